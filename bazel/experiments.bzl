@@ -26,29 +26,67 @@ EXPERIMENTS = {
         ],
     },
     "off": {
+        "core_end2end_tests": [
+            "call_combiner_inline_start",
+            "channel_stack_cache",
+            "chttp2_confined_read_slices",
+            "chttp2_parallel_stream_delivery",
+            "connected_channel_inline_callbacks",
+            "epoll1_background_poller",
+            "epoll_batched_events",
+            "epoll_sharded_sets",
+            "event_engine_dns",
+            "event_engine_executor",
+            "fused_filters",
+            "handshake_thread_pool",
+            "keepalive_coalescing",
+            "kernel_tls",
+            "service_config_cache",
+            "ssl_zero_copy_protector",
+            "timerfd_timers",
+            "tls_verification_cache",
+            "work_serializer_offload",
+        ],
+        "credential_token_tests": [
+            "shared_oauth2_token_cache",
+        ],
+        "dns_test": [
+            "dns_result_cache",
+        ],
         "endpoint_test": [
+            "adaptive_tcp_zerocopy_threshold",
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
             "tcp_read_chunks",
         ],
         "event_engine_client_test": [
             "event_engine_client",
+            "numa_thread_placement",
         ],
         "flow_control_test": [
+            "adaptive_frame_size",
+            "adaptive_tcp_zerocopy_threshold",
+            "chttp2_weighted_fair_writes",
             "flow_control_fixes",
+            "model_based_flow_control",
             "peer_state_based_framing",
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
             "tcp_read_chunks",
         ],
         "hpack_test": [
+            "hpack_encoder_literal_cache",
+            "hpack_index_authorization",
+            "hpack_table_arena",
             "periodic_resource_quota_reclamation",
         ],
         "promise_test": [
             "periodic_resource_quota_reclamation",
         ],
         "resource_quota_test": [
+            "arena_block_cache",
             "memory_pressure_controller",
+            "per_cpu_memory_quota",
             "periodic_resource_quota_reclamation",
             "unconstrained_max_quota_buffer_size",
         ],
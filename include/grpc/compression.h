@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include <grpc/impl/codegen/compression_types.h>  // IWYU pragma: export
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
 
 #ifdef __cplusplus
@@ -49,6 +50,11 @@ GRPCAPI int grpc_compression_algorithm_parse(
 GRPCAPI int grpc_compression_algorithm_name(
     grpc_compression_algorithm algorithm, const char** name);
 
+/** Returns 1 if this build of gRPC implements \a algorithm, 0 otherwise.
+ * Algorithms that are not implemented are never advertised to peers. */
+GRPCAPI int grpc_compression_algorithm_is_supported(
+    grpc_compression_algorithm algorithm);
+
 /** Returns the compression algorithm corresponding to \a level for the
  * compression algorithms encoded in the \a accepted_encodings bitset.*/
 GRPCAPI grpc_compression_algorithm grpc_compression_algorithm_for_level(
@@ -68,6 +74,20 @@ GRPCAPI void grpc_compression_options_disable_algorithm(
 GRPCAPI int grpc_compression_options_is_algorithm_enabled(
     const grpc_compression_options* opts, grpc_compression_algorithm algorithm);
 
+/** Creates a dictionary for the zstd and lz4 algorithms from the \a length
+ * bytes at \a data, which are copied. Pass it to channels and servers through
+ * the GRPC_COMPRESSION_CHANNEL_DICTIONARY channel argument. */
+GRPCAPI grpc_compression_dictionary* grpc_compression_dictionary_create(
+    const char* data, size_t length);
+
+/** Drops a reference to \a dictionary; channel args hold their own. */
+GRPCAPI void grpc_compression_dictionary_unref(
+    grpc_compression_dictionary* dictionary);
+
+/** The vtable for GRPC_COMPRESSION_CHANNEL_DICTIONARY channel arguments. */
+GRPCAPI const grpc_arg_pointer_vtable* grpc_compression_dictionary_arg_vtable(
+    void);
+
 #ifdef __cplusplus
 }
 #endif
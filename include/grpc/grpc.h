@@ -124,6 +124,23 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but returns up to \a max_events events
+    at once. Blocks until at least one event is available, the completion
+    queue is being shut down, or deadline is reached; then also returns the
+    events that are already queued, without blocking for more.
+
+    Returns the number of events written to \a events, which is at least one.
+    If events[0] has type GRPC_QUEUE_TIMEOUT or GRPC_QUEUE_SHUTDOWN it is the
+    only event returned.
+
+    \a cq must have completion type GRPC_CQ_NEXT and \a max_events must be
+    at least one. This function is experimental. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                                grpc_event* events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -119,6 +119,30 @@ GRPCAPI void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache* cache);
 GRPCAPI grpc_arg
 grpc_ssl_session_cache_create_channel_arg(grpc_ssl_session_cache* cache);
 
+/** --- SSL Session Ticket Keys. --- EXPERIMENTAL API - Subject to change
+
+    The keys a TLS server encrypts the session tickets it issues with, which
+    clients present to resume their sessions. Servers sharing one object
+    resume each other's sessions. */
+
+typedef struct grpc_ssl_session_ticket_keys grpc_ssl_session_ticket_keys;
+
+/** Create session ticket keys holding a single random key. */
+GRPCAPI grpc_ssl_session_ticket_keys* grpc_ssl_session_ticket_keys_create(
+    void);
+
+/** Make the key_size bytes at key the key new tickets are encrypted with.
+    The key is a 16-byte key name, followed by a 16-byte HMAC-SHA256 key and a
+    16-byte AES-128 key. Tickets encrypted with one of the two previous keys
+    are still accepted. Returns 1 on success, and 0 if key_size is not 48. */
+GRPCAPI int grpc_ssl_session_ticket_keys_rotate(
+    grpc_ssl_session_ticket_keys* keys, const char* key, size_t key_size);
+
+/** Release session ticket keys. The credentials options they were set on
+    hold their own reference. */
+GRPCAPI void grpc_ssl_session_ticket_keys_release(
+    grpc_ssl_session_ticket_keys* keys);
+
 /** --- grpc_call_credentials object.
 
    A call credentials object represents a way to authenticate on a particular
@@ -887,6 +911,100 @@ GRPCAPI void grpc_tls_credentials_options_set_cert_request_type(
 GRPCAPI void grpc_tls_credentials_options_set_crl_directory(
     grpc_tls_credentials_options* options, const char* crl_directory);
 
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Sets the keys the server encrypts session tickets with. Servers whose
+ * options share the same keys resume each other's sessions. If not set, each
+ * server uses its own random key.
+ * It is used for experimental purpose for now and subject to change.
+ */
+GRPCAPI void grpc_tls_credentials_options_set_session_ticket_keys(
+    grpc_tls_credentials_options* options, grpc_ssl_session_ticket_keys* keys);
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * The internal private key signer type that will be used inside core.
+ */
+typedef struct grpc_tls_private_key_signer grpc_tls_private_key_signer;
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * A callback function provided by gRPC to receive the outcome of a signing
+ * operation, invoked with the |callback_arg| passed to |sign| in
+ * grpc_tls_private_key_signer_external. On success, |status| is
+ * GRPC_STATUS_OK and |signature| holds the |signature_size| bytes of the
+ * signature. Otherwise, |error_details| describes the failure. gRPC copies
+ * |signature| and |error_details| before the callback returns.
+ */
+typedef void (*grpc_tls_on_private_key_sign_done_cb)(
+    void* callback_arg, grpc_status_code status, const char* error_details,
+    const char* signature, size_t signature_size);
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * A struct containing all the necessary functions a custom external private
+ * key signer needs to implement to be able to be converted to an internal
+ * signer.
+ */
+typedef struct grpc_tls_private_key_signer_external {
+  void* user_data;
+  /**
+   * A function pointer that signs the |input_size| bytes at |input| with the
+   * server's private key, using the TLS SignatureScheme
+   * |signature_algorithm| as defined in RFC 8446, section 4.2.3. The
+   * implementer must invoke |callback| with |callback_arg| exactly once,
+   * either before |sign| returns or later from any thread. The handshake does
+   * not block while the signing is in flight. |input| is only valid until
+   * |sign| returns.
+   */
+  void (*sign)(void* user_data, const char* input, size_t input_size,
+               uint16_t signature_algorithm,
+               grpc_tls_on_private_key_sign_done_cb callback,
+               void* callback_arg);
+  /**
+   * A function pointer that cleans up the user_data when the signer is
+   * destroyed. It may be null.
+   */
+  void (*destruct)(void* user_data);
+} grpc_tls_private_key_signer_external;
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Converts an external private key signer to an internal one. The struct is
+ * copied, and |destruct| is invoked on its user_data once the internal
+ * signer is destroyed.
+ */
+GRPCAPI grpc_tls_private_key_signer*
+grpc_tls_private_key_signer_external_create(
+    const grpc_tls_private_key_signer_external* external_signer);
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Releases a grpc_tls_private_key_signer object. The credentials options it
+ * was set on hold their own reference.
+ */
+GRPCAPI void grpc_tls_private_key_signer_release(
+    grpc_tls_private_key_signer* signer);
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Sets the signer that performs the signing operations of the server's TLS
+ * handshakes, for servers whose private key is not loaded in the process. If
+ * set, the private keys of the identity key-cert pairs are ignored and may be
+ * empty. Only supported when gRPC is built with BoringSSL.
+ * It is used for experimental purpose for now and subject to change.
+ */
+GRPCAPI void grpc_tls_credentials_options_set_private_key_signer(
+    grpc_tls_credentials_options* options,
+    grpc_tls_private_key_signer* signer);
+
 /**
  * EXPERIMENTAL API - Subject to change
  *
@@ -50,9 +50,35 @@ extern "C" {
  * GRPC_COMPRESS_NONE, the next bit to GRPC_COMPRESS_DEFLATE, etc.
  * Unset bits disable support for the algorithm. By default all algorithms are
  * supported. It's not possible to disable GRPC_COMPRESS_NONE (the attempt will
- * be ignored). */
+ * be ignored), nor to enable an algorithm this build doesn't implement (see
+ * grpc_compression_algorithm_is_supported()). */
 #define GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET \
   "grpc.compression_enabled_algorithms_bitset"
+/** Dictionary used by the zstd and lz4 algorithms to compress and decompress
+ * messages. Both peers must use the same dictionary. Its value is a pointer to
+ * a \a grpc_compression_dictionary, with the vtable returned by
+ * grpc_compression_dictionary_arg_vtable(). */
+#define GRPC_COMPRESSION_CHANNEL_DICTIONARY "grpc.compression_dictionary"
+/** Named dictionaries that received zstd and lz4 messages may have been
+ * compressed with, as referred to by their grpc-compression-dictionary header.
+ * Clients pick the dictionary of a method through the "compressionDictionary"
+ * field of its method config. Its value is a JSON string holding an array of
+ * {"name": "...", "data": "<base64 dictionary>"} objects. */
+#define GRPC_COMPRESSION_CHANNEL_DICTIONARIES "grpc.compression_dictionaries"
+/** Size in bytes from which messages are compressed and decompressed on the
+ * EventEngine instead of on the thread running the call, which would otherwise
+ * hold up the other calls sharing it. zstd and lz4 messages are also split
+ * into chunks compressed in parallel. Its value is an int; 0, the default,
+ * disables offloading. */
+#define GRPC_COMPRESSION_CHANNEL_OFFLOAD_THRESHOLD \
+  "grpc.compression_offload_threshold"
+/** Minimum percentage by which compression must shrink the messages of a
+ * method for the messages it sends to keep being compressed. The ratio is
+ * sampled per method; methods below it are only compressed once in a while,
+ * to notice if they become compressible again. Its value is an int from 0 to
+ * 100; 0, the default, compresses all messages. */
+#define GRPC_COMPRESSION_CHANNEL_MIN_SAVINGS_PERCENT \
+  "grpc.compression_min_savings_percent"
 /** \} */
 
 /** The various compression algorithms supported by gRPC (not sorted by
@@ -61,6 +87,10 @@ typedef enum {
   GRPC_COMPRESS_NONE = 0,
   GRPC_COMPRESS_DEFLATE,
   GRPC_COMPRESS_GZIP,
+  /** Only available in builds with GRPC_HAVE_ZSTD defined. */
+  GRPC_COMPRESS_ZSTD,
+  /** Only available in builds with GRPC_HAVE_LZ4 defined. */
+  GRPC_COMPRESS_LZ4,
   /* TODO(ctiller): snappy */
   GRPC_COMPRESS_ALGORITHMS_COUNT
 } grpc_compression_algorithm;
@@ -77,6 +107,10 @@ typedef enum {
   GRPC_COMPRESS_LEVEL_COUNT
 } grpc_compression_level;
 
+/** A dictionary for the zstd and lz4 algorithms, see
+ * GRPC_COMPRESSION_CHANNEL_DICTIONARY. */
+typedef struct grpc_compression_dictionary grpc_compression_dictionary;
+
 typedef struct grpc_compression_options {
   /** All algs are enabled by default. This option corresponds to the channel
    * argument key behind \a GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET
@@ -167,6 +167,27 @@ typedef struct {
 /** Grace period after the channel reaches its max age. Int valued,
    milliseconds. INT_MAX means unlimited. */
 #define GRPC_ARG_MAX_CONNECTION_AGE_GRACE_MS "grpc.max_connection_age_grace_ms"
+/** If non-zero, the server limits the calls it runs at once to a limit that
+ * it adapts to the latency of its calls, and fails calls over the limit with
+ * RESOURCE_EXHAUSTED before reading their messages. The limit is shared by
+ * all the connections of a server. Int valued, defaults to 0. */
+#define GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT \
+  "grpc.server_adaptive_concurrency_limit"
+/** The most calls the adaptive concurrency limit may allow at once. Int
+ * valued, defaults to 1000. */
+#define GRPC_ARG_SERVER_MAX_CONCURRENCY_LIMIT \
+  "grpc.server_max_concurrency_limit"
+/** If positive, the server fails with DEADLINE_EXCEEDED the calls that have
+ * less than this much time left before their deadline when they would be
+ * handed to the application, rather than running handlers whose result
+ * would arrive too late. Int valued, milliseconds, defaults to 0. */
+#define GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS \
+  "grpc.server_min_deadline_budget_ms"
+/** Time taken off the deadline a server call propagates to the calls it
+ * makes, leaving it that long to produce its response once they are done.
+ * Int valued, milliseconds, defaults to 0. */
+#define GRPC_ARG_SERVER_DEADLINE_PROPAGATION_MARGIN_MS \
+  "grpc.server_deadline_propagation_margin_ms"
 /** Timeout after the last RPC finishes on the client channel at which the
  * channel goes back into IDLE state. Int valued, milliseconds. INT_MAX means
  * unlimited. The default value is 30 minutes and the min value is 1 second. */
@@ -232,6 +253,24 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** Writes of fewer than this many bytes of stream frames are held back for up
+    to GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, so that frames from other
+    streams completing shortly afterwards go out in the same write. Frames
+    that should not wait (settings, pings, resets, goaways and flow control
+    updates) end the window early. Int valued, bytes. Defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES \
+  "grpc.http2.write_coalescing_bytes"
+/** How long a write may be held back for GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES.
+    Rounded up to the resolution of timers (currently a millisecond).
+    Int valued, microseconds. Defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US \
+  "grpc.http2.write_coalescing_window_us"
+/** After a connection has had no streams for this long, it hibernates: both
+    ends drop their HPACK tables, and the endpoints free the buffers they keep
+    between reads and writes. The tables come back with the next stream, the
+    buffers with the next read or write. Int valued, milliseconds. Defaults
+    to 0 (off). */
+#define GRPC_ARG_IDLE_HIBERNATION_MS "grpc.idle_hibernation_ms"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -262,6 +301,24 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** Experimental Arg. The maximum number of connections that a subchannel
+    keeps to its address. Calls go to the connection with the fewest active
+    calls, and another connection is opened once all of them carry
+    GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION calls. Default value is 1. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS \
+  "grpc.experimental.subchannel_max_connections"
+/** Experimental Arg. The number of active calls on each of a subchannel's
+    connections at which it opens another one, up to
+    GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS. Should match the servers'
+    MAX_CONCURRENT_STREAMS setting. Default value is 100. */
+#define GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION \
+  "grpc.experimental.subchannel_streams_per_connection"
+/** Experimental Arg. If non-zero, subchannels to the same address that
+    health check the same service share one health check stream, even when
+    they belong to channels with different args, instead of each opening its
+    own. Only subchannels that set this arg take part. Default value is 0. */
+#define GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS \
+  "grpc.experimental.share_health_check_streams"
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
@@ -293,6 +350,13 @@ typedef struct {
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, and SO_REUSEPORT is in use, a server listens on each port with
+    one socket per listening completion queue, and connections accepted on a
+    socket are polled only by the pollset of that completion queue, instead of
+    being spread round robin over all of them. Together with one completion
+    queue per CPU this keeps each connection on one polling thread. Default 0.
+ */
+#define GRPC_ARG_REUSEPORT_SHARDING "grpc.experimental.reuseport_sharding"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
@@ -350,6 +414,46 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map kernel receive buffers into the process with
+   TCP_ZEROCOPY_RECEIVE instead of copying them, where the platform supports
+   it. By default, it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy read threshold: only zerocopy receive when at least this many
+   bytes are expected to be read. By default, this is set to 256KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_READ_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_read_bytes_threshold"
+/* If non-zero, chttp2 connections over unix domain sockets on Linux send
+   large DATA payloads as sealed memfds passed with SCM_RIGHTS instead of
+   through the socket, once both peers have agreed to it through an HTTP/2
+   setting. The payload is then copied once, into the memfd, and read straight
+   from its mapping. Peers must trust each other with their memory use. By
+   default, it is disabled. */
+#define GRPC_ARG_UDS_MEMFD_DATA_ENABLED \
+  "grpc.experimental.uds_memfd_data_enabled"
+/* The smallest DATA payload sent as a memfd. By default, this is 1MB. */
+#define GRPC_ARG_UDS_MEMFD_DATA_MIN_BYTES \
+  "grpc.experimental.uds_memfd_data_min_bytes"
+/* TCP busy poll time in microseconds: sets SO_BUSY_POLL on TCP sockets so that
+   blocking reads and polls busy wait on the device queue for up to this long
+   before sleeping. Raising it above net.core.busy_read needs CAP_NET_ADMIN;
+   failures are logged and ignored. Only supported on Linux. By default, this is
+   0 (disabled). */
+#define GRPC_ARG_TCP_BUSY_POLL_US "grpc.experimental.tcp_busy_poll_us"
+/* If non-zero, enables TCP Fast Open: clients set TCP_FASTOPEN_CONNECT so that
+   once they hold a cookie from a server, the HTTP/2 preface goes out with the
+   SYN, and servers set TCP_FASTOPEN on their listeners to accept such data.
+   The kernel must allow it (net.ipv4.tcp_fastopen); failures are logged and
+   ignored. Only supported on Linux. By default, this is 0 (disabled). */
+#define GRPC_ARG_TCP_FASTOPEN "grpc.experimental.tcp_fastopen"
+/* If non-zero, sets TCP_NOTSENT_LOWAT on TCP sockets to this many bytes, so
+   that the kernel takes no more data while that much is still unsent and only
+   reports the socket writable once it drains below that. chttp2 then also
+   limits each write to that many bytes, so frames are chosen as late as
+   possible and urgent frames do not queue behind bulk data in the socket.
+   Supported on Linux and macOS. By default, this is 0 (disabled). */
+#define GRPC_ARG_TCP_NOTSENT_LOWAT "grpc.experimental.tcp_notsent_lowat"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -379,6 +483,32 @@ typedef struct {
    over to the next priority. Default value is 10 seconds. */
 #define GRPC_ARG_PRIORITY_FAILOVER_TIMEOUT_MS \
   "grpc.priority_failover_timeout_ms"
+/* Experimental Arg. Max number of subchannels that the priority LB policy
+   keeps connected as a warm standby. While a priority is in use, the child
+   of the next priority is kept connected if it has this many addresses or
+   fewer, so that failing over to it does not wait for fresh connections.
+   Default value is 0 (no warm standby). */
+#define GRPC_ARG_EXPERIMENTAL_PRIORITY_WARM_STANDBY_SUBCHANNELS \
+  "grpc.experimental.priority_warm_standby_subchannels"
+/* Experimental Arg. Percentage (0 to 100) of the addresses at the front of
+   a pick_first address list to connect to eagerly. These subchannels
+   connect in parallel instead of one at a time, are reconnected in the
+   background whenever they go IDLE, and are kept connected as standbys
+   once a subchannel is selected, so that losing the selected connection or
+   switching to a new address list does not wait for a fresh handshake.
+   With a non-zero value, pick_first also reconnects right away rather than
+   going IDLE when its selected subchannel fails. Default value is 0. */
+#define GRPC_ARG_EXPERIMENTAL_PICK_FIRST_PRECONNECT_PERCENT \
+  "grpc.experimental.pick_first_preconnect_percent"
+/* Experimental Arg. Happy Eyeballs (RFC 8305) connection attempt delay for
+   pick_first, in milliseconds. If non-zero, pick_first interleaves the
+   addresses by address family, and whenever the address it is connecting
+   to has not connected within this delay, it starts connecting to the next
+   one without giving up on the earlier attempts. The first subchannel to
+   become READY is selected. Values are clamped to [10, 2000]; RFC 8305
+   recommends 250. Default value is 0 (one address at a time). */
+#define GRPC_ARG_EXPERIMENTAL_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS \
+  "grpc.experimental.pick_first_connection_attempt_delay_ms"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -395,15 +525,18 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: Hedging is only enabled by the
+          GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below; without it, the
+          hedgingPolicy field in the service config is ignored.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    When enabled, a method's hedgingPolicy in the service config is used
+    to send up to maxAttempts copies of the call, hedgingDelay apart,
+    committing to the first one that gets a response.  Hedged attempts
+    share the retry throttling and the per-RPC retry buffer with retries.
+    Default is currently false.
     NOTE: This channel arg is experimental and will eventually be removed.
           Once hedging functionality has been implemented and proves stable,
           this arg will be removed, and the hedging functionality will
@@ -461,6 +594,20 @@ typedef struct {
  * channel arg. Int valued, milliseconds. Defaults to 10 minutes.*/
 #define GRPC_ARG_SERVER_CONFIG_CHANGE_DRAIN_GRACE_TIME_MS \
   "grpc.experimental.server_config_change_drain_grace_time_ms"
+/** EXPERIMENTAL. If positive, the client channel keeps up to this many bytes
+ * of responses to unary calls made with
+ * GRPC_INITIAL_METADATA_CACHEABLE_REQUEST, and answers later calls sending the
+ * same request to the same method from them, for as long as the max-age of
+ * the response's cache-control metadata. Int valued, bytes. Defaults to 0
+ * (no cache). */
+#define GRPC_ARG_RESPONSE_CACHE_SIZE "grpc.experimental.response_cache_size"
+/** EXPERIMENTAL. If set, a unary call made with
+ * GRPC_INITIAL_METADATA_CACHEABLE_REQUEST while an identical one (same method,
+ * authority and request message) is in flight on the same client channel is
+ * not sent: it waits for the call in flight, and gets its response if that
+ * one succeeds. Boolean valued. Defaults to false. */
+#define GRPC_ARG_COALESCE_CACHEABLE_CALLS \
+  "grpc.experimental.coalesce_cacheable_calls"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
@@ -527,6 +674,13 @@ typedef enum grpc_call_error {
 /** These flags are to be passed to the `grpc_op::flags` field */
 /** Signal that the call should not return UNAVAILABLE before it has started */
 #define GRPC_INITIAL_METADATA_WAIT_FOR_READY (0x00000020u)
+/** EXPERIMENTAL: Signal that the response to the call depends only on its
+    method, authority and request message, so that a client channel with a
+    response cache (GRPC_ARG_RESPONSE_CACHE_SIZE) may answer it from the
+    cache, or one coalescing calls (GRPC_ARG_COALESCE_CACHEABLE_CALLS) with
+    the response to an identical call in flight. Only unary calls are ever
+    cached or coalesced. */
+#define GRPC_INITIAL_METADATA_CACHEABLE_REQUEST (0x00000040u)
 /** Signal that GRPC_INITIAL_METADATA_WAIT_FOR_READY was explicitly set
     by the calling application. */
 #define GRPC_INITIAL_METADATA_WAIT_FOR_READY_EXPLICITLY_SET (0x00000080u)
@@ -534,7 +688,23 @@ typedef enum grpc_call_error {
 /** Mask of all valid flags */
 #define GRPC_INITIAL_METADATA_USED_MASK                  \
   (GRPC_INITIAL_METADATA_WAIT_FOR_READY_EXPLICITLY_SET | \
-   GRPC_INITIAL_METADATA_WAIT_FOR_READY | GRPC_WRITE_THROUGH)
+   GRPC_INITIAL_METADATA_WAIT_FOR_READY |                \
+   GRPC_INITIAL_METADATA_CACHEABLE_REQUEST | GRPC_WRITE_THROUGH)
+
+/** Receive message flags */
+/** These flags are to be passed to the `grpc_op::flags` field of a
+    GRPC_OP_RECV_MESSAGE */
+/** EXPERIMENTAL: Let the op complete with the part of a message received so
+    far, rather than once the whole message has arrived, so that a huge
+    message can be streamed through with bounded memory. The op then sets
+    *data.recv_message.partial to whether the rest of the message follows.
+    Once part of a message was received, the ops receiving the rest of it
+    must set this flag too. Only uncompressed messages are received in parts,
+    and only from transports that support it: others receive whole messages.
+  */
+#define GRPC_RECV_MESSAGE_PARTIAL (0x00000001u)
+/** Mask of all valid flags */
+#define GRPC_RECV_MESSAGE_USED_MASK GRPC_RECV_MESSAGE_PARTIAL
 
 /** A single metadata element */
 typedef struct grpc_metadata {
@@ -692,6 +862,9 @@ typedef struct grpc_op {
        */
     struct grpc_op_recv_message {
       struct grpc_byte_buffer** recv_message;
+      /** EXPERIMENTAL: with GRPC_RECV_MESSAGE_PARTIAL, set to 1 if the bytes
+          received are not the end of their message, and to 0 otherwise. */
+      int* partial;
     } recv_message;
     struct grpc_op_recv_status_on_client {
       /** ownership of the array is with the caller, but ownership of the
@@ -787,8 +960,9 @@ typedef struct grpc_completion_queue_functor {
   struct grpc_completion_queue_functor* internal_next;
 } grpc_completion_queue_functor;
 
-#define GRPC_CQ_CURRENT_VERSION 2
+#define GRPC_CQ_CURRENT_VERSION 3
 #define GRPC_CQ_VERSION_MINIMUM_FOR_CALLBACKABLE 2
+#define GRPC_CQ_VERSION_MINIMUM_FOR_BUSY_POLL 3
 typedef struct grpc_completion_queue_attributes {
   /** The version number of this structure. More fields might be added to this
      structure in future. */
@@ -806,6 +980,23 @@ typedef struct grpc_completion_queue_attributes {
   grpc_completion_queue_functor* cq_shutdown_cb;
 
   /* END OF VERSION 2 CQ ATTRIBUTES */
+
+  /* START OF VERSION 3 CQ ATTRIBUTES */
+  /** For GRPC_CQ_NEXT completion queues: how long, in microseconds, each
+     grpc_completion_queue_next() call keeps polling the pollset without
+     sleeping before it blocks in the poller. This trades a spinning CPU for
+     lower wakeup latency. 0 (the default) never busy polls. Ignored by other
+     completion types. */
+  int cq_busy_poll_us;
+
+  /** If non-zero, threads that call grpc_completion_queue_next() on this
+     completion queue are pinned to CPU cq_busy_poll_cpu on their first call,
+     whether or not the queue busy polls, and stay pinned. Only supported on
+     Linux. */
+  int cq_busy_poll_pin_cpu;
+  int cq_busy_poll_cpu;
+
+  /* END OF VERSION 3 CQ ATTRIBUTES */
 } grpc_completion_queue_attributes;
 
 /** The completion queue factory structure is opaque to the callers of grpc */
@@ -20,6 +20,7 @@
 #define GRPCPP_CHANNEL_H
 
 #include <memory>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpcpp/impl/call.h>
@@ -99,6 +100,8 @@ class Channel final : public grpc::ChannelInterface,
                               gpr_timespec deadline) override;
 
   grpc::CompletionQueue* CallbackCQ() override;
+  grpc::CompletionQueue* LendPluckCQ() override;
+  void ReturnPluckCQ(grpc::CompletionQueue* cq) override;
 
   grpc::internal::Call CreateCallInternal(
       const grpc::internal::RpcMethod& method, grpc::ClientContext* context,
@@ -116,6 +119,12 @@ class Channel final : public grpc::ChannelInterface,
   // shutdown callback tag (invoked when the CQ is fully shutdown).
   std::atomic<CompletionQueue*> callback_cq_{nullptr};
 
+  // spare_pluck_cqs_mu_ protects spare_pluck_cqs_, the pluckable completion
+  // queues given back by blocking calls that are done with them, kept (and
+  // owned) by the channel for later blocking calls to borrow.
+  grpc::internal::Mutex spare_pluck_cqs_mu_;
+  std::vector<CompletionQueue*> spare_pluck_cqs_;
+
   std::vector<
       std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
       interceptor_creators_;
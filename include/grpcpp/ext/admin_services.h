@@ -19,6 +19,11 @@
 #ifndef GRPCPP_EXT_ADMIN_SERVICES_H
 #define GRPCPP_EXT_ADMIN_SERVICES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
 #include <grpcpp/server_builder.h>
 
 namespace grpc {
@@ -28,6 +33,24 @@ namespace grpc {
 // CSDS service if xDS is enabled in this binary.
 void AddAdminServices(grpc::ServerBuilder* builder);
 
+namespace experimental {
+
+// Starts sampling contention on gRPC's internal mutexes, timing one in every
+// sample_period acquisitions that find the mutex held, or stops if
+// sample_period is 0. Sampling can also be started at init by setting the
+// GRPC_MUTEX_CONTENTION_SAMPLE_PERIOD environment variable.
+void SetMutexContentionSamplePeriod(uint32_t sample_period);
+
+// Returns, as JSON text, the up to max_sites pairs of holder and waiter call
+// sites that have been waited on longest since sampling started, for an
+// application to serve from its admin or debug endpoint.
+std::string GetMutexContentionProfile(size_t max_sites);
+
+// Forgets the contention sampled so far.
+void ResetMutexContentionProfile();
+
+}  // namespace experimental
+
 }  // namespace grpc
 
 #endif  // GRPCPP_EXT_ADMIN_SERVICES_H
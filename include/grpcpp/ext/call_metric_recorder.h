@@ -46,6 +46,16 @@ class OrcaServerInterceptor;
 // retrieve the recorder for the current call.
 void EnableCallMetricRecording(ServerBuilder*);
 
+// Like \a EnableCallMetricRecording(), and also has the server measure the
+// CPU cost of each RPC, for the metrics that its handler does not record:
+// - the CPU time that the RPC took on the thread that received it, from
+//   receiving its initial metadata to sending its status, as the request cost
+//   named "grpc.cpu_time_ms", in milliseconds. It is only recorded for RPCs
+//   that finish on that thread, like those of synchronous methods.
+// - the CPU utilization of the server process over about the last second, as
+//   the CPU utilization.
+void EnableCallMetricRecordingWithCpuStats(ServerBuilder*);
+
 /// Records call metrics for the purpose of load balancing.
 /// During an RPC, call \a ServerContext::ExperimentalGetCallMetricRecorder()
 /// method to retrive the recorder for the current call.
@@ -62,6 +72,10 @@ class CallMetricRecorder {
   /// Multiple calls to this method will override the stored value.
   CallMetricRecorder& RecordMemoryUtilizationMetric(double value);
 
+  /// Records a call metric measurement for queries per second.
+  /// Multiple calls to this method will override the stored value.
+  CallMetricRecorder& RecordQpsMetric(double value);
+
   /// Records a call metric measurement for utilization.
   /// Multiple calls to this method with the same name will
   /// override the corresponding stored value. The lifetime of the
@@ -0,0 +1,52 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_GENERIC_PROXYING_GENERIC_SERVICE_H
+#define GRPCPP_GENERIC_PROXYING_GENERIC_SERVICE_H
+
+#include <memory>
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/channel_interface.h>
+
+namespace grpc {
+
+/// A CallbackGenericService that forwards every call it receives to the same
+/// method on \a channel, and the backend's metadata, messages and status back
+/// to the caller.
+///
+/// Messages are never parsed: each received ByteBuffer is handed to the other
+/// call as is, so its slices are passed on by reference without being
+/// flattened or re-chunked. Each direction has at most one message in flight,
+/// so a slow reader on either side holds back the writer on the other.
+class ProxyingGenericService : public CallbackGenericService {
+ public:
+  explicit ProxyingGenericService(std::shared_ptr<ChannelInterface> channel)
+      : stub_(std::move(channel)) {}
+
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* ctx) override;
+
+ private:
+  GenericStub stub_;
+};
+
+}  // namespace grpc
+
+#endif  // GRPCPP_GENERIC_PROXYING_GENERIC_SERVICE_H
@@ -24,6 +24,8 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -54,8 +56,12 @@ class CallHook;
 // mess. Make sure it does not happen.
 inline grpc_metadata* FillMetadataArray(
     const std::multimap<std::string, std::string>& metadata,
+    const std::vector<std::pair<grpc::string_ref, grpc::string_ref>>*
+        referenced,
     size_t* metadata_count, const std::string& optional_error_details) {
-  *metadata_count = metadata.size() + (optional_error_details.empty() ? 0 : 1);
+  *metadata_count = metadata.size() +
+                    (referenced == nullptr ? 0 : referenced->size()) +
+                    (optional_error_details.empty() ? 0 : 1);
   if (*metadata_count == 0) {
     return nullptr;
   }
@@ -67,6 +73,17 @@ inline grpc_metadata* FillMetadataArray(
     metadata_array[i].key = SliceReferencingString(iter->first);
     metadata_array[i].value = SliceReferencingString(iter->second);
   }
+  if (referenced != nullptr) {
+    for (const auto& md : *referenced) {
+      metadata_array[i].key =
+          g_core_codegen_interface->grpc_slice_from_static_buffer(
+              md.first.data(), md.first.length());
+      metadata_array[i].value =
+          g_core_codegen_interface->grpc_slice_from_static_buffer(
+              md.second.data(), md.second.length());
+      ++i;
+    }
+  }
   if (!optional_error_details.empty()) {
     metadata_array[i].key =
         g_core_codegen_interface->grpc_slice_from_static_buffer(
@@ -75,6 +92,13 @@ inline grpc_metadata* FillMetadataArray(
   }
   return metadata_array;
 }
+
+inline grpc_metadata* FillMetadataArray(
+    const std::multimap<std::string, std::string>& metadata,
+    size_t* metadata_count, const std::string& optional_error_details) {
+  return FillMetadataArray(metadata, nullptr, metadata_count,
+                           optional_error_details);
+}
 }  // namespace internal
 
 /// Per-message write options.
@@ -228,6 +252,14 @@ class CallOpSendInitialMetadata {
     send_ = true;
     flags_ = flags;
     metadata_map_ = metadata;
+    client_metadata_ = nullptr;
+  }
+
+  void SendInitialMetadata(ClientSendMetadata* metadata, uint32_t flags) {
+    SendInitialMetadata(
+        static_cast<std::multimap<std::string, std::string>*>(metadata),
+        flags);
+    client_metadata_ = metadata;
   }
 
   void set_compression_level(grpc_compression_level level) {
@@ -242,8 +274,10 @@ class CallOpSendInitialMetadata {
     op->op = GRPC_OP_SEND_INITIAL_METADATA;
     op->flags = flags_;
     op->reserved = nullptr;
-    initial_metadata_ =
-        FillMetadataArray(*metadata_map_, &initial_metadata_count_, "");
+    initial_metadata_ = FillMetadataArray(
+        *metadata_map_,
+        client_metadata_ == nullptr ? nullptr : &client_metadata_->referenced,
+        &initial_metadata_count_, "");
     op->data.send_initial_metadata.count = initial_metadata_count_;
     op->data.send_initial_metadata.metadata = initial_metadata_;
     op->data.send_initial_metadata.maybe_compression_level.is_set =
@@ -264,6 +298,8 @@ class CallOpSendInitialMetadata {
     if (!send_) return;
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA);
+    // Interceptors see, and may change, all the metadata in the multimap.
+    if (client_metadata_ != nullptr) client_metadata_->CopyReferenced();
     interceptor_methods->SetSendInitialMetadata(metadata_map_);
   }
 
@@ -279,6 +315,7 @@ class CallOpSendInitialMetadata {
   uint32_t flags_;
   size_t initial_metadata_count_;
   std::multimap<std::string, std::string>* metadata_map_;
+  ClientSendMetadata* client_metadata_ = nullptr;
   grpc_metadata* initial_metadata_;
   struct {
     bool is_set;
@@ -311,6 +348,16 @@ class CallOpSendMessage {
   template <class M>
   Status SendMessagePtr(const M* message) GRPC_MUST_USE_RESULT;
 
+  /// Send the already serialized (and possibly compressed) \a message using
+  /// \a options for the write. The \a options are cleared after use. This only
+  /// takes references to the slices of \a message, so the same buffer can be
+  /// sent on any number of calls without serializing it again.
+  void SendSerializedMessage(const ByteBuffer& message, WriteOptions options) {
+    GPR_CODEGEN_ASSERT(message.Valid());
+    write_options_ = options;
+    send_buf_ = message;
+  }
+
  protected:
   void AddOp(grpc_op* ops, size_t* nops) {
     if (msg_ == nullptr && !send_buf_.Valid()) return;
@@ -353,7 +400,8 @@ class CallOpSendMessage {
 
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
-    if (msg_ != nullptr || send_buf_.Valid()) {
+    if (interceptor_methods != nullptr &&
+        (msg_ != nullptr || send_buf_.Valid())) {
       interceptor_methods->AddInterceptionHookPoint(
           experimental::InterceptionHookPoints::POST_SEND_MESSAGE);
     }
@@ -361,8 +409,10 @@ class CallOpSendMessage {
     msg_ = nullptr;
     // The contents of the SendMessage value that was previously set
     // has had its references stolen by core's operations
-    interceptor_methods->SetSendMessage(nullptr, nullptr, &failed_send_,
-                                        nullptr);
+    if (interceptor_methods != nullptr) {
+      interceptor_methods->SetSendMessage(nullptr, nullptr, &failed_send_,
+                                          nullptr);
+    }
   }
 
   void SetHijackingState(InterceptorBatchMethodsImpl* /*interceptor_methods*/) {
@@ -435,6 +485,10 @@ class CallOpRecvMessage {
   // Do not change status if no message is received.
   void AllowNoMessage() { allow_not_getting_message_ = true; }
 
+  // EXPERIMENTAL: Receive the part of the message received so far, and set
+  // *partial to whether the rest of it follows. Only for R = ByteBuffer.
+  void AllowPartialMessage(bool* partial) { partial_ = partial; }
+
   bool got_message = false;
 
  protected:
@@ -442,13 +496,15 @@ class CallOpRecvMessage {
     if (message_ == nullptr || hijacked_) return;
     grpc_op* op = &ops[(*nops)++];
     op->op = GRPC_OP_RECV_MESSAGE;
-    op->flags = 0;
+    op->flags = partial_ != nullptr ? GRPC_RECV_MESSAGE_PARTIAL : 0;
     op->reserved = nullptr;
     op->data.recv_message.recv_message = recv_buf_.c_buffer_ptr();
+    op->data.recv_message.partial = &received_partial_;
   }
 
   void FinishOp(bool* status) {
     if (message_ == nullptr) return;
+    if (partial_ != nullptr) *partial_ = received_partial_ != 0;
     if (recv_buf_.Valid()) {
       if (*status) {
         got_message = *status =
@@ -481,7 +537,7 @@ class CallOpRecvMessage {
 
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
-    if (message_ == nullptr) return;
+    if (message_ == nullptr || interceptor_methods == nullptr) return;
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
     if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
@@ -506,6 +562,8 @@ class CallOpRecvMessage {
   R* message_ = nullptr;
   ByteBuffer recv_buf_;
   bool allow_not_getting_message_ = false;
+  bool* partial_ = nullptr;
+  int received_partial_ = 0;
   bool hijacked_ = false;
   bool hijacked_recv_message_failed_ = false;
 };
@@ -593,9 +651,11 @@ class CallOpGenericRecvMessage {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (!deserialize_) return;
-    interceptor_methods->AddInterceptionHookPoint(
-        experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
-    if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
+    if (interceptor_methods != nullptr) {
+      interceptor_methods->AddInterceptionHookPoint(
+          experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
+      if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
+    }
     deserialize_.reset();
   }
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
@@ -756,8 +816,10 @@ class CallOpRecvInitialMetadata {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (metadata_map_ == nullptr) return;
-    interceptor_methods->AddInterceptionHookPoint(
-        experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA);
+    if (interceptor_methods != nullptr) {
+      interceptor_methods->AddInterceptionHookPoint(
+          experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA);
+    }
     metadata_map_ = nullptr;
   }
 
@@ -831,8 +893,10 @@ class CallOpClientRecvStatus {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (recv_status_ == nullptr) return;
-    interceptor_methods->AddInterceptionHookPoint(
-        experimental::InterceptionHookPoints::POST_RECV_STATUS);
+    if (interceptor_methods != nullptr) {
+      interceptor_methods->AddInterceptionHookPoint(
+          experimental::InterceptionHookPoints::POST_RECV_STATUS);
+    }
     recv_status_ = nullptr;
   }
 
@@ -881,8 +945,7 @@ class CallOpSet : public CallOpSetInterface,
       : core_cq_tag_(this),
         return_tag_(this),
         call_(other.call_),
-        done_intercepting_(false),
-        interceptor_methods_(InterceptorBatchMethodsImpl()) {}
+        done_intercepting_(false) {}
 
   CallOpSet& operator=(const CallOpSet& other) {
     if (&other == this) {
@@ -892,7 +955,8 @@ class CallOpSet : public CallOpSetInterface,
     return_tag_ = this;
     call_ = other.call_;
     done_intercepting_ = false;
-    interceptor_methods_ = InterceptorBatchMethodsImpl();
+    intercepting_ = false;
+    interceptor_methods_.reset();
     return *this;
   }
 
@@ -902,7 +966,11 @@ class CallOpSet : public CallOpSetInterface,
     call_ =
         *call;  // It's fine to create a copy of call since it's just pointers
 
-    if (RunInterceptors()) {
+    // Calls without interceptors, the common case, skip their machinery.
+    intercepting_ = !InterceptorBatchMethodsImpl::InterceptorsListEmpty(call_);
+    if (!intercepting_) {
+      ContinueFillOpsAfterInterception();
+    } else if (RunInterceptors()) {
       ContinueFillOpsAfterInterception();
     } else {
       // After the interceptors are run, ContinueFillOpsAfterInterception will
@@ -930,6 +998,17 @@ class CallOpSet : public CallOpSetInterface,
     this->Op5::FinishOp(status);
     this->Op6::FinishOp(status);
     saved_status_ = *status;
+    if (!intercepting_) {
+      this->Op1::SetFinishInterceptionHookPoint(nullptr);
+      this->Op2::SetFinishInterceptionHookPoint(nullptr);
+      this->Op3::SetFinishInterceptionHookPoint(nullptr);
+      this->Op4::SetFinishInterceptionHookPoint(nullptr);
+      this->Op5::SetFinishInterceptionHookPoint(nullptr);
+      this->Op6::SetFinishInterceptionHookPoint(nullptr);
+      *tag = return_tag_;
+      g_core_codegen_interface->grpc_call_unref(call_.call());
+      return true;
+    }
     if (RunInterceptorsPostRecv()) {
       *tag = return_tag_;
       g_core_codegen_interface->grpc_call_unref(call_.call());
@@ -953,12 +1032,12 @@ class CallOpSet : public CallOpSetInterface,
   // This will be called while interceptors are run if the RPC is a hijacked
   // RPC. This should set hijacking state for each of the ops.
   void SetHijackingState() override {
-    this->Op1::SetHijackingState(&interceptor_methods_);
-    this->Op2::SetHijackingState(&interceptor_methods_);
-    this->Op3::SetHijackingState(&interceptor_methods_);
-    this->Op4::SetHijackingState(&interceptor_methods_);
-    this->Op5::SetHijackingState(&interceptor_methods_);
-    this->Op6::SetHijackingState(&interceptor_methods_);
+    this->Op1::SetHijackingState(interceptor_methods_.get());
+    this->Op2::SetHijackingState(interceptor_methods_.get());
+    this->Op3::SetHijackingState(interceptor_methods_.get());
+    this->Op4::SetHijackingState(interceptor_methods_.get());
+    this->Op5::SetHijackingState(interceptor_methods_.get());
+    this->Op6::SetHijackingState(interceptor_methods_.get());
   }
 
   // Should be called after interceptors are done running
@@ -998,44 +1077,48 @@ class CallOpSet : public CallOpSetInterface,
   }
 
  private:
-  // Returns true if no interceptors need to be run
+  // Returns true if no interceptors need to be run. Only called for calls
+  // that have interceptors.
   bool RunInterceptors() {
-    interceptor_methods_.ClearState();
-    interceptor_methods_.SetCallOpSetInterface(this);
-    interceptor_methods_.SetCall(&call_);
-    this->Op1::SetInterceptionHookPoint(&interceptor_methods_);
-    this->Op2::SetInterceptionHookPoint(&interceptor_methods_);
-    this->Op3::SetInterceptionHookPoint(&interceptor_methods_);
-    this->Op4::SetInterceptionHookPoint(&interceptor_methods_);
-    this->Op5::SetInterceptionHookPoint(&interceptor_methods_);
-    this->Op6::SetInterceptionHookPoint(&interceptor_methods_);
-    if (interceptor_methods_.InterceptorsListEmpty()) {
-      return true;
+    if (interceptor_methods_ == nullptr) {
+      interceptor_methods_.reset(new InterceptorBatchMethodsImpl);
     }
+    interceptor_methods_->ClearState();
+    interceptor_methods_->SetCallOpSetInterface(this);
+    interceptor_methods_->SetCall(&call_);
+    this->Op1::SetInterceptionHookPoint(interceptor_methods_.get());
+    this->Op2::SetInterceptionHookPoint(interceptor_methods_.get());
+    this->Op3::SetInterceptionHookPoint(interceptor_methods_.get());
+    this->Op4::SetInterceptionHookPoint(interceptor_methods_.get());
+    this->Op5::SetInterceptionHookPoint(interceptor_methods_.get());
+    this->Op6::SetInterceptionHookPoint(interceptor_methods_.get());
     // This call will go through interceptors and would need to
     // schedule new batches, so delay completion queue shutdown
     call_.cq()->RegisterAvalanching();
-    return interceptor_methods_.RunInterceptors();
+    return interceptor_methods_->RunInterceptors();
   }
   // Returns true if no interceptors need to be run
   bool RunInterceptorsPostRecv() {
     // Call and OpSet had already been set on the set state.
     // SetReverse also clears previously set hook points
-    interceptor_methods_.SetReverse();
-    this->Op1::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    this->Op2::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    this->Op3::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    return interceptor_methods_.RunInterceptors();
+    interceptor_methods_->SetReverse();
+    this->Op1::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    this->Op2::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    this->Op3::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    this->Op4::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    this->Op5::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    this->Op6::SetFinishInterceptionHookPoint(interceptor_methods_.get());
+    return interceptor_methods_->RunInterceptors();
   }
 
   void* core_cq_tag_;
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
-  InterceptorBatchMethodsImpl interceptor_methods_;
+  // Whether the call has interceptors, which need interceptor_methods_. Most
+  // calls have none, and then don't pay for that state.
+  bool intercepting_ = false;
+  std::unique_ptr<InterceptorBatchMethodsImpl> interceptor_methods_;
   bool saved_status_;
 };
 
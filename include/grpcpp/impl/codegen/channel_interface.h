@@ -67,6 +67,7 @@ class RpcMethod;
 class InterceptedChannel;
 template <class InputMessage, class OutputMessage>
 class BlockingUnaryCallImpl;
+class BlockingCallCQ;
 }  // namespace internal
 
 /// Codegen interface for \a grpc::Channel.
@@ -130,6 +131,7 @@ class ChannelInterface {
   template <class InputMessage, class OutputMessage>
   friend class grpc::internal::CallbackUnaryCallImpl;
   friend class grpc::internal::RpcMethod;
+  friend class grpc::internal::BlockingCallCQ;
   friend class grpc::experimental::DelegatingChannel;
   friend class grpc::internal::InterceptedChannel;
   virtual internal::Call CreateCall(const internal::RpcMethod& method,
@@ -166,6 +168,14 @@ class ChannelInterface {
   // and adding a new pure method to an interface would be a breaking change
   // (even though this is private and non-API)
   virtual grpc::CompletionQueue* CallbackCQ() { return nullptr; }
+
+  // Methods to borrow a pluckable completion queue for a blocking call and to
+  // give it back once nothing is left on it, so that blocking calls need not
+  // each create and shut down a completion queue of their own. If
+  // LendPluckCQ returns nullptr, this channel keeps no spare completion
+  // queues. These have defaults for the same reason as CallbackCQ.
+  virtual grpc::CompletionQueue* LendPluckCQ() { return nullptr; }
+  virtual void ReturnPluckCQ(grpc::CompletionQueue* /*cq*/) {}
 };
 }  // namespace grpc
 
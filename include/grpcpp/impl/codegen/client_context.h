@@ -39,6 +39,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/propagation_bits.h>
@@ -75,6 +77,24 @@ class ClientCallbackWriterImpl;
 class ClientCallbackUnaryImpl;
 class ClientContextAccessor;
 class ClientAsyncResponseReaderHelper;
+
+/// The initial metadata a client call sends. Entries that
+/// ClientContext::AddMetadata copies in live in the multimap, which is what
+/// interceptors see. Entries from ClientContext::AddMetadataByReference are
+/// kept aside in \a referenced until something needs them copied in too.
+class ClientSendMetadata : public std::multimap<std::string, std::string> {
+ public:
+  /// Copies the referenced entries into the multimap.
+  void CopyReferenced() {
+    for (const auto& md : referenced) {
+      emplace(std::string(md.first.data(), md.first.length()),
+              std::string(md.second.data(), md.second.length()));
+    }
+    referenced.clear();
+  }
+
+  std::vector<std::pair<grpc::string_ref, grpc::string_ref>> referenced;
+};
 }  // namespace internal
 
 template <class R>
@@ -238,6 +258,15 @@ class ClientContext {
   **/
   void AddMetadata(const std::string& meta_key, const std::string& meta_value);
 
+  /// Add the (\a meta_key, \a meta_value) pair to the metadata associated
+  /// with a client call, like \a AddMetadata but without copying either: both
+  /// must stay valid and unchanged for as long as this context, as string
+  /// literals do. They are only copied if an interceptor is to see them.
+  void AddMetadataByReference(grpc::string_ref meta_key,
+                              grpc::string_ref meta_value) {
+    send_initial_metadata_.referenced.emplace_back(meta_key, meta_value);
+  }
+
   /// Return a collection of initial metadata key-value pairs. Note that keys
   /// may happen more than once (ie, a \a std::multimap is returned).
   ///
@@ -252,6 +281,14 @@ class ClientContext {
     return *recv_initial_metadata_.map();
   }
 
+  /// Return a view of the same initial metadata as \a
+  /// GetServerInitialMetadata(), in the order the server sent it, that is
+  /// made without building a multimap. The same warning applies.
+  grpc::MetadataView GetServerInitialMetadataView() const {
+    GPR_CODEGEN_ASSERT(initial_metadata_received_);
+    return recv_initial_metadata_.view();
+  }
+
   /// Return a collection of trailing metadata key-value pairs. Note that keys
   /// may happen more than once (ie, a \a std::multimap is returned).
   ///
@@ -264,6 +301,13 @@ class ClientContext {
     return *trailing_metadata_.map();
   }
 
+  /// Return a view of the same trailing metadata as \a
+  /// GetServerTrailingMetadata(), in the order the server sent it, that is
+  /// made without building a multimap. The same warning applies.
+  grpc::MetadataView GetServerTrailingMetadataView() const {
+    return trailing_metadata_.view();
+  }
+
   /// Set the deadline for the client call.
   ///
   /// \warning This method should only be called before invoking the rpc.
@@ -290,6 +334,14 @@ class ClientContext {
   /// DEPRECATED: Use set_wait_for_ready() instead.
   void set_fail_fast(bool fail_fast) { set_wait_for_ready(!fail_fast); }
 
+  /// EXPERIMENTAL: Mark this (unary) request as cacheable: its response only
+  /// depends on its method, authority and request message. A channel created
+  /// with the GRPC_ARG_RESPONSE_CACHE_SIZE channel argument may then answer it
+  /// with an earlier response to the same request, without sending it, and
+  /// one created with GRPC_ARG_COALESCE_CACHEABLE_CALLS with the response to
+  /// the same request in flight.
+  void set_cacheable(bool cacheable) { cacheable_ = cacheable; }
+
   /// Return the deadline for the client call.
   std::chrono::system_clock::time_point deadline() const {
     return grpc::Timespec2Timepoint(deadline_);
@@ -475,7 +527,8 @@ class ClientContext {
     return (wait_for_ready_ ? GRPC_INITIAL_METADATA_WAIT_FOR_READY : 0) |
            (wait_for_ready_explicitly_set_
                 ? GRPC_INITIAL_METADATA_WAIT_FOR_READY_EXPLICITLY_SET
-                : 0);
+                : 0) |
+           (cacheable_ ? GRPC_INITIAL_METADATA_CACHEABLE_REQUEST : 0);
   }
 
   std::string authority() { return authority_; }
@@ -489,6 +542,7 @@ class ClientContext {
   bool initial_metadata_received_;
   bool wait_for_ready_;
   bool wait_for_ready_explicitly_set_;
+  bool cacheable_;
   std::shared_ptr<grpc::Channel> channel_;
   grpc::internal::Mutex mu_;
   grpc_call* call_;
@@ -498,7 +552,7 @@ class ClientContext {
   std::shared_ptr<grpc::CallCredentials> creds_;
   mutable std::shared_ptr<const grpc::AuthContext> auth_context_;
   struct census_context* census_context_;
-  std::multimap<std::string, std::string> send_initial_metadata_;
+  grpc::internal::ClientSendMetadata send_initial_metadata_;
   mutable grpc::internal::MetadataMap recv_initial_metadata_;
   mutable grpc::internal::MetadataMap trailing_metadata_;
 
@@ -73,6 +73,10 @@ template <class ServiceType, class RequestType, class ResponseType>
 class ClientStreamingHandler;
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaClientStreamingHandler;
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaServerStreamingHandler;
 template <class Streamer, bool WriteNeeded>
 class TemplatedBidiStreamingHandler;
 template <grpc::StatusCode code>
@@ -91,6 +95,7 @@ class CompletionQueueTag;
 class RpcMethod;
 template <class InputMessage, class OutputMessage>
 class BlockingUnaryCallImpl;
+class BlockingCallCQ;
 template <class Op1, class Op2, class Op3, class Op4, class Op5, class Op6>
 class CallOpSet;
 }  // namespace internal
@@ -108,7 +113,7 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
   CompletionQueue()
       : CompletionQueue(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, GRPC_CQ_NEXT, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}) {}
+            nullptr, 0, 0, 0}) {}
 
   /// Wrap \a take, taking ownership of the instance.
   ///
@@ -187,6 +192,24 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) == GOT_EVENT);
   }
 
+  /// EXPERIMENTAL
+  /// Read up to \a max events from the queue, blocking until at least one is
+  /// available or the queue is fully drained and shut down. Events that are
+  /// already queued when the first one arrives are returned together, so a
+  /// caller that handles many events per wakeup pays for a single wakeup.
+  /// Must only be used on queues that can also be read with \a Next.
+  ///
+  /// \param[out] tags Updated to point to the tags of the events read.
+  /// \param[out] oks Updated with the \a ok of each event read, in the same
+  ///        order as \a tags. See documentation for CompletionQueue::Next for
+  ///        explanation of ok.
+  /// \param[in] max Number of entries in \a tags and \a oks. Must be at
+  ///        least one.
+  ///
+  /// \return The number of events read (at most \a max), or 0 if the queue
+  ///         is fully drained and shut down.
+  size_t NextBatch(void** tags, bool* oks, size_t max);
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
@@ -286,6 +309,10 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
   friend class grpc::internal::ClientStreamingHandler;
   template <class ServiceType, class RequestType, class ResponseType>
   friend class grpc::internal::ServerStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class grpc::internal::ProtoArenaClientStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class grpc::internal::ProtoArenaServerStreamingHandler;
   template <class Streamer, bool WriteNeeded>
   friend class grpc::internal::TemplatedBidiStreamingHandler;
   template <grpc::StatusCode code>
@@ -297,6 +324,7 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
 
   // Friends that need access to constructor for callback CQ
   friend class grpc::Channel;
+  friend class grpc::internal::BlockingCallCQ;
 
   // For access to Register/CompleteAvalanching
   template <class Op1, class Op2, class Op3, class Op4, class Op5, class Op6>
@@ -431,6 +459,28 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
       server_list_ /* GUARDED_BY(server_list_mutex_) */;
 };
 
+namespace internal {
+/// The pluckable completion queue of one blocking call. It is borrowed from
+/// the channel of the call when the channel keeps spare ones, and created for
+/// the call alone otherwise. It goes back to the channel on destruction, so it
+/// must have nothing left on it by then.
+class BlockingCallCQ {
+ public:
+  explicit BlockingCallCQ(grpc::ChannelInterface* channel);
+  ~BlockingCallCQ();
+
+  BlockingCallCQ(const BlockingCallCQ&) = delete;
+  BlockingCallCQ& operator=(const BlockingCallCQ&) = delete;
+
+  grpc::CompletionQueue* get() const { return cq_; }
+  grpc::CompletionQueue* operator->() const { return cq_; }
+
+ private:
+  grpc::ChannelInterface* channel_;  // the lender of cq_, if any
+  grpc::CompletionQueue* cq_;
+};
+}  // namespace internal
+
 /// A specific type of completion queue used by the processing of notifications
 /// by servers. Instantiated by \a ServerBuilder or Server (for health checker).
 class ServerCompletionQueue : public CompletionQueue {
@@ -448,12 +498,15 @@ class ServerCompletionQueue : public CompletionQueue {
   /// allowed on this completion queue. See grpc_cq_polling_type's description
   /// in grpc_types.h for more details.
   /// \param shutdown_cb is the shutdown callback used for CALLBACK api queues
+  /// \param pin_cpu if not negative, the CPU that threads calling Next() on
+  /// this queue are pinned to.
   ServerCompletionQueue(grpc_cq_completion_type completion_type,
                         grpc_cq_polling_type polling_type,
-                        grpc_completion_queue_functor* shutdown_cb)
+                        grpc_completion_queue_functor* shutdown_cb,
+                        int pin_cpu = -1)
       : CompletionQueue(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, completion_type, polling_type,
-            shutdown_cb}),
+            shutdown_cb, 0, pin_cpu >= 0, pin_cpu}),
         polling_type_(polling_type) {}
 
   grpc_cq_polling_type polling_type_;
@@ -35,6 +35,12 @@
 #endif
 #endif
 
+#ifndef GRPC_CUSTOM_ARENA
+#include <google/protobuf/arena.h>
+#define GRPC_CUSTOM_ARENA ::google::protobuf::Arena
+#define GRPC_CUSTOM_ARENAOPTIONS ::google::protobuf::ArenaOptions
+#endif
+
 #ifndef GRPC_CUSTOM_DESCRIPTOR
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/descriptor.pb.h>
@@ -65,6 +71,11 @@
 #define GRPC_CUSTOM_CODEDINPUTSTREAM ::google::protobuf::io::CodedInputStream
 #endif
 
+#ifndef GRPC_CUSTOM_CODEDOUTPUTSTREAM
+#include <google/protobuf/io/coded_stream.h>
+#define GRPC_CUSTOM_CODEDOUTPUTSTREAM ::google::protobuf::io::CodedOutputStream
+#endif
+
 #ifndef GRPC_CUSTOM_JSONUTIL
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/util/type_resolver_util.h>
@@ -72,12 +83,23 @@
 #define GRPC_CUSTOM_UTIL_STATUS ::google::protobuf::util::Status
 #endif
 
+// Protobuf 22 lets a ZeroCopyInputStream hand the bytes of [ctype = CORD]
+// fields to the parser as a cord, which ProtoBufferReader builds out of the
+// slices of the message rather than copying them.
+#if !defined(GRPC_PROTOBUF_CORD_SUPPORT_ENABLED) && \
+    defined(GOOGLE_PROTOBUF_VERSION) && GOOGLE_PROTOBUF_VERSION >= 4022000
+#define GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#endif
+
 namespace grpc {
 namespace protobuf {
 
 typedef GRPC_CUSTOM_MESSAGE Message;
 typedef GRPC_CUSTOM_MESSAGELITE MessageLite;
 
+typedef GRPC_CUSTOM_ARENA Arena;
+typedef GRPC_CUSTOM_ARENAOPTIONS ArenaOptions;
+
 typedef GRPC_CUSTOM_DESCRIPTOR Descriptor;
 typedef GRPC_CUSTOM_DESCRIPTORPOOL DescriptorPool;
 typedef GRPC_CUSTOM_DESCRIPTORDATABASE DescriptorDatabase;
@@ -100,6 +122,7 @@ namespace io {
 typedef GRPC_CUSTOM_ZEROCOPYOUTPUTSTREAM ZeroCopyOutputStream;
 typedef GRPC_CUSTOM_ZEROCOPYINPUTSTREAM ZeroCopyInputStream;
 typedef GRPC_CUSTOM_CODEDINPUTSTREAM CodedInputStream;
+typedef GRPC_CUSTOM_CODEDOUTPUTSTREAM CodedOutputStream;
 }  // namespace io
 
 }  // namespace protobuf
@@ -84,6 +84,14 @@ class DelegatingChannel : public grpc::ChannelInterface {
     return delegate_channel()->CallbackCQ();
   }
 
+  grpc::CompletionQueue* LendPluckCQ() final {
+    return delegate_channel()->LendPluckCQ();
+  }
+
+  void ReturnPluckCQ(grpc::CompletionQueue* cq) final {
+    delegate_channel()->ReturnPluckCQ(cq);
+  }
+
   std::shared_ptr<grpc::ChannelInterface> delegate_channel_;
 };
 
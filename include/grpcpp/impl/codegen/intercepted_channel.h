@@ -74,6 +74,13 @@ class InterceptedChannel : public ChannelInterface {
     return channel_->CallbackCQ();
   }
 
+  grpc::CompletionQueue* LendPluckCQ() override {
+    return channel_->LendPluckCQ();
+  }
+  void ReturnPluckCQ(grpc::CompletionQueue* cq) override {
+    channel_->ReturnPluckCQ(cq);
+  }
+
   ChannelInterface* channel_;
   size_t interceptor_pos_;
 
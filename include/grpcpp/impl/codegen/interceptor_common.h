@@ -221,13 +221,16 @@ class InterceptorBatchMethodsImpl
 
   // SetCall should have been called before this.
   // Returns true if the interceptors list is empty
-  bool InterceptorsListEmpty() {
-    auto* client_rpc_info = call_->client_rpc_info();
+  bool InterceptorsListEmpty() { return InterceptorsListEmpty(*call_); }
+
+  // Returns true if \a call has no interceptors, without needing an instance
+  static bool InterceptorsListEmpty(const Call& call) {
+    auto* client_rpc_info = call.client_rpc_info();
     if (client_rpc_info != nullptr) {
       return client_rpc_info->interceptors_.empty();
     }
 
-    auto* server_rpc_info = call_->server_rpc_info();
+    auto* server_rpc_info = call.server_rpc_info();
     return server_rpc_info == nullptr || server_rpc_info->interceptors_.empty();
   }
 
@@ -21,13 +21,86 @@
 
 // IWYU pragma: private
 
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <utility>
 
 #include <grpc/impl/codegen/log.h>
 #include <grpcpp/impl/codegen/slice.h>
+#include <grpcpp/impl/codegen/string_ref.h>
 
 namespace grpc {
 
+/// A read-only view of received metadata, in the order it arrived, straight
+/// over the array that gRPC core fills in. Unlike the multimaps returned by
+/// ServerContext::client_metadata() and the like, it costs no allocation to
+/// make or to walk; in exchange, looking up a key takes linear time. A view is
+/// valid for as long as the context it came from.
+class MetadataView {
+ public:
+  using value_type = std::pair<grpc::string_ref, grpc::string_ref>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = MetadataView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    value_type operator*() const {
+      return value_type(StringRefFromSlice(&md_->key),
+                        StringRefFromSlice(&md_->value));
+    }
+    const_iterator& operator++() {
+      ++md_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator prev = *this;
+      ++md_;
+      return prev;
+    }
+    bool operator==(const const_iterator& other) const {
+      return md_ == other.md_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return md_ != other.md_;
+    }
+
+   private:
+    friend class MetadataView;
+    explicit const_iterator(const grpc_metadata* md) : md_(md) {}
+
+    const grpc_metadata* md_;
+  };
+
+  explicit MetadataView(const grpc_metadata_array& arr) : arr_(&arr) {}
+
+  size_t size() const { return arr_->count; }
+  bool empty() const { return arr_->count == 0; }
+  const_iterator begin() const { return const_iterator(arr_->metadata); }
+  const_iterator end() const {
+    return const_iterator(arr_->metadata + arr_->count);
+  }
+
+  /// Sets \a value to the value of the first entry with key \a key and
+  /// returns true, or returns false if there is no such entry.
+  bool Find(grpc::string_ref key, grpc::string_ref* value) const {
+    for (size_t i = 0; i < arr_->count; i++) {
+      if (StringRefFromSlice(&arr_->metadata[i].key) == key) {
+        *value = StringRefFromSlice(&arr_->metadata[i].value);
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  const grpc_metadata_array* arr_;
+};
+
 namespace internal {
 
 const char kBinaryErrorDetailsKey[] = "grpc-status-details-bin";
@@ -70,6 +143,7 @@ class MetadataMap {
     return &map_;
   }
   grpc_metadata_array* arr() { return &arr_; }
+  grpc::MetadataView view() const { return grpc::MetadataView(arr_); }
 
   void Reset() {
     filled_ = false;
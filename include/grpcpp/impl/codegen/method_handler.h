@@ -399,6 +399,8 @@ typedef ErrorMethodHandler<grpc::StatusCode::UNIMPLEMENTED>
     UnknownMethodHandler;
 typedef ErrorMethodHandler<grpc::StatusCode::RESOURCE_EXHAUSTED>
     ResourceExhaustedHandler;
+typedef ErrorMethodHandler<grpc::StatusCode::DEADLINE_EXCEEDED>
+    DeadlineExceededHandler;
 
 }  // namespace internal
 }  // namespace grpc
@@ -0,0 +1,284 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_PROTO_ARENA_METHOD_HANDLER_H
+#define GRPCPP_IMPL_CODEGEN_PROTO_ARENA_METHOD_HANDLER_H
+
+// IWYU pragma: private
+
+/// Method handlers and a message allocator that place the request and
+/// response messages of a call in a protobuf arena, so that parsing and
+/// building large messages doesn't do a heap allocation per field. They are
+/// used by code generated with the use_arena_messages option.
+
+#include <stddef.h>
+
+#include <functional>
+
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/method_handler.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+
+namespace grpc {
+
+namespace internal {
+
+/// A protobuf arena whose first block is inline, so that typical messages
+/// need no heap allocation at all.
+class ProtoArenaState {
+ public:
+  ProtoArenaState() : arena_(Options()) {}
+  ProtoArenaState(const ProtoArenaState&) = delete;
+  ProtoArenaState& operator=(const ProtoArenaState&) = delete;
+
+  grpc::protobuf::Arena* arena() { return &arena_; }
+
+ private:
+  static constexpr size_t kInitialBlockSize = 1024;
+
+  grpc::protobuf::ArenaOptions Options() {
+    grpc::protobuf::ArenaOptions options;
+    options.initial_block = initial_block_;
+    options.initial_block_size = sizeof(initial_block_);
+    return options;
+  }
+
+  alignas(8) char initial_block_[kInitialBlockSize];
+  grpc::protobuf::Arena arena_;
+};
+
+/// Returns the protobuf arena state of a call, creating it in the call arena
+/// if the handler's Deserialize did not.
+inline ProtoArenaState* ProtoArenaStateForCall(
+    const MethodHandler::HandlerParameter& param) {
+  if (param.internal_data != nullptr) {
+    return static_cast<ProtoArenaState*>(param.internal_data);
+  }
+  return new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
+      param.call->call(), sizeof(ProtoArenaState))) ProtoArenaState;
+}
+
+/// Deserializes \a req into a RequestType created on a protobuf arena that
+/// lives in the call arena. The arena is returned through \a handler_data and
+/// must be destroyed by RunHandler.
+template <class RequestType>
+void* ProtoArenaDeserialize(grpc_call* call, grpc_byte_buffer* req,
+                            grpc::Status* status, void** handler_data) {
+  auto* state = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
+      call, sizeof(ProtoArenaState))) ProtoArenaState;
+  *handler_data = state;
+  auto* request =
+      grpc::protobuf::Arena::CreateMessage<RequestType>(state->arena());
+  grpc::ByteBuffer buf;
+  buf.set_buffer(req);
+  *status = grpc::SerializationTraits<grpc::protobuf::MessageLite>::Deserialize(
+      &buf, static_cast<grpc::protobuf::MessageLite*>(request));
+  buf.Release();
+  return status->ok() ? request : nullptr;
+}
+
+/// An RpcMethodHandler whose messages live in a protobuf arena.
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaRpcMethodHandler : public grpc::internal::MethodHandler {
+ public:
+  ProtoArenaRpcMethodHandler(
+      std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                                 const RequestType*, ResponseType*)>
+          func,
+      ServiceType* service)
+      : func_(func), service_(service) {}
+
+  void RunHandler(const HandlerParameter& param) final {
+    ProtoArenaState* state = ProtoArenaStateForCall(param);
+    auto* rsp =
+        grpc::protobuf::Arena::CreateMessage<ResponseType>(state->arena());
+    grpc::Status status = param.status;
+    if (status.ok()) {
+      status = CatchingFunctionHandler([this, &param, rsp] {
+        return func_(service_,
+                     static_cast<grpc::ServerContext*>(param.server_context),
+                     static_cast<RequestType*>(param.request), rsp);
+      });
+    }
+    UnaryRunHandlerHelper(param, static_cast<grpc::protobuf::MessageLite*>(rsp),
+                          status);
+    state->~ProtoArenaState();
+  }
+
+  void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
+                    grpc::Status* status, void** handler_data) final {
+    return ProtoArenaDeserialize<RequestType>(call, req, status, handler_data);
+  }
+
+ private:
+  std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                             const RequestType*, ResponseType*)>
+      func_;
+  ServiceType* service_;
+};
+
+/// A ClientStreamingHandler whose response lives in a protobuf arena. The
+/// requests are read into messages owned by the application.
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaClientStreamingHandler : public grpc::internal::MethodHandler {
+ public:
+  ProtoArenaClientStreamingHandler(
+      std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                                 ServerReader<RequestType>*, ResponseType*)>
+          func,
+      ServiceType* service)
+      : func_(func), service_(service) {}
+
+  void RunHandler(const HandlerParameter& param) final {
+    ProtoArenaState* state = ProtoArenaStateForCall(param);
+    ServerReader<RequestType> reader(
+        param.call, static_cast<grpc::ServerContext*>(param.server_context));
+    auto* rsp =
+        grpc::protobuf::Arena::CreateMessage<ResponseType>(state->arena());
+    grpc::Status status = CatchingFunctionHandler([this, &param, &reader, rsp] {
+      return func_(service_,
+                   static_cast<grpc::ServerContext*>(param.server_context),
+                   &reader, rsp);
+    });
+
+    grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
+                              grpc::internal::CallOpSendMessage,
+                              grpc::internal::CallOpServerSendStatus>
+        ops;
+    if (!param.server_context->sent_initial_metadata_) {
+      ops.SendInitialMetadata(&param.server_context->initial_metadata_,
+                              param.server_context->initial_metadata_flags());
+      if (param.server_context->compression_level_set()) {
+        ops.set_compression_level(param.server_context->compression_level());
+      }
+    }
+    if (status.ok()) {
+      status =
+          ops.SendMessagePtr(static_cast<grpc::protobuf::MessageLite*>(rsp));
+    }
+    ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
+    param.call->PerformOps(&ops);
+    param.call->cq()->Pluck(&ops);
+    state->~ProtoArenaState();
+  }
+
+ private:
+  std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                             ServerReader<RequestType>*, ResponseType*)>
+      func_;
+  ServiceType* service_;
+};
+
+/// A ServerStreamingHandler whose request lives in a protobuf arena. The
+/// responses are written from messages owned by the application.
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaServerStreamingHandler : public grpc::internal::MethodHandler {
+ public:
+  ProtoArenaServerStreamingHandler(
+      std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                                 const RequestType*,
+                                 ServerWriter<ResponseType>*)>
+          func,
+      ServiceType* service)
+      : func_(func), service_(service) {}
+
+  void RunHandler(const HandlerParameter& param) final {
+    ProtoArenaState* state = ProtoArenaStateForCall(param);
+    grpc::Status status = param.status;
+    if (status.ok()) {
+      ServerWriter<ResponseType> writer(
+          param.call, static_cast<grpc::ServerContext*>(param.server_context));
+      status = CatchingFunctionHandler([this, &param, &writer] {
+        return func_(service_,
+                     static_cast<grpc::ServerContext*>(param.server_context),
+                     static_cast<RequestType*>(param.request), &writer);
+      });
+    }
+
+    grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
+                              grpc::internal::CallOpServerSendStatus>
+        ops;
+    if (!param.server_context->sent_initial_metadata_) {
+      ops.SendInitialMetadata(&param.server_context->initial_metadata_,
+                              param.server_context->initial_metadata_flags());
+      if (param.server_context->compression_level_set()) {
+        ops.set_compression_level(param.server_context->compression_level());
+      }
+    }
+    ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
+    param.call->PerformOps(&ops);
+    if (param.server_context->has_pending_ops_) {
+      param.call->cq()->Pluck(&param.server_context->pending_ops_);
+    }
+    param.call->cq()->Pluck(&ops);
+    state->~ProtoArenaState();
+  }
+
+  void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
+                    grpc::Status* status, void** handler_data) final {
+    return ProtoArenaDeserialize<RequestType>(call, req, status, handler_data);
+  }
+
+ private:
+  std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
+                             const RequestType*, ServerWriter<ResponseType>*)>
+      func_;
+  ServiceType* service_;
+};
+
+/// A MessageAllocator for callback unary methods that creates both messages
+/// of an RPC in a protobuf arena. The arena and its first block are a single
+/// allocation.
+template <class RequestType, class ResponseType>
+class ProtoArenaMessageAllocator
+    : public MessageAllocator<RequestType, ResponseType> {
+ public:
+  /// The allocator shared by all the methods of this signature; it lives for
+  /// the lifetime of the process.
+  static ProtoArenaMessageAllocator* Get() {
+    static auto* allocator = new ProtoArenaMessageAllocator;
+    return allocator;
+  }
+
+  MessageHolder<RequestType, ResponseType>* AllocateMessages() override {
+    return new Holder;
+  }
+
+ private:
+  class Holder : public MessageHolder<RequestType, ResponseType> {
+   public:
+    Holder() {
+      this->set_request(
+          grpc::protobuf::Arena::CreateMessage<RequestType>(state_.arena()));
+      this->set_response(
+          grpc::protobuf::Arena::CreateMessage<ResponseType>(state_.arena()));
+    }
+    void Release() override { delete this; }
+
+   private:
+    ProtoArenaState state_;
+  };
+};
+
+}  // namespace internal
+
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_PROTO_ARENA_METHOD_HANDLER_H
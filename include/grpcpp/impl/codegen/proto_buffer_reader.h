@@ -21,6 +21,7 @@
 
 // IWYU pragma: private, include <grpcpp/support/proto_buffer_reader.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include <grpc/impl/codegen/byte_buffer_reader.h>
@@ -32,6 +33,11 @@
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/support/byte_buffer.h>
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#endif
+
 /// This header provides an object that reads bytes directly from a
 /// grpc::ByteBuffer, via the ZeroCopyInputStream interface
 
@@ -125,6 +131,46 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   /// Returns the total number of bytes read since this object was created.
   int64_t ByteCount() const override { return byte_count_ - backup_count_; }
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// The proto library calls this to read \a count bytes of a cord field.
+  /// The cord refers to the slices of the byte buffer rather than copying
+  /// them, however many slices the field spans.
+  bool ReadCord(absl::Cord* cord, int count) override {
+    if (!status_.ok()) {
+      return false;
+    }
+    /// The backed-up bytes of the current slice come first
+    if (backup_count_ > 0) {
+      const size_t begin = GRPC_SLICE_LENGTH(*slice_) - backup_count_;
+      const int64_t taken = std::min<int64_t>(backup_count_, count);
+      AppendSlice(cord, g_core_codegen_interface->grpc_slice_sub(
+                            *slice_, begin, begin + taken));
+      backup_count_ -= taken;
+      count -= static_cast<int>(taken);
+    }
+    while (count > 0) {
+      if (!g_core_codegen_interface->grpc_byte_buffer_reader_peek(&reader_,
+                                                                  &slice_)) {
+        return false;
+      }
+      GPR_CODEGEN_ASSERT(GRPC_SLICE_LENGTH(*slice_) <= INT_MAX);
+      const int length = static_cast<int>(GRPC_SLICE_LENGTH(*slice_));
+      byte_count_ += length;
+      if (length <= count) {
+        AppendSlice(cord, g_core_codegen_interface->grpc_slice_ref(*slice_));
+        count -= length;
+      } else {
+        /// Back up past the end of the field, for the next Next
+        AppendSlice(cord, g_core_codegen_interface->grpc_slice_sub(
+                              *slice_, 0, static_cast<size_t>(count)));
+        backup_count_ = length - count;
+        count = 0;
+      }
+    }
+    return true;
+  }
+#endif
+
   // These protected members are needed to support internal optimizations.
   // they expose internal bits of grpc core that are NOT stable. If you have
   // a use case needs to use one of these functions, please send an email to
@@ -138,6 +184,26 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   grpc_slice** mutable_slice_ptr() { return &slice_; }
 
  private:
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// Appends \a slice to \a cord, taking its ref. Small slices are copied:
+  /// a cord node referring to one would cost more than its bytes.
+  static void AppendSlice(absl::Cord* cord, grpc_slice slice) {
+    absl::string_view bytes(
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+        GRPC_SLICE_LENGTH(slice));
+    if (slice.refcount == nullptr || bytes.size() < kMinCordSliceSize) {
+      cord->Append(bytes);
+      g_core_codegen_interface->grpc_slice_unref(slice);
+      return;
+    }
+    cord->Append(absl::MakeCordFromExternal(bytes, [slice](absl::string_view) {
+      g_core_codegen_interface->grpc_slice_unref(slice);
+    }));
+  }
+
+  static constexpr size_t kMinCordSliceSize = 512;
+#endif
+
   int64_t byte_count_;              ///< total bytes read since object creation
   int64_t backup_count_;            ///< how far backed up in the stream we are
   grpc_byte_buffer_reader reader_;  ///< internal object to read \a grpc_slice
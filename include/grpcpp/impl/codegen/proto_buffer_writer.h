@@ -154,6 +154,24 @@ class ProtoBufferWriter : public grpc::protobuf::io::ZeroCopyOutputStream {
   /// Returns the total number of bytes written since this object was created.
   int64_t ByteCount() const override { return byte_count_; }
 
+  /// Aliased writes only happen when the serializer enabled aliasing on its
+  /// CodedOutputStream, which makes it responsible for keeping the data alive
+  /// for the lifetime of the byte buffer.
+  bool AllowsAliasing() const override { return true; }
+
+  /// Add \a size bytes at \a data to the byte buffer by reference, without
+  /// copying them. Protobuf backs up the unused part of the last buffer
+  /// before an aliased write, so the data lands right after the bytes
+  /// written so far.
+  bool WriteAliasedRaw(const void* data, int size) override {
+    GPR_CODEGEN_ASSERT(byte_count_ + size <= total_size_);
+    g_core_codegen_interface->grpc_slice_buffer_add_indexed(
+        slice_buffer_, g_core_codegen_interface->grpc_slice_from_static_buffer(
+                           data, static_cast<size_t>(size)));
+    byte_count_ += size;
+    return true;
+  }
+
   // These protected members are needed to support internal optimizations.
   // they expose internal bits of grpc core that are NOT stable. If you have
   // a use case needs to use one of these functions, please send an email to
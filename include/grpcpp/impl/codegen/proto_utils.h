@@ -68,6 +68,47 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
              : Status(StatusCode::INTERNAL, "Failed to serialize message");
 }
 
+// Serializes msg into a single slice of exactly msg.ByteSizeLong() bytes with
+// protobuf's flat array serializer. For large messages this avoids both the
+// stream overhead and splitting the output into
+// kProtoBufferWriterMaxBufferLength sized slices.
+inline Status GenericSerializeExact(const grpc::protobuf::MessageLite& msg,
+                                    ByteBuffer* bb, bool* own_buffer) {
+  *own_buffer = true;
+  Slice slice(msg.ByteSizeLong());
+  GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
+                                        const_cast<uint8_t*>(slice.begin())));
+  ByteBuffer tmp(&slice, 1);
+  bb->Swap(&tmp);
+  return g_core_codegen_interface->ok();
+}
+
+// Like GenericSerialize, but the string and bytes fields that protobuf is
+// willing to alias are added to bb by reference instead of being copied. The
+// caller must keep msg alive and unmodified for as long as bb or any copy of
+// it is in use, e.g. until the write that sends it has completed.
+// ProtoBufferWriter must be a subclass of ::protobuf::io::ZeroCopyOutputStream.
+template <class ProtoBufferWriter>
+Status GenericSerializeAliased(const grpc::protobuf::MessageLite& msg,
+                               ByteBuffer* bb, bool* own_buffer) {
+  static_assert(std::is_base_of<protobuf::io::ZeroCopyOutputStream,
+                                ProtoBufferWriter>::value,
+                "ProtoBufferWriter must be a subclass of "
+                "::protobuf::io::ZeroCopyOutputStream");
+  *own_buffer = true;
+  int byte_size = static_cast<int>(msg.ByteSizeLong());
+  ProtoBufferWriter writer(bb, kProtoBufferWriterMaxBufferLength, byte_size);
+  bool failed;
+  {
+    protobuf::io::CodedOutputStream output(&writer);
+    output.EnableAliasing(true);
+    msg.SerializeWithCachedSizes(&output);
+    failed = output.HadError();
+  }
+  return failed ? Status(StatusCode::INTERNAL, "Failed to serialize message")
+                : g_core_codegen_interface->ok();
+}
+
 // BufferReader must be a subclass of ::protobuf::io::ZeroCopyInputStream.
 template <class ProtoBufferReader, class T>
 Status GenericDeserialize(ByteBuffer* buffer,
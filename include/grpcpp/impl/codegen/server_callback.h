@@ -227,6 +227,8 @@ class ServerCallbackWriter : public internal::ServerCallbackCall {
   virtual void Finish(grpc::Status s) = 0;
   virtual void SendInitialMetadata() = 0;
   virtual void Write(const Response* msg, grpc::WriteOptions options) = 0;
+  virtual void WriteSerialized(const grpc::ByteBuffer& msg,
+                               grpc::WriteOptions options) = 0;
   virtual void WriteAndFinish(const Response* msg, grpc::WriteOptions options,
                               grpc::Status s) = 0;
 
@@ -245,6 +247,8 @@ class ServerCallbackReaderWriter : public internal::ServerCallbackCall {
   virtual void SendInitialMetadata() = 0;
   virtual void Read(Request* msg) = 0;
   virtual void Write(const Response* msg, grpc::WriteOptions options) = 0;
+  virtual void WriteSerialized(const grpc::ByteBuffer& msg,
+                               grpc::WriteOptions options) = 0;
   virtual void WriteAndFinish(const Response* msg, grpc::WriteOptions options,
                               grpc::Status s) = 0;
 
@@ -343,6 +347,38 @@ class ServerBidiReactor : public internal::ServerReactor {
     stream->Write(resp, options);
   }
 
+  /// EXPERIMENTAL: Initiate a write operation of a message already serialized
+  /// into a byte buffer (see \a SerializationTraits), with specified options.
+  /// Only the slices of the buffer are referenced, so the same buffer can be
+  /// written to many streams at the cost of serializing it once. A buffer
+  /// compressed with \a ByteBuffer::Compress must only be written to calls
+  /// using that same compression algorithm (see
+  /// \a CallbackServerContext::set_compression_algorithm).
+  ///
+  /// \param[in] resp The serialized message to be written. Unlike with
+  ///                 StartWrite, it may be deleted or modified as soon as this
+  ///                 returns.
+  /// \param[in] options The WriteOptions to use for writing this message
+  void StartWriteSerialized(const grpc::ByteBuffer& resp,
+                            grpc::WriteOptions options)
+      ABSL_LOCKS_EXCLUDED(stream_mu_) {
+    ServerCallbackReaderWriter<Request, Response>* stream =
+        stream_.load(std::memory_order_acquire);
+    if (stream == nullptr) {
+      grpc::internal::MutexLock l(&stream_mu_);
+      stream = stream_.load(std::memory_order_relaxed);
+      if (stream == nullptr) {
+        backlog_.serialized_write_wanted = resp;
+        backlog_.write_options_wanted = options;
+        return;
+      }
+    }
+    stream->WriteSerialized(resp, options);
+  }
+  void StartWriteSerialized(const grpc::ByteBuffer& resp) {
+    StartWriteSerialized(resp, grpc::WriteOptions());
+  }
+
   /// Initiate a write operation with specified options and final RPC Status,
   /// which also causes any trailing metadata for this RPC to be sent out.
   /// StartWriteAndFinish is like merging StartWriteLast and Finish into a
@@ -460,6 +496,10 @@ class ServerBidiReactor : public internal::ServerReactor {
       if (GPR_UNLIKELY(backlog_.write_wanted != nullptr)) {
         stream->Write(backlog_.write_wanted,
                       std::move(backlog_.write_options_wanted));
+      } else if (GPR_UNLIKELY(backlog_.serialized_write_wanted.Valid())) {
+        stream->WriteSerialized(backlog_.serialized_write_wanted,
+                                std::move(backlog_.write_options_wanted));
+        backlog_.serialized_write_wanted.Clear();
       }
       if (GPR_UNLIKELY(backlog_.finish_wanted)) {
         stream->Finish(std::move(backlog_.status_wanted));
@@ -481,6 +521,7 @@ class ServerBidiReactor : public internal::ServerReactor {
     bool finish_wanted = false;
     Request* read_wanted = nullptr;
     const Response* write_wanted = nullptr;
+    grpc::ByteBuffer serialized_write_wanted;
     grpc::WriteOptions write_options_wanted;
     grpc::Status status_wanted;
   };
@@ -614,6 +655,26 @@ class ServerWriteReactor : public internal::ServerReactor {
     }
     writer->Write(resp, options);
   }
+  /// EXPERIMENTAL: Exactly like ServerBidiReactor.
+  void StartWriteSerialized(const grpc::ByteBuffer& resp,
+                            grpc::WriteOptions options)
+      ABSL_LOCKS_EXCLUDED(writer_mu_) {
+    ServerCallbackWriter<Response>* writer =
+        writer_.load(std::memory_order_acquire);
+    if (writer == nullptr) {
+      grpc::internal::MutexLock l(&writer_mu_);
+      writer = writer_.load(std::memory_order_relaxed);
+      if (writer == nullptr) {
+        backlog_.serialized_write_wanted = resp;
+        backlog_.write_options_wanted = options;
+        return;
+      }
+    }
+    writer->WriteSerialized(resp, options);
+  }
+  void StartWriteSerialized(const grpc::ByteBuffer& resp) {
+    StartWriteSerialized(resp, grpc::WriteOptions());
+  }
   void StartWriteAndFinish(const Response* resp, grpc::WriteOptions options,
                            grpc::Status s) ABSL_LOCKS_EXCLUDED(writer_mu_) {
     ServerCallbackWriter<Response>* writer =
@@ -674,6 +735,10 @@ class ServerWriteReactor : public internal::ServerReactor {
       if (GPR_UNLIKELY(backlog_.write_wanted != nullptr)) {
         writer->Write(backlog_.write_wanted,
                       std::move(backlog_.write_options_wanted));
+      } else if (GPR_UNLIKELY(backlog_.serialized_write_wanted.Valid())) {
+        writer->WriteSerialized(backlog_.serialized_write_wanted,
+                                std::move(backlog_.write_options_wanted));
+        backlog_.serialized_write_wanted.Clear();
       }
       if (GPR_UNLIKELY(backlog_.finish_wanted)) {
         writer->Finish(std::move(backlog_.status_wanted));
@@ -690,6 +755,7 @@ class ServerWriteReactor : public internal::ServerReactor {
     bool write_and_finish_wanted = false;
     bool finish_wanted = false;
     const Response* write_wanted = nullptr;
+    grpc::ByteBuffer serialized_write_wanted;
     grpc::WriteOptions write_options_wanted;
     grpc::Status status_wanted;
   };
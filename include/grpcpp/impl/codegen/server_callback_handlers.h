@@ -210,8 +210,10 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
         ctx_->context_allocator()->Release(ctx_);
       }
       this->~ServerCallbackUnaryImpl();  // explicitly call destructor
-      grpc::g_core_codegen_interface->grpc_call_unref(call);
+      // The request lives in the call's arena, so release it while our ref
+      // keeps the call alive.
       call_requester();
+      grpc::g_core_codegen_interface->grpc_call_unref(call);
     }
 
     ServerReactor* reactor() override {
@@ -407,8 +409,10 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
         ctx_->context_allocator()->Release(ctx_);
       }
       this->~ServerCallbackReaderImpl();  // explicitly call destructor
-      grpc::g_core_codegen_interface->grpc_call_unref(call);
+      // The request lives in the call's arena, so release it while our ref
+      // keeps the call alive.
       call_requester();
+      grpc::g_core_codegen_interface->grpc_call_unref(call);
     }
 
     ServerReactor* reactor() override {
@@ -560,23 +564,19 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
     }
 
     void Write(const ResponseType* resp, grpc::WriteOptions options) override {
-      this->Ref();
-      if (options.is_last_message()) {
-        options.set_buffer_hint();
-      }
-      if (!ctx_->sent_initial_metadata_) {
-        write_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
-                                       ctx_->initial_metadata_flags());
-        if (ctx_->compression_level_set()) {
-          write_ops_.set_compression_level(ctx_->compression_level());
-        }
-        ctx_->sent_initial_metadata_ = true;
-      }
+      PrepareWrite(&options);
       // TODO(vjpai): don't assert
       GPR_CODEGEN_ASSERT(write_ops_.SendMessagePtr(resp, options).ok());
       call_.PerformOps(&write_ops_);
     }
 
+    void WriteSerialized(const grpc::ByteBuffer& resp,
+                         grpc::WriteOptions options) override {
+      PrepareWrite(&options);
+      write_ops_.SendSerializedMessage(resp, options);
+      call_.PerformOps(&write_ops_);
+    }
+
     void WriteAndFinish(const ResponseType* resp, grpc::WriteOptions options,
                         grpc::Status s) override {
       // This combines the write into the finish callback
@@ -588,6 +588,23 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
    private:
     friend class CallbackServerStreamingHandler<RequestType, ResponseType>;
 
+    // Takes a ref for the write, and adds the initial metadata to it if not
+    // sent yet.
+    void PrepareWrite(grpc::WriteOptions* options) {
+      this->Ref();
+      if (options->is_last_message()) {
+        options->set_buffer_hint();
+      }
+      if (!ctx_->sent_initial_metadata_) {
+        write_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
+                                       ctx_->initial_metadata_flags());
+        if (ctx_->compression_level_set()) {
+          write_ops_.set_compression_level(ctx_->compression_level());
+        }
+        ctx_->sent_initial_metadata_ = true;
+      }
+    }
+
     ServerCallbackWriterImpl(grpc::CallbackServerContext* ctx,
                              grpc::internal::Call* call, const RequestType* req,
                              std::function<void()> call_requester)
@@ -632,8 +649,10 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
         ctx_->context_allocator()->Release(ctx_);
       }
       this->~ServerCallbackWriterImpl();  // explicitly call destructor
-      grpc::g_core_codegen_interface->grpc_call_unref(call);
+      // The request lives in the call's arena, so release it while our ref
+      // keeps the call alive.
       call_requester();
+      grpc::g_core_codegen_interface->grpc_call_unref(call);
     }
 
     ServerReactor* reactor() override {
@@ -770,23 +789,19 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
     }
 
     void Write(const ResponseType* resp, grpc::WriteOptions options) override {
-      this->Ref();
-      if (options.is_last_message()) {
-        options.set_buffer_hint();
-      }
-      if (!ctx_->sent_initial_metadata_) {
-        write_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
-                                       ctx_->initial_metadata_flags());
-        if (ctx_->compression_level_set()) {
-          write_ops_.set_compression_level(ctx_->compression_level());
-        }
-        ctx_->sent_initial_metadata_ = true;
-      }
+      PrepareWrite(&options);
       // TODO(vjpai): don't assert
       GPR_CODEGEN_ASSERT(write_ops_.SendMessagePtr(resp, options).ok());
       call_.PerformOps(&write_ops_);
     }
 
+    void WriteSerialized(const grpc::ByteBuffer& resp,
+                         grpc::WriteOptions options) override {
+      PrepareWrite(&options);
+      write_ops_.SendSerializedMessage(resp, options);
+      call_.PerformOps(&write_ops_);
+    }
+
     void WriteAndFinish(const ResponseType* resp, grpc::WriteOptions options,
                         grpc::Status s) override {
       // TODO(vjpai): don't assert
@@ -803,6 +818,23 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
    private:
     friend class CallbackBidiHandler<RequestType, ResponseType>;
 
+    // Takes a ref for the write, and adds the initial metadata to it if not
+    // sent yet.
+    void PrepareWrite(grpc::WriteOptions* options) {
+      this->Ref();
+      if (options->is_last_message()) {
+        options->set_buffer_hint();
+      }
+      if (!ctx_->sent_initial_metadata_) {
+        write_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
+                                       ctx_->initial_metadata_flags());
+        if (ctx_->compression_level_set()) {
+          write_ops_.set_compression_level(ctx_->compression_level());
+        }
+        ctx_->sent_initial_metadata_ = true;
+      }
+    }
+
     ServerCallbackReaderWriterImpl(grpc::CallbackServerContext* ctx,
                                    grpc::internal::Call* call,
                                    std::function<void()> call_requester)
@@ -848,8 +880,10 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
         ctx_->context_allocator()->Release(ctx_);
       }
       this->~ServerCallbackReaderWriterImpl();  // explicitly call destructor
-      grpc::g_core_codegen_interface->grpc_call_unref(call);
+      // The request lives in the call's arena, so release it while our ref
+      // keeps the call alive.
       call_requester();
+      grpc::g_core_codegen_interface->grpc_call_unref(call);
     }
 
     ServerReactor* reactor() override {
@@ -92,6 +92,10 @@ template <class W, class R>
 class ServerReaderWriterBody;
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaClientStreamingHandler;
+template <class ServiceType, class RequestType, class ResponseType>
+class ProtoArenaServerStreamingHandler;
 class ServerReactor;
 template <class Streamer, bool WriteNeeded>
 class TemplatedBidiStreamingHandler;
@@ -232,6 +236,12 @@ class ServerContextBase {
     return *client_metadata_.map();
   }
 
+  /// Return a view of the same initial metadata as \a client_metadata(), in
+  /// the order the client sent it, that is made without building a multimap.
+  grpc::MetadataView client_metadata_view() const {
+    return client_metadata_.view();
+  }
+
   /// Return the compression algorithm to be used by the server call.
   grpc_compression_level compression_level() const {
     return compression_level_;
@@ -389,6 +399,10 @@ class ServerContextBase {
   friend class grpc::internal::ClientStreamingHandler;
   template <class ServiceType, class RequestType, class ResponseType>
   friend class grpc::internal::ServerStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class grpc::internal::ProtoArenaClientStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class grpc::internal::ProtoArenaServerStreamingHandler;
   template <class Streamer, bool WriteNeeded>
   friend class grpc::internal::TemplatedBidiStreamingHandler;
   template <class RequestType, class ResponseType>
@@ -573,6 +587,7 @@ class ServerContext : public ServerContextBase {
   using ServerContextBase::c_call;
   using ServerContextBase::census_context;
   using ServerContextBase::client_metadata;
+  using ServerContextBase::client_metadata_view;
   using ServerContextBase::compression_algorithm;
   using ServerContextBase::compression_level;
   using ServerContextBase::compression_level_set;
@@ -615,6 +630,7 @@ class CallbackServerContext : public ServerContextBase {
   using ServerContextBase::c_call;
   using ServerContextBase::census_context;
   using ServerContextBase::client_metadata;
+  using ServerContextBase::client_metadata_view;
   using ServerContextBase::compression_algorithm;
   using ServerContextBase::compression_level;
   using ServerContextBase::compression_level_set;
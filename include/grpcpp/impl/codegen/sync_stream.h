@@ -190,7 +190,7 @@ class ClientReader final : public ClientReaderInterface<R> {
     grpc::internal::CallOpSet<grpc::internal::CallOpRecvInitialMetadata> ops;
     ops.RecvInitialMetadata(context_);
     call_.PerformOps(&ops);
-    cq_.Pluck(&ops);  /// status ignored
+    cq_->Pluck(&ops);  /// status ignored
   }
 
   bool NextMessageSize(uint32_t* sz) override {
@@ -213,7 +213,7 @@ class ClientReader final : public ClientReaderInterface<R> {
     }
     ops.RecvMessage(msg);
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops) && ops.got_message;
+    return cq_->Pluck(&ops) && ops.got_message;
   }
 
   /// See the \a ClientStreamingInterface.Finish method for semantics.
@@ -231,14 +231,14 @@ class ClientReader final : public ClientReaderInterface<R> {
     grpc::Status status;
     ops.ClientRecvStatus(context_, &status);
     call_.PerformOps(&ops);
-    GPR_CODEGEN_ASSERT(cq_.Pluck(&ops));
+    GPR_CODEGEN_ASSERT(cq_->Pluck(&ops));
     return status;
   }
 
  private:
   friend class internal::ClientReaderFactory<R>;
   grpc::ClientContext* context_;
-  grpc::CompletionQueue cq_;
+  grpc::internal::BlockingCallCQ cq_;
   grpc::internal::Call call_;
 
   /// Block to create a stream and write the initial metadata and \a request
@@ -249,10 +249,8 @@ class ClientReader final : public ClientReaderInterface<R> {
                const grpc::internal::RpcMethod& method,
                grpc::ClientContext* context, const W& request)
       : context_(context),
-        cq_(grpc_completion_queue_attributes{
-            GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
-        call_(channel->CreateCall(method, context, &cq_)) {
+        cq_(channel),
+        call_(channel->CreateCall(method, context, cq_.get())) {
     grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
                               grpc::internal::CallOpSendMessage,
                               grpc::internal::CallOpClientSendClose>
@@ -263,7 +261,7 @@ class ClientReader final : public ClientReaderInterface<R> {
     GPR_CODEGEN_ASSERT(ops.SendMessagePtr(&request).ok());
     ops.ClientSendClose();
     call_.PerformOps(&ops);
-    cq_.Pluck(&ops);
+    cq_->Pluck(&ops);
   }
 };
 
@@ -312,7 +310,7 @@ class ClientWriter : public ClientWriterInterface<W> {
     grpc::internal::CallOpSet<grpc::internal::CallOpRecvInitialMetadata> ops;
     ops.RecvInitialMetadata(context_);
     call_.PerformOps(&ops);
-    cq_.Pluck(&ops);  // status ignored
+    cq_->Pluck(&ops);  // status ignored
   }
 
   /// See the WriterInterface.Write(const W& msg, WriteOptions options) method
@@ -342,14 +340,14 @@ class ClientWriter : public ClientWriterInterface<W> {
     }
 
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops);
+    return cq_->Pluck(&ops);
   }
 
   bool WritesDone() override {
     grpc::internal::CallOpSet<grpc::internal::CallOpClientSendClose> ops;
     ops.ClientSendClose();
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops);
+    return cq_->Pluck(&ops);
   }
 
   /// See the ClientStreamingInterface.Finish method for semantics.
@@ -365,7 +363,7 @@ class ClientWriter : public ClientWriterInterface<W> {
     }
     finish_ops_.ClientRecvStatus(context_, &status);
     call_.PerformOps(&finish_ops_);
-    GPR_CODEGEN_ASSERT(cq_.Pluck(&finish_ops_));
+    GPR_CODEGEN_ASSERT(cq_->Pluck(&finish_ops_));
     return status;
   }
 
@@ -382,10 +380,8 @@ class ClientWriter : public ClientWriterInterface<W> {
                const grpc::internal::RpcMethod& method,
                grpc::ClientContext* context, R* response)
       : context_(context),
-        cq_(grpc_completion_queue_attributes{
-            GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
-        call_(channel->CreateCall(method, context, &cq_)) {
+        cq_(channel),
+        call_(channel->CreateCall(method, context, cq_.get())) {
     finish_ops_.RecvMessage(response);
     finish_ops_.AllowNoMessage();
 
@@ -394,7 +390,7 @@ class ClientWriter : public ClientWriterInterface<W> {
       ops.SendInitialMetadata(&context->send_initial_metadata_,
                               context->initial_metadata_flags());
       call_.PerformOps(&ops);
-      cq_.Pluck(&ops);
+      cq_->Pluck(&ops);
     }
   }
 
@@ -403,7 +399,7 @@ class ClientWriter : public ClientWriterInterface<W> {
                             grpc::internal::CallOpGenericRecvMessage,
                             grpc::internal::CallOpClientRecvStatus>
       finish_ops_;
-  grpc::CompletionQueue cq_;
+  grpc::internal::BlockingCallCQ cq_;
   grpc::internal::Call call_;
 };
 
@@ -461,7 +457,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
     grpc::internal::CallOpSet<grpc::internal::CallOpRecvInitialMetadata> ops;
     ops.RecvInitialMetadata(context_);
     call_.PerformOps(&ops);
-    cq_.Pluck(&ops);  // status ignored
+    cq_->Pluck(&ops);  // status ignored
   }
 
   bool NextMessageSize(uint32_t* sz) override {
@@ -483,7 +479,26 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
     }
     ops.RecvMessage(msg);
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops) && ops.got_message;
+    return cq_->Pluck(&ops) && ops.got_message;
+  }
+
+  /// EXPERIMENTAL: Like \a Read, but reads the serialized bytes of the next
+  /// message received so far rather than waiting for all of them, so that a
+  /// huge message can be streamed through with bounded memory. Sets \a
+  /// *partial to whether the rest of the message follows, to be read by
+  /// further calls to \a ReadPartial. Compressed messages, and messages from
+  /// transports that do not support it, are read whole.
+  bool ReadPartial(grpc::ByteBuffer* bytes, bool* partial) {
+    grpc::internal::CallOpSet<grpc::internal::CallOpRecvInitialMetadata,
+                              grpc::internal::CallOpRecvMessage<ByteBuffer>>
+        ops;
+    if (!context_->initial_metadata_received_) {
+      ops.RecvInitialMetadata(context_);
+    }
+    ops.RecvMessage(bytes);
+    ops.AllowPartialMessage(partial);
+    call_.PerformOps(&ops);
+    return cq_->Pluck(&ops) && ops.got_message;
   }
 
   /// See the \a WriterInterface.Write method for semantics.
@@ -512,14 +527,14 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
     }
 
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops);
+    return cq_->Pluck(&ops);
   }
 
   bool WritesDone() override {
     grpc::internal::CallOpSet<grpc::internal::CallOpClientSendClose> ops;
     ops.ClientSendClose();
     call_.PerformOps(&ops);
-    return cq_.Pluck(&ops);
+    return cq_->Pluck(&ops);
   }
 
   /// See the ClientStreamingInterface.Finish method for semantics.
@@ -537,7 +552,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
     grpc::Status status;
     ops.ClientRecvStatus(context_, &status);
     call_.PerformOps(&ops);
-    GPR_CODEGEN_ASSERT(cq_.Pluck(&ops));
+    GPR_CODEGEN_ASSERT(cq_->Pluck(&ops));
     return status;
   }
 
@@ -545,7 +560,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
   friend class internal::ClientReaderWriterFactory<W, R>;
 
   grpc::ClientContext* context_;
-  grpc::CompletionQueue cq_;
+  grpc::internal::BlockingCallCQ cq_;
   grpc::internal::Call call_;
 
   /// Block to create a stream and write the initial metadata and \a request
@@ -555,16 +570,14 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
                      const grpc::internal::RpcMethod& method,
                      grpc::ClientContext* context)
       : context_(context),
-        cq_(grpc_completion_queue_attributes{
-            GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
-        call_(channel->CreateCall(method, context, &cq_)) {
+        cq_(channel),
+        call_(channel->CreateCall(method, context, cq_.get())) {
     if (!context_->initial_metadata_corked_) {
       grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata> ops;
       ops.SendInitialMetadata(&context->send_initial_metadata_,
                               context->initial_metadata_flags());
       call_.PerformOps(&ops);
-      cq_.Pluck(&ops);
+      cq_->Pluck(&ops);
     }
   }
 };
@@ -620,6 +633,8 @@ class ServerReader final : public ServerReaderInterface<R> {
 
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ClientStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class internal::ProtoArenaClientStreamingHandler;
 
   ServerReader(grpc::internal::Call* call, grpc::ServerContext* ctx)
       : call_(call), ctx_(ctx) {}
@@ -668,6 +683,29 @@ class ServerWriter final : public ServerWriterInterface<W> {
     if (!ctx_->pending_ops_.SendMessagePtr(&msg, options).ok()) {
       return false;
     }
+    return PerformWrite(options);
+  }
+
+  /// EXPERIMENTAL: Like \a Write, but for a message \a msg already serialized
+  /// into a byte buffer (see \a SerializationTraits), of which only the slices
+  /// are referenced: the same buffer can be written to many streams at the
+  /// cost of serializing it once. A buffer compressed with
+  /// \a ByteBuffer::Compress must only be written to calls using that same
+  /// compression algorithm (see \a ServerContext::set_compression_algorithm).
+  bool WriteSerialized(const grpc::ByteBuffer& msg,
+                       grpc::WriteOptions options) {
+    if (options.is_last_message()) {
+      options.set_buffer_hint();
+    }
+    ctx_->pending_ops_.SendSerializedMessage(msg, options);
+    return PerformWrite(options);
+  }
+  bool WriteSerialized(const grpc::ByteBuffer& msg) {
+    return WriteSerialized(msg, grpc::WriteOptions());
+  }
+
+ private:
+  bool PerformWrite(grpc::WriteOptions options) {
     if (!ctx_->sent_initial_metadata_) {
       ctx_->pending_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                              ctx_->initial_metadata_flags());
@@ -688,12 +726,13 @@ class ServerWriter final : public ServerWriterInterface<W> {
     return call_->cq()->Pluck(&ctx_->pending_ops_);
   }
 
- private:
   grpc::internal::Call* const call_;
   grpc::ServerContext* const ctx_;
 
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ServerStreamingHandler;
+  template <class ServiceType, class RequestType, class ResponseType>
+  friend class internal::ProtoArenaServerStreamingHandler;
 
   ServerWriter(grpc::internal::Call* call, grpc::ServerContext* ctx)
       : call_(call), ctx_(ctx) {}
@@ -744,6 +783,19 @@ class ServerReaderWriterBody final {
     return ok;
   }
 
+  bool ReadPartial(grpc::ByteBuffer* bytes, bool* partial) {
+    grpc::internal::CallOpSet<grpc::internal::CallOpRecvMessage<ByteBuffer>>
+        ops;
+    ops.RecvMessage(bytes);
+    ops.AllowPartialMessage(partial);
+    call_->PerformOps(&ops);
+    bool ok = call_->cq()->Pluck(&ops) && ops.got_message;
+    if (!ok) {
+      ctx_->MaybeMarkCancelledOnRead();
+    }
+    return ok;
+  }
+
   bool Write(const W& msg, grpc::WriteOptions options) {
     if (options.is_last_message()) {
       options.set_buffer_hint();
@@ -751,6 +803,20 @@ class ServerReaderWriterBody final {
     if (!ctx_->pending_ops_.SendMessagePtr(&msg, options).ok()) {
       return false;
     }
+    return PerformWrite(options);
+  }
+
+  bool WriteSerialized(const grpc::ByteBuffer& msg,
+                       grpc::WriteOptions options) {
+    if (options.is_last_message()) {
+      options.set_buffer_hint();
+    }
+    ctx_->pending_ops_.SendSerializedMessage(msg, options);
+    return PerformWrite(options);
+  }
+
+ private:
+  bool PerformWrite(grpc::WriteOptions options) {
     if (!ctx_->sent_initial_metadata_) {
       ctx_->pending_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                              ctx_->initial_metadata_flags());
@@ -771,7 +837,6 @@ class ServerReaderWriterBody final {
     return call_->cq()->Pluck(&ctx_->pending_ops_);
   }
 
- private:
   grpc::internal::Call* const call_;
   grpc::ServerContext* const ctx_;
 };
@@ -796,6 +861,12 @@ class ServerReaderWriter final : public ServerReaderWriterInterface<W, R> {
 
   bool Read(R* msg) override { return body_.Read(msg); }
 
+  /// EXPERIMENTAL: See the \a ClientReaderWriter.ReadPartial method for
+  /// semantics.
+  bool ReadPartial(grpc::ByteBuffer* bytes, bool* partial) {
+    return body_.ReadPartial(bytes, partial);
+  }
+
   /// See the \a WriterInterface.Write(const W& msg, WriteOptions options)
   /// method for semantics.
   /// Side effect:
@@ -806,6 +877,16 @@ class ServerReaderWriter final : public ServerReaderWriterInterface<W, R> {
     return body_.Write(msg, options);
   }
 
+  /// EXPERIMENTAL: See the \a ServerWriter.WriteSerialized method for
+  /// semantics.
+  bool WriteSerialized(const grpc::ByteBuffer& msg,
+                       grpc::WriteOptions options) {
+    return body_.WriteSerialized(msg, options);
+  }
+  bool WriteSerialized(const grpc::ByteBuffer& msg) {
+    return WriteSerialized(msg, grpc::WriteOptions());
+  }
+
  private:
   internal::ServerReaderWriterBody<W, R> body_;
 
@@ -19,7 +19,11 @@
 #ifndef GRPCPP_SECURITY_TLS_CREDENTIALS_OPTIONS_H
 #define GRPCPP_SECURITY_TLS_CREDENTIALS_OPTIONS_H
 
+#include <stdint.h>
+
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/grpc_security.h>
@@ -29,10 +33,57 @@
 #include <grpcpp/security/tls_certificate_provider.h>
 #include <grpcpp/security/tls_certificate_verifier.h>
 #include <grpcpp/support/config.h>
+#include <grpcpp/support/status.h>
 
 namespace grpc {
 namespace experimental {
 
+// The keys TLS servers encrypt the session tickets they issue with. Servers
+// whose options share the same keys resume each other's sessions. It is used
+// for experimental purposes for now and it is subject to change.
+class TlsSessionTicketKeys {
+ public:
+  // Creates keys holding a single random key.
+  TlsSessionTicketKeys();
+  ~TlsSessionTicketKeys();
+
+  // Not copyable nor assignable.
+  TlsSessionTicketKeys(const TlsSessionTicketKeys&) = delete;
+  TlsSessionTicketKeys& operator=(const TlsSessionTicketKeys&) = delete;
+
+  // Makes |key| the key new session tickets are encrypted with; tickets
+  // encrypted with one of the two previous keys are still accepted. |key| is
+  // a 16-byte key name, followed by a 16-byte HMAC-SHA256 key and a 16-byte
+  // AES-128 key. Returns false if |key| is not 48 bytes long.
+  bool Rotate(const std::string& key);
+
+  grpc_ssl_session_ticket_keys* c_keys() const { return c_keys_; }
+
+ private:
+  grpc_ssl_session_ticket_keys* c_keys_;
+};
+
+// Signs on behalf of a TLS server whose private key is not loaded in the
+// process, e.g. because it is held by a hardware accelerator, an HSM or a
+// remote key service. Handshakes do not block while a signing operation is in
+// flight. It is used for experimental purposes for now and it is subject to
+// change.
+class TlsPrivateKeySigner {
+ public:
+  virtual ~TlsPrivateKeySigner() = default;
+
+  // Signs |input| with the server's private key, using the TLS
+  // SignatureScheme |signature_algorithm| defined in RFC 8446, section 4.2.3.
+  // |on_done| must be invoked exactly once with the signature, or with a
+  // non-OK status if the signing failed. It may be invoked before Sign()
+  // returns, or later from any thread.
+  virtual void Sign(
+      const std::string& input, uint16_t signature_algorithm,
+      std::function<void(const grpc::Status& status,
+                         const std::string& signature)>
+          on_done) = 0;
+};
+
 // Base class of configurable options specified by users to configure their
 // certain security features supported in TLS. It is used for experimental
 // purposes for now and it is subject to change.
@@ -148,7 +199,20 @@ class TlsServerCredentialsOptions final : public TlsCredentialsOptions {
   void set_cert_request_type(
       grpc_ssl_client_certificate_request_type cert_request_type);
 
+  // Sets the keys to encrypt session tickets with, which lets servers sharing
+  // the same keys resume each other's sessions. If not set, each server uses
+  // its own random key.
+  void set_session_ticket_keys(
+      std::shared_ptr<TlsSessionTicketKeys> session_ticket_keys);
+
+  // Sets the signer that performs the signing operations of the handshakes,
+  // for servers whose private key is not loaded in the process. If set, the
+  // private keys of the identity key-cert pairs are ignored and may be empty.
+  // Only supported when gRPC is built with BoringSSL.
+  void set_private_key_signer(std::shared_ptr<TlsPrivateKeySigner> signer);
+
  private:
+  std::shared_ptr<TlsSessionTicketKeys> session_ticket_keys_;
 };
 
 }  // namespace experimental
@@ -22,7 +22,9 @@
 #include <grpc/impl/codegen/port_platform.h>
 
 #include <list>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -36,6 +38,7 @@
 #include <grpcpp/impl/codegen/server_interface.h>
 #include <grpcpp/impl/rpc_service_method.h>
 #include <grpcpp/security/server_credentials.h>
+#include <grpcpp/support/callback_method_executor.h>
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/client_interceptor.h>
 #include <grpcpp/support/config.h>
@@ -247,6 +250,19 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
     context_allocator_ = std::move(context_allocator);
   }
 
+  /// Start the handlers of the callback methods matching \a method_or_service
+  /// on \a method_class of \a executor. Must be called before the services are
+  /// registered.
+  void RegisterCallbackMethodExecutor(
+      const std::string& method_or_service,
+      std::shared_ptr<experimental::CallbackMethodExecutor> executor,
+      experimental::CallbackMethodExecutor::MethodClass* method_class);
+
+  /// The class the handlers of the callback method \a method_name start on,
+  /// or nullptr to start them inline.
+  experimental::CallbackMethodExecutor::MethodClass* CallbackMethodClass(
+      const char* method_name);
+
   void PerformOpsOnCall(internal::CallOpSetInterface* ops,
                         internal::Call* call) override;
 
@@ -281,6 +297,10 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
 
   int max_receive_message_size_;
 
+  // Sync calls left with less time than this when a thread picks them up are
+  // failed with DEADLINE_EXCEEDED. See GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS.
+  int min_deadline_budget_ms_ = 0;
+
   /// The following completion queues are ONLY used in case of Sync API
   /// i.e. if the server has any services with sync methods. The server uses
   /// these completion queues to poll for new RPCs
@@ -317,6 +337,12 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
 
   std::unique_ptr<ContextAllocator> context_allocator_;
 
+  // Keyed by full method name ("/pkg.Service/Method") or by service name.
+  std::map<std::string, experimental::CallbackMethodExecutor::MethodClass*>
+      callback_method_classes_;
+  std::vector<std::shared_ptr<experimental::CallbackMethodExecutor>>
+      callback_method_executors_;
+
   std::unique_ptr<HealthCheckServiceInterface> health_check_service_;
   bool health_check_service_disabled_;
 
@@ -327,6 +353,10 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   // A special handler for resource exhausted in sync case
   std::unique_ptr<internal::MethodHandler> resource_exhausted_handler_;
 
+  // A handler for sync calls that are out of time, if min_deadline_budget_ms_
+  // is set
+  std::unique_ptr<internal::MethodHandler> deadline_exceeded_handler_;
+
   // Handler for callback generic service, if any
   std::unique_ptr<internal::MethodHandler> generic_handler_;
 
@@ -24,6 +24,7 @@
 #include <climits>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -35,6 +36,7 @@
 #include <grpcpp/impl/server_builder_plugin.h>
 #include <grpcpp/security/authorization_policy_provider.h>
 #include <grpcpp/server.h>
+#include <grpcpp/support/callback_method_executor.h>
 #include <grpcpp/support/config.h>
 
 struct grpc_resource_quota;
@@ -226,10 +228,14 @@ class ServerBuilder {
 
   /// Options for synchronous servers.
   enum SyncServerOption {
-    NUM_CQS,         ///< Number of completion queues.
-    MIN_POLLERS,     ///< Minimum number of polling threads.
-    MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    NUM_CQS,          ///< Number of completion queues.
+    MIN_POLLERS,      ///< Minimum number of polling threads.
+    MAX_POLLERS,      ///< Maximum number of polling threads.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    /// If non-zero, pin the threads of completion queue i to CPU i modulo the
+    /// number of CPUs. Combine with GRPC_ARG_REUSEPORT_SHARDING to serve each
+    /// connection from one CPU.
+    PIN_CQS_TO_CPUS
   };
 
   /// Only useful if this is a Synchronous server.
@@ -283,6 +289,20 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Start the handlers of callback methods matching \a method_or_service
+    /// on \a executor rather than on the server's own threads.
+    /// \a method_or_service is either a full method name
+    /// ("/package.Service/Method") or a service name ("package.Service"); an
+    /// entry for a method takes precedence over one for its service.
+    ///
+    /// Among the classes of work of \a executor, pending handlers of a higher
+    /// \a priority are started first. At most \a max_concurrency handlers of
+    /// this entry run at once, with 0 meaning no cap.
+    void SetCallbackMethodExecutor(
+        const std::string& method_or_service,
+        std::shared_ptr<experimental::CallbackMethodExecutor> executor,
+        int priority = 0, int max_concurrency = 0);
+
    private:
     ServerBuilder* builder_;
   };
@@ -357,7 +377,11 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          pin_cqs_to_cpus(false) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -372,6 +396,9 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Whether to pin the threads of each completion queue to one CPU.
+    bool pin_cqs_to_cpus;
   };
 
   int max_receive_message_size_;
@@ -412,6 +439,13 @@ class ServerBuilder {
   grpc_server_config_fetcher* server_config_fetcher_ = nullptr;
   std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
       authorization_provider_;
+  struct CallbackMethodExecutorEntry {
+    std::string method_or_service;
+    std::shared_ptr<experimental::CallbackMethodExecutor> executor;
+    int priority;
+    int max_concurrency;
+  };
+  std::vector<CallbackMethodExecutorEntry> callback_method_executors_;
 };
 
 }  // namespace grpc
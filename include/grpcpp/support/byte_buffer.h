@@ -43,6 +43,9 @@ template <class RequestType, class ResponseType>
 class CallbackServerStreamingHandler;
 template <class RequestType>
 void* UnaryDeserializeHelper(grpc_byte_buffer*, grpc::Status*, RequestType*);
+template <class RequestType>
+void* ProtoArenaDeserialize(grpc_call*, grpc_byte_buffer*, grpc::Status*,
+                            void**);
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
 template <grpc::StatusCode code>
@@ -125,6 +128,25 @@ class ByteBuffer final {
   /// Dump (read) the buffer contents into \a slices.
   Status Dump(std::vector<Slice>* slices) const;
 
+  /// EXPERIMENTAL: Compress the contents of this (uncompressed) buffer with
+  /// \a algorithm into \a compressed, which is then sent as is by the
+  /// WriteSerialized methods of server streams: the cost of compressing a
+  /// message written to many streams is only paid once. The contents are left
+  /// uncompressed if compressing would not make them any smaller.
+  Status Compress(grpc_compression_algorithm algorithm,
+                  ByteBuffer* compressed) const;
+
+  /// EXPERIMENTAL: Make \a buffer reference the \a length bytes from \a offset
+  /// of the file open as \a fd, without reading them: the region is mapped
+  /// into memory, and its pages only come from the page cache as they are
+  /// sent. Over plaintext TCP that costs no copy into userspace, and none at
+  /// all with the GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED channel argument. \a fd may
+  /// be closed as soon as this returns, but the file must not be truncated
+  /// while \a buffer or any copy of it is in use. Only supported on POSIX
+  /// platforms.
+  static Status FromFileRegion(int fd, uint64_t offset, size_t length,
+                               ByteBuffer* buffer);
+
   /// Remove all data.
   void Clear() {
     if (buffer_) {
@@ -173,6 +195,9 @@ class ByteBuffer final {
   template <class RequestType>
   friend void* internal::UnaryDeserializeHelper(grpc_byte_buffer*,
                                                 grpc::Status*, RequestType*);
+  template <class RequestType>
+  friend void* internal::ProtoArenaDeserialize(grpc_call*, grpc_byte_buffer*,
+                                               grpc::Status*, void**);
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ServerStreamingHandler;
   template <class RequestType, class ResponseType>
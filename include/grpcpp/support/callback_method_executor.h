@@ -0,0 +1,76 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPCPP_SUPPORT_CALLBACK_METHOD_EXECUTOR_H
+#define GRPCPP_SUPPORT_CALLBACK_METHOD_EXECUTOR_H
+
+#include <functional>
+#include <memory>
+
+namespace grpc {
+
+class Server;
+class ServerBuilder;
+
+namespace experimental {
+
+/// A pool of threads on which a server starts the handlers of the callback
+/// methods attached to it with
+/// \a ServerBuilder::experimental_type::SetCallbackMethodExecutor, instead of
+/// on the threads shared by every callback method of the server.
+///
+/// Each attachment gets its own class of work with a priority and a
+/// concurrency cap. An idle thread always starts the oldest pending handler
+/// of the highest priority class that is under its cap, so a backlog of
+/// expensive methods does not delay methods attached with a higher priority.
+/// Reactions (OnDone, OnReadDone, ...) still run on the server's own threads.
+///
+/// One executor may be shared by several servers and methods. Each server
+/// holds a reference to the executors attached to it.
+class CallbackMethodExecutor final {
+ public:
+  /// \a num_threads must be positive.
+  explicit CallbackMethodExecutor(int num_threads);
+  /// Runs the handlers still pending, then joins the threads.
+  ~CallbackMethodExecutor();
+
+  CallbackMethodExecutor(const CallbackMethodExecutor&) = delete;
+  CallbackMethodExecutor& operator=(const CallbackMethodExecutor&) = delete;
+
+  /// Opaque handle on one class of work of an executor.
+  class MethodClass;
+
+ private:
+  friend class grpc::Server;
+  friend class grpc::ServerBuilder;
+  class Impl;
+
+  /// The returned class lives as long as the executor. A \a max_concurrency of
+  /// 0 leaves the class uncapped.
+  MethodClass* AddMethodClass(int priority, int max_concurrency);
+
+  /// Queues \a fn on the executor that \a method_class belongs to.
+  static void Run(MethodClass* method_class, std::function<void()> fn);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_CALLBACK_METHOD_EXECUTOR_H
@@ -0,0 +1,275 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_CLIENT_COROUTINE_H
+#define GRPCPP_SUPPORT_CLIENT_COROUTINE_H
+
+// EXPERIMENTAL: Awaitable client calls for C++20 coroutines, built on the
+// callback API. Each one is the reactor of its call, so it lives wherever the
+// coroutine keeps it (typically its frame), and awaiting costs no allocation
+// beyond what the callback API itself makes. Coroutines resume on the thread
+// that runs the corresponding reaction, as reactors would.
+//
+//   grpc::experimental::AwaitableUnaryCall call;
+//   stub->async()->Echo(&context, &request, &response, &call);
+//   grpc::Status status = co_await call.Start();
+//
+//   grpc::experimental::AwaitableReader<EchoResponse> reader;
+//   stub->async()->ResponseStream(&context, &request, &reader);
+//   reader.StartCall();
+//   while (co_await reader.Read(&response)) { ... }
+//   grpc::Status status = co_await reader.Finish();
+//
+// This header is empty unless the compiler supports coroutines.
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+
+#include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/status.h>
+
+#define GRPCPP_HAS_CLIENT_COROUTINES 1
+
+namespace grpc {
+namespace experimental {
+namespace internal {
+
+// The final status of a call, awaitable by one coroutine whether the call is
+// done before or after the coroutine starts waiting for it.
+class AwaitableStatus {
+ public:
+  class Awaiter {
+   public:
+    explicit Awaiter(AwaitableStatus* status) : status_(status) {}
+
+    bool await_ready() const noexcept {
+      return status_->state_.load(std::memory_order_acquire) == Done();
+    }
+    bool await_suspend(std::coroutine_handle<> waiter) noexcept {
+      void* expected = nullptr;
+      return status_->state_.compare_exchange_strong(
+          expected, waiter.address(), std::memory_order_acq_rel,
+          std::memory_order_acquire);
+    }
+    grpc::Status await_resume() const { return status_->status_; }
+
+   private:
+    AwaitableStatus* const status_;
+  };
+
+  // Called once, from OnDone.
+  void Set(const grpc::Status& status) {
+    status_ = status;
+    void* waiter = state_.exchange(Done(), std::memory_order_acq_rel);
+    if (waiter != nullptr) {
+      std::coroutine_handle<>::from_address(waiter).resume();
+    }
+  }
+
+ private:
+  static void* Done() { return reinterpret_cast<void*>(uintptr_t{1}); }
+
+  // nullptr, then the waiting coroutine or Done(), whichever comes first.
+  std::atomic<void*> state_{nullptr};
+  grpc::Status status_;
+};
+
+// Awaits the completion of one operation of a stream: the reactor starts it
+// once the coroutine is suspended, and resumes the coroutine from the
+// corresponding reaction with its result.
+template <class Reactor, void (Reactor::*Start)(std::coroutine_handle<>)>
+class AwaitableOp {
+ public:
+  explicit AwaitableOp(Reactor* reactor, bool* ok)
+      : reactor_(reactor), ok_(ok) {}
+
+  bool await_ready() const noexcept { return false; }
+  // The coroutine may be resumed, on another thread, before this returns.
+  void await_suspend(std::coroutine_handle<> waiter) {
+    (reactor_->*Start)(waiter);
+  }
+  bool await_resume() const noexcept { return *ok_; }
+
+ private:
+  Reactor* const reactor_;
+  bool* const ok_;
+};
+
+}  // namespace internal
+
+/// The reactor of a unary call, whose outcome a coroutine awaits. Pass it to
+/// a stub's async() method, then co_await Start() for the status.
+class AwaitableUnaryCall : public grpc::ClientUnaryReactor {
+ public:
+  class StartAwaiter {
+   public:
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> waiter) {
+      // Nothing can be done before the call starts, so this always suspends.
+      done_.await_suspend(waiter);
+      call_->StartCall();
+    }
+    grpc::Status await_resume() const { return done_.await_resume(); }
+
+   private:
+    friend class AwaitableUnaryCall;
+    explicit StartAwaiter(AwaitableUnaryCall* call)
+        : call_(call), done_(&call->done_) {}
+
+    AwaitableUnaryCall* const call_;
+    internal::AwaitableStatus::Awaiter done_;
+  };
+
+  /// Starts the call, resuming the coroutine with its status once done.
+  StartAwaiter Start() { return StartAwaiter(this); }
+
+  void OnDone(const grpc::Status& s) override { done_.Set(s); }
+
+ private:
+  internal::AwaitableStatus done_;
+};
+
+/// The reactor of a server-streaming call, for a coroutine to read. Pass it
+/// to a stub's async() method and call StartCall(). Then co_await Read() until
+/// it returns false, and co_await Finish() before this goes away. Only one
+/// Read() may be outstanding at a time.
+template <class Response>
+class AwaitableReader : public grpc::ClientReadReactor<Response> {
+ private:
+  void StartReadFor(std::coroutine_handle<> waiter) {
+    read_waiter_ = waiter;
+    this->StartRead(read_msg_);
+  }
+
+ public:
+  using ReadAwaiter =
+      internal::AwaitableOp<AwaitableReader, &AwaitableReader::StartReadFor>;
+
+  /// Reads the next message into \a msg, resuming the coroutine with true, or
+  /// with false once there are no more.
+  ReadAwaiter Read(Response* msg) {
+    read_msg_ = msg;
+    return ReadAwaiter(this, &read_ok_);
+  }
+
+  /// Resumes the coroutine with the final status of the call.
+  internal::AwaitableStatus::Awaiter Finish() {
+    return internal::AwaitableStatus::Awaiter(&done_);
+  }
+
+  void OnReadDone(bool ok) override {
+    read_ok_ = ok;
+    read_waiter_.resume();
+  }
+  void OnDone(const grpc::Status& s) override { done_.Set(s); }
+
+ private:
+  Response* read_msg_ = nullptr;
+  bool read_ok_ = false;
+  std::coroutine_handle<> read_waiter_;
+  internal::AwaitableStatus done_;
+};
+
+/// The reactor of a bidirectional streaming call, for coroutines to read and
+/// write. Pass it to a stub's async() method and call StartCall(). Then
+/// co_await Read(), Write() and WritesDone() as needed, and co_await Finish()
+/// before this goes away. Only one read and one write (or WritesDone()) may be
+/// outstanding at a time; they may be awaited by different coroutines.
+template <class Request, class Response>
+class AwaitableReaderWriter
+    : public grpc::ClientBidiReactor<Request, Response> {
+ private:
+  void StartReadFor(std::coroutine_handle<> waiter) {
+    read_waiter_ = waiter;
+    this->StartRead(read_msg_);
+  }
+  void StartWriteFor(std::coroutine_handle<> waiter) {
+    write_waiter_ = waiter;
+    if (write_msg_ == nullptr) {
+      this->StartWritesDone();
+    } else {
+      this->StartWrite(write_msg_, write_options_);
+    }
+  }
+
+ public:
+  using ReadAwaiter =
+      internal::AwaitableOp<AwaitableReaderWriter,
+                            &AwaitableReaderWriter::StartReadFor>;
+  using WriteAwaiter =
+      internal::AwaitableOp<AwaitableReaderWriter,
+                            &AwaitableReaderWriter::StartWriteFor>;
+
+  /// Reads the next message into \a msg, resuming the coroutine with true, or
+  /// with false once there are no more.
+  ReadAwaiter Read(Response* msg) {
+    read_msg_ = msg;
+    return ReadAwaiter(this, &read_ok_);
+  }
+
+  /// Writes \a msg, which must stay valid until the write completes, resuming
+  /// the coroutine with whether it went out.
+  WriteAwaiter Write(const Request* msg,
+                     grpc::WriteOptions options = grpc::WriteOptions()) {
+    write_msg_ = msg;
+    write_options_ = options;
+    return WriteAwaiter(this, &write_ok_);
+  }
+
+  /// Half-closes the call, resuming the coroutine with whether it went out.
+  WriteAwaiter WritesDone() {
+    write_msg_ = nullptr;
+    return WriteAwaiter(this, &write_ok_);
+  }
+
+  /// Resumes the coroutine with the final status of the call.
+  internal::AwaitableStatus::Awaiter Finish() {
+    return internal::AwaitableStatus::Awaiter(&done_);
+  }
+
+  void OnReadDone(bool ok) override {
+    read_ok_ = ok;
+    read_waiter_.resume();
+  }
+  void OnWriteDone(bool ok) override {
+    write_ok_ = ok;
+    write_waiter_.resume();
+  }
+  void OnWritesDoneDone(bool ok) override { OnWriteDone(ok); }
+  void OnDone(const grpc::Status& s) override { done_.Set(s); }
+
+ private:
+  Response* read_msg_ = nullptr;
+  bool read_ok_ = false;
+  std::coroutine_handle<> read_waiter_;
+  const Request* write_msg_ = nullptr;
+  grpc::WriteOptions write_options_;
+  bool write_ok_ = false;
+  std::coroutine_handle<> write_waiter_;
+  internal::AwaitableStatus done_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // __has_include(<coroutine>)
+#endif  // __cpp_impl_coroutine && __has_include
+
+#endif  // GRPCPP_SUPPORT_CLIENT_COROUTINE_H
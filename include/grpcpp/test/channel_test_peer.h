@@ -33,6 +33,8 @@ class ChannelTestPeer {
   grpc_channel* channel() const { return channel_->c_channel_; }
   int registered_calls() const;
   int registration_attempts() const;
+  /// The pluckable completion queues kept for blocking calls to borrow
+  int spare_pluck_cqs() const;
 
  private:
   Channel* channel_;  // not owned
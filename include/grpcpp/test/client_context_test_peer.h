@@ -20,6 +20,7 @@
 #define GRPCPP_TEST_CLIENT_CONTEXT_TEST_PEER_H
 
 #include <map>
+#include <utility>
 
 #include <grpcpp/client_context.h>
 
@@ -48,7 +49,9 @@ class ClientContextTestPeer {
   }
 
   std::multimap<std::string, std::string> GetSendInitialMetadata() const {
-    return ctx_->send_initial_metadata_;
+    grpc::internal::ClientSendMetadata metadata = ctx_->send_initial_metadata_;
+    metadata.CopyReferenced();
+    return std::move(metadata);
   }
 
  private:
@@ -18,6 +18,7 @@
 
 #include "src/compiler/cpp_generator.h"
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 
@@ -39,6 +40,19 @@ inline bool ServerOnlyStreaming(const grpc_generator::Method* method) {
   return !method->ClientStreaming() && method->ServerStreaming();
 }
 
+// Records in vars whether server handlers should create their messages in a
+// protobuf arena.
+void SetArenaMessagesVars(const Parameters& params,
+                          std::map<std::string, std::string>* vars) {
+  (*vars)["ArenaMessages"] = params.use_arena_messages ? "true" : "false";
+  (*vars)["ArenaPrefix"] = params.use_arena_messages ? "ProtoArena" : "";
+}
+
+bool UseArenaMessages(const std::map<std::string, std::string>& vars) {
+  auto it = vars.find("ArenaMessages");
+  return it != vars.end() && it->second == "true";
+}
+
 std::string FilenameIdentifier(const std::string& filename) {
   std::string result;
   for (unsigned i = 0; i < filename.size(); i++) {
@@ -156,6 +170,11 @@ std::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/sync_stream.h",
     };
     std::vector<std::string> headers(headers_strs, array_end(headers_strs));
+    if (params.use_arena_messages) {
+      headers.insert(std::find(headers.begin(), headers.end(),
+                               "grpcpp/impl/codegen/proto_utils.h"),
+                     "grpcpp/impl/codegen/proto_arena_method_handler.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -992,7 +1011,14 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
         "const $RealRequest$* "
         "request, "
         "$RealResponse$* response) { "
-        "return this->$Method$(context, request, response); }));}\n");
+        "return this->$Method$(context, request, response); }));\n");
+    if (UseArenaMessages(*vars)) {
+      printer->Print(*vars,
+                     "  SetMessageAllocatorFor_$Method$(\n"
+                     "      ::grpc::internal::ProtoArenaMessageAllocator< "
+                     "$RealRequest$, $RealResponse$>::Get());\n");
+    }
+    printer->Print("}\n");
     printer->Print(*vars,
                    "void SetMessageAllocatorFor_$Method$(\n"
                    "    ::grpc::MessageAllocator< "
@@ -1565,6 +1591,7 @@ std::string GetHeaderServices(grpc_generator::File* file,
     if (!file->package().empty()) {
       vars["Package"].append(".");
     }
+    SetArenaMessagesVars(params, &vars);
 
     if (!params.services_namespace.empty()) {
       vars["services_namespace"] = params.services_namespace;
@@ -1662,6 +1689,11 @@ std::string GetSourceIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/service_type.h",
         "grpcpp/impl/codegen/sync_stream.h"};
     std::vector<std::string> headers(headers_strs, array_end(headers_strs));
+    if (params.use_arena_messages) {
+      headers.insert(std::find(headers.begin(), headers.end(),
+                               "grpcpp/impl/codegen/rpc_service_method.h"),
+                     "grpcpp/impl/codegen/proto_arena_method_handler.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
 
@@ -2021,7 +2053,21 @@ void PrintSourceService(grpc_generator::Printer* printer,
     (*vars)["Method"] = method->name();
     (*vars)["Request"] = method->input_type_name();
     (*vars)["Response"] = method->output_type_name();
-    if (method->NoStreaming()) {
+    if (method->NoStreaming() && UseArenaMessages(*vars)) {
+      printer->Print(
+          *vars,
+          "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
+          "    $prefix$$Service$_method_names[$Idx$],\n"
+          "    ::grpc::internal::RpcMethod::NORMAL_RPC,\n"
+          "    new ::grpc::internal::ProtoArenaRpcMethodHandler< "
+          "$ns$$Service$::Service, $Request$, $Response$>(\n"
+          "        []($ns$$Service$::Service* service,\n"
+          "           ::grpc::ServerContext* ctx,\n"
+          "           const $Request$* req,\n"
+          "           $Response$* resp) {\n"
+          "             return service->$Method$(ctx, req, resp);\n"
+          "           }, this)));\n");
+    } else if (method->NoStreaming()) {
       printer->Print(
           *vars,
           "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
@@ -2042,7 +2088,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
           "    $prefix$$Service$_method_names[$Idx$],\n"
           "    ::grpc::internal::RpcMethod::CLIENT_STREAMING,\n"
-          "    new ::grpc::internal::ClientStreamingHandler< "
+          "    new ::grpc::internal::$ArenaPrefix$ClientStreamingHandler< "
           "$ns$$Service$::Service, $Request$, $Response$>(\n"
           "        []($ns$$Service$::Service* service,\n"
           "           ::grpc::ServerContext* ctx,\n"
@@ -2056,7 +2102,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
           "    $prefix$$Service$_method_names[$Idx$],\n"
           "    ::grpc::internal::RpcMethod::SERVER_STREAMING,\n"
-          "    new ::grpc::internal::ServerStreamingHandler< "
+          "    new ::grpc::internal::$ArenaPrefix$ServerStreamingHandler< "
           "$ns$$Service$::Service, $Request$, $Response$>(\n"
           "        []($ns$$Service$::Service* service,\n"
           "           ::grpc::ServerContext* ctx,\n"
@@ -2103,6 +2149,7 @@ std::string GetSourceServices(grpc_generator::File* file,
     if (!file->package().empty()) {
       vars["Package"].append(".");
     }
+    SetArenaMessagesVars(params, &vars);
     if (!params.services_namespace.empty()) {
       vars["ns"] = params.services_namespace + "::";
       vars["prefix"] = params.services_namespace;
@@ -64,6 +64,9 @@ struct Parameters {
   std::string message_header_extension;
   // Whether to include headers corresponding to imports in source file.
   bool include_import_headers;
+  // Create the request and response messages of server handlers in a
+  // protobuf arena tied to the call.
+  bool use_arena_messages;
 };
 
 // Return the prologue of the generated header file.
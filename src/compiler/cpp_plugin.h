@@ -53,6 +53,7 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     generator_parameters.use_system_headers = true;
     generator_parameters.generate_mock_code = false;
     generator_parameters.include_import_headers = false;
+    generator_parameters.use_arena_messages = false;
 
     ProtoBufFile pbfile(file);
 
@@ -97,6 +98,13 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
             *error = std::string("Invalid parameter: ") + *parameter_string;
             return false;
           }
+        } else if (param[0] == "use_arena_messages") {
+          if (param[1] == "true") {
+            generator_parameters.use_arena_messages = true;
+          } else if (param[1] != "false") {
+            *error = std::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
         } else {
           *error = std::string("Unknown parameter: ") + *parameter_string;
           return false;
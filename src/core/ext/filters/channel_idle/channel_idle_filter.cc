@@ -173,21 +173,17 @@ void MaxAgeFilter::PostInit() {
               GRPC_CHANNEL_STACK_REF(this->channel_stack(),
                                      "max_age send_goaway");
               // Jump out of the activity to send the goaway.
-              auto fn = [](void* arg, grpc_error_handle) {
-                auto* channel_stack = static_cast<grpc_channel_stack*>(arg);
+              grpc_channel_stack* stack = this->channel_stack();
+              ExecCtx::RunCallback(DEBUG_LOCATION, [stack]() {
                 grpc_transport_op* op = grpc_make_transport_op(nullptr);
                 op->goaway_error = grpc_error_set_int(
                     GRPC_ERROR_CREATE_FROM_STATIC_STRING("max_age"),
                     GRPC_ERROR_INT_HTTP2_ERROR, GRPC_HTTP2_NO_ERROR);
                 grpc_channel_element* elem =
-                    grpc_channel_stack_element(channel_stack, 0);
+                    grpc_channel_stack_element(stack, 0);
                 elem->filter->start_transport_op(elem, op);
-                GRPC_CHANNEL_STACK_UNREF(channel_stack, "max_age send_goaway");
-              };
-              ExecCtx::Run(
-                  DEBUG_LOCATION,
-                  GRPC_CLOSURE_CREATE(fn, this->channel_stack(), nullptr),
-                  absl::OkStatus());
+                GRPC_CHANNEL_STACK_UNREF(stack, "max_age send_goaway");
+              });
               return Immediate(absl::OkStatus());
             },
             // Sleep for the grace period
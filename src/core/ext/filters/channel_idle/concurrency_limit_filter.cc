@@ -0,0 +1,128 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/channel_idle/concurrency_limit_filter.h"
+
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/types/variant.h"
+#include "absl/utility/utility.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/promise/poll.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+
+namespace grpc_core {
+
+namespace {
+
+const int kDefaultMaxConcurrencyLimit = 1000;
+
+// A call admitted by the limiter. Reports the call's latency to the limiter
+// when it completes, or just gives the call's place back if it goes away
+// before completing.
+class CallPermit {
+ public:
+  explicit CallPermit(ConcurrencyLimiter* limiter)
+      : limiter_(limiter), start_(gpr_now(GPR_CLOCK_MONOTONIC)) {}
+  CallPermit(CallPermit&& other) noexcept
+      : limiter_(absl::exchange(other.limiter_, nullptr)),
+        start_(other.start_) {}
+  CallPermit& operator=(CallPermit&&) = delete;
+  ~CallPermit() {
+    if (limiter_ != nullptr) limiter_->Drop();
+  }
+
+  void Complete() {
+    limiter_->Release(gpr_timespec_to_micros(
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_)));
+    limiter_ = nullptr;
+  }
+
+ private:
+  ConcurrencyLimiter* limiter_;
+  gpr_timespec start_;
+};
+
+ChannelArgs EnsureConcurrencyLimiterInChannelArgs(const ChannelArgs& args) {
+  if (args.GetObject<ConcurrencyLimiter>() != nullptr) return args;
+  if (!args.GetBool(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT)
+           .value_or(false)) {
+    return args;
+  }
+  // Created once per server, with the server's args, so that all its
+  // connections share the limit.
+  return args.SetObject(MakeRefCounted<ConcurrencyLimiter>(
+      args.GetInt(GRPC_ARG_SERVER_MAX_CONCURRENCY_LIMIT)
+          .value_or(kDefaultMaxConcurrencyLimit)));
+}
+
+}  // namespace
+
+absl::StatusOr<ConcurrencyLimitFilter> ConcurrencyLimitFilter::Create(
+    const ChannelArgs& args, ChannelFilter::Args) {
+  auto limiter = args.GetObjectRef<ConcurrencyLimiter>();
+  if (limiter == nullptr) {
+    return absl::InvalidArgumentError("concurrency limiter missing");
+  }
+  return ConcurrencyLimitFilter(std::move(limiter));
+}
+
+ArenaPromise<ServerMetadataHandle> ConcurrencyLimitFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  if (!limiter_->TryAcquire()) {
+    return ArenaPromise<ServerMetadataHandle>(Immediate(ServerMetadataHandle(
+        absl::ResourceExhaustedError("Server concurrency limit reached"))));
+  }
+  return ArenaPromise<ServerMetadataHandle>(
+      [permit = CallPermit(limiter_.get()),
+       next = next_promise_factory(std::move(call_args))]() mutable
+      -> Poll<ServerMetadataHandle> {
+        auto r = next();
+        if (!absl::holds_alternative<Pending>(r)) permit.Complete();
+        return r;
+      });
+}
+
+const grpc_channel_filter ConcurrencyLimitFilter::kFilter =
+    MakePromiseBasedFilter<ConcurrencyLimitFilter, FilterEndpoint::kServer>(
+        "concurrency_limit");
+
+void RegisterConcurrencyLimitFilter(CoreConfiguration::Builder* builder) {
+  builder->channel_args_preconditioning()->RegisterStage(
+      EnsureConcurrencyLimiterInChannelArgs);
+  // Prepended after the max_age filter, so calls are turned away before any
+  // other filter spends time on them.
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (!channel_args.WantMinimalStack() &&
+            channel_args.GetObject<ConcurrencyLimiter>() != nullptr) {
+          builder->PrependFilter(&ConcurrencyLimitFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
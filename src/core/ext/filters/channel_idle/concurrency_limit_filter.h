@@ -0,0 +1,57 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMIT_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMIT_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <utility>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/ext/filters/channel_idle/concurrency_limiter.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+// Server filter that fails calls over the server's ConcurrencyLimiter with
+// RESOURCE_EXHAUSTED as they start, before any of their messages are read,
+// and feeds the latency of the calls it lets through back to the limiter.
+class ConcurrencyLimitFilter final : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ConcurrencyLimitFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ private:
+  explicit ConcurrencyLimitFilter(RefCountedPtr<ConcurrencyLimiter> limiter)
+      : limiter_(std::move(limiter)) {}
+
+  RefCountedPtr<ConcurrencyLimiter> limiter_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMIT_FILTER_H
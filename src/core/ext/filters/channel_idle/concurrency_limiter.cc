@@ -0,0 +1,78 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/channel_idle/concurrency_limiter.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+namespace grpc_core {
+
+namespace {
+// Calls over which the no-load latency is averaged.
+constexpr double kLongWindow = 600;
+// How much slower than usual calls may be before the limit shrinks.
+constexpr double kTolerance = 1.5;
+// Share of each new limit estimate in the limit.
+constexpr double kSmoothing = 0.2;
+}  // namespace
+
+constexpr int ConcurrencyLimiter::kMinLimit;
+
+ConcurrencyLimiter::ConcurrencyLimiter(int max_limit)
+    : max_limit_(std::max(max_limit, kMinLimit)) {}
+
+bool ConcurrencyLimiter::TryAcquire() {
+  if (in_flight_.fetch_add(1, std::memory_order_relaxed) >=
+      limit_.load(std::memory_order_relaxed)) {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void ConcurrencyLimiter::Drop() {
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ConcurrencyLimiter::Release(double latency_us) {
+  latency_us = std::max(latency_us, 1.0);
+  // Includes this call.
+  const int in_flight = in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  MutexLock lock(&mu_);
+  if (long_latency_us_ == 0) {
+    long_latency_us_ = latency_us;
+  } else {
+    long_latency_us_ += (latency_us - long_latency_us_) / kLongWindow;
+  }
+  // After a spell of slow calls the average is left too high: let it catch
+  // up with calls that are fast again.
+  if (long_latency_us_ > 2 * latency_us) long_latency_us_ *= 0.95;
+  // A server that does not use its limit cannot tell whether it could take
+  // more.
+  if (in_flight < estimated_limit_ / 2) return;
+  const double gradient =
+      Clamp(kTolerance * long_latency_us_ / latency_us, 0.5, 1.0);
+  const double new_limit =
+      estimated_limit_ * gradient + sqrt(estimated_limit_);
+  estimated_limit_ = Clamp(
+      estimated_limit_ * (1 - kSmoothing) + new_limit * kSmoothing,
+      static_cast<double>(kMinLimit), static_cast<double>(max_limit_));
+  limit_.store(static_cast<int>(estimated_limit_), std::memory_order_relaxed);
+}
+
+}  // namespace grpc_core
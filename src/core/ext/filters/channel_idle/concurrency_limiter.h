@@ -0,0 +1,85 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMITER_H
+#define GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMITER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Adaptive limit on the number of calls a server runs at once.
+//
+// The limit follows the gradient between the latency calls have when the
+// server is not loaded (a slow moving average of the latency) and the
+// latency they have now: while they match, the limit grows by a small queue
+// allowance; once calls take longer than usual - they are queueing somewhere
+// in the server - the limit shrinks in proportion. Calls over the limit are
+// meant to be failed straight away, which is far cheaper for an overloaded
+// server than running them late.
+//
+// Shared by all the connections of a server through its channel args.
+class ConcurrencyLimiter : public RefCounted<ConcurrencyLimiter> {
+ public:
+  // The limit never goes below this, nor starts elsewhere.
+  static constexpr int kMinLimit = 20;
+
+  explicit ConcurrencyLimiter(int max_limit);
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.concurrency_limiter";
+  }
+  static int ChannelArgsCompare(const ConcurrencyLimiter* a,
+                                const ConcurrencyLimiter* b) {
+    return QsortCompare(a, b);
+  }
+
+  // Admits a call if fewer than limit() calls are in flight. Every admitted
+  // call must be followed by exactly one Release() or Drop().
+  GRPC_MUST_USE_RESULT bool TryAcquire();
+
+  // An admitted call finished, having taken latency_us: adapts the limit.
+  void Release(double latency_us);
+
+  // An admitted call went away without a latency worth learning from, e.g.
+  // because it was cancelled.
+  void Drop();
+
+  int limit() const { return limit_.load(std::memory_order_relaxed); }
+  int in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+ private:
+  const int max_limit_;
+  std::atomic<int> limit_{kMinLimit};
+  std::atomic<int> in_flight_{0};
+
+  Mutex mu_;
+  // The unrounded limit, which limit_ follows.
+  double estimated_limit_ ABSL_GUARDED_BY(mu_) = kMinLimit;
+  // Slow moving average of call latency: the latency without load.
+  double long_latency_us_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONCURRENCY_LIMITER_H
@@ -18,79 +18,90 @@
 
 #include <assert.h>
 
+#include <algorithm>
+
 namespace grpc_core {
 
 IdleFilterState::IdleFilterState(bool start_timer)
-    : state_(start_timer ? kTimerStarted : 0) {}
+    : state_(start_timer ? kTimerStarted : 0),
+      num_shards_(std::max(1u, gpr_cpu_num_cores())),
+      shards_(new Shard[num_shards_]) {}
 
 void IdleFilterState::IncreaseCallCount() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  do {
-    // Increment the counter, and flag that there's been activity.
-    new_state = state;
-    new_state |= kCallsStartedSinceLastTimerCheck;
-    new_state += kCallIncrement;
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
+  this_cpu_shard().started.fetch_add(1, std::memory_order_seq_cst);
+  // Either CheckTimer() sees this call when it adds up the shards, or this
+  // sees it checking and tells it about the call.
+  uintptr_t state = state_.load(std::memory_order_seq_cst);
+  if (state & kCheckingTimer) {
+    state_.fetch_or(kCallsStartedSinceLastTimerCheck,
+                    std::memory_order_seq_cst);
+  }
 }
 
 bool IdleFilterState::DecreaseCallCount() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  bool start_timer;
-  do {
-    start_timer = false;
-    new_state = state;
-    // Decrement call count (and assert there's at least one call outstanding!)
-    assert(new_state >= kCallIncrement);
-    new_state -= kCallIncrement;
-    // If that decrement reaches a call count of zero and we have not started a
-    // timer
-    if ((new_state >> kCallsInProgressShift) == 0 &&
-        (new_state & kTimerStarted) == 0) {
-      // Flag that we will start a timer, and mark it started so nobody else
-      // does.
-      start_timer = true;
-      new_state |= kTimerStarted;
-      new_state &= ~kCallsInProgressShift;
+  this_cpu_shard().finished.fetch_add(1, std::memory_order_seq_cst);
+  uintptr_t state = state_.load(std::memory_order_seq_cst);
+  // The timer will notice when the channel goes idle: nothing else to do.
+  while ((state & kTimerStarted) == 0) {
+    Totals totals = AddUpShards();
+    if (totals.in_progress != 0) return false;
+    // That was the last call in progress, so start the timer, unless someone
+    // else already did.
+    started_at_last_check_.store(totals.started, std::memory_order_relaxed);
+    if (state_.compare_exchange_weak(state, state | kTimerStarted,
+                                     std::memory_order_seq_cst)) {
+      return true;
     }
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
-  return start_timer;
+  }
+  return false;
 }
 
 bool IdleFilterState::CheckTimer() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  bool start_timer;
-  do {
-    if ((state >> kCallsInProgressShift) != 0) {
-      // Still calls in progress: nothing needs updating, just return
-      // and keep the timer going!
+  uintptr_t state =
+      state_.fetch_or(kCheckingTimer, std::memory_order_seq_cst) |
+      kCheckingTimer;
+  for (;;) {
+    Totals totals = AddUpShards();
+    if (totals.in_progress != 0) {
+      // Still calls in progress: just keep the timer going! They count as
+      // activity at the next check.
+      state_.fetch_and(~kCheckingTimer, std::memory_order_seq_cst);
       return true;
     }
-    new_state = state;
-    bool is_active = false;
-    if (new_state & kCallsStartedSinceLastTimerCheck) {
+    if (totals.started !=
+            started_at_last_check_.load(std::memory_order_relaxed) ||
+        (state & kCallsStartedSinceLastTimerCheck) != 0) {
       // If any calls started since the last time we checked, then consider the
       // channel still active and try again.
-      is_active = true;
-      new_state &= ~kCallsStartedSinceLastTimerCheck;
+      started_at_last_check_.store(totals.started, std::memory_order_relaxed);
+      state_.fetch_and(~(kCheckingTimer | kCallsStartedSinceLastTimerCheck),
+                       std::memory_order_seq_cst);
+      return true;
     }
-    if (is_active) {
-      // If we are still active, we should signal that the timer should start
-      // again.
-      start_timer = true;
-    } else {
-      // Otherwise, we should not start the timer again, and we should signal
-      // that in the updated state.
-      start_timer = false;
-      new_state &= ~kTimerStarted;
+    // Otherwise, we should not start the timer again, and we should signal
+    // that in the updated state - unless a call started meanwhile.
+    if (state_.compare_exchange_weak(state,
+                                     state & ~(kTimerStarted | kCheckingTimer),
+                                     std::memory_order_seq_cst)) {
+      return false;
     }
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
-  return start_timer;
+  }
+}
+
+IdleFilterState::Totals IdleFilterState::AddUpShards() const {
+  // Calls finished are added up first: counted after them, the calls started
+  // include every call that finished, so the difference cannot be zero while
+  // any call counted as started is still in progress.
+  uint64_t finished = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    finished += shards_[i].finished.load(std::memory_order_seq_cst);
+  }
+  uint64_t started = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    started += shards_[i].started.load(std::memory_order_seq_cst);
+  }
+  assert(started >= finished);
+  return Totals{started, started - finished};
 }
 
 }  // namespace grpc_core
@@ -20,12 +20,19 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <memory>
+
+#include <grpc/support/cpu.h>
 
 namespace grpc_core {
 
 // State machine for the idle filter.
 // Keeps track of how many calls are in progress, whether there is a timer
 // started, and whether we've seen calls since the previous timer fired.
+//
+// Calls are counted per CPU, so that calls on a channel shared by many threads
+// do not all contend on one cache line. The counts are only added up when the
+// timer fires, or when a call finishes with no timer started.
 class IdleFilterState {
  public:
   explicit IdleFilterState(bool start_timer);
@@ -49,18 +56,38 @@ class IdleFilterState {
   GRPC_MUST_USE_RESULT bool CheckTimer();
 
  private:
+  // Calls started and finished on one CPU. Calls may finish on another CPU
+  // than they started on, so only the totals over all shards mean anything.
+  struct Shard {
+    std::atomic<uint64_t> started{0};
+    std::atomic<uint64_t> finished{0};
+    char padding[GPR_CACHELINE_SIZE - 2 * sizeof(std::atomic<uint64_t>)];
+  };
+  struct Totals {
+    uint64_t started;
+    uint64_t in_progress;
+  };
+
+  Shard& this_cpu_shard() {
+    return shards_[gpr_cpu_current_cpu() % num_shards_];
+  }
+  // Adds up the shards. in_progress is never zero unless there was a moment,
+  // while adding up, at which no call was in progress.
+  Totals AddUpShards() const;
+
   // Bit in state_ indicating that the timer has been started.
   static constexpr uintptr_t kTimerStarted = 1;
-  // Bit in state_ indicating that we've seen a call start or stop since the
-  // last timer.
-  static constexpr uintptr_t kCallsStartedSinceLastTimerCheck = 2;
-  // How much should we shift to get the number of calls in progress.
-  static constexpr uintptr_t kCallsInProgressShift = 2;
-  // How much to increment/decrement the state_ when a call is started/stopped.
-  // Ensures we don't clobber the preceding bits.
-  static constexpr uintptr_t kCallIncrement = uintptr_t(1)
-                                              << kCallsInProgressShift;
+  // Bit in state_ indicating that CheckTimer() is deciding whether the channel
+  // is idle: calls starting meanwhile set kCallsStartedSinceLastTimerCheck.
+  static constexpr uintptr_t kCheckingTimer = 2;
+  // Bit in state_ indicating that we've seen a call start since CheckTimer()
+  // began checking.
+  static constexpr uintptr_t kCallsStartedSinceLastTimerCheck = 4;
   std::atomic<uintptr_t> state_;
+  // Calls started (over all shards) as of the last timer check.
+  std::atomic<uint64_t> started_at_last_check_{0};
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
 };
 
 }  // namespace grpc_core
@@ -22,6 +22,7 @@
 #include <limits.h>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <new>
 #include <set>
@@ -43,6 +44,7 @@
 #include <grpc/status.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/filters/client_channel/backend_metric.h"
 #include "src/core/ext/filters/client_channel/backup_poller.h"
@@ -842,6 +844,57 @@ class ClientChannel::ConnectivityWatcherRemover {
   AsyncConnectivityStateWatcherInterface* watcher_;
 };
 
+//
+// ClientChannel::PickerReadGuard
+//
+
+// Lets a pick read picker_ without holding data_plane_mu_.  The pick is
+// counted against the picker epoch it started in for as long as the guard
+// lives.  A picker replaced in picker_ waits in retired_pickers_ until the
+// next epoch starts, and then in draining_pickers_ until every pick counted
+// against the epoch it was replaced in has finished, so it is never
+// destroyed while a pick may still be using it.
+class ClientChannel::PickerReadGuard {
+ public:
+  explicit PickerReadGuard(ClientChannel* chand)
+      : chand_(chand), active_picks_(&chand->active_picks_.this_cpu()) {
+    while (true) {
+      epoch_ = chand_->picker_epoch_.load(std::memory_order_seq_cst);
+      active_picks_->count[epoch_ % 2].fetch_add(1, std::memory_order_seq_cst);
+      // If the epoch changed before the pick was counted, the pickers
+      // retired in it may already have been destroyed, so count the pick
+      // against the new epoch instead.
+      if (chand_->picker_epoch_.load(std::memory_order_seq_cst) == epoch_) {
+        break;
+      }
+      Release();
+    }
+  }
+
+  ~PickerReadGuard() { Release(); }
+
+  PickerReadGuard(const PickerReadGuard&) = delete;
+  PickerReadGuard& operator=(const PickerReadGuard&) = delete;
+
+  LoadBalancingPolicy::SubchannelPicker* picker() const {
+    return chand_->picker_.load(std::memory_order_seq_cst);
+  }
+
+ private:
+  void Release() {
+    active_picks_->count[epoch_ % 2].fetch_sub(1, std::memory_order_seq_cst);
+    // If the epoch has moved on, this may have been the last pick holding
+    // back the destruction of the pickers retired in it.
+    if (chand_->picker_epoch_.load(std::memory_order_seq_cst) != epoch_) {
+      chand_->MaybeDestroyRetiredPickers();
+    }
+  }
+
+  ClientChannel* chand_;
+  ActivePicks* active_picks_;
+  uint32_t epoch_;
+};
+
 //
 // ClientChannel::ClientChannelControlHelper
 //
@@ -973,6 +1026,26 @@ RefCountedPtr<SubchannelPoolInterface> GetSubchannelPool(
   return GlobalSubchannelPool::instance();
 }
 
+// Records in the channel trace each time the control plane work serializer
+// hands a long drain to the EventEngine, along with its stats.
+WorkSerializer::OffloadObserver MakeWorkSerializerObserver(
+    channelz::ChannelNode* channelz_node) {
+  if (channelz_node == nullptr) return nullptr;
+  // The work serializer can outlive the channel.
+  RefCountedPtr<channelz::BaseNode> node = channelz_node->Ref();
+  return [node](const WorkSerializer::Stats& stats) {
+    static_cast<channelz::ChannelNode*>(node.get())
+        ->AddTraceEvent(
+            channelz::ChannelTrace::Severity::Info,
+            grpc_slice_from_cpp_string(absl::StrCat(
+                "Control plane work offloaded to the EventEngine: drains=",
+                stats.drains, " callbacks=", stats.callbacks,
+                " offloads=", stats.offloads,
+                " max_queue_depth=", stats.max_queue_depth,
+                " drain_time=", stats.drain_time.ToString())));
+  };
+}
+
 }  // namespace
 
 ClientChannel::ClientChannel(grpc_channel_element_args* args,
@@ -985,7 +1058,8 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
       interested_parties_(grpc_pollset_set_create()),
       service_config_parser_index_(
           internal::ClientChannelServiceConfigParser::ParserIndex()),
-      work_serializer_(std::make_shared<WorkSerializer>()),
+      work_serializer_(std::make_shared<WorkSerializer>(
+          MakeWorkSerializerObserver(channelz_node_))),
       state_tracker_("client_channel", GRPC_CHANNEL_IDLE),
       subchannel_pool_(GetSubchannelPool(channel_args_)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_trace)) {
@@ -1063,6 +1137,7 @@ ClientChannel::~ClientChannel() {
     gpr_log(GPR_INFO, "chand=%p: destroying channel", this);
   }
   DestroyResolverAndLbPolicyLocked();
+  delete picker_.load(std::memory_order_relaxed);
   // Stop backup polling.
   grpc_client_channel_stop_backup_polling(interested_parties_);
   grpc_pollset_set_destroy(interested_parties_);
@@ -1567,11 +1642,18 @@ void ClientChannel::UpdateStateAndPickerLocked(
                 state)));
   }
   // Grab data plane lock to update the picker.
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+      pickers_to_destroy;
   {
     MutexLock lock(&data_plane_mu_);
-    // Swap out the picker.
-    // Note: Original value will be destroyed after the lock is released.
-    picker_.swap(picker);
+    // Swap out the picker.  Picks in progress may still be using the old
+    // one, so it is retired instead of destroyed.
+    // Note: The pickers that can be destroyed will be destroyed after the
+    // lock is released.
+    LoadBalancingPolicy::SubchannelPicker* old_picker =
+        picker_.exchange(picker.release(), std::memory_order_seq_cst);
+    if (old_picker != nullptr) retired_pickers_.emplace_back(old_picker);
+    pickers_to_destroy = TakeDrainedPickersLocked();
     // Re-process queued picks.
     for (LbQueuedCall* call = lb_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1626,6 +1708,49 @@ T HandlePickResult(
 
 }  // namespace
 
+std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+ClientChannel::TakeDrainedPickersLocked() {
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>> drained;
+  const uint32_t epoch = picker_epoch_.load(std::memory_order_relaxed);
+  if (!draining_pickers_.empty()) {
+    if (!PicksDrainedLocked(epoch - 1)) return drained;
+    drained = std::move(draining_pickers_);
+    draining_pickers_.clear();
+  }
+  if (retired_pickers_.empty()) return drained;
+  // Start a new epoch, so that the picks that may be using the retired
+  // pickers stop being joined by new ones.
+  draining_pickers_ = std::move(retired_pickers_);
+  retired_pickers_.clear();
+  picker_epoch_.store(epoch + 1, std::memory_order_seq_cst);
+  if (PicksDrainedLocked(epoch)) {
+    for (auto& picker : draining_pickers_) drained.push_back(std::move(picker));
+    draining_pickers_.clear();
+  }
+  return drained;
+}
+
+bool ClientChannel::PicksDrainedLocked(uint32_t epoch) {
+  // A pick counted against an epoch after it has ended backs out before
+  // reading picker_, so once a count is seen at zero, none of the picks
+  // counted in it can be using a retired picker.
+  for (const ActivePicks& active_picks : active_picks_) {
+    if (active_picks.count[epoch % 2].load(std::memory_order_seq_cst) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ClientChannel::MaybeDestroyRetiredPickers() {
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+      pickers_to_destroy;
+  {
+    MutexLock lock(&data_plane_mu_);
+    pickers_to_destroy = TakeDrainedPickersLocked();
+  }
+}
+
 grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   if (state_tracker_.state() != GRPC_CHANNEL_READY) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING("channel not connected");
@@ -1633,7 +1758,8 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   LoadBalancingPolicy::PickResult result;
   {
     MutexLock lock(&data_plane_mu_);
-    result = picker_->Pick(LoadBalancingPolicy::PickArgs());
+    result = picker_.load(std::memory_order_relaxed)
+                 ->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
       &result,
@@ -2816,13 +2942,10 @@ void ClientChannel::LoadBalancedCall::StartTransportStreamOpBatch(
   }
   // Add the batch to the pending list.
   PendingBatchesAdd(batch);
-  // For batches containing a send_initial_metadata op, acquire the
-  // channel's data plane mutex to pick a subchannel.
+  // For batches containing a send_initial_metadata op, pick a subchannel.
   if (GPR_LIKELY(batch->send_initial_metadata)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-      gpr_log(GPR_INFO,
-              "chand=%p lb_call=%p: grabbing data plane mutex to perform pick",
-              chand_, this);
+      gpr_log(GPR_INFO, "chand=%p lb_call=%p: performing pick", chand_, this);
     }
     PickSubchannel(this, absl::OkStatus());
   } else {
@@ -2934,6 +3057,13 @@ void ClientChannel::LoadBalancedCall::RecordCallCompletion(
     absl::Status status) {
   // If we have a tracer, notify it.
   if (call_attempt_tracer_ != nullptr) {
+    if (transport_stream_stats_ != nullptr &&
+        gpr_time_cmp(transport_stream_stats_->first_byte_written,
+                     gpr_inf_past(GPR_CLOCK_MONOTONIC)) != 0) {
+      call_attempt_tracer_->RecordLatencyEvent(
+          CallTracer::CallAttemptTracer::LatencyEvent::kFirstByteWritten,
+          transport_stream_stats_->first_byte_written);
+    }
     call_attempt_tracer_->RecordReceivedTrailingMetadata(
         status, recv_trailing_metadata_, transport_stream_stats_);
   }
@@ -3042,6 +3172,11 @@ void ClientChannel::LoadBalancedCall::MaybeAddCallToLbQueuedCallsLocked() {
   queued_pending_lb_pick_ = true;
   queued_call_.lb_call = this;
   chand_->AddLbQueuedCall(&queued_call_, pollent_);
+  if (call_attempt_tracer_ != nullptr) {
+    call_attempt_tracer_->RecordLatencyEvent(
+        CallTracer::CallAttemptTracer::LatencyEvent::kPickQueued,
+        gpr_now(GPR_CLOCK_MONOTONIC));
+  }
   // Register call combiner cancellation callback.
   lb_call_canceller_ = new LbQueuedCallCanceller(Ref());
 }
@@ -3065,14 +3200,22 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
     return;
   }
   self->call_dispatch_controller_->Commit();
+  if (self->call_attempt_tracer_ != nullptr) {
+    self->call_attempt_tracer_->RecordLatencyEvent(
+        CallTracer::CallAttemptTracer::LatencyEvent::kPickComplete,
+        gpr_now(GPR_CLOCK_MONOTONIC));
+  }
   self->CreateSubchannelCall();
 }
 
 void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
                                                      grpc_error_handle error) {
   auto* self = static_cast<LoadBalancedCall*>(arg);
-  bool pick_complete;
-  {
+  // Only take the data plane mutex if the call may have to be queued.  The
+  // pick is then tried again under the mutex, since the picker may have
+  // been updated, and the queued calls re-processed, in the meantime.
+  bool pick_complete = self->PickSubchannelWithoutLock(&error);
+  if (!pick_complete) {
     MutexLock lock(&self->chand_->data_plane_mu_);
     pick_complete = self->PickSubchannelLocked(&error);
   }
@@ -3081,8 +3224,26 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
   }
 }
 
+bool ClientChannel::LoadBalancedCall::PickSubchannelWithoutLock(
+    grpc_error_handle* error) {
+  PickerReadGuard guard(chand_);
+  LoadBalancingPolicy::SubchannelPicker* picker = guard.picker();
+  return picker != nullptr && PickSubchannelImpl(picker, error);
+}
+
 bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
     grpc_error_handle* error) {
+  if (PickSubchannelImpl(chand_->picker_.load(std::memory_order_relaxed),
+                         error)) {
+    MaybeRemoveCallFromLbQueuedCallsLocked();
+    return true;
+  }
+  MaybeAddCallToLbQueuedCallsLocked();
+  return false;
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelImpl(
+    LoadBalancingPolicy::SubchannelPicker* picker, grpc_error_handle* error) {
   GPR_ASSERT(connected_subchannel_ == nullptr);
   GPR_ASSERT(subchannel_call_ == nullptr);
   // Grab initial metadata.
@@ -3097,91 +3258,79 @@ bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
   pick_args.call_state = &lb_call_state;
   Metadata initial_metadata(initial_metadata_batch);
   pick_args.initial_metadata = &initial_metadata;
-  auto result = chand_->picker_->Pick(pick_args);
+  auto result = picker->Pick(pick_args);
   return HandlePickResult<bool>(
       &result,
       // CompletePick
-      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO,
-                      "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
-                      chand_, this, complete_pick->subchannel.get());
-            }
-            GPR_ASSERT(complete_pick->subchannel != nullptr);
-            // Grab a ref to the connected subchannel while we're still
-            // holding the data plane mutex.
-            SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
-                complete_pick->subchannel.get());
-            connected_subchannel_ = subchannel->connected_subchannel();
-            // If the subchannel has no connected subchannel (e.g., if the
-            // subchannel has moved out of state READY but the LB policy hasn't
-            // yet seen that change and given us a new picker), then just
-            // queue the pick.  We'll try again as soon as we get a new picker.
-            if (connected_subchannel_ == nullptr) {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-                gpr_log(GPR_INFO,
-                        "chand=%p lb_call=%p: subchannel returned by LB picker "
-                        "has no connected subchannel; queueing pick",
-                        chand_, this);
-              }
-              MaybeAddCallToLbQueuedCallsLocked();
-              return false;
-            }
-            lb_subchannel_call_tracker_ =
-                std::move(complete_pick->subchannel_call_tracker);
-            if (lb_subchannel_call_tracker_ != nullptr) {
-              lb_subchannel_call_tracker_->Start();
-            }
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          },
+      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
+                  chand_, this, complete_pick->subchannel.get());
+        }
+        GPR_ASSERT(complete_pick->subchannel != nullptr);
+        SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
+            complete_pick->subchannel.get());
+        connected_subchannel_ = subchannel->connected_subchannel();
+        // If the subchannel has no connected subchannel (e.g., if the
+        // subchannel has moved out of state READY but the LB policy hasn't
+        // yet seen that change and given us a new picker), then just
+        // queue the pick.  We'll try again as soon as we get a new picker.
+        if (connected_subchannel_ == nullptr) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+            gpr_log(GPR_INFO,
+                    "chand=%p lb_call=%p: subchannel returned by LB picker "
+                    "has no connected subchannel; queueing pick",
+                    chand_, this);
+          }
+          return false;
+        }
+        lb_subchannel_call_tracker_ =
+            std::move(complete_pick->subchannel_call_tracker);
+        if (lb_subchannel_call_tracker_ != nullptr) {
+          lb_subchannel_call_tracker_->Start();
+        }
+        return true;
+      },
       // QueuePick
-      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
-                      this);
-            }
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
+                  this);
+        }
+        return false;
+      },
       // FailPick
       [this, initial_metadata_batch,
-       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
-                      chand_, this, fail_pick->status.ToString().c_str());
-            }
-            // If wait_for_ready is false, then the error indicates the RPC
-            // attempt's final status.
-            if (!initial_metadata_batch->GetOrCreatePointer(WaitForReady())
-                     ->value) {
-              *error = absl_status_to_grpc_error(MaybeRewriteIllegalStatusCode(
-                  std::move(fail_pick->status), "LB pick"));
-              MaybeRemoveCallFromLbQueuedCallsLocked();
-              return true;
-            }
-            // If wait_for_ready is true, then queue to retry when we get a new
-            // picker.
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
+                  chand_, this, fail_pick->status.ToString().c_str());
+        }
+        // If wait_for_ready is false, then the error indicates the RPC
+        // attempt's final status.
+        if (!initial_metadata_batch->GetOrCreatePointer(WaitForReady())
+                 ->value) {
+          *error = absl_status_to_grpc_error(MaybeRewriteIllegalStatusCode(
+              std::move(fail_pick->status), "LB pick"));
+          return true;
+        }
+        // If wait_for_ready is true, then queue to retry when we get a new
+        // picker.
+        return false;
+      },
       // DropPick
-      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
-                      chand_, this, drop_pick->status.ToString().c_str());
-            }
-            *error = grpc_error_set_int(
-                absl_status_to_grpc_error(MaybeRewriteIllegalStatusCode(
-                    std::move(drop_pick->status), "LB drop")),
-                GRPC_ERROR_INT_LB_POLICY_DROP, 1);
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          });
+      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
+                  chand_, this, drop_pick->status.ToString().c_str());
+        }
+        *error = grpc_error_set_int(
+            absl_status_to_grpc_error(MaybeRewriteIllegalStatusCode(
+                std::move(drop_pick->status), "LB drop")),
+            GRPC_ERROR_INT_LB_POLICY_DROP, 1);
+        return true;
+      });
 }
 
 }  // namespace grpc_core
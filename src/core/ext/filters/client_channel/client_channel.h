@@ -27,6 +27,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
@@ -51,6 +52,7 @@
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -181,6 +183,7 @@ class ClientChannel {
   class ClientChannelControlHelper;
   class ConnectivityWatcherAdder;
   class ConnectivityWatcherRemover;
+  class PickerReadGuard;
 
   // Represents a pending connectivity callback from an external caller
   // via grpc_client_channel_watch_connectivity_state().
@@ -230,6 +233,14 @@ class ClientChannel {
     LbQueuedCall* next = nullptr;
   };
 
+  // Picks in progress on one CPU that read picker_ without holding
+  // data_plane_mu_, counted by the parity of the picker epoch they started
+  // in, and padded to avoid false sharing between CPUs.
+  struct ActivePicks {
+    std::atomic<intptr_t> count[2] = {};
+    char padding[GPR_CACHELINE_SIZE - 2 * sizeof(std::atomic<intptr_t>)];
+  };
+
   ClientChannel(grpc_channel_element_args* args, grpc_error_handle* error);
   ~ClientChannel();
 
@@ -296,6 +307,17 @@ class ClientChannel {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
   void RemoveLbQueuedCall(LbQueuedCall* to_remove, grpc_polling_entity* pollent)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
+  // Returns the retired pickers that no pick can be using anymore, to be
+  // destroyed after releasing data_plane_mu_, and starts a new picker epoch
+  // if there are pickers waiting for one.
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+  TakeDrainedPickersLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
+  // Returns true if no pick started in the given picker epoch is still
+  // running.
+  bool PicksDrainedLocked(uint32_t epoch)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
+  // Destroys the retired pickers that no pick can be using anymore.
+  void MaybeDestroyRetiredPickers() ABSL_LOCKS_EXCLUDED(data_plane_mu_);
 
   //
   // Fields set at construction and never modified.
@@ -329,11 +351,23 @@ class ClientChannel {
       ABSL_GUARDED_BY(resolution_mu_);
 
   //
-  // Fields used in the data plane.  Guarded by data_plane_mu_.
+  // Fields used in the data plane.  Guarded by data_plane_mu_, except that
+  // picks read picker_ without it (see PickerReadGuard).
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-      ABSL_GUARDED_BY(data_plane_mu_);
+  // Owned.  Only written while holding data_plane_mu_.
+  std::atomic<LoadBalancingPolicy::SubchannelPicker*> picker_{nullptr};
+  // Pickers replaced in picker_ since the epoch last changed.  Picks started
+  // in the current epoch may still be using them.
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+      retired_pickers_ ABSL_GUARDED_BY(data_plane_mu_);
+  // Pickers replaced in picker_ before the epoch last changed.  They are
+  // destroyed once the picks started in the previous epoch have finished.
+  std::vector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>>
+      draining_pickers_ ABSL_GUARDED_BY(data_plane_mu_);
+  // Only written while holding data_plane_mu_.
+  std::atomic<uint32_t> picker_epoch_{0};
+  PerCpu<ActivePicks> active_picks_;
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
 
@@ -397,8 +431,9 @@ class ClientChannel::LoadBalancedCall
     void* Alloc(size_t size) override { return lb_call_->arena_->Alloc(size); }
 
     // Internal API to allow first-party LB policies to access per-call
-    // attributes set by the ConfigSelector.
-    absl::string_view GetCallAttribute(UniqueTypeName type);
+    // attributes set by the ConfigSelector.  Virtual so that benchmarks can
+    // pick without a call.
+    virtual absl::string_view GetCallAttribute(UniqueTypeName type);
 
    private:
     LoadBalancedCall* lb_call_;
@@ -421,11 +456,13 @@ class ClientChannel::LoadBalancedCall
 
   void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
 
-  // Invoked by channel for queued LB picks when the picker is updated.
+  // Performs the LB pick for the call, without holding the data plane
+  // mutex unless the call has to be queued.
   static void PickSubchannel(void* arg, grpc_error_handle error);
   // Helper function for performing an LB pick while holding the data plane
   // mutex.  Returns true if the pick is complete, in which case the caller
   // must invoke PickDone() or AsyncPickDone() with the returned error.
+  // Otherwise, the call is queued until the picker is updated.
   bool PickSubchannelLocked(grpc_error_handle* error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
   // Schedules a callback to process the completed pick.  The callback
@@ -480,6 +517,14 @@ class ClientChannel::LoadBalancedCall
   void CreateSubchannelCall();
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error_handle error);
+  // Performs an LB pick with picker.  Returns true if the pick is complete,
+  // as for PickSubchannelLocked(), or false if the call needs to be queued,
+  // which is left to the caller.
+  bool PickSubchannelImpl(LoadBalancingPolicy::SubchannelPicker* picker,
+                          grpc_error_handle* error);
+  // Performs an LB pick without holding the data plane mutex.  Returns false
+  // if the pick needs to be retried with PickSubchannelLocked().
+  bool PickSubchannelWithoutLock(grpc_error_handle* error);
   // Removes the call from the channel's list of queued picks if present.
   void MaybeRemoveCallFromLbQueuedCallsLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
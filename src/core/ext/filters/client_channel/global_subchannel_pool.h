@@ -21,9 +21,12 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
+#include <stddef.h>
+
+#include <array>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -40,22 +43,30 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
 
   // Implements interface methods.
   RefCountedPtr<Subchannel> RegisterSubchannel(
-      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override;
   void UnregisterSubchannel(const SubchannelKey& key,
-                            Subchannel* subchannel) override
-      ABSL_LOCKS_EXCLUDED(mu_);
-  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+                            Subchannel* subchannel) override;
+  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override;
 
  private:
+  // Keys are spread over this many independently locked maps, so that
+  // channels created concurrently to different addresses don't contend.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // To protect subchannel_map.
+    Mutex mu;
+    // A map from subchannel key to subchannel.
+    absl::flat_hash_map<SubchannelKey, Subchannel*> subchannel_map
+        ABSL_GUARDED_BY(mu);
+  };
+
   GlobalSubchannelPool() {}
   ~GlobalSubchannelPool() override {}
 
-  // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
-  // To protect subchannel_map_.
-  Mutex mu_;
+  Shard& ShardForKey(const SubchannelKey& key);
+
+  std::array<Shard, kNumShards> shards_;
 };
 
 }  // namespace grpc_core
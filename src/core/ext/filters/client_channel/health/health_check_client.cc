@@ -22,13 +22,17 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "upb/upb.h"
 #include "upb/upb.hpp"
 
@@ -39,6 +43,9 @@
 
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/proto/grpc/health/v1/health.upb.h"
 
@@ -155,6 +162,142 @@ class HealthStreamEventHandler
   RefCountedPtr<ConnectivityStateWatcherInterface> watcher_;
 };
 
+//
+// SharedHealthCheck
+//
+
+class SharedHealthCheck;
+
+NoDestruct<Mutex> g_shared_mu;
+// Keyed by address and service name.
+NoDestruct<std::map<std::pair<std::string, std::string>, SharedHealthCheck*>>
+    g_shared_health_checks ABSL_GUARDED_BY(g_shared_mu);
+
+// A health check stream and the clients sharing it.
+class SharedHealthCheck : public RefCounted<SharedHealthCheck> {
+ public:
+  // A client of the shared stream, returned by
+  // MakeSharedHealthCheckClient().  Orphaning it leaves the stream.
+  class Member : public Orphanable {
+   public:
+    Member(RefCountedPtr<SharedHealthCheck> shared,
+           RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+           grpc_pollset_set* interested_parties,
+           RefCountedPtr<channelz::SubchannelNode> channelz_node,
+           RefCountedPtr<ConnectivityStateWatcherInterface> watcher)
+        : shared_(std::move(shared)),
+          connected_subchannel_(std::move(connected_subchannel)),
+          interested_parties_(interested_parties),
+          channelz_node_(std::move(channelz_node)),
+          watcher_(std::move(watcher)) {}
+
+    void Orphan() override {
+      {
+        MutexLock lock(g_shared_mu.get());
+        shared_->RemoveMemberLocked(this);
+      }
+      delete this;
+    }
+
+   private:
+    friend class SharedHealthCheck;
+
+    RefCountedPtr<SharedHealthCheck> shared_;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+    grpc_pollset_set* interested_parties_;
+    RefCountedPtr<channelz::SubchannelNode> channelz_node_;
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher_;
+  };
+
+  SharedHealthCheck(std::string address, std::string service_name)
+      : address_(std::move(address)), service_name_(std::move(service_name)) {}
+
+  void AddMemberLocked(Member* member)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(g_shared_mu) {
+    members_.push_back(member);
+    if (stream_ == nullptr) {
+      StartStreamLocked(member, /*handing_over=*/false);
+    } else if (state_.has_value()) {
+      member->watcher_->Notify(*state_, status_);
+    }
+  }
+
+  void RemoveMemberLocked(Member* member)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(g_shared_mu) {
+    members_.erase(std::find(members_.begin(), members_.end(), member));
+    if (members_.empty()) {
+      stream_.reset();
+      stream_member_ = nullptr;
+      ++stream_id_;
+      auto it = g_shared_health_checks->find({address_, service_name_});
+      if (it != g_shared_health_checks->end() && it->second == this) {
+        g_shared_health_checks->erase(it);
+      }
+    } else if (member == stream_member_) {
+      // The stream ran on the departing member's connection.
+      StartStreamLocked(members_.front(), /*handing_over=*/true);
+    }
+  }
+
+ private:
+  // Watches the health reported on one of the streams started for the
+  // clients, so that reports from streams since replaced are dropped.
+  class StreamWatcher : public AsyncConnectivityStateWatcherInterface {
+   public:
+    StreamWatcher(RefCountedPtr<SharedHealthCheck> shared, uint64_t stream_id)
+        : shared_(std::move(shared)), stream_id_(stream_id) {}
+
+   private:
+    void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                   const absl::Status& status) override {
+      shared_->OnStreamStateChange(stream_id_, new_state, status);
+    }
+
+    RefCountedPtr<SharedHealthCheck> shared_;
+    const uint64_t stream_id_;
+  };
+
+  void StartStreamLocked(Member* member, bool handing_over)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(g_shared_mu) {
+    stream_member_ = member;
+    // The new stream reports CONNECTING while it starts; the clients already
+    // know the backend's health, so don't make them flap through it.
+    handing_over_ = handing_over && state_.has_value();
+    stream_ = MakeHealthCheckClient(
+        service_name_, member->connected_subchannel_,
+        member->interested_parties_, member->channelz_node_,
+        MakeRefCounted<StreamWatcher>(Ref(), ++stream_id_));
+  }
+
+  void OnStreamStateChange(uint64_t stream_id, grpc_connectivity_state state,
+                           const absl::Status& status) {
+    MutexLock lock(g_shared_mu.get());
+    if (stream_id != stream_id_) return;
+    if (handing_over_) {
+      if (state == GRPC_CHANNEL_CONNECTING) return;
+      handing_over_ = false;
+    }
+    state_ = state;
+    status_ = status;
+    for (Member* member : members_) {
+      member->watcher_->Notify(state, status);
+    }
+  }
+
+  const std::string address_;
+  const std::string service_name_;
+  std::vector<Member*> members_ ABSL_GUARDED_BY(g_shared_mu);
+  // The member whose connection carries stream_.
+  Member* stream_member_ ABSL_GUARDED_BY(g_shared_mu) = nullptr;
+  OrphanablePtr<SubchannelStreamClient> stream_ ABSL_GUARDED_BY(g_shared_mu);
+  uint64_t stream_id_ ABSL_GUARDED_BY(g_shared_mu) = 0;
+  bool handing_over_ ABSL_GUARDED_BY(g_shared_mu) = false;
+  // The last health status reported on the stream, passed to members that
+  // join after it.
+  absl::optional<grpc_connectivity_state> state_ ABSL_GUARDED_BY(g_shared_mu);
+  absl::Status status_ ABSL_GUARDED_BY(g_shared_mu);
+};
+
 }  // namespace
 
 OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
@@ -173,4 +316,27 @@ OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
           : nullptr);
 }
 
+OrphanablePtr<Orphanable> MakeSharedHealthCheckClient(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher) {
+  MutexLock lock(g_shared_mu.get());
+  auto key = std::make_pair(std::move(address), std::move(service_name));
+  RefCountedPtr<SharedHealthCheck> shared;
+  auto it = g_shared_health_checks->find(key);
+  if (it != g_shared_health_checks->end()) {
+    shared = it->second->Ref();
+  } else {
+    shared = MakeRefCounted<SharedHealthCheck>(key.first, key.second);
+    g_shared_health_checks->emplace(std::move(key), shared.get());
+  }
+  auto* member = new SharedHealthCheck::Member(
+      shared, std::move(connected_subchannel), interested_parties,
+      std::move(channelz_node), std::move(watcher));
+  shared->AddMemberLocked(member);
+  return OrphanablePtr<Orphanable>(member);
+}
+
 }  // namespace grpc_core
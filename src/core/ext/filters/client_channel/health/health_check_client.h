@@ -38,6 +38,20 @@ OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
     RefCountedPtr<channelz::SubchannelNode> channelz_node,
     RefCountedPtr<ConnectivityStateWatcherInterface> watcher);
 
+// Like MakeHealthCheckClient(), but shares one health check stream among
+// all the clients for the same address and service name in the process,
+// so that subchannels that could not be shared because their channel args
+// differ still cost the backend a single Watch call.  The stream runs on
+// the connection of one of the clients and moves to another one when that
+// client is orphaned.  Every client's watcher is notified of the health
+// status reported on the shared stream.
+OrphanablePtr<Orphanable> MakeSharedHealthCheckClient(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_HEALTH_HEALTH_CHECK_CLIENT_H
@@ -21,6 +21,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <map>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -77,6 +78,11 @@ absl::StatusOr<HierarchicalAddressMap> MakeHierarchicalAddressMap(
     const absl::StatusOr<ServerAddressList>& addresses) {
   if (!addresses.ok()) return addresses.status();
   HierarchicalAddressMap result;
+  // Addresses sharing a path attribute (typically all the addresses of a
+  // locality) also share the attribute holding the rest of the path.
+  std::map<const HierarchicalPathAttribute*,
+           std::shared_ptr<const HierarchicalPathAttribute>>
+      remaining_path_attributes;
   for (const ServerAddress& address : *addresses) {
     const HierarchicalPathAttribute* path_attribute =
         static_cast<const HierarchicalPathAttribute*>(
@@ -85,14 +91,17 @@ absl::StatusOr<HierarchicalAddressMap> MakeHierarchicalAddressMap(
     const std::vector<std::string>& path = path_attribute->path();
     auto it = path.begin();
     ServerAddressList& target_list = result[*it];
-    std::unique_ptr<HierarchicalPathAttribute> new_attribute;
     ++it;
+    std::shared_ptr<const HierarchicalPathAttribute> new_attribute;
     if (it != path.end()) {
-      std::vector<std::string> remaining_path(it, path.end());
-      new_attribute = absl::make_unique<HierarchicalPathAttribute>(
-          std::move(remaining_path));
+      auto& cached = remaining_path_attributes[path_attribute];
+      if (cached == nullptr) {
+        cached = std::make_shared<HierarchicalPathAttribute>(
+            std::vector<std::string>(it, path.end()));
+      }
+      new_attribute = cached;
     }
-    target_list.emplace_back(address.WithAttribute(
+    target_list.emplace_back(address.WithSharedAttribute(
         kHierarchicalPathAttributeKey, std::move(new_attribute)));
   }
   return result;
@@ -32,6 +32,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/random/random.h"
 #include "absl/status/status.h"
@@ -51,8 +53,10 @@
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/env.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/gprpp/work_serializer.h"
 #include "src/core/lib/iomgr/closure.h"
@@ -99,7 +103,8 @@ class OutlierDetectionLbConfig : public LoadBalancingPolicy::Config {
 
   bool CountingEnabled() const {
     return outlier_detection_config_.success_rate_ejection.has_value() ||
-           outlier_detection_config_.failure_percentage_ejection.has_value();
+           outlier_detection_config_.failure_percentage_ejection.has_value() ||
+           outlier_detection_config_.consecutive_failure_ejection.has_value();
   }
 
   const OutlierDetectionConfig& outlier_detection_config() const {
@@ -224,32 +229,48 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
         watchers_;
   };
 
-  class SubchannelState : public RefCounted<SubchannelState> {
+  // The calls each address finished since the last interval. Sharded by
+  // CPU, so that calls finishing on different CPUs do not contend, and
+  // holding only the addresses that had calls, so that the ejection timer
+  // only looks at those.
+  class CallCounts : public RefCounted<CallCounts> {
    public:
-    struct Bucket {
-      std::atomic<uint64_t> successes;
-      std::atomic<uint64_t> failures;
+    struct Counts {
+      uint64_t successes = 0;
+      uint64_t failures = 0;
+    };
+    struct Entry {
+      RefCountedPtr<SubchannelState> subchannel_state;
+      Counts counts;
     };
+    using Map = absl::flat_hash_map<SubchannelState*, Entry>;
 
-    void RotateBucket() {
-      backup_bucket_->successes = 0;
-      backup_bucket_->failures = 0;
-      current_bucket_.swap(backup_bucket_);
-      active_bucket_.store(current_bucket_.get());
-    }
+    CallCounts() = default;
+    ~CallCounts();
 
-    absl::optional<std::pair<double, uint64_t>> GetSuccessRateAndVolume() {
-      uint64_t total_request =
-          backup_bucket_->successes + backup_bucket_->failures;
-      if (total_request == 0) {
-        return absl::nullopt;
-      }
-      double success_rate =
-          backup_bucket_->successes * 100.0 /
-          (backup_bucket_->successes + backup_bucket_->failures);
-      return {
-          {success_rate, backup_bucket_->successes + backup_bucket_->failures}};
-    }
+    void AddCall(SubchannelState* subchannel_state, bool success);
+
+    // Returns the counts since the last call and starts counting again.
+    Map Collect();
+
+    // Drops the counts and stops counting. The counts hold refs to the
+    // subchannel states, which hold refs to this.
+    void Shutdown();
+
+   private:
+    struct Shard {
+      Mutex mu;
+      Map counts ABSL_GUARDED_BY(mu);
+      bool shutdown ABSL_GUARDED_BY(mu) = false;
+    };
+
+    PerCpu<Shard> shards_;
+  };
+
+  class SubchannelState : public RefCounted<SubchannelState> {
+   public:
+    explicit SubchannelState(RefCountedPtr<CallCounts> call_counts)
+        : call_counts_(std::move(call_counts)) {}
 
     void AddSubchannel(SubchannelWrapper* wrapper) {
       subchannels_.insert(wrapper);
@@ -259,9 +280,20 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
       subchannels_.erase(wrapper);
     }
 
-    void AddSuccessCount() { active_bucket_.load()->successes.fetch_add(1); }
+    void AddCall(bool success) { call_counts_->AddCall(this, success); }
 
-    void AddFailureCount() { active_bucket_.load()->failures.fetch_add(1); }
+    // Returns true if this failure makes limit failures in a row.
+    bool AddConsecutiveFailure(uint32_t limit) {
+      return consecutive_failures_.fetch_add(1, std::memory_order_relaxed) +
+                 1 ==
+             limit;
+    }
+
+    void ResetConsecutiveFailures() {
+      if (consecutive_failures_.load(std::memory_order_relaxed) != 0) {
+        consecutive_failures_.store(0, std::memory_order_relaxed);
+      }
+    }
 
     absl::optional<Timestamp> ejection_time() const { return ejection_time_; }
 
@@ -306,12 +338,20 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
       multiplier_ = 0;
     }
 
+    // Whether the address is ejected or will have its multiplier decreased
+    // at the next interval.
+    bool penalized() const {
+      return ejection_time_.has_value() || multiplier_ > 0;
+    }
+
+    // Whether the address is no longer in the policy's addresses.
+    bool removed() const { return removed_; }
+    void set_removed() { removed_ = true; }
+
    private:
-    std::unique_ptr<Bucket> current_bucket_ = absl::make_unique<Bucket>();
-    std::unique_ptr<Bucket> backup_bucket_ = absl::make_unique<Bucket>();
-    // The bucket used to update call counts.
-    // Points to either current_bucket or active_bucket.
-    std::atomic<Bucket*> active_bucket_{current_bucket_.get()};
+    const RefCountedPtr<CallCounts> call_counts_;
+    std::atomic<uint32_t> consecutive_failures_{0};
+    bool removed_ = false;
     uint32_t multiplier_ = 0;
     absl::optional<Timestamp> ejection_time_;
     std::set<SubchannelWrapper*> subchannels_;
@@ -340,6 +380,10 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     class SubchannelCallTracker;
     RefCountedPtr<RefCountedPicker> picker_;
     bool counting_enabled_;
+    // Set if consecutive failure ejection is enabled.
+    RefCountedPtr<OutlierDetectionLb> outlier_detection_lb_;
+    uint32_t consecutive_failures_ = 0;
+    absl::optional<Duration> failure_latency_;
   };
 
   class Helper : public ChannelControlHelper {
@@ -396,6 +440,13 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
 
   void MaybeUpdatePickerLocked();
 
+  // Ejects an address that has failed too many calls in a row, if the
+  // ejection limits allow.
+  void MaybeEjectForConsecutiveFailuresLocked(SubchannelState* state);
+
+  void EjectLocked(SubchannelState* state, Timestamp now);
+  size_t EjectedHostCountLocked() const;
+
   // Current config from the resolver.
   RefCountedPtr<OutlierDetectionLbConfig> config_;
 
@@ -409,9 +460,70 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
   absl::Status status_;
   RefCountedPtr<RefCountedPicker> picker_;
   std::map<std::string, RefCountedPtr<SubchannelState>> subchannel_state_map_;
+  // Call counts for all the addresses in subchannel_state_map_.
+  RefCountedPtr<CallCounts> call_counts_ = MakeRefCounted<CallCounts>();
+  // The addresses in subchannel_state_map_ that are penalized(), so that
+  // the ejection timer need not go through all the addresses.
+  std::set<SubchannelState*> penalized_;
   OrphanablePtr<EjectionTimer> ejection_timer_;
+  absl::BitGen bit_gen_;
 };
 
+//
+// OutlierDetectionLb::CallCounts
+//
+
+OutlierDetectionLb::CallCounts::~CallCounts() = default;
+
+void OutlierDetectionLb::CallCounts::AddCall(SubchannelState* subchannel_state,
+                                             bool success) {
+  Shard& shard = shards_.this_cpu();
+  MutexLock lock(&shard.mu);
+  if (shard.shutdown) return;
+  Entry& entry = shard.counts[subchannel_state];
+  if (entry.subchannel_state == nullptr) {
+    entry.subchannel_state = subchannel_state->Ref();
+  }
+  if (success) {
+    ++entry.counts.successes;
+  } else {
+    ++entry.counts.failures;
+  }
+}
+
+OutlierDetectionLb::CallCounts::Map OutlierDetectionLb::CallCounts::Collect() {
+  Map result;
+  for (Shard& shard : shards_) {
+    Map counts;
+    {
+      MutexLock lock(&shard.mu);
+      counts.swap(shard.counts);
+    }
+    if (result.empty()) {
+      result = std::move(counts);
+      continue;
+    }
+    for (auto& p : counts) {
+      Entry& entry = result[p.first];
+      if (entry.subchannel_state == nullptr) {
+        entry.subchannel_state = std::move(p.second.subchannel_state);
+      }
+      entry.counts.successes += p.second.counts.successes;
+      entry.counts.failures += p.second.counts.failures;
+    }
+  }
+  return result;
+}
+
+void OutlierDetectionLb::CallCounts::Shutdown() {
+  for (Shard& shard : shards_) {
+    Map counts;
+    MutexLock lock(&shard.mu);
+    shard.shutdown = true;
+    counts.swap(shard.counts);
+  }
+}
+
 //
 // OutlierDetectionLb::SubchannelWrapper
 //
@@ -457,17 +569,22 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
   SubchannelCallTracker(
       std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
           original_subchannel_call_tracker,
-      RefCountedPtr<SubchannelState> subchannel_state)
+      RefCountedPtr<SubchannelState> subchannel_state,
+      const Picker& picker)
       : original_subchannel_call_tracker_(
             std::move(original_subchannel_call_tracker)),
-        subchannel_state_(std::move(subchannel_state)) {}
+        subchannel_state_(std::move(subchannel_state)),
+        outlier_detection_lb_(picker.outlier_detection_lb_),
+        consecutive_failures_(picker.consecutive_failures_),
+        failure_latency_(picker.failure_latency_) {}
 
   ~SubchannelCallTracker() override {
     subchannel_state_.reset(DEBUG_LOCATION, "SubchannelCallTracker");
   }
 
   void Start() override {
-    // This tracker does not care about started calls only finished calls.
+    // This tracker only needs to know when calls start to tell slow calls.
+    if (failure_latency_.has_value()) start_time_ = Timestamp::Now();
     // Delegate if needed.
     if (original_subchannel_call_tracker_ != nullptr) {
       original_subchannel_call_tracker_->Start();
@@ -482,18 +599,43 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
     // Record call completion based on status for outlier detection
     // calculations.
     if (subchannel_state_ != nullptr) {
-      if (args.status.ok()) {
-        subchannel_state_->AddSuccessCount();
-      } else {
-        subchannel_state_->AddFailureCount();
-      }
+      subchannel_state_->AddCall(args.status.ok());
+      if (outlier_detection_lb_ != nullptr) RecordConsecutiveFailure(args);
     }
   }
 
  private:
+  void RecordConsecutiveFailure(const FinishArgs& args) {
+    const bool failed =
+        !args.status.ok() ||
+        (failure_latency_.has_value() &&
+         Timestamp::Now() - start_time_ > *failure_latency_);
+    if (!failed) {
+      subchannel_state_->ResetConsecutiveFailures();
+      return;
+    }
+    if (!subchannel_state_->AddConsecutiveFailure(consecutive_failures_)) {
+      return;
+    }
+    // Eject the address now rather than at the next interval, so that it
+    // stops taking calls as soon as it fails.
+    auto work_serializer = outlier_detection_lb_->work_serializer();
+    work_serializer->Run(
+        [outlier_detection_lb = std::move(outlier_detection_lb_),
+         subchannel_state = subchannel_state_]() {
+          outlier_detection_lb->MaybeEjectForConsecutiveFailuresLocked(
+              subchannel_state.get());
+        },
+        DEBUG_LOCATION);
+  }
+
   std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
       original_subchannel_call_tracker_;
   RefCountedPtr<SubchannelState> subchannel_state_;
+  RefCountedPtr<OutlierDetectionLb> outlier_detection_lb_;
+  uint32_t consecutive_failures_;
+  absl::optional<Duration> failure_latency_;
+  Timestamp start_time_;
 };
 
 //
@@ -504,6 +646,15 @@ OutlierDetectionLb::Picker::Picker(OutlierDetectionLb* outlier_detection_lb,
                                    RefCountedPtr<RefCountedPicker> picker,
                                    bool counting_enabled)
     : picker_(std::move(picker)), counting_enabled_(counting_enabled) {
+  const auto& consecutive_failure_ejection =
+      outlier_detection_lb->config_->outlier_detection_config()
+          .consecutive_failure_ejection;
+  if (consecutive_failure_ejection.has_value()) {
+    outlier_detection_lb_ =
+        outlier_detection_lb->Ref(DEBUG_LOCATION, "Picker");
+    consecutive_failures_ = consecutive_failure_ejection->consecutive_failures;
+    failure_latency_ = consecutive_failure_ejection->failure_latency;
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
     gpr_log(GPR_INFO,
             "[outlier_detection_lb %p] constructed new picker %p and counting "
@@ -532,7 +683,7 @@ LoadBalancingPolicy::PickResult OutlierDetectionLb::Picker::Pick(
       complete_pick->subchannel_call_tracker =
           absl::make_unique<SubchannelCallTracker>(
               std::move(complete_pick->subchannel_call_tracker),
-              subchannel_wrapper->subchannel_state());
+              subchannel_wrapper->subchannel_state(), *this);
     }
     complete_pick->subchannel = subchannel_wrapper->wrapped_subchannel();
   }
@@ -570,6 +721,7 @@ void OutlierDetectionLb::ShutdownLocked() {
     gpr_log(GPR_INFO, "[outlier_detection_lb %p] shutting down", this);
   }
   ejection_timer_.reset();
+  call_counts_->Shutdown();
   shutting_down_ = true;
   // Remove the child policy's interested_parties pollset_set from the
   // xDS policy.
@@ -607,15 +759,14 @@ absl::Status OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
               this);
     }
     ejection_timer_.reset();
+    call_counts_->Collect();  // Drop call counters.
   } else if (ejection_timer_ == nullptr) {
     // No timer running.  Start it now.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
       gpr_log(GPR_INFO, "[outlier_detection_lb %p] starting timer", this);
     }
     ejection_timer_ = MakeOrphanable<EjectionTimer>(Ref(), Timestamp::Now());
-    for (const auto& p : subchannel_state_map_) {
-      p.second->RotateBucket();  // Reset call counters.
-    }
+    call_counts_->Collect();  // Reset call counters.
   } else if (old_config->outlier_detection_config().interval !=
              config_->outlier_detection_config().interval) {
     // Timer interval changed.  Cancel the current timer and start a new one
@@ -637,7 +788,7 @@ absl::Status OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
       std::string address_key = MakeKeyForAddress(address);
       auto& subchannel_state = subchannel_state_map_[address_key];
       if (subchannel_state == nullptr) {
-        subchannel_state = MakeRefCounted<SubchannelState>();
+        subchannel_state = MakeRefCounted<SubchannelState>(call_counts_);
         if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
           gpr_log(GPR_INFO,
                   "[outlier_detection_lb %p] adding map entry for %s (%p)",
@@ -652,6 +803,7 @@ absl::Status OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
                   this, address_key.c_str(), subchannel_state.get());
         }
         subchannel_state->DisableEjection();
+        penalized_.erase(subchannel_state.get());
       }
       current_addresses.emplace(address_key);
     }
@@ -665,6 +817,8 @@ absl::Status OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
                   "[outlier_detection_lb %p] removing map entry for %s (%p)",
                   this, it->first.c_str(), it->second.get());
         }
+        it->second->set_removed();
+        penalized_.erase(it->second.get());
         it = subchannel_state_map_.erase(it);
       } else {
         ++it;
@@ -706,6 +860,47 @@ void OutlierDetectionLb::MaybeUpdatePickerLocked() {
   }
 }
 
+void OutlierDetectionLb::MaybeEjectForConsecutiveFailuresLocked(
+    SubchannelState* state) {
+  if (shutting_down_) return;
+  const auto& config = config_->outlier_detection_config();
+  if (!config.consecutive_failure_ejection.has_value()) return;
+  // Failures go on counting while the ejection hops here.
+  state->ResetConsecutiveFailures();
+  // The address may have gone away meanwhile.
+  if (state->removed() || state->ejection_time().has_value()) return;
+  const size_t ejected_host_count = EjectedHostCountLocked();
+  uint32_t random_key = absl::Uniform(bit_gen_, 1, 100);
+  double current_percent =
+      100.0 * ejected_host_count / subchannel_state_map_.size();
+  if (random_key <
+          config.consecutive_failure_ejection->enforcement_percentage &&
+      (ejected_host_count == 0 ||
+       current_percent < config.max_ejection_percent)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+      gpr_log(GPR_INFO,
+              "[outlier_detection_lb %p] ejecting %p after %u consecutive "
+              "failures",
+              this, state,
+              config.consecutive_failure_ejection->consecutive_failures);
+    }
+    EjectLocked(state, Timestamp::Now());
+  }
+}
+
+void OutlierDetectionLb::EjectLocked(SubchannelState* state, Timestamp now) {
+  state->Eject(now);
+  penalized_.insert(state);
+}
+
+size_t OutlierDetectionLb::EjectedHostCountLocked() const {
+  size_t ejected_host_count = 0;
+  for (SubchannelState* state : penalized_) {
+    if (state->ejection_time().has_value()) ++ejected_host_count;
+  }
+  return ejected_host_count;
+}
+
 OrphanablePtr<LoadBalancingPolicy> OutlierDetectionLb::CreateChildPolicyLocked(
     const ChannelArgs& args) {
   LoadBalancingPolicy::Args lb_policy_args;
@@ -828,31 +1023,25 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
     }
     std::map<SubchannelState*, double> success_rate_ejection_candidates;
     std::map<SubchannelState*, double> failure_percentage_ejection_candidates;
-    size_t ejected_host_count = 0;
+    size_t ejected_host_count = parent_->EjectedHostCountLocked();
     double success_rate_sum = 0;
+    double success_rate_sum_of_squares = 0;
     auto time_now = Timestamp::Now();
     auto& config = parent_->config_->outlier_detection_config();
-    for (auto& state : parent_->subchannel_state_map_) {
-      auto* subchannel_state = state.second.get();
-      // For each address, swap the call counter's buckets in that address's
-      // map entry.
-      subchannel_state->RotateBucket();
-      // Gather data to run success rate algorithm or failure percentage
-      // algorithm.
-      if (subchannel_state->ejection_time().has_value()) {
-        ++ejected_host_count;
-      }
-      absl::optional<std::pair<double, uint64_t>> host_success_rate_and_volume =
-          subchannel_state->GetSuccessRateAndVolume();
-      if (!host_success_rate_and_volume.has_value()) {
-        continue;
-      }
-      double success_rate = host_success_rate_and_volume->first;
-      uint64_t request_volume = host_success_rate_and_volume->second;
+    // Gather data to run success rate algorithm or failure percentage
+    // algorithm, from the addresses that had calls in the last interval.
+    const CallCounts::Map call_counts = parent_->call_counts_->Collect();
+    for (const auto& p : call_counts) {
+      auto* subchannel_state = p.first;
+      if (subchannel_state->removed()) continue;
+      const CallCounts::Counts& counts = p.second.counts;
+      uint64_t request_volume = counts.successes + counts.failures;
+      double success_rate = counts.successes * 100.0 / request_volume;
       if (config.success_rate_ejection.has_value()) {
         if (request_volume >= config.success_rate_ejection->request_volume) {
           success_rate_ejection_candidates[subchannel_state] = success_rate;
           success_rate_sum += success_rate;
+          success_rate_sum_of_squares += success_rate * success_rate;
         }
       }
       if (config.failure_percentage_ejection.has_value()) {
@@ -885,11 +1074,11 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
       // calculate ejection threshold: (mean - stdev *
       // (success_rate_ejection.stdev_factor / 1000))
       double mean = success_rate_sum / success_rate_ejection_candidates.size();
-      double variance = 0;
-      for (const auto& p : success_rate_ejection_candidates) {
-        variance += std::pow(p.second - mean, 2);
-      }
-      variance /= success_rate_ejection_candidates.size();
+      double variance = std::max(
+          success_rate_sum_of_squares /
+                  success_rate_ejection_candidates.size() -
+              mean * mean,
+          0.0);
       double stdev = std::sqrt(variance);
       const double success_rate_stdev_factor =
           static_cast<double>(config.success_rate_ejection->stdev_factor) /
@@ -928,7 +1117,7 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
               gpr_log(GPR_INFO, "[outlier_detection_lb %p] ejecting candidate",
                       parent_.get());
             }
-            candidate.first->Eject(time_now);
+            parent_->EjectLocked(candidate.first, time_now);
             ++ejected_host_count;
           }
         }
@@ -976,7 +1165,7 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
               gpr_log(GPR_INFO, "[outlier_detection_lb %p] ejecting candidate",
                       parent_.get());
             }
-            candidate.first->Eject(time_now);
+            parent_->EjectLocked(candidate.first, time_now);
             ++ejected_host_count;
           }
         }
@@ -988,15 +1177,22 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
     //   current time is after ejection_timestamp + min(base_ejection_time *
     //   multiplier, max(base_ejection_time, max_ejection_time)), un-eject the
     //   address.
-    for (auto& state : parent_->subchannel_state_map_) {
-      auto* subchannel_state = state.second.get();
+    // Only penalized addresses can have either happen.
+    for (auto it = parent_->penalized_.begin();
+         it != parent_->penalized_.end();) {
+      auto* subchannel_state = *it;
       const bool unejected =
           subchannel_state->MaybeUneject(config.base_ejection_time.millis(),
                                          config.max_ejection_time.millis());
       if (unejected &&
           GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
-        gpr_log(GPR_INFO, "[outlier_detection_lb %p] unejected address %s (%p)",
-                parent_.get(), state.first.c_str(), subchannel_state);
+        gpr_log(GPR_INFO, "[outlier_detection_lb %p] unejected address %p",
+                parent_.get(), subchannel_state);
+      }
+      if (subchannel_state->penalized()) {
+        ++it;
+      } else {
+        it = parent_->penalized_.erase(it);
       }
     }
     timer_pending_ = false;
@@ -1098,6 +1294,29 @@ OutlierDetectionConfig::FailurePercentageEjection::JsonLoader(const JsonArgs&) {
   return loader;
 }
 
+const JsonLoaderInterface*
+OutlierDetectionConfig::ConsecutiveFailureEjection::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<ConsecutiveFailureEjection>()
+          .OptionalField("consecutiveFailures",
+                         &ConsecutiveFailureEjection::consecutive_failures)
+          .OptionalField("enforcementPercentage",
+                         &ConsecutiveFailureEjection::enforcement_percentage)
+          .OptionalField("failureLatency",
+                         &ConsecutiveFailureEjection::failure_latency)
+          .Finish();
+  return loader;
+}
+
+void OutlierDetectionConfig::ConsecutiveFailureEjection::JsonPostLoad(
+    const Json&, const JsonArgs&, ValidationErrors* errors) {
+  if (consecutive_failures == 0) {
+    ValidationErrors::ScopedField field(errors, ".consecutiveFailures");
+    errors->AddError("must be greater than 0");
+  }
+}
+
 const JsonLoaderInterface* OutlierDetectionConfig::JsonLoader(const JsonArgs&) {
   static const auto* loader =
       JsonObjectLoader<OutlierDetectionConfig>()
@@ -1112,6 +1331,8 @@ const JsonLoaderInterface* OutlierDetectionConfig::JsonLoader(const JsonArgs&) {
                          &OutlierDetectionConfig::success_rate_ejection)
           .OptionalField("failurePercentageEjection",
                          &OutlierDetectionConfig::failure_percentage_ejection)
+          .OptionalField("consecutiveFailureEjection",
+                         &OutlierDetectionConfig::consecutive_failure_ejection)
           .Finish();
   return loader;
 }
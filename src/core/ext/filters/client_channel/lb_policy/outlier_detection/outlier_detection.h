@@ -72,8 +72,29 @@ struct OutlierDetectionConfig {
 
     static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
   };
+  // Ejects an address as soon as it fails this many calls in a row, instead
+  // of waiting for the next interval.
+  struct ConsecutiveFailureEjection {
+    uint32_t consecutive_failures = 5;
+    uint32_t enforcement_percentage = 100;
+    // If set, calls that take longer than this count as failures too.
+    absl::optional<Duration> failure_latency;
+
+    ConsecutiveFailureEjection() {}
+
+    bool operator==(const ConsecutiveFailureEjection& other) const {
+      return consecutive_failures == other.consecutive_failures &&
+             enforcement_percentage == other.enforcement_percentage &&
+             failure_latency == other.failure_latency;
+    }
+
+    static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+    void JsonPostLoad(const Json& json, const JsonArgs&,
+                      ValidationErrors* errors);
+  };
   absl::optional<SuccessRateEjection> success_rate_ejection;
   absl::optional<FailurePercentageEjection> failure_percentage_ejection;
+  absl::optional<ConsecutiveFailureEjection> consecutive_failure_ejection;
 
   bool operator==(const OutlierDetectionConfig& other) const {
     return interval == other.interval &&
@@ -81,7 +102,8 @@ struct OutlierDetectionConfig {
            max_ejection_time == other.max_ejection_time &&
            max_ejection_percent == other.max_ejection_percent &&
            success_rate_ejection == other.success_rate_ejection &&
-           failure_percentage_ejection == other.failure_percentage_ejection;
+           failure_percentage_ejection == other.failure_percentage_ejection &&
+           consecutive_failure_ejection == other.consecutive_failure_ejection;
   }
 
   static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
@@ -32,17 +32,24 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/load_balancing/lb_policy.h"
 #include "src/core/lib/load_balancing/lb_policy_factory.h"
@@ -57,12 +64,49 @@ TraceFlag grpc_lb_pick_first_trace(false, "pick_first");
 
 namespace {
 
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::GetDefaultEventEngine;
+
 //
 // pick_first LB policy
 //
 
 constexpr absl::string_view kPickFirst = "pick_first";
 
+// Returns the Happy Eyeballs connection attempt delay set in \a args, if
+// any.
+absl::optional<Duration> GetConnectionAttemptDelay(const ChannelArgs& args) {
+  const int delay_ms =
+      args.GetInt(GRPC_ARG_EXPERIMENTAL_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS)
+          .value_or(0);
+  if (delay_ms <= 0) return absl::nullopt;
+  return Duration::Milliseconds(Clamp(delay_ms, 10, 2000));
+}
+
+// Reorders \a addresses so that address families alternate, starting with
+// the family of the first address, as described in RFC 8305 section 4.
+// The order of the addresses of each family is kept.
+ServerAddressList InterleaveAddressFamilies(ServerAddressList addresses) {
+  if (addresses.empty()) return addresses;
+  const int first_family = grpc_sockaddr_get_family(&addresses[0].address());
+  ServerAddressList first;
+  ServerAddressList other;
+  for (ServerAddress& address : addresses) {
+    if (grpc_sockaddr_get_family(&address.address()) == first_family) {
+      first.push_back(std::move(address));
+    } else {
+      other.push_back(std::move(address));
+    }
+  }
+  ServerAddressList interleaved;
+  interleaved.reserve(first.size() + other.size());
+  for (size_t i = 0; i < std::max(first.size(), other.size()); ++i) {
+    if (i < first.size()) interleaved.push_back(std::move(first[i]));
+    if (i < other.size()) interleaved.push_back(std::move(other[i]));
+  }
+  return interleaved;
+}
+
 class PickFirst : public LoadBalancingPolicy {
  public:
   explicit PickFirst(Args args);
@@ -113,6 +157,13 @@ class PickFirst : public LoadBalancingPolicy {
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
       policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      const int preconnect_percent = Clamp(
+          args.GetInt(GRPC_ARG_EXPERIMENTAL_PICK_FIRST_PRECONNECT_PERCENT)
+              .value_or(0),
+          0, 100);
+      preconnect_enabled_ = preconnect_percent > 0;
+      num_warm_ = (num_subchannels() * preconnect_percent + 99) / 100;
+      connection_attempt_delay_ = GetConnectionAttemptDelay(args);
       // Note that we do not start trying to connect to any subchannel here,
       // since we will wait until we see the initial connectivity state for all
       // subchannels before doing that.
@@ -123,6 +174,11 @@ class PickFirst : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
+    void Orphan() override {
+      CancelConnectionAttemptTimerLocked();
+      SubchannelList::Orphan();
+    }
+
     bool in_transient_failure() const { return in_transient_failure_; }
     void set_in_transient_failure(bool in_transient_failure) {
       in_transient_failure_ = in_transient_failure;
@@ -131,6 +187,37 @@ class PickFirst : public LoadBalancingPolicy {
     size_t attempting_index() const { return attempting_index_; }
     void set_attempting_index(size_t index) { attempting_index_ = index; }
 
+    // Whether GRPC_ARG_EXPERIMENTAL_PICK_FIRST_PRECONNECT_PERCENT is set.
+    bool preconnect_enabled() const { return preconnect_enabled_; }
+    // Returns true if the subchannel at \a index is one of the subchannels
+    // that we keep connected in the background.
+    bool IsWarmLocked(size_t index) const { return index < num_warm_; }
+
+    // Starts connecting the subchannels that we keep warm, besides the
+    // one at attempting_index().
+    void ConnectWarmSubchannelsLocked() {
+      for (size_t i = 0; i < num_warm_; ++i) {
+        PickFirstSubchannelData* sd = subchannel(i);
+        if (sd->subchannel() != nullptr &&
+            sd->connectivity_state() == GRPC_CHANNEL_IDLE) {
+          sd->subchannel()->RequestConnection();
+        }
+      }
+    }
+
+    // Returns a READY warm subchannel other than \a exclude, or null.
+    PickFirstSubchannelData* FindReadyWarmSubchannelLocked(
+        PickFirstSubchannelData* exclude) {
+      for (size_t i = 0; i < num_warm_; ++i) {
+        PickFirstSubchannelData* sd = subchannel(i);
+        if (sd != exclude && sd->subchannel() != nullptr &&
+            sd->connectivity_state() == GRPC_CHANNEL_READY) {
+          return sd;
+        }
+      }
+      return nullptr;
+    }
+
     bool AllSubchannelsSeenInitialState() {
       for (size_t i = 0; i < num_subchannels(); ++i) {
         if (!subchannel(i)->connectivity_state().has_value()) return false;
@@ -138,9 +225,23 @@ class PickFirst : public LoadBalancingPolicy {
       return true;
     }
 
+    // With Happy Eyeballs enabled, starts the timer after which we also
+    // start connecting to the subchannel after attempting_index().  Does
+    // nothing once every subchannel of the list has been tried.
+    void StartConnectionAttemptTimerLocked();
+    void CancelConnectionAttemptTimerLocked();
+
    private:
+    void OnConnectionAttemptTimerLocked(size_t index);
+
     bool in_transient_failure_ = false;
     size_t attempting_index_ = 0;
+    bool preconnect_enabled_ = false;
+    // Number of subchannels at the front of the list to keep warm.
+    size_t num_warm_ = 0;
+    // Set by GRPC_ARG_EXPERIMENTAL_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS.
+    absl::optional<Duration> connection_attempt_delay_;
+    absl::optional<EventEngine::TaskHandle> connection_attempt_timer_handle_;
   };
 
   class Picker : public SubchannelPicker {
@@ -228,6 +329,12 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
             "[PF %p] Shutting down previous pending subchannel list %p", this,
             latest_pending_subchannel_list_.get());
   }
+  // With Happy Eyeballs, attempts that overlap alternate between address
+  // families, so that a family that is broken on this host does not delay
+  // connecting through the other one.
+  if (GetConnectionAttemptDelay(latest_update_args_.args).has_value()) {
+    addresses = InterleaveAddressFamilies(std::move(addresses));
+  }
   latest_pending_subchannel_list_ = MakeRefCounted<PickFirstSubchannelList>(
       this, std::move(addresses), latest_update_args_.args);
   latest_pending_subchannel_list_->StartWatchingLocked();
@@ -353,6 +460,32 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
     // TODO(qianchengz): We may want to request re-resolution in
     // ExitIdleLocked().
     p->channel_control_helper()->RequestReresolution();
+    // If one of the warm standbys is connected, fail over to it.  The
+    // failed subchannel stays in the list and reconnects in the background
+    // if it is warm itself.
+    PickFirstSubchannelData* standby =
+        subchannel_list()->FindReadyWarmSubchannelLocked(this);
+    if (standby != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO, "Pick First %p failing over to warm subchannel %p",
+                p, standby->subchannel());
+      }
+      if (!subchannel_list()->IsWarmLocked(Index())) ShutdownLocked();
+      standby->ProcessUnselectedReadyLocked();
+      return;
+    }
+    // With pre-connection enabled, reconnect right away instead of waiting
+    // for the next call to take us out of IDLE.
+    if (subchannel_list()->preconnect_enabled()) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO,
+                "Pick First %p selected subchannel failed; reconnecting", p);
+      }
+      p->selected_ = nullptr;
+      p->subchannel_list_.reset();
+      p->AttemptToConnectUsingLatestUpdateArgsLocked();
+      return;
+    }
     // TODO(roth): We chould check the connectivity states of all the
     // subchannels here, just in case one of them happens to be READY,
     // and we could switch to that rather than going IDLE.
@@ -365,6 +498,13 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
         absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
     return;
   }
+  // Updates for the warm standbys of the selected subchannel only need to
+  // keep them connected.
+  if (p->selected_ != nullptr &&
+      subchannel_list() == p->subchannel_list_.get()) {
+    if (new_state == GRPC_CHANNEL_IDLE) subchannel()->RequestConnection();
+    return;
+  }
   // If we get here, there are two possible cases:
   // 1. We do not currently have a selected subchannel, and the update is
   //    for a subchannel in p->subchannel_list_ that we're trying to
@@ -388,12 +528,20 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
   if (!old_state.has_value()) {
     if (subchannel_list()->AllSubchannelsSeenInitialState()) {
       subchannel_list()->subchannel(0)->subchannel()->RequestConnection();
+      subchannel_list()->ConnectWarmSubchannelsLocked();
+      subchannel_list()->StartConnectionAttemptTimerLocked();
     }
     return;
   }
   // Ignore any other updates for subchannels we're not currently trying to
-  // connect to.
-  if (Index() != subchannel_list()->attempting_index()) return;
+  // connect to, except for reconnecting the warm ones.
+  if (Index() != subchannel_list()->attempting_index()) {
+    if (new_state == GRPC_CHANNEL_IDLE &&
+        subchannel_list()->IsWarmLocked(Index())) {
+      subchannel()->RequestConnection();
+    }
+    return;
+  }
   // Otherwise, process connectivity state.
   switch (new_state) {
     case GRPC_CHANNEL_READY:
@@ -449,6 +597,9 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
       if (sd_state.has_value() && *sd_state == GRPC_CHANNEL_IDLE) {
         sd->subchannel()->RequestConnection();
       }
+      // Don't wait out the delay of the attempt that just failed before
+      // trying the subchannel after the next one.
+      subchannel_list()->StartConnectionAttemptTimerLocked();
       break;
     }
     case GRPC_CHANNEL_IDLE: {
@@ -501,16 +652,78 @@ void PickFirst::PickFirstSubchannelData::ProcessUnselectedReadyLocked() {
     gpr_log(GPR_INFO, "Pick First %p selected subchannel %p", p, subchannel());
   }
   p->selected_ = this;
+  subchannel_list()->CancelConnectionAttemptTimerLocked();
   p->channel_control_helper()->UpdateState(
       GRPC_CHANNEL_READY, absl::Status(),
       absl::make_unique<Picker>(subchannel()->Ref()));
   for (size_t i = 0; i < subchannel_list()->num_subchannels(); ++i) {
-    if (i != Index()) {
+    if (i != Index() && !subchannel_list()->IsWarmLocked(i)) {
       subchannel_list()->subchannel(i)->ShutdownLocked();
     }
   }
 }
 
+//
+// PickFirst::PickFirstSubchannelList
+//
+
+void PickFirst::PickFirstSubchannelList::StartConnectionAttemptTimerLocked() {
+  CancelConnectionAttemptTimerLocked();
+  if (!connection_attempt_delay_.has_value() || in_transient_failure_ ||
+      attempting_index_ + 1 >= num_subchannels()) {
+    return;
+  }
+  connection_attempt_timer_handle_ = GetDefaultEventEngine()->RunAfter(
+      *connection_attempt_delay_,
+      [self = WeakRef(DEBUG_LOCATION, "ConnectionAttemptTimer"),
+       index = attempting_index_]() mutable {
+        ApplicationCallbackExecCtx app_exec_ctx;
+        ExecCtx exec_ctx;
+        auto* self_ptr = self.get();
+        self_ptr->policy()->work_serializer()->Run(
+            [self = std::move(self), index]() {
+              self->OnConnectionAttemptTimerLocked(index);
+            },
+            DEBUG_LOCATION);
+      });
+}
+
+void PickFirst::PickFirstSubchannelList::CancelConnectionAttemptTimerLocked() {
+  if (connection_attempt_timer_handle_.has_value()) {
+    GetDefaultEventEngine()->Cancel(*connection_attempt_timer_handle_);
+    connection_attempt_timer_handle_.reset();
+  }
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimerLocked(
+    size_t index) {
+  // Ignore the timer if the attempt it was started for has since failed,
+  // since that started the timer for the next attempt.
+  if (shutting_down() || index != attempting_index_) return;
+  connection_attempt_timer_handle_.reset();
+  PickFirst* p = static_cast<PickFirst*>(policy());
+  if (in_transient_failure_ ||
+      (p->selected_ != nullptr && p->subchannel_list_.get() == this)) {
+    return;
+  }
+  // Keep the current attempt going, and start the next one alongside it.
+  // Whichever subchannel becomes READY first is selected.
+  attempting_index_ = index + 1;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO,
+            "Pick First %p subchannel list %p: connection attempt delay "
+            "elapsed; also connecting to subchannel %" PRIuPTR,
+            p, this, attempting_index_);
+  }
+  PickFirstSubchannelData* sd = subchannel(attempting_index_);
+  // If the subchannel is in TRANSIENT_FAILURE, it will be connected to
+  // when it reports IDLE.
+  if (sd->connectivity_state() == GRPC_CHANNEL_IDLE) {
+    sd->subchannel()->RequestConnection();
+  }
+  StartConnectionAttemptTimerLocked();
+}
+
 class PickFirstConfig : public LoadBalancingPolicy::Config {
  public:
   absl::string_view name() const override { return kPickFirst; }
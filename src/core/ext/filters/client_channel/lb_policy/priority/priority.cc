@@ -146,6 +146,9 @@ class PriorityLb : public LoadBalancingPolicy {
     void ResetBackoffLocked();
     void MaybeDeactivateLocked();
     void MaybeReactivateLocked();
+    // If the child policy is IDLE, asks it to connect once the current
+    // callback is done, as it may be the one that reported IDLE.
+    void MaybeExitIdleLaterLocked();
 
     void Orphan() override;
 
@@ -256,6 +259,7 @@ class PriorityLb : public LoadBalancingPolicy {
     RefCountedPtr<RefCountedPicker> picker_wrapper_;
 
     bool seen_ready_or_idle_since_transient_failure_ = true;
+    bool exit_idle_pending_ = false;
 
     OrphanablePtr<DeactivationTimer> deactivation_timer_;
     OrphanablePtr<FailoverTimer> failover_timer_;
@@ -272,6 +276,14 @@ class PriorityLb : public LoadBalancingPolicy {
   // Deletes a child.  Called when the child's deactivation timer fires.
   void DeleteChild(ChildPriority* child);
 
+  // Creates the child of the specified name if it does not exist yet, or
+  // else reactivates it if needed.
+  ChildPriority* CreateOrReactivateChildLocked(const std::string& child_name);
+
+  // Returns the priority whose child is kept connected as a warm standby
+  // while the specified priority is in use, or UINT32_MAX if there is none.
+  uint32_t WarmStandbyPriorityLocked(uint32_t priority) const;
+
   // Iterates through the list of priorities to choose one:
   // - If the child for a priority doesn't exist, creates it.
   // - If a child's failover timer is pending, selects that priority
@@ -286,13 +298,16 @@ class PriorityLb : public LoadBalancingPolicy {
   void ChoosePriorityLocked();
 
   // Sets the specified priority as the current priority.
-  // Optionally deactivates any children at lower priorities.
+  // Optionally deactivates any children at lower priorities, except for
+  // the warm standby.
   // Returns the child's picker to the channel.
   void SetCurrentPriorityLocked(int32_t priority,
                                 bool deactivate_lower_priorities,
                                 const char* reason);
 
   const Duration child_failover_timeout_;
+  // Max number of addresses of a warm standby child, or 0 for none.
+  const size_t warm_standby_subchannels_;
 
   // Current channel args and config from the resolver.
   ChannelArgs args_;
@@ -322,7 +337,12 @@ PriorityLb::PriorityLb(Args args)
           Duration::Zero(),
           args.args
               .GetDurationFromIntMillis(GRPC_ARG_PRIORITY_FAILOVER_TIMEOUT_MS)
-              .value_or(kDefaultChildFailoverTimeout))) {
+              .value_or(kDefaultChildFailoverTimeout))),
+      warm_standby_subchannels_(std::max(
+          0,
+          args.args
+              .GetInt(GRPC_ARG_EXPERIMENTAL_PRIORITY_WARM_STANDBY_SUBCHANNELS)
+              .value_or(0))) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_priority_trace)) {
     gpr_log(GPR_INFO, "[priority_lb %p] created", this);
   }
@@ -414,6 +434,41 @@ void PriorityLb::DeleteChild(ChildPriority* child) {
   children_.erase(child->name());
 }
 
+PriorityLb::ChildPriority* PriorityLb::CreateOrReactivateChildLocked(
+    const std::string& child_name) {
+  auto& child = children_[child_name];
+  if (child == nullptr) {
+    child = MakeOrphanable<ChildPriority>(Ref(DEBUG_LOCATION, "ChildPriority"),
+                                          child_name);
+    auto child_config = config_->children().find(child_name);
+    GPR_DEBUG_ASSERT(child_config != config_->children().end());
+    // TODO(roth): If the child reports a non-OK status with the
+    // update, we need to propagate that back to the resolver somehow.
+    (void)child->UpdateLocked(
+        child_config->second.config,
+        child_config->second.ignore_reresolution_requests);
+  } else {
+    // The child already exists.  Reactivate if needed.
+    child->MaybeReactivateLocked();
+  }
+  return child.get();
+}
+
+uint32_t PriorityLb::WarmStandbyPriorityLocked(uint32_t priority) const {
+  const uint32_t standby = priority + 1;
+  if (warm_standby_subchannels_ == 0 ||
+      standby >= config_->priorities().size() || !addresses_.ok()) {
+    return UINT32_MAX;
+  }
+  // Only keep the child warm if its connections fit in the budget.
+  auto it = addresses_->find(config_->priorities()[standby]);
+  if (it != addresses_->end() &&
+      it->second.size() > warm_standby_subchannels_) {
+    return UINT32_MAX;
+  }
+  return standby;
+}
+
 void PriorityLb::ChoosePriorityLocked() {
   // If priority list is empty, report TF.
   if (config_->priorities().empty()) {
@@ -435,22 +490,7 @@ void PriorityLb::ChoosePriorityLocked() {
       gpr_log(GPR_INFO, "[priority_lb %p] trying priority %u, child %s", this,
               priority, child_name.c_str());
     }
-    auto& child = children_[child_name];
-    // Create child if needed.
-    if (child == nullptr) {
-      child = MakeOrphanable<ChildPriority>(
-          Ref(DEBUG_LOCATION, "ChildPriority"), child_name);
-      auto child_config = config_->children().find(child_name);
-      GPR_DEBUG_ASSERT(child_config != config_->children().end());
-      // TODO(roth): If the child reports a non-OK status with the
-      // update, we need to propagate that back to the resolver somehow.
-      (void)child->UpdateLocked(
-          child_config->second.config,
-          child_config->second.ignore_reresolution_requests);
-    } else {
-      // The child already exists.  Reactivate if needed.
-      child->MaybeReactivateLocked();
-    }
+    ChildPriority* child = CreateOrReactivateChildLocked(child_name);
     // Select this child if it is in states READY or IDLE.
     if (child->connectivity_state() == GRPC_CHANNEL_READY ||
         child->connectivity_state() == GRPC_CHANNEL_IDLE) {
@@ -516,8 +556,21 @@ void PriorityLb::SetCurrentPriorityLocked(int32_t priority,
   }
   current_priority_ = priority;
   if (deactivate_lower_priorities) {
+    // Keep the next priority connected, so that failing over to it does
+    // not have to wait for its connections to be established.
+    const uint32_t standby = WarmStandbyPriorityLocked(priority);
     for (uint32_t p = priority + 1; p < config_->priorities().size(); ++p) {
       const std::string& child_name = config_->priorities()[p];
+      if (p == standby) {
+        // The standby's state does not change which priority we are
+        // selecting here, so don't choose again on updates from creating
+        // it.
+        update_in_progress_ = true;
+        ChildPriority* child = CreateOrReactivateChildLocked(child_name);
+        update_in_progress_ = false;
+        child->MaybeExitIdleLaterLocked();
+        continue;
+      }
       auto it = children_.find(child_name);
       if (it != children_.end()) it->second->MaybeDeactivateLocked();
     }
@@ -818,6 +871,21 @@ void PriorityLb::ChildPriority::MaybeReactivateLocked() {
   deactivation_timer_.reset();
 }
 
+void PriorityLb::ChildPriority::MaybeExitIdleLaterLocked() {
+  if (connectivity_state_ != GRPC_CHANNEL_IDLE || exit_idle_pending_) return;
+  exit_idle_pending_ = true;
+  priority_policy_->work_serializer()->Run(
+      [self = Ref(DEBUG_LOCATION, "ExitIdle")]() {
+        self->exit_idle_pending_ = false;
+        // The child policy is gone once we are orphaned.
+        if (self->child_policy_ != nullptr &&
+            self->connectivity_state_ == GRPC_CHANNEL_IDLE) {
+          self->child_policy_->ExitIdleLocked();
+        }
+      },
+      DEBUG_LOCATION);
+}
+
 //
 // PriorityLb::ChildPriority::Helper
 //
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -110,32 +111,148 @@ void RingHashConfig::JsonPostLoad(const Json&, const JsonArgs&,
   }
 }
 
+const JsonLoaderInterface* MaglevConfig::JsonLoader(const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<MaglevConfig>()
+          .OptionalField("table_size", &MaglevConfig::table_size)
+          .Finish();
+  return loader;
+}
+
+void MaglevConfig::JsonPostLoad(const Json&, const JsonArgs&,
+                                ValidationErrors* errors) {
+  ValidationErrors::ScopedField field(errors, ".table_size");
+  if (errors->FieldHasErrors()) return;
+  bool prime = table_size >= 2;
+  for (uint64_t d = 2; prime && d * d <= table_size; ++d) {
+    prime = table_size % d != 0;
+  }
+  if (!prime || table_size > 5000011) {
+    errors->AddError("must be a prime no larger than 5000011");
+  }
+}
+
+std::vector<uint32_t> BuildMaglevTable(
+    const std::vector<MaglevBackend>& backends, size_t table_size) {
+  std::vector<uint32_t> table;
+  if (backends.empty()) return table;
+  GPR_ASSERT(table_size >= 2);
+  // Each backend visits the slots in the order of its own permutation of
+  // them, (offset + j * skip) % table_size, which reaches every slot since
+  // table_size is prime.
+  struct Permutation {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next = 0;
+    double weight;
+    size_t count = 0;
+  };
+  uint32_t max_weight = 1;
+  for (const MaglevBackend& backend : backends) {
+    max_weight = std::max(backend.weight, max_weight);
+  }
+  std::vector<Permutation> permutations;
+  permutations.reserve(backends.size());
+  for (const MaglevBackend& backend : backends) {
+    Permutation permutation;
+    permutation.offset =
+        XXH64(backend.key.data(), backend.key.size(), 0) % table_size;
+    permutation.skip =
+        XXH64(backend.key.data(), backend.key.size(), 1) % (table_size - 1) +
+        1;
+    permutation.weight =
+        static_cast<double>(std::max(backend.weight, 1u)) / max_weight;
+    permutations.push_back(permutation);
+  }
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  table.assign(table_size, kEmpty);
+  // In turn, each backend claims the next slot of its permutation not taken
+  // yet, except that lighter backends skip their turn once they are ahead of
+  // their share of the slots.
+  size_t filled = 0;
+  for (uint64_t round = 1; filled < table_size; ++round) {
+    for (size_t i = 0; i < backends.size() && filled < table_size; ++i) {
+      Permutation& permutation = permutations[i];
+      if (permutation.weight * round < permutation.count) continue;
+      size_t slot;
+      do {
+        slot = (permutation.offset + permutation.next * permutation.skip) %
+               table_size;
+        ++permutation.next;
+      } while (table[slot] != kEmpty);
+      table[slot] = static_cast<uint32_t>(i);
+      ++permutation.count;
+      ++filled;
+    }
+  }
+  return table;
+}
+
+RingHashLookupTable::RingHashLookupTable(std::vector<uint64_t> hashes)
+    : hashes_(std::move(hashes)) {
+  GPR_ASSERT(hashes_.size() <= std::numeric_limits<uint32_t>::max());
+  // About one hash per bucket, with at least two buckets.
+  int bits = 1;
+  while (bits < 32 && (size_t{1} << (bits + 1)) <= hashes_.size()) ++bits;
+  shift_ = 64 - bits;
+  const size_t num_buckets = size_t{1} << bits;
+  bucket_starts_.resize(num_buckets + 1);
+  size_t i = 0;
+  for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+    while (i < hashes_.size() && (hashes_[i] >> shift_) < bucket) ++i;
+    bucket_starts_[bucket] = i;
+  }
+  bucket_starts_[num_buckets] = hashes_.size();
+}
+
+size_t RingHashLookupTable::Find(uint64_t hash) const {
+  const size_t bucket = hash >> shift_;
+  // If the bucket has no hash at or after \a hash, the search ends on the
+  // first hash of the next non-empty bucket, which is the right answer too.
+  auto it = std::lower_bound(hashes_.begin() + bucket_starts_[bucket],
+                             hashes_.begin() + bucket_starts_[bucket + 1],
+                             hash);
+  if (it == hashes_.end()) return 0;
+  return it - hashes_.begin();
+}
+
 namespace {
 
 constexpr absl::string_view kRingHash = "ring_hash_experimental";
+constexpr absl::string_view kMaglev = "maglev_experimental";
 
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
   RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
       : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
-  absl::string_view name() const override { return kRingHash; }
+  // The config of the maglev policy.
+  explicit RingHashLbConfig(size_t maglev_table_size)
+      : maglev_table_size_(maglev_table_size) {}
+  absl::string_view name() const override {
+    return maglev_table_size_ == 0 ? kRingHash : kMaglev;
+  }
   size_t min_ring_size() const { return min_ring_size_; }
   size_t max_ring_size() const { return max_ring_size_; }
+  // 0 for ring_hash.
+  size_t maglev_table_size() const { return maglev_table_size_; }
 
  private:
-  size_t min_ring_size_;
-  size_t max_ring_size_;
+  size_t min_ring_size_ = 0;
+  size_t max_ring_size_ = 0;
+  size_t maglev_table_size_ = 0;
 };
 
 //
 // ring_hash LB policy
 //
 
+// Also implements the maglev policy, which differs only in how the
+// subchannel of a request hash is looked up.
 class RingHash : public LoadBalancingPolicy {
  public:
-  explicit RingHash(Args args);
+  RingHash(Args args, absl::string_view name);
 
-  absl::string_view name() const override { return kRingHash; }
+  absl::string_view name() const override { return name_; }
 
   absl::Status UpdateLocked(UpdateArgs args) override;
   void ResetBackoffLocked() override;
@@ -197,11 +314,6 @@ class RingHash : public LoadBalancingPolicy {
   class RingHashSubchannelList
       : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
    public:
-    struct RingEntry {
-      uint64_t hash;
-      RingHashSubchannelData* subchannel;
-    };
-
     RingHashSubchannelList(RingHash* policy, ServerAddressList addresses,
                            const ChannelArgs& args);
 
@@ -210,7 +322,18 @@ class RingHash : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
-    const std::vector<RingEntry>& ring() const { return ring_; }
+    // The subchannel of each hash on the ring, or of each slot of the
+    // maglev table.
+    const std::vector<RingHashSubchannelData*>& ring_subchannels() const {
+      return ring_subchannels_;
+    }
+
+    // Returns the index in ring_subchannels() of the subchannel to pick
+    // first for \a hash. The list must not be empty.
+    size_t FindRingIndex(uint64_t hash) const {
+      if (maglev_) return hash % ring_subchannels_.size();
+      return ring_.Find(hash);
+    }
 
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
@@ -228,7 +351,25 @@ class RingHash : public LoadBalancingPolicy {
                                                bool connection_attempt_complete,
                                                absl::Status status);
 
+    // Like UpdateRingHashConnectivityStateLocked(), but creates the new
+    // picker only once the notifications that are already queued have been
+    // processed, so that a burst of them creates a single picker.
+    void ScheduleRingHashConnectivityStateUpdateLocked(
+        size_t index, bool connection_attempt_complete, absl::Status status);
+
    private:
+    void UpdateStateLocked(absl::Status status_for_tf) override {
+      UpdateRingHashConnectivityStateLocked(
+          last_updated_index_, /*connection_attempt_complete=*/false,
+          std::move(status_for_tf));
+    }
+
+    // Used while building the ring.
+    struct RingEntry {
+      uint64_t hash;
+      RingHashSubchannelData* subchannel;
+    };
+
     bool AllSubchannelsSeenInitialState() {
       for (size_t i = 0; i < num_subchannels(); ++i) {
         if (!subchannel(i)->connectivity_state().has_value()) return false;
@@ -241,12 +382,19 @@ class RingHash : public LoadBalancingPolicy {
     size_t num_connecting_ = 0;
     size_t num_transient_failure_ = 0;
 
-    std::vector<RingEntry> ring_;
+    // Whether ring_subchannels_ is a maglev table rather than a ring.
+    bool maglev_ = false;
+    RingHashLookupTable ring_;
+    std::vector<RingHashSubchannelData*> ring_subchannels_;
 
     // The index of the subchannel currently doing an internally
     // triggered connection attempt, if any.
     absl::optional<size_t> internally_triggered_connection_index_;
 
+    // The index of the last subchannel passed to
+    // ScheduleRingHashConnectivityStateUpdateLocked().
+    size_t last_updated_index_ = 0;
+
     // TODO(roth): If we ever change the helper UpdateState() API to not
     // need the status reported for TRANSIENT_FAILURE state (because
     // it's not currently actually used for anything outside of the picker),
@@ -335,6 +483,8 @@ class RingHash : public LoadBalancingPolicy {
 
   void ShutdownLocked() override;
 
+  const absl::string_view name_;
+
   // Current config from resolver.
   RefCountedPtr<RingHashLbConfig> config_;
 
@@ -358,34 +508,8 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     return PickResult::Fail(
         absl::InternalError("ring hash value is not a number"));
   }
-  const auto& ring = subchannel_list_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  size_t lowp = 0;
-  size_t highp = ring.size();
-  size_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == ring.size()) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
-    }
-  }
+  const auto& ring = subchannel_list_->ring_subchannels();
+  const size_t first_index = subchannel_list_->FindRingIndex(h);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -397,41 +521,37 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         }
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
-  switch (ring[first_index].subchannel->GetConnectivityState()) {
+  switch (ring[first_index]->GetConnectivityState()) {
     case GRPC_CHANNEL_READY:
-      return PickResult::Complete(
-          ring[first_index].subchannel->subchannel()->Ref());
+      return PickResult::Complete(ring[first_index]->subchannel()->Ref());
     case GRPC_CHANNEL_IDLE:
       ScheduleSubchannelConnectionAttempt(
-          ring[first_index].subchannel->subchannel()->Ref());
+          ring[first_index]->subchannel()->Ref());
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHANNEL_CONNECTING:
       return PickResult::Queue();
     default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
       break;
   }
-  ScheduleSubchannelConnectionAttempt(
-      ring[first_index].subchannel->subchannel()->Ref());
+  ScheduleSubchannelConnectionAttempt(ring[first_index]->subchannel()->Ref());
   // Loop through remaining subchannels to find one in READY.
   // On the way, we make sure the right set of connection attempts
   // will happen.
   bool found_second_subchannel = false;
   bool found_first_non_failed = false;
   for (size_t i = 1; i < ring.size(); ++i) {
-    const auto& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel == ring[first_index].subchannel) {
+    RingHashSubchannelData* entry = ring[(first_index + i) % ring.size()];
+    if (entry == ring[first_index]) {
       continue;
     }
-    grpc_connectivity_state connectivity_state =
-        entry.subchannel->GetConnectivityState();
+    grpc_connectivity_state connectivity_state = entry->GetConnectivityState();
     if (connectivity_state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(entry.subchannel->subchannel()->Ref());
+      return PickResult::Complete(entry->subchannel()->Ref());
     }
     if (!found_second_subchannel) {
       switch (connectivity_state) {
         case GRPC_CHANNEL_IDLE:
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(entry->subchannel()->Ref());
           ABSL_FALLTHROUGH_INTENDED;
         case GRPC_CHANNEL_CONNECTING:
           return PickResult::Queue();
@@ -442,12 +562,10 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     }
     if (!found_first_non_failed) {
       if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-        ScheduleSubchannelConnectionAttempt(
-            entry.subchannel->subchannel()->Ref());
+        ScheduleSubchannelConnectionAttempt(entry->subchannel()->Ref());
       } else {
         if (connectivity_state == GRPC_CHANNEL_IDLE) {
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(entry->subchannel()->Ref());
         }
         found_first_non_failed = true;
       }
@@ -455,7 +573,7 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
   }
   return PickResult::Fail(absl::UnavailableError(absl::StrCat(
       "ring hash cannot find a connected subchannel; first failure: ",
-      ring[first_index].subchannel->GetConnectivityStatus().ToString())));
+      ring[first_index]->GetConnectivityStatus().ToString())));
 }
 
 //
@@ -503,6 +621,26 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
     sum += address_weight.weight;
     address_weights.push_back(std::move(address_weight));
   }
+  const size_t maglev_table_size = policy->config_->maglev_table_size();
+  if (maglev_table_size > 0 && num_subchannels() > 0) {
+    maglev_ = true;
+    std::vector<MaglevBackend> backends;
+    backends.reserve(num_subchannels());
+    for (const AddressWeight& address_weight : address_weights) {
+      backends.push_back({address_weight.address, address_weight.weight});
+    }
+    ring_subchannels_.reserve(maglev_table_size);
+    for (uint32_t index : BuildMaglevTable(backends, maglev_table_size)) {
+      ring_subchannels_.push_back(subchannel(index));
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] created subchannel list %p with a maglev table of "
+              "%" PRIuPTR " entries",
+              policy, this, ring_subchannels_.size());
+    }
+    return;
+  }
   // Calculating normalized weights and find min and max.
   double min_normalized_weight = 1.0;
   double max_normalized_weight = 0.0;
@@ -527,7 +665,8 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
       static_cast<double>(max_ring_size));
   // Reserve memory for the entire ring up front.
   const size_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
+  std::vector<RingEntry> ring;
+  ring.reserve(ring_size);
   // Populate the hash ring by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each
   // host. Since these aren't necessarily whole numbers, we maintain running
@@ -542,30 +681,39 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
     const std::string& address_string = address_weights[i].address;
     hash_key_buffer.assign(address_string.begin(), address_string.end());
     hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
+    const size_t prefix_size = hash_key_buffer.size();
     target_hashes += scale * address_weights[i].normalized_weight;
     size_t count = 0;
     while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, subchannel(i)});
+      // Formatted in place: a string per hash adds up on rings of millions.
+      const absl::AlphaNum count_str(count);
+      hash_key_buffer.insert(hash_key_buffer.end(), count_str.data(),
+                             count_str.data() + count_str.size());
+      const uint64_t hash =
+          XXH64(hash_key_buffer.data(), hash_key_buffer.size(), 0);
+      ring.push_back({hash, subchannel(i)});
       ++count;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+      hash_key_buffer.resize(prefix_size);
     }
     min_hashes_per_host =
         std::min(static_cast<uint64_t>(i), min_hashes_per_host);
     max_hashes_per_host =
         std::max(static_cast<uint64_t>(i), max_hashes_per_host);
   }
-  std::sort(ring_.begin(), ring_.end(),
+  std::sort(ring.begin(), ring.end(),
             [](const RingHashSubchannelList::RingEntry& lhs,
                const RingHashSubchannelList::RingEntry& rhs) -> bool {
               return lhs.hash < rhs.hash;
             });
+  std::vector<uint64_t> hashes;
+  hashes.reserve(ring.size());
+  ring_subchannels_.reserve(ring.size());
+  for (const RingEntry& entry : ring) {
+    hashes.push_back(entry.hash);
+    ring_subchannels_.push_back(entry.subchannel);
+  }
+  ring_ = RingHashLookupTable(std::move(hashes));
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO,
             "[RH %p] created subchannel list %p with %" PRIuPTR " ring entries",
@@ -700,6 +848,20 @@ void RingHash::RingHashSubchannelList::UpdateRingHashConnectivityStateLocked(
   }
 }
 
+void RingHash::RingHashSubchannelList::
+    ScheduleRingHashConnectivityStateUpdateLocked(
+        size_t index, bool connection_attempt_complete, absl::Status status) {
+  // The end of the internally triggered connection attempt must not be
+  // lost if other subchannels report before the update.
+  if (internally_triggered_connection_index_.has_value() &&
+      *internally_triggered_connection_index_ == index &&
+      connection_attempt_complete) {
+    internally_triggered_connection_index_.reset();
+  }
+  last_updated_index_ = index;
+  ScheduleStateUpdateLocked(std::move(status));
+}
+
 //
 // RingHash::RingHashSubchannelData
 //
@@ -762,15 +924,16 @@ void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
   connectivity_state_.store(new_state, std::memory_order_relaxed);
   // Update the RH policy's connectivity state, creating new picker and new
   // ring.
-  subchannel_list()->UpdateRingHashConnectivityStateLocked(
-      Index(), connection_attempt_complete, status);
+  subchannel_list()->ScheduleRingHashConnectivityStateUpdateLocked(
+      Index(), connection_attempt_complete, std::move(status));
 }
 
 //
 // RingHash
 //
 
-RingHash::RingHash(Args args) : LoadBalancingPolicy(std::move(args)) {
+RingHash::RingHash(Args args, absl::string_view name)
+    : LoadBalancingPolicy(std::move(args)), name_(name) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO, "[RH %p] Created", this);
   }
@@ -866,7 +1029,7 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
  public:
   OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
       LoadBalancingPolicy::Args args) const override {
-    return MakeOrphanable<RingHash>(std::move(args));
+    return MakeOrphanable<RingHash>(std::move(args), kRingHash);
   }
 
   absl::string_view name() const override { return kRingHash; }
@@ -881,6 +1044,24 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
   }
 };
 
+class MaglevFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<RingHash>(std::move(args), kMaglev);
+  }
+
+  absl::string_view name() const override { return kMaglev; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    auto config = LoadFromJson<MaglevConfig>(
+        json, JsonArgs(), "errors validating maglev LB policy config");
+    if (!config.ok()) return config.status();
+    return MakeRefCounted<RingHashLbConfig>(config->table_size);
+  }
+};
+
 }  // namespace
 
 void RegisterRingHashLbPolicy(CoreConfiguration::Builder* builder) {
@@ -888,4 +1069,9 @@ void RegisterRingHashLbPolicy(CoreConfiguration::Builder* builder) {
       absl::make_unique<RingHashFactory>());
 }
 
+void RegisterMaglevLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<MaglevFactory>());
+}
+
 }  // namespace grpc_core
@@ -19,8 +19,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
 #include "src/core/lib/gprpp/unique_type_name.h"
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/json/json.h"
@@ -42,6 +47,56 @@ struct RingHashConfig {
                     ValidationErrors* errors);
 };
 
+// Config of the maglev policy, which picks as ring_hash does but from a
+// Maglev lookup table instead of a ring.
+struct MaglevConfig {
+  // Must be prime. More slots balance the load better.
+  uint64_t table_size = 65537;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+  void JsonPostLoad(const Json& json, const JsonArgs&,
+                    ValidationErrors* errors);
+};
+
+struct MaglevBackend {
+  // What identifies the backend across updates, e.g. its address.
+  absl::string_view key;
+  uint32_t weight = 1;
+};
+
+// Builds a Maglev lookup table (Eisenbud et al., NSDI 2016) of \a table_size
+// slots, a prime, each holding the index of one of \a backends. Each backend
+// gets a share of the slots proportional to its weight, and adding or removing
+// one moves few of the slots of the others. Returns an empty table if there
+// are no backends.
+std::vector<uint32_t> BuildMaglevTable(
+    const std::vector<MaglevBackend>& backends, size_t table_size);
+
+// The hashes of a ring, sorted, with an index over the hash space: a lookup
+// searches only the few hashes sharing its top bits, so it touches a couple of
+// cache lines whatever the size of the ring, instead of one per level of a
+// binary search over megabytes of entries.
+class RingHashLookupTable {
+ public:
+  RingHashLookupTable() = default;
+  // \a hashes must be sorted.
+  explicit RingHashLookupTable(std::vector<uint64_t> hashes);
+
+  size_t size() const { return hashes_.size(); }
+  uint64_t hash(size_t index) const { return hashes_[index]; }
+
+  // Returns the index of the first hash at or after \a hash on the ring,
+  // wrapping around to 0 past the last one. The table must not be empty.
+  size_t Find(uint64_t hash) const;
+
+ private:
+  std::vector<uint64_t> hashes_;
+  // Hashes are bucketed by their top (64 - shift_) bits.
+  int shift_ = 63;
+  // The hashes of bucket i are at [bucket_starts_[i], bucket_starts_[i + 1]).
+  std::vector<uint32_t> bucket_starts_;
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
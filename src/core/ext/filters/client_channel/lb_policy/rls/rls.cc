@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <map>
@@ -278,6 +279,13 @@ class RlsLb : public LoadBalancingPolicy {
       return picker_->Pick(args);
     }
 
+    // Returns the current picker of the child policy, for the RLS picker to
+    // use without the lock.  Null once the wrapper is shut down.
+    std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      return picker_;
+    }
+
     // Updates for the child policy are handled in two phases:
     // 1. In StartUpdate(), we parse and validate the new child policy
     //    config and store the parsed config.
@@ -351,12 +359,34 @@ class RlsLb : public LoadBalancingPolicy {
 
     grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(&RlsLb::mu_) =
         GRPC_CHANNEL_IDLE;
-    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
+    // Shared with the RLS pickers, which keep using it after a new one is
+    // set here until they are replaced themselves.
+    std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
         ABSL_GUARDED_BY(&RlsLb::mu_);
   };
 
+  // The data a pick needs from a cache entry that got a successful RLS
+  // response.  Each response gets a new Route, which is never modified once
+  // created, except for its flags, so that pickers can use it without
+  // holding the lock.
+  struct Route {
+    std::vector<std::string> targets;
+    std::string header_data;
+    Timestamp stale_time;
+    // Set by the picks that used the route without the lock, instead of
+    // moving the entry to the end of the LRU list right away.
+    mutable std::atomic<bool> used{false};
+    // Set once the entry has newer data or is evicted.
+    std::atomic<bool> retired{false};
+  };
+  using RouteMap = std::unordered_map<RequestKey, std::shared_ptr<const Route>,
+                                      absl::Hash<RequestKey>>;
+
   // A picker that uses the cache and the request map in the LB policy
   // (synchronized via a mutex) to determine how to route requests.
+  // Requests whose keys have fresh data are routed with a snapshot of the
+  // cache and of the child pickers taken when the picker is created, without
+  // the mutex.
   class Picker : public LoadBalancingPolicy::SubchannelPicker {
    public:
     explicit Picker(RefCountedPtr<RlsLb> lb_policy);
@@ -365,9 +395,21 @@ class RlsLb : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
+    struct ChildPicker {
+      grpc_connectivity_state state;
+      std::shared_ptr<SubchannelPicker> picker;
+    };
+
+    // Picks from the snapshot.  Returns nullopt if the request needs the
+    // locked path, e.g. because the data for its key is missing or stale.
+    absl::optional<PickResult> PickFromSnapshot(const RequestKey& key,
+                                                Timestamp now, PickArgs args);
+
     RefCountedPtr<RlsLb> lb_policy_;
     RefCountedPtr<RlsLbConfig> config_;
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+    std::shared_ptr<const RouteMap> routes_;
+    std::map<std::string /*target*/, ChildPicker> child_pickers_;
   };
 
   // An LRU cache with adjustable size.
@@ -446,6 +488,16 @@ class RlsLb : public LoadBalancingPolicy {
       // Moves entry to the end of the LRU list.
       void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+      // Returns whether a picker used the entry without the lock since the
+      // last call, and resets that.
+      bool TakeUsedWithoutLock() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
+      // The data of the last successful RLS response, or null.
+      const std::shared_ptr<Route>& route() const
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return route_;
+      }
+
      private:
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
        public:
@@ -485,6 +537,7 @@ class RlsLb : public LoadBalancingPolicy {
       Timestamp data_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
           Timestamp::InfPast();
       Timestamp stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) = Timestamp::InfPast();
+      std::shared_ptr<Route> route_ ABSL_GUARDED_BY(&RlsLb::mu_);
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
       Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
@@ -517,6 +570,16 @@ class RlsLb : public LoadBalancingPolicy {
     // Shutdown the cache; clean-up and orphan all the stored cache entries.
     void Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Returns the routes of all the entries that have one, for the pickers.
+    // The map is only rebuilt after InvalidateRoutes() is called.
+    std::shared_ptr<const RouteMap> Routes()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
+    // Called when an entry gets a new route or is removed.
+    void InvalidateRoutes() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      routes_.reset();
+    }
+
    private:
     static void OnCleanupTimer(void* arg, grpc_error_handle error);
 
@@ -536,6 +599,7 @@ class RlsLb : public LoadBalancingPolicy {
     std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
     std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
         map_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    std::shared_ptr<const RouteMap> routes_ ABSL_GUARDED_BY(&RlsLb::mu_);
     grpc_timer cleanup_timer_;
     grpc_closure timer_callback_;
   };
@@ -989,12 +1053,30 @@ std::map<std::string, std::string> BuildKeyMap(
   return key_map;
 }
 
+// Adds the header data of the RLS response to the request.
+void AddRlsHeaderData(const std::string& header_data,
+                      LoadBalancingPolicy::PickArgs args) {
+  if (header_data.empty()) return;
+  char* copied_header_data =
+      static_cast<char*>(args.call_state->Alloc(header_data.length() + 1));
+  strcpy(copied_header_data, header_data.c_str());
+  args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
+}
+
 RlsLb::Picker::Picker(RefCountedPtr<RlsLb> lb_policy)
     : lb_policy_(std::move(lb_policy)), config_(lb_policy_->config_) {
   if (lb_policy_->default_child_policy_ != nullptr) {
     default_child_policy_ =
         lb_policy_->default_child_policy_->Ref(DEBUG_LOCATION, "Picker");
   }
+  MutexLock lock(&lb_policy_->mu_);
+  if (lb_policy_->is_shutdown_) return;
+  routes_ = lb_policy_->cache_.Routes();
+  for (auto& p : lb_policy_->child_policy_map_) {
+    child_pickers_.emplace(
+        p.first,
+        ChildPicker{p.second->connectivity_state(), p.second->picker()});
+  }
 }
 
 RlsLb::Picker::~Picker() {
@@ -1020,6 +1102,8 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = Timestamp::Now();
+  absl::optional<PickResult> result = PickFromSnapshot(key, now, args);
+  if (result.has_value()) return std::move(*result);
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1101,6 +1185,49 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   return PickResult::Queue();
 }
 
+absl::optional<LoadBalancingPolicy::PickResult> RlsLb::Picker::PickFromSnapshot(
+    const RequestKey& key, Timestamp now, PickArgs args) {
+  if (routes_ == nullptr) return absl::nullopt;
+  auto it = routes_->find(key);
+  if (it == routes_->end()) return absl::nullopt;
+  const Route& route = *it->second;
+  // Stale data must be refreshed with an RLS request, which needs the lock.
+  if (route.stale_time < now ||
+      route.retired.load(std::memory_order_acquire)) {
+    return absl::nullopt;
+  }
+  // Skip targets before the last one that are in state TRANSIENT_FAILURE.
+  const ChildPicker* child_picker = nullptr;
+  size_t i = 0;
+  for (; i < route.targets.size(); ++i) {
+    auto child_it = child_pickers_.find(route.targets[i]);
+    if (child_it == child_pickers_.end()) return absl::nullopt;
+    child_picker = &child_it->second;
+    if (child_picker->state != GRPC_CHANNEL_TRANSIENT_FAILURE ||
+        i == route.targets.size() - 1) {
+      break;
+    }
+  }
+  if (child_picker == nullptr || child_picker->picker == nullptr) {
+    return absl::nullopt;
+  }
+  // The cache moves the entry to the end of the LRU list when it next
+  // needs to evict something.  Avoid writing the flag when it's already
+  // set, to keep the cache line shared between the threads picking.
+  if (!route.used.load(std::memory_order_relaxed)) {
+    route.used.store(true, std::memory_order_relaxed);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+    gpr_log(GPR_INFO,
+            "[rlslb %p] picker=%p: using cached target %s (%" PRIuPTR
+            " of %" PRIuPTR ") in state %s without the lock",
+            lb_policy_.get(), this, route.targets[i].c_str(), i,
+            route.targets.size(), ConnectivityStateName(child_picker->state));
+  }
+  AddRlsHeaderData(route.header_data, args);
+  return child_picker->picker->Pick(args);
+}
+
 //
 // RlsLb::Cache::Entry::BackoffTimer
 //
@@ -1187,6 +1314,10 @@ void RlsLb::Cache::Entry::Orphan() {
     lb_policy_->UpdatePickerAsync();
   }
   child_policy_wrappers_.clear();
+  if (route_ != nullptr) {
+    route_->retired.store(true, std::memory_order_release);
+    lb_policy_->cache_.InvalidateRoutes();
+  }
   Unref(DEBUG_LOCATION, "Orphan");
 }
 
@@ -1228,16 +1359,10 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
             child_policy_wrappers_.size(),
             ConnectivityStateName(child_policy_wrapper->connectivity_state()));
   }
-  // Add header data.
   // Note that even if the target we're using is in TRANSIENT_FAILURE,
   // the pick might still succeed (e.g., if the child is ring_hash), so
   // we need to pass the right header info down in all cases.
-  if (!header_data_.empty()) {
-    char* copied_header_data =
-        static_cast<char*>(args.call_state->Alloc(header_data_.length() + 1));
-    strcpy(copied_header_data, header_data_.c_str());
-    args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
-  }
+  AddRlsHeaderData(header_data_, args);
   return child_policy_wrapper->Pick(args);
 }
 
@@ -1263,6 +1388,11 @@ void RlsLb::Cache::Entry::MarkUsed() {
   lru_iterator_ = new_it;
 }
 
+bool RlsLb::Cache::Entry::TakeUsedWithoutLock() {
+  return route_ != nullptr &&
+         route_->used.exchange(false, std::memory_order_relaxed);
+}
+
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
@@ -1294,6 +1424,13 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
   backoff_state_.reset();
   backoff_time_ = Timestamp::InfPast();
   backoff_expiration_time_ = Timestamp::InfPast();
+  // Replace the route used by the pickers.
+  if (route_ != nullptr) route_->retired.store(true, std::memory_order_release);
+  route_ = std::make_shared<Route>();
+  route_->targets = response.targets;
+  route_->header_data = header_data_;
+  route_->stale_time = stale_time_;
+  lb_policy_->cache_.InvalidateRoutes();
   // Check if we need to update this list of targets.
   bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
     if (child_policy_wrappers_.size() != response.targets.size()) return true;
@@ -1414,6 +1551,19 @@ void RlsLb::Cache::Shutdown() {
   grpc_timer_cancel(&cleanup_timer_);
 }
 
+std::shared_ptr<const RlsLb::RouteMap> RlsLb::Cache::Routes() {
+  if (routes_ == nullptr) {
+    auto routes = std::make_shared<RouteMap>();
+    for (auto& p : map_) {
+      if (p.second->route() != nullptr) {
+        routes->emplace(p.first, p.second->route());
+      }
+    }
+    routes_ = std::move(routes);
+  }
+  return routes_;
+}
+
 void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
   Cache* cache = static_cast<Cache*>(arg);
   cache->lb_policy_->work_serializer()->Run(
@@ -1450,11 +1600,19 @@ size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
 }
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
+  // Entries used by pickers without the lock get a second chance, but only
+  // one each, in case they keep being used while we are at it.
+  size_t second_chances = map_.size();
   while (size_ > bytes) {
     auto lru_it = lru_list_.begin();
     if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
     auto map_it = map_.find(*lru_it);
     GPR_ASSERT(map_it != map_.end());
+    if (second_chances > 0 && map_it->second->TakeUsedWithoutLock()) {
+      --second_chances;
+      map_it->second->MarkUsed();
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
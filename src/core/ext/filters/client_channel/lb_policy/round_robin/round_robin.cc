@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -77,6 +78,11 @@ class RoundRobin : public LoadBalancingPolicy {
   // Forward declaration.
   class RoundRobinSubchannelList;
 
+  // The READY subchannels among a fixed range of indexes in a subchannel
+  // list, in index order.  Chunks are immutable once built, so that pickers
+  // can share them with the subchannel list.
+  using ReadyChunk = std::vector<RefCountedPtr<SubchannelInterface>>;
+
   // Data for a particular subchannel in a subchannel list.
   // This subclass adds the following functionality:
   // - Tracks the previous connectivity state of the subchannel, so that
@@ -132,6 +138,10 @@ class RoundRobin : public LoadBalancingPolicy {
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
       policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      const size_t num_chunks =
+          (num_subchannels() + kReadyChunkSize - 1) / kReadyChunkSize;
+      ready_chunks_.resize(num_chunks);
+      ready_chunk_dirty_.resize(num_chunks, false);
     }
 
     ~RoundRobinSubchannelList() override {
@@ -139,6 +149,14 @@ class RoundRobin : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
+    void Orphan() override {
+      SubchannelList::Orphan();
+      // Release our refs to the subchannels.  Pickers that are still
+      // using the chunks keep their own refs.
+      ready_chunks_.clear();
+      ready_chunk_dirty_.clear();
+    }
+
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
     void UpdateStateCountersLocked(
@@ -151,7 +169,28 @@ class RoundRobin : public LoadBalancingPolicy {
     void MaybeUpdateRoundRobinConnectivityStateLocked(
         absl::Status status_for_tf);
 
+    // Notes that the subchannel at \a index became or stopped being READY,
+    // so its chunk must be rebuilt before the next picker is created.
+    void MarkReadyChunkDirtyLocked(size_t index) {
+      ready_chunk_dirty_[index / kReadyChunkSize] = true;
+    }
+
+    // Returns the READY subchannels, rebuilding only the chunks that
+    // changed since the last call.  Entries are null for chunks that have
+    // no READY subchannels.
+    const std::vector<std::shared_ptr<const ReadyChunk>>&
+    GetReadyChunksLocked();
+
    private:
+    // Number of subchannel indexes covered by each chunk.  A single
+    // subchannel changing state costs rebuilding one chunk of this size
+    // plus copying one pointer per chunk into the new picker.
+    static constexpr size_t kReadyChunkSize = 64;
+
+    void UpdateStateLocked(absl::Status status_for_tf) override {
+      MaybeUpdateRoundRobinConnectivityStateLocked(std::move(status_for_tf));
+    }
+
     std::string CountersString() const {
       return absl::StrCat("num_subchannels=", num_subchannels(),
                           " num_ready=", num_ready_,
@@ -164,6 +203,9 @@ class RoundRobin : public LoadBalancingPolicy {
     size_t num_transient_failure_ = 0;
 
     absl::Status last_failure_;
+
+    std::vector<std::shared_ptr<const ReadyChunk>> ready_chunks_;
+    std::vector<bool> ready_chunk_dirty_;
   };
 
   class Picker : public SubchannelPicker {
@@ -176,8 +218,12 @@ class RoundRobin : public LoadBalancingPolicy {
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
-    size_t last_picked_index_;
-    std::vector<RefCountedPtr<SubchannelInterface>> subchannels_;
+    // Non-empty chunks only, in subchannel list order.
+    std::vector<std::shared_ptr<const ReadyChunk>> chunks_;
+    // The index just past the end of each chunk, counting the READY
+    // subchannels of all the chunks in order.
+    std::vector<size_t> chunk_ends_;
+    std::atomic<size_t> next_index_{0};
   };
 
   void ShutdownLocked() override;
@@ -200,36 +246,46 @@ class RoundRobin : public LoadBalancingPolicy {
 RoundRobin::Picker::Picker(RoundRobin* parent,
                            RoundRobinSubchannelList* subchannel_list)
     : parent_(parent) {
-  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-    RoundRobinSubchannelData* sd = subchannel_list->subchannel(i);
-    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
-        GRPC_CHANNEL_READY) {
-      subchannels_.push_back(sd->subchannel()->Ref());
-    }
+  size_t num_ready = 0;
+  for (const auto& chunk : subchannel_list->GetReadyChunksLocked()) {
+    if (chunk == nullptr) continue;
+    num_ready += chunk->size();
+    chunks_.push_back(chunk);
+    chunk_ends_.push_back(num_ready);
   }
   // For discussion on why we generate a random starting index for
   // the picker, see https://github.com/grpc/grpc-go/issues/2580.
   // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
   // something better as part of https://github.com/grpc/grpc/issues/17891.
-  last_picked_index_ = rand() % subchannels_.size();
+  const size_t initial_index = rand() % num_ready;
+  next_index_.store(initial_index + 1, std::memory_order_relaxed);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] created picker from subchannel_list=%p "
-            "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
-            parent_, this, subchannel_list, subchannels_.size(),
-            last_picked_index_);
+            "with %" PRIuPTR " READY subchannels in %" PRIuPTR
+            " chunks; last_picked_index=%" PRIuPTR,
+            parent_, this, subchannel_list, num_ready, chunks_.size(),
+            initial_index);
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  const size_t index = next_index_.fetch_add(1, std::memory_order_relaxed) %
+                       chunk_ends_.back();
+  const size_t chunk =
+      std::upper_bound(chunk_ends_.begin(), chunk_ends_.end(), index) -
+      chunk_ends_.begin();
+  const size_t index_in_chunk =
+      chunk == 0 ? index : index - chunk_ends_[chunk - 1];
+  const RefCountedPtr<SubchannelInterface>& subchannel =
+      (*chunks_[chunk])[index_in_chunk];
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
-            "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
-            parent_, this, last_picked_index_,
-            subchannels_[last_picked_index_].get());
+            "[RR %p picker %p] returning chunk %" PRIuPTR " index %" PRIuPTR
+            ", subchannel=%p",
+            parent_, this, chunk, index_in_chunk, subchannel.get());
   }
-  return PickResult::Complete(subchannels_[last_picked_index_]);
+  return PickResult::Complete(subchannel);
 }
 
 //
@@ -414,6 +470,32 @@ void RoundRobin::RoundRobinSubchannelList::
   }
 }
 
+constexpr size_t RoundRobin::RoundRobinSubchannelList::kReadyChunkSize;
+
+const std::vector<std::shared_ptr<const RoundRobin::ReadyChunk>>&
+RoundRobin::RoundRobinSubchannelList::GetReadyChunksLocked() {
+  for (size_t chunk = 0; chunk < ready_chunks_.size(); ++chunk) {
+    if (!ready_chunk_dirty_[chunk]) continue;
+    ready_chunk_dirty_[chunk] = false;
+    auto ready = std::make_shared<ReadyChunk>();
+    const size_t end =
+        std::min(num_subchannels(), (chunk + 1) * kReadyChunkSize);
+    for (size_t i = chunk * kReadyChunkSize; i < end; ++i) {
+      RoundRobinSubchannelData* sd = subchannel(i);
+      if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+          GRPC_CHANNEL_READY) {
+        ready->push_back(sd->subchannel()->Ref());
+      }
+    }
+    if (ready->empty()) {
+      ready_chunks_[chunk].reset();
+    } else {
+      ready_chunks_[chunk] = std::move(ready);
+    }
+  }
+  return ready_chunks_;
+}
+
 //
 // RoundRobinSubchannelData
 //
@@ -446,9 +528,9 @@ void RoundRobin::RoundRobinSubchannelData::ProcessConnectivityChangeLocked(
   }
   // Update logical connectivity state.
   UpdateLogicalConnectivityStateLocked(new_state);
-  // Update the policy state.
-  subchannel_list()->MaybeUpdateRoundRobinConnectivityStateLocked(
-      connectivity_status());
+  // Update the policy state once the notifications that are already queued
+  // have been processed.
+  subchannel_list()->ScheduleStateUpdateLocked(connectivity_status());
 }
 
 void RoundRobin::RoundRobinSubchannelData::UpdateLogicalConnectivityStateLocked(
@@ -494,6 +576,10 @@ void RoundRobin::RoundRobinSubchannelData::UpdateLogicalConnectivityStateLocked(
   // Otherwise, update counters and logical state.
   subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
                                                connectivity_state);
+  if ((logical_connectivity_state_ == GRPC_CHANNEL_READY) !=
+      (connectivity_state == GRPC_CHANNEL_READY)) {
+    subchannel_list()->MarkReadyChunkDirtyLocked(Index());
+  }
   logical_connectivity_state_ = connectivity_state;
 }
 
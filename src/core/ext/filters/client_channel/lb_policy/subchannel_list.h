@@ -38,6 +38,7 @@
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/work_serializer.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/load_balancing/lb_policy.h"
 #include "src/core/lib/load_balancing/subchannel_interface.h"
@@ -200,6 +201,15 @@ class SubchannelList : public DualRefCounted<SubchannelListType> {
   // Resets connection backoff of all subchannels.
   void ResetBackoffLocked();
 
+  // Arranges for UpdateStateLocked() to be invoked once the connectivity
+  // state notifications already queued in the policy's WorkSerializer have
+  // been processed.  Calling this from ProcessConnectivityChangeLocked()
+  // instead of reporting a new picker right away means that a burst of
+  // notifications, such as every subchannel reconnecting after a network
+  // blip, results in a single picker.  \a status is the connectivity
+  // status of the subchannel whose state changed.
+  void ScheduleStateUpdateLocked(absl::Status status);
+
   void Orphan() override;
 
  protected:
@@ -210,6 +220,11 @@ class SubchannelList : public DualRefCounted<SubchannelListType> {
 
   virtual ~SubchannelList();
 
+  // Invoked after ScheduleStateUpdateLocked(), unless the list is shutting
+  // down by then.  \a status_for_tf is the last non-OK status passed to
+  // ScheduleStateUpdateLocked() since the previous invocation, or OK.
+  virtual void UpdateStateLocked(absl::Status /*status_for_tf*/) {}
+
  private:
   // For accessing Ref() and Unref().
   friend class SubchannelData<SubchannelListType, SubchannelDataType>;
@@ -228,6 +243,11 @@ class SubchannelList : public DualRefCounted<SubchannelListType> {
   // policy itself or because a newer update has arrived while this one hadn't
   // finished processing.
   bool shutting_down_ = false;
+
+  // Whether ScheduleStateUpdateLocked() was called and UpdateStateLocked()
+  // has not run yet.
+  bool state_update_pending_ = false;
+  absl::Status pending_status_for_tf_;
 };
 
 //
@@ -434,6 +454,31 @@ void SubchannelList<SubchannelListType,
   }
 }
 
+template <typename SubchannelListType, typename SubchannelDataType>
+void SubchannelList<SubchannelListType, SubchannelDataType>::
+    ScheduleStateUpdateLocked(absl::Status status) {
+  if (!status.ok()) pending_status_for_tf_ = std::move(status);
+  if (state_update_pending_) return;
+  state_update_pending_ = true;
+  // We are running in the WorkSerializer, so this is queued behind the
+  // callbacks that are already pending.
+  policy_->work_serializer()->Run(
+      [self = this->WeakRef(DEBUG_LOCATION, "StateUpdate")]() {
+        SubchannelList* subchannel_list = self.get();
+        subchannel_list->state_update_pending_ = false;
+        if (subchannel_list->shutting_down_) return;
+        if (GPR_UNLIKELY(subchannel_list->tracer_ != nullptr)) {
+          gpr_log(GPR_INFO, "[%s %p] subchannel list %p: updating state",
+                  subchannel_list->tracer_, subchannel_list->policy_,
+                  subchannel_list);
+        }
+        subchannel_list->UpdateStateLocked(
+            std::exchange(subchannel_list->pending_status_for_tf_,
+                          absl::OkStatus()));
+      },
+      DEBUG_LOCATION);
+}
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_SUBCHANNEL_LIST_H
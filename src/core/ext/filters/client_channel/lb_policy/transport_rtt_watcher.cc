@@ -0,0 +1,67 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/transport_rtt_watcher.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/transport/transport_rtt_observer.h"
+
+namespace grpc_core {
+
+namespace {
+
+// This watcher is returned to the LB policy and added to the
+// client channel SubchannelWrapper.
+class RttWatcher : public InternalSubchannelDataWatcherInterface,
+                   public TransportRttObserver::WatcherInterface {
+ public:
+  explicit RttWatcher(std::unique_ptr<TransportRttWatcher> watcher)
+      : watcher_(std::move(watcher)) {}
+
+  ~RttWatcher() override {
+    if (observer_ != nullptr) observer_->RemoveWatcher(this);
+  }
+
+  // When the client channel sees this wrapper, it will pass it the real
+  // subchannel to use.
+  void SetSubchannel(Subchannel* subchannel) override {
+    observer_ = subchannel->transport_rtt_observer()->Ref();
+    observer_->AddWatcher(this);
+  }
+
+  void OnRttSample(Duration rtt) override { watcher_->OnRttSample(rtt); }
+
+ private:
+  std::unique_ptr<TransportRttWatcher> watcher_;
+  RefCountedPtr<TransportRttObserver> observer_;
+};
+
+}  // namespace
+
+std::unique_ptr<SubchannelInterface::DataWatcherInterface>
+MakeTransportRttWatcher(std::unique_ptr<TransportRttWatcher> watcher) {
+  return absl::make_unique<RttWatcher>(std::move(watcher));
+}
+
+}  // namespace grpc_core
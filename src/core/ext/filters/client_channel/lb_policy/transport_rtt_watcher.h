@@ -0,0 +1,53 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_TRANSPORT_RTT_WATCHER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_TRANSPORT_RTT_WATCHER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+
+namespace grpc_core {
+
+// Interface for LB policies to watch the round trip times that the
+// transports of a subchannel's connections measure.  With chttp2, these
+// are the RTTs of the BDP pings, which are only sent while data is being
+// received, so there are no samples on an idle connection.
+//
+// To use this, an LB policy will implement its own subclass of
+// TransportRttWatcher and register it with the subchannel like this:
+//   subchannel->AddDataWatcher(
+//       MakeTransportRttWatcher(
+//           absl::make_unique<MyTransportRttWatcherSubclass>(...)));
+
+class TransportRttWatcher {
+ public:
+  virtual ~TransportRttWatcher() = default;
+
+  // Called from the transport, so this must be quick.
+  virtual void OnRttSample(Duration rtt) = 0;
+};
+
+std::unique_ptr<SubchannelInterface::DataWatcherInterface>
+MakeTransportRttWatcher(std::unique_ptr<TransportRttWatcher> watcher);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_TRANSPORT_RTT_WATCHER_H
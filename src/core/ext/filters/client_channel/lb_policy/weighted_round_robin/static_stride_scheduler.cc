@@ -0,0 +1,90 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace grpc_core {
+
+namespace {
+
+constexpr uint16_t kMaxWeight = std::numeric_limits<uint16_t>::max();
+
+constexpr double kMinRatio = 0.01;
+
+}  // namespace
+
+absl::optional<StaticStrideScheduler> StaticStrideScheduler::Make(
+    absl::Span<const float> float_weights,
+    std::function<uint32_t()> next_sequence_func) {
+  if (float_weights.size() < 2) return absl::nullopt;
+  size_t num_positive = 0;
+  double sum = 0;
+  float max = 0;
+  for (float weight : float_weights) {
+    if (weight > 0) {
+      ++num_positive;
+      sum += weight;
+      max = std::max(max, weight);
+    }
+  }
+  if (num_positive < 2) return absl::nullopt;
+  const double scaling_factor = kMaxWeight / max;
+  const uint16_t min_weight = std::lround(kMaxWeight * kMinRatio);
+  auto scale = [&](double weight) -> uint16_t {
+    return std::min<double>(
+        kMaxWeight,
+        std::max<double>(min_weight, std::lround(weight * scaling_factor)));
+  };
+  const uint16_t mean = scale(sum / num_positive);
+  std::vector<uint16_t> weights;
+  weights.reserve(float_weights.size());
+  for (float weight : float_weights) {
+    weights.push_back(weight > 0 ? scale(weight) : mean);
+  }
+  return StaticStrideScheduler(std::move(weights),
+                               std::move(next_sequence_func));
+}
+
+StaticStrideScheduler::StaticStrideScheduler(
+    std::vector<uint16_t> weights, std::function<uint32_t()> next_sequence_func)
+    : next_sequence_func_(std::move(next_sequence_func)),
+      weights_(std::move(weights)) {}
+
+size_t StaticStrideScheduler::Pick() const {
+  while (true) {
+    const uint32_t sequence = next_sequence_func_();
+    // The sequence number selects a backend and a round. The backend takes
+    // its slot in weight out of every kMaxWeight rounds. Offsetting each
+    // backend's rounds keeps backends with the same weight from all taking,
+    // or all skipping, the same rounds.
+    const uint64_t backend_index = sequence % weights_.size();
+    const uint64_t round = sequence / weights_.size();
+    const uint64_t weight = weights_[backend_index];
+    const uint64_t offset = backend_index * (kMaxWeight / 2);
+    if ((weight * round + offset) % kMaxWeight >= kMaxWeight - weight) {
+      return backend_index;
+    }
+  }
+}
+
+}  // namespace grpc_core
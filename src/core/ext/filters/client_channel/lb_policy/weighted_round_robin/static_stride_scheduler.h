@@ -0,0 +1,66 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// Picks backends in proportion to their weights. Each backend has a slot in
+// every round of picks, and takes it in the fraction of the rounds given by
+// its weight relative to the largest one, so picks are spread evenly over
+// time and need no per-pick state beyond a sequence number. The weights are
+// fixed once the scheduler is made.
+class StaticStrideScheduler {
+ public:
+  // Returns nullopt if fewer than two of \a float_weights are positive, in
+  // which case the caller should fall back to round robin. Backends with no
+  // weight get the mean of the others. Weights below 1% of the largest one
+  // are raised to that, which bounds the expected cost of a pick.
+  //
+  // \a next_sequence_func returns consecutive numbers, starting anywhere. It
+  // is called by Pick(), and must be thread-safe if Pick() is called from
+  // several threads.
+  static absl::optional<StaticStrideScheduler> Make(
+      absl::Span<const float> float_weights,
+      std::function<uint32_t()> next_sequence_func);
+
+  // Returns the index of the backend to use.
+  size_t Pick() const;
+
+ private:
+  StaticStrideScheduler(std::vector<uint16_t> weights,
+                        std::function<uint32_t()> next_sequence_func);
+
+  std::function<uint32_t()> next_sequence_func_;
+  // Scaled so that the largest one is the maximum uint16_t.
+  std::vector<uint16_t> weights_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
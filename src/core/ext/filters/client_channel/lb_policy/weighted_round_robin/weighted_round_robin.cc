@@ -0,0 +1,917 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::GetDefaultEventEngine;
+
+constexpr absl::string_view kWeightedRoundRobin =
+    "weighted_round_robin_experimental";
+
+// Config for the weighted_round_robin policy.
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig() = default;
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  Duration blackout_period() const { return blackout_period_; }
+  Duration weight_update_period() const { return weight_update_period_; }
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<WeightedRoundRobinConfig>()
+            .OptionalField("enableOobLoadReport",
+                           &WeightedRoundRobinConfig::enable_oob_load_report_)
+            .OptionalField("oobReportingPeriod",
+                           &WeightedRoundRobinConfig::oob_reporting_period_)
+            .OptionalField("blackoutPeriod",
+                           &WeightedRoundRobinConfig::blackout_period_)
+            .OptionalField("weightUpdatePeriod",
+                           &WeightedRoundRobinConfig::weight_update_period_)
+            .OptionalField("weightExpirationPeriod",
+                           &WeightedRoundRobinConfig::weight_expiration_period_)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors*) {
+    // Rebuilding the scheduler more often than this is not worth the cost.
+    weight_update_period_ =
+        std::max(weight_update_period_, Duration::Milliseconds(100));
+  }
+
+ private:
+  bool enable_oob_load_report_ = false;
+  Duration oob_reporting_period_ = Duration::Seconds(10);
+  Duration blackout_period_ = Duration::Seconds(10);
+  Duration weight_update_period_ = Duration::Seconds(1);
+  Duration weight_expiration_period_ = Duration::Minutes(3);
+};
+
+//
+// weighted_round_robin LB policy
+//
+
+// Spreads picks over the READY subchannels in proportion to weights computed
+// from the QPS and CPU utilization the backends report via ORCA, either on
+// each call or out of band. Backends that serve few queries for the CPU they
+// use get less of the load. Until a backend has reported for the blackout
+// period, and once its reports are older than the expiration period, it gets
+// the mean weight of the others.
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  absl::Status UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin() override;
+
+  // Forward declaration.
+  class WeightedRoundRobinSubchannelList;
+
+  // The weight of an address. Shared by its subchannels in all subchannel
+  // lists, so that it survives resolver updates, and by the call trackers
+  // and OOB watchers that update it.
+  class AddressWeight : public RefCounted<AddressWeight> {
+   public:
+    AddressWeight(RefCountedPtr<WeightedRoundRobin> wrr, std::string key)
+        : wrr_(std::move(wrr)), key_(std::move(key)) {}
+    ~AddressWeight() override;
+
+    // Updates the weight from a load report, unless it lacks the QPS or the
+    // CPU utilization.
+    void MaybeUpdateWeight(double qps, double cpu_utilization);
+
+    // Returns the weight to schedule with, or 0 if the weight is not known,
+    // still in its blackout period, or expired.
+    float GetWeight(Timestamp now, Duration weight_expiration_period,
+                    Duration blackout_period);
+
+    // Restarts the blackout period, e.g. after the backend reconnected.
+    void ResetNonEmptySince();
+
+   private:
+    RefCountedPtr<WeightedRoundRobin> wrr_;
+    const std::string key_;
+
+    Mutex mu_;
+    float weight_ ABSL_GUARDED_BY(&mu_) = 0;
+    Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
+    Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's address, and feeds it with OOB
+  //   load reports if the config enables them.
+  class WeightedRoundRobinSubchannelData
+      : public SubchannelData<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    const RefCountedPtr<AddressWeight>& weight() const { return weight_; }
+
+   private:
+    class OobWatcher : public OobBackendMetricWatcher {
+     public:
+      explicit OobWatcher(RefCountedPtr<AddressWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void OnBackendMetricReport(
+          const BackendMetricData& backend_metric_data) override {
+        weight_->MaybeUpdateWeight(backend_metric_data.qps,
+                                   backend_metric_data.cpu_utilization);
+      }
+
+     private:
+      RefCountedPtr<AddressWeight> weight_;
+    };
+
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.
+    void UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<AddressWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WeightedRoundRobinSubchannelList
+      : public SubchannelList<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelList(WeightedRoundRobin* policy,
+                                     ServerAddressList addresses,
+                                     const ChannelArgs& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)
+                              ? "WeightedRoundRobinSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WeightedRoundRobinSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the WRR policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateWeightedRoundRobinConnectivityStateLocked(
+        absl::Status status_for_tf);
+
+   private:
+    void UpdateStateLocked(absl::Status status_for_tf) override {
+      MaybeUpdateWeightedRoundRobinConnectivityStateLocked(
+          std::move(status_for_tf));
+    }
+
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    absl::Status last_failure_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent,
+           WeightedRoundRobinSubchannelList* subchannel_list);
+    ~Picker() override;
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Feeds the load reports of the calls to the weight of their address.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      explicit SubchannelCallTracker(RefCountedPtr<AddressWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void Start() override {}
+
+      void Finish(FinishArgs args) override {
+        const BackendMetricData* backend_metric_data =
+            args.backend_metric_accessor->GetBackendMetricData();
+        if (backend_metric_data != nullptr) {
+          weight_->MaybeUpdateWeight(backend_metric_data->qps,
+                                     backend_metric_data->cpu_utilization);
+        }
+      }
+
+     private:
+      RefCountedPtr<AddressWeight> weight_;
+    };
+
+    // The scheduler of a picker, which a timer periodically rebuilds from
+    // the latest weights. Shared with the timer callback, which may run
+    // after the picker is gone.
+    class Scheduler : public RefCounted<Scheduler> {
+     public:
+      Scheduler(const WeightedRoundRobinConfig& config,
+                std::vector<RefCountedPtr<AddressWeight>> weights);
+
+      // Returns the index of the address to use.
+      size_t Pick();
+
+      // Rebuilds the scheduler and arms the timer to do it again.
+      void UpdateAndStartTimer();
+
+      // Stops the timer.
+      void Shutdown();
+
+     private:
+      const Duration weight_update_period_;
+      const Duration weight_expiration_period_;
+      const Duration blackout_period_;
+      const std::vector<RefCountedPtr<AddressWeight>> weights_;
+      // Used by the static stride scheduler, or for plain round robin when
+      // there are not enough weights yet. Starts at a random place so that
+      // the clients do not all pick the same backends at the same time.
+      std::atomic<uint32_t> sequence_;
+
+      Mutex mu_;
+      std::shared_ptr<StaticStrideScheduler> scheduler_ ABSL_GUARDED_BY(&mu_);
+      absl::optional<EventEngine::TaskHandle> timer_handle_
+          ABSL_GUARDED_BY(&mu_);
+      bool shutdown_ ABSL_GUARDED_BY(&mu_) = false;
+    };
+
+    struct Endpoint {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<AddressWeight> weight;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    const bool report_per_call_;
+    std::vector<Endpoint> endpoints_;
+    RefCountedPtr<Scheduler> scheduler_;
+  };
+
+  // Returns the weight of \a address, creating it if needed.
+  RefCountedPtr<AddressWeight> GetOrCreateWeight(
+      const grpc_resolved_address& address);
+
+  void ShutdownLocked() override;
+
+  // Current config from resolver.
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+
+  // List of subchannels.
+  RefCountedPtr<WeightedRoundRobinSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  RefCountedPtr<WeightedRoundRobinSubchannelList>
+      latest_pending_subchannel_list_;
+
+  // The weights of the addresses, which unregister themselves when the
+  // last subchannel and call using them are gone.
+  Mutex address_weight_map_mu_;
+  std::map<std::string, AddressWeight*, std::less<>> address_weight_map_
+      ABSL_GUARDED_BY(&address_weight_map_mu_);
+
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::AddressWeight
+//
+
+WeightedRoundRobin::AddressWeight::~AddressWeight() {
+  MutexLock lock(&wrr_->address_weight_map_mu_);
+  auto it = wrr_->address_weight_map_.find(key_);
+  if (it != wrr_->address_weight_map_.end() && it->second == this) {
+    wrr_->address_weight_map_.erase(it);
+  }
+}
+
+void WeightedRoundRobin::AddressWeight::MaybeUpdateWeight(
+    double qps, double cpu_utilization) {
+  if (qps <= 0 || cpu_utilization <= 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] subchannel %s: qps=%f, cpu_utilization=%f: "
+              "ignoring load report",
+              wrr_.get(), key_.c_str(), qps, cpu_utilization);
+    }
+    return;
+  }
+  const float weight = qps / cpu_utilization;
+  const Timestamp now = Timestamp::Now();
+  MutexLock lock(&mu_);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p] subchannel %s: qps=%f, cpu_utilization=%f: "
+            "weight=%f (prev=%f)",
+            wrr_.get(), key_.c_str(), qps, cpu_utilization, weight, weight_);
+  }
+  if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+  weight_ = weight;
+  last_update_time_ = now;
+}
+
+float WeightedRoundRobin::AddressWeight::GetWeight(
+    Timestamp now, Duration weight_expiration_period,
+    Duration blackout_period) {
+  MutexLock lock(&mu_);
+  // A weight that has not been updated for that long no longer says
+  // anything about the backend, which must go through the blackout period
+  // again once it reports.
+  if (now - last_update_time_ >= weight_expiration_period) {
+    non_empty_since_ = Timestamp::InfFuture();
+    return 0;
+  }
+  // The first reports of a backend that just started are often not
+  // representative of its steady state.
+  if (blackout_period > Duration::Zero() &&
+      now - non_empty_since_ < blackout_period) {
+    return 0;
+  }
+  return weight_;
+}
+
+void WeightedRoundRobin::AddressWeight::ResetNonEmptySince() {
+  MutexLock lock(&mu_);
+  non_empty_since_ = Timestamp::InfFuture();
+}
+
+//
+// WeightedRoundRobin::Picker::Scheduler
+//
+
+WeightedRoundRobin::Picker::Scheduler::Scheduler(
+    const WeightedRoundRobinConfig& config,
+    std::vector<RefCountedPtr<AddressWeight>> weights)
+    : weight_update_period_(config.weight_update_period()),
+      weight_expiration_period_(config.weight_expiration_period()),
+      blackout_period_(config.blackout_period()),
+      weights_(std::move(weights)),
+      sequence_(absl::Uniform<uint32_t>(absl::BitGen())) {}
+
+size_t WeightedRoundRobin::Picker::Scheduler::Pick() {
+  std::shared_ptr<StaticStrideScheduler> scheduler;
+  {
+    MutexLock lock(&mu_);
+    scheduler = scheduler_;
+  }
+  if (scheduler != nullptr) return scheduler->Pick();
+  return sequence_.fetch_add(1, std::memory_order_relaxed) % weights_.size();
+}
+
+void WeightedRoundRobin::Picker::Scheduler::UpdateAndStartTimer() {
+  const Timestamp now = Timestamp::Now();
+  std::vector<float> weights;
+  weights.reserve(weights_.size());
+  for (const auto& weight : weights_) {
+    weights.push_back(
+        weight->GetWeight(now, weight_expiration_period_, blackout_period_));
+  }
+  auto static_stride_scheduler = StaticStrideScheduler::Make(
+      weights,
+      [this]() { return sequence_.fetch_add(1, std::memory_order_relaxed); });
+  std::shared_ptr<StaticStrideScheduler> scheduler;
+  if (static_stride_scheduler.has_value()) {
+    scheduler = std::make_shared<StaticStrideScheduler>(
+        std::move(*static_stride_scheduler));
+  }
+  MutexLock lock(&mu_);
+  if (shutdown_) return;
+  scheduler_ = std::move(scheduler);
+  timer_handle_ = GetDefaultEventEngine()->RunAfter(
+      weight_update_period_, [self = Ref()]() mutable {
+        ApplicationCallbackExecCtx app_exec_ctx;
+        ExecCtx exec_ctx;
+        self->UpdateAndStartTimer();
+        // Release the ref before the ExecCtx goes away.
+        self.reset();
+      });
+}
+
+void WeightedRoundRobin::Picker::Scheduler::Shutdown() {
+  MutexLock lock(&mu_);
+  shutdown_ = true;
+  if (timer_handle_.has_value()) {
+    GetDefaultEventEngine()->Cancel(*timer_handle_);
+    timer_handle_.reset();
+  }
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(
+    WeightedRoundRobin* parent,
+    WeightedRoundRobinSubchannelList* subchannel_list)
+    : parent_(parent),
+      report_per_call_(!parent->config_->enable_oob_load_report()) {
+  std::vector<RefCountedPtr<AddressWeight>> weights;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WeightedRoundRobinSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+        GRPC_CHANNEL_READY) {
+      endpoints_.push_back({sd->subchannel()->Ref(), sd->weight()});
+      weights.push_back(sd->weight());
+    }
+  }
+  scheduler_ = MakeRefCounted<Scheduler>(*parent->config_, std::move(weights));
+  scheduler_->UpdateAndStartTimer();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels",
+            parent_, this, subchannel_list, endpoints_.size());
+  }
+}
+
+WeightedRoundRobin::Picker::~Picker() { scheduler_->Shutdown(); }
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  const size_t index = scheduler_->Pick();
+  const Endpoint& endpoint = endpoints_[index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, endpoint.subchannel.get());
+  }
+  std::unique_ptr<SubchannelCallTrackerInterface> subchannel_call_tracker;
+  if (report_per_call_) {
+    subchannel_call_tracker =
+        absl::make_unique<SubchannelCallTracker>(endpoint.weight);
+  }
+  return PickResult::Complete(endpoint.subchannel,
+                              std::move(subchannel_call_tracker));
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::AddressWeight>
+WeightedRoundRobin::GetOrCreateWeight(const grpc_resolved_address& address) {
+  absl::StatusOr<std::string> key = grpc_sockaddr_to_uri(&address);
+  if (!key.ok()) key = grpc_sockaddr_to_string(&address, false);
+  if (!key.ok()) key = key.status().ToString();
+  MutexLock lock(&address_weight_map_mu_);
+  auto it = address_weight_map_.find(*key);
+  if (it != address_weight_map_.end()) {
+    auto weight = it->second->RefIfNonZero();
+    if (weight != nullptr) return weight;
+  }
+  auto weight =
+      MakeRefCounted<AddressWeight>(Ref(DEBUG_LOCATION, "AddressWeight"), *key);
+  address_weight_map_[*key] = weight.get();
+  return weight;
+}
+
+absl::Status WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then keep using the existing
+    // list, but still report back that the update was not accepted.
+    if (subchannel_list_ != nullptr) return args.addresses.status();
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[WRR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ =
+      MakeRefCounted<WeightedRoundRobinSubchannelList>(
+          this, std::move(addresses), args.args);
+  latest_pending_subchannel_list_->StartWatchingLocked();
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[WRR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+    return status;
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_ and report CONNECTING.
+  if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
+  }
+  return absl::OkStatus();
+}
+
+//
+// WeightedRoundRobinSubchannelList
+//
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateStateCountersLocked(absl::optional<grpc_connectivity_state> old_state,
+                              grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    MaybeUpdateWeightedRoundRobinConnectivityStateLocked(
+        absl::Status status_for_tf) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] swapping out subchannel list %p (%s) in favor of %p (%s)",
+          p, p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] reporting TRANSIENT_FAILURE with subchannel list %p: "
+              "%s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    if (!status_for_tf.ok()) {
+      last_failure_ = absl::UnavailableError(
+          absl::StrCat("connections to all backends failing; last error: ",
+                       status_for_tf.ToString()));
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, last_failure_,
+        absl::make_unique<TransientFailurePicker>(last_failure_));
+  }
+}
+
+//
+// WeightedRoundRobinSubchannelData
+//
+
+WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list->policy());
+  weight_ = p->GetOrCreateWeight(address.address());
+  if (p->config_->enable_oob_load_report()) {
+    this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+        p->config_->oob_reporting_period(),
+        absl::make_unique<OobWatcher>(weight_)));
+  }
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve.
+  // Note that we don't want to do this on the initial state notification,
+  // because that would result in an endless loop of re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported %s; requesting re-resolution", p,
+              subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported IDLE; requesting connection", p,
+              subchannel());
+    }
+    subchannel()->RequestConnection();
+  }
+  // A backend that just (re)connected must report for the blackout period
+  // again before its weight is used.
+  if (new_state == GRPC_CHANNEL_READY &&
+      logical_connectivity_state_ != GRPC_CHANNEL_READY) {
+    weight_->ResetNonEmptySince();
+  }
+  // Update logical connectivity state.
+  UpdateLogicalConnectivityStateLocked(new_state);
+  // Update the policy state once the notifications that are already queued
+  // have been processed.
+  subchannel_list()->ScheduleStateUpdateLocked(connectivity_status());
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              p, subchannel(), subchannel_list(), Index(),
+              subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return;
+  }
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    return LoadRefCountedFromJson<WeightedRoundRobinConfig>(
+        json, JsonArgs(),
+        "errors validating weighted_round_robin LB policy config");
+  }
+};
+
+}  // namespace
+
+void RegisterWeightedRoundRobinLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<WeightedRoundRobinFactory>());
+}
+
+}  // namespace grpc_core
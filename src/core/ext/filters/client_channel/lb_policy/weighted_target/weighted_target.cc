@@ -16,7 +16,7 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <stdlib.h>
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/random/random.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -71,6 +72,61 @@ TraceFlag grpc_lb_weighted_target_trace(false, "weighted_target_lb");
 
 namespace {
 
+// Returns part * 2^32 / total, for part < total, by long division: part * 2^32
+// may not fit in 64 bits.
+uint32_t ThresholdOf(uint64_t part, uint64_t total) {
+  uint32_t threshold = 0;
+  for (int i = 0; i < 32; ++i) {
+    part <<= 1;
+    threshold <<= 1;
+    if (part >= total) {
+      part -= total;
+      threshold |= 1;
+    }
+  }
+  return threshold;
+}
+
+}  // namespace
+
+AliasTable::AliasTable(const std::vector<uint32_t>& weights) {
+  const uint64_t n = weights.size();
+  uint64_t total = 0;
+  for (uint32_t weight : weights) total += weight;
+  GPR_ASSERT(n > 0 && total > 0);
+  // Each column holds total / n of the weight. Scaled by n, weights are
+  // compared against total instead, which keeps the arithmetic exact.
+  std::vector<uint64_t> scaled(n);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t i = 0; i < n; ++i) {
+    scaled[i] = weights[i] * n;
+    (scaled[i] < total ? small : large).push_back(i);
+  }
+  columns_.resize(n);
+  // Fill each column short of weight with weight taken from one with too
+  // much, making that the column's alias.
+  while (!small.empty() && !large.empty()) {
+    const uint32_t s = small.back();
+    small.pop_back();
+    const uint32_t l = large.back();
+    columns_[s].threshold = ThresholdOf(scaled[s], total);
+    columns_[s].index = s;
+    columns_[s].alias = l;
+    scaled[l] -= total - scaled[s];
+    if (scaled[l] < total) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // What remains is full, give or take rounding errors: these columns always
+  // pick their own index.
+  for (uint32_t i : large) columns_[i] = {0, i, i};
+  for (uint32_t i : small) columns_[i] = {0, i, i};
+}
+
+namespace {
+
 using ::grpc_event_engine::experimental::EventEngine;
 using ::grpc_event_engine::experimental::GetDefaultEventEngine;
 
@@ -145,13 +201,14 @@ class WeightedTargetLb : public LoadBalancingPolicy {
     using PickerList =
         std::vector<std::pair<uint32_t, RefCountedPtr<ChildPickerWrapper>>>;
 
-    explicit WeightedPicker(PickerList pickers)
-        : pickers_(std::move(pickers)) {}
+    explicit WeightedPicker(PickerList pickers);
 
     PickResult Pick(PickArgs args) override;
 
    private:
-    PickerList pickers_;
+    std::vector<RefCountedPtr<ChildPickerWrapper>> pickers_;
+    // Picks which of pickers_ to delegate to. Unused with only one.
+    AliasTable table_;
   };
 
   // Each WeightedChild holds a ref to its parent WeightedTargetLb.
@@ -258,30 +315,24 @@ class WeightedTargetLb : public LoadBalancingPolicy {
 // WeightedTargetLb::WeightedPicker
 //
 
+WeightedTargetLb::WeightedPicker::WeightedPicker(PickerList pickers) {
+  std::vector<uint32_t> weights;
+  uint32_t start = 0;
+  for (auto& p : pickers) {
+    weights.push_back(p.first - start);
+    start = p.first;
+    pickers_.push_back(std::move(p.second));
+  }
+  if (pickers_.size() > 1) table_ = AliasTable(weights);
+}
+
 WeightedTargetLb::PickResult WeightedTargetLb::WeightedPicker::Pick(
     PickArgs args) {
-  // Generate a random number in [0, total weight).
-  const uint32_t key = rand() % pickers_[pickers_.size() - 1].first;
-  // Find the index in pickers_ corresponding to key.
-  size_t mid = 0;
-  size_t start_index = 0;
-  size_t end_index = pickers_.size() - 1;
-  size_t index = 0;
-  while (end_index > start_index) {
-    mid = (start_index + end_index) / 2;
-    if (pickers_[mid].first > key) {
-      end_index = mid;
-    } else if (pickers_[mid].first < key) {
-      start_index = mid + 1;
-    } else {
-      index = mid + 1;
-      break;
-    }
-  }
-  if (index == 0) index = start_index;
-  GPR_ASSERT(pickers_[index].first > key);
+  // With a single locality, as is common, there is nothing to pick.
+  if (pickers_.size() == 1) return pickers_[0]->Pick(args);
+  thread_local absl::InsecureBitGen bitgen;
   // Delegate to the child picker.
-  return pickers_[index].second->Pick(args);
+  return pickers_[table_.Pick(absl::Uniform<uint64_t>(bitgen))]->Pick(args);
 }
 
 //
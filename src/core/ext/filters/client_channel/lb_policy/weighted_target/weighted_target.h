@@ -0,0 +1,62 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_TARGET_WEIGHTED_TARGET_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_TARGET_WEIGHTED_TARGET_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace grpc_core {
+
+// Picks indices at random, each with a probability proportional to its
+// weight, in constant time whatever the number of weights (Walker's alias
+// method, as built by Vose): one random number picks a column, and a second
+// one whether to take the column's own index or its alias.
+class AliasTable {
+ public:
+  AliasTable() = default;
+  // \a weights must not be empty, and must not all be zero.
+  explicit AliasTable(const std::vector<uint32_t>& weights);
+
+  size_t size() const { return columns_.size(); }
+
+  // Returns the index picked by \a random, which must be uniformly
+  // distributed over all of its 64 bits.
+  size_t Pick(uint64_t random) const {
+    const Column& column =
+        columns_[((random >> 32) * columns_.size()) >> 32];
+    return static_cast<uint32_t>(random) < column.threshold ? column.index
+                                                            : column.alias;
+  }
+
+ private:
+  struct Column {
+    // Out of 2^32, how often the column picks its own index.
+    uint32_t threshold;
+    uint32_t index;
+    uint32_t alias;
+  };
+  std::vector<Column> columns_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_TARGET_WEIGHTED_TARGET_H
@@ -29,7 +29,6 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
-#include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
 #include <grpc/grpc_security.h>
@@ -124,12 +123,11 @@ class CdsLb : public LoadBalancingPolicy {
     ClusterWatcher(RefCountedPtr<CdsLb> parent, std::string name)
         : parent_(std::move(parent)), name_(std::move(name)) {}
 
-    void OnResourceChanged(XdsClusterResource cluster_data) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsClusterResource> cluster_data) override {
       Ref().release();  // Ref held by lambda
       parent_->work_serializer()->Run(
-          // TODO(roth): When we move to C++14, capture cluster_data with
-          // std::move().
-          [this, cluster_data]() mutable {
+          [this, cluster_data = std::move(cluster_data)]() mutable {
             parent_->OnClusterChanged(name_, std::move(cluster_data));
             Unref();
           },
@@ -163,8 +161,9 @@ class CdsLb : public LoadBalancingPolicy {
     // Pointer to watcher, to be used when cancelling.
     // Not owned, so do not dereference.
     ClusterWatcher* watcher = nullptr;
-    // Most recent update obtained from this watcher.
-    absl::optional<XdsClusterResource> update;
+    // Most recent update obtained from this watcher, shared with the
+    // XdsClient.
+    std::shared_ptr<const XdsClusterResource> update;
   };
 
   // Delegating helper to be passed to child policy.
@@ -192,7 +191,7 @@ class CdsLb : public LoadBalancingPolicy {
       const std::string& name, int depth, Json::Array* discovery_mechanisms,
       std::set<std::string>* clusters_added);
   void OnClusterChanged(const std::string& name,
-                        XdsClusterResource cluster_data);
+                        std::shared_ptr<const XdsClusterResource> cluster_data);
   void OnError(const std::string& name, absl::Status status);
   void OnResourceDoesNotExist(const std::string& name);
 
@@ -388,7 +387,7 @@ absl::StatusOr<bool> CdsLb::GenerateDiscoveryMechanismForCluster(
     return false;
   }
   // Don't have the update we need yet.
-  if (!state.update.has_value()) return false;
+  if (state.update == nullptr) return false;
   // For AGGREGATE clusters, recursively expand to child clusters.
   if (state.update->cluster_type ==
       XdsClusterResource::ClusterType::AGGREGATE) {
@@ -443,6 +442,16 @@ absl::StatusOr<bool> CdsLb::GenerateDiscoveryMechanismForCluster(
                                 .failure_percentage_ejection->request_volume},
       };
     }
+    if (outlier_detection_update.consecutive_failure_ejection.has_value()) {
+      outlier_detection["consecutiveFailureEjection"] = Json::Object{
+          {"consecutiveFailures",
+           outlier_detection_update.consecutive_failure_ejection
+               ->consecutive_failures},
+          {"enforcementPercentage",
+           outlier_detection_update.consecutive_failure_ejection
+               ->enforcement_percentage},
+      };
+    }
     mechanism["outlierDetection"] = std::move(outlier_detection);
   }
   switch (state.update->cluster_type) {
@@ -468,13 +477,15 @@ absl::StatusOr<bool> CdsLb::GenerateDiscoveryMechanismForCluster(
   return true;
 }
 
-void CdsLb::OnClusterChanged(const std::string& name,
-                             XdsClusterResource cluster_data) {
+void CdsLb::OnClusterChanged(
+    const std::string& name,
+    std::shared_ptr<const XdsClusterResource> cluster_data) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_cds_lb_trace)) {
     gpr_log(
         GPR_INFO,
         "[cdslb %p] received CDS update for cluster %s from xds client %p: %s",
-        this, name.c_str(), xds_client_.get(), cluster_data.ToString().c_str());
+        this, name.c_str(), xds_client_.get(),
+        cluster_data->ToString().c_str());
   }
   // Store the update in the map if we are still interested in watching this
   // cluster (i.e., it is not cancelled already).
@@ -484,8 +495,7 @@ void CdsLb::OnClusterChanged(const std::string& name,
   if (it == watchers_.end()) return;
   it->second.update = cluster_data;
   // Take care of integration with new certificate code.
-  absl::Status status =
-      UpdateXdsCertificateProvider(name, it->second.update.value());
+  absl::Status status = UpdateXdsCertificateProvider(name, *cluster_data);
   if (!status.ok()) {
     return OnError(name, status);
   }
@@ -510,8 +520,12 @@ void CdsLb::OnClusterChanged(const std::string& name,
     Json::Object xds_lb_policy;
     if (lb_policy == "RING_HASH") {
       xds_lb_policy["RING_HASH"] = Json::Object{
-          {"min_ring_size", cluster_data.min_ring_size},
-          {"max_ring_size", cluster_data.max_ring_size},
+          {"min_ring_size", cluster_data->min_ring_size},
+          {"max_ring_size", cluster_data->max_ring_size},
+      };
+    } else if (lb_policy == "LEAST_REQUEST") {
+      xds_lb_policy["LEAST_REQUEST"] = Json::Object{
+          {"choiceCount", cluster_data->choice_count},
       };
     } else {
       xds_lb_policy["ROUND_ROBIN"] = Json::Object();
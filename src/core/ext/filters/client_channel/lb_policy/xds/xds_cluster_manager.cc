@@ -17,6 +17,8 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #include <algorithm>
 #include <map>
@@ -143,15 +145,24 @@ class XdsClusterManagerLb : public LoadBalancingPolicy {
     using ClusterMap = std::map<absl::string_view /*cluster_name*/,
                                 RefCountedPtr<ChildPickerWrapper>>;
 
+    // The pickers indexed by the slot of the XdsClusterToken of each
+    // cluster, for calls tagged with the token by the xds resolver.
+    struct SlotEntry {
+      uint64_t id = 0;
+      RefCountedPtr<ChildPickerWrapper> picker;
+    };
+    using SlotVector = std::vector<SlotEntry>;
+
     // It is required that the keys of cluster_map have to live at least as long
     // as the ClusterPicker instance.
-    explicit ClusterPicker(ClusterMap cluster_map)
-        : cluster_map_(std::move(cluster_map)) {}
+    ClusterPicker(ClusterMap cluster_map, SlotVector slots)
+        : cluster_map_(std::move(cluster_map)), slots_(std::move(slots)) {}
 
     PickResult Pick(PickArgs args) override;
 
    private:
     ClusterMap cluster_map_;
+    SlotVector slots_;
   };
 
   // Each ClusterChild holds a ref to its parent XdsClusterManagerLb.
@@ -235,6 +246,8 @@ class XdsClusterManagerLb : public LoadBalancingPolicy {
 
   // Current config from the resolver.
   RefCountedPtr<XdsClusterManagerLbConfig> config_;
+  // Tokens of the clusters in config_, if passed by the xds resolver.
+  RefCountedPtr<XdsClusterTokenMap> cluster_tokens_;
 
   // Internal state.
   bool shutting_down_ = false;
@@ -252,6 +265,21 @@ XdsClusterManagerLb::PickResult XdsClusterManagerLb::ClusterPicker::Pick(
     PickArgs args) {
   auto* call_state = static_cast<ClientChannel::LoadBalancedCall::LbCallState*>(
       args.call_state);
+  // Fast path: find the child by the slot of the cluster's token.  The
+  // id check catches slots that were reused for another cluster after
+  // this picker was created.
+  absl::string_view token_attribute =
+      call_state->GetCallAttribute(XdsClusterTokenAttributeTypeName());
+  if (token_attribute.size() == sizeof(XdsClusterToken)) {
+    XdsClusterToken token;
+    memcpy(&token, token_attribute.data(), sizeof(token));
+    if (token.slot < slots_.size()) {
+      const SlotEntry& entry = slots_[token.slot];
+      if (entry.picker != nullptr && entry.id == token.id) {
+        return entry.picker->Pick(args);
+      }
+    }
+  }
   auto cluster_name =
       call_state->GetCallAttribute(XdsClusterAttributeTypeName());
   auto it = cluster_map_.find(cluster_name);
@@ -302,6 +330,7 @@ absl::Status XdsClusterManagerLb::UpdateLocked(UpdateArgs args) {
   update_in_progress_ = true;
   // Update config.
   config_ = std::move(args.config);
+  cluster_tokens_ = args.args.GetObjectRef<XdsClusterTokenMap>();
   // Deactivate the children not in the new config.
   for (const auto& p : children_) {
     const std::string& name = p.first;
@@ -395,6 +424,7 @@ void XdsClusterManagerLb::UpdateStateLocked() {
             this, ConnectivityStateName(connectivity_state));
   }
   ClusterPicker::ClusterMap cluster_map;
+  ClusterPicker::SlotVector slots;
   for (const auto& p : config_->cluster_map()) {
     const std::string& cluster_name = p.first;
     RefCountedPtr<ChildPickerWrapper>& child_picker = cluster_map[cluster_name];
@@ -410,9 +440,18 @@ void XdsClusterManagerLb::UpdateStateLocked() {
           cluster_name,
           absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
     }
+    if (cluster_tokens_ != nullptr) {
+      auto it = cluster_tokens_->tokens().find(cluster_name);
+      if (it != cluster_tokens_->tokens().end()) {
+        const XdsClusterToken& token = it->second;
+        if (token.slot >= slots.size()) slots.resize(token.slot + 1);
+        slots[token.slot].id = token.id;
+        slots[token.slot].picker = child_picker;
+      }
+    }
   }
-  std::unique_ptr<SubchannelPicker> picker =
-      absl::make_unique<ClusterPicker>(std::move(cluster_map));
+  std::unique_ptr<SubchannelPicker> picker = absl::make_unique<ClusterPicker>(
+      std::move(cluster_map), std::move(slots));
   absl::Status status;
   if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
     status = absl::Status(absl::StatusCode::kUnavailable,
@@ -42,6 +42,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
 #include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.h"
+#include "src/core/ext/filters/client_channel/lb_policy/least_request/least_request.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_channel_args.h"
@@ -56,7 +57,9 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/env.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/validation_errors.h"
@@ -87,6 +90,75 @@ namespace {
 constexpr absl::string_view kXdsClusterResolver =
     "xds_cluster_resolver_experimental";
 
+// TODO(roth): Remove once zone-aware routing is no longer experimental.
+bool XdsZoneAwareRoutingEnabled() {
+  auto value = GetEnv("GRPC_EXPERIMENTAL_XDS_ZONE_AWARE_ROUTING");
+  if (!value.has_value()) return false;
+  bool parsed_value;
+  bool parse_succeeded = gpr_parse_bool_value(value->c_str(), &parsed_value);
+  return parse_succeeded && parsed_value;
+}
+
+// The total of the locality weights computed for zone-aware routing.
+constexpr double kZoneAwareTotalWeight = 1e9;
+
+// Returns the weight of each locality of \a priority for the client in
+// \a region and \a zone, or an empty map to weight localities by their
+// lb_weight alone.
+//
+// Clients are taken to be spread evenly over the zones of the priority,
+// and each zone's capacity to be the sum of its lb_weights.  The client's
+// zone gets all of its traffic if its capacity covers its share of the
+// clients; otherwise the zone is filled to capacity and the rest spills
+// over to the other zones by the capacity they have left after serving
+// their own clients.  Localities keep a weight of at least 1, so that
+// traffic still goes to them when all the ones favoured are down.
+std::map<XdsLocalityName*, uint32_t> ZoneAwareLocalityWeights(
+    const XdsEndpointResource::Priority& priority, const std::string& region,
+    const std::string& zone) {
+  std::map<XdsLocalityName*, uint32_t> weights;
+  if (zone.empty()) return weights;
+  // The lb_weight of each zone, keyed by region and zone.
+  std::map<std::pair<std::string, std::string>, double> zone_weights;
+  double total_weight = 0;
+  for (const auto& p : priority.localities) {
+    zone_weights[{p.first->region(), p.first->zone()}] += p.second.lb_weight;
+    total_weight += p.second.lb_weight;
+  }
+  auto local_it = zone_weights.find({region, zone});
+  if (local_it == zone_weights.end() || zone_weights.size() < 2) {
+    return weights;
+  }
+  const double fair_share = 1.0 / zone_weights.size();
+  // The fraction of our traffic that stays in our zone.
+  const double local_fraction =
+      std::min(1.0, local_it->second / total_weight / fair_share);
+  // The capacity the other zones have left after serving their own
+  // clients, as a fraction of the total.
+  auto spare = [&](double zone_weight) {
+    return std::max(0.0, zone_weight / total_weight - fair_share);
+  };
+  double total_spare = 0;
+  for (const auto& p : zone_weights) {
+    if (p.first != local_it->first) total_spare += spare(p.second);
+  }
+  for (const auto& p : priority.localities) {
+    const double zone_weight =
+        zone_weights[{p.first->region(), p.first->zone()}];
+    double zone_fraction = 0;
+    if (p.first->region() == region && p.first->zone() == zone) {
+      zone_fraction = local_fraction;
+    } else if (total_spare > 0) {
+      zone_fraction = (1 - local_fraction) * spare(zone_weight) / total_spare;
+    }
+    // Split the zone's fraction between its localities by lb_weight.
+    const double fraction = zone_fraction * p.second.lb_weight / zone_weight;
+    weights[p.first] = std::max<uint32_t>(
+        1, static_cast<uint32_t>(fraction * kZoneAwareTotalWeight + 0.5));
+  }
+  return weights;
+}
+
 // Config for EDS LB policy.
 class XdsClusterResolverLbConfig : public LoadBalancingPolicy::Config {
  public:
@@ -213,12 +285,11 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
       ~EndpointWatcher() override {
         discovery_mechanism_.reset(DEBUG_LOCATION, "EndpointWatcher");
       }
-      void OnResourceChanged(XdsEndpointResource update) override {
+      void OnResourceChanged(
+          std::shared_ptr<const XdsEndpointResource> update) override {
         Ref().release();  // ref held by callback
         discovery_mechanism_->parent()->work_serializer()->Run(
-            // TODO(yashykt): When we move to C++14, capture update with
-            // std::move
-            [this, update]() mutable {
+            [this, update = std::move(update)]() mutable {
               OnResourceChangedHelper(std::move(update));
               Unref();
             },
@@ -247,15 +318,16 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
       // Code accessing protected methods of `DiscoveryMechanism` need to be
       // in methods of this class rather than in lambdas to work around an MSVC
       // bug.
-      void OnResourceChangedHelper(XdsEndpointResource update) {
+      void OnResourceChangedHelper(
+          std::shared_ptr<const XdsEndpointResource> update) {
         std::string resolution_note;
-        if (update.priorities.empty()) {
+        if (update->priorities.empty()) {
           resolution_note = absl::StrCat(
               "EDS resource ", discovery_mechanism_->GetEdsResourceName(),
               " contains no localities");
         } else {
           std::set<std::string> empty_localities;
-          for (const auto& priority : update.priorities) {
+          for (const auto& priority : update->priorities) {
             for (const auto& p : priority.localities) {
               if (p.second.endpoints.empty()) {
                 empty_localities.insert(p.first->AsHumanReadableString());
@@ -350,8 +422,9 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
 
   struct DiscoveryMechanismEntry {
     OrphanablePtr<DiscoveryMechanism> discovery_mechanism;
-    // Most recent update reported by the discovery mechanism.
-    absl::optional<XdsEndpointResource> latest_update;
+    // Most recent update reported by the discovery mechanism.  May be
+    // shared with the XdsClient, so it must not be modified.
+    std::shared_ptr<const XdsEndpointResource> latest_update;
     // Last resolution note reported by the discovery mechanism, if any.
     std::string resolution_note;
     // State used to retain child policy names for priority policy.
@@ -394,7 +467,8 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
 
   void ShutdownLocked() override;
 
-  void OnEndpointChanged(size_t index, XdsEndpointResource update,
+  void OnEndpointChanged(size_t index,
+                         std::shared_ptr<const XdsEndpointResource> update,
                          std::string resolution_note);
   void OnError(size_t index, std::string resolution_note);
   void OnResourceDoesNotExist(size_t index, std::string resolution_note);
@@ -562,14 +636,14 @@ void XdsClusterResolverLb::LogicalDNSDiscoveryMechanism::ResolverResultHandler::
     return;
   }
   // Convert resolver result to EDS update.
-  XdsEndpointResource update;
+  auto update = std::make_shared<XdsEndpointResource>();
   XdsEndpointResource::Priority::Locality locality;
   locality.name = MakeRefCounted<XdsLocalityName>("", "", "");
   locality.lb_weight = 1;
   locality.endpoints = std::move(*result.addresses);
   XdsEndpointResource::Priority priority;
   priority.localities.emplace(locality.name.get(), std::move(locality));
-  update.priorities.emplace_back(std::move(priority));
+  update->priorities.emplace_back(std::move(priority));
   lb_policy->OnEndpointChanged(index, std::move(update),
                                std::move(result.resolution_note));
 }
@@ -682,9 +756,9 @@ void XdsClusterResolverLb::ExitIdleLocked() {
   if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
 }
 
-void XdsClusterResolverLb::OnEndpointChanged(size_t index,
-                                             XdsEndpointResource update,
-                                             std::string resolution_note) {
+void XdsClusterResolverLb::OnEndpointChanged(
+    size_t index, std::shared_ptr<const XdsEndpointResource> update,
+    std::string resolution_note) {
   if (shutting_down_) return;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_xds_cluster_resolver_trace)) {
     gpr_log(GPR_INFO,
@@ -697,7 +771,11 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   // have a child in which to create the xds_cluster_impl policy.  This ensures
   // that we properly handle the case of a discovery mechanism dropping 100% of
   // calls, the OnError() case, and the OnResourceDoesNotExist() case.
-  if (update.priorities.empty()) update.priorities.emplace_back();
+  if (update->priorities.empty()) {
+    auto copy = std::make_shared<XdsEndpointResource>(*update);
+    copy->priorities.emplace_back();
+    update = std::move(copy);
+  }
   // Update priority_child_numbers, reusing old child numbers in an
   // intelligent way to avoid unnecessary churn.
   // First, build some maps from locality to child number and the reverse
@@ -706,7 +784,7 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
       locality_child_map;
   std::map<size_t, std::set<XdsLocalityName*, XdsLocalityName::Less>>
       child_locality_map;
-  if (discovery_entry.latest_update.has_value()) {
+  if (discovery_entry.latest_update != nullptr) {
     const auto& prev_priority_list = discovery_entry.latest_update->priorities;
     for (size_t priority = 0; priority < prev_priority_list.size();
          ++priority) {
@@ -721,8 +799,8 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   }
   // Construct new list of children.
   std::vector<size_t> priority_child_numbers;
-  for (size_t priority = 0; priority < update.priorities.size(); ++priority) {
-    const auto& localities = update.priorities[priority].localities;
+  for (size_t priority = 0; priority < update->priorities.size(); ++priority) {
+    const auto& localities = update->priorities[priority].localities;
     absl::optional<size_t> child_number;
     // If one of the localities in this priority already existed, reuse its
     // child number.
@@ -775,7 +853,7 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   // will put the channel into TRANSIENT_FAILURE instead of CONNECTING
   // while we're still waiting for the other discovery mechanism(s).
   for (DiscoveryMechanismEntry& mechanism : discovery_mechanisms_) {
-    if (!mechanism.latest_update.has_value()) return;
+    if (mechanism.latest_update == nullptr) return;
   }
   // Update child policy.
   // TODO(roth): If the child policy reports an error with the update,
@@ -789,10 +867,11 @@ void XdsClusterResolverLb::OnError(size_t index, std::string resolution_note) {
           " reported error: %s",
           this, index, resolution_note.c_str());
   if (shutting_down_) return;
-  if (!discovery_mechanisms_[index].latest_update.has_value()) {
+  if (discovery_mechanisms_[index].latest_update == nullptr) {
     // Call OnEndpointChanged() with an empty update just like
     // OnResourceDoesNotExist().
-    OnEndpointChanged(index, XdsEndpointResource(), std::move(resolution_note));
+    OnEndpointChanged(index, std::make_shared<XdsEndpointResource>(),
+                      std::move(resolution_note));
   }
 }
 
@@ -804,7 +883,8 @@ void XdsClusterResolverLb::OnResourceDoesNotExist(size_t index,
           this, index, resolution_note.c_str());
   if (shutting_down_) return;
   // Call OnEndpointChanged() with an empty update.
-  OnEndpointChanged(index, XdsEndpointResource(), std::move(resolution_note));
+  OnEndpointChanged(index, std::make_shared<XdsEndpointResource>(),
+                    std::move(resolution_note));
 }
 
 //
@@ -824,8 +904,18 @@ ServerAddressList XdsClusterResolverLb::CreateChildPolicyAddressesLocked() {
       for (const auto& p : priority_entry.localities) {
         const auto& locality_name = p.first;
         const auto& locality = p.second;
-        std::vector<std::string> hierarchical_path = {
-            priority_child_name, locality_name->AsHumanReadableString()};
+        // The path and locality attributes are the same for all endpoints
+        // in the locality, and endpoints with the same weight share a
+        // weight attribute, so that large localities store them only once.
+        std::shared_ptr<const ServerAddress::AttributeInterface>
+            hierarchical_path_attribute = MakeHierarchicalPathAttribute(
+                {priority_child_name, locality_name->AsHumanReadableString()});
+        std::shared_ptr<const ServerAddress::AttributeInterface>
+            locality_attribute =
+                std::make_shared<XdsLocalityAttribute>(locality_name->Ref());
+        std::map<uint32_t,
+                 std::shared_ptr<const ServerAddress::AttributeInterface>>
+            weight_attributes;
         for (const auto& endpoint : locality.endpoints) {
           const ServerAddressWeightAttribute* weight_attribute = static_cast<
               const ServerAddressWeightAttribute*>(endpoint.GetAttribute(
@@ -834,18 +924,20 @@ ServerAddressList XdsClusterResolverLb::CreateChildPolicyAddressesLocked() {
           if (weight_attribute != nullptr) {
             weight = locality.lb_weight * weight_attribute->weight();
           }
+          auto& shared_weight_attribute = weight_attributes[weight];
+          if (shared_weight_attribute == nullptr) {
+            shared_weight_attribute =
+                std::make_shared<ServerAddressWeightAttribute>(weight);
+          }
           addresses.emplace_back(
               endpoint
-                  .WithAttribute(
-                      kHierarchicalPathAttributeKey,
-                      MakeHierarchicalPathAttribute(hierarchical_path))
-                  .WithAttribute(kXdsLocalityNameAttributeKey,
-                                 absl::make_unique<XdsLocalityAttribute>(
-                                     locality_name->Ref()))
-                  .WithAttribute(
-                      ServerAddressWeightAttribute::
-                          kServerAddressWeightAttributeKey,
-                      absl::make_unique<ServerAddressWeightAttribute>(weight)));
+                  .WithSharedAttribute(kHierarchicalPathAttributeKey,
+                                       hierarchical_path_attribute)
+                  .WithSharedAttribute(kXdsLocalityNameAttributeKey,
+                                       locality_attribute)
+                  .WithSharedAttribute(ServerAddressWeightAttribute::
+                                           kServerAddressWeightAttributeKey,
+                                       shared_weight_attribute));
         }
       }
     }
@@ -881,22 +973,43 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
             discovery_entry.discovery_mechanism->override_child_policy();
       } else {
         const auto& xds_lb_policy = config_->xds_lb_policy().object_value();
-        if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end()) {
+        auto least_request_it = xds_lb_policy.find("LEAST_REQUEST");
+        if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end() ||
+            least_request_it != xds_lb_policy.end()) {
+          // Localities are picked by weight, then endpoints within them by
+          // the endpoint-picking policy.
+          Json::Object endpoint_picking_policy;
+          if (least_request_it != xds_lb_policy.end()) {
+            endpoint_picking_policy["least_request_experimental"] =
+                least_request_it->second;
+          } else {
+            endpoint_picking_policy["round_robin"] = Json::Object();
+          }
           const auto& localities = priority_entry.localities;
+          // With zone-aware routing, prefer the localities in our own zone.
+          std::map<XdsLocalityName*, uint32_t> zone_aware_weights;
+          if (XdsZoneAwareRoutingEnabled()) {
+            const XdsBootstrap::Node* node = xds_client_->bootstrap().node();
+            if (node != nullptr) {
+              zone_aware_weights = ZoneAwareLocalityWeights(
+                  priority_entry, node->locality_region(),
+                  node->locality_zone());
+            }
+          }
           Json::Object weighted_targets;
           for (const auto& p : localities) {
             XdsLocalityName* locality_name = p.first;
             const auto& locality = p.second;
+            uint32_t weight = locality.lb_weight;
+            auto weight_it = zone_aware_weights.find(locality_name);
+            if (weight_it != zone_aware_weights.end()) {
+              weight = weight_it->second;
+            }
             // Add weighted target entry.
             weighted_targets[locality_name->AsHumanReadableString()] =
                 Json::Object{
-                    {"weight", locality.lb_weight},
-                    {"childPolicy",
-                     Json::Array{
-                         Json::Object{
-                             {"round_robin", Json::Object()},
-                         },
-                     }},
+                    {"weight", weight},
+                    {"childPolicy", Json::Array{endpoint_picking_policy}},
                 };
           }
           // Construct locality-picking policy.
@@ -1183,6 +1296,16 @@ void XdsClusterResolverLbConfig::JsonPostLoad(const Json& json,
               xds_lb_policy_ = array[i];
             }
           }
+          {
+            ValidationErrors::ScopedField field(errors,
+                                                "[\"LEAST_REQUEST\"]");
+            policy_it = policy.find("LEAST_REQUEST");
+            if (policy_it != policy.end()) {
+              LoadFromJson<LeastRequestConfig>(policy_it->second, args,
+                                               errors);
+              xds_lb_policy_ = array[i];
+            }
+          }
         }
       }
     }
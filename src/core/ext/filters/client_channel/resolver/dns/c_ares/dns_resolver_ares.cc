@@ -72,10 +72,12 @@
 #include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_result_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/event_engine/handle_containers.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/iomgr/gethostname.h"
 #include "src/core/lib/iomgr/resolve_address.h"
@@ -102,11 +104,16 @@ class AresClientChannelDNSResolver : public PollingResolver {
   OrphanablePtr<Orphanable> StartRequest() override;
 
  private:
+  // The hostname, SRV and TXT queries for the resolver's name.  Does not
+  // depend on the resolver itself, so that the DnsResultCache may share it
+  // among channels.
   class AresRequestWrapper : public InternallyRefCounted<AresRequestWrapper> {
    public:
-    explicit AresRequestWrapper(
-        RefCountedPtr<AresClientChannelDNSResolver> resolver)
-        : resolver_(std::move(resolver)) {
+    AresRequestWrapper(const AresClientChannelDNSResolver& resolver,
+                       grpc_pollset_set* interested_parties,
+                       DnsResultCache::OnDone on_done)
+        : name_to_resolve_(resolver.name_to_resolve()),
+          on_done_(std::move(on_done)) {
       // TODO(hork): replace this callback bookkeeping with promises.
       // Locking to prevent completion before all records are queried
       MutexLock lock(&on_resolved_mu_);
@@ -114,42 +121,37 @@ class AresClientChannelDNSResolver : public PollingResolver {
       GRPC_CLOSURE_INIT(&on_hostname_resolved_, OnHostnameResolved, this,
                         nullptr);
       hostname_request_.reset(grpc_dns_lookup_hostname_ares(
-          resolver_->authority().c_str(), resolver_->name_to_resolve().c_str(),
-          kDefaultSecurePort, resolver_->interested_parties(),
-          &on_hostname_resolved_, &addresses_, resolver_->query_timeout_ms_));
+          resolver.authority().c_str(), resolver.name_to_resolve().c_str(),
+          kDefaultSecurePort, interested_parties, &on_hostname_resolved_,
+          &addresses_, resolver.query_timeout_ms_));
       GRPC_CARES_TRACE_LOG(
           "resolver:%p Started resolving hostnames. hostname_request_:%p",
-          resolver_.get(), hostname_request_.get());
-      if (resolver_->enable_srv_queries_) {
+          &resolver, hostname_request_.get());
+      if (resolver.enable_srv_queries_) {
         Ref(DEBUG_LOCATION, "OnSRVResolved").release();
         GRPC_CLOSURE_INIT(&on_srv_resolved_, OnSRVResolved, this, nullptr);
         srv_request_.reset(grpc_dns_lookup_srv_ares(
-            resolver_->authority().c_str(),
-            resolver_->name_to_resolve().c_str(),
-            resolver_->interested_parties(), &on_srv_resolved_,
-            &balancer_addresses_, resolver_->query_timeout_ms_));
+            resolver.authority().c_str(), resolver.name_to_resolve().c_str(),
+            interested_parties, &on_srv_resolved_, &balancer_addresses_,
+            resolver.query_timeout_ms_));
         GRPC_CARES_TRACE_LOG(
             "resolver:%p Started resolving SRV records. srv_request_:%p",
-            resolver_.get(), srv_request_.get());
+            &resolver, srv_request_.get());
       }
-      if (resolver_->request_service_config_) {
+      if (resolver.request_service_config_) {
         Ref(DEBUG_LOCATION, "OnTXTResolved").release();
         GRPC_CLOSURE_INIT(&on_txt_resolved_, OnTXTResolved, this, nullptr);
         txt_request_.reset(grpc_dns_lookup_txt_ares(
-            resolver_->authority().c_str(),
-            resolver_->name_to_resolve().c_str(),
-            resolver_->interested_parties(), &on_txt_resolved_,
-            &service_config_json_, resolver_->query_timeout_ms_));
+            resolver.authority().c_str(), resolver.name_to_resolve().c_str(),
+            interested_parties, &on_txt_resolved_, &service_config_json_,
+            resolver.query_timeout_ms_));
         GRPC_CARES_TRACE_LOG(
             "resolver:%p Started resolving TXT records. txt_request_:%p",
-            resolver_.get(), srv_request_.get());
+            &resolver, srv_request_.get());
       }
     }
 
-    ~AresRequestWrapper() override {
-      gpr_free(service_config_json_);
-      resolver_.reset(DEBUG_LOCATION, "dns-resolving");
-    }
+    ~AresRequestWrapper() override { gpr_free(service_config_json_); }
 
     // Note that thread safety cannot be analyzed due to this being invoked from
     // OrphanablePtr<>, and there's no way to pass the lock annotation through
@@ -174,11 +176,12 @@ class AresClientChannelDNSResolver : public PollingResolver {
     static void OnHostnameResolved(void* arg, grpc_error_handle error);
     static void OnSRVResolved(void* arg, grpc_error_handle error);
     static void OnTXTResolved(void* arg, grpc_error_handle error);
-    absl::optional<Result> OnResolvedLocked(grpc_error_handle error)
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(on_resolved_mu_);
+    absl::optional<DnsResultCache::LookupResult> OnResolvedLocked(
+        grpc_error_handle error) ABSL_EXCLUSIVE_LOCKS_REQUIRED(on_resolved_mu_);
 
+    const std::string name_to_resolve_;
+    const DnsResultCache::OnDone on_done_;
     Mutex on_resolved_mu_;
-    RefCountedPtr<AresClientChannelDNSResolver> resolver_;
     grpc_closure on_hostname_resolved_;
     std::unique_ptr<grpc_ares_request> hostname_request_
         ABSL_GUARDED_BY(on_resolved_mu_);
@@ -198,6 +201,9 @@ class AresClientChannelDNSResolver : public PollingResolver {
 
   ~AresClientChannelDNSResolver() override;
 
+  // Turns the result of the queries into a Result for this channel.
+  void OnLookupDone(DnsResultCache::LookupResult lookup_result);
+
   /// whether to request the service config
   const bool request_service_config_;
   // whether or not to enable SRV DNS queries
@@ -238,8 +244,30 @@ AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
-  return MakeOrphanable<AresRequestWrapper>(
-      Ref(DEBUG_LOCATION, "dns-resolving"));
+  RefCountedPtr<AresClientChannelDNSResolver> self =
+      Ref(DEBUG_LOCATION, "dns-resolving");
+  DnsResultCache::OnDone on_done =
+      [self = std::move(self)](DnsResultCache::LookupResult lookup_result) {
+        self->OnLookupDone(std::move(lookup_result));
+      };
+  if (!IsDnsResultCacheEnabled()) {
+    return MakeOrphanable<AresRequestWrapper>(*this, interested_parties(),
+                                              std::move(on_done));
+  }
+  // The queries made depend on the channel args, so they are part of the
+  // key.
+  std::string key = absl::StrCat("ares:", authority(), "/", name_to_resolve(),
+                                 ":", query_timeout_ms_);
+  if (enable_srv_queries_) absl::StrAppend(&key, ":srv");
+  if (request_service_config_) absl::StrAppend(&key, ":txt");
+  return DnsResultCache::Get()->Lookup(
+      key, min_time_between_resolutions(), interested_parties(),
+      [this](grpc_pollset_set* interested_parties,
+             DnsResultCache::OnDone on_done) {
+        return OrphanablePtr<Orphanable>(MakeOrphanable<AresRequestWrapper>(
+            *this, interested_parties, std::move(on_done)));
+      },
+      std::move(on_done));
 }
 
 bool ValueInJsonArray(const Json::Array& array, const char* value) {
@@ -251,7 +279,7 @@ bool ValueInJsonArray(const Json::Array& array, const char* value) {
   return false;
 }
 
-std::string ChooseServiceConfig(char* service_config_choice_json,
+std::string ChooseServiceConfig(absl::string_view service_config_choice_json,
                                 grpc_error_handle* error) {
   auto json = Json::Parse(service_config_choice_json);
   if (!json.ok()) {
@@ -336,53 +364,47 @@ std::string ChooseServiceConfig(char* service_config_choice_json,
 void AresClientChannelDNSResolver::AresRequestWrapper::OnHostnameResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsResultCache::LookupResult> result;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->hostname_request_.reset();
     result = self->OnResolvedLocked(error);
   }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
-  }
+  if (result.has_value()) self->on_done_(std::move(*result));
   self->Unref(DEBUG_LOCATION, "OnHostnameResolved");
 }
 
 void AresClientChannelDNSResolver::AresRequestWrapper::OnSRVResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsResultCache::LookupResult> result;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->srv_request_.reset();
     result = self->OnResolvedLocked(error);
   }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
-  }
+  if (result.has_value()) self->on_done_(std::move(*result));
   self->Unref(DEBUG_LOCATION, "OnSRVResolved");
 }
 
 void AresClientChannelDNSResolver::AresRequestWrapper::OnTXTResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsResultCache::LookupResult> result;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->txt_request_.reset();
     result = self->OnResolvedLocked(error);
   }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
-  }
+  if (result.has_value()) self->on_done_(std::move(*result));
   self->Unref(DEBUG_LOCATION, "OnTXTResolved");
 }
 
-// Returns a Result if resolution is complete.
-// callers must release the lock and call OnRequestComplete if a Result is
-// returned. This is because OnRequestComplete may Orphan the resolver, which
+// Returns a LookupResult if resolution is complete.
+// callers must release the lock and call on_done_ if a LookupResult is
+// returned. This is because on_done_ may Orphan the resolver, which
 // requires taking the lock.
-absl::optional<AresClientChannelDNSResolver::Result>
+absl::optional<DnsResultCache::LookupResult>
 AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
     grpc_error_handle error) ABSL_EXCLUSIVE_LOCKS_REQUIRED(on_resolved_mu_) {
   if (hostname_request_ != nullptr || srv_request_ != nullptr ||
@@ -396,20 +418,38 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
     return absl::nullopt;
   }
   GRPC_CARES_TRACE_LOG("resolver:%p OnResolved() proceeding", this);
+  DnsResultCache::LookupResult result;
+  if (addresses_ != nullptr) result.addresses = std::move(*addresses_);
+  if (balancer_addresses_ != nullptr) {
+    result.balancer_addresses = std::move(*balancer_addresses_);
+  }
+  if (service_config_json_ != nullptr) {
+    result.service_config_json = service_config_json_;
+  }
+  if (!result.ok()) {
+    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
+                         grpc_error_std_string(error).c_str());
+    std::string error_message;
+    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
+    result.status = absl::UnavailableError(absl::StrCat(
+        "DNS resolution failed for ", name_to_resolve_, ": ", error_message));
+  }
+  return std::move(result);
+}
+
+void AresClientChannelDNSResolver::OnLookupDone(
+    DnsResultCache::LookupResult lookup_result) {
   Result result;
-  result.args = resolver_->channel_args();
+  result.args = channel_args();
   // TODO(roth): Change logic to be able to report failures for addresses
   // and service config independently of each other.
-  if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
-    if (addresses_ != nullptr) {
-      result.addresses = std::move(*addresses_);
-    } else {
-      result.addresses = ServerAddressList();
-    }
-    if (service_config_json_ != nullptr) {
+  if (lookup_result.ok()) {
+    result.addresses =
+        std::move(lookup_result.addresses).value_or(ServerAddressList());
+    if (lookup_result.service_config_json.has_value()) {
       grpc_error_handle service_config_error;
-      std::string service_config_string =
-          ChooseServiceConfig(service_config_json_, &service_config_error);
+      std::string service_config_string = ChooseServiceConfig(
+          *lookup_result.service_config_json, &service_config_error);
       if (!service_config_error.ok()) {
         result.service_config = absl::UnavailableError(
             absl::StrCat("failed to parse service config: ",
@@ -417,8 +457,8 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
       } else if (!service_config_string.empty()) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
                              this, service_config_string.c_str());
-        result.service_config = ServiceConfigImpl::Create(
-            resolver_->channel_args(), service_config_string);
+        result.service_config =
+            ServiceConfigImpl::Create(channel_args(), service_config_string);
         if (!result.service_config.ok()) {
           result.service_config = absl::UnavailableError(
               absl::StrCat("failed to parse service config: ",
@@ -426,23 +466,15 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
         }
       }
     }
-    if (balancer_addresses_ != nullptr) {
+    if (lookup_result.balancer_addresses.has_value()) {
       result.args = SetGrpcLbBalancerAddresses(
-          result.args, ServerAddressList(*balancer_addresses_));
+          result.args, std::move(*lookup_result.balancer_addresses));
     }
   } else {
-    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
-                         grpc_error_std_string(error).c_str());
-    std::string error_message;
-    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
-    absl::Status status = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", resolver_->name_to_resolve(),
-                     ": ", error_message));
-    result.addresses = status;
-    result.service_config = status;
+    result.addresses = lookup_result.status;
+    result.service_config = lookup_result.status;
   }
-
-  return std::move(result);
+  OnRequestComplete(std::move(result));
 }
 
 //
@@ -0,0 +1,206 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_result_cache.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "src/core/lib/iomgr/pollset_set.h"
+
+namespace grpc_core {
+
+//
+// DnsResultCache::PendingLookup
+//
+
+// A lookup in flight, and the waiters for its result.  All of the non-const
+// fields are guarded by the cache's mu_.
+class DnsResultCache::PendingLookup : public RefCounted<PendingLookup> {
+ public:
+  PendingLookup(std::string key, Timestamp start_time)
+      : key(std::move(key)),
+        start_time(start_time),
+        pollset_set(grpc_pollset_set_create()) {}
+
+  ~PendingLookup() override { grpc_pollset_set_destroy(pollset_set); }
+
+  const std::string key;
+  const Timestamp start_time;
+  // Drives the lookup; the interested parties of the waiters are added to
+  // it.
+  grpc_pollset_set* const pollset_set;
+  OrphanablePtr<Orphanable> lookup;
+  std::set<Waiter*> waiters;
+  // Set once no one waits for the result anymore.
+  bool cancelled = false;
+  bool done = false;
+};
+
+//
+// DnsResultCache::Waiter
+//
+
+// One lookup of the cache.  pending and on_done are guarded by the cache's
+// mu_, and are reset once the result is delivered.
+class DnsResultCache::Waiter : public Orphanable {
+ public:
+  Waiter(DnsResultCache* cache, RefCountedPtr<PendingLookup> pending,
+         grpc_pollset_set* interested_parties, OnDone on_done)
+      : cache(cache),
+        pending(std::move(pending)),
+        interested_parties(interested_parties),
+        on_done(std::move(on_done)) {}
+
+  void Orphan() override {
+    cache->CancelWaiter(this);
+    delete this;
+  }
+
+  DnsResultCache* const cache;
+  RefCountedPtr<PendingLookup> pending;
+  grpc_pollset_set* const interested_parties;
+  OnDone on_done;
+};
+
+//
+// DnsResultCache
+//
+
+DnsResultCache* DnsResultCache::Get() {
+  static DnsResultCache* cache = new DnsResultCache();
+  return cache;
+}
+
+OrphanablePtr<Orphanable> DnsResultCache::Lookup(
+    const std::string& key, Duration max_age,
+    grpc_pollset_set* interested_parties, const StartLookupFunc& start_lookup,
+    OnDone on_done) {
+  const Timestamp now = Timestamp::Now();
+  absl::optional<LookupResult> cached_result;
+  RefCountedPtr<PendingLookup> pending;
+  Waiter* waiter = nullptr;
+  bool start = false;
+  {
+    MutexLock lock(&mu_);
+    longest_max_age_ = std::max(longest_max_age_, max_age);
+    auto it = results_.find(key);
+    if (it != results_.end() && now - it->second.start_time < max_age) {
+      cached_result = it->second.result;
+    } else {
+      auto pending_it = pending_.find(key);
+      if (pending_it != pending_.end()) {
+        pending = pending_it->second;
+      } else {
+        pending = MakeRefCounted<PendingLookup>(key, now);
+        pending_.emplace(key, pending);
+        start = true;
+      }
+      waiter =
+          new Waiter(this, pending, interested_parties, std::move(on_done));
+      pending->waiters.insert(waiter);
+      if (interested_parties != nullptr) {
+        grpc_pollset_set_add_pollset_set(pending->pollset_set,
+                                         interested_parties);
+      }
+    }
+  }
+  if (cached_result.has_value()) {
+    on_done(std::move(*cached_result));
+    return MakeOrphanable<Waiter>(this, nullptr, nullptr, nullptr);
+  }
+  if (start) {
+    OrphanablePtr<Orphanable> lookup = start_lookup(
+        pending->pollset_set, [this, pending](LookupResult result) {
+          OnLookupDone(pending, std::move(result));
+        });
+    MutexLock lock(&mu_);
+    // If the lookup already completed, it is released outside of the lock.
+    if (!pending->done) pending->lookup = std::move(lookup);
+  }
+  return OrphanablePtr<Orphanable>(waiter);
+}
+
+void DnsResultCache::OnLookupDone(const RefCountedPtr<PendingLookup>& pending,
+                                  LookupResult result) {
+  OrphanablePtr<Orphanable> lookup;
+  std::vector<OnDone> callbacks;
+  {
+    MutexLock lock(&mu_);
+    pending->done = true;
+    lookup = std::move(pending->lookup);
+    if (pending->cancelled) return;
+    pending_.erase(pending->key);
+    if (result.ok()) {
+      results_[pending->key] = CachedResult{pending->start_time, result};
+      PruneLocked();
+    }
+    for (Waiter* waiter : pending->waiters) {
+      if (waiter->interested_parties != nullptr) {
+        grpc_pollset_set_del_pollset_set(pending->pollset_set,
+                                         waiter->interested_parties);
+      }
+      callbacks.push_back(std::move(waiter->on_done));
+      waiter->pending.reset();
+    }
+    pending->waiters.clear();
+  }
+  for (OnDone& on_done : callbacks) on_done(result);
+}
+
+void DnsResultCache::CancelWaiter(Waiter* waiter) {
+  OrphanablePtr<Orphanable> lookup;
+  {
+    MutexLock lock(&mu_);
+    PendingLookup* pending = waiter->pending.get();
+    if (pending == nullptr) return;
+    pending->waiters.erase(waiter);
+    if (waiter->interested_parties != nullptr) {
+      grpc_pollset_set_del_pollset_set(pending->pollset_set,
+                                       waiter->interested_parties);
+    }
+    if (pending->waiters.empty()) {
+      // The lookup still invokes its callback once cancelled, and finds
+      // that there is no one to deliver its result to.
+      pending->cancelled = true;
+      pending_.erase(pending->key);
+      lookup = std::move(pending->lookup);
+    }
+    waiter->pending.reset();
+  }
+}
+
+void DnsResultCache::PruneLocked() {
+  const Timestamp now = Timestamp::Now();
+  for (auto it = results_.begin(); it != results_.end();) {
+    if (now - it->second.start_time >= longest_max_age_) {
+      results_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void DnsResultCache::ResetForTesting() {
+  MutexLock lock(&mu_);
+  results_.clear();
+}
+
+}  // namespace grpc_core
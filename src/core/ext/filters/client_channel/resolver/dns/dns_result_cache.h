@@ -0,0 +1,117 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_RESULT_CACHE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_RESULT_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <functional>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// A process-wide cache of DNS lookup results, shared by the DNS resolvers
+// of all channels.
+//
+// Concurrent lookups with the same key are coalesced into a single lookup,
+// whose result is delivered to all of them.  A successful result is also
+// kept, and handed out to later lookups of the same key for as long as it
+// is younger than the max age they ask for, which resolvers set to their
+// minimum time between resolutions: a channel never sees a result older
+// than one it could have asked for itself.
+class DnsResultCache {
+ public:
+  // The result of a lookup, before any per-channel processing.
+  struct LookupResult {
+    // Unset if no addresses were found.
+    absl::optional<ServerAddressList> addresses;
+    absl::optional<ServerAddressList> balancer_addresses;
+    absl::optional<std::string> service_config_json;
+    // Why the lookup failed, if it found no addresses.
+    absl::Status status;
+
+    bool ok() const {
+      return addresses.has_value() || balancer_addresses.has_value();
+    }
+  };
+
+  using OnDone = std::function<void(LookupResult)>;
+  // Starts a lookup driven by \a interested_parties.  The lookup must
+  // invoke \a on_done exactly once, even when it is cancelled by orphaning
+  // the returned object.
+  using StartLookupFunc = std::function<OrphanablePtr<Orphanable>(
+      grpc_pollset_set* interested_parties, OnDone on_done)>;
+
+  static DnsResultCache* Get();
+
+  // Delivers a result for \a key to \a on_done: a cached result from a
+  // lookup started less than \a max_age ago if there is one, or else the
+  // result of the lookup already in flight for \a key, or else that of a
+  // new lookup started with \a start_lookup.  \a on_done may be invoked
+  // before Lookup() returns.
+  //
+  // Orphaning the returned object cancels the interest in the result; the
+  // lookup itself is cancelled when no one is interested in it anymore.
+  // \a on_done may still be invoked if the lookup completes concurrently.
+  OrphanablePtr<Orphanable> Lookup(const std::string& key, Duration max_age,
+                                   grpc_pollset_set* interested_parties,
+                                   const StartLookupFunc& start_lookup,
+                                   OnDone on_done);
+
+  // Drops the cached results.
+  void ResetForTesting();
+
+ private:
+  class PendingLookup;
+  class Waiter;
+
+  struct CachedResult {
+    Timestamp start_time;
+    LookupResult result;
+  };
+
+  void OnLookupDone(const RefCountedPtr<PendingLookup>& pending,
+                    LookupResult result);
+  void CancelWaiter(Waiter* waiter);
+
+  // Drops the results that no lookup would still accept.
+  void PruneLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Mutex mu_;
+  absl::flat_hash_map<std::string, CachedResult> results_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::string, RefCountedPtr<PendingLookup>> pending_
+      ABSL_GUARDED_BY(mu_);
+  // The longest max age any lookup asked for.
+  Duration longest_max_age_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_RESULT_CACHE_H
@@ -16,7 +16,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <inttypes.h>
+#include <string.h>
+
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -31,15 +36,19 @@
 #include "absl/strings/strip.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_result_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/global_config_generic.h"
@@ -47,6 +56,7 @@
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 #include "src/core/lib/resolver/resolver.h"
@@ -64,8 +74,13 @@ namespace grpc_core {
 
 namespace {
 
+using ::grpc_event_engine::experimental::EventEngine;
+
 TraceFlag grpc_trace_dns_resolver(false, "dns_resolver");
 
+using OnAddresses =
+    std::function<void(absl::StatusOr<std::vector<grpc_resolved_address>>)>;
+
 class NativeClientChannelDNSResolver : public PollingResolver {
  public:
   NativeClientChannelDNSResolver(ResolverArgs args,
@@ -85,8 +100,46 @@ class NativeClientChannelDNSResolver : public PollingResolver {
     void Orphan() override { delete this; }
   };
 
+  // A lookup through event_engine_resolver_, which orphaning cancels if it is
+  // still going: its callback then never runs, and on_cancelled does instead.
+  class EventEngineRequest : public Orphanable {
+   public:
+    EventEngineRequest(std::shared_ptr<EventEngine::DNSResolver> resolver,
+                       EventEngine::DNSResolver::LookupTaskHandle handle,
+                       std::function<void()> on_cancelled)
+        : resolver_(std::move(resolver)),
+          handle_(handle),
+          on_cancelled_(std::move(on_cancelled)) {}
+
+    void Orphan() override {
+      if (resolver_->CancelLookup(handle_) && on_cancelled_ != nullptr) {
+        on_cancelled_();
+      }
+      delete this;
+    }
+
+   private:
+    const std::shared_ptr<EventEngine::DNSResolver> resolver_;
+    const EventEngine::DNSResolver::LookupTaskHandle handle_;
+    const std::function<void()> on_cancelled_;
+  };
+
   void OnResolved(
       absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or);
+
+  // Looks up the name through the DnsResultCache.
+  OrphanablePtr<Orphanable> StartCachedRequest();
+  void OnLookupDone(DnsResultCache::LookupResult lookup_result);
+
+  // Looks up the name through event_engine_resolver_, calling on_done in an
+  // ExecCtx.
+  OrphanablePtr<Orphanable> StartEventEngineLookup(
+      OnAddresses on_done, std::function<void()> on_cancelled);
+
+  // Set with the event_engine_dns experiment, for lookups to go through the
+  // EventEngine rather than the iomgr DNS resolver.  Shared with the
+  // lookups' requests, which the DnsResultCache may keep past this resolver.
+  std::shared_ptr<EventEngine::DNSResolver> event_engine_resolver_;
 };
 
 NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
@@ -106,6 +159,14 @@ NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
               .set_max_backoff(Duration::Milliseconds(
                   GRPC_DNS_RECONNECT_MAX_BACKOFF_SECONDS * 1000)),
           &grpc_trace_dns_resolver) {
+  // The Windows EventEngine has no DNSResolver yet.
+#ifndef GPR_WINDOWS
+  if (IsEventEngineDnsEnabled()) {
+    event_engine_resolver_ =
+        grpc_event_engine::experimental::GetDefaultEventEngine()
+            ->GetDNSResolver(EventEngine::DNSResolver::ResolverOptions());
+  }
+#endif
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] created", this);
   }
@@ -118,7 +179,13 @@ NativeClientChannelDNSResolver::~NativeClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartRequest() {
+  if (IsDnsResultCacheEnabled()) return StartCachedRequest();
   Ref(DEBUG_LOCATION, "dns_request").release();
+  if (event_engine_resolver_ != nullptr) {
+    return StartEventEngineLookup(
+        absl::bind_front(&NativeClientChannelDNSResolver::OnResolved, this),
+        [this]() { Unref(DEBUG_LOCATION, "dns_request"); });
+  }
   auto dns_request_handle = GetDNSResolver()->LookupHostname(
       absl::bind_front(&NativeClientChannelDNSResolver::OnResolved, this),
       name_to_resolve(), kDefaultSecurePort, kDefaultDNSRequestTimeout,
@@ -154,6 +221,105 @@ void NativeClientChannelDNSResolver::OnResolved(
   Unref(DEBUG_LOCATION, "dns_request");
 }
 
+OrphanablePtr<Orphanable>
+NativeClientChannelDNSResolver::StartCachedRequest() {
+  auto start_lookup = [this](grpc_pollset_set* interested_parties,
+                             DnsResultCache::OnDone on_done) {
+    OnAddresses on_addresses =
+        [on_done](
+            absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or) {
+          DnsResultCache::LookupResult lookup_result;
+          if (addresses_or.ok()) {
+            ServerAddressList addresses;
+            for (auto& addr : *addresses_or) {
+              addresses.emplace_back(addr, ChannelArgs());
+            }
+            lookup_result.addresses = std::move(addresses);
+          } else {
+            lookup_result.status = addresses_or.status();
+          }
+          on_done(std::move(lookup_result));
+        };
+    if (event_engine_resolver_ != nullptr) {
+      // The cache needs on_done called even when it cancels the lookup.
+      return StartEventEngineLookup(std::move(on_addresses), [on_done]() {
+        DnsResultCache::LookupResult lookup_result;
+        lookup_result.status = absl::CancelledError("DNS lookup cancelled");
+        on_done(std::move(lookup_result));
+      });
+    }
+    auto dns_request_handle = GetDNSResolver()->LookupHostname(
+        std::move(on_addresses), name_to_resolve(), kDefaultSecurePort,
+        kDefaultDNSRequestTimeout, interested_parties, /*name_server=*/"");
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
+      gpr_log(GPR_DEBUG, "[dns_resolver=%p] starting shared request=%p", this,
+              DNSResolver::HandleToString(dns_request_handle).c_str());
+    }
+    return OrphanablePtr<Orphanable>(MakeOrphanable<Request>());
+  };
+  RefCountedPtr<NativeClientChannelDNSResolver> self =
+      Ref(DEBUG_LOCATION, "dns_request");
+  return DnsResultCache::Get()->Lookup(
+      absl::StrCat("native:", name_to_resolve()),
+      min_time_between_resolutions(), interested_parties(), start_lookup,
+      [self = std::move(self)](DnsResultCache::LookupResult lookup_result) {
+        self->OnLookupDone(std::move(lookup_result));
+      });
+}
+
+void NativeClientChannelDNSResolver::OnLookupDone(
+    DnsResultCache::LookupResult lookup_result) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
+    gpr_log(GPR_DEBUG, "[dns_resolver=%p] request complete, status=\"%s\"",
+            this, lookup_result.status.ToString().c_str());
+  }
+  Result result;
+  if (lookup_result.addresses.has_value()) {
+    result.addresses = std::move(*lookup_result.addresses);
+  } else {
+    result.addresses = absl::UnavailableError(
+        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
+                     lookup_result.status.ToString()));
+  }
+  result.args = channel_args();
+  OnRequestComplete(std::move(result));
+}
+
+OrphanablePtr<Orphanable>
+NativeClientChannelDNSResolver::StartEventEngineLookup(
+    OnAddresses on_done, std::function<void()> on_cancelled) {
+  auto handle = event_engine_resolver_->LookupHostname(
+      [on_done = std::move(on_done)](
+          absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>
+              addresses_or) {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        if (!addresses_or.ok()) {
+          on_done(addresses_or.status());
+          return;
+        }
+        std::vector<grpc_resolved_address> addresses;
+        addresses.reserve(addresses_or->size());
+        for (const auto& address : *addresses_or) {
+          grpc_resolved_address addr;
+          memcpy(addr.addr, address.address(), address.size());
+          addr.len = address.size();
+          addresses.push_back(addr);
+        }
+        on_done(std::move(addresses));
+      },
+      name_to_resolve(), kDefaultSecurePort,
+      std::chrono::milliseconds(kDefaultDNSRequestTimeout.millis()));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
+    gpr_log(GPR_DEBUG,
+            "[dns_resolver=%p] starting event engine request={%" PRIdPTR
+            ",%" PRIdPTR "}",
+            this, handle.keys[0], handle.keys[1]);
+  }
+  return MakeOrphanable<EventEngineRequest>(event_engine_resolver_, handle,
+                                            std::move(on_cancelled));
+}
+
 //
 // Factory
 //
@@ -71,6 +71,9 @@ class PollingResolver : public Resolver {
   const std::string& name_to_resolve() const { return name_to_resolve_; }
   grpc_pollset_set* interested_parties() const { return interested_parties_; }
   const ChannelArgs& channel_args() const { return channel_args_; }
+  Duration min_time_between_resolutions() const {
+    return min_time_between_resolutions_;
+  }
 
  private:
   void MaybeStartResolvingLocked();
@@ -29,6 +29,8 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/ext/transport/shm/shm_handshaker.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
@@ -78,7 +80,8 @@ void SockaddrResolver::StartLocked() {
 
 bool ParseUri(const URI& uri,
               bool parse(const URI& uri, grpc_resolved_address* dst),
-              ServerAddressList* addresses) {
+              ServerAddressList* addresses,
+              const ChannelArgs& address_args = ChannelArgs()) {
   if (!uri.authority().empty()) {
     gpr_log(GPR_ERROR, "authority-based URIs not supported by the %s scheme",
             uri.scheme().c_str());
@@ -98,16 +101,17 @@ bool ParseUri(const URI& uri,
       break;
     }
     if (addresses != nullptr) {
-      addresses->emplace_back(addr, ChannelArgs());
+      addresses->emplace_back(addr, address_args);
     }
   }
   return !errors_found;
 }
 
 OrphanablePtr<Resolver> CreateSockaddrResolver(
-    ResolverArgs args, bool parse(const URI& uri, grpc_resolved_address* dst)) {
+    ResolverArgs args, bool parse(const URI& uri, grpc_resolved_address* dst),
+    const ChannelArgs& address_args = ChannelArgs()) {
   ServerAddressList addresses;
-  if (!ParseUri(args.uri, parse, &addresses)) return nullptr;
+  if (!ParseUri(args.uri, parse, &addresses, address_args)) return nullptr;
   // Instantiate resolver.
   return MakeOrphanable<SockaddrResolver>(std::move(addresses),
                                           std::move(args));
@@ -173,6 +177,34 @@ class UnixAbstractResolverFactory : public ResolverFactory {
     return "localhost";
   }
 };
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+// Connects over a unix domain socket, and then moves the connection onto
+// shared memory.
+bool ParseShm(const URI& uri, grpc_resolved_address* dst) {
+  auto unix_uri = URI::Create("unix", "", uri.path(), {}, "");
+  return unix_uri.ok() && grpc_parse_unix(*unix_uri, dst);
+}
+
+class ShmResolverFactory : public ResolverFactory {
+ public:
+  absl::string_view scheme() const override { return "shm"; }
+
+  bool IsValidUri(const URI& uri) const override {
+    return ParseUri(uri, ParseShm, nullptr);
+  }
+
+  OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
+    return CreateSockaddrResolver(
+        std::move(args), ParseShm,
+        ChannelArgs().Set(GRPC_ARG_SHM_TRANSPORT, true));
+  }
+
+  std::string GetDefaultAuthority(const URI& /*uri*/) const override {
+    return "localhost";
+  }
+};
+#endif  // GRPC_HAVE_SHM_ENDPOINT
 #endif  // GRPC_HAVE_UNIX_SOCKET
 
 }  // namespace
@@ -187,6 +219,10 @@ void RegisterSockaddrResolver(CoreConfiguration::Builder* builder) {
       absl::make_unique<UnixResolverFactory>());
   builder->resolver_registry()->RegisterResolverFactory(
       absl::make_unique<UnixAbstractResolverFactory>());
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+  builder->resolver_registry()->RegisterResolverFactory(
+      absl::make_unique<ShmResolverFactory>());
+#endif
 #endif
 }
 
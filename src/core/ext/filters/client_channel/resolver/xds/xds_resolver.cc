@@ -55,6 +55,7 @@
 
 #include "src/core/ext/filters/client_channel/config_selector.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.h"
 #include "src/core/ext/xds/xds_bootstrap.h"
 #include "src/core/ext/xds/xds_bootstrap_grpc.h"
 #include "src/core/ext/xds/xds_client.h"
@@ -100,6 +101,11 @@ UniqueTypeName XdsClusterAttributeTypeName() {
   return kFactory.Create();
 }
 
+UniqueTypeName XdsClusterTokenAttributeTypeName() {
+  static UniqueTypeName::Factory kFactory("xds_cluster_token");
+  return kFactory.Create();
+}
+
 namespace {
 
 std::string GetDefaultAuthorityInternal(const URI& uri) {
@@ -160,12 +166,11 @@ class XdsResolver : public Resolver {
    public:
     explicit ListenerWatcher(RefCountedPtr<XdsResolver> resolver)
         : resolver_(std::move(resolver)) {}
-    void OnResourceChanged(XdsListenerResource listener) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsListenerResource> listener) override {
       Ref().release();  // ref held by lambda
       resolver_->work_serializer_->Run(
-          // TODO(yashykt): When we move to C++14, capture listener with
-          // std::move
-          [this, listener]() mutable {
+          [this, listener = std::move(listener)]() mutable {
             resolver_->OnListenerUpdate(std::move(listener));
             Unref();
           },
@@ -201,12 +206,11 @@ class XdsResolver : public Resolver {
    public:
     explicit RouteConfigWatcher(RefCountedPtr<XdsResolver> resolver)
         : resolver_(std::move(resolver)) {}
-    void OnResourceChanged(XdsRouteConfigResource route_config) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsRouteConfigResource> route_config) override {
       Ref().release();  // ref held by lambda
       resolver_->work_serializer_->Run(
-          // TODO(yashykt): When we move to C++14, capture route_config with
-          // std::move
-          [this, route_config]() mutable {
+          [this, route_config = std::move(route_config)]() mutable {
             resolver_->OnRouteConfigUpdate(std::move(route_config));
             Unref();
           },
@@ -252,7 +256,8 @@ class XdsResolver : public Resolver {
                  const std::string& cluster_name)
         : resolver_(std::move(resolver)),
           it_(resolver_->cluster_state_map_.emplace(cluster_name, WeakRef())
-                  .first) {}
+                  .first),
+          token_(resolver_->AllocateClusterToken()) {}
 
     void Orphan() override {
       auto* resolver = resolver_.release();
@@ -265,10 +270,17 @@ class XdsResolver : public Resolver {
     }
 
     const std::string& cluster() const { return it_->first; }
+    const XdsClusterToken& token() const { return token_; }
+    // The value of the XdsClusterTokenAttributeTypeName() call attribute.
+    absl::string_view token_attribute() const {
+      return absl::string_view(reinterpret_cast<const char*>(&token_),
+                               sizeof(token_));
+    }
 
    private:
     RefCountedPtr<XdsResolver> resolver_;
     ClusterStateMap::iterator it_;
+    const XdsClusterToken token_;
   };
 
   // Call dispatch controller, created for each call handled by the
@@ -350,18 +362,22 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    // Index over route_table_, for picking the route of each call.
+    XdsRouting::RouteIndex route_index_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
 
-  void OnListenerUpdate(XdsListenerResource listener);
-  void OnRouteConfigUpdate(XdsRouteConfigResource rds_update);
+  void OnListenerUpdate(std::shared_ptr<const XdsListenerResource> listener);
+  void OnRouteConfigUpdate(
+      std::shared_ptr<const XdsRouteConfigResource> rds_update);
   void OnError(absl::string_view context, absl::Status status);
   void OnResourceDoesNotExist(std::string context);
 
   absl::StatusOr<RefCountedPtr<ServiceConfig>> CreateServiceConfig();
   void GenerateResult();
   void MaybeRemoveUnusedClusters();
+  XdsClusterToken AllocateClusterToken();
   uint64_t channel_id() const { return channel_id_; }
 
   std::shared_ptr<WorkSerializer> work_serializer_;
@@ -375,19 +391,26 @@ class XdsResolver : public Resolver {
   uint64_t channel_id_;
 
   ListenerWatcher* listener_watcher_ = nullptr;
-  // This will not contain the RouteConfiguration, even if it comes with the
-  // LDS response; instead, the relevant VirtualHost from the
-  // RouteConfiguration will be saved in current_virtual_host_.
-  XdsListenerResource current_listener_;
+  // The listener and route config are shared with the XdsClient.  If the
+  // RouteConfiguration comes with the LDS response, current_route_config_
+  // points into current_listener_.
+  std::shared_ptr<const XdsListenerResource> current_listener_;
 
   std::string route_config_name_;
   RouteConfigWatcher* route_config_watcher_ = nullptr;
-  XdsRouteConfigResource::VirtualHost current_virtual_host_;
+  std::shared_ptr<const XdsRouteConfigResource> current_route_config_;
+  // The relevant VirtualHost from current_route_config_, or null if we
+  // don't have one.
+  const XdsRouteConfigResource::VirtualHost* current_virtual_host_ = nullptr;
   std::map<std::string /*cluster_specifier_plugin_name*/,
            std::string /*LB policy config*/>
       cluster_specifier_plugin_map_;
 
   ClusterState::ClusterStateMap cluster_state_map_;
+  // Slots of removed clusters, for reuse by new ones.
+  std::vector<uint32_t> free_cluster_slots_;
+  uint32_t num_cluster_slots_ = 0;
+  uint64_t next_cluster_id_ = 0;
 };
 
 //
@@ -452,8 +475,8 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
   // weighted_cluster_state field points to the memory in the route field, so
   // moving the entry in a reallocation will cause the string_view to point to
   // invalid data.
-  route_table_.reserve(resolver_->current_virtual_host_.routes.size());
-  for (auto& route : resolver_->current_virtual_host_.routes) {
+  route_table_.reserve(resolver_->current_virtual_host_->routes.size());
+  for (auto& route : resolver_->current_virtual_host_->routes) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
       gpr_log(GPR_INFO, "[xds_resolver %p] XdsConfigSelector %p: route: %s",
               resolver_.get(), this, route.ToString().c_str());
@@ -469,7 +492,7 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       // one.
       if (!route_action->max_stream_duration.has_value()) {
         route_action->max_stream_duration =
-            resolver_->current_listener_.http_connection_manager
+            resolver_->current_listener_->http_connection_manager
                 .http_max_stream_duration;
       }
       Match(
@@ -524,9 +547,10 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       if (!status->ok()) return;
     }
   }
+  route_index_ = XdsRouting::RouteIndex(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
-       resolver_->current_listener_.http_connection_manager.http_filters) {
+       resolver_->current_listener_->http_connection_manager.http_filters) {
     // Find filter.  This is guaranteed to succeed, because it's checked
     // at config validation time in the XdsApi code.
     const XdsHttpFilterImpl* filter_impl =
@@ -603,8 +627,8 @@ XdsResolver::XdsConfigSelector::CreateMethodConfig(
   }
   // Handle xDS HTTP filters.
   auto result = XdsRouting::GeneratePerHTTPFilterConfigs(
-      resolver_->current_listener_.http_connection_manager.http_filters,
-      resolver_->current_virtual_host_, route, cluster_weight,
+      resolver_->current_listener_->http_connection_manager.http_filters,
+      *resolver_->current_virtual_host_, route, cluster_weight,
       resolver_->args_);
   if (!result.ok()) return result.status();
   for (const auto& p : result->per_filter_configs) {
@@ -671,7 +695,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = route_index_.GetRouteForRequest(
       RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
       args.initial_metadata);
   if (!route_index.has_value()) {
@@ -777,6 +801,8 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     call_config.service_config = std::move(method_config);
   }
   call_config.call_attributes[XdsClusterAttributeTypeName()] = it->first;
+  call_config.call_attributes[XdsClusterTokenAttributeTypeName()] =
+      it->second->token_attribute();
   std::string hash_string = absl::StrCat(hash.value());
   char* hash_value =
       static_cast<char*>(args.arena->Alloc(hash_string.size() + 1));
@@ -886,26 +912,27 @@ void XdsResolver::ShutdownLocked() {
   }
 }
 
-void XdsResolver::OnListenerUpdate(XdsListenerResource listener) {
+void XdsResolver::OnListenerUpdate(
+    std::shared_ptr<const XdsListenerResource> listener) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
     gpr_log(GPR_INFO, "[xds_resolver %p] received updated listener data", this);
   }
   if (xds_client_ == nullptr) {
     return;
   }
-  if (listener.http_connection_manager.route_config_name !=
+  if (listener->http_connection_manager.route_config_name !=
       route_config_name_) {
     if (route_config_watcher_ != nullptr) {
       XdsRouteConfigResourceType::CancelWatch(
           xds_client_.get(), route_config_name_, route_config_watcher_,
           /*delay_unsubscription=*/
-          !listener.http_connection_manager.route_config_name.empty());
+          !listener->http_connection_manager.route_config_name.empty());
       route_config_watcher_ = nullptr;
     }
-    route_config_name_ =
-        std::move(listener.http_connection_manager.route_config_name);
+    route_config_name_ = listener->http_connection_manager.route_config_name;
     if (!route_config_name_.empty()) {
-      current_virtual_host_.routes.clear();
+      current_route_config_.reset();
+      current_virtual_host_ = nullptr;
       auto watcher = MakeRefCounted<RouteConfigWatcher>(Ref());
       route_config_watcher_ = watcher.get();
       XdsRouteConfigResourceType::StartWatch(
@@ -915,9 +942,10 @@ void XdsResolver::OnListenerUpdate(XdsListenerResource listener) {
   current_listener_ = std::move(listener);
   if (route_config_name_.empty()) {
     GPR_ASSERT(
-        current_listener_.http_connection_manager.rds_update.has_value());
-    OnRouteConfigUpdate(
-        std::move(*current_listener_.http_connection_manager.rds_update));
+        current_listener_->http_connection_manager.rds_update.has_value());
+    OnRouteConfigUpdate(std::shared_ptr<const XdsRouteConfigResource>(
+        current_listener_,
+        &*current_listener_->http_connection_manager.rds_update));
   } else {
     // HCM may contain newer filter config. We need to propagate the update as
     // config selector to the channel
@@ -944,7 +972,8 @@ class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
 };
 }  // namespace
 
-void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
+void XdsResolver::OnRouteConfigUpdate(
+    std::shared_ptr<const XdsRouteConfigResource> rds_update) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
     gpr_log(GPR_INFO, "[xds_resolver %p] received updated route config", this);
   }
@@ -953,7 +982,7 @@ void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
   }
   // Find the relevant VirtualHost from the RouteConfiguration.
   auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&rds_update.virtual_hosts),
+      VirtualHostListIterator(&rds_update->virtual_hosts),
       data_plane_authority_);
   if (!vhost_index.has_value()) {
     OnError(
@@ -964,9 +993,9 @@ void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
     return;
   }
   // Save the virtual host in the resolver.
-  current_virtual_host_ = std::move(rds_update.virtual_hosts[*vhost_index]);
-  cluster_specifier_plugin_map_ =
-      std::move(rds_update.cluster_specifier_plugin_map);
+  current_virtual_host_ = &rds_update->virtual_hosts[*vhost_index];
+  cluster_specifier_plugin_map_ = rds_update->cluster_specifier_plugin_map;
+  current_route_config_ = std::move(rds_update);
   // Send a new result to the channel.
   GenerateResult();
 }
@@ -996,7 +1025,8 @@ void XdsResolver::OnResourceDoesNotExist(std::string context) {
   if (xds_client_ == nullptr) {
     return;
   }
-  current_virtual_host_.routes.clear();
+  current_route_config_.reset();
+  current_virtual_host_ = nullptr;
   Result result;
   result.addresses.emplace();
   result.service_config = ServiceConfigImpl::Create(args_, "{}");
@@ -1048,7 +1078,10 @@ XdsResolver::CreateServiceConfig() {
 }
 
 void XdsResolver::GenerateResult() {
-  if (current_virtual_host_.routes.empty()) return;
+  if (current_virtual_host_ == nullptr ||
+      current_virtual_host_->routes.empty()) {
+    return;
+  }
   // First create XdsConfigSelector, which may add new entries to the cluster
   // state map, and then CreateServiceConfig for LB policies.
   absl::Status status;
@@ -1071,8 +1104,15 @@ void XdsResolver::GenerateResult() {
   // use with ChannelArgs::SetObject().
   RefCountedPtr<GrpcXdsClient> xds_client =
       xds_client_->Ref(DEBUG_LOCATION, "xds resolver result");
+  std::map<std::string, XdsClusterToken> cluster_tokens;
+  for (const auto& cluster : cluster_state_map_) {
+    cluster_tokens.emplace(cluster.first, cluster.second->token());
+  }
   result.args =
-      args_.SetObject(std::move(xds_client)).SetObject(config_selector);
+      args_.SetObject(std::move(xds_client))
+          .SetObject(config_selector)
+          .SetObject(MakeRefCounted<XdsClusterTokenMap>(
+              std::move(cluster_tokens)));
   result_handler_->ReportResult(std::move(result));
 }
 
@@ -1084,6 +1124,7 @@ void XdsResolver::MaybeRemoveUnusedClusters() {
       ++it;
     } else {
       update_needed = true;
+      free_cluster_slots_.push_back(it->second->token().slot);
       it = cluster_state_map_.erase(it);
     }
   }
@@ -1093,6 +1134,18 @@ void XdsResolver::MaybeRemoveUnusedClusters() {
   }
 }
 
+XdsClusterToken XdsResolver::AllocateClusterToken() {
+  XdsClusterToken token;
+  if (free_cluster_slots_.empty()) {
+    token.slot = num_cluster_slots_++;
+  } else {
+    token.slot = free_cluster_slots_.back();
+    free_cluster_slots_.pop_back();
+  }
+  token.id = next_cluster_id_++;
+  return token;
+}
+
 //
 // Factory
 //
@@ -19,12 +19,59 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
 
 namespace grpc_core {
 
 UniqueTypeName XdsClusterAttributeTypeName();
 
+// Identifies a cluster the xds resolver routes calls to.  The slot is a
+// small number that is reused once no call can be routed to the cluster
+// any more; the id is never reused.
+struct XdsClusterToken {
+  uint32_t slot;
+  uint64_t id;
+};
+
+// Call attribute holding the bytes of the XdsClusterToken of the call's
+// cluster, so that xds_cluster_manager can find the cluster by slot
+// rather than by name.
+UniqueTypeName XdsClusterTokenAttributeTypeName();
+
+// The tokens of the clusters in an xds resolver result, by the child name
+// of the cluster in the xds_cluster_manager config.  Passed to the LB
+// policy in the channel args of the result.
+class XdsClusterTokenMap : public RefCounted<XdsClusterTokenMap> {
+ public:
+  explicit XdsClusterTokenMap(std::map<std::string, XdsClusterToken> tokens)
+      : tokens_(std::move(tokens)) {}
+
+  const std::map<std::string, XdsClusterToken>& tokens() const {
+    return tokens_;
+  }
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.xds_cluster_token_map";
+  }
+  static int ChannelArgsCompare(const XdsClusterTokenMap* a,
+                                const XdsClusterTokenMap* b) {
+    return QsortCompare(a, b);
+  }
+
+ private:
+  std::map<std::string, XdsClusterToken> tokens_;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_XDS_XDS_RESOLVER_H */
@@ -22,10 +22,13 @@
 #include <limits.h>
 #include <stddef.h>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
@@ -114,9 +117,12 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
+//
+// With a hedging policy, we instead start a new call attempt every
+// hedgingDelay while the earlier ones are still in flight, up to
+// maxAttempts.  Every attempt in flight is given the same batches, built
+// from the same cached send ops.  The first attempt to get a response or
+// a fatal status is committed to, and the others are cancelled.
 
 // By default, we buffer 256 KiB per RPC for retries.
 // TODO(roth): Do we have any data to suggest a better value?
@@ -212,12 +218,35 @@ class RetryFilter {
   const RetryMethodConfig* GetRetryPolicy(
       const grpc_call_context_element* context);
 
+  // Returns true if a call with retry_policy is expected to go over the
+  // retry buffer, so that it should be committed before it starts.
+  bool PredictOversizedCall(const RetryMethodConfig* retry_policy);
+  // Records whether a call with retry_policy went over the retry buffer.
+  void RecordCallSize(const RetryMethodConfig* retry_policy, bool oversized);
+
   ClientChannel* client_channel_;
   size_t per_rpc_retry_buffer_size_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
   const size_t service_config_parser_index_;
+
+  // Methods whose calls recently went over the retry buffer, keyed by
+  // their retry policy, which is unique to the method in this filter's
+  // service config.  Later calls to such a method are committed up
+  // front, skipping the buffering altogether, except for one call in
+  // every kOversizedProbeInterval, which checks whether the method's
+  // calls still go over.
+  static constexpr size_t kNumOversizedSlots = 32;
+  static constexpr uint32_t kOversizedProbeInterval = 16;
+  struct OversizedSlot {
+    std::atomic<const RetryMethodConfig*> retry_policy{nullptr};
+    std::atomic<uint32_t> num_calls{0};
+  };
+  OversizedSlot oversized_slots_[kNumOversizedSlots];
 };
 
+constexpr size_t RetryFilter::kNumOversizedSlots;
+constexpr uint32_t RetryFilter::kOversizedProbeInterval;
+
 //
 // RetryFilter::CallData
 //
@@ -251,11 +280,15 @@ class RetryFilter::CallData {
     ~CallAttempt() override;
 
     bool lb_call_committed() const { return lb_call_committed_; }
+    bool abandoned() const { return abandoned_; }
 
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -263,6 +296,9 @@ class RetryFilter::CallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Cancels and abandons a hedged attempt that lost to the one committed.
+    void CancelHedgedAttempt(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -421,9 +457,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -451,6 +484,8 @@ class RetryFilter::CallData {
     AttemptDispatchController attempt_dispatch_controller_;
     OrphanablePtr<ClientChannel::LoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
+    // When hedging, the value of the grpc-previous-rpc-attempts header.
+    int num_previous_hedged_attempts_ = 0;
 
     grpc_timer per_attempt_recv_timer_;
     grpc_closure on_per_attempt_recv_timer_;
@@ -562,6 +597,22 @@ class RetryFilter::CallData {
 
   void CreateCallAttempt(bool is_transparent_retry);
 
+  // Starts the timer for the next hedged attempt, if there is one.
+  void MaybeStartHedgingTimer();
+  static void OnHedgingTimer(void* arg, grpc_error_handle error);
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle error);
+
+  // Drops a hedged attempt that failed with a non-fatal status.  If no
+  // other attempt is in flight, starts the next one.
+  void OnHedgedAttemptFailed(CallAttempt* call_attempt,
+                             bool is_transparent_retry,
+                             absl::optional<Duration> server_pushback,
+                             CallCombinerClosureList* closures);
+
+  // Cancels all hedged attempts other than call_attempt, which becomes
+  // call_attempt_.
+  void CancelLosingHedgedAttempts(CallAttempt* call_attempt);
+
   RetryFilter* chand_;
   grpc_polling_entity* pollent_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
@@ -579,10 +630,12 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
+  // The attempt that new batches from the surface are started on.
   RefCountedPtr<CallAttempt> call_attempt_;
+  // When hedging, the earlier attempts that are still in flight.  These
+  // are also given every new batch from the surface.  If this is
+  // non-empty, call_attempt_ is non-null.
+  std::vector<RefCountedPtr<CallAttempt>> hedged_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -605,10 +658,25 @@ class RetryFilter::CallData {
   bool retry_timer_pending_ : 1;
   bool retry_codepath_started_ : 1;
   bool sent_transparent_retry_not_seen_by_server_ : 1;
+  // Set if the call was committed before it started because it was
+  // expected to go over the retry buffer.
+  bool committed_as_oversized_ : 1;
   int num_attempts_completed_ = 0;
   grpc_timer retry_timer_;
   grpc_closure retry_closure_;
 
+  // Hedging state.
+  bool hedging_ : 1;
+  bool hedging_timer_pending_ : 1;
+  // Set when a hedged attempt is cancelled while still in flight.  It may
+  // still be using the cached send op data, so that data is then kept
+  // until the call is destroyed instead of being freed after commit.
+  bool keep_cached_send_ops_ : 1;
+  // Attempts started, not counting transparent retries.
+  int num_attempts_started_ = 0;
+  grpc_timer hedging_timer_;
+  grpc_closure hedging_closure_;
+
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
@@ -714,6 +782,9 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
       sent_cancel_stream_(false),
       seen_recv_trailing_metadata_from_surface_(false),
       abandoned_(false) {
+  if (calld->hedging_) {
+    num_previous_hedged_attempts_ = calld->num_attempts_started_ - 1;
+  }
   lb_call_ = calld->CreateLoadBalancedCall(&attempt_dispatch_controller_,
                                            is_transparent_retry);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -752,10 +823,8 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Cancelled hedged attempts may still be using this data.
+  if (calld_->keep_cached_send_ops_) return;
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -796,11 +865,9 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
+  // Only the attempt we've committed to can switch.
+  if (abandoned_) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -1071,6 +1138,12 @@ void RetryFilter::CallData::CallAttempt::AddBatchesForPendingBatches(
     }
     // recv_message.
     if (batch->recv_message) {
+      // Pass on whether the message may be received in parts.
+      recv_message_flags_ = 0;
+      if (batch->payload->recv_message.flags != nullptr) {
+        recv_message_flags_ = *batch->payload->recv_message.flags &
+                              GRPC_RECV_INTERNAL_ACCEPT_PARTIAL;
+      }
       batch_data->AddRetriableRecvMessageOp();
     }
     // recv_trailing_metadata.
@@ -1123,6 +1196,22 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling losing hedged attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "another hedged attempt was committed"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+      closures);
+  Abandon();
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
@@ -1159,8 +1248,11 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   // things like failures due to malformed requests (INVALID_ARGUMENT).
   // Conversely, it's important for this to come before the remaining
   // checks, so that we don't fail to record failures due to other factors.
+  // When hedging, throttling only keeps new attempts from being started,
+  // so the call may still go on with the other attempts in flight.
   if (calld_->retry_throttle_data_ != nullptr &&
-      !calld_->retry_throttle_data_->RecordFailure()) {
+      !calld_->retry_throttle_data_->RecordFailure() &&
+      (!calld_->hedging_ || calld_->hedged_attempts_.empty())) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
       gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: retries throttled",
               calld_->chand_, calld_, this);
@@ -1360,10 +1452,8 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Cancelled hedged attempts may still be using this data.
+  if (calld->keep_cached_send_ops_) return;
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1787,7 +1877,11 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
       // For transparent retries, add a closure to immediately start a new
       // call attempt.
       // For configurable retries, start retry timer.
-      if (retry == kTransparentRetry) {
+      // When hedging, the call may instead go on with the other attempts.
+      if (calld->hedging_) {
+        calld->OnHedgedAttemptFailed(call_attempt, retry == kTransparentRetry,
+                                     server_pushback, &closures);
+      } else if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
       } else {
         calld->StartRetryTimer(server_pushback);
@@ -1976,11 +2070,15 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   // want those modifications to be passed forward to subsequent attempts.
   //
   // If we've already completed one or more attempts, add the
-  // grpc-retry-attempts header.
+  // grpc-retry-attempts header.  Hedged attempts overlap, so for those it
+  // counts the attempts started before this one.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
+  const int num_previous_attempts =
+      calld->hedging_ ? call_attempt_->num_previous_hedged_attempts_
+                      : calld->num_attempts_completed_;
+  if (GPR_UNLIKELY(num_previous_attempts > 0)) {
     call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+                                              num_previous_attempts);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -2134,6 +2232,36 @@ const RetryMethodConfig* RetryFilter::GetRetryPolicy(
       svc_cfg_call_data->GetMethodParsedConfig(service_config_parser_index_));
 }
 
+bool RetryFilter::PredictOversizedCall(const RetryMethodConfig* retry_policy) {
+  OversizedSlot& slot =
+      oversized_slots_[std::hash<const RetryMethodConfig*>()(retry_policy) %
+                       kNumOversizedSlots];
+  if (slot.retry_policy.load(std::memory_order_relaxed) != retry_policy) {
+    return false;
+  }
+  return slot.num_calls.fetch_add(1, std::memory_order_relaxed) %
+             kOversizedProbeInterval !=
+         0;
+}
+
+void RetryFilter::RecordCallSize(const RetryMethodConfig* retry_policy,
+                                 bool oversized) {
+  OversizedSlot& slot =
+      oversized_slots_[std::hash<const RetryMethodConfig*>()(retry_policy) %
+                       kNumOversizedSlots];
+  if (oversized) {
+    if (slot.retry_policy.load(std::memory_order_relaxed) == retry_policy) {
+      return;
+    }
+    // The next call is not a probe.
+    slot.num_calls.store(1, std::memory_order_relaxed);
+    slot.retry_policy.store(retry_policy, std::memory_order_relaxed);
+  } else {
+    slot.retry_policy.compare_exchange_strong(retry_policy, nullptr,
+                                              std::memory_order_relaxed);
+  }
+}
+
 RetryFilter::CallData::CallData(RetryFilter* chand,
                                 const grpc_call_element_args& args)
     : chand_(chand),
@@ -2165,9 +2293,30 @@ RetryFilter::CallData::CallData(RetryFilter* chand,
       retry_committed_(false),
       retry_timer_pending_(false),
       retry_codepath_started_(false),
-      sent_transparent_retry_not_seen_by_server_(false) {}
+      sent_transparent_retry_not_seen_by_server_(false),
+      hedging_(retry_policy_ != nullptr &&
+               retry_policy_->hedging_delay().has_value()),
+      hedging_timer_pending_(false),
+      keep_cached_send_ops_(false) {
+  committed_as_oversized_ =
+      retry_policy_ != nullptr && chand->PredictOversizedCall(retry_policy_);
+  if (committed_as_oversized_) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: method expected to exceed retry buffer "
+              "size, committing",
+              chand, this);
+    }
+    retry_committed_ = true;
+  }
+}
 
 RetryFilter::CallData::~CallData() {
+  if (retry_policy_ != nullptr && !committed_as_oversized_) {
+    chand_->RecordCallSize(
+        retry_policy_,
+        bytes_buffered_for_retry_ > chand_->per_rpc_retry_buffer_size_);
+  }
   FreeAllCachedSendOpData();
   grpc_slice_unref(path_);
   // Make sure there are no remaining pending batches.
@@ -2210,14 +2359,10 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
+    // When hedging, committing also cancels all the other attempts, so
+    // only the attempt we commit to is given the cancellation batch.
     if (call_attempt_ != nullptr) {
       RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
       // Note: This will release the call combiner.
       call_attempt_->CancelFromSurface(batch);
       return;
@@ -2232,6 +2377,11 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
       grpc_timer_cancel(&retry_timer_);
       FreeAllCachedSendOpData();
     }
+    // Cancel hedging timer if needed.
+    if (hedging_timer_pending_) {
+      hedging_timer_pending_ = false;  // Lame timer callback.
+      grpc_timer_cancel(&hedging_timer_);
+    }
     // We have no call attempt, so there's nowhere to send the cancellation
     // batch.  Return it back to the surface immediately.
     // Note: This will release the call combiner.
@@ -2300,6 +2450,19 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
             this, call_attempt_.get());
   }
+  // When hedging, every attempt in flight gets the batch.  Cache its send
+  // ops up front, since any of the attempts may complete it.
+  if (!hedged_attempts_.empty()) {
+    MaybeCacheSendOpsForBatch(pending);
+    CallCombinerClosureList closures;
+    for (auto& hedged_attempt : hedged_attempts_) {
+      hedged_attempt->AddRetriableBatches(&closures);
+    }
+    call_attempt_->AddRetriableBatches(&closures);
+    // Note: This will yield the call combiner.
+    closures.RunClosures(call_combiner_);
+    return;
+  }
   call_attempt_->StartRetriableBatches();
 }
 
@@ -2319,7 +2482,13 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 }
 
 void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
+  // When hedging, the current attempt keeps going alongside the new one.
+  if (hedging_ && call_attempt_ != nullptr && !call_attempt_->abandoned()) {
+    hedged_attempts_.push_back(std::move(call_attempt_));
+  }
+  if (!is_transparent_retry) ++num_attempts_started_;
   call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  MaybeStartHedgingTimer();
   call_attempt_->StartRetriableBatches();
 }
 
@@ -2438,9 +2607,9 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
+  // TODO(roth): When hedging, we commit to the latest attempt here, but
+  // it would be better to pick the one on which the max number of send
+  // ops have already been sent.
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size_)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2555,6 +2724,12 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
+  // No more hedged attempts are needed.
+  if (hedging_timer_pending_) {
+    hedging_timer_pending_ = false;  // Lame timer callback.
+    grpc_timer_cancel(&hedging_timer_);
+  }
+  if (!hedged_attempts_.empty()) CancelLosingHedgedAttempts(call_attempt);
   if (call_attempt != nullptr) {
     // If the call attempt's LB call has been committed, inform the call
     // dispatch controller that the call has been committed.
@@ -2617,6 +2792,114 @@ void RetryFilter::CallData::OnRetryTimerLocked(void* arg,
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
+void RetryFilter::CallData::MaybeStartHedgingTimer() {
+  if (!hedging_ || hedging_timer_pending_ || retry_committed_) return;
+  if (num_attempts_started_ >= retry_policy_->max_attempts()) return;
+  const Duration hedging_delay = *retry_policy_->hedging_delay();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting hedged attempt %d in %" PRId64 " ms",
+            chand_, this, num_attempts_started_ + 1, hedging_delay.millis());
+  }
+  GRPC_CLOSURE_INIT(&hedging_closure_, OnHedgingTimer, this, nullptr);
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  hedging_timer_pending_ = true;
+  grpc_timer_init(&hedging_timer_, Timestamp::Now() + hedging_delay,
+                  &hedging_closure_);
+}
+
+void RetryFilter::CallData::OnHedgingTimer(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  GRPC_CLOSURE_INIT(&calld->hedging_closure_, OnHedgingTimerLocked, calld,
+                    nullptr);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->hedging_closure_,
+                           error, "hedging timer fired");
+}
+
+void RetryFilter::CallData::OnHedgingTimerLocked(void* arg,
+                                                 grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error.ok() && calld->hedging_timer_pending_) {
+    calld->hedging_timer_pending_ = false;
+    // If no attempt is in flight, a retry timer or transparent retry is
+    // going to start the next one.
+    if (!calld->retry_committed_ && calld->cancelled_from_surface_.ok() &&
+        calld->call_attempt_ != nullptr &&
+        !calld->call_attempt_->abandoned()) {
+      if (calld->retry_throttle_data_ == nullptr ||
+          calld->retry_throttle_data_->RetriesAllowed()) {
+        calld->CreateCallAttempt(/*is_transparent_retry=*/false);
+        GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+        return;
+      }
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p: hedging throttled",
+                calld->chand_, calld);
+      }
+    }
+  }
+  GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "hedging timer not used");
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
+void RetryFilter::CallData::OnHedgedAttemptFailed(
+    CallAttempt* call_attempt, bool is_transparent_retry,
+    absl::optional<Duration> server_pushback,
+    CallCombinerClosureList* closures) {
+  // If nothing else is in flight, this is just like a retry, except that
+  // the next attempt goes out right away unless the server pushed back.
+  if (hedged_attempts_.empty()) {
+    if (is_transparent_retry) {
+      AddClosureToStartTransparentRetry(closures);
+    } else {
+      StartRetryTimer(server_pushback.value_or(Duration::Zero()));
+    }
+    return;
+  }
+  // Otherwise, drop this attempt and let the others go on.  The hedging
+  // timer will start the next attempt, if there is one.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: hedged attempt failed; %" PRIuPTR
+            " other attempts still in flight",
+            chand_, this, call_attempt, hedged_attempts_.size());
+  }
+  if (call_attempt_.get() == call_attempt) {
+    call_attempt_ = std::move(hedged_attempts_.back());
+    hedged_attempts_.pop_back();
+    return;
+  }
+  for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end();
+       ++it) {
+    if (it->get() == call_attempt) {
+      hedged_attempts_.erase(it);
+      return;
+    }
+  }
+}
+
+void RetryFilter::CallData::CancelLosingHedgedAttempts(
+    CallAttempt* call_attempt) {
+  // Make the attempt we're committing to the current one.
+  if (call_attempt != nullptr && call_attempt != call_attempt_.get()) {
+    for (auto& hedged_attempt : hedged_attempts_) {
+      if (hedged_attempt.get() == call_attempt) {
+        std::swap(hedged_attempt, call_attempt_);
+        break;
+      }
+    }
+  }
+  CallCombinerClosureList closures;
+  for (auto& hedged_attempt : hedged_attempts_) {
+    if (!hedged_attempt->abandoned()) {
+      hedged_attempt->CancelHedgedAttempt(&closures);
+      keep_cached_send_ops_ = true;
+    }
+  }
+  hedged_attempts_.clear();
+  closures.RunClosuresWithoutYielding(call_combiner_);
+}
+
 void RetryFilter::CallData::AddClosureToStartTransparentRetry(
     CallCombinerClosureList* closures) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -65,6 +65,16 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
         retryable_status_codes_(retryable_status_codes),
         per_attempt_recv_timeout_(per_attempt_recv_timeout) {}
 
+  // Constructs the config for a hedgingPolicy.  The nonFatalStatusCodes are
+  // kept as the retryable status codes, since a hedged attempt failing with
+  // one of them lets the call go on to the other attempts just as a
+  // retryable failure does.
+  RetryMethodConfig(int max_attempts, Duration hedging_delay,
+                    StatusCodeSet non_fatal_status_codes)
+      : max_attempts_(max_attempts),
+        retryable_status_codes_(non_fatal_status_codes),
+        hedging_delay_(hedging_delay) {}
+
   int max_attempts() const { return max_attempts_; }
   Duration initial_backoff() const { return initial_backoff_; }
   Duration max_backoff() const { return max_backoff_; }
@@ -75,6 +85,8 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   absl::optional<Duration> per_attempt_recv_timeout() const {
     return per_attempt_recv_timeout_;
   }
+  // Set only for a hedgingPolicy.
+  absl::optional<Duration> hedging_delay() const { return hedging_delay_; }
 
  private:
   int max_attempts_ = 0;
@@ -83,6 +95,7 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  absl::optional<Duration> hedging_delay_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -50,6 +50,10 @@ class ServerRetryThrottleData : public RefCounted<ServerRetryThrottleData> {
   /// Records a success.
   void RecordSuccess();
 
+  /// Returns true if it's okay to send a retry or a hedged attempt,
+  /// without recording anything.
+  bool RetriesAllowed();
+
   intptr_t max_milli_tokens() const { return max_milli_tokens_; }
   intptr_t milli_token_ratio() const { return milli_token_ratio_; }
 
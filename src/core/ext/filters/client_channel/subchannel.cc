@@ -93,11 +93,7 @@ DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
 ConnectedSubchannel::ConnectedSubchannel(
     grpc_channel_stack* channel_stack, const ChannelArgs& args,
     RefCountedPtr<channelz::SubchannelNode> channelz_subchannel)
-    : RefCounted<ConnectedSubchannel>(
-          GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)
-              ? "ConnectedSubchannel"
-              : nullptr),
-      channel_stack_(channel_stack),
+    : channel_stack_(channel_stack),
       args_(args),
       channelz_subchannel_(std::move(channelz_subchannel)) {}
 
@@ -147,6 +143,7 @@ RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
 SubchannelCall::SubchannelCall(Args args, grpc_error_handle* error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  connected_subchannel_->active_calls_.fetch_add(1, std::memory_order_relaxed);
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,             /* call_stack */
@@ -216,6 +213,7 @@ void SubchannelCall::Destroy(void* arg, grpc_error_handle /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  connected_subchannel->active_calls_.fetch_sub(1, std::memory_order_relaxed);
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -298,8 +296,9 @@ class Subchannel::ConnectedSubchannelStateWatcher
     : public AsyncConnectivityStateWatcherInterface {
  public:
   // Must be instantiated while holding c->mu.
-  explicit ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c)
-      : subchannel_(std::move(c)) {}
+  ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c,
+                                  uint64_t connection_id)
+      : subchannel_(std::move(c)), connection_id_(connection_id) {}
 
   ~ConnectedSubchannelStateWatcher() override {
     subchannel_.reset(DEBUG_LOCATION, "state_watcher");
@@ -311,36 +310,60 @@ class Subchannel::ConnectedSubchannelStateWatcher
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
     // If we're either shutting down or have already seen this connection
-    // failure (i.e., c->connected_subchannel_ is null), do nothing.
+    // failure (i.e., c->connected_subchannel_ is null or is a different
+    // connection), do nothing.
     //
     // The transport reports TRANSIENT_FAILURE upon GOAWAY but SHUTDOWN
     // upon connection close.  So if the server gracefully shuts down,
     // we will see TRANSIENT_FAILURE followed by SHUTDOWN, but if not, we
     // will see only SHUTDOWN.  Either way, we react to the first one we
     // see, ignoring anything that happens after that.
-    if (c->connected_subchannel_ == nullptr) return;
-    if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
-        new_state == GRPC_CHANNEL_SHUTDOWN) {
+    if (new_state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+        new_state != GRPC_CHANNEL_SHUTDOWN) {
+      return;
+    }
+    // A pooled connection that fails just leaves the pool.
+    if (c->RemovePooledConnectionLocked(connection_id_)) return;
+    if (c->connected_subchannel_ == nullptr ||
+        c->connected_subchannel_id_ != connection_id_) {
+      return;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO,
+              "subchannel %p %s: Connected subchannel %p reports %s: %s", c,
+              c->key_.ToString().c_str(), c->connected_subchannel_.get(),
+              ConnectivityStateName(new_state), status.ToString().c_str());
+    }
+    c->connected_subchannel_.reset();
+    // If another connection is up, switch to it and stay READY.
+    if (!c->pooled_connections_.empty()) {
+      c->connected_subchannel_ =
+          std::move(c->pooled_connections_.back().connected_subchannel);
+      c->connected_subchannel_id_ = c->pooled_connections_.back().id;
+      c->pooled_connections_.pop_back();
       if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
         gpr_log(GPR_INFO,
-                "subchannel %p %s: Connected subchannel %p reports %s: %s", c,
-                c->key_.ToString().c_str(), c->connected_subchannel_.get(),
-                ConnectivityStateName(new_state), status.ToString().c_str());
+                "subchannel %p %s: switching to pooled connected "
+                "subchannel %p",
+                c, c->key_.ToString().c_str(),
+                c->connected_subchannel_.get());
       }
-      c->connected_subchannel_.reset();
-      if (c->channelz_node() != nullptr) {
-        c->channelz_node()->SetChildSocket(nullptr);
-      }
-      // Even though we're reporting IDLE instead of TRANSIENT_FAILURE here,
-      // pass along the status from the transport, since it may have
-      // keepalive info attached to it that the channel needs.
-      // TODO(roth): Consider whether there's a cleaner way to do this.
-      c->SetConnectivityStateLocked(GRPC_CHANNEL_IDLE, status);
-      c->backoff_.Reset();
+      c->health_watcher_map_.OnConnectedSubchannelChangedLocked();
+      return;
+    }
+    if (c->channelz_node() != nullptr) {
+      c->channelz_node()->SetChildSocket(nullptr);
     }
+    // Even though we're reporting IDLE instead of TRANSIENT_FAILURE here,
+    // pass along the status from the transport, since it may have
+    // keepalive info attached to it that the channel needs.
+    // TODO(roth): Consider whether there's a cleaner way to do this.
+    c->SetConnectivityStateLocked(GRPC_CHANNEL_IDLE, status);
+    c->backoff_.Reset();
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
+  const uint64_t connection_id_;
 };
 
 // Asynchronously notifies the \a watcher of a change in the connectvity state
@@ -457,6 +480,14 @@ class Subchannel::HealthWatcherMap::HealthWatcher
     }
   }
 
+  // Moves health checking to the subchannel's new connected subchannel.
+  void RestartHealthCheckingLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(subchannel_->mu_) {
+    if (health_check_client_ == nullptr) return;
+    health_check_client_.reset();
+    StartHealthCheckingLocked();
+  }
+
   void Orphan() override {
     watcher_list_.Clear();
     health_check_client_.reset();
@@ -477,14 +508,25 @@ class Subchannel::HealthWatcherMap::HealthWatcher
   void StartHealthCheckingLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(subchannel_->mu_) {
     GPR_ASSERT(health_check_client_ == nullptr);
+    if (subchannel_->args_.GetBool(GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS)
+            .value_or(false)) {
+      auto address = grpc_sockaddr_to_uri(&subchannel_->key_.address());
+      if (address.ok()) {
+        health_check_client_ = MakeSharedHealthCheckClient(
+            std::move(*address), health_check_service_name_,
+            subchannel_->connected_subchannel_->Ref(),
+            subchannel_->pollset_set_, subchannel_->channelz_node_, Ref());
+        return;
+      }
+    }
     health_check_client_ = MakeHealthCheckClient(
-        health_check_service_name_, subchannel_->connected_subchannel_,
+        health_check_service_name_, subchannel_->connected_subchannel_->Ref(),
         subchannel_->pollset_set_, subchannel_->channelz_node_, Ref());
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
   std::string health_check_service_name_;
-  OrphanablePtr<SubchannelStreamClient> health_check_client_;
+  OrphanablePtr<Orphanable> health_check_client_;
   grpc_connectivity_state state_;
   absl::Status status_;
   ConnectivityStateWatcherList watcher_list_;
@@ -532,6 +574,12 @@ void Subchannel::HealthWatcherMap::NotifyLocked(grpc_connectivity_state state,
   }
 }
 
+void Subchannel::HealthWatcherMap::OnConnectedSubchannelChangedLocked() {
+  for (const auto& p : map_) {
+    p.second->RestartHealthCheckingLocked();
+  }
+}
+
 grpc_connectivity_state
 Subchannel::HealthWatcherMap::CheckConnectivityStateLocked(
     Subchannel* subchannel, const std::string& health_check_service_name) {
@@ -623,6 +671,7 @@ Subchannel::Subchannel(SubchannelKey key,
       key_(std::move(key)),
       args_(args),
       pollset_set_(grpc_pollset_set_create()),
+      transport_rtt_observer_(MakeRefCounted<TransportRttObserver>()),
       connector_(std::move(connector)),
       backoff_(ParseArgsForBackoffValues(args_, &min_connect_timeout_)) {
   // A grpc_init is added here to ensure that grpc_shutdown does not happen
@@ -643,6 +692,14 @@ Subchannel::Subchannel(SubchannelKey key,
                              .proxy_mapper_registry()
                              .MapAddress(key_.address(), &args_)
                              .value_or(key_.address());
+  max_connections_ = Clamp(
+      args_.GetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS).value_or(1), 1, 64);
+  streams_per_connection_ = Clamp(
+      args_.GetInt(GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION).value_or(100), 1,
+      INT_MAX);
+  // Added after the key is computed, so that it does not keep subchannels
+  // from being shared.
+  args_ = args_.SetObject(transport_rtt_observer_);
   // Initialize channelz.
   const bool channelz_enabled = args_.GetBool(GRPC_ARG_ENABLE_CHANNELZ)
                                     .value_or(GRPC_ENABLE_CHANNELZ_DEFAULT);
@@ -746,6 +803,22 @@ void Subchannel::CancelConnectivityStateWatch(
   }
 }
 
+RefCountedPtr<ConnectedSubchannel> Subchannel::connected_subchannel() {
+  MutexLock lock(&mu_);
+  if (connected_subchannel_ == nullptr) return nullptr;
+  if (max_connections_ == 1) return connected_subchannel_->Ref();
+  ConnectedSubchannel* best = connected_subchannel_.get();
+  for (const PooledConnection& pooled : pooled_connections_) {
+    if (pooled.connected_subchannel->active_calls() < best->active_calls()) {
+      best = pooled.connected_subchannel.get();
+    }
+  }
+  if (best->active_calls() >= streams_per_connection_) {
+    MaybeStartPooledConnectionLocked();
+  }
+  return best->Ref();
+}
+
 void Subchannel::RequestConnection() {
   MutexLock lock(&mu_);
   if (state_ == GRPC_CHANNEL_IDLE) {
@@ -760,6 +833,7 @@ void Subchannel::ResetBackoff() {
   auto self = WeakRef(DEBUG_LOCATION, "ResetBackoff");
   MutexLock lock(&mu_);
   backoff_.Reset();
+  next_pooled_attempt_time_ = Timestamp();
   if (state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
       GetDefaultEventEngine()->Cancel(retry_timer_handle_)) {
     OnRetryTimerLocked();
@@ -780,6 +854,7 @@ void Subchannel::Orphan() {
   shutdown_ = true;
   connector_.reset();
   connected_subchannel_.reset();
+  pooled_connections_.clear();
   health_watcher_map_.ShutdownLocked();
 }
 
@@ -872,6 +947,12 @@ void Subchannel::StartConnectingLocked() {
   next_attempt_time_ = backoff_.NextAttemptTime();
   // Report CONNECTING.
   SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+  // If the connector is still busy with an attempt for pooled_connections_,
+  // let that attempt stand in for this one.
+  if (pooled_connecting_) {
+    pooled_connecting_ = false;
+    return;
+  }
   // Start connection attempt.
   SubchannelConnector::Args args;
   args.address = &address_for_connect_;
@@ -895,6 +976,11 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
   if (shutdown_) {
     return;
   }
+  if (pooled_connecting_) {
+    pooled_connecting_ = false;
+    OnPooledConnectingFinishedLocked(error);
+    return;
+  }
   // If we didn't get a transport or we fail to publish it, report
   // TRANSIENT_FAILURE and start the retry timer.
   // Note that if the connection attempt took longer than the backoff
@@ -929,13 +1015,14 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
   }
 }
 
-bool Subchannel::PublishTransportLocked() {
+OrphanablePtr<ConnectedSubchannel> Subchannel::CreateConnectedSubchannelLocked(
+    RefCountedPtr<channelz::SocketNode>* socket) {
   // Construct channel stack.
   ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
   builder.SetChannelArgs(connecting_result_.channel_args)
       .SetTransport(connecting_result_.transport);
   if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
-    return false;
+    return nullptr;
   }
   absl::StatusOr<RefCountedPtr<grpc_channel_stack>> stk = builder.Build();
   if (!stk.ok()) {
@@ -944,15 +1031,23 @@ bool Subchannel::PublishTransportLocked() {
     gpr_log(GPR_ERROR,
             "subchannel %p %s: error initializing subchannel stack: %s", this,
             key_.ToString().c_str(), grpc_error_std_string(error).c_str());
-    return false;
+    return nullptr;
   }
-  RefCountedPtr<channelz::SocketNode> socket =
-      std::move(connecting_result_.socket_node);
+  *socket = std::move(connecting_result_.socket_node);
   connecting_result_.Reset();
-  if (shutdown_) return false;
+  if (shutdown_) return nullptr;
+  return MakeOrphanable<ConnectedSubchannel>(stk->release(), args_,
+                                             channelz_node_);
+}
+
+bool Subchannel::PublishTransportLocked() {
+  RefCountedPtr<channelz::SocketNode> socket;
+  OrphanablePtr<ConnectedSubchannel> connected_subchannel =
+      CreateConnectedSubchannelLocked(&socket);
+  if (connected_subchannel == nullptr) return false;
   // Publish.
-  connected_subchannel_.reset(
-      new ConnectedSubchannel(stk->release(), args_, channelz_node_));
+  connected_subchannel_ = std::move(connected_subchannel);
+  connected_subchannel_id_ = next_connection_id_++;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
     gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
             key_.ToString().c_str(), connected_subchannel_.get());
@@ -963,10 +1058,85 @@ bool Subchannel::PublishTransportLocked() {
   // Start watching connected subchannel.
   connected_subchannel_->StartWatch(
       pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
+                        WeakRef(DEBUG_LOCATION, "state_watcher"),
+                        connected_subchannel_id_));
   // Report initial state.
   SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
   return true;
 }
 
+void Subchannel::MaybeStartPooledConnectionLocked() {
+  if (shutdown_ || pooled_connecting_ || state_ != GRPC_CHANNEL_READY ||
+      pooled_connections_.size() + 1 >= max_connections_ ||
+      Timestamp::Now() < next_pooled_attempt_time_) {
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: all %" PRIuPTR
+            " connections full, starting another",
+            this, key_.ToString().c_str(), pooled_connections_.size() + 1);
+  }
+  pooled_connecting_ = true;
+  SubchannelConnector::Args args;
+  args.address = &address_for_connect_;
+  args.interested_parties = pollset_set_;
+  args.deadline = Timestamp::Now() + min_connect_timeout_;
+  args.channel_args = args_;
+  WeakRef(DEBUG_LOCATION, "Connect").release();  // Ref held by callback.
+  connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+}
+
+void Subchannel::OnPooledConnectingFinishedLocked(grpc_error_handle error) {
+  RefCountedPtr<channelz::SocketNode> socket;
+  OrphanablePtr<ConnectedSubchannel> connected_subchannel;
+  if (connecting_result_.transport != nullptr) {
+    connected_subchannel = CreateConnectedSubchannelLocked(&socket);
+  }
+  if (connected_subchannel == nullptr) {
+    gpr_log(GPR_INFO, "subchannel %p %s: pooled connect failed (%s)", this,
+            key_.ToString().c_str(), grpc_error_std_string(error).c_str());
+    next_pooled_attempt_time_ = Timestamp::Now() + min_connect_timeout_;
+    return;
+  }
+  const uint64_t connection_id = next_connection_id_++;
+  connected_subchannel->StartWatch(
+      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
+                        WeakRef(DEBUG_LOCATION, "state_watcher"),
+                        connection_id));
+  // If the subchannel lost its connection while this attempt was in
+  // flight, use the new one as the primary connection.
+  if (connected_subchannel_ == nullptr) {
+    connected_subchannel_ = std::move(connected_subchannel);
+    connected_subchannel_id_ = connection_id;
+    if (channelz_node_ != nullptr) {
+      channelz_node_->SetChildSocket(std::move(socket));
+    }
+    SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO, "subchannel %p %s: new pooled connected subchannel at %p",
+            this, key_.ToString().c_str(), connected_subchannel.get());
+  }
+  pooled_connections_.push_back(
+      {connection_id, std::move(connected_subchannel)});
+}
+
+bool Subchannel::RemovePooledConnectionLocked(uint64_t connection_id) {
+  for (auto it = pooled_connections_.begin(); it != pooled_connections_.end();
+       ++it) {
+    if (it->id == connection_id) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+        gpr_log(GPR_INFO,
+                "subchannel %p %s: pooled connected subchannel %p failed",
+                this, key_.ToString().c_str(), it->connected_subchannel.get());
+      }
+      pooled_connections_.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace grpc_core
@@ -20,11 +20,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
@@ -46,6 +49,7 @@
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sharded_ref_count.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
@@ -60,18 +64,27 @@
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
+#include "src/core/lib/transport/transport_rtt_observer.h"
 
 namespace grpc_core {
 
 class SubchannelCall;
 
-class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
+// Every call on the connection refs it, from whichever thread the call is
+// on, so its ref-count is sharded.  The owning Subchannel holds it in an
+// OrphanablePtr, and everything else holds refs.
+class ConnectedSubchannel
+    : public ShardedInternallyRefCounted<ConnectedSubchannel> {
  public:
   ConnectedSubchannel(
       grpc_channel_stack* channel_stack, const ChannelArgs& args,
       RefCountedPtr<channelz::SubchannelNode> channelz_subchannel);
   ~ConnectedSubchannel() override;
 
+  using ShardedInternallyRefCounted::Ref;
+
+  void Orphan() override { ReleaseInitialRef(); }
+
   void StartWatch(grpc_pollset_set* interested_parties,
                   OrphanablePtr<ConnectivityStateWatcherInterface> watcher);
 
@@ -85,12 +98,20 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // The number of SubchannelCalls currently using this connection.
+  size_t active_calls() const {
+    return active_calls_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class SubchannelCall;
+
   grpc_channel_stack* channel_stack_;
   ChannelArgs args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  std::atomic<size_t> active_calls_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -260,15 +281,22 @@ class Subchannel : public DualRefCounted<Subchannel> {
       const absl::optional<std::string>& health_check_service_name,
       ConnectivityStateWatcherInterface* watcher) ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Returns the connection to use for a new call, or null if not READY.
+  // With GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS set, this is the connection
+  // with the fewest active calls, and another connection is started in the
+  // background if all of them are full.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel()
-      ABSL_LOCKS_EXCLUDED(mu_) {
-    MutexLock lock(&mu_);
-    return connected_subchannel_;
-  }
+      ABSL_LOCKS_EXCLUDED(mu_);
 
   // Attempt to connect to the backend.  Has no effect if already connected.
   void RequestConnection() ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Reports the RTTs measured by the transports of the subchannel's
+  // connections.
+  TransportRttObserver* transport_rtt_observer() const {
+    return transport_rtt_observer_.get();
+  }
+
   // Resets the connection backoff of the subchannel.
   void ResetBackoff() ABSL_LOCKS_EXCLUDED(mu_);
 
@@ -347,6 +375,11 @@ class Subchannel : public DualRefCounted<Subchannel> {
         Subchannel* subchannel, const std::string& health_check_service_name)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Subchannel::mu_);
 
+    // Restarts health checking after the subchannel switched to another of
+    // its connections without leaving READY.
+    void OnConnectedSubchannelChangedLocked()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Subchannel::mu_);
+
     void ShutdownLocked();
 
    private:
@@ -372,6 +405,19 @@ class Subchannel : public DualRefCounted<Subchannel> {
   void OnConnectingFinishedLocked(grpc_error_handle error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Builds a connected subchannel from connecting_result_, or returns null.
+  OrphanablePtr<ConnectedSubchannel> CreateConnectedSubchannelLocked(
+      RefCountedPtr<channelz::SocketNode>* socket)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Methods for the additional connections kept while READY.
+  void MaybeStartPooledConnectionLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnPooledConnectingFinishedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Removes the pooled connection with \a connection_id, returning false if
+  // there is none.
+  bool RemovePooledConnectionLocked(uint64_t connection_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
@@ -386,6 +432,8 @@ class Subchannel : public DualRefCounted<Subchannel> {
   grpc_pollset_set* pollset_set_;
   // Channelz tracking.
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
+  // Passed to transports in args_.
+  RefCountedPtr<TransportRttObserver> transport_rtt_observer_;
   // Minimum connection timeout.
   Duration min_connect_timeout_;
 
@@ -414,7 +462,28 @@ class Subchannel : public DualRefCounted<Subchannel> {
   HealthWatcherMap health_watcher_map_ ABSL_GUARDED_BY(mu_);
 
   // Active connection, or null.
-  RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  OrphanablePtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  // Identifies the connection in connected_subchannel_ to its state watcher.
+  uint64_t connected_subchannel_id_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t next_connection_id_ ABSL_GUARDED_BY(mu_) = 0;
+
+  // Connections in addition to connected_subchannel_, kept only while READY.
+  // If connected_subchannel_ fails, one of these replaces it instead of the
+  // subchannel going IDLE.
+  struct PooledConnection {
+    uint64_t id;
+    OrphanablePtr<ConnectedSubchannel> connected_subchannel;
+  };
+  std::vector<PooledConnection> pooled_connections_ ABSL_GUARDED_BY(mu_);
+  // From GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS and
+  // GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION.
+  size_t max_connections_ = 1;
+  size_t streams_per_connection_ = 100;
+  // Whether connector_ is connecting for pooled_connections_.  A primary
+  // connection attempt started meanwhile takes the attempt over.
+  bool pooled_connecting_ ABSL_GUARDED_BY(mu_) = false;
+  // Earliest time to retry after a failed pooled connection attempt.
+  Timestamp next_pooled_attempt_time_ ABSL_GUARDED_BY(mu_);
 
   // Backoff state.
   BackOff backoff_ ABSL_GUARDED_BY(mu_);
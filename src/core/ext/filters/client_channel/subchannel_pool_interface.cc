@@ -22,9 +22,13 @@
 
 #include <string.h>
 
+#include <tuple>
+
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/variant.h"
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -38,9 +42,35 @@ namespace grpc_core {
 
 TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
+namespace {
+
+// Consistent with SubchannelKey::operator==().  Pointer args compare equal
+// according to their vtable, so only their names are hashed.
+size_t HashAddressAndArgs(const grpc_resolved_address& address,
+                          const ChannelArgs& args) {
+  size_t hash = absl::Hash<absl::string_view>()(
+      absl::string_view(address.addr, address.len));
+  args.ForEach([&hash](const std::string& name,
+                       const ChannelArgs::Value& value) {
+    size_t value_hash = value.index();
+    if (const int* i = absl::get_if<int>(&value)) {
+      value_hash = absl::Hash<int>()(*i);
+    } else if (const std::string* s = absl::get_if<std::string>(&value)) {
+      value_hash = absl::Hash<std::string>()(*s);
+    }
+    hash = absl::Hash<std::tuple<size_t, absl::string_view, size_t>>()(
+        std::make_tuple(hash, absl::string_view(name), value_hash));
+  });
+  return hash;
+}
+
+}  // namespace
+
 SubchannelKey::SubchannelKey(const grpc_resolved_address& address,
                              const ChannelArgs& args)
-    : address_(address), args_(args) {}
+    : address_(address),
+      args_(args),
+      hash_(HashAddressAndArgs(address, args)) {}
 
 bool SubchannelKey::operator<(const SubchannelKey& other) const {
   if (address_.len < other.address_.len) return true;
@@ -51,6 +81,12 @@ bool SubchannelKey::operator<(const SubchannelKey& other) const {
   return args_ < other.args();
 }
 
+bool SubchannelKey::operator==(const SubchannelKey& other) const {
+  return hash_ == other.hash_ && address_.len == other.address_.len &&
+         memcmp(address_.addr, other.address_.addr, address_.len) == 0 &&
+         args_ == other.args_;
+}
+
 std::string SubchannelKey::ToString() const {
   auto addr_uri = grpc_sockaddr_to_uri(&address_);
   return absl::StrCat(
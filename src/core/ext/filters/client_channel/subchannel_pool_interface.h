@@ -21,7 +21,10 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <string>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 
@@ -49,6 +52,15 @@ class SubchannelKey {
   SubchannelKey& operator=(SubchannelKey&& other) noexcept = default;
 
   bool operator<(const SubchannelKey& other) const;
+  bool operator==(const SubchannelKey& other) const;
+
+  // The hash of the address and args is computed once, when the key is
+  // constructed, so that pool lookups neither rehash the args nor, for
+  // keys that differ, compare them.
+  template <typename H>
+  friend H AbslHashValue(H h, const SubchannelKey& key) {
+    return H::combine(std::move(h), key.hash_);
+  }
 
   const grpc_resolved_address& address() const { return address_; }
   const ChannelArgs& args() const { return args_; }
@@ -59,6 +71,7 @@ class SubchannelKey {
  private:
   grpc_resolved_address address_;
   ChannelArgs args_;
+  size_t hash_;
 };
 
 // Interface for subchannel pool.
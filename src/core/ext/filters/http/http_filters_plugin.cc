@@ -25,6 +25,7 @@
 #include <grpc/impl/codegen/grpc_types.h>
 
 #include "src/core/ext/filters/http/client/http_client_filter.h"
+#include "src/core/ext/filters/http/message_compress/compression_dictionary_config.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_decompress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
@@ -45,6 +46,7 @@ static bool is_building_http_like_transport(
 
 namespace grpc_core {
 void RegisterHttpFilters(CoreConfiguration::Builder* builder) {
+  RegisterCompressionDictionaries(builder);
   auto optional = [builder](grpc_channel_stack_type channel_type,
                             bool enable_in_minimal_stack,
                             const char* control_channel_arg,
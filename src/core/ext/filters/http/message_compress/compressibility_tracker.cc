@@ -0,0 +1,77 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/http/message_compress/compressibility_tracker.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace grpc_core {
+
+namespace {
+
+// Ratios are fractions of this.
+constexpr uint32_t kRatioOne = 1024;
+
+}  // namespace
+
+bool CompressibilityTracker::MethodStats::ShouldCompress() {
+  if (samples_.load(std::memory_order_relaxed) < kMinSamples) return true;
+  if (ratio_.load(std::memory_order_relaxed) <= max_ratio_) return true;
+  return skipped_.fetch_add(1, std::memory_order_relaxed) % kProbeInterval ==
+         kProbeInterval - 1;
+}
+
+void CompressibilityTracker::MethodStats::RecordCompression(
+    size_t before_size, size_t after_size) {
+  if (before_size == 0) return;
+  const uint32_t ratio = static_cast<uint32_t>(
+      std::min<uint64_t>(kRatioOne, static_cast<uint64_t>(after_size) *
+                                        kRatioOne / before_size));
+  // Concurrent calls may lose each other's updates, which only makes the
+  // average a little less recent.
+  const uint32_t samples = samples_.load(std::memory_order_relaxed);
+  uint32_t average = ratio;
+  if (samples > 0) {
+    average = (ratio_.load(std::memory_order_relaxed) * 7 + ratio) / 8;
+  }
+  ratio_.store(average, std::memory_order_relaxed);
+  if (samples < kMinSamples) {
+    samples_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+CompressibilityTracker::CompressibilityTracker(uint32_t min_savings_percent)
+    : max_ratio_(kRatioOne -
+                 std::min<uint32_t>(min_savings_percent, 100) * kRatioOne /
+                     100) {}
+
+CompressibilityTracker::MethodStats* CompressibilityTracker::GetMethodStats(
+    absl::string_view path) {
+  MutexLock lock(&mu_);
+  auto it = methods_.find(path);
+  if (it != methods_.end()) return it->second.get();
+  if (methods_.size() >= kMaxMethods) return nullptr;
+  auto* stats = new MethodStats(max_ratio_);
+  methods_.emplace(std::string(path), std::unique_ptr<MethodStats>(stats));
+  return stats;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,94 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSIBILITY_TRACKER_H
+#define GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSIBILITY_TRACKER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Tracks how much the messages of each method of a channel shrink when
+// compressed, from the GRPC_COMPRESSION_CHANNEL_MIN_SAVINGS_PERCENT channel
+// arg. Methods whose messages save less than that stop being compressed,
+// except for one message in every kProbeInterval, so that they are
+// compressed again if their messages become compressible.
+class CompressibilityTracker {
+ public:
+  // Messages of a method always compressed before its stats are used.
+  static constexpr uint32_t kMinSamples = 4;
+  // While a method is not compressed, one message in this many is.
+  static constexpr uint32_t kProbeInterval = 64;
+  // Methods beyond this many are not tracked, and always compressed.
+  static constexpr size_t kMaxMethods = 1024;
+
+  // The stats of one method, updated by all its calls without locking.
+  class MethodStats {
+   public:
+    // Whether to compress the next message of the method.
+    bool ShouldCompress();
+    // Reports the size of a message before and after compression; when
+    // the compressor declined because the message didn't shrink, pass the
+    // same size twice.
+    void RecordCompression(size_t before_size, size_t after_size);
+
+   private:
+    friend class CompressibilityTracker;
+
+    explicit MethodStats(uint32_t max_ratio) : max_ratio_(max_ratio) {}
+
+    // Highest compressed to uncompressed size ratio, in 1024ths, for which
+    // messages are still compressed.
+    const uint32_t max_ratio_;
+    // Moving average of the ratio of the recent messages.
+    std::atomic<uint32_t> ratio_{0};
+    // Messages recorded, up to kMinSamples.
+    std::atomic<uint32_t> samples_{0};
+    std::atomic<uint32_t> skipped_{0};
+  };
+
+  explicit CompressibilityTracker(uint32_t min_savings_percent);
+
+  // Returns the stats of the method at \a path, which live as long as the
+  // tracker, or nullptr if too many methods are already tracked.
+  MethodStats* GetMethodStats(absl::string_view path);
+
+ private:
+  const uint32_t max_ratio_;
+  Mutex mu_;
+  std::map<std::string, std::unique_ptr<MethodStats>, std::less<>> methods_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSIBILITY_TRACKER_H
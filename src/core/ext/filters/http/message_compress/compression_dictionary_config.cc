@@ -0,0 +1,172 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/http/message_compress/compression_dictionary_config.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/impl/codegen/compression_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/service_config/service_config_call_data.h"
+
+namespace grpc_core {
+
+//
+// NamedCompressionDictionary
+//
+
+absl::StatusOr<NamedCompressionDictionary> NamedCompressionDictionary::FromJson(
+    const Json& json) {
+  if (json.type() != Json::Type::OBJECT) {
+    return absl::InvalidArgumentError("should be of type object");
+  }
+  auto it = json.object_value().find("name");
+  if (it == json.object_value().end() ||
+      it->second.type() != Json::Type::STRING ||
+      it->second.string_value().empty()) {
+    return absl::InvalidArgumentError(
+        "field:name error:should be a non-empty string");
+  }
+  NamedCompressionDictionary result;
+  result.name = Slice::FromCopiedString(it->second.string_value());
+  it = json.object_value().find("data");
+  std::string data;
+  if (it == json.object_value().end() ||
+      it->second.type() != Json::Type::STRING ||
+      !absl::Base64Unescape(it->second.string_value(), &data) ||
+      data.empty()) {
+    return absl::InvalidArgumentError(
+        "field:data error:should be a non-empty base64 string");
+  }
+  result.dictionary = MakeRefCounted<CompressionDictionary>(std::move(data));
+  return result;
+}
+
+//
+// CompressionDictionaryRegistry
+//
+
+absl::StatusOr<RefCountedPtr<CompressionDictionaryRegistry>>
+CompressionDictionaryRegistry::FromJsonString(absl::string_view json_string) {
+  auto json = Json::Parse(json_string);
+  if (!json.ok()) return json.status();
+  if (json->type() != Json::Type::ARRAY) {
+    return absl::InvalidArgumentError("should be of type array");
+  }
+  auto registry = MakeRefCounted<CompressionDictionaryRegistry>();
+  for (size_t i = 0; i < json->array_value().size(); ++i) {
+    auto dictionary =
+        NamedCompressionDictionary::FromJson(json->array_value()[i]);
+    if (!dictionary.ok()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("index ", i, ": ", dictionary.status().message()));
+    }
+    std::string name(dictionary->name.as_string_view());
+    if (!registry->dictionaries_
+             .emplace(std::move(name), std::move(dictionary->dictionary))
+             .second) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("index ", i, ": duplicate name"));
+    }
+  }
+  return registry;
+}
+
+RefCountedPtr<CompressionDictionary> CompressionDictionaryRegistry::Lookup(
+    absl::string_view name) const {
+  auto it = dictionaries_.find(name);
+  if (it == dictionaries_.end()) return nullptr;
+  return it->second;
+}
+
+//
+// CompressionDictionaryParsedConfig
+//
+
+const CompressionDictionaryParsedConfig*
+CompressionDictionaryParsedConfig::GetFromCallContext(
+    const grpc_call_context_element* context,
+    size_t service_config_parser_index) {
+  if (context == nullptr) return nullptr;
+  auto* svc_cfg_call_data = static_cast<ServiceConfigCallData*>(
+      context[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (svc_cfg_call_data == nullptr) return nullptr;
+  return static_cast<const CompressionDictionaryParsedConfig*>(
+      svc_cfg_call_data->GetMethodParsedConfig(service_config_parser_index));
+}
+
+//
+// CompressionDictionaryParser
+//
+
+absl::StatusOr<std::unique_ptr<ServiceConfigParser::ParsedConfig>>
+CompressionDictionaryParser::ParsePerMethodParams(const ChannelArgs& /*args*/,
+                                                  const Json& json) {
+  auto it = json.object_value().find("compressionDictionary");
+  if (it == json.object_value().end()) return nullptr;
+  auto dictionary = NamedCompressionDictionary::FromJson(it->second);
+  if (!dictionary.ok()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("field:compressionDictionary error:",
+                     dictionary.status().message()));
+  }
+  return absl::make_unique<CompressionDictionaryParsedConfig>(
+      std::move(*dictionary));
+}
+
+size_t CompressionDictionaryParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+namespace {
+
+ChannelArgs EnsureCompressionDictionaryRegistryInChannelArgs(
+    const ChannelArgs& args) {
+  if (args.GetObject<CompressionDictionaryRegistry>() != nullptr) return args;
+  auto json_string = args.GetString(GRPC_COMPRESSION_CHANNEL_DICTIONARIES);
+  if (!json_string.has_value()) return args;
+  auto registry = CompressionDictionaryRegistry::FromJsonString(*json_string);
+  if (!registry.ok()) {
+    gpr_log(GPR_ERROR, "Ignoring invalid %s channel arg: %s",
+            GRPC_COMPRESSION_CHANNEL_DICTIONARIES,
+            registry.status().ToString().c_str());
+    return args;
+  }
+  return args.SetObject(std::move(*registry));
+}
+
+}  // namespace
+
+void RegisterCompressionDictionaries(CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      absl::make_unique<CompressionDictionaryParser>());
+  builder->channel_args_preconditioning()->RegisterStage(
+      EnsureCompressionDictionaryRegistryInChannelArgs);
+}
+
+}  // namespace grpc_core
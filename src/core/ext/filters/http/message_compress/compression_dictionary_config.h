@@ -0,0 +1,124 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_DICTIONARY_CONFIG_H
+#define GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_DICTIONARY_CONFIG_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+// A dictionary and the name that the grpc-compression-dictionary header
+// identifies it by. Parsed from {"name": "...", "data": "<base64>"}.
+struct NamedCompressionDictionary {
+  Slice name;
+  RefCountedPtr<CompressionDictionary> dictionary;
+
+  static absl::StatusOr<NamedCompressionDictionary> FromJson(const Json& json);
+};
+
+// The dictionaries a channel can decompress messages with, from the
+// GRPC_COMPRESSION_CHANNEL_DICTIONARIES channel arg. It is built once, when
+// the channel args are preconditioned, so that the connections of a server
+// share it.
+class CompressionDictionaryRegistry
+    : public RefCounted<CompressionDictionaryRegistry> {
+ public:
+  static absl::StatusOr<RefCountedPtr<CompressionDictionaryRegistry>>
+  FromJsonString(absl::string_view json_string);
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.compression_dictionary_registry";
+  }
+  static int ChannelArgsCompare(const CompressionDictionaryRegistry* a,
+                                const CompressionDictionaryRegistry* b) {
+    return QsortCompare(a, b);
+  }
+
+  // Returns null if there is no dictionary called \a name.
+  RefCountedPtr<CompressionDictionary> Lookup(absl::string_view name) const;
+
+ private:
+  std::map<std::string, RefCountedPtr<CompressionDictionary>, std::less<>>
+      dictionaries_;
+};
+
+// The dictionary the zstd and lz4 algorithms compress a method's requests
+// with, from the "compressionDictionary" field of its method config.
+class CompressionDictionaryParsedConfig
+    : public ServiceConfigParser::ParsedConfig {
+ public:
+  explicit CompressionDictionaryParsedConfig(
+      NamedCompressionDictionary dictionary)
+      : dictionary_(std::move(dictionary)) {}
+
+  const Slice& name() const { return dictionary_.name; }
+  const RefCountedPtr<CompressionDictionary>& dictionary() const {
+    return dictionary_.dictionary;
+  }
+
+  static const CompressionDictionaryParsedConfig* GetFromCallContext(
+      const grpc_call_context_element* context,
+      size_t service_config_parser_index);
+
+ private:
+  NamedCompressionDictionary dictionary_;
+};
+
+class CompressionDictionaryParser : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+
+  absl::StatusOr<std::unique_ptr<ServiceConfigParser::ParsedConfig>>
+  ParsePerMethodParams(const ChannelArgs& /*args*/, const Json& json) override;
+
+  static size_t ParserIndex();
+
+ private:
+  static absl::string_view parser_name() { return "compression_dictionary"; }
+};
+
+// Registers the service config parser, and the channel args preconditioning
+// stage that builds the CompressionDictionaryRegistry.
+void RegisterCompressionDictionaries(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_DICTIONARY_CONFIG_H \
+        */
@@ -23,31 +23,50 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <new>
 #include <utility>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
 #include "absl/types/optional.h"
 
 #include <grpc/compression.h>
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/http/message_compress/compressibility_tracker.h"
+#include "src/core/ext/filters/http/message_compress/compression_dictionary_config.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
 
 namespace {
 
+// zstd and lz4 messages compressed off the call combiner are split into
+// chunks of at least this size, compressed in parallel as frames of their
+// own. Both formats decode concatenated frames as one message.
+constexpr size_t kMinParallelCompressionChunkSize = 1024 * 1024;
+
 class ChannelData {
  public:
   explicit ChannelData(grpc_channel_element_args* args) {
@@ -71,6 +90,31 @@ class ChannelData {
               name);
       default_compression_algorithm_ = GRPC_COMPRESS_NONE;
     }
+    // Options for the algorithms that take them.
+    grpc_core::ChannelArgs channel_args =
+        grpc_core::ChannelArgs::FromC(args->channel_args);
+    auto level = channel_args.GetInt(GRPC_COMPRESSION_CHANNEL_DEFAULT_LEVEL);
+    if (level.has_value()) {
+      compression_options_.level = grpc_core::Clamp(
+          static_cast<grpc_compression_level>(*level),
+          GRPC_COMPRESS_LEVEL_NONE,
+          static_cast<grpc_compression_level>(GRPC_COMPRESS_LEVEL_COUNT - 1));
+    }
+    compression_options_.dictionary =
+        channel_args.GetObjectRef<grpc_core::CompressionDictionary>();
+    dictionary_parser_index_ =
+        grpc_core::CompressionDictionaryParser::ParserIndex();
+    offload_threshold_ = std::max(
+        0, channel_args.GetInt(GRPC_COMPRESSION_CHANNEL_OFFLOAD_THRESHOLD)
+               .value_or(0));
+    const int min_savings_percent =
+        channel_args.GetInt(GRPC_COMPRESSION_CHANNEL_MIN_SAVINGS_PERCENT)
+            .value_or(0);
+    if (min_savings_percent > 0) {
+      compressibility_tracker_ =
+          absl::make_unique<grpc_core::CompressibilityTracker>(
+              min_savings_percent);
+    }
     GPR_ASSERT(!args->is_last);
   }
 
@@ -82,18 +126,49 @@ class ChannelData {
     return enabled_compression_algorithms_;
   }
 
+  const grpc_core::MessageCompressionOptions& compression_options() const {
+    return compression_options_;
+  }
+
+  size_t dictionary_parser_index() const { return dictionary_parser_index_; }
+
+  size_t offload_threshold() const { return offload_threshold_; }
+
+  grpc_core::CompressibilityTracker* compressibility_tracker() const {
+    return compressibility_tracker_.get();
+  }
+
  private:
   /** The default, channel-level, compression algorithm */
   grpc_compression_algorithm default_compression_algorithm_;
   /** Enabled compression algorithms */
   grpc_core::CompressionAlgorithmSet enabled_compression_algorithms_;
+  /** Level and dictionary used by the algorithms supporting them */
+  grpc_core::MessageCompressionOptions compression_options_;
+  /** Index of the per-method compression dictionary in service configs */
+  size_t dictionary_parser_index_;
+  /** Size from which messages are compressed off the call combiner, or 0 */
+  size_t offload_threshold_;
+  /** How well the messages of each method compress, if tracked */
+  std::unique_ptr<grpc_core::CompressibilityTracker> compressibility_tracker_;
 };
 
 class CallData {
  public:
   CallData(grpc_call_element* elem, const grpc_call_element_args& args)
-      : call_combiner_(args.call_combiner) {
+      : owning_call_(args.call_stack), call_combiner_(args.call_combiner) {
     ChannelData* channeld = static_cast<ChannelData*>(elem->channel_data);
+    compression_options_ = &channeld->compression_options();
+    offload_threshold_ = channeld->offload_threshold();
+    method_dictionary_ =
+        grpc_core::CompressionDictionaryParsedConfig::GetFromCallContext(
+            args.context, channeld->dictionary_parser_index());
+    // Servers don't know the method yet, so their calls share the stats
+    // of the empty path.
+    if (channeld->compressibility_tracker() != nullptr) {
+      method_stats_ = channeld->compressibility_tracker()->GetMethodStats(
+          grpc_core::StringViewFromSlice(args.path));
+    }
     // The call's message compression algorithm is set to channel's default
     // setting. It can be overridden later by initial metadata.
     if (GPR_LIKELY(channeld->enabled_compression_algorithms().IsSet(
@@ -102,6 +177,8 @@ class CallData {
     }
     GRPC_CLOSURE_INIT(&forward_send_message_batch_in_call_combiner_,
                       ForwardSendMessageBatch, elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&send_compressed_message_in_call_combiner_,
+                      SendCompressedMessage, elem, grpc_schedule_on_exec_ctx);
   }
 
   ~CallData() { GRPC_ERROR_UNREF(cancel_error_); }
@@ -112,6 +189,13 @@ class CallData {
  private:
   bool SkipMessageCompression();
   void FinishSendMessage(grpc_call_element* elem);
+  void LogCompression(bool did_compress, size_t before_size,
+                      size_t after_size);
+
+  // Methods for compressing a large message on the EventEngine
+  void OffloadMessageCompression();
+  void FinishOffloadedCompression();
+  static void SendCompressedMessage(void* elem_arg, grpc_error_handle unused);
 
   void ProcessSendInitialMetadata(grpc_call_element* elem,
                                   grpc_metadata_batch* initial_metadata);
@@ -121,12 +205,30 @@ class CallData {
                                                  grpc_error_handle error);
   static void ForwardSendMessageBatch(void* elem_arg, grpc_error_handle unused);
 
+  grpc_call_stack* owning_call_;
   grpc_core::CallCombiner* call_combiner_;
   grpc_compression_algorithm compression_algorithm_ = GRPC_COMPRESS_NONE;
+  // The channel's options, or method_compression_options_ once the method's
+  // dictionary is in use.
+  const grpc_core::MessageCompressionOptions* compression_options_;
+  const grpc_core::CompressionDictionaryParsedConfig* method_dictionary_;
+  grpc_core::MessageCompressionOptions method_compression_options_;
+  // How well the method's messages compress, if tracked.
+  grpc_core::CompressibilityTracker::MethodStats* method_stats_ = nullptr;
   grpc_error_handle cancel_error_;
   grpc_transport_stream_op_batch* send_message_batch_ = nullptr;
   bool seen_initial_metadata_ = false;
   grpc_closure forward_send_message_batch_in_call_combiner_;
+  // Fields for compressing a large message on the EventEngine
+  struct CompressionChunk {
+    grpc_core::SliceBuffer input;
+    grpc_core::SliceBuffer output;
+    bool compressed = false;
+  };
+  size_t offload_threshold_;
+  std::vector<CompressionChunk> compression_chunks_;
+  std::atomic<size_t> pending_compression_chunks_{0};
+  grpc_closure send_compressed_message_in_call_combiner_;
 };
 
 // Returns true if we should skip message compression for the current message.
@@ -139,7 +241,9 @@ bool CallData::SkipMessageCompression() {
   }
   // If this call doesn't have any message compression algorithm set, skip
   // message compression.
-  return compression_algorithm_ == GRPC_COMPRESS_NONE;
+  if (compression_algorithm_ == GRPC_COMPRESS_NONE) return true;
+  // Skip compression if the method's messages have not been shrinking.
+  return method_stats_ != nullptr && !method_stats_->ShouldCompress();
 }
 
 void CallData::ProcessSendInitialMetadata(
@@ -157,6 +261,21 @@ void CallData::ProcessSendInitialMetadata(
       initial_metadata->Set(grpc_core::GrpcEncodingMetadata(),
                             compression_algorithm_);
       break;
+    case GRPC_COMPRESS_ZSTD:
+    case GRPC_COMPRESS_LZ4:
+      initial_metadata->Set(grpc_core::GrpcEncodingMetadata(),
+                            compression_algorithm_);
+      // Tell the peer which of its dictionaries the method's messages are
+      // compressed with.
+      if (method_dictionary_ != nullptr) {
+        method_compression_options_.level = compression_options_->level;
+        method_compression_options_.dictionary =
+            method_dictionary_->dictionary();
+        compression_options_ = &method_compression_options_;
+        initial_metadata->Set(grpc_core::GrpcCompressionDictionaryMetadata(),
+                              method_dictionary_->name().Ref());
+      }
+      break;
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       abort();
   }
@@ -172,39 +291,135 @@ void CallData::FinishSendMessage(grpc_call_element* elem) {
     uint32_t& send_flags = send_message_batch_->payload->send_message.flags;
     grpc_core::SliceBuffer* payload =
         send_message_batch_->payload->send_message.send_message;
+    // Don't hold up the other streams of the connection with a large one.
+    if (offload_threshold_ > 0 && payload->Length() >= offload_threshold_) {
+      OffloadMessageCompression();
+      return;
+    }
     bool did_compress =
-        grpc_msg_compress(compression_algorithm_, payload->c_slice_buffer(),
-                          tmp.c_slice_buffer());
+        grpc_msg_compress(compression_algorithm_, *compression_options_,
+                          payload->c_slice_buffer(), tmp.c_slice_buffer());
+    LogCompression(did_compress, payload->Length(), tmp.Length());
+    if (method_stats_ != nullptr) {
+      method_stats_->RecordCompression(
+          payload->Length(), did_compress ? tmp.Length() : payload->Length());
+    }
     if (did_compress) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
-        const char* algo_name;
-        const size_t before_size = payload->Length();
-        const size_t after_size = tmp.Length();
-        const float savings_ratio = 1.0f - static_cast<float>(after_size) /
-                                               static_cast<float>(before_size);
-        GPR_ASSERT(grpc_compression_algorithm_name(compression_algorithm_,
-                                                   &algo_name));
-        gpr_log(GPR_INFO,
-                "Compressed[%s] %" PRIuPTR " bytes vs. %" PRIuPTR
-                " bytes (%.2f%% savings)",
-                algo_name, before_size, after_size, 100 * savings_ratio);
-      }
       tmp.Swap(payload);
       send_flags |= GRPC_WRITE_INTERNAL_COMPRESS;
-    } else {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
-        const char* algo_name;
-        GPR_ASSERT(grpc_compression_algorithm_name(compression_algorithm_,
-                                                   &algo_name));
-        gpr_log(
-            GPR_INFO,
+    }
+  }
+  grpc_call_next_op(elem, std::exchange(send_message_batch_, nullptr));
+}
+
+void CallData::LogCompression(bool did_compress, size_t before_size,
+                              size_t after_size) {
+  if (!GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) return;
+  const char* algo_name;
+  GPR_ASSERT(
+      grpc_compression_algorithm_name(compression_algorithm_, &algo_name));
+  if (did_compress) {
+    const float savings_ratio = 1.0f - static_cast<float>(after_size) /
+                                           static_cast<float>(before_size);
+    gpr_log(GPR_INFO,
+            "Compressed[%s] %" PRIuPTR " bytes vs. %" PRIuPTR
+            " bytes (%.2f%% savings)",
+            algo_name, before_size, after_size, 100 * savings_ratio);
+  } else {
+    gpr_log(GPR_INFO,
             "Algorithm '%s' enabled but decided not to compress. Input size: "
             "%" PRIuPTR,
-            algo_name, payload->Length());
+            algo_name, before_size);
+  }
+}
+
+void CallData::OffloadMessageCompression() {
+  grpc_core::SliceBuffer* payload =
+      send_message_batch_->payload->send_message.send_message;
+  size_t num_chunks = 1;
+  size_t chunk_size = payload->Length();
+  if (compression_algorithm_ == GRPC_COMPRESS_ZSTD ||
+      compression_algorithm_ == GRPC_COMPRESS_LZ4) {
+    chunk_size = std::max(offload_threshold_, kMinParallelCompressionChunkSize);
+    num_chunks = std::max<size_t>(
+        1, (payload->Length() + chunk_size - 1) / chunk_size);
+  }
+  compression_chunks_.resize(num_chunks);
+  for (size_t i = 0; i + 1 < num_chunks; i++) {
+    grpc_slice_buffer_move_first(payload->c_slice_buffer(), chunk_size,
+                                 compression_chunks_[i].input.c_slice_buffer());
+  }
+  compression_chunks_.back().input.Swap(payload);
+  pending_compression_chunks_.store(num_chunks, std::memory_order_relaxed);
+  // Held until the batch is sent down.
+  GRPC_CALL_STACK_REF(owning_call_, "compress_offload");
+  GRPC_CALL_COMBINER_STOP(call_combiner_,
+                          "compressing send_message on the EventEngine");
+  for (size_t i = 0; i < num_chunks; i++) {
+    grpc_event_engine::experimental::GetDefaultEventEngine()->Run([this, i] {
+      grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+      grpc_core::ExecCtx exec_ctx;
+      CompressionChunk& chunk = compression_chunks_[i];
+      chunk.compressed = grpc_msg_compress(
+          compression_algorithm_, *compression_options_,
+          chunk.input.c_slice_buffer(), chunk.output.c_slice_buffer());
+      if (pending_compression_chunks_.fetch_sub(
+              1, std::memory_order_acq_rel) == 1) {
+        FinishOffloadedCompression();
       }
-    }
+    });
   }
-  grpc_call_next_op(elem, std::exchange(send_message_batch_, nullptr));
+}
+
+void CallData::FinishOffloadedCompression() {
+  grpc_core::SliceBuffer* payload =
+      send_message_batch_->payload->send_message.send_message;
+  // A chunk that didn't shrink is sent as is, so the others must be too.
+  bool did_compress = true;
+  size_t before_size = 0;
+  size_t after_size = 0;
+  for (const CompressionChunk& chunk : compression_chunks_) {
+    did_compress = did_compress && chunk.compressed;
+    before_size += chunk.input.Length();
+    after_size += chunk.output.Length();
+  }
+  for (CompressionChunk& chunk : compression_chunks_) {
+    grpc_slice_buffer_move_into(
+        did_compress ? chunk.output.c_slice_buffer()
+                     : chunk.input.c_slice_buffer(),
+        payload->c_slice_buffer());
+  }
+  compression_chunks_.clear();
+  LogCompression(did_compress, before_size, after_size);
+  if (method_stats_ != nullptr) {
+    method_stats_->RecordCompression(
+        before_size, did_compress ? after_size : before_size);
+  }
+  if (did_compress) {
+    send_message_batch_->payload->send_message.flags |=
+        GRPC_WRITE_INTERNAL_COMPRESS;
+  }
+  GRPC_CALL_COMBINER_START(call_combiner_,
+                           &send_compressed_message_in_call_combiner_,
+                           absl::OkStatus(),
+                           "send_message compressed on the EventEngine");
+}
+
+void CallData::SendCompressedMessage(void* elem_arg,
+                                     grpc_error_handle /*unused*/) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(elem_arg);
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  grpc_call_stack* owning_call = calld->owning_call_;
+  grpc_transport_stream_op_batch* batch =
+      std::exchange(calld->send_message_batch_, nullptr);
+  // The call may have been cancelled meanwhile.
+  if (!calld->cancel_error_.ok()) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        batch, calld->cancel_error_, calld->call_combiner_);
+  } else {
+    grpc_call_next_op(elem, batch);
+  }
+  GRPC_CALL_STACK_UNREF(owning_call, "compress_offload");
 }
 
 void CallData::FailSendMessageBatchInCallCombiner(void* calld_arg,
@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <new>
 
 #include "absl/status/status.h"
@@ -30,17 +31,21 @@
 #include "absl/strings/str_format.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/status.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/http/message_compress/compression_dictionary_config.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_buffer.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
@@ -54,23 +59,55 @@ class ChannelData {
       : max_recv_size_(GetMaxRecvSizeFromChannelArgs(
             ChannelArgs::FromC(args->channel_args))),
         message_size_service_config_parser_index_(
-            MessageSizeParser::ParserIndex()) {}
+            MessageSizeParser::ParserIndex()),
+        dictionary_service_config_parser_index_(
+            CompressionDictionaryParser::ParserIndex()) {
+    ChannelArgs channel_args = ChannelArgs::FromC(args->channel_args);
+    compression_options_.dictionary =
+        channel_args.GetObjectRef<CompressionDictionary>();
+    dictionary_registry_ =
+        channel_args.GetObjectRef<CompressionDictionaryRegistry>();
+    offload_threshold_ = std::max(
+        0, channel_args.GetInt(GRPC_COMPRESSION_CHANNEL_OFFLOAD_THRESHOLD)
+               .value_or(0));
+  }
 
   int max_recv_size() const { return max_recv_size_; }
   size_t message_size_service_config_parser_index() const {
     return message_size_service_config_parser_index_;
   }
+  size_t dictionary_service_config_parser_index() const {
+    return dictionary_service_config_parser_index_;
+  }
+  const MessageCompressionOptions& compression_options() const {
+    return compression_options_;
+  }
+  const CompressionDictionaryRegistry* dictionary_registry() const {
+    return dictionary_registry_.get();
+  }
+  size_t offload_threshold() const { return offload_threshold_; }
 
  private:
   int max_recv_size_;
   const size_t message_size_service_config_parser_index_;
+  const size_t dictionary_service_config_parser_index_;
+  // The dictionary the peer compresses with, if any.
+  MessageCompressionOptions compression_options_;
+  // The dictionaries the peer may name in grpc-compression-dictionary.
+  RefCountedPtr<CompressionDictionaryRegistry> dictionary_registry_;
+  // Size from which messages are decompressed off the call combiner, or 0.
+  size_t offload_threshold_;
 };
 
 class CallData {
  public:
   CallData(const grpc_call_element_args& args, const ChannelData* chand)
-      : call_combiner_(args.call_combiner),
-        max_recv_message_length_(chand->max_recv_size()) {
+      : owning_call_(args.call_stack),
+        call_combiner_(args.call_combiner),
+        max_recv_message_length_(chand->max_recv_size()),
+        compression_options_(&chand->compression_options()),
+        dictionary_registry_(chand->dictionary_registry()),
+        offload_threshold_(chand->offload_threshold()) {
     // Initialize state for recv_initial_metadata_ready callback
     GRPC_CLOSURE_INIT(&on_recv_initial_metadata_ready_,
                       OnRecvInitialMetadataReady, this,
@@ -78,6 +115,8 @@ class CallData {
     // Initialize state for recv_message_ready callback
     GRPC_CLOSURE_INIT(&on_recv_message_ready_, OnRecvMessageReady, this,
                       grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_message_decompressed_, OnMessageDecompressed, this,
+                      grpc_schedule_on_exec_ctx);
     // Initialize state for recv_trailing_metadata_ready callback
     GRPC_CLOSURE_INIT(&on_recv_trailing_metadata_ready_,
                       OnRecvTrailingMetadataReady, this,
@@ -90,6 +129,8 @@ class CallData {
          max_recv_message_length_ < 0)) {
       max_recv_message_length_ = limits->limits().max_recv_size;
     }
+    method_dictionary_ = CompressionDictionaryParsedConfig::GetFromCallContext(
+        args.context, chand->dictionary_service_config_parser_index());
   }
 
   void DecompressStartTransportStreamOpBatch(
@@ -97,16 +138,22 @@ class CallData {
 
  private:
   static void OnRecvInitialMetadataReady(void* arg, grpc_error_handle error);
+  // Picks the dictionary named by the peer, if any.
+  void SelectDictionary(const Slice& name);
 
   // Methods for processing a receive message event
   void MaybeResumeOnRecvMessageReady();
   static void OnRecvMessageReady(void* arg, grpc_error_handle error);
+  void DecompressMessage();
+  void OffloadMessageDecompression();
+  static void OnMessageDecompressed(void* arg, grpc_error_handle error);
   void ContinueRecvMessageReadyCallback(grpc_error_handle error);
 
   // Methods for processing a recv_trailing_metadata event
   void MaybeResumeOnRecvTrailingMetadataReady();
   static void OnRecvTrailingMetadataReady(void* arg, grpc_error_handle error);
 
+  grpc_call_stack* owning_call_;
   CallCombiner* call_combiner_;
   // Overall error for the call
   grpc_error_handle error_;
@@ -118,10 +165,19 @@ class CallData {
   bool seen_recv_message_ready_ = false;
   int max_recv_message_length_;
   grpc_compression_algorithm algorithm_ = GRPC_COMPRESS_NONE;
+  const MessageCompressionOptions* compression_options_;
+  const CompressionDictionaryRegistry* const dictionary_registry_;
+  const CompressionDictionaryParsedConfig* method_dictionary_;
+  // Set when the peer names its dictionary.
+  MessageCompressionOptions named_dictionary_options_;
+  // The name of a dictionary the peer used that this side doesn't know.
+  absl::optional<Slice> unknown_dictionary_;
   absl::optional<SliceBuffer>* recv_message_ = nullptr;
   uint32_t* recv_message_flags_ = nullptr;
   grpc_closure on_recv_message_ready_;
   grpc_closure* original_recv_message_ready_ = nullptr;
+  const size_t offload_threshold_;
+  grpc_closure on_message_decompressed_;
   // Fields for handling recv_trailing_metadata_ready callback
   bool seen_recv_trailing_metadata_ready_ = false;
   grpc_closure on_recv_trailing_metadata_ready_;
@@ -135,6 +191,9 @@ void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error_handle error) {
     calld->algorithm_ =
         calld->recv_initial_metadata_->get(GrpcEncodingMetadata())
             .value_or(GRPC_COMPRESS_NONE);
+    auto dictionary = calld->recv_initial_metadata_->Take(
+        GrpcCompressionDictionaryMetadata());
+    if (dictionary.has_value()) calld->SelectDictionary(*dictionary);
   }
   calld->MaybeResumeOnRecvMessageReady();
   calld->MaybeResumeOnRecvTrailingMetadataReady();
@@ -143,6 +202,21 @@ void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error_handle error) {
   Closure::Run(DEBUG_LOCATION, closure, error);
 }
 
+void CallData::SelectDictionary(const Slice& name) {
+  RefCountedPtr<CompressionDictionary> dictionary;
+  if (method_dictionary_ != nullptr && method_dictionary_->name() == name) {
+    dictionary = method_dictionary_->dictionary();
+  } else if (dictionary_registry_ != nullptr) {
+    dictionary = dictionary_registry_->Lookup(name.as_string_view());
+  }
+  if (dictionary == nullptr) {
+    unknown_dictionary_ = name.Ref();
+    return;
+  }
+  named_dictionary_options_.dictionary = std::move(dictionary);
+  compression_options_ = &named_dictionary_options_;
+}
+
 void CallData::MaybeResumeOnRecvMessageReady() {
   if (seen_recv_message_ready_) {
     seen_recv_message_ready_ = false;
@@ -182,27 +256,67 @@ void CallData::OnRecvMessageReady(void* arg, grpc_error_handle error) {
             GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
         return calld->ContinueRecvMessageReadyCallback(calld->error_);
       }
-      SliceBuffer decompressed_slices;
-      if (grpc_msg_decompress(calld->algorithm_,
-                              (*calld->recv_message_)->c_slice_buffer(),
-                              decompressed_slices.c_slice_buffer()) == 0) {
+      if (calld->unknown_dictionary_.has_value()) {
         GPR_DEBUG_ASSERT(calld->error_.ok());
-        calld->error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
-            "Unexpected error decompressing data for algorithm with "
-            "enum value ",
-            calld->algorithm_));
-      } else {
-        *calld->recv_message_flags_ =
-            (*calld->recv_message_flags_ & (~GRPC_WRITE_INTERNAL_COMPRESS)) |
-            GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED;
-        (*calld->recv_message_)->Swap(&decompressed_slices);
+        calld->error_ = grpc_error_set_int(
+            GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+                "Message compressed with unknown dictionary ",
+                calld->unknown_dictionary_->as_string_view())),
+            GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_INTERNAL);
+        return calld->ContinueRecvMessageReadyCallback(calld->error_);
+      }
+      // Don't hold up the other streams of the connection with a large one.
+      if (calld->offload_threshold_ > 0 &&
+          (*calld->recv_message_)->Length() >= calld->offload_threshold_) {
+        return calld->OffloadMessageDecompression();
       }
+      calld->DecompressMessage();
       return calld->ContinueRecvMessageReadyCallback(calld->error_);
     }
   }
   calld->ContinueRecvMessageReadyCallback(error);
 }
 
+void CallData::DecompressMessage() {
+  SliceBuffer decompressed_slices;
+  if (grpc_msg_decompress(algorithm_, *compression_options_,
+                          (*recv_message_)->c_slice_buffer(),
+                          decompressed_slices.c_slice_buffer()) == 0) {
+    GPR_DEBUG_ASSERT(error_.ok());
+    error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+        "Unexpected error decompressing data for algorithm with "
+        "enum value ",
+        algorithm_));
+  } else {
+    *recv_message_flags_ =
+        (*recv_message_flags_ & (~GRPC_WRITE_INTERNAL_COMPRESS)) |
+        GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED;
+    (*recv_message_)->Swap(&decompressed_slices);
+  }
+}
+
+void CallData::OffloadMessageDecompression() {
+  // Held until the message is handed up.
+  GRPC_CALL_STACK_REF(owning_call_, "decompress_offload");
+  GRPC_CALL_COMBINER_STOP(call_combiner_,
+                          "decompressing recv_message on the EventEngine");
+  grpc_event_engine::experimental::GetDefaultEventEngine()->Run([this] {
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    DecompressMessage();
+    GRPC_CALL_COMBINER_START(call_combiner_, &on_message_decompressed_,
+                             absl::OkStatus(),
+                             "recv_message decompressed on the EventEngine");
+  });
+}
+
+void CallData::OnMessageDecompressed(void* arg, grpc_error_handle /*error*/) {
+  CallData* calld = static_cast<CallData*>(arg);
+  grpc_call_stack* owning_call = calld->owning_call_;
+  calld->ContinueRecvMessageReadyCallback(calld->error_);
+  GRPC_CALL_STACK_UNREF(owning_call, "decompress_offload");
+}
+
 void CallData::ContinueRecvMessageReadyCallback(grpc_error_handle error) {
   MaybeResumeOnRecvTrailingMetadataReady();
   // The surface will clean up the receiving stream if there is an error.
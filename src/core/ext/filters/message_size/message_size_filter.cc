@@ -199,6 +199,9 @@ struct call_data {
   grpc_error_handle error;
   // Used by recv_message_ready.
   absl::optional<grpc_core::SliceBuffer>* recv_message = nullptr;
+  uint32_t* recv_message_flags = nullptr;
+  // Bytes of the parts received so far of a message received in parts.
+  size_t recv_message_parts_length = 0;
   // Original recv_message_ready callback, invoked after our own.
   grpc_closure* next_recv_message_ready = nullptr;
   // Original recv_trailing_metadata callback, invoked after our own.
@@ -214,16 +217,24 @@ struct call_data {
 static void recv_message_ready(void* user_data, grpc_error_handle error) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
   call_data* calld = static_cast<call_data*>(elem->call_data);
-  if (calld->recv_message->has_value() && calld->limits.max_recv_size >= 0 &&
-      (*calld->recv_message)->Length() >
-          static_cast<size_t>(calld->limits.max_recv_size)) {
-    grpc_error_handle new_error = grpc_error_set_int(
-        GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrFormat(
-            "Received message larger than max (%u vs. %d)",
-            (*calld->recv_message)->Length(), calld->limits.max_recv_size)),
-        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
-    error = grpc_error_add_child(error, new_error);
-    calld->error = error;
+  if (calld->recv_message->has_value()) {
+    // The limit applies to whole messages, however many parts they come in.
+    const size_t length =
+        calld->recv_message_parts_length + (*calld->recv_message)->Length();
+    const bool partial =
+        calld->recv_message_flags != nullptr &&
+        (*calld->recv_message_flags & GRPC_RECV_INTERNAL_PARTIAL) != 0;
+    calld->recv_message_parts_length = partial ? length : 0;
+    if (calld->limits.max_recv_size >= 0 &&
+        length > static_cast<size_t>(calld->limits.max_recv_size)) {
+      grpc_error_handle new_error = grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_CPP_STRING(
+              absl::StrFormat("Received message larger than max (%u vs. %d)",
+                              length, calld->limits.max_recv_size)),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
+      error = grpc_error_add_child(error, new_error);
+      calld->error = error;
+    }
   }
   // Invoke the next callback.
   grpc_closure* closure = calld->next_recv_message_ready;
@@ -287,6 +298,7 @@ static void message_size_start_transport_stream_op_batch(
     calld->next_recv_message_ready =
         op->payload->recv_message.recv_message_ready;
     calld->recv_message = op->payload->recv_message.recv_message;
+    calld->recv_message_flags = op->payload->recv_message.flags;
     op->payload->recv_message.recv_message_ready = &calld->recv_message_ready;
   }
   // Inject callback for receiving trailing metadata.
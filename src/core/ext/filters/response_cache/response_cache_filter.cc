@@ -0,0 +1,723 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/response_cache/response_cache_filter.h"
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+#include <grpc/event_engine/memory_request.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Above this memory pressure, no more responses are cached.
+constexpr double kMaxInsertPressure = 0.8;
+
+size_t MetadataSize(const CachedResponse::Metadata& metadata) {
+  size_t size = metadata.capacity() * sizeof(metadata[0]);
+  for (const auto& kv : metadata) size += kv.first.size() + kv.second.size();
+  return size;
+}
+
+}  // namespace
+
+size_t CachedResponse::Size() const {
+  return sizeof(*this) + MetadataSize(initial_metadata) + message.Length() +
+         MetadataSize(trailing_metadata);
+}
+
+//
+// ResponseCache
+//
+
+ResponseCache::ResponseCache(size_t max_size, MemoryOwner memory_owner)
+    : max_size_(max_size), memory_owner_(std::move(memory_owner)) {}
+
+ResponseCache::~ResponseCache() { memory_owner_.Release(size_); }
+
+std::shared_ptr<const CachedResponse> ResponseCache::Lookup(
+    absl::string_view key, Timestamp now) {
+  MutexLock lock(&mu_);
+  auto it = index_.find(key);
+  if (it == index_.end()) return nullptr;
+  EntryList::iterator entry = it->second;
+  if (entry->expiry <= now) {
+    RemoveLocked(entry);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->response;
+}
+
+void ResponseCache::Insert(std::string key,
+                           std::shared_ptr<const CachedResponse> response,
+                           Timestamp expiry) {
+  const size_t size = sizeof(Entry) + key.size() + response->Size();
+  if (size > max_size_ ||
+      size > grpc_event_engine::experimental::MemoryRequest::
+                 max_allowed_size() ||
+      memory_owner_.GetPressureInfo().instantaneous_pressure >
+          kMaxInsertPressure) {
+    return;
+  }
+  bool post_reclaimer;
+  {
+    MutexLock lock(&mu_);
+    auto it = index_.find(key);
+    if (it != index_.end()) RemoveLocked(it->second);
+    while (size_ + size > max_size_) RemoveLocked(std::prev(entries_.end()));
+    memory_owner_.Reserve(size);
+    size_ += size;
+    entries_.push_front(
+        Entry{std::move(key), std::move(response), expiry, size});
+    index_.emplace(entries_.front().key, entries_.begin());
+    post_reclaimer = !std::exchange(posted_reclaimer_, true);
+  }
+  if (post_reclaimer) PostReclaimer();
+}
+
+size_t ResponseCache::size() const {
+  MutexLock lock(&mu_);
+  return size_;
+}
+
+void ResponseCache::RemoveLocked(EntryList::iterator entry) {
+  index_.erase(entry->key);
+  size_ -= entry->size;
+  memory_owner_.Release(entry->size);
+  entries_.erase(entry);
+}
+
+void ResponseCache::PostReclaimer() {
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kBenign,
+      [this](absl::optional<ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        Reclaim();
+      });
+}
+
+void ResponseCache::Reclaim() {
+  // Freed once the lock is released.
+  EntryList entries;
+  MutexLock lock(&mu_);
+  index_.clear();
+  entries.swap(entries_);
+  memory_owner_.Release(size_);
+  size_ = 0;
+  posted_reclaimer_ = false;
+}
+
+absl::optional<Duration> ResponseCache::ParseMaxAge(
+    absl::string_view cache_control) {
+  absl::optional<Duration> max_age;
+  for (absl::string_view directive : absl::StrSplit(cache_control, ',')) {
+    directive = absl::StripAsciiWhitespace(directive);
+    if (absl::EqualsIgnoreCase(directive, "no-cache") ||
+        absl::EqualsIgnoreCase(directive, "no-store")) {
+      return absl::nullopt;
+    }
+    if (absl::ConsumePrefix(&directive, "max-age=")) {
+      int64_t seconds;
+      if (!absl::SimpleAtoi(directive, &seconds) || seconds < 0) {
+        return absl::nullopt;
+      }
+      max_age = Duration::Seconds(seconds);
+    }
+  }
+  return max_age;
+}
+
+}  // namespace grpc_core
+
+static void recv_initial_metadata_ready(void* user_data,
+                                        grpc_error_handle error);
+static void recv_message_ready(void* user_data, grpc_error_handle error);
+static void recv_trailing_metadata_ready(void* user_data,
+                                         grpc_error_handle error);
+static void leader_done(void* user_data, grpc_error_handle error);
+
+namespace {
+
+// Copies every encodable element of a metadata batch into a
+// CachedResponse::Metadata, in the batch's own order.
+class MetadataRecorder {
+ public:
+  explicit MetadataRecorder(grpc_core::CachedResponse::Metadata* metadata)
+      : metadata_(metadata) {}
+
+  void Encode(const grpc_core::Slice& key, const grpc_core::Slice& value) {
+    Add(key.as_string_view(), value.as_string_view());
+  }
+
+  template <typename Which>
+  void Encode(Which, const typename Which::ValueType& value) {
+    Add(Which::key(), Which::Encode(value).as_string_view());
+  }
+
+  void Encode(grpc_core::ContentTypeMetadata,
+              grpc_core::ContentTypeMetadata::ValueType value) {
+    if (value == grpc_core::ContentTypeMetadata::kInvalid) return;
+    Add(grpc_core::ContentTypeMetadata::key(),
+        grpc_core::ContentTypeMetadata::Encode(value).as_string_view());
+  }
+
+ private:
+  // Copied, rather than reffed, so as not to keep whole transport read
+  // buffers alive in the cache.
+  void Add(absl::string_view key, absl::string_view value) {
+    metadata_->emplace_back(grpc_core::Slice::FromCopiedString(key),
+                            grpc_core::Slice::FromCopiedString(value));
+  }
+
+  grpc_core::CachedResponse::Metadata* metadata_;
+};
+
+void ReplayMetadata(const grpc_core::CachedResponse::Metadata& metadata,
+                    grpc_metadata_batch* batch) {
+  for (const auto& kv : metadata) {
+    batch->Append(kv.first.as_string_view(), kv.second.Ref(),
+                  [](absl::string_view, const grpc_core::Slice&) {});
+  }
+}
+
+struct call_data;
+
+struct channel_data {
+  grpc_core::RefCountedPtr<grpc_core::ResponseCache> cache;
+  // Whether cacheable calls wait for an identical one already in flight.
+  bool coalesce_calls = false;
+  grpc_core::Mutex mu;
+  // The calls waiting for each call in flight, by key.
+  absl::flat_hash_map<std::string, std::vector<call_data*>> in_flight
+      ABSL_GUARDED_BY(mu);
+};
+
+struct call_data {
+  enum class State {
+    // No batch seen yet.
+    kStarting,
+    // Not a cacheable call, or not one the cache can answer.
+    kPassThrough,
+    // Not cached yet: the response is recorded on its way up.
+    kRecording,
+    // Waiting for an identical call in flight to finish, with its batches
+    // held.
+    kFollowing,
+    // Answered from the cache, or with the response to an identical call.
+    kReplaying,
+  };
+
+  call_data(grpc_call_element* elem, const grpc_call_element_args& args)
+      : owning_call(args.call_stack), call_combiner(args.call_combiner) {
+    GRPC_CLOSURE_INIT(&recv_initial_metadata_ready,
+                      ::recv_initial_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_message_ready, ::recv_message_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready,
+                      ::recv_trailing_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&leader_done, ::leader_done, elem,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+  grpc_call_stack* owning_call;
+  grpc_core::CallCombiner* call_combiner;
+  State state = State::kStarting;
+  // The method, authority and request message of the call.
+  std::string key;
+  // The response replayed.
+  std::shared_ptr<const grpc_core::CachedResponse> replayed;
+  // The response being recorded.
+  std::shared_ptr<grpc_core::CachedResponse> recorded;
+  // Set while recording, once the response turns out to be of no use to
+  // other calls: a failure, or a message the filter does not record.
+  bool unusable = false;
+  // Whether other calls with the same key wait for this one.
+  bool leading = false;
+  bool saw_cache_control = false;
+  absl::optional<grpc_core::Duration> max_age;
+  bool got_message = false;
+  bool got_trailing_metadata = false;
+  // Intercepted recv ops, while recording.
+  grpc_metadata_batch* recv_initial_metadata = nullptr;
+  grpc_closure recv_initial_metadata_ready;
+  grpc_closure* original_recv_initial_metadata_ready = nullptr;
+  absl::optional<grpc_core::SliceBuffer>* recv_message = nullptr;
+  uint32_t* recv_message_flags = nullptr;
+  grpc_closure recv_message_ready;
+  grpc_closure* original_recv_message_ready = nullptr;
+  grpc_metadata_batch* recv_trailing_metadata = nullptr;
+  grpc_closure recv_trailing_metadata_ready;
+  grpc_closure* original_recv_trailing_metadata_ready = nullptr;
+  // While following.
+  absl::InlinedVector<grpc_transport_stream_op_batch*, 3> held_batches;
+  grpc_closure leader_done;
+};
+
+// Reads the max-age from the cache-control metadata in \a batch, if any.
+void MaybeReadMaxAge(call_data* calld, const grpc_metadata_batch& batch) {
+  std::string buffer;
+  auto cache_control = batch.GetStringValue("cache-control", &buffer);
+  if (!cache_control.has_value()) return;
+  calld->saw_cache_control = true;
+  calld->max_age = grpc_core::ResponseCache::ParseMaxAge(*cache_control);
+}
+
+// Hands \a response to the calls waiting for this one, or lets them go on to
+// the network themselves if it is null.
+void ReleaseFollowers(
+    grpc_call_element* elem,
+    std::shared_ptr<const grpc_core::CachedResponse> response) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (!calld->leading) return;
+  calld->leading = false;
+  std::vector<call_data*> followers;
+  {
+    grpc_core::MutexLock lock(&chand->mu);
+    auto it = chand->in_flight.find(calld->key);
+    followers = std::move(it->second);
+    chand->in_flight.erase(it);
+  }
+  for (call_data* follower : followers) {
+    follower->replayed = response;
+    GRPC_CALL_COMBINER_START(follower->call_combiner, &follower->leader_done,
+                             absl::OkStatus(), "coalesced call finished");
+  }
+}
+
+// Marks the response being recorded as of no use to other calls.
+void SetUnusable(grpc_call_element* elem) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->unusable = true;
+  ReleaseFollowers(elem, nullptr);
+}
+
+// Shares and caches the response once it is all recorded.
+void MaybeFinishRecording(grpc_call_element* elem) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->unusable || !calld->got_message ||
+      !calld->got_trailing_metadata) {
+    return;
+  }
+  calld->unusable = true;
+  ReleaseFollowers(elem, calld->recorded);
+  if (!calld->max_age.has_value() ||
+      *calld->max_age <= grpc_core::Duration::Zero()) {
+    return;
+  }
+  chand->cache->Insert(std::move(calld->key), std::move(calld->recorded),
+                       grpc_core::Timestamp::Now() + *calld->max_age);
+}
+
+// Looks up the call in the cache, given its first batch.
+void StartCall(grpc_call_element* elem, grpc_transport_stream_op_batch* op) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->state = call_data::State::kPassThrough;
+  // Only unary calls sending their whole request at once can be answered
+  // before passing anything down.
+  if (!op->send_initial_metadata || !op->send_message ||
+      !op->send_trailing_metadata) {
+    return;
+  }
+  const grpc_metadata_batch& initial_metadata =
+      *op->payload->send_initial_metadata.send_initial_metadata;
+  if (!initial_metadata.get(grpc_core::CacheableRequest()).value_or(false)) {
+    return;
+  }
+  const grpc_core::Slice* path =
+      initial_metadata.get_pointer(grpc_core::HttpPathMetadata());
+  if (path == nullptr) return;
+  const grpc_core::Slice* authority =
+      initial_metadata.get_pointer(grpc_core::HttpAuthorityMetadata());
+  const absl::string_view separator("\0", 1);
+  calld->key = absl::StrCat(
+      path->as_string_view(), separator,
+      authority == nullptr ? "" : authority->as_string_view(), separator,
+      op->payload->send_message.send_message->JoinIntoString());
+  calld->replayed =
+      chand->cache->Lookup(calld->key, grpc_core::Timestamp::Now());
+  if (calld->replayed != nullptr) {
+    calld->state = call_data::State::kReplaying;
+    calld->key.clear();
+    return;
+  }
+  if (chand->coalesce_calls) {
+    grpc_core::MutexLock lock(&chand->mu);
+    auto it = chand->in_flight.find(calld->key);
+    if (it != chand->in_flight.end()) {
+      it->second.push_back(calld);
+      calld->state = call_data::State::kFollowing;
+      GRPC_CALL_STACK_REF(calld->owning_call, "coalesced call");
+      return;
+    }
+    chand->in_flight.emplace(calld->key, std::vector<call_data*>());
+    calld->leading = true;
+  }
+  calld->state = call_data::State::kRecording;
+  calld->recorded = std::make_shared<grpc_core::CachedResponse>();
+}
+
+// Completes \a op from the replayed response, without passing it down,
+// adding its closures to \a closures.
+void Replay(call_data* calld, grpc_transport_stream_op_batch* op,
+            grpc_core::CallCombinerClosureList* closures) {
+  const grpc_core::CachedResponse& response = *calld->replayed;
+  if (op->recv_initial_metadata) {
+    ReplayMetadata(response.initial_metadata,
+                   op->payload->recv_initial_metadata.recv_initial_metadata);
+    closures->Add(
+        op->payload->recv_initial_metadata.recv_initial_metadata_ready,
+        absl::OkStatus(), "recv_initial_metadata_ready from cache");
+  }
+  if (op->recv_message) {
+    // The one message, then the end of the stream.
+    if (!calld->got_message) {
+      calld->got_message = true;
+      *op->payload->recv_message.recv_message = response.message.Copy();
+      if (op->payload->recv_message.flags != nullptr) {
+        *op->payload->recv_message.flags = response.message_flags;
+      }
+    } else {
+      op->payload->recv_message.recv_message->reset();
+    }
+    closures->Add(op->payload->recv_message.recv_message_ready,
+                  absl::OkStatus(), "recv_message_ready from cache");
+  }
+  if (op->recv_trailing_metadata) {
+    ReplayMetadata(response.trailing_metadata,
+                   op->payload->recv_trailing_metadata.recv_trailing_metadata);
+    closures->Add(
+        op->payload->recv_trailing_metadata.recv_trailing_metadata_ready,
+        absl::OkStatus(), "recv_trailing_metadata_ready from cache");
+  }
+  if (op->on_complete != nullptr) {
+    closures->Add(op->on_complete, absl::OkStatus(), "on_complete from cache");
+  }
+}
+
+// Stops waiting for the identical call in flight, on cancellation: the held
+// batches fail with \a error.
+void StopFollowing(grpc_call_element* elem, grpc_error_handle error) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  bool was_waiting = false;
+  {
+    grpc_core::MutexLock lock(&chand->mu);
+    auto it = chand->in_flight.find(calld->key);
+    if (it != chand->in_flight.end()) {
+      auto& followers = it->second;
+      auto follower = std::find(followers.begin(), followers.end(), calld);
+      if (follower != followers.end()) {
+        followers.erase(follower);
+        was_waiting = true;
+      }
+    }
+  }
+  // If the call in flight already finished, leader_done will find the call
+  // no longer following.
+  calld->state = call_data::State::kPassThrough;
+  grpc_core::CallCombinerClosureList closures;
+  for (grpc_transport_stream_op_batch* batch : calld->held_batches) {
+    grpc_transport_stream_op_batch_queue_finish_with_failure(batch, error,
+                                                             &closures);
+  }
+  calld->held_batches.clear();
+  closures.RunClosuresWithoutYielding(calld->call_combiner);
+  if (was_waiting) GRPC_CALL_STACK_UNREF(calld->owning_call, "coalesced call");
+}
+
+}  // namespace
+
+static void resume_held_batch(void* arg, grpc_error_handle /*error*/) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  grpc_call_element* elem =
+      static_cast<grpc_call_element*>(batch->handler_private.extra_arg);
+  grpc_call_next_op(elem, batch);
+}
+
+// Called in the call combiner once the call this one was waiting for
+// finished.
+static void leader_done(void* user_data, grpc_error_handle /*error*/) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  grpc_core::CallCombinerClosureList closures;
+  if (calld->state == call_data::State::kFollowing) {
+    if (calld->replayed != nullptr) {
+      calld->state = call_data::State::kReplaying;
+      for (grpc_transport_stream_op_batch* batch : calld->held_batches) {
+        Replay(calld, batch, &closures);
+      }
+    } else {
+      // The call this one waited for failed: this one goes ahead on its own.
+      calld->state = call_data::State::kPassThrough;
+      for (grpc_transport_stream_op_batch* batch : calld->held_batches) {
+        batch->handler_private.extra_arg = elem;
+        GRPC_CLOSURE_INIT(&batch->handler_private.closure, resume_held_batch,
+                          batch, nullptr);
+        closures.Add(&batch->handler_private.closure, absl::OkStatus(),
+                     "resuming batch held for a coalesced call");
+      }
+    }
+    calld->held_batches.clear();
+  }
+  closures.RunClosures(calld->call_combiner);
+  GRPC_CALL_STACK_UNREF(calld->owning_call, "coalesced call");
+}
+
+static void recv_initial_metadata_ready(void* user_data,
+                                        grpc_error_handle error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (!error.ok()) {
+    SetUnusable(elem);
+  } else if (!calld->unusable) {
+    MetadataRecorder recorder(&calld->recorded->initial_metadata);
+    calld->recv_initial_metadata->Encode(&recorder);
+    MaybeReadMaxAge(calld, *calld->recv_initial_metadata);
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION,
+                          calld->original_recv_initial_metadata_ready, error);
+}
+
+static void recv_message_ready(void* user_data, grpc_error_handle error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (!error.ok()) {
+    SetUnusable(elem);
+  } else if (calld->recv_message->has_value() && !calld->unusable) {
+    const uint32_t flags = calld->recv_message_flags == nullptr
+                               ? 0
+                               : *calld->recv_message_flags;
+    if (calld->got_message || (flags & GRPC_RECV_INTERNAL_PARTIAL) != 0) {
+      SetUnusable(elem);
+    } else {
+      calld->got_message = true;
+      calld->recorded->message.Append(grpc_core::Slice::FromCopiedString(
+          (*calld->recv_message)->JoinIntoString()));
+      calld->recorded->message_flags = flags;
+      MaybeFinishRecording(elem);
+    }
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION, calld->original_recv_message_ready,
+                          error);
+}
+
+static void recv_trailing_metadata_ready(void* user_data,
+                                         grpc_error_handle error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (!error.ok() ||
+      calld->recv_trailing_metadata->get(grpc_core::GrpcStatusMetadata()) !=
+          GRPC_STATUS_OK) {
+    SetUnusable(elem);
+  } else if (!calld->unusable) {
+    calld->got_trailing_metadata = true;
+    MetadataRecorder recorder(&calld->recorded->trailing_metadata);
+    calld->recv_trailing_metadata->Encode(&recorder);
+    if (!calld->saw_cache_control) {
+      MaybeReadMaxAge(calld, *calld->recv_trailing_metadata);
+    }
+    MaybeFinishRecording(elem);
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION,
+                          calld->original_recv_trailing_metadata_ready, error);
+}
+
+// Start transport stream op.
+static void response_cache_start_transport_stream_op_batch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* op) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->state == call_data::State::kStarting && !op->cancel_stream) {
+    StartCall(elem, op);
+  }
+  switch (calld->state) {
+    case call_data::State::kReplaying:
+      // Cancellation still goes down, for the filters below to see it.
+      if (op->cancel_stream) break;
+      {
+        grpc_core::CallCombinerClosureList closures;
+        Replay(calld, op, &closures);
+        closures.RunClosures(calld->call_combiner);
+      }
+      return;
+    case call_data::State::kFollowing:
+      if (op->cancel_stream) {
+        StopFollowing(elem, op->payload->cancel_stream.cancel_error);
+        break;
+      }
+      calld->held_batches.push_back(op);
+      GRPC_CALL_COMBINER_STOP(calld->call_combiner,
+                              "held until the coalesced call finishes");
+      return;
+    case call_data::State::kRecording:
+      if (op->recv_initial_metadata) {
+        calld->recv_initial_metadata =
+            op->payload->recv_initial_metadata.recv_initial_metadata;
+        calld->original_recv_initial_metadata_ready =
+            op->payload->recv_initial_metadata.recv_initial_metadata_ready;
+        op->payload->recv_initial_metadata.recv_initial_metadata_ready =
+            &calld->recv_initial_metadata_ready;
+      }
+      if (op->recv_message) {
+        calld->recv_message = op->payload->recv_message.recv_message;
+        calld->recv_message_flags = op->payload->recv_message.flags;
+        calld->original_recv_message_ready =
+            op->payload->recv_message.recv_message_ready;
+        op->payload->recv_message.recv_message_ready =
+            &calld->recv_message_ready;
+      }
+      if (op->recv_trailing_metadata) {
+        calld->recv_trailing_metadata =
+            op->payload->recv_trailing_metadata.recv_trailing_metadata;
+        calld->original_recv_trailing_metadata_ready =
+            op->payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+        op->payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+            &calld->recv_trailing_metadata_ready;
+      }
+      break;
+    default:
+      break;
+  }
+  // Chain to the next filter.
+  grpc_call_next_op(elem, op);
+}
+
+// Constructor for call_data.
+static grpc_error_handle response_cache_init_call_elem(
+    grpc_call_element* elem, const grpc_call_element_args* args) {
+  new (elem->call_data) call_data(elem, *args);
+  return absl::OkStatus();
+}
+
+// Destructor for call_data.
+static void response_cache_destroy_call_elem(
+    grpc_call_element* elem, const grpc_call_final_info* /*final_info*/,
+    grpc_closure* /*ignored*/) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  // Lets the calls still waiting for this one go on without it.
+  ReleaseFollowers(elem, nullptr);
+  calld->~call_data();
+}
+
+// Constructor for channel_data.
+static grpc_error_handle response_cache_init_channel_elem(
+    grpc_channel_element* elem, grpc_channel_element_args* args) {
+  GPR_ASSERT(!args->is_last);
+  auto channel_args = grpc_core::ChannelArgs::FromC(args->channel_args);
+  grpc_core::ResourceQuota* resource_quota =
+      channel_args.GetObject<grpc_core::ResourceQuota>();
+  grpc_core::MemoryOwner memory_owner =
+      (resource_quota != nullptr ? resource_quota->memory_quota()
+                                 : grpc_core::ResourceQuota::Default()
+                                       ->memory_quota())
+          ->CreateMemoryOwner("response_cache");
+  channel_data* chand = new (elem->channel_data) channel_data();
+  chand->cache = grpc_core::MakeRefCounted<grpc_core::ResponseCache>(
+      std::max(0,
+               channel_args.GetInt(GRPC_ARG_RESPONSE_CACHE_SIZE).value_or(0)),
+      std::move(memory_owner));
+  chand->coalesce_calls =
+      channel_args.GetBool(GRPC_ARG_COALESCE_CACHEABLE_CALLS).value_or(false);
+  return absl::OkStatus();
+}
+
+// Destructor for channel_data.
+static void response_cache_destroy_channel_elem(grpc_channel_element* elem) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  chand->~channel_data();
+}
+
+const grpc_channel_filter grpc_response_cache_filter = {
+    response_cache_start_transport_stream_op_batch,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(call_data),
+    response_cache_init_call_elem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    response_cache_destroy_call_elem,
+    sizeof(channel_data),
+    response_cache_init_channel_elem,
+    grpc_channel_stack_no_post_init,
+    response_cache_destroy_channel_elem,
+    grpc_channel_next_get_info,
+    "response_cache"};
+
+// Adds the filter only if GRPC_ARG_RESPONSE_CACHE_SIZE or
+// GRPC_ARG_COALESCE_CACHEABLE_CALLS is set: at the top of the stack, so that
+// the calls it answers skip name resolution and load balancing as well.
+static bool maybe_add_response_cache_filter(
+    grpc_core::ChannelStackBuilder* builder) {
+  auto channel_args = builder->channel_args();
+  if (channel_args.WantMinimalStack()) return true;
+  if (channel_args.GetInt(GRPC_ARG_RESPONSE_CACHE_SIZE).value_or(0) > 0 ||
+      channel_args.GetBool(GRPC_ARG_COALESCE_CACHEABLE_CALLS).value_or(false)) {
+    builder->PrependFilter(&grpc_response_cache_filter);
+  }
+  return true;
+}
+
+namespace grpc_core {
+void RegisterResponseCacheFilter(CoreConfiguration::Builder* builder) {
+  builder->channel_init()->RegisterStage(GRPC_CLIENT_CHANNEL,
+                                         GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                         maybe_add_response_cache_filter);
+  builder->channel_init()->RegisterStage(GRPC_CLIENT_DIRECT_CHANNEL,
+                                         GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                         maybe_add_response_cache_filter);
+}
+}  // namespace grpc_core
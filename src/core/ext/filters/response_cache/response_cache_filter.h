@@ -0,0 +1,122 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+
+// Answers unary calls made with GRPC_INITIAL_METADATA_CACHEABLE_REQUEST from
+// the responses to earlier calls sending the same request, on client channels
+// with GRPC_ARG_RESPONSE_CACHE_SIZE set. With GRPC_ARG_COALESCE_CACHEABLE_CALLS
+// set, such calls also wait for an identical call already in flight rather
+// than being sent, and share its response.
+extern const grpc_channel_filter grpc_response_cache_filter;
+
+namespace grpc_core {
+
+// A successful response to a unary call, as the filter replays it.
+struct CachedResponse {
+  // Keys and values as they came over the wire.
+  using Metadata = std::vector<std::pair<Slice, Slice>>;
+
+  // Bytes taken, counted against the cache's size.
+  size_t Size() const;
+
+  Metadata initial_metadata;
+  SliceBuffer message;
+  uint32_t message_flags = 0;
+  Metadata trailing_metadata;
+};
+
+// The responses cached by one channel, up to max_size bytes, evicting the
+// least recently used ones first. The bytes are also taken from the channel's
+// memory quota: under memory pressure nothing more is added, and the quota
+// may reclaim the whole cache.
+class ResponseCache : public RefCounted<ResponseCache> {
+ public:
+  ResponseCache(size_t max_size, MemoryOwner memory_owner);
+  ~ResponseCache() override;
+
+  // The response cached for \a key, if it has not expired by \a now.
+  std::shared_ptr<const CachedResponse> Lookup(absl::string_view key,
+                                               Timestamp now);
+  // Caches \a response for \a key until \a expiry, replacing whatever was
+  // cached before for it.
+  void Insert(std::string key, std::shared_ptr<const CachedResponse> response,
+              Timestamp expiry);
+
+  // Bytes taken by the keys and responses cached.
+  size_t size() const;
+
+  // How long a response may be cached for, from the value of its
+  // cache-control metadata: its max-age, unless no-cache or no-store say
+  // not to cache it at all.
+  static absl::optional<Duration> ParseMaxAge(absl::string_view cache_control);
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const CachedResponse> response;
+    Timestamp expiry;
+    size_t size;
+  };
+  using EntryList = std::list<Entry>;
+
+  void RemoveLocked(EntryList::iterator entry)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void PostReclaimer() ABSL_LOCKS_EXCLUDED(mu_);
+  void Reclaim() ABSL_LOCKS_EXCLUDED(mu_);
+
+  const size_t max_size_;
+  mutable Mutex mu_;
+  // Most recently used first.
+  EntryList entries_ ABSL_GUARDED_BY(mu_);
+  // Keyed by the entries' own keys.
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> index_
+      ABSL_GUARDED_BY(mu_);
+  size_t size_ ABSL_GUARDED_BY(mu_) = 0;
+  bool posted_reclaimer_ ABSL_GUARDED_BY(mu_) = false;
+  // Last, so that its reclaimer is cancelled before anything else goes.
+  MemoryOwner memory_owner_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_RESPONSE_CACHE_RESPONSE_CACHE_FILTER_H
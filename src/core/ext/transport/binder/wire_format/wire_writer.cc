@@ -114,7 +114,7 @@ absl::Status WireWriterImpl::MakeBinderTransaction(
               parcel_size);
     }
     num_outgoing_bytes_ += parcel_size;
-    gpr_log(GPR_INFO, "Total outgoing bytes: %" PRId64,
+    gpr_log(GPR_DEBUG, "Total outgoing bytes: %" PRId64,
             num_outgoing_bytes_.load());
   }
   GPR_ASSERT(!is_transacting_);
@@ -221,18 +221,19 @@ void WireWriterImpl::RunScheduledTxInternal(RunScheduledTxArgs* args) {
   GPR_ASSERT(absl::holds_alternative<RunScheduledTxArgs::StreamTx>(args->tx));
   RunScheduledTxArgs::StreamTx* stream_tx =
       &absl::get<RunScheduledTxArgs::StreamTx>(args->tx);
-  // Be reservative. Decrease CombinerTxCount after the data size of this
-  // transaction has already been added to `num_outgoing_bytes_`, to make sure
-  // we never underestimate `num_outgoing_bytes_`.
-  auto decrease_combiner_tx_count = absl::MakeCleanup([this]() {
-    {
-      grpc_core::MutexLock lock(&flow_control_mu_);
-      GPR_ASSERT(num_non_acked_tx_in_combiner_ > 0);
-      num_non_acked_tx_in_combiner_--;
-    }
-    // New transaction might be ready to be scheduled.
-    TryScheduleTransaction();
-  });
+  // Be reservative. Decrease the bytes scheduled in combiner after the data
+  // size of this transaction has already been added to `num_outgoing_bytes_`,
+  // to make sure we never underestimate `num_outgoing_bytes_`.
+  auto decrease_combiner_tx_count = absl::MakeCleanup(
+      [this, bytes_scheduled = stream_tx->bytes_scheduled]() {
+        {
+          grpc_core::MutexLock lock(&flow_control_mu_);
+          GPR_ASSERT(num_bytes_scheduled_in_combiner_ >= bytes_scheduled);
+          num_bytes_scheduled_in_combiner_ -= bytes_scheduled;
+        }
+        // New transaction might be ready to be scheduled.
+        TryScheduleTransaction();
+      });
   if (CanBeSentInOneTransaction(*stream_tx->tx.get())) {  // NOLINT
     absl::Status result = RpcCallFastPath(std::move(stream_tx->tx));
     if (!result.ok()) {
@@ -284,7 +285,7 @@ absl::Status WireWriterImpl::SendAck(int64_t num_bytes) {
   // Ensure combiner will be run if this is not called from top-level gRPC API
   // entrypoint.
   grpc_core::ExecCtx exec_ctx;
-  gpr_log(GPR_INFO, "Ack %" PRId64 " bytes received", num_bytes);
+  gpr_log(GPR_DEBUG, "Ack %" PRId64 " bytes received", num_bytes);
   if (is_transacting_) {
     // This can happen because NDK might call our registered callback function
     // in the same thread while we are telling it to send a transaction
@@ -322,7 +323,7 @@ void WireWriterImpl::OnAckReceived(int64_t num_bytes) {
   // Ensure combiner will be run if this is not called from top-level gRPC API
   // entrypoint.
   grpc_core::ExecCtx exec_ctx;
-  gpr_log(GPR_INFO, "OnAckReceived %" PRId64, num_bytes);
+  gpr_log(GPR_DEBUG, "OnAckReceived %" PRId64, num_bytes);
   // Do not try to obtain `write_mu_` in this function. NDKBinder might invoke
   // the callback to notify us about new incoming binder transaction when we are
   // sending transaction. i.e. `write_mu_` might have already been acquired by
@@ -341,6 +342,31 @@ void WireWriterImpl::OnAckReceived(int64_t num_bytes) {
   TryScheduleTransaction();
 }
 
+int64_t WireWriterImpl::EstimateNextTxSize(
+    const RunScheduledTxArgs::StreamTx& stream_tx) {
+  // Flags, sequence number and byte array length.
+  constexpr int64_t kTxHeaderSize = 3 * sizeof(int32_t);
+  const Transaction& tx = *stream_tx.tx;
+  int64_t size = kTxHeaderSize;
+  if (tx.GetFlags() & kFlagMessageData) {
+    size += static_cast<int64_t>(tx.GetMessageData().size()) -
+            stream_tx.bytes_sent;
+  }
+  if (stream_tx.bytes_sent == 0 && (tx.GetFlags() & kFlagPrefix)) {
+    size += tx.GetMethodRef().size();
+    for (const auto& md : tx.GetPrefixMetadata()) {
+      size += md.first.size() + md.second.size();
+    }
+  }
+  if (tx.GetFlags() & kFlagSuffix) {
+    size += tx.GetStatusDesc().size();
+    for (const auto& md : tx.GetSuffixMetadata()) {
+      size += md.first.size() + md.second.size();
+    }
+  }
+  return std::min(size, kBlockSize);
+}
+
 void WireWriterImpl::TryScheduleTransaction() {
   while (true) {
     grpc_core::MutexLock lock(&flow_control_mu_);
@@ -349,11 +375,8 @@ void WireWriterImpl::TryScheduleTransaction() {
       break;
     }
     // Number of bytes we have scheduled in combiner but have not yet be
-    // executed by combiner. Here we make an assumption that every binder
-    // transaction will take `kBlockSize`. This should be close to truth when a
-    // large message is being cut to `kBlockSize` chunks.
-    int64_t num_bytes_scheduled_in_combiner =
-        num_non_acked_tx_in_combiner_ * kBlockSize;
+    // executed by combiner.
+    int64_t num_bytes_scheduled_in_combiner = num_bytes_scheduled_in_combiner_;
     // An estimation of number of bytes of traffic we will eventually send to
     // the other end, assuming all tasks in combiner will be executed and we
     // receive no new ACK from the other end of transport.
@@ -371,11 +394,18 @@ void WireWriterImpl::TryScheduleTransaction() {
           "non-negative but it is %" PRId64,
           num_non_acked_bytes_estimation);
     }
-    // If we can schedule another transaction (which has size estimation of
-    // `kBlockSize`) without exceeding `kFlowControlWindowSize`, schedule it.
-    if ((num_non_acked_bytes_estimation + kBlockSize <
+    // If we can schedule another transaction without exceeding
+    // `kFlowControlWindowSize`, schedule it. Small messages are estimated by
+    // their size rather than a whole `kBlockSize`, so that a stream of them
+    // does not stall on acks long before the window is full.
+    RunScheduledTxArgs::StreamTx* stream_tx =
+        &absl::get<RunScheduledTxArgs::StreamTx>(
+            pending_outgoing_tx_.front()->tx);
+    const int64_t next_tx_size = EstimateNextTxSize(*stream_tx);
+    if ((num_non_acked_bytes_estimation + next_tx_size <
          kFlowControlWindowSize)) {
-      num_non_acked_tx_in_combiner_++;
+      stream_tx->bytes_scheduled = next_tx_size;
+      num_bytes_scheduled_in_combiner_ += next_tx_size;
       combiner_->Run(GRPC_CLOSURE_CREATE(RunScheduledTx,
                                          pending_outgoing_tx_.front(), nullptr),
                      absl::OkStatus());
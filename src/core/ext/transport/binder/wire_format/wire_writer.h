@@ -56,6 +56,9 @@ class WireWriterImpl : public WireWriter {
       std::unique_ptr<Transaction> tx;
       // How many data in transaction's `data` field has been sent.
       int64_t bytes_sent = 0;
+      // Estimated size of the next transaction, counted against the flow
+      // control window while it waits in `combiner_`.
+      int64_t bytes_scheduled = 0;
     };
     struct AckTx {
       int64_t num_bytes;
@@ -93,6 +96,10 @@ class WireWriterImpl : public WireWriter {
   // many as possible (under the constraint of `kFlowControlWindowSize`).
   void TryScheduleTransaction();
 
+  // An estimation of the size of the next transaction sent for `stream_tx`,
+  // at most `kBlockSize`.
+  static int64_t EstimateNextTxSize(const RunScheduledTxArgs::StreamTx& tx);
+
   // Guards variables related to transport state.
   grpc_core::Mutex write_mu_;
   std::unique_ptr<Binder> binder_ ABSL_GUARDED_BY(write_mu_);
@@ -112,7 +119,9 @@ class WireWriterImpl : public WireWriter {
   // The queue takes ownership of the pointer.
   std::queue<RunScheduledTxArgs*> pending_outgoing_tx_
       ABSL_GUARDED_BY(flow_control_mu_);
-  int num_non_acked_tx_in_combiner_ ABSL_GUARDED_BY(flow_control_mu_) = 0;
+  // Sum of `StreamTx::bytes_scheduled` of the transactions in `combiner_`.
+  int64_t num_bytes_scheduled_in_combiner_ ABSL_GUARDED_BY(flow_control_mu_) =
+      0;
 
   // Helper variable for determining if we are currently calling into
   // `Binder::Transact`. Useful for avoiding the attempt of acquiring
@@ -50,6 +50,8 @@
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/ext/transport/shm/shm_handshaker.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
@@ -96,6 +98,7 @@ namespace {
 
 const char kUnixUriPrefix[] = "unix:";
 const char kUnixAbstractUriPrefix[] = "unix-abstract:";
+const char kShmUriPrefix[] = "shm:";
 
 class Chttp2ServerListener : public Server::ListenerInterface {
  public:
@@ -917,6 +920,7 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
                                                     args_modifier);
   }
   *port_num = -1;
+  ChannelArgs listener_args = args;
   absl::StatusOr<std::vector<grpc_resolved_address>> resolved_or;
   std::vector<grpc_error_handle> error_list;
   std::string parsed_addr = URI::PercentDecode(addr);
@@ -930,6 +934,13 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
                                    kUnixAbstractUriPrefix)) {
       resolved_or =
           grpc_resolve_unix_abstract_domain_address(parsed_addr_unprefixed);
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+    } else if (absl::ConsumePrefix(&parsed_addr_unprefixed, kShmUriPrefix)) {
+      // Listens on a unix domain socket, and moves each connection onto
+      // shared memory.
+      resolved_or = grpc_resolve_unix_domain_address(parsed_addr_unprefixed);
+      listener_args = listener_args.Set(GRPC_ARG_SHM_TRANSPORT, true);
+#endif
     } else {
       resolved_or =
           GetDNSResolver()->LookupHostnameBlocking(parsed_addr, "https");
@@ -945,8 +956,8 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
         grpc_sockaddr_set_port(&addr, *port_num);
       }
       int port_temp = -1;
-      error = Chttp2ServerListener::Create(server, &addr, args, args_modifier,
-                                           &port_temp);
+      error = Chttp2ServerListener::Create(server, &addr, listener_args,
+                                           args_modifier, &port_temp);
       if (!error.ok()) {
         error_list.push_back(error);
       } else {
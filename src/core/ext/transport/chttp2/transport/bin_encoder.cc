@@ -27,14 +27,26 @@
 
 #include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 
-static const char alphabet[] =
+static constexpr char alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+/* The two base64 characters for every 12 bits of input. */
+struct b64_pair_table {
+  constexpr b64_pair_table() : pairs() {
+    for (int i = 0; i < 4096; i++) {
+      pairs[i][0] = alphabet[i >> 6];
+      pairs[i][1] = alphabet[i & 0x3f];
+    }
+  }
+  char pairs[4096][2];
+};
+static const b64_pair_table alphabet_pairs;
+
 struct b64_huff_sym {
   uint16_t bits;
   uint8_t length;
 };
-static const b64_huff_sym huff_alphabet[64] = {
+static constexpr b64_huff_sym huff_alphabet[64] = {
     {0x21, 6}, {0x5d, 7}, {0x5e, 7},   {0x5f, 7}, {0x60, 7}, {0x61, 7},
     {0x62, 7}, {0x63, 7}, {0x64, 7},   {0x65, 7}, {0x66, 7}, {0x67, 7},
     {0x68, 7}, {0x69, 7}, {0x6a, 7},   {0x6b, 7}, {0x6c, 7}, {0x6d, 7},
@@ -47,6 +59,24 @@ static const b64_huff_sym huff_alphabet[64] = {
     {0x2, 5},  {0x19, 6}, {0x1a, 6},   {0x1b, 6}, {0x1c, 6}, {0x1d, 6},
     {0x1e, 6}, {0x1f, 6}, {0x7fb, 11}, {0x18, 6}};
 
+/* The huffman codes of every pair of base64 symbols, indexed by the 12 bits
+   of input they encode: a triplet of input bytes is compressed with two
+   lookups rather than four. Each entry packs the code bits above a 5 bit
+   length. */
+struct b64_huff_pair_table {
+  constexpr b64_huff_pair_table() : pairs() {
+    for (uint32_t i = 0; i < 4096; i++) {
+      const b64_huff_sym a = huff_alphabet[i >> 6];
+      const b64_huff_sym b = huff_alphabet[i & 0x3f];
+      const uint32_t bits =
+          (static_cast<uint32_t>(a.bits) << b.length) | b.bits;
+      pairs[i] = (bits << 5) | (a.length + b.length);
+    }
+  }
+  uint32_t pairs[4096];
+};
+static const b64_huff_pair_table huff_alphabet_pairs;
+
 static const uint8_t tail_xtra[3] = {0, 2, 3};
 
 grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
@@ -61,10 +91,10 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
 
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    const uint32_t triplet = (static_cast<uint32_t>(in[0]) << 16) |
+                             (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    memcpy(out, alphabet_pairs.pairs[triplet >> 12], 2);
+    memcpy(out + 2, alphabet_pairs.pairs[triplet & 0xfff], 2);
     out += 4;
     in += 3;
   }
@@ -93,13 +123,57 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
+/* Bits are accumulated in a 64 bit word and written out 32 at a time; with at
+   most 31 bits pending, appending a code of up to 30 bits cannot overflow. */
+struct huff_out {
+  uint64_t temp;
+  uint32_t temp_length;
+  uint8_t* out;
+};
+
+static inline void enc_add(huff_out* out, uint32_t bits, uint32_t length) {
+  out->temp = (out->temp << length) | bits;
+  out->temp_length += length;
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
+  }
+}
+
+/* Writes out the pending bits, padding the last byte with the most
+   significant bits of EOS as required by RFC 7541 section 5.2. */
+static void enc_finish(huff_out* out) {
+  while (out->temp_length >= 8) {
+    out->temp_length -= 8;
+    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  }
+  if (out->temp_length) {
+    /* NB: the following integer arithmetic operation needs to be in its
+     * expanded form due to the "integral promotion" performed (see section
+     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
+     * is then required to avoid the compiler warning */
+    *out->out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(out->temp << (8u - out->temp_length)) |
+        static_cast<uint8_t>(0xffu >> out->temp_length));
+    out->temp_length = 0;
+  }
+}
+
+static inline void enc_add_b64_pair(huff_out* out, uint32_t index) {
+  const uint32_t pair = huff_alphabet_pairs.pairs[index];
+  enc_add(out, pair >> 5, pair & 31);
+}
+
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   size_t nbits;
   const uint8_t* in;
-  uint8_t* out;
   grpc_slice output;
-  uint64_t temp = 0;
-  uint32_t temp_length = 0;
+  huff_out out;
 
   nbits = 0;
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
@@ -108,64 +182,21 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   }
 
   output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
+  out.temp = 0;
+  out.temp_length = 0;
+  out.out = GRPC_SLICE_START_PTR(output);
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
-    }
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    enc_add(&out, sym.bits, sym.length);
   }
+  enc_finish(&out);
 
-  if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
-  }
-
-  GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
+  GPR_ASSERT(out.out == GRPC_SLICE_END_PTR(output));
 
   return output;
 }
 
-struct huff_out {
-  uint32_t temp;
-  uint32_t temp_length;
-  uint8_t* out;
-};
-static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
-  }
-}
-
-static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
-  b64_huff_sym sa = huff_alphabet[a];
-  b64_huff_sym sb = huff_alphabet[b];
-  out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
-  out->temp_length +=
-      static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
-  enc_flush_some(out);
-}
-
-static void enc_add1(huff_out* out, uint8_t a) {
-  b64_huff_sym sa = huff_alphabet[a];
-  out->temp = (out->temp << sa.length) | sa.bits;
-  out->temp_length += sa.length;
-  enc_flush_some(out);
-}
-
 grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
@@ -186,13 +217,10 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
 
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    const uint32_t triplet = (static_cast<uint32_t>(in[0]) << 16) |
+                             (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    enc_add_b64_pair(&out, triplet >> 12);
+    enc_add_b64_pair(&out, triplet & 0xfff);
     in += 3;
   }
 
@@ -201,28 +229,19 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     case 0:
       break;
     case 1:
-      enc_add2(&out, in[0] >> 2, static_cast<uint8_t>((in[0] & 0x3) << 4));
+      enc_add_b64_pair(&out, static_cast<uint32_t>(in[0]) << 4);
       in += 1;
       break;
     case 2: {
-      const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-      const uint8_t high_to_low = in[1] >> 4;
-      enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-      enc_add1(&out, static_cast<uint8_t>((in[1] & 0xf) << 2));
+      const uint32_t pair = (static_cast<uint32_t>(in[0]) << 4) | (in[1] >> 4);
+      enc_add_b64_pair(&out, pair);
+      const b64_huff_sym sym = huff_alphabet[(in[1] & 0xf) << 2];
+      enc_add(&out, sym.bits, sym.length);
       in += 2;
       break;
     }
   }
-
-  if (out.temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
-  }
+  enc_finish(&out);
 
   GPR_ASSERT(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
@@ -56,6 +56,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/chttp2/transport/keepalive_schedule.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -137,6 +138,10 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void start_write_locked(grpc_chttp2_transport* t, const char* reason);
+static void write_coalescing_timer_expired(void* t, grpc_error_handle error);
+static void write_coalescing_timer_expired_locked(void* t,
+                                                  grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -158,10 +163,19 @@ static void connectivity_state_set(grpc_chttp2_transport* t,
                                    const char* reason);
 
 static void benign_reclaimer_locked(void* arg, grpc_error_handle error);
+static void idle_reclaimer_locked(void* arg, grpc_error_handle error);
 static void destructive_reclaimer_locked(void* arg, grpc_error_handle error);
 
 static void post_benign_reclaimer(grpc_chttp2_transport* t);
+static void post_idle_reclaimer(grpc_chttp2_transport* t);
 static void post_destructive_reclaimer(grpc_chttp2_transport* t);
+static void maybe_unshrink_after_memory_pressure(grpc_chttp2_transport* t);
+static void update_hpack_table_sizes(grpc_chttp2_transport* t);
+
+static void maybe_arm_hibernation_timer(grpc_chttp2_transport* t);
+static void hibernation_timer_expired(void* t, grpc_error_handle error);
+static void hibernation_timer_expired_locked(void* t, grpc_error_handle error);
+static void wake_from_hibernation(grpc_chttp2_transport* t);
 
 static void close_transport_locked(grpc_chttp2_transport* t,
                                    grpc_error_handle error);
@@ -190,6 +204,8 @@ static void start_keepalive_ping_locked(void* arg, grpc_error_handle error);
 static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error);
 static void keepalive_watchdog_fired(void* arg, grpc_error_handle error);
 static void keepalive_watchdog_fired_locked(void* arg, grpc_error_handle error);
+static void schedule_keepalive_ping_locked(grpc_chttp2_transport* t,
+                                           grpc_core::Timestamp from);
 
 namespace grpc_core {
 
@@ -309,6 +325,25 @@ static void read_channel_args(grpc_chttp2_transport* t,
   t->write_buffer_size =
       std::max(0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)
                       .value_or(grpc_core::chttp2::kDefaultWindow));
+  // With TCP_NOTSENT_LOWAT, the endpoint completes a write only once the
+  // socket is nearly drained, so frames are picked as late as the socket
+  // allows if each write is no larger than the low water mark.
+  const int notsent_lowat =
+      std::max(0, channel_args.GetInt(GRPC_ARG_TCP_NOTSENT_LOWAT).value_or(0));
+  if (notsent_lowat > 0) {
+    t->target_write_size =
+        std::min(t->target_write_size, static_cast<uint32_t>(notsent_lowat));
+  }
+  t->write_coalescing_bytes =
+      std::max(0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES)
+                      .value_or(0));
+  t->write_coalescing_window = grpc_core::Duration::MicrosecondsRoundUp(
+      std::max(0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US)
+                      .value_or(0)));
+  t->idle_hibernation_timeout = std::max(
+      grpc_core::Duration::Zero(),
+      channel_args.GetDurationFromIntMillis(GRPC_ARG_IDLE_HIBERNATION_MS)
+          .value_or(grpc_core::Duration::Zero()));
   t->keepalive_time =
       std::max(grpc_core::Duration::Milliseconds(1),
                channel_args.GetDurationFromIntMillis(GRPC_ARG_KEEPALIVE_TIME_MS)
@@ -333,7 +368,10 @@ static void read_channel_args(grpc_chttp2_transport* t,
             absl::StrFormat("%s %s", get_vtable()->name, t->peer_string),
             channel_args
                 .GetObjectRef<grpc_core::channelz::SocketNode::Security>());
+    grpc_endpoint_set_channelz_socket(t->ep, t->channelz_socket.get());
   }
+  t->rtt_observer =
+      channel_args.GetObjectRef<grpc_core::TransportRttObserver>();
 
   static const struct {
     absl::string_view channel_arg_name;
@@ -433,12 +471,8 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
   if (t->keepalive_time != grpc_core::Duration::Infinity()) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::Timestamp::Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    t->last_read_time = grpc_core::Timestamp::Now();
+    schedule_keepalive_ping_locked(t, t->last_read_time);
   } else {
     // Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
     //   inflight keeaplive timers
@@ -478,7 +512,11 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   //   large enough that the exponential growth should happen nicely when it's
   //   needed.
   //   TODO(ctiller): tune this
-  grpc_chttp2_stream_map_init(&stream_map, 8);
+  if (grpc_core::IsChttp2HashedStreamMapEnabled()) {
+    grpc_chttp2_stream_map_init_open_addressing(&stream_map, 8);
+  } else {
+    grpc_chttp2_stream_map_init(&stream_map, 8);
+  }
 
   grpc_slice_buffer_init(&read_buffer);
   grpc_slice_buffer_init(&outbuf);
@@ -511,6 +549,15 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   init_transport_keepalive_settings(this);
 
   read_channel_args(this, channel_args, is_client);
+  if (channel_args.GetBool(GRPC_ARG_UDS_MEMFD_DATA_ENABLED).value_or(false) &&
+      grpc_chttp2_memfd_data_supported(ep)) {
+    memfd_data_min_bytes = static_cast<uint32_t>(std::max(
+        1, channel_args.GetInt(GRPC_ARG_UDS_MEMFD_DATA_MIN_BYTES)
+               .value_or(1024 * 1024)));
+    queue_setting_update(this, GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_MEMFD_DATA, 1);
+  }
+  hpack_decoder_table_size =
+      settings[GRPC_LOCAL_SETTINGS][GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE];
 
   // No pings allowed before receiving a header or data frame.
   ping_state.pings_before_data_required = 0;
@@ -530,6 +577,9 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   grpc_chttp2_initiate_write(this, GRPC_CHTTP2_INITIATE_WRITE_INITIAL_WRITE);
   post_benign_reclaimer(this);
+  post_idle_reclaimer(this);
+  last_busy_time = grpc_core::Timestamp::Now();
+  maybe_arm_hibernation_timer(this);
   if (grpc_core::test_only_init_callback != nullptr) {
     grpc_core::test_only_init_callback();
   }
@@ -562,6 +612,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
       error = grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
                                  GRPC_STATUS_UNAVAILABLE);
     }
+    if (t->write_corked &&
+        t->write_state == GRPC_CHTTP2_WRITE_STATE_WRITING) {
+      start_write_locked(t, "flush corked write before close");
+    }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
       if (t->close_transport_on_writes_finished.ok()) {
         t->close_transport_on_writes_finished =
@@ -582,6 +636,12 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     if (t->have_next_bdp_ping_timer) {
       grpc_timer_cancel(&t->next_bdp_ping_timer);
     }
+    if (t->have_write_coalescing_timer) {
+      grpc_timer_cancel(&t->write_coalescing_timer);
+    }
+    if (t->have_hibernation_timer) {
+      grpc_timer_cancel(&t->hibernation_timer);
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
         grpc_timer_cancel(&t->keepalive_ping_timer);
@@ -653,9 +713,15 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
     id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(server_data));
     *t->accepting_stream = this;
     grpc_chttp2_stream_map_add(&t->stream_map, id, this);
+    wake_from_hibernation(t);
     post_destructive_reclaimer(t);
   }
 
+  if (grpc_core::IsChttp2ParallelStreamDeliveryEnabled()) {
+    delivery_queue =
+        grpc_core::MakeRefCounted<grpc_core::chttp2::StreamDeliveryQueue>();
+  }
+
   grpc_slice_buffer_init(&frame_storage);
   grpc_slice_buffer_init(&flow_controlled_buffer);
 }
@@ -774,8 +840,24 @@ static void set_write_state(grpc_chttp2_transport* t,
   }
 }
 
+// Whether frames written for \a reason may wait in a corked write (see
+// GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES) for frames from other streams.
+static bool write_reason_can_be_coalesced(
+    grpc_chttp2_initiate_write_reason reason) {
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
+  if (!write_reason_can_be_coalesced(reason)) t->write_urgent = true;
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
@@ -805,6 +887,15 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
+      // A corked write has not reached the endpoint yet, so rather than
+      // waiting for it to finish, add the new frames to it now and check
+      // again whether it is big enough to send.
+      if (t->write_corked) {
+        t->combiner->FinallyRun(
+            GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
+                              write_action_begin_locked, t, nullptr),
+            absl::OkStatus());
+      }
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
@@ -826,6 +917,59 @@ static const char* begin_writing_desc(bool partial) {
   }
 }
 
+// Whether to hold back the frames in outbuf, hoping that more will follow
+// before the write coalescing window closes.
+static bool should_cork_write(grpc_chttp2_transport* t) {
+  if (t->write_coalescing_bytes == 0 ||
+      t->write_coalescing_window == grpc_core::Duration::Zero() ||
+      t->write_urgent || t->outbuf.length >= t->write_coalescing_bytes ||
+      !t->close_transport_on_writes_finished.ok()) {
+    return false;
+  }
+  return !t->write_corked ||
+         grpc_core::Timestamp::Now() < t->write_cork_deadline;
+}
+
+static void cork_write_locked(grpc_chttp2_transport* t) {
+  set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING, "cork write");
+  if (t->write_corked) return;
+  t->write_corked = true;
+  t->write_cork_deadline =
+      grpc_core::Timestamp::Now() + t->write_coalescing_window;
+  // A timer armed for an earlier window re-arms itself for this one.
+  if (!t->have_write_coalescing_timer) {
+    t->have_write_coalescing_timer = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "write_coalescing");
+    GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                      write_coalescing_timer_expired, t,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&t->write_coalescing_timer, t->write_cork_deadline,
+                    &t->write_coalescing_timer_expired_locked);
+  }
+}
+
+// Hands outbuf to the endpoint. The write state must already reflect whether
+// more frames are waiting.
+static void start_write_locked(grpc_chttp2_transport* t, const char* reason) {
+  GRPC_CHTTP2_IF_TRACING(gpr_log(GPR_INFO, "W:%p start write [%s]", t, reason));
+  t->write_corked = false;
+  t->write_urgent = false;
+  write_action(t, absl::OkStatus());
+  if (t->reading_paused_on_pending_induced_frames) {
+    GPR_ASSERT(t->num_pending_induced_frames == 0);
+    // We had paused reading, because we had many induced frames (SETTINGS
+    // ACK, PINGS ACK and RST_STREAMS) pending in t->qbuf. Now that we have
+    // been able to flush qbuf, we can resume reading.
+    GRPC_CHTTP2_IF_TRACING(gpr_log(
+        GPR_INFO,
+        "transport %p : Resuming reading after being paused due to too "
+        "many unwritten SETTINGS ACK, PINGS ACK and RST_STREAM frames",
+        t));
+    t->reading_paused_on_pending_induced_frames = false;
+    continue_read_action_locked(t);
+  }
+}
+
 static void write_action_begin_locked(void* gt,
                                       grpc_error_handle /*error_ignored*/) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
@@ -837,30 +981,54 @@ static void write_action_begin_locked(void* gt,
     r = grpc_chttp2_begin_write(t);
   }
   if (r.writing) {
+    if (!r.partial && should_cork_write(t)) {
+      cork_write_locked(t);
+      return;
+    }
     set_write_state(t,
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
                     begin_writing_desc(r.partial));
-    write_action(t, absl::OkStatus());
-    if (t->reading_paused_on_pending_induced_frames) {
-      GPR_ASSERT(t->num_pending_induced_frames == 0);
-      // We had paused reading, because we had many induced frames (SETTINGS
-      // ACK, PINGS ACK and RST_STREAMS) pending in t->qbuf. Now that we have
-      // been able to flush qbuf, we can resume reading.
-      GRPC_CHTTP2_IF_TRACING(gpr_log(
-          GPR_INFO,
-          "transport %p : Resuming reading after being paused due to too "
-          "many unwritten SETTINGS ACK, PINGS ACK and RST_STREAM frames",
-          t));
-      t->reading_paused_on_pending_induced_frames = false;
-      continue_read_action_locked(t);
-    }
+    start_write_locked(t, begin_writing_desc(r.partial));
   } else {
     set_write_state(t, GRPC_CHTTP2_WRITE_STATE_IDLE, "begin writing nothing");
     GRPC_CHTTP2_UNREF_TRANSPORT(t, "writing");
   }
 }
 
+static void write_coalescing_timer_expired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                        write_coalescing_timer_expired_locked, t, nullptr),
+      error);
+}
+
+static void write_coalescing_timer_expired_locked(void* tp,
+                                                  grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->have_write_coalescing_timer);
+  t->have_write_coalescing_timer = false;
+  if (t->write_corked) {
+    if (error.ok() && grpc_core::Timestamp::Now() < t->write_cork_deadline) {
+      // This timer was armed for an earlier window; wait for the current one.
+      t->have_write_coalescing_timer = true;
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                        write_coalescing_timer_expired, t,
+                        grpc_schedule_on_exec_ctx);
+      grpc_timer_init(&t->write_coalescing_timer, t->write_cork_deadline,
+                      &t->write_coalescing_timer_expired_locked);
+      return;
+    }
+    // In WRITING_WITH_MORE a write_action_begin_locked is already queued and
+    // will see that the window has closed.
+    if (t->write_state == GRPC_CHTTP2_WRITE_STATE_WRITING) {
+      start_write_locked(t, "write coalescing window closed");
+    }
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalescing");
+}
+
 static void write_action(void* gt, grpc_error_handle /*error*/) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
@@ -875,6 +1043,8 @@ static void write_action(void* gt, grpc_error_handle /*error*/) {
           ? 2 * t->settings[GRPC_PEER_SETTINGS]
                            [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]
           : INT_MAX;
+  // Every memfd queued so far goes along with this write.
+  t->memfds_in_outbuf = 0;
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1070,6 +1240,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
     }
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
+    wake_from_hibernation(t);
     post_destructive_reclaimer(t);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
@@ -1114,6 +1285,19 @@ static void null_then_sched_closure(grpc_closure** closure) {
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, c, absl::OkStatus());
 }
 
+// As null_then_sched_closure, for the closures completing the receive ops of
+// \a s.
+static void null_then_sched_recv_closure(grpc_chttp2_stream* s,
+                                         grpc_closure** closure) {
+  if (s->delivery_queue == nullptr) {
+    null_then_sched_closure(closure);
+    return;
+  }
+  grpc_closure* c = *closure;
+  *closure = nullptr;
+  s->delivery_queue->Run(c);
+}
+
 void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
                                        grpc_chttp2_stream* /*s*/,
                                        grpc_closure** pclosure,
@@ -1236,6 +1420,7 @@ static void perform_stream_op_locked(void* stream_op,
           s->deadline,
           s->send_initial_metadata->get(grpc_core::GrpcTimeoutMetadata())
               .value_or(grpc_core::Timestamp::InfFuture()));
+      grpc_chttp2_set_stream_write_weight(s, *s->send_initial_metadata);
     }
     if (contains_non_ok_status(s->send_initial_metadata)) {
       s->seen_error = true;
@@ -1790,7 +1975,7 @@ void grpc_chttp2_maybe_complete_recv_initial_metadata(grpc_chttp2_transport* t,
       *s->trailing_metadata_available = true;
       s->trailing_metadata_available = nullptr;
     }
-    null_then_sched_closure(&s->recv_initial_metadata_ready);
+    null_then_sched_recv_closure(s, &s->recv_initial_metadata_ready);
   }
 }
 
@@ -1807,6 +1992,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
   [&]() {
     if (s->final_metadata_requested && s->seen_error) {
       grpc_slice_buffer_reset_and_unref(&s->frame_storage);
+      s->recv_message_remaining = 0;
       s->recv_message->reset();
     } else {
       if (s->frame_storage.length != 0) {
@@ -1818,6 +2004,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
           if (absl::holds_alternative<grpc_core::Pending>(r)) {
             if (s->read_closed) {
               grpc_slice_buffer_reset_and_unref(&s->frame_storage);
+              s->recv_message_remaining = 0;
               s->recv_message->reset();
               break;
             } else {
@@ -1831,7 +2018,8 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
               grpc_slice_buffer_reset_and_unref(&s->frame_storage);
               break;
             } else {
-              if (t->channelz_socket != nullptr) {
+              if (t->channelz_socket != nullptr &&
+                  s->recv_message_remaining == 0) {
                 t->channelz_socket->RecordMessageReceived();
               }
               break;
@@ -1839,6 +2027,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
           }
         }
       } else if (s->read_closed) {
+        s->recv_message_remaining = 0;
         s->recv_message->reset();
       } else {
         upd.SetMinProgressSize(GRPC_HEADER_SIZE_IN_BYTES);
@@ -1848,13 +2037,13 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
     // save the length of the buffer before handing control back to application
     // threads. Needed to support correct flow control bookkeeping
     if (error.ok() && s->recv_message->has_value()) {
-      null_then_sched_closure(&s->recv_message_ready);
+      null_then_sched_recv_closure(s, &s->recv_message_ready);
     } else if (s->published_metadata[1] != GRPC_METADATA_NOT_PUBLISHED) {
       if (s->call_failed_before_recv_message != nullptr) {
         *s->call_failed_before_recv_message =
             (s->published_metadata[1] != GRPC_METADATA_PUBLISHED_AT_CLOSE);
       }
-      null_then_sched_closure(&s->recv_message_ready);
+      null_then_sched_recv_closure(s, &s->recv_message_ready);
     }
   }();
 
@@ -1876,7 +2065,7 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
       s->collecting_stats = nullptr;
       *s->recv_trailing_metadata = std::move(s->trailing_metadata_buffer);
       s->recv_trailing_metadata->Set(grpc_core::PeerString(), t->peer_string);
-      null_then_sched_closure(&s->recv_trailing_metadata_finished);
+      null_then_sched_recv_closure(s, &s->recv_trailing_metadata_finished);
     }
   }
 }
@@ -1892,7 +2081,9 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
   }
 
   if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
-    post_benign_reclaimer(t);
+    post_idle_reclaimer(t);
+    t->last_busy_time = grpc_core::Timestamp::Now();
+    maybe_arm_hibernation_timer(t);
     if (t->sent_goaway_state == GRPC_CHTTP2_FINAL_GOAWAY_SENT) {
       close_transport_locked(
           t, GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
@@ -1972,7 +2163,8 @@ static void add_error(grpc_error_handle error, grpc_error_handle* refs,
   ++*nrefs;
 }
 
-static grpc_error_handle removal_error(grpc_error_handle extra_error,
+static grpc_error_handle removal_error(grpc_chttp2_transport* t,
+                                       grpc_error_handle extra_error,
                                        grpc_chttp2_stream* s,
                                        const char* main_error_msg) {
   grpc_error_handle refs[3];
@@ -1980,12 +2172,21 @@ static grpc_error_handle removal_error(grpc_error_handle extra_error,
   add_error(s->read_closed_error, refs, &nrefs);
   add_error(s->write_closed_error, refs, &nrefs);
   add_error(extra_error, refs, &nrefs);
-  grpc_error_handle error;
-  if (nrefs > 0) {
-    error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(main_error_msg,
-                                                             refs, nrefs);
+  if (nrefs == 0) return absl::OkStatus();
+  if (nrefs == 1) {
+    for (auto& cached : t->removal_errors) {
+      if (cached.message == nullptr) cached.message = main_error_msg;
+      if (cached.message != main_error_msg) continue;
+      if (cached.cause != refs[0]) {
+        cached.cause = refs[0];
+        cached.error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+            main_error_msg, refs, nrefs);
+      }
+      return cached.error;
+    }
   }
-  return error;
+  return GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(main_error_msg, refs,
+                                                          nrefs);
 }
 
 static void flush_write_list(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
@@ -2005,7 +2206,7 @@ void grpc_chttp2_fail_pending_writes(grpc_chttp2_transport* t,
                                      grpc_chttp2_stream* s,
                                      grpc_error_handle error) {
   error =
-      removal_error(error, s, "Pending writes failed due to stream closure");
+      removal_error(t, error, s, "Pending writes failed due to stream closure");
   s->send_initial_metadata = nullptr;
   grpc_chttp2_complete_closure_step(t, s, &s->send_initial_metadata_finished,
                                     error, "send_initial_metadata_finished");
@@ -2026,7 +2227,8 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
                                     int close_writes, grpc_error_handle error) {
   if (s->read_closed && s->write_closed) {
     // already closed, but we should still fake the status if needed.
-    grpc_error_handle overall_error = removal_error(error, s, "Stream removed");
+    grpc_error_handle overall_error =
+        removal_error(t, error, s, "Stream removed");
     if (!overall_error.ok()) {
       grpc_chttp2_fake_status(t, s, overall_error);
     }
@@ -2047,7 +2249,8 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
   }
   if (s->read_closed && s->write_closed) {
     became_closed = true;
-    grpc_error_handle overall_error = removal_error(error, s, "Stream removed");
+    grpc_error_handle overall_error =
+        removal_error(t, error, s, "Stream removed");
     if (s->id != 0) {
       remove_stream(t, s->id, overall_error);
     } else {
@@ -2329,6 +2532,32 @@ static grpc_error_handle try_http_parsing(grpc_chttp2_transport* t) {
   return error;
 }
 
+// Confines the refcounts of the slices just read that nothing else refers
+// to, so that the refs the frame parsers take on them, such as those of
+// data frames and metadata, are counted without atomics while the combiner
+// parses them.  release_read_buffer_locked() makes them atomic again before
+// anything parsed can reach another thread, which is when the closures the
+// parsers schedule on the ExecCtx run.  Parallel stream delivery runs them
+// on the EventEngine right away, so the two don't mix.
+static void confine_read_buffer_locked(grpc_chttp2_transport* t) {
+  for (size_t i = 0; i < t->read_buffer.count; i++) {
+    grpc_slice_refcount* refcount = t->read_buffer.slices[i].refcount;
+    if (reinterpret_cast<uintptr_t>(refcount) > 1) refcount->TryConfine();
+  }
+}
+
+static void release_read_buffer_locked(grpc_chttp2_transport* t) {
+  for (size_t i = 0; i < t->read_buffer.count; i++) {
+    grpc_slice& slice = t->read_buffer.slices[i];
+    if (reinterpret_cast<uintptr_t>(slice.refcount) > 1 &&
+        slice.refcount->confined()) {
+      slice.refcount->UnrefAndShare();
+      slice = grpc_empty_slice();
+    }
+  }
+  grpc_slice_buffer_reset_and_unref(&t->read_buffer);
+}
+
 static void read_action(void* tp, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
   t->combiner->Run(
@@ -2347,6 +2576,10 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
                              t->write_state);
   }
   std::swap(err, error);
+  const bool confine_reads =
+      grpc_core::IsChttp2ConfinedReadSlicesEnabled() &&
+      !grpc_core::IsChttp2ParallelStreamDeliveryEnabled();
+  if (confine_reads) confine_read_buffer_locked(t);
   if (t->closed_with_error.ok()) {
     size_t i = 0;
     grpc_error_handle errors[3] = {error, absl::OkStatus(), absl::OkStatus()};
@@ -2391,11 +2624,18 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
   } else if (t->closed_with_error.ok()) {
     keep_reading = true;
     // Since we have read a byte, reset the keepalive timer
-    if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
+    if (grpc_core::IsKeepaliveCoalescingEnabled()) {
+      t->last_read_time = grpc_core::Timestamp::Now();
+    } else if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
       grpc_timer_cancel(&t->keepalive_ping_timer);
     }
+    maybe_unshrink_after_memory_pressure(t);
+  }
+  if (confine_reads) {
+    release_read_buffer_locked(t);
+  } else {
+    grpc_slice_buffer_reset_and_unref(&t->read_buffer);
   }
-  grpc_slice_buffer_reset_and_unref(&t->read_buffer);
 
   if (keep_reading) {
     if (t->num_pending_induced_frames >= DEFAULT_MAX_PENDING_INDUCED_FRAMES) {
@@ -2450,8 +2690,11 @@ static void start_bdp_ping_locked(void* tp, grpc_error_handle error) {
   if (!error.ok() || !t->closed_with_error.ok()) {
     return;
   }
-  // Reset the keepalive ping timer
-  if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
+  // Reset the keepalive ping timer. With keepalive_coalescing, the ack of the
+  // BDP ping counts as a read from the peer, and a keepalive ping due before
+  // it arrives piggybacks on it.
+  if (!grpc_core::IsKeepaliveCoalescingEnabled() &&
+      t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
     grpc_timer_cancel(&t->keepalive_ping_timer);
   }
   t->flow_control.bdp_estimator()->StartPing();
@@ -2486,6 +2729,9 @@ static void finish_bdp_ping_locked(void* tp, grpc_error_handle error) {
   t->bdp_ping_started = false;
   grpc_core::Timestamp next_ping =
       t->flow_control.bdp_estimator()->CompletePing();
+  if (t->rtt_observer != nullptr) {
+    t->rtt_observer->OnRttSample(t->flow_control.bdp_estimator()->LastRtt());
+  }
   grpc_chttp2_act_on_flowctl_action(t->flow_control.PeriodicUpdate(), t,
                                     nullptr);
   GPR_ASSERT(!t->have_next_bdp_ping_timer);
@@ -2594,20 +2840,22 @@ static void init_keepalive_ping_locked(void* arg, grpc_error_handle error) {
   if (t->destroying || !t->closed_with_error.ok()) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_DYING;
   } else if (error.ok()) {
-    if (t->keepalive_permit_without_calls ||
-        grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
+    if (grpc_core::IsKeepaliveCoalescingEnabled() &&
+        grpc_core::chttp2::KeepaliveDeadline(t->last_read_time,
+                                             t->keepalive_time) >
+            grpc_core::Timestamp::Now()) {
+      // We heard from the peer since the timer was armed: no need to ping it
+      // until keepalive_time after that.
+      schedule_keepalive_ping_locked(t, t->last_read_time);
+    } else if (t->keepalive_permit_without_calls ||
+               grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_PINGING;
       GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive ping end");
       grpc_timer_init_unset(&t->keepalive_watchdog_timer);
       send_keepalive_ping_locked(t);
       grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_KEEPALIVE_PING);
     } else {
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::Timestamp::Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      schedule_keepalive_ping_locked(t, grpc_core::Timestamp::Now());
     }
   } else if (error == absl::CancelledError()) {
     // The keepalive ping timer may be cancelled by bdp
@@ -2616,16 +2864,26 @@ static void init_keepalive_ping_locked(void* arg, grpc_error_handle error) {
       gpr_log(GPR_INFO, "%s: Keepalive ping cancelled. Resetting timer.",
               t->peer_string.c_str());
     }
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::Timestamp::Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    schedule_keepalive_ping_locked(t, grpc_core::Timestamp::Now());
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
 }
 
+// Arms the keepalive ping timer for keepalive_time after from, aligned to
+// the slots of KeepaliveDeadline with keepalive_coalescing.
+static void schedule_keepalive_ping_locked(grpc_chttp2_transport* t,
+                                           grpc_core::Timestamp from) {
+  const grpc_core::Timestamp deadline =
+      grpc_core::IsKeepaliveCoalescingEnabled()
+          ? grpc_core::chttp2::KeepaliveDeadline(from, t->keepalive_time)
+          : from + t->keepalive_time;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
+  GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->keepalive_ping_timer, deadline,
+                  &t->init_keepalive_ping_locked);
+}
+
 static void start_keepalive_ping(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   t->combiner->Run(GRPC_CLOSURE_INIT(&t->start_keepalive_ping_locked,
@@ -2681,12 +2939,8 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error) {
       t->keepalive_ping_started = false;
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(&t->keepalive_watchdog_timer);
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::Timestamp::Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      t->last_read_time = grpc_core::Timestamp::Now();
+      schedule_keepalive_ping_locked(t, t->last_read_time);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "keepalive ping end");
@@ -2754,10 +3008,79 @@ static void set_pollset_set(grpc_transport* gt, grpc_stream* /*gs*/,
   grpc_endpoint_add_to_pollset_set(t->ep, pollset_set);
 }
 
+//
+// IDLE HIBERNATION
+//
+
+static void maybe_arm_hibernation_timer(grpc_chttp2_transport* t) {
+  if (t->idle_hibernation_timeout == grpc_core::Duration::Zero() ||
+      t->have_hibernation_timer || t->hibernating ||
+      !t->closed_with_error.ok()) {
+    return;
+  }
+  t->have_hibernation_timer = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "hibernation_timer");
+  GRPC_CLOSURE_INIT(&t->hibernation_timer_expired_locked,
+                    hibernation_timer_expired, t, grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->hibernation_timer,
+                  t->last_busy_time + t->idle_hibernation_timeout,
+                  &t->hibernation_timer_expired_locked);
+}
+
+static void hibernation_timer_expired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->hibernation_timer_expired_locked,
+                        hibernation_timer_expired_locked, t, nullptr),
+      error);
+}
+
+static void hibernation_timer_expired_locked(void* tp,
+                                             grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->have_hibernation_timer);
+  t->have_hibernation_timer = false;
+  // With streams, the timer is armed again when the last one goes away.
+  if (error.ok() && t->closed_with_error.ok() &&
+      grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+    if (grpc_core::Timestamp::Now() <
+        t->last_busy_time + t->idle_hibernation_timeout) {
+      // Streams came and went since the timer was armed.
+      maybe_arm_hibernation_timer(t);
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+        gpr_log(GPR_INFO, "HTTP2: %s - hibernate idle transport",
+                t->peer_string.c_str());
+      }
+      t->hibernating = true;
+      update_hpack_table_sizes(t);
+      grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+    }
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "hibernation_timer");
+}
+
+// Gives a hibernating transport its HPACK tables back, for the stream about to
+// start or arrive.
+static void wake_from_hibernation(grpc_chttp2_transport* t) {
+  if (!t->hibernating) return;
+  t->hibernating = false;
+  update_hpack_table_sizes(t);
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+}
+
 //
 // RESOURCE QUOTAS
 //
 
+// HPACK table size used by both ends while under memory pressure.
+static constexpr uint32_t kMemoryPressureHpackTableSize = 1024;
+// Streams with up to this many bytes of unparsed data copy them out of the
+// larger read buffers they point into, so those can be freed.
+static constexpr size_t kMaxCompactedFrameStorage = 16 * 1024;
+// Table sizes are restored once memory pressure is back below this.
+static constexpr double kUnshrinkMemoryPressure = 0.5;
+
 static void post_benign_reclaimer(grpc_chttp2_transport* t) {
   if (!t->benign_reclaimer_registered) {
     t->benign_reclaimer_registered = true;
@@ -2778,6 +3101,26 @@ static void post_benign_reclaimer(grpc_chttp2_transport* t) {
   }
 }
 
+static void post_idle_reclaimer(grpc_chttp2_transport* t) {
+  if (!t->idle_reclaimer_registered) {
+    t->idle_reclaimer_registered = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "idle_reclaimer");
+    t->memory_owner.PostReclaimer(
+        grpc_core::ReclamationPass::kIdle,
+        [t](absl::optional<grpc_core::ReclamationSweep> sweep) {
+          if (sweep.has_value()) {
+            GRPC_CLOSURE_INIT(&t->idle_reclaimer_locked,
+                              idle_reclaimer_locked, t,
+                              grpc_schedule_on_exec_ctx);
+            t->active_reclamation = std::move(*sweep);
+            t->combiner->Run(&t->idle_reclaimer_locked, absl::OkStatus());
+          } else {
+            GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_reclaimer");
+          }
+        });
+  }
+}
+
 static void post_destructive_reclaimer(grpc_chttp2_transport* t) {
   if (!t->destructive_reclaimer_registered) {
     t->destructive_reclaimer_registered = true;
@@ -2793,13 +3136,91 @@ static void post_destructive_reclaimer(grpc_chttp2_transport* t) {
             t->combiner->Run(&t->destructive_reclaimer_locked,
                              absl::OkStatus());
           } else {
-            GRPC_CHTTP2_UNREF_TRANSPORT(t, "benign_reclaimer");
+            GRPC_CHTTP2_UNREF_TRANSPORT(t, "destructive_reclaimer");
           }
         });
   }
 }
 
+// Copies what is left of the data of stream s out of the read buffers it
+// points into.
+static void compact_frame_storage(void* user_data, uint32_t /*key*/,
+                                  void* stream) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(user_data);
+  grpc_chttp2_stream* s = static_cast<grpc_chttp2_stream*>(stream);
+  const size_t length = s->frame_storage.length;
+  if (length == 0 || length > kMaxCompactedFrameStorage) return;
+  if (s->frame_storage.count == 1 &&
+      s->frame_storage.slices[0].refcount == nullptr) {
+    return;
+  }
+  grpc_slice compacted =
+      t->memory_owner.MakeSlice(grpc_core::MemoryRequest(length));
+  grpc_slice_buffer_move_first_into_buffer(&s->frame_storage, length,
+                                           GRPC_SLICE_START_PTR(compacted));
+  grpc_slice_buffer_add(&s->frame_storage, compacted);
+}
+
 static void benign_reclaimer_locked(void* arg, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  t->benign_reclaimer_registered = false;
+  if (error.ok() && t->closed_with_error.ok() &&
+      !t->shrunk_for_memory_pressure) {
+    // Shrink the HPACK tables of both ends: the encoder's right away, the
+    // decoder's once the peer acknowledges the new setting.
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+      gpr_log(GPR_INFO, "HTTP2: %s - shrink hpack tables to free memory",
+              t->peer_string.c_str());
+    }
+    t->shrunk_for_memory_pressure = true;
+    update_hpack_table_sizes(t);
+    grpc_chttp2_stream_map_for_each(&t->stream_map, compact_frame_storage, t);
+    // The flow control windows follow memory pressure: update them now rather
+    // than at the next bdp ping.
+    if (t->flow_control.bdp_probe()) {
+      grpc_chttp2_act_on_flowctl_action(t->flow_control.PeriodicUpdate(), t,
+                                        nullptr);
+    }
+    grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+  }
+  if (error != absl::CancelledError()) {
+    t->active_reclamation.Finish();
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "benign_reclaimer");
+}
+
+// Gives the HPACK tables their sizes back once memory pressure has eased, and
+// gets ready to shrink them again.
+static void maybe_unshrink_after_memory_pressure(grpc_chttp2_transport* t) {
+  if (!t->shrunk_for_memory_pressure ||
+      t->memory_owner.GetPressureInfo().instantaneous_pressure >=
+          kUnshrinkMemoryPressure) {
+    return;
+  }
+  t->shrunk_for_memory_pressure = false;
+  update_hpack_table_sizes(t);
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+  post_benign_reclaimer(t);
+}
+
+// Sizes the HPACK tables of both ends for the state of the transport: dropped
+// while hibernating, small under memory pressure. The decoder's changes once
+// the peer acknowledges the new setting.
+static void update_hpack_table_sizes(grpc_chttp2_transport* t) {
+  uint32_t encoder_size = grpc_core::HPackCompressor::kMaxTableSize;
+  uint32_t decoder_size = t->hpack_decoder_table_size;
+  if (t->hibernating) {
+    encoder_size = decoder_size = 0;
+  } else if (t->shrunk_for_memory_pressure) {
+    encoder_size = kMemoryPressureHpackTableSize;
+    decoder_size = std::min(decoder_size, kMemoryPressureHpackTableSize);
+  }
+  t->hpack_compressor.SetMemoryPressureLimit(encoder_size);
+  queue_setting_update(t, GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE,
+                       decoder_size);
+}
+
+static void idle_reclaimer_locked(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   if (error.ok() && grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     // Channel with no active streams: send a goaway to try and make it
@@ -2815,16 +3236,16 @@ static void benign_reclaimer_locked(void* arg, grpc_error_handle error) {
                 /*immediate_disconnect_hint=*/true);
   } else if (error.ok() && GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
     gpr_log(GPR_INFO,
-            "HTTP2: %s - skip benign reclamation, there are still %" PRIdPTR
+            "HTTP2: %s - skip idle reclamation, there are still %" PRIdPTR
             " streams",
             t->peer_string.c_str(),
             grpc_chttp2_stream_map_size(&t->stream_map));
   }
-  t->benign_reclaimer_registered = false;
+  t->idle_reclaimer_registered = false;
   if (error != absl::CancelledError()) {
     t->active_reclamation.Finish();
   }
-  GRPC_CHTTP2_UNREF_TRANSPORT(t, "benign_reclaimer");
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_reclaimer");
 }
 
 static void destructive_reclaimer_locked(void* arg, grpc_error_handle error) {
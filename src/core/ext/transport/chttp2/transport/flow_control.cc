@@ -268,6 +268,44 @@ TransportFlowControl::TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
   }
 }
 
+double TransportFlowControl::TargetInitialWindowSizeBasedOnModel() const {
+  // The bytes in flight on the path: what the BDP pings saw arrive within a
+  // round trip, or the bandwidth they measured over the shortest round trip.
+  const double bdp = std::max(
+      static_cast<double>(bdp_estimator_.EstimateBdp()),
+      bdp_estimator_.EstimateBandwidth() * bdp_estimator_.MinRtt().seconds());
+  // Leave room for the next ping to see more bytes arrive: a window of twice
+  // the estimate once it is stable, and of four times while it grows, so
+  // that it ramps up 4x per ping instead of 2x on long fat paths. Unlike the
+  // PID controller, this does not lag behind (and then overshoot) the
+  // estimate.
+  const double target = bdp * (bdp_estimator_.EstimateGrowing() ? 4 : 2);
+  // Cap the window by the memory the transport may use: any window below
+  // half memory pressure, then linearly down to nothing at full pressure.
+  const double memory_pressure =
+      memory_owner_->is_valid()
+          ? memory_owner_->GetPressureInfo().pressure_control_value
+          : 0.0;
+  const double kFullWindowPressure = 0.5;
+  double max_window = kMaxInitialWindowSize;
+  if (memory_pressure >= 1.0) {
+    max_window = 0;
+  } else if (memory_pressure > kFullWindowPressure) {
+    max_window *= (1.0 - memory_pressure) / (1.0 - kFullWindowPressure);
+  }
+  return std::min(target, max_window);
+}
+
+double TransportFlowControl::TargetInitialWindowSize() {
+  if (IsModelBasedFlowControlEnabled()) {
+    return TargetInitialWindowSizeBasedOnModel();
+  }
+  if (IsMemoryPressureControllerEnabled()) {
+    return TargetInitialWindowSizeBasedOnMemoryPressureAndBdp();
+  }
+  return pow(2, SmoothLogBdp(TargetLogBdp()));
+}
+
 void TransportFlowControl::UpdateSetting(
     grpc_chttp2_setting_id id, int64_t* desired_value,
     uint32_t new_desired_value, FlowControlAction* action,
@@ -300,11 +338,9 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
       // target might change based on how much memory pressure we are under
       // TODO(ncteisen): experiment with setting target to be huge under low
       // memory pressure.
-      uint32_t target = static_cast<uint32_t>(RoundUpToPowerOf2(
-          Clamp(IsMemoryPressureControllerEnabled()
-                    ? TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
-                    : pow(2, SmoothLogBdp(TargetLogBdp())),
-                0.0, static_cast<double>(kMaxInitialWindowSize))));
+      uint32_t target = static_cast<uint32_t>(
+          RoundUpToPowerOf2(Clamp(TargetInitialWindowSize(), 0.0,
+                                  static_cast<double>(kMaxInitialWindowSize))));
       if (target < kMinPositiveInitialWindowSize) target = 0;
       if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
         // Hook for simulating unusual flow control situations in tests.
@@ -326,9 +362,7 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
       // target might change based on how much memory pressure we are under
       // TODO(ncteisen): experiment with setting target to be huge under low
       // memory pressure.
-      double target = IsMemoryPressureControllerEnabled()
-                          ? TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
-                          : pow(2, SmoothLogBdp(TargetLogBdp()));
+      double target = TargetInitialWindowSize();
       if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
         // Hook for simulating unusual flow control situations in tests.
         target = g_test_only_transport_target_window_estimates_mocker
@@ -257,6 +257,8 @@ class TransportFlowControl final {
   double TargetLogBdp();
   double SmoothLogBdp(double value);
   double TargetInitialWindowSizeBasedOnMemoryPressureAndBdp() const;
+  double TargetInitialWindowSizeBasedOnModel() const;
+  double TargetInitialWindowSize();
   static void UpdateSetting(grpc_chttp2_setting_id id, int64_t* desired_value,
                             uint32_t new_desired_value,
                             FlowControlAction* action,
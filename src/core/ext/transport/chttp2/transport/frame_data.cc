@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 
@@ -78,11 +80,41 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   stats->data_bytes += write_bytes;
 }
 
+// Parts of a message received in parts are at least this long, except its
+// last one.
+static constexpr uint32_t kMinRecvMessagePart = 16384;
+
 grpc_core::Poll<grpc_error_handle> grpc_deframe_unprocessed_incoming_frames(
     grpc_chttp2_stream* s, uint32_t* min_progress_size,
     grpc_core::SliceBuffer* stream_out, uint32_t* message_flags) {
   grpc_slice_buffer* slices = &s->frame_storage;
   grpc_error_handle error;
+  const bool accept_partial =
+      message_flags != nullptr &&
+      (*message_flags & GRPC_RECV_INTERNAL_ACCEPT_PARTIAL) != 0;
+
+  if (s->recv_message_remaining > 0) {
+    // The rest of a message received in parts.
+    const uint32_t wanted =
+        std::min(s->recv_message_remaining, kMinRecvMessagePart);
+    const uint32_t part = static_cast<uint32_t>(std::min<size_t>(
+        slices->length, s->recv_message_remaining));
+    if (part < wanted) {
+      if (min_progress_size != nullptr) *min_progress_size = wanted - part;
+      return grpc_core::Pending{};
+    }
+    if (min_progress_size != nullptr) *min_progress_size = 0;
+    s->recv_message_remaining -= part;
+    if (message_flags != nullptr) {
+      *message_flags =
+          s->recv_message_remaining > 0 ? GRPC_RECV_INTERNAL_PARTIAL : 0;
+    }
+    if (stream_out != nullptr) {
+      s->stats.incoming.data_bytes += part;
+      grpc_slice_buffer_move_first(slices, part, stream_out->c_slice_buffer());
+    }
+    return absl::OkStatus();
+  }
 
   if (slices->length < 5) {
     if (min_progress_size != nullptr) *min_progress_size = 5 - slices->length;
@@ -115,10 +147,30 @@ grpc_core::Poll<grpc_error_handle> grpc_deframe_unprocessed_incoming_frames(
                     static_cast<uint32_t>(header[4]);
 
   if (slices->length < length + 5) {
-    if (min_progress_size != nullptr) {
-      *min_progress_size = length + 5 - slices->length;
+    // Compressed messages are decompressed whole.
+    if (!accept_partial || header[0] != 0) {
+      if (min_progress_size != nullptr) {
+        *min_progress_size = length + 5 - slices->length;
+      }
+      return grpc_core::Pending{};
     }
-    return grpc_core::Pending{};
+    const uint32_t part = slices->length - 5;
+    if (part < kMinRecvMessagePart) {
+      if (min_progress_size != nullptr) {
+        *min_progress_size = kMinRecvMessagePart - part;
+      }
+      return grpc_core::Pending{};
+    }
+    if (min_progress_size != nullptr) *min_progress_size = 0;
+    s->recv_message_remaining = static_cast<uint32_t>(length) - part;
+    *message_flags = GRPC_RECV_INTERNAL_PARTIAL;
+    if (stream_out != nullptr) {
+      s->stats.incoming.framing_bytes += 5;
+      s->stats.incoming.data_bytes += part;
+      grpc_slice_buffer_move_first_into_buffer(slices, 5, header);
+      grpc_slice_buffer_move_first(slices, part, stream_out->c_slice_buffer());
+    }
+    return absl::OkStatus();
   }
 
   if (min_progress_size != nullptr) *min_progress_size = 0;
@@ -0,0 +1,260 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/frame_memfd_data.h"
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#if defined(GRPC_LINUX_MEMFD) && defined(GRPC_POSIX_SOCKET_TCP)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/slice/slice_refcount_base.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+namespace {
+
+constexpr size_t kFrameSize = 13;
+
+// Nothing can change the payload once the receiver has checked it, and
+// nothing can shrink it from under the receiver's mapping.
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_WRITE;
+
+// Writes the first \a length bytes of \a buf to \a fd without consuming them.
+bool WriteSlices(int fd, grpc_slice_buffer* buf, size_t length) {
+  constexpr size_t kMaxIovecs = 64;
+  struct iovec iov[kMaxIovecs];
+  size_t slice_idx = 0;
+  size_t slice_offset = 0;
+  off_t offset = 0;
+  while (static_cast<size_t>(offset) < length) {
+    size_t iov_count = 0;
+    size_t batch = 0;
+    size_t idx = slice_idx;
+    size_t idx_offset = slice_offset;
+    while (iov_count < kMaxIovecs && offset + batch < length) {
+      grpc_slice& slice = buf->slices[idx];
+      const size_t n = std::min(GRPC_SLICE_LENGTH(slice) - idx_offset,
+                                length - offset - batch);
+      iov[iov_count].iov_base = GRPC_SLICE_START_PTR(slice) + idx_offset;
+      iov[iov_count].iov_len = n;
+      ++iov_count;
+      batch += n;
+      ++idx;
+      idx_offset = 0;
+    }
+    ssize_t written;
+    do {
+      written = pwritev(fd, iov, static_cast<int>(iov_count), offset);
+    } while (written < 0 && errno == EINTR);
+    if (written <= 0) return false;
+    offset += written;
+    // Skip over what was written.
+    size_t skip = static_cast<size_t>(written);
+    while (skip > 0) {
+      const size_t left = GRPC_SLICE_LENGTH(buf->slices[slice_idx]) -
+                          slice_offset;
+      if (skip < left) {
+        slice_offset += skip;
+        break;
+      }
+      skip -= left;
+      ++slice_idx;
+      slice_offset = 0;
+    }
+  }
+  return true;
+}
+
+// Unmaps a received payload once its slice goes away.
+class MappedPayload : public grpc_slice_refcount {
+ public:
+  MappedPayload(void* mapping, size_t length)
+      : grpc_slice_refcount(Destroy), mapping_(mapping), length_(length) {}
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* payload = static_cast<MappedPayload*>(p);
+    munmap(payload->mapping_, payload->length_);
+    delete payload;
+  }
+
+  void* const mapping_;
+  const size_t length_;
+};
+
+grpc_error_handle MapPayload(int fd, uint32_t length, grpc_slice* data) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) return GRPC_OS_ERROR(errno, "fstat");
+  if (static_cast<uint64_t>(st.st_size) != length) {
+    return GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrFormat(
+        "memfd data frame of %d bytes has a %d byte descriptor", length,
+        static_cast<int64_t>(st.st_size)));
+  }
+  const int seals = fcntl(fd, F_GET_SEALS);
+  if (seals < 0 || (seals & kRequiredSeals) != kRequiredSeals) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "memfd data frame has an unsealed descriptor");
+  }
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) return GRPC_OS_ERROR(errno, "mmap");
+  data->refcount = new MappedPayload(mapping, length);
+  data->data.refcounted.bytes = static_cast<uint8_t*>(mapping);
+  data->data.refcounted.length = length;
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+bool grpc_chttp2_memfd_data_supported(grpc_endpoint* ep) {
+  return grpc_tcp_can_pass_fds(ep);
+}
+
+bool grpc_chttp2_encode_memfd_data(grpc_endpoint* ep, uint32_t id,
+                                   grpc_slice_buffer* inbuf,
+                                   uint32_t write_bytes, int is_eof,
+                                   grpc_transport_one_way_stats* stats,
+                                   grpc_slice_buffer* outbuf) {
+  GPR_ASSERT(write_bytes > 0 && write_bytes <= inbuf->length);
+  int fd = static_cast<int>(syscall(SYS_memfd_create, "grpc-data",
+                                    MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (fd < 0) return false;
+  if (ftruncate(fd, write_bytes) != 0 || !WriteSlices(fd, inbuf, write_bytes) ||
+      fcntl(fd, F_ADD_SEALS,
+            F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+    gpr_log(GPR_DEBUG, "cannot pass %u bytes as a memfd: errno=%d",
+            write_bytes, errno);
+    close(fd);
+    return false;
+  }
+  grpc_slice hdr = GRPC_SLICE_MALLOC(kFrameSize);
+  uint8_t* p = GRPC_SLICE_START_PTR(hdr);
+  *p++ = 0;
+  *p++ = 0;
+  *p++ = 4;
+  *p++ = GRPC_CHTTP2_FRAME_GRPC_MEMFD_DATA;
+  *p++ = is_eof ? GRPC_CHTTP2_DATA_FLAG_END_STREAM : 0;
+  *p++ = static_cast<uint8_t>(id >> 24);
+  *p++ = static_cast<uint8_t>(id >> 16);
+  *p++ = static_cast<uint8_t>(id >> 8);
+  *p++ = static_cast<uint8_t>(id);
+  *p++ = static_cast<uint8_t>(write_bytes >> 24);
+  *p++ = static_cast<uint8_t>(write_bytes >> 16);
+  *p++ = static_cast<uint8_t>(write_bytes >> 8);
+  *p++ = static_cast<uint8_t>(write_bytes);
+  grpc_slice_buffer_add(outbuf, hdr);
+  grpc_tcp_queue_fd_for_write(ep, fd);
+
+  grpc_slice_buffer sent;
+  grpc_slice_buffer_init(&sent);
+  grpc_slice_buffer_move_first(inbuf, write_bytes, &sent);
+  grpc_slice_buffer_destroy(&sent);
+
+  stats->framing_bytes += kFrameSize;
+  stats->data_bytes += write_bytes;
+  return true;
+}
+
+grpc_error_handle grpc_chttp2_memfd_data_parser_parse(
+    grpc_chttp2_memfd_data_parser* parser, grpc_endpoint* ep,
+    const grpc_slice& slice, int is_last, grpc_slice* data) {
+  const uint8_t* cur = GRPC_SLICE_START_PTR(slice);
+  const uint8_t* const end = GRPC_SLICE_END_PTR(slice);
+  while (parser->byte != 4 && cur != end) {
+    parser->length |= static_cast<uint32_t>(*cur) << (8 * (3 - parser->byte));
+    cur++;
+    parser->byte++;
+  }
+  if (parser->byte != 4) return absl::OkStatus();
+  GPR_ASSERT(is_last);
+  if (parser->length == 0) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("empty memfd data frame");
+  }
+  const int fd = grpc_tcp_take_received_fd(ep);
+  if (fd < 0) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "memfd data frame arrived without its descriptor");
+  }
+  grpc_error_handle error = MapPayload(fd, parser->length, data);
+  close(fd);
+  return error;
+}
+
+#else  // !(GRPC_LINUX_MEMFD && GRPC_POSIX_SOCKET_TCP)
+
+bool grpc_chttp2_memfd_data_supported(grpc_endpoint* /*ep*/) { return false; }
+
+bool grpc_chttp2_encode_memfd_data(grpc_endpoint* /*ep*/, uint32_t /*id*/,
+                                   grpc_slice_buffer* /*inbuf*/,
+                                   uint32_t /*write_bytes*/, int /*is_eof*/,
+                                   grpc_transport_one_way_stats* /*stats*/,
+                                   grpc_slice_buffer* /*outbuf*/) {
+  return false;
+}
+
+grpc_error_handle grpc_chttp2_memfd_data_parser_parse(
+    grpc_chttp2_memfd_data_parser* /*parser*/, grpc_endpoint* /*ep*/,
+    const grpc_slice& /*slice*/, int /*is_last*/, grpc_slice* /*data*/) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "memfd data frames are not supported on this platform");
+}
+
+#endif  // GRPC_LINUX_MEMFD && GRPC_POSIX_SOCKET_TCP
+
+grpc_error_handle grpc_chttp2_memfd_data_parser_begin_frame(
+    grpc_chttp2_memfd_data_parser* parser, uint32_t length, uint8_t flags,
+    uint32_t stream_id) {
+  if ((flags & ~GRPC_CHTTP2_DATA_FLAG_END_STREAM) != 0 || length != 4 ||
+      stream_id == 0) {
+    return GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrFormat(
+        "invalid memfd data frame: length=%d, flags=%02x, stream=%d", length,
+        flags, stream_id));
+  }
+  parser->byte = 0;
+  parser->length = 0;
+  return absl::OkStatus();
+}
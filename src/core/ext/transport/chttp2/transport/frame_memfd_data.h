@@ -0,0 +1,66 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_MEMFD_DATA_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_MEMFD_DATA_H
+
+// An extension frame that stands in for a DATA frame whose payload travels
+// beside the connection, in a sealed memfd passed over the unix domain socket
+// underneath it (see GRPC_ARG_UDS_MEMFD_DATA_ENABLED). Its own payload is just
+// the 32-bit length of the DATA payload, which counts against flow control as
+// though it had been sent inline. Peers only send it once told that the other
+// side accepts it, through the GRPC_ALLOW_MEMFD_DATA setting.
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+
+#include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/transport/transport.h"
+
+struct grpc_chttp2_memfd_data_parser {
+  uint8_t byte;
+  uint32_t length;
+};
+
+// Whether DATA payloads can be passed to the peer of \a ep as memfds.
+bool grpc_chttp2_memfd_data_supported(grpc_endpoint* ep);
+
+// Copies the first \a write_bytes of \a inbuf into a sealed memfd, queues it
+// to be passed over \a ep, and appends a frame standing in for a DATA frame
+// with those bytes to \a outbuf. Returns false, leaving everything untouched,
+// if the memfd cannot be made. Requires grpc_chttp2_memfd_data_supported(ep).
+bool grpc_chttp2_encode_memfd_data(grpc_endpoint* ep, uint32_t id,
+                                   grpc_slice_buffer* inbuf,
+                                   uint32_t write_bytes, int is_eof,
+                                   grpc_transport_one_way_stats* stats,
+                                   grpc_slice_buffer* outbuf);
+
+grpc_error_handle grpc_chttp2_memfd_data_parser_begin_frame(
+    grpc_chttp2_memfd_data_parser* parser, uint32_t length, uint8_t flags,
+    uint32_t stream_id);
+// Once \a is_last, sets \a data to the DATA payload, mapped from the oldest
+// descriptor received over \a ep. The caller owns the slice.
+grpc_error_handle grpc_chttp2_memfd_data_parser_parse(
+    grpc_chttp2_memfd_data_parser* parser, grpc_endpoint* ep,
+    const grpc_slice& slice, int is_last, grpc_slice* data);
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_MEMFD_DATA_H
@@ -33,9 +33,44 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/no_destruct.h"
 #include "src/core/lib/transport/http2_errors.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
+namespace {
+
+grpc_error_handle MakeRstStreamError(uint32_t reason) {
+  return grpc_error_set_int(
+      grpc_error_set_str(
+          absl::UnknownError("RST_STREAM"), GRPC_ERROR_STR_GRPC_MESSAGE,
+          absl::StrCat("Received RST_STREAM with error code ", reason)),
+      GRPC_ERROR_INT_HTTP2_ERROR, static_cast<intptr_t>(reason));
+}
+
+// The errors for the codes of RFC 7540, built once: a peer that cancels many
+// streams, or goes away with many open, then costs a reference per stream
+// rather than an error built and formatted for each. These carry no creation
+// location or time, which would be the same for every one of them anyway.
+class RstStreamErrors {
+ public:
+  RstStreamErrors() {
+    for (uint32_t reason = 0; reason < kNumReasons; reason++) {
+      errors_[reason] = MakeRstStreamError(reason);
+    }
+  }
+
+  grpc_error_handle Get(uint32_t reason) const {
+    if (reason < kNumReasons) return errors_[reason];
+    return MakeRstStreamError(reason);
+  }
+
+ private:
+  static constexpr uint32_t kNumReasons = GRPC_HTTP2_INADEQUATE_SECURITY + 1;
+  grpc_error_handle errors_[kNumReasons];
+};
+
+}  // namespace
+
 grpc_slice grpc_chttp2_rst_stream_create(uint32_t id, uint32_t code,
                                          grpc_transport_one_way_stats* stats) {
   static const size_t frame_size = 13;
@@ -114,12 +149,8 @@ grpc_error_handle grpc_chttp2_rst_stream_parser_parse(void* parser,
     }
     grpc_error_handle error;
     if (reason != GRPC_HTTP2_NO_ERROR || s->trailing_metadata_buffer.empty()) {
-      error = grpc_error_set_int(
-          grpc_error_set_str(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING("RST_STREAM"),
-              GRPC_ERROR_STR_GRPC_MESSAGE,
-              absl::StrCat("Received RST_STREAM with error code ", reason)),
-          GRPC_ERROR_INT_HTTP2_ERROR, static_cast<intptr_t>(reason));
+      error = grpc_core::NoDestructSingleton<RstStreamErrors>::Get()->Get(
+          reason);
     }
     grpc_chttp2_mark_stream_closed(t, s, true, true, error);
   }
@@ -0,0 +1,71 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/frame_size_policy.h"
+
+#include <algorithm>
+
+namespace grpc_core {
+namespace chttp2 {
+
+namespace {
+// A sample spanning longer than this most likely includes a time when we had
+// nothing to send, and would underestimate the peer.
+constexpr Duration kMaxSampleInterval = Duration::Seconds(1);
+// The weight of a new sample in the drain rate estimate.
+constexpr double kSampleWeight = 0.25;
+}  // namespace
+
+constexpr uint32_t FrameSizePolicy::kMinFrameSize;
+constexpr Duration FrameSizePolicy::kFrameBudget;
+constexpr Duration FrameSizePolicy::kSampleInterval;
+
+void FrameSizePolicy::PeerDrained(uint32_t bytes, Timestamp now) {
+  const Duration elapsed = now - sample_start_;
+  if (sample_start_ == Timestamp::InfPast() || elapsed > kMaxSampleInterval) {
+    // The time these bytes took to drain is unknown: start a new sample.
+    sample_start_ = now;
+    sample_bytes_ = 0;
+    return;
+  }
+  sample_bytes_ += bytes;
+  if (elapsed < kSampleInterval) return;
+  const double rate = static_cast<double>(sample_bytes_) / elapsed.seconds();
+  if (drain_bytes_per_second_ <= 0) {
+    drain_bytes_per_second_ = rate;
+  } else {
+    drain_bytes_per_second_ +=
+        kSampleWeight * (rate - drain_bytes_per_second_);
+  }
+  sample_start_ = now;
+  sample_bytes_ = 0;
+}
+
+uint32_t FrameSizePolicy::FrameSize(uint32_t peer_max_frame_size,
+                                    size_t pending_bytes,
+                                    bool contended) const {
+  if (!contended || pending_bytes <= kMinFrameSize) return peer_max_frame_size;
+  const double budget_bytes = drain_bytes_per_second_ * kFrameBudget.seconds();
+  if (budget_bytes >= peer_max_frame_size) return peer_max_frame_size;
+  return std::min(
+      peer_max_frame_size,
+      std::max(kMinFrameSize, static_cast<uint32_t>(budget_bytes)));
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
@@ -0,0 +1,77 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_SIZE_POLICY_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_SIZE_POLICY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+// Chooses the size of the DATA frames the transport writes.
+//
+// A stream that is the only one with data to write, or whose pending data
+// fits in a minimum sized frame, is framed up to the maximum frame size of
+// the peer: there is nothing to interleave with it.
+//
+// When several streams are writable, the frames of bulk streams are sized
+// to what the peer drains in kFrameBudget, measured from the transport
+// window updates it sends, between kMinFrameSize and the maximum frame size
+// of the peer. A busy stream then holds the connection for a bounded time
+// before a smaller stream gets its turn, and a peer that reads fast still
+// gets large frames.
+class FrameSizePolicy {
+ public:
+  // The smallest maximum frame size a peer can advertise (RFC 7540 6.5.2).
+  static constexpr uint32_t kMinFrameSize = 16384;
+  static constexpr Duration kFrameBudget = Duration::Milliseconds(1);
+
+  // Notes that the peer returned bytes of transport window at now.
+  void PeerDrained(uint32_t bytes, Timestamp now);
+
+  // Returns the size of the next DATA frame of a stream with pending_bytes
+  // to send; contended tells whether other streams are waiting to write.
+  uint32_t FrameSize(uint32_t peer_max_frame_size, size_t pending_bytes,
+                     bool contended) const;
+
+  // The estimated rate at which the peer drains the connection, if known.
+  absl::optional<double> drain_bytes_per_second() const {
+    if (drain_bytes_per_second_ <= 0) return absl::nullopt;
+    return drain_bytes_per_second_;
+  }
+
+ private:
+  // Window updates are folded into the estimate once they span this long,
+  // so that a burst of updates read together is not taken for a fast peer.
+  static constexpr Duration kSampleInterval = Duration::Milliseconds(10);
+
+  double drain_bytes_per_second_ = 0;
+  Timestamp sample_start_ = Timestamp::InfPast();
+  uint64_t sample_bytes_ = 0;
+};
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_SIZE_POLICY_H
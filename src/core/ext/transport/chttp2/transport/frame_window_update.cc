@@ -30,6 +30,7 @@
 
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/gprpp/time.h"
 
 grpc_slice grpc_chttp2_window_update_create(
     uint32_t id, uint32_t window_delta, grpc_transport_one_way_stats* stats) {
@@ -111,6 +112,8 @@ grpc_error_handle grpc_chttp2_window_update_parser_parse(
       grpc_core::chttp2::TransportFlowControl::OutgoingUpdateContext upd(
           &t->flow_control);
       upd.RecvUpdate(received_update);
+      t->frame_size_policy.PeerDrained(received_update,
+                                       grpc_core::Timestamp::Now());
       if (upd.Finish() == grpc_core::chttp2::StallEdge::kUnstalled) {
         grpc_chttp2_initiate_write(
             t, GRPC_CHTTP2_INITIATE_WRITE_TRANSPORT_FLOW_CONTROL_UNSTALLED);
@@ -23,6 +23,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
 
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
@@ -33,6 +37,8 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/surface/validate_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
 
@@ -42,6 +48,70 @@ namespace {
 
 constexpr size_t kDataFrameHeaderSize = 9;
 
+// Process wide cache of the wire form of "literal header field with
+// incremental indexing -- new name" for headers that many connections send
+// (method paths, user-agent, te, ...). Each connection still has to teach its
+// peer's decode table these headers once, but with the cache that costs one
+// slice ref instead of re-encoding them, and since the encoding is done once
+// the strings are also huffman compressed when that makes them shorter.
+class LiteralCache {
+ public:
+  static LiteralCache* Get() {
+    static NoDestruct<LiteralCache> cache;
+    return cache.get();
+  }
+
+  // Returns the encoded header, or an empty slice if it's not cached and the
+  // cache is full.
+  Slice Lookup(absl::string_view key, absl::string_view value) {
+    MutexLock lock(&mu_);
+    auto key_it = entries_.find(key);
+    if (key_it != entries_.end()) {
+      auto value_it = key_it->second.find(value);
+      if (value_it != key_it->second.end()) return value_it->second.Ref();
+    }
+    if (bytes_ >= kMaxBytes) return Slice();
+    Slice encoded = Encode(key, value);
+    bytes_ += encoded.size();
+    if (key_it == entries_.end()) {
+      key_it = entries_.emplace(std::string(key), ValueMap()).first;
+    }
+    key_it->second.emplace(std::string(value), encoded.Ref());
+    return encoded;
+  }
+
+ private:
+  using ValueMap = absl::flat_hash_map<std::string, Slice>;
+
+  // Bounds the memory used by peers sending many distinct values (e.g.
+  // unregistered method paths); once full, further headers are encoded per
+  // connection as before.
+  static constexpr size_t kMaxBytes = 64 * 1024;
+
+  static void AppendString(absl::string_view str, std::string* out) {
+    Slice huff(grpc_chttp2_huffman_compress(
+        Slice::FromStaticString(str).c_slice()));
+    const bool use_huff = huff.size() < str.size();
+    absl::string_view wire = use_huff ? huff.as_string_view() : str;
+    VarintWriter<1> len(wire.size());
+    uint8_t prefix[VarintLength(UINT32_MAX) + 1];
+    len.Write(use_huff ? 0x80 : 0x00, prefix);
+    out->append(reinterpret_cast<const char*>(prefix), len.length());
+    out->append(wire.data(), wire.size());
+  }
+
+  static Slice Encode(absl::string_view key, absl::string_view value) {
+    std::string out(1, '\x40');
+    AppendString(key, &out);
+    AppendString(value, &out);
+    return Slice::FromCopiedString(std::move(out));
+  }
+
+  Mutex mu_;
+  absl::flat_hash_map<std::string, ValueMap> entries_ ABSL_GUARDED_BY(mu_);
+  size_t bytes_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
 } /* namespace */
 
 /* fills p (which is expected to be kDataFrameHeaderSize bytes long)
@@ -309,6 +379,19 @@ void HPackCompressor::Framer::EmitLitHdrWithNonBinaryStringKeyNotIdx(
   Add(emit.data());
 }
 
+void HPackCompressor::Framer::EmitCacheableLitHdrIncIdx(absl::string_view key,
+                                                        const Slice& value) {
+  if (compressor_->use_literal_cache_) {
+    Slice encoded = LiteralCache::Get()->Lookup(key, value.as_string_view());
+    if (!encoded.empty()) {
+      Add(std::move(encoded));
+      return;
+    }
+  }
+  EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(key),
+                                         value.Ref());
+}
+
 void HPackCompressor::Framer::AdvertiseTableSizeChange() {
   VarintWriter<3> w(compressor_->table_.max_size());
   w.Write(0x20, AddTiny(w.length()));
@@ -336,8 +419,7 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
       } else {
         // Not current, emit a new literal and update the index.
         it->index = table.AllocateIndex(transport_length);
-        framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(
-            Slice::FromStaticString(key), value.Ref());
+        framer->EmitCacheableLitHdrIncIdx(key, value);
       }
       // Bubble this entry up if we can - ensures that the most used values end
       // up towards the start of the array.
@@ -355,12 +437,27 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
   }
   // No hit, emit a new literal and add it to the index.
   uint32_t index = table.AllocateIndex(transport_length);
-  framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(key),
-                                                 value.Ref());
+  framer->EmitCacheableLitHdrIncIdx(key, value);
   values_.emplace_back(value.Ref(), index);
 }
 
+void HPackCompressor::SliceIndex::ForgetEvicted(
+    const HPackEncoderTable& table) {
+  values_.erase(std::remove_if(values_.begin(), values_.end(),
+                               [&table](const ValueIndex& value) {
+                                 return !table.ConvertableToDynamicIndex(
+                                     value.index);
+                               }),
+                values_.end());
+  values_.shrink_to_fit();
+}
+
 void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
+  if (compressor_->index_authorization_ &&
+      key.as_string_view() == "authorization") {
+    EncodeAuthorization(value);
+    return;
+  }
   if (absl::EndsWith(key.as_string_view(), "-bin")) {
     EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
   } else {
@@ -412,6 +509,12 @@ void HPackCompressor::Framer::Encode(HttpSchemeMetadata,
   }
 }
 
+void HPackCompressor::Framer::Encode(GrpcCompressionDictionaryMetadata,
+                                     const Slice& slice) {
+  compressor_->compression_dictionary_index_.EmitTo(
+      GrpcCompressionDictionaryMetadata::key(), slice, this);
+}
+
 void HPackCompressor::Framer::Encode(GrpcTraceBinMetadata, const Slice& slice) {
   EncodeRepeatingSliceValue(GrpcTraceBinMetadata::key(), slice,
                             &compressor_->grpc_trace_bin_index_,
@@ -453,8 +556,7 @@ void HPackCompressor::Framer::Encode(HttpStatusMetadata, uint32_t status) {
   if (GPR_LIKELY(index != 0)) {
     EmitIndexed(index);
   } else {
-    EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(":status"),
-                                           Slice::FromInt64(status));
+    EmitCacheableLitHdrIncIdx(":status", Slice::FromInt64(status));
   }
 }
 
@@ -487,8 +589,7 @@ void HPackCompressor::Framer::EncodeAlwaysIndexed(uint32_t* index,
     EmitIndexed(compressor_->table_.DynamicIndex(*index));
   } else {
     *index = compressor_->table_.AllocateIndex(transport_length);
-    EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(key),
-                                           std::move(value));
+    EmitCacheableLitHdrIncIdx(key, value);
   }
 }
 
@@ -566,6 +667,34 @@ void HPackCompressor::Framer::Encode(UserAgentMetadata, const Slice& slice) {
                           UserAgentMetadata::key().size(), slice.size()));
 }
 
+void HPackCompressor::Framer::EncodeAuthorization(const Slice& value) {
+  static constexpr absl::string_view kKey = "authorization";
+  const uint32_t transport_length =
+      hpack_constants::SizeForEntry(kKey.size(), value.size());
+  if (transport_length > HPackEncoderTable::MaxEntrySize()) {
+    EmitLitHdrWithNonBinaryStringKeyNotIdx(Slice::FromStaticString(kKey),
+                                           value.Ref());
+    return;
+  }
+  // Call credentials attach their cached token by reference, so comparing the
+  // slices usually avoids comparing the bytes of the token.
+  if (!value.is_equivalent(compressor_->authorization_) &&
+      value != compressor_->authorization_) {
+    compressor_->authorization_ = value.Ref();
+    compressor_->authorization_index_ = 0;
+  }
+  auto& table = compressor_->table_;
+  if (table.ConvertableToDynamicIndex(compressor_->authorization_index_)) {
+    EmitIndexed(table.DynamicIndex(compressor_->authorization_index_));
+  } else {
+    // Not through the literal cache: tokens are not shared with other
+    // connections, and must not outlive them.
+    compressor_->authorization_index_ = table.AllocateIndex(transport_length);
+    EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(kKey),
+                                           value.Ref());
+  }
+}
+
 void HPackCompressor::Framer::Encode(GrpcStatusMetadata,
                                      grpc_status_code status) {
   const uint32_t code = static_cast<uint32_t>(status);
@@ -583,7 +712,7 @@ void HPackCompressor::Framer::Encode(GrpcStatusMetadata,
       key.length() + value.length() + hpack_constants::kEntryOverhead;
   if (index != nullptr) {
     *index = compressor_->table_.AllocateIndex(transport_length);
-    EmitLitHdrWithNonBinaryStringKeyIncIdx(std::move(key), std::move(value));
+    EmitCacheableLitHdrIncIdx(GrpcStatusMetadata::key(), value);
   } else {
     EmitLitHdrWithNonBinaryStringKeyNotIdx(std::move(key), std::move(value));
   }
@@ -605,8 +734,7 @@ void HPackCompressor::Framer::Encode(GrpcEncodingMetadata,
       key.length() + encoded_value.length() + hpack_constants::kEntryOverhead;
   if (index != nullptr) {
     *index = compressor_->table_.AllocateIndex(transport_length);
-    EmitLitHdrWithNonBinaryStringKeyIncIdx(std::move(key),
-                                           std::move(encoded_value));
+    EmitCacheableLitHdrIncIdx(GrpcEncodingMetadata::key(), encoded_value);
   } else {
     EmitLitHdrWithNonBinaryStringKeyNotIdx(std::move(key),
                                            std::move(encoded_value));
@@ -630,8 +758,7 @@ void HPackCompressor::Framer::Encode(GrpcAcceptEncodingMetadata,
   compressor_->grpc_accept_encoding_index_ =
       compressor_->table_.AllocateIndex(transport_length);
   compressor_->grpc_accept_encoding_ = value;
-  EmitLitHdrWithNonBinaryStringKeyIncIdx(std::move(key),
-                                         std::move(encoded_value));
+  EmitCacheableLitHdrIncIdx(GrpcAcceptEncodingMetadata::key(), encoded_value);
 }
 
 void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
@@ -639,8 +766,25 @@ void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
 }
 
+void HPackCompressor::SetMemoryPressureLimit(uint32_t max_table_size) {
+  memory_pressure_limit_ = max_table_size;
+  SetMaxTableSize(table_.max_size());
+  path_index_.ForgetEvicted(table_);
+  authority_index_.ForgetEvicted(table_);
+  compression_dictionary_index_.ForgetEvicted(table_);
+  if (!table_.ConvertableToDynamicIndex(user_agent_index_)) {
+    user_agent_ = Slice();
+    user_agent_index_ = 0;
+  }
+  if (!table_.ConvertableToDynamicIndex(authorization_index_)) {
+    authorization_ = Slice();
+    authorization_index_ = 0;
+  }
+}
+
 void HPackCompressor::SetMaxTableSize(uint32_t max_table_size) {
-  if (table_.SetMaxSize(std::min(max_usable_size_, max_table_size))) {
+  if (table_.SetMaxSize(std::min(
+          {max_usable_size_, memory_pressure_limit_, max_table_size}))) {
     advertise_table_size_change_ = true;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
       gpr_log(GPR_INFO, "set max table size from encoder to %d",
@@ -38,6 +38,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -60,11 +61,30 @@ class HPackCompressor {
 
   void SetMaxTableSize(uint32_t max_table_size);
   void SetMaxUsableSize(uint32_t max_table_size);
+  // Under memory pressure: use at most max_table_size bytes of the table,
+  // whatever the peer and SetMaxUsableSize allow, and let go of the values of
+  // the entries that no longer fit. kMaxTableSize lifts the limit again, from
+  // the next SetMaxTableSize on.
+  void SetMemoryPressureLimit(uint32_t max_table_size);
 
   uint32_t test_only_table_size() const {
     return table_.test_only_table_size();
   }
 
+  // Emit first sightings of common headers from a process wide cache of
+  // their encoded form (defaults to the hpack_encoder_literal_cache
+  // experiment).
+  void SetUseLiteralCache(bool use_literal_cache) {
+    use_literal_cache_ = use_literal_cache;
+  }
+
+  // Add the authorization header to the dynamic table, so that calls
+  // carrying the same token refer to it instead of sending it again
+  // (defaults to the hpack_index_authorization experiment).
+  void SetIndexAuthorization(bool index_authorization) {
+    index_authorization_ = index_authorization;
+  }
+
   struct EncodeHeaderOptions {
     uint32_t stream_id;
     bool is_end_of_stream;
@@ -102,6 +122,7 @@ class HPackCompressor {
     void Encode(GrpcStatusMetadata, grpc_status_code status);
     void Encode(GrpcEncodingMetadata, grpc_compression_algorithm value);
     void Encode(GrpcAcceptEncodingMetadata, CompressionAlgorithmSet value);
+    void Encode(GrpcCompressionDictionaryMetadata, const Slice& slice);
     void Encode(GrpcTagsBinMetadata, const Slice& slice);
     void Encode(GrpcTraceBinMetadata, const Slice& slice);
     void Encode(GrpcMessageMetadata, const Slice& slice) {
@@ -148,12 +169,17 @@ class HPackCompressor {
                                              Slice value_slice);
     void EmitLitHdrWithNonBinaryStringKeyNotIdx(Slice key_slice,
                                                 Slice value_slice);
+    // As EmitLitHdrWithNonBinaryStringKeyIncIdx, for a static key and a
+    // value that is likely to be sent by other connections too.
+    void EmitCacheableLitHdrIncIdx(absl::string_view key, const Slice& value);
 
     void EncodeAlwaysIndexed(uint32_t* index, absl::string_view key,
                              Slice value, uint32_t transport_length);
     void EncodeIndexedKeyWithBinaryValue(uint32_t* index, absl::string_view key,
                                          Slice value);
 
+    void EncodeAuthorization(const Slice& value);
+
     void EncodeRepeatingSliceValue(const absl::string_view& key,
                                    const Slice& slice, uint32_t* index,
                                    size_t max_compression_size);
@@ -182,14 +208,20 @@ class HPackCompressor {
   // maximum number of bytes we'll use for the decode table (to guard against
   // peers ooming us by setting decode table size high)
   uint32_t max_usable_size_ = hpack_constants::kInitialTableSize;
+  // maximum number of bytes we'll use while under memory pressure
+  uint32_t memory_pressure_limit_ = kMaxTableSize;
   // if non-zero, advertise to the decoder that we'll start using a table
   // of this size
   bool advertise_table_size_change_ = false;
+  bool use_literal_cache_ = IsHpackEncoderLiteralCacheEnabled();
+  bool index_authorization_ = IsHpackIndexAuthorizationEnabled();
   HPackEncoderTable table_;
 
   class SliceIndex {
    public:
     void EmitTo(absl::string_view key, const Slice& value, Framer* framer);
+    // Drop the values that are no longer in table.
+    void ForgetEvicted(const HPackEncoderTable& table);
 
    private:
     struct ValueIndex {
@@ -226,8 +258,13 @@ class HPackCompressor {
   uint32_t grpc_trace_bin_index_ = 0;
   // The user-agent string referred to by user_agent_index_
   Slice user_agent_;
+  // Index into table_ for the authorization metadata element
+  uint32_t authorization_index_ = 0;
+  // The authorization string referred to by authorization_index_
+  Slice authorization_;
   SliceIndex path_index_;
   SliceIndex authority_index_;
+  SliceIndex compression_dictionary_index_;
   std::vector<PreviousTimeout> previous_timeouts_;
 };
 
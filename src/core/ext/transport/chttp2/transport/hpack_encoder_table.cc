@@ -58,9 +58,12 @@ bool HPackEncoderTable::SetMaxSize(uint32_t max_table_size) {
   max_table_size_ = max_table_size;
   const size_t max_table_elems =
       hpack_constants::EntriesForBytes(max_table_size);
-  // TODO(ctiller): integrate with ResourceQuota to rebuild smaller when we can.
   if (max_table_elems > elem_size_.size()) {
     Rebuild(std::max(max_table_elems, 2 * elem_size_.size()));
+  } else if (max_table_elems < elem_size_.size() / 4) {
+    // Shrunk a long way, eg. under memory pressure: give back the space.
+    Rebuild(std::max<size_t>(max_table_elems,
+                             hpack_constants::kInitialTableEntries));
   }
   return true;
 }
@@ -508,8 +508,7 @@ class HPackParser::Input {
   // Helper to parse a varint delta on top of value, return nullopt on failure
   // (setting error)
   absl::optional<uint32_t> ParseVarint(uint32_t value) {
-    // TODO(ctiller): break out a variant of this when we know there are at
-    // least 5 bytes in input_
+    if (GPR_LIKELY(end_ - begin_ >= 5)) return ParseVarintUnchecked(value);
     auto cur = Next();
     if (!cur) return {};
     value += *cur & 0x7f;
@@ -530,7 +529,12 @@ class HPackParser::Input {
     value += (*cur & 0x7f) << 21;
     if ((*cur & 0x80) == 0) return value;
 
-    cur = Next();
+    return ParseVarintTail(value);
+  }
+
+  // The fifth byte of a varint, and any padding after it
+  absl::optional<uint32_t> ParseVarintTail(uint32_t value) {
+    auto cur = Next();
     if (!cur) return {};
     uint32_t c = (*cur) & 0x7f;
     // We might overflow here, so we need to be a little careful about the
@@ -555,6 +559,40 @@ class HPackParser::Input {
     return ParseVarintOutOfRange(value, *cur);
   }
 
+  // ParseVarint, when there are at least 5 bytes of input left: enough for
+  // any varint that does not overflow, or is not padded with 0x80 bytes, so
+  // no bounds checks are needed until then.
+  absl::optional<uint32_t> ParseVarintUnchecked(uint32_t value) {
+    const uint8_t* p = begin_;
+    uint32_t c = *p++;
+    value += c & 0x7f;
+    if ((c & 0x80) != 0) {
+      c = *p++;
+      value += (c & 0x7f) << 7;
+      if ((c & 0x80) != 0) {
+        c = *p++;
+        value += (c & 0x7f) << 14;
+        if ((c & 0x80) != 0) {
+          c = *p++;
+          value += (c & 0x7f) << 21;
+          if ((c & 0x80) != 0) {
+            // The fifth byte may overflow, or be followed by padding: leave
+            // those cases to the careful path.
+            c = *p;
+            if (c > 0xf || (c << 28) > 0xffffffffu - value) {
+              begin_ = p;
+              return ParseVarintTail(value);
+            }
+            value += c << 28;
+            ++p;
+          }
+        }
+      }
+    }
+    begin_ = p;
+    return value;
+  }
+
   // Prefix for a string
   struct StringPrefix {
     // Number of bytes in input for string
@@ -848,32 +886,20 @@ class HPackParser::String {
 
     std::vector<uint8_t> out;
     out.reserve(3 * (end - cur) / 4 + 3);
-
-    // Decode 4 bytes at a time while we can
-    while (end - cur >= 4) {
-      uint32_t bits = kBase64InverseTable.table[*cur];
-      if (bits > 63) return {};
-      uint32_t buffer = bits << 18;
-      ++cur;
-
-      bits = kBase64InverseTable.table[*cur];
-      if (bits > 63) return {};
-      buffer |= bits << 12;
-      ++cur;
-
-      bits = kBase64InverseTable.table[*cur];
-      if (bits > 63) return {};
-      buffer |= bits << 6;
-      ++cur;
-
-      bits = kBase64InverseTable.table[*cur];
-      if (bits > 63) return {};
-      buffer |= bits;
-      ++cur;
-
-      out.insert(out.end(), {static_cast<uint8_t>(buffer >> 16),
-                             static_cast<uint8_t>(buffer >> 8),
-                             static_cast<uint8_t>(buffer)});
+    out.resize(3 * ((end - cur) / 4));
+
+    // Decode 4 bytes at a time while we can: invalid characters map to values
+    // above 63, so one check covers the whole group.
+    for (uint8_t* p = out.data(); end - cur >= 4; cur += 4, p += 3) {
+      const uint32_t a = kBase64InverseTable.table[cur[0]];
+      const uint32_t b = kBase64InverseTable.table[cur[1]];
+      const uint32_t c = kBase64InverseTable.table[cur[2]];
+      const uint32_t d = kBase64InverseTable.table[cur[3]];
+      if ((a | b | c | d) > 63) return {};
+      const uint32_t buffer = (a << 18) | (b << 12) | (c << 6) | d;
+      p[0] = static_cast<uint8_t>(buffer >> 16);
+      p[1] = static_cast<uint8_t>(buffer >> 8);
+      p[2] = static_cast<uint8_t>(buffer);
     }
     // Deal with the last 0, 1, 2, or 3 bytes.
     switch (end - cur) {
@@ -959,11 +985,11 @@ class HPackParser::Parser {
       case 1:
         switch (cur & 0xf) {
           case 0:  // literal key
-            return FinishHeaderOmitFromTable(ParseLiteralKey());
+            return FinishHeaderOmitFromTable(ParseLiteralKey(false));
           case 0xf:  // varint encoded key index
-            return FinishHeaderOmitFromTable(ParseVarIdxKey(0xf));
+            return FinishHeaderOmitFromTable(ParseVarIdxKey(0xf, false));
           default:  // inline encoded key index
-            return FinishHeaderOmitFromTable(ParseIdxKey(cur & 0xf));
+            return FinishHeaderOmitFromTable(ParseIdxKey(cur & 0xf, false));
         }
         // Update max table size.
         // First byte format: 001xxxxx
@@ -990,20 +1016,20 @@ class HPackParser::Parser {
       case 4:
         if (cur == 0x40) {
           // literal key
-          return FinishHeaderAndAddToTable(ParseLiteralKey());
+          return FinishHeaderAndAddToTable(ParseLiteralKey(true));
         }
         ABSL_FALLTHROUGH_INTENDED;
       case 5:
       case 6:
         // inline encoded key index
-        return FinishHeaderAndAddToTable(ParseIdxKey(cur & 0x3f));
+        return FinishHeaderAndAddToTable(ParseIdxKey(cur & 0x3f, true));
       case 7:
         if (cur == 0x7f) {
           // varint encoded key index
-          return FinishHeaderAndAddToTable(ParseVarIdxKey(0x3f));
+          return FinishHeaderAndAddToTable(ParseVarIdxKey(0x3f, true));
         } else {
           // inline encoded key index
-          return FinishHeaderAndAddToTable(ParseIdxKey(cur & 0x3f));
+          return FinishHeaderAndAddToTable(ParseIdxKey(cur & 0x3f, true));
         }
         // Indexed Header Field Representation
         // First byte format: 1xxxxxxx
@@ -1060,7 +1086,10 @@ class HPackParser::Parser {
             log_info_.is_client ? "CLI" : "SVR", memento.DebugString().c_str());
   }
 
-  bool EmitHeader(const HPackTable::Memento& md) {
+  // Emit md to the metadata batch: a header that is not added to the table is
+  // moved into it rather than ref'd.
+  template <typename M>
+  bool EmitHeader(M&& md) {
     // Pass up to the transport
     if (GPR_UNLIKELY(metadata_buffer_ == nullptr)) return true;
     *frame_length_ += md.transport_size();
@@ -1068,7 +1097,7 @@ class HPackParser::Parser {
       return HandleMetadataSizeLimitExceeded(md);
     }
 
-    metadata_buffer_->Set(md);
+    metadata_buffer_->Set(std::forward<M>(md));
     return true;
   }
 
@@ -1093,7 +1122,11 @@ class HPackParser::Parser {
   bool FinishHeaderOmitFromTable(absl::optional<HPackTable::Memento> md) {
     // Allow higher code to just pass in failures ... simplifies things a bit.
     if (!md.has_value()) return false;
-    return FinishHeaderOmitFromTable(*md);
+    // Log if desired
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_chttp2_hpack_parser)) {
+      LogHeader(*md);
+    }
+    return EmitHeader(std::move(*md));
   }
 
   bool FinishHeaderOmitFromTable(const HPackTable::Memento& md) {
@@ -1105,7 +1138,7 @@ class HPackParser::Parser {
   }
 
   // Parse a string encoded key and a string encoded value
-  absl::optional<HPackTable::Memento> ParseLiteralKey() {
+  absl::optional<HPackTable::Memento> ParseLiteralKey(bool add_to_table) {
     auto key = String::Parse(input_);
     if (!key.has_value()) return {};
     auto value = ParseValueString(absl::EndsWith(key->string_view(), "-bin"));
@@ -1113,18 +1146,24 @@ class HPackParser::Parser {
       return {};
     }
     auto key_string = key->string_view();
-    auto value_slice = value->Take();
+    auto value_slice = TakeValue(&*value, add_to_table);
     const auto transport_size = key_string.size() + value_slice.size() +
                                 hpack_constants::kEntryOverhead;
-    return grpc_metadata_batch::Parse(
-        key->string_view(), std::move(value_slice), transport_size,
-        [key_string](absl::string_view error, const Slice& value) {
-          ReportMetadataParseError(key_string, error, value.as_string_view());
-        });
+    auto on_error = [key_string](absl::string_view error, const Slice& value) {
+      ReportMetadataParseError(key_string, error, value.as_string_view());
+    };
+    if (add_to_table && IsHpackTableArenaEnabled()) {
+      return grpc_metadata_batch::Parse(table_->CopyToArena(key_string),
+                                        std::move(value_slice),
+                                        transport_size, on_error);
+    }
+    return grpc_metadata_batch::Parse(key_string, std::move(value_slice),
+                                      transport_size, on_error);
   }
 
   // Parse an index encoded key and a string encoded value
-  absl::optional<HPackTable::Memento> ParseIdxKey(uint32_t index) {
+  absl::optional<HPackTable::Memento> ParseIdxKey(uint32_t index,
+                                                  bool add_to_table) {
     const auto* elem = table_->Lookup(index);
     if (GPR_UNLIKELY(elem == nullptr)) {
       return InvalidHPackIndexError(index,
@@ -1133,16 +1172,27 @@ class HPackParser::Parser {
     auto value = ParseValueString(elem->is_binary_header());
     if (GPR_UNLIKELY(!value.has_value())) return {};
     return elem->WithNewValue(
-        value->Take(), [=](absl::string_view error, const Slice& value) {
+        TakeValue(&*value, add_to_table),
+        [=](absl::string_view error, const Slice& value) {
           ReportMetadataParseError(elem->key(), error, value.as_string_view());
         });
   }
 
   // Parse a varint index encoded key and a string encoded value
-  absl::optional<HPackTable::Memento> ParseVarIdxKey(uint32_t offset) {
+  absl::optional<HPackTable::Memento> ParseVarIdxKey(uint32_t offset,
+                                                     bool add_to_table) {
     auto index = input_->ParseVarint(offset);
     if (GPR_UNLIKELY(!index.has_value())) return {};
-    return ParseIdxKey(*index);
+    return ParseIdxKey(*index, add_to_table);
+  }
+
+  // Take the value of a header, into the arena of the table should the
+  // header be added to it.
+  Slice TakeValue(String* value, bool add_to_table) {
+    if (add_to_table && IsHpackTableArenaEnabled()) {
+      return table_->CopyToArena(value->string_view());
+    }
+    return value->Take();
   }
 
   // Parse a string, figuring out if it's binary or not by the key name.
@@ -1366,6 +1416,10 @@ grpc_error_handle grpc_chttp2_header_parser_parse(void* hpack_parser,
         }
         s->published_metadata[s->header_frames_received] =
             GRPC_METADATA_PUBLISHED_FROM_WIRE;
+        if (!t->is_client && s->header_frames_received == 0) {
+          // The server writes the call at the weight the client gave it.
+          grpc_chttp2_set_stream_write_weight(s, s->initial_metadata_buffer);
+        }
         maybe_complete_funcs[s->header_frames_received](t, s);
         s->header_frames_received++;
       }
@@ -21,26 +21,98 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser_table.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <new>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
+#include <grpc/slice.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_refcount_base.h"
 
 extern grpc_core::TraceFlag grpc_http_trace;
 
 namespace grpc_core {
 
+namespace {
+// The smallest arena block: tables are seldom smaller than this, and a block
+// only gets allocated once headers are added to them.
+constexpr size_t kMinArenaBlockSize = 1024;
+}  // namespace
+
+// A block of bytes that CopyToArena copies to, and the refcount of the slices
+// referencing the copies.
+class HPackTable::ArenaBlock final : public grpc_slice_refcount {
+ public:
+  static ArenaBlock* Create(size_t capacity) {
+    void* memory = gpr_malloc(sizeof(ArenaBlock) + capacity);
+    return new (memory) ArenaBlock(capacity);
+  }
+
+  // Returns a slice of a copy of bytes, if they fit in what is left of the
+  // block.
+  absl::optional<Slice> Copy(absl::string_view bytes) {
+    if (bytes.size() > capacity_ - used_) return absl::nullopt;
+    uint8_t* copy = reinterpret_cast<uint8_t*>(this + 1) + used_;
+    memcpy(copy, bytes.data(), bytes.size());
+    used_ += bytes.size();
+    Ref();
+    grpc_slice slice;
+    slice.refcount = this;
+    slice.data.refcounted.bytes = copy;
+    slice.data.refcounted.length = bytes.size();
+    return Slice(slice);
+  }
+
+ private:
+  explicit ArenaBlock(size_t capacity)
+      : grpc_slice_refcount(Destroy), capacity_(capacity) {}
+
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* block = static_cast<ArenaBlock*>(p);
+    block->~ArenaBlock();
+    gpr_free(block);
+  }
+
+  const size_t capacity_;
+  size_t used_ = 0;
+};
+
+HPackTable::~HPackTable() {
+  if (arena_ != nullptr) arena_->Unref();
+}
+
+Slice HPackTable::CopyToArena(absl::string_view bytes) {
+  // Bytes that fit in a slice need no allocation at all.
+  if (bytes.size() <= GRPC_SLICE_INLINED_SIZE) {
+    return Slice::FromCopiedString(bytes);
+  }
+  if (arena_ != nullptr) {
+    auto copy = arena_->Copy(bytes);
+    if (copy.has_value()) return std::move(*copy);
+  }
+  // Bytes that would leave most of a new block unused get their own.
+  const size_t block_size =
+      std::max<size_t>(current_table_bytes_, kMinArenaBlockSize);
+  if (bytes.size() > block_size / 4) return Slice::FromCopiedString(bytes);
+  if (arena_ != nullptr) arena_->Unref();
+  arena_ = ArenaBlock::Create(block_size);
+  return std::move(*arena_->Copy(bytes));
+}
+
 void HPackTable::MementoRingBuffer::Put(Memento m) {
   GPR_ASSERT(num_entries_ < max_entries_);
   if (entries_.size() < max_entries_) {
@@ -86,6 +158,17 @@ void HPackTable::EvictOne() {
   mem_used_ -= first_entry.transport_size();
 }
 
+// An empty table, as left by shrinking it to nothing, needs none of its
+// storage: give it back until entries are added again.
+void HPackTable::ReleaseIfEmpty() {
+  if (entries_.num_entries() != 0) return;
+  entries_ = MementoRingBuffer();
+  if (arena_ != nullptr) {
+    arena_->Unref();
+    arena_ = nullptr;
+  }
+}
+
 void HPackTable::SetMaxBytes(uint32_t max_bytes) {
   if (max_bytes_ == max_bytes) {
     return;
@@ -97,6 +180,7 @@ void HPackTable::SetMaxBytes(uint32_t max_bytes) {
     EvictOne();
   }
   max_bytes_ = max_bytes;
+  ReleaseIfEmpty();
 }
 
 grpc_error_handle HPackTable::SetCurrentTableSize(uint32_t bytes) {
@@ -118,6 +202,7 @@ grpc_error_handle HPackTable::SetCurrentTableSize(uint32_t bytes) {
   uint32_t new_cap = std::max(hpack_constants::EntriesForBytes(bytes),
                               hpack_constants::kInitialTableEntries);
   entries_.Rebuild(new_cap);
+  ReleaseIfEmpty();
   return absl::OkStatus();
 }
 
@@ -25,6 +25,8 @@
 
 #include <vector>
 
+#include "absl/strings/string_view.h"
+
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 #include "src/core/lib/gprpp/no_destruct.h"
 #include "src/core/lib/iomgr/error.h"
@@ -37,7 +39,7 @@ namespace grpc_core {
 class HPackTable {
  public:
   HPackTable() = default;
-  ~HPackTable() = default;
+  ~HPackTable();
 
   HPackTable(const HPackTable&) = delete;
   HPackTable& operator=(const HPackTable&) = delete;
@@ -65,10 +67,18 @@ class HPackTable {
   // add a table entry to the index
   grpc_error_handle Add(Memento md) GRPC_MUST_USE_RESULT;
 
+  // Returns a copy of bytes, the key or value of an entry about to be added.
+  // Copies are carved out of a few blocks sized to the table, rather than
+  // each needing an allocation, or pinning the read buffer they arrived in
+  // for as long as the entry stays in the table.
+  Slice CopyToArena(absl::string_view bytes);
+
   // Current entry count in the table.
   uint32_t num_entries() const { return entries_.num_entries(); }
 
  private:
+  class ArenaBlock;
+
   struct StaticMementos {
     StaticMementos();
     Memento memento[hpack_constants::kLastStaticEntry];
@@ -113,6 +123,7 @@ class HPackTable {
   }
 
   void EvictOne();
+  void ReleaseIfEmpty();
 
   static const StaticMementos* GetStaticMementos() {
     static const NoDestruct<StaticMementos> static_mementos;
@@ -128,6 +139,11 @@ class HPackTable {
   uint32_t current_table_bytes_ = hpack_constants::kInitialTableSize;
   // HPack table entries
   MementoRingBuffer entries_;
+  // The block CopyToArena copies to, we hold a ref to it. Entries and the
+  // metadata batches they are emitted into hold refs to the blocks their
+  // copies are in: those are freed with the last of them, in the order the
+  // table evicts entries.
+  ArenaBlock* arena_ = nullptr;
   // Static mementos
   const StaticMementos* const static_mementos_ = GetStaticMementos();
 };
@@ -25,7 +25,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/transport/http2_errors.h"
 
-const uint16_t grpc_setting_id_to_wire_id[] = {1, 2, 3, 4, 5, 6, 65027};
+const uint16_t grpc_setting_id_to_wire_id[] = {1, 2, 3, 4, 5, 6, 65027, 65028};
 
 bool grpc_wire_id_to_setting_id(uint32_t wire_id, grpc_chttp2_setting_id* out) {
   uint32_t i = wire_id - 1;
@@ -59,4 +59,6 @@ const grpc_chttp2_setting_parameters
          GRPC_CHTTP2_CLAMP_INVALID_VALUE, GRPC_HTTP2_PROTOCOL_ERROR},
         {"GRPC_ALLOW_TRUE_BINARY_METADATA", 0u, 0u, 1u,
          GRPC_CHTTP2_CLAMP_INVALID_VALUE, GRPC_HTTP2_PROTOCOL_ERROR},
+        {"GRPC_ALLOW_MEMFD_DATA", 0u, 0u, 1u, GRPC_CHTTP2_CLAMP_INVALID_VALUE,
+         GRPC_HTTP2_PROTOCOL_ERROR},
 };
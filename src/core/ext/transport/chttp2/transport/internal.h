@@ -36,13 +36,16 @@
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/frame_goaway.h"
+#include "src/core/ext/transport/chttp2/transport/frame_memfd_data.h"
 #include "src/core/ext/transport/chttp2/transport/frame_ping.h"
 #include "src/core/ext/transport/chttp2/transport/frame_rst_stream.h"
 #include "src/core/ext/transport/chttp2/transport/frame_settings.h"
+#include "src/core/ext/transport/chttp2/transport/frame_size_policy.h"
 #include "src/core/ext/transport/chttp2/transport/frame_window_update.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
+#include "src/core/ext/transport/chttp2/transport/stream_delivery_queue.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
@@ -65,6 +68,7 @@
 #include "src/core/lib/transport/transport.h"
 #include "src/core/lib/transport/transport_fwd.h"
 #include "src/core/lib/transport/transport_impl.h"
+#include "src/core/lib/transport/transport_rtt_observer.h"
 
 namespace grpc_core {
 class ContextList;
@@ -263,6 +267,16 @@ struct grpc_chttp2_transport {
   /** has the upper layer closed the transport? */
   grpc_error_handle closed_with_error;
 
+  /** the last error built to report the removal of a stream, with the
+      message and the cause it was built from: streams removed for the same
+      reason, as when a peer goes away with many open, share it */
+  struct RemovalError {
+    const char* message = nullptr;
+    grpc_error_handle cause;
+    grpc_error_handle error;
+  };
+  RemovalError removal_errors[2];
+
   /** is there a read request to the endpoint outstanding? */
   uint8_t endpoint_reading = 1;
 
@@ -308,6 +322,18 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** how many bytes to put on the wire in one endpoint write; the next write
+      is only put together once this one is in the kernel, so with
+      TCP_NOTSENT_LOWAT it matches the low water mark */
+  uint32_t target_write_size = 1024 * 1024;
+
+  /** smallest DATA payload to pass to the peer as a memfd, or 0 to never do
+      so */
+  uint32_t memfd_data_min_bytes = 0;
+  /** memfd data frames in outbuf, whose descriptors must all fit in the
+      endpoint's next write */
+  uint32_t memfds_in_outbuf = 0;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to absl::OkStatus() */
   grpc_error_handle goaway_error;
@@ -353,11 +379,14 @@ struct grpc_chttp2_transport {
     grpc_chttp2_settings_parser settings;
     grpc_chttp2_ping_parser ping;
     grpc_chttp2_rst_stream_parser rst_stream;
+    grpc_chttp2_memfd_data_parser memfd_data;
   } simple;
   /** parser for goaway frames */
   grpc_chttp2_goaway_parser goaway_parser;
 
   grpc_core::chttp2::TransportFlowControl flow_control;
+  /** sizes the DATA frames of the streams, under adaptive_frame_size */
+  grpc_core::chttp2::FrameSizePolicy frame_size_policy;
   /** initial window change. This is tracked as we parse settings frames from
    * the remote peer. If there is a positive delta, then we will make all
    * streams readable since they may have become unstalled */
@@ -399,12 +428,32 @@ struct grpc_chttp2_transport {
   /* buffer pool state */
   /** have we scheduled a benign cleanup? */
   bool benign_reclaimer_registered = false;
+  /** have we scheduled an idle cleanup? */
+  bool idle_reclaimer_registered = false;
   /** have we scheduled a destructive cleanup? */
   bool destructive_reclaimer_registered = false;
   /** benign cleanup closure */
   grpc_closure benign_reclaimer_locked;
+  /** idle cleanup closure */
+  grpc_closure idle_reclaimer_locked;
   /** destructive cleanup closure */
   grpc_closure destructive_reclaimer_locked;
+  /** have the hpack tables been shrunk by the benign cleanup? */
+  bool shrunk_for_memory_pressure = false;
+  /** the configured local SETTINGS_HEADER_TABLE_SIZE, that the decoder table
+      grows back to */
+  uint32_t hpack_decoder_table_size = 0;
+
+  /* idle hibernation */
+  /** How long without streams before hibernating (0 = never) */
+  grpc_core::Duration idle_hibernation_timeout;
+  /** when the transport last had streams */
+  grpc_core::Timestamp last_busy_time;
+  /** Have the hpack tables been dropped for being idle? */
+  bool hibernating = false;
+  bool have_hibernation_timer = false;
+  grpc_timer hibernation_timer;
+  grpc_closure hibernation_timer_expired_locked;
 
   /* next bdp ping timer */
   bool have_next_bdp_ping_timer = false;
@@ -435,8 +484,14 @@ struct grpc_chttp2_transport {
   bool keepalive_ping_started = false;
   /** keep-alive state machine state */
   grpc_chttp2_keepalive_state keepalive_state;
+  /** when the transport last read from its peer: with keepalive_coalescing,
+      reads don't rearm the keepalive ping timer, it checks this when fired */
+  grpc_core::Timestamp last_read_time;
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
+  /** Told the RTT of each BDP ping, if the channel that created the
+      transport asked for it */
+  grpc_core::RefCountedPtr<grpc_core::TransportRttObserver> rtt_observer;
   uint32_t num_messages_in_next_write = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
@@ -445,6 +500,21 @@ struct grpc_chttp2_transport {
    * thereby reducing the number of induced frames. */
   uint32_t num_pending_induced_frames = 0;
   bool reading_paused_on_pending_induced_frames = false;
+
+  /* write coalescing */
+  /** Writes smaller than this are held back for up to write_coalescing_window
+      (0 = off) */
+  uint32_t write_coalescing_bytes = 0;
+  grpc_core::Duration write_coalescing_window;
+  /** Serialized frames are waiting in outbuf for the window to close */
+  bool write_corked = false;
+  /** Something initiated since the last write should not be held back */
+  bool write_urgent = false;
+  /** When the current write_corked window closes */
+  grpc_core::Timestamp write_cork_deadline;
+  bool have_write_coalescing_timer = false;
+  grpc_timer write_coalescing_timer;
+  grpc_closure write_coalescing_timer_expired_locked;
 };
 
 typedef enum {
@@ -505,6 +575,9 @@ struct grpc_chttp2_stream {
   grpc_closure* recv_message_ready = nullptr;
   grpc_metadata_batch* recv_trailing_metadata;
   grpc_closure* recv_trailing_metadata_finished = nullptr;
+  /** runs the closures above off the transport's thread, if set */
+  grpc_core::RefCountedPtr<grpc_core::chttp2::StreamDeliveryQueue>
+      delivery_queue;
 
   grpc_transport_stream_stats* collecting_stats = nullptr;
   grpc_transport_stream_stats stats = grpc_transport_stream_stats();
@@ -539,6 +612,8 @@ struct grpc_chttp2_stream {
 
   grpc_slice_buffer frame_storage;  /* protected by t combiner */
   bool received_last_frame = false; /* protected by t combiner */
+  /** bytes of the message being received in parts not delivered yet */
+  uint32_t recv_message_remaining = 0; /* protected by t combiner */
 
   grpc_core::Timestamp deadline = grpc_core::Timestamp::InfFuture();
 
@@ -561,6 +636,12 @@ struct grpc_chttp2_stream {
   grpc_chttp2_write_cb* finish_after_write = nullptr;
   size_t sending_bytes = 0;
 
+  /** share of the connection when other streams are writing, from
+      grpc-write-weight, and the bytes it may still write in the current
+      round, under chttp2_weighted_fair_writes */
+  uint32_t write_weight = grpc_core::GrpcWriteWeightMetadata::kDefaultWeight;
+  int64_t write_deficit = 0;
+
   /** Whether the bytes needs to be traced using Fathom */
   bool traced = false;
   /** Byte counter for number of bytes written */
@@ -593,6 +674,10 @@ struct grpc_chttp2_begin_write_result {
 grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_chttp2_transport* t);
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error);
+/** Sets the write weight of a stream from metadata carrying
+    grpc-write-weight */
+void grpc_chttp2_set_stream_write_weight(grpc_chttp2_stream* s,
+                                         const grpc_metadata_batch& md);
 
 /** Process one slice of incoming data; return 1 if the connection is still
     viable after reading, or 0 if the connection should be torn down */
@@ -607,6 +692,7 @@ bool grpc_chttp2_list_pop_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream** s);
 bool grpc_chttp2_list_remove_writable_stream(grpc_chttp2_transport* t,
                                              grpc_chttp2_stream* s);
+bool grpc_chttp2_list_have_writable_streams(grpc_chttp2_transport* t);
 
 bool grpc_chttp2_list_add_writing_stream(grpc_chttp2_transport* t,
                                          grpc_chttp2_stream* s);
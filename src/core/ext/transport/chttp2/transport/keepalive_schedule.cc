@@ -0,0 +1,43 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/keepalive_schedule.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+namespace grpc_core {
+namespace chttp2 {
+
+Duration KeepaliveSlack(Duration keepalive_time) {
+  return std::max(Duration::Milliseconds(1),
+                  std::min(keepalive_time / 10, Duration::Seconds(1)));
+}
+
+Timestamp KeepaliveDeadline(Timestamp last_read, Duration keepalive_time) {
+  const Timestamp deadline = last_read + keepalive_time;
+  if (deadline == Timestamp::InfFuture()) return deadline;
+  const int64_t slack = KeepaliveSlack(keepalive_time).millis();
+  const int64_t millis = deadline.milliseconds_after_process_epoch();
+  return Timestamp::FromMillisecondsAfterProcessEpoch(
+      (millis + slack - 1) / slack * slack);
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
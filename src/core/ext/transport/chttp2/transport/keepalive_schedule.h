@@ -0,0 +1,50 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULE_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULE_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+// When keepalive timers fire, for transports that coalesce them.
+//
+// Each transport arms its keepalive timer for keepalive_time after it last
+// heard from its peer, rounded up to a multiple of KeepaliveSlack: the
+// timers of the transports of a process, idle since about the same time,
+// then expire together and are run in one wakeup of the timer thread rather
+// than one each.
+//
+// Reads do not rearm the timer: when it fires, a transport that heard from
+// its peer since (the acks of BDP pings included) rearms it for
+// keepalive_time after that, instead of pinging.
+
+// How much later than keepalive_time a keepalive ping may be sent: a tenth
+// of it, up to a second.
+Duration KeepaliveSlack(Duration keepalive_time);
+
+// When to next check whether a transport that last heard from its peer at
+// last_read needs to ping it.
+Timestamp KeepaliveDeadline(Timestamp last_read, Duration keepalive_time);
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULE_H
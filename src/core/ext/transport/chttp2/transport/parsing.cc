@@ -61,7 +61,10 @@ using grpc_core::HPackParser;
 static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t);
 static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
                                                   int is_continuation);
-static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t);
+static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t,
+                                                uint32_t data_size);
+static grpc_error_handle init_memfd_data_frame_parser(
+    grpc_chttp2_transport* t);
 static grpc_error_handle init_rst_stream_parser(grpc_chttp2_transport* t);
 static grpc_error_handle init_settings_frame_parser(grpc_chttp2_transport* t);
 static grpc_error_handle init_window_update_frame_parser(
@@ -344,7 +347,7 @@ static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t) {
   }
   switch (t->incoming_frame_type) {
     case GRPC_CHTTP2_FRAME_DATA:
-      return init_data_frame_parser(t);
+      return init_data_frame_parser(t, t->incoming_frame_size);
     case GRPC_CHTTP2_FRAME_HEADER:
       return init_header_frame_parser(t, 0);
     case GRPC_CHTTP2_FRAME_CONTINUATION:
@@ -360,6 +363,12 @@ static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t) {
       return init_ping_parser(t);
     case GRPC_CHTTP2_FRAME_GOAWAY:
       return init_goaway_parser(t);
+    case GRPC_CHTTP2_FRAME_GRPC_MEMFD_DATA:
+      if (t->settings[GRPC_SENT_SETTINGS]
+                     [GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_MEMFD_DATA] != 0) {
+        return init_memfd_data_frame_parser(t);
+      }
+      return init_non_header_skip_frame_parser(t);
     default:
       if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
         gpr_log(GPR_ERROR, "Unknown frame type %02x", t->incoming_frame_type);
@@ -426,7 +435,8 @@ void grpc_chttp2_parsing_become_skip_parser(grpc_chttp2_transport* t) {
   }
 }
 
-static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t) {
+static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t,
+                                                uint32_t data_size) {
   // Update BDP accounting since we have received a data frame.
   grpc_core::BdpEstimator* bdp_est = t->flow_control.bdp_estimator();
   if (bdp_est) {
@@ -435,7 +445,7 @@ static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t) {
       GRPC_CHTTP2_REF_TRANSPORT(t, "bdp_ping");
       schedule_bdp_ping_locked(t);
     }
-    bdp_est->AddIncomingBytes(t->incoming_frame_size);
+    bdp_est->AddIncomingBytes(data_size);
   }
   grpc_chttp2_stream* s =
       grpc_chttp2_parsing_lookup_stream(t, t->incoming_stream_id);
@@ -444,12 +454,12 @@ static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t) {
   if (s == nullptr) {
     grpc_core::chttp2::TransportFlowControl::IncomingUpdateContext upd(
         &t->flow_control);
-    status = upd.RecvData(t->incoming_frame_size);
+    status = upd.RecvData(data_size);
     action = upd.MakeAction();
   } else {
     grpc_core::chttp2::StreamFlowControl::IncomingUpdateContext upd(
         &s->flow_control);
-    status = upd.RecvData(t->incoming_frame_size);
+    status = upd.RecvData(data_size);
     action = upd.MakeAction();
   }
   grpc_chttp2_act_on_flowctl_action(action, t, s);
@@ -459,7 +469,7 @@ static grpc_error_handle init_data_frame_parser(grpc_chttp2_transport* t) {
   if (s == nullptr) {
     return init_non_header_skip_frame_parser(t);
   }
-  s->received_bytes += t->incoming_frame_size;
+  s->received_bytes += data_size;
   s->stats.incoming.framing_bytes += 9;
   if (s->read_closed) {
     return init_non_header_skip_frame_parser(t);
@@ -487,6 +497,37 @@ error_handler:
   }
 }
 
+static grpc_error_handle memfd_data_parser_parse(void* parser,
+                                                 grpc_chttp2_transport* t,
+                                                 grpc_chttp2_stream* /*s*/,
+                                                 const grpc_slice& slice,
+                                                 int is_last) {
+  grpc_slice data;
+  grpc_error_handle error = grpc_chttp2_memfd_data_parser_parse(
+      static_cast<grpc_chttp2_memfd_data_parser*>(parser), t->ep, slice,
+      is_last, &data);
+  if (!error.ok() || !is_last) return error;
+  // Carry on as though the payload had arrived inline in a DATA frame.
+  error = init_data_frame_parser(t, GRPC_SLICE_LENGTH(data));
+  if (error.ok()) {
+    error = t->parser(t->parser_data, t, t->incoming_stream, data, 1);
+  }
+  grpc_slice_unref(data);
+  return error;
+}
+
+static grpc_error_handle init_memfd_data_frame_parser(
+    grpc_chttp2_transport* t) {
+  grpc_error_handle err = grpc_chttp2_memfd_data_parser_begin_frame(
+      &t->simple.memfd_data, t->incoming_frame_size, t->incoming_frame_flags,
+      t->incoming_stream_id);
+  if (!err.ok()) return err;
+  t->incoming_stream = nullptr;
+  t->parser = memfd_data_parser_parse;
+  t->parser_data = &t->simple.memfd_data;
+  return absl::OkStatus();
+}
+
 static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
                                                   int is_continuation) {
   const bool is_eoh =
@@ -0,0 +1,68 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_delivery_queue.h"
+
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+void StreamDeliveryQueue::Run(grpc_closure* closure) {
+  {
+    MutexLock lock(&mu_);
+    closures_.push_back(closure);
+    if (draining_) return;
+    draining_ = true;
+  }
+  grpc_event_engine::experimental::GetDefaultEventEngine()->Run(
+      [self = Ref()]() {
+        ApplicationCallbackExecCtx app_exec_ctx;
+        ExecCtx exec_ctx;
+        self->Drain();
+      });
+}
+
+void StreamDeliveryQueue::Drain() {
+  while (true) {
+    grpc_closure* closure;
+    {
+      MutexLock lock(&mu_);
+      if (closures_.empty()) {
+        draining_ = false;
+        return;
+      }
+      closure = closures_.front();
+      closures_.pop_front();
+    }
+    Closure::Run(DEBUG_LOCATION, closure, absl::OkStatus());
+    // Run what this closure scheduled before the next closure, as the
+    // transport's ExecCtx would have.
+    ExecCtx::Get()->Flush();
+  }
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
@@ -0,0 +1,62 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_STREAM_DELIVERY_QUEUE_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_STREAM_DELIVERY_QUEUE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <deque>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+// Runs the closures that complete the receive ops of a stream on the event
+// engine's threads, one at a time and in the order they were scheduled.
+//
+// The transport demuxes frames and assembles messages under its combiner,
+// but what the call stack does with a received message (decompression,
+// deserialization, delivery to the application) then runs on the threads
+// of the queues of the streams instead of after the combiner on the reading
+// thread, so that a single busy connection can keep several cores busy.
+//
+// The queue is ref counted because the stream may be destroyed as soon as
+// its last closure has run, while the queue is still being drained.
+class StreamDeliveryQueue : public RefCounted<StreamDeliveryQueue> {
+ public:
+  // Schedules \a closure to run with an OK status after the closures
+  // scheduled before it.
+  void Run(grpc_closure* closure);
+
+ private:
+  void Drain();
+
+  Mutex mu_;
+  std::deque<grpc_closure*> closures_ ABSL_GUARDED_BY(mu_);
+  // Whether a thread is running the closures.
+  bool draining_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_STREAM_DELIVERY_QUEUE_H
@@ -156,6 +156,10 @@ bool grpc_chttp2_list_remove_writable_stream(grpc_chttp2_transport* t,
   return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE);
 }
 
+bool grpc_chttp2_list_have_writable_streams(grpc_chttp2_transport* t) {
+  return !stream_list_empty(t, GRPC_CHTTP2_LIST_WRITABLE);
+}
+
 bool grpc_chttp2_list_add_writing_stream(grpc_chttp2_transport* t,
                                          grpc_chttp2_stream* s) {
   return stream_list_add(t, s, GRPC_CHTTP2_LIST_WRITING);
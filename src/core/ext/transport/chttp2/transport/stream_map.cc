@@ -35,6 +35,120 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
   map->count = 0;
   map->free = 0;
   map->capacity = initial_capacity;
+  map->open_addressing = false;
+}
+
+static void oa_alloc(grpc_chttp2_stream_map* map, size_t capacity) {
+  map->keys = static_cast<uint32_t*>(gpr_zalloc(sizeof(uint32_t) * capacity));
+  map->values = static_cast<void**>(gpr_zalloc(sizeof(void*) * capacity));
+  map->capacity = capacity;
+}
+
+void grpc_chttp2_stream_map_init_open_addressing(grpc_chttp2_stream_map* map,
+                                                 size_t initial_capacity) {
+  GPR_DEBUG_ASSERT(initial_capacity > 1);
+  size_t capacity = 2;
+  while (capacity < initial_capacity) capacity *= 2;
+  oa_alloc(map, capacity);
+  map->count = 0;
+  map->free = 0;
+  map->open_addressing = true;
+}
+
+/* Stream ids on a connection are allocated sequentially with a stride of two,
+   so mix the bits to spread them over the whole table. */
+static size_t oa_home(const grpc_chttp2_stream_map* map, uint32_t key) {
+  uint32_t h = key * 0x9e3779b9u;
+  h ^= h >> 16;
+  return h & (map->capacity - 1);
+}
+
+/* Returns the slot holding key, or the empty slot ending its probe sequence */
+static size_t oa_probe(const grpc_chttp2_stream_map* map, uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  size_t i = oa_home(map, key);
+  while (map->keys[i] != key && map->keys[i] != 0) i = (i + 1) & mask;
+  return i;
+}
+
+static void oa_grow(grpc_chttp2_stream_map* map) {
+  uint32_t* old_keys = map->keys;
+  void** old_values = map->values;
+  size_t old_capacity = map->capacity;
+  oa_alloc(map, 2 * old_capacity);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_keys[i] == 0) continue;
+    size_t slot = oa_probe(map, old_keys[i]);
+    map->keys[slot] = old_keys[i];
+    map->values[slot] = old_values[i];
+  }
+  gpr_free(old_keys);
+  gpr_free(old_values);
+}
+
+static void oa_add(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  GPR_ASSERT(key != 0);
+  GPR_DEBUG_ASSERT(value);
+  /* keep the load factor at or below 1/2 so probe sequences stay short */
+  if (2 * (map->count + 1) > map->capacity) oa_grow(map);
+  size_t slot = oa_probe(map, key);
+  GPR_DEBUG_ASSERT(map->keys[slot] == 0);
+  map->keys[slot] = key;
+  map->values[slot] = value;
+  map->count++;
+}
+
+static void* oa_delete(grpc_chttp2_stream_map* map, uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  size_t hole = oa_probe(map, key);
+  GPR_DEBUG_ASSERT(map->keys[hole] == key);
+  if (map->keys[hole] != key) return nullptr;
+  void* out = map->values[hole];
+  /* Shift back later entries of the probe sequence that would no longer be
+     reachable from their home slot across the hole. */
+  for (size_t i = (hole + 1) & mask; map->keys[i] != 0; i = (i + 1) & mask) {
+    size_t home = oa_home(map, map->keys[i]);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      map->keys[hole] = map->keys[i];
+      map->values[hole] = map->values[i];
+      hole = i;
+    }
+  }
+  map->keys[hole] = 0;
+  map->values[hole] = nullptr;
+  map->count--;
+  return out;
+}
+
+static void* oa_find(grpc_chttp2_stream_map* map, uint32_t key) {
+  if (key == 0) return nullptr;
+  return map->values[oa_probe(map, key)];
+}
+
+static void* oa_rand(grpc_chttp2_stream_map* map) {
+  if (map->count == 0) return nullptr;
+  const size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->keys[i] == 0) i = (i + 1) & mask;
+  return map->values[i];
+}
+
+static void oa_for_each(grpc_chttp2_stream_map* map,
+                        void (*f)(void* user_data, uint32_t key, void* value),
+                        void* user_data) {
+  /* Callbacks may delete entries, which moves other entries around the table,
+     so iterate over a snapshot of the keys. */
+  size_t n = 0;
+  uint32_t* keys =
+      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * (map->count + 1)));
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (map->keys[i] != 0) keys[n++] = map->keys[i];
+  }
+  for (size_t i = 0; i < n; i++) {
+    void* value = oa_find(map, keys[i]);
+    if (value != nullptr) f(user_data, keys[i], value);
+  }
+  gpr_free(keys);
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -58,6 +172,10 @@ static size_t compact(uint32_t* keys, void** values, size_t count) {
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
+  if (map->open_addressing) {
+    oa_add(map, key, value);
+    return;
+  }
   size_t count = map->count;
   size_t capacity = map->capacity;
   uint32_t* keys = map->keys;
@@ -127,6 +245,7 @@ static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
+  if (map->open_addressing) return oa_delete(map, key);
   void** pvalue = find<true>(map, key);
   GPR_DEBUG_ASSERT(pvalue != nullptr);
   void* out = *pvalue;
@@ -143,15 +262,18 @@ void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
+  if (map->open_addressing) return oa_find(map, key);
   void** pvalue = find<false>(map, key);
   return pvalue != nullptr ? *pvalue : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
+  /* free is always 0 for open addressing maps */
   return map->count - map->free;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
+  if (map->open_addressing) return oa_rand(map);
   if (map->count == map->free) {
     return nullptr;
   }
@@ -167,6 +289,10 @@ void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
+  if (map->open_addressing) {
+    oa_for_each(map, f, user_data);
+    return;
+  }
   size_t i;
 
   for (i = 0; i < map->count; i++) {
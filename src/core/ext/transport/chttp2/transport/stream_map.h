@@ -26,19 +26,33 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   By default represented as a sorted array of keys, and a corresponding array
+   of values. Lookups are performed with binary search.
    Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   guaranteed by http2).
+
+   Maps initialized with grpc_chttp2_stream_map_init_open_addressing instead
+   use an open addressing hash table with linear probing: keys and values are
+   stored at the same index of power-of-two sized arrays, with a key of 0
+   (never a valid stream id) marking an empty slot. Lookups touch one or two
+   cache lines of keys regardless of the number of streams, and deletes shift
+   later entries of the probe sequence back instead of leaving tombstones, so
+   the table never needs compacting. Iteration order is unspecified. */
 struct grpc_chttp2_stream_map {
   uint32_t* keys;
   void** values;
+  /* Sorted array: number of used slots, including deleted ones.
+     Hash table: number of populated slots. */
   size_t count;
+  /* Sorted array: number of deleted slots. Unused by the hash table. */
   size_t free;
   size_t capacity;
+  bool open_addressing;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
+void grpc_chttp2_stream_map_init_open_addressing(grpc_chttp2_stream_map* map,
+                                                 size_t initial_capacity);
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map);
 
 /* Add a new key: given http2 semantics, new keys must always be greater than
@@ -30,6 +30,7 @@
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 // IWYU pragma: no_include "src/core/lib/gprpp/orphanable.h"
 
@@ -38,9 +39,11 @@
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/frame_data.h"
+#include "src/core/ext/transport/chttp2/transport/frame_memfd_data.h"
 #include "src/core/ext/transport/chttp2/transport/frame_ping.h"
 #include "src/core/ext/transport/chttp2/transport/frame_rst_stream.h"
 #include "src/core/ext/transport/chttp2/transport/frame_settings.h"
+#include "src/core/ext/transport/chttp2/transport/frame_size_policy.h"
 #include "src/core/ext/transport/chttp2/transport/frame_window_update.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
@@ -49,6 +52,7 @@
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -57,6 +61,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/transport/bdp_estimator.h"
@@ -228,10 +233,15 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 }
 
 /* How many bytes would we like to put on the wire during a single syscall */
-static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
-  return 1024 * 1024;
+static uint32_t target_write_size(grpc_chttp2_transport* t) {
+  return t->target_write_size;
 }
 
+/* How many bytes a stream of weight 1 may write per round of the writable
+   streams, under chttp2_weighted_fair_writes: streams of the default weight
+   write a minimum sized frame per round */
+static constexpr int64_t kWriteQuantumPerWeight = 1024;
+
 namespace {
 
 class CountDefaultMetadataEncoder {
@@ -372,7 +382,26 @@ class DataSendContext {
       : write_context_(write_context),
         t_(t),
         s_(s),
-        sending_bytes_before_(s_->sending_bytes) {}
+        sending_bytes_before_(s_->sending_bytes),
+        contended_(grpc_chttp2_list_have_writable_streams(t)),
+        weighted_fair_(contended_ &&
+                       grpc_core::IsChttp2WeightedFairWritesEnabled()),
+        max_frame_size_(
+            grpc_core::IsAdaptiveFrameSizeEnabled()
+                ? t->frame_size_policy.FrameSize(
+                      t->settings[GRPC_PEER_SETTINGS]
+                                 [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+                      s->flow_controlled_buffer.length, contended_)
+                : t->settings[GRPC_PEER_SETTINGS]
+                             [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]) {
+    // Streams that are alone writing are not limited: a deficit only
+    // accumulates while the stream takes turns with others.
+    if (weighted_fair_) {
+      s_->write_deficit += kWriteQuantumPerWeight * s_->write_weight;
+    } else {
+      s_->write_deficit = 0;
+    }
+  }
 
   uint32_t stream_remote_window() const {
     return static_cast<uint32_t>(std::max(
@@ -385,14 +414,24 @@ class DataSendContext {
 
   uint32_t max_outgoing() const {
     return static_cast<uint32_t>(std::min(
-        t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+        max_frame_size_,
         static_cast<uint32_t>(std::min(int64_t(stream_remote_window()),
                                        t_->flow_control.remote_window()))));
   }
 
   bool AnyOutgoing() const { return max_outgoing() > 0; }
 
+  // Whether the stream may write its next frame in this round of the
+  // writable streams, or should yield to the others.
+  bool CanSendFrame() const {
+    return !weighted_fair_ ||
+           s_->write_deficit >=
+               static_cast<int64_t>(std::min(
+                   size_t(max_outgoing()), s_->flow_controlled_buffer.length));
+  }
+
   void FlushBytes() {
+    if (MaybeFlushBytesAsMemfd()) return;
     uint32_t send_bytes = static_cast<uint32_t>(
         std::min(size_t(max_outgoing()), s_->flow_controlled_buffer.length));
     is_last_frame_ = send_bytes == s_->flow_controlled_buffer.length &&
@@ -402,10 +441,51 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     sfc_upd_.SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    if (weighted_fair_) s_->write_deficit -= send_bytes;
+  }
+
+  // Passes the next payload to the peer as a memfd instead, when it is large
+  // enough and the connection allows it. Such a payload is not bounded by the
+  // frame size, only by flow control.
+  bool MaybeFlushBytesAsMemfd() {
+    if (t_->memfd_data_min_bytes == 0 ||
+        t_->settings[GRPC_PEER_SETTINGS]
+                    [GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_MEMFD_DATA] == 0 ||
+        t_->memfds_in_outbuf >= GRPC_TCP_MAX_PASSED_FDS) {
+      return false;
+    }
+    uint32_t send_bytes = static_cast<uint32_t>(std::min(
+        s_->flow_controlled_buffer.length,
+        size_t(std::min(int64_t(stream_remote_window()),
+                        t_->flow_control.remote_window()))));
+    if (send_bytes < t_->memfd_data_min_bytes) return false;
+    const bool is_last_frame =
+        send_bytes == s_->flow_controlled_buffer.length &&
+        s_->send_trailing_metadata != nullptr &&
+        s_->send_trailing_metadata->empty();
+    if (!grpc_chttp2_encode_memfd_data(t_->ep, s_->id,
+                                       &s_->flow_controlled_buffer, send_bytes,
+                                       is_last_frame, &s_->stats.outgoing,
+                                       &t_->outbuf)) {
+      return false;
+    }
+    is_last_frame_ = is_last_frame;
+    ++t_->memfds_in_outbuf;
+    sfc_upd_.SentData(send_bytes);
+    s_->sending_bytes += send_bytes;
+    if (weighted_fair_) s_->write_deficit -= send_bytes;
+    return true;
   }
 
   bool is_last_frame() const { return is_last_frame_; }
 
+  // Whether the stream yields to the other writable streams after each
+  // frame, under adaptive_frame_size.
+  bool YieldsAfterEachFrame() const {
+    return contended_ && !weighted_fair_ &&
+           grpc_core::IsAdaptiveFrameSizeEnabled();
+  }
+
   void CallCallbacks() {
     if (update_list(
             t_, s_,
@@ -423,6 +503,10 @@ class DataSendContext {
   grpc_core::chttp2::StreamFlowControl::OutgoingUpdateContext sfc_upd_{
       &s_->flow_control};
   const size_t sending_bytes_before_;
+  // Whether other streams are waiting to write.
+  const bool contended_;
+  const bool weighted_fair_;
+  const uint32_t max_frame_size_;
   bool is_last_frame_ = false;
 };
 
@@ -451,6 +535,7 @@ class StreamWriteContext {
         is_default_initial_metadata(s_->send_initial_metadata)) {
       ConvertInitialMetadataToTrailingMetadata();
     } else {
+      grpc_core::StatsTimer encode_timer;
       t_->hpack_compressor.EncodeHeaders(
           grpc_core::HPackCompressor::EncodeHeaderOptions{
               s_->id,  // stream_id
@@ -465,6 +550,10 @@ class StreamWriteContext {
               &s_->stats.outgoing                         // stats
           },
           *s_->send_initial_metadata, &t_->outbuf);
+      if (encode_timer.enabled()) {
+        GRPC_STATS_INC_HTTP2_HEADER_ENCODE_TIME_NS(
+            encode_timer.ElapsedNanos());
+      }
       grpc_chttp2_reset_ping_clock(t_);
       write_context_->IncInitialMetadataWrites();
     }
@@ -501,6 +590,7 @@ class StreamWriteContext {
     DataSendContext data_send_context(write_context_, t_, s_);
 
     if (!data_send_context.AnyOutgoing()) {
+      s_->write_deficit = 0;
       if (t_->flow_control.remote_window() <= 0) {
         GRPC_STATS_INC_HTTP2_TRANSPORT_STALLS();
         report_stall(t_, s_, "transport");
@@ -514,8 +604,10 @@ class StreamWriteContext {
     }
 
     while (s_->flow_controlled_buffer.length > 0 &&
-           data_send_context.max_outgoing() > 0) {
+           data_send_context.max_outgoing() > 0 &&
+           data_send_context.CanSendFrame()) {
       data_send_context.FlushBytes();
+      if (data_send_context.YieldsAfterEachFrame()) break;
     }
     grpc_chttp2_reset_ping_clock(t_);
     if (data_send_context.is_last_frame()) {
@@ -526,6 +618,8 @@ class StreamWriteContext {
     if (s_->flow_controlled_buffer.length > 0) {
       GRPC_CHTTP2_STREAM_REF(s_, "chttp2_writing:fork");
       grpc_chttp2_list_add_writable_stream(t_, s_);
+    } else {
+      s_->write_deficit = 0;
     }
     write_context_->IncMessageWrites();
   }
@@ -549,6 +643,7 @@ class StreamWriteContext {
         s_->send_trailing_metadata->Set(grpc_core::ContentTypeMetadata(),
                                         *send_content_type_);
       }
+      grpc_core::StatsTimer encode_timer;
       t_->hpack_compressor.EncodeHeaders(
           grpc_core::HPackCompressor::EncodeHeaderOptions{
               s_->id, true,
@@ -560,6 +655,10 @@ class StreamWriteContext {
                           [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
               &s_->stats.outgoing},
           *s_->send_trailing_metadata, &t_->outbuf);
+      if (encode_timer.enabled()) {
+        GRPC_STATS_INC_HTTP2_HEADER_ENCODE_TIME_NS(
+            encode_timer.ElapsedNanos());
+      }
     }
     write_context_->IncTrailingMetadataWrites();
     grpc_chttp2_reset_ping_clock(t_);
@@ -635,6 +734,9 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     stream_ctx.FlushData();
     stream_ctx.FlushTrailingMetadata();
     if (t->outbuf.length > orig_len) {
+      if (s->byte_counter == 0) {
+        s->stats.first_byte_written = gpr_now(GPR_CLOCK_MONOTONIC);
+      }
       /* Add this stream to the list of the contexts to be traced at TCP */
       s->byte_counter += t->outbuf.length - orig_len;
       if (s->traced && grpc_endpoint_can_track_err(t->ep)) {
@@ -660,6 +762,14 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
   return ctx.Result();
 }
 
+void grpc_chttp2_set_stream_write_weight(grpc_chttp2_stream* s,
+                                         const grpc_metadata_batch& md) {
+  absl::optional<uint32_t> weight = md.get(grpc_core::GrpcWriteWeightMetadata());
+  if (!weight.has_value() || *weight == 0) return;
+  s->write_weight = std::min(
+      *weight, uint32_t{grpc_core::GrpcWriteWeightMetadata::kMaxWeight});
+}
+
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
   grpc_chttp2_stream* s;
 
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <new>
 #include <string>
@@ -87,15 +88,24 @@ void ResetSendMessage(grpc_transport_stream_op_batch* batch) {
   std::exchange(batch->payload->send_message.send_message, nullptr)->Clear();
 }
 
+// A lock shared by the client and server sides of a transport, or of a call.
 struct shared_mu {
-  shared_mu() {
-    // Share one lock between both sides since both sides get affected
+  explicit shared_mu(int initial_refs) {
     gpr_mu_init(&mu);
-    gpr_ref_init(&refs, 2);
+    gpr_ref_init(&refs, initial_refs);
   }
 
   ~shared_mu() { gpr_mu_destroy(&mu); }
 
+  void ref() { gpr_ref(&refs); }
+
+  void unref() {
+    if (gpr_unref(&refs)) {
+      this->~shared_mu();
+      gpr_free(this);
+    }
+  }
+
   gpr_mu mu;
   gpr_refcount refs;
 };
@@ -111,13 +121,12 @@ struct inproc_transport {
     // Start each side of transport with 2 refs since they each have a ref
     // to the other
     gpr_ref_init(&refs, 2);
+    gpr_mu_init(&stream_list_mu);
   }
 
   ~inproc_transport() {
-    if (gpr_unref(&mu->refs)) {
-      mu->~shared_mu();
-      gpr_free(mu);
-    }
+    gpr_mu_destroy(&stream_list_mu);
+    mu->unref();
   }
 
   void ref() {
@@ -135,7 +144,13 @@ struct inproc_transport {
     gpr_free(this);
   }
 
+  // Returns the first stream of stream_list with a ref, or null.
+  inproc_stream* ref_first_stream();
+
   grpc_transport base;
+  // Guards the state of the transport, shared with the other side. The
+  // streams are guarded by the call_mu of their call instead, so that calls
+  // do not contend with each other: when both are needed, mu is taken first.
   shared_mu* mu;
   gpr_refcount refs;
   bool is_client;
@@ -143,8 +158,12 @@ struct inproc_transport {
   void (*accept_stream_cb)(void* user_data, grpc_transport* transport,
                            const void* server_data);
   void* accept_stream_data;
-  bool is_closed = false;
+  // Written under mu, read by the streams under their call_mu.
+  std::atomic<bool> is_closed{false};
   struct inproc_transport* other_side;
+  // Guards stream_list and the links of the streams in it; nothing else is
+  // locked while holding it.
+  gpr_mu stream_list_mu;
   struct inproc_stream* stream_list = nullptr;
 };
 
@@ -156,14 +175,22 @@ struct inproc_stream {
     ref("inproc_init_stream:init");
     ref("inproc_init_stream:list");
 
+    // Both sides of a call share the lock of the client side.
+    if (!server_data) {
+      call_mu = new (gpr_malloc(sizeof(*call_mu))) shared_mu(1);
+    } else {
+      call_mu = static_cast<const inproc_stream*>(server_data)->call_mu;
+      call_mu->ref();
+    }
+
     stream_list_prev = nullptr;
-    gpr_mu_lock(&t->mu->mu);
+    gpr_mu_lock(&t->stream_list_mu);
     stream_list_next = t->stream_list;
     if (t->stream_list) {
       t->stream_list->stream_list_prev = this;
     }
     t->stream_list = this;
-    gpr_mu_unlock(&t->mu->mu);
+    gpr_mu_unlock(&t->stream_list_mu);
 
     if (!server_data) {
       t->ref();
@@ -184,9 +211,8 @@ struct inproc_stream {
       // Ref the server-side stream on behalf of the client now
       ref("inproc_init_stream:srv");
 
-      // Now we are about to affect the other side, so lock the transport
-      // to make sure that it doesn't get destroyed
-      gpr_mu_lock(&t->mu->mu);
+      // Now we are about to affect the other side, so lock the call
+      gpr_mu_lock(&call_mu->mu);
       cs->other_side = this;
       // Now transfer from the other side's write_buffer if any to the to_read
       // buffer
@@ -209,11 +235,14 @@ struct inproc_stream {
         maybe_process_ops_locked(this, cancel_other_error);
       }
 
-      gpr_mu_unlock(&t->mu->mu);
+      gpr_mu_unlock(&call_mu->mu);
     }
   }
 
-  ~inproc_stream() { t->unref(); }
+  ~inproc_stream() {
+    call_mu->unref();
+    t->unref();
+  }
 
 #ifndef NDEBUG
 #define STREAM_REF(refs, reason) grpc_stream_ref(refs, reason)
@@ -237,6 +266,8 @@ struct inproc_stream {
   inproc_transport* t;
   grpc_stream_refcount* refs;
   grpc_core::Arena* arena;
+  // Guards both sides of the call.
+  shared_mu* call_mu;
 
   grpc_metadata_batch to_read_initial_md{arena};
   bool to_read_initial_md_filled = false;
@@ -280,11 +311,22 @@ struct inproc_stream {
 
   grpc_core::Timestamp deadline = grpc_core::Timestamp::InfFuture();
 
+  // The links are guarded by the stream_list_mu of the transport; listed is
+  // only written with call_mu held too.
   bool listed = true;
   struct inproc_stream* stream_list_prev;
   struct inproc_stream* stream_list_next;
 };
 
+inproc_stream* inproc_transport::ref_first_stream() {
+  gpr_mu_lock(&stream_list_mu);
+  inproc_stream* s = stream_list;
+  // The list holds a ref to the stream: it is still alive.
+  if (s != nullptr) s->ref("ref_first_stream");
+  gpr_mu_unlock(&stream_list_mu);
+  return s;
+}
+
 void log_metadata(const grpc_metadata_batch* md_batch, bool is_client,
                   bool is_initial) {
   std::string prefix = absl::StrCat(
@@ -355,7 +397,9 @@ void close_stream_locked(inproc_stream* s) {
     s->write_buffer_initial_md.Clear();
     s->write_buffer_trailing_md.Clear();
 
-    if (s->listed) {
+    gpr_mu_lock(&s->t->stream_list_mu);
+    const bool unlist = s->listed;
+    if (unlist) {
       inproc_stream* p = s->stream_list_prev;
       inproc_stream* n = s->stream_list_next;
       if (p != nullptr) {
@@ -367,8 +411,9 @@ void close_stream_locked(inproc_stream* s) {
         n->stream_list_prev = p;
       }
       s->listed = false;
-      s->unref("close_stream:list");
     }
+    gpr_mu_unlock(&s->t->stream_list_mu);
+    if (unlist) s->unref("close_stream:list");
     s->closed = true;
     s->unref("close_stream:closing");
   }
@@ -537,14 +582,8 @@ void fail_helper_locked(inproc_stream* s, grpc_error_handle error) {
   close_stream_locked(s);
 }
 
-// TODO(vjpai): It should not be necessary to drain the incoming byte
-// stream and create a new one; instead, we should simply pass the byte
-// stream from the sender directly to the receiver as-is.
-//
-// Note that fixing this will also avoid the assumption in this code
-// that the incoming byte stream's next() call will always return
-// synchronously.  That assumption is true today but may not always be
-// true in the future.
+// The slices of the message are moved from the sender to the receiver as they
+// are: nothing is copied.
 void message_transfer_locked(inproc_stream* sender, inproc_stream* receiver) {
   *receiver->recv_message_op->payload->recv_message.recv_message =
       std::move(*sender->send_message_op->payload->send_message.send_message);
@@ -913,7 +952,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                        grpc_transport_stream_op_batch* op) {
   INPROC_LOG(GPR_INFO, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu* mu = &s->t->mu->mu;  // save aside in case s gets closed
+  gpr_mu* mu = &s->call_mu->mu;  // save aside in case s gets closed
   gpr_mu_lock(mu);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
@@ -1089,19 +1128,24 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
 }
 
 void close_transport_locked(inproc_transport* t) {
-  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed);
+  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed.load());
   t->state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, absl::Status(),
                             "close transport");
   if (!t->is_closed) {
     t->is_closed = true;
     /* Also end all streams on this transport */
-    while (t->stream_list != nullptr) {
-      // cancel_stream_locked also adjusts stream list
-      cancel_stream_locked(
-          t->stream_list,
-          grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+    while (inproc_stream* s = t->ref_first_stream()) {
+      gpr_mu_lock(&s->call_mu->mu);
+      // cancel_stream_locked also adjusts stream list, unless the call
+      // closed the stream since it was found
+      if (s->listed) {
+        cancel_stream_locked(
+            s, grpc_error_set_int(
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
+                   GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+      }
+      gpr_mu_unlock(&s->call_mu->mu);
+      s->unref("close_transport");
     }
   }
 }
@@ -1139,14 +1183,13 @@ void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
   gpr_mu_unlock(&t->mu->mu);
 }
 
-void destroy_stream(grpc_transport* gt, grpc_stream* gs,
+void destroy_stream(grpc_transport* /*gt*/, grpc_stream* gs,
                     grpc_closure* then_schedule_closure) {
   INPROC_LOG(GPR_INFO, "destroy_stream %p %p", gs, then_schedule_closure);
-  inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&s->call_mu->mu);
   close_stream_locked(s);
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_unlock(&s->call_mu->mu);
   s->~inproc_stream();
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, then_schedule_closure,
                           absl::OkStatus());
@@ -1192,7 +1235,8 @@ const grpc_transport_vtable inproc_vtable = {
 void inproc_transports_create(grpc_transport** server_transport,
                               grpc_transport** client_transport) {
   INPROC_LOG(GPR_INFO, "inproc_transports_create");
-  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
+  // Share one lock between both sides since both sides get affected
+  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu(2);
   inproc_transport* st = new (gpr_malloc(sizeof(*st)))
       inproc_transport(&inproc_vtable, mu, /*is_client=*/false);
   inproc_transport* ct = new (gpr_malloc(sizeof(*ct)))
@@ -0,0 +1,718 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/wakeup_fd_posix.h"
+#include "src/core/lib/slice/slice_refcount_base.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x67536d31;  // "gSm1"
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kMinRingSize = 64 * 1024;
+constexpr size_t kMaxRingSize = 256 * 1024 * 1024;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory rings need address-free atomics");
+
+// The state of one direction of a connection. Positions count every byte
+// ever written, so that a full ring can be told apart from an empty one.
+struct ShmRing {
+  // Bytes written by the producer.
+  alignas(kCacheLineSize) std::atomic<uint64_t> head;
+  // Bytes released by the consumer. The producer may fill the ring up to
+  // tail + ring_size.
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail;
+  // Set by the consumer before waiting for data, and by the producer before
+  // waiting for space. Whoever then makes that progress clears the flag and
+  // signals the waiting side.
+  alignas(kCacheLineSize) std::atomic<uint32_t> consumer_waiting;
+  std::atomic<uint32_t> producer_waiting;
+  // Set once either side is done with the ring.
+  std::atomic<uint32_t> closed;
+};
+
+struct ShmHeader {
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t ring_size;
+  // [0] carries data from the client to the server, [1] the other way.
+  ShmRing rings[2];
+};
+
+size_t PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+size_t RoundUpToPage(size_t n) {
+  return (n + PageSize() - 1) / PageSize() * PageSize();
+}
+
+size_t DataOffset() { return RoundUpToPage(sizeof(ShmHeader)); }
+
+grpc_error_handle CreateEventFd(int* fd) {
+  grpc_wakeup_fd wakeup_fd;
+  grpc_error_handle error =
+      grpc_specialized_wakeup_fd_vtable.init(&wakeup_fd);
+  if (!error.ok()) return error;
+  *fd = GRPC_WAKEUP_FD_GET_READ_FD(&wakeup_fd);
+  return absl::OkStatus();
+}
+
+// The mapping of a connection's shared memory, which stays alive until the
+// last slice pointing into it is released. Also keeps track of which parts of
+// the receive ring are still held by slices.
+class ShmRegion : public RefCounted<ShmRegion> {
+ public:
+  ShmRegion(void* mapping, size_t mapping_size, bool is_client,
+            int peer_wakeup_fd)
+      : mapping_(mapping),
+        mapping_size_(mapping_size),
+        header_(static_cast<ShmHeader*>(mapping)),
+        ring_size_(header_->ring_size),
+        in_ring_(&header_->rings[is_client ? 1 : 0]),
+        out_ring_(&header_->rings[is_client ? 0 : 1]),
+        in_data_(static_cast<char*>(mapping) + DataOffset() +
+                 (is_client ? ring_size_ : 0)),
+        out_data_(static_cast<char*>(mapping) + DataOffset() +
+                  (is_client ? 0 : ring_size_)),
+        released_(in_ring_->tail.load(std::memory_order_relaxed)) {
+    peer_wakeup_fd_.read_fd = peer_wakeup_fd;
+    peer_wakeup_fd_.write_fd = -1;
+  }
+
+  ~ShmRegion() override {
+    munmap(mapping_, mapping_size_);
+    grpc_specialized_wakeup_fd_vtable.destroy(&peer_wakeup_fd_);
+  }
+
+  size_t ring_size() const { return ring_size_; }
+  ShmRing* in_ring() const { return in_ring_; }
+  ShmRing* out_ring() const { return out_ring_; }
+  char* out_data() const { return out_data_; }
+
+  void WakeUpPeer() {
+    grpc_error_handle error =
+        grpc_specialized_wakeup_fd_vtable.wakeup(&peer_wakeup_fd_);
+    if (!error.ok()) {
+      gpr_log(GPR_ERROR, "Failed to wake up shared memory peer: %s",
+              grpc_error_std_string(error).c_str());
+    }
+  }
+
+  // Returns a slice holding the \a length received bytes starting at
+  // position \a pos, which must not wrap around the end of the ring.
+  grpc_slice TakeSlice(uint64_t pos, size_t length);
+
+ private:
+  class SliceRefCount;
+
+  struct Chunk {
+    uint64_t end;
+    // Bytes of the chunk still held by a slice.
+    size_t lent;
+    bool released;
+  };
+
+  void Release(uint64_t seq);
+  // Gives back to the producer the space of the released chunks at the front
+  // of the queue.
+  void AdvanceTailLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  void* const mapping_;
+  const size_t mapping_size_;
+  ShmHeader* const header_;
+  const size_t ring_size_;
+  ShmRing* const in_ring_;
+  ShmRing* const out_ring_;
+  char* const in_data_;
+  char* const out_data_;
+  grpc_wakeup_fd peer_wakeup_fd_;
+
+  Mutex mu_;
+  // Chunks of the receive ring handed out and not yet given back, in ring
+  // order. The front one has sequence number front_seq_.
+  std::deque<Chunk> chunks_ ABSL_GUARDED_BY(mu_);
+  uint64_t front_seq_ ABSL_GUARDED_BY(mu_) = 0;
+  // The end of the last chunk given back to the producer.
+  uint64_t released_ ABSL_GUARDED_BY(mu_);
+  // Bytes of the receive ring still held by slices.
+  size_t lent_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+// Reference count of a slice pointing into the receive ring.
+class ShmRegion::SliceRefCount : public grpc_slice_refcount {
+ public:
+  SliceRefCount(RefCountedPtr<ShmRegion> region, uint64_t seq)
+      : grpc_slice_refcount(Destroy), region_(std::move(region)), seq_(seq) {}
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* rc = static_cast<SliceRefCount*>(p);
+    rc->region_->Release(rc->seq_);
+    delete rc;
+  }
+
+  RefCountedPtr<ShmRegion> region_;
+  const uint64_t seq_;
+};
+
+grpc_slice ShmRegion::TakeSlice(uint64_t pos, size_t length) {
+  char* start = in_data_ + pos % ring_size_;
+  MutexLock lock(&mu_);
+  if (lent_bytes_ + length > ring_size_ / 2) {
+    grpc_slice slice = grpc_slice_from_copied_buffer(start, length);
+    chunks_.push_back(Chunk{pos + length, 0, true});
+    AdvanceTailLocked();
+    return slice;
+  }
+  lent_bytes_ += length;
+  chunks_.push_back(Chunk{pos + length, length, false});
+  grpc_slice slice;
+  slice.refcount =
+      new SliceRefCount(Ref(), front_seq_ + chunks_.size() - 1);
+  slice.data.refcounted.bytes = reinterpret_cast<uint8_t*>(start);
+  slice.data.refcounted.length = length;
+  return slice;
+}
+
+void ShmRegion::Release(uint64_t seq) {
+  MutexLock lock(&mu_);
+  Chunk& chunk = chunks_[seq - front_seq_];
+  lent_bytes_ -= chunk.lent;
+  chunk.released = true;
+  AdvanceTailLocked();
+}
+
+void ShmRegion::AdvanceTailLocked() {
+  const uint64_t old_released = released_;
+  while (!chunks_.empty() && chunks_.front().released) {
+    released_ = chunks_.front().end;
+    chunks_.pop_front();
+    ++front_seq_;
+  }
+  if (released_ == old_released) return;
+  in_ring_->tail.store(released_, std::memory_order_seq_cst);
+  if (in_ring_->producer_waiting.exchange(0, std::memory_order_seq_cst) !=
+      0) {
+    WakeUpPeer();
+  }
+}
+
+class ShmEndpoint {
+ public:
+  ShmEndpoint(RefCountedPtr<ShmRegion> region, int wakeup_fd, bool is_client,
+              grpc_endpoint* control);
+
+  static ShmEndpoint* FromBase(grpc_endpoint* ep) {
+    return reinterpret_cast<ShmEndpoint*>(ep);
+  }
+  grpc_endpoint* base() { return &base_; }
+
+  // Starts watching the control connection for the peer going away.
+  void Start();
+
+ private:
+  ~ShmEndpoint();
+
+  void Ref() { refs_.Ref(); }
+  void Unref() {
+    if (refs_.Unref()) delete this;
+  }
+
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, bool urgent, int min_progress_size);
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* arg, int max_frame_size);
+  static void AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset);
+  static void AddToPollsetSet(grpc_endpoint* ep, grpc_pollset_set* pollset);
+  static void DeleteFromPollsetSet(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset);
+  static void Shutdown(grpc_endpoint* ep, grpc_error_handle why);
+  static void Destroy(grpc_endpoint* ep);
+  static absl::string_view GetPeer(grpc_endpoint* ep);
+  static absl::string_view GetLocalAddress(grpc_endpoint* ep);
+  static int GetFd(grpc_endpoint* /*ep*/) { return -1; }
+  static bool CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  static const grpc_endpoint_vtable kVtable;
+
+  void ShutdownLocked(grpc_error_handle why) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Moves the pending read and write along as far as the rings allow, and
+  // waits to be woken up by the peer if either is left pending.
+  void ProgressLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void TryReadLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void TryWriteLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FinishReadLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FinishWriteLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnWakeup(void* arg, grpc_error_handle error);
+  static void OnControlReadDone(void* arg, grpc_error_handle error);
+
+  // Must be first, so that a grpc_endpoint* can be cast to this class.
+  grpc_endpoint base_;
+  RefCount refs_;
+  RefCountedPtr<ShmRegion> region_;
+  grpc_fd* wakeup_fd_;
+  grpc_endpoint* control_;
+  grpc_slice_buffer control_buffer_;
+  std::string peer_address_;
+  std::string local_address_;
+  grpc_closure on_wakeup_;
+  grpc_closure on_control_read_done_;
+
+  Mutex mu_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_error_handle shutdown_error_ ABSL_GUARDED_BY(mu_);
+  bool wakeup_armed_ ABSL_GUARDED_BY(mu_) = false;
+  // The pending read, if any, and how far the receive ring has been handed
+  // out to reads.
+  grpc_closure* read_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* read_slices_ ABSL_GUARDED_BY(mu_) = nullptr;
+  uint64_t read_pos_ ABSL_GUARDED_BY(mu_);
+  // The pending write, if any, and the next byte of it to copy into the
+  // send ring.
+  grpc_closure* write_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* write_slices_ ABSL_GUARDED_BY(mu_) = nullptr;
+  size_t write_slice_index_ ABSL_GUARDED_BY(mu_) = 0;
+  size_t write_slice_offset_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t write_pos_ ABSL_GUARDED_BY(mu_);
+};
+
+const grpc_endpoint_vtable ShmEndpoint::kVtable = {
+    ShmEndpoint::Read,
+    ShmEndpoint::Write,
+    ShmEndpoint::AddToPollset,
+    ShmEndpoint::AddToPollsetSet,
+    ShmEndpoint::DeleteFromPollsetSet,
+    ShmEndpoint::Shutdown,
+    ShmEndpoint::Destroy,
+    ShmEndpoint::GetPeer,
+    ShmEndpoint::GetLocalAddress,
+    ShmEndpoint::GetFd,
+    ShmEndpoint::CanTrackErr,
+    nullptr};
+
+ShmEndpoint::ShmEndpoint(RefCountedPtr<ShmRegion> region, int wakeup_fd,
+                         bool is_client, grpc_endpoint* control)
+    : region_(std::move(region)),
+      wakeup_fd_(grpc_fd_create(
+          wakeup_fd, is_client ? "shm-client-wakeup" : "shm-server-wakeup",
+          false)),
+      control_(control),
+      peer_address_(grpc_endpoint_get_peer(control)),
+      local_address_(grpc_endpoint_get_local_address(control)),
+      read_pos_(region_->in_ring()->tail.load(std::memory_order_relaxed)),
+      write_pos_(region_->out_ring()->head.load(std::memory_order_relaxed)) {
+  base_.vtable = &kVtable;
+  grpc_slice_buffer_init(&control_buffer_);
+  GRPC_CLOSURE_INIT(&on_wakeup_, OnWakeup, this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_control_read_done_, OnControlReadDone, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+ShmEndpoint::~ShmEndpoint() {
+  grpc_fd_orphan(wakeup_fd_, nullptr, nullptr, "shm endpoint destroyed");
+  grpc_endpoint_destroy(control_);
+  grpc_slice_buffer_destroy(&control_buffer_);
+}
+
+void ShmEndpoint::Start() {
+  // Held by the read on the control connection.
+  Ref();
+  grpc_endpoint_read(control_, &control_buffer_, &on_control_read_done_,
+                     /*urgent=*/false, /*min_progress_size=*/1);
+}
+
+void ShmEndpoint::OnControlReadDone(void* arg, grpc_error_handle error) {
+  auto* self = static_cast<ShmEndpoint*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    if (error.ok()) {
+      error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Unexpected data on shared memory control connection");
+    }
+    self->ShutdownLocked(GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+        "Shared memory peer went away", &error, 1));
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                       grpc_closure* cb, bool /*urgent*/,
+                       int /*min_progress_size*/) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_slice_buffer_reset_and_unref(slices);
+  MutexLock lock(&self->mu_);
+  GPR_ASSERT(self->read_cb_ == nullptr);
+  if (self->shutdown_) {
+    ExecCtx::Run(DEBUG_LOCATION, cb, self->shutdown_error_);
+    return;
+  }
+  self->read_cb_ = cb;
+  self->read_slices_ = slices;
+  self->ProgressLocked();
+}
+
+void ShmEndpoint::Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                        grpc_closure* cb, void* /*arg*/,
+                        int /*max_frame_size*/) {
+  ShmEndpoint* self = FromBase(ep);
+  MutexLock lock(&self->mu_);
+  GPR_ASSERT(self->write_cb_ == nullptr);
+  if (self->shutdown_) {
+    ExecCtx::Run(DEBUG_LOCATION, cb, self->shutdown_error_);
+    return;
+  }
+  if (slices->length == 0) {
+    ExecCtx::Run(DEBUG_LOCATION, cb, absl::OkStatus());
+    return;
+  }
+  self->write_cb_ = cb;
+  self->write_slices_ = slices;
+  self->write_slice_index_ = 0;
+  self->write_slice_offset_ = 0;
+  self->ProgressLocked();
+}
+
+void ShmEndpoint::ProgressLocked() {
+  ShmRegion* region = region_.get();
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if (read_cb_ != nullptr) TryReadLocked();
+    if (write_cb_ != nullptr) TryWriteLocked();
+    if (read_cb_ == nullptr && write_cb_ == nullptr) return;
+    if (attempt == 0) {
+      // Let the peer know that we are about to wait, then look again in case
+      // it made progress before it could see that.
+      if (read_cb_ != nullptr) {
+        region->in_ring()->consumer_waiting.store(1, std::memory_order_seq_cst);
+      }
+      if (write_cb_ != nullptr) {
+        region->out_ring()->producer_waiting.store(1,
+                                                   std::memory_order_seq_cst);
+      }
+    }
+  }
+  if (!wakeup_armed_) {
+    wakeup_armed_ = true;
+    // Held by the wakeup callback.
+    Ref();
+    grpc_fd_notify_on_read(wakeup_fd_, &on_wakeup_);
+  }
+}
+
+void ShmEndpoint::TryReadLocked() {
+  ShmRing* ring = region_->in_ring();
+  const size_t ring_size = region_->ring_size();
+  // Loaded before head: the peer closes the ring only after its last write.
+  const bool closed = ring->closed.load(std::memory_order_acquire) != 0;
+  const uint64_t head = ring->head.load(std::memory_order_acquire);
+  const uint64_t available = head - read_pos_;
+  if (available > ring_size) {
+    ShutdownLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory peer overran the ring"));
+    return;
+  }
+  if (available == 0) {
+    if (closed) {
+      FinishReadLocked(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory peer closed"));
+    }
+    return;
+  }
+  // Data that wraps around the end of the ring is handed out in two slices.
+  const size_t first = std::min<uint64_t>(
+      available, ring_size - read_pos_ % ring_size);
+  grpc_slice_buffer_add(read_slices_, region_->TakeSlice(read_pos_, first));
+  if (first < available) {
+    grpc_slice_buffer_add(read_slices_,
+                          region_->TakeSlice(read_pos_ + first,
+                                             available - first));
+  }
+  read_pos_ = head;
+  FinishReadLocked(absl::OkStatus());
+}
+
+void ShmEndpoint::TryWriteLocked() {
+  ShmRing* ring = region_->out_ring();
+  const size_t ring_size = region_->ring_size();
+  if (ring->closed.load(std::memory_order_acquire) != 0) {
+    FinishWriteLocked(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory peer closed"));
+    return;
+  }
+  const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+  if (write_pos_ - tail > ring_size) {
+    ShutdownLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory peer released more than was sent"));
+    return;
+  }
+  const uint64_t start_pos = write_pos_;
+  const uint64_t limit = tail + ring_size;
+  char* data = region_->out_data();
+  while (write_pos_ < limit &&
+         write_slice_index_ < write_slices_->count) {
+    const grpc_slice& slice = write_slices_->slices[write_slice_index_];
+    const size_t offset = write_pos_ % ring_size;
+    const size_t n = std::min<uint64_t>(
+        {GRPC_SLICE_LENGTH(slice) - write_slice_offset_, limit - write_pos_,
+         ring_size - offset});
+    memcpy(data + offset, GRPC_SLICE_START_PTR(slice) + write_slice_offset_,
+           n);
+    write_pos_ += n;
+    write_slice_offset_ += n;
+    if (write_slice_offset_ == GRPC_SLICE_LENGTH(slice)) {
+      ++write_slice_index_;
+      write_slice_offset_ = 0;
+    }
+  }
+  if (write_pos_ != start_pos) {
+    ring->head.store(write_pos_, std::memory_order_seq_cst);
+    if (ring->consumer_waiting.exchange(0, std::memory_order_seq_cst) != 0) {
+      region_->WakeUpPeer();
+    }
+  }
+  if (write_slice_index_ == write_slices_->count) {
+    FinishWriteLocked(absl::OkStatus());
+  }
+}
+
+void ShmEndpoint::FinishReadLocked(grpc_error_handle error) {
+  ExecCtx::Run(DEBUG_LOCATION, read_cb_, error);
+  read_cb_ = nullptr;
+  read_slices_ = nullptr;
+}
+
+void ShmEndpoint::FinishWriteLocked(grpc_error_handle error) {
+  ExecCtx::Run(DEBUG_LOCATION, write_cb_, error);
+  write_cb_ = nullptr;
+  write_slices_ = nullptr;
+}
+
+void ShmEndpoint::OnWakeup(void* arg, grpc_error_handle error) {
+  auto* self = static_cast<ShmEndpoint*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    self->wakeup_armed_ = false;
+    if (!self->shutdown_) {
+      if (!error.ok()) {
+        self->ShutdownLocked(error);
+      } else {
+        grpc_wakeup_fd wakeup_fd;
+        wakeup_fd.read_fd = grpc_fd_wrapped_fd(self->wakeup_fd_);
+        wakeup_fd.write_fd = -1;
+        GRPC_LOG_IF_ERROR(
+            "shm wakeup",
+            grpc_specialized_wakeup_fd_vtable.consume(&wakeup_fd));
+        self->ProgressLocked();
+      }
+    }
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::ShutdownLocked(grpc_error_handle why) {
+  if (shutdown_) return;
+  shutdown_ = true;
+  shutdown_error_ = why;
+  // Tell the peer that neither ring will be used any more.
+  region_->in_ring()->closed.store(1, std::memory_order_seq_cst);
+  region_->out_ring()->closed.store(1, std::memory_order_seq_cst);
+  region_->WakeUpPeer();
+  if (read_cb_ != nullptr) FinishReadLocked(why);
+  if (write_cb_ != nullptr) FinishWriteLocked(why);
+  grpc_fd_shutdown(wakeup_fd_, why);
+  grpc_endpoint_shutdown(control_, why);
+}
+
+void ShmEndpoint::Shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+  ShmEndpoint* self = FromBase(ep);
+  MutexLock lock(&self->mu_);
+  self->ShutdownLocked(why);
+}
+
+void ShmEndpoint::Destroy(grpc_endpoint* ep) {
+  ShmEndpoint* self = FromBase(ep);
+  {
+    MutexLock lock(&self->mu_);
+    self->ShutdownLocked(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory endpoint closed"));
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_add_fd(pollset, self->wakeup_fd_);
+  grpc_endpoint_add_to_pollset(self->control_, pollset);
+}
+
+void ShmEndpoint::AddToPollsetSet(grpc_endpoint* ep,
+                                  grpc_pollset_set* pollset_set) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_set_add_fd(pollset_set, self->wakeup_fd_);
+  grpc_endpoint_add_to_pollset_set(self->control_, pollset_set);
+}
+
+void ShmEndpoint::DeleteFromPollsetSet(grpc_endpoint* ep,
+                                       grpc_pollset_set* pollset_set) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_set_del_fd(pollset_set, self->wakeup_fd_);
+  grpc_endpoint_delete_from_pollset_set(self->control_, pollset_set);
+}
+
+absl::string_view ShmEndpoint::GetPeer(grpc_endpoint* ep) {
+  return FromBase(ep)->peer_address_;
+}
+
+absl::string_view ShmEndpoint::GetLocalAddress(grpc_endpoint* ep) {
+  return FromBase(ep)->local_address_;
+}
+
+}  // namespace
+
+absl::StatusOr<ShmConnectionFds> ShmCreateConnectionFds(size_t ring_size) {
+  ring_size = RoundUpToPage(Clamp(ring_size, kMinRingSize, kMaxRingSize));
+  const size_t mapping_size = DataOffset() + 2 * ring_size;
+  ShmConnectionFds fds;
+  fds.memfd = static_cast<int>(syscall(SYS_memfd_create, "grpc-shm",
+                                       MFD_CLOEXEC));
+  if (fds.memfd < 0) return GRPC_OS_ERROR(errno, "memfd_create");
+  if (ftruncate(fds.memfd, static_cast<off_t>(mapping_size)) != 0) {
+    grpc_error_handle error = GRPC_OS_ERROR(errno, "ftruncate");
+    ShmCloseConnectionFds(&fds);
+    return error;
+  }
+  void* mapping = mmap(nullptr, DataOffset(), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fds.memfd, 0);
+  if (mapping == MAP_FAILED) {
+    grpc_error_handle error = GRPC_OS_ERROR(errno, "mmap");
+    ShmCloseConnectionFds(&fds);
+    return error;
+  }
+  ShmHeader* header = new (mapping) ShmHeader();
+  header->magic = kShmMagic;
+  header->ring_size = ring_size;
+  munmap(mapping, DataOffset());
+  grpc_error_handle error = CreateEventFd(&fds.client_wakeup_fd);
+  if (error.ok()) error = CreateEventFd(&fds.server_wakeup_fd);
+  if (!error.ok()) {
+    ShmCloseConnectionFds(&fds);
+    return error;
+  }
+  return fds;
+}
+
+void ShmCloseConnectionFds(ShmConnectionFds* fds) {
+  for (int* fd :
+       {&fds->memfd, &fds->client_wakeup_fd, &fds->server_wakeup_fd}) {
+    if (*fd >= 0) close(*fd);
+    *fd = -1;
+  }
+}
+
+absl::StatusOr<grpc_endpoint*> ShmEndpointCreate(ShmConnectionFds fds,
+                                                 bool is_client,
+                                                 grpc_endpoint* control) {
+  // The client made the memory, but the server has to check everything about
+  // it before relying on it.
+  struct stat st;
+  if (fstat(fds.memfd, &st) != 0) {
+    grpc_error_handle error = GRPC_OS_ERROR(errno, "fstat");
+    ShmCloseConnectionFds(&fds);
+    return error;
+  }
+  const size_t mapping_size = static_cast<size_t>(st.st_size);
+  if (mapping_size < DataOffset() + 2 * kMinRingSize) {
+    ShmCloseConnectionFds(&fds);
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory is too small");
+  }
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fds.memfd, 0);
+  if (mapping == MAP_FAILED) {
+    grpc_error_handle error = GRPC_OS_ERROR(errno, "mmap");
+    ShmCloseConnectionFds(&fds);
+    return error;
+  }
+  // The mapping stays valid once the memfd is closed.
+  close(fds.memfd);
+  const ShmHeader* header = static_cast<const ShmHeader*>(mapping);
+  if (header->magic != kShmMagic ||
+      header->ring_size < kMinRingSize || header->ring_size > kMaxRingSize ||
+      DataOffset() + 2 * header->ring_size != mapping_size) {
+    munmap(mapping, mapping_size);
+    close(fds.client_wakeup_fd);
+    close(fds.server_wakeup_fd);
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory has an unexpected layout");
+  }
+  auto region = MakeRefCounted<ShmRegion>(
+      mapping, mapping_size, is_client,
+      is_client ? fds.server_wakeup_fd : fds.client_wakeup_fd);
+  auto* ep = new ShmEndpoint(
+      std::move(region),
+      is_client ? fds.client_wakeup_fd : fds.server_wakeup_fd, is_client,
+      control);
+  ep->Start();
+  return ep->base();
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
@@ -0,0 +1,86 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/port.h"
+
+#if defined(GRPC_LINUX_MEMFD) && defined(GRPC_LINUX_EVENTFD) && \
+    defined(GRPC_POSIX_SOCKET_TCP)
+#define GRPC_HAVE_SHM_ENDPOINT 1
+#endif
+
+// An endpoint between two processes on the same host that moves bytes
+// through shared memory instead of a socket.
+//
+// Each connection shares one memfd holding a ring buffer per direction.
+// Each side also has an eventfd, which the other side signals when it makes
+// progress (new data, or freed space) that the first side is waiting for.
+// Signals are only sent to a side that has said it is about to wait, so a
+// busy connection moves data without any system calls.
+//
+// Reads hand out slices that point straight into the receive ring; their
+// space is given back to the sender as the slices are released. So that the
+// sender can always make progress, reads copy the data out instead once half
+// of the ring is held by unreleased slices.
+//
+// Both processes can write to the shared memory at any time, so this is only
+// meant for peers that trust each other, such as an application and its
+// sidecar.
+
+namespace grpc_core {
+
+// The descriptors for one shared-memory connection.
+struct ShmConnectionFds {
+  int memfd = -1;
+  // Signalled by the server to wake up the client.
+  int client_wakeup_fd = -1;
+  // Signalled by the client to wake up the server.
+  int server_wakeup_fd = -1;
+};
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+// Creates the shared memory and eventfds for a new connection, with rings of
+// at least \a ring_size bytes in each direction.
+absl::StatusOr<ShmConnectionFds> ShmCreateConnectionFds(size_t ring_size);
+
+// Closes whichever of the descriptors in \a fds are open.
+void ShmCloseConnectionFds(ShmConnectionFds* fds);
+
+// Creates the client or server end of a connection over \a fds, taking
+// ownership of the descriptors whether or not it succeeds.
+//
+// \a control is the connection that the descriptors were exchanged over. No
+// data is sent on it any more, but the endpoint watches it so as to fail
+// once the peer process goes away. On success the new endpoint owns it; on
+// failure the caller keeps it.
+absl::StatusOr<grpc_endpoint*> ShmEndpointCreate(ShmConnectionFds fds,
+                                                 bool is_client,
+                                                 grpc_endpoint* control);
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
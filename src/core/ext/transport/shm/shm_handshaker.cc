@@ -0,0 +1,561 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_handshaker.h"
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/tcp_server.h"
+#include "src/core/lib/transport/handshaker.h"
+#include "src/core/lib/transport/handshaker_factory.h"
+#include "src/core/lib/transport/handshaker_registry.h"
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
+
+namespace grpc_core {
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+namespace {
+
+// Sent by the client along with the connection's descriptors, and sent back
+// by the server once it has taken them.
+constexpr char kGreeting[] = {'G', 'R', 'P', 'C', '-', 'S', 'H', 'M'};
+constexpr size_t kGreetingLength = sizeof(kGreeting);
+constexpr int kNumFds = 3;
+constexpr int kDefaultRingSize = 1024 * 1024;
+
+class ShmHandshaker : public Handshaker {
+ public:
+  ShmHandshaker(bool is_client, grpc_pollset_set* interested_parties);
+  void Shutdown(grpc_error_handle why) override;
+  void DoHandshake(grpc_tcp_server_acceptor* acceptor,
+                   grpc_closure* on_handshake_done,
+                   HandshakerArgs* args) override;
+  const char* name() const override { return "shm"; }
+
+ private:
+  ~ShmHandshaker() override;
+  void CleanupArgsForFailureLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void HandshakeFailedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Swaps the endpoint for a shared-memory one.
+  void FinishLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Client side.
+  grpc_error_handle SendGreetingLocked(int fd)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnReplyReadDoneScheduler(void* arg, grpc_error_handle error);
+  static void OnReplyReadDone(void* arg, grpc_error_handle error);
+
+  // Server side.
+  // Returns false if the handshake is over, in which case the caller drops
+  // its ref to the handshaker; otherwise, the pending operation holds it.
+  bool ContinueReceivingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Returns true once the whole greeting has arrived.
+  absl::StatusOr<bool> ReceiveGreetingLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void StopWatchingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnReadable(void* arg, grpc_error_handle error);
+  static void OnReplyWriteDoneScheduler(void* arg, grpc_error_handle error);
+  static void OnReplyWriteDone(void* arg, grpc_error_handle error);
+
+  const bool is_client_;
+  grpc_pollset_set* const interested_parties_;
+
+  Mutex mu_;
+
+  bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // Endpoint and read buffer to destroy after a shutdown.
+  grpc_endpoint* endpoint_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* read_buffer_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
+
+  // State saved while performing the handshake.
+  HandshakerArgs* args_ = nullptr;
+  grpc_closure* on_handshake_done_ = nullptr;
+
+  ShmConnectionFds fds_ ABSL_GUARDED_BY(mu_);
+  // How much of the greeting has been received.
+  size_t greeting_length_ ABSL_GUARDED_BY(mu_) = 0;
+  // On the server, a duplicate of the connection's socket, polled until the
+  // greeting arrives. The greeting has to be read with recvmsg() to get at
+  // the descriptors passed with it, which the endpoint's reads would drop.
+  grpc_fd* watched_fd_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer write_buffer_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_readable_ ABSL_GUARDED_BY(mu_);
+  grpc_closure read_done_closure_ ABSL_GUARDED_BY(mu_);
+  grpc_closure write_done_closure_ ABSL_GUARDED_BY(mu_);
+};
+
+ShmHandshaker::ShmHandshaker(bool is_client,
+                             grpc_pollset_set* interested_parties)
+    : is_client_(is_client), interested_parties_(interested_parties) {
+  grpc_slice_buffer_init(&write_buffer_);
+}
+
+ShmHandshaker::~ShmHandshaker() {
+  GPR_ASSERT(watched_fd_ == nullptr);
+  ShmCloseConnectionFds(&fds_);
+  if (endpoint_to_destroy_ != nullptr) {
+    grpc_endpoint_destroy(endpoint_to_destroy_);
+  }
+  if (read_buffer_to_destroy_ != nullptr) {
+    grpc_slice_buffer_destroy(read_buffer_to_destroy_);
+    gpr_free(read_buffer_to_destroy_);
+  }
+  grpc_slice_buffer_destroy(&write_buffer_);
+}
+
+// Set args fields to nullptr, saving the endpoint and read buffer for
+// later destruction.
+void ShmHandshaker::CleanupArgsForFailureLocked() {
+  StopWatchingLocked();
+  endpoint_to_destroy_ = args_->endpoint;
+  args_->endpoint = nullptr;
+  read_buffer_to_destroy_ = args_->read_buffer;
+  args_->read_buffer = nullptr;
+  args_->args = ChannelArgs();
+}
+
+// If the handshake failed or we're shutting down, clean up and invoke the
+// callback with the error.
+void ShmHandshaker::HandshakeFailedLocked(grpc_error_handle error) {
+  if (error.ok()) {
+    // If we were shut down after an operation succeeded but before its
+    // callback was invoked, we need to generate our own error.
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown");
+  }
+  if (!is_shutdown_) {
+    grpc_endpoint_shutdown(args_->endpoint, error);
+    CleanupArgsForFailureLocked();
+    is_shutdown_ = true;
+  }
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, error);
+}
+
+void ShmHandshaker::FinishLocked() {
+  absl::StatusOr<grpc_endpoint*> endpoint =
+      ShmEndpointCreate(fds_, is_client_, args_->endpoint);
+  fds_ = ShmConnectionFds();
+  if (!endpoint.ok()) {
+    HandshakeFailedLocked(endpoint.status());
+    return;
+  }
+  args_->endpoint = *endpoint;
+  grpc_slice_buffer_reset_and_unref(args_->read_buffer);
+  // Set shutdown to true so that subsequent calls to Shutdown() do nothing.
+  is_shutdown_ = true;
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, absl::OkStatus());
+}
+
+//
+// Client side
+//
+
+grpc_error_handle ShmHandshaker::SendGreetingLocked(int fd) {
+  iovec iov;
+  iov.iov_base = const_cast<char*>(kGreeting);
+  iov.iov_len = kGreetingLength;
+  union {
+    cmsghdr align;
+    char buf[CMSG_SPACE(kNumFds * sizeof(int))];
+  } control;
+  memset(&control, 0, sizeof(control));
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(kNumFds * sizeof(int));
+  const int fds[kNumFds] = {fds_.memfd, fds_.client_wakeup_fd,
+                            fds_.server_wakeup_fd};
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+  ssize_t sent;
+  do {
+    sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  // The connection is brand new, so its send buffer has room for the whole
+  // greeting.
+  if (sent < 0) return GRPC_OS_ERROR(errno, "sendmsg");
+  if (static_cast<size_t>(sent) != kGreetingLength) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Short write of shared memory greeting");
+  }
+  return absl::OkStatus();
+}
+
+// This callback can be invoked inline while already holding onto the mutex. To
+// avoid deadlocks, schedule OnReplyReadDone on ExecCtx.
+void ShmHandshaker::OnReplyReadDoneScheduler(void* arg,
+                                             grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ExecCtx::Run(DEBUG_LOCATION,
+               GRPC_CLOSURE_INIT(&handshaker->read_done_closure_,
+                                 &ShmHandshaker::OnReplyReadDone, handshaker,
+                                 grpc_schedule_on_exec_ctx),
+               error);
+}
+
+// Callback invoked for reading the server's reply to the greeting.
+void ShmHandshaker::OnReplyReadDone(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  if (!error.ok() || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(error);
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  grpc_slice_buffer* buffer = handshaker->args_->read_buffer;
+  const size_t length = handshaker->greeting_length_ + buffer->length;
+  if (length > kGreetingLength) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Unexpected data after shared memory greeting"));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  char reply[kGreetingLength];
+  grpc_slice_buffer_move_first_into_buffer(buffer, buffer->length, reply);
+  if (memcmp(reply, kGreeting + handshaker->greeting_length_,
+             length - handshaker->greeting_length_) != 0) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Server did not accept shared memory"));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  handshaker->greeting_length_ = length;
+  if (length < kGreetingLength) {
+    grpc_endpoint_read(
+        handshaker->args_->endpoint, handshaker->args_->read_buffer,
+        GRPC_CLOSURE_INIT(&handshaker->read_done_closure_,
+                          &ShmHandshaker::OnReplyReadDoneScheduler,
+                          handshaker, grpc_schedule_on_exec_ctx),
+        /*urgent=*/true, /*min_progress_size=*/1);
+    return;
+  }
+  handshaker->FinishLocked();
+  lock.Release();
+  handshaker->Unref();
+}
+
+//
+// Server side
+//
+
+bool ShmHandshaker::ContinueReceivingLocked() {
+  absl::StatusOr<bool> done = ReceiveGreetingLocked();
+  if (!done.ok()) {
+    HandshakeFailedLocked(done.status());
+    return false;
+  }
+  if (!*done) {
+    // The callback inherits our ref to the handshaker.
+    grpc_fd_notify_on_read(watched_fd_,
+                           GRPC_CLOSURE_INIT(&on_readable_,
+                                             &ShmHandshaker::OnReadable, this,
+                                             grpc_schedule_on_exec_ctx));
+    return true;
+  }
+  StopWatchingLocked();
+  grpc_slice_buffer_add(&write_buffer_, grpc_slice_from_static_buffer(
+                                            kGreeting, kGreetingLength));
+  // The write callback inherits our ref to the handshaker.
+  grpc_endpoint_write(
+      args_->endpoint, &write_buffer_,
+      GRPC_CLOSURE_INIT(&write_done_closure_,
+                        &ShmHandshaker::OnReplyWriteDoneScheduler, this,
+                        grpc_schedule_on_exec_ctx),
+      nullptr, /*max_frame_size=*/INT_MAX);
+  return true;
+}
+
+absl::StatusOr<bool> ShmHandshaker::ReceiveGreetingLocked() {
+  const int fd = grpc_fd_wrapped_fd(watched_fd_);
+  while (greeting_length_ < kGreetingLength) {
+    char buf[kGreetingLength];
+    iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = kGreetingLength - greeting_length_;
+    union {
+      cmsghdr align;
+      char buf[CMSG_SPACE(kNumFds * sizeof(int))];
+    } control;
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    ssize_t received;
+    do {
+      received = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+      return GRPC_OS_ERROR(errno, "recvmsg");
+    }
+    // Take ownership of any descriptors first, so that they are closed
+    // whatever else goes wrong.
+    bool got_fds = false;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+        continue;
+      }
+      const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      int fds[kNumFds];
+      for (size_t i = 0; i < count; ++i) {
+        int received_fd;
+        memcpy(&received_fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        if (count == kNumFds && i < kNumFds) {
+          fds[i] = received_fd;
+        } else {
+          close(received_fd);
+        }
+      }
+      if (count == kNumFds) {
+        ShmCloseConnectionFds(&fds_);
+        fds_.memfd = fds[0];
+        fds_.client_wakeup_fd = fds[1];
+        fds_.server_wakeup_fd = fds[2];
+        got_fds = true;
+      }
+    }
+    if (received == 0) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Connection closed during shared memory handshake");
+    }
+    if ((msg.msg_flags & MSG_CTRUNC) != 0 ||
+        (got_fds && greeting_length_ != 0)) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Malformed shared memory greeting");
+    }
+    if (memcmp(buf, kGreeting + greeting_length_,
+               static_cast<size_t>(received)) != 0) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Client did not ask for shared memory");
+    }
+    greeting_length_ += static_cast<size_t>(received);
+  }
+  if (fds_.memfd < 0) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Client did not pass shared memory descriptors");
+  }
+  return true;
+}
+
+void ShmHandshaker::StopWatchingLocked() {
+  if (watched_fd_ == nullptr) return;
+  if (interested_parties_ != nullptr) {
+    grpc_pollset_set_del_fd(interested_parties_, watched_fd_);
+  }
+  // Release rather than close the descriptor: shutting down the duplicate
+  // would shut down the connection itself.
+  int fd;
+  grpc_fd_orphan(watched_fd_, nullptr, &fd, "shm handshake done");
+  close(fd);
+  watched_fd_ = nullptr;
+}
+
+void ShmHandshaker::OnReadable(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  if (!error.ok() || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(error);
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  if (!handshaker->ContinueReceivingLocked()) {
+    lock.Release();
+    handshaker->Unref();
+  }
+}
+
+// This callback can be invoked inline while already holding onto the mutex. To
+// avoid deadlocks, schedule OnReplyWriteDone on ExecCtx.
+void ShmHandshaker::OnReplyWriteDoneScheduler(void* arg,
+                                              grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ExecCtx::Run(DEBUG_LOCATION,
+               GRPC_CLOSURE_INIT(&handshaker->write_done_closure_,
+                                 &ShmHandshaker::OnReplyWriteDone, handshaker,
+                                 grpc_schedule_on_exec_ctx),
+               error);
+}
+
+// Callback invoked when finished writing the reply to the greeting.
+void ShmHandshaker::OnReplyWriteDone(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  if (!error.ok() || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(error);
+  } else {
+    handshaker->FinishLocked();
+  }
+  lock.Release();
+  handshaker->Unref();
+}
+
+//
+// Public handshaker methods
+//
+
+void ShmHandshaker::Shutdown(grpc_error_handle why) {
+  MutexLock lock(&mu_);
+  if (!is_shutdown_) {
+    is_shutdown_ = true;
+    grpc_endpoint_shutdown(args_->endpoint, why);
+    CleanupArgsForFailureLocked();
+  }
+}
+
+void ShmHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                                grpc_closure* on_handshake_done,
+                                HandshakerArgs* args) {
+  ReleasableMutexLock lock(&mu_);
+  args_ = args;
+  on_handshake_done_ = on_handshake_done;
+  if (!args->args.GetBool(GRPC_ARG_SHM_TRANSPORT).value_or(false)) {
+    // Set shutdown to true so that subsequent calls to Shutdown() do nothing.
+    is_shutdown_ = true;
+    ExecCtx::Run(DEBUG_LOCATION, on_handshake_done, absl::OkStatus());
+    return;
+  }
+  const int fd = grpc_endpoint_get_fd(args->endpoint);
+  if (fd < 0) {
+    HandshakeFailedLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory needs a unix domain socket to set up"));
+    return;
+  }
+  if (is_client_) {
+    absl::StatusOr<ShmConnectionFds> fds = ShmCreateConnectionFds(
+        args->args.GetInt(GRPC_ARG_SHM_RING_SIZE).value_or(kDefaultRingSize));
+    if (!fds.ok()) {
+      HandshakeFailedLocked(fds.status());
+      return;
+    }
+    fds_ = *fds;
+    grpc_error_handle error = SendGreetingLocked(fd);
+    if (!error.ok()) {
+      HandshakeFailedLocked(error);
+      return;
+    }
+    // Take a new ref to be held by the read callback.
+    Ref().release();
+    grpc_endpoint_read(
+        args->endpoint, args->read_buffer,
+        GRPC_CLOSURE_INIT(&read_done_closure_,
+                          &ShmHandshaker::OnReplyReadDoneScheduler, this,
+                          grpc_schedule_on_exec_ctx),
+        /*urgent=*/true, /*min_progress_size=*/1);
+    return;
+  }
+  const int watched_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (watched_fd < 0) {
+    HandshakeFailedLocked(GRPC_OS_ERROR(errno, "fcntl"));
+    return;
+  }
+  watched_fd_ = grpc_fd_create(watched_fd, "shm-handshake", false);
+  if (interested_parties_ != nullptr) {
+    grpc_pollset_set_add_fd(interested_parties_, watched_fd_);
+  }
+  // Take a new ref to be held while receiving the greeting.
+  Ref().release();
+  if (!ContinueReceivingLocked()) {
+    lock.Release();
+    Unref();
+  }
+}
+
+//
+// handshaker factory
+//
+
+class ShmHandshakerFactory : public HandshakerFactory {
+ public:
+  explicit ShmHandshakerFactory(bool is_client) : is_client_(is_client) {}
+
+  void AddHandshakers(const ChannelArgs& /*args*/,
+                      grpc_pollset_set* interested_parties,
+                      HandshakeManager* handshake_mgr) override {
+    handshake_mgr->Add(
+        MakeRefCounted<ShmHandshaker>(is_client_, interested_parties));
+  }
+  ~ShmHandshakerFactory() override = default;
+
+ private:
+  const bool is_client_;
+};
+
+}  // namespace
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder) {
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      false /* at_start */, HANDSHAKER_CLIENT,
+      absl::make_unique<ShmHandshakerFactory>(/*is_client=*/true));
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      false /* at_start */, HANDSHAKER_SERVER,
+      absl::make_unique<ShmHandshakerFactory>(/*is_client=*/false));
+}
+
+#else  // GRPC_HAVE_SHM_ENDPOINT
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* /*builder*/) {}
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
+
+}  // namespace grpc_core
@@ -0,0 +1,41 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/config/core_configuration.h"
+
+/// Channel arg (bool) that moves a connection made over a unix domain socket
+/// onto shared memory. Set on the addresses of "shm:" targets on the client,
+/// and on listeners bound to "shm:" addresses on the server.
+#define GRPC_ARG_SHM_TRANSPORT "grpc.shm_transport"
+
+/// Channel arg (int) for the size in bytes of each direction's ring of a
+/// shared-memory connection. Only the client's value is used.
+#define GRPC_ARG_SHM_RING_SIZE "grpc.shm_ring_size"
+
+namespace grpc_core {
+
+// Registers the handshakers that hand the descriptors of a shared-memory
+// connection over a freshly made unix domain socket connection, and then
+// replace the connection's endpoint with a shared-memory one. They run before
+// the security handshakers.
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -40,6 +41,7 @@
 #include "google/protobuf/struct.upb.h"
 #include "google/protobuf/timestamp.upb.h"
 #include "google/rpc/status.upb.h"
+#include "upb/decode.h"
 #include "upb/def.h"
 #include "upb/text_encode.h"
 #include "upb/upb.h"
@@ -356,10 +358,12 @@ absl::Status XdsApi::ParseAdsResponse(const XdsBootstrap::XdsServer& server,
   upb::Arena arena;
   const XdsApiContext context = {client_, tracer_, symtab_->ptr(), arena.ptr(),
                                  server.ShouldUseV3()};
-  // Decode the response.
+  // Decode the response.  Strings alias encoded_response, so that the
+  // serialized resources passed to the parser outlive the arena.
   const envoy_service_discovery_v3_DiscoveryResponse* response =
-      envoy_service_discovery_v3_DiscoveryResponse_parse(
-          encoded_response.data(), encoded_response.size(), arena.ptr());
+      envoy_service_discovery_v3_DiscoveryResponse_parse_ex(
+          encoded_response.data(), encoded_response.size(), nullptr,
+          kUpb_DecodeOption_AliasString, arena.ptr());
   // If decoding fails, report a fatal error and return.
   if (response == nullptr) {
     return absl::InvalidArgumentError("Can't decode DiscoveryResponse.");
@@ -393,8 +397,10 @@ absl::Status XdsApi::ParseAdsResponse(const XdsBootstrap::XdsServer& server,
     absl::string_view resource_name;
     if (type_url == "envoy.api.v2.Resource" ||
         type_url == "envoy.service.discovery.v3.Resource") {
-      const auto* resource_wrapper = envoy_service_discovery_v3_Resource_parse(
-          serialized_resource.data(), serialized_resource.size(), arena.ptr());
+      const auto* resource_wrapper =
+          envoy_service_discovery_v3_Resource_parse_ex(
+              serialized_resource.data(), serialized_resource.size(), nullptr,
+              kUpb_DecodeOption_AliasString, arena.ptr());
       if (resource_wrapper == nullptr) {
         parser->ResourceWrapperParsingFailed(i);
         continue;
@@ -410,7 +416,176 @@ absl::Status XdsApi::ParseAdsResponse(const XdsBootstrap::XdsServer& server,
           envoy_service_discovery_v3_Resource_name(resource_wrapper));
     }
     parser->ParseResource(context.arena, i, type_url, resource_name,
-                          serialized_resource);
+                          /*resource_version=*/"", serialized_resource);
+  }
+  return absl::OkStatus();
+}
+
+namespace {
+
+void MaybeLogDeltaDiscoveryRequest(
+    const XdsApiContext& context,
+    const envoy_service_discovery_v3_DeltaDiscoveryRequest* request) {
+  if (GRPC_TRACE_FLAG_ENABLED(*context.tracer) &&
+      gpr_should_log(GPR_LOG_SEVERITY_DEBUG)) {
+    const upb_MessageDef* msg_type =
+        envoy_service_discovery_v3_DeltaDiscoveryRequest_getmsgdef(
+            context.symtab);
+    char buf[10240];
+    upb_TextEncode(request, msg_type, nullptr, 0, buf, sizeof(buf));
+    gpr_log(GPR_DEBUG, "[xds_client %p] constructed delta ADS request: %s",
+            context.client, buf);
+  }
+}
+
+std::string SerializeDeltaDiscoveryRequest(
+    const XdsApiContext& context,
+    envoy_service_discovery_v3_DeltaDiscoveryRequest* request) {
+  size_t output_length;
+  char* output = envoy_service_discovery_v3_DeltaDiscoveryRequest_serialize(
+      request, context.arena, &output_length);
+  return std::string(output, output_length);
+}
+
+void MaybeLogDeltaDiscoveryResponse(
+    const XdsApiContext& context,
+    const envoy_service_discovery_v3_DeltaDiscoveryResponse* response) {
+  if (GRPC_TRACE_FLAG_ENABLED(*context.tracer) &&
+      gpr_should_log(GPR_LOG_SEVERITY_DEBUG)) {
+    const upb_MessageDef* msg_type =
+        envoy_service_discovery_v3_DeltaDiscoveryResponse_getmsgdef(
+            context.symtab);
+    char buf[10240];
+    upb_TextEncode(response, msg_type, nullptr, 0, buf, sizeof(buf));
+    gpr_log(GPR_DEBUG, "[xds_client %p] received delta response: %s",
+            context.client, buf);
+  }
+}
+
+}  // namespace
+
+std::string XdsApi::CreateDeltaAdsRequest(
+    const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+    absl::string_view nonce,
+    const std::vector<std::string>& resource_names_subscribe,
+    const std::vector<std::string>& resource_names_unsubscribe,
+    const std::map<std::string, std::string>& initial_resource_versions,
+    absl::Status status, bool populate_node) {
+  upb::Arena arena;
+  const XdsApiContext context = {client_, tracer_, symtab_->ptr(), arena.ptr(),
+                                 server.ShouldUseV3()};
+  // Create a request.
+  envoy_service_discovery_v3_DeltaDiscoveryRequest* request =
+      envoy_service_discovery_v3_DeltaDiscoveryRequest_new(arena.ptr());
+  // Set type_url.
+  std::string type_url_str = absl::StrCat("type.googleapis.com/", type_url);
+  envoy_service_discovery_v3_DeltaDiscoveryRequest_set_type_url(
+      request, StdStringToUpbString(type_url_str));
+  // Set nonce.
+  if (!nonce.empty()) {
+    envoy_service_discovery_v3_DeltaDiscoveryRequest_set_response_nonce(
+        request, StdStringToUpbString(nonce));
+  }
+  // Set error_detail if it's a NACK.
+  std::string error_string_storage;
+  if (!status.ok()) {
+    google_rpc_Status* error_detail =
+        envoy_service_discovery_v3_DeltaDiscoveryRequest_mutable_error_detail(
+            request, arena.ptr());
+    // Hard-code INVALID_ARGUMENT as the status code, as in the SotW case.
+    google_rpc_Status_set_code(error_detail, GRPC_STATUS_INVALID_ARGUMENT);
+    error_string_storage = std::string(status.message());
+    google_rpc_Status_set_message(error_detail,
+                                  StdStringToUpbString(error_string_storage));
+  }
+  // Populate node.
+  if (populate_node) {
+    envoy_config_core_v3_Node* node_msg =
+        envoy_service_discovery_v3_DeltaDiscoveryRequest_mutable_node(
+            request, arena.ptr());
+    PopulateNode(context, node_, build_version_, user_agent_name_,
+                 user_agent_version_, node_msg);
+  }
+  // Add resource_names_subscribe and resource_names_unsubscribe.
+  for (const std::string& resource_name : resource_names_subscribe) {
+    envoy_service_discovery_v3_DeltaDiscoveryRequest_add_resource_names_subscribe(
+        request, StdStringToUpbString(resource_name), arena.ptr());
+  }
+  for (const std::string& resource_name : resource_names_unsubscribe) {
+    envoy_service_discovery_v3_DeltaDiscoveryRequest_add_resource_names_unsubscribe(
+        request, StdStringToUpbString(resource_name), arena.ptr());
+  }
+  // Add initial_resource_versions.
+  for (const auto& p : initial_resource_versions) {
+    envoy_service_discovery_v3_DeltaDiscoveryRequest_initial_resource_versions_set(
+        request, StdStringToUpbString(p.first), StdStringToUpbString(p.second),
+        arena.ptr());
+  }
+  MaybeLogDeltaDiscoveryRequest(context, request);
+  return SerializeDeltaDiscoveryRequest(context, request);
+}
+
+absl::Status XdsApi::ParseDeltaAdsResponse(
+    const XdsBootstrap::XdsServer& server, absl::string_view encoded_response,
+    AdsResponseParserInterface* parser) {
+  upb::Arena arena;
+  const XdsApiContext context = {client_, tracer_, symtab_->ptr(), arena.ptr(),
+                                 server.ShouldUseV3()};
+  // Decode the response, aliasing encoded_response as in ParseAdsResponse().
+  const envoy_service_discovery_v3_DeltaDiscoveryResponse* response =
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_parse_ex(
+          encoded_response.data(), encoded_response.size(), nullptr,
+          kUpb_DecodeOption_AliasString, arena.ptr());
+  // If decoding fails, report a fatal error and return.
+  if (response == nullptr) {
+    return absl::InvalidArgumentError("Can't decode DeltaDiscoveryResponse.");
+  }
+  MaybeLogDeltaDiscoveryResponse(context, response);
+  // Report the type_url, system version, nonce, number of resources, and
+  // removed resources to the parser.
+  AdsResponseParserInterface::AdsResponseFields fields;
+  fields.type_url = std::string(absl::StripPrefix(
+      UpbStringToAbsl(
+          envoy_service_discovery_v3_DeltaDiscoveryResponse_type_url(response)),
+      "type.googleapis.com/"));
+  fields.version = UpbStringToStdString(
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_system_version_info(
+          response));
+  fields.nonce = UpbStringToStdString(
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_nonce(response));
+  size_t num_resources;
+  const envoy_service_discovery_v3_Resource* const* resources =
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_resources(
+          response, &num_resources);
+  fields.num_resources = num_resources;
+  size_t num_removed_resources;
+  const upb_StringView* removed_resources =
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_removed_resources(
+          response, &num_removed_resources);
+  for (size_t i = 0; i < num_removed_resources; ++i) {
+    fields.removed_resources.push_back(
+        UpbStringToStdString(removed_resources[i]));
+  }
+  absl::Status status = parser->ProcessAdsResponseFields(std::move(fields));
+  if (!status.ok()) return status;
+  // Process each resource.  Unlike in SotW, every resource is always
+  // wrapped in a Resource message.
+  for (size_t i = 0; i < num_resources; ++i) {
+    if (!envoy_service_discovery_v3_Resource_has_resource(resources[i])) {
+      parser->ResourceWrapperParsingFailed(i);
+      continue;
+    }
+    const auto* resource =
+        envoy_service_discovery_v3_Resource_resource(resources[i]);
+    parser->ParseResource(
+        context.arena, i,
+        absl::StripPrefix(
+            UpbStringToAbsl(google_protobuf_Any_type_url(resource)),
+            "type.googleapis.com/"),
+        UpbStringToAbsl(envoy_service_discovery_v3_Resource_name(resources[i])),
+        UpbStringToAbsl(
+            envoy_service_discovery_v3_Resource_version(resources[i])),
+        UpbStringToAbsl(google_protobuf_Any_value(resource)));
   }
   return absl::OkStatus();
 }
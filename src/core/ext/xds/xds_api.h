@@ -57,6 +57,8 @@ class XdsApi {
       std::string version;
       std::string nonce;
       size_t num_resources;
+      // Delta xDS only: names of resources the server has removed.
+      std::vector<std::string> removed_resources;
     };
 
     virtual ~AdsResponseParserInterface() = default;
@@ -68,10 +70,14 @@ class XdsApi {
 
     // Called to parse each individual resource in the ADS response.
     // Note that resource_name is non-empty only when the resource was
-    // wrapped in a Resource wrapper proto.
+    // wrapped in a Resource wrapper proto, and resource_version is
+    // non-empty only in delta responses.  The string_views point into
+    // the encoded response passed to ParseAdsResponse(), so they remain
+    // valid for as long as the caller keeps that alive.
     virtual void ParseResource(upb_Arena* arena, size_t idx,
                                absl::string_view type_url,
                                absl::string_view resource_name,
+                               absl::string_view resource_version,
                                absl::string_view serialized_resource) = 0;
 
     // Called when a resource is wrapped in a Resource wrapper proto but
@@ -158,12 +164,27 @@ class XdsApi {
                                const std::vector<std::string>& resource_names,
                                absl::Status status, bool populate_node);
 
+  // Creates a delta ADS request.  initial_resource_versions is populated
+  // only on the first request for a given type on each stream.
+  std::string CreateDeltaAdsRequest(
+      const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+      absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      absl::Status status, bool populate_node);
+
   // Returns non-OK when failing to deserialize response message.
   // Otherwise, all events are reported to the parser.
   absl::Status ParseAdsResponse(const XdsBootstrap::XdsServer& server,
                                 absl::string_view encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Same as ParseAdsResponse(), but for a DeltaDiscoveryResponse.
+  absl::Status ParseDeltaAdsResponse(const XdsBootstrap::XdsServer& server,
+                                     absl::string_view encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   std::string CreateLrsInitialRequest(const XdsBootstrap::XdsServer& server);
 
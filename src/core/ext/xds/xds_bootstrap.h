@@ -48,6 +48,7 @@ class XdsBootstrap {
     virtual const std::string& server_uri() const = 0;
     virtual bool ShouldUseV3() const = 0;
     virtual bool IgnoreResourceDeletion() const = 0;
+    virtual bool ShouldUseDelta() const = 0;
 
     virtual bool Equals(const XdsServer& other) const = 0;
 
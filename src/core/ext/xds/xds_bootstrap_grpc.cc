@@ -98,6 +98,7 @@ namespace {
 constexpr absl::string_view kServerFeatureXdsV3 = "xds_v3";
 constexpr absl::string_view kServerFeatureIgnoreResourceDeletion =
     "ignore_resource_deletion";
+constexpr absl::string_view kServerFeatureXdsDelta = "xds_delta";
 
 }  // namespace
 
@@ -111,6 +112,13 @@ bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
              kServerFeatureIgnoreResourceDeletion)) != server_features_.end();
 }
 
+bool GrpcXdsBootstrap::GrpcXdsServer::ShouldUseDelta() const {
+  // Delta ADS is only supported with xDS v3.
+  return ShouldUseV3() &&
+         server_features_.find(std::string(kServerFeatureXdsDelta)) !=
+             server_features_.end();
+}
+
 bool GrpcXdsBootstrap::GrpcXdsServer::Equals(const XdsServer& other) const {
   const auto& o = static_cast<const GrpcXdsServer&>(other);
   return (server_uri_ == o.server_uri_ &&
@@ -170,7 +178,8 @@ void GrpcXdsBootstrap::GrpcXdsServer::JsonPostLoad(const Json& json,
           if (feature_json.type() == Json::Type::STRING &&
               (feature_json.string_value() == kServerFeatureXdsV3 ||
                feature_json.string_value() ==
-                   kServerFeatureIgnoreResourceDeletion)) {
+                   kServerFeatureIgnoreResourceDeletion ||
+               feature_json.string_value() == kServerFeatureXdsDelta)) {
             server_features_.insert(feature_json.string_value());
           }
         }
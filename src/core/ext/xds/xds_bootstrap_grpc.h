@@ -76,6 +76,7 @@ class GrpcXdsBootstrap : public XdsBootstrap {
 
     bool ShouldUseV3() const override;
     bool IgnoreResourceDeletion() const override;
+    bool ShouldUseDelta() const override;
 
     bool Equals(const XdsServer& other) const override;
 
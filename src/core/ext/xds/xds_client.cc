@@ -22,7 +22,12 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -33,8 +38,10 @@
 #include "absl/strings/strip.h"
 #include "absl/types/optional.h"
 #include "upb/arena.h"
+#include "upb/upb.hpp"
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_api.h"
@@ -44,6 +51,7 @@
 #include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -139,8 +147,11 @@ class XdsClient::ChannelState::AdsCallState
       std::string version;
       std::string nonce;
       std::vector<std::string> errors;
-      std::map<std::string /*authority*/, std::set<XdsResourceKey>>
+      absl::flat_hash_map<std::string /*authority*/,
+                          absl::flat_hash_set<XdsResourceKey>>
           resources_seen;
+      // Delta xDS only.
+      std::vector<std::string> removed_resources;
       bool have_valid_resources = false;
     };
 
@@ -152,19 +163,64 @@ class XdsClient::ChannelState::AdsCallState
 
     void ParseResource(upb_Arena* arena, size_t idx, absl::string_view type_url,
                        absl::string_view resource_name,
+                       absl::string_view resource_version,
                        absl::string_view serialized_resource) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
     void ResourceWrapperParsingFailed(size_t idx) override;
 
+    // Decodes the resources collected by ParseResource().  Called without
+    // holding the XdsClient lock; large responses are decoded on several
+    // threads.
+    void DecodeResources();
+
+    // Applies the decoded resources to the cache, in the order in which
+    // they appeared in the response.
+    void ProcessResourcesLocked()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     Result TakeResult() { return std::move(result_); }
 
    private:
+    // A resource from the response whose decoding has been deferred.  The
+    // string_views point into the serialized response.
+    struct PendingResource {
+      size_t idx = 0;
+      absl::string_view type_url;
+      absl::string_view resource_name;
+      absl::string_view resource_version;
+      absl::string_view serialized_resource;
+      bool is_v2 = false;
+      size_t hash = 0;
+      // True if the resource matched the cached serialization when it was
+      // collected, in which case it is not decoded.
+      bool unchanged = false;
+      // If non-empty, the resource was rejected before decoding.
+      std::string error;
+      absl::optional<XdsResourceType::DecodeResult> decode_result;
+    };
+
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    void DecodeResource(PendingResource* resource);
+
+    void ProcessResourceLocked(PendingResource* resource)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Records that the resource was present in the response.
+    void MarkResourceSeenLocked(absl::string_view type_url,
+                                absl::string_view resource_name,
+                                const XdsResourceName& name,
+                                ResourceState* resource_state)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = Timestamp::Now();
     Result result_;
+    std::vector<PendingResource> pending_resources_;
+    // Captured under the lock by ProcessAdsResponseFields(), for use by
+    // DecodeResources().
+    upb_DefPool* symtab_ = nullptr;
   };
 
   class ResourceTimer : public InternallyRefCounted<ResourceTimer> {
@@ -288,10 +344,19 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // Delta xDS only: the resource names that the server currently has
+    // us subscribed to on this stream, and whether the first request for
+    // this type (which carries initial_resource_versions) has been sent.
+    std::set<std::string> delta_subscribed_names;
+    bool sent_initial_delta_request = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+  void SendDeltaMessageLocked(const XdsResourceType* type,
+                              ResourceTypeState* state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
   void OnRequestSent(bool ok);
   void OnRecvMessage(absl::string_view payload);
@@ -304,11 +369,37 @@ class XdsClient::ChannelState::AdsCallState
   std::vector<std::string> ResourceNamesForRequest(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+  // Returns the versions of the cached resources of a given type, for the
+  // first delta request for that type on this stream.
+  std::map<std::string, std::string> InitialResourceVersions(
+      const XdsResourceType* type)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+  // Handles the server no longer providing a resource, either by its
+  // absence from a SotW response or by an explicit delta removal.
+  void ProcessResourceRemovalLocked(const XdsResourceType* type,
+                                    const std::string& type_url,
+                                    const std::string& authority,
+                                    const XdsResourceKey& resource_key,
+                                    ResourceState* resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+  // Handles the removed_resources list of a delta response.
+  void ProcessDeltaRemovalsLocked(const AdsResponseParser::Result& result)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+  // Cancels the resource-does-not-exist timer for a resource, if needed.
+  void MaybeCancelResourceTimerLocked(const XdsResourceType* type,
+                                      const XdsResourceName& name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
   OrphanablePtr<XdsTransportFactory::XdsTransport::StreamingCall> call_;
 
+  // Whether this stream speaks the delta (incremental) variant of ADS.
+  bool delta_ = false;
   bool sent_initial_message_ = false;
   bool seen_response_ = false;
   bool send_message_pending_ ABSL_GUARDED_BY(&XdsClient::mu_) = false;
@@ -671,11 +762,12 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
     gpr_log(
         GPR_INFO,
         "[xds_client %p] xds server %s: received ADS response: type_url=%s, "
-        "version=%s, nonce=%s, num_resources=%" PRIuPTR,
+        "version=%s, nonce=%s, num_resources=%" PRIuPTR
+        ", num_removed_resources=%" PRIuPTR,
         ads_call_state_->xds_client(),
         ads_call_state_->chand()->server_.server_uri().c_str(),
         fields.type_url.c_str(), fields.version.c_str(), fields.nonce.c_str(),
-        fields.num_resources);
+        fields.num_resources, fields.removed_resources.size());
   }
   result_.type =
       ads_call_state_->xds_client()->GetResourceTypeLocked(fields.type_url);
@@ -686,11 +778,55 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
   result_.type_url = std::move(fields.type_url);
   result_.version = std::move(fields.version);
   result_.nonce = std::move(fields.nonce);
+  result_.removed_resources = std::move(fields.removed_resources);
+  symtab_ = ads_call_state_->xds_client()->symtab_.ptr();
   return absl::OkStatus();
 }
 
 namespace {
 
+// The minimum number of resources to decode on each thread when decoding a
+// response in parallel, so that small responses are decoded inline.
+constexpr size_t kMinResourcesPerDecodeThread = 32;
+
+// Runs fn(i) for each i in [0, n) on num_threads threads, including the
+// calling one, and returns when all have completed.
+void ParallelFor(size_t n, size_t num_threads,
+                 std::function<void(size_t)> fn) {
+  struct State : public RefCounted<State> {
+    State(size_t n, std::function<void(size_t)> fn)
+        : n(n), remaining(n), fn(std::move(fn)) {}
+
+    void RunUntilDone() {
+      for (size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+        fn(i);
+        if (remaining.fetch_sub(1) == 1) {
+          MutexLock lock(&mu);
+          cv.SignalAll();
+        }
+      }
+    }
+
+    const size_t n;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> remaining;
+    std::function<void(size_t)> fn;
+    Mutex mu;
+    CondVar cv;
+  };
+  auto state = MakeRefCounted<State>(n, std::move(fn));
+  for (size_t i = 1; i < num_threads; ++i) {
+    GetDefaultEventEngine()->Run([state]() {
+      ApplicationCallbackExecCtx callback_exec_ctx;
+      ExecCtx exec_ctx;
+      state->RunUntilDone();
+    });
+  }
+  state->RunUntilDone();
+  MutexLock lock(&state->mu);
+  while (state->remaining.load() != 0) state->cv.Wait(&state->mu);
+}
+
 // Build a resource metadata struct for ADS result accepting methods and CSDS.
 XdsApi::ResourceMetadata CreateResourceMetadataAcked(
     std::string serialized_proto, std::string version, Timestamp update_time) {
@@ -716,25 +852,124 @@ void UpdateResourceMetadataNacked(const std::string& version,
 }  // namespace
 
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
-    upb_Arena* arena, size_t idx, absl::string_view type_url,
-    absl::string_view resource_name, absl::string_view serialized_resource) {
-  std::string error_prefix = absl::StrCat(
-      "resource index ", idx, ": ",
-      resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
+    upb_Arena* /*arena*/, size_t idx, absl::string_view type_url,
+    absl::string_view resource_name, absl::string_view resource_version,
+    absl::string_view serialized_resource) {
+  PendingResource resource;
+  resource.idx = idx;
+  resource.type_url = type_url;
+  resource.resource_name = resource_name;
+  resource.resource_version = resource_version;
+  resource.serialized_resource = serialized_resource;
   // Check the type_url of the resource.
-  bool is_v2 = false;
-  if (!result_.type->IsType(type_url, &is_v2)) {
-    result_.errors.emplace_back(
-        absl::StrCat(error_prefix, "incorrect resource type ", type_url,
-                     " (should be ", result_.type_url, ")"));
+  if (!result_.type->IsType(type_url, &resource.is_v2)) {
+    resource.error = absl::StrCat(
+        "resource index ", idx, ": ",
+        resource_name.empty() ? "" : absl::StrCat(resource_name, ": "),
+        "incorrect resource type ", type_url, " (should be ",
+        result_.type_url, ")");
+  } else {
+    // If the resource is byte-identical to the one we already have, there
+    // is no need to decode and validate it again.
+    resource.hash = absl::Hash<absl::string_view>()(serialized_resource);
+    XdsResourceName name;
+    resource.unchanged =
+        xds_client()->FindUnchangedResourceLocked(
+            result_.type, resource_name, resource.hash, serialized_resource,
+            &name) != nullptr;
+  }
+  pending_resources_.push_back(std::move(resource));
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    DecodeResources() {
+  std::vector<PendingResource*> to_decode;
+  for (PendingResource& resource : pending_resources_) {
+    if (resource.error.empty() && !resource.unchanged) {
+      to_decode.push_back(&resource);
+    }
+  }
+  const size_t num_threads =
+      std::min<size_t>(gpr_cpu_num_cores(),
+                       to_decode.size() / kMinResourcesPerDecodeThread);
+  if (num_threads <= 1) {
+    for (PendingResource* resource : to_decode) DecodeResource(resource);
     return;
   }
-  // Parse the resource.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] xds server %s: decoding %" PRIuPTR
+            " %s resources on %" PRIuPTR " threads",
+            xds_client(),
+            ads_call_state_->chand()->server_.server_uri().c_str(),
+            to_decode.size(), result_.type_url.c_str(), num_threads);
+  }
+  ParallelFor(to_decode.size(), num_threads,
+              [&](size_t i) { DecodeResource(to_decode[i]); });
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::DecodeResource(
+    PendingResource* resource) {
+  upb::Arena arena;
   XdsResourceType::DecodeContext context = {
       xds_client(), ads_call_state_->chand()->server_, &grpc_xds_client_trace,
-      xds_client()->symtab_.ptr(), arena};
-  XdsResourceType::DecodeResult decode_result =
-      result_.type->Decode(context, serialized_resource, is_v2);
+      symtab_, arena.ptr()};
+  resource->decode_result = result_.type->Decode(
+      context, resource->serialized_resource, resource->is_v2);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ProcessResourcesLocked() {
+  for (PendingResource& resource : pending_resources_) {
+    ProcessResourceLocked(&resource);
+  }
+  pending_resources_.clear();
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ProcessResourceLocked(PendingResource* resource) {
+  if (!resource->error.empty()) {
+    result_.errors.push_back(std::move(resource->error));
+    return;
+  }
+  const size_t idx = resource->idx;
+  const absl::string_view type_url = resource->type_url;
+  absl::string_view resource_name = resource->resource_name;
+  const absl::string_view resource_version = resource->resource_version;
+  const absl::string_view serialized_resource = resource->serialized_resource;
+  const size_t resource_hash = resource->hash;
+  std::string error_prefix = absl::StrCat(
+      "resource index ", idx, ": ",
+      resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
+  // If the resource was not decoded because it was unchanged, check
+  // that it still is, since an earlier copy of it in the same response
+  // may have changed it.
+  if (!resource->decode_result.has_value()) {
+    XdsResourceName unchanged_name;
+    ResourceState* unchanged_state = xds_client()->FindUnchangedResourceLocked(
+        result_.type, resource_name, resource_hash, serialized_resource,
+        &unchanged_name);
+    if (unchanged_state != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+        gpr_log(GPR_INFO,
+                "[xds_client %p] %s resource %s unchanged, skipping decode.",
+                xds_client(), result_.type_url.c_str(),
+                XdsClient::ConstructFullXdsResourceName(
+                    unchanged_name.authority, result_.type->type_url(),
+                    unchanged_name.key)
+                    .c_str());
+      }
+      ads_call_state_->MaybeCancelResourceTimerLocked(result_.type,
+                                                      unchanged_name);
+      MarkResourceSeenLocked(type_url, resource_name, unchanged_name,
+                             unchanged_state);
+      result_.have_valid_resources = true;
+      unchanged_state->version = std::string(resource_version);
+      return;
+    }
+    DecodeResource(resource);
+  }
+  XdsResourceType::DecodeResult& decode_result = *resource->decode_result;
   // If we didn't already have the resource name from the Resource
   // wrapper, try to get it from the decoding result.
   if (resource_name.empty()) {
@@ -765,17 +1000,8 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it = timer_it->second.subscribed_resources.find(
-        parsed_resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(parsed_resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MaybeCancelTimer();
-      }
-    }
-  }
+  ads_call_state_->MaybeCancelResourceTimerLocked(result_.type,
+                                                  *parsed_resource_name);
   // Lookup the authority in the cache.
   auto authority_it =
       xds_client()->authority_state_map_.find(parsed_resource_name->authority);
@@ -795,35 +1021,25 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;  // Skip resource -- we don't have a subscription for it.
   }
   ResourceState& resource_state = it->second;
-  // If needed, record that we've seen this resource.
-  if (result_.type->AllResourcesRequiredInSotW()) {
-    result_.resources_seen[parsed_resource_name->authority].insert(
-        parsed_resource_name->key);
-  }
-  // If we previously ignored the resource's deletion, log that we're
-  // now re-adding it.
-  if (resource_state.ignored_deletion) {
-    gpr_log(GPR_INFO,
-            "[xds_client %p] xds server %s: server returned new version of "
-            "resource for which we previously ignored a deletion: type %s "
-            "name %s",
-            xds_client(),
-            ads_call_state_->chand()->server_.server_uri().c_str(),
-            std::string(type_url).c_str(), std::string(resource_name).c_str());
-    resource_state.ignored_deletion = false;
-  }
+  MarkResourceSeenLocked(type_url, resource_name, *parsed_resource_name,
+                         &resource_state);
+  // In delta responses, each resource carries its own version.
+  const std::string version = resource_version.empty()
+                                  ? result_.version
+                                  : std::string(resource_version);
   // Update resource state based on whether the resource is valid.
   if (!decode_status.ok()) {
     xds_client()->NotifyWatchersOnErrorLocked(
         resource_state.watchers,
         absl::UnavailableError(
             absl::StrCat("invalid resource: ", decode_status.ToString())));
-    UpdateResourceMetadataNacked(result_.version, decode_status.ToString(),
+    UpdateResourceMetadataNacked(version, decode_status.ToString(),
                                  update_time_, &resource_state.meta);
     return;
   }
   // Resource is valid.
   result_.have_valid_resources = true;
+  resource_state.version = std::string(resource_version);
   // If it didn't change, ignore it.
   if (resource_state.resource != nullptr &&
       result_.type->ResourcesEqual(resource_state.resource.get(),
@@ -834,31 +1050,61 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
               xds_client(), result_.type_url.c_str(),
               std::string(resource_name).c_str());
     }
+    // Remember the new serialization, so that we can skip decoding it
+    // if the server sends it again.
+    resource_state.meta.serialized_proto = std::string(serialized_resource);
+    xds_client()->UpdateResourceHashLocked(result_.type, *parsed_resource_name,
+                                           resource_hash, &resource_state);
     return;
   }
   // Update the resource state.
   resource_state.resource = std::move(*decode_result.resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
-  // Notify watchers.
+      std::string(serialized_resource), version, update_time_);
+  xds_client()->UpdateResourceHashLocked(result_.type, *parsed_resource_name,
+                                         resource_hash, &resource_state);
+  // Notify watchers.  They all share the cached resource.
   auto& watchers_list = resource_state.watchers;
-  auto* value =
-      result_.type->CopyResource(resource_state.resource.get()).release();
   xds_client()->work_serializer_.Schedule(
-      [watchers_list, value]()
+      [watchers_list, value = resource_state.resource]()
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&xds_client()->work_serializer_) {
             for (const auto& p : watchers_list) {
               p.first->OnGenericResourceChanged(value);
             }
-            delete value;
           },
       DEBUG_LOCATION);
 }
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MarkResourceSeenLocked(absl::string_view type_url,
+                           absl::string_view resource_name,
+                           const XdsResourceName& name,
+                           ResourceState* resource_state) {
+  // If needed, record that we've seen this resource.
+  if (!ads_call_state_->delta_ && result_.type->AllResourcesRequiredInSotW()) {
+    result_.resources_seen[name.authority].insert(name.key);
+  }
+  // If we previously ignored the resource's deletion, log that we're
+  // now re-adding it.
+  if (resource_state->ignored_deletion) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] xds server %s: server returned new version of "
+            "resource for which we previously ignored a deletion: type %s "
+            "name %s",
+            xds_client(),
+            ads_call_state_->chand()->server_.server_uri().c_str(),
+            std::string(type_url).c_str(), std::string(resource_name).c_str());
+    resource_state->ignored_deletion = false;
+  }
+}
+
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
     ResourceWrapperParsingFailed(size_t idx) {
-  result_.errors.emplace_back(absl::StrCat(
-      "resource index ", idx, ": Can't decode Resource proto wrapper"));
+  PendingResource resource;
+  resource.idx = idx;
+  resource.error = absl::StrCat("resource index ", idx,
+                                ": Can't decode Resource proto wrapper");
+  pending_resources_.push_back(std::move(resource));
 }
 
 //
@@ -874,12 +1120,18 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
       parent_(std::move(parent)) {
   GPR_ASSERT(xds_client() != nullptr);
   // Init the ADS call.
+  delta_ = chand()->server_.ShouldUseDelta() && !chand()->delta_unsupported_;
   const char* method =
       chand()->server_.ShouldUseV3()
           ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
             "StreamAggregatedResources"
           : "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
             "StreamAggregatedResources";
+  if (delta_) {
+    method =
+        "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+        "DeltaAggregatedResources";
+  }
   call_ = chand()->transport_->CreateStreamingCall(
       method, absl::make_unique<StreamEventHandler>(
                   // Passing the initial ref here.  This ref will go away when
@@ -889,10 +1141,10 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
   // Start the call.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
-            "[xds_client %p] xds server %s: starting ADS call "
+            "[xds_client %p] xds server %s: starting %sADS call "
             "(calld: %p, call: %p)",
-            xds_client(), chand()->server_.server_uri().c_str(), this,
-            call_.get());
+            xds_client(), chand()->server_.server_uri().c_str(),
+            delta_ ? "delta " : "", this, call_.get());
   }
   // If this is a reconnect, add any necessary subscriptions from what's
   // already in the cache.
@@ -931,6 +1183,10 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
     return;
   }
   auto& state = state_map_[type];
+  if (delta_) {
+    SendDeltaMessageLocked(type, &state);
+    return;
+  }
   std::string serialized_message = xds_client()->api_.CreateAdsRequest(
       chand()->server_,
       chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
@@ -951,6 +1207,47 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   send_message_pending_ = true;
 }
 
+void XdsClient::ChannelState::AdsCallState::SendDeltaMessageLocked(
+    const XdsResourceType* type, ResourceTypeState* state) {
+  // Diff the current subscriptions against what the server already has.
+  std::vector<std::string> resource_names = ResourceNamesForRequest(type);
+  std::set<std::string> names(std::make_move_iterator(resource_names.begin()),
+                              std::make_move_iterator(resource_names.end()));
+  std::vector<std::string> subscribe;
+  for (const std::string& name : names) {
+    if (state->delta_subscribed_names.count(name) == 0) {
+      subscribe.push_back(name);
+    }
+  }
+  std::vector<std::string> unsubscribe;
+  for (const std::string& name : state->delta_subscribed_names) {
+    if (names.count(name) == 0) unsubscribe.push_back(name);
+  }
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->sent_initial_delta_request) {
+    initial_resource_versions = InitialResourceVersions(type);
+    state->sent_initial_delta_request = true;
+  }
+  std::string serialized_message = xds_client()->api_.CreateDeltaAdsRequest(
+      chand()->server_, type->type_url(), state->nonce, subscribe, unsubscribe,
+      initial_resource_versions, state->status, !sent_initial_message_);
+  sent_initial_message_ = true;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] xds server %s: sending delta ADS request: "
+            "type=%s subscribe=%" PRIuPTR " unsubscribe=%" PRIuPTR
+            " initial_versions=%" PRIuPTR " nonce=%s error=%s",
+            xds_client(), chand()->server_.server_uri().c_str(),
+            std::string(type->type_url()).c_str(), subscribe.size(),
+            unsubscribe.size(), initial_resource_versions.size(),
+            state->nonce.c_str(), state->status.ToString().c_str());
+  }
+  state->delta_subscribed_names = std::move(names);
+  state->status = absl::OkStatus();
+  call_->SendMessage(std::move(serialized_message));
+  send_message_pending_ = true;
+}
+
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
   auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
@@ -1002,13 +1299,16 @@ void XdsClient::ChannelState::AdsCallState::OnRequestSent(bool ok) {
 
 void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
     absl::string_view payload) {
+  // Parse the response and collect its resources.
+  AdsResponseParser parser(this);
   {
     MutexLock lock(&xds_client()->mu_);
     if (!IsCurrentCallOnChannel()) return;
-    // Parse and validate the response.
-    AdsResponseParser parser(this);
     absl::Status status =
-        xds_client()->api_.ParseAdsResponse(chand()->server_, payload, &parser);
+        delta_ ? xds_client()->api_.ParseDeltaAdsResponse(chand()->server_,
+                                                          payload, &parser)
+               : xds_client()->api_.ParseAdsResponse(chand()->server_,
+                                                     payload, &parser);
     if (!status.ok()) {
       // Ignore unparsable response.
       gpr_log(GPR_ERROR,
@@ -1016,7 +1316,24 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
               "-- ignoring",
               xds_client(), chand()->server_.server_uri().c_str(),
               status.ToString().c_str());
-    } else {
+      return;
+    }
+    // Keep resource types from being registered in the symtab while we
+    // use it without the lock.
+    ++xds_client()->num_unlocked_decodes_;
+  }
+  // Decode the resources without holding the lock, since this is the
+  // expensive part of handling a large response.  The payload, which the
+  // collected resources point into, stays valid until we return.
+  parser.DecodeResources();
+  {
+    MutexLock lock(&xds_client()->mu_);
+    if (--xds_client()->num_unlocked_decodes_ == 0) {
+      xds_client()->unlocked_decodes_cv_.SignalAll();
+    }
+    if (IsCurrentCallOnChannel()) {
+      // Validate the decoded resources and update the cache.
+      parser.ProcessResourcesLocked();
       seen_response_ = true;
       chand()->status_ = absl::OkStatus();
       AdsResponseParser::Result result = parser.TakeResult();
@@ -1036,8 +1353,10 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
                 result.type_url.c_str(), result.version.c_str(),
                 state.nonce.c_str(), state.status.ToString().c_str());
       }
+      // Delete resources the server removed, if using delta.
+      if (delta_) ProcessDeltaRemovalsLocked(result);
       // Delete resources not seen in update if needed.
-      if (result.type->AllResourcesRequiredInSotW()) {
+      if (!delta_ && result.type->AllResourcesRequiredInSotW()) {
         for (auto& a : xds_client()->authority_state_map_) {
           const std::string& authority = a.first;
           AuthorityState& authority_state = a.second;
@@ -1062,23 +1381,9 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
               // that the resource does not exist.  For that case, we rely on
               // the request timeout instead.
               if (resource_state.resource == nullptr) continue;
-              if (chand()->server_.IgnoreResourceDeletion()) {
-                if (!resource_state.ignored_deletion) {
-                  gpr_log(GPR_ERROR,
-                          "[xds_client %p] xds server %s: ignoring deletion "
-                          "for resource type %s name %s",
-                          xds_client(), chand()->server_.server_uri().c_str(),
-                          result.type_url.c_str(),
-                          XdsClient::ConstructFullXdsResourceName(
-                              authority, result.type_url.c_str(), resource_key)
-                              .c_str());
-                  resource_state.ignored_deletion = true;
-                }
-              } else {
-                resource_state.resource.reset();
-                xds_client()->NotifyWatchersOnResourceDoesNotExist(
-                    resource_state.watchers);
-              }
+              ProcessResourceRemovalLocked(result.type, result.type_url,
+                                           authority, resource_key,
+                                           &resource_state);
             }
           }
         }
@@ -1101,6 +1406,72 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
   xds_client()->work_serializer_.DrainQueue();
 }
 
+void XdsClient::ChannelState::AdsCallState::ProcessResourceRemovalLocked(
+    const XdsResourceType* type, const std::string& type_url,
+    const std::string& authority, const XdsResourceKey& resource_key,
+    ResourceState* resource_state) {
+  if (chand()->server_.IgnoreResourceDeletion()) {
+    if (!resource_state->ignored_deletion) {
+      gpr_log(GPR_ERROR,
+              "[xds_client %p] xds server %s: ignoring deletion "
+              "for resource type %s name %s",
+              xds_client(), chand()->server_.server_uri().c_str(),
+              type_url.c_str(),
+              XdsClient::ConstructFullXdsResourceName(
+                  authority, type_url.c_str(), resource_key)
+                  .c_str());
+      resource_state->ignored_deletion = true;
+    }
+  } else {
+    xds_client()->RemoveResourceHashLocked(type, {authority, resource_key},
+                                           resource_state);
+    resource_state->resource.reset();
+    resource_state->version.clear();
+    xds_client()->NotifyWatchersOnResourceDoesNotExist(
+        resource_state->watchers);
+  }
+}
+
+void XdsClient::ChannelState::AdsCallState::ProcessDeltaRemovalsLocked(
+    const AdsResponseParser::Result& result) {
+  for (const std::string& resource_name : result.removed_resources) {
+    auto parsed_resource_name =
+        xds_client()->ParseXdsResourceName(resource_name, result.type);
+    if (!parsed_resource_name.ok()) continue;
+    const std::string& authority = parsed_resource_name->authority;
+    const XdsResourceKey& resource_key = parsed_resource_name->key;
+    auto authority_it = xds_client()->authority_state_map_.find(authority);
+    if (authority_it == xds_client()->authority_state_map_.end()) continue;
+    AuthorityState& authority_state = authority_it->second;
+    // Skip authorities that are not using this xDS channel.
+    if (authority_state.channel_state != chand()) continue;
+    auto type_it = authority_state.resource_map.find(result.type);
+    if (type_it == authority_state.resource_map.end()) continue;
+    auto it = type_it->second.find(resource_key);
+    if (it == type_it->second.end()) continue;
+    // Unlike an absence from a SotW response, an explicit removal is
+    // authoritative even if we have not yet received the resource, so
+    // there is no need to wait for the does-not-exist timer.
+    MaybeCancelResourceTimerLocked(result.type, *parsed_resource_name);
+    if (it->second.resource == nullptr) {
+      xds_client()->NotifyWatchersOnResourceDoesNotExist(it->second.watchers);
+    } else {
+      ProcessResourceRemovalLocked(result.type, result.type_url, authority,
+                                   resource_key, &it->second);
+    }
+  }
+}
+
+void XdsClient::ChannelState::AdsCallState::MaybeCancelResourceTimerLocked(
+    const XdsResourceType* type, const XdsResourceName& name) {
+  auto timer_it = state_map_.find(type);
+  if (timer_it == state_map_.end()) return;
+  auto it = timer_it->second.subscribed_resources.find(name.authority);
+  if (it == timer_it->second.subscribed_resources.end()) return;
+  auto res_it = it->second.find(name.key);
+  if (res_it != it->second.end()) res_it->second->MaybeCancelTimer();
+}
+
 void XdsClient::ChannelState::AdsCallState::OnStatusReceived(
     absl::Status status) {
   {
@@ -1114,6 +1485,15 @@ void XdsClient::ChannelState::AdsCallState::OnStatusReceived(
     }
     // Ignore status from a stale call.
     if (IsCurrentCallOnChannel()) {
+      // If the server doesn't implement delta ADS, have the retry use SotW.
+      if (delta_ && !seen_response_ &&
+          status.code() == absl::StatusCode::kUnimplemented) {
+        gpr_log(GPR_INFO,
+                "[xds_client %p] xds server %s: delta ADS not supported, "
+                "falling back to state-of-the-world ADS",
+                xds_client(), chand()->server_.server_uri().c_str());
+        chand()->delta_unsupported_ = true;
+      }
       // Try to restart the call.
       parent_->OnCallFinishedLocked();
       // Send error to all watchers for the channel.
@@ -1151,6 +1531,35 @@ XdsClient::ChannelState::AdsCallState::ResourceNamesForRequest(
   return resource_names;
 }
 
+std::map<std::string, std::string>
+XdsClient::ChannelState::AdsCallState::InitialResourceVersions(
+    const XdsResourceType* type) {
+  std::map<std::string, std::string> versions;
+  auto it = state_map_.find(type);
+  if (it == state_map_.end()) return versions;
+  for (const auto& a : it->second.subscribed_resources) {
+    const std::string& authority = a.first;
+    auto authority_it = xds_client()->authority_state_map_.find(authority);
+    if (authority_it == xds_client()->authority_state_map_.end()) continue;
+    auto type_it = authority_it->second.resource_map.find(type);
+    if (type_it == authority_it->second.resource_map.end()) continue;
+    for (const auto& p : a.second) {
+      const XdsResourceKey& resource_key = p.first;
+      auto res_it = type_it->second.find(resource_key);
+      if (res_it == type_it->second.end()) continue;
+      const ResourceState& resource_state = res_it->second;
+      if (resource_state.resource == nullptr ||
+          resource_state.version.empty()) {
+        continue;
+      }
+      versions.emplace(XdsClient::ConstructFullXdsResourceName(
+                           authority, type->type_url(), resource_key),
+                       resource_state.version);
+    }
+  }
+  return versions;
+}
+
 //
 // XdsClient::ChannelState::LrsCallState::Reporter
 //
@@ -1534,12 +1943,11 @@ void XdsClient::WatchResource(const XdsResourceType* type,
                 "[xds_client %p] returning cached listener data for %s", this,
                 std::string(name).c_str());
       }
-      auto* value = type->CopyResource(resource_state.resource.get()).release();
       work_serializer_.Schedule(
-          [watcher, value]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) {
-            watcher->OnGenericResourceChanged(value);
-            delete value;
-          },
+          [watcher, value = resource_state.resource]()
+              ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) {
+                watcher->OnGenericResourceChanged(value);
+              },
           DEBUG_LOCATION);
     } else if (resource_state.meta.client_status ==
                XdsApi::ResourceMetadata::DOES_NOT_EXIST) {
@@ -1636,6 +2044,9 @@ void XdsClient::CancelResourceWatch(const XdsResourceType* type,
     }
     authority_state.channel_state->UnsubscribeLocked(type, *resource_name,
                                                      delay_unsubscription);
+    if (resource_state.resource != nullptr) {
+      RemoveResourceHashLocked(type, *resource_name, &resource_state);
+    }
     type_map.erase(resource_it);
     if (type_map.empty()) {
       authority_state.resource_map.erase(type_it);
@@ -1646,6 +2057,60 @@ void XdsClient::CancelResourceWatch(const XdsResourceType* type,
   }
 }
 
+XdsClient::ResourceState* XdsClient::FindUnchangedResourceLocked(
+    const XdsResourceType* type, absl::string_view resource_name, size_t hash,
+    absl::string_view serialized_resource, XdsResourceName* name) {
+  if (!resource_name.empty()) {
+    auto parsed_resource_name = ParseXdsResourceName(resource_name, type);
+    if (!parsed_resource_name.ok()) return nullptr;
+    *name = std::move(*parsed_resource_name);
+  } else {
+    auto type_it = resource_hash_map_.find(type);
+    if (type_it == resource_hash_map_.end()) return nullptr;
+    auto it = type_it->second.find(hash);
+    if (it == type_it->second.end()) return nullptr;
+    *name = it->second;
+  }
+  auto authority_it = authority_state_map_.find(name->authority);
+  if (authority_it == authority_state_map_.end()) return nullptr;
+  auto type_it = authority_it->second.resource_map.find(type);
+  if (type_it == authority_it->second.resource_map.end()) return nullptr;
+  auto it = type_it->second.find(name->key);
+  if (it == type_it->second.end()) return nullptr;
+  ResourceState& resource_state = it->second;
+  // Compare the bytes too, in case of a hash collision.
+  if (resource_state.resource == nullptr ||
+      resource_state.serialized_resource_hash != hash ||
+      resource_state.meta.serialized_proto != serialized_resource) {
+    return nullptr;
+  }
+  return &resource_state;
+}
+
+void XdsClient::UpdateResourceHashLocked(const XdsResourceType* type,
+                                         const XdsResourceName& name,
+                                         size_t hash,
+                                         ResourceState* resource_state) {
+  RemoveResourceHashLocked(type, name, resource_state);
+  resource_state->serialized_resource_hash = hash;
+  resource_hash_map_[type][hash] = name;
+}
+
+void XdsClient::RemoveResourceHashLocked(const XdsResourceType* type,
+                                         const XdsResourceName& name,
+                                         ResourceState* resource_state) {
+  auto type_it = resource_hash_map_.find(type);
+  if (type_it == resource_hash_map_.end()) return;
+  auto it = type_it->second.find(resource_state->serialized_resource_hash);
+  if (it == type_it->second.end()) return;
+  // On a hash collision, the entry may belong to another resource.
+  if (it->second.authority != name.authority || !(it->second.key == name.key)) {
+    return;
+  }
+  type_it->second.erase(it);
+  if (type_it->second.empty()) resource_hash_map_.erase(type_it);
+}
+
 void XdsClient::MaybeRegisterResourceTypeLocked(
     const XdsResourceType* resource_type) {
   auto it = resource_types_.find(resource_type->type_url());
@@ -1653,6 +2118,14 @@ void XdsClient::MaybeRegisterResourceTypeLocked(
     GPR_ASSERT(it->second == resource_type);
     return;
   }
+  // Wait for any ADS response that is being decoded without the lock,
+  // since adding to the symtab is not safe while it is in use.
+  if (num_unlocked_decodes_ > 0) {
+    while (num_unlocked_decodes_ > 0) unlocked_decodes_cv_.Wait(&mu_);
+    // Another thread may have registered the type while we waited.
+    MaybeRegisterResourceTypeLocked(resource_type);
+    return;
+  }
   resource_types_.emplace(resource_type->type_url(), resource_type);
   v2_resource_types_.emplace(resource_type->v2_type_url(), resource_type);
   resource_type->InitUpbSymtab(symtab_.ptr());
@@ -1721,10 +2194,9 @@ RefCountedPtr<XdsClusterDropStats> XdsClient::AddClusterDropStats(
   {
     MutexLock lock(&mu_);
     // We jump through some hoops here to make sure that the const
-    // XdsBootstrap::XdsServer& and absl::string_views
-    // stored in the XdsClusterDropStats object point to the
-    // XdsBootstrap::XdsServer and strings
-    // in the load_report_map_ key, so that they have the same lifetime.
+    // XdsBootstrap::XdsServer& stored in the XdsClusterDropStats object
+    // points to the XdsBootstrap::XdsServer in the
+    // xds_load_report_server_map_ key, so that they have the same lifetime.
     auto server_it =
         xds_load_report_server_map_.emplace(server, LoadReportServer()).first;
     if (server_it->second.channel_state == nullptr) {
@@ -1789,10 +2261,9 @@ RefCountedPtr<XdsClusterLocalityStats> XdsClient::AddClusterLocalityStats(
   {
     MutexLock lock(&mu_);
     // We jump through some hoops here to make sure that the const
-    // XdsBootstrap::XdsServer& and absl::string_views
-    // stored in the XdsClusterDropStats object point to the
-    // XdsBootstrap::XdsServer and strings
-    // in the load_report_map_ key, so that they have the same lifetime.
+    // XdsBootstrap::XdsServer& stored in the XdsClusterLocalityStats
+    // object points to the XdsBootstrap::XdsServer in the
+    // xds_load_report_server_map_ key, so that they have the same lifetime.
     auto server_it =
         xds_load_report_server_map_.emplace(server, LoadReportServer()).first;
     if (server_it->second.channel_state == nullptr) {
@@ -1859,10 +2330,8 @@ void XdsClient::ResetBackoff() {
   }
 }
 
-void XdsClient::NotifyWatchersOnErrorLocked(
-    const std::map<ResourceWatcherInterface*,
-                   RefCountedPtr<ResourceWatcherInterface>>& watchers,
-    absl::Status status) {
+void XdsClient::NotifyWatchersOnErrorLocked(const WatcherMap& watchers,
+                                            absl::Status status) {
   const auto* node = bootstrap_->node();
   if (node != nullptr) {
     status = absl::Status(
@@ -1880,8 +2349,7 @@ void XdsClient::NotifyWatchersOnErrorLocked(
 }
 
 void XdsClient::NotifyWatchersOnResourceDoesNotExist(
-    const std::map<ResourceWatcherInterface*,
-                   RefCountedPtr<ResourceWatcherInterface>>& watchers) {
+    const WatcherMap& watchers) {
   work_serializer_.Schedule(
       [watchers]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) {
         for (const auto& p : watchers) {
@@ -1968,7 +2436,7 @@ XdsApi::ClusterLoadReportMap XdsClient::BuildLoadReportSnapshotLocked(
     // deleted stats objects, remove the entry.
     if (load_report.locality_stats.empty() &&
         load_report.drop_stats == nullptr) {
-      load_report_it = load_report_map.erase(load_report_it);
+      load_report_map.erase(load_report_it++);
     } else {
       ++load_report_it;
     }
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
@@ -60,8 +61,9 @@ class XdsClient : public DualRefCounted<XdsClient> {
   // XdsResourceType implementation.
   class ResourceWatcherInterface : public RefCounted<ResourceWatcherInterface> {
    public:
+    // The resource is an immutable snapshot shared by all watchers.
     virtual void OnGenericResourceChanged(
-        const XdsResourceType::ResourceData* resource)
+        std::shared_ptr<const XdsResourceType::ResourceData> resource)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) = 0;
     virtual void OnError(absl::Status status)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) = 0;
@@ -153,6 +155,19 @@ class XdsClient : public DualRefCounted<XdsClient> {
       if (c != 0) return c < 0;
       return query_params < other.query_params;
     }
+
+    bool operator==(const XdsResourceKey& other) const {
+      return id == other.id && query_params == other.query_params;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const XdsResourceKey& key) {
+      h = H::combine(std::move(h), key.id, key.query_params.size());
+      for (const URI::QueryParam& param : key.query_params) {
+        h = H::combine(std::move(h), param.key, param.value);
+      }
+      return h;
+    }
   };
 
   struct XdsResourceName {
@@ -222,21 +237,34 @@ class XdsClient : public DualRefCounted<XdsClient> {
     std::map<const XdsResourceType*, std::string /*version*/>
         resource_type_version_map_;
 
+    // Set when the server rejected a delta ADS stream as unimplemented,
+    // so that subsequent streams fall back to SotW.
+    bool delta_unsupported_ = false;
+
     absl::Status status_;
   };
 
+  using WatcherMap =
+      absl::flat_hash_map<ResourceWatcherInterface*,
+                          RefCountedPtr<ResourceWatcherInterface>>;
+
   struct ResourceState {
-    std::map<ResourceWatcherInterface*, RefCountedPtr<ResourceWatcherInterface>>
-        watchers;
-    // The latest data seen for the resource.
-    std::unique_ptr<XdsResourceType::ResourceData> resource;
+    WatcherMap watchers;
+    // The latest data seen for the resource.  Shared with the watchers.
+    std::shared_ptr<const XdsResourceType::ResourceData> resource;
     XdsApi::ResourceMetadata meta;
+    // The server's version of the resource, as sent in delta responses.
+    // Used to populate initial_resource_versions on new delta streams.
+    std::string version;
+    // Hash of meta.serialized_proto.  Meaningful only if resource is set.
+    size_t serialized_resource_hash = 0;
     bool ignored_deletion = false;
   };
 
   struct AuthorityState {
     RefCountedPtr<ChannelState> channel_state;
-    std::map<const XdsResourceType*, std::map<XdsResourceKey, ResourceState>>
+    absl::flat_hash_map<const XdsResourceType*,
+                        absl::flat_hash_map<XdsResourceKey, ResourceState>>
         resource_map;
   };
 
@@ -255,7 +283,7 @@ class XdsClient : public DualRefCounted<XdsClient> {
   };
 
   // Load report data.
-  using LoadReportMap = std::map<
+  using LoadReportMap = absl::flat_hash_map<
       std::pair<std::string /*cluster_name*/, std::string /*eds_service_name*/>,
       LoadReportState>;
 
@@ -265,14 +293,10 @@ class XdsClient : public DualRefCounted<XdsClient> {
   };
 
   // Sends an error notification to a specific set of watchers.
-  void NotifyWatchersOnErrorLocked(
-      const std::map<ResourceWatcherInterface*,
-                     RefCountedPtr<ResourceWatcherInterface>>& watchers,
-      absl::Status status);
+  void NotifyWatchersOnErrorLocked(const WatcherMap& watchers,
+                                   absl::Status status);
   // Sends a resource-does-not-exist notification to a specific set of watchers.
-  void NotifyWatchersOnResourceDoesNotExist(
-      const std::map<ResourceWatcherInterface*,
-                     RefCountedPtr<ResourceWatcherInterface>>& watchers);
+  void NotifyWatchersOnResourceDoesNotExist(const WatcherMap& watchers);
 
   void MaybeRegisterResourceTypeLocked(const XdsResourceType* resource_type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
@@ -281,6 +305,26 @@ class XdsClient : public DualRefCounted<XdsClient> {
   const XdsResourceType* GetResourceTypeLocked(absl::string_view resource_type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Returns the cached resource of the given type whose serialized form
+  // is exactly serialized_resource, or null if there is none, and sets
+  // name to its name.  If resource_name is empty (i.e., the server didn't
+  // wrap the resource in a Resource message), the cached resource is
+  // found by hash.
+  ResourceState* FindUnchangedResourceLocked(
+      const XdsResourceType* type, absl::string_view resource_name,
+      size_t hash, absl::string_view serialized_resource,
+      XdsResourceName* name) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Records hash as the hash of the serialized form of the resource.
+  void UpdateResourceHashLocked(const XdsResourceType* type,
+                                const XdsResourceName& name, size_t hash,
+                                ResourceState* resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Must be called before a cached resource is reset or removed.
+  void RemoveResourceHashLocked(const XdsResourceType* type,
+                                const XdsResourceName& name,
+                                ResourceState* resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   absl::StatusOr<XdsResourceName> ParseXdsResourceName(
       absl::string_view name, const XdsResourceType* type);
   static std::string ConstructFullXdsResourceName(
@@ -310,14 +354,26 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<absl::string_view /*v2_resource_type*/, const XdsResourceType*>
       v2_resource_types_ ABSL_GUARDED_BY(mu_);
   upb::SymbolTable symtab_ ABSL_GUARDED_BY(mu_);
+  // Number of ADS responses whose resources are being decoded without
+  // holding mu_.  New resource types are not added to symtab_ until this
+  // drops to zero.
+  size_t num_unlocked_decodes_ ABSL_GUARDED_BY(mu_) = 0;
+  CondVar unlocked_decodes_cv_;
 
   // Map of existing xDS server channels.
   // Key is owned by the bootstrap config.
   std::map<const XdsBootstrap::XdsServer*, ChannelState*>
       xds_server_channel_map_ ABSL_GUARDED_BY(mu_);
 
-  std::map<std::string /*authority*/, AuthorityState> authority_state_map_
-      ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::string /*authority*/, AuthorityState>
+      authority_state_map_ ABSL_GUARDED_BY(mu_);
+
+  // For each resource type, maps the hash of the serialized form of each
+  // cached resource to its name, so that an unchanged resource can be
+  // recognized without decoding it.
+  absl::flat_hash_map<const XdsResourceType*,
+                      absl::flat_hash_map<size_t, XdsResourceName>>
+      resource_hash_map_ ABSL_GUARDED_BY(mu_);
 
   // Key is owned by the bootstrap config.
   std::map<const XdsBootstrap::XdsServer*, LoadReportServer>
@@ -325,8 +381,7 @@ class XdsClient : public DualRefCounted<XdsClient> {
 
   // Stores started watchers whose resource name was not parsed successfully,
   // waiting to be cancelled or reset in Orphan().
-  std::map<ResourceWatcherInterface*, RefCountedPtr<ResourceWatcherInterface>>
-      invalid_watchers_ ABSL_GUARDED_BY(mu_);
+  WatcherMap invalid_watchers_ ABSL_GUARDED_BY(mu_);
 
   bool shutting_down_ ABSL_GUARDED_BY(mu_) = false;
 };
@@ -54,8 +54,8 @@ XdsClusterDropStats::XdsClusterDropStats(
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO, "[xds_client %p] created drop stats %p for {%s, %s, %s}",
             xds_client_.get(), this, lrs_server_.server_uri().c_str(),
-            std::string(cluster_name_).c_str(),
-            std::string(eds_service_name_).c_str());
+            cluster_name_.c_str(),
+            eds_service_name_.c_str());
   }
 }
 
@@ -64,8 +64,8 @@ XdsClusterDropStats::~XdsClusterDropStats() {
     gpr_log(GPR_INFO,
             "[xds_client %p] destroying drop stats %p for {%s, %s, %s}",
             xds_client_.get(), this, lrs_server_.server_uri().c_str(),
-            std::string(cluster_name_).c_str(),
-            std::string(eds_service_name_).c_str());
+            cluster_name_.c_str(),
+            eds_service_name_.c_str());
   }
   xds_client_->RemoveClusterDropStats(lrs_server_, cluster_name_,
                                       eds_service_name_, this);
@@ -109,8 +109,8 @@ XdsClusterLocalityStats::XdsClusterLocalityStats(
     gpr_log(GPR_INFO,
             "[xds_client %p] created locality stats %p for {%s, %s, %s, %s}",
             xds_client_.get(), this, lrs_server_.server_uri().c_str(),
-            std::string(cluster_name_).c_str(),
-            std::string(eds_service_name_).c_str(),
+            cluster_name_.c_str(),
+            eds_service_name_.c_str(),
             name_->AsHumanReadableString().c_str());
   }
 }
@@ -120,8 +120,8 @@ XdsClusterLocalityStats::~XdsClusterLocalityStats() {
     gpr_log(GPR_INFO,
             "[xds_client %p] destroying locality stats %p for {%s, %s, %s, %s}",
             xds_client_.get(), this, lrs_server_.server_uri().c_str(),
-            std::string(cluster_name_).c_str(),
-            std::string(eds_service_name_).c_str(),
+            cluster_name_.c_str(),
+            eds_service_name_.c_str(),
             name_->AsHumanReadableString().c_str());
   }
   xds_client_->RemoveClusterLocalityStats(lrs_server_, cluster_name_,
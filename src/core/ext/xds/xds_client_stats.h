@@ -144,8 +144,8 @@ class XdsClusterDropStats : public RefCounted<XdsClusterDropStats> {
  private:
   RefCountedPtr<XdsClient> xds_client_;
   const XdsBootstrap::XdsServer& lrs_server_;
-  absl::string_view cluster_name_;
-  absl::string_view eds_service_name_;
+  const std::string cluster_name_;
+  const std::string eds_service_name_;
   std::atomic<uint64_t> uncategorized_drops_{0};
   // Protects categorized_drops_. A mutex is necessary because the length of
   // dropped_requests can be accessed by both the picker (from data plane
@@ -219,8 +219,8 @@ class XdsClusterLocalityStats : public RefCounted<XdsClusterLocalityStats> {
  private:
   RefCountedPtr<XdsClient> xds_client_;
   const XdsBootstrap::XdsServer& lrs_server_;
-  absl::string_view cluster_name_;
-  absl::string_view eds_service_name_;
+  const std::string cluster_name_;
+  const std::string eds_service_name_;
   RefCountedPtr<XdsLocalityName> name_;
 
   std::atomic<uint64_t> total_successful_requests_{0};
@@ -91,6 +91,8 @@ std::string XdsClusterResource::ToString() const {
   if (lb_policy == "RING_HASH") {
     contents.push_back(absl::StrCat("min_ring_size=", min_ring_size));
     contents.push_back(absl::StrCat("max_ring_size=", max_ring_size));
+  } else if (lb_policy == "LEAST_REQUEST") {
+    contents.push_back(absl::StrCat("choice_count=", choice_count));
   }
   contents.push_back(
       absl::StrCat("max_concurrent_requests=", max_concurrent_requests));
@@ -336,6 +338,23 @@ absl::StatusOr<XdsClusterResource> CdsResourceParse(
         errors.emplace_back("ring hash lb config has invalid hash function.");
       }
     }
+  } else if (envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
+             envoy_config_cluster_v3_Cluster_LEAST_REQUEST) {
+    cds_update.lb_policy = "LEAST_REQUEST";
+    auto* least_request_config =
+        envoy_config_cluster_v3_Cluster_least_request_lb_config(cluster);
+    if (least_request_config != nullptr) {
+      const google_protobuf_UInt32Value* choice_count =
+          envoy_config_cluster_v3_Cluster_LeastRequestLbConfig_choice_count(
+              least_request_config);
+      if (choice_count != nullptr) {
+        cds_update.choice_count =
+            google_protobuf_UInt32Value_value(choice_count);
+        if (cds_update.choice_count < 2) {
+          errors.emplace_back("choice_count must be at least 2.");
+        }
+      }
+    }
   } else {
     errors.emplace_back("LB policy is not supported.");
   }
@@ -488,6 +507,32 @@ absl::StatusOr<XdsClusterResource> CdsResourceParse(
             failure_percentage_ejection;
       }
     }
+    const google_protobuf_UInt32Value* enforcing_consecutive_5xx =
+        envoy_config_cluster_v3_OutlierDetection_enforcing_consecutive_5xx(
+            outlier_detection);
+    if (enforcing_consecutive_5xx != nullptr) {
+      uint32_t enforcement_percentage =
+          google_protobuf_UInt32Value_value(enforcing_consecutive_5xx);
+      if (enforcement_percentage != 0) {
+        OutlierDetectionConfig::ConsecutiveFailureEjection
+            consecutive_failure_ejection;
+        consecutive_failure_ejection.enforcement_percentage =
+            enforcement_percentage;
+        const google_protobuf_UInt32Value* consecutive_5xx =
+            envoy_config_cluster_v3_OutlierDetection_consecutive_5xx(
+                outlier_detection);
+        if (consecutive_5xx != nullptr) {
+          consecutive_failure_ejection.consecutive_failures =
+              google_protobuf_UInt32Value_value(consecutive_5xx);
+          if (consecutive_failure_ejection.consecutive_failures == 0) {
+            errors.emplace_back(
+                "outlier_detection.consecutive_5xx must be greater than 0");
+          }
+        }
+        outlier_detection_update.consecutive_failure_ejection =
+            consecutive_failure_ejection;
+      }
+    }
     cds_update.outlier_detection = outlier_detection_update;
   }
   // Return result.
@@ -63,11 +63,14 @@ struct XdsClusterResource {
   // If not set, load reporting will be disabled.
   absl::optional<GrpcXdsBootstrap::GrpcXdsServer> lrs_load_reporting_server;
 
-  // The LB policy to use (e.g., "ROUND_ROBIN" or "RING_HASH").
+  // The LB policy to use (e.g., "ROUND_ROBIN", "RING_HASH" or
+  // "LEAST_REQUEST").
   std::string lb_policy;
   // Used for RING_HASH LB policy only.
   uint64_t min_ring_size = 1024;
   uint64_t max_ring_size = 8388608;
+  // Used for LEAST_REQUEST LB policy only.
+  uint32_t choice_count = 2;
   // Maximum number of outstanding requests can be made to the upstream
   // cluster.
   uint32_t max_concurrent_requests = 1024;
@@ -84,6 +87,7 @@ struct XdsClusterResource {
            lb_policy == other.lb_policy &&
            min_ring_size == other.min_ring_size &&
            max_ring_size == other.max_ring_size &&
+           choice_count == other.choice_count &&
            max_concurrent_requests == other.max_concurrent_requests &&
            outlier_detection == other.outlier_detection;
   }
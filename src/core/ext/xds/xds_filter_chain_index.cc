@@ -0,0 +1,219 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/xds/xds_filter_chain_index.h"
+
+#include <string.h>
+
+#include <map>
+
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "src/core/lib/iomgr/socket_utils.h"
+
+namespace grpc_core {
+
+//
+// CidrTrie
+//
+
+CidrTrie::CidrTrie() : nodes_(2) {}
+
+int CidrTrie::GetRoot(const grpc_resolved_address& address,
+                      const uint8_t** bytes, uint32_t* bits) const {
+  const grpc_sockaddr* addr =
+      reinterpret_cast<const grpc_sockaddr*>(address.addr);
+  if (addr->sa_family == GRPC_AF_INET) {
+    *bytes = reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in*>(addr)->sin_addr);
+    *bits = 32;
+    return 0;
+  }
+  if (addr->sa_family == GRPC_AF_INET6) {
+    *bytes = reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in6*>(addr)->sin6_addr);
+    *bits = 128;
+    return 1;
+  }
+  return -1;
+}
+
+void CidrTrie::Insert(
+    const XdsListenerResource::FilterChainMap::CidrRange& range,
+    size_t value) {
+  const uint8_t* bytes;
+  uint32_t bits;
+  int node = GetRoot(range.address, &bytes, &bits);
+  if (node < 0) return;
+  for (uint32_t i = 0; i < range.prefix_len && i < bits; ++i) {
+    const int bit = (bytes[i / 8] >> (7 - i % 8)) & 1;
+    if (nodes_[node].children[bit] < 0) {
+      nodes_[node].children[bit] = static_cast<int32_t>(nodes_.size());
+      nodes_.emplace_back();
+    }
+    node = nodes_[node].children[bit];
+  }
+  if (nodes_[node].value < 0) nodes_[node].value = static_cast<int32_t>(value);
+}
+
+int CidrTrie::Find(const grpc_resolved_address& address) const {
+  const uint8_t* bytes;
+  uint32_t bits;
+  int node = GetRoot(address, &bytes, &bits);
+  if (node < 0) return -1;
+  int value = nodes_[node].value;
+  for (uint32_t i = 0; i < bits; ++i) {
+    node = nodes_[node].children[(bytes[i / 8] >> (7 - i % 8)) & 1];
+    if (node < 0) break;
+    if (nodes_[node].value >= 0) value = nodes_[node].value;
+  }
+  return value;
+}
+
+//
+// XdsFilterChainIndex
+//
+
+namespace {
+
+bool IsLoopbackIp(const grpc_resolved_address& address) {
+  const grpc_sockaddr* sock_addr =
+      reinterpret_cast<const grpc_sockaddr*>(&address.addr);
+  if (sock_addr->sa_family == GRPC_AF_INET) {
+    const grpc_sockaddr_in* addr4 =
+        reinterpret_cast<const grpc_sockaddr_in*>(sock_addr);
+    if (addr4->sin_addr.s_addr == grpc_htonl(INADDR_LOOPBACK)) {
+      return true;
+    }
+  } else if (sock_addr->sa_family == GRPC_AF_INET6) {
+    const grpc_sockaddr_in6* addr6 =
+        reinterpret_cast<const grpc_sockaddr_in6*>(sock_addr);
+    if (memcmp(&addr6->sin6_addr, &in6addr_loopback,
+               sizeof(in6addr_loopback)) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsSameIp(const grpc_resolved_address& a, const grpc_resolved_address& b) {
+  const grpc_sockaddr* addr_a = reinterpret_cast<const grpc_sockaddr*>(a.addr);
+  const grpc_sockaddr* addr_b = reinterpret_cast<const grpc_sockaddr*>(b.addr);
+  if (addr_a->sa_family != addr_b->sa_family) return false;
+  if (addr_a->sa_family == GRPC_AF_INET) {
+    return memcmp(&reinterpret_cast<const grpc_sockaddr_in*>(addr_a)->sin_addr,
+                  &reinterpret_cast<const grpc_sockaddr_in*>(addr_b)->sin_addr,
+                  sizeof(grpc_in_addr)) == 0;
+  }
+  if (addr_a->sa_family == GRPC_AF_INET6) {
+    return memcmp(
+               &reinterpret_cast<const grpc_sockaddr_in6*>(addr_a)->sin6_addr,
+               &reinterpret_cast<const grpc_sockaddr_in6*>(addr_b)->sin6_addr,
+               sizeof(grpc_in6_addr)) == 0;
+  }
+  return false;
+}
+
+const XdsListenerResource::FilterChainData* FindForSourcePort(
+    const XdsListenerResource::FilterChainMap::SourcePortsMap& source_ports_map,
+    int port) {
+  auto it = source_ports_map.find(port);
+  if (it != source_ports_map.end()) {
+    return it->second.data.get();
+  }
+  // Search for the catch-all port 0 since we didn't get a direct match
+  it = source_ports_map.find(0);
+  if (it != source_ports_map.end()) {
+    return it->second.data.get();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+void XdsFilterChainIndex::SourceIpIndex::Add(
+    const XdsListenerResource::FilterChainMap::SourceIp& entry) {
+  if (!entry.prefix_range.has_value()) {
+    if (catch_all == nullptr) catch_all = &entry;
+    return;
+  }
+  trie.Insert(*entry.prefix_range, entries.size());
+  entries.push_back(&entry);
+}
+
+const XdsListenerResource::FilterChainMap::SourceIp*
+XdsFilterChainIndex::SourceIpIndex::Find(
+    const grpc_resolved_address& address) const {
+  const int index = trie.Find(address);
+  if (index < 0) return catch_all;
+  return entries[index];
+}
+
+XdsFilterChainIndex::XdsFilterChainIndex(
+    const XdsListenerResource::FilterChainMap& filter_chain_map) {
+  destinations_.reserve(filter_chain_map.destination_ip_vector.size());
+  for (const auto& entry : filter_chain_map.destination_ip_vector) {
+    AddDestinationIp(entry);
+  }
+}
+
+void XdsFilterChainIndex::AddDestinationIp(
+    const XdsListenerResource::FilterChainMap::DestinationIp& entry) {
+  if (!entry.prefix_range.has_value()) {
+    if (catch_all_destination_ >= 0) return;
+    catch_all_destination_ = static_cast<int>(destinations_.size());
+  } else {
+    destination_trie_.Insert(*entry.prefix_range, destinations_.size());
+  }
+  destinations_.emplace_back();
+  DestinationIpEntry& destination = destinations_.back();
+  for (size_t i = 0; i < entry.source_types_array.size(); ++i) {
+    for (const auto& source_ip : entry.source_types_array[i]) {
+      destination.source_types[i].Add(source_ip);
+    }
+  }
+  using ConnectionSourceType =
+      XdsListenerResource::FilterChainMap::ConnectionSourceType;
+  const auto& source_types = entry.source_types_array;
+  destination.any_source_type_only =
+      source_types[static_cast<int>(ConnectionSourceType::kSameIpOrLoopback)]
+          .empty() &&
+      source_types[static_cast<int>(ConnectionSourceType::kExternal)].empty();
+}
+
+const XdsListenerResource::FilterChainData* XdsFilterChainIndex::Find(
+    const grpc_resolved_address& destination,
+    const grpc_resolved_address& source, int source_port) const {
+  int index = destination_trie_.Find(destination);
+  if (index < 0) index = catch_all_destination_;
+  if (index < 0) return nullptr;
+  const DestinationIpEntry& entry = destinations_[index];
+  using ConnectionSourceType =
+      XdsListenerResource::FilterChainMap::ConnectionSourceType;
+  ConnectionSourceType source_type = ConnectionSourceType::kAny;
+  if (!entry.any_source_type_only) {
+    source_type = IsLoopbackIp(source) || IsSameIp(source, destination)
+                      ? ConnectionSourceType::kSameIpOrLoopback
+                      : ConnectionSourceType::kExternal;
+  }
+  const auto* source_ip =
+      entry.source_types[static_cast<int>(source_type)].Find(source);
+  if (source_ip == nullptr) return nullptr;
+  return FindForSourcePort(source_ip->ports_map, source_port);
+}
+
+}  // namespace grpc_core
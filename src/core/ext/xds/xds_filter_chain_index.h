@@ -0,0 +1,110 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_XDS_XDS_FILTER_CHAIN_INDEX_H
+#define GRPC_CORE_EXT_XDS_XDS_FILTER_CHAIN_INDEX_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "src/core/ext/xds/xds_listener.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+
+namespace grpc_core {
+
+// Longest prefix match over IPv4 and IPv6 CIDR ranges, as a binary trie
+// per address family.  Each range maps to an index chosen by the caller.
+class CidrTrie {
+ public:
+  CidrTrie();
+
+  // Adds \a range with \a value.  If the range is already present, the
+  // value it was first added with is kept.
+  void Insert(const XdsListenerResource::FilterChainMap::CidrRange& range,
+              size_t value);
+
+  // Returns the value of the longest range containing \a address, or -1 if
+  // no range contains it.
+  int Find(const grpc_resolved_address& address) const;
+
+ private:
+  struct Node {
+    int32_t children[2] = {-1, -1};
+    int32_t value = -1;
+  };
+
+  // Returns the root node index for the family of \a address, or -1 for
+  // families other than IPv4 and IPv6, reporting the address bytes and
+  // their number of bits.
+  int GetRoot(const grpc_resolved_address& address, const uint8_t** bytes,
+              uint32_t* bits) const;
+
+  std::vector<Node> nodes_;
+};
+
+// Compiles an XdsListenerResource::FilterChainMap into tries over the
+// destination and source IP ranges, so that the filter chain of a
+// connection is found without scanning the ranges.  The map must outlive
+// the index.
+class XdsFilterChainIndex {
+ public:
+  explicit XdsFilterChainIndex(
+      const XdsListenerResource::FilterChainMap& filter_chain_map);
+
+  // Returns the filter chain matching a connection from \a source on
+  // \a source_port to \a destination, or nullptr if none matches.
+  const XdsListenerResource::FilterChainData* Find(
+      const grpc_resolved_address& destination,
+      const grpc_resolved_address& source, int source_port) const;
+
+ private:
+  struct SourceIpIndex {
+    CidrTrie trie;
+    std::vector<const XdsListenerResource::FilterChainMap::SourceIp*> entries;
+    // The entry without a prefix range, used when no range matches.
+    const XdsListenerResource::FilterChainMap::SourceIp* catch_all = nullptr;
+
+    void Add(const XdsListenerResource::FilterChainMap::SourceIp& entry);
+    const XdsListenerResource::FilterChainMap::SourceIp* Find(
+        const grpc_resolved_address& address) const;
+  };
+
+  // Indexed by ConnectionSourceType.
+  struct DestinationIpEntry {
+    std::array<SourceIpIndex, 3> source_types;
+    // Whether the kSameIpOrLoopback and kExternal entries are both empty,
+    // in which case the kAny entries apply to all connections.
+    bool any_source_type_only = true;
+  };
+
+  void AddDestinationIp(
+      const XdsListenerResource::FilterChainMap::DestinationIp& entry);
+
+  CidrTrie destination_trie_;
+  std::vector<DestinationIpEntry> destinations_;
+  // The index into destinations_ of the entry without a prefix range, used
+  // when no range matches, or -1.
+  int catch_all_destination_ = -1;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_XDS_XDS_FILTER_CHAIN_INDEX_H
@@ -19,6 +19,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <memory>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 
@@ -40,15 +41,21 @@ class XdsResourceTypeImpl : public XdsResourceType {
   // XdsClient watcher that handles down-casting.
   class WatcherInterface : public XdsClient::ResourceWatcherInterface {
    public:
-    virtual void OnResourceChanged(ResourceTypeStruct listener) = 0;
+    // The resource is shared with the XdsClient cache and with every other
+    // watcher of the same resource, so it must not be modified.
+    virtual void OnResourceChanged(
+        std::shared_ptr<const ResourceTypeStruct> resource) = 0;
 
    private:
     // Get result from XdsClient generic watcher interface, perform
-    // down-casting, and invoke the caller's OnListenerChanged() method.
+    // down-casting, and invoke the caller's OnResourceChanged() method.
     void OnGenericResourceChanged(
-        const XdsResourceType::ResourceData* resource) override {
-      OnResourceChanged(
-          static_cast<const ResourceDataSubclass*>(resource)->resource);
+        std::shared_ptr<const XdsResourceType::ResourceData> resource)
+        override {
+      const ResourceTypeStruct* value =
+          &static_cast<const ResourceDataSubclass*>(resource.get())->resource;
+      OnResourceChanged(std::shared_ptr<const ResourceTypeStruct>(
+          std::move(resource), value));
     }
   };
 
@@ -76,14 +83,6 @@ class XdsResourceTypeImpl : public XdsResourceType {
     return static_cast<const ResourceDataSubclass*>(r1)->resource ==
            static_cast<const ResourceDataSubclass*>(r2)->resource;
   }
-
-  std::unique_ptr<ResourceData> CopyResource(
-      const ResourceData* resource) const override {
-    auto* resource_copy = new ResourceDataSubclass();
-    resource_copy->resource =
-        static_cast<const ResourceDataSubclass*>(resource)->resource;
-    return std::unique_ptr<ResourceData>(resource_copy);
-  }
 };
 
 }  // namespace grpc_core
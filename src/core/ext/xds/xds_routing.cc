@@ -27,6 +27,7 @@
 #include <cctype>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
@@ -49,41 +50,43 @@ enum MatchType {
   INVALID_MATCH,
 };
 
-// Returns true if match succeeds.
-bool DomainMatch(MatchType match_type, absl::string_view domain_pattern_in,
-                 absl::string_view expected_host_name_in) {
-  // Normalize the args to lower-case. Domain matching is case-insensitive.
-  std::string domain_pattern = std::string(domain_pattern_in);
-  std::string expected_host_name = std::string(expected_host_name_in);
-  std::transform(domain_pattern.begin(), domain_pattern.end(),
-                 domain_pattern.begin(),
-                 [](unsigned char c) { return std::tolower(c); });
-  std::transform(expected_host_name.begin(), expected_host_name.end(),
-                 expected_host_name.begin(),
+std::string ToLowerCase(absl::string_view str) {
+  std::string result(str);
+  std::transform(result.begin(), result.end(), result.begin(),
                  [](unsigned char c) { return std::tolower(c); });
+  return result;
+}
+
+// Returns true if match succeeds.  Both args must already be lower-case.
+bool LowerCaseDomainMatch(MatchType match_type,
+                          absl::string_view domain_pattern,
+                          absl::string_view expected_host_name) {
   if (match_type == EXACT_MATCH) {
     return domain_pattern == expected_host_name;
   } else if (match_type == SUFFIX_MATCH) {
     // Asterisk must match at least one char.
     if (expected_host_name.size() < domain_pattern.size()) return false;
-    absl::string_view pattern_suffix(domain_pattern.c_str() + 1);
-    absl::string_view host_suffix(expected_host_name.c_str() +
-                                  expected_host_name.size() -
-                                  pattern_suffix.size());
-    return pattern_suffix == host_suffix;
+    absl::string_view pattern_suffix = domain_pattern.substr(1);
+    return absl::EndsWith(expected_host_name, pattern_suffix);
   } else if (match_type == PREFIX_MATCH) {
     // Asterisk must match at least one char.
     if (expected_host_name.size() < domain_pattern.size()) return false;
-    absl::string_view pattern_prefix(domain_pattern.c_str(),
-                                     domain_pattern.size() - 1);
-    absl::string_view host_prefix(expected_host_name.c_str(),
-                                  pattern_prefix.size());
-    return pattern_prefix == host_prefix;
+    absl::string_view pattern_prefix =
+        domain_pattern.substr(0, domain_pattern.size() - 1);
+    return absl::StartsWith(expected_host_name, pattern_prefix);
   } else {
     return match_type == UNIVERSE_MATCH;
   }
 }
 
+// Returns true if match succeeds.
+bool DomainMatch(MatchType match_type, absl::string_view domain_pattern,
+                 absl::string_view expected_host_name) {
+  // Normalize the args to lower-case. Domain matching is case-insensitive.
+  return LowerCaseDomainMatch(match_type, ToLowerCase(domain_pattern),
+                              ToLowerCase(expected_host_name));
+}
+
 MatchType DomainPatternMatchType(absl::string_view domain_pattern) {
   if (domain_pattern.empty()) return INVALID_MATCH;
   if (!absl::StrContains(domain_pattern, '*')) return EXACT_MATCH;
@@ -137,6 +140,49 @@ absl::optional<size_t> XdsRouting::FindVirtualHostForDomain(
   return target_index;
 }
 
+XdsRouting::VirtualHostIndex::VirtualHostIndex(
+    const VirtualHostListIterator& vhost_iterator) {
+  for (size_t i = 0; i < vhost_iterator.Size(); ++i) {
+    for (const std::string& domain_pattern :
+         vhost_iterator.GetDomainsForVirtualHost(i)) {
+      const MatchType match_type = DomainPatternMatchType(domain_pattern);
+      // This should be caught by RouteConfigParse().
+      GPR_ASSERT(match_type != INVALID_MATCH);
+      if (match_type == EXACT_MATCH) {
+        // Keeps the first virtual host if the domain is listed again.
+        exact_domains_.emplace(ToLowerCase(domain_pattern), i);
+      } else {
+        wildcard_patterns_.push_back(
+            {match_type, ToLowerCase(domain_pattern), i});
+      }
+    }
+  }
+  // The sort is stable, so patterns of the same type and length stay in
+  // virtual host order and the first virtual host wins.
+  std::stable_sort(wildcard_patterns_.begin(), wildcard_patterns_.end(),
+                   [](const WildcardPattern& a, const WildcardPattern& b) {
+                     if (a.match_type != b.match_type) {
+                       return a.match_type < b.match_type;
+                     }
+                     return a.pattern.size() > b.pattern.size();
+                   });
+}
+
+absl::optional<size_t> XdsRouting::VirtualHostIndex::Find(
+    absl::string_view domain) const {
+  const std::string lower_case_domain = ToLowerCase(domain);
+  auto it = exact_domains_.find(lower_case_domain);
+  if (it != exact_domains_.end()) return it->second;
+  for (const WildcardPattern& wildcard_pattern : wildcard_patterns_) {
+    if (LowerCaseDomainMatch(
+            static_cast<MatchType>(wildcard_pattern.match_type),
+            wildcard_pattern.pattern, lower_case_domain)) {
+      return wildcard_pattern.vhost_index;
+    }
+  }
+  return absl::nullopt;
+}
+
 namespace {
 
 bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
@@ -157,6 +203,16 @@ bool UnderFraction(const uint32_t fraction_per_million) {
   return random_number < fraction_per_million;
 }
 
+// Returns true if the route's header matchers and runtime fraction select
+// the request.  The path is checked by the caller.
+bool HeadersAndFractionMatch(
+    const XdsRouteConfigResource::Route::Matchers& matchers,
+    grpc_metadata_batch* initial_metadata) {
+  return HeadersMatch(matchers.header_matchers, initial_metadata) &&
+         (!matchers.fraction_per_million.has_value() ||
+          UnderFraction(*matchers.fraction_per_million));
+}
+
 }  // namespace
 
 absl::optional<size_t> XdsRouting::GetRouteForRequest(
@@ -166,15 +222,75 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
     const XdsRouteConfigResource::Route::Matchers& matchers =
         route_list_iterator.GetMatchersForRoute(i);
     if (matchers.path_matcher.Match(path) &&
-        HeadersMatch(matchers.header_matchers, initial_metadata) &&
-        (!matchers.fraction_per_million.has_value() ||
-         UnderFraction(*matchers.fraction_per_million))) {
+        HeadersAndFractionMatch(matchers, initial_metadata)) {
       return i;
     }
   }
   return absl::nullopt;
 }
 
+XdsRouting::RouteIndex::RouteIndex(
+    const RouteListIterator& route_list_iterator) {
+  std::vector<const StringMatcher*> other_path_matchers;
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    if (path_matcher.case_sensitive() &&
+        path_matcher.type() == StringMatcher::Type::kExact) {
+      exact_paths_[path_matcher.string_matcher()].push_back(i);
+    } else if (path_matcher.case_sensitive() &&
+               path_matcher.type() == StringMatcher::Type::kPrefix) {
+      path_prefixes_[path_matcher.string_matcher()].push_back(i);
+    } else {
+      other_routes_.push_back(i);
+      other_path_matchers.push_back(&path_matcher);
+    }
+  }
+  for (const auto& p : path_prefixes_) {
+    prefix_lengths_.push_back(p.first.size());
+  }
+  std::sort(prefix_lengths_.begin(), prefix_lengths_.end());
+  prefix_lengths_.erase(
+      std::unique(prefix_lengths_.begin(), prefix_lengths_.end()),
+      prefix_lengths_.end());
+  other_path_matchers_ = StringMatcherSet(other_path_matchers);
+}
+
+absl::optional<size_t> XdsRouting::RouteIndex::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  // Collect the routes whose path matcher matches.
+  absl::InlinedVector<size_t, 8> path_matches;
+  auto it = exact_paths_.find(path);
+  if (it != exact_paths_.end()) {
+    path_matches.insert(path_matches.end(), it->second.begin(),
+                        it->second.end());
+  }
+  for (size_t prefix_length : prefix_lengths_) {
+    if (prefix_length > path.size()) break;
+    it = path_prefixes_.find(path.substr(0, prefix_length));
+    if (it != path_prefixes_.end()) {
+      path_matches.insert(path_matches.end(), it->second.begin(),
+                          it->second.end());
+    }
+  }
+  if (!other_routes_.empty()) {
+    for (size_t i : other_path_matchers_.Match(path)) {
+      path_matches.push_back(other_routes_[i]);
+    }
+  }
+  // Evaluate the rest of their matchers in route order, so that the first
+  // matching route wins, as in GetRouteForRequest().
+  std::sort(path_matches.begin(), path_matches.end());
+  for (size_t index : path_matches) {
+    if (HeadersAndFractionMatch(route_list_iterator.GetMatchersForRoute(index),
+                                initial_metadata)) {
+      return index;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
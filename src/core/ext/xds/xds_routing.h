@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -34,6 +35,7 @@
 #include "src/core/ext/xds/xds_listener.h"
 #include "src/core/ext/xds/xds_route_config.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/matchers/matchers.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
 namespace grpc_core {
@@ -70,6 +72,65 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // An index over a list of virtual hosts, built once per update, that
+  // gives the same answer as FindVirtualHostForDomain() without scanning
+  // every domain pattern.  Exact domains are looked up in a hash map; the
+  // wildcard patterns are kept in the order in which they win.
+  class VirtualHostIndex {
+   public:
+    VirtualHostIndex() = default;
+    explicit VirtualHostIndex(const VirtualHostListIterator& vhost_iterator);
+
+    // Returns the index of the selected virtual host in the list.
+    absl::optional<size_t> Find(absl::string_view domain) const;
+
+   private:
+    struct WildcardPattern {
+      int match_type;
+      std::string pattern;  // Lower-case.
+      size_t vhost_index;
+    };
+
+    // Lower-case exact domain to the first virtual host that lists it.
+    absl::flat_hash_map<std::string, size_t> exact_domains_;
+    // Sorted by match type, then by decreasing length, then by vhost index,
+    // so the first one that matches is the best match.
+    std::vector<WildcardPattern> wildcard_patterns_;
+  };
+
+  // An index over a list of routes, built once per update, that gives the
+  // same answer as GetRouteForRequest() while only evaluating the routes
+  // that can match the request's path.  Routes with a case-sensitive exact
+  // or prefix path matcher are found through hash maps keyed by path and by
+  // prefix; the path matchers of all other routes are evaluated together
+  // by a StringMatcherSet.
+  class RouteIndex {
+   public:
+    RouteIndex() = default;
+    explicit RouteIndex(const RouteListIterator& route_list_iterator);
+
+    // Returns the index in route_list_iterator to use for a request with
+    // the specified path and metadata, or nullopt if no route matches.
+    // \a route_list_iterator must iterate over the same routes as the one
+    // the index was built from.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    // Path to the indexes of the routes that match exactly that path.
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_paths_;
+    // Prefix to the indexes of the routes that match that prefix.
+    absl::flat_hash_map<std::string, std::vector<size_t>> path_prefixes_;
+    // The distinct lengths of the keys of path_prefixes_, in increasing
+    // order.
+    std::vector<size_t> prefix_lengths_;
+    // Indexes of the routes that are not in either map.
+    std::vector<size_t> other_routes_;
+    // The path matchers of other_routes_, in the same order.
+    StringMatcherSet other_path_matchers_;
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
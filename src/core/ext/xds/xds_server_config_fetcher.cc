@@ -18,10 +18,7 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <string.h>
-
 #include <algorithm>
-#include <array>
 #include <map>
 #include <memory>
 #include <set>
@@ -56,13 +53,13 @@
 #include "src/core/ext/xds/xds_channel_stack_modifier.h"
 #include "src/core/ext/xds/xds_client_grpc.h"
 #include "src/core/ext/xds/xds_common_types.h"
+#include "src/core/ext/xds/xds_filter_chain_index.h"
 #include "src/core/ext/xds/xds_http_filters.h"
 #include "src/core/ext/xds/xds_listener.h"
 #include "src/core/ext/xds/xds_resource_type_impl.h"
 #include "src/core/ext/xds/xds_route_config.h"
 #include "src/core/ext/xds/xds_routing.h"
 #include "src/core/lib/address_utils/parse_address.h"
-#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_args_preconditioning.h"
 #include "src/core/lib/channel/channel_fwd.h"
@@ -78,8 +75,6 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/resolved_address.h"
-#include "src/core/lib/iomgr/sockaddr.h"
-#include "src/core/lib/iomgr/socket_utils.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_distributor.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
@@ -153,7 +148,8 @@ class XdsServerConfigFetcher::ListenerWatcher
     xds_client_.reset(DEBUG_LOCATION, "ListenerWatcher");
   }
 
-  void OnResourceChanged(XdsListenerResource listener) override;
+  void OnResourceChanged(
+      std::shared_ptr<const XdsListenerResource> listener) override;
 
   void OnError(absl::Status status) override;
 
@@ -262,6 +258,8 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager
   // ready.
   RefCountedPtr<ListenerWatcher> listener_watcher_;
   XdsListenerResource::FilterChainMap filter_chain_map_;
+  // Matches connections against filter_chain_map_.
+  const XdsFilterChainIndex filter_chain_index_;
   absl::optional<XdsListenerResource::FilterChainData> default_filter_chain_;
   Mutex mu_;
   size_t rds_resources_yet_to_fetch_ ABSL_GUARDED_BY(mu_) = 0;
@@ -287,9 +285,10 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       : resource_name_(std::move(resource_name)),
         filter_chain_match_manager_(std::move(filter_chain_match_manager)) {}
 
-  void OnResourceChanged(XdsRouteConfigResource route_config) override {
+  void OnResourceChanged(
+      std::shared_ptr<const XdsRouteConfigResource> route_config) override {
     filter_chain_match_manager_->OnRouteConfigChanged(resource_name_,
-                                                      std::move(route_config));
+                                                      *route_config);
   }
 
   void OnError(absl::Status status) override {
@@ -347,6 +346,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    XdsRouting::RouteIndex route_index;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -367,6 +367,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   };
 
   std::vector<VirtualHost> virtual_hosts_;
+  XdsRouting::VirtualHostIndex virtual_host_index_;
 };
 
 // An XdsServerConfigSelectorProvider implementation for when the
@@ -457,8 +458,9 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       WeakRefCountedPtr<DynamicXdsServerConfigSelectorProvider> parent)
       : parent_(std::move(parent)) {}
 
-  void OnResourceChanged(XdsRouteConfigResource route_config) override {
-    parent_->OnRouteConfigChanged(std::move(route_config));
+  void OnResourceChanged(
+      std::shared_ptr<const XdsRouteConfigResource> route_config) override {
+    parent_->OnRouteConfigChanged(*route_config);
   }
 
   void OnError(absl::Status status) override { parent_->OnError(status); }
@@ -543,13 +545,13 @@ XdsServerConfigFetcher::ListenerWatcher::ListenerWatcher(
       listening_address_(std::move(listening_address)) {}
 
 void XdsServerConfigFetcher::ListenerWatcher::OnResourceChanged(
-    XdsListenerResource listener) {
+    std::shared_ptr<const XdsListenerResource> listener) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_server_config_fetcher_trace)) {
     gpr_log(GPR_INFO,
             "[ListenerWatcher %p] Received LDS update from xds client %p: %s",
-            this, xds_client_.get(), listener.ToString().c_str());
+            this, xds_client_.get(), listener->ToString().c_str());
   }
-  if (listener.address != listening_address_) {
+  if (listener->address != listening_address_) {
     MutexLock lock(&mu_);
     OnFatalError(absl::FailedPreconditionError(
         "Address in LDS update does not match listening address"));
@@ -557,8 +559,7 @@ void XdsServerConfigFetcher::ListenerWatcher::OnResourceChanged(
   }
   auto new_filter_chain_match_manager = MakeRefCounted<FilterChainMatchManager>(
       xds_client_->Ref(DEBUG_LOCATION, "FilterChainMatchManager"),
-      std::move(listener.filter_chain_map),
-      std::move(listener.default_filter_chain));
+      listener->filter_chain_map, listener->default_filter_chain);
   MutexLock lock(&mu_);
   if (filter_chain_match_manager_ == nullptr ||
       !(new_filter_chain_match_manager->filter_chain_map() ==
@@ -666,6 +667,7 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
             default_filter_chain)
     : xds_client_(std::move(xds_client)),
       filter_chain_map_(std::move(filter_chain_map)),
+      filter_chain_index_(filter_chain_map_),
       default_filter_chain_(std::move(default_filter_chain)) {}
 
 void XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
@@ -886,170 +888,49 @@ void XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   }
 }
 
-const XdsListenerResource::FilterChainData* FindFilterChainDataForSourcePort(
-    const XdsListenerResource::FilterChainMap::SourcePortsMap& source_ports_map,
-    absl::string_view port_str) {
-  int port = 0;
-  if (!absl::SimpleAtoi(port_str, &port)) return nullptr;
-  auto it = source_ports_map.find(port);
-  if (it != source_ports_map.end()) {
-    return it->second.data.get();
-  }
-  // Search for the catch-all port 0 since we didn't get a direct match
-  it = source_ports_map.find(0);
-  if (it != source_ports_map.end()) {
-    return it->second.data.get();
-  }
-  return nullptr;
-}
-
-const XdsListenerResource::FilterChainData* FindFilterChainDataForSourceIp(
-    const XdsListenerResource::FilterChainMap::SourceIpVector& source_ip_vector,
-    const grpc_resolved_address* source_ip, absl::string_view port) {
-  const XdsListenerResource::FilterChainMap::SourceIp* best_match = nullptr;
-  for (const auto& entry : source_ip_vector) {
-    // Special case for catch-all
-    if (!entry.prefix_range.has_value()) {
-      if (best_match == nullptr) {
-        best_match = &entry;
-      }
-      continue;
-    }
-    if (best_match != nullptr && best_match->prefix_range.has_value() &&
-        best_match->prefix_range->prefix_len >=
-            entry.prefix_range->prefix_len) {
-      continue;
-    }
-    if (grpc_sockaddr_match_subnet(source_ip, &entry.prefix_range->address,
-                                   entry.prefix_range->prefix_len)) {
-      best_match = &entry;
-    }
-  }
-  if (best_match == nullptr) return nullptr;
-  return FindFilterChainDataForSourcePort(best_match->ports_map, port);
-}
-
-bool IsLoopbackIp(const grpc_resolved_address* address) {
-  const grpc_sockaddr* sock_addr =
-      reinterpret_cast<const grpc_sockaddr*>(&address->addr);
-  if (sock_addr->sa_family == GRPC_AF_INET) {
-    const grpc_sockaddr_in* addr4 =
-        reinterpret_cast<const grpc_sockaddr_in*>(sock_addr);
-    if (addr4->sin_addr.s_addr == grpc_htonl(INADDR_LOOPBACK)) {
-      return true;
-    }
-  } else if (sock_addr->sa_family == GRPC_AF_INET6) {
-    const grpc_sockaddr_in6* addr6 =
-        reinterpret_cast<const grpc_sockaddr_in6*>(sock_addr);
-    if (memcmp(&addr6->sin6_addr, &in6addr_loopback,
-               sizeof(in6addr_loopback)) == 0) {
-      return true;
-    }
-  }
-  return false;
-}
-
-const XdsListenerResource::FilterChainData* FindFilterChainDataForSourceType(
-    const XdsListenerResource::FilterChainMap::ConnectionSourceTypesArray&
-        source_types_array,
-    grpc_endpoint* tcp, absl::string_view destination_ip) {
-  auto source_uri = URI::Parse(grpc_endpoint_get_peer(tcp));
-  if (!source_uri.ok() ||
-      (source_uri->scheme() != "ipv4" && source_uri->scheme() != "ipv6")) {
-    return nullptr;
+// Parses an endpoint address URI into the address and port.
+bool ParseEndpointAddress(absl::string_view uri_str,
+                          grpc_resolved_address* address, int* port) {
+  auto uri = URI::Parse(uri_str);
+  if (!uri.ok() || (uri->scheme() != "ipv4" && uri->scheme() != "ipv6")) {
+    return false;
   }
   std::string host;
-  std::string port;
-  if (!SplitHostPort(source_uri->path(), &host, &port)) {
-    return nullptr;
+  std::string port_str;
+  if (!SplitHostPort(uri->path(), &host, &port_str)) {
+    return false;
   }
-  auto source_addr = StringToSockaddr(host, 0);  // Port doesn't matter here.
-  if (!source_addr.ok()) {
+  auto addr = StringToSockaddr(host, 0);  // Port doesn't matter here.
+  if (!addr.ok()) {
     gpr_log(GPR_DEBUG, "Could not parse \"%s\" as socket address: %s",
-            host.c_str(), source_addr.status().ToString().c_str());
-    return nullptr;
-  }
-  // Use kAny only if kSameIporLoopback and kExternal are empty
-  if (source_types_array[static_cast<int>(
-                             XdsListenerResource::FilterChainMap::
-                                 ConnectionSourceType::kSameIpOrLoopback)]
-          .empty() &&
-      source_types_array[static_cast<int>(XdsListenerResource::FilterChainMap::
-                                              ConnectionSourceType::kExternal)]
-          .empty()) {
-    return FindFilterChainDataForSourceIp(
-        source_types_array[static_cast<int>(
-            XdsListenerResource::FilterChainMap::ConnectionSourceType::kAny)],
-        &*source_addr, port);
-  }
-  if (IsLoopbackIp(&*source_addr) || host == destination_ip) {
-    return FindFilterChainDataForSourceIp(
-        source_types_array[static_cast<int>(
-            XdsListenerResource::FilterChainMap::ConnectionSourceType::
-                kSameIpOrLoopback)],
-        &*source_addr, port);
-  } else {
-    return FindFilterChainDataForSourceIp(
-        source_types_array[static_cast<int>(
-            XdsListenerResource::FilterChainMap::ConnectionSourceType::
-                kExternal)],
-        &*source_addr, port);
+            host.c_str(), addr.status().ToString().c_str());
+    return false;
   }
+  *address = *addr;
+  return port == nullptr || absl::SimpleAtoi(port_str, port);
 }
 
-const XdsListenerResource::FilterChainData* FindFilterChainDataForDestinationIp(
-    const XdsListenerResource::FilterChainMap::DestinationIpVector
-        destination_ip_vector,
-    grpc_endpoint* tcp) {
-  auto destination_uri = URI::Parse(grpc_endpoint_get_local_address(tcp));
-  if (!destination_uri.ok() || (destination_uri->scheme() != "ipv4" &&
-                                destination_uri->scheme() != "ipv6")) {
-    return nullptr;
-  }
-  std::string host;
-  std::string port;
-  if (!SplitHostPort(destination_uri->path(), &host, &port)) {
+const XdsListenerResource::FilterChainData* FindFilterChainData(
+    const XdsFilterChainIndex& filter_chain_index, grpc_endpoint* tcp) {
+  grpc_resolved_address destination_addr;
+  if (!ParseEndpointAddress(grpc_endpoint_get_local_address(tcp),
+                            &destination_addr, nullptr)) {
     return nullptr;
   }
-  auto destination_addr =
-      StringToSockaddr(host, 0);  // Port doesn't matter here.
-  if (!destination_addr.ok()) {
-    gpr_log(GPR_DEBUG, "Could not parse \"%s\" as socket address: %s",
-            host.c_str(), destination_addr.status().ToString().c_str());
+  grpc_resolved_address source_addr;
+  int source_port;
+  if (!ParseEndpointAddress(grpc_endpoint_get_peer(tcp), &source_addr,
+                            &source_port)) {
     return nullptr;
   }
-  const XdsListenerResource::FilterChainMap::DestinationIp* best_match =
-      nullptr;
-  for (const auto& entry : destination_ip_vector) {
-    // Special case for catch-all
-    if (!entry.prefix_range.has_value()) {
-      if (best_match == nullptr) {
-        best_match = &entry;
-      }
-      continue;
-    }
-    if (best_match != nullptr && best_match->prefix_range.has_value() &&
-        best_match->prefix_range->prefix_len >=
-            entry.prefix_range->prefix_len) {
-      continue;
-    }
-    if (grpc_sockaddr_match_subnet(&*destination_addr,
-                                   &entry.prefix_range->address,
-                                   entry.prefix_range->prefix_len)) {
-      best_match = &entry;
-    }
-  }
-  if (best_match == nullptr) return nullptr;
-  return FindFilterChainDataForSourceType(best_match->source_types_array, tcp,
-                                          host);
+  return filter_chain_index.Find(destination_addr, source_addr, source_port);
 }
 
 absl::StatusOr<ChannelArgs> XdsServerConfigFetcher::ListenerWatcher::
     FilterChainMatchManager::UpdateChannelArgsForConnection(
         const ChannelArgs& input_args, grpc_endpoint* tcp) {
   ChannelArgs args = input_args;
-  const auto* filter_chain = FindFilterChainDataForDestinationIp(
-      filter_chain_map_.destination_ip_vector, tcp);
+  const auto* filter_chain = FindFilterChainData(filter_chain_index_, tcp);
   if (filter_chain == nullptr && default_filter_chain_.has_value()) {
     filter_chain = &default_filter_chain_.value();
   }
@@ -1171,7 +1052,11 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
             ServiceConfigImpl::Create(result->args, json.c_str()).value();
       }
     }
+    virtual_host.route_index = XdsRouting::RouteIndex(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
+  config_selector->virtual_host_index_ = XdsRouting::VirtualHostIndex(
+      VirtualHostListIterator(&config_selector->virtual_hosts_));
   return config_selector;
 }
 
@@ -1192,8 +1077,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
   }
   absl::string_view authority =
       metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&virtual_hosts_), authority);
+  auto vhost_index = virtual_host_index_.Find(authority);
   if (!vhost_index.has_value()) {
     call_config.error =
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -1203,7 +1087,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
     return call_config;
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = virtual_host.route_index.GetRouteForRequest(
       VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
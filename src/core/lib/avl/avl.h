@@ -32,6 +32,14 @@ class AVL {
  public:
   AVL() {}
 
+  // Builds a tree from the key value pairs in [begin, end), which must be
+  // sorted by key without duplicates, moving them out of the range. Takes
+  // one allocation per pair, rather than the path copies of an Add() each.
+  template <typename RandomIt>
+  static AVL FromSortedUnique(RandomIt begin, RandomIt end) {
+    return AVL(BuildBalanced(begin, end));
+  }
+
   AVL Add(K key, V value) const {
     return AVL(AddKey(root_, std::move(key), std::move(value)));
   }
@@ -41,8 +49,15 @@ class AVL {
   }
   template <typename SomethingLikeK>
   const V* Lookup(const SomethingLikeK& key) const {
-    NodePtr n = Get(root_, key);
-    return n ? &n->kv.second : nullptr;
+    // Walk the tree without taking refs on its nodes, which this tree
+    // already keeps alive, and with one comparison per level.
+    const Node* n = root_.get();
+    while (n != nullptr) {
+      const int cmp = QsortCompare(n->kv.first, key);
+      if (cmp == 0) return &n->kv.second;
+      n = cmp > 0 ? n->left.get() : n->right.get();
+    }
+    return nullptr;
   }
 
   const std::pair<K, V>* LookupBelow(const K& key) const {
@@ -170,19 +185,15 @@ class AVL {
                                   1 + std::max(Height(left), Height(right)));
   }
 
-  template <typename SomethingLikeK>
-  static NodePtr Get(const NodePtr& node, const SomethingLikeK& key) {
-    if (node == nullptr) {
-      return nullptr;
-    }
-
-    if (node->kv.first > key) {
-      return Get(node->left, key);
-    } else if (node->kv.first < key) {
-      return Get(node->right, key);
-    } else {
-      return node;
-    }
+  template <typename RandomIt>
+  static NodePtr BuildBalanced(RandomIt begin, RandomIt end) {
+    if (begin == end) return nullptr;
+    // Halves differ in size by at most one, and so in height.
+    RandomIt mid = begin + (end - begin) / 2;
+    NodePtr left = BuildBalanced(begin, mid);
+    NodePtr right = BuildBalanced(mid + 1, end);
+    return MakeNode(std::move(mid->first), std::move(mid->second), left,
+                    right);
   }
 
   static NodePtr GetBelow(const NodePtr& node, const K& key) {
@@ -72,6 +72,23 @@ class CallTracer {
         absl::Status status, grpc_metadata_batch* recv_trailing_metadata,
         const grpc_transport_stream_stats* transport_stream_stats) = 0;
     virtual void RecordCancel(grpc_error_handle cancel_error) = 0;
+    // Points in the life of the attempt that its latency can be broken down
+    // by, in the order they happen to an attempt that sees all of them.
+    enum class LatencyEvent {
+      // The LB pick had to wait for a new picker.
+      kPickQueued,
+      // The LB pick completed and the attempt is started on a subchannel.
+      kPickComplete,
+      // The transport started writing the first bytes of the attempt.
+      kFirstByteWritten,
+    };
+    // Records that \a event happened at \a time (a GPR_CLOCK_MONOTONIC time).
+    // Each event is recorded at most once, before RecordEnd(), but not
+    // necessarily when it happens: kFirstByteWritten is recorded when the
+    // transport reports its stats. Tracers that do not break latency down
+    // need not implement it.
+    virtual void RecordLatencyEvent(LatencyEvent /*event*/,
+                                    gpr_timespec /*time*/) {}
     // Should be the last API call to the object. Once invoked, the tracer
     // library is free to destroy the object.
     virtual void RecordEnd(const gpr_timespec& latency) = 0;
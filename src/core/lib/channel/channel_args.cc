@@ -101,29 +101,60 @@ bool ChannelArgs::WantMinimalStack() const {
 ChannelArgs::ChannelArgs(AVL<std::string, Value> args)
     : args_(std::move(args)) {}
 
-ChannelArgs ChannelArgs::Set(grpc_arg arg) const {
+ChannelArgs::Value ChannelArgs::ValueFromC(const grpc_arg& arg) {
   switch (arg.type) {
     case GRPC_ARG_INTEGER:
-      return Set(arg.key, arg.value.integer);
+      return Value(arg.value.integer);
     case GRPC_ARG_STRING:
-      if (arg.value.string != nullptr) return Set(arg.key, arg.value.string);
-      return Set(arg.key, "");
+      if (arg.value.string != nullptr) {
+        return Value(std::string(arg.value.string));
+      }
+      return Value(std::string());
     case GRPC_ARG_POINTER:
-      return Set(arg.key,
-                 Pointer(arg.value.pointer.vtable->copy(arg.value.pointer.p),
-                         arg.value.pointer.vtable));
+      return Value(
+          Pointer(arg.value.pointer.vtable->copy(arg.value.pointer.p),
+                  arg.value.pointer.vtable));
   }
-  GPR_UNREACHABLE_CODE(return ChannelArgs());
+  GPR_UNREACHABLE_CODE(return Value());
 }
 
-ChannelArgs ChannelArgs::FromC(const grpc_channel_args* args) {
-  ChannelArgs result;
-  if (args != nullptr) {
-    for (size_t i = 0; i < args->num_args; i++) {
-      result = result.Set(args->args[i]);
+ChannelArgs ChannelArgs::Set(grpc_arg arg) const {
+  return Set(arg.key, ValueFromC(arg));
+}
+
+ChannelArgs ChannelArgs::FromEntries(
+    std::vector<std::pair<std::string, Value>> entries) {
+  // Values are moved but never assigned (Pointer is not move assignable):
+  // sort pointers to the entries.
+  std::vector<std::pair<std::string, Value>*> by_key;
+  by_key.reserve(entries.size());
+  for (auto& entry : entries) by_key.push_back(&entry);
+  std::stable_sort(by_key.begin(), by_key.end(),
+                   [](const std::pair<std::string, Value>* a,
+                      const std::pair<std::string, Value>* b) {
+                     return a->first < b->first;
+                   });
+  // Keep the last entry of each run with the same key.
+  std::vector<std::pair<std::string, Value>> sorted;
+  sorted.reserve(by_key.size());
+  for (size_t i = 0; i < by_key.size(); i++) {
+    if (i + 1 < by_key.size() && by_key[i + 1]->first == by_key[i]->first) {
+      continue;
     }
+    sorted.push_back(std::move(*by_key[i]));
   }
-  return result;
+  return ChannelArgs(AVL<std::string, Value>::FromSortedUnique(sorted.begin(),
+                                                              sorted.end()));
+}
+
+ChannelArgs ChannelArgs::FromC(const grpc_channel_args* args) {
+  if (args == nullptr) return ChannelArgs();
+  std::vector<std::pair<std::string, Value>> entries;
+  entries.reserve(args->num_args);
+  for (size_t i = 0; i < args->num_args; i++) {
+    entries.emplace_back(args->args[i].key, ValueFromC(args->args[i]));
+  }
+  return FromEntries(std::move(entries));
 }
 
 ChannelArgs::CPtr ChannelArgs::ToC() const {
@@ -574,7 +605,8 @@ std::string grpc_channel_args_string(const grpc_channel_args* args) {
 namespace grpc_core {
 ChannelArgs ChannelArgsBuiltinPrecondition(const grpc_channel_args* src) {
   if (src == nullptr) return ChannelArgs();
-  ChannelArgs output;
+  std::vector<std::pair<std::string, ChannelArgs::Value>> entries;
+  entries.reserve(src->num_args);
   std::map<absl::string_view, std::vector<absl::string_view>>
       concatenated_values;
   for (size_t i = 0; i < src->num_args; i++) {
@@ -593,14 +625,16 @@ ChannelArgs ChannelArgsBuiltinPrecondition(const grpc_channel_args* src) {
     } else if (absl::StartsWith(key, "grpc.internal.")) {
       continue;
     }
-    if (!output.Contains(key)) {
-      output = output.Set(src->args[i]);
-    } else {
-      // Traditional grpc_channel_args_find behavior was to pick the first
-      // value.
-      // For compatibility with existing users, we will do the same here.
-    }
+    entries.emplace_back(std::string(key),
+                         ChannelArgs::ValueFromC(src->args[i]));
   }
+  // Traditional grpc_channel_args_find behavior was to pick the first value.
+  // For compatibility with existing users, we will do the same here: the
+  // last of the reversed entries wins.
+  ChannelArgs output = ChannelArgs::FromEntries(
+      std::vector<std::pair<std::string, ChannelArgs::Value>>(
+          std::make_move_iterator(entries.rbegin()),
+          std::make_move_iterator(entries.rend())));
   // Concatenate the concatenated values.
   for (const auto& concatenated_value : concatenated_values) {
     output = output.Set(concatenated_value.first,
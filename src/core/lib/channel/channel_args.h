@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/meta/type_traits.h"
 #include "absl/strings/string_view.h"
@@ -278,6 +279,13 @@ class ChannelArgs {
   static ChannelArgs FromC(const grpc_channel_args& args) {
     return FromC(&args);
   }
+  // Builds channel args from many entries at once, which is cheaper than a
+  // Set() per entry. As with successive Set() calls, a later entry replaces
+  // an earlier one with the same key.
+  static ChannelArgs FromEntries(
+      std::vector<std::pair<std::string, Value>> entries);
+  // Converts the value of a C channel arg, taking a ref to a pointer value.
+  static Value ValueFromC(const grpc_arg& arg);
   // Construct a new grpc_channel_args struct.
   CPtr ToC() const;
 
@@ -394,6 +402,12 @@ class ChannelArgs {
         reason);
   }
 
+  // Calls f(key, value) for each arg, in key order.
+  template <typename F>
+  void ForEach(F&& f) const {
+    args_.ForEach(std::forward<F>(f));
+  }
+
   bool operator!=(const ChannelArgs& other) const;
   bool operator<(const ChannelArgs& other) const;
   bool operator==(const ChannelArgs& other) const;
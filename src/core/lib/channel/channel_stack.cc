@@ -143,6 +143,7 @@ grpc_error_handle grpc_channel_stack_init(
     args.is_last = i == (filter_count - 1);
     elems[i].filter = filters[i];
     elems[i].channel_data = user_data;
+    elems[i].call_data_offset = call_size;
     grpc_error_handle error =
         elems[i].filter->init_channel_elem(&elems[i], &args);
     if (!error.ok()) {
@@ -184,23 +185,21 @@ grpc_error_handle grpc_call_stack_init(
   grpc_channel_element* channel_elems = CHANNEL_ELEMS_FROM_STACK(channel_stack);
   size_t count = channel_stack->count;
   grpc_call_element* call_elems;
-  char* user_data;
+  char* call_stack_start = reinterpret_cast<char*>(elem_args->call_stack);
 
   elem_args->call_stack->count = count;
   GRPC_STREAM_REF_INIT(&elem_args->call_stack->refcount, initial_refs, destroy,
                        destroy_arg, "CALL_STACK");
   call_elems = CALL_ELEMS_FROM_STACK(elem_args->call_stack);
-  user_data = (reinterpret_cast<char*>(call_elems)) +
-              GPR_ROUND_UP_TO_ALIGNMENT_SIZE(count * sizeof(grpc_call_element));
 
-  /* init per-filter data */
+  /* init per-filter data: the layout was computed with the channel stack, so
+     this only reads the channel elements */
   grpc_error_handle first_error;
   for (size_t i = 0; i < count; i++) {
     call_elems[i].filter = channel_elems[i].filter;
     call_elems[i].channel_data = channel_elems[i].channel_data;
-    call_elems[i].call_data = user_data;
-    user_data +=
-        GPR_ROUND_UP_TO_ALIGNMENT_SIZE(call_elems[i].filter->sizeof_call_data);
+    call_elems[i].call_data =
+        call_stack_start + channel_elems[i].call_data_offset;
   }
   for (size_t i = 0; i < count; i++) {
     grpc_error_handle error =
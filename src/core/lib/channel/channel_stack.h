@@ -187,6 +187,9 @@ struct grpc_channel_filter {
 struct grpc_channel_element {
   const grpc_channel_filter* filter;
   void* channel_data;
+  /* Offset of the call data of this filter from the start of a call stack
+     (computed at channel stack initialization) */
+  size_t call_data_offset;
 };
 
 /* A call_element tracks its filter, the filter requested memory within
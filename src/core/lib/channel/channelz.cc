@@ -23,12 +23,14 @@
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <new>
 
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/strip.h"
 
 #include <grpc/impl/codegen/gpr_types.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
@@ -67,45 +69,50 @@ std::string BaseNode::RenderJsonString() {
 // CallCountingHelper
 //
 
-CallCountingHelper::CallCountingHelper() {
-  num_cores_ = std::max(1u, gpr_cpu_num_cores());
-  per_cpu_counter_data_storage_.reserve(num_cores_);
+CallCountingHelper::CallCountingHelper()
+    : num_cores_(std::max(1u, gpr_cpu_num_cores())),
+      per_cpu_counter_data_(static_cast<AtomicCounterData*>(gpr_malloc_aligned(
+          num_cores_ * sizeof(AtomicCounterData), GPR_CACHELINE_SIZE))) {
   for (size_t i = 0; i < num_cores_; ++i) {
-    per_cpu_counter_data_storage_.emplace_back();
+    new (&per_cpu_counter_data_[i]) AtomicCounterData();
   }
 }
 
+CallCountingHelper::~CallCountingHelper() {
+  for (size_t i = 0; i < num_cores_; ++i) {
+    per_cpu_counter_data_[i].~AtomicCounterData();
+  }
+  gpr_free_aligned(per_cpu_counter_data_);
+}
+
+CallCountingHelper::AtomicCounterData& CallCountingHelper::PerCpuData() {
+  return per_cpu_counter_data_[ExecCtx::Get()->starting_cpu() % num_cores_];
+}
+
 void CallCountingHelper::RecordCallStarted() {
-  AtomicCounterData& data =
-      per_cpu_counter_data_storage_[ExecCtx::Get()->starting_cpu()];
+  AtomicCounterData& data = PerCpuData();
   data.calls_started.fetch_add(1, std::memory_order_relaxed);
   data.last_call_started_cycle.store(gpr_get_cycle_counter(),
                                      std::memory_order_relaxed);
 }
 
 void CallCountingHelper::RecordCallFailed() {
-  per_cpu_counter_data_storage_[ExecCtx::Get()->starting_cpu()]
-      .calls_failed.fetch_add(1, std::memory_order_relaxed);
+  PerCpuData().calls_failed.fetch_add(1, std::memory_order_relaxed);
 }
 
 void CallCountingHelper::RecordCallSucceeded() {
-  per_cpu_counter_data_storage_[ExecCtx::Get()->starting_cpu()]
-      .calls_succeeded.fetch_add(1, std::memory_order_relaxed);
+  PerCpuData().calls_succeeded.fetch_add(1, std::memory_order_relaxed);
 }
 
 void CallCountingHelper::CollectData(CounterData* out) {
   for (size_t core = 0; core < num_cores_; ++core) {
-    AtomicCounterData& data = per_cpu_counter_data_storage_[core];
-
+    const AtomicCounterData& data = per_cpu_counter_data_[core];
     out->calls_started += data.calls_started.load(std::memory_order_relaxed);
     out->calls_succeeded +=
-        per_cpu_counter_data_storage_[core].calls_succeeded.load(
-            std::memory_order_relaxed);
-    out->calls_failed += per_cpu_counter_data_storage_[core].calls_failed.load(
-        std::memory_order_relaxed);
+        data.calls_succeeded.load(std::memory_order_relaxed);
+    out->calls_failed += data.calls_failed.load(std::memory_order_relaxed);
     const gpr_cycle_counter last_call =
-        per_cpu_counter_data_storage_[core].last_call_started_cycle.load(
-            std::memory_order_relaxed);
+        data.last_call_started_cycle.load(std::memory_order_relaxed);
     if (last_call > out->last_call_started_cycle) {
       out->last_call_started_cycle = last_call;
     }
@@ -485,6 +492,11 @@ void SocketNode::RecordMessageReceived() {
                                      std::memory_order_relaxed);
 }
 
+void SocketNode::SetSocketOption(absl::string_view name, std::string value) {
+  MutexLock lock(&options_mu_);
+  options_[std::string(name)] = std::move(value);
+}
+
 Json SocketNode::RenderJson() {
   // Create and fill the data child.
   Json::Object data;
@@ -541,6 +553,19 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = std::to_string(keepalives_sent);
   }
+  {
+    MutexLock lock(&options_mu_);
+    if (!options_.empty()) {
+      Json::Array options;
+      for (const auto& option : options_) {
+        options.push_back(Json::Object{
+            {"name", option.first},
+            {"value", option.second},
+        });
+      }
+      data["option"] = std::move(options);
+    }
+  }
   // Create and fill the parent object.
   Json::Object object = {
       {"ref",
@@ -29,8 +29,8 @@
 #include <set>
 #include <string>
 #include <utility>
-#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -123,6 +123,10 @@ class BaseNode : public RefCounted<BaseNode> {
 class CallCountingHelper {
  public:
   CallCountingHelper();
+  ~CallCountingHelper();
+
+  CallCountingHelper(const CallCountingHelper&) = delete;
+  CallCountingHelper& operator=(const CallCountingHelper&) = delete;
 
   void RecordCallStarted();
   void RecordCallFailed();
@@ -135,17 +139,10 @@ class CallCountingHelper {
   // testing peer friend.
   friend class testing::CallCountingHelperPeer;
 
-  // TODO(soheil): add a proper PerCPU helper and use it here.
+  // The counts of the calls of one CPU. Each is aligned to a cache line of
+  // its own, so that calls on different CPUs never write the same line: the
+  // sum is only taken when channelz is queried.
   struct AtomicCounterData {
-    // Define the ctors so that we can use this structure in InlinedVector.
-    AtomicCounterData() = default;
-    AtomicCounterData(const AtomicCounterData& that)
-        : calls_started(that.calls_started.load(std::memory_order_relaxed)),
-          calls_succeeded(that.calls_succeeded.load(std::memory_order_relaxed)),
-          calls_failed(that.calls_failed.load(std::memory_order_relaxed)),
-          last_call_started_cycle(
-              that.last_call_started_cycle.load(std::memory_order_relaxed)) {}
-
     std::atomic<int64_t> calls_started{0};
     std::atomic<int64_t> calls_succeeded{0};
     std::atomic<int64_t> calls_failed{0};
@@ -154,12 +151,11 @@ class CallCountingHelper {
     uint8_t padding[GPR_CACHELINE_SIZE - 3 * sizeof(std::atomic<intptr_t>) -
                     sizeof(std::atomic<gpr_cycle_counter>)];
   };
-  // TODO(soheilhy,veblush): Revist this after abseil integration.
-  // This has a problem when using abseil inlined_vector because it
-  // carries an alignment attribute properly but our allocator doesn't
-  // respect this. To avoid UBSAN errors, this should be removed with
-  // abseil inlined_vector.
-  // GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+  static_assert(sizeof(AtomicCounterData) == GPR_CACHELINE_SIZE,
+                "AtomicCounterData must fill a cache line");
+
+  // The entry of the CPU the current ExecCtx started on.
+  AtomicCounterData& PerCpuData();
 
   struct CounterData {
     int64_t calls_started = 0;
@@ -171,8 +167,9 @@ class CallCountingHelper {
   // collects the sharded data into one CounterData struct.
   void CollectData(CounterData* out);
 
-  std::vector<AtomicCounterData> per_cpu_counter_data_storage_;
-  size_t num_cores_ = 0;
+  const size_t num_cores_;
+  // num_cores_ entries, allocated on a cache line boundary.
+  AtomicCounterData* const per_cpu_counter_data_;
 };
 
 // Handles channelz bookkeeping for channels
@@ -340,6 +337,10 @@ class SocketNode : public BaseNode {
 
   const std::string& remote() { return remote_; }
 
+  // Sets the value reported for the socket option \a name, replacing any
+  // earlier value. Lets the endpoint export settings it adapts at runtime.
+  void SetSocketOption(absl::string_view name, std::string value);
+
  private:
   std::atomic<int64_t> streams_started_{0};
   std::atomic<int64_t> streams_succeeded_{0};
@@ -354,6 +355,8 @@ class SocketNode : public BaseNode {
   std::string local_;
   std::string remote_;
   RefCountedPtr<Security> const security_;
+  Mutex options_mu_;
+  std::map<std::string, std::string> options_ ABSL_GUARDED_BY(options_mu_);
 };
 
 // Handles channelz bookkeeping for listen sockets
@@ -43,124 +43,126 @@ const int kPaginationLimit = 100;
 
 }  // anonymous namespace
 
+constexpr size_t ChannelzRegistry::kNumShards;
+
 ChannelzRegistry* ChannelzRegistry::Default() {
   static ChannelzRegistry* singleton = new ChannelzRegistry();
   return singleton;
 }
 
+std::map<intptr_t, BaseNode*>* ChannelzRegistry::ListedIndex(
+    BaseNode::EntityType type) {
+  switch (type) {
+    case BaseNode::EntityType::kTopLevelChannel:
+      return &top_level_channels_;
+    case BaseNode::EntityType::kServer:
+      return &servers_;
+    default:
+      return nullptr;
+  }
+}
+
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.fetch_add(1, std::memory_order_relaxed) + 1;
+  {
+    Shard& shard = ShardFor(node->uuid_);
+    MutexLock lock(&shard.mu);
+    shard.node_map[node->uuid_] = node;
+  }
+  MutexLock lock(&listed_mu_);
+  auto* index = ListedIndex(node->type());
+  if (index != nullptr) (*index)[node->uuid_] = node;
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
-  GPR_ASSERT(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  GPR_ASSERT(uuid <= uuid_generator_.load(std::memory_order_relaxed));
+  BaseNode* node = nullptr;
+  {
+    Shard& shard = ShardFor(uuid);
+    MutexLock lock(&shard.mu);
+    auto it = shard.node_map.find(uuid);
+    if (it == shard.node_map.end()) return;
+    node = it->second;
+    shard.node_map.erase(it);
+  }
+  // The node is being destroyed, but its type is still there.
+  MutexLock lock(&listed_mu_);
+  auto* index = ListedIndex(node->type());
+  if (index != nullptr) index->erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  Shard& shard = ShardFor(uuid);
+  MutexLock lock(&shard.mu);
+  auto it = shard.node_map.find(uuid);
+  if (it == shard.node_map.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
   return node->RefIfNonZero();
 }
 
-std::string ChannelzRegistry::InternalGetTopChannels(
-    intptr_t start_channel_id) {
-  std::vector<RefCountedPtr<BaseNode>> top_level_channels;
+std::string ChannelzRegistry::RenderPage(BaseNode::EntityType type,
+                                         intptr_t start_id,
+                                         const char* field_name) {
+  std::vector<RefCountedPtr<BaseNode>> nodes;
   RefCountedPtr<BaseNode> node_after_pagination_limit;
   {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        top_level_channels.emplace_back(std::move(node_ref));
+    MutexLock lock(&listed_mu_);
+    const auto* index = ListedIndex(type);
+    for (auto it = index->lower_bound(start_id); it != index->end(); ++it) {
+      RefCountedPtr<BaseNode> node_ref = it->second->RefIfNonZero();
+      if (node_ref == nullptr) continue;
+      // Check if we are over pagination limit to determine if we need to set
+      // the "end" element. If we don't go through this block, we know that
+      // when the loop terminates, we have <= to kPaginationLimit.
+      // Note that because we have already increased this node's
+      // refcount, we need to decrease it, but we can't unref while
+      // holding the lock, because this may lead to a deadlock.
+      if (nodes.size() == kPaginationLimit) {
+        node_after_pagination_limit = std::move(node_ref);
+        break;
       }
+      nodes.emplace_back(std::move(node_ref));
     }
   }
   Json::Object object;
-  if (!top_level_channels.empty()) {
-    // Create list of channels.
+  if (!nodes.empty()) {
     Json::Array array;
-    for (size_t i = 0; i < top_level_channels.size(); ++i) {
-      array.emplace_back(top_level_channels[i]->RenderJson());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      array.emplace_back(nodes[i]->RenderJson());
     }
-    object["channel"] = std::move(array);
+    object[field_name] = std::move(array);
   }
   if (node_after_pagination_limit == nullptr) object["end"] = true;
   Json json(std::move(object));
   return json.Dump();
 }
 
+std::string ChannelzRegistry::InternalGetTopChannels(
+    intptr_t start_channel_id) {
+  return RenderPage(BaseNode::EntityType::kTopLevelChannel, start_channel_id,
+                    "channel");
+}
+
 std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
-  std::vector<RefCountedPtr<BaseNode>> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        servers.emplace_back(std::move(node_ref));
-      }
-    }
-  }
-  Json::Object object;
-  if (!servers.empty()) {
-    // Create list of servers.
-    Json::Array array;
-    for (size_t i = 0; i < servers.size(); ++i) {
-      array.emplace_back(servers[i]->RenderJson());
-    }
-    object["server"] = std::move(array);
-  }
-  if (node_after_pagination_limit == nullptr) object["end"] = true;
-  Json json(std::move(object));
-  return json.Dump();
+  return RenderPage(BaseNode::EntityType::kServer, start_server_id, "server");
 }
 
 void ChannelzRegistry::InternalLogAllEntities() {
   std::vector<RefCountedPtr<BaseNode>> nodes;
   {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
-      RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
-      if (node != nullptr) {
-        nodes.emplace_back(std::move(node));
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      for (auto& p : shard.node_map) {
+        RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
+        if (node != nullptr) {
+          nodes.emplace_back(std::move(node));
+        }
       }
     }
   }
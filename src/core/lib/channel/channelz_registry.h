@@ -21,10 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
 
+#include "absl/base/thread_annotations.h"
+
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -34,6 +39,11 @@ namespace channelz {
 
 // singleton registry object to track all objects that are needed to support
 // channelz bookkeeping. All objects share globally distributed uuids.
+//
+// Nodes are sharded by uuid, so that the creation and destruction of
+// sockets on different connections rarely contend on the same lock. Top
+// level channels and servers, which channelz lists, are also indexed on their
+// own: paginating through them does not walk the sockets and subchannels.
 class ChannelzRegistry {
  public:
   static void Register(BaseNode* node) {
@@ -63,9 +73,16 @@ class ChannelzRegistry {
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (Shard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    {
+      MutexLock lock(&p->listed_mu_);
+      p->top_level_channels_.clear();
+      p->servers_.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
@@ -88,10 +105,35 @@ class ChannelzRegistry {
 
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // protects node_map
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+    // Keeps the locks of neighbouring shards out of each other's cache line.
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  Shard& ShardFor(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  // The index of the listed entity type, or nullptr.
+  std::map<intptr_t, BaseNode*>* ListedIndex(BaseNode::EntityType type)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(listed_mu_);
+
+  // Renders a page of the listed nodes of type from start_id on, as the
+  // repeated field_name of a response.
+  std::string RenderPage(BaseNode::EntityType type, intptr_t start_id,
+                         const char* field_name);
+
+  std::atomic<intptr_t> uuid_generator_{0};
+  Shard shards_[kNumShards];
+  // protects top_level_channels_ and servers_. Never held with the lock of
+  // a shard.
+  Mutex listed_mu_;
+  std::map<intptr_t, BaseNode*> top_level_channels_
+      ABSL_GUARDED_BY(listed_mu_);
+  std::map<intptr_t, BaseNode*> servers_ ABSL_GUARDED_BY(listed_mu_);
 };
 
 }  // namespace channelz
@@ -28,6 +28,7 @@
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
@@ -59,8 +60,16 @@ typedef struct connected_channel_call_data {
 
 static void run_in_call_combiner(void* arg, grpc_error_handle error) {
   callback_state* state = static_cast<callback_state*>(arg);
-  GRPC_CALL_COMBINER_START(state->call_combiner, state->original_closure, error,
-                           state->reason);
+  // Transports schedule these callbacks on the ExecCtx: this already runs
+  // from there, so a free call combiner can run the original closure now.
+  if (grpc_core::IsConnectedChannelInlineCallbacksEnabled()) {
+    GRPC_CALL_COMBINER_START_INLINE(state->call_combiner,
+                                    state->original_closure, error,
+                                    state->reason);
+  } else {
+    GRPC_CALL_COMBINER_START(state->call_combiner, state->original_closure,
+                             error, state->reason);
+  }
 }
 
 static void run_cancel_in_call_combiner(void* arg, grpc_error_handle error) {
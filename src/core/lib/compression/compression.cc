@@ -21,13 +21,17 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <string>
+
 #include "absl/types/optional.h"
 
 #include <grpc/compression.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -65,6 +69,11 @@ int grpc_compression_algorithm_name(grpc_compression_algorithm algorithm,
   return 0;
 }
 
+int grpc_compression_algorithm_is_supported(
+    grpc_compression_algorithm algorithm) {
+  return grpc_core::MessageCompressionAlgorithmIsSupported(algorithm);
+}
+
 grpc_compression_algorithm grpc_compression_algorithm_for_level(
     grpc_compression_level level, uint32_t accepted_encodings) {
   return grpc_core::CompressionAlgorithmSet::FromUint32(accepted_encodings)
@@ -94,3 +103,21 @@ int grpc_compression_options_is_algorithm_enabled(
              opts->enabled_algorithms_bitset)
       .IsSet(algorithm);
 }
+
+grpc_compression_dictionary* grpc_compression_dictionary_create(
+    const char* data, size_t length) {
+  GRPC_API_TRACE("grpc_compression_dictionary_create(data=%p, length=%zu)", 2,
+                 (data, length));
+  return (new grpc_core::CompressionDictionary(std::string(data, length)))
+      ->c_ptr();
+}
+
+void grpc_compression_dictionary_unref(
+    grpc_compression_dictionary* dictionary) {
+  grpc_core::CompressionDictionary::FromC(dictionary)->Unref();
+}
+
+const grpc_arg_pointer_vtable* grpc_compression_dictionary_arg_vtable() {
+  return grpc_core::ChannelArgTypeTraits<
+      grpc_core::CompressionDictionary>::VTable();
+}
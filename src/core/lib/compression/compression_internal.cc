@@ -30,6 +30,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/surface/api_trace.h"
 
@@ -43,6 +44,10 @@ const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm) {
       return "deflate";
     case GRPC_COMPRESS_GZIP:
       return "gzip";
+    case GRPC_COMPRESS_ZSTD:
+      return "zstd";
+    case GRPC_COMPRESS_LZ4:
+      return "lz4";
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
     default:
       return nullptr;
@@ -83,7 +88,7 @@ class CommaSeparatedLists {
  private:
   static constexpr size_t kNumLists = 1 << GRPC_COMPRESS_ALGORITHMS_COUNT;
   // Experimentally determined (tweak things until it runs).
-  static constexpr size_t kTextBufferSize = 86;
+  static constexpr size_t kTextBufferSize = 514;
   absl::string_view lists_[kNumLists];
   char text_buffer_[kTextBufferSize];
 };
@@ -99,6 +104,10 @@ absl::optional<grpc_compression_algorithm> ParseCompressionAlgorithm(
     return GRPC_COMPRESS_DEFLATE;
   } else if (algorithm == "gzip") {
     return GRPC_COMPRESS_GZIP;
+  } else if (algorithm == "zstd") {
+    return GRPC_COMPRESS_ZSTD;
+  } else if (algorithm == "lz4") {
+    return GRPC_COMPRESS_LZ4;
   } else {
     return absl::nullopt;
   }
@@ -124,12 +133,14 @@ CompressionAlgorithmSet::CompressionAlgorithmForLevel(
   /* Establish a "ranking" or compression algorithms in increasing order of
    * compression.
    * This is simplistic and we will probably want to introduce other dimensions
-   * in the future (cpu/memory cost, etc). */
+   * in the future (cpu/memory cost, etc). Algorithms this build can't compress
+   * with are skipped even if the peer accepts them. */
   absl::InlinedVector<grpc_compression_algorithm,
                       GRPC_COMPRESS_ALGORITHMS_COUNT>
       algos;
-  for (auto algo : {GRPC_COMPRESS_GZIP, GRPC_COMPRESS_DEFLATE}) {
-    if (set_.is_set(algo)) {
+  for (auto algo : {GRPC_COMPRESS_LZ4, GRPC_COMPRESS_GZIP,
+                    GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_ZSTD}) {
+    if (set_.is_set(algo) && MessageCompressionAlgorithmIsSupported(algo)) {
       algos.push_back(algo);
     }
   }
@@ -175,6 +186,14 @@ CompressionAlgorithmSet CompressionAlgorithmSet::FromChannelArgs(
   } else {
     set = CompressionAlgorithmSet::FromUint32(kEverything);
   }
+  // Never advertise an algorithm that received messages can't be decompressed
+  // with.
+  for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if (!MessageCompressionAlgorithmIsSupported(
+            static_cast<grpc_compression_algorithm>(i))) {
+      set.set_.clear(i);
+    }
+  }
   return set;
 }
 
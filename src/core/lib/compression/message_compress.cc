@@ -22,15 +22,548 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <utility>
+
 #include <zconf.h>
 #include <zlib.h>
 
+#ifdef GRPC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef GRPC_HAVE_LZ4
+#define LZ4F_STATIC_LINKING_ONLY
+#include <lz4frame.h>
+#endif
+
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #define OUTPUT_BLOCK_SIZE 1024
 
+namespace grpc_core {
+
+struct CompressionDictionary::Digested {
+#ifdef GRPC_HAVE_ZSTD
+  // Indexed by grpc_compression_level - 1.
+  ZSTD_CDict* zstd_cdicts[GRPC_COMPRESS_LEVEL_COUNT - 1] = {};
+  ZSTD_DDict* zstd_ddict = nullptr;
+#endif
+#ifdef GRPC_HAVE_LZ4
+  LZ4F_CDict* lz4_cdict = nullptr;
+#endif
+};
+
+namespace {
+
+#ifdef GRPC_HAVE_ZSTD
+int ZstdLevel(grpc_compression_level level) {
+  switch (level) {
+    case GRPC_COMPRESS_LEVEL_NONE:
+    case GRPC_COMPRESS_LEVEL_LOW:
+      return 1;
+    case GRPC_COMPRESS_LEVEL_MED:
+    case GRPC_COMPRESS_LEVEL_COUNT:
+      break;
+    case GRPC_COMPRESS_LEVEL_HIGH:
+      return 9;
+  }
+  return ZSTD_CLEVEL_DEFAULT;
+}
+
+// The index of the CDict of \a level in CompressionDictionary::Digested.
+size_t ZstdDictIndex(grpc_compression_level level) {
+  return level <= GRPC_COMPRESS_LEVEL_LOW ? 0
+         : level >= GRPC_COMPRESS_LEVEL_HIGH
+             ? GRPC_COMPRESS_LEVEL_HIGH - 1
+             : GRPC_COMPRESS_LEVEL_MED - 1;
+}
+#endif
+
+}  // namespace
+
+CompressionDictionary::CompressionDictionary(std::string data)
+    : data_(std::move(data)), digested_(new Digested) {
+#ifdef GRPC_HAVE_ZSTD
+  for (int level = GRPC_COMPRESS_LEVEL_LOW; level <= GRPC_COMPRESS_LEVEL_HIGH;
+       level++) {
+    digested_->zstd_cdicts[level - 1] = ZSTD_createCDict(
+        data_.data(), data_.size(),
+        ZstdLevel(static_cast<grpc_compression_level>(level)));
+  }
+  digested_->zstd_ddict = ZSTD_createDDict(data_.data(), data_.size());
+#endif
+#ifdef GRPC_HAVE_LZ4
+  digested_->lz4_cdict = LZ4F_createCDict(data_.data(), data_.size());
+#endif
+}
+
+CompressionDictionary::~CompressionDictionary() {
+#ifdef GRPC_HAVE_ZSTD
+  for (ZSTD_CDict* cdict : digested_->zstd_cdicts) ZSTD_freeCDict(cdict);
+  ZSTD_freeDDict(digested_->zstd_ddict);
+#endif
+#ifdef GRPC_HAVE_LZ4
+  LZ4F_freeCDict(digested_->lz4_cdict);
+#endif
+}
+
+bool MessageCompressionAlgorithmIsSupported(
+    grpc_compression_algorithm algorithm) {
+  switch (algorithm) {
+    case GRPC_COMPRESS_NONE:
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      return true;
+    case GRPC_COMPRESS_ZSTD:
+#ifdef GRPC_HAVE_ZSTD
+      return true;
+#else
+      return false;
+#endif
+    case GRPC_COMPRESS_LZ4:
+#ifdef GRPC_HAVE_LZ4
+      return true;
+#else
+      return false;
+#endif
+    case GRPC_COMPRESS_ALGORITHMS_COUNT:
+      break;
+  }
+  return false;
+}
+
+}  // namespace grpc_core
+
+static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
+                        unsigned int size) {
+  return gpr_malloc(items * size);
+}
+
+static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
+
+namespace {
+
+// Setting up a codec context costs about as much as compressing a small
+// message, and a streaming call may send millions of them. So each thread
+// keeps one context of each kind, made the first time it is needed, and
+// resets it for every message instead.
+class CodecContexts {
+ public:
+  static CodecContexts& Get() {
+    static thread_local CodecContexts contexts;
+    return contexts;
+  }
+
+  ~CodecContexts() {
+    for (z_stream* zs : deflate_) {
+      if (zs != nullptr) deflateEnd(zs);
+      delete zs;
+    }
+    for (z_stream* zs : inflate_) {
+      if (zs != nullptr) inflateEnd(zs);
+      delete zs;
+    }
+#ifdef GRPC_HAVE_ZSTD
+    ZSTD_freeCCtx(zstd_cctx_);
+    ZSTD_freeDCtx(zstd_dctx_);
+#endif
+#ifdef GRPC_HAVE_LZ4
+    if (lz4_cctx_ != nullptr) LZ4F_freeCompressionContext(lz4_cctx_);
+    if (lz4_dctx_ != nullptr) LZ4F_freeDecompressionContext(lz4_dctx_);
+#endif
+  }
+
+  z_stream* Deflate(bool gzip) {
+    z_stream*& zs = deflate_[gzip];
+    int r;
+    if (zs == nullptr) {
+      zs = NewZStream();
+      r = deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                       15 | (gzip ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
+    } else {
+      r = deflateReset(zs);
+    }
+    GPR_ASSERT(r == Z_OK);
+    return zs;
+  }
+
+  z_stream* Inflate(bool gzip) {
+    z_stream*& zs = inflate_[gzip];
+    int r;
+    if (zs == nullptr) {
+      zs = NewZStream();
+      r = inflateInit2(zs, 15 | (gzip ? 16 : 0));
+    } else {
+      r = inflateReset(zs);
+    }
+    GPR_ASSERT(r == Z_OK);
+    return zs;
+  }
+
+#ifdef GRPC_HAVE_ZSTD
+  // Also drops the parameters and dictionary of the previous message.
+  ZSTD_CCtx* ZstdCompress() {
+    if (zstd_cctx_ == nullptr) {
+      zstd_cctx_ = ZSTD_createCCtx();
+      GPR_ASSERT(zstd_cctx_ != nullptr);
+    } else {
+      ZSTD_CCtx_reset(zstd_cctx_, ZSTD_reset_session_and_parameters);
+    }
+    return zstd_cctx_;
+  }
+
+  ZSTD_DCtx* ZstdDecompress() {
+    if (zstd_dctx_ == nullptr) {
+      zstd_dctx_ = ZSTD_createDCtx();
+      GPR_ASSERT(zstd_dctx_ != nullptr);
+    } else {
+      ZSTD_DCtx_reset(zstd_dctx_, ZSTD_reset_session_and_parameters);
+    }
+    return zstd_dctx_;
+  }
+#endif
+
+#ifdef GRPC_HAVE_LZ4
+  // Needs no reset: every frame starts with LZ4F_compressBegin().
+  LZ4F_cctx* Lz4Compress() {
+    if (lz4_cctx_ == nullptr) {
+      GPR_ASSERT(!LZ4F_isError(
+          LZ4F_createCompressionContext(&lz4_cctx_, LZ4F_VERSION)));
+    }
+    return lz4_cctx_;
+  }
+
+  LZ4F_dctx* Lz4Decompress() {
+    if (lz4_dctx_ == nullptr) {
+      GPR_ASSERT(!LZ4F_isError(
+          LZ4F_createDecompressionContext(&lz4_dctx_, LZ4F_VERSION)));
+    } else {
+      // The previous message may have left a frame half decoded.
+      LZ4F_resetDecompressionContext(lz4_dctx_);
+    }
+    return lz4_dctx_;
+  }
+#endif
+
+ private:
+  static z_stream* NewZStream() {
+    z_stream* zs = new z_stream();
+    zs->zalloc = zalloc_gpr;
+    zs->zfree = zfree_gpr;
+    return zs;
+  }
+
+  // Indexed by whether the stream has a gzip wrapper.
+  z_stream* deflate_[2] = {};
+  z_stream* inflate_[2] = {};
+#ifdef GRPC_HAVE_ZSTD
+  ZSTD_CCtx* zstd_cctx_ = nullptr;
+  ZSTD_DCtx* zstd_dctx_ = nullptr;
+#endif
+#ifdef GRPC_HAVE_LZ4
+  LZ4F_cctx* lz4_cctx_ = nullptr;
+  LZ4F_dctx* lz4_dctx_ = nullptr;
+#endif
+};
+
+}  // namespace
+
+#if defined(GRPC_HAVE_ZSTD) || defined(GRPC_HAVE_LZ4)
+namespace {
+
+// Drops the slices appended to \a output since it had \a count slices and
+// \a length bytes.
+void truncate_output(grpc_slice_buffer* output, size_t count, size_t length) {
+  for (size_t i = count; i < output->count; i++) {
+    grpc_slice_unref(output->slices[i]);
+  }
+  output->count = count;
+  output->length = length;
+}
+
+// A growing sequence of output slices that codecs write into directly.
+class OutputBlocks {
+ public:
+  OutputBlocks(grpc_slice_buffer* output, size_t block_size)
+      : output_(output),
+        count_before_(output->count),
+        length_before_(output->length),
+        block_size_(block_size),
+        block_(GRPC_SLICE_MALLOC(block_size)) {}
+  ~OutputBlocks() {
+    if (block_.refcount != nullptr) grpc_slice_unref(block_);
+  }
+
+  uint8_t* data() { return GRPC_SLICE_START_PTR(block_) + used_; }
+  size_t available() const { return GRPC_SLICE_LENGTH(block_) - used_; }
+  void Commit(size_t n) { used_ += n; }
+
+  // Makes sure at least \a n bytes are available, moving to a new block of at
+  // least \a n bytes if the current one is too full.
+  void Reserve(size_t n) {
+    if (available() >= n) return;
+    Flush();
+    block_ = GRPC_SLICE_MALLOC(std::max(n, block_size_));
+  }
+
+  // Bytes produced so far.
+  size_t length() const { return output_->length - length_before_ + used_; }
+
+  // Appends what was written to the output.
+  void Finish() { Flush(); }
+  // Drops everything written.
+  void Abandon() { truncate_output(output_, count_before_, length_before_); }
+
+ private:
+  void Flush() {
+    if (used_ > 0) {
+      block_.data.refcounted.length = used_;
+      grpc_slice_buffer_add_indexed(output_, block_);
+    } else {
+      grpc_slice_unref(block_);
+    }
+    block_ = grpc_empty_slice();
+    used_ = 0;
+  }
+
+  grpc_slice_buffer* const output_;
+  const size_t count_before_;
+  const size_t length_before_;
+  const size_t block_size_;
+  grpc_slice block_;
+  size_t used_ = 0;
+};
+
+// Output block size for zstd and lz4: small messages get a single slice
+// barely larger than they are, large ones are not held in one huge slice.
+constexpr size_t kMaxOutputBlockSize = 16384;
+
+size_t output_block_size(const grpc_slice_buffer* input) {
+  return std::max<size_t>(OUTPUT_BLOCK_SIZE,
+                          std::min(input->length, kMaxOutputBlockSize));
+}
+
+#ifdef GRPC_HAVE_ZSTD
+int zstd_compress(const grpc_core::MessageCompressionOptions& options,
+                  grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  ZSTD_CCtx* cctx = CodecContexts::Get().ZstdCompress();
+  if (options.dictionary != nullptr) {
+    ZSTD_CCtx_refCDict(
+        cctx, options.dictionary->digested()
+                  ->zstd_cdicts[grpc_core::ZstdDictIndex(options.level)]);
+    // The dictionary may be raw content without an ID, so the checksum is
+    // what catches a peer with a different one.
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+  } else {
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel,
+                           grpc_core::ZstdLevel(options.level));
+  }
+  ZSTD_CCtx_setPledgedSrcSize(cctx, input->length);
+  OutputBlocks out(output, output_block_size(input));
+  int r = 1;
+  size_t i = 0;
+  do {
+    bool last = i + 1 >= input->count;
+    ZSTD_inBuffer in = {nullptr, 0, 0};
+    if (i < input->count) {
+      in.src = GRPC_SLICE_START_PTR(input->slices[i]);
+      in.size = GRPC_SLICE_LENGTH(input->slices[i]);
+    }
+    size_t remaining;
+    do {
+      out.Reserve(1);
+      ZSTD_outBuffer buf = {out.data(), out.available(), 0};
+      remaining = ZSTD_compressStream2(cctx, &buf, &in,
+                                       last ? ZSTD_e_end : ZSTD_e_continue);
+      out.Commit(buf.pos);
+      if (ZSTD_isError(remaining)) {
+        gpr_log(GPR_INFO, "zstd error: %s", ZSTD_getErrorName(remaining));
+        r = 0;
+        break;
+      }
+      // Compression that doesn't shrink the message isn't worth it.
+      if (out.length() >= input->length) {
+        r = 0;
+        break;
+      }
+    } while (in.pos < in.size || (last && remaining != 0));
+  } while (r && ++i < input->count);
+  if (r) {
+    out.Finish();
+  } else {
+    out.Abandon();
+  }
+  return r;
+}
+
+int zstd_decompress(const grpc_core::MessageCompressionOptions& options,
+                    grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  ZSTD_DCtx* dctx = CodecContexts::Get().ZstdDecompress();
+  if (options.dictionary != nullptr) {
+    ZSTD_DCtx_refDDict(dctx, options.dictionary->digested()->zstd_ddict);
+  }
+  OutputBlocks out(output, output_block_size(input));
+  size_t remaining = 1;  // Non-zero until a whole frame is decoded.
+  int r = 1;
+  for (size_t i = 0; r && i < input->count; i++) {
+    ZSTD_inBuffer in = {GRPC_SLICE_START_PTR(input->slices[i]),
+                        GRPC_SLICE_LENGTH(input->slices[i]), 0};
+    bool output_full;
+    do {
+      out.Reserve(1);
+      ZSTD_outBuffer buf = {out.data(), out.available(), 0};
+      remaining = ZSTD_decompressStream(dctx, &buf, &in);
+      out.Commit(buf.pos);
+      output_full = buf.pos == buf.size;
+      if (ZSTD_isError(remaining)) {
+        gpr_log(GPR_INFO, "zstd error: %s", ZSTD_getErrorName(remaining));
+        r = 0;
+      }
+    } while (r && (in.pos < in.size || (output_full && remaining != 0)));
+  }
+  if (r && remaining != 0) {
+    gpr_log(GPR_INFO, "zstd: truncated frame");
+    r = 0;
+  }
+  if (r) {
+    out.Finish();
+  } else {
+    out.Abandon();
+  }
+  return r;
+}
+#endif  // GRPC_HAVE_ZSTD
+
+#ifdef GRPC_HAVE_LZ4
+// lz4 is fed at most this much input at a time, which bounds the output
+// space each step needs.
+constexpr size_t kLz4InputChunkSize = 16384;
+
+int lz4_compress(const grpc_core::MessageCompressionOptions& options,
+                 grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  LZ4F_cctx* cctx = CodecContexts::Get().Lz4Compress();
+  LZ4F_preferences_t prefs;
+  memset(&prefs, 0, sizeof(prefs));
+  prefs.frameInfo.contentSize = input->length;
+  if (options.dictionary != nullptr) {
+    // The dictionary may be raw content without an ID, so the checksum is
+    // what catches a peer with a different one.
+    prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  }
+  const size_t step_bound = LZ4F_compressBound(kLz4InputChunkSize, &prefs);
+  OutputBlocks out(output, std::max(output_block_size(input),
+                                    step_bound + LZ4F_HEADER_SIZE_MAX));
+  int r = 1;
+  size_t n;
+  out.Reserve(LZ4F_HEADER_SIZE_MAX);
+  if (options.dictionary != nullptr) {
+    n = LZ4F_compressBegin_usingCDict(cctx, out.data(), out.available(),
+                                      options.dictionary->digested()->lz4_cdict,
+                                      &prefs);
+  } else {
+    n = LZ4F_compressBegin(cctx, out.data(), out.available(), &prefs);
+  }
+  if (LZ4F_isError(n)) {
+    gpr_log(GPR_INFO, "lz4 error: %s", LZ4F_getErrorName(n));
+    r = 0;
+  } else {
+    out.Commit(n);
+  }
+  for (size_t i = 0; r && i < input->count; i++) {
+    const uint8_t* src = GRPC_SLICE_START_PTR(input->slices[i]);
+    size_t src_size = GRPC_SLICE_LENGTH(input->slices[i]);
+    while (r && src_size > 0) {
+      size_t chunk = std::min(src_size, kLz4InputChunkSize);
+      out.Reserve(step_bound);
+      n = LZ4F_compressUpdate(cctx, out.data(), out.available(), src, chunk,
+                              nullptr);
+      if (LZ4F_isError(n)) {
+        gpr_log(GPR_INFO, "lz4 error: %s", LZ4F_getErrorName(n));
+        r = 0;
+      } else {
+        out.Commit(n);
+        src += chunk;
+        src_size -= chunk;
+      }
+    }
+  }
+  if (r) {
+    out.Reserve(LZ4F_compressBound(0, &prefs));
+    n = LZ4F_compressEnd(cctx, out.data(), out.available(), nullptr);
+    if (LZ4F_isError(n)) {
+      gpr_log(GPR_INFO, "lz4 error: %s", LZ4F_getErrorName(n));
+      r = 0;
+    } else {
+      out.Commit(n);
+    }
+  }
+  // Compression that doesn't shrink the message isn't worth it.
+  r = r && out.length() < input->length;
+  if (r) {
+    out.Finish();
+  } else {
+    out.Abandon();
+  }
+  return r;
+}
+
+int lz4_decompress(const grpc_core::MessageCompressionOptions& options,
+                   grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  LZ4F_dctx* dctx = CodecContexts::Get().Lz4Decompress();
+  const void* dict = nullptr;
+  size_t dict_size = 0;
+  if (options.dictionary != nullptr) {
+    dict = options.dictionary->data().data();
+    dict_size = options.dictionary->data().size();
+  }
+  OutputBlocks out(output, output_block_size(input));
+  size_t remaining = 1;  // Non-zero until a whole frame is decoded.
+  int r = 1;
+  for (size_t i = 0; r && i < input->count; i++) {
+    const uint8_t* src = GRPC_SLICE_START_PTR(input->slices[i]);
+    size_t src_left = GRPC_SLICE_LENGTH(input->slices[i]);
+    bool output_full;
+    do {
+      out.Reserve(1);
+      const size_t capacity = out.available();
+      size_t dst_size = capacity;
+      size_t src_size = src_left;
+      if (dict != nullptr) {
+        remaining = LZ4F_decompress_usingDict(dctx, out.data(), &dst_size, src,
+                                              &src_size, dict, dict_size,
+                                              nullptr);
+      } else {
+        remaining = LZ4F_decompress(dctx, out.data(), &dst_size, src,
+                                    &src_size, nullptr);
+      }
+      out.Commit(dst_size);
+      output_full = dst_size == capacity;
+      src += src_size;
+      src_left -= src_size;
+      if (LZ4F_isError(remaining)) {
+        gpr_log(GPR_INFO, "lz4 error: %s", LZ4F_getErrorName(remaining));
+        r = 0;
+      }
+    } while (r && (src_left > 0 || (output_full && remaining != 0)));
+  }
+  if (r && remaining != 0) {
+    gpr_log(GPR_INFO, "lz4: truncated frame");
+    r = 0;
+  }
+  if (r) {
+    out.Finish();
+  } else {
+    out.Abandon();
+  }
+  return r;
+}
+#endif  // GRPC_HAVE_LZ4
+
+}  // namespace
+#endif  // defined(GRPC_HAVE_ZSTD) || defined(GRPC_HAVE_LZ4)
+
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
                      int (*flate)(z_stream* zs, int flush)) {
@@ -84,27 +617,14 @@ error:
   return 0;
 }
 
-static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
-                        unsigned int size) {
-  return gpr_malloc(items * size);
-}
-
-static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
-
 static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
                          int gzip) {
-  z_stream zs;
+  z_stream* zs = CodecContexts::Get().Deflate(gzip);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
+  r = zlib_body(zs, input, output, deflate) && output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref(output->slices[i]);
@@ -112,23 +632,17 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  deflateEnd(&zs);
   return r;
 }
 
 static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
                            int gzip) {
-  z_stream zs;
+  z_stream* zs = CodecContexts::Get().Inflate(gzip);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  r = zlib_body(zs, input, output, inflate);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref(output->slices[i]);
@@ -136,7 +650,6 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
   return r;
 }
 
@@ -149,6 +662,7 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
 }
 
 static int compress_inner(grpc_compression_algorithm algorithm,
+                          const grpc_core::MessageCompressionOptions& options,
                           grpc_slice_buffer* input, grpc_slice_buffer* output) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
@@ -159,6 +673,18 @@ static int compress_inner(grpc_compression_algorithm algorithm,
       return zlib_compress(input, output, 0);
     case GRPC_COMPRESS_GZIP:
       return zlib_compress(input, output, 1);
+    case GRPC_COMPRESS_ZSTD:
+#ifdef GRPC_HAVE_ZSTD
+      return zstd_compress(options, input, output);
+#else
+      break;
+#endif
+    case GRPC_COMPRESS_LZ4:
+#ifdef GRPC_HAVE_LZ4
+      return lz4_compress(options, input, output);
+#else
+      break;
+#endif
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -168,7 +694,14 @@ static int compress_inner(grpc_compression_algorithm algorithm,
 
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+  return grpc_msg_compress(algorithm, grpc_core::MessageCompressionOptions(),
+                           input, output);
+}
+
+int grpc_msg_compress(grpc_compression_algorithm algorithm,
+                      const grpc_core::MessageCompressionOptions& options,
+                      grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  if (!compress_inner(algorithm, options, input, output)) {
     copy(input, output);
     return 0;
   }
@@ -177,6 +710,13 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  return grpc_msg_decompress(algorithm, grpc_core::MessageCompressionOptions(),
+                             input, output);
+}
+
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        const grpc_core::MessageCompressionOptions& options,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       return copy(input, output);
@@ -184,6 +724,18 @@ int grpc_msg_decompress(grpc_compression_algorithm algorithm,
       return zlib_decompress(input, output, 0);
     case GRPC_COMPRESS_GZIP:
       return zlib_decompress(input, output, 1);
+    case GRPC_COMPRESS_ZSTD:
+#ifdef GRPC_HAVE_ZSTD
+      return zstd_decompress(options, input, output);
+#else
+      break;
+#endif
+    case GRPC_COMPRESS_LZ4:
+#ifdef GRPC_HAVE_LZ4
+      return lz4_decompress(options, input, output);
+#else
+      break;
+#endif
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -21,19 +21,81 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/cpp_impl_of.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_core {
+
+// A dictionary shared by both peers that the zstd and lz4 algorithms prime
+// their compressors and decompressors with, so that small messages made of
+// the same vocabulary still compress well.
+class CompressionDictionary
+    : public RefCounted<CompressionDictionary>,
+      public CppImplOf<CompressionDictionary, grpc_compression_dictionary> {
+ public:
+  explicit CompressionDictionary(std::string data);
+  ~CompressionDictionary() override;
+
+  static absl::string_view ChannelArgName() {
+    return GRPC_COMPRESSION_CHANNEL_DICTIONARY;
+  }
+  static int ChannelArgsCompare(const CompressionDictionary* a,
+                                const CompressionDictionary* b) {
+    return QsortCompare(a, b);
+  }
+
+  absl::string_view data() const { return data_; }
+
+  // The dictionary digested by codec specific code, built once.
+  struct Digested;
+  const Digested* digested() const { return digested_.get(); }
+
+ private:
+  const std::string data_;
+  std::unique_ptr<Digested> digested_;
+};
+
+// How messages are compressed, beyond the negotiated algorithm.
+struct MessageCompressionOptions {
+  // How hard zstd works on each message. The other algorithms ignore it.
+  grpc_compression_level level = GRPC_COMPRESS_LEVEL_MED;
+  // May be null. Only used by zstd and lz4.
+  RefCountedPtr<CompressionDictionary> dictionary;
+};
+
+// Returns true if this build implements \a algorithm: zstd and lz4 need
+// GRPC_HAVE_ZSTD and GRPC_HAVE_LZ4.
+bool MessageCompressionAlgorithmIsSupported(
+    grpc_compression_algorithm algorithm);
+
+}  // namespace grpc_core
+
 /* compress 'input' to 'output' using 'algorithm'.
    On success, appends compressed slices to output and returns 1.
    On failure, appends uncompressed slices to output and returns 0. */
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output);
+int grpc_msg_compress(grpc_compression_algorithm algorithm,
+                      const grpc_core::MessageCompressionOptions& options,
+                      grpc_slice_buffer* input, grpc_slice_buffer* output);
 
 /* decompress 'input' to 'output' using 'algorithm'.
    On success, appends slices to output and returns 1.
    On failure, output is unchanged, and returns 0. */
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        const grpc_core::MessageCompressionOptions& options,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output);
 
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -0,0 +1,224 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/debug/event_trace.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+namespace {
+
+struct EventInfo {
+  const char* name;
+  const char* category;
+  // nullptr for events without an arg.
+  const char* arg_name;
+  bool instant;
+};
+
+const EventInfo kEventInfo[] = {
+    {"exec_ctx_flush", "exec_ctx", "closures", false},
+    {"combiner_hold", "combiner", nullptr, false},
+    {"combiner_offload", "combiner", nullptr, true},
+    {"tcp_read", "tcp", "bytes", false},
+    {"tcp_write", "tcp", "bytes", false},
+    {"timer_fire", "timer", "late_ms", true},
+};
+static_assert(
+    sizeof(kEventInfo) / sizeof(kEventInfo[0]) ==
+        static_cast<size_t>(EventTrace::Event::kCount),
+    "kEventInfo must name every event");
+
+// A slot of a ring. Its writer bumps seq to odd before writing the other
+// fields and to even after, so that a concurrent dump can tell a torn copy.
+struct Entry {
+  std::atomic<uint64_t> seq{0};
+  // Of the Start() the entry was recorded after.
+  std::atomic<uint64_t> generation{0};
+  std::atomic<gpr_cycle_counter> begin{0};
+  std::atomic<gpr_cycle_counter> end{0};
+  std::atomic<int64_t> arg{0};
+  std::atomic<uint8_t> event{0};
+};
+
+struct Ring {
+  explicit Ring(int tid) : tid(tid) {}
+  const int tid;
+  // Only used by the thread that owns the ring.
+  uint64_t next = 0;
+  Entry entries[EventTrace::kRingSize];
+};
+
+// All rings ever created: they are never freed, so a dump can read them
+// without a lock.
+struct Registry {
+  Mutex mu;
+  std::vector<Ring*> rings ABSL_GUARDED_BY(mu);
+  std::vector<Ring*> free_rings ABSL_GUARDED_BY(mu);
+};
+
+Registry* GetRegistry() {
+  static Registry* registry = new Registry();
+  return registry;
+}
+
+// Owns the ring of a thread, and returns it for reuse when the thread exits.
+class ThreadRing {
+ public:
+  ~ThreadRing() {
+    if (ring_ == nullptr) return;
+    Registry* registry = GetRegistry();
+    MutexLock lock(&registry->mu);
+    registry->free_rings.push_back(ring_);
+  }
+
+  Ring* Get() {
+    if (ring_ == nullptr) {
+      Registry* registry = GetRegistry();
+      MutexLock lock(&registry->mu);
+      if (registry->free_rings.empty()) {
+        ring_ = new Ring(static_cast<int>(registry->rings.size()));
+        registry->rings.push_back(ring_);
+      } else {
+        ring_ = registry->free_rings.back();
+        registry->free_rings.pop_back();
+      }
+    }
+    return ring_;
+  }
+
+ private:
+  Ring* ring_ = nullptr;
+};
+
+thread_local ThreadRing g_thread_ring;
+
+std::atomic<uint64_t> g_generation{0};
+std::atomic<gpr_cycle_counter> g_start{0};
+
+struct Copy {
+  int tid;
+  uint64_t seq;
+  EventTrace::Event event;
+  gpr_cycle_counter begin;
+  gpr_cycle_counter end;
+  int64_t arg;
+};
+
+// Microseconds from begin to end, with nanosecond digits.
+std::string Micros(gpr_cycle_counter begin, gpr_cycle_counter end) {
+  gpr_timespec ts = gpr_cycle_counter_sub(end, begin);
+  int64_t nanos = ts.tv_sec * GPR_NS_PER_SEC + ts.tv_nsec;
+  if (nanos < 0) nanos = 0;
+  return absl::StrCat(nanos / GPR_NS_PER_US, ".",
+                      absl::Dec(nanos % GPR_NS_PER_US, absl::kZeroPad3));
+}
+
+}  // namespace
+
+constexpr size_t EventTrace::kRingSize;
+
+std::atomic<bool> EventTrace::g_enabled_{false};
+
+void EventTrace::Start() {
+  g_start.store(gpr_get_cycle_counter(), std::memory_order_relaxed);
+  g_generation.fetch_add(1, std::memory_order_relaxed);
+  g_enabled_.store(true, std::memory_order_relaxed);
+}
+
+void EventTrace::Stop() { g_enabled_.store(false, std::memory_order_relaxed); }
+
+void EventTrace::Record(Event event, gpr_cycle_counter begin, int64_t arg) {
+  Ring* ring = g_thread_ring.Get();
+  const gpr_cycle_counter end = gpr_get_cycle_counter();
+  Entry& entry = ring->entries[ring->next % kRingSize];
+  const uint64_t seq = ++ring->next * 2;
+  entry.seq.store(seq - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  entry.generation.store(g_generation.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  entry.begin.store(begin == 0 ? end : begin, std::memory_order_relaxed);
+  entry.end.store(end, std::memory_order_relaxed);
+  entry.arg.store(arg, std::memory_order_relaxed);
+  entry.event.store(static_cast<uint8_t>(event), std::memory_order_relaxed);
+  entry.seq.store(seq, std::memory_order_release);
+}
+
+std::string EventTrace::DumpJson() {
+  std::vector<Ring*> rings;
+  {
+    Registry* registry = GetRegistry();
+    MutexLock lock(&registry->mu);
+    rings = registry->rings;
+  }
+  const uint64_t generation = g_generation.load(std::memory_order_relaxed);
+  const gpr_cycle_counter start = g_start.load(std::memory_order_relaxed);
+  std::vector<Copy> copies;
+  for (Ring* ring : rings) {
+    for (Entry& entry : ring->entries) {
+      const uint64_t seq = entry.seq.load(std::memory_order_acquire);
+      if (seq == 0 || seq % 2 != 0) continue;
+      const uint64_t entry_generation =
+          entry.generation.load(std::memory_order_relaxed);
+      Copy copy{ring->tid, seq,
+                static_cast<Event>(entry.event.load(std::memory_order_relaxed)),
+                entry.begin.load(std::memory_order_relaxed),
+                entry.end.load(std::memory_order_relaxed),
+                entry.arg.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (entry.seq.load(std::memory_order_relaxed) != seq) continue;
+      if (entry_generation != generation) continue;
+      copies.push_back(copy);
+    }
+  }
+  // The clock may not tell apart the events of a thread: seq does.
+  std::sort(copies.begin(), copies.end(), [](const Copy& a, const Copy& b) {
+    if (a.begin != b.begin) return a.begin < b.begin;
+    return a.tid != b.tid ? a.tid < b.tid : a.seq < b.seq;
+  });
+  std::vector<std::string> events;
+  events.reserve(copies.size());
+  for (const Copy& copy : copies) {
+    const EventInfo& info = kEventInfo[static_cast<size_t>(copy.event)];
+    std::string phase =
+        info.instant ? "\"ph\":\"i\",\"s\":\"t\""
+                     : absl::StrCat("\"ph\":\"X\",\"dur\":",
+                                    Micros(copy.begin, copy.end));
+    std::string args =
+        info.arg_name == nullptr
+            ? ""
+            : absl::StrCat(",\"args\":{\"", info.arg_name, "\":", copy.arg,
+                           "}");
+    events.push_back(absl::StrCat(
+        "{\"name\":\"", info.name, "\",\"cat\":\"", info.category, "\",",
+        phase, ",\"ts\":", Micros(start, copy.begin),
+        ",\"pid\":1,\"tid\":", copy.tid, args, "}"));
+  }
+  return absl::StrCat("{\"traceEvents\":[\n", absl::StrJoin(events, ",\n"),
+                      "\n]}\n");
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,108 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_DEBUG_EVENT_TRACE_H
+#define GRPC_CORE_LIB_DEBUG_EVENT_TRACE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "src/core/lib/gpr/time_precise.h"
+
+namespace grpc_core {
+
+// Traces hot-path events into per-thread ring buffers, to find out where a
+// microsecond-scale stall came from. Recording takes no lock: each thread
+// writes its own ring, and when tracing is stopped an event costs a relaxed
+// load. The last kRingSize events of each thread since Start() are dumped
+// as Chrome trace JSON, which chrome://tracing and Perfetto load.
+class EventTrace {
+ public:
+  // Which event was recorded. Names are in the .cc file.
+  enum class Event : uint8_t {
+    // An ExecCtx flush that ran closures; arg is how many.
+    kExecCtxFlush,
+    // A thread running the closures of a combiner.
+    kCombinerHold,
+    // A combiner handed off to the executor.
+    kCombinerOffload,
+    // A recvmsg() on a TCP socket; arg is its result.
+    kTcpRead,
+    // A sendmsg() on a TCP socket; arg is its result.
+    kTcpWrite,
+    // A timer popped from the timer list; arg is how late, in milliseconds.
+    kTimerFire,
+    kCount,
+  };
+
+  // Events recorded per thread before the oldest is overwritten.
+  static constexpr size_t kRingSize = 4096;
+
+  // Starts recording. Events recorded before are no longer dumped.
+  static void Start();
+  // Stops recording. Events recorded so far can still be dumped.
+  static void Stop();
+
+  static bool enabled() { return g_enabled_.load(std::memory_order_relaxed); }
+
+  // The begin time to pass to Complete(), or 0 when tracing is stopped.
+  static gpr_cycle_counter Now() {
+    return enabled() ? gpr_get_cycle_counter() : 0;
+  }
+
+  // Records an event that happened now.
+  static void Instant(Event event, int64_t arg = 0) {
+    if (enabled()) Record(event, 0, arg);
+  }
+  // Records an event that ran from begin, as returned by Now(), until now.
+  static void Complete(Event event, gpr_cycle_counter begin, int64_t arg = 0) {
+    if (begin != 0 && enabled()) Record(event, begin, arg);
+  }
+
+  // Records event over the lifetime of the scope.
+  class Scope {
+   public:
+    explicit Scope(Event event) : event_(event), begin_(Now()) {}
+    ~Scope() { Complete(event_, begin_, arg_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    void set_arg(int64_t arg) { arg_ = arg; }
+
+   private:
+    const Event event_;
+    const gpr_cycle_counter begin_;
+    int64_t arg_ = 0;
+  };
+
+  // The events recorded since the last Start(), in Chrome trace JSON. Can be
+  // called while threads record. Each tid is a ring: rings of exited threads
+  // are reused by new ones.
+  static std::string DumpJson();
+
+ private:
+  // begin is 0 for instant events.
+  static void Record(Event event, gpr_cycle_counter begin, int64_t arg);
+
+  static std::atomic<bool> g_enabled_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_DEBUG_EVENT_TRACE_H
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
@@ -32,6 +33,14 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_stats_collect_times, false,
+    "Record the stats histograms that time hot code paths, such as pollset "
+    "work and HPACK encoding.");
 
 namespace grpc_core {
 Stats* const g_stats_data = [] {
@@ -67,6 +76,20 @@ void grpc_stats_diff(const grpc_stats_data* b, const grpc_stats_data* a,
   }
 }
 
+bool grpc_stats_collect_times_enabled() {
+  static const bool enabled = GPR_GLOBAL_CONFIG_GET(grpc_stats_collect_times);
+  return enabled;
+}
+
+namespace grpc_core {
+int64_t StatsTimer::ElapsedNanos() const {
+  gpr_timespec elapsed =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start_);
+  return std::min<int64_t>(elapsed.tv_sec * GPR_NS_PER_SEC + elapsed.tv_nsec,
+                           std::numeric_limits<int>::max());
+}
+}  // namespace grpc_core
+
 void grpc_stats_inc_histogram_value(int histogram, int value) {
   const int bucket = grpc_stats_get_bucket[histogram](value);
   gpr_atm_no_barrier_fetch_add(
@@ -163,3 +186,36 @@ std::string grpc_stats_data_as_json(const grpc_stats_data* data) {
   }
   return absl::StrCat("{", absl::StrJoin(parts, ", "), "}");
 }
+
+std::string grpc_stats_data_as_prometheus(const grpc_stats_data* data) {
+  std::string out;
+  for (size_t i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
+    absl::StrAppendFormat(&out,
+                          "# HELP grpc_%s %s\n# TYPE grpc_%s counter\n"
+                          "grpc_%s %" PRIdPTR "\n",
+                          grpc_stats_counter_name[i], grpc_stats_counter_doc[i],
+                          grpc_stats_counter_name[i],
+                          grpc_stats_counter_name[i], data->counters[i]);
+  }
+  for (size_t i = 0; i < GRPC_STATS_HISTOGRAM_COUNT; i++) {
+    const char* name = grpc_stats_histogram_name[i];
+    absl::StrAppendFormat(&out, "# HELP grpc_%s %s\n# TYPE grpc_%s histogram\n",
+                          name, grpc_stats_histogram_doc[i], name);
+    const gpr_atm* buckets = data->histograms + grpc_stats_histo_start[i];
+    const int* boundaries = grpc_stats_histo_bucket_boundaries[i];
+    const int num_buckets = grpc_stats_histo_buckets[i];
+    // Values are integers: bucket j holds [boundaries[j], boundaries[j+1]),
+    // and the last bucket everything above.
+    int64_t count = 0;
+    for (int j = 0; j < num_buckets - 1; j++) {
+      count += buckets[j];
+      absl::StrAppendFormat(&out, "grpc_%s_bucket{le=\"%d\"} %d\n", name,
+                            boundaries[j + 1] - 1, count);
+    }
+    count += buckets[num_buckets - 1];
+    absl::StrAppendFormat(&out,
+                          "grpc_%s_bucket{le=\"+Inf\"} %d\ngrpc_%s_count %d\n",
+                          name, count, name, count);
+  }
+  return out;
+}
@@ -22,12 +22,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <string>
 
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/stats_data.h"  // IWYU pragma: export
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 typedef struct grpc_stats_data {
@@ -60,11 +62,38 @@ void grpc_stats_collect(grpc_stats_data* output);
 void grpc_stats_diff(const grpc_stats_data* b, const grpc_stats_data* a,
                      grpc_stats_data* c);
 std::string grpc_stats_data_as_json(const grpc_stats_data* data);
+// The Prometheus text exposition of data: counters as counters, histograms
+// as histograms with one bucket per stats bucket. The stats system does not
+// track sums, so histograms have no _sum.
+std::string grpc_stats_data_as_prometheus(const grpc_stats_data* data);
 double grpc_stats_histo_percentile(const grpc_stats_data* stats,
                                    grpc_stats_histograms histogram,
                                    double percentile);
 size_t grpc_stats_histo_count(const grpc_stats_data* stats,
                               grpc_stats_histograms histogram);
 void grpc_stats_inc_histogram_value(int histogram, int value);
+// Whether to record the histograms that time hot code paths, which read the
+// clock twice per value (the GRPC_STATS_COLLECT_TIMES environment variable).
+bool grpc_stats_collect_times_enabled();
+
+namespace grpc_core {
+// Measures how long a scope took, for a histogram recorded only when
+// grpc_stats_collect_times_enabled(): the clock is not read otherwise.
+class StatsTimer {
+ public:
+  StatsTimer() : enabled_(grpc_stats_collect_times_enabled()) {
+    if (enabled_) start_ = gpr_get_cycle_counter();
+  }
+
+  bool enabled() const { return enabled_; }
+  // Time since construction, capped to what a histogram value can hold.
+  int64_t ElapsedNanos() const;
+  int64_t ElapsedMicros() const { return ElapsedNanos() / GPR_NS_PER_US; }
+
+ private:
+  const bool enabled_;
+  gpr_cycle_counter start_{};
+};
+}  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_DEBUG_STATS_H
@@ -50,6 +50,9 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cq_pluck_creates",
     "cq_next_creates",
     "cq_callback_creates",
+    "tls_server_handshakes",
+    "tls_server_sessions_resumed",
+    "combiner_budget_offloads",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -75,11 +78,18 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "usage)",
     "Number of completion queues created for cq_callback (indicates callback "
     "api usage)",
+    "Number of TLS handshakes completed by servers",
+    "Number of TLS handshakes completed by servers that resumed a session",
+    "Number of times a combiner was handed to the executor after running past "
+    "its time budget",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
-    "call_initial_size",       "tcp_write_size", "tcp_write_iov_size",
-    "tcp_read_size",           "tcp_read_offer", "tcp_read_offer_iov_size",
-    "http2_send_message_size",
+    "call_initial_size",       "tcp_write_size",
+    "tcp_write_iov_size",      "tcp_read_size",
+    "tcp_read_offer",          "tcp_read_offer_iov_size",
+    "http2_send_message_size", "http2_header_encode_time_ns",
+    "pollset_work_time_us",    "combiner_hold_time_us",
+    "combiner_queue_length",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -89,6 +99,13 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of bytes offered to each syscall_read",
     "Number of byte segments offered to each syscall_read",
     "Size of messages received by HTTP2 transport",
+    "Nanoseconds spent HPACK encoding each metadata batch (with "
+    "GRPC_STATS_COLLECT_TIMES)",
+    "Microseconds each call to pollset_work took, polling and running closures "
+    "(with GRPC_STATS_COLLECT_TIMES)",
+    "Microseconds a thread ran a combiner for before releasing it or handing "
+    "it off",
+    "Number of closures queued on a combiner when a thread starts running it",
 };
 const int grpc_stats_table_0[25] = {
     0,   1,   2,   4,    7,    11,   17,   26,   40,   61,    93,    142,  216,
@@ -174,17 +191,24 @@ int BucketForHistogramValue_80_10(int value) {
   }
 }
 }  // namespace grpc_core
-const int grpc_stats_histo_buckets[7] = {24, 20, 10, 20, 20, 10, 20};
-const int grpc_stats_histo_start[7] = {0, 24, 44, 54, 74, 94, 104};
-const int* const grpc_stats_histo_bucket_boundaries[7] = {
+const int grpc_stats_histo_buckets[11] = {24, 20, 10, 20, 20, 10,
+                                          20, 20, 20, 24, 10};
+const int grpc_stats_histo_start[11] = {0,   24,  44,  54,  74, 94,
+                                        104, 124, 144, 164, 188};
+const int* const grpc_stats_histo_bucket_boundaries[11] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_2, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_2};
-int (*const grpc_stats_get_bucket[7])(int value) = {
+    grpc_stats_table_2, grpc_stats_table_2, grpc_stats_table_2,
+    grpc_stats_table_0, grpc_stats_table_4};
+int (*const grpc_stats_get_bucket[11])(int value) = {
     grpc_core::BucketForHistogramValue_32768_24,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_80_10,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_80_10,
-    grpc_core::BucketForHistogramValue_16777216_20};
+    grpc_core::BucketForHistogramValue_16777216_20,
+    grpc_core::BucketForHistogramValue_16777216_20,
+    grpc_core::BucketForHistogramValue_16777216_20,
+    grpc_core::BucketForHistogramValue_32768_24,
+    grpc_core::BucketForHistogramValue_80_10};
@@ -43,6 +43,9 @@ typedef enum {
   GRPC_STATS_COUNTER_CQ_PLUCK_CREATES,
   GRPC_STATS_COUNTER_CQ_NEXT_CREATES,
   GRPC_STATS_COUNTER_CQ_CALLBACK_CREATES,
+  GRPC_STATS_COUNTER_TLS_SERVER_HANDSHAKES,
+  GRPC_STATS_COUNTER_TLS_SERVER_SESSIONS_RESUMED,
+  GRPC_STATS_COUNTER_COMBINER_BUDGET_OFFLOADS,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -55,6 +58,10 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE,
+  GRPC_STATS_HISTOGRAM_HTTP2_HEADER_ENCODE_TIME_NS,
+  GRPC_STATS_HISTOGRAM_POLLSET_WORK_TIME_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -74,7 +81,15 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_BUCKETS = 10,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 104,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_BUCKETS = 20,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 124
+  GRPC_STATS_HISTOGRAM_HTTP2_HEADER_ENCODE_TIME_NS_FIRST_SLOT = 124,
+  GRPC_STATS_HISTOGRAM_HTTP2_HEADER_ENCODE_TIME_NS_BUCKETS = 20,
+  GRPC_STATS_HISTOGRAM_POLLSET_WORK_TIME_US_FIRST_SLOT = 144,
+  GRPC_STATS_HISTOGRAM_POLLSET_WORK_TIME_US_BUCKETS = 20,
+  GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US_FIRST_SLOT = 164,
+  GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US_BUCKETS = 24,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH_FIRST_SLOT = 188,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH_BUCKETS = 10,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 198
 } grpc_stats_histogram_constants;
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
@@ -110,6 +125,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_NEXT_CREATES)
 #define GRPC_STATS_INC_CQ_CALLBACK_CREATES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_CALLBACK_CREATES)
+#define GRPC_STATS_INC_TLS_SERVER_HANDSHAKES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TLS_SERVER_HANDSHAKES)
+#define GRPC_STATS_INC_TLS_SERVER_SESSIONS_RESUMED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TLS_SERVER_SESSIONS_RESUMED)
+#define GRPC_STATS_INC_COMBINER_BUDGET_OFFLOADS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_BUDGET_OFFLOADS)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   GRPC_STATS_INC_HISTOGRAM(                     \
       GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE,   \
@@ -138,14 +159,30 @@ typedef enum {
   GRPC_STATS_INC_HISTOGRAM(                           \
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE,   \
       grpc_core::BucketForHistogramValue_16777216_20(static_cast<int>(value)))
+#define GRPC_STATS_INC_HTTP2_HEADER_ENCODE_TIME_NS(value) \
+  GRPC_STATS_INC_HISTOGRAM(                               \
+      GRPC_STATS_HISTOGRAM_HTTP2_HEADER_ENCODE_TIME_NS,   \
+      grpc_core::BucketForHistogramValue_16777216_20(static_cast<int>(value)))
+#define GRPC_STATS_INC_POLLSET_WORK_TIME_US(value) \
+  GRPC_STATS_INC_HISTOGRAM(                        \
+      GRPC_STATS_HISTOGRAM_POLLSET_WORK_TIME_US,   \
+      grpc_core::BucketForHistogramValue_16777216_20(static_cast<int>(value)))
+#define GRPC_STATS_INC_COMBINER_HOLD_TIME_US(value) \
+  GRPC_STATS_INC_HISTOGRAM(                         \
+      GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US,   \
+      grpc_core::BucketForHistogramValue_32768_24(static_cast<int>(value)))
+#define GRPC_STATS_INC_COMBINER_QUEUE_LENGTH(value) \
+  GRPC_STATS_INC_HISTOGRAM(                         \
+      GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH,   \
+      grpc_core::BucketForHistogramValue_80_10(static_cast<int>(value)))
 namespace grpc_core {
 int BucketForHistogramValue_32768_24(int value);
 int BucketForHistogramValue_16777216_20(int value);
 int BucketForHistogramValue_80_10(int value);
 }  // namespace grpc_core
-extern const int grpc_stats_histo_buckets[7];
-extern const int grpc_stats_histo_start[7];
-extern const int* const grpc_stats_histo_bucket_boundaries[7];
-extern int (*const grpc_stats_get_bucket[7])(int value);
+extern const int grpc_stats_histo_buckets[11];
+extern const int grpc_stats_histo_start[11];
+extern const int* const grpc_stats_histo_bucket_boundaries[11];
+extern int (*const grpc_stats_get_bucket[11])(int value);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -22,14 +22,14 @@ namespace grpc_event_engine {
 namespace experimental {
 
 ThreadedExecutor::ThreadedExecutor(int reserve_threads)
-    : thread_pool_(reserve_threads){};
+    : thread_pool_(MakeThreadPool(reserve_threads)){};
 
 void ThreadedExecutor::Run(EventEngine::Closure* closure) {
-  thread_pool_.Add([closure]() { closure->Run(); });
+  thread_pool_->Add([closure]() { closure->Run(); });
 }
 
 void ThreadedExecutor::Run(absl::AnyInvocable<void()> closure) {
-  thread_pool_.Add(std::move(closure));
+  thread_pool_->Add(std::move(closure));
 }
 
 }  // namespace experimental
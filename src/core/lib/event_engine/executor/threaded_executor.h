@@ -17,6 +17,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+
 #include "absl/functional/any_invocable.h"
 
 #include <grpc/event_engine/event_engine.h>
@@ -35,7 +37,7 @@ class ThreadedExecutor : public Executor {
   void Run(absl::AnyInvocable<void()> closure) override;
 
  private:
-  ThreadPool thread_pool_;
+  const std::unique_ptr<ThreadPool> thread_pool_;
 };
 
 }  // namespace experimental
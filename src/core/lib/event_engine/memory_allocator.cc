@@ -25,6 +25,7 @@
 #include <grpc/event_engine/memory_request.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/slice/slab_pool.h"
 #include "src/core/lib/slice/slice_refcount_base.h"
 
 namespace grpc_event_engine {
@@ -36,11 +37,14 @@ namespace {
 // Takes care of releasing memory back when the slice is destroyed.
 class SliceRefCount : public grpc_slice_refcount {
  public:
+  // size_class is the slab pool size class of the storage, or -1 if it was
+  // malloced.
   SliceRefCount(std::shared_ptr<internal::MemoryAllocatorImpl> allocator,
-                size_t size)
+                size_t size, int size_class)
       : grpc_slice_refcount(Destroy),
         allocator_(std::move(allocator)),
-        size_(size) {
+        size_(size),
+        size_class_(size_class) {
     // Nothing to do here.
   }
   ~SliceRefCount() { allocator_->Release(size_); }
@@ -48,25 +52,44 @@ class SliceRefCount : public grpc_slice_refcount {
  private:
   static void Destroy(grpc_slice_refcount* p) {
     auto* rc = static_cast<SliceRefCount*>(p);
+    const int size_class = rc->size_class_;
     rc->~SliceRefCount();
-    free(rc);
+    if (size_class >= 0) {
+      grpc_core::SlabPool::Free(size_class, rc);
+    } else {
+      free(rc);
+    }
   }
 
   std::shared_ptr<internal::MemoryAllocatorImpl> allocator_;
   size_t size_;
+  int size_class_;
 };
 
+static_assert(sizeof(SliceRefCount) <= grpc_core::SlabPool::kHeaderSize,
+              "SliceRefCount must fit the header of slab pool blocks");
+
 }  // namespace
 
 grpc_slice MemoryAllocator::MakeSlice(MemoryRequest request) {
   auto size = Reserve(request.Increase(sizeof(SliceRefCount)));
-  void* p = malloc(size);
-  new (p) SliceRefCount(allocator_, size);
+  const size_t length = size - sizeof(SliceRefCount);
+  // The sizes transports read in are recycled rather than malloced.
+  const int size_class = grpc_core::SlabPool::SizeClass(length);
+  void* p;
+  size_t header_size;
+  if (size_class >= 0) {
+    p = grpc_core::SlabPool::Alloc(size_class);
+    header_size = grpc_core::SlabPool::kHeaderSize;
+  } else {
+    p = malloc(size);
+    header_size = sizeof(SliceRefCount);
+  }
+  new (p) SliceRefCount(allocator_, size, size_class);
   grpc_slice slice;
   slice.refcount = static_cast<SliceRefCount*>(p);
-  slice.data.refcounted.bytes =
-      static_cast<uint8_t*>(p) + sizeof(SliceRefCount);
-  slice.data.refcounted.length = size - sizeof(SliceRefCount);
+  slice.data.refcounted.bytes = static_cast<uint8_t*>(p) + header_size;
+  slice.data.refcounted.length = length;
   return slice;
 }
 
@@ -45,6 +45,7 @@
 #include "absl/synchronization/mutex.h"
 
 #include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/internal_errqueue.h"
 #include "src/core/lib/event_engine/posix_engine/lockfree_event.h"
 #include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
 #include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
@@ -91,7 +92,7 @@ class Epoll1EventHandle : public EventHandle {
     pending_write_.store(false, std::memory_order_relaxed);
     pending_error_.store(false, std::memory_order_relaxed);
   }
-  Epoll1Poller* Poller() { return poller_; }
+  Epoll1Poller* Poller() override { return poller_; }
   bool SetPendingActions(bool pending_read, bool pending_write,
                          bool pending_error) {
     // Another thread may be executing ExecutePendingActions() at this point
@@ -556,6 +557,8 @@ void Epoll1Poller::Kick() {
   GPR_ASSERT(wakeup_fd_->Wakeup().ok());
 }
 
+bool Epoll1Poller::CanTrackErrors() const { return KernelSupportsErrqueue(); }
+
 Epoll1Poller* GetEpoll1Poller(Scheduler* scheduler) {
   static bool kEpoll1PollerSupported = InitEpoll1PollerLinux();
   if (kEpoll1PollerSupported) {
@@ -606,6 +609,10 @@ Poller::WorkResult Epoll1Poller::Work(
 
 void Epoll1Poller::Kick() { GPR_ASSERT(false && "unimplemented"); }
 
+bool Epoll1Poller::CanTrackErrors() const {
+  GPR_ASSERT(false && "unimplemented");
+}
+
 // If GRPC_LINUX_EPOLL is not defined, it means epoll is not available. Return
 // nullptr.
 Epoll1Poller* GetEpoll1Poller(Scheduler* /*scheduler*/) { return nullptr; }
@@ -54,6 +54,7 @@ class Epoll1Poller : public PosixEventPoller {
       grpc_event_engine::experimental::EventEngine::Duration timeout,
       absl::FunctionRef<void()> schedule_poll_again) override;
   std::string Name() override { return "epoll1"; }
+  bool CanTrackErrors() const override;
   void Kick() override;
   Scheduler* GetScheduler() { return scheduler_; }
   void Shutdown() override;
@@ -0,0 +1,708 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/iomgr/port.h"
+
+// This polling engine is only relevant on linux kernels supporting io_uring
+// with multishot poll requests (5.13+).
+#ifdef GRPC_LINUX_IO_URING
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "absl/synchronization/mutex.h"
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/internal_errqueue.h"
+#include "src/core/lib/event_engine/posix_engine/lockfree_event.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix_default.h"
+#include "src/core/lib/gprpp/fork.h"
+
+// Kernel headers older than 5.13 do not know about multishot poll requests.
+// The flags are still defined here so that the poller builds on such systems;
+// ProbeMultishotPoll() rejects kernels that do not actually support them.
+#ifndef IORING_POLL_ADD_MULTI
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#define GRPC_IO_URING_NO_POLL32_EVENTS 1
+#endif
+#ifndef IORING_CQE_F_MORE
+#define IORING_CQE_F_MORE (1U << 1)
+#endif
+
+#define IO_URING_RING_ENTRIES 4096
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::Poller;
+
+namespace {
+
+// user_data values that do not correspond to an IoUringEventHandle. Handles
+// are at least word aligned and only use the least significant bit of their
+// address as a tag, so these values never collide with a handle.
+constexpr uint64_t kTimeoutUserData = 0;
+constexpr uint64_t kPollRemoveUserData = 2;
+
+constexpr uint32_t kPollMask = POLLIN | POLLOUT | POLLPRI | POLLERR | POLLHUP;
+
+int IoUringSetup(unsigned entries, struct io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int IoUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+}  // namespace
+
+class IoUringEventHandle : public EventHandle {
+ public:
+  IoUringEventHandle(int fd, bool track_err, IoUringPoller* poller)
+      : fd_(fd),
+        track_err_(track_err),
+        poller_(poller),
+        read_closure_(absl::make_unique<LockfreeEvent>(poller->GetScheduler())),
+        write_closure_(
+            absl::make_unique<LockfreeEvent>(poller->GetScheduler())),
+        error_closure_(
+            absl::make_unique<LockfreeEvent>(poller->GetScheduler())) {
+    read_closure_->InitEvent();
+    write_closure_->InitEvent();
+    error_closure_->InitEvent();
+    pending_read_.store(false, std::memory_order_relaxed);
+    pending_write_.store(false, std::memory_order_relaxed);
+    pending_error_.store(false, std::memory_order_relaxed);
+  }
+  void ReInit(int fd, bool track_err) {
+    fd_ = fd;
+    track_err_ = track_err;
+    orphaned_ = false;
+    poll_armed_ = false;
+    read_closure_->InitEvent();
+    write_closure_->InitEvent();
+    error_closure_->InitEvent();
+    pending_read_.store(false, std::memory_order_relaxed);
+    pending_write_.store(false, std::memory_order_relaxed);
+    pending_error_.store(false, std::memory_order_relaxed);
+  }
+  IoUringPoller* Poller() override { return poller_; }
+  // The user_data tag of the poll request associated with this handle. The
+  // least significant bit stores track_err, so that completions can be
+  // interpreted without touching the handle's fd.
+  uint64_t UserData() const {
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this)) |
+           (track_err_ ? 1 : 0);
+  }
+  bool SetPendingActions(bool pending_read, bool pending_write,
+                         bool pending_error) {
+    // See Epoll1EventHandle::SetPendingActions for why these are atomics:
+    // ExecutePendingActions() of a previous Work(...) invocation may run in
+    // parallel with the processing of completions in the next one.
+    if (pending_read) {
+      pending_read_.store(true, std::memory_order_release);
+    }
+    if (pending_write) {
+      pending_write_.store(true, std::memory_order_release);
+    }
+    if (pending_error) {
+      pending_error_.store(true, std::memory_order_release);
+    }
+    return pending_read || pending_write || pending_error;
+  }
+  int WrappedFd() override { return fd_; }
+  void OrphanHandle(PosixEngineClosure* on_done, int* release_fd,
+                    absl::string_view reason) override;
+  void ShutdownHandle(absl::Status why) override;
+  void NotifyOnRead(PosixEngineClosure* on_read) override;
+  void NotifyOnWrite(PosixEngineClosure* on_write) override;
+  void NotifyOnError(PosixEngineClosure* on_error) override;
+  void SetReadable() override;
+  void SetWritable() override;
+  void SetHasError() override;
+  bool IsHandleShutdown() override;
+  inline void ExecutePendingActions() {
+    if (pending_read_.exchange(false, std::memory_order_acq_rel)) {
+      read_closure_->SetReady();
+    }
+    if (pending_write_.exchange(false, std::memory_order_acq_rel)) {
+      write_closure_->SetReady();
+    }
+    if (pending_error_.exchange(false, std::memory_order_acq_rel)) {
+      error_closure_->SetReady();
+    }
+  }
+  ~IoUringEventHandle() override = default;
+
+ private:
+  friend class IoUringPoller;
+  void HandleShutdownInternal(absl::Status why, bool releasing_fd);
+  // See Epoll1EventHandle::ShutdownHandle for explanation on why a mutex is
+  // required.
+  absl::Mutex mu_;
+  int fd_;
+  bool track_err_;
+  // Both fields are guarded by the poller's mu_. orphaned_ is set once
+  // OrphanHandle has been called, poll_armed_ is true while the kernel holds
+  // an active poll request tagged with this handle.
+  bool orphaned_ = false;
+  bool poll_armed_ = false;
+  std::atomic<bool> pending_read_{false};
+  std::atomic<bool> pending_write_{false};
+  std::atomic<bool> pending_error_{false};
+  IoUringPoller* poller_;
+  std::unique_ptr<LockfreeEvent> read_closure_;
+  std::unique_ptr<LockfreeEvent> write_closure_;
+  std::unique_ptr<LockfreeEvent> error_closure_;
+};
+
+void IoUringEventHandle::OrphanHandle(PosixEngineClosure* on_done,
+                                      int* release_fd,
+                                      absl::string_view reason) {
+  bool is_release_fd = (release_fd != nullptr);
+  if (!read_closure_->IsShutdown()) {
+    HandleShutdownInternal(absl::Status(absl::StatusCode::kUnknown, reason),
+                           is_release_fd);
+  }
+
+  // If release_fd is not NULL, we should be relinquishing control of the file
+  // descriptor fd->fd (but we still own the grpc_fd structure).
+  if (is_release_fd) {
+    *release_fd = fd_;
+  } else {
+    close(fd_);
+  }
+
+  {
+    // See Epoll1Poller::ShutdownHandle for explanation on why a mutex is
+    // required here.
+    absl::MutexLock lock(&mu_);
+    read_closure_->DestroyEvent();
+    write_closure_->DestroyEvent();
+    error_closure_->DestroyEvent();
+  }
+  pending_read_.store(false, std::memory_order_release);
+  pending_write_.store(false, std::memory_order_release);
+  pending_error_.store(false, std::memory_order_release);
+  {
+    absl::MutexLock lock(&poller_->mu_);
+    orphaned_ = true;
+    if (poll_armed_) {
+      // The poll request holds a reference to the underlying file, so closing
+      // the fd is not enough to stop it. The handle can only be reused once
+      // the kernel posts the final completion for the request.
+      poller_->QueuePollRemove(UserData());
+      poller_->FlushSubmissions();
+      poller_->orphaned_io_uring_handles_list_.push_back(this);
+    } else {
+      poller_->free_io_uring_handles_list_.push_back(this);
+    }
+  }
+  if (on_done != nullptr) {
+    on_done->SetStatus(absl::OkStatus());
+    poller_->GetScheduler()->Run(on_done);
+  }
+}
+
+// if 'releasing_fd' is true, it means that we are going to detach the internal
+// fd from grpc_fd structure (i.e which means we should not be calling
+// shutdown() syscall on that fd)
+void IoUringEventHandle::HandleShutdownInternal(absl::Status why,
+                                                bool releasing_fd) {
+  if (read_closure_->SetShutdown(why)) {
+    if (!releasing_fd) {
+      shutdown(fd_, SHUT_RDWR);
+    }
+    write_closure_->SetShutdown(why);
+    error_closure_->SetShutdown(why);
+  }
+}
+
+// Might be called multiple times
+void IoUringEventHandle::ShutdownHandle(absl::Status why) {
+  absl::MutexLock lock(&mu_);
+  HandleShutdownInternal(why, false);
+}
+
+bool IoUringEventHandle::IsHandleShutdown() {
+  return read_closure_->IsShutdown();
+}
+
+void IoUringEventHandle::NotifyOnRead(PosixEngineClosure* on_read) {
+  read_closure_->NotifyOn(on_read);
+}
+
+void IoUringEventHandle::NotifyOnWrite(PosixEngineClosure* on_write) {
+  write_closure_->NotifyOn(on_write);
+}
+
+void IoUringEventHandle::NotifyOnError(PosixEngineClosure* on_error) {
+  error_closure_->NotifyOn(on_error);
+}
+
+void IoUringEventHandle::SetReadable() { read_closure_->SetReady(); }
+
+void IoUringEventHandle::SetWritable() { write_closure_->SetReady(); }
+
+void IoUringEventHandle::SetHasError() { error_closure_->SetReady(); }
+
+IoUringPoller::IoUringPoller(Scheduler* scheduler)
+    : scheduler_(scheduler), was_kicked_(false) {
+  wakeup_fd_ = *CreateWakeupFd();
+  GPR_ASSERT(wakeup_fd_ != nullptr);
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  int ring_fd = IoUringSetup(IO_URING_RING_ENTRIES, &p);
+  if (ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return;
+  }
+  ring_.ring_fd = ring_fd;
+  ring_.entries = p.sq_entries;
+  ring_.sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring_.cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    ring_.sq_ring_size = ring_.cq_ring_size =
+        std::max(ring_.sq_ring_size, ring_.cq_ring_size);
+  }
+  ring_.sq_ring = mmap(nullptr, ring_.sq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (ring_.sq_ring == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring sq ring mmap failed: %s", strerror(errno));
+    ring_.sq_ring = nullptr;
+    close(ring_fd);
+    ring_.ring_fd = -1;
+    return;
+  }
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    ring_.cq_ring = ring_.sq_ring;
+  } else {
+    ring_.cq_ring =
+        mmap(nullptr, ring_.cq_ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+  }
+  ring_.sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes =
+      mmap(nullptr, ring_.sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (ring_.cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring ring mmap failed: %s", strerror(errno));
+    if (sqes != MAP_FAILED) munmap(sqes, ring_.sqes_size);
+    if (ring_.cq_ring != MAP_FAILED && ring_.cq_ring != ring_.sq_ring) {
+      munmap(ring_.cq_ring, ring_.cq_ring_size);
+    }
+    munmap(ring_.sq_ring, ring_.sq_ring_size);
+    ring_.sq_ring = ring_.cq_ring = nullptr;
+    close(ring_fd);
+    ring_.ring_fd = -1;
+    return;
+  }
+  char* sq = static_cast<char*>(ring_.sq_ring);
+  ring_.sq.head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+  ring_.sq.tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+  ring_.sq.ring_mask = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+  ring_.sq.array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+  ring_.sq.sqes = static_cast<struct io_uring_sqe*>(sqes);
+  char* cq = static_cast<char*>(ring_.cq_ring);
+  ring_.cq.head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+  ring_.cq.tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+  ring_.cq.ring_mask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+  ring_.cq.cqes = reinterpret_cast<struct io_uring_cqe*>(cq + p.cq_off.cqes);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", ring_fd);
+  absl::MutexLock lock(&mu_);
+  QueuePollAdd(wakeup_fd_->ReadFd(),
+               reinterpret_cast<uintptr_t>(wakeup_fd_.get()));
+  FlushSubmissions();
+}
+
+void IoUringPoller::Shutdown() { delete this; }
+
+IoUringPoller::~IoUringPoller() {
+  if (ring_.ring_fd >= 0) {
+    munmap(ring_.sq.sqes, ring_.sqes_size);
+    if (ring_.cq_ring != ring_.sq_ring) {
+      munmap(ring_.cq_ring, ring_.cq_ring_size);
+    }
+    munmap(ring_.sq_ring, ring_.sq_ring_size);
+    // Closing the ring cancels all outstanding poll requests, so the
+    // orphaned handles can be safely deleted afterwards.
+    close(ring_.ring_fd);
+    ring_.ring_fd = -1;
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    while (!free_io_uring_handles_list_.empty()) {
+      IoUringEventHandle* handle = reinterpret_cast<IoUringEventHandle*>(
+          free_io_uring_handles_list_.front());
+      free_io_uring_handles_list_.pop_front();
+      delete handle;
+    }
+    while (!orphaned_io_uring_handles_list_.empty()) {
+      IoUringEventHandle* handle = reinterpret_cast<IoUringEventHandle*>(
+          orphaned_io_uring_handles_list_.front());
+      orphaned_io_uring_handles_list_.pop_front();
+      delete handle;
+    }
+  }
+}
+
+struct io_uring_sqe* IoUringPoller::GetSqe() {
+  unsigned tail = *ring_.sq.tail;
+  while (tail - __atomic_load_n(ring_.sq.head, __ATOMIC_ACQUIRE) >=
+         ring_.entries) {
+    // The submission ring is full. Hand the queued entries to the kernel to
+    // make room.
+    if (!Enter(ring_.entries, 0)) {
+      gpr_log(GPR_ERROR, "io_uring submission ring is stuck");
+      GPR_ASSERT(false);
+    }
+  }
+  unsigned index = tail & *ring_.sq.ring_mask;
+  struct io_uring_sqe* sqe = &ring_.sq.sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  ring_.sq.array[index] = index;
+  // Publish the entry. The kernel only reads it once the tail moves past it.
+  __atomic_store_n(ring_.sq.tail, tail + 1, __ATOMIC_RELEASE);
+  return sqe;
+}
+
+void IoUringPoller::QueuePollAdd(int fd, uint64_t user_data) {
+  struct io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+#ifdef GRPC_IO_URING_NO_POLL32_EVENTS
+  sqe->poll_events = static_cast<__u16>(kPollMask);
+#else
+  sqe->poll32_events = kPollMask;
+#endif
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = user_data;
+}
+
+void IoUringPoller::QueuePollRemove(uint64_t user_data) {
+  struct io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->user_data = kPollRemoveUserData;
+}
+
+bool IoUringPoller::Enter(unsigned to_submit, unsigned min_complete) {
+  unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+  int r;
+  do {
+    r = IoUringEnter(ring_.ring_fd, to_submit, min_complete, flags);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0 && errno != EBUSY && errno != EAGAIN) {
+    gpr_log(GPR_ERROR,
+            "(event_engine) IoUringPoller:%p encountered io_uring_enter "
+            "error: %s",
+            this, strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void IoUringPoller::FlushSubmissions() {
+  unsigned to_submit =
+      *ring_.sq.tail - __atomic_load_n(ring_.sq.head, __ATOMIC_ACQUIRE);
+  if (to_submit > 0) {
+    Enter(to_submit, 0);
+  }
+}
+
+bool IoUringPoller::ProcessCompletions(Events& pending_events,
+                                       bool& timed_out) {
+  bool was_kicked = false;
+  uint64_t wakeup_user_data = reinterpret_cast<uintptr_t>(wakeup_fd_.get());
+  unsigned head = *ring_.cq.head;
+  unsigned tail = __atomic_load_n(ring_.cq.tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    struct io_uring_cqe* cqe = &ring_.cq.cqes[head & *ring_.cq.ring_mask];
+    uint64_t user_data = cqe->user_data;
+    int res = cqe->res;
+    bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+    if (user_data == kTimeoutUserData) {
+      if (res == -ETIME) {
+        timed_out = true;
+      }
+      continue;
+    }
+    if (user_data == kPollRemoveUserData) {
+      continue;
+    }
+    if (user_data == wakeup_user_data) {
+      if (res > 0) {
+        GPR_ASSERT(wakeup_fd_->ConsumeWakeup().ok());
+        was_kicked = true;
+      }
+      if (!more) {
+        QueuePollAdd(wakeup_fd_->ReadFd(), wakeup_user_data);
+      }
+      continue;
+    }
+    IoUringEventHandle* handle = reinterpret_cast<IoUringEventHandle*>(
+        static_cast<uintptr_t>(user_data) & ~static_cast<uintptr_t>(1));
+    bool track_err = (user_data & 1) != 0;
+    if (handle->orphaned_) {
+      if (!more) {
+        handle->poll_armed_ = false;
+        orphaned_io_uring_handles_list_.remove(handle);
+        free_io_uring_handles_list_.push_back(handle);
+      }
+      continue;
+    }
+    if (res < 0) {
+      // The poll request failed. Report the fd as readable and writable so
+      // that the owner attempts the operation and observes the error.
+      gpr_log(GPR_ERROR, "io_uring poll request for fd %d failed: %s",
+              handle->fd_, strerror(-res));
+      if (!more) {
+        handle->poll_armed_ = false;
+      }
+      if (handle->SetPendingActions(true, true, false)) {
+        pending_events.push_back(handle);
+      }
+      continue;
+    }
+    uint32_t events = static_cast<uint32_t>(res);
+    bool cancel = (events & POLLHUP) != 0;
+    bool error = (events & POLLERR) != 0;
+    bool read_ev = (events & (POLLIN | POLLPRI)) != 0;
+    bool write_ev = (events & POLLOUT) != 0;
+    bool err_fallback = error && !track_err;
+    if (handle->SetPendingActions(read_ev || cancel || err_fallback,
+                                  write_ev || cancel || err_fallback,
+                                  error && !err_fallback)) {
+      pending_events.push_back(handle);
+    }
+    if (!more) {
+      // The kernel terminated the multishot request (e.g. because the
+      // completion ring overflowed). Re-arm it; the new request is submitted
+      // together with the next wait.
+      QueuePollAdd(handle->fd_, user_data);
+    }
+  }
+  __atomic_store_n(ring_.cq.head, head, __ATOMIC_RELEASE);
+  return was_kicked;
+}
+
+bool IoUringPoller::ProbeMultishotPoll() {
+  if (!wakeup_fd_->Wakeup().ok() || !Enter(0, 1)) {
+    return false;
+  }
+  bool supported = false;
+  absl::MutexLock lock(&mu_);
+  unsigned head = *ring_.cq.head;
+  unsigned tail = __atomic_load_n(ring_.cq.tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    struct io_uring_cqe* cqe = &ring_.cq.cqes[head & *ring_.cq.ring_mask];
+    if (cqe->res > 0 && (cqe->flags & IORING_CQE_F_MORE) != 0) {
+      supported = true;
+    }
+  }
+  __atomic_store_n(ring_.cq.head, head, __ATOMIC_RELEASE);
+  wakeup_fd_->ConsumeWakeup().IgnoreError();
+  return supported;
+}
+
+EventHandle* IoUringPoller::CreateHandle(int fd, absl::string_view /*name*/,
+                                         bool track_err) {
+  IoUringEventHandle* new_handle = nullptr;
+  absl::MutexLock lock(&mu_);
+  if (free_io_uring_handles_list_.empty()) {
+    new_handle = new IoUringEventHandle(fd, track_err, this);
+  } else {
+    new_handle = reinterpret_cast<IoUringEventHandle*>(
+        free_io_uring_handles_list_.front());
+    free_io_uring_handles_list_.pop_front();
+    new_handle->ReInit(fd, track_err);
+  }
+  new_handle->poll_armed_ = true;
+  QueuePollAdd(fd, new_handle->UserData());
+  // Submit right away: a thread may be blocked in Work(...) and would not pick
+  // up the new request until its next wakeup.
+  FlushSubmissions();
+  return new_handle;
+}
+
+// Submits all queued requests and waits for completions until timeout is
+// reached or there is a Kick(). Completions are processed in one batch.
+Poller::WorkResult IoUringPoller::Work(
+    EventEngine::Duration timeout,
+    absl::FunctionRef<void()> schedule_poll_again) {
+  Events pending_events;
+  bool timed_out = false;
+  bool wait = false;
+  {
+    absl::MutexLock lock(&mu_);
+    if (*ring_.cq.head == __atomic_load_n(ring_.cq.tail, __ATOMIC_ACQUIRE)) {
+      // Nothing is ready yet. Queue a timeout request that completes either
+      // when the deadline expires or as soon as one other completion is
+      // posted, and block on it.
+      EventEngine::Duration wait_for =
+          std::max(timeout, EventEngine::Duration::zero());
+      auto secs = std::chrono::duration_cast<std::chrono::seconds>(wait_for);
+      timeout_ts_.tv_sec = secs.count();
+      timeout_ts_.tv_nsec =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(wait_for - secs)
+              .count();
+      struct io_uring_sqe* sqe = GetSqe();
+      sqe->opcode = IORING_OP_TIMEOUT;
+      sqe->fd = -1;
+      sqe->addr = reinterpret_cast<uintptr_t>(&timeout_ts_);
+      sqe->len = 1;
+      sqe->off = 1;
+      sqe->user_data = kTimeoutUserData;
+      wait = true;
+    }
+  }
+  // Submit every queued request (poll re-arms, removals and the timeout)
+  // with the same system call that waits for completions.
+  unsigned to_submit =
+      __atomic_load_n(ring_.sq.tail, __ATOMIC_ACQUIRE) -
+      __atomic_load_n(ring_.sq.head, __ATOMIC_ACQUIRE);
+  if ((to_submit > 0 || wait) && !Enter(to_submit, wait ? 1 : 0)) {
+    GPR_ASSERT(false);
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    // Process all available completions. Unlike the epoll1 poller, the
+    // completion ring is always drained completely, so a Kick does not
+    // require special handling beyond resetting was_kicked_.
+    if (ProcessCompletions(pending_events, timed_out)) {
+      was_kicked_ = false;
+    }
+    if (pending_events.empty()) {
+      return timed_out ? Poller::WorkResult::kDeadlineExceeded
+                       : Poller::WorkResult::kKicked;
+    }
+  }
+  // Run the provided callback.
+  schedule_poll_again();
+  // Process all pending events inline.
+  for (auto& it : pending_events) {
+    it->ExecutePendingActions();
+  }
+  return Poller::WorkResult::kOk;
+}
+
+void IoUringPoller::Kick() {
+  absl::MutexLock lock(&mu_);
+  if (was_kicked_) {
+    return;
+  }
+  was_kicked_ = true;
+  GPR_ASSERT(wakeup_fd_->Wakeup().ok());
+}
+
+bool IoUringPoller::CanTrackErrors() const { return KernelSupportsErrqueue(); }
+
+IoUringPoller* GetIoUringPoller(Scheduler* scheduler) {
+  static bool kIoUringPollerSupported = []() {
+    // The ring is shared with child processes after a fork, which would make
+    // the parent and the child steal each other's completions.
+    if (grpc_core::Fork::Enabled() ||
+        !grpc_event_engine::posix_engine::SupportsWakeupFd()) {
+      return false;
+    }
+    IoUringPoller probe(nullptr);
+    return probe.ring_.ring_fd >= 0 && probe.ProbeMultishotPoll();
+  }();
+  if (!kIoUringPollerSupported) {
+    return nullptr;
+  }
+  IoUringPoller* poller = new IoUringPoller(scheduler);
+  if (poller->ring_.ring_fd < 0) {
+    delete poller;
+    return nullptr;
+  }
+  return poller;
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#else /* defined(GRPC_LINUX_IO_URING) */
+#if defined(GRPC_POSIX_SOCKET_EV)
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::Poller;
+
+IoUringPoller::IoUringPoller(Scheduler* /* engine */) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+void IoUringPoller::Shutdown() { GPR_ASSERT(false && "unimplemented"); }
+
+IoUringPoller::~IoUringPoller() { GPR_ASSERT(false && "unimplemented"); }
+
+EventHandle* IoUringPoller::CreateHandle(int /*fd*/,
+                                         absl::string_view /*name*/,
+                                         bool /*track_err*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+Poller::WorkResult IoUringPoller::Work(
+    EventEngine::Duration /*timeout*/,
+    absl::FunctionRef<void()> /*schedule_poll_again*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+void IoUringPoller::Kick() { GPR_ASSERT(false && "unimplemented"); }
+
+bool IoUringPoller::CanTrackErrors() const {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+// If GRPC_LINUX_IO_URING is not defined, it means io_uring is not available.
+// Return nullptr.
+IoUringPoller* GetIoUringPoller(Scheduler* /*scheduler*/) { return nullptr; }
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif /* defined(GRPC_POSIX_SOCKET_EV) */
+#endif /* !defined(GRPC_LINUX_IO_URING) */
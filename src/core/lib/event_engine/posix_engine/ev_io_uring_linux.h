@@ -0,0 +1,153 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <time.h>
+#endif
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+class IoUringEventHandle;
+
+// Definition of an io_uring based poller.
+//
+// Every handle is registered with a multishot IORING_OP_POLL_ADD request, so
+// the kernel keeps reporting readiness edges for it without the poller having
+// to re-arm it. Poll (re-)arm and removal requests are queued on the
+// submission ring and flushed together with the wait for completions, so a
+// single io_uring_enter() call covers every socket that changed since the
+// previous poll cycle.
+class IoUringPoller : public PosixEventPoller {
+ public:
+  explicit IoUringPoller(Scheduler* scheduler);
+  EventHandle* CreateHandle(int fd, absl::string_view name,
+                            bool track_err) override;
+  Poller::WorkResult Work(
+      grpc_event_engine::experimental::EventEngine::Duration timeout,
+      absl::FunctionRef<void()> schedule_poll_again) override;
+  std::string Name() override { return "io_uring"; }
+  bool CanTrackErrors() const override;
+  void Kick() override;
+  Scheduler* GetScheduler() { return scheduler_; }
+  void Shutdown() override;
+  ~IoUringPoller() override;
+
+ private:
+  // This initial vector size may need to be tuned
+  using Events = absl::InlinedVector<IoUringEventHandle*, 5>;
+  friend class IoUringEventHandle;
+  friend IoUringPoller* GetIoUringPoller(Scheduler* scheduler);
+#ifdef GRPC_LINUX_IO_URING
+  struct SubmissionQueue {
+    unsigned* head;
+    unsigned* tail;
+    unsigned* ring_mask;
+    unsigned* array;
+    struct io_uring_sqe* sqes;
+    // Number of sqes written to the ring but not yet handed to the kernel.
+    unsigned pending;
+  };
+  struct CompletionQueue {
+    unsigned* head;
+    unsigned* tail;
+    unsigned* ring_mask;
+    struct io_uring_cqe* cqes;
+  };
+  struct IoUringSet {
+    int ring_fd = -1;
+    unsigned entries = 0;
+    void* sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    void* cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    size_t sqes_size = 0;
+    SubmissionQueue sq;
+    CompletionQueue cq;
+  };
+  // Returns a free submission queue entry, flushing pending entries to the
+  // kernel if the ring is full. The returned entry is zeroed.
+  struct io_uring_sqe* GetSqe() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Queue a multishot poll request for the file descriptor associated with
+  // user_data.
+  void QueuePollAdd(int fd, uint64_t user_data)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Queue the removal of a previously armed poll request.
+  void QueuePollRemove(uint64_t user_data) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Hand all queued submission queue entries to the kernel. If
+  // min_complete > 0, it also blocks until that many completions are
+  // available. Returns false on unexpected errors.
+  bool Enter(unsigned to_submit, unsigned min_complete);
+  // Submits pending entries without waiting for completions.
+  void FlushSubmissions() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Process all completions currently available on the completion ring.
+  // Returns true if there was a Kick that forced invocation of this function.
+  // timed_out is set to true if the timeout request armed by Work() fired.
+  bool ProcessCompletions(Events& pending_events, bool& timed_out)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Verifies that the running kernel supports multishot poll requests.
+  bool ProbeMultishotPoll();
+  IoUringSet ring_;
+  // Deadline used by the timeout request queued by Work(). It lives here
+  // because the kernel reads it once the request is submitted, which may
+  // happen from a thread other than the one that queued it.
+  struct __kernel_timespec timeout_ts_;
+#else
+  struct IoUringSet {};
+  IoUringSet ring_;
+#endif
+  absl::Mutex mu_;
+  Scheduler* scheduler_;
+  bool was_kicked_ ABSL_GUARDED_BY(mu_);
+  std::list<EventHandle*> free_io_uring_handles_list_ ABSL_GUARDED_BY(mu_);
+  // Handles that have been orphaned but whose poll request has not yet
+  // produced its final completion. They move to free_io_uring_handles_list_
+  // once the kernel is done with them.
+  std::list<EventHandle*> orphaned_io_uring_handles_list_ ABSL_GUARDED_BY(mu_);
+  std::unique_ptr<WakeupFd> wakeup_fd_;
+};
+
+// Return an instance of an io_uring based poller tied to the specified
+// scheduler. Returns nullptr if the running kernel does not support the
+// io_uring features required by the poller.
+IoUringPoller* GetIoUringPoller(Scheduler* scheduler);
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
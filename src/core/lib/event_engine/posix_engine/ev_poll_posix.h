@@ -48,6 +48,7 @@ class PollPoller : public PosixEventPoller {
       grpc_event_engine::experimental::EventEngine::Duration timeout,
       absl::FunctionRef<void()> schedule_poll_again) override;
   std::string Name() override { return "poll"; }
+  bool CanTrackErrors() const override { return false; }
   void Kick() override;
   Scheduler* GetScheduler() { return scheduler_; }
   void Shutdown() override;
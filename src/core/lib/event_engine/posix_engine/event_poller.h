@@ -37,6 +37,8 @@ class Scheduler {
   virtual ~Scheduler() = default;
 };
 
+class PosixEventPoller;
+
 class EventHandle {
  public:
   virtual int WrappedFd() = 0;
@@ -79,6 +81,8 @@ class EventHandle {
   virtual void SetHasError() = 0;
   // Returns true if the handle has been shutdown.
   virtual bool IsHandleShutdown() = 0;
+  // Returns the poller which was used to create this handle.
+  virtual PosixEventPoller* Poller() = 0;
   virtual ~EventHandle() = default;
 };
 
@@ -88,6 +92,10 @@ class PosixEventPoller : public grpc_event_engine::experimental::Poller {
   virtual EventHandle* CreateHandle(int fd, absl::string_view name,
                                     bool track_err) = 0;
   virtual std::string Name() = 0;
+  // Returns true if the poller can report errors (such as zerocopy
+  // completions and timestamps) read from the error queue of a handle created
+  // with track_err set.
+  virtual bool CanTrackErrors() const = 0;
   // Shuts down and deletes the poller. It is legal to call this function
   // only when no other poller method is in progress. For instance, it is
   // not safe to call this method, while a thread is blocked on Work(...).
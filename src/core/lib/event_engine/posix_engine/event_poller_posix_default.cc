@@ -18,6 +18,7 @@
 #include "absl/strings/string_view.h"
 
 #include "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h"
+#include "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.h"
 #include "src/core/lib/event_engine/posix_engine/ev_poll_posix.h"
 #include "src/core/lib/event_engine/posix_engine/event_poller.h"
 #include "src/core/lib/gprpp/global_config.h"
@@ -43,7 +44,10 @@ PosixEventPoller* GetDefaultPoller(Scheduler* scheduler) {
   auto strings = absl::StrSplit(poll_strategy.get(), ',');
   for (auto it = strings.begin(); it != strings.end() && poller == nullptr;
        it++) {
-    if (PollStrategyMatches(*it, "epoll1")) {
+    // io_uring is opt-in only, it is not selected by "all".
+    if (*it == "io_uring") {
+      poller = GetIoUringPoller(scheduler);
+    } else if (PollStrategyMatches(*it, "epoll1")) {
       poller = GetEpoll1Poller(scheduler);
     } else if (PollStrategyMatches(*it, "poll")) {
       poller = GetPollPoller(scheduler, /*use_phony_poll=*/false);
@@ -0,0 +1,217 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/native_dns_lookups.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+
+namespace {
+
+#ifdef GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
+// Whether \a name has an IP address for its host, which needs no lookup.
+bool IsLiteral(absl::string_view name) {
+  std::string host;
+  std::string port;
+  grpc_core::SplitHostPort(name, &host, &port);
+  char buf[sizeof(struct in6_addr)];
+  return inet_pton(AF_INET, host.c_str(), buf) == 1 ||
+         inet_pton(AF_INET6, host.c_str(), buf) == 1;
+}
+#else
+bool IsLiteral(absl::string_view /*name*/) { return false; }
+#endif
+
+}  // namespace
+
+NativeDNSLookups::LookupTaskHandle NativeDNSLookups::LookupHostname(
+    LookupHostnameCallback on_resolve, absl::string_view name,
+    absl::string_view default_port, EventEngine::Duration timeout) {
+  if (IsLiteral(name)) {
+    auto result = LookupHostnameBlocking(name, default_port);
+    engine_->Run([on_resolve = std::move(on_resolve),
+                  result = std::move(result)]() mutable {
+      on_resolve(std::move(result));
+    });
+    return {0, 0};
+  }
+  std::string key =
+      absl::StrCat(name, absl::string_view("\0", 1), default_port);
+  grpc_core::MutexLock lock(&mu_);
+  const intptr_t id = next_id_++;
+  std::unique_ptr<Lookup>& lookup = lookups_[key];
+  if (lookup == nullptr) {
+    lookup = std::make_unique<Lookup>();
+    lookup->name = std::string(name);
+    lookup->default_port = std::string(default_port);
+    queue_.push_back(key);
+  }
+  Waiter& waiter = lookup->waiters[id];
+  waiter.on_resolve = std::move(on_resolve);
+  waiter.deadline_timer = engine_->RunAfter(timeout, [this, id]() {
+    absl::optional<Waiter> waiter;
+    {
+      grpc_core::MutexLock lock(&mu_);
+      waiter = RemoveWaiter(id);
+    }
+    if (waiter.has_value()) {
+      waiter->on_resolve(absl::DeadlineExceededError("DNS lookup timed out"));
+    }
+  });
+  waiter_keys_.emplace(id, std::move(key));
+  if (running_ < kMaxConcurrentLookups && !queue_.empty()) {
+    ++running_;
+    engine_->Run([this]() { RunLookups(); });
+  }
+  return {id, 0};
+}
+
+bool NativeDNSLookups::CancelLookup(LookupTaskHandle handle) {
+  absl::optional<Waiter> waiter;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    waiter = RemoveWaiter(handle.keys[0]);
+  }
+  if (!waiter.has_value()) return false;
+  engine_->Cancel(waiter->deadline_timer);
+  return true;
+}
+
+absl::optional<NativeDNSLookups::Waiter> NativeDNSLookups::RemoveWaiter(
+    intptr_t id) {
+  auto key = waiter_keys_.find(id);
+  if (key == waiter_keys_.end()) return absl::nullopt;
+  auto lookup = lookups_.find(key->second);
+  waiter_keys_.erase(key);
+  auto it = lookup->second->waiters.find(id);
+  Waiter waiter = std::move(it->second);
+  lookup->second->waiters.erase(it);
+  // A lookup nobody waits for any more is not started; its key stays queued,
+  // and is skipped there.
+  if (lookup->second->waiters.empty() && !lookup->second->started) {
+    lookups_.erase(lookup);
+  }
+  return waiter;
+}
+
+void NativeDNSLookups::RunLookups() {
+  mu_.Lock();
+  while (!queue_.empty()) {
+    std::string key = std::move(queue_.front());
+    queue_.pop_front();
+    auto it = lookups_.find(key);
+    if (it == lookups_.end() || it->second->started) continue;
+    Lookup* lookup = it->second.get();
+    lookup->started = true;
+    mu_.Unlock();
+    auto result = LookupHostnameBlocking(lookup->name, lookup->default_port);
+    mu_.Lock();
+    // Everybody who started waiting for the name meanwhile gets the result.
+    std::unique_ptr<Lookup> done = std::move(lookups_[key]);
+    lookups_.erase(key);
+    for (const auto& waiter : done->waiters) waiter_keys_.erase(waiter.first);
+    mu_.Unlock();
+    for (auto& waiter : done->waiters) {
+      engine_->Cancel(waiter.second.deadline_timer);
+      waiter.second.on_resolve(result);
+    }
+    done.reset();
+    mu_.Lock();
+  }
+  --running_;
+  mu_.Unlock();
+}
+
+#ifdef GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
+
+absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>
+NativeDNSLookups::LookupHostnameBlocking(absl::string_view name,
+                                         absl::string_view default_port) {
+  std::string host;
+  std::string port;
+  grpc_core::SplitHostPort(name, &host, &port);
+  if (host.empty()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("unparseable host:port: ", name));
+  }
+  if (port.empty()) {
+    if (default_port.empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("no port in name: ", name));
+    }
+    port = std::string(default_port);
+  }
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  struct addrinfo* result = nullptr;
+  int s = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+  if (s != 0) {
+    // Retry if well-known service name is recognized
+    const char* svc[][2] = {{"http", "80"}, {"https", "443"}};
+    for (const auto& service : svc) {
+      if (port == service[0]) {
+        s = getaddrinfo(host.c_str(), service[1], &hints, &result);
+        break;
+      }
+    }
+  }
+  if (s != 0) {
+    std::string message =
+        absl::StrCat("getaddrinfo(", name, "): ", gai_strerror(s));
+    if (s == EAI_NONAME) return absl::NotFoundError(message);
+    return absl::UnavailableError(message);
+  }
+  std::vector<EventEngine::ResolvedAddress> addresses;
+  for (struct addrinfo* resp = result; resp != nullptr; resp = resp->ai_next) {
+    addresses.emplace_back(resp->ai_addr, resp->ai_addrlen);
+  }
+  freeaddrinfo(result);
+  return addresses;
+}
+
+#else  // GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
+
+absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>
+NativeDNSLookups::LookupHostnameBlocking(absl::string_view /*name*/,
+                                         absl::string_view /*default_port*/) {
+  return absl::UnimplementedError("no system resolver on this platform");
+}
+
+#endif  // GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
@@ -0,0 +1,105 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_NATIVE_DNS_LOOKUPS_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_NATIVE_DNS_LOOKUPS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// Hostname lookups through the system resolver (getaddrinfo) for the
+// EventEngine's DNSResolvers. getaddrinfo blocks, so lookups run on the
+// engine's threads, but no more than kMaxConcurrentLookups at a time: under a
+// resolution storm the rest wait their turn rather than take every thread.
+// Lookups of a name already being looked up (or waiting to be) wait for that
+// lookup's result instead of starting another one, and literal IP addresses
+// are never looked up at all.
+class NativeDNSLookups {
+ public:
+  using LookupTaskHandle =
+      experimental::EventEngine::DNSResolver::LookupTaskHandle;
+  using LookupHostnameCallback =
+      experimental::EventEngine::DNSResolver::LookupHostnameCallback;
+
+  static constexpr int kMaxConcurrentLookups = 4;
+
+  explicit NativeDNSLookups(experimental::EventEngine* engine)
+      : engine_(engine) {}
+
+  // As EventEngine::DNSResolver::LookupHostname(). \a on_resolve runs on one
+  // of the engine's threads, with DEADLINE_EXCEEDED after \a timeout.
+  LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
+                                  absl::string_view name,
+                                  absl::string_view default_port,
+                                  experimental::EventEngine::Duration timeout);
+  bool CancelLookup(LookupTaskHandle handle);
+
+  // Looks \a name up in the calling thread.
+  static absl::StatusOr<std::vector<experimental::EventEngine::ResolvedAddress>>
+  LookupHostnameBlocking(absl::string_view name,
+                         absl::string_view default_port);
+
+ private:
+  struct Waiter {
+    LookupHostnameCallback on_resolve;
+    experimental::EventEngine::TaskHandle deadline_timer;
+  };
+  // The lookup of one name and default port, shared by all their waiters.
+  struct Lookup {
+    std::string name;
+    std::string default_port;
+    // Keyed by the LookupTaskHandle given to each waiter.
+    absl::flat_hash_map<intptr_t, Waiter> waiters;
+    bool started = false;
+  };
+
+  void RunLookups();
+  absl::optional<Waiter> RemoveWaiter(intptr_t id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  experimental::EventEngine* const engine_;
+  grpc_core::Mutex mu_;
+  // Keyed by name and default port.
+  absl::flat_hash_map<std::string, std::unique_ptr<Lookup>> lookups_
+      ABSL_GUARDED_BY(mu_);
+  // Keys of the lookups not started yet, in order.
+  std::deque<std::string> queue_ ABSL_GUARDED_BY(mu_);
+  // Where each waiter is, by id.
+  absl::flat_hash_map<intptr_t, std::string> waiter_keys_ ABSL_GUARDED_BY(mu_);
+  int running_ ABSL_GUARDED_BY(mu_) = 0;
+  intptr_t next_id_ ABSL_GUARDED_BY(mu_) = 1;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_NATIVE_DNS_LOOKUPS_H
@@ -20,6 +20,8 @@
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/any_invocable.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
 
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/support/log.h>
@@ -110,8 +112,49 @@ EventEngine::TaskHandle PosixEventEngine::RunAfterInternal(
 }
 
 std::unique_ptr<EventEngine::DNSResolver> PosixEventEngine::GetDNSResolver(
-    EventEngine::DNSResolver::ResolverOptions const& /*options*/) {
-  GPR_ASSERT(false && "unimplemented");
+    EventEngine::DNSResolver::ResolverOptions const& options) {
+  if (!options.dns_server.empty()) {
+    gpr_log(GPR_ERROR,
+            "PosixEventEngine:%p cannot resolve through DNS server %s, using "
+            "the system resolver instead",
+            this, options.dns_server.c_str());
+  }
+  return absl::make_unique<PosixDNSResolver>(this);
+}
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupHostname(
+    LookupHostnameCallback on_resolve, absl::string_view name,
+    absl::string_view default_port, Duration timeout) {
+  return engine_->native_dns_lookups_.LookupHostname(
+      std::move(on_resolve), name, default_port, timeout);
+}
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupSRV(LookupSRVCallback on_resolve,
+                                              absl::string_view /*name*/,
+                                              Duration /*timeout*/) {
+  engine_->Run([on_resolve = std::move(on_resolve)]() mutable {
+    on_resolve(absl::UnimplementedError(
+        "The system resolver does not support looking up SRV records"));
+  });
+  return {0, 0};
+}
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupTXT(LookupTXTCallback on_resolve,
+                                              absl::string_view /*name*/,
+                                              Duration /*timeout*/) {
+  engine_->Run([on_resolve = std::move(on_resolve)]() mutable {
+    on_resolve(absl::UnimplementedError(
+        "The system resolver does not support looking up TXT records"));
+  });
+  return {0, 0};
+}
+
+bool PosixEventEngine::PosixDNSResolver::CancelLookup(
+    LookupTaskHandle handle) {
+  return engine_->native_dns_lookups_.CancelLookup(handle);
 }
 
 bool PosixEventEngine::IsWorkerThread() {
@@ -33,6 +33,7 @@
 
 #include "src/core/lib/event_engine/executor/threaded_executor.h"
 #include "src/core/lib/event_engine/handle_containers.h"
+#include "src/core/lib/event_engine/posix_engine/native_dns_lookups.h"
 #include "src/core/lib/event_engine/posix_engine/timer_manager.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -59,9 +60,13 @@ class PosixEventEngine final : public EventEngine {
     absl::StatusOr<int> Bind(const ResolvedAddress& addr) override;
     absl::Status Start() override;
   };
+  // Resolves through the system resolver (see posix_engine::NativeDNSLookups),
+  // so ResolverOptions::dns_server is not supported, nor are SRV and TXT
+  // records.
   class PosixDNSResolver : public EventEngine::DNSResolver {
    public:
-    ~PosixDNSResolver() override;
+    explicit PosixDNSResolver(PosixEventEngine* engine) : engine_(engine) {}
+    ~PosixDNSResolver() override = default;
     LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
                                     absl::string_view name,
                                     absl::string_view default_port,
@@ -73,6 +78,9 @@ class PosixEventEngine final : public EventEngine {
                                absl::string_view name,
                                Duration timeout) override;
     bool CancelLookup(LookupTaskHandle handle) override;
+
+   private:
+    PosixEventEngine* const engine_;
   };
 
   PosixEventEngine() = default;
@@ -108,6 +116,8 @@ class PosixEventEngine final : public EventEngine {
                                            absl::AnyInvocable<void()> cb);
 
   posix_engine::TimerManager timer_manager_;
+  // Before executor_, so that lookups still running on it finish first.
+  posix_engine::NativeDNSLookups native_dns_lookups_{this};
   ThreadedExecutor executor_{2};
 
   grpc_core::Mutex mu_;
@@ -32,6 +32,8 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/thd.h"
 
 static thread_local bool g_timer_thread;
@@ -201,7 +203,11 @@ void TimerManager::Run() {
 bool TimerManager::IsTimerManagerThread() { return g_timer_thread; }
 
 TimerManager::TimerManager() : host_(this) {
-  timer_list_ = absl::make_unique<TimerList>(&host_);
+  if (grpc_core::IsTimerWheelEnabled()) {
+    timer_list_ = absl::make_unique<TimerWheel>(&host_);
+  } else {
+    timer_list_ = absl::make_unique<TimerList>(&host_);
+  }
   grpc_core::MutexLock lock(&mu_);
   StartThread();
 }
@@ -0,0 +1,157 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+TimerWheel::Shard::Shard(grpc_core::Timestamp now)
+    : wheel(now.milliseconds_after_process_epoch()),
+      published_min_deadline(now),
+      min_deadline(now) {}
+
+grpc_core::Timestamp TimerWheel::Shard::PopTimers(
+    grpc_core::Timestamp now,
+    std::vector<experimental::EventEngine::Closure*>* out) {
+  grpc_core::MutexLock lock(&mu);
+  auto on_expired = [out](Timer* timer) {
+    timer->pending = false;
+    out->push_back(timer->closure);
+  };
+  if (now == grpc_core::Timestamp::InfFuture()) {
+    wheel.PopAll(on_expired);
+  } else {
+    wheel.Advance(now.milliseconds_after_process_epoch(), on_expired);
+  }
+  // NextDeadline() returns INT64_MAX, i.e. InfFuture, for an empty wheel.
+  published_min_deadline =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          wheel.NextDeadline());
+  return published_min_deadline;
+}
+
+TimerWheel::TimerWheel(TimerListHost* host)
+    : host_(host),
+      num_shards_(grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u)),
+      min_timer_(host_->Now().milliseconds_after_process_epoch()) {
+  const auto now = grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+      min_timer_.load(std::memory_order_relaxed));
+  shards_.reserve(num_shards_);
+  for (size_t i = 0; i < num_shards_; i++) {
+    shards_.push_back(std::make_unique<Shard>(now));
+  }
+}
+
+void TimerWheel::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                           experimental::EventEngine::Closure* closure) {
+  bool is_first_timer = false;
+  Shard* shard = shards_[grpc_core::HashPointer(timer, num_shards_)].get();
+  timer->closure = closure;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  {
+    grpc_core::MutexLock lock(&shard->mu);
+    timer->pending = true;
+    grpc_core::Timestamp now = host_->Now();
+    if (deadline <= now) {
+      deadline = now;
+    }
+    timer->deadline = deadline.milliseconds_after_process_epoch();
+    shard->wheel.Add(timer);
+    if (deadline < shard->published_min_deadline) {
+      shard->published_min_deadline = deadline;
+      is_first_timer = true;
+    }
+  }
+
+  // As in TimerList::TimerInit, a TimerCheck may intervene between the two
+  // locks; the checks below err on the side of an early wakeup.
+  if (is_first_timer) {
+    grpc_core::MutexLock lock(&mu_);
+    if (deadline < shard->min_deadline) {
+      shard->min_deadline = deadline;
+      if (deadline < grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                         min_timer_.load(std::memory_order_relaxed))) {
+        min_timer_.store(deadline.milliseconds_after_process_epoch(),
+                         std::memory_order_relaxed);
+        host_->Kick();
+      }
+    }
+  }
+}
+
+bool TimerWheel::TimerCancel(Timer* timer) {
+  Shard* shard = shards_[grpc_core::HashPointer(timer, num_shards_)].get();
+  grpc_core::MutexLock lock(&shard->mu);
+  if (timer->pending) {
+    timer->pending = false;
+    shard->wheel.Remove(timer);
+    return true;
+  }
+  return false;
+}
+
+std::vector<experimental::EventEngine::Closure*> TimerWheel::FindExpiredTimers(
+    grpc_core::Timestamp now, grpc_core::Timestamp* next) {
+  std::vector<experimental::EventEngine::Closure*> done;
+  grpc_core::MutexLock lock(&mu_);
+  grpc_core::Timestamp min_deadline = grpc_core::Timestamp::InfFuture();
+  for (const auto& shard : shards_) {
+    // Shards hold few enough timers due at any instant that popping every
+    // expired shard in one pass is cheaper than keeping them sorted.
+    if (shard->min_deadline < now ||
+        (now != grpc_core::Timestamp::InfFuture() &&
+         shard->min_deadline == now)) {
+      shard->min_deadline = shard->PopTimers(now, &done);
+    }
+    min_deadline = std::min(min_deadline, shard->min_deadline);
+  }
+  if (next != nullptr) *next = std::min(*next, min_deadline);
+  min_timer_.store(min_deadline.milliseconds_after_process_epoch(),
+                   std::memory_order_relaxed);
+  return done;
+}
+
+absl::optional<std::vector<experimental::EventEngine::Closure*>>
+TimerWheel::TimerCheck(grpc_core::Timestamp* next) {
+  grpc_core::Timestamp now = host_->Now();
+  grpc_core::Timestamp min_timer =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          min_timer_.load(std::memory_order_relaxed));
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    return std::vector<experimental::EventEngine::Closure*>();
+  }
+  if (!checker_mu_.TryLock()) return absl::nullopt;
+  std::vector<experimental::EventEngine::Closure*> run =
+      FindExpiredTimers(now, next);
+  checker_mu_.Unlock();
+  return run;
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
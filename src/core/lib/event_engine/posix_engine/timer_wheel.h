@@ -0,0 +1,100 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/timer_wheel.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// A TimerListInterface backed by sharded hierarchical timing wheels.
+//
+// Unlike TimerList, whose shards keep a heap of timers due soon, TimerInit and
+// TimerCancel are O(1) regardless of how many timers are pending; the cost is
+// moved to TimerCheck, which cascades far timers towards their deadlines as
+// time passes. This suits workloads that arm and cancel many deadlines which
+// rarely fire.
+class TimerWheel final : public TimerListInterface {
+ public:
+  explicit TimerWheel(TimerListHost* host);
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // See TimerList for the contract of these methods.
+  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                 experimental::EventEngine::Closure* closure) override;
+  bool TimerCancel(Timer* timer) override GRPC_MUST_USE_RESULT;
+  absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
+      grpc_core::Timestamp* next) override;
+
+ private:
+  struct Shard {
+    explicit Shard(grpc_core::Timestamp now);
+
+    // Runs the wheel forward to now, appending the closures of the expired
+    // timers to out, and returns a lower bound for the next deadline.
+    grpc_core::Timestamp PopTimers(
+        grpc_core::Timestamp now,
+        std::vector<experimental::EventEngine::Closure*>* out)
+        ABSL_LOCKS_EXCLUDED(mu);
+
+    grpc_core::Mutex mu;
+    grpc_core::HierarchicalTimerWheel<Timer> wheel ABSL_GUARDED_BY(mu);
+    // The last min_deadline published for this shard, readable without
+    // holding TimerWheel::mu_ so that TimerInit only takes the global lock
+    // when it lowers the shard's deadline.
+    grpc_core::Timestamp published_min_deadline ABSL_GUARDED_BY(mu);
+    // A lower bound for the deadline of the next timer due in this shard.
+    grpc_core::Timestamp min_deadline ABSL_GUARDED_BY(&TimerWheel::mu_);
+  };
+
+  std::vector<experimental::EventEngine::Closure*> FindExpiredTimers(
+      grpc_core::Timestamp now, grpc_core::Timestamp* next);
+
+  TimerListHost* const host_;
+  const size_t num_shards_;
+  grpc_core::Mutex mu_;
+  // The deadline of the next timer due across all timer shards.
+  std::atomic<int64_t> min_timer_;
+  // Allow only one FindExpiredTimers at once (used as a TryLock, protects no
+  // fields but ensures limits on concurrency).
+  grpc_core::Mutex checker_mu_;
+  // Whenever a timer is added, its address is hashed to select the shard.
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
@@ -23,11 +23,15 @@
 #include <memory>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/event_engine/work_stealing_thread_pool.h"
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/cpu_topology.h"
 #include "src/core/lib/gprpp/thd.h"
 
 namespace grpc_event_engine {
@@ -39,7 +43,14 @@ namespace {
 thread_local bool g_threadpool_thread;
 }  // namespace
 
-void ThreadPool::StartThread(StatePtr state, bool throttled) {
+std::unique_ptr<ThreadPool> MakeThreadPool(int reserve_threads) {
+  if (grpc_core::IsWorkStealingEnabled()) {
+    return absl::make_unique<WorkStealingThreadPool>(reserve_threads);
+  }
+  return absl::make_unique<OriginalThreadPool>(reserve_threads);
+}
+
+void OriginalThreadPool::StartThread(StatePtr state, bool throttled) {
   state->thread_count.Add();
   struct ThreadArg {
     StatePtr state;
@@ -50,6 +61,10 @@ void ThreadPool::StartThread(StatePtr state, bool throttled) {
       [](void* arg) {
         std::unique_ptr<ThreadArg> a(static_cast<ThreadArg*>(arg));
         g_threadpool_thread = true;
+        if (grpc_core::IsNumaThreadPlacementEnabled()) {
+          grpc_core::PinCurrentThreadToNumaNode(
+              grpc_core::CpuTopology::Get().NextNode());
+        }
         if (a->throttled) {
           GPR_ASSERT(a->state->currently_starting_one_thread.exchange(
               false, std::memory_order_relaxed));
@@ -61,13 +76,13 @@ void ThreadPool::StartThread(StatePtr state, bool throttled) {
       .Start();
 }
 
-void ThreadPool::ThreadFunc(StatePtr state) {
+void OriginalThreadPool::ThreadFunc(StatePtr state) {
   while (state->queue.Step()) {
   }
   state->thread_count.Remove();
 }
 
-bool ThreadPool::Queue::Step() {
+bool OriginalThreadPool::Queue::Step() {
   grpc_core::ReleasableMutexLock lock(&mu_);
   // Wait until work is available or we are shutting down.
   while (state_ == State::kRunning && callbacks_.empty()) {
@@ -94,14 +109,14 @@ bool ThreadPool::Queue::Step() {
   return true;
 }
 
-ThreadPool::ThreadPool(int reserve_threads)
+OriginalThreadPool::OriginalThreadPool(int reserve_threads)
     : reserve_threads_(reserve_threads) {
   for (int i = 0; i < reserve_threads; i++) {
     StartThread(state_, /*throttled=*/false);
   }
 }
 
-ThreadPool::~ThreadPool() {
+OriginalThreadPool::~OriginalThreadPool() {
   state_->queue.SetShutdown();
   // Wait until all threads are exited.
   // Note that if this is a threadpool thread then we won't exit this thread
@@ -111,7 +126,7 @@ ThreadPool::~ThreadPool() {
                                              "shutting down");
 }
 
-void ThreadPool::Add(absl::AnyInvocable<void()> callback) {
+void OriginalThreadPool::Add(absl::AnyInvocable<void()> callback) {
   if (state_->queue.Add(std::move(callback))) {
     if (!state_->currently_starting_one_thread.exchange(
             true, std::memory_order_relaxed)) {
@@ -120,7 +135,7 @@ void ThreadPool::Add(absl::AnyInvocable<void()> callback) {
   }
 }
 
-bool ThreadPool::Queue::Add(absl::AnyInvocable<void()> callback) {
+bool OriginalThreadPool::Queue::Add(absl::AnyInvocable<void()> callback) {
   grpc_core::MutexLock lock(&mu_);
   // Add works to the callbacks list
   callbacks_.push(std::move(callback));
@@ -135,7 +150,7 @@ bool ThreadPool::Queue::Add(absl::AnyInvocable<void()> callback) {
   GPR_UNREACHABLE_CODE(return false);
 }
 
-void ThreadPool::Queue::SetState(State state) {
+void OriginalThreadPool::Queue::SetState(State state) {
   grpc_core::MutexLock lock(&mu_);
   if (state == State::kRunning) {
     GPR_ASSERT(state_ != State::kRunning);
@@ -146,19 +161,19 @@ void ThreadPool::Queue::SetState(State state) {
   cv_.SignalAll();
 }
 
-void ThreadPool::ThreadCount::Add() {
+void OriginalThreadPool::ThreadCount::Add() {
   grpc_core::MutexLock lock(&mu_);
   ++threads_;
 }
 
-void ThreadPool::ThreadCount::Remove() {
+void OriginalThreadPool::ThreadCount::Remove() {
   grpc_core::MutexLock lock(&mu_);
   --threads_;
   cv_.Signal();
 }
 
-void ThreadPool::ThreadCount::BlockUntilThreadCount(int threads,
-                                                    const char* why) {
+void OriginalThreadPool::ThreadCount::BlockUntilThreadCount(
+    int threads, const char* why) {
   grpc_core::MutexLock lock(&mu_);
   auto last_log = absl::Now();
   while (threads_ > threads) {
@@ -174,16 +189,16 @@ void ThreadPool::ThreadCount::BlockUntilThreadCount(int threads,
   }
 }
 
-void ThreadPool::PrepareFork() {
+void OriginalThreadPool::PrepareFork() {
   state_->queue.SetForking();
   state_->thread_count.BlockUntilThreadCount(0, "forking");
 }
 
-void ThreadPool::PostforkParent() { Postfork(); }
+void OriginalThreadPool::PostforkParent() { Postfork(); }
 
-void ThreadPool::PostforkChild() { Postfork(); }
+void OriginalThreadPool::PostforkChild() { Postfork(); }
 
-void ThreadPool::Postfork() {
+void OriginalThreadPool::Postfork() {
   state_->queue.Reset();
   for (int i = 0; i < reserve_threads_; i++) {
     StartThread(state_, /*throttled=*/false);
@@ -34,13 +34,27 @@
 namespace grpc_event_engine {
 namespace experimental {
 
-class ThreadPool final : public grpc_event_engine::experimental::Forkable {
+// Interface for all EventEngine ThreadPool implementations.
+class ThreadPool : public grpc_event_engine::experimental::Forkable {
  public:
-  explicit ThreadPool(int reserve_threads);
   // Ensures the thread pool is empty before destroying it.
-  ~ThreadPool() override;
+  ~ThreadPool() override = default;
 
-  void Add(absl::AnyInvocable<void()> callback);
+  virtual void Add(absl::AnyInvocable<void()> callback) = 0;
+};
+
+// Creates the default ThreadPool implementation. The work-stealing pool is
+// used if the work_stealing experiment is enabled.
+std::unique_ptr<ThreadPool> MakeThreadPool(int reserve_threads);
+
+// A ThreadPool in which all threads share a single mutex-protected queue.
+class OriginalThreadPool final : public ThreadPool {
+ public:
+  explicit OriginalThreadPool(int reserve_threads);
+  // Ensures the thread pool is empty before destroying it.
+  ~OriginalThreadPool() override;
+
+  void Add(absl::AnyInvocable<void()> callback) override;
 
   // Forkable
   // Ensures that the thread pool is empty before forking.
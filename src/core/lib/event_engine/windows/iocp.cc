@@ -66,58 +66,74 @@ void IOCP::Shutdown() {
 
 Poller::WorkResult IOCP::Work(EventEngine::Duration timeout,
                               absl::FunctionRef<void()> schedule_poll_again) {
-  static const absl::Status kDeadlineExceeded = absl::DeadlineExceededError(
-      absl::StrFormat("IOCP::%p: Received no completions", this));
-  static const absl::Status kKicked =
-      absl::AbortedError(absl::StrFormat("IOCP::%p: Awoken from a kick", this));
-  DWORD bytes = 0;
-  ULONG_PTR completion_key;
-  LPOVERLAPPED overlapped;
+  OVERLAPPED_ENTRY entries[kMaxCompletionsPerWork];
+  ULONG num_entries = 0;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
     gpr_log(GPR_DEBUG, "IOCP::%p doing work", this);
   }
-  BOOL success = GetQueuedCompletionStatus(
-      iocp_handle_, &bytes, &completion_key, &overlapped,
-      static_cast<DWORD>(Milliseconds(timeout)));
-  if (success == 0 && overlapped == NULL) {
+  BOOL success = GetQueuedCompletionStatusEx(
+      iocp_handle_, entries, kMaxCompletionsPerWork, &num_entries,
+      static_cast<DWORD>(Milliseconds(timeout)), /*fAlertable=*/FALSE);
+  if (success == 0 || num_entries == 0) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
       gpr_log(GPR_DEBUG, "IOCP::%p deadline exceeded", this);
     }
     return Poller::WorkResult::kDeadlineExceeded;
   }
-  GPR_ASSERT(completion_key && overlapped);
-  if (overlapped == &kick_overlap_) {
+  int kicks = 0;
+  bool polled_again = false;
+  for (ULONG i = 0; i < num_entries; i++) {
+    ULONG_PTR completion_key = entries[i].lpCompletionKey;
+    LPOVERLAPPED overlapped = entries[i].lpOverlapped;
+    GPR_ASSERT(completion_key && overlapped);
+    if (overlapped == &kick_overlap_) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
+        gpr_log(GPR_DEBUG, "IOCP::%p kicked", this);
+      }
+      if (completion_key != (ULONG_PTR)&kick_token_) {
+        gpr_log(GPR_ERROR, "Unknown custom completion key: %p",
+                completion_key);
+        abort();
+      }
+      kicks++;
+      continue;
+    }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
-      gpr_log(GPR_DEBUG, "IOCP::%p kicked", this);
+      gpr_log(GPR_DEBUG, "IOCP::%p got event on OVERLAPPED::%p", this,
+              overlapped);
     }
-    outstanding_kicks_.fetch_sub(1);
-    if (completion_key == (ULONG_PTR)&kick_token_) {
-      return Poller::WorkResult::kKicked;
+    if (!polled_again) {
+      schedule_poll_again();
+      polled_again = true;
+    }
+    WinSocket* socket = reinterpret_cast<WinSocket*>(completion_key);
+    // TODO(hork): move the following logic into the WinSocket impl.
+    WinSocket::OpState* info = socket->GetOpInfoForOverlapped(overlapped);
+    GPR_ASSERT(info != nullptr);
+    if (socket->IsShutdown()) {
+      info->SetError(WSAESHUTDOWN);
+    } else {
+      info->GetOverlappedResult();
+    }
+    if (info->closure() != nullptr) {
+      executor_->Run(info->closure());
+    } else {
+      // No callback registered. Set ready.
+      info->SetReady();
     }
-    gpr_log(GPR_ERROR, "Unknown custom completion key: %p", completion_key);
-    abort();
-  }
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
-    gpr_log(GPR_DEBUG, "IOCP::%p got event on OVERLAPPED::%p", this,
-            overlapped);
   }
-  WinSocket* socket = reinterpret_cast<WinSocket*>(completion_key);
-  // TODO(hork): move the following logic into the WinSocket impl.
-  WinSocket::OpState* info = socket->GetOpInfoForOverlapped(overlapped);
-  GPR_ASSERT(info != nullptr);
-  if (socket->IsShutdown()) {
-    info->SetError(WSAESHUTDOWN);
-  } else {
-    info->GetOverlappedResult();
+  // Each kick is meant to wake one worker. This one consumes a kick only if
+  // it has no events to report, and passes the rest on to the next workers.
+  const bool kicked = !polled_again;
+  for (int k = kicked ? 1 : 0; k < kicks; k++) {
+    GPR_ASSERT(PostQueuedCompletionStatus(
+        iocp_handle_, 0, reinterpret_cast<ULONG_PTR>(&kick_token_),
+        &kick_overlap_));
   }
-  if (info->closure() != nullptr) {
-    schedule_poll_again();
-    executor_->Run(info->closure());
-    return Poller::WorkResult::kOk;
+  if (kicked) {
+    outstanding_kicks_.fetch_sub(1);
+    return Poller::WorkResult::kKicked;
   }
-  // No callback registered. Set ready and return an empty set
-  info->SetReady();
-  schedule_poll_again();
   return Poller::WorkResult::kOk;
 }
 
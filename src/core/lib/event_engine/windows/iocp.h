@@ -54,6 +54,9 @@ class IOCP final : public Poller {
   // Initialize default flags via checking platform support
   static DWORD WSASocketFlagsInit();
 
+  // The most completions dequeued by one call to Work().
+  static constexpr ULONG kMaxCompletionsPerWork = 64;
+
   Executor* executor_;
   HANDLE iocp_handle_;
   OVERLAPPED kick_overlap_;
@@ -51,54 +51,55 @@ EventEngine::Closure* WorkQueue::Storage::closure() { return closure_; }
 
 // ------ WorkQueue -----------------------------------------------------------
 
+static_assert((WorkQueue::kRingSize & (WorkQueue::kRingSize - 1)) == 0,
+              "kRingSize must be a power of two");
+
 // Returns whether the queue is empty
 bool WorkQueue::Empty() const {
-  return (most_recent_element_enqueue_timestamp_.load(
-              std::memory_order_relaxed) == kInvalidTimestamp &&
-          oldest_enqueued_timestamp_.load(std::memory_order_relaxed) ==
+  return (bottom_.load(std::memory_order_relaxed) <=
+              top_.load(std::memory_order_relaxed) &&
+          oldest_overflow_timestamp_.load(std::memory_order_relaxed) ==
               kInvalidTimestamp);
 }
 
 grpc_core::Timestamp WorkQueue::OldestEnqueuedTimestamp() const {
-  int64_t front_of_queue_timestamp =
-      oldest_enqueued_timestamp_.load(std::memory_order_relaxed);
-  if (front_of_queue_timestamp != kInvalidTimestamp) {
-    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
-        front_of_queue_timestamp);
+  int64_t top = top_.load(std::memory_order_acquire);
+  if (top < bottom_.load(std::memory_order_acquire)) {
+    int64_t ring_millis = ring_[top & (kRingSize - 1)].enqueued.load(
+        std::memory_order_relaxed);
+    if (ring_millis != kInvalidTimestamp) {
+      return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          ring_millis);
+    }
   }
-  int64_t most_recent_millis =
-      most_recent_element_enqueue_timestamp_.load(std::memory_order_relaxed);
-  if (most_recent_millis == kInvalidTimestamp) {
+  int64_t overflow_millis =
+      oldest_overflow_timestamp_.load(std::memory_order_relaxed);
+  if (overflow_millis == kInvalidTimestamp) {
     return grpc_core::Timestamp::InfPast();
   }
   return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
-      most_recent_millis);
+      overflow_millis);
 }
 
-EventEngine::Closure* WorkQueue::PopFront() ABSL_LOCKS_EXCLUDED(mu_) {
-  if (oldest_enqueued_timestamp_.load(std::memory_order_relaxed) !=
+EventEngine::Closure* WorkQueue::PopFront() {
+  // Every overflow element is newer than every ring element.
+  EventEngine::Closure* closure = RingSteal();
+  if (closure != nullptr) return closure;
+  if (oldest_overflow_timestamp_.load(std::memory_order_relaxed) !=
       kInvalidTimestamp) {
-    EventEngine::Closure* t = TryLockAndPop(/*front=*/true);
-    if (t != nullptr) return t;
-  }
-  if (most_recent_element_enqueue_timestamp_.load(std::memory_order_relaxed) !=
-      kInvalidTimestamp) {
-    return TryPopMostRecentElement();
+    return OverflowPop(/*front=*/true);
   }
   return nullptr;
 }
 
 EventEngine::Closure* WorkQueue::PopBack() {
-  if (most_recent_element_enqueue_timestamp_.load(std::memory_order_relaxed) !=
-      kInvalidTimestamp) {
-    return TryPopMostRecentElement();
-  }
-  if (oldest_enqueued_timestamp_.load(std::memory_order_relaxed) !=
+  grpc_core::MutexLock lock(&owner_mu_);
+  if (oldest_overflow_timestamp_.load(std::memory_order_relaxed) !=
       kInvalidTimestamp) {
-    EventEngine::Closure* t = TryLockAndPop(/*front=*/false);
-    if (t != nullptr) return t;
+    EventEngine::Closure* closure = OverflowPop(/*front=*/false);
+    if (closure != nullptr) return closure;
   }
-  return nullptr;
+  return RingPopBack();
 }
 
 void WorkQueue::Add(EventEngine::Closure* closure) {
@@ -110,85 +111,97 @@ void WorkQueue::Add(absl::AnyInvocable<void()> invocable) {
 }
 
 void WorkQueue::AddInternal(Storage&& storage) {
-  Storage previous_most_recent;
-  int64_t previous_ts;
-  {
-    absl::optional<Storage> tmp_element;
-    {
-      grpc_core::MutexLock lock(&most_recent_element_lock_);
-      previous_ts = most_recent_element_enqueue_timestamp_.exchange(
-          storage.enqueued(), std::memory_order_relaxed);
-      tmp_element = std::exchange(most_recent_element_, std::move(storage));
-    }
-    if (!tmp_element.has_value() || previous_ts == kInvalidTimestamp) return;
-    previous_most_recent = std::move(*tmp_element);
+  grpc_core::MutexLock lock(&owner_mu_);
+  // Only threads holding owner_mu_ add to the overflow queue, so if it is
+  // empty here it stays empty until we add to it. Keep adding to the overflow
+  // queue while it has elements so that it stays newer than the ring.
+  if (oldest_overflow_timestamp_.load(std::memory_order_relaxed) ==
+          kInvalidTimestamp &&
+      RingPush(storage)) {
+    return;
   }
-  grpc_core::MutexLock lock(&mu_);
-  if (elements_.empty()) {
-    oldest_enqueued_timestamp_.store(previous_ts, std::memory_order_relaxed);
+  grpc_core::MutexLock overflow_lock(&overflow_mu_);
+  if (overflow_.empty()) {
+    oldest_overflow_timestamp_.store(storage.enqueued(),
+                                     std::memory_order_relaxed);
   }
-  elements_.push_back(std::move(previous_most_recent));
+  overflow_.push_back(std::move(storage));
 }
 
-EventEngine::Closure* WorkQueue::TryLockAndPop(bool front)
-    ABSL_LOCKS_EXCLUDED(mu_) {
-  // Do not block the worker if there are other workers trying to pop
-  // tasks from this queue.
-  if (!mu_.TryLock()) return nullptr;
-  auto ret = PopLocked(front);
-  mu_.Unlock();
-  return ret;
+bool WorkQueue::RingPush(Storage& storage) {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  if (bottom - top >= kRingSize) return false;
+  Slot& slot = ring_[bottom & (kRingSize - 1)];
+  slot.closure.store(storage.closure(), std::memory_order_relaxed);
+  slot.enqueued.store(storage.enqueued(), std::memory_order_relaxed);
+  // Publishes the slot contents to thieves that observe the new bottom_.
+  bottom_.store(bottom + 1, std::memory_order_release);
+  return true;
 }
 
-EventEngine::Closure* WorkQueue::PopLocked(bool front)
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  if (GPR_UNLIKELY(elements_.empty())) {
-    if (most_recent_element_enqueue_timestamp_.load(
-            std::memory_order_relaxed) == kInvalidTimestamp) {
-      return nullptr;
+EventEngine::Closure* WorkQueue::RingPopBack() {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  // Reserve the most recent slot before looking at top_, so that a
+  // concurrent thief either sees the reservation or loses the race for the
+  // last element below.
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // Empty, undo the reservation.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  EventEngine::Closure* closure =
+      ring_[bottom & (kRingSize - 1)].closure.load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // This is the last element, and a thief may be trying to steal it.
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      closure = nullptr;
     }
-    if (!most_recent_element_lock_.TryLock()) return nullptr;
-    absl::optional<Storage> ret;
-    if (GPR_LIKELY(most_recent_element_.has_value())) {
-      most_recent_element_enqueue_timestamp_.store(kInvalidTimestamp,
-                                                   std::memory_order_relaxed);
-      ret = std::exchange(most_recent_element_, absl::nullopt);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+EventEngine::Closure* WorkQueue::RingSteal() {
+  int64_t top = top_.load(std::memory_order_acquire);
+  while (true) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+    EventEngine::Closure* closure =
+        ring_[top & (kRingSize - 1)].closure.load(std::memory_order_relaxed);
+    // On failure, top is reloaded and another thread made progress.
+    if (top_.compare_exchange_weak(top, top + 1, std::memory_order_seq_cst,
+                                   std::memory_order_acquire)) {
+      return closure;
     }
-    most_recent_element_lock_.Unlock();
-    return ret->closure();
   }
-  // the queue has elements, let's pop one and update timestamps
+}
+
+EventEngine::Closure* WorkQueue::OverflowPop(bool front) {
+  grpc_core::MutexLock lock(&overflow_mu_);
+  if (GPR_UNLIKELY(overflow_.empty())) return nullptr;
   Storage ret_s;
   if (front) {
-    ret_s = std::move(elements_.front());
-    elements_.pop_front();
+    ret_s = std::move(overflow_.front());
+    overflow_.pop_front();
   } else {
-    ret_s = std::move(elements_.back());
-    elements_.pop_back();
+    ret_s = std::move(overflow_.back());
+    overflow_.pop_back();
   }
-  if (elements_.empty()) {
-    oldest_enqueued_timestamp_.store(kInvalidTimestamp,
+  if (overflow_.empty()) {
+    oldest_overflow_timestamp_.store(kInvalidTimestamp,
                                      std::memory_order_relaxed);
   } else if (front) {
-    oldest_enqueued_timestamp_.store(elements_.front().enqueued(),
+    oldest_overflow_timestamp_.store(overflow_.front().enqueued(),
                                      std::memory_order_relaxed);
   }
   return ret_s.closure();
 }
 
-EventEngine::Closure* WorkQueue::TryPopMostRecentElement() {
-  if (!most_recent_element_lock_.TryLock()) return nullptr;
-  if (GPR_UNLIKELY(!most_recent_element_.has_value())) {
-    most_recent_element_lock_.Unlock();
-    return nullptr;
-  }
-  most_recent_element_enqueue_timestamp_.store(kInvalidTimestamp,
-                                               std::memory_order_relaxed);
-  absl::optional<Storage> tmp =
-      std::exchange(most_recent_element_, absl::nullopt);
-  most_recent_element_lock_.Unlock();
-  return tmp->closure();
-}
-
 }  // namespace experimental
 }  // namespace grpc_event_engine
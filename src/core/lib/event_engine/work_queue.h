@@ -35,13 +35,20 @@ namespace experimental {
 
 // A fast work queue based lightly on an internal Google implementation.
 //
-// This uses atomics to access the most recent element in the queue, making it
-// fast for LIFO operations. Accessing the oldest (next) element requires taking
-// a mutex lock.
+// Elements live in a fixed-size Chase-Lev ring. Add and PopBack operate on
+// the most recent end of the ring and are serialized by a mutex that is only
+// contended if several threads treat the same queue as their own. PopFront
+// steals the oldest element with a single CAS and never takes that mutex, so
+// work stealing threads do not contend with the owner on the fast path. Once
+// the ring is full, newer elements spill into an unbounded mutex-protected
+// overflow deque until it drains.
 class WorkQueue {
  public:
   // comparable to Timestamp::milliseconds_after_process_epoch()
   static const int64_t kInvalidTimestamp = -1;
+  // Number of elements held in the lock-free ring before spilling into the
+  // overflow queue. Must be a power of two.
+  static constexpr int64_t kRingSize = 256;
 
   WorkQueue() = default;
   // Returns whether the queue is empty
@@ -50,9 +57,9 @@ class WorkQueue {
   // enqueued.
   grpc_core::Timestamp OldestEnqueuedTimestamp() const;
   // Returns the next (oldest) element from the queue, or nullopt if empty
-  EventEngine::Closure* PopFront() ABSL_LOCKS_EXCLUDED(mu_);
+  EventEngine::Closure* PopFront() ABSL_LOCKS_EXCLUDED(owner_mu_, overflow_mu_);
   // Returns the most recent element from the queue, or nullopt if empty
-  EventEngine::Closure* PopBack();
+  EventEngine::Closure* PopBack() ABSL_LOCKS_EXCLUDED(owner_mu_, overflow_mu_);
   // Adds a closure to the back of the queue
   void Add(EventEngine::Closure* closure);
   // Wraps an AnyInvocable and adds it to the back of the queue
@@ -88,31 +95,40 @@ class WorkQueue {
     int64_t enqueued_ = kInvalidTimestamp;
   };
 
-  // Attempts to pop from the front of the queue (oldest).
-  // This will return nullopt if the queue is empty, or if other workers
-  // are already attempting to pop from this queue.
-  EventEngine::Closure* TryLockAndPop(bool front) ABSL_LOCKS_EXCLUDED(mu_);
-  // Internal implementation, helps with thread safety analysis in TryLockAndPop
-  EventEngine::Closure* PopLocked(bool front)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
-  // Attempts to pop from the back of the queue (most recent).
-  // This will return nullopt if the queue is empty, or if other workers
-  // are already attempting to pop from this queue.
-  EventEngine::Closure* TryPopMostRecentElement();
+  // A ring slot. Both fields are atomics since a thief may read a slot while
+  // the owner is refilling it; the thief's CAS on top_ fails in that case.
+  struct Slot {
+    std::atomic<EventEngine::Closure*> closure{nullptr};
+    std::atomic<int64_t> enqueued{kInvalidTimestamp};
+  };
+
   // Common code for the Add methods
-  void AddInternal(Storage&& storage);
-
-  // The managed items in the queue
-  std::deque<Storage> elements_ ABSL_GUARDED_BY(mu_);
-  // The most recently enqueued element. This is reserved from work stealing
-  absl::optional<Storage> most_recent_element_
-      ABSL_GUARDED_BY(most_recent_element_lock_);
-  grpc_core::Mutex ABSL_ACQUIRED_AFTER(mu_) most_recent_element_lock_;
+  void AddInternal(Storage&& storage) ABSL_LOCKS_EXCLUDED(owner_mu_);
+  // Pushes onto the most recent end of the ring. Returns false if the ring is
+  // full.
+  bool RingPush(Storage& storage) ABSL_EXCLUSIVE_LOCKS_REQUIRED(owner_mu_);
+  // Pops from the most recent end of the ring, or returns nullptr if empty.
+  EventEngine::Closure* RingPopBack() ABSL_EXCLUSIVE_LOCKS_REQUIRED(owner_mu_);
+  // Steals from the oldest end of the ring, or returns nullptr if empty.
+  EventEngine::Closure* RingSteal();
+  // Pops from either end of the overflow queue, or returns nullptr if empty.
+  EventEngine::Closure* OverflowPop(bool front)
+      ABSL_LOCKS_EXCLUDED(overflow_mu_);
+
+  // Serializes Add and PopBack.
+  grpc_core::Mutex owner_mu_;
+  // Ring indices. Elements in [top_, bottom_) are queued; top_ is the oldest.
   // TODO(hork): consider ABSL_CACHELINE_ALIGNED
-  std::atomic<int64_t> most_recent_element_enqueue_timestamp_{
-      kInvalidTimestamp};
-  std::atomic<int64_t> oldest_enqueued_timestamp_{kInvalidTimestamp};
-  grpc_core::Mutex mu_;
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  Slot ring_[kRingSize];
+  // Elements added while the ring was full. All of them are newer than every
+  // element in the ring, which keeps both ends of the queue ordered.
+  grpc_core::Mutex ABSL_ACQUIRED_AFTER(owner_mu_) overflow_mu_;
+  std::deque<Storage> overflow_ ABSL_GUARDED_BY(overflow_mu_);
+  // Enqueue time of the oldest overflow element, or kInvalidTimestamp if the
+  // overflow queue is empty.
+  std::atomic<int64_t> oldest_overflow_timestamp_{kInvalidTimestamp};
 };
 
 }  // namespace experimental
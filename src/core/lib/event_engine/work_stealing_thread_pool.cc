@@ -0,0 +1,277 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/work_stealing_thread_pool.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "absl/random/random.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/cpu_topology.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+// The pool state and the local queue of the current thread, if it is a
+// WorkStealingThreadPool worker thread. The state is stored type-erased since
+// it is only used for identity comparisons.
+thread_local const void* g_local_pool_state = nullptr;
+thread_local WorkQueue* g_local_queue = nullptr;
+}  // namespace
+
+// ------ WorkStealingThreadPool::TheftRegistry --------------------------------
+
+void WorkStealingThreadPool::TheftRegistry::Enroll(WorkQueue* queue) {
+  grpc_core::MutexLock lock(&mu_);
+  queues_.push_back(queue);
+}
+
+void WorkStealingThreadPool::TheftRegistry::Unenroll(WorkQueue* queue) {
+  grpc_core::MutexLock lock(&mu_);
+  auto it = std::find(queues_.begin(), queues_.end(), queue);
+  GPR_ASSERT(it != queues_.end());
+  *it = queues_.back();
+  queues_.pop_back();
+}
+
+EventEngine::Closure* WorkStealingThreadPool::TheftRegistry::StealOne(
+    WorkQueue* thief) {
+  thread_local absl::BitGen bitgen;
+  grpc_core::MutexLock lock(&mu_);
+  const size_t num_queues = queues_.size();
+  if (num_queues == 0) return nullptr;
+  // Start at a random victim so that thieves spread out over the pool.
+  const size_t start = absl::Uniform<size_t>(bitgen, 0, num_queues);
+  for (size_t i = 0; i < num_queues; i++) {
+    WorkQueue* victim = queues_[(start + i) % num_queues];
+    if (victim == thief || victim->Empty()) continue;
+    EventEngine::Closure* closure = victim->PopFront();
+    if (closure != nullptr) return closure;
+  }
+  return nullptr;
+}
+
+bool WorkStealingThreadPool::TheftRegistry::HasWork() {
+  grpc_core::MutexLock lock(&mu_);
+  for (WorkQueue* queue : queues_) {
+    if (!queue->Empty()) return true;
+  }
+  return false;
+}
+
+// ------ WorkStealingThreadPool::ThreadCount ----------------------------------
+
+void WorkStealingThreadPool::ThreadCount::Add() {
+  grpc_core::MutexLock lock(&mu_);
+  ++threads_;
+}
+
+void WorkStealingThreadPool::ThreadCount::Remove() {
+  grpc_core::MutexLock lock(&mu_);
+  --threads_;
+  cv_.Signal();
+}
+
+void WorkStealingThreadPool::ThreadCount::BlockUntilThreadCount(
+    int threads, const char* why) {
+  grpc_core::MutexLock lock(&mu_);
+  auto last_log = absl::Now();
+  while (threads_ > threads) {
+    // Wait for all threads to exit.
+    // At least once every three seconds (but no faster than once per second in
+    // the event of spurious wakeups) log a message indicating we're waiting to
+    // fork.
+    cv_.WaitWithTimeout(&mu_, absl::Seconds(3));
+    if (threads_ > threads && absl::Now() - last_log > absl::Seconds(1)) {
+      gpr_log(GPR_ERROR, "Waiting for thread pool to idle before %s", why);
+      last_log = absl::Now();
+    }
+  }
+}
+
+// ------ WorkStealingThreadPool::State ----------------------------------------
+
+EventEngine::Closure* WorkStealingThreadPool::State::FindWork(
+    WorkQueue* local_queue) {
+  // The most recently added local callback is the most likely to find its
+  // data still in cache.
+  EventEngine::Closure* closure = local_queue->PopBack();
+  if (closure != nullptr) return closure;
+  closure = global_queue.PopFront();
+  if (closure != nullptr) return closure;
+  return theft_registry.StealOne(local_queue);
+}
+
+bool WorkStealingThreadPool::State::HasWork(WorkQueue* local_queue) {
+  if (!local_queue->Empty() || !global_queue.Empty()) return true;
+  // Checking for stealable work takes the registry lock, but this is only
+  // done by threads that are about to go idle.
+  return theft_registry.HasWork();
+}
+
+bool WorkStealingThreadPool::State::WaitForWork(WorkQueue* local_queue) {
+  grpc_core::MutexLock lock(&mu);
+  if (run_state != RunState::kRunning) {
+    // Drain all queued work before exiting on shutdown or fork.
+    return HasWork(local_queue);
+  }
+  // If there are too many threads waiting, then quit this thread.
+  if (threads_waiting.load(std::memory_order_relaxed) >= reserve_threads) {
+    return HasWork(local_queue);
+  }
+  // Announce that this thread is about to sleep before re-checking the
+  // queues. Together with the fence in Add() this guarantees that either this
+  // thread sees the new callback or the producer sees a waiting thread.
+  threads_waiting.fetch_add(1, std::memory_order_seq_cst);
+  if (!HasWork(local_queue)) {
+    cv.Wait(&mu);
+  }
+  threads_waiting.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool WorkStealingThreadPool::State::WakeOne() {
+  if (threads_waiting.load(std::memory_order_seq_cst) == 0) return false;
+  grpc_core::MutexLock lock(&mu);
+  cv.Signal();
+  return true;
+}
+
+void WorkStealingThreadPool::State::SetRunState(RunState state) {
+  grpc_core::MutexLock lock(&mu);
+  if (state == RunState::kRunning) {
+    GPR_ASSERT(run_state != RunState::kRunning);
+  } else {
+    GPR_ASSERT(run_state == RunState::kRunning);
+  }
+  run_state = state;
+  forking.store(state == RunState::kForking, std::memory_order_relaxed);
+  cv.SignalAll();
+}
+
+// ------ WorkStealingThreadPool -----------------------------------------------
+
+void WorkStealingThreadPool::StartThread(StatePtr state, bool throttled) {
+  state->thread_count.Add();
+  struct ThreadArg {
+    StatePtr state;
+    bool throttled;
+  };
+  grpc_core::Thread(
+      "event_engine",
+      [](void* arg) {
+        std::unique_ptr<ThreadArg> a(static_cast<ThreadArg*>(arg));
+        if (grpc_core::IsNumaThreadPlacementEnabled()) {
+          grpc_core::PinCurrentThreadToNumaNode(
+              grpc_core::CpuTopology::Get().NextNode());
+        }
+        if (a->throttled) {
+          GPR_ASSERT(a->state->currently_starting_one_thread.exchange(
+              false, std::memory_order_relaxed));
+        }
+        ThreadFunc(a->state);
+      },
+      new ThreadArg{state, throttled}, nullptr,
+      grpc_core::Thread::Options().set_tracked(false).set_joinable(false))
+      .Start();
+}
+
+void WorkStealingThreadPool::ThreadFunc(StatePtr state) {
+  WorkQueue local_queue;
+  g_local_pool_state = state.get();
+  g_local_queue = &local_queue;
+  state->theft_registry.Enroll(&local_queue);
+  while (true) {
+    EventEngine::Closure* closure = state->FindWork(&local_queue);
+    if (closure != nullptr) {
+      closure->Run();
+      continue;
+    }
+    if (!state->WaitForWork(&local_queue)) break;
+  }
+  // Only this thread adds to its local queue, and it only exits once every
+  // queue it can see is empty.
+  state->theft_registry.Unenroll(&local_queue);
+  GPR_DEBUG_ASSERT(local_queue.Empty());
+  g_local_queue = nullptr;
+  g_local_pool_state = nullptr;
+  state->thread_count.Remove();
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(int reserve_threads)
+    : reserve_threads_(reserve_threads) {
+  for (int i = 0; i < reserve_threads; i++) {
+    StartThread(state_, /*throttled=*/false);
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  state_->SetRunState(RunState::kShutdown);
+  // Wait until all threads are exited.
+  // Note that if this is a threadpool thread then we won't exit this thread
+  // until the callstack unwinds a little, so we need to wait for just one
+  // thread running instead of zero.
+  state_->thread_count.BlockUntilThreadCount(
+      g_local_pool_state == state_.get() ? 1 : 0, "shutting down");
+}
+
+void WorkStealingThreadPool::Add(absl::AnyInvocable<void()> callback) {
+  if (g_local_pool_state == state_.get()) {
+    g_local_queue->Add(std::move(callback));
+  } else {
+    state_->global_queue.Add(std::move(callback));
+  }
+  // Pairs with the increment of threads_waiting in WaitForWork.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (state_->WakeOne()) return;
+  // Every thread is busy. New threads are not started while forking, the
+  // callback will be run once the pool restarts after the fork.
+  if (state_->forking.load(std::memory_order_relaxed)) return;
+  if (!state_->currently_starting_one_thread.exchange(
+          true, std::memory_order_relaxed)) {
+    StartThread(state_, /*throttled=*/true);
+  }
+}
+
+void WorkStealingThreadPool::PrepareFork() {
+  state_->SetRunState(RunState::kForking);
+  state_->thread_count.BlockUntilThreadCount(0, "forking");
+}
+
+void WorkStealingThreadPool::PostforkParent() { Postfork(); }
+
+void WorkStealingThreadPool::PostforkChild() { Postfork(); }
+
+void WorkStealingThreadPool::Postfork() {
+  state_->SetRunState(RunState::kRunning);
+  for (int i = 0; i < reserve_threads_; i++) {
+    StartThread(state_, /*throttled=*/false);
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
@@ -0,0 +1,136 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_WORK_STEALING_THREAD_POOL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_WORK_STEALING_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/thread_pool.h"
+#include "src/core/lib/event_engine/work_queue.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A ThreadPool in which every worker thread owns a local WorkQueue.
+//
+// Callbacks added from a worker thread go to that thread's local queue, which
+// the owner drains most-recent-first for cache locality. Callbacks added from
+// other threads go to a global queue. Idle workers first check the global
+// queue and then steal the oldest callbacks from the local queues of randomly
+// chosen peers, so the common path never touches a shared lock.
+class WorkStealingThreadPool final : public ThreadPool {
+ public:
+  explicit WorkStealingThreadPool(int reserve_threads);
+  // Ensures the thread pool is empty before destroying it.
+  ~WorkStealingThreadPool() override;
+
+  void Add(absl::AnyInvocable<void()> callback) override;
+
+  // Forkable
+  // Ensures that the thread pool is empty before forking.
+  void PrepareFork() override;
+  void PostforkParent() override;
+  void PostforkChild() override;
+
+ private:
+  enum class RunState { kRunning, kShutdown, kForking };
+
+  // The set of local queues that idle threads may steal from.
+  class TheftRegistry {
+   public:
+    void Enroll(WorkQueue* queue) ABSL_LOCKS_EXCLUDED(mu_);
+    void Unenroll(WorkQueue* queue) ABSL_LOCKS_EXCLUDED(mu_);
+    // Steals the oldest callback from a randomly chosen queue other than
+    // `thief`. Returns nullptr if nothing could be stolen.
+    EventEngine::Closure* StealOne(WorkQueue* thief) ABSL_LOCKS_EXCLUDED(mu_);
+    // Returns true if any enrolled queue is non-empty.
+    bool HasWork() ABSL_LOCKS_EXCLUDED(mu_);
+
+   private:
+    grpc_core::Mutex mu_;
+    std::vector<WorkQueue*> queues_ ABSL_GUARDED_BY(mu_);
+  };
+
+  class ThreadCount {
+   public:
+    void Add();
+    void Remove();
+    void BlockUntilThreadCount(int threads, const char* why);
+
+   private:
+    grpc_core::Mutex mu_;
+    grpc_core::CondVar cv_;
+    int threads_ ABSL_GUARDED_BY(mu_) = 0;
+  };
+
+  struct State {
+    explicit State(int reserve_threads) : reserve_threads(reserve_threads) {}
+    // Finds the next callback for a worker owning `local_queue`, in order:
+    // local queue, global queue, peers' local queues.
+    EventEngine::Closure* FindWork(WorkQueue* local_queue);
+    // Returns true if there may be queued work anywhere in the pool.
+    bool HasWork(WorkQueue* local_queue);
+    // Blocks an idle worker until work may be available. Returns false if the
+    // thread should exit instead.
+    bool WaitForWork(WorkQueue* local_queue);
+    // Wakes one idle thread, if there is one. Returns false if no thread was
+    // idle.
+    bool WakeOne();
+    void SetRunState(RunState state);
+
+    const int reserve_threads;
+    WorkQueue global_queue;
+    TheftRegistry theft_registry;
+    ThreadCount thread_count;
+    grpc_core::Mutex mu;
+    grpc_core::CondVar cv;
+    RunState run_state ABSL_GUARDED_BY(mu) = RunState::kRunning;
+    // Mirrors run_state == kForking for lock-free reads from Add().
+    std::atomic<bool> forking{false};
+    // Number of threads blocked in WaitForWork. Producers read it without
+    // holding the lock to skip signalling when every thread is busy.
+    std::atomic<int> threads_waiting{0};
+    // After pool creation we use this to rate limit creation of threads to one
+    // at a time.
+    std::atomic<bool> currently_starting_one_thread{false};
+  };
+
+  using StatePtr = std::shared_ptr<State>;
+
+  static void ThreadFunc(StatePtr state);
+  // Start a new thread; throttled indicates whether the
+  // State::currently_starting_one_thread variable is being used to throttle
+  // this thread's creation against others or not.
+  static void StartThread(StatePtr state, bool throttled);
+  void Postfork();
+
+  const int reserve_threads_;
+  const StatePtr state_ = std::make_shared<State>(reserve_threads_);
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_WORK_STEALING_THREAD_POOL_H
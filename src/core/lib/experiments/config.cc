@@ -55,10 +55,12 @@ std::atomic<bool> g_loaded;
 
 GPR_ATTRIBUTE_NOINLINE Experiments LoadExperimentsFromConfigVariable() {
   GPR_ASSERT(g_loaded.exchange(true, std::memory_order_relaxed) == false);
-  // Set defaults from metadata.
+  // Set defaults from metadata, or from what the test forced.
   Experiments experiments;
   for (size_t i = 0; i < kNumExperiments; i++) {
-    experiments.enabled[i] = g_experiment_metadata[i].default_value;
+    experiments.enabled[i] = g_forced_experiments[i].forced
+                                 ? g_forced_experiments[i].value
+                                 : g_experiment_metadata[i].default_value;
   }
   // Get the global config.
   auto experiments_str = GPR_GLOBAL_CONFIG_GET(grpc_experiments);
@@ -48,6 +48,129 @@ const char* const description_event_engine_client =
     "Use EventEngine clients instead of iomgr's grpc_tcp_client";
 const char* const description_monitoring_experiment =
     "Placeholder experiment to prove/disprove our monitoring is working";
+const char* const description_work_stealing =
+    "If set, use a work stealing thread pool implementation in EventEngine";
+const char* const description_timer_wheel =
+    "If set, use hierarchical timer wheels instead of heaps to track iomgr and "
+    "EventEngine timers";
+const char* const description_chttp2_hashed_stream_map =
+    "If set, chttp2 transports track their streams in an open addressing hash "
+    "table instead of a sorted array";
+const char* const description_hpack_encoder_literal_cache =
+    "If set, HPACK encoders share a process wide cache of the encoded literal "
+    "form of frequently sent headers, so new connections do not re-encode them.";
+const char* const description_per_cpu_memory_quota =
+    "If set, memory quotas keep a per-CPU cache of free bytes so that "
+    "allocators on different cores do not contend on a single counter.";
+const char* const description_arena_block_cache =
+    "If set, destroyed call arenas return their initial block to a thread "
+    "local free list sized by power of two, so steady state call creation does "
+    "not allocate.";
+const char* const description_adaptive_tcp_zerocopy_threshold =
+    "Move the TCP MSG_ZEROCOPY send threshold according to the observed cost "
+    "of copying and zerocopy sends on each endpoint.";
+const char* const description_numa_thread_placement =
+    "If set, EventEngine thread pool threads are spread round robin over the "
+    "NUMA nodes, the threads of each C++ sync server completion queue share a "
+    "node, and each such thread only runs on the CPUs of its node, so the "
+    "memory it touches stays node local.";
+const char* const description_dns_result_cache =
+    "If set, the DNS resolvers of all channels share one cache of lookup "
+    "results, so that concurrent lookups of the same name are made once and "
+    "recent results are reused by new channels.";
+const char* const description_kernel_tls =
+    "Hand the protection of TLS 1.2 connections over to the kernel (Linux "
+    "kTLS) after the handshake, when the session and the kernel support it.";
+const char* const description_ssl_zero_copy_protector =
+    "Protect TLS connections with a zero-copy frame protector, which seals the "
+    "records straight from the application slices.";
+const char* const description_handshake_thread_pool =
+    "Run the steps of security handshakers on a bounded thread pool instead of "
+    "the I/O thread that read the handshake bytes, and reject new handshakes "
+    "while the pool is backed up.";
+const char* const description_tls_verification_cache =
+    "Skip the verification of peer certificate chains that a TLS handshaker "
+    "factory has verified recently.";
+const char* const description_shared_oauth2_token_cache =
+    "Share the OAuth2 access tokens fetched by call credentials with the other "
+    "credentials objects in the process that fetch the same tokens.";
+const char* const description_hpack_index_authorization =
+    "If set, HPACK encoders add the authorization header of the calls to the "
+    "dynamic table, so that the calls of a connection sharing a token send it "
+    "once.";
+const char* const description_chttp2_parallel_stream_delivery =
+    "If set, chttp2 transports complete the receive ops of their streams on "
+    "the event engine's threads, one serial queue per stream, instead of on "
+    "the thread reading from the connection.";
+const char* const description_model_based_flow_control =
+    "If set, chttp2 transports size their windows from the bandwidth and round "
+    "trip time their BDP pings measure, capped by memory pressure, instead of "
+    "smoothing the BDP estimate with a PID controller.";
+const char* const description_adaptive_frame_size =
+    "Size the DATA frames of streams that share a connection with others to "
+    "what the peer drains in a millisecond, and interleave them frame by frame.";
+const char* const description_chttp2_weighted_fair_writes =
+    "Share a connection between the calls writing data on it by deficit round "
+    "robin, in proportion to the weights they set in grpc-write-weight.";
+const char* const description_hpack_table_arena =
+    "Copy the keys and values of HPACK dynamic table entries into a few large "
+    "per-connection arenas, instead of a buffer per entry or a reference to "
+    "the read buffer they arrived in.";
+const char* const description_keepalive_coalescing =
+    "Align the keepalive timers of chttp2 transports to coarse slots so that "
+    "idle connections wake up together, and let reads since the last keepalive "
+    "ping (including BDP ping acks) stand in for the next one, rather than "
+    "rearming the timer on every read.";
+const char* const description_epoll_batched_events =
+    "Have the designated poller of the epoll1 engine process the readiness of "
+    "up to 16 fds per pollset_work, instead of one, so that busy servers with "
+    "many connections spend less time handing off the poller between events.";
+const char* const description_fused_filters =
+    "Replace runs of adjacent promise based filters that have a registered "
+    "fused equivalent (the client authority and auth filters) by a single "
+    "filter composing them, saving a call element and the promise adapter of "
+    "each filter composed.";
+const char* const description_connected_channel_inline_callbacks =
+    "Have the connected channel run the callbacks of the transport in the call "
+    "combiner right away when it is free, instead of scheduling them on the "
+    "ExecCtx a second time, saving a closure bounce per op on the batch based "
+    "call path.";
+const char* const description_call_combiner_inline_start =
+    "Run the closure started on a free call combiner right away rather than "
+    "through the ExecCtx, up to a small nesting depth per thread.";
+const char* const description_work_serializer_offload =
+    "Hand the remainder of a long WorkSerializer drain to the EventEngine, so "
+    "that control plane work does not hold a data plane thread.";
+const char* const description_service_config_cache =
+    "Share the ServiceConfig parsed from the same JSON and channel args "
+    "between resolver updates and channels, rather than parsing it again.";
+const char* const description_channel_stack_cache =
+    "Reuse the filter list computed for a channel stack without a transport "
+    "when another is built from the same channel args.";
+const char* const description_epoll_sharded_sets =
+    "Spread the fds of the epoll1 engine over one epoll set per pollset "
+    "neighborhood, each with a designated poller of its own, and register "
+    "listening sockets with EPOLLEXCLUSIVE, so that many threads can poll at "
+    "once on hosts with many cores and connections.";
+const char* const description_timerfd_timers =
+    "Arm a timerfd in the epoll set of the epoll1 engine for the next timer, "
+    "so that the designated poller runs timers as they expire, and the timer "
+    "manager threads only step in when nobody is polling.";
+const char* const description_event_engine_dns =
+    "Look names up for the native DNS resolver through the EventEngine's "
+    "DNSResolver, which bounds how many lookups block at once and coalesces "
+    "lookups of the same name, instead of on the iomgr executor.";
+const char* const description_event_engine_executor =
+    "Run closures scheduled on the iomgr executor on the default EventEngine's "
+    "thread pool instead of on executor threads of their own.";
+const char* const description_chttp2_confined_read_slices =
+    "Count the refs chttp2 takes on the slices it reads with plain loads and "
+    "stores while the transport's combiner parses them, making the refs "
+    "atomic only once the parsed frames leave the read.";
+const char* const description_epoll1_background_poller =
+    "Poll the fds of the epoll1 engine from a thread of its own, which blocks "
+    "until they have events, so that client channels and TCP writes make "
+    "progress without any periodic backup poller.";
 #ifdef NDEBUG
 const bool kDefaultForDebugOnly = false;
 #else
@@ -73,6 +196,47 @@ const ExperimentMetadata g_experiment_metadata[] = {
      kDefaultForDebugOnly},
     {"event_engine_client", description_event_engine_client, false},
     {"monitoring_experiment", description_monitoring_experiment, true},
+    {"work_stealing", description_work_stealing, false},
+    {"timer_wheel", description_timer_wheel, false},
+    {"chttp2_hashed_stream_map", description_chttp2_hashed_stream_map, false},
+    {"hpack_encoder_literal_cache", description_hpack_encoder_literal_cache,
+     false},
+    {"per_cpu_memory_quota", description_per_cpu_memory_quota, false},
+    {"arena_block_cache", description_arena_block_cache, false},
+    {"adaptive_tcp_zerocopy_threshold",
+     description_adaptive_tcp_zerocopy_threshold, false},
+    {"numa_thread_placement", description_numa_thread_placement, false},
+    {"dns_result_cache", description_dns_result_cache, false},
+    {"kernel_tls", description_kernel_tls, false},
+    {"ssl_zero_copy_protector", description_ssl_zero_copy_protector, false},
+    {"handshake_thread_pool", description_handshake_thread_pool, false},
+    {"tls_verification_cache", description_tls_verification_cache, false},
+    {"shared_oauth2_token_cache", description_shared_oauth2_token_cache, false},
+    {"hpack_index_authorization", description_hpack_index_authorization, false},
+    {"chttp2_parallel_stream_delivery",
+     description_chttp2_parallel_stream_delivery, false},
+    {"model_based_flow_control", description_model_based_flow_control, false},
+    {"adaptive_frame_size", description_adaptive_frame_size, false},
+    {"chttp2_weighted_fair_writes", description_chttp2_weighted_fair_writes,
+     false},
+    {"hpack_table_arena", description_hpack_table_arena, false},
+    {"keepalive_coalescing", description_keepalive_coalescing, false},
+    {"epoll_batched_events", description_epoll_batched_events, false},
+    {"fused_filters", description_fused_filters, false},
+    {"connected_channel_inline_callbacks",
+     description_connected_channel_inline_callbacks, false},
+    {"call_combiner_inline_start", description_call_combiner_inline_start,
+     false},
+    {"work_serializer_offload", description_work_serializer_offload, false},
+    {"service_config_cache", description_service_config_cache, false},
+    {"channel_stack_cache", description_channel_stack_cache, false},
+    {"epoll_sharded_sets", description_epoll_sharded_sets, false},
+    {"timerfd_timers", description_timerfd_timers, false},
+    {"event_engine_dns", description_event_engine_dns, false},
+    {"event_engine_executor", description_event_engine_executor, false},
+    {"chttp2_confined_read_slices", description_chttp2_confined_read_slices,
+     false},
+    {"epoll1_background_poller", description_epoll1_background_poller, false},
 };
 
 }  // namespace grpc_core
@@ -42,6 +42,60 @@ inline bool IsUnconstrainedMaxQuotaBufferSizeEnabled() {
 inline bool IsNewHpackHuffmanDecoderEnabled() { return IsExperimentEnabled(8); }
 inline bool IsEventEngineClientEnabled() { return IsExperimentEnabled(9); }
 inline bool IsMonitoringExperimentEnabled() { return IsExperimentEnabled(10); }
+inline bool IsWorkStealingEnabled() { return IsExperimentEnabled(11); }
+inline bool IsTimerWheelEnabled() { return IsExperimentEnabled(12); }
+inline bool IsChttp2HashedStreamMapEnabled() { return IsExperimentEnabled(13); }
+inline bool IsHpackEncoderLiteralCacheEnabled() {
+  return IsExperimentEnabled(14);
+}
+inline bool IsPerCpuMemoryQuotaEnabled() { return IsExperimentEnabled(15); }
+inline bool IsArenaBlockCacheEnabled() { return IsExperimentEnabled(16); }
+inline bool IsAdaptiveTcpZerocopyThresholdEnabled() {
+  return IsExperimentEnabled(17);
+}
+inline bool IsNumaThreadPlacementEnabled() { return IsExperimentEnabled(18); }
+inline bool IsDnsResultCacheEnabled() { return IsExperimentEnabled(19); }
+inline bool IsKernelTlsEnabled() { return IsExperimentEnabled(20); }
+inline bool IsSslZeroCopyProtectorEnabled() { return IsExperimentEnabled(21); }
+inline bool IsHandshakeThreadPoolEnabled() { return IsExperimentEnabled(22); }
+inline bool IsTlsVerificationCacheEnabled() { return IsExperimentEnabled(23); }
+inline bool IsSharedOauth2TokenCacheEnabled() {
+  return IsExperimentEnabled(24);
+}
+inline bool IsHpackIndexAuthorizationEnabled() {
+  return IsExperimentEnabled(25);
+}
+inline bool IsChttp2ParallelStreamDeliveryEnabled() {
+  return IsExperimentEnabled(26);
+}
+inline bool IsModelBasedFlowControlEnabled() { return IsExperimentEnabled(27); }
+inline bool IsAdaptiveFrameSizeEnabled() { return IsExperimentEnabled(28); }
+inline bool IsChttp2WeightedFairWritesEnabled() {
+  return IsExperimentEnabled(29);
+}
+inline bool IsHpackTableArenaEnabled() { return IsExperimentEnabled(30); }
+inline bool IsKeepaliveCoalescingEnabled() { return IsExperimentEnabled(31); }
+inline bool IsEpollBatchedEventsEnabled() { return IsExperimentEnabled(32); }
+inline bool IsFusedFiltersEnabled() { return IsExperimentEnabled(33); }
+inline bool IsConnectedChannelInlineCallbacksEnabled() {
+  return IsExperimentEnabled(34);
+}
+inline bool IsCallCombinerInlineStartEnabled() {
+  return IsExperimentEnabled(35);
+}
+inline bool IsWorkSerializerOffloadEnabled() { return IsExperimentEnabled(36); }
+inline bool IsServiceConfigCacheEnabled() { return IsExperimentEnabled(37); }
+inline bool IsChannelStackCacheEnabled() { return IsExperimentEnabled(38); }
+inline bool IsEpollShardedSetsEnabled() { return IsExperimentEnabled(39); }
+inline bool IsTimerfdTimersEnabled() { return IsExperimentEnabled(40); }
+inline bool IsEventEngineDnsEnabled() { return IsExperimentEnabled(41); }
+inline bool IsEventEngineExecutorEnabled() { return IsExperimentEnabled(42); }
+inline bool IsChttp2ConfinedReadSlicesEnabled() {
+  return IsExperimentEnabled(43);
+}
+inline bool IsEpoll1BackgroundPollerEnabled() {
+  return IsExperimentEnabled(44);
+}
 
 struct ExperimentMetadata {
   const char* name;
@@ -49,7 +103,7 @@ struct ExperimentMetadata {
   bool default_value;
 };
 
-constexpr const size_t kNumExperiments = 11;
+constexpr const size_t kNumExperiments = 45;
 extern const ExperimentMetadata g_experiment_metadata[kNumExperiments];
 
 }  // namespace grpc_core
@@ -0,0 +1,159 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/cpu_topology.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#ifdef GPR_LINUX
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+#ifdef GPR_LINUX
+constexpr char kSysfsNodeDir[] = "/sys/devices/system/node";
+
+absl::optional<std::vector<int>> ReadNodeCpus(const std::string& node_dir) {
+  FILE* f = fopen((node_dir + "/cpulist").c_str(), "r");
+  if (f == nullptr) return absl::nullopt;
+  char buf[4096];
+  size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+  fclose(f);
+  buf[n] = '\0';
+  return ParseCpuList(absl::StripAsciiWhitespace(buf));
+}
+
+// Returns the CPUs of each node listed in sysfs, in node order.
+std::vector<std::vector<int>> DiscoverNodes() {
+  std::vector<std::pair<int, std::vector<int>>> nodes;
+  DIR* dir = opendir(kSysfsNodeDir);
+  if (dir == nullptr) return {};
+  while (struct dirent* entry = readdir(dir)) {
+    absl::string_view name(entry->d_name);
+    int node;
+    if (!absl::ConsumePrefix(&name, "node") || !absl::SimpleAtoi(name, &node)) {
+      continue;
+    }
+    auto cpus = ReadNodeCpus(absl::StrCat(kSysfsNodeDir, "/", entry->d_name));
+    if (!cpus.has_value()) {
+      gpr_log(GPR_INFO, "Could not read the CPUs of NUMA node %d", node);
+      continue;
+    }
+    nodes.emplace_back(node, std::move(*cpus));
+  }
+  closedir(dir);
+  std::sort(nodes.begin(), nodes.end());
+  std::vector<std::vector<int>> result;
+  for (auto& node : nodes) result.push_back(std::move(node.second));
+  return result;
+}
+#else
+std::vector<std::vector<int>> DiscoverNodes() { return {}; }
+#endif
+
+}  // namespace
+
+CpuTopology::CpuTopology(std::vector<std::vector<int>> nodes) {
+  for (auto& cpus : nodes) {
+    if (!cpus.empty()) nodes_.push_back(std::move(cpus));
+  }
+  if (nodes_.empty()) nodes_.push_back({0});
+}
+
+const CpuTopology& CpuTopology::Get() {
+  static const CpuTopology* topology = [] {
+    std::vector<std::vector<int>> nodes = DiscoverNodes();
+    if (nodes.empty()) {
+      std::vector<int> cpus(gpr_cpu_num_cores());
+      for (size_t i = 0; i < cpus.size(); i++) cpus[i] = static_cast<int>(i);
+      nodes.push_back(std::move(cpus));
+    }
+    return new CpuTopology(std::move(nodes));
+  }();
+  return *topology;
+}
+
+absl::optional<size_t> CpuTopology::NodeOfCpu(int cpu) const {
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    if (std::binary_search(nodes_[i].begin(), nodes_[i].end(), cpu)) return i;
+  }
+  return absl::nullopt;
+}
+
+absl::optional<std::vector<int>> ParseCpuList(absl::string_view cpulist) {
+  std::vector<int> cpus;
+  if (cpulist.empty()) return cpus;
+  for (absl::string_view range : absl::StrSplit(cpulist, ',')) {
+    std::pair<absl::string_view, absl::string_view> bounds =
+        absl::StrSplit(range, absl::MaxSplits('-', 1));
+    int first;
+    int last;
+    if (!absl::SimpleAtoi(bounds.first, &first) || first < 0) {
+      return absl::nullopt;
+    }
+    if (bounds.second.empty() && range.back() != '-') {
+      last = first;
+    } else if (!absl::SimpleAtoi(bounds.second, &last) || last < first) {
+      return absl::nullopt;
+    }
+    for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+bool PinCurrentThreadToNumaNode(size_t node) {
+  const CpuTopology& topology = CpuTopology::Get();
+  if (node >= topology.num_nodes()) return false;
+#ifdef GPR_LINUX
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu : topology.CpusOfNode(node)) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpus);
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (err != 0) {
+    gpr_log(GPR_ERROR, "Failed to pin thread to NUMA node %" PRIuPTR ": %s",
+            node, strerror(err));
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace grpc_core
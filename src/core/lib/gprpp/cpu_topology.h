@@ -0,0 +1,70 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_CPU_TOPOLOGY_H
+#define GRPC_CORE_LIB_GPRPP_CPU_TOPOLOGY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace grpc_core {
+
+// The CPUs of the machine, grouped by NUMA node.
+class CpuTopology {
+ public:
+  // Node i holds the CPUs in nodes[i]. Empty nodes are dropped; if no node is
+  // left a single node with CPU 0 is used.
+  explicit CpuTopology(std::vector<std::vector<int>> nodes);
+
+  // The topology of this machine, discovered once. On Linux it is read from
+  // /sys/devices/system/node; elsewhere, or if that fails, all CPUs are put in
+  // a single node.
+  static const CpuTopology& Get();
+
+  size_t num_nodes() const { return nodes_.size(); }
+  const std::vector<int>& CpusOfNode(size_t node) const {
+    return nodes_[node];
+  }
+  // Returns the node of \a cpu, or nullopt for an unknown CPU.
+  absl::optional<size_t> NodeOfCpu(int cpu) const;
+
+  // Returns nodes round robin, for spreading threads or pools over the
+  // machine.
+  size_t NextNode() const {
+    return next_node_.fetch_add(1, std::memory_order_relaxed) % nodes_.size();
+  }
+
+ private:
+  std::vector<std::vector<int>> nodes_;
+  mutable std::atomic<size_t> next_node_{0};
+};
+
+// Parses a Linux cpulist such as "0-3,8,10-11" into a sorted list of CPUs.
+// Returns nullopt if \a cpulist is malformed.
+absl::optional<std::vector<int>> ParseCpuList(absl::string_view cpulist);
+
+// Restricts the calling thread to the CPUs of \a node of
+// CpuTopology::Get(). Returns false if that is not supported or fails.
+bool PinCurrentThreadToNumaNode(size_t node);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_CPU_TOPOLOGY_H
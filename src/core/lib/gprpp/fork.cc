@@ -20,8 +20,9 @@
 
 #include "src/core/lib/gprpp/fork.h"
 
+#include <stdint.h>
+
 #include <grpc/impl/codegen/gpr_types.h>
-#include <grpc/support/atm.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
@@ -45,77 +46,124 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_enable_fork_support,
 
 namespace grpc_core {
 namespace {
-// The exec_ctx_count has 2 modes, blocked and unblocked.
-// When unblocked, the count is 2-indexed; exec_ctx_count=2 indicates
-// 0 active ExecCtxs, exex_ctx_count=3 indicates 1 active ExecCtxs...
-
-// When blocked, the exec_ctx_count is 0-indexed.  Note that ExecCtx
-// creation can only be blocked if there is exactly 1 outstanding ExecCtx,
-// meaning that BLOCKED and UNBLOCKED counts partition the integers
-#define UNBLOCKED(n) ((n) + 2)
-#define BLOCKED(n) (n)
+// Each thread counts its own active ExecCtxs, in a slot of its own, so that
+// creating one does not contend with other threads for a shared count. The
+// slots are only added up when a fork is about to happen.
+//
+// Slots are never freed: a thread returns its slot for reuse when it exits.
+// Nothing here takes a lock either, so that a thread caught registering by
+// fork() leaves nothing locked in the child.
+struct ExecCtxSlot {
+  // Written only by the thread that owns the slot.
+  std::atomic<intptr_t> count{0};
+  std::atomic<bool> in_use{true};
+  ExecCtxSlot* next = nullptr;
+};
 
 class ExecCtxState {
  public:
-  ExecCtxState() : fork_complete_(true) {
+  ExecCtxState() {
     gpr_mu_init(&mu_);
     gpr_cv_init(&cv_);
-    gpr_atm_no_barrier_store(&count_, UNBLOCKED(0));
   }
 
-  void IncExecCtxCount() {
-    gpr_atm count = gpr_atm_no_barrier_load(&count_);
+  void IncExecCtxCount(ExecCtxSlot* slot) {
+    const intptr_t count = slot->count.load(std::memory_order_relaxed);
     while (true) {
-      if (count <= BLOCKED(1)) {
-        // This only occurs if we are trying to fork.  Wait until the fork()
-        // operation completes before allowing new ExecCtxs.
-        gpr_mu_lock(&mu_);
-        if (gpr_atm_no_barrier_load(&count_) <= BLOCKED(1)) {
-          while (!fork_complete_) {
-            gpr_cv_wait(&cv_, &mu_, gpr_inf_future(GPR_CLOCK_REALTIME));
-          }
-        }
-        gpr_mu_unlock(&mu_);
-      } else if (gpr_atm_no_barrier_cas(&count_, count, count + 1)) {
-        break;
+      // Pairs with BlockExecCtx(): either it sees this ExecCtx in the sum,
+      // or this sees that ExecCtx creation is blocked.
+      slot->count.store(count + 1, std::memory_order_seq_cst);
+      if (GPR_LIKELY(!blocked_.load(std::memory_order_seq_cst))) return;
+      // This only occurs if we are trying to fork.  Wait until the fork()
+      // operation completes before allowing new ExecCtxs.
+      slot->count.store(count, std::memory_order_relaxed);
+      gpr_mu_lock(&mu_);
+      while (blocked_.load(std::memory_order_relaxed)) {
+        gpr_cv_wait(&cv_, &mu_, gpr_inf_future(GPR_CLOCK_REALTIME));
       }
-      count = gpr_atm_no_barrier_load(&count_);
+      gpr_mu_unlock(&mu_);
     }
   }
 
-  void DecExecCtxCount() { gpr_atm_no_barrier_fetch_add(&count_, -1); }
+  void DecExecCtxCount(ExecCtxSlot* slot) {
+    slot->count.store(slot->count.load(std::memory_order_relaxed) - 1,
+                      std::memory_order_relaxed);
+  }
 
   bool BlockExecCtx() {
+    bool expected = false;
+    if (!blocked_.compare_exchange_strong(expected, true,
+                                          std::memory_order_seq_cst)) {
+      return false;
+    }
     // Assumes there is an active ExecCtx when this function is called
-    if (gpr_atm_no_barrier_cas(&count_, UNBLOCKED(1), BLOCKED(1))) {
-      gpr_mu_lock(&mu_);
-      fork_complete_ = false;
-      gpr_mu_unlock(&mu_);
-      return true;
+    intptr_t total = 0;
+    for (ExecCtxSlot* slot = slots_.load(std::memory_order_acquire);
+         slot != nullptr; slot = slot->next) {
+      total += slot->count.load(std::memory_order_seq_cst);
     }
+    if (total == 1) return true;
+    AllowExecCtx();
     return false;
   }
 
   void AllowExecCtx() {
     gpr_mu_lock(&mu_);
-    gpr_atm_no_barrier_store(&count_, UNBLOCKED(0));
-    fork_complete_ = true;
+    blocked_.store(false, std::memory_order_seq_cst);
     gpr_cv_broadcast(&cv_);
     gpr_mu_unlock(&mu_);
   }
 
+  ExecCtxSlot* AcquireSlot() {
+    for (ExecCtxSlot* slot = slots_.load(std::memory_order_acquire);
+         slot != nullptr; slot = slot->next) {
+      if (!slot->in_use.load(std::memory_order_relaxed) &&
+          !slot->in_use.exchange(true, std::memory_order_acquire)) {
+        return slot;
+      }
+    }
+    auto* slot = new ExecCtxSlot();
+    slot->next = slots_.load(std::memory_order_relaxed);
+    while (!slots_.compare_exchange_weak(slot->next, slot,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+    return slot;
+  }
+
   ~ExecCtxState() {
     gpr_mu_destroy(&mu_);
     gpr_cv_destroy(&cv_);
   }
 
  private:
-  bool fork_complete_;
+  // Only cleared with mu_ held, so that waiters do not miss it.
+  std::atomic<bool> blocked_{false};
   gpr_mu mu_;
   gpr_cv cv_;
-  gpr_atm count_;
+  std::atomic<ExecCtxSlot*> slots_{nullptr};
+};
+
+// Owns the slot of a thread, and returns it for reuse when the thread exits.
+class ThreadExecCtxSlot {
+ public:
+  ~ThreadExecCtxSlot() {
+    if (slot_ != nullptr) slot_->in_use.store(false, std::memory_order_release);
+  }
+
+  ExecCtxSlot* Get() {
+    if (GPR_UNLIKELY(slot_ == nullptr)) {
+      slot_ = NoDestructSingleton<ExecCtxState>::Get()->AcquireSlot();
+    }
+    return slot_;
+  }
+
+ private:
+  ExecCtxSlot* slot_ = nullptr;
 };
 
+thread_local ThreadExecCtxSlot g_exec_ctx_slot;
+
 class ThreadState {
  public:
   ThreadState() : awaiting_threads_(false), threads_done_(false), count_(0) {
@@ -182,11 +230,13 @@ void Fork::Enable(bool enable) {
 }
 
 void Fork::DoIncExecCtxCount() {
-  NoDestructSingleton<ExecCtxState>::Get()->IncExecCtxCount();
+  NoDestructSingleton<ExecCtxState>::Get()->IncExecCtxCount(
+      g_exec_ctx_slot.Get());
 }
 
 void Fork::DoDecExecCtxCount() {
-  NoDestructSingleton<ExecCtxState>::Get()->DecExecCtxCount();
+  NoDestructSingleton<ExecCtxState>::Get()->DecExecCtxCount(
+      g_exec_ctx_slot.Get());
 }
 
 void Fork::SetResetChildPollingEngineFunc(
@@ -0,0 +1,151 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/mutex_contention_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+namespace grpc_core {
+
+namespace {
+
+// Where each mutex was last taken, by hash of its address. Mutexes sharing a
+// slot may have their holders mixed up.
+constexpr size_t kHolderSlots = 4096;
+
+struct HolderSlot {
+  std::atomic<const char*> file{nullptr};
+  std::atomic<int> line{0};
+};
+
+HolderSlot g_holders[kHolderSlots];
+
+HolderSlot& HolderSlotFor(const void* mu) {
+  uintptr_t p = reinterpret_cast<uintptr_t>(mu);
+  return g_holders[((p >> 4) ^ (p >> 16)) % kHolderSlots];
+}
+
+// Pairs of call sites beyond this many are not recorded.
+constexpr size_t kMaxSites = 1024;
+
+struct SiteTable {
+  using Key = std::tuple<absl::string_view, int, absl::string_view, int>;
+
+  SiteTable() { gpr_mu_init(&mu); }
+
+  // A gpr_mu rather than a Mutex, so that contention on it is not itself
+  // profiled.
+  gpr_mu mu;
+  std::map<Key, MutexContentionProfiler::Site> sites;
+};
+
+SiteTable* Sites() {
+  static SiteTable* sites = new SiteTable();
+  return sites;
+}
+
+thread_local uint32_t g_contended_acquisitions = 0;
+
+int64_t NowNs() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+}  // namespace
+
+std::atomic<uint32_t> MutexContentionProfiler::sample_period_{0};
+
+void MutexContentionProfiler::Start(uint32_t sample_period) {
+  sample_period_.store(sample_period, std::memory_order_relaxed);
+}
+
+std::vector<MutexContentionProfiler::Site> MutexContentionProfiler::TopSites(
+    size_t max_sites) {
+  std::vector<Site> sites;
+  SiteTable* table = Sites();
+  gpr_mu_lock(&table->mu);
+  sites.reserve(table->sites.size());
+  for (const auto& p : table->sites) sites.push_back(p.second);
+  gpr_mu_unlock(&table->mu);
+  std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) {
+    return a.total_wait_ns > b.total_wait_ns;
+  });
+  if (sites.size() > max_sites) sites.resize(max_sites);
+  return sites;
+}
+
+void MutexContentionProfiler::Reset() {
+  SiteTable* table = Sites();
+  gpr_mu_lock(&table->mu);
+  table->sites.clear();
+  gpr_mu_unlock(&table->mu);
+}
+
+MutexContentionProfiler::Wait MutexContentionProfiler::BeginWait(
+    const void* mu) {
+  Wait wait;
+  const uint32_t sample_period = sample_period_.load(std::memory_order_relaxed);
+  if (sample_period == 0 || ++g_contended_acquisitions % sample_period != 0) {
+    return wait;
+  }
+  HolderSlot& slot = HolderSlotFor(mu);
+  const char* file = slot.file.load(std::memory_order_relaxed);
+  if (file != nullptr) {
+    wait.holder =
+        SourceLocation(file, slot.line.load(std::memory_order_relaxed));
+  }
+  wait.start_ns = NowNs();
+  return wait;
+}
+
+void MutexContentionProfiler::EndWait(const Wait& wait,
+                                      const SourceLocation& waiter) {
+  if (wait.start_ns < 0) return;
+  const int64_t wait_ns = NowNs() - wait.start_ns;
+  const SiteTable::Key key(wait.holder.file(), wait.holder.line(),
+                           waiter.file(), waiter.line());
+  SiteTable* table = Sites();
+  gpr_mu_lock(&table->mu);
+  auto it = table->sites.find(key);
+  if (it == table->sites.end() && table->sites.size() < kMaxSites) {
+    it = table->sites.emplace(key, Site()).first;
+    it->second.holder = wait.holder;
+    it->second.waiter = waiter;
+  }
+  if (it != table->sites.end()) {
+    Site& site = it->second;
+    ++site.contentions;
+    site.total_wait_ns += wait_ns;
+    site.max_wait_ns = std::max(site.max_wait_ns, wait_ns);
+  }
+  gpr_mu_unlock(&table->mu);
+}
+
+void MutexContentionProfiler::SetHolder(const void* mu,
+                                        const SourceLocation& location) {
+  HolderSlot& slot = HolderSlotFor(mu);
+  slot.file.store(location.file(), std::memory_order_relaxed);
+  slot.line.store(location.line(), std::memory_order_relaxed);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,81 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_MUTEX_CONTENTION_PROFILER_H
+#define GRPC_CORE_LIB_GPRPP_MUTEX_CONTENTION_PROFILER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "src/core/lib/gprpp/debug_location.h"
+
+namespace grpc_core {
+
+// Samples contention on the mutexes taken through MutexLock and
+// ReleasableMutexLock (see sync.h), attributing the time a thread waited to
+// the call sites of the waiter and of the holder it waited for.
+//
+// While stopped, a lock pays one relaxed load. While started, every lock
+// first tries to take the mutex and remembers where it was taken; one in
+// every sample_period acquisitions that find the mutex held is timed and
+// recorded. The holder is the last call site that took the mutex through
+// MutexLock, so a mutex also taken by other means may be misattributed.
+class MutexContentionProfiler {
+ public:
+  struct Site {
+    SourceLocation holder{"<unknown>", -1};
+    SourceLocation waiter{"<unknown>", -1};
+    // Sampled contended acquisitions, and how long they waited in total and
+    // at most.
+    uint64_t contentions = 0;
+    int64_t total_wait_ns = 0;
+    int64_t max_wait_ns = 0;
+  };
+
+  // Starts sampling one in every sample_period contended acquisitions, or
+  // stops if sample_period is 0. What has been recorded is kept.
+  static void Start(uint32_t sample_period);
+  static void Stop() { Start(0); }
+  static bool enabled() {
+    return sample_period_.load(std::memory_order_relaxed) != 0;
+  }
+
+  // Returns up to max_sites pairs of holder and waiter call sites, most
+  // waited on first.
+  static std::vector<Site> TopSites(size_t max_sites);
+  // Forgets what has been recorded.
+  static void Reset();
+
+  // For sync.h: a contended acquisition of mu at location begins and ends.
+  struct Wait {
+    SourceLocation holder{"<unknown>", -1};
+    int64_t start_ns = -1;
+  };
+  static Wait BeginWait(const void* mu);
+  static void EndWait(const Wait& wait, const SourceLocation& waiter);
+  // For sync.h: mu has been taken at location.
+  static void SetHolder(const void* mu, const SourceLocation& location);
+
+ private:
+  static std::atomic<uint32_t> sample_period_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_MUTEX_CONTENTION_PROFILER_H
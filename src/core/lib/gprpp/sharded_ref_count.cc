@@ -0,0 +1,44 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/sharded_ref_count.h"
+
+namespace grpc_core {
+
+size_t ShardedRefCount::ThisThreadShardIndex() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return shard;
+}
+
+bool ShardedRefCount::ReleaseInitialRef() {
+  // Marking each shard released makes later refs and unrefs on it go to
+  // central_, so that it counts all refs once every shard is marked.
+  intptr_t shard_refs = 0;
+  for (Shard& shard : shards_) {
+    const intptr_t prior =
+        shard.refs.fetch_or(kShardReleased, std::memory_order_acq_rel);
+    shard_refs += prior / kShardRef;
+  }
+  // Add the shards' refs and drop the bias and the initial ref.
+  const intptr_t delta = shard_refs - kBias - 1;
+  return central_.fetch_add(delta, std::memory_order_acq_rel) + delta == 0;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,150 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_GPRPP_SHARDED_REF_COUNT_H
+#define GRPC_CORE_LIB_GPRPP_SHARDED_REF_COUNT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_core {
+
+// A ref-count for objects that are reffed and unreffed by many threads at
+// once, such as the connections shared by all the calls of a channel.
+//
+// It starts with one ref, the initial ref, held by the object's owner.
+// Until the owner drops it with ReleaseInitialRef(), Ref() and Unref()
+// update one of several counters, picked by thread, so that threads don't
+// contend for one cache line; the count can't reach zero meanwhile, so
+// nothing needs to add them up.  ReleaseInitialRef() folds them into a
+// central counter, which all later Ref() and Unref() calls update.
+class ShardedRefCount {
+ public:
+  ShardedRefCount() = default;
+
+  ShardedRefCount(const ShardedRefCount&) = delete;
+  ShardedRefCount& operator=(const ShardedRefCount&) = delete;
+
+  void Ref() {
+    const intptr_t prior =
+        ThisThreadShard().fetch_add(kShardRef, std::memory_order_relaxed);
+    if (GPR_UNLIKELY(prior & kShardReleased)) {
+      central_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns true if the ref-count reaches 0, which can only happen after
+  // ReleaseInitialRef().
+  bool Unref() {
+    const intptr_t prior =
+        ThisThreadShard().fetch_sub(kShardRef, std::memory_order_release);
+    if (GPR_LIKELY(!(prior & kShardReleased))) return false;
+    return central_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  // Drops the initial ref and returns true if it was the last one.  Must be
+  // called exactly once.
+  bool ReleaseInitialRef();
+
+ private:
+  static constexpr size_t kNumShards = 16;
+  // Shards count refs in units of kShardRef; the low bit is set once the
+  // shard has been folded into central_, after which its count is unused.
+  static constexpr intptr_t kShardRef = 2;
+  static constexpr intptr_t kShardReleased = 1;
+  // Keeps central_ from reaching zero while refs are still in the shards,
+  // some of which may have been dropped through central_.
+  static constexpr intptr_t kBias = intptr_t{1} << (sizeof(intptr_t) * 8 - 3);
+
+  struct Shard {
+    std::atomic<intptr_t> refs{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<intptr_t>)];
+  };
+
+  std::atomic<intptr_t>& ThisThreadShard() {
+    return shards_[ThisThreadShardIndex()].refs;
+  }
+  static size_t ThisThreadShardIndex();
+
+  Shard shards_[kNumShards];
+  // Holds the initial ref, plus kBias until ReleaseInitialRef().
+  std::atomic<intptr_t> central_{kBias + 1};
+};
+
+// Like InternallyRefCounted, but with a ShardedRefCount: the owner's
+// OrphanablePtr holds the initial ref, which Orphan() must drop by calling
+// ReleaseInitialRef(), and refs taken meanwhile don't contend with each
+// other.  Each object takes a cache line per shard, so this is for a few
+// objects reffed on every call, not for the objects of every call.
+template <typename Child>
+class ShardedInternallyRefCounted : public Orphanable {
+ public:
+  // Not copyable nor movable.
+  ShardedInternallyRefCounted(const ShardedInternallyRefCounted&) = delete;
+  ShardedInternallyRefCounted& operator=(const ShardedInternallyRefCounted&) =
+      delete;
+
+ protected:
+  // Allow RefCountedPtr<> to access Unref() and IncrementRefCount().
+  template <typename T>
+  friend class RefCountedPtr;
+
+  ShardedInternallyRefCounted() = default;
+  ~ShardedInternallyRefCounted() override = default;
+
+  RefCountedPtr<Child> Ref() GRPC_MUST_USE_RESULT {
+    IncrementRefCount();
+    return RefCountedPtr<Child>(static_cast<Child*>(this));
+  }
+  RefCountedPtr<Child> Ref(const DebugLocation& location,
+                           const char* reason) GRPC_MUST_USE_RESULT {
+    IncrementRefCount(location, reason);
+    return RefCountedPtr<Child>(static_cast<Child*>(this));
+  }
+
+  void Unref() {
+    if (GPR_UNLIKELY(refs_.Unref())) delete static_cast<Child*>(this);
+  }
+  void Unref(const DebugLocation& /*location*/, const char* /*reason*/) {
+    Unref();
+  }
+
+  // Drops the owner's ref.  To be called by Orphan().
+  void ReleaseInitialRef() {
+    if (refs_.ReleaseInitialRef()) delete static_cast<Child*>(this);
+  }
+
+ private:
+  void IncrementRefCount() { refs_.Ref(); }
+  void IncrementRefCount(const DebugLocation& /*location*/,
+                         const char* /*reason*/) {
+    refs_.Ref();
+  }
+
+  ShardedRefCount refs_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_SHARDED_REF_COUNT_H
@@ -27,6 +27,9 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/mutex_contention_profiler.h"
+
 #ifndef GPR_ABSEIL_SYNC
 #include "src/core/lib/gprpp/time_util.h"
 #endif
@@ -45,8 +48,6 @@ namespace grpc_core {
 #ifdef GPR_ABSEIL_SYNC
 
 using Mutex = absl::Mutex;
-using MutexLock = absl::MutexLock;
-using ReleasableMutexLock = absl::ReleasableMutexLock;
 using CondVar = absl::CondVar;
 
 // Returns the underlying gpr_mu from Mutex. This should be used only when
@@ -85,10 +86,55 @@ class ABSL_LOCKABLE Mutex {
 // TODO(veblush): Remove this after C-core no longer uses gpr_mu.
 inline gpr_mu* GetUnderlyingGprMu(Mutex* mutex) { return &mutex->mu_; }
 
+class CondVar {
+ public:
+  CondVar() { gpr_cv_init(&cv_); }
+  ~CondVar() { gpr_cv_destroy(&cv_); }
+
+  CondVar(const CondVar&) = delete;
+  CondVar& operator=(const CondVar&) = delete;
+
+  void Signal() { gpr_cv_signal(&cv_); }
+  void SignalAll() { gpr_cv_broadcast(&cv_); }
+
+  void Wait(Mutex* mu) { WaitWithDeadline(mu, absl::InfiniteFuture()); }
+  bool WaitWithTimeout(Mutex* mu, absl::Duration timeout) {
+    return gpr_cv_wait(&cv_, &mu->mu_, ToGprTimeSpec(timeout)) != 0;
+  }
+  bool WaitWithDeadline(Mutex* mu, absl::Time deadline) {
+    return gpr_cv_wait(&cv_, &mu->mu_, ToGprTimeSpec(deadline)) != 0;
+  }
+
+ private:
+  gpr_cv cv_;
+};
+
+#endif  // GPR_ABSEIL_SYNC
+
+// Takes mu for MutexLock or ReleasableMutexLock while the contention profiler
+// is running.
+inline void ProfiledLock(Mutex* mu, const SourceLocation& location)
+    ABSL_EXCLUSIVE_LOCK_FUNCTION(mu) ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  if (!mu->TryLock()) {
+    const MutexContentionProfiler::Wait wait =
+        MutexContentionProfiler::BeginWait(mu);
+    mu->Lock();
+    MutexContentionProfiler::EndWait(wait, location);
+  }
+  MutexContentionProfiler::SetHolder(mu, location);
+}
+
+// location defaults to the caller's, for the contention profiler.
 class ABSL_SCOPED_LOCKABLE MutexLock {
  public:
-  explicit MutexLock(Mutex* mu) ABSL_EXCLUSIVE_LOCK_FUNCTION(mu) : mu_(mu) {
-    mu_->Lock();
+  explicit MutexLock(Mutex* mu, SourceLocation location = SourceLocation())
+      ABSL_EXCLUSIVE_LOCK_FUNCTION(mu)
+      : mu_(mu) {
+    if (GPR_UNLIKELY(MutexContentionProfiler::enabled())) {
+      ProfiledLock(mu_, location);
+    } else {
+      mu_->Lock();
+    }
   }
   ~MutexLock() ABSL_UNLOCK_FUNCTION() { mu_->Unlock(); }
 
@@ -101,9 +147,15 @@ class ABSL_SCOPED_LOCKABLE MutexLock {
 
 class ABSL_SCOPED_LOCKABLE ReleasableMutexLock {
  public:
-  explicit ReleasableMutexLock(Mutex* mu) ABSL_EXCLUSIVE_LOCK_FUNCTION(mu)
+  explicit ReleasableMutexLock(Mutex* mu,
+                               SourceLocation location = SourceLocation())
+      ABSL_EXCLUSIVE_LOCK_FUNCTION(mu)
       : mu_(mu) {
-    mu_->Lock();
+    if (GPR_UNLIKELY(MutexContentionProfiler::enabled())) {
+      ProfiledLock(mu_, location);
+    } else {
+      mu_->Lock();
+    }
   }
   ~ReleasableMutexLock() ABSL_UNLOCK_FUNCTION() {
     if (!released_) mu_->Unlock();
@@ -123,31 +175,6 @@ class ABSL_SCOPED_LOCKABLE ReleasableMutexLock {
   bool released_ = false;
 };
 
-class CondVar {
- public:
-  CondVar() { gpr_cv_init(&cv_); }
-  ~CondVar() { gpr_cv_destroy(&cv_); }
-
-  CondVar(const CondVar&) = delete;
-  CondVar& operator=(const CondVar&) = delete;
-
-  void Signal() { gpr_cv_signal(&cv_); }
-  void SignalAll() { gpr_cv_broadcast(&cv_); }
-
-  void Wait(Mutex* mu) { WaitWithDeadline(mu, absl::InfiniteFuture()); }
-  bool WaitWithTimeout(Mutex* mu, absl::Duration timeout) {
-    return gpr_cv_wait(&cv_, &mu->mu_, ToGprTimeSpec(timeout)) != 0;
-  }
-  bool WaitWithDeadline(Mutex* mu, absl::Time deadline) {
-    return gpr_cv_wait(&cv_, &mu->mu_, ToGprTimeSpec(deadline)) != 0;
-  }
-
- private:
-  gpr_cv cv_;
-};
-
-#endif  // GPR_ABSEIL_SYNC
-
 // Deprecated. Prefer MutexLock
 class MutexLockForGprMu {
  public:
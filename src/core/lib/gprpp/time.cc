@@ -16,6 +16,7 @@
 
 #include "src/core/lib/gprpp/time.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -28,7 +29,14 @@
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/tsc_clock.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_tsc_clock, false,
+    "Read Timestamp::Now() from the CPU's time stamp counter, calibrated "
+    "against the monotonic clock, if the CPU has an invariant one.");
 
 namespace grpc_core {
 
@@ -37,11 +45,37 @@ namespace {
 std::atomic<int64_t> g_process_epoch_seconds;
 std::atomic<gpr_cycle_counter> g_process_epoch_cycles;
 
+gpr_timespec StartTime();
+
+TscClock* MaybeCreateTscClock() {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_tsc_clock)) return nullptr;
+  if (!TscClock::Supported()) {
+    gpr_log(GPR_INFO, "No invariant TSC: reading time from gpr_now()");
+    return nullptr;
+  }
+  return new TscClock();
+}
+
 class GprNowTimeSource final : public Timestamp::Source {
  public:
   Timestamp Now() override {
+    static TscClock* const tsc_clock = MaybeCreateTscClock();
+    if (tsc_clock != nullptr) return TscNow(tsc_clock);
     return Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
   }
+
+ private:
+  static Timestamp TscNow(TscClock* tsc_clock) {
+    // Resyncs adjust the clock's rate, which may leave it a few nanoseconds
+    // behind what a thread read just before, so keep time from going back
+    // for each thread.
+    static thread_local int64_t last_millis = 0;
+    const int64_t millis = std::max(
+        last_millis, (tsc_clock->Now() - StartTime().tv_sec * GPR_NS_PER_SEC) /
+                         GPR_NS_PER_MS);
+    last_millis = millis;
+    return Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+  }
 };
 
 GPR_ATTRIBUTE_NOINLINE std::pair<int64_t, gpr_cycle_counter> InitTime() {
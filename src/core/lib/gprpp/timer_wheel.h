@@ -0,0 +1,271 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_TIMER_WHEEL_H
+#define GRPC_CORE_LIB_GPRPP_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "absl/numeric/bits.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+// A hierarchical timing wheel with millisecond resolution.
+//
+// Timers are kept in intrusive lists hanging off 4 levels of 256 slots each.
+// Level 0 slots each hold timers due in a single millisecond, level 1 slots
+// span 256ms, level 2 slots ~65s and level 3 slots ~4.6h. Timers further out
+// than level 3 can represent (~49 days) are kept in an overflow list. Insert
+// and remove are O(1); timers are cascaded towards level 0 as time advances.
+//
+// TimerType must provide these (public) fields:
+//   int64_t deadline;         // milliseconds after the process epoch
+//   TimerType* next;
+//   TimerType* prev;
+//   <unsigned integer> heap_index;  // used to record the timer's slot
+//
+// This class is not thread safe; callers are expected to shard timers across
+// several wheels each protected by a mutex.
+template <typename TimerType>
+class HierarchicalTimerWheel {
+ public:
+  explicit HierarchicalTimerWheel(int64_t now) : now_(now) {}
+
+  HierarchicalTimerWheel(const HierarchicalTimerWheel&) = delete;
+  HierarchicalTimerWheel& operator=(const HierarchicalTimerWheel&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Adds timer to the wheel. Timers with a deadline that has already been
+  // passed by Advance() are returned by the next call to Advance().
+  void Add(TimerType* timer) {
+    ++size_;
+    ListAdd(SlotFor(timer->deadline), timer);
+  }
+
+  // Removes a timer previously added and not yet returned by Advance().
+  void Remove(TimerType* timer) {
+    GPR_DEBUG_ASSERT(size_ > 0);
+    --size_;
+    ListRemove(timer);
+  }
+
+  // Removes every timer with a deadline <= now and passes it to
+  // on_expired(TimerType*). Requires now < INT64_MAX; use PopAll() to drain
+  // the wheel.
+  template <typename F>
+  void Advance(int64_t now, F on_expired) {
+    GPR_DEBUG_ASSERT(now < std::numeric_limits<int64_t>::max());
+    PopSlot(kExpiredSlot, on_expired);
+    while (now_ <= now) {
+      if (size_ == 0) {
+        // Nothing to cascade, so boundaries may be skipped freely.
+        now_ = now + 1;
+        break;
+      }
+      const int idx = static_cast<int>(now_ & kSlotMask);
+      const int next = FindNextOccupied(0, idx);
+      const int64_t block_start = now_ & ~kSlotMask;
+      if (next < 0) {
+        // Nothing else is due in this level 0 rotation; skip to its end, but
+        // never past the requested time.
+        AdvanceTo(std::min(block_start + kSlotsPerLevel, now + 1));
+        continue;
+      }
+      const int64_t due = block_start + next;
+      if (due > now) {
+        AdvanceTo(now + 1);
+        break;
+      }
+      PopSlot(next, on_expired);
+      AdvanceTo(due + 1);
+    }
+  }
+
+  // Removes every timer in the wheel, passing each to on_expired(TimerType*).
+  template <typename F>
+  void PopAll(F on_expired) {
+    for (size_t i = 0; i < kNumSlots; i++) PopSlot(i, on_expired);
+  }
+
+  // Returns a lower bound for the deadline of the next timer to expire, or
+  // INT64_MAX if the wheel is empty. The bound is exact for timers due within
+  // the current level 0 rotation; otherwise it is the time at which the next
+  // occupied higher level slot gets cascaded, after which calling Advance()
+  // and NextDeadline() again produces a tighter bound.
+  int64_t NextDeadline() const {
+    if (size_ == 0) return std::numeric_limits<int64_t>::max();
+    if (slots_[kExpiredSlot] != nullptr) return now_;
+    const int idx0 = static_cast<int>(now_ & kSlotMask);
+    const int next0 = FindNextOccupied(0, idx0);
+    if (next0 >= 0) return (now_ & ~kSlotMask) + next0;
+    for (int level = 1; level < kNumLevels; level++) {
+      const int shift = kBitsPerLevel * level;
+      const int idx = static_cast<int>((now_ >> shift) & kSlotMask);
+      // The slot at idx has already been cascaded into lower levels.
+      const int next = FindNextOccupied(level, idx + 1);
+      if (next >= 0) {
+        const int64_t upper_mask =
+            ~((int64_t{1} << (shift + kBitsPerLevel)) - 1);
+        return (now_ & upper_mask) + (static_cast<int64_t>(next) << shift);
+      }
+    }
+    // Only the overflow list remains; it is cascaded once every level wraps.
+    return (now_ | ((int64_t{1} << (kBitsPerLevel * kNumLevels)) - 1)) + 1;
+  }
+
+ private:
+  static constexpr int kBitsPerLevel = 8;
+  static constexpr int kNumLevels = 4;
+  static constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+  static constexpr int64_t kSlotMask = kSlotsPerLevel - 1;
+  static constexpr size_t kWheelSlots = kNumLevels * kSlotsPerLevel;
+  // Timers whose deadline had passed when they were added.
+  static constexpr size_t kExpiredSlot = kWheelSlots;
+  // Timers too far in the future for the wheel.
+  static constexpr size_t kOverflowSlot = kWheelSlots + 1;
+  static constexpr size_t kNumSlots = kWheelSlots + 2;
+  static constexpr int kWordsPerLevel = kSlotsPerLevel / 64;
+
+  // Returns the slot a timer with the given deadline belongs to, relative to
+  // now_: the lowest level whose range still covers every bit in which the
+  // deadline differs from now_.
+  size_t SlotFor(int64_t deadline) const {
+    if (deadline < now_) return kExpiredSlot;
+    const uint64_t diff =
+        static_cast<uint64_t>(deadline) ^ static_cast<uint64_t>(now_);
+    for (int level = 0; level < kNumLevels; level++) {
+      const int shift = kBitsPerLevel * level;
+      if ((diff >> (shift + kBitsPerLevel)) == 0) {
+        return level * kSlotsPerLevel + ((deadline >> shift) & kSlotMask);
+      }
+    }
+    return kOverflowSlot;
+  }
+
+  // Moves now_ forward by at most one level 0 rotation, cascading if it lands
+  // on a rotation boundary. This keeps the invariant that every higher level
+  // slot covering now_ has already been cascaded.
+  void AdvanceTo(int64_t now) {
+    now_ = now;
+    if ((now_ & kSlotMask) == 0) Cascade();
+  }
+
+  // Called when now_ crosses a level 0 rotation boundary: moves the timers in
+  // the slots that now_ enters at each higher level into lower levels.
+  // Higher levels are cascaded first since their timers may land in the
+  // lower level slots cascaded after them.
+  void Cascade() {
+    int top = 1;
+    while (top < kNumLevels &&
+           ((now_ >> (kBitsPerLevel * top)) & kSlotMask) == 0) {
+      ++top;
+    }
+    if (top == kNumLevels) Reslot(kOverflowSlot);
+    for (int level = std::min(top, kNumLevels - 1); level >= 1; level--) {
+      const int shift = kBitsPerLevel * level;
+      Reslot(level * kSlotsPerLevel + ((now_ >> shift) & kSlotMask));
+    }
+  }
+
+  void Reslot(size_t slot) {
+    TimerType* timer = slots_[slot];
+    if (timer == nullptr) return;
+    slots_[slot] = nullptr;
+    if (slot < kWheelSlots) ClearOccupied(slot);
+    while (timer != nullptr) {
+      TimerType* next = timer->next;
+      ListAdd(SlotFor(timer->deadline), timer);
+      timer = next;
+    }
+  }
+
+  template <typename F>
+  void PopSlot(size_t slot, F& on_expired) {
+    TimerType* timer = slots_[slot];
+    if (timer == nullptr) return;
+    slots_[slot] = nullptr;
+    if (slot < kWheelSlots) ClearOccupied(slot);
+    while (timer != nullptr) {
+      TimerType* next = timer->next;
+      --size_;
+      on_expired(timer);
+      timer = next;
+    }
+  }
+
+  void ListAdd(size_t slot, TimerType* timer) {
+    timer->heap_index = static_cast<decltype(timer->heap_index)>(slot);
+    timer->prev = nullptr;
+    timer->next = slots_[slot];
+    if (timer->next != nullptr) timer->next->prev = timer;
+    slots_[slot] = timer;
+    if (slot < kWheelSlots) SetOccupied(slot);
+  }
+
+  void ListRemove(TimerType* timer) {
+    const size_t slot = timer->heap_index;
+    if (timer->prev != nullptr) {
+      timer->prev->next = timer->next;
+    } else {
+      GPR_DEBUG_ASSERT(slots_[slot] == timer);
+      slots_[slot] = timer->next;
+      if (slots_[slot] == nullptr && slot < kWheelSlots) ClearOccupied(slot);
+    }
+    if (timer->next != nullptr) timer->next->prev = timer->prev;
+  }
+
+  void SetOccupied(size_t slot) {
+    occupied_[slot / 64] |= uint64_t{1} << (slot % 64);
+  }
+  void ClearOccupied(size_t slot) {
+    occupied_[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+  }
+  bool LevelOccupied(int level) const {
+    for (int i = 0; i < kWordsPerLevel; i++) {
+      if (occupied_[level * kWordsPerLevel + i] != 0) return true;
+    }
+    return false;
+  }
+
+  // Returns the index of the first occupied slot >= from at the given level,
+  // or -1 if there is none.
+  int FindNextOccupied(int level, int from) const {
+    for (int word = from / 64; word < kWordsPerLevel; word++) {
+      uint64_t bits = occupied_[level * kWordsPerLevel + word];
+      if (word == from / 64) bits &= ~uint64_t{0} << (from % 64);
+      if (bits != 0) return word * 64 + absl::countr_zero(bits);
+    }
+    return -1;
+  }
+
+  // All times before now_ have been processed by Advance().
+  int64_t now_;
+  size_t size_ = 0;
+  TimerType* slots_[kNumSlots] = {};
+  uint64_t occupied_[kWheelSlots / 64] = {};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_TIMER_WHEEL_H
@@ -0,0 +1,187 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/tsc_clock.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <grpc/support/log.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GRPC_HAVE_TSC_CLOCK 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#else
+#define GRPC_HAVE_TSC_CLOCK 0
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+// How long the rate is first measured for, before the first resync
+// corrects it.
+constexpr int64_t kInitialCalibrationNanos = GPR_NS_PER_MS;
+// Samples of the monotonic clock are taken as the closest of a few
+// attempts, as a thread may be descheduled in the middle of one.
+constexpr int kSampleAttempts = 3;
+
+}  // namespace
+
+constexpr int64_t TscClock::kDefaultResyncIntervalNanos;
+
+bool TscClock::Supported() {
+#if GRPC_HAVE_TSC_CLOCK
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+      eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  // Advanced power management information: invariant TSC.
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+int64_t TscClock::ReadTsc() {
+#if GRPC_HAVE_TSC_CLOCK
+  return static_cast<int64_t>(__rdtsc());
+#else
+  GPR_UNREACHABLE_CODE(return 0);
+#endif
+}
+
+int64_t TscClock::MonotonicNanos() {
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+int64_t TscClock::Sample(int64_t* nanos) {
+  int64_t best_tsc = 0;
+  int64_t best_spread = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < kSampleAttempts; i++) {
+    const int64_t before = ReadTsc();
+    const int64_t sample_nanos = MonotonicNanos();
+    const int64_t after = ReadTsc();
+    if (after - before < best_spread) {
+      best_spread = after - before;
+      best_tsc = before + (after - before) / 2;
+      *nanos = sample_nanos;
+    }
+  }
+  return best_tsc;
+}
+
+TscClock::TscClock(int64_t resync_interval_nanos)
+    : resync_interval_nanos_(resync_interval_nanos) {
+  GPR_ASSERT(Supported());
+  int64_t start_nanos;
+  const int64_t start_tsc = Sample(&start_nanos);
+  int64_t tsc;
+  int64_t nanos;
+  do {
+    tsc = Sample(&nanos);
+  } while (nanos - start_nanos < kInitialCalibrationNanos);
+  const double nanos_per_tick =
+      static_cast<double>(nanos - start_nanos) / (tsc - start_tsc);
+  sample_tsc_ = tsc;
+  sample_nanos_ = nanos;
+  base_tsc_.store(tsc, std::memory_order_relaxed);
+  base_nanos_.store(nanos, std::memory_order_relaxed);
+  nanos_per_tick_.store(nanos_per_tick, std::memory_order_relaxed);
+  resync_ticks_.store(
+      static_cast<int64_t>(resync_interval_nanos_ / nanos_per_tick),
+      std::memory_order_relaxed);
+}
+
+TscClock::Calibration TscClock::Load(uint64_t* seq) const {
+  Calibration calibration;
+  while (true) {
+    *seq = seq_.load(std::memory_order_acquire);
+    if (GPR_UNLIKELY(*seq & 1)) continue;
+    calibration.tsc = base_tsc_.load(std::memory_order_relaxed);
+    calibration.nanos = base_nanos_.load(std::memory_order_relaxed);
+    calibration.nanos_per_tick =
+        nanos_per_tick_.load(std::memory_order_relaxed);
+    calibration.resync_ticks = resync_ticks_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (GPR_LIKELY(seq_.load(std::memory_order_relaxed) == *seq)) {
+      return calibration;
+    }
+  }
+}
+
+int64_t TscClock::Now() {
+  uint64_t seq;
+  const Calibration calibration = Load(&seq);
+  // Read after the calibration, so that it is never much behind its base.
+  const int64_t ticks = std::max<int64_t>(ReadTsc() - calibration.tsc, 0);
+  if (GPR_UNLIKELY(ticks >= calibration.resync_ticks)) {
+    return Resync(seq, calibration, calibration.tsc + ticks);
+  }
+  return calibration.nanos +
+         static_cast<int64_t>(ticks * calibration.nanos_per_tick);
+}
+
+int64_t TscClock::Resync(uint64_t seq, const Calibration& calibration,
+                         int64_t tsc) {
+  if (!seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire,
+                                    std::memory_order_relaxed)) {
+    // Another thread is resyncing.
+    return calibration.nanos + static_cast<int64_t>((tsc - calibration.tsc) *
+                                                    calibration.nanos_per_tick);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  int64_t nanos;
+  tsc = Sample(&nanos);
+  const int64_t projected =
+      calibration.nanos + static_cast<int64_t>((tsc - calibration.tsc) *
+                                               calibration.nanos_per_tick);
+  // The rate at which the counter ticked since the last sample, adjusted so
+  // that the clock meets the monotonic clock one interval from now.
+  double nanos_per_tick = calibration.nanos_per_tick;
+  if (tsc > sample_tsc_ && nanos > sample_nanos_) {
+    nanos_per_tick =
+        static_cast<double>(nanos - sample_nanos_) / (tsc - sample_tsc_);
+  }
+  int64_t base_nanos = projected;
+  const int64_t error = nanos - projected;
+  if (error > resync_interval_nanos_) {
+    // Too far behind to catch up by slewing, say after the machine was
+    // suspended.
+    base_nanos = nanos;
+  } else {
+    const double correction = std::max(
+        0.5, std::min(2.0, 1.0 + static_cast<double>(error) /
+                                     resync_interval_nanos_));
+    nanos_per_tick *= correction;
+  }
+  sample_tsc_ = tsc;
+  sample_nanos_ = nanos;
+  base_tsc_.store(tsc, std::memory_order_relaxed);
+  base_nanos_.store(base_nanos, std::memory_order_relaxed);
+  nanos_per_tick_.store(nanos_per_tick, std::memory_order_relaxed);
+  resync_ticks_.store(
+      static_cast<int64_t>(resync_interval_nanos_ / nanos_per_tick),
+      std::memory_order_relaxed);
+  seq_.store(seq + 2, std::memory_order_release);
+  return base_nanos;
+}
+
+}  // namespace grpc_core
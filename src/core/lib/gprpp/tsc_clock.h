@@ -0,0 +1,94 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_TSC_CLOCK_H
+#define GRPC_CORE_LIB_GPRPP_TSC_CLOCK_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <grpc/support/time.h>
+
+namespace grpc_core {
+
+// A clock on the GPR_CLOCK_MONOTONIC timeline read from the CPU's time
+// stamp counter, which is much cheaper to read than clock_gettime().
+//
+// The counter's rate is calibrated against gpr_now(GPR_CLOCK_MONOTONIC)
+// once every resync interval, by whichever reader finds the interval has
+// passed.  Rather than stepping to the monotonic clock, a resync adjusts
+// the rate so that the two meet by the next resync, which keeps Now()
+// continuous; only a clock more than one interval ahead is stepped to.
+// gpr_now_impl overrides, as tests use to fake time, are not followed
+// between resyncs.
+class TscClock {
+ public:
+  static constexpr int64_t kDefaultResyncIntervalNanos = GPR_NS_PER_SEC;
+
+  // Whether the CPU has a time stamp counter that ticks at a constant rate
+  // whatever its frequency and power states (an invariant TSC).  Only then
+  // may a TscClock be created.
+  static bool Supported();
+
+  explicit TscClock(
+      int64_t resync_interval_nanos = kDefaultResyncIntervalNanos);
+
+  TscClock(const TscClock&) = delete;
+  TscClock& operator=(const TscClock&) = delete;
+
+  // Returns the nanoseconds on the GPR_CLOCK_MONOTONIC timeline.
+  int64_t Now();
+
+ private:
+  struct Calibration {
+    int64_t tsc;
+    int64_t nanos;
+    double nanos_per_tick;
+    int64_t resync_ticks;
+  };
+
+  static int64_t ReadTsc();
+  static int64_t MonotonicNanos();
+  // Samples the monotonic clock into \a nanos, returning the counter at the
+  // time of the sample.
+  static int64_t Sample(int64_t* nanos);
+
+  // Reads the current calibration, consistently with the resyncs that may
+  // be publishing a new one, and the sequence number it was published at.
+  Calibration Load(uint64_t* seq) const;
+  // Publishes a new calibration at \a tsc if no other thread is doing so,
+  // and returns the time at \a tsc.
+  int64_t Resync(uint64_t seq, const Calibration& calibration, int64_t tsc);
+
+  const int64_t resync_interval_nanos_;
+
+  // A sequence lock over the calibration: odd while a resync publishes a
+  // new one.
+  std::atomic<uint64_t> seq_{0};
+  std::atomic<int64_t> base_tsc_{0};
+  std::atomic<int64_t> base_nanos_{0};
+  std::atomic<double> nanos_per_tick_{0};
+  std::atomic<int64_t> resync_ticks_{0};
+
+  // The last sample of the monotonic clock; used while holding seq_ odd.
+  int64_t sample_tsc_;
+  int64_t sample_nanos_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_TSC_CLOCK_H
@@ -25,27 +25,49 @@
 #include <memory>
 #include <utility>
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
+namespace {
+// With the work_serializer_offload experiment, a drain that has run this many
+// callbacks, or for this long, hands the rest of the queue to the EventEngine.
+constexpr uint64_t kMaxCallbacksPerDrain = 64;
+constexpr int64_t kMaxDrainNanos = GPR_NS_PER_MS;
+
+int64_t NanosSince(gpr_cycle_counter start) {
+  gpr_timespec elapsed = gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+  return elapsed.tv_sec * GPR_NS_PER_SEC + elapsed.tv_nsec;
+}
+}  // namespace
+
 //
 // WorkSerializer::WorkSerializerImpl
 //
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
+  explicit WorkSerializerImpl(OffloadObserver on_offload)
+      : on_offload_(std::move(on_offload)) {}
+
   void Run(std::function<void()> callback, const DebugLocation& location);
   void Schedule(std::function<void()> callback, const DebugLocation& location);
   void DrainQueue();
   void Orphan() override;
+  Stats stats() const;
 
  private:
   struct CallbackWrapper {
@@ -66,8 +88,16 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // and only invoke DrainQueueOwned() if there was previously no owner. Note
   // that the queue size is also incremented as part of the fetch_add to allow
   // the callers to add a callback to the queue if another thread already holds
-  // the lock to the work serializer.
-  void DrainQueueOwned();
+  // the lock to the work serializer. start is when the caller took
+  // ownership.
+  void DrainQueueOwned(gpr_cycle_counter start);
+  // Hands a drain that went over budget to the EventEngine.
+  void OffloadDrain(gpr_cycle_counter start);
+  // Accounts for the time of a drain that is ending.
+  void FinishDrain(gpr_cycle_counter start) {
+    drain_nanos_.fetch_add(NanosSince(start), std::memory_order_relaxed);
+  }
+  void NoteQueueDepth(uint64_t depth);
 
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
@@ -86,6 +116,13 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  const OffloadObserver on_offload_;
+  // Stats.
+  std::atomic<uint64_t> drains_{0};
+  std::atomic<uint64_t> callbacks_{0};
+  std::atomic<uint64_t> offloads_{0};
+  std::atomic<uint64_t> max_queue_depth_{0};
+  std::atomic<int64_t> drain_nanos_{0};
 };
 
 void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
@@ -105,12 +142,17 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
+    const gpr_cycle_counter start = gpr_get_cycle_counter();
+    drains_.fetch_add(1, std::memory_order_relaxed);
+    callbacks_.fetch_add(1, std::memory_order_relaxed);
     callback();
-    DrainQueueOwned();
+    DrainQueueOwned(start);
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue the callback.
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
+    // The size counted the orphan ref and the callback being run.
+    NoteQueueDepth(GetSize(prev_ref_pair) - 1);
     CallbackWrapper* cb_wrapper =
         new CallbackWrapper(std::move(callback), location);
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
@@ -129,7 +171,9 @@ void WorkSerializer::WorkSerializerImpl::Schedule(
             "WorkSerializer::Schedule() %p Scheduling callback %p [%s:%d]",
             this, cb_wrapper, location.file(), location.line());
   }
-  refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  const uint64_t prev_ref_pair =
+      refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  NoteQueueDepth(GetSize(prev_ref_pair));
   queue_.Push(&cb_wrapper->mpscq_node);
 }
 
@@ -159,7 +203,8 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
       refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
   if (GetOwners(prev_ref_pair) == 0) {
     // We took ownership of the WorkSerializer. Drain the queue.
-    DrainQueueOwned();
+    drains_.fetch_add(1, std::memory_order_relaxed);
+    DrainQueueOwned(gpr_get_cycle_counter());
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
@@ -169,10 +214,13 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
   }
 }
 
-void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
+void WorkSerializer::WorkSerializerImpl::DrainQueueOwned(
+    gpr_cycle_counter start) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
+  const bool offload_enabled = IsWorkSerializerOffloadEnabled();
+  uint64_t callbacks_run = 0;
   while (true) {
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
@@ -181,6 +229,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
         gpr_log(GPR_INFO, "  Queue Drained. Destroying");
       }
+      FinishDrain(start);
       delete this;
       return;
     }
@@ -190,6 +239,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
                                         std::memory_order_acq_rel)) {
         // Queue is drained.
+        FinishDrain(start);
         return;
       }
       if (GetSize(expected) == 0) {
@@ -197,10 +247,18 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
         if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
           gpr_log(GPR_INFO, "  Queue Drained. Destroying");
         }
+        FinishDrain(start);
         delete this;
         return;
       }
     }
+    // There is more to run: leave it to the EventEngine if this thread has
+    // been borrowed for long enough.
+    if (offload_enabled && (callbacks_run >= kMaxCallbacksPerDrain ||
+                            NanosSince(start) >= kMaxDrainNanos)) {
+      OffloadDrain(start);
+      return;
+    }
     // There is at least one callback on the queue. Pop the callback from the
     // queue and execute it.
     CallbackWrapper* cb_wrapper = nullptr;
@@ -218,17 +276,57 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
+    callbacks_.fetch_add(1, std::memory_order_relaxed);
+    ++callbacks_run;
     cb_wrapper->callback();
     delete cb_wrapper;
   }
 }
 
+void WorkSerializer::WorkSerializerImpl::OffloadDrain(gpr_cycle_counter start) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO, "  Drain over budget, offloading to the EventEngine");
+  }
+  FinishDrain(start);
+  offloads_.fetch_add(1, std::memory_order_relaxed);
+  // Ownership passes to the EventEngine thread. DrainQueueOwned() starts by
+  // releasing the size of the callback it last ran, which this thread
+  // already did: account for it again.
+  refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  if (on_offload_ != nullptr) on_offload_(stats());
+  grpc_event_engine::experimental::GetDefaultEventEngine()->Run([this]() {
+    ApplicationCallbackExecCtx app_exec_ctx;
+    ExecCtx exec_ctx;
+    drains_.fetch_add(1, std::memory_order_relaxed);
+    DrainQueueOwned(gpr_get_cycle_counter());
+  });
+}
+
+void WorkSerializer::WorkSerializerImpl::NoteQueueDepth(uint64_t depth) {
+  uint64_t max_depth = max_queue_depth_.load(std::memory_order_relaxed);
+  while (depth > max_depth &&
+         !max_queue_depth_.compare_exchange_weak(max_depth, depth,
+                                                 std::memory_order_relaxed)) {
+  }
+}
+
+WorkSerializer::Stats WorkSerializer::WorkSerializerImpl::stats() const {
+  Stats stats;
+  stats.drains = drains_.load(std::memory_order_relaxed);
+  stats.callbacks = callbacks_.load(std::memory_order_relaxed);
+  stats.offloads = offloads_.load(std::memory_order_relaxed);
+  stats.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+  stats.drain_time = Duration::NanosecondsRoundDown(
+      drain_nanos_.load(std::memory_order_relaxed));
+  return stats;
+}
+
 //
 // WorkSerializer
 //
 
-WorkSerializer::WorkSerializer()
-    : impl_(MakeOrphanable<WorkSerializerImpl>()) {}
+WorkSerializer::WorkSerializer(OffloadObserver on_offload)
+    : impl_(MakeOrphanable<WorkSerializerImpl>(std::move(on_offload))) {}
 
 WorkSerializer::~WorkSerializer() {}
 
@@ -244,4 +342,6 @@ void WorkSerializer::Schedule(std::function<void()> callback,
 
 void WorkSerializer::DrainQueue() { impl_->DrainQueue(); }
 
+WorkSerializer::Stats WorkSerializer::stats() const { return impl_->stats(); }
+
 }  // namespace grpc_core
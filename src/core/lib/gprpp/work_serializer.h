@@ -19,12 +19,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <functional>
 
 #include "absl/base/thread_annotations.h"
 
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/time.h"
 
 namespace grpc_core {
 
@@ -42,9 +45,32 @@ namespace grpc_core {
 // inline in Run() (for example, if a mutex lock is held and executing callbacks
 // inline would cause a deadlock), it should use Schedule() instead and then
 // invoke DrainQueue() when it is safe to invoke the callback.
+//
+// With the work_serializer_offload experiment, a thread that has drained the
+// queue for longer than a small budget hands the rest of the drain to the
+// EventEngine and returns, so that a data plane thread that happened to call
+// Run() is not held by a long run of control plane callbacks. The FIFO and
+// mutual exclusion guarantees are unchanged.
 class ABSL_LOCKABLE WorkSerializer {
  public:
-  WorkSerializer();
+  // Counters of the work done by a WorkSerializer since its creation.
+  struct Stats {
+    // Times a thread took ownership to run callbacks.
+    uint64_t drains = 0;
+    uint64_t callbacks = 0;
+    // Drains handed to the EventEngine once over budget.
+    uint64_t offloads = 0;
+    // The most callbacks that were ever waiting for a running drain.
+    uint64_t max_queue_depth = 0;
+    // Total time threads spent draining.
+    Duration drain_time;
+  };
+
+  // Invoked with the current stats each time a drain is handed to the
+  // EventEngine, from the thread that handed it over.
+  using OffloadObserver = std::function<void(const Stats&)>;
+
+  explicit WorkSerializer(OffloadObserver on_offload = nullptr);
 
   ~WorkSerializer();
 
@@ -75,6 +101,8 @@ class ABSL_LOCKABLE WorkSerializer {
   // Drains the queue of callbacks.
   void DrainQueue();
 
+  Stats stats() const;
+
  private:
   class WorkSerializerImpl;
 
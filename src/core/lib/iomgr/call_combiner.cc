@@ -25,6 +25,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/experiments/experiments.h"
 
 namespace grpc_core {
 
@@ -90,6 +91,15 @@ void CallCombiner::TsanClosure(void* arg, grpc_error_handle error) {
 }
 #endif
 
+#ifndef GRPC_TSAN_ENABLED
+namespace {
+// Closures run inline from call combiners can start more: past this many
+// nested on a thread, they are scheduled on the ExecCtx to unwind the stack.
+constexpr int kMaxInlineDepth = 4;
+thread_local int g_inline_depth = 0;
+}  // namespace
+#endif
+
 void CallCombiner::ScheduleClosure(grpc_closure* closure,
                                    grpc_error_handle error) {
 #ifdef GRPC_TSAN_ENABLED
@@ -119,6 +129,45 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
             this, closure DEBUG_FMT_ARGS, reason,
             grpc_error_std_string(error).c_str());
   }
+  if (Enqueue(closure, error)) {
+    if (IsCallCombinerInlineStartEnabled()) {
+      RunOrScheduleClosure(closure, error);
+    } else {
+      ScheduleClosure(closure, error);
+    }
+  }
+}
+
+void CallCombiner::StartInline(grpc_closure* closure, grpc_error_handle error,
+                               DEBUG_ARGS const char* reason) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
+    gpr_log(GPR_INFO,
+            "==> CallCombiner::StartInline() [%p] closure=%p [" DEBUG_FMT_STR
+            "%s] error=%s",
+            this, closure DEBUG_FMT_ARGS, reason,
+            grpc_error_std_string(error).c_str());
+  }
+  if (Enqueue(closure, error)) RunOrScheduleClosure(closure, error);
+}
+
+void CallCombiner::RunOrScheduleClosure(grpc_closure* closure,
+                                        grpc_error_handle error) {
+#ifdef GRPC_TSAN_ENABLED
+  // Keeps the annotations of TsanClosure.
+  ScheduleClosure(closure, error);
+#else
+  if (g_inline_depth >= kMaxInlineDepth) {
+    ScheduleClosure(closure, error);
+    return;
+  }
+  ++g_inline_depth;
+  Closure::Run(DEBUG_LOCATION, closure, error);
+  --g_inline_depth;
+#endif
+}
+
+bool CallCombiner::Enqueue(grpc_closure* closure,
+                           const grpc_error_handle& error) {
   size_t prev_size =
       static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)1));
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
@@ -130,16 +179,16 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
       gpr_log(GPR_INFO, "  EXECUTING IMMEDIATELY");
     }
     // Queue was empty, so execute this closure immediately.
-    ScheduleClosure(closure, error);
-  } else {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
-      gpr_log(GPR_INFO, "  QUEUING");
-    }
-    // Queue was not empty, so add closure to queue.
-    closure->error_data.error = internal::StatusAllocHeapPtr(error);
-    queue_.Push(
-        reinterpret_cast<MultiProducerSingleConsumerQueue::Node*>(closure));
+    return true;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
+    gpr_log(GPR_INFO, "  QUEUING");
   }
+  // Queue was not empty, so add closure to queue.
+  closure->error_data.error = internal::StatusAllocHeapPtr(error);
+  queue_.Push(
+      reinterpret_cast<MultiProducerSingleConsumerQueue::Node*>(closure));
+  return false;
 }
 
 void CallCombiner::Stop(DEBUG_ARGS const char* reason) {
@@ -57,9 +57,18 @@ class CallCombiner {
   (call_combiner)->Start((closure), (error), __FILE__, __LINE__, (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop(__FILE__, __LINE__, (reason))
+#define GRPC_CALL_COMBINER_START_INLINE(call_combiner, closure, error, reason) \
+  (call_combiner)->StartInline((closure), (error), __FILE__, __LINE__,        \
+                               (reason))
   /// Starts processing \a closure.
   void Start(grpc_closure* closure, grpc_error_handle error, const char* file,
              int line, const char* reason);
+  /// Like Start(), but runs \a closure before returning if the call combiner
+  /// is free (and not too many closures are nested on the thread already).
+  /// Only for callers that run from the ExecCtx themselves and hold no locks.
+  /// With the call_combiner_inline_start experiment, Start() does this too.
+  void StartInline(grpc_closure* closure, grpc_error_handle error,
+                   const char* file, int line, const char* reason);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* file, int line, const char* reason);
 #else
@@ -67,9 +76,17 @@ class CallCombiner {
   (call_combiner)->Start((closure), (error), (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop((reason))
+#define GRPC_CALL_COMBINER_START_INLINE(call_combiner, closure, error, reason) \
+  (call_combiner)->StartInline((closure), (error), (reason))
   /// Starts processing \a closure.
   void Start(grpc_closure* closure, grpc_error_handle error,
              const char* reason);
+  /// Like Start(), but runs \a closure before returning if the call combiner
+  /// is free (and not too many closures are nested on the thread already).
+  /// Only for callers that run from the ExecCtx themselves and hold no locks.
+  /// With the call_combiner_inline_start experiment, Start() does this too.
+  void StartInline(grpc_closure* closure, grpc_error_handle error,
+                   const char* reason);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* reason);
 #endif
@@ -102,6 +119,10 @@ class CallCombiner {
 
  private:
   void ScheduleClosure(grpc_closure* closure, grpc_error_handle error);
+  // Adds closure to the queue, and returns true if the caller must run it
+  // now.
+  bool Enqueue(grpc_closure* closure, const grpc_error_handle& error);
+  void RunOrScheduleClosure(grpc_closure* closure, grpc_error_handle error);
 #ifdef GRPC_TSAN_ENABLED
   static void TsanClosure(void* arg, grpc_error_handle error);
 #endif
@@ -26,13 +26,33 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/debug/event_trace.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_time_budget_us, 0,
+    "If positive, a thread that has run a combiner for this many microseconds "
+    "while other closures are queued on it hands the combiner to the "
+    "executor.");
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_combiner_collect_stats, false,
+                              "Record histograms of combiner hold times and "
+                              "queue lengths in the stats system.");
+
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
+static int64_t g_time_budget_us;
+static bool g_collect_stats;
+
+void grpc_combiner_global_init() {
+  g_time_budget_us = GPR_GLOBAL_CONFIG_GET(grpc_combiner_time_budget_us);
+  g_collect_stats = GPR_GLOBAL_CONFIG_GET(grpc_combiner_collect_stats);
+}
+
 #define GRPC_COMBINER_TRACE(fn)          \
   do {                                   \
     if (grpc_combiner_trace.enabled()) { \
@@ -163,14 +183,46 @@ static void move_next() {
   }
 }
 
+static int64_t held_us(grpc_core::Combiner* lock) {
+  gpr_timespec held =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), lock->hold_start);
+  return held.tv_sec * GPR_US_PER_SEC + held.tv_nsec / GPR_NS_PER_US;
+}
+
+// Notes that the current thread starts running closures of lock.
+static void begin_hold(grpc_core::Combiner* lock) {
+  if (lock->held || (g_time_budget_us <= 0 && !g_collect_stats &&
+                     !grpc_core::EventTrace::enabled())) {
+    return;
+  }
+  lock->held = true;
+  lock->hold_start = gpr_get_cycle_counter();
+  if (g_collect_stats) {
+    GRPC_STATS_INC_COMBINER_QUEUE_LENGTH(
+        gpr_atm_no_barrier_load(&lock->state) >> 1);
+  }
+}
+
+// Notes that the current thread releases lock, or hands it off.
+static void end_hold(grpc_core::Combiner* lock) {
+  if (!lock->held) return;
+  lock->held = false;
+  if (g_collect_stats) GRPC_STATS_INC_COMBINER_HOLD_TIME_US(held_us(lock));
+  grpc_core::EventTrace::Complete(grpc_core::EventTrace::Event::kCombinerHold,
+                                  lock->hold_start);
+}
+
 static void offload(void* arg, grpc_error_handle /*error*/) {
   grpc_core::Combiner* lock = static_cast<grpc_core::Combiner*>(arg);
   push_last_on_exec_ctx(lock);
 }
 
 static void queue_offload(grpc_core::Combiner* lock) {
+  end_hold(lock);
   move_next();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
+  grpc_core::EventTrace::Instant(
+      grpc_core::EventTrace::Event::kCombinerOffload);
   grpc_core::Executor::Run(&lock->offload, absl::OkStatus());
 }
 
@@ -193,6 +245,8 @@ bool grpc_combiner_continue_exec_ctx() {
                               grpc_core::ExecCtx::Get()->IsReadyToFinish(),
                               lock->time_to_execute_final_list));
 
+  begin_hold(lock);
+
   // offload only if all the following conditions are true:
   // 1. the combiner is contended and has more than one closure to execute
   // 2. the current execution context needs to finish as soon as possible
@@ -207,6 +261,17 @@ bool grpc_combiner_continue_exec_ctx() {
     return true;
   }
 
+  // also offload once this thread has run the combiner past its time budget
+  // while more closures are waiting, under the same conditions 3. and 4.
+  if (g_time_budget_us > 0 && held_us(lock) >= g_time_budget_us &&
+      (gpr_atm_acq_load(&lock->state) >> 1) > 1 &&
+      !grpc_iomgr_platform_is_any_background_poller_thread() &&
+      grpc_core::Executor::IsThreadedDefault()) {
+    GRPC_STATS_INC_COMBINER_BUDGET_OFFLOADS();
+    queue_offload(lock);
+    return true;
+  }
+
   if (!lock->time_to_execute_final_list ||
       // peek to see if something new has shown up, and execute that with
       // priority
@@ -273,9 +338,11 @@ bool grpc_combiner_continue_exec_ctx() {
       break;
     case OLD_STATE_WAS(false, 1):
       // had one count, one unorphaned --> unlocked unorphaned
+      end_hold(lock);
       return true;
     case OLD_STATE_WAS(true, 1):
       // and one count, one orphaned --> unlocked and orphaned
+      end_hold(lock);
       really_destroy(lock);
       return true;
     case OLD_STATE_WAS(false, 0):
@@ -26,8 +26,18 @@
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
+// If positive, a thread that has run a combiner for this many microseconds
+// while other closures are still queued on it hands the combiner to the
+// executor.
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_combiner_time_budget_us);
+// Whether to record the combiner_hold_time_us and combiner_queue_length
+// stats histograms.
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_combiner_collect_stats);
+
 namespace grpc_core {
 // TODO(yashkt) : Remove this class and replace it with a class that does not
 // use ExecCtx
@@ -51,6 +61,9 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // Whether a thread is running the combiner since hold_start.
+  bool held = false;
+  gpr_cycle_counter hold_start;
 };
 }  // namespace grpc_core
 
@@ -84,6 +97,9 @@ void grpc_combiner_unref(grpc_core::Combiner* lock GRPC_COMBINER_DEBUG_ARGS);
 
 bool grpc_combiner_continue_exec_ctx();
 
+// Reads the combiner configuration. Called by grpc_iomgr_init().
+void grpc_combiner_global_init();
+
 extern grpc_core::DebugOnlyTraceFlag grpc_combiner_trace;
 
 #endif /* GRPC_CORE_LIB_IOMGR_COMBINER_H */
@@ -65,3 +65,10 @@ int grpc_endpoint_get_fd(grpc_endpoint* ep) { return ep->vtable->get_fd(ep); }
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep) {
   return ep->vtable->can_track_err(ep);
 }
+
+void grpc_endpoint_set_channelz_socket(
+    grpc_endpoint* ep, grpc_core::channelz::SocketNode* socket) {
+  if (ep->vtable->set_channelz_socket != nullptr) {
+    ep->vtable->set_channelz_socket(ep, socket);
+  }
+}
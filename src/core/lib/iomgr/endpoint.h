@@ -36,6 +36,12 @@
 typedef struct grpc_endpoint grpc_endpoint;
 typedef struct grpc_endpoint_vtable grpc_endpoint_vtable;
 
+namespace grpc_core {
+namespace channelz {
+class SocketNode;
+}  // namespace channelz
+}  // namespace grpc_core
+
 struct grpc_endpoint_vtable {
   void (*read)(grpc_endpoint* ep, grpc_slice_buffer* slices, grpc_closure* cb,
                bool urgent, int min_progress_size);
@@ -50,6 +56,9 @@ struct grpc_endpoint_vtable {
   absl::string_view (*get_local_address)(grpc_endpoint* ep);
   int (*get_fd)(grpc_endpoint* ep);
   bool (*can_track_err)(grpc_endpoint* ep);
+  /* May be null for endpoints with nothing to report to channelz. */
+  void (*set_channelz_socket)(grpc_endpoint* ep,
+                              grpc_core::channelz::SocketNode* socket);
 };
 
 /* When data is available on the connection, calls the callback with slices.
@@ -102,6 +111,12 @@ void grpc_endpoint_delete_from_pollset_set(grpc_endpoint* ep,
 
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep);
 
+/* Gives \a ep the channelz node of the transport it carries, so that it can
+   report its own state (e.g. socket options it tunes at runtime) there.
+   \a socket may be null. */
+void grpc_endpoint_set_channelz_socket(grpc_endpoint* ep,
+                                       grpc_core::channelz::SocketNode* socket);
+
 struct grpc_endpoint {
   const grpc_endpoint_vtable* vtable;
 };
@@ -319,7 +319,8 @@ static const grpc_endpoint_vtable vtable = {CFStreamRead,
                                             CFStreamGetPeer,
                                             CFStreamGetLocalAddress,
                                             CFStreamGetFD,
-                                            CFStreamCanTrackErr};
+                                            CFStreamCanTrackErr,
+                                            nullptr};
 
 grpc_endpoint* grpc_cfstream_endpoint_create(CFReadStreamRef read_stream,
                                              CFWriteStreamRef write_stream,
@@ -34,8 +34,10 @@
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -47,14 +49,17 @@
 #include <grpc/support/cpu.h>
 
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/timer_manager.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 
 static grpc_wakeup_fd global_wakeup_fd;
@@ -65,6 +70,10 @@ static grpc_wakeup_fd global_wakeup_fd;
 
 #define MAX_EPOLL_EVENTS 100
 #define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 1
+/* With the epoll_batched_events experiment: enough to amortize handing off
+   the poller on a busy server, few enough that the events of a large
+   epoll_wait are still spread over the threads polling */
+#define MAX_EPOLL_EVENTS_HANDLED_PER_BATCHED_ITERATION 16
 
 /* NOTE ON SYNCHRONIZATION:
  * - Fields in this struct are only modified by the designated poller. Hence
@@ -130,6 +139,113 @@ static void epoll_set_shutdown() {
   }
 }
 
+/*******************************************************************************
+ * Sharded epoll sets (epoll_sharded_sets experiment)
+ */
+
+#define MAX_EPOLL_SHARDS 64u
+#define MAX_EPOLL_EVENTS_PER_SHARD_POLL 16
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE (1u << 28)
+#endif
+
+/* With the epoll_sharded_sets experiment, fds are spread over one epoll set
+ * per pollset neighborhood (up to MAX_EPOLL_SHARDS) instead of living in
+ * g_epoll_set, and each shard has a designated poller of its own, chosen among
+ * the workers of the pollsets of its neighborhoods, so that as many threads as
+ * there are shards can be in epoll_wait at once. An fd goes to the shard of
+ * the CPU that creates it, then to that of the first pollset it is added to;
+ * listening sockets go to every shard, with EPOLLEXCLUSIVE so that a new
+ * connection wakes a single one.
+ *
+ * Each shard's set is itself in g_epoll_set, with EPOLLONESHOT: the designated
+ * poller of g_epoll_set drains the shards that nobody polls, and those whose
+ * poller stops while the shard was reported, so that no event is stranded when
+ * there are fewer threads polling than shards. */
+typedef struct epoll_shard {
+  union {
+    char pad[GPR_CACHELINE_SIZE];
+    struct {
+      int epfd;
+      grpc_wakeup_fd wakeup_fd;
+      /* The worker polling this shard, SHARD_DRAINING while the designated
+       * poller of g_epoll_set drains it, or 0 */
+      gpr_atm active_poller;
+      /* Set when g_epoll_set reported this shard while someone polled it; the
+       * shard is rearmed in g_epoll_set once they stop */
+      gpr_atm needs_rearm;
+    };
+  };
+} epoll_shard;
+
+#define SHARD_DRAINING ((gpr_atm)1)
+
+static bool g_sharded;
+static epoll_shard* g_shards;
+static size_t g_num_shards;
+/* Serializes moving fds between shards */
+static gpr_mu g_fd_shard_mu;
+
+static bool is_shard(void* data_ptr) {
+  return g_sharded && data_ptr >= static_cast<void*>(g_shards) &&
+         data_ptr < static_cast<void*>(g_shards + g_num_shards);
+}
+
+static void shard_rearm(epoll_shard* shard) {
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLONESHOT);
+  ev.data.ptr = shard;
+  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_MOD, shard->epfd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+}
+
+static grpc_error_handle shards_init(size_t num_shards) {
+  g_num_shards = std::min<size_t>(num_shards, MAX_EPOLL_SHARDS);
+  g_shards = static_cast<epoll_shard*>(
+      gpr_zalloc(sizeof(*g_shards) * g_num_shards));
+  for (size_t i = 0; i < g_num_shards; i++) {
+    g_shards[i].epfd = -1;
+    g_shards[i].wakeup_fd.read_fd = -1;
+  }
+  gpr_mu_init(&g_fd_shard_mu);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    epoll_shard* shard = &g_shards[i];
+    shard->epfd = epoll_create_and_cloexec();
+    if (shard->epfd < 0) return GRPC_OS_ERROR(errno, "epoll_create");
+    grpc_error_handle err = grpc_wakeup_fd_init(&shard->wakeup_fd);
+    if (!err.ok()) return err;
+    struct epoll_event ev;
+    ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
+    ev.data.ptr = &shard->wakeup_fd;
+    if (epoll_ctl(shard->epfd, EPOLL_CTL_ADD, shard->wakeup_fd.read_fd, &ev) !=
+        0) {
+      return GRPC_OS_ERROR(errno, "epoll_ctl");
+    }
+    ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLONESHOT);
+    ev.data.ptr = shard;
+    if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, shard->epfd, &ev) != 0) {
+      return GRPC_OS_ERROR(errno, "epoll_ctl");
+    }
+  }
+  return absl::OkStatus();
+}
+
+static void shards_shutdown() {
+  if (g_shards == nullptr) return;
+  for (size_t i = 0; i < g_num_shards; i++) {
+    if (g_shards[i].wakeup_fd.read_fd != -1) {
+      grpc_wakeup_fd_destroy(&g_shards[i].wakeup_fd);
+    }
+    if (g_shards[i].epfd >= 0) close(g_shards[i].epfd);
+  }
+  gpr_mu_destroy(&g_fd_shard_mu);
+  gpr_free(g_shards);
+  g_shards = nullptr;
+  g_num_shards = 0;
+}
+
 /*******************************************************************************
  * Fd Declarations
  */
@@ -144,6 +260,13 @@ struct grpc_fork_fd_list {
 struct grpc_fd {
   int fd;
 
+  /* The shard whose epoll set has this fd, or nullptr if it is in g_epoll_set
+   * (or, for listeners, in every shard) */
+  struct epoll_shard* shard;
+  bool listener;
+  bool track_err;
+  bool added_to_pollset;
+
   grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
   grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
   grpc_core::ManualConstructor<grpc_core::LockfreeEvent> error_closure;
@@ -181,6 +304,8 @@ struct grpc_pollset_worker {
   kick_state state;
   int kick_state_mutator;  // which line of code last changed kick state
   bool initialized_cv;
+  /* The shard this DESIGNATED_POLLER polls, nullptr for g_epoll_set */
+  struct epoll_shard* poll_shard;
   grpc_pollset_worker* next;
   grpc_pollset_worker* prev;
   gpr_cv cv;
@@ -326,6 +451,77 @@ static void fork_fd_list_remove_grpc_fd(grpc_fd* fd) {
   }
 }
 
+static size_t choose_neighborhood(void);
+
+static struct epoll_event fd_epoll_event(grpc_fd* fd) {
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+  /* Use the least significant bit of ev.data.ptr to store track_err. We expect
+   * the addresses to be word aligned. We need to store track_err to avoid
+   * synchronization issues when accessing it after receiving an event.
+   * Accessing fd would be a data race there because the fd might have been
+   * returned to the free list at that point. */
+  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(fd) |
+                                        (fd->track_err ? 1 : 0));
+  return ev;
+}
+
+/* The epoll set that has \a fd, unless it is a listener */
+static int fd_epfd(grpc_fd* fd) {
+  return fd->shard == nullptr ? g_epoll_set.epfd : fd->shard->epfd;
+}
+
+static bool fd_is_listener(int fd) {
+  int listening = 0;
+  socklen_t len = sizeof(listening);
+  return getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &len) == 0 &&
+         listening != 0;
+}
+
+/* Adds the listener \a fd to the set of every shard, so that whichever polls
+ * first accepts its connections. Failing that (EPOLLEXCLUSIVE needs Linux
+ * 4.5), adds it to the set of the current CPU's shard only. */
+static void fd_add_to_all_shards(grpc_fd* fd, struct epoll_event* ev) {
+  struct epoll_event exclusive = *ev;
+  exclusive.events = static_cast<uint32_t>(EPOLLIN | EPOLLET | EPOLLEXCLUSIVE);
+  size_t added = 0;
+  for (; added < g_num_shards; added++) {
+    if (epoll_ctl(g_shards[added].epfd, EPOLL_CTL_ADD, fd->fd, &exclusive) !=
+        0) {
+      break;
+    }
+  }
+  if (added == g_num_shards) {
+    fd->listener = true;
+    return;
+  }
+  for (size_t i = 0; i < added; i++) {
+    epoll_event phony_event;
+    epoll_ctl(g_shards[i].epfd, EPOLL_CTL_DEL, fd->fd, &phony_event);
+  }
+  fd->shard = &g_shards[choose_neighborhood() % g_num_shards];
+  if (epoll_ctl(fd->shard->epfd, EPOLL_CTL_ADD, fd->fd, ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+}
+
+/* Removes \a fd from the epoll sets it is in */
+static void fd_epoll_del(grpc_fd* fd) {
+  /* we need a phony event for earlier linux versions. */
+  epoll_event phony_event;
+  if (fd->listener) {
+    for (size_t i = 0; i < g_num_shards; i++) {
+      epoll_ctl(g_shards[i].epfd, EPOLL_CTL_DEL, fd->fd, &phony_event);
+    }
+    return;
+  }
+  if (g_sharded) gpr_mu_lock(&g_fd_shard_mu);
+  if (epoll_ctl(fd_epfd(fd), EPOLL_CTL_DEL, fd->fd, &phony_event) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+  if (g_sharded) gpr_mu_unlock(&g_fd_shard_mu);
+}
+
 static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   grpc_fd* new_fd = nullptr;
 
@@ -358,17 +554,20 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   }
 #endif
 
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
-  /* Use the least significant bit of ev.data.ptr to store track_err. We expect
-   * the addresses to be word aligned. We need to store track_err to avoid
-   * synchronization issues when accessing it after receiving an event.
-   * Accessing fd would be a data race there because the fd might have been
-   * returned to the free list at that point. */
-  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(new_fd) |
-                                        (track_err ? 1 : 0));
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
-    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  new_fd->shard = nullptr;
+  new_fd->listener = false;
+  new_fd->track_err = track_err;
+  new_fd->added_to_pollset = false;
+  struct epoll_event ev = fd_epoll_event(new_fd);
+  if (g_sharded && fd_is_listener(fd)) {
+    fd_add_to_all_shards(new_fd, &ev);
+  } else {
+    if (g_sharded) {
+      new_fd->shard = &g_shards[choose_neighborhood() % g_num_shards];
+    }
+    if (epoll_ctl(fd_epfd(new_fd), EPOLL_CTL_ADD, fd, &ev) != 0) {
+      gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    }
   }
 
   return new_fd;
@@ -385,12 +584,7 @@ static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
     if (!releasing_fd) {
       shutdown(fd->fd, SHUT_RDWR);
     } else {
-      /* we need a phony event for earlier linux versions. */
-      epoll_event phony_event;
-      if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) !=
-          0) {
-        gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
-      }
+      fd_epoll_del(fd);
     }
     fd->write_closure->SetShutdown(why);
     fd->error_closure->SetShutdown(why);
@@ -510,6 +704,98 @@ static size_t choose_neighborhood(void) {
   return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
 }
 
+static epoll_shard* neighborhood_shard(pollset_neighborhood* neighborhood) {
+  return &g_shards[static_cast<size_t>(neighborhood - g_neighborhoods) %
+                   g_num_shards];
+}
+
+/* The wakeup fd that gets the designated poller \a worker out of epoll_wait */
+static grpc_wakeup_fd* poller_wakeup_fd(grpc_pollset_worker* worker) {
+  return worker->poll_shard == nullptr ? &global_wakeup_fd
+                                       : &worker->poll_shard->wakeup_fd;
+}
+
+/* With the timerfd_timers experiment, a timerfd in g_epoll_set that the
+   timer manager arms for the next timer to expire, so that the designated
+   poller runs timers itself (see grpc_timer_manager_set_poller) */
+static int g_timerfd = -1;
+static gpr_mu g_timerfd_mu;
+/* The deadline g_timerfd is armed for, InfFuture if none */
+static grpc_core::Timestamp g_timerfd_deadline;
+
+static void timerfd_arm(grpc_core::Timestamp deadline) {
+  gpr_mu_lock(&g_timerfd_mu);
+  /* Only ever bring the deadline forward: timerfd_fired() forgets it before
+     the timer manager looks for the next one */
+  if (deadline < g_timerfd_deadline) {
+    g_timerfd_deadline = deadline;
+    gpr_timespec ts = deadline.as_timespec(GPR_CLOCK_MONOTONIC);
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = static_cast<time_t>(ts.tv_sec);
+    spec.it_value.tv_nsec = ts.tv_nsec;
+    /* A zero value would disarm the timer rather than fire it */
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+      spec.it_value.tv_nsec = 1;
+    }
+    if (timerfd_settime(g_timerfd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+      gpr_log(GPR_ERROR, "timerfd_settime: %s", strerror(errno));
+    }
+  }
+  gpr_mu_unlock(&g_timerfd_mu);
+}
+
+static bool timerfd_polling() {
+  return gpr_atm_no_barrier_load(&g_active_poller) != 0;
+}
+
+static const grpc_timer_poller g_timerfd_poller = {timerfd_arm,
+                                                   timerfd_polling};
+
+/* Called by the designated poller when g_timerfd is readable */
+static void timerfd_fired() {
+  uint64_t expirations;
+  ssize_t r;
+  /* EAGAIN if it was armed again since; the timers are looked at anyway */
+  do {
+    r = read(g_timerfd, &expirations, sizeof(expirations));
+  } while (r < 0 && errno == EINTR);
+  gpr_mu_lock(&g_timerfd_mu);
+  g_timerfd_deadline = grpc_core::Timestamp::InfFuture();
+  gpr_mu_unlock(&g_timerfd_mu);
+  grpc_timer_manager_run_from_poller();
+}
+
+/* Failing leaves the timers to the timer manager threads, as without the
+   experiment */
+static void timerfd_init() {
+  g_timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (g_timerfd < 0) {
+    gpr_log(GPR_ERROR, "timerfd_create: %s", strerror(errno));
+    return;
+  }
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
+  ev.data.ptr = &g_timerfd;
+  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, g_timerfd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl of timerfd: %s", strerror(errno));
+    close(g_timerfd);
+    g_timerfd = -1;
+    return;
+  }
+  gpr_mu_init(&g_timerfd_mu);
+  g_timerfd_deadline = grpc_core::Timestamp::InfFuture();
+  grpc_timer_manager_set_poller(&g_timerfd_poller);
+}
+
+static void timerfd_shutdown() {
+  if (g_timerfd < 0) return;
+  grpc_timer_manager_set_poller(nullptr);
+  close(g_timerfd);
+  g_timerfd = -1;
+  gpr_mu_destroy(&g_timerfd_mu);
+}
+
 static grpc_error_handle pollset_global_init(void) {
   gpr_atm_no_barrier_store(&g_active_poller, 0);
   global_wakeup_fd.read_fd = -1;
@@ -529,11 +815,24 @@ static grpc_error_handle pollset_global_init(void) {
   for (size_t i = 0; i < g_num_neighborhoods; i++) {
     gpr_mu_init(&g_neighborhoods[i].mu);
   }
+  g_sharded = grpc_core::IsEpollShardedSetsEnabled();
+  if (g_sharded) {
+    err = shards_init(g_num_neighborhoods);
+    if (!err.ok()) {
+      shards_shutdown();
+      g_sharded = false;
+      return err;
+    }
+  }
+  if (grpc_core::IsTimerfdTimersEnabled()) timerfd_init();
   return absl::OkStatus();
 }
 
 static void pollset_global_shutdown(void) {
+  timerfd_shutdown();
   if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
+  shards_shutdown();
+  g_sharded = false;
   for (size_t i = 0; i < g_num_neighborhoods; i++) {
     gpr_mu_destroy(&g_neighborhoods[i].mu);
   }
@@ -598,7 +897,7 @@ static grpc_error_handle pollset_kick_all(grpc_pollset* pollset) {
           break;
         case DESIGNATED_POLLER:
           SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+          append_error(&error, grpc_wakeup_fd_wakeup(poller_wakeup_fd(worker)),
                        "pollset_kick_all");
           break;
       }
@@ -641,51 +940,133 @@ static int poll_deadline_to_millis_timeout(grpc_core::Timestamp millis) {
   }
 }
 
+/* Marks the fd of an event reported by epoll_wait as ready */
+static void process_fd_event(struct epoll_event* ev) {
+  void* data_ptr = ev->data.ptr;
+  grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+      reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
+  bool track_err =
+      reinterpret_cast<intptr_t>(data_ptr) & static_cast<intptr_t>(1);
+  bool cancel = (ev->events & EPOLLHUP) != 0;
+  bool error = (ev->events & EPOLLERR) != 0;
+  bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
+  bool write_ev = (ev->events & EPOLLOUT) != 0;
+  bool err_fallback = error && !track_err;
+
+  if (error && !err_fallback) {
+    fd_has_errors(fd);
+  }
+
+  if (read_ev || cancel || err_fallback) {
+    fd_become_readable(fd);
+  }
+
+  if (write_ev || cancel || err_fallback) {
+    fd_become_writable(fd);
+  }
+}
+
+/* Waits up to \a timeout milliseconds for the fds of \a shard and processes
+   up to MAX_EPOLL_EVENTS_PER_SHARD_POLL of their events. Only called by the
+   worker that owns shard->active_poller. */
+static grpc_error_handle poll_shard(grpc_pollset* ps, epoll_shard* shard,
+                                    int timeout) {
+  static const char* err_desc = "poll_shard";
+  struct epoll_event events[MAX_EPOLL_EVENTS_PER_SHARD_POLL];
+  int r;
+  if (timeout != 0) {
+    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  }
+  do {
+    r = epoll_wait(shard->epfd, events, MAX_EPOLL_EVENTS_PER_SHARD_POLL,
+                   timeout);
+  } while (r < 0 && errno == EINTR);
+  if (timeout != 0) {
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  }
+
+  if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ps: %p poll of shard %" PRIdPTR " got %d events", ps,
+            shard - g_shards, r);
+  }
+
+  grpc_error_handle error;
+  for (int i = 0; i < r; i++) {
+    if (events[i].data.ptr == &shard->wakeup_fd) {
+      append_error(&error, grpc_wakeup_fd_consume_wakeup(&shard->wakeup_fd),
+                   err_desc);
+    } else {
+      process_fd_event(&events[i]);
+    }
+  }
+  return error;
+}
+
+/* Called by the designated poller of g_epoll_set when g_epoll_set reports
+   \a shard: processes the events of the shard, unless it has a poller of its
+   own, in which case the shard is rearmed once that poller stops. */
+static void drain_shard(grpc_pollset* ps, epoll_shard* shard,
+                        grpc_error_handle* error) {
+  while (!gpr_atm_acq_cas(&shard->active_poller, 0, SHARD_DRAINING)) {
+    gpr_atm_full_xchg(&shard->needs_rearm, 1);
+    if (gpr_atm_full_fetch_add(&shard->active_poller, 0) != 0) return;
+    /* Its poller stopped meanwhile, and may have missed needs_rearm */
+    if (gpr_atm_full_xchg(&shard->needs_rearm, 0) == 0) return;
+  }
+  gpr_atm_no_barrier_store(&shard->needs_rearm, 0);
+  append_error(error, poll_shard(ps, shard, 0), "drain_shard");
+  gpr_atm_rel_store(&shard->active_poller, 0);
+  shard_rearm(shard);
+}
+
+/* Gives up \a shard, rearming it in g_epoll_set if g_epoll_set reported it
+   meanwhile */
+static void release_shard(epoll_shard* shard) {
+  gpr_atm_full_xchg(&shard->active_poller, 0);
+  if (gpr_atm_full_xchg(&shard->needs_rearm, 0) != 0) shard_rearm(shard);
+}
+
 /* Process the epoll events found by do_epoll_wait() function.
    - g_epoll_set.cursor points to the index of the first event to be processed
-   - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
-     updates the g_epoll_set.cursor
+   - This function then processes up-to MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION
+     (MAX_EPOLL_EVENTS_HANDLED_PER_BATCHED_ITERATION with the
+     epoll_batched_events experiment) and updates the g_epoll_set.cursor
 
    NOTE ON SYNCRHONIZATION: Similar to do_epoll_wait(), this function is only
    called by g_active_poller thread. So there is no need for synchronization
    when accessing fields in g_epoll_set */
-static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
+static grpc_error_handle process_epoll_events(grpc_pollset* pollset) {
   static const char* err_desc = "process_events";
   grpc_error_handle error;
   long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
   long cursor = gpr_atm_acq_load(&g_epoll_set.cursor);
-  for (int idx = 0;
-       (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
-       idx++) {
+  const bool batched = grpc_core::IsEpollBatchedEventsEnabled();
+  const int max_events = batched
+                             ? MAX_EPOLL_EVENTS_HANDLED_PER_BATCHED_ITERATION
+                             : MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION;
+  for (int idx = 0; (idx < max_events) && cursor != num_events; idx++) {
     long c = cursor++;
     struct epoll_event* ev = &g_epoll_set.events[c];
     void* data_ptr = ev->data.ptr;
+    if (batched && idx + 1 < max_events && cursor != num_events) {
+      /* The fd of the next event is handled right after this one: start
+         bringing its closures in while this one's are scheduled */
+      __builtin_prefetch(reinterpret_cast<void*>(
+          reinterpret_cast<intptr_t>(g_epoll_set.events[cursor].data.ptr) &
+          ~static_cast<intptr_t>(1)));
+    }
 
     if (data_ptr == &global_wakeup_fd) {
       append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
                    err_desc);
+    } else if (data_ptr == &g_timerfd) {
+      timerfd_fired();
+    } else if (is_shard(data_ptr)) {
+      drain_shard(pollset, static_cast<epoll_shard*>(data_ptr), &error);
     } else {
-      grpc_fd* fd = reinterpret_cast<grpc_fd*>(
-          reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
-      bool track_err =
-          reinterpret_cast<intptr_t>(data_ptr) & static_cast<intptr_t>(1);
-      bool cancel = (ev->events & EPOLLHUP) != 0;
-      bool error = (ev->events & EPOLLERR) != 0;
-      bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
-      bool write_ev = (ev->events & EPOLLOUT) != 0;
-      bool err_fallback = error && !track_err;
-
-      if (error && !err_fallback) {
-        fd_has_errors(fd);
-      }
-
-      if (read_ev || cancel || err_fallback) {
-        fd_become_readable(fd);
-      }
-
-      if (write_ev || cancel || err_fallback) {
-        fd_become_writable(fd);
-      }
+      process_fd_event(ev);
     }
   }
   gpr_atm_rel_store(&g_epoll_set.cursor, cursor);
@@ -731,6 +1112,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                          grpc_core::Timestamp deadline) {
   if (worker_hdl != nullptr) *worker_hdl = worker;
   worker->initialized_cv = false;
+  worker->poll_shard = nullptr;
   SET_KICK_STATE(worker, UNKICKED);
   worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
   pollset->begin_refs++;
@@ -802,6 +1184,17 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
 
   worker_insert(pollset, worker);
   pollset->begin_refs--;
+  if (g_sharded && worker->state == UNKICKED &&
+      !pollset->kicked_without_poller && !pollset->seen_inactive) {
+    /* Rather than wait for g_epoll_set, poll the shard of the pollset if
+       nobody does */
+    epoll_shard* shard = neighborhood_shard(pollset->neighborhood);
+    if (gpr_atm_acq_cas(&shard->active_poller, 0,
+                        reinterpret_cast<gpr_atm>(worker))) {
+      worker->poll_shard = shard;
+      SET_KICK_STATE(worker, DESIGNATED_POLLER);
+    }
+  }
   if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
     GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
     worker->initialized_cv = true;
@@ -886,8 +1279,9 @@ static bool check_neighborhood_for_available_poller(
           case KICKED:
             break;
           case DESIGNATED_POLLER:
-            found_worker = true;  // ok, so someone else found the worker, but
-                                  // we'll accept that
+            // ok, so someone else found the worker, but we'll accept that;
+            // unless it polls a shard, which leaves g_epoll_set to others
+            if (inspect_worker->poll_shard == nullptr) found_worker = true;
             break;
         }
         inspect_worker = inspect_worker->next;
@@ -921,6 +1315,10 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
   SET_KICK_STATE(worker, KICKED);
   grpc_closure_list_move(&worker->schedule_on_end_work,
                          grpc_core::ExecCtx::Get()->closure_list());
+  if (worker->poll_shard != nullptr) {
+    release_shard(worker->poll_shard);
+    worker->poll_shard = nullptr;
+  }
   if (gpr_atm_no_barrier_load(&g_active_poller) ==
       reinterpret_cast<gpr_atm>(worker)) {
     if (worker->next != worker && worker->next->state == UNKICKED) {
@@ -999,6 +1397,7 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
     return absl::OkStatus();
   }
 
+  grpc_core::StatsTimer timer;
   if (begin_worker(ps, &worker, worker_hdl, deadline)) {
     g_current_thread_pollset = ps;
     g_current_thread_worker = &worker;
@@ -1020,11 +1419,18 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
        accurately grpc_core::ExecCtx::Get()->Flush() happens in end_worker()
        AFTER selecting a designated poller). So we are not waiting long periods
        without a designated poller */
-    if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
-        gpr_atm_acq_load(&g_epoll_set.num_events)) {
-      append_error(&error, do_epoll_wait(ps, deadline), err_desc);
+    if (worker.poll_shard != nullptr) {
+      append_error(&error,
+                   poll_shard(ps, worker.poll_shard,
+                              poll_deadline_to_millis_timeout(deadline)),
+                   err_desc);
+    } else {
+      if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
+          gpr_atm_acq_load(&g_epoll_set.num_events)) {
+        append_error(&error, do_epoll_wait(ps, deadline), err_desc);
+      }
+      append_error(&error, process_epoll_events(ps), err_desc);
     }
-    append_error(&error, process_epoll_events(ps), err_desc);
 
     gpr_mu_lock(&ps->mu); /* lock */
 
@@ -1035,6 +1441,9 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
   end_worker(ps, &worker, worker_hdl);
 
   g_current_thread_pollset = nullptr;
+  if (timer.enabled()) {
+    GRPC_STATS_INC_POLLSET_WORK_TIME_US(timer.ElapsedMicros());
+  }
   return error;
 }
 
@@ -1122,7 +1531,7 @@ static grpc_error_handle pollset_kick(grpc_pollset* pollset,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          ret_err = grpc_wakeup_fd_wakeup(poller_wakeup_fd(next_worker));
           goto done;
         }
       } else {
@@ -1151,14 +1560,15 @@ static grpc_error_handle pollset_kick(grpc_pollset* pollset,
     }
     SET_KICK_STATE(specific_worker, KICKED);
     goto done;
-  } else if (specific_worker ==
-             reinterpret_cast<grpc_pollset_worker*>(
-                 gpr_atm_no_barrier_load(&g_active_poller))) {
+  } else if (specific_worker->poll_shard != nullptr ||
+             specific_worker ==
+                 reinterpret_cast<grpc_pollset_worker*>(
+                     gpr_atm_no_barrier_load(&g_active_poller))) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
       gpr_log(GPR_INFO, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    ret_err = grpc_wakeup_fd_wakeup(poller_wakeup_fd(specific_worker));
     goto done;
   } else if (specific_worker->initialized_cv) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
@@ -1178,7 +1588,29 @@ done:
   return ret_err;
 }
 
-static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
+/* With sharded epoll sets, moves \a fd to the shard of the first pollset it is
+   added to, so that the threads that read it poll it, wherever it was
+   created. */
+static void pollset_add_fd(grpc_pollset* pollset, grpc_fd* fd) {
+  if (!g_sharded || fd->listener) return;
+  gpr_mu_lock(&pollset->mu);
+  epoll_shard* shard = neighborhood_shard(pollset->neighborhood);
+  gpr_mu_unlock(&pollset->mu);
+  gpr_mu_lock(&g_fd_shard_mu);
+  if (!fd->added_to_pollset && fd->shard != shard) {
+    /* Added to its new set first, so that no edge is missed in between */
+    struct epoll_event ev = fd_epoll_event(fd);
+    if (epoll_ctl(shard->epfd, EPOLL_CTL_ADD, fd->fd, &ev) != 0) {
+      gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    } else {
+      epoll_event phony_event;
+      epoll_ctl(fd->shard->epfd, EPOLL_CTL_DEL, fd->fd, &phony_event);
+      fd->shard = shard;
+    }
+  }
+  fd->added_to_pollset = true;
+  gpr_mu_unlock(&g_fd_shard_mu);
+}
 
 /*******************************************************************************
  * Pollset-set Definitions
@@ -1206,11 +1638,73 @@ static void pollset_set_add_pollset_set(grpc_pollset_set* /*bag*/,
 static void pollset_set_del_pollset_set(grpc_pollset_set* /*bag*/,
                                         grpc_pollset_set* /*item*/) {}
 
+/*******************************************************************************
+ * Background poller (epoll1_background_poller experiment)
+ */
+
+/* A thread of the engine's own, that polls until there are events and then
+ * hands the designated poller role over like any other worker. Since the
+ * designated poller polls every fd, it keeps all of them making progress
+ * when no application thread polls, so that the client channel and TCP
+ * backup pollers, which wake up periodically to do the same, are not
+ * needed. */
+static bool g_has_background_poller;
+static grpc_pollset* g_background_pollset;
+/* guarded by g_background_pollset->mu */
+static bool g_background_poller_shutting_down;
+static grpc_core::ManualConstructor<grpc_core::Thread> g_background_poller;
+static thread_local bool g_is_background_poller_thread;
+
+static void background_poller_loop(void* /*arg*/) {
+  g_is_background_poller_thread = true;
+  grpc_core::ExecCtx exec_ctx;
+  gpr_mu_lock(&g_background_pollset->mu);
+  while (!g_background_poller_shutting_down) {
+    GRPC_LOG_IF_ERROR("background_poller",
+                      pollset_work(g_background_pollset, nullptr,
+                                   grpc_core::Timestamp::InfFuture()));
+  }
+  gpr_mu_unlock(&g_background_pollset->mu);
+}
+
+static void background_poller_start(void) {
+  /* The child of a fork would have no poller thread */
+  g_has_background_poller = grpc_core::IsEpoll1BackgroundPollerEnabled() &&
+                            !grpc_core::Fork::Enabled();
+  if (!g_has_background_poller) return;
+  g_background_pollset =
+      static_cast<grpc_pollset*>(gpr_zalloc(sizeof(grpc_pollset)));
+  gpr_mu* mu;
+  pollset_init(g_background_pollset, &mu);
+  g_background_poller_shutting_down = false;
+  g_background_poller.Init("grpc_background_poller", background_poller_loop,
+                           nullptr);
+  g_background_poller->Start();
+}
+
+static void background_poller_stop(void) {
+  if (g_background_pollset == nullptr) return;
+  gpr_mu_lock(&g_background_pollset->mu);
+  g_background_poller_shutting_down = true;
+  GRPC_LOG_IF_ERROR("background_poller_kick",
+                    pollset_kick(g_background_pollset, nullptr));
+  gpr_mu_unlock(&g_background_pollset->mu);
+  g_background_poller->Join();
+  g_background_poller.Destroy();
+  pollset_destroy(g_background_pollset);
+  gpr_free(g_background_pollset);
+  g_background_pollset = nullptr;
+}
+
+bool grpc_epoll1_has_background_poller() { return g_has_background_poller; }
+
 /*******************************************************************************
  * Event engine binding
  */
 
-static bool is_any_background_poller_thread(void) { return false; }
+static bool is_any_background_poller_thread(void) {
+  return g_is_background_poller_thread;
+}
 
 static void shutdown_background_closure(void) {}
 
@@ -1267,9 +1761,9 @@ const grpc_event_engine_vtable grpc_ev_epoll1_posix = {
     is_any_background_poller_thread,
     /* name = */ "epoll1",
     /* check_engine_available = */ [](bool) { return init_epoll1_linux(); },
-    /* init_engine = */ []() {},
+    /* init_engine = */ background_poller_start,
     shutdown_background_closure,
-    /* shutdown_engine = */ []() {},
+    /* shutdown_engine = */ background_poller_stop,
     add_closure_to_background_poller,
 };
 
@@ -1361,5 +1855,7 @@ const grpc_event_engine_vtable grpc_ev_epoll1_posix = {
     nullptr,
     nullptr,
 };
+
+bool grpc_epoll1_has_background_poller() { return false; }
 #endif /* defined(GRPC_POSIX_SOCKET_EV_EPOLL1) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
@@ -28,4 +28,8 @@
 
 extern const grpc_event_engine_vtable grpc_ev_epoll1_posix;
 
+// Whether the engine polls its fds from a thread of its own, with the
+// epoll1_background_poller experiment.  Set when the engine is initialized.
+bool grpc_epoll1_has_background_poller();
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
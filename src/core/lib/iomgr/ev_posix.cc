@@ -204,7 +204,14 @@ bool grpc_event_engine_can_track_errors(void) {
 
 bool grpc_event_engine_run_in_background(void) {
   // g_event_engine is nullptr when using a custom iomgr.
-  return g_event_engine != nullptr && g_event_engine->run_in_background;
+  if (g_event_engine == nullptr) return false;
+#ifdef GRPC_POSIX_SOCKET_EV_EPOLL1
+  if (g_event_engine == &grpc_ev_epoll1_posix &&
+      grpc_epoll1_has_background_poller()) {
+    return true;
+  }
+#endif
+  return g_event_engine->run_in_background;
 }
 
 grpc_fd* grpc_fd_create(int fd, const char* name, bool track_err) {
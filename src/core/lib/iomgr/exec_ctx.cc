@@ -23,6 +23,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/debug/event_trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 
@@ -53,19 +55,23 @@ static void exec_ctx_sched(grpc_closure* closure) {
 
 namespace grpc_core {
 
+constexpr size_t ExecCtx::kInlineCallbackSize;
+constexpr size_t ExecCtx::kInlineCallbacks;
+
 thread_local ExecCtx* ExecCtx::exec_ctx_;
 thread_local ApplicationCallbackExecCtx*
     ApplicationCallbackExecCtx::callback_exec_ctx_;
 
 bool ExecCtx::Flush() {
-  bool did_something = false;
+  const gpr_cycle_counter trace_begin = EventTrace::Now();
+  int64_t closures_run = 0;
   for (;;) {
     if (!grpc_closure_list_empty(closure_list_)) {
       grpc_closure* c = closure_list_.head;
       closure_list_.head = closure_list_.tail = nullptr;
       while (c != nullptr) {
         grpc_closure* next = c->next_data.next;
-        did_something = true;
+        ++closures_run;
         exec_ctx_run(c);
         c = next;
       }
@@ -74,7 +80,11 @@ bool ExecCtx::Flush() {
     }
   }
   GPR_ASSERT(combiner_data_.active_combiner == nullptr);
-  return did_something;
+  if (closures_run > 0) {
+    EventTrace::Complete(EventTrace::Event::kExecCtxFlush, trace_begin,
+                         closures_run);
+  }
+  return closures_run > 0;
 }
 
 void ExecCtx::Run(const DebugLocation& location, grpc_closure* closure,
@@ -21,7 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "absl/numeric/bits.h"
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -192,6 +200,16 @@ class ExecCtx {
 
   static void RunList(const DebugLocation& location, grpc_closure_list* list);
 
+  /** Runs \a callback, a void() functor, in this thread's ExecCtx, in order
+   *  with the closures passed to Run(). While it waits, a callback of up to
+   *  kInlineCallbackSize bytes is kept in the ExecCtx itself, so that
+   *  one-shot work needs no heap allocated closure (see GRPC_CLOSURE_CREATE).
+   */
+  template <typename F>
+  static void RunCallback(const DebugLocation& location, F callback);
+
+  static constexpr size_t kInlineCallbackSize = 4 * sizeof(void*);
+
  protected:
   /** Check if ready to finish. */
   virtual bool CheckReadyToFinish() { return false; }
@@ -203,6 +221,66 @@ class ExecCtx {
   /** Set exec_ctx_ to exec_ctx. */
   static void Set(ExecCtx* exec_ctx) { exec_ctx_ = exec_ctx; }
 
+  static constexpr size_t kInlineCallbacks = 8;
+
+  // A callback waiting to run, and the closure that runs it.
+  struct CallbackSlot {
+    grpc_closure closure;
+    // Runs, then destroys, the callback held in storage.
+    void (*run)(CallbackSlot* slot);
+    // The ExecCtx holding the slot, or null if it was heap allocated.
+    ExecCtx* owner;
+    alignas(alignof(std::max_align_t)) char storage[kInlineCallbackSize];
+  };
+
+  template <typename F>
+  static void StoreCallback(CallbackSlot* slot, F callback,
+                            std::true_type /*fits_inline*/) {
+    new (slot->storage) F(std::move(callback));
+    slot->run = [](CallbackSlot* slot) {
+      F* callback = reinterpret_cast<F*>(slot->storage);
+      (*callback)();
+      callback->~F();
+    };
+  }
+
+  // Larger callbacks still allocate: the slot holds a pointer to them.
+  template <typename F>
+  static void StoreCallback(CallbackSlot* slot, F callback,
+                            std::false_type /*fits_inline*/) {
+    *reinterpret_cast<F**>(slot->storage) = new F(std::move(callback));
+    slot->run = [](CallbackSlot* slot) {
+      F* callback = *reinterpret_cast<F**>(slot->storage);
+      (*callback)();
+      delete callback;
+    };
+  }
+
+  CallbackSlot* AllocCallbackSlot() {
+    if (GPR_LIKELY(callback_slots_used_ != (1u << kInlineCallbacks) - 1)) {
+      const int index = absl::countr_zero(
+          static_cast<uint32_t>(~callback_slots_used_));
+      callback_slots_used_ |= 1u << index;
+      CallbackSlot* slot = &callback_slots_[index];
+      slot->owner = this;
+      return slot;
+    }
+    CallbackSlot* slot = new CallbackSlot;
+    slot->owner = nullptr;
+    return slot;
+  }
+
+  static void RunCallbackSlot(void* arg, grpc_error_handle /*error*/) {
+    CallbackSlot* slot = static_cast<CallbackSlot*>(arg);
+    slot->run(slot);
+    if (slot->owner == nullptr) {
+      delete slot;
+    } else {
+      slot->owner->callback_slots_used_ &=
+          ~(1u << (slot - slot->owner->callback_slots_));
+    }
+  }
+
   grpc_closure_list closure_list_ = GRPC_CLOSURE_LIST_INIT;
   CombinerData combiner_data_ = {nullptr, nullptr};
   uintptr_t flags_;
@@ -212,8 +290,25 @@ class ExecCtx {
   ScopedTimeCache time_cache_;
   static thread_local ExecCtx* exec_ctx_;
   ExecCtx* last_exec_ctx_ = Get();
+
+  // Left uninitialized until used: which of them are is in the mask.
+  uint32_t callback_slots_used_ = 0;
+  CallbackSlot callback_slots_[kInlineCallbacks];
 };
 
+template <typename F>
+void ExecCtx::RunCallback(const DebugLocation& location, F callback) {
+  CallbackSlot* slot = Get()->AllocCallbackSlot();
+  StoreCallback(
+      slot, std::move(callback),
+      std::integral_constant<
+          bool, sizeof(F) <= kInlineCallbackSize &&
+                    alignof(F) <= alignof(std::max_align_t) &&
+                    std::is_nothrow_move_constructible<F>::value>());
+  GRPC_CLOSURE_INIT(&slot->closure, RunCallbackSlot, slot, nullptr);
+  Run(location, &slot->closure, absl::OkStatus());
+}
+
 /** Application-callback execution context.
  *  A bag of data that collects information along a callstack.
  *  It is created on the stack at core entry points, and stored internally
@@ -27,6 +27,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -90,7 +92,15 @@ TraceFlag executor_trace(false, "executor");
 Executor::Executor(const char* name) : name_(name) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
+  gpr_atm_rel_store(&first_thread_started_, 0);
   max_threads_ = std::max(1u, 2 * gpr_cpu_num_cores());
+  gpr_mu_init(&event_engine_mu_);
+  gpr_cv_init(&event_engine_cv_);
+}
+
+Executor::~Executor() {
+  gpr_mu_destroy(&event_engine_mu_);
+  gpr_cv_destroy(&event_engine_cv_);
 }
 
 void Executor::Init() { SetThreading(true); }
@@ -159,15 +169,25 @@ void Executor::SetThreading(bool threading) {
       thd_state_[i].thd = Thread();
       thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
     }
-
-    thd_state_[0].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
-    thd_state_[0].thd.Start();
+    // The first thread starts with the first closure enqueued.
+    if (IsEventEngineExecutorEnabled() && event_engine_ == nullptr) {
+      event_engine_ = grpc_event_engine::experimental::GetDefaultEventEngine();
+    }
   } else {  // !threading
     if (curr_num_threads == 0) {
       EXECUTOR_TRACE("(%s) SetThreading(false). curr_num_threads == 0", name_);
       return;
     }
 
+    // Closures still running on the EventEngine may enqueue more, which go
+    // there too until everything is done.
+    gpr_mu_lock(&event_engine_mu_);
+    while (event_engine_pending_ > 0) {
+      gpr_cv_wait(&event_engine_cv_, &event_engine_mu_,
+                  gpr_inf_future(GPR_CLOCK_MONOTONIC));
+    }
+    gpr_mu_unlock(&event_engine_mu_);
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -182,12 +202,16 @@ void Executor::SetThreading(bool threading) {
 
     curr_num_threads = gpr_atm_no_barrier_load(&num_threads_);
     for (gpr_atm i = 0; i < curr_num_threads; i++) {
+      if (i == 0 && gpr_atm_no_barrier_load(&first_thread_started_) == 0) {
+        continue;
+      }
       thd_state_[i].thd.Join();
       EXECUTOR_TRACE("(%s) Thread %" PRIdPTR " of %" PRIdPTR " joined", name_,
                      i + 1, curr_num_threads);
     }
 
     gpr_atm_rel_store(&num_threads_, 0);
+    gpr_atm_rel_store(&first_thread_started_, 0);
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_destroy(&thd_state_[i].mu);
       gpr_cv_destroy(&thd_state_[i].cv);
@@ -210,6 +234,37 @@ void Executor::SetThreading(bool threading) {
 
 void Executor::Shutdown() { SetThreading(false); }
 
+void Executor::MaybeStartFirstThread() {
+  // Shutdown sets `shutdown` before taking `adding_thread_lock_`, so a thread
+  // started here is always joined.
+  gpr_spinlock_lock(&adding_thread_lock_);
+  if (gpr_atm_no_barrier_load(&first_thread_started_) == 0) {
+    gpr_mu_lock(&thd_state_[0].mu);
+    const bool shutdown = thd_state_[0].shutdown;
+    gpr_mu_unlock(&thd_state_[0].mu);
+    if (!shutdown) {
+      EXECUTOR_TRACE("(%s) starting the first thread", name_);
+      thd_state_[0].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
+      thd_state_[0].thd.Start();
+      gpr_atm_rel_store(&first_thread_started_, 1);
+    }
+  }
+  gpr_spinlock_unlock(&adding_thread_lock_);
+}
+
+void Executor::RunOnEventEngine(grpc_closure_list list) {
+  gpr_mu_lock(&event_engine_mu_);
+  ++event_engine_pending_;
+  gpr_mu_unlock(&event_engine_mu_);
+  event_engine_->Run([this, list]() {
+    ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+    RunClosures(name_, list);
+    gpr_mu_lock(&event_engine_mu_);
+    if (--event_engine_pending_ == 0) gpr_cv_broadcast(&event_engine_cv_);
+    gpr_mu_unlock(&event_engine_mu_);
+  });
+}
+
 void Executor::ThreadMain(void* arg) {
   ThreadState* ts = static_cast<ThreadState*>(arg);
   g_this_thread_state = ts;
@@ -274,6 +329,20 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       return;
     }
 
+    if (event_engine_ != nullptr) {
+#ifndef NDEBUG
+      EXECUTOR_TRACE("(%s) schedule %p (created %s:%d) on the EventEngine",
+                     name_, closure, closure->file_created,
+                     closure->line_created);
+#else
+      EXECUTOR_TRACE("(%s) schedule %p on the EventEngine", name_, closure);
+#endif
+      grpc_closure_list list = GRPC_CLOSURE_LIST_INIT;
+      grpc_closure_list_append(&list, closure, error);
+      RunOnEventEngine(list);
+      return;
+    }
+
     ThreadState* ts = g_this_thread_state;
     if (ts == nullptr) {
       ts = &thd_state_[HashPointer(ExecCtx::Get(), cur_thread_count)];
@@ -281,6 +350,7 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
 
     ThreadState* orig_ts = ts;
     bool try_new_thread = false;
+    bool start_first_thread = false;
 
     for (;;) {
 #ifndef NDEBUG
@@ -342,10 +412,16 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
 
       ts->queued_long_job = !is_short;
 
+      start_first_thread =
+          ts == &thd_state_[0] && !ts->shutdown &&
+          gpr_atm_acq_load(&first_thread_started_) == 0;
+
       gpr_mu_unlock(&ts->mu);
       break;
     }
 
+    if (start_first_thread) MaybeStartFirstThread();
+
     if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
       cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
       if (cur_thread_count < max_threads_) {
@@ -21,6 +21,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/sync.h>
+
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
@@ -55,6 +60,7 @@ enum class ExecutorJobType {
 class Executor {
  public:
   explicit Executor(const char* executor_name);
+  ~Executor();
 
   void Init();
 
@@ -106,12 +112,26 @@ class Executor {
  private:
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
+  // Starts the first thread, unless already started or shut down.
+  void MaybeStartFirstThread();
+  // Runs \a list on one of the EventEngine's threads.
+  void RunOnEventEngine(grpc_closure_list list);
 
   const char* name_;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
+  // The first thread only starts once there is work for it, so that processes
+  // that never use the executor do not pay for its threads.
+  gpr_atm first_thread_started_;
   gpr_spinlock adding_thread_lock_;
+  // With the event_engine_executor experiment, closures run on the default
+  // EventEngine's threads instead, and the executor's own never start.
+  grpc_event_engine::experimental::EventEngine* event_engine_ = nullptr;
+  gpr_mu event_engine_mu_;
+  gpr_cv event_engine_cv_;
+  // Closures handed to event_engine_ that have not finished running yet.
+  size_t event_engine_pending_ = 0;
 };
 
 }  // namespace grpc_core
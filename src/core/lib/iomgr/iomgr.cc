@@ -34,6 +34,7 @@
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
@@ -60,6 +61,7 @@ void grpc_iomgr_init() {
   gpr_mu_init(&g_mu);
   gpr_cv_init(&g_rcv);
   grpc_core::Executor::InitAll();
+  grpc_combiner_global_init();
   g_root_object.next = g_root_object.prev = &g_root_object;
   g_root_object.name = const_cast<char*>("root");
   grpc_iomgr_platform_init();
@@ -23,6 +23,7 @@
 #ifdef GRPC_POSIX_SOCKET_IOMGR
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/resolve_address.h"
@@ -35,6 +36,7 @@
 extern grpc_tcp_server_vtable grpc_posix_tcp_server_vtable;
 extern grpc_tcp_client_vtable grpc_posix_tcp_client_vtable;
 extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_timer_wheel_vtable;
 extern grpc_pollset_vtable grpc_posix_pollset_vtable;
 extern grpc_pollset_set_vtable grpc_posix_pollset_set_vtable;
 
@@ -76,7 +78,9 @@ static grpc_iomgr_platform_vtable vtable = {
 void grpc_set_default_iomgr_platform() {
   grpc_set_tcp_client_impl(&grpc_posix_tcp_client_vtable);
   grpc_set_tcp_server_impl(&grpc_posix_tcp_server_vtable);
-  grpc_set_timer_impl(&grpc_generic_timer_vtable);
+  grpc_set_timer_impl(grpc_core::IsTimerWheelEnabled()
+                          ? &grpc_timer_wheel_vtable
+                          : &grpc_generic_timer_vtable);
   grpc_set_pollset_vtable(&grpc_posix_pollset_vtable);
   grpc_set_pollset_set_vtable(&grpc_posix_pollset_set_vtable);
   grpc_core::SetDNSResolver(grpc_core::NativeDNSResolver::GetOrCreate());
@@ -24,6 +24,7 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/iomgr/iocp_windows.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset_windows.h"
@@ -38,6 +39,7 @@
 extern grpc_tcp_server_vtable grpc_windows_tcp_server_vtable;
 extern grpc_tcp_client_vtable grpc_windows_tcp_client_vtable;
 extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_timer_wheel_vtable;
 extern grpc_pollset_vtable grpc_windows_pollset_vtable;
 extern grpc_pollset_set_vtable grpc_windows_pollset_set_vtable;
 
@@ -93,7 +95,9 @@ static grpc_iomgr_platform_vtable vtable = {
 void grpc_set_default_iomgr_platform() {
   grpc_set_tcp_client_impl(&grpc_windows_tcp_client_vtable);
   grpc_set_tcp_server_impl(&grpc_windows_tcp_server_vtable);
-  grpc_set_timer_impl(&grpc_generic_timer_vtable);
+  grpc_set_timer_impl(grpc_core::IsTimerWheelEnabled()
+                          ? &grpc_timer_wheel_vtable
+                          : &grpc_generic_timer_vtable);
   grpc_set_pollset_vtable(&grpc_windows_pollset_vtable);
   grpc_set_pollset_set_vtable(&grpc_windows_pollset_set_vtable);
   grpc_core::SetDNSResolver(grpc_core::NativeDNSResolver::GetOrCreate());
@@ -0,0 +1,93 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/map_file.h"
+
+#include "absl/strings/str_format.h"
+
+#include "src/core/lib/slice/slice_refcount_base.h"
+
+#ifndef GPR_WINDOWS
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Unmaps a file region once its slice goes away.
+class MappedFileRegion : public grpc_slice_refcount {
+ public:
+  MappedFileRegion(void* mapping, size_t length)
+      : grpc_slice_refcount(Destroy), mapping_(mapping), length_(length) {}
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* region = static_cast<MappedFileRegion*>(p);
+    munmap(region->mapping_, region->length_);
+    delete region;
+  }
+
+  void* const mapping_;
+  const size_t length_;
+};
+
+}  // namespace
+
+grpc_error_handle grpc_map_file_region(int fd, uint64_t offset, size_t length,
+                                       grpc_slice* output) {
+  if (length == 0) {
+    *output = grpc_empty_slice();
+    return absl::OkStatus();
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) return GRPC_OS_ERROR(errno, "fstat");
+  if (offset > static_cast<uint64_t>(st.st_size) ||
+      length > static_cast<uint64_t>(st.st_size) - offset) {
+    return GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrFormat("%d bytes from %d are past the end of a %d byte file",
+                        length, offset, static_cast<int64_t>(st.st_size)));
+  }
+  // Mappings start on a page boundary.
+  static const uint64_t page_size =
+      static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t map_offset = offset / page_size * page_size;
+  const size_t map_length = static_cast<size_t>(offset - map_offset) + length;
+  void* mapping = mmap(nullptr, map_length, PROT_READ, MAP_SHARED, fd,
+                       static_cast<off_t>(map_offset));
+  if (mapping == MAP_FAILED) return GRPC_OS_ERROR(errno, "mmap");
+  // The region is usually sent from beginning to end, once.
+  madvise(mapping, map_length, MADV_SEQUENTIAL);
+  output->refcount = new MappedFileRegion(mapping, map_length);
+  output->data.refcounted.bytes =
+      static_cast<uint8_t*>(mapping) + (offset - map_offset);
+  output->data.refcounted.length = length;
+  return absl::OkStatus();
+}
+
+#else  // GPR_WINDOWS
+
+grpc_error_handle grpc_map_file_region(int /*fd*/, uint64_t /*offset*/,
+                                       size_t /*length*/,
+                                       grpc_slice* /*output*/) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "mapping file regions is not supported on this platform");
+}
+
+#endif  // GPR_WINDOWS
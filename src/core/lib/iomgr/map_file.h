@@ -0,0 +1,40 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_IOMGR_MAP_FILE_H
+#define GRPC_CORE_LIB_IOMGR_MAP_FILE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/iomgr/error.h"
+
+// Maps the \a length bytes of the file open as \a fd from \a offset into
+// memory, read only, as a slice that unmaps them once its last ref goes.
+// Unlike grpc_load_file, nothing is read up front: the pages come from the
+// page cache as they are touched, which for a plaintext TCP endpoint is when
+// the kernel sends them (without any copy at all with
+// GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED). \a fd may be closed right away, but the
+// file must not be truncated while the slice is in use. Only supported on
+// POSIX platforms.
+grpc_error_handle grpc_map_file_region(int fd, uint64_t offset, size_t length,
+                                       grpc_slice* output);
+
+#endif  // GRPC_CORE_LIB_IOMGR_MAP_FILE_H
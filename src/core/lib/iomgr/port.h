@@ -55,7 +55,21 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0) */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0)
+#define GRPC_LINUX_TCP_ZEROCOPY_RECEIVE 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0) */
 #endif /* LINUX_VERSION_CODE */
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define GRPC_LINUX_IO_URING 1
+#endif /* __has_include(<linux/io_uring.h>) */
+#if __has_include(<linux/tls.h>)
+#define GRPC_LINUX_KTLS 1
+#endif /* __has_include(<linux/tls.h>) */
+#if __has_include(<linux/memfd.h>)
+#define GRPC_LINUX_MEMFD 1
+#endif /* __has_include(<linux/memfd.h>) */
+#endif /* defined(__has_include) */
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
 #define GRPC_POSIX_FORK 1
 #define GRPC_POSIX_HOST_NAME_MAX 1
@@ -148,6 +148,66 @@ grpc_error_handle grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes) {
              : GRPC_OS_ERROR(errno, "setsockopt(SO_RCVBUF)");
 }
 
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int busy_poll_us) {
+#ifdef SO_BUSY_POLL
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us,
+                      sizeof(busy_poll_us))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+  return absl::OkStatus();
+#else
+  (void)fd;
+  (void)busy_poll_us;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_BUSY_POLL is not supported on this platform");
+#endif
+}
+
+grpc_error_handle grpc_set_socket_fastopen_connect(int fd) {
+#ifdef TCP_FASTOPEN_CONNECT
+  int val = 1;
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &val,
+                      sizeof(val))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN_CONNECT)");
+  }
+  return absl::OkStatus();
+#else
+  (void)fd;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN_CONNECT is not supported on this platform");
+#endif
+}
+
+grpc_error_handle grpc_set_socket_fastopen(int fd, int queue_length) {
+#ifdef TCP_FASTOPEN
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_length,
+                      sizeof(queue_length))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN)");
+  }
+  return absl::OkStatus();
+#else
+  (void)fd;
+  (void)queue_length;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN is not supported on this platform");
+#endif
+}
+
+grpc_error_handle grpc_set_socket_notsent_lowat(int fd, int lowat_bytes) {
+#ifdef TCP_NOTSENT_LOWAT
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &lowat_bytes,
+                      sizeof(lowat_bytes))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_NOTSENT_LOWAT)");
+  }
+  return absl::OkStatus();
+#else
+  (void)fd;
+  (void)lowat_bytes;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_NOTSENT_LOWAT is not supported on this platform");
+#endif
+}
+
 /* set a socket to close on exec */
 grpc_error_handle grpc_set_socket_cloexec(int fd, int close_on_exec) {
   int oldflags = fcntl(fd, F_GETFD, 0);
@@ -78,10 +78,27 @@ PosixTcpOptions TcpOptionsFromEndpointConfig(const EndpointConfig& config) {
   options.tcp_tx_zero_copy_enabled =
       (AdjustValue(PosixTcpOptions::kZerocpTxEnabledDefault, 0, 1,
                    config.GetInt(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) != 0);
+  options.tcp_rx_zerocopy_read_bytes_threshold = AdjustValue(
+      PosixTcpOptions::kDefaultReceiveBytesThreshold, 0, INT_MAX,
+      config.GetInt(GRPC_ARG_TCP_RX_ZEROCOPY_READ_BYTES_THRESHOLD));
+  options.tcp_rx_zero_copy_enabled =
+      (AdjustValue(PosixTcpOptions::kZerocpRxEnabledDefault, 0, 1,
+                   config.GetInt(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) != 0);
+  options.pass_fds =
+      AdjustValue(0, 0, 1, config.GetInt(GRPC_ARG_UDS_MEMFD_DATA_ENABLED)) != 0;
+  options.release_read_buffer_when_idle =
+      (AdjustValue(0, 1, INT_MAX,
+                   config.GetInt(GRPC_ARG_IDLE_HIBERNATION_MS)) != 0);
   options.keep_alive_time_ms =
       AdjustValue(0, 1, INT_MAX, config.GetInt(GRPC_ARG_KEEPALIVE_TIME_MS));
   options.keep_alive_timeout_ms =
       AdjustValue(0, 1, INT_MAX, config.GetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS));
+  options.tcp_busy_poll_us =
+      AdjustValue(0, 0, INT_MAX, config.GetInt(GRPC_ARG_TCP_BUSY_POLL_US));
+  options.tcp_fastopen =
+      AdjustValue(0, 0, 1, config.GetInt(GRPC_ARG_TCP_FASTOPEN)) != 0;
+  options.tcp_notsent_lowat =
+      AdjustValue(0, 0, INT_MAX, config.GetInt(GRPC_ARG_TCP_NOTSENT_LOWAT));
   options.expand_wildcard_addrs =
       (AdjustValue(0, 1, INT_MAX,
                    config.GetInt(GRPC_ARG_EXPAND_WILDCARD_ADDRS)) != 0);
@@ -49,14 +49,27 @@ struct PosixTcpOptions {
   static constexpr int kMaxChunkSize = 32 * 1024 * 1024;
   static constexpr int kDefaultMaxSends = 4;
   static constexpr size_t kDefaultSendBytesThreshold = 16 * 1024;
+  static constexpr int kZerocpRxEnabledDefault = 0;
+  static constexpr int kDefaultReceiveBytesThreshold = 256 * 1024;
   int tcp_read_chunk_size = kDefaultReadChunkSize;
   int tcp_min_read_chunk_size = kDefaultMinReadChunksize;
   int tcp_max_read_chunk_size = kDefaultMaxReadChunksize;
   int tcp_tx_zerocopy_send_bytes_threshold = kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simultaneous_sends = kDefaultMaxSends;
   bool tcp_tx_zero_copy_enabled = kZerocpTxEnabledDefault;
+  int tcp_rx_zerocopy_read_bytes_threshold = kDefaultReceiveBytesThreshold;
+  bool tcp_rx_zero_copy_enabled = kZerocpRxEnabledDefault;
+  // Pass descriptors over unix domain sockets (set by
+  // GRPC_ARG_UDS_MEMFD_DATA_ENABLED).
+  bool pass_fds = false;
+  // Free the spare read buffer while waiting for the peer to send something
+  // (set by GRPC_ARG_IDLE_HIBERNATION_MS).
+  bool release_read_buffer_when_idle = false;
   int keep_alive_time_ms = 0;
   int keep_alive_timeout_ms = 0;
+  int tcp_busy_poll_us = 0;
+  bool tcp_fastopen = false;
+  int tcp_notsent_lowat = 0;
   bool expand_wildcard_addrs = false;
   bool allow_reuse_port = false;
   RefCountedPtr<ResourceQuota> resource_quota;
@@ -119,8 +132,16 @@ struct PosixTcpOptions {
     tcp_tx_zerocopy_max_simultaneous_sends =
         other.tcp_tx_zerocopy_max_simultaneous_sends;
     tcp_tx_zero_copy_enabled = other.tcp_tx_zero_copy_enabled;
+    tcp_rx_zerocopy_read_bytes_threshold =
+        other.tcp_rx_zerocopy_read_bytes_threshold;
+    tcp_rx_zero_copy_enabled = other.tcp_rx_zero_copy_enabled;
+    pass_fds = other.pass_fds;
+    release_read_buffer_when_idle = other.release_read_buffer_when_idle;
     keep_alive_time_ms = other.keep_alive_time_ms;
     keep_alive_timeout_ms = other.keep_alive_timeout_ms;
+    tcp_busy_poll_us = other.tcp_busy_poll_us;
+    tcp_fastopen = other.tcp_fastopen;
+    tcp_notsent_lowat = other.tcp_notsent_lowat;
     expand_wildcard_addrs = other.expand_wildcard_addrs;
     allow_reuse_port = other.allow_reuse_port;
   }
@@ -191,6 +212,23 @@ grpc_error_handle grpc_set_socket_sndbuf(int fd, int buffer_size_bytes);
 /* Tries to set the socket's receive buffer to given size. */
 grpc_error_handle grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes);
 
+/* Tries to set SO_BUSY_POLL to the given number of microseconds if available on
+   this platform. */
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int busy_poll_us);
+
+/* Tries to set TCP_FASTOPEN_CONNECT on a client socket if available on this
+   platform, so that connect() is deferred to the first write when the kernel
+   has a Fast Open cookie for the peer. */
+grpc_error_handle grpc_set_socket_fastopen_connect(int fd);
+
+/* Tries to set TCP_FASTOPEN on a listening socket if available on this
+   platform, with room for queue_length pending Fast Open requests. */
+grpc_error_handle grpc_set_socket_fastopen(int fd, int queue_length);
+
+/* Tries to set TCP_NOTSENT_LOWAT to the given number of bytes if available on
+   this platform. */
+grpc_error_handle grpc_set_socket_notsent_lowat(int fd, int lowat_bytes);
+
 /* Tries to set the socket using a grpc_socket_mutator */
 grpc_error_handle grpc_set_socket_with_mutator(int fd, grpc_fd_usage usage,
                                                grpc_socket_mutator* mutator);
@@ -109,6 +109,30 @@ static grpc_error_handle prepare_socket(
     if (!err.ok()) goto error;
     err = grpc_set_socket_tcp_user_timeout(fd, options, true /* is_client */);
     if (!err.ok()) goto error;
+    if (options.tcp_busy_poll_us > 0) {
+      err = grpc_set_socket_busy_poll(fd, options.tcp_busy_poll_us);
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without SO_BUSY_POLL: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
+    if (options.tcp_fastopen) {
+      err = grpc_set_socket_fastopen_connect(fd);
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without TCP_FASTOPEN_CONNECT: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
+    if (options.tcp_notsent_lowat > 0) {
+      err = grpc_set_socket_notsent_lowat(fd, options.tcp_notsent_lowat);
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without TCP_NOTSENT_LOWAT: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (!err.ok()) goto error;
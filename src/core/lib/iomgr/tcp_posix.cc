@@ -35,10 +35,16 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#include <sys/mman.h>
+#endif
 #include <unistd.h>
 
 #include <algorithm>
+#include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
@@ -48,7 +54,9 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/event_log.h"
+#include "src/core/lib/debug/event_trace.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/experiments/experiments.h"
@@ -60,10 +68,13 @@
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/iomgr/tcp_zerocopy_threshold.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/trace.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/slice/slice_refcount_base.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
 #ifndef SOL_TCP
@@ -90,6 +101,16 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+// Set in the ee_code of a zerocopy completion if the kernel copied the data.
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+// Only use TCP_ZEROCOPY_RECEIVE if the library headers know about it too.
+#if defined(GRPC_LINUX_TCP_ZEROCOPY_RECEIVE) && !defined(TCP_ZEROCOPY_RECEIVE)
+#undef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -98,6 +119,11 @@ typedef size_t msg_iovlen_type;
 
 extern grpc_core::TraceFlag grpc_tcp_trace;
 
+static int64_t monotonic_nanos() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
 namespace grpc_core {
 
 class TcpZerocopySendRecord {
@@ -132,6 +158,15 @@ class TcpZerocopySendRecord {
   // Indicates whether all underlying data has been sent or not.
   bool AllSlicesSent() { return out_offset_.slice_idx == buf_.count; }
 
+  // When the most recent sendmsg() for this record was issued, as returned by
+  // monotonic_nanos(). Read when its completion arrives on the error queue.
+  void set_last_send_nanos(int64_t nanos) {
+    last_send_nanos_.store(nanos, std::memory_order_relaxed);
+  }
+  int64_t last_send_nanos() const {
+    return last_send_nanos_.load(std::memory_order_relaxed);
+  }
+
   // Reset this structure for a new tcp_write() with zerocopy.
   void PrepareForSends(grpc_slice_buffer* slices_to_send) {
     AssertEmpty();
@@ -179,6 +214,7 @@ class TcpZerocopySendRecord {
 
   grpc_slice_buffer buf_;
   std::atomic<intptr_t> ref_{0};
+  std::atomic<int64_t> last_send_nanos_{0};
   OutgoingOffset out_offset_;
 };
 
@@ -469,9 +505,13 @@ struct grpc_tcp {
   explicit grpc_tcp(const grpc_core::PosixTcpOptions& tcp_options)
       : min_read_chunk_size(tcp_options.tcp_min_read_chunk_size),
         max_read_chunk_size(tcp_options.tcp_max_read_chunk_size),
+        release_read_buffer_when_idle(
+            tcp_options.release_read_buffer_when_idle),
         tcp_zerocopy_send_ctx(
             tcp_options.tcp_tx_zerocopy_max_simultaneous_sends,
-            tcp_options.tcp_tx_zerocopy_send_bytes_threshold) {}
+            tcp_options.tcp_tx_zerocopy_send_bytes_threshold),
+        rx_zerocopy_threshold(
+            tcp_options.tcp_rx_zerocopy_read_bytes_threshold) {}
   grpc_endpoint base;
   grpc_fd* em_fd;
   int fd;
@@ -490,6 +530,8 @@ struct grpc_tcp {
 
   /* garbage after the last read */
   grpc_slice_buffer last_read_buffer;
+  /* free that garbage rather than keep it while waiting for POLLIN */
+  const bool release_read_buffer_when_idle;
 
   grpc_core::Mutex read_mu;
   grpc_slice_buffer* incoming_buffer ABSL_GUARDED_BY(read_mu) = nullptr;
@@ -539,6 +581,32 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+  /* Replaces tcp_zerocopy_send_ctx's fixed threshold when the
+     adaptive_tcp_zerocopy_threshold experiment is enabled. */
+  std::unique_ptr<grpc_core::TcpZerocopyThresholdController>
+      zerocopy_threshold;
+  /* Set while the current write is a copying send that zerocopy_threshold
+     wants timed. */
+  bool time_copy_sends = false;
+  /* Where zerocopy_threshold publishes its decisions. */
+  grpc_core::Mutex channelz_mu;
+  grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket
+      ABSL_GUARDED_BY(channelz_mu);
+
+  /* Whether reads may map kernel receive buffers instead of copying them.
+     Cleared the first time the socket turns out not to support it. */
+  bool rx_zerocopy_enabled = false;
+  /* Only zerocopy receive when at least this many bytes are expected. */
+  const int rx_zerocopy_threshold;
+
+  /* Whether descriptors are passed to and from the peer of this unix domain
+     socket (see grpc_tcp_can_pass_fds()). */
+  bool pass_fds = false;
+  grpc_core::Mutex passed_fds_mu;
+  /* Descriptors to send along with the next bytes written. */
+  std::vector<int> fds_to_send ABSL_GUARDED_BY(passed_fds_mu);
+  /* Descriptors received along with the bytes read, oldest first. */
+  std::deque<int> received_fds ABSL_GUARDED_BY(passed_fds_mu);
 
   bool frame_size_tuning_enabled;
   int min_progress_size; /* A hint from upper layers specifying the minimum
@@ -740,6 +808,11 @@ static void tcp_free(grpc_tcp* tcp) {
   gpr_mu_unlock(&tcp->tb_mu);
   tcp->outgoing_buffer_arg = nullptr;
   gpr_mu_destroy(&tcp->tb_mu);
+  {
+    grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+    for (int fd : tcp->fds_to_send) close(fd);
+    for (int fd : tcp->received_fds) close(fd);
+  }
   delete tcp;
 }
 
@@ -869,8 +942,139 @@ static void update_rcvlowat(grpc_tcp* tcp)
   tcp->set_rcvlowat = remaining;
 }
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+namespace {
+
+// Reference count for a slice that maps pages of the socket receive queue.
+// Unmaps them, and releases the memory quota charged for them, once the slice
+// is destroyed.
+class ZerocopyReceiveSliceRefCount : public grpc_slice_refcount {
+ public:
+  ZerocopyReceiveSliceRefCount(
+      void* mapping, size_t length,
+      grpc_core::MemoryAllocator::Reservation reservation)
+      : grpc_slice_refcount(Destroy),
+        mapping_(mapping),
+        length_(length),
+        reservation_(std::move(reservation)) {}
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* rc = static_cast<ZerocopyReceiveSliceRefCount*>(p);
+    munmap(rc->mapping_, rc->length_);
+    delete rc;
+  }
+
+  void* const mapping_;
+  const size_t length_;
+  grpc_core::MemoryAllocator::Reservation reservation_;
+};
+
+}  // namespace
+
+/* Tries to map the next bytes of the receive queue into memory rather than
+   copying them out. Only whole pages can be mapped, so the remainder of the
+   queue is left for recvmsg(). Returns the number of bytes placed in
+   \a slice, which is zero if nothing could be mapped. */
+static size_t tcp_zerocopy_receive(grpc_tcp* tcp, grpc_slice* slice)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  if (!tcp->rx_zerocopy_enabled) return 0;
+  // Use whichever of the pending bytes reported by TCP_INQ and the recent read
+  // sizes promises the bigger read.
+  const size_t expected_length =
+      std::max(static_cast<size_t>(tcp->inq),
+               static_cast<size_t>(tcp->target_length));
+  if (expected_length < static_cast<size_t>(tcp->rx_zerocopy_threshold)) {
+    return 0;
+  }
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t map_length =
+      std::min(expected_length, static_cast<size_t>(tcp->max_read_chunk_size)) /
+      page_size * page_size;
+  if (map_length == 0) return 0;
+  void* mapping = mmap(nullptr, map_length, PROT_READ, MAP_SHARED, tcp->fd, 0);
+  if (mapping == MAP_FAILED) {
+    gpr_log(GPR_DEBUG, "Disabling TCP RX zerocopy on fd=%d: mmap: %s", tcp->fd,
+            strerror(errno));
+    tcp->rx_zerocopy_enabled = false;
+    return 0;
+  }
+  struct tcp_zerocopy_receive zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uintptr_t>(mapping);
+  zc.length = static_cast<uint32_t>(map_length);
+  socklen_t zc_len = sizeof(zc);
+  int err;
+  do {
+    GRPC_STATS_INC_SYSCALL_READ();
+    err = getsockopt(tcp->fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (err < 0 && errno == EINTR);
+  // Nothing was mapped, e.g. because the data does not fill a page or the
+  // kernel did not receive it into page aligned buffers: recvmsg() will copy
+  // it instead.
+  if (err != 0 || zc.length == 0) {
+    if (err != 0 && errno != EAGAIN) {
+      gpr_log(GPR_DEBUG,
+              "Disabling TCP RX zerocopy on fd=%d: TCP_ZEROCOPY_RECEIVE: %s",
+              tcp->fd, strerror(errno));
+      tcp->rx_zerocopy_enabled = false;
+    }
+    munmap(mapping, map_length);
+    return 0;
+  }
+  const size_t mapped_length =
+      (zc.length + page_size - 1) / page_size * page_size;
+  if (mapped_length < map_length) {
+    munmap(static_cast<char*>(mapping) + mapped_length,
+           map_length - mapped_length);
+  }
+  slice->refcount = new ZerocopyReceiveSliceRefCount(
+      mapping, mapped_length, tcp->memory_owner.MakeReservation(mapped_length));
+  slice->data.refcounted.bytes = static_cast<uint8_t*>(mapping);
+  slice->data.refcounted.length = zc.length;
+  return zc.length;
+}
+#else  /* GRPC_LINUX_TCP_ZEROCOPY_RECEIVE */
+static size_t tcp_zerocopy_receive(grpc_tcp* /*tcp*/, grpc_slice* /*slice*/) {
+  return 0;
+}
+#endif /* GRPC_LINUX_TCP_ZEROCOPY_RECEIVE */
+
 /* Returns true if data available to read or error other than EAGAIN. */
 #define MAX_READ_IOVEC 64
+/* Control message space for the most descriptors passed with one sendmsg(). */
+constexpr size_t kPassedFdsCmsgSpace =
+    CMSG_SPACE(sizeof(int) * GRPC_TCP_MAX_PASSED_FDS);
+/* The most received descriptors held until taken. */
+constexpr size_t kMaxHeldReceivedFds = 4 * GRPC_TCP_MAX_PASSED_FDS;
+
+/* Queues the descriptors that came with a read for
+   grpc_tcp_take_received_fd(). */
+static void tcp_keep_received_fds(grpc_tcp* tcp, struct msghdr* msg) {
+  if (msg->msg_flags & MSG_CTRUNC) {
+    gpr_log(GPR_ERROR, "TCP:%p dropped descriptors passed by the peer", tcp);
+  }
+  grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count; i++) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(fd));
+      // A peer that passes descriptors nobody asks for only gets to hold
+      // down so many of ours.
+      if (tcp->received_fds.size() >= kMaxHeldReceivedFds) {
+        close(fd);
+      } else {
+        tcp->received_fds.push_back(fd);
+      }
+    }
+  }
+}
+
 static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -889,6 +1093,8 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
   constexpr size_t cmsg_alloc_space = 24 /* CMSG_SPACE(sizeof(int)) */;
 #endif /* GRPC_LINUX_ERRQUEUE */
   char cmsgbuf[cmsg_alloc_space];
+  /* Room for the descriptors the peer passes along with one sendmsg(). */
+  alignas(struct cmsghdr) char fds_cmsgbuf[kPassedFdsCmsgSpace];
   for (size_t i = 0; i < iov_len; i++) {
     iov[i].iov_base = GRPC_SLICE_START_PTR(tcp->incoming_buffer->slices[i]);
     iov[i].iov_len = GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
@@ -897,6 +1103,14 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
   GPR_ASSERT(tcp->incoming_buffer->length != 0);
   GPR_DEBUG_ASSERT(tcp->min_progress_size > 0);
 
+  /* Bytes mapped by tcp_zerocopy_receive() precede anything read below. */
+  grpc_slice zerocopy_slice;
+  const size_t zerocopy_read_bytes = tcp_zerocopy_receive(tcp, &zerocopy_slice);
+  if (zerocopy_read_bytes > 0) {
+    GRPC_STATS_INC_TCP_READ_SIZE(zerocopy_read_bytes);
+    add_to_estimate(tcp, zerocopy_read_bytes);
+  }
+
   do {
     /* Assume there is something on the queue. If we receive TCP_INQ from
      * kernel, we will update this value, otherwise, we have to assume there is
@@ -910,6 +1124,9 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     if (tcp->inq_capable) {
       msg.msg_control = cmsgbuf;
       msg.msg_controllen = sizeof(cmsgbuf);
+    } else if (tcp->pass_fds) {
+      msg.msg_control = fds_cmsgbuf;
+      msg.msg_controllen = sizeof(fds_cmsgbuf);
     } else {
       msg.msg_control = nullptr;
       msg.msg_controllen = 0;
@@ -919,15 +1136,21 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     GRPC_STATS_INC_TCP_READ_OFFER(tcp->incoming_buffer->length);
     GRPC_STATS_INC_TCP_READ_OFFER_IOV_SIZE(tcp->incoming_buffer->count);
 
-    do {
-      GRPC_STATS_INC_SYSCALL_READ();
-      read_bytes = recvmsg(tcp->fd, &msg, 0);
-    } while (read_bytes < 0 && errno == EINTR);
+    {
+      grpc_core::EventTrace::Scope trace(
+          grpc_core::EventTrace::Event::kTcpRead);
+      do {
+        GRPC_STATS_INC_SYSCALL_READ();
+        read_bytes =
+            recvmsg(tcp->fd, &msg, tcp->pass_fds ? MSG_CMSG_CLOEXEC : 0);
+      } while (read_bytes < 0 && errno == EINTR);
+      trace.set_arg(read_bytes);
+    }
 
     /* We have read something in previous reads. We need to deliver those
      * bytes to the upper layer. */
-    if (read_bytes <= 0 &&
-        total_read_bytes >= static_cast<size_t>(tcp->min_progress_size)) {
+    if (read_bytes <= 0 && total_read_bytes + zerocopy_read_bytes >=
+                               static_cast<size_t>(tcp->min_progress_size)) {
       tcp->inq = 1;
       break;
     }
@@ -936,13 +1159,14 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
       /* NB: After calling call_read_cb a parallel call of the read handler may
        * be running. */
       if (errno == EAGAIN) {
-        if (total_read_bytes > 0) {
+        if (total_read_bytes + zerocopy_read_bytes > 0) {
           break;
         }
         finish_estimate(tcp);
         tcp->inq = 0;
         return false;
       } else {
+        if (zerocopy_read_bytes > 0) grpc_slice_unref(zerocopy_slice);
         grpc_slice_buffer_reset_and_unref(tcp->incoming_buffer);
         *error = tcp_annotate_error(GRPC_OS_ERROR(errno, "recvmsg"), tcp);
         return true;
@@ -954,6 +1178,7 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
        * We may have read something, i.e., total_read_bytes > 0, but
        * since the connection is closed we will drop the data here, because we
        * can't call the callback multiple times. */
+      if (zerocopy_read_bytes > 0) grpc_slice_unref(zerocopy_slice);
       grpc_slice_buffer_reset_and_unref(tcp->incoming_buffer);
       *error = tcp_annotate_error(
           GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), tcp);
@@ -964,6 +1189,7 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     add_to_estimate(tcp, static_cast<size_t>(read_bytes));
     GPR_DEBUG_ASSERT((size_t)read_bytes <=
                      tcp->incoming_buffer->length - total_read_bytes);
+    if (tcp->pass_fds && !tcp->inq_capable) tcp_keep_received_fds(tcp, &msg);
 
 #ifdef GRPC_HAVE_TCP_INQ
     if (tcp->inq_capable) {
@@ -1010,6 +1236,17 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     finish_estimate(tcp);
   }
 
+  if (zerocopy_read_bytes > 0) {
+    // Put the mapped bytes in front of any copied ones.
+    grpc_slice_buffer read_buffer;
+    grpc_slice_buffer_init(&read_buffer);
+    grpc_slice_buffer_add_indexed(&read_buffer, zerocopy_slice);
+    grpc_slice_buffer_move_into(tcp->incoming_buffer, &read_buffer);
+    grpc_slice_buffer_swap(&read_buffer, tcp->incoming_buffer);
+    grpc_slice_buffer_destroy(&read_buffer);
+    total_read_bytes += zerocopy_read_bytes;
+  }
+
   GPR_DEBUG_ASSERT(total_read_bytes > 0);
   *error = absl::OkStatus();
   if (tcp->frame_size_tuning_enabled) {
@@ -1162,6 +1399,10 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
     tcp->is_first_read = false;
     notify_on_read(tcp);
   } else if (!urgent && tcp->inq == 0) {
+    if (tcp->release_read_buffer_when_idle) {
+      /* maybe_make_read_slices allocates again once there is data. */
+      grpc_slice_buffer_reset_and_unref(incoming_buffer);
+    }
     update_rcvlowat(tcp);
     tcp->read_mu.Unlock();
     /* Upper layer asked to read more but we know there is no pending data
@@ -1184,12 +1425,18 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
  * of bytes sent. */
 ssize_t tcp_send(int fd, const struct msghdr* msg, int* saved_errno,
                  int additional_flags = 0) {
+  grpc_core::EventTrace::Scope trace(grpc_core::EventTrace::Event::kTcpWrite);
   ssize_t sent_length;
   do {
     /* TODO(klempner): Cork if this is a partial write */
     GRPC_STATS_INC_SYSCALL_WRITE();
     sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && (*saved_errno = errno) == EINTR);
+  // With TCP_FASTOPEN_CONNECT, the first write of a client socket sends the
+  // SYN, and fails with EINPROGRESS if none of the data fit in it. The socket
+  // becomes writable once the handshake completes, as after EAGAIN.
+  if (sent_length < 0 && *saved_errno == EINPROGRESS) *saved_errno = EAGAIN;
+  trace.set_arg(sent_length);
   return sent_length;
 }
 
@@ -1210,18 +1457,50 @@ static void tcp_handle_error(void* arg /* grpc_tcp */, grpc_error_handle error);
 static TcpZerocopySendRecord* tcp_get_send_zerocopy_record(
     grpc_tcp* tcp, grpc_slice_buffer* buf);
 
+// Reports the adaptive zerocopy threshold and the reasoning behind it as
+// socket options of the transport's channelz socket.
+static void publish_zerocopy_threshold(grpc_tcp* tcp) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "TCP:%p zerocopy %s", tcp,
+            tcp->zerocopy_threshold->LastDecision().c_str());
+  }
+  grpc_core::MutexLock lock(&tcp->channelz_mu);
+  if (tcp->channelz_socket == nullptr) return;
+  tcp->channelz_socket->SetSocketOption(
+      "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold",
+      std::to_string(tcp->zerocopy_threshold->threshold()));
+  std::string decision = tcp->zerocopy_threshold->LastDecision();
+  if (!decision.empty()) {
+    tcp->channelz_socket->SetSocketOption(
+        "grpc.experimental.tcp_tx_zerocopy_last_decision",
+        std::move(decision));
+  }
+}
+
 #ifdef GRPC_LINUX_ERRQUEUE
 static bool process_errors(grpc_tcp* tcp);
 
 static TcpZerocopySendRecord* tcp_get_send_zerocopy_record(
     grpc_tcp* tcp, grpc_slice_buffer* buf) {
   TcpZerocopySendRecord* zerocopy_send_record = nullptr;
-  const bool use_zerocopy =
-      tcp->tcp_zerocopy_send_ctx.enabled() &&
-      tcp->tcp_zerocopy_send_ctx.threshold_bytes() < buf->length;
+  tcp->time_copy_sends = false;
+  bool use_zerocopy;
+  if (!tcp->tcp_zerocopy_send_ctx.enabled()) {
+    use_zerocopy = false;
+  } else if (tcp->zerocopy_threshold != nullptr) {
+    use_zerocopy = tcp->zerocopy_threshold->ShouldZerocopy(buf->length);
+    tcp->time_copy_sends =
+        !use_zerocopy &&
+        buf->length >= tcp->zerocopy_threshold->threshold() / 2;
+  } else {
+    use_zerocopy = tcp->tcp_zerocopy_send_ctx.threshold_bytes() < buf->length;
+  }
   if (use_zerocopy) {
     zerocopy_send_record = tcp->tcp_zerocopy_send_ctx.GetSendRecord();
     if (zerocopy_send_record == nullptr) {
+      if (tcp->zerocopy_threshold != nullptr) {
+        tcp->zerocopy_threshold->RecordSendRecordsExhausted();
+      }
       process_errors(tcp);
       zerocopy_send_record = tcp->tcp_zerocopy_send_ctx.GetSendRecord();
     }
@@ -1291,6 +1570,7 @@ static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
 static void UnrefMaybePutZerocopySendRecord(grpc_tcp* tcp,
                                             TcpZerocopySendRecord* record,
                                             uint32_t seq, const char* tag);
+
 // Reads \a cmsg to process zerocopy control messages.
 static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
   GPR_DEBUG_ASSERT(cmsg);
@@ -1299,6 +1579,10 @@ static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
   GPR_DEBUG_ASSERT(serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY);
   const uint32_t lo = serr->ee_info;
   const uint32_t hi = serr->ee_data;
+  const bool copied = (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+  const int64_t now =
+      tcp->zerocopy_threshold != nullptr ? monotonic_nanos() : 0;
+  bool threshold_changed = false;
   for (uint32_t seq = lo; seq <= hi; ++seq) {
     // TODO(arjunroy): It's likely that lo and hi refer to zerocopy sequence
     // numbers that are generated by a single call to grpc_endpoint_write; ie.
@@ -1307,8 +1591,13 @@ static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
     TcpZerocopySendRecord* record =
         tcp->tcp_zerocopy_send_ctx.ReleaseSendRecord(seq);
     GPR_DEBUG_ASSERT(record);
+    if (tcp->zerocopy_threshold != nullptr) {
+      threshold_changed |= tcp->zerocopy_threshold->RecordCompletion(
+          now - record->last_send_nanos(), copied);
+    }
     UnrefMaybePutZerocopySendRecord(tcp, record, seq, "CALLBACK RCVD");
   }
+  if (threshold_changed) publish_zerocopy_threshold(tcp);
   if (tcp->tcp_zerocopy_send_ctx.UpdateZeroCopyOMemStateAfterFree()) {
     grpc_fd_set_writable(tcp->em_fd);
   }
@@ -1481,7 +1770,12 @@ static void tcp_handle_error(void* arg /* grpc_tcp */,
 
   /* We are still interested in collecting timestamps, so let's try reading
    * them. */
+  const int64_t start =
+      tcp->zerocopy_threshold != nullptr ? monotonic_nanos() : 0;
   bool processed = process_errors(tcp);
+  if (processed && tcp->zerocopy_threshold != nullptr) {
+    tcp->zerocopy_threshold->RecordErrqueueTime(monotonic_nanos() - start);
+  }
   /* This might not a timestamps error. Set the read and write closures to be
    * ready. */
   if (!processed) {
@@ -1602,6 +1896,9 @@ static bool do_tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
     // Before calling sendmsg (with or without timestamps): we
     // take a single ref on the zerocopy send record.
     tcp->tcp_zerocopy_send_ctx.NoteSend(record);
+    const int64_t send_start =
+        tcp->zerocopy_threshold != nullptr ? monotonic_nanos() : 0;
+    record->set_last_send_nanos(send_start);
     saved_errno = 0;
     if (tcp->outgoing_buffer_arg != nullptr) {
       if (!tcp->ts_capable ||
@@ -1622,6 +1919,10 @@ static bool do_tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
       GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
       sent_length = tcp_send(tcp->fd, &msg, &saved_errno, MSG_ZEROCOPY);
     }
+    if (tcp->zerocopy_threshold != nullptr && sent_length > 0) {
+      tcp->zerocopy_threshold->RecordZerocopySend(
+          static_cast<size_t>(sent_length), monotonic_nanos() - send_start);
+    }
     if (tcp->tcp_zerocopy_send_ctx.UpdateZeroCopyOMemStateAfterSend(
             saved_errno == ENOBUFS)) {
       grpc_fd_set_writable(tcp->em_fd);
@@ -1673,9 +1974,36 @@ static bool tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
   return done;
 }
 
+/* Attaches the descriptors waiting to be passed to the peer to \a msg, using
+   \a cmsgbuf of kPassedFdsCmsgSpace bytes. Returns how many were attached. */
+static size_t tcp_attach_fds_to_send(grpc_tcp* tcp, struct msghdr* msg,
+                                     char* cmsgbuf) {
+  grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+  const size_t count = tcp->fds_to_send.size();
+  if (count == 0) return 0;
+  msg->msg_control = cmsgbuf;
+  msg->msg_controllen = CMSG_SPACE(count * sizeof(int));
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(count * sizeof(int));
+  memcpy(CMSG_DATA(cmsg), tcp->fds_to_send.data(), count * sizeof(int));
+  return count;
+}
+
+/* Closes the first \a count descriptors waiting to be passed, now that the
+   peer has them. */
+static void tcp_drop_sent_fds(grpc_tcp* tcp, size_t count) {
+  grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+  for (size_t i = 0; i < count; i++) close(tcp->fds_to_send[i]);
+  tcp->fds_to_send.erase(tcp->fds_to_send.begin(),
+                         tcp->fds_to_send.begin() + count);
+}
+
 static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
   struct msghdr msg;
   struct iovec iov[MAX_WRITE_IOVEC];
+  alignas(struct cmsghdr) char fds_cmsgbuf[kPassedFdsCmsgSpace];
   msg_iovlen_type iov_size;
   ssize_t sent_length = 0;
   size_t sending_length;
@@ -1715,7 +2043,9 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
     msg.msg_flags = 0;
     bool tried_sending_message = false;
     saved_errno = 0;
-    if (tcp->outgoing_buffer_arg != nullptr) {
+    const size_t fds_sending =
+        tcp->pass_fds ? tcp_attach_fds_to_send(tcp, &msg, fds_cmsgbuf) : 0;
+    if (tcp->outgoing_buffer_arg != nullptr && fds_sending == 0) {
       if (!tcp->ts_capable ||
           !tcp_write_with_timestamps(tcp, &msg, sending_length, &sent_length,
                                      &saved_errno)) {
@@ -1728,13 +2058,24 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
       }
     }
     if (!tried_sending_message) {
-      msg.msg_control = nullptr;
-      msg.msg_controllen = 0;
+      if (fds_sending == 0) {
+        msg.msg_control = nullptr;
+        msg.msg_controllen = 0;
+      }
 
       GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
       GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
 
-      sent_length = tcp_send(tcp->fd, &msg, &saved_errno);
+      if (tcp->time_copy_sends) {
+        const int64_t send_start = monotonic_nanos();
+        sent_length = tcp_send(tcp->fd, &msg, &saved_errno);
+        if (sent_length > 0) {
+          tcp->zerocopy_threshold->RecordCopySend(
+              static_cast<size_t>(sent_length), monotonic_nanos() - send_start);
+        }
+      } else {
+        sent_length = tcp_send(tcp->fd, &msg, &saved_errno);
+      }
     }
 
     if (sent_length < 0) {
@@ -1760,6 +2101,7 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
     }
 
     GPR_ASSERT(tcp->outgoing_byte_idx == 0);
+    if (fds_sending > 0) tcp_drop_sent_fds(tcp, fds_sending);
     grpc_core::EventLog::Append("tcp-write-outstanding", -sent_length);
     tcp->bytes_counter += sent_length;
     trailing = sending_length - static_cast<size_t>(sent_length);
@@ -1937,6 +2279,17 @@ static bool tcp_can_track_err(grpc_endpoint* ep) {
   return addr.sa_family == AF_INET || addr.sa_family == AF_INET6;
 }
 
+static void tcp_set_channelz_socket(grpc_endpoint* ep,
+                                    grpc_core::channelz::SocketNode* socket) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  if (tcp->zerocopy_threshold == nullptr) return;
+  {
+    grpc_core::MutexLock lock(&tcp->channelz_mu);
+    tcp->channelz_socket = socket == nullptr ? nullptr : socket->Ref();
+  }
+  publish_zerocopy_threshold(tcp);
+}
+
 static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_write,
                                             tcp_add_to_pollset,
@@ -1947,7 +2300,8 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_get_peer,
                                             tcp_get_local_address,
                                             tcp_get_fd,
-                                            tcp_can_track_err};
+                                            tcp_can_track_err,
+                                            tcp_set_channelz_socket};
 
 grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_core::PosixTcpOptions& options,
@@ -1995,11 +2349,22 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
         setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
     if (err == 0) {
       tcp->tcp_zerocopy_send_ctx.set_enabled(true);
+      if (grpc_core::IsAdaptiveTcpZerocopyThresholdEnabled()) {
+        tcp->zerocopy_threshold =
+            std::make_unique<grpc_core::TcpZerocopyThresholdController>(
+                options.tcp_tx_zerocopy_send_bytes_threshold);
+      }
     } else {
       gpr_log(GPR_ERROR, "Failed to set zerocopy options on the socket.");
     }
 #endif
   }
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  tcp->rx_zerocopy_enabled = options.tcp_rx_zero_copy_enabled;
+#endif
+  tcp->pass_fds = options.pass_fds &&
+                  !tcp->tcp_zerocopy_send_ctx.enabled() &&
+                  grpc_is_unix_socket(&resolved_local_addr);
   /* paired with unref in grpc_tcp_destroy */
   new (&tcp->refcount) grpc_core::RefCount(
       1, GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace) ? "tcp" : nullptr);
@@ -2070,6 +2435,28 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   TCP_UNREF(tcp, "destroy");
 }
 
+bool grpc_tcp_can_pass_fds(grpc_endpoint* ep) {
+  return ep->vtable == &vtable && reinterpret_cast<grpc_tcp*>(ep)->pass_fds;
+}
+
+void grpc_tcp_queue_fd_for_write(grpc_endpoint* ep, int fd) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  GPR_ASSERT(grpc_tcp_can_pass_fds(ep));
+  grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+  GPR_ASSERT(tcp->fds_to_send.size() < GRPC_TCP_MAX_PASSED_FDS);
+  tcp->fds_to_send.push_back(fd);
+}
+
+int grpc_tcp_take_received_fd(grpc_endpoint* ep) {
+  if (!grpc_tcp_can_pass_fds(ep)) return -1;
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  grpc_core::MutexLock lock(&tcp->passed_fds_mu);
+  if (tcp->received_fds.empty()) return -1;
+  int fd = tcp->received_fds.front();
+  tcp->received_fds.pop_front();
+  return fd;
+}
+
 void grpc_tcp_posix_init() { g_backup_poller_mu = new grpc_core::Mutex; }
 
 void grpc_tcp_posix_shutdown() {
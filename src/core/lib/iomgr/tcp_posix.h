@@ -56,6 +56,26 @@ int grpc_tcp_fd(grpc_endpoint* ep);
 void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
                                      grpc_closure* done);
 
+/// The most descriptors that may be queued with grpc_tcp_queue_fd_for_write()
+/// before the next write.
+#define GRPC_TCP_MAX_PASSED_FDS 16
+
+/// Whether \a ep passes descriptors to and from its peer along with the bytes
+/// it writes and reads: it must be a tcp endpoint over a unix domain socket,
+/// created with PosixTcpOptions::pass_fds. Returns false for any other
+/// endpoint.
+bool grpc_tcp_can_pass_fds(grpc_endpoint* ep);
+
+/// Sends \a fd to the peer along with the first bytes written from now on, and
+/// closes it once sent. The peer receives it no later than those bytes.
+/// Requires: grpc_tcp_can_pass_fds(ep), and fewer than GRPC_TCP_MAX_PASSED_FDS
+/// descriptors queued since the last write.
+void grpc_tcp_queue_fd_for_write(grpc_endpoint* ep, int fd);
+
+/// Returns the oldest descriptor received from the peer and not yet taken,
+/// which the caller then owns, or -1 if there is none.
+int grpc_tcp_take_received_fd(grpc_endpoint* ep);
+
 #ifdef GRPC_POSIX_SOCKET_TCP
 
 void grpc_tcp_posix_init();
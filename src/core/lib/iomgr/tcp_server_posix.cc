@@ -80,6 +80,10 @@ static grpc_error_handle tcp_server_create(grpc_closure* shutdown_complete,
   if (value.has_value()) {
     s->expand_wildcard_addrs = (*value != 0);
   }
+  value = config.GetInt(GRPC_ARG_REUSEPORT_SHARDING);
+  if (value.has_value()) {
+    s->reuseport_sharding = (*value != 0);
+  }
   gpr_ref_init(&s->refs, 1);
   gpr_mu_init(&s->mu);
   s->active_ports = 0;
@@ -260,10 +264,14 @@ static void on_read(void* arg, grpc_error_handle err) {
     std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
 
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
+    if (sp->server->reuseport_sharding && sp->pollset != nullptr) {
+      read_notifier_pollset = sp->pollset;
+    } else {
+      read_notifier_pollset = (*(sp->server->pollsets))
+          [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+               &sp->server->next_pollset_to_assign, 1)) %
+           sp->server->pollsets->size()];
+    }
 
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
 
@@ -523,6 +531,7 @@ static void tcp_server_start(grpc_tcp_server* s,
           "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
       for (i = 0; i < pollsets->size(); i++) {
         grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        sp->pollset = (*pollsets)[i];
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -533,6 +542,7 @@ static void tcp_server_start(grpc_tcp_server* s,
       for (i = 0; i < pollsets->size(); i++) {
         grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
       }
+      sp->pollset = nullptr;
       GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                         grpc_schedule_on_exec_ctx);
       grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
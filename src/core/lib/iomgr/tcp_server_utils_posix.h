@@ -47,6 +47,9 @@ typedef struct grpc_tcp_listener {
      identified while iterating through 'next'. */
   struct grpc_tcp_listener* sibling;
   int is_sibling;
+  /* the pollset this listener was added to, if it is one of several
+     SO_REUSEPORT listeners for its address that have a pollset each */
+  grpc_pollset* pollset;
 } grpc_tcp_listener;
 
 /* the overall server */
@@ -71,6 +74,8 @@ struct grpc_tcp_server {
   bool so_reuseport = false;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs = false;
+  /* poll connections with the pollset of the listener that accepted them */
+  bool reuseport_sharding = false;
 
   /* linked list of server ports */
   grpc_tcp_listener* head = nullptr;
@@ -180,6 +180,32 @@ grpc_error_handle grpc_tcp_server_prepare_socket(
     err =
         grpc_set_socket_tcp_user_timeout(fd, s->options, false /* is_client */);
     if (!err.ok()) goto error;
+    // Accepted sockets inherit SO_BUSY_POLL from the listener.
+    if (s->options.tcp_busy_poll_us > 0) {
+      err = grpc_set_socket_busy_poll(fd, s->options.tcp_busy_poll_us);
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without SO_BUSY_POLL: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
+    if (s->options.tcp_fastopen) {
+      err = grpc_set_socket_fastopen(fd, get_max_accept_queue_size());
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without TCP_FASTOPEN: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
+    // Accepted sockets inherit TCP_NOTSENT_LOWAT from the listener.
+    if (s->options.tcp_notsent_lowat > 0) {
+      err = grpc_set_socket_notsent_lowat(fd, s->options.tcp_notsent_lowat);
+      if (!err.ok()) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_INFO, "Continuing without TCP_NOTSENT_LOWAT: %s",
+                grpc_error_std_string(err).c_str());
+      }
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (!err.ok()) goto error;
@@ -0,0 +1,181 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_IOMGR_TCP_ZEROCOPY_THRESHOLD_H
+#define GRPC_CORE_LIB_IOMGR_TCP_ZEROCOPY_THRESHOLD_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/str_format.h"
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Moves the size above which a TCP endpoint sends with MSG_ZEROCOPY towards
+// the point where zerocopy starts to pay off for this endpoint.
+//
+// Writes of at least threshold() bytes use zerocopy, except for one in every
+// kProbeInterval which is copied instead; one in every kProbeInterval writes
+// of between threshold()/2 and threshold() bytes use zerocopy. Timing those
+// sends near the threshold with both methods gives the CPU cost per byte of
+// copying and of zerocopy (sendmsg() plus reading the completions off the
+// error queue). After every kCompletionsPerDecision completions the threshold
+// is halved if zerocopy is clearly cheaper, and doubled if it is not cheaper,
+// if the kernel had to copy most of the data anyway, or if zerocopy sends had
+// to wait for slow completions to free up a send record.
+//
+// Thread safe: sends and completions are usually recorded from different
+// threads.
+class TcpZerocopyThresholdController {
+ public:
+  static constexpr size_t kMinThreshold = 4 * 1024;
+  static constexpr size_t kMaxThreshold = 4 * 1024 * 1024;
+  static constexpr uint32_t kProbeInterval = 16;
+  static constexpr uint32_t kCompletionsPerDecision = 64;
+  static constexpr uint32_t kMinCopyProbesPerDecision = 2;
+
+  explicit TcpZerocopyThresholdController(size_t initial_threshold)
+      : threshold_(Clamp(initial_threshold, kMinThreshold, kMaxThreshold)) {}
+
+  size_t threshold() const {
+    return threshold_.load(std::memory_order_relaxed);
+  }
+
+  // Returns true if a write of \a bytes should be sent with zerocopy.
+  bool ShouldZerocopy(size_t bytes) {
+    const size_t threshold = this->threshold();
+    if (bytes < threshold / 2) return false;
+    const bool probe =
+        probe_counter_.fetch_add(1, std::memory_order_relaxed) %
+            kProbeInterval ==
+        0;
+    return (bytes >= threshold) != probe;
+  }
+
+  // Records that a copying sendmsg() of a write that ShouldZerocopy() was
+  // asked about took \a nanos to send \a bytes.
+  void RecordCopySend(size_t bytes, int64_t nanos) {
+    MutexLock lock(&mu_);
+    copy_bytes_ += bytes;
+    copy_nanos_ += nanos;
+    ++copy_sends_;
+  }
+
+  // Records that a zerocopy sendmsg() took \a nanos to send \a bytes.
+  void RecordZerocopySend(size_t bytes, int64_t nanos) {
+    MutexLock lock(&mu_);
+    zerocopy_bytes_ += bytes;
+    zerocopy_nanos_ += nanos;
+  }
+
+  // Records time spent reading zerocopy completions off the error queue.
+  void RecordErrqueueTime(int64_t nanos) {
+    MutexLock lock(&mu_);
+    zerocopy_nanos_ += nanos;
+  }
+
+  // Records that a zerocopy write had to wait for a free send record.
+  void RecordSendRecordsExhausted() {
+    MutexLock lock(&mu_);
+    ++records_exhausted_;
+  }
+
+  // Records the completion of a zerocopy sendmsg() issued \a delay_nanos ago.
+  // \a copied is set if the kernel reported that it copied the data after all.
+  // Returns true if this changed the threshold.
+  bool RecordCompletion(int64_t delay_nanos, bool copied) {
+    MutexLock lock(&mu_);
+    ++completions_;
+    if (copied) ++copied_completions_;
+    completion_delay_nanos_ += delay_nanos;
+    if (completions_ < kCompletionsPerDecision ||
+        copy_sends_ < kMinCopyProbesPerDecision) {
+      return false;
+    }
+    return DecideLocked();
+  }
+
+  // Describes the inputs and outcome of the last decision.
+  std::string LastDecision() {
+    MutexLock lock(&mu_);
+    return last_decision_;
+  }
+
+ private:
+  bool DecideLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const double copy_ns_per_byte =
+        copy_bytes_ == 0 ? 0 : static_cast<double>(copy_nanos_) / copy_bytes_;
+    const double zerocopy_ns_per_byte =
+        zerocopy_bytes_ == 0
+            ? 0
+            : static_cast<double>(zerocopy_nanos_) / zerocopy_bytes_;
+    const double copied_fraction =
+        static_cast<double>(copied_completions_) / completions_;
+    const size_t old_threshold = threshold();
+    size_t new_threshold = old_threshold;
+    if (records_exhausted_ > 0 || copied_fraction > 0.5 ||
+        zerocopy_ns_per_byte >= copy_ns_per_byte) {
+      new_threshold = std::min(old_threshold * 2, size_t{kMaxThreshold});
+    } else if (zerocopy_ns_per_byte * 2 <= copy_ns_per_byte) {
+      new_threshold = std::max(old_threshold / 2, size_t{kMinThreshold});
+    }
+    last_decision_ = absl::StrFormat(
+        "threshold %d -> %d: copy %.3fns/B, zerocopy %.3fns/B, "
+        "%.0f%% copied by kernel, %.0fus mean completion delay, "
+        "%d waits for a send record",
+        old_threshold, new_threshold, copy_ns_per_byte, zerocopy_ns_per_byte,
+        copied_fraction * 100,
+        static_cast<double>(completion_delay_nanos_) / completions_ / 1000,
+        records_exhausted_);
+    threshold_.store(new_threshold, std::memory_order_relaxed);
+    copy_bytes_ = 0;
+    copy_nanos_ = 0;
+    copy_sends_ = 0;
+    zerocopy_bytes_ = 0;
+    zerocopy_nanos_ = 0;
+    completions_ = 0;
+    copied_completions_ = 0;
+    completion_delay_nanos_ = 0;
+    records_exhausted_ = 0;
+    return new_threshold != old_threshold;
+  }
+
+  std::atomic<size_t> threshold_;
+  std::atomic<uint32_t> probe_counter_{0};
+  Mutex mu_;
+  uint64_t copy_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t copy_nanos_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t copy_sends_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t zerocopy_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t zerocopy_nanos_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t completions_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t copied_completions_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t completion_delay_nanos_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t records_exhausted_ ABSL_GUARDED_BY(mu_) = 0;
+  std::string last_decision_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_IOMGR_TCP_ZEROCOPY_THRESHOLD_H
@@ -127,8 +127,9 @@ void grpc_timer_list_shutdown();
 /* Consume a kick issued by grpc_kick_poller */
 void grpc_timer_consume_kick(void);
 
-/* the following must be implemented by each iomgr implementation */
-void grpc_kick_poller(void);
+/* the following must be implemented by each iomgr implementation: called with
+   the deadline of a new timer that expires before any other */
+void grpc_kick_poller(grpc_core::Timestamp deadline);
 
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
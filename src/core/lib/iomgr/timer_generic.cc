@@ -29,6 +29,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/debug/event_trace.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/useful.h"
@@ -421,7 +422,7 @@ static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
         // g_shared_mutables.min_timer varialbe under g_shared_mutables.mu
         g_shared_mutables.min_timer = deadline;
 #endif
-        grpc_kick_poller();
+        grpc_kick_poller(deadline);
       }
     }
     gpr_mu_unlock(&g_shared_mutables.mu);
@@ -535,6 +536,11 @@ static grpc_timer* pop_one(timer_shard* shard, grpc_core::Timestamp now) {
       gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
               (now - timer_deadline).millis());
     }
+    if (grpc_core::EventTrace::enabled() &&
+        now != grpc_core::Timestamp::InfFuture()) {
+      grpc_core::EventTrace::Instant(grpc_core::EventTrace::Event::kTimerFire,
+                                     (now - timer_deadline).millis());
+    }
     timer->pending = false;
     grpc_timer_heap_pop(&shard->heap);
     return timer;
@@ -22,6 +22,8 @@
 
 #include <inttypes.h>
 
+#include <atomic>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -61,6 +63,14 @@ static grpc_core::Timestamp g_timed_waiter_deadline;
 static uint64_t g_timed_waiter_generation;
 // number of timer wakeups
 static uint64_t g_wakeups;
+// the poller running timers, if any (see grpc_timer_manager_set_poller)
+static std::atomic<const grpc_timer_poller*> g_poller{nullptr};
+
+// How late a timer may be before a timer thread runs it in the poller's stead,
+// while a thread is polling: a poller that runs timers on time never has a
+// timer thread wake up for them.
+static constexpr grpc_core::Duration kPollerSlack =
+    grpc_core::Duration::Milliseconds(50);
 
 static void timer_thread(void* completed_thread_ptr);
 
@@ -158,6 +168,12 @@ static bool wait_until(grpc_core::Timestamp next) {
   // deadline from the timer system
 
   if (!g_kicked) {
+    if (next != grpc_core::Timestamp::InfFuture()) {
+      const grpc_timer_poller* poller =
+          g_poller.load(std::memory_order_acquire);
+      if (poller != nullptr && poller->polling()) next = next + kPollerSlack;
+    }
+
     // if there's no timed waiter, we should become one: that waiter waits
     // only until the next timer should expire. All other timers wait forever
     //
@@ -232,7 +248,12 @@ static void timer_main_loop() {
     grpc_core::ExecCtx::Get()->InvalidateNow();
 
     // check timer state, updates next to the next time to run a check
-    switch (grpc_timer_check(&next)) {
+    grpc_timer_check_result result = grpc_timer_check(&next);
+    const grpc_timer_poller* poller = g_poller.load(std::memory_order_acquire);
+    if (poller != nullptr && next != grpc_core::Timestamp::InfFuture()) {
+      poller->arm(next);
+    }
+    switch (result) {
       case GRPC_TIMERS_FIRED:
         run_some_timers();
         break;
@@ -350,8 +371,37 @@ void grpc_timer_manager_set_threading(bool enabled) {
   }
 }
 
-void grpc_kick_poller(void) {
+void grpc_timer_manager_set_poller(const grpc_timer_poller* poller) {
+  g_poller.store(poller, std::memory_order_release);
+}
+
+void grpc_timer_manager_run_from_poller(void) {
+  const grpc_timer_poller* poller = g_poller.load(std::memory_order_acquire);
+  if (poller == nullptr) return;
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  // The poller may have been armed for a timer this thread has not seen yet.
+  grpc_timer_consume_kick();
+  grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+  if (grpc_timer_check(&next) == GRPC_TIMERS_NOT_CHECKED) {
+    // Another thread is running timers, and may still be at it when the next
+    // one expires: look again shortly.
+    next = grpc_core::ExecCtx::Get()->Now() +
+           grpc_core::Duration::Milliseconds(1);
+  }
+  poller->arm(next);
+}
+
+void grpc_kick_poller(grpc_core::Timestamp deadline) {
+  const grpc_timer_poller* poller = g_poller.load(std::memory_order_acquire);
+  if (poller != nullptr) poller->arm(deadline);
   gpr_mu_lock(&g_mu);
+  // The poller is to run this timer, and the timed waiter wakes up soon enough
+  // after it to step in if the poller does not.
+  if (poller != nullptr && g_has_timed_waiter &&
+      g_timed_waiter_deadline <= deadline + kPollerSlack) {
+    gpr_mu_unlock(&g_mu);
+    return;
+  }
   g_kicked = true;
   g_has_timed_waiter = false;
   g_timed_waiter_deadline = grpc_core::Timestamp::InfFuture();
@@ -23,6 +23,8 @@
 
 #include <stdbool.h>
 
+#include "src/core/lib/gprpp/time.h"
+
 /* Timer Manager tries to keep only one thread waiting for the next timeout at
    all times, and thus effectively preventing the thundering herd problem. */
 
@@ -35,6 +37,20 @@ void grpc_timer_manager_set_threading(bool enabled);
 /* explicitly perform one tick of the timer system - for when threading is
  * disabled */
 void grpc_timer_manager_tick(void);
+
+/* A poller that runs timers itself, so that they need no timer thread to wake
+   up: arm() asks it to call grpc_timer_manager_run_from_poller() once past
+   the given deadline (or never, for InfFuture), and polling() says whether a
+   thread is in it to do so right now. */
+typedef struct grpc_timer_poller {
+  void (*arm)(grpc_core::Timestamp deadline);
+  bool (*polling)(void);
+} grpc_timer_poller;
+/* hand timers to \a poller (or back to the timer threads, for nullptr): the
+   timer threads then only wake up for timers the poller is late to run */
+void grpc_timer_manager_set_poller(const grpc_timer_poller* poller);
+/* run the expired timers from the poller, and arm it for the next one */
+void grpc_timer_manager_run_from_poller(void);
 /* get global counter that tracks timer wakeups */
 uint64_t grpc_timer_manager_get_wakeups_testonly(void);
 
@@ -0,0 +1,312 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// A grpc_timer_vtable backed by hierarchical timer wheels rather than the
+// heaps used by timer_generic.cc. Timer init and cancel are O(1) regardless of
+// the number of pending timers, which makes arming and cancelling per-call
+// deadlines cheaper on servers with many outstanding calls.
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/event_trace.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/timer_wheel.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+struct WheelShard {
+  gpr_mu mu;
+  grpc_core::ManualConstructor<grpc_core::HierarchicalTimerWheel<grpc_timer>>
+      wheel;
+  // The last min_deadline published for this shard; guarded by mu so that
+  // timer_init only takes g_shared_mutables.mu when it lowers the deadline.
+  grpc_core::Timestamp published_min_deadline;
+  // A lower bound for the deadline of the next timer due in this shard.
+  // Guarded by g_shared_mutables.mu.
+  grpc_core::Timestamp min_deadline;
+};
+
+size_t g_num_shards;
+WheelShard* g_shards;
+
+// See g_last_seen_min_timer in timer_generic.cc.
+thread_local int64_t g_last_seen_min_timer;
+
+struct SharedMutables {
+  // The deadline of the next timer due across all timer shards.
+  std::atomic<int64_t> min_timer;
+  // Allow only one run_some_expired_timers at once.
+  gpr_spinlock checker_mu;
+  bool initialized;
+  // Protects the min_deadline of every shard.
+  gpr_mu mu;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+SharedMutables g_shared_mutables;
+
+grpc_core::Timestamp NextDeadline(WheelShard* shard) {
+  // NextDeadline() returns INT64_MAX, i.e. InfFuture, for an empty wheel.
+  return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+      shard->wheel->NextDeadline());
+}
+
+// REQUIRES: shard->mu unlocked
+size_t PopTimers(WheelShard* shard, grpc_core::Timestamp now,
+                 grpc_core::Timestamp* new_min_deadline,
+                 grpc_error_handle error) {
+  size_t n = 0;
+  auto on_expired = [&n, &error, now](grpc_timer* timer) {
+    if (grpc_core::EventTrace::enabled() &&
+        now != grpc_core::Timestamp::InfFuture()) {
+      grpc_core::EventTrace::Instant(
+          grpc_core::EventTrace::Event::kTimerFire,
+          now.milliseconds_after_process_epoch() - timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, error);
+    n++;
+  };
+  gpr_mu_lock(&shard->mu);
+  if (now == grpc_core::Timestamp::InfFuture()) {
+    shard->wheel->PopAll(on_expired);
+  } else {
+    shard->wheel->Advance(now.milliseconds_after_process_epoch(), on_expired);
+  }
+  *new_min_deadline = shard->published_min_deadline = NextDeadline(shard);
+  gpr_mu_unlock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "  .. shard[%d] popped %" PRIdPTR,
+            static_cast<int>(shard - g_shards), n);
+  }
+  return n;
+}
+
+grpc_timer_check_result RunSomeExpiredTimers(grpc_core::Timestamp now,
+                                             grpc_core::Timestamp* next,
+                                             grpc_error_handle error) {
+  grpc_core::Timestamp min_timer =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          g_shared_mutables.min_timer.load(std::memory_order_relaxed));
+  g_last_seen_min_timer = min_timer.milliseconds_after_process_epoch();
+
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (!gpr_spinlock_trylock(&g_shared_mutables.checker_mu)) {
+    return GRPC_TIMERS_NOT_CHECKED;
+  }
+  grpc_timer_check_result result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+  gpr_mu_lock(&g_shared_mutables.mu);
+  grpc_core::Timestamp min_deadline = grpc_core::Timestamp::InfFuture();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    if (shard->min_deadline < now ||
+        (now != grpc_core::Timestamp::InfFuture() &&
+         shard->min_deadline == now)) {
+      if (PopTimers(shard, now, &shard->min_deadline, error) > 0) {
+        result = GRPC_TIMERS_FIRED;
+      }
+    }
+    min_deadline = std::min(min_deadline, shard->min_deadline);
+  }
+  if (next != nullptr) *next = std::min(*next, min_deadline);
+  g_shared_mutables.min_timer.store(
+      min_deadline.milliseconds_after_process_epoch(),
+      std::memory_order_relaxed);
+  gpr_mu_unlock(&g_shared_mutables.mu);
+  gpr_spinlock_unlock(&g_shared_mutables.checker_mu);
+  return result;
+}
+
+void TimerListInit() {
+  g_num_shards = grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u);
+  g_shards =
+      static_cast<WheelShard*>(gpr_zalloc(g_num_shards * sizeof(*g_shards)));
+
+  g_shared_mutables.initialized = true;
+  g_shared_mutables.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_shared_mutables.mu);
+  const grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+  g_shared_mutables.min_timer.store(now.milliseconds_after_process_epoch(),
+                                    std::memory_order_relaxed);
+
+  g_last_seen_min_timer = 0;
+
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->wheel.Init(now.milliseconds_after_process_epoch());
+    shard->published_min_deadline = now;
+    shard->min_deadline = now;
+  }
+}
+
+void TimerListShutdown() {
+  RunSomeExpiredTimers(
+      grpc_core::Timestamp::InfFuture(), nullptr,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown"));
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    gpr_mu_destroy(&shard->mu);
+    shard->wheel.Destroy();
+  }
+  gpr_mu_destroy(&g_shared_mutables.mu);
+  gpr_free(g_shards);
+  g_shared_mutables.initialized = false;
+}
+
+void TimerInit(grpc_timer* timer, grpc_core::Timestamp deadline,
+               grpc_closure* closure) {
+  bool is_first_timer = false;
+  WheelShard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  timer->closure = closure;
+  timer->deadline = deadline.milliseconds_after_process_epoch();
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline.milliseconds_after_process_epoch(),
+            grpc_core::Timestamp::Now().milliseconds_after_process_epoch(),
+            closure, closure->cb);
+  }
+
+  if (!g_shared_mutables.initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, absl::OkStatus());
+    gpr_mu_unlock(&shard->mu);
+    /* early out */
+    return;
+  }
+  shard->wheel->Add(timer);
+  if (deadline < shard->published_min_deadline) {
+    shard->published_min_deadline = deadline;
+    is_first_timer = true;
+  }
+  gpr_mu_unlock(&shard->mu);
+
+  // As in timer_generic.cc, a timer check may intervene between the two
+  // locks; the checks below err on the side of an early wakeup.
+  if (is_first_timer) {
+    gpr_mu_lock(&g_shared_mutables.mu);
+    if (deadline < shard->min_deadline) {
+      shard->min_deadline = deadline;
+      if (deadline <
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+              g_shared_mutables.min_timer.load(std::memory_order_relaxed))) {
+        g_shared_mutables.min_timer.store(
+            deadline.milliseconds_after_process_epoch(),
+            std::memory_order_relaxed);
+        grpc_kick_poller(deadline);
+      }
+    }
+    gpr_mu_unlock(&g_shared_mutables.mu);
+  }
+}
+
+void TimerConsumeKick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+void TimerCancel(grpc_timer* timer) {
+  if (!g_shared_mutables.initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  WheelShard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            absl::CancelledError());
+    timer->pending = false;
+    shard->wheel->Remove(timer);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+grpc_timer_check_result TimerCheck(grpc_core::Timestamp* next) {
+  grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+
+  /* fetch from a thread-local first: this avoids contention on a globally
+     mutable cacheline in the common case */
+  grpc_core::Timestamp min_timer =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          g_last_seen_min_timer);
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != grpc_core::Timestamp::InfFuture()
+          ? absl::OkStatus()
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  grpc_timer_check_result r = RunSomeExpiredTimers(now, next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d; now=%" PRId64, r,
+            now.milliseconds_after_process_epoch());
+  }
+  return r;
+}
+
+}  // namespace
+
+grpc_timer_vtable grpc_timer_wheel_vtable = {
+    TimerInit,     TimerCancel,       TimerCheck,
+    TimerListInit, TimerListShutdown, TimerConsumeKick};
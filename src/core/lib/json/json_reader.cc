@@ -18,6 +18,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
 #include <map>
@@ -44,6 +45,14 @@ namespace grpc_core {
 
 namespace {
 
+constexpr uint64_t kOnes = 0x0101010101010101;
+constexpr uint64_t kHighBits = 0x8080808080808080;
+
+// Whether any of the eight bytes of x is below n, for n <= 128.
+inline uint64_t HasByteBelow(uint64_t x, uint8_t n) {
+  return (x - kOnes * n) & ~x & kHighBits;
+}
+
 class JsonReader {
  public:
   static absl::StatusOr<Json> Parse(absl::string_view input);
@@ -99,6 +108,8 @@ class JsonReader {
 
   Status Run();
   uint32_t ReadChar();
+  void ReadPlainStringRun();
+  void SkipWhitespace();
   bool IsComplete();
 
   size_t CurrentIndex() const { return input_ - original_input_ - 1; }
@@ -227,6 +238,45 @@ uint32_t JsonReader::ReadChar() {
   return r;
 }
 
+// Appends the run of bytes at the front of the input that stand for
+// themselves inside a string, printable ASCII other than '"' and '\\', to
+// string_ in one go: those are most bytes of a typical document, and the
+// state machine would otherwise handle them one at a time.
+void JsonReader::ReadPlainStringRun() {
+  size_t n = 0;
+  // Eight bytes at a time while none of them needs the state machine...
+  while (n + 8 <= remaining_input_) {
+    uint64_t word;
+    memcpy(&word, input_ + n, sizeof(word));
+    if (((word & kHighBits) | HasByteBelow(word, 0x20) |
+         HasByteBelow(word ^ (kOnes * '"'), 1) |
+         HasByteBelow(word ^ (kOnes * '\\'), 1)) != 0) {
+      break;
+    }
+    n += 8;
+  }
+  // ... then one at a time up to the first that does.
+  while (n < remaining_input_) {
+    const uint8_t c = input_[n];
+    if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\') break;
+    ++n;
+  }
+  string_.append(reinterpret_cast<const char*>(input_), n);
+  input_ += n;
+  remaining_input_ -= n;
+}
+
+// Skips the whitespace between tokens, which indented documents have a lot
+// of.
+void JsonReader::SkipWhitespace() {
+  while (remaining_input_ > 0) {
+    const uint8_t c = *input_;
+    if (c != ' ' && c != '\n' && c != '\t' && c != '\r') break;
+    ++input_;
+    --remaining_input_;
+  }
+}
+
 Json* JsonReader::CreateAndLinkValue() {
   Json* value;
   if (stack_.empty()) {
@@ -234,15 +284,19 @@ Json* JsonReader::CreateAndLinkValue() {
   } else {
     Json* parent = stack_.back();
     if (parent->type() == Json::Type::OBJECT) {
-      if (parent->object_value().find(key_) != parent->object_value().end()) {
+      Json::Object* object = parent->mutable_object();
+      auto it = object->lower_bound(key_);
+      if (it != object->end() && it->first == key_) {
         if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
           truncated_errors_ = true;
         } else {
           errors_.push_back(absl::StrFormat(
               "duplicate key \"%s\" at index %" PRIuPTR, key_, CurrentIndex()));
         }
+        value = &it->second;
+      } else {
+        value = &object->emplace_hint(it, std::move(key_), Json())->second;
       }
-      value = &(*parent->mutable_object())[std::move(key_)];
     } else {
       GPR_ASSERT(parent->type() == Json::Type::ARRAY);
       parent->mutable_array()->emplace_back();
@@ -328,6 +382,23 @@ JsonReader::Status JsonReader::Run() {
 
   /* This state-machine is a strict implementation of ECMA-404 */
   while (true) {
+    switch (state_) {
+      case State::GRPC_JSON_STATE_OBJECT_KEY_STRING:
+      case State::GRPC_JSON_STATE_VALUE_STRING:
+        if (utf8_bytes_remaining_ == 0 && unicode_high_surrogate_ == 0) {
+          ReadPlainStringRun();
+        }
+        break;
+      case State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN:
+      case State::GRPC_JSON_STATE_OBJECT_KEY_END:
+      case State::GRPC_JSON_STATE_VALUE_BEGIN:
+      case State::GRPC_JSON_STATE_VALUE_END:
+      case State::GRPC_JSON_STATE_END:
+        SkipWhitespace();
+        break;
+      default:
+        break;
+    }
     c = ReadChar();
     switch (c) {
       /* Let's process the error case first. */
@@ -67,25 +67,20 @@ LoadBalancingPolicy::PickResult LoadBalancingPolicy::QueuePicker::Pick(
   //    the time this function returns, the pick will already have
   //    been processed, and we'll be trying to re-process the same
   //    pick again, leading to a crash.
-  // 2. We are currently running in the data plane mutex, but we
-  //    need to bounce into the control plane work_serializer to call
+  // 2. We are currently running on the data plane, but we need to
+  //    bounce into the control plane work_serializer to call
   //    ExitIdleLocked().
-  if (!exit_idle_called_ && parent_ != nullptr) {
-    exit_idle_called_ = true;
+  if (parent_ != nullptr &&
+      !exit_idle_called_.exchange(true, std::memory_order_relaxed)) {
     auto* parent = parent_->Ref().release();  // ref held by lambda.
-    ExecCtx::Run(DEBUG_LOCATION,
-                 GRPC_CLOSURE_CREATE(
-                     [](void* arg, grpc_error_handle /*error*/) {
-                       auto* parent = static_cast<LoadBalancingPolicy*>(arg);
-                       parent->work_serializer()->Run(
-                           [parent]() {
-                             parent->ExitIdleLocked();
-                             parent->Unref();
-                           },
-                           DEBUG_LOCATION);
-                     },
-                     parent, nullptr),
-                 absl::OkStatus());
+    ExecCtx::RunCallback(DEBUG_LOCATION, [parent]() {
+      parent->work_serializer()->Run(
+          [parent]() {
+            parent->ExitIdleLocked();
+            parent->Unref();
+          },
+          DEBUG_LOCATION);
+    });
   }
   return PickResult::Queue();
 }
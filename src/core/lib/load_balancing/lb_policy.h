@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -252,9 +253,8 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
-  /// client_channel data plane mutex, so they do not have to be
-  /// thread-safe.
+  /// The client channel calls Pick() from many threads at once without
+  /// holding any lock, so pickers must be thread-safe.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
@@ -369,6 +369,10 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
 
   grpc_pollset_set* interested_parties() const { return interested_parties_; }
 
+  std::shared_ptr<WorkSerializer> work_serializer() const {
+    return work_serializer_;
+  }
+
   // Note: This must be invoked while holding the work_serializer.
   void Orphan() override;
 
@@ -386,7 +390,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
 
    private:
     RefCountedPtr<LoadBalancingPolicy> parent_;
-    bool exit_idle_called_ = false;
+    std::atomic<bool> exit_idle_called_{false};
   };
 
   // A picker that returns PickResult::Fail for all picks.
@@ -403,10 +407,6 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   };
 
  protected:
-  std::shared_ptr<WorkSerializer> work_serializer() const {
-    return work_serializer_;
-  }
-
   const ChannelArgs& channel_args() const { return channel_args_; }
 
   // Note: LB policies MUST NOT call any method on the helper from their
@@ -16,6 +16,7 @@
 
 #include "src/core/lib/matchers/matchers.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -150,6 +151,56 @@ std::string StringMatcher::ToString() const {
   }
 }
 
+//
+// StringMatcherSet
+//
+
+StringMatcherSet::StringMatcherSet(
+    const std::vector<const StringMatcher*>& matchers) {
+  auto regex_set =
+      absl::make_unique<RE2::Set>(RE2::DefaultOptions, RE2::ANCHOR_BOTH);
+  for (size_t i = 0; i < matchers.size(); ++i) {
+    const StringMatcher& matcher = *matchers[i];
+    if (matcher.type() == StringMatcher::Type::kSafeRegex &&
+        regex_set->Add(matcher.regex_matcher()->pattern(), nullptr) >= 0) {
+      regex_matchers_.emplace_back(i, matcher);
+    } else {
+      matchers_.emplace_back(i, matcher);
+    }
+  }
+  if (regex_matchers_.empty()) return;
+  if (!regex_set->Compile()) {
+    // Fall back to evaluating each regex on its own.
+    for (auto& p : regex_matchers_) matchers_.push_back(std::move(p));
+    regex_matchers_.clear();
+    return;
+  }
+  regex_set_ = std::move(regex_set);
+}
+
+std::vector<size_t> StringMatcherSet::Match(absl::string_view value) const {
+  std::vector<size_t> result;
+  for (const auto& p : matchers_) {
+    if (p.second.Match(value)) result.push_back(p.first);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> regex_matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(value.data(), value.size()),
+                          &regex_matches, &error_info)) {
+      for (int i : regex_matches) result.push_back(regex_matchers_[i].first);
+    } else if (error_info.kind != RE2::Set::kNoError) {
+      // The DFA ran out of memory, so the set cannot tell us which regexes
+      // match.
+      for (const auto& p : regex_matchers_) {
+        if (p.second.Match(value)) result.push_back(p.first);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 //
 // HeaderMatcher
 //
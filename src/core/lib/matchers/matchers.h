@@ -21,11 +21,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 namespace grpc_core {
 
@@ -76,6 +79,30 @@ class StringMatcher {
   bool case_sensitive_ = true;
 };
 
+// A set of StringMatchers that are all evaluated against the same value,
+// such as the path matchers of a list of routes.  The regex matchers are
+// compiled into a single RE2::Set, so that one pass over the value decides
+// all of them; the other matchers are cheap and are evaluated one by one.
+class StringMatcherSet {
+ public:
+  StringMatcherSet() = default;
+  // Matchers are identified by their index in \a matchers.
+  explicit StringMatcherSet(const std::vector<const StringMatcher*>& matchers);
+
+  // Returns the indexes of the matchers that match \a value, in increasing
+  // order.
+  std::vector<size_t> Match(absl::string_view value) const;
+
+ private:
+  // Matchers not in regex_set_, with their indexes.
+  std::vector<std::pair<size_t, StringMatcher>> matchers_;
+  // The regex matchers, or null if there are none.
+  std::unique_ptr<RE2::Set> regex_set_;
+  // The matchers in regex_set_, in the order they were added, with their
+  // indexes.  Used on their own if the set runs out of memory.
+  std::vector<std::pair<size_t, StringMatcher>> regex_matchers_;
+};
+
 class HeaderMatcher {
  public:
   enum class Type {
@@ -51,37 +51,34 @@ const char* ServerAddressWeightAttribute::kServerAddressWeightAttributeKey =
 // ServerAddress
 //
 
+std::shared_ptr<const ServerAddress::AttributeMap>
+ServerAddress::MakeAttributeMap(
+    std::map<const char*, std::unique_ptr<AttributeInterface>> attributes) {
+  if (attributes.empty()) return nullptr;
+  auto map = std::make_shared<AttributeMap>();
+  for (auto& p : attributes) {
+    map->emplace(p.first, std::move(p.second));
+  }
+  return map;
+}
+
 ServerAddress::ServerAddress(
     const grpc_resolved_address& address, const ChannelArgs& args,
     std::map<const char*, std::unique_ptr<AttributeInterface>> attributes)
-    : address_(address), args_(args), attributes_(std::move(attributes)) {}
+    : address_(address),
+      args_(args),
+      attributes_(MakeAttributeMap(std::move(attributes))) {}
 
 ServerAddress::ServerAddress(
     const void* address, size_t address_len, const ChannelArgs& args,
     std::map<const char*, std::unique_ptr<AttributeInterface>> attributes)
-    : args_(args), attributes_(std::move(attributes)) {
+    : args_(args), attributes_(MakeAttributeMap(std::move(attributes))) {
   memcpy(address_.addr, address, address_len);
   address_.len = static_cast<socklen_t>(address_len);
 }
 
-ServerAddress::ServerAddress(const ServerAddress& other)
-    : address_(other.address_), args_(other.args_) {
-  for (const auto& p : other.attributes_) {
-    attributes_[p.first] = p.second->Copy();
-  }
-}
-ServerAddress& ServerAddress::operator=(const ServerAddress& other) {
-  if (&other == this) {
-    return *this;
-  }
-  address_ = other.address_;
-  args_ = other.args_;
-  attributes_.clear();
-  for (const auto& p : other.attributes_) {
-    attributes_[p.first] = p.second->Copy();
-  }
-  return *this;
-}
+ServerAddress::ServerAddress(const ServerAddress& other) = default;
+ServerAddress& ServerAddress::operator=(const ServerAddress& other) = default;
 
 ServerAddress::ServerAddress(ServerAddress&& other) noexcept
     : address_(other.address_),
@@ -95,35 +92,6 @@ ServerAddress& ServerAddress::operator=(ServerAddress&& other) noexcept {
   return *this;
 }
 
-namespace {
-
-int CompareAttributes(
-    const std::map<const char*,
-                   std::unique_ptr<ServerAddress::AttributeInterface>>&
-        attributes1,
-    const std::map<const char*,
-                   std::unique_ptr<ServerAddress::AttributeInterface>>&
-        attributes2) {
-  auto it2 = attributes2.begin();
-  for (auto it1 = attributes1.begin(); it1 != attributes1.end(); ++it1) {
-    // attributes2 has fewer elements than attributes1
-    if (it2 == attributes2.end()) return -1;
-    // compare keys
-    int retval = strcmp(it1->first, it2->first);
-    if (retval != 0) return retval;
-    // compare values
-    retval = it1->second->Cmp(it2->second.get());
-    if (retval != 0) return retval;
-    ++it2;
-  }
-  // attributes1 has fewer elements than attributes2
-  if (it2 != attributes2.end()) return 1;
-  // equal
-  return 0;
-}
-
-}  // namespace
-
 int ServerAddress::Cmp(const ServerAddress& other) const {
   if (address_.len > other.address_.len) return 1;
   if (address_.len < other.address_.len) return -1;
@@ -131,13 +99,34 @@ int ServerAddress::Cmp(const ServerAddress& other) const {
   if (retval != 0) return retval;
   retval = QsortCompare(args_, other.args_);
   if (retval != 0) return retval;
-  return CompareAttributes(attributes_, other.attributes_);
+  if (attributes_ == other.attributes_) return 0;
+  if (attributes_ == nullptr) return -1;
+  if (other.attributes_ == nullptr) return 1;
+  auto it2 = other.attributes_->begin();
+  for (auto it1 = attributes_->begin(); it1 != attributes_->end(); ++it1) {
+    // other has fewer attributes than this
+    if (it2 == other.attributes_->end()) return -1;
+    // compare keys
+    retval = strcmp(it1->first, it2->first);
+    if (retval != 0) return retval;
+    // compare values, unless shared
+    if (it1->second != it2->second) {
+      retval = it1->second->Cmp(it2->second.get());
+      if (retval != 0) return retval;
+    }
+    ++it2;
+  }
+  // this has fewer attributes than other
+  if (it2 != other.attributes_->end()) return 1;
+  // equal
+  return 0;
 }
 
 const ServerAddress::AttributeInterface* ServerAddress::GetAttribute(
     const char* key) const {
-  auto it = attributes_.find(key);
-  if (it == attributes_.end()) return nullptr;
+  if (attributes_ == nullptr) return nullptr;
+  auto it = attributes_->find(key);
+  if (it == attributes_->end()) return nullptr;
   return it->second.get();
 }
 
@@ -145,11 +134,23 @@ const ServerAddress::AttributeInterface* ServerAddress::GetAttribute(
 // If the new value is null, the attribute is removed.
 ServerAddress ServerAddress::WithAttribute(
     const char* key, std::unique_ptr<AttributeInterface> value) const {
+  return WithSharedAttribute(key, std::move(value));
+}
+
+ServerAddress ServerAddress::WithSharedAttribute(
+    const char* key, std::shared_ptr<const AttributeInterface> value) const {
   ServerAddress address = *this;
+  auto map = std::make_shared<AttributeMap>();
+  if (attributes_ != nullptr) *map = *attributes_;
   if (value == nullptr) {
-    address.attributes_.erase(key);
+    map->erase(key);
+  } else {
+    (*map)[key] = std::move(value);
+  }
+  if (map->empty()) {
+    address.attributes_.reset();
   } else {
-    address.attributes_[key] = std::move(value);
+    address.attributes_ = std::move(map);
   }
   return address;
 }
@@ -162,9 +163,9 @@ std::string ServerAddress::ToString() const {
   if (args_ != ChannelArgs()) {
     parts.emplace_back(absl::StrCat("args=", args_.ToString()));
   }
-  if (!attributes_.empty()) {
+  if (attributes_ != nullptr) {
     std::vector<std::string> attrs;
-    for (const auto& p : attributes_) {
+    for (const auto& p : *attributes_) {
       attrs.emplace_back(absl::StrCat(p.first, "=", p.second->ToString()));
     }
     parts.emplace_back(
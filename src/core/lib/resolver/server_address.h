@@ -44,6 +44,11 @@ namespace grpc_core {
 // A server address is a grpc_resolved_address with an associated set of
 // channel args.  Any args present here will be merged into the channel
 // args when a subchannel is created for this address.
+//
+// The attributes are held in a shared immutable map, so copying an address
+// does not copy them, and an attribute value may be shared by many
+// addresses (see WithSharedAttribute()).  This keeps the address lists of
+// large clusters cheap to copy and to split up in the LB policy hierarchy.
 class ServerAddress {
  public:
   // Base class for resolver-supplied attributes.
@@ -98,15 +103,27 @@ class ServerAddress {
   ServerAddress WithAttribute(const char* key,
                               std::unique_ptr<AttributeInterface> value) const;
 
+  // Like WithAttribute(), but \a value may be shared with other addresses,
+  // so that an attribute common to many addresses is stored only once.
+  ServerAddress WithSharedAttribute(
+      const char* key, std::shared_ptr<const AttributeInterface> value) const;
+
   // TODO(ctiller): Prior to making this a public API we should ensure that the
   // channel args are not part of the generated string, lest we make that debug
   // format load-bearing via Hyrum's law.
   std::string ToString() const;
 
  private:
+  using AttributeMap =
+      std::map<const char*, std::shared_ptr<const AttributeInterface>>;
+
+  static std::shared_ptr<const AttributeMap> MakeAttributeMap(
+      std::map<const char*, std::unique_ptr<AttributeInterface>> attributes);
+
   grpc_resolved_address address_;
   ChannelArgs args_;
-  std::map<const char*, std::unique_ptr<AttributeInterface>> attributes_;
+  // Null if there are no attributes.
+  std::shared_ptr<const AttributeMap> attributes_;
 };
 
 //
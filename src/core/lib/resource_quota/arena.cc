@@ -22,24 +22,126 @@
 
 #include <atomic>
 #include <new>
+#include <utility>
 
 #include <grpc/support/alloc.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/alloc.h"
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
-  static constexpr size_t alignment =
-      (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
-       GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
-          ? GPR_CACHELINE_SIZE
-          : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+constexpr size_t kArenaBaseSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
+constexpr size_t kArenaAlignment =
+    (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
+     GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
+        ? GPR_CACHELINE_SIZE
+        : GPR_MAX_ALIGNMENT;
+
+// Arena blocks are recycled in power of two size classes from
+// kMinCachedBlockSize to kMaxCachedBlockSize; bigger arenas are rare enough
+// that they always go to the allocator.
+constexpr size_t kMinCachedBlockShift = 10;
+constexpr size_t kMaxCachedBlockShift = 16;
+constexpr size_t kNumBlockSizeClasses =
+    kMaxCachedBlockShift - kMinCachedBlockShift + 1;
+// Bounds the memory a single thread can hold on to.
+constexpr size_t kMaxCachedBytesPerThread = 256 * 1024;
+
+size_t BlockSize(size_t size_class) {
+  return size_t{1} << (size_class + kMinCachedBlockShift);
+}
+
+// Returns the size class whose blocks fit alloc_size bytes, or
+// kNumBlockSizeClasses if the size is too big to cache.
+size_t SizeClassFor(size_t alloc_size) {
+  size_t size_class = 0;
+  while (size_class < kNumBlockSizeClasses &&
+         BlockSize(size_class) < alloc_size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+// Per thread free lists of arena blocks. Blocks freed on one thread may be
+// reused by an arena created on the same thread only, so no synchronization
+// is needed.
+class ArenaBlockCache {
+ public:
+  ArenaBlockCache() = default;
+  ArenaBlockCache(const ArenaBlockCache&) = delete;
+  ArenaBlockCache& operator=(const ArenaBlockCache&) = delete;
+
+  ~ArenaBlockCache() {
+    shutdown_ = true;
+    for (FreeBlock*& head : free_blocks_) {
+      while (head != nullptr) gpr_free_aligned(std::exchange(head, head->next));
+    }
+  }
+
+  void* Pop(size_t size_class) {
+    FreeBlock* block = free_blocks_[size_class];
+    if (block == nullptr) return nullptr;
+    free_blocks_[size_class] = block->next;
+    cached_bytes_ -= BlockSize(size_class);
+    return block;
+  }
+
+  // Returns false (and leaves block untouched) if the cache is full.
+  bool Push(size_t size_class, void* block) {
+    const size_t block_size = BlockSize(size_class);
+    if (shutdown_ || cached_bytes_ + block_size > kMaxCachedBytesPerThread) {
+      return false;
+    }
+    free_blocks_[size_class] = new (block) FreeBlock{free_blocks_[size_class]};
+    cached_bytes_ += block_size;
+    return true;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* free_blocks_[kNumBlockSizeClasses] = {};
+  size_t cached_bytes_ = 0;
+  // Set once the thread is exiting: arenas destroyed by later thread_local
+  // destructors free their blocks directly.
+  bool shutdown_ = false;
+};
+
+thread_local ArenaBlockCache g_arena_block_cache;
+
+// Allocates the block holding an arena and its initial zone. With the block
+// cache enabled, the block is rounded up to its size class and the extra
+// space is handed to the initial zone, so *initial_size may grow.
+void* ArenaStorage(size_t* initial_size) {
+  *initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  size_t alloc_size = kArenaBaseSize + *initial_size;
+  if (grpc_core::IsArenaBlockCacheEnabled()) {
+    const size_t size_class = SizeClassFor(alloc_size);
+    if (size_class < kNumBlockSizeClasses) {
+      alloc_size = BlockSize(size_class);
+      *initial_size = alloc_size - kArenaBaseSize;
+      void* block = g_arena_block_cache.Pop(size_class);
+      if (block != nullptr) return block;
+    }
+  }
+  return gpr_malloc_aligned(alloc_size, kArenaAlignment);
+}
+
+// Frees a block returned by ArenaStorage.
+void FreeArenaStorage(void* block, size_t initial_zone_size) {
+  const size_t alloc_size = kArenaBaseSize + initial_zone_size;
+  const size_t size_class = SizeClassFor(alloc_size);
+  if (grpc_core::IsArenaBlockCacheEnabled() &&
+      size_class < kNumBlockSizeClasses &&
+      BlockSize(size_class) == alloc_size &&
+      g_arena_block_cache.Push(size_class, block)) {
+    return;
+  }
+  gpr_free_aligned(block);
 }
 
 }  // namespace
@@ -57,17 +159,16 @@ Arena::~Arena() {
 }
 
 Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
-  return new (ArenaStorage(initial_size))
-      Arena(initial_size, 0, memory_allocator);
+  void* storage = ArenaStorage(&initial_size);
+  return new (storage) Arena(initial_size, 0, memory_allocator);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena = new (ArenaStorage(initial_size))
-      Arena(initial_size, alloc_size, memory_allocator);
-  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  void* storage = ArenaStorage(&initial_size);
+  auto* new_arena =
+      new (storage) Arena(initial_size, alloc_size, memory_allocator);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kArenaBaseSize;
   return std::make_pair(new_arena, first_alloc);
 }
 
@@ -84,8 +185,9 @@ size_t Arena::Destroy() {
   }
   size_t size = total_used_.load(std::memory_order_relaxed);
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
+  const size_t initial_zone_size = initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(this);
+  FreeArenaStorage(this, initial_zone_size);
   return size;
 }
 
@@ -44,12 +44,13 @@ namespace grpc_core {
 
 class Arena {
  public:
-  // Create an arena, with \a initial_size bytes in the first allocated buffer.
+  // Create an arena, with at least \a initial_size bytes in the first allocated
+  // buffer.
   static Arena* Create(size_t initial_size, MemoryAllocator* memory_allocator);
 
-  // Create an arena, with \a initial_size bytes in the first allocated buffer,
-  // and return both a void pointer to the returned arena and a void* with the
-  // first allocation.
+  // Create an arena, with at least \a initial_size bytes in the first allocated
+  // buffer, and return both a void pointer to the returned arena and a void*
+  // with the first allocation.
   static std::pair<Arena*, void*> CreateWithAlloc(
       size_t initial_size, size_t alloc_size,
       MemoryAllocator* memory_allocator);
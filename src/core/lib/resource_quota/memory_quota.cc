@@ -44,6 +44,9 @@ static constexpr size_t kMaxReplenishBytes = 1024 * 1024;
 // Minimum number of bytes an allocator will request from a quota in one step.
 static constexpr size_t kMinReplenishBytes = 4096;
 
+// Maximum number of free bytes a memory quota caches for each CPU.
+static constexpr size_t kMaxCpuCacheBytes = 256 * 1024;
+
 //
 // Reclaimer
 //
@@ -350,6 +353,11 @@ void BasicMemoryQuota::Start() {
         if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
           return Pending{};
         }
+        // Bytes parked in the CPU caches may be enough to leave overcommit.
+        self->DrainCpuCaches();
+        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
+          return Pending{};
+        }
         return 0;
       },
       [self]() {
@@ -406,6 +414,8 @@ void BasicMemoryQuota::Stop() { reclaimer_activity_.reset(); }
 
 void BasicMemoryQuota::SetSize(size_t new_size) {
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
+  // Caches may have been sized for the old quota.
+  DrainCpuCaches();
   if (old_size < new_size) {
     // We're growing the quota.
     Return(new_size - old_size);
@@ -419,6 +429,7 @@ void BasicMemoryQuota::Take(size_t amount) {
   // If there's a request for nothing, then do nothing!
   if (amount == 0) return;
   GPR_DEBUG_ASSERT(amount <= std::numeric_limits<intptr_t>::max());
+  if (TakeFromCpuCache(amount)) return;
   // Grab memory from the quota.
   auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
   // If we push into overcommit, awake the reclaimer.
@@ -427,6 +438,70 @@ void BasicMemoryQuota::Take(size_t amount) {
   }
 }
 
+size_t BasicMemoryQuota::CpuCacheCapacity() const {
+  if (!IsPerCpuMemoryQuotaEnabled()) return 0;
+  // free_bytes_ excludes cached bytes, so together the caches may overstate
+  // pressure by at most 1/64th of the quota.
+  const size_t num_cpus = cpu_caches_.end() - cpu_caches_.begin();
+  const size_t capacity =
+      std::min(kMaxCpuCacheBytes,
+               quota_size_.load(std::memory_order_relaxed) / (64 * num_cpus));
+  return capacity < kMinReplenishBytes ? 0 : capacity;
+}
+
+bool BasicMemoryQuota::TakeFromCpuCache(size_t amount) {
+  // this_cpu() is keyed off the ExecCtx.
+  if (ExecCtx::Get() == nullptr) return false;
+  const size_t capacity = CpuCacheCapacity();
+  if (amount > capacity) return false;
+  auto& cache = cpu_caches_.this_cpu().free_bytes;
+  size_t cached = cache.load(std::memory_order_relaxed);
+  while (cached >= amount) {
+    if (cache.compare_exchange_weak(cached, cached - amount,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  // Refill the cache along with this request, unless the quota can't spare
+  // it: near the limit every Take() must be seen by free_bytes_.
+  const intptr_t total = amount + capacity;
+  auto prior = free_bytes_.fetch_sub(total, std::memory_order_acq_rel);
+  if (prior < total) {
+    free_bytes_.fetch_add(total, std::memory_order_relaxed);
+    return false;
+  }
+  cache.fetch_add(capacity, std::memory_order_relaxed);
+  return true;
+}
+
+bool BasicMemoryQuota::ReturnToCpuCache(size_t amount) {
+  if (ExecCtx::Get() == nullptr) return false;
+  const size_t capacity = CpuCacheCapacity();
+  if (amount > capacity) return false;
+  auto& cache = cpu_caches_.this_cpu().free_bytes;
+  size_t cached = cache.fetch_add(amount, std::memory_order_relaxed) + amount;
+  // On overflow keep half the capacity, so that alternating takes and returns
+  // don't bounce between the cache and free_bytes_.
+  while (cached > capacity) {
+    if (cache.compare_exchange_weak(cached, capacity / 2,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_relaxed)) {
+      free_bytes_.fetch_add(cached - capacity / 2, std::memory_order_relaxed);
+      break;
+    }
+  }
+  return true;
+}
+
+void BasicMemoryQuota::DrainCpuCaches() {
+  for (auto& cache : cpu_caches_) {
+    const size_t cached =
+        cache.free_bytes.exchange(0, std::memory_order_acq_rel);
+    if (cached != 0) free_bytes_.fetch_add(cached, std::memory_order_relaxed);
+  }
+}
+
 void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
   uint64_t current = reclamation_counter_.load(std::memory_order_relaxed);
   if (current != token) return;
@@ -446,10 +521,14 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
+  if (ReturnToCpuCache(amount)) return;
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
 }
 
 BasicMemoryQuota::PressureInfo BasicMemoryQuota::GetPressureInfo() {
+  if (IsPerCpuMemoryQuotaEnabled()) {
+    reconcile_cpu_caches_.Tick([this](Duration) { DrainCpuCaches(); });
+  }
   double free = free_bytes_.load();
   if (free < 0) free = 0;
   size_t quota_size = quota_size_.load();
@@ -36,6 +36,7 @@
 
 #include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
@@ -321,12 +322,32 @@ class BasicMemoryQuota final
 
   static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
 
+  // Free bytes set aside for the allocators running on one CPU (see
+  // per_cpu_memory_quota), padded to avoid false sharing between CPUs.
+  struct CpuCache {
+    std::atomic<size_t> free_bytes{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<size_t>)];
+  };
+
+  // The most each CPU cache may hold: small enough that bytes parked in the
+  // caches cannot noticeably skew GetPressureInfo(). Zero disables caching.
+  size_t CpuCacheCapacity() const;
+  // Try to satisfy Take() or Return() from this CPU's cache.
+  bool TakeFromCpuCache(size_t amount);
+  bool ReturnToCpuCache(size_t amount);
+  // Move every cached byte back to free_bytes_.
+  void DrainCpuCaches();
+
   // The amount of memory that's free in this quota.
   // We use intptr_t as a reasonable proxy for ssize_t that's portable.
   // We allow arbitrary overcommit and so this must allow negative values.
+  // Bytes held in cpu_caches_ are not counted here.
   std::atomic<intptr_t> free_bytes_{kInitialSize};
   // The total number of bytes in this quota.
   std::atomic<size_t> quota_size_{kInitialSize};
+  PerCpu<CpuCache> cpu_caches_;
+  // Periodically return cached bytes so that idle CPUs don't sit on them.
+  PeriodicUpdate reconcile_cpu_caches_{Duration::Seconds(1)};
 
   // Reclaimer queues.
   ReclaimerQueue reclaimers_[kNumReclamationPasses];
@@ -37,6 +37,11 @@ class AuthorizationEngine : public RefCounted<AuthorizationEngine> {
   };
 
   virtual Decision Evaluate(const EvaluateArgs& args) const = 0;
+
+  // Returns true if the decisions of this engine only depend on the request
+  // path and on the connection, so that they may be cached per connection
+  // and path.
+  virtual bool DecisionsDependOnlyOnPath() const { return false; }
 };
 
 }  // namespace grpc_core
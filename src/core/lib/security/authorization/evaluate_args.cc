@@ -89,6 +89,19 @@ EvaluateArgs::PerChannelArgs::PerChannelArgs(grpc_auth_context* auth_context,
   }
 }
 
+std::shared_ptr<const EvaluateArgs::PerChannelArgs::EngineCache::Results>
+EvaluateArgs::PerChannelArgs::EngineCache::GetOrCompute(
+    uint64_t engine_id, absl::FunctionRef<Results()> compute) {
+  MutexLock lock(&mu_);
+  for (const auto& entry : entries_) {
+    if (entry.first == engine_id) return entry.second;
+  }
+  if (entries_.size() == kMaxEntries) entries_.erase(entries_.begin());
+  entries_.emplace_back(engine_id,
+                        std::make_shared<const Results>(compute()));
+  return entries_.back().second;
+}
+
 absl::string_view EvaluateArgs::GetPath() const {
   if (metadata_ != nullptr) {
     const auto* path = metadata_->get_pointer(HttpPathMetadata());
@@ -190,16 +203,18 @@ absl::string_view EvaluateArgs::GetSpiffeId() const {
   return channel_args_->spiffe_id;
 }
 
-std::vector<absl::string_view> EvaluateArgs::GetUriSans() const {
+const std::vector<absl::string_view>& EvaluateArgs::GetUriSans() const {
   if (channel_args_ == nullptr) {
-    return {};
+    static const auto* kEmpty = new std::vector<absl::string_view>();
+    return *kEmpty;
   }
   return channel_args_->uri_sans;
 }
 
-std::vector<absl::string_view> EvaluateArgs::GetDnsSans() const {
+const std::vector<absl::string_view>& EvaluateArgs::GetDnsSans() const {
   if (channel_args_ == nullptr) {
-    return {};
+    static const auto* kEmpty = new std::vector<absl::string_view>();
+    return *kEmpty;
   }
   return channel_args_->dns_sans;
 }
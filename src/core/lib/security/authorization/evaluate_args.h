@@ -17,14 +17,22 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -44,6 +52,30 @@ class EvaluateArgs {
       int port = 0;
     };
 
+    // Memoizes results that an authorization engine computes only from the
+    // fields of PerChannelArgs, for the lifetime of the connection.  Entries
+    // are keyed by the engine's unique id, so that the engine of a reloaded
+    // policy never sees the results of the engine it replaced.
+    class EngineCache {
+     public:
+      using Results = std::vector<bool>;
+
+      // Returns the results of the engine \a engine_id, calling \a compute
+      // to compute them on the first call for that engine.
+      std::shared_ptr<const Results> GetOrCompute(
+          uint64_t engine_id, absl::FunctionRef<Results()> compute);
+
+     private:
+      // Each channel usually sees only its deny and allow engines, plus
+      // their replacements while a policy is being reloaded.
+      static constexpr size_t kMaxEntries = 4;
+
+      Mutex mu_;
+      // Most recently added last.
+      std::vector<std::pair<uint64_t, std::shared_ptr<const Results>>>
+          entries_ ABSL_GUARDED_BY(mu_);
+    };
+
     PerChannelArgs(grpc_auth_context* auth_context, grpc_endpoint* endpoint);
 
     absl::string_view transport_security_type;
@@ -54,6 +86,9 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    // Held by pointer so that PerChannelArgs stays movable.
+    std::unique_ptr<EngineCache> engine_cache =
+        absl::make_unique<EngineCache>();
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -80,11 +115,18 @@ class EvaluateArgs {
   int GetPeerPort() const;
   absl::string_view GetTransportSecurityType() const;
   absl::string_view GetSpiffeId() const;
-  std::vector<absl::string_view> GetUriSans() const;
-  std::vector<absl::string_view> GetDnsSans() const;
+  const std::vector<absl::string_view>& GetUriSans() const;
+  const std::vector<absl::string_view>& GetDnsSans() const;
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
 
+  // Returns the per-connection cache for authorization engines, or null if
+  // there are no per-channel args.
+  PerChannelArgs::EngineCache* GetEngineCache() const {
+    return channel_args_ == nullptr ? nullptr
+                                    : channel_args_->engine_cache.get();
+  }
+
  private:
   grpc_metadata_batch* metadata_;
   PerChannelArgs* channel_args_;
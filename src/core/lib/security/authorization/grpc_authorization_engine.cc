@@ -17,43 +17,219 @@
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/matchers/matchers.h"
 
 namespace grpc_core {
 
+namespace {
+
+std::atomic<uint64_t> g_next_engine_id{1};
+
+// Returns the exact paths that a request must have for \a permission to
+// match, or nullopt if it can also match other paths.
+absl::optional<std::vector<std::string>> RequiredPaths(
+    const Rbac::Permission& permission) {
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kPath:
+      if (permission.string_matcher.type() == StringMatcher::Type::kExact &&
+          permission.string_matcher.case_sensitive()) {
+        return std::vector<std::string>{
+            permission.string_matcher.string_matcher()};
+      }
+      return absl::nullopt;
+    case Rbac::Permission::RuleType::kOr: {
+      // All of the alternatives must be limited.
+      std::vector<std::string> paths;
+      for (const auto& rule : permission.permissions) {
+        auto rule_paths = RequiredPaths(*rule);
+        if (!rule_paths.has_value()) return absl::nullopt;
+        paths.insert(paths.end(), rule_paths->begin(), rule_paths->end());
+      }
+      return paths;
+    }
+    case Rbac::Permission::RuleType::kAnd: {
+      // Any limited rule limits the conjunction; use the tightest.
+      absl::optional<std::vector<std::string>> paths;
+      for (const auto& rule : permission.permissions) {
+        auto rule_paths = RequiredPaths(*rule);
+        if (rule_paths.has_value() &&
+            (!paths.has_value() || rule_paths->size() < paths->size())) {
+          paths = std::move(rule_paths);
+        }
+      }
+      return paths;
+    }
+    default:
+      return absl::nullopt;
+  }
+}
+
+// Returns true if \a principal only depends on the connection, not on the
+// call.
+bool IsPerChannel(const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kHeader:
+    case Rbac::Principal::RuleType::kPath:
+      return false;
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+    case Rbac::Principal::RuleType::kNot:
+      for (const auto& id : principal.principals) {
+        if (!IsPerChannel(*id)) return false;
+      }
+      return true;
+    default:
+      return true;
+  }
+}
+
+// Returns true if \a permission looks at request headers other than the
+// path.
+bool HasHeaderRules(const Rbac::Permission& permission) {
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kHeader:
+      return true;
+    case Rbac::Permission::RuleType::kAnd:
+    case Rbac::Permission::RuleType::kOr:
+    case Rbac::Permission::RuleType::kNot:
+      for (const auto& rule : permission.permissions) {
+        if (HasHeaderRules(*rule)) return true;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+bool HasHeaderRules(const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kHeader:
+      return true;
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+    case Rbac::Principal::RuleType::kNot:
+      for (const auto& id : principal.principals) {
+        if (HasHeaderRules(*id)) return true;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
+    : action_(policy.action), id_(g_next_engine_id.fetch_add(1)) {
   for (auto& sub_policy : policy.policies) {
+    const size_t index = policies_.size();
+    auto paths = RequiredPaths(sub_policy.second.permissions);
+    if (paths.has_value()) {
+      std::sort(paths->begin(), paths->end());
+      paths->erase(std::unique(paths->begin(), paths->end()), paths->end());
+      for (std::string& path : *paths) {
+        policies_by_path_[std::move(path)].push_back(index);
+      }
+    } else {
+      unindexed_policies_.push_back(index);
+    }
     Policy policy;
     policy.name = sub_policy.first;
-    policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
+    policy.per_channel_principals = IsPerChannel(sub_policy.second.principals);
+    has_per_channel_principals_ |= policy.per_channel_principals;
+    if (HasHeaderRules(sub_policy.second.permissions) ||
+        HasHeaderRules(sub_policy.second.principals)) {
+      decisions_depend_only_on_path_ = false;
+    }
+    policy.permissions =
+        AuthorizationMatcher::Create(std::move(sub_policy.second.permissions));
+    policy.principals =
+        AuthorizationMatcher::Create(std::move(sub_policy.second.principals));
     policies_.push_back(std::move(policy));
   }
 }
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : action_(other.action_),
+      policies_(std::move(other.policies_)),
+      id_(other.id_),
+      has_per_channel_principals_(other.has_per_channel_principals_),
+      decisions_depend_only_on_path_(other.decisions_depend_only_on_path_),
+      policies_by_path_(std::move(other.policies_by_path_)),
+      unindexed_policies_(std::move(other.unindexed_policies_)) {}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
   action_ = other.action_;
   policies_ = std::move(other.policies_);
+  id_ = other.id_;
+  has_per_channel_principals_ = other.has_per_channel_principals_;
+  decisions_depend_only_on_path_ = other.decisions_depend_only_on_path_;
+  policies_by_path_ = std::move(other.policies_by_path_);
+  unindexed_policies_ = std::move(other.unindexed_policies_);
   return *this;
 }
 
+std::vector<bool> GrpcAuthorizationEngine::EvaluatePerChannelPrincipals(
+    const EvaluateArgs& args) const {
+  std::vector<bool> results(policies_.size());
+  for (size_t i = 0; i < policies_.size(); ++i) {
+    if (policies_[i].per_channel_principals) {
+      results[i] = policies_[i].principals->Matches(args);
+    }
+  }
+  return results;
+}
+
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
+  std::shared_ptr<const std::vector<bool>> per_channel_results;
+  EvaluateArgs::PerChannelArgs::EngineCache* engine_cache =
+      args.GetEngineCache();
+  if (has_per_channel_principals_ && engine_cache != nullptr) {
+    per_channel_results = engine_cache->GetOrCompute(
+        id_, [&]() { return EvaluatePerChannelPrincipals(args); });
+  }
+  auto policy_matches = [&](size_t index) {
+    const Policy& policy = policies_[index];
+    const bool principals_match =
+        policy.per_channel_principals && per_channel_results != nullptr
+            ? (*per_channel_results)[index]
+            : policy.principals->Matches(args);
+    return principals_match && policy.permissions->Matches(args);
+  };
+  // Walk the policies that can match the path and the unindexed ones
+  // together in policy order, so that the first matching policy wins.
+  static const auto* kNoPolicies = new std::vector<size_t>();
+  const std::vector<size_t>* path_policies = kNoPolicies;
+  auto it = policies_by_path_.find(args.GetPath());
+  if (it != policies_by_path_.end()) path_policies = &it->second;
+  size_t next_path_policy = 0;
+  size_t next_unindexed_policy = 0;
   Decision decision;
   bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
+  while (next_path_policy < path_policies->size() ||
+         next_unindexed_policy < unindexed_policies_.size()) {
+    size_t index;
+    if (next_unindexed_policy == unindexed_policies_.size() ||
+        (next_path_policy < path_policies->size() &&
+         (*path_policies)[next_path_policy] <
+             unindexed_policies_[next_unindexed_policy])) {
+      index = (*path_policies)[next_path_policy++];
+    } else {
+      index = unindexed_policies_[next_unindexed_policy++];
+    }
+    if (policy_matches(index)) {
       matches = true;
-      decision.matching_policy_name = policy.name;
+      decision.matching_policy_name = policies_[index].name;
       break;
     }
   }
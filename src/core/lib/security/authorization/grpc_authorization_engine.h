@@ -18,11 +18,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/evaluate_args.h"
 #include "src/core/lib/security/authorization/matchers.h"
@@ -36,6 +39,11 @@ namespace grpc_core {
 // engine type. This engine ignores condition field in RBAC config. It is the
 // caller's responsibility to provide RBAC policies that are compatible with
 // this engine.
+//
+// To keep per-call evaluation cheap with large policies, policies whose
+// permissions only match a known set of exact paths are indexed by path, and
+// the results of principals that only depend on the connection are computed
+// once per connection and cached in EvaluateArgs::PerChannelArgs.
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
@@ -55,13 +63,36 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   // whether allow/deny this request.
   Decision Evaluate(const EvaluateArgs& args) const override;
 
+  // Returns false if any policy has header rules.
+  bool DecisionsDependOnlyOnPath() const override {
+    return decisions_depend_only_on_path_;
+  }
+
  private:
   struct Policy {
     std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
+    std::unique_ptr<AuthorizationMatcher> permissions;
+    std::unique_ptr<AuthorizationMatcher> principals;
+    // True if the principals only depend on the connection, so that their
+    // result can be cached per connection.
+    bool per_channel_principals = false;
   };
+
+  // Evaluates the per-channel principals of every policy.
+  std::vector<bool> EvaluatePerChannelPrincipals(
+      const EvaluateArgs& args) const;
+
   Rbac::Action action_;
   std::vector<Policy> policies_;
+  // Unique among all engines; identifies this engine's entries in the
+  // per-connection caches.
+  uint64_t id_ = 0;
+  bool has_per_channel_principals_ = false;
+  bool decisions_depend_only_on_path_ = true;
+  // Exact path to the indexes of the policies that can match it.
+  absl::flat_hash_map<std::string, std::vector<size_t>> policies_by_path_;
+  // Indexes of the policies that are not in policies_by_path_.
+  std::vector<size_t> unindexed_policies_;
 };
 
 }  // namespace grpc_core
@@ -20,6 +20,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
@@ -43,7 +44,8 @@ GrpcServerAuthzFilter::GrpcServerAuthzFilter(
     RefCountedPtr<grpc_authorization_policy_provider> provider)
     : auth_context_(std::move(auth_context)),
       per_channel_evaluate_args_(auth_context_.get(), endpoint),
-      provider_(std::move(provider)) {}
+      provider_(std::move(provider)),
+      decision_cache_(absl::make_unique<DecisionCache>()) {}
 
 absl::StatusOr<GrpcServerAuthzFilter> GrpcServerAuthzFilter::Create(
     const ChannelArgs& args, ChannelFilter::Args) {
@@ -60,6 +62,35 @@ absl::StatusOr<GrpcServerAuthzFilter> GrpcServerAuthzFilter::Create(
       /*endpoint=*/nullptr, provider->Ref());
 }
 
+constexpr size_t GrpcServerAuthzFilter::DecisionCache::kMaxEntries;
+
+void GrpcServerAuthzFilter::DecisionCache::MaybeResetLocked(
+    const AuthorizationEngines& engines) {
+  if (engines.allow_engine != engines_.allow_engine ||
+      engines.deny_engine != engines_.deny_engine) {
+    engines_ = engines;
+    decisions_.clear();
+  }
+}
+
+absl::optional<bool> GrpcServerAuthzFilter::DecisionCache::Get(
+    const AuthorizationEngines& engines, absl::string_view path) {
+  MutexLock lock(&mu_);
+  MaybeResetLocked(engines);
+  auto it = decisions_.find(path);
+  if (it == decisions_.end()) return absl::nullopt;
+  return it->second;
+}
+
+void GrpcServerAuthzFilter::DecisionCache::Set(
+    const AuthorizationEngines& engines, absl::string_view path,
+    bool authorized) {
+  MutexLock lock(&mu_);
+  MaybeResetLocked(engines);
+  if (decisions_.size() >= kMaxEntries) decisions_.clear();
+  decisions_.emplace(path, authorized);
+}
+
 bool GrpcServerAuthzFilter::IsAuthorized(
     const ClientMetadataHandle& initial_metadata) {
   EvaluateArgs args(initial_metadata.get(), &per_channel_evaluate_args_);
@@ -73,8 +104,28 @@ bool GrpcServerAuthzFilter::IsAuthorized(
             absl::StrJoin(args.GetDnsSans(), ",").c_str(),
             std::string(args.GetSubject()).c_str());
   }
-  grpc_authorization_policy_provider::AuthorizationEngines engines =
-      provider_->engines();
+  AuthorizationEngines engines = provider_->engines();
+  const bool cacheable = (engines.deny_engine == nullptr ||
+                          engines.deny_engine->DecisionsDependOnlyOnPath()) &&
+                         (engines.allow_engine == nullptr ||
+                          engines.allow_engine->DecisionsDependOnlyOnPath());
+  if (!cacheable) return EvaluateEngines(engines, args);
+  absl::string_view path = args.GetPath();
+  absl::optional<bool> authorized = decision_cache_->Get(engines, path);
+  if (authorized.has_value()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_authz_trace)) {
+      gpr_log(GPR_DEBUG, "chand=%p: request %s by cached decision.", this,
+              *authorized ? "allowed" : "denied");
+    }
+    return *authorized;
+  }
+  authorized = EvaluateEngines(engines, args);
+  decision_cache_->Set(engines, path, *authorized);
+  return *authorized;
+}
+
+bool GrpcServerAuthzFilter::EvaluateEngines(
+    const AuthorizationEngines& engines, const EvaluateArgs& args) {
   if (engines.deny_engine != nullptr) {
     AuthorizationEngine::Decision decision =
         engines.deny_engine->Evaluate(args);
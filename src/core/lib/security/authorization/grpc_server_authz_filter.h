@@ -17,7 +17,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc_security.h>
 
@@ -25,6 +32,7 @@
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/security/authorization/authorization_policy_provider.h"
@@ -45,15 +53,46 @@ class GrpcServerAuthzFilter final : public ChannelFilter {
       CallArgs call_args, NextPromiseFactory next_promise_factory) override;
 
  private:
+  using AuthorizationEngines =
+      grpc_authorization_policy_provider::AuthorizationEngines;
+
+  // The decisions made on this connection by the current engines, by path,
+  // when the engines only look at the path and the connection.  Cleared
+  // when the provider publishes new engines.
+  class DecisionCache {
+   public:
+    // Bounds the memory used by connections calling many distinct paths.
+    static constexpr size_t kMaxEntries = 1000;
+
+    absl::optional<bool> Get(const AuthorizationEngines& engines,
+                             absl::string_view path);
+    void Set(const AuthorizationEngines& engines, absl::string_view path,
+             bool authorized);
+
+   private:
+    // Drops the decisions unless they were made by engines.
+    void MaybeResetLocked(const AuthorizationEngines& engines)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+    Mutex mu_;
+    // Held so that the pointers cannot be reused by newer engines.
+    AuthorizationEngines engines_ ABSL_GUARDED_BY(mu_);
+    absl::flat_hash_map<std::string, bool> decisions_ ABSL_GUARDED_BY(mu_);
+  };
+
   GrpcServerAuthzFilter(
       RefCountedPtr<grpc_auth_context> auth_context, grpc_endpoint* endpoint,
       RefCountedPtr<grpc_authorization_policy_provider> provider);
 
   bool IsAuthorized(const ClientMetadataHandle& initial_metadata);
+  bool EvaluateEngines(const AuthorizationEngines& engines,
+                       const EvaluateArgs& args);
 
   RefCountedPtr<grpc_auth_context> auth_context_;
   EvaluateArgs::PerChannelArgs per_channel_evaluate_args_;
   RefCountedPtr<grpc_authorization_policy_provider> provider_;
+  // Held by pointer to keep the filter movable.
+  std::unique_ptr<DecisionCache> decision_cache_;
 };
 
 }  // namespace grpc_core
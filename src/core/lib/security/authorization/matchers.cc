@@ -199,7 +199,7 @@ bool AuthenticatedAuthorizationMatcher::Matches(
     // Allows any authenticated user.
     return true;
   }
-  std::vector<absl::string_view> uri_sans = args.GetUriSans();
+  const std::vector<absl::string_view>& uri_sans = args.GetUriSans();
   if (!uri_sans.empty()) {
     for (const auto& uri : uri_sans) {
       if (matcher_->Match(uri)) {
@@ -207,7 +207,7 @@ bool AuthenticatedAuthorizationMatcher::Matches(
       }
     }
   }
-  std::vector<absl::string_view> dns_sans = args.GetDnsSans();
+  const std::vector<absl::string_view>& dns_sans = args.GetDnsSans();
   if (!dns_sans.empty()) {
     for (const auto& dns : dns_sans) {
       if (matcher_->Match(dns)) {
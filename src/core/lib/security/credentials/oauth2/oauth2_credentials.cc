@@ -45,8 +45,10 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/httpcli_ssl_credentials.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/load_file.h"
@@ -144,6 +146,69 @@ void grpc_auth_refresh_token_destruct(grpc_auth_refresh_token* refresh_token) {
 // Oauth2 Token Fetcher credentials.
 //
 
+namespace {
+
+// A token is refreshed in the background this long before calls have to wait
+// for a new one (GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS before it expires),
+// or a quarter of its lifetime before for short-lived tokens.
+constexpr int kTokenRefreshAheadSecs = 300;
+// How long to keep using a token after its background refresh failed, before
+// trying again.
+constexpr int kTokenRefreshRetrySecs = 10;
+
+// The tokens of the credentials that share them, by token cache key.
+class SharedTokenCache {
+ public:
+  struct Token {
+    grpc_core::Slice value;
+    gpr_timespec expiration;
+    gpr_timespec refresh_time;
+  };
+
+  static SharedTokenCache* Get() {
+    static SharedTokenCache* cache = new SharedTokenCache();
+    return cache;
+  }
+
+  absl::optional<Token> Lookup(const std::string& key) {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = tokens_.find(key);
+    if (it == tokens_.end()) return absl::nullopt;
+    return Token{it->second.value.Ref(), it->second.expiration,
+                 it->second.refresh_time};
+  }
+
+  void Store(const std::string& key, Token token) {
+    grpc_core::MutexLock lock(&mu_);
+    // Drops the expired tokens, so that the tokens of the credentials that
+    // are gone do not accumulate.
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    for (auto it = tokens_.begin(); it != tokens_.end();) {
+      if (gpr_time_cmp(it->second.expiration, now) <= 0) {
+        tokens_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+    tokens_[key] = std::move(token);
+  }
+
+  void Reset() {
+    grpc_core::MutexLock lock(&mu_);
+    tokens_.clear();
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  std::map<std::string, Token> tokens_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace
+
+void grpc_oauth2_token_fetcher_credentials_reset_shared_cache_for_testing() {
+  SharedTokenCache::Get()->Reset();
+}
+
 grpc_oauth2_token_fetcher_credentials::
     ~grpc_oauth2_token_fetcher_credentials() {
   gpr_mu_destroy(&mu_);
@@ -253,15 +318,33 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
   token_fetch_pending_ = false;
-  if (access_token_value.has_value()) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  if (status == GRPC_CREDENTIALS_OK) {
     access_token_value_ = access_token_value->Ref();
+    token_expiration_ = gpr_time_add(now, token_lifetime.as_timespec());
+    grpc_core::Duration refresh_ahead =
+        grpc_core::Duration::Seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS) +
+        std::min(grpc_core::Duration::Seconds(kTokenRefreshAheadSecs),
+                 token_lifetime / 4);
+    token_refresh_time_ =
+        gpr_time_sub(token_expiration_, refresh_ahead.as_timespec());
+    if (grpc_core::IsSharedOauth2TokenCacheEnabled()) {
+      std::string key = token_cache_key();
+      if (!key.empty()) {
+        SharedTokenCache::Get()->Store(
+            key, {access_token_value_->Ref(), token_expiration_,
+                  token_refresh_time_});
+      }
+    }
+  } else if (access_token_value_.has_value() &&
+             gpr_time_cmp(token_expiration_, now) > 0) {
+    // A background refresh failed: keep using the token while it is valid.
+    token_refresh_time_ = gpr_time_add(
+        now, gpr_time_from_seconds(kTokenRefreshRetrySecs, GPR_TIMESPAN));
   } else {
     access_token_value_ = absl::nullopt;
+    token_expiration_ = gpr_inf_past(GPR_CLOCK_MONOTONIC);
   }
-  token_expiration_ = status == GRPC_CREDENTIALS_OK
-                          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                                         token_lifetime.as_timespec())
-                          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
@@ -294,16 +377,30 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
     const grpc_call_credentials::GetRequestMetadataArgs*) {
   // Check if we can use the cached token.
   absl::optional<grpc_core::Slice> cached_access_token_value;
+  bool start_refresh = false;
   gpr_mu_lock(&mu_);
-  if (access_token_value_.has_value() &&
-      gpr_time_cmp(
-          gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
-          gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
-                                GPR_TIMESPAN)) > 0) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  auto token_is_usable = [this, now]() {
+    return access_token_value_.has_value() &&
+           gpr_time_cmp(gpr_time_sub(token_expiration_, now),
+                        gpr_time_from_seconds(
+                            GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
+                            GPR_TIMESPAN)) > 0;
+  };
+  if (!token_is_usable()) use_shared_token_locked(now);
+  if (token_is_usable()) {
     cached_access_token_value = access_token_value_->Ref();
+    // Refresh the token in the background once it is due, unless other
+    // credentials already did.
+    if (!token_fetch_pending_ && gpr_time_cmp(now, token_refresh_time_) >= 0 &&
+        !use_shared_token_locked(now)) {
+      token_fetch_pending_ = true;
+      start_refresh = true;
+    }
   }
   if (cached_access_token_value.has_value()) {
     gpr_mu_unlock(&mu_);
+    if (start_refresh) start_fetch();
     initial_metadata->Append(
         GRPC_AUTHORIZATION_METADATA_KEY, std::move(*cached_access_token_value),
         [](absl::string_view, const grpc_core::Slice&) { abort(); });
@@ -311,8 +408,6 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
   }
   // Couldn't get the token from the cache.
   // Add request to pending_requests_ and start a new fetch if needed.
-  grpc_core::Duration refresh_threshold =
-      grpc_core::Duration::Seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS);
   auto pending_request =
       grpc_core::MakeRefCounted<grpc_oauth2_pending_get_request_metadata>();
   pending_request->pollent = grpc_core::GetContext<grpc_polling_entity>();
@@ -322,17 +417,13 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
   pending_request->next = pending_requests_;
   pending_request->md = std::move(initial_metadata);
   pending_requests_ = pending_request->Ref().release();
-  bool start_fetch = false;
+  bool start_new_fetch = false;
   if (!token_fetch_pending_) {
     token_fetch_pending_ = true;
-    start_fetch = true;
+    start_new_fetch = true;
   }
   gpr_mu_unlock(&mu_);
-  if (start_fetch) {
-    fetch_oauth2(new grpc_credentials_metadata_request(Ref()), &pollent_,
-                 on_oauth2_token_fetcher_http_response,
-                 grpc_core::Timestamp::Now() + refresh_threshold);
-  }
+  if (start_new_fetch) start_fetch();
   return
       [pending_request]()
           -> grpc_core::Poll<absl::StatusOr<grpc_core::ClientMetadataHandle>> {
@@ -343,8 +434,33 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
       };
 }
 
+bool grpc_oauth2_token_fetcher_credentials::use_shared_token_locked(
+    gpr_timespec now) {
+  if (!grpc_core::IsSharedOauth2TokenCacheEnabled()) return false;
+  std::string key = token_cache_key();
+  if (key.empty()) return false;
+  absl::optional<SharedTokenCache::Token> token =
+      SharedTokenCache::Get()->Lookup(key);
+  if (!token.has_value() || gpr_time_cmp(now, token->refresh_time) >= 0) {
+    return false;
+  }
+  access_token_value_ = std::move(token->value);
+  token_expiration_ = token->expiration;
+  token_refresh_time_ = token->refresh_time;
+  return true;
+}
+
+void grpc_oauth2_token_fetcher_credentials::start_fetch() {
+  fetch_oauth2(new grpc_credentials_metadata_request(Ref()), &pollent_,
+               on_oauth2_token_fetcher_http_response,
+               grpc_core::Timestamp::Now() +
+                   grpc_core::Duration::Seconds(
+                       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS));
+}
+
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      token_refresh_time_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
           grpc_pollset_set_create())) {
   gpr_mu_init(&mu_);
@@ -406,6 +522,9 @@ class grpc_compute_engine_token_fetcher_credentials
         grpc_oauth2_token_fetcher_credentials::debug_string());
   }
 
+  // All compute engine credentials of the process get the same tokens.
+  std::string token_cache_key() const override { return "ComputeEngine"; }
+
  private:
   grpc_closure http_get_cb_closure_;
   grpc_core::OrphanablePtr<grpc_core::HttpRequest> http_request_;
@@ -478,6 +597,14 @@ grpc_refresh_token_credentials_create_from_auth_refresh_token(
       refresh_token);
 }
 
+std::string grpc_google_refresh_token_credentials::token_cache_key() const {
+  return absl::StrJoin({absl::string_view("RefreshToken"),
+                        absl::string_view(refresh_token_.client_id),
+                        absl::string_view(refresh_token_.client_secret),
+                        absl::string_view(refresh_token_.refresh_token)},
+                       absl::string_view("\0", 1));
+}
+
 std::string grpc_google_refresh_token_credentials::debug_string() {
   return absl::StrFormat("GoogleRefreshToken{ClientID:%s,%s}",
                          refresh_token_.client_id,
@@ -561,6 +688,22 @@ class StsTokenFetcherCredentials
         grpc_oauth2_token_fetcher_credentials::debug_string());
   }
 
+ protected:
+  // The token files are part of the key, not their contents: the tokens are
+  // shared until they are refreshed, like the ones of a single credentials.
+  std::string token_cache_key() const override {
+    auto value = [](const UniquePtr<char>& field) {
+      return field == nullptr ? absl::string_view() : field.get();
+    };
+    std::string sts_url = sts_url_.ToString();
+    return absl::StrJoin(
+        {absl::string_view("Sts"), absl::string_view(sts_url), value(resource_),
+         value(audience_), value(scope_), value(requested_token_type_),
+         value(subject_token_path_), value(subject_token_type_),
+         value(actor_token_path_), value(actor_token_type_)},
+        absl::string_view("\0", 1));
+  }
+
  private:
   void fetch_oauth2(grpc_credentials_metadata_request* metadata_req,
                     grpc_polling_entity* pollent,
@@ -80,6 +80,9 @@ grpc_auth_refresh_token grpc_auth_refresh_token_create_from_json(
 /// Destructs the object.
 void grpc_auth_refresh_token_destruct(grpc_auth_refresh_token* refresh_token);
 
+/// Forgets the tokens shared between oauth2 token fetcher credentials.
+void grpc_oauth2_token_fetcher_credentials_reset_shared_cache_for_testing();
+
 // -- Credentials Metadata Request. --
 
 struct grpc_credentials_metadata_request {
@@ -108,6 +111,10 @@ struct grpc_oauth2_pending_get_request_metadata
 //
 //  This object is a base for credentials that need to acquire an oauth2 token
 //  from an http service.
+//
+//  A token is refreshed in the background once most of its lifetime has
+//  elapsed, while calls keep using it, so that calls only wait for a fetch
+//  when there is no token or it is about to expire.
 
 class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
  public:
@@ -129,6 +136,12 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
                             grpc_polling_entity* pollent, grpc_iomgr_cb_func cb,
                             grpc_core::Timestamp deadline) = 0;
 
+  // Returns the key under which the tokens fetched by these credentials are
+  // shared with the other credentials objects in the process, or an empty
+  // string if they are not shared. Credentials returning the same key must
+  // fetch interchangeable tokens.
+  virtual std::string token_cache_key() const { return ""; }
+
  private:
   int cmp_impl(const grpc_call_credentials* other) const override {
     // TODO(yashykt): Check if we can do something better here
@@ -136,9 +149,16 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
         static_cast<const grpc_call_credentials*>(this), other);
   }
 
+  // Takes the token from the shared cache if it has one that does not need a
+  // refresh yet. Returns whether it did. Requires mu_.
+  bool use_shared_token_locked(gpr_timespec now);
+  void start_fetch();
+
   gpr_mu mu_;
   absl::optional<grpc_core::Slice> access_token_value_;
   gpr_timespec token_expiration_;
+  // When to start refreshing the token in the background.
+  gpr_timespec token_refresh_time_;
   bool token_fetch_pending_ = false;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_polling_entity pollent_;
@@ -164,6 +184,7 @@ class grpc_google_refresh_token_credentials final
   void fetch_oauth2(grpc_credentials_metadata_request* req,
                     grpc_polling_entity* pollent, grpc_iomgr_cb_func cb,
                     grpc_core::Timestamp deadline) override;
+  std::string token_cache_key() const override;
 
  private:
   grpc_auth_refresh_token refresh_token_;
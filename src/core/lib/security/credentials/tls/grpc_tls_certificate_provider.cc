@@ -19,19 +19,34 @@
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <time.h>
 
 #include <algorithm>
+#include <set>
 #include <utility>
 #include <vector>
 
+#ifdef GPR_LINUX
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <openssl/bio.h>
 #include <openssl/crypto.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/slice.h>
@@ -116,6 +131,171 @@ gpr_timespec TimeoutSecondsToDeadline(int64_t seconds) {
 
 }  // namespace
 
+#ifdef GPR_LINUX
+
+// Watches the directories of the credential files with inotify. Directories
+// rather than files are watched so that files replaced by a rename, or by
+// swapping a symlink to them as Kubernetes does for mounted secrets, are
+// seen to change.
+class FileWatcherCertificateProvider::FileChangeNotifier {
+ public:
+  // Returns null if the files cannot be watched.
+  static std::unique_ptr<FileChangeNotifier> Create(
+      const std::vector<std::string>& paths) {
+    int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+      gpr_log(GPR_INFO,
+              "inotify_init1 failed: %s. Credential files will only be "
+              "reloaded on refresh.",
+              strerror(errno));
+      return nullptr;
+    }
+    int wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd < 0) {
+      close(inotify_fd);
+      return nullptr;
+    }
+    auto notifier = absl::WrapUnique(
+        new FileChangeNotifier(paths, inotify_fd, wakeup_fd));
+    for (const std::string& path : paths) {
+      const size_t slash = path.rfind('/');
+      const std::string dir =
+          slash == std::string::npos ? "." : path.substr(0, slash + 1);
+      if (inotify_add_watch(inotify_fd, dir.c_str(),
+                            IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                                IN_DELETE | IN_ATTRIB) < 0) {
+        gpr_log(GPR_INFO,
+                "Watching %s failed: %s. Credential files will only be "
+                "reloaded on refresh.",
+                dir.c_str(), strerror(errno));
+        return nullptr;
+      }
+    }
+    notifier->UpdateSignature();
+    return notifier;
+  }
+
+  ~FileChangeNotifier() {
+    close(inotify_fd_);
+    close(wakeup_fd_);
+  }
+
+  // Waits up to timeout_sec for the files to change, or for WakeUp().
+  // Returns whether they changed.
+  bool Wait(int64_t timeout_sec) {
+    const gpr_timespec deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_seconds(timeout_sec, GPR_TIMESPAN));
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wakeup_fd_, POLLIN, 0}};
+    while (true) {
+      const int timeout_ms = std::max<int>(
+          0, gpr_time_to_millis(
+                 gpr_time_sub(deadline, gpr_now(GPR_CLOCK_MONOTONIC))));
+      const int ready = poll(fds, 2, timeout_ms);
+      if (ready < 0 && errno == EINTR) continue;
+      if (ready <= 0 || (fds[1].revents & POLLIN) != 0) return false;
+      // Other files in the directories may have changed.
+      if (DrainEvents()) break;
+    }
+    // The key and the certificate are usually written one after the other:
+    // wait a little for writes to settle, rather than read half an update.
+    poll(&fds[1], 1, kSettleTimeMs);
+    DrainEvents();
+    return true;
+  }
+
+  void WakeUp() {
+    uint64_t one = 1;
+    GPR_ASSERT(write(wakeup_fd_, &one, sizeof(one)) == sizeof(one));
+  }
+
+  // Records the identity, size and times of the files, as stat() reports
+  // them, and returns whether they differ from the previous record. This
+  // catches changes that inotify did not report, e.g. on network file
+  // systems, without reading the files.
+  bool UpdateSignature() {
+    std::vector<std::string> parts;
+    for (const std::string& path : paths_) {
+      struct stat st;
+      if (stat(path.c_str(), &st) != 0) {
+        parts.push_back("-");
+        continue;
+      }
+      parts.push_back(absl::StrCat(st.st_dev, ":", st.st_ino, ":", st.st_size,
+                                   ":", st.st_mtim.tv_sec, ".",
+                                   st.st_mtim.tv_nsec, ":", st.st_ctim.tv_sec,
+                                   ".", st.st_ctim.tv_nsec));
+    }
+    std::string signature = absl::StrJoin(parts, ";");
+    if (signature == signature_) return false;
+    signature_ = std::move(signature);
+    return true;
+  }
+
+ private:
+  static constexpr int kSettleTimeMs = 100;
+
+  FileChangeNotifier(const std::vector<std::string>& paths, int inotify_fd,
+                     int wakeup_fd)
+      : paths_(paths), inotify_fd_(inotify_fd), wakeup_fd_(wakeup_fd) {
+    for (const std::string& path : paths) {
+      const size_t slash = path.rfind('/');
+      names_.insert(slash == std::string::npos ? path
+                                                : path.substr(slash + 1));
+      // A symlink to a file through a symlinked directory next to it, as in
+      // Kubernetes, changes when that directory symlink is replaced.
+      char target[PATH_MAX];
+      ssize_t length = readlink(path.c_str(), target, sizeof(target) - 1);
+      if (length > 0 && target[0] != '/') {
+        std::string link(target, length);
+        names_.insert(link.substr(0, link.find('/')));
+      }
+    }
+  }
+
+  // Reads the pending events, and returns whether any was about the files.
+  bool DrainEvents() {
+    alignas(inotify_event) char buffer[4096];
+    bool relevant = false;
+    while (true) {
+      ssize_t length = read(inotify_fd_, buffer, sizeof(buffer));
+      if (length <= 0) break;
+      for (char* p = buffer; p < buffer + length;) {
+        const inotify_event* event = reinterpret_cast<inotify_event*>(p);
+        if ((event->mask & IN_Q_OVERFLOW) != 0 ||
+            (event->len > 0 && names_.count(event->name) > 0)) {
+          relevant = true;
+        }
+        p += sizeof(inotify_event) + event->len;
+      }
+    }
+    return relevant;
+  }
+
+  const std::vector<std::string> paths_;
+  // The names, in the watched directories, whose changes are relevant.
+  std::set<std::string> names_;
+  const int inotify_fd_;
+  const int wakeup_fd_;
+  std::string signature_;
+};
+
+#else  // GPR_LINUX
+
+class FileWatcherCertificateProvider::FileChangeNotifier {
+ public:
+  static std::unique_ptr<FileChangeNotifier> Create(
+      const std::vector<std::string>& /*paths*/) {
+    return nullptr;
+  }
+
+  bool Wait(int64_t /*timeout_sec*/) { return false; }
+  void WakeUp() {}
+  bool UpdateSignature() { return true; }
+};
+
+#endif  // GPR_LINUX
+
 FileWatcherCertificateProvider::FileWatcherCertificateProvider(
     std::string private_key_path, std::string identity_certificate_path,
     std::string root_cert_path, int64_t refresh_interval_sec)
@@ -129,12 +309,27 @@ FileWatcherCertificateProvider::FileWatcherCertificateProvider(
   // Must be watching either root or identity certs.
   GPR_ASSERT(!private_key_path_.empty() || !root_cert_path_.empty());
   gpr_event_init(&shutdown_event_);
+  std::vector<std::string> paths;
+  for (const std::string* path :
+       {&private_key_path_, &identity_certificate_path_, &root_cert_path_}) {
+    if (!path->empty()) paths.push_back(*path);
+  }
+  file_change_notifier_ = FileChangeNotifier::Create(paths);
   ForceUpdate();
   auto thread_lambda = [](void* arg) {
     FileWatcherCertificateProvider* provider =
         static_cast<FileWatcherCertificateProvider*>(arg);
     GPR_ASSERT(provider != nullptr);
+    FileChangeNotifier* notifier = provider->file_change_notifier_.get();
     while (true) {
+      if (notifier != nullptr) {
+        // Reload as soon as the files change, and on refresh only if stat()
+        // says they changed, which inotify may miss.
+        const bool notified = notifier->Wait(provider->refresh_interval_sec_);
+        if (gpr_event_get(&provider->shutdown_event_) != nullptr) return;
+        if (notifier->UpdateSignature() || notified) provider->ForceUpdate();
+        continue;
+      }
       void* value = gpr_event_wait(
           &provider->shutdown_event_,
           TimeoutSecondsToDeadline(provider->refresh_interval_sec_));
@@ -195,6 +390,7 @@ FileWatcherCertificateProvider::~FileWatcherCertificateProvider() {
   // again after this object(provider) is destroyed.
   distributor_->SetWatchStatusCallback(nullptr);
   gpr_event_set(&shutdown_event_, reinterpret_cast<void*>(1));
+  if (file_change_notifier_ != nullptr) file_change_notifier_->WakeUp();
   refresh_thread_.Join();
 }
 
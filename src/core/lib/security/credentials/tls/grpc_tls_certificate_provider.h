@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "absl/base/thread_annotations.h"
@@ -157,6 +158,8 @@ class FileWatcherCertificateProvider final
     bool identity_being_watched = false;
   };
 
+  class FileChangeNotifier;
+
   int CompareImpl(const grpc_tls_certificate_provider* other) const override {
     // TODO(yashykt): Maybe do something better here.
     return QsortCompare(static_cast<const grpc_tls_certificate_provider*>(this),
@@ -181,6 +184,9 @@ class FileWatcherCertificateProvider final
   int64_t refresh_interval_sec_ = 0;
 
   RefCountedPtr<grpc_tls_certificate_distributor> distributor_;
+  // Wakes the refreshing thread up as soon as the files change, where the
+  // platform supports it; null otherwise.
+  std::unique_ptr<FileChangeNotifier> file_change_notifier_;
   Thread refresh_thread_;
   gpr_event shutdown_event_;
 
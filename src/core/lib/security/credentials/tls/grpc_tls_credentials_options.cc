@@ -96,6 +96,23 @@ void grpc_tls_credentials_options_set_crl_directory(
   options->set_crl_directory(crl_directory);
 }
 
+void grpc_tls_credentials_options_set_session_ticket_keys(
+    grpc_tls_credentials_options* options, grpc_ssl_session_ticket_keys* keys) {
+  GPR_ASSERT(options != nullptr);
+  GPR_ASSERT(keys != nullptr);
+  options->set_session_ticket_keys(
+      tsi::SslSessionTicketKeys::FromC(keys)->Ref());
+}
+
+void grpc_tls_credentials_options_set_private_key_signer(
+    grpc_tls_credentials_options* options,
+    grpc_tls_private_key_signer* signer) {
+  GPR_ASSERT(options != nullptr);
+  GPR_ASSERT(signer != nullptr);
+  options->set_private_key_signer(
+      tsi::SslPrivateKeySigner::FromC(signer)->Ref());
+}
+
 void grpc_tls_credentials_options_set_check_call_host(
     grpc_tls_credentials_options* options, int check_call_host) {
   GPR_ASSERT(options != nullptr);
@@ -61,6 +61,8 @@ struct grpc_tls_credentials_options
   const std::string& identity_cert_name() const { return identity_cert_name_; }
   const std::string& tls_session_key_log_file_path() const { return tls_session_key_log_file_path_; }
   const std::string& crl_directory() const { return crl_directory_; }
+  const grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys>& session_ticket_keys() const { return session_ticket_keys_; }
+  const grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner>& private_key_signer() const { return private_key_signer_; }
 
   // Setters for member fields.
   void set_cert_request_type(grpc_ssl_client_certificate_request_type cert_request_type) { cert_request_type_ = cert_request_type; }
@@ -81,6 +83,10 @@ struct grpc_tls_credentials_options
   void set_tls_session_key_log_file_path(std::string tls_session_key_log_file_path) { tls_session_key_log_file_path_ = std::move(tls_session_key_log_file_path); }
   //  gRPC will enforce CRLs on all handshakes from all hashed CRL files inside of the crl_directory. If not set, an empty string will be used, which will not enable CRL checking. Only supported for OpenSSL version > 1.1.
   void set_crl_directory(std::string crl_directory) { crl_directory_ = std::move(crl_directory); }
+  // Sets the keys the server encrypts session tickets with. Servers sharing the same keys resume each other's sessions. If not set, each server uses its own random key.
+  void set_session_ticket_keys(grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys> session_ticket_keys) { session_ticket_keys_ = std::move(session_ticket_keys); }
+  // Sets the signer that performs the signing operations of the server's handshakes, for servers whose private key is not loaded in the process. If set, the private keys of the identity key-cert pairs are ignored.
+  void set_private_key_signer(grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer) { private_key_signer_ = std::move(private_key_signer); }
 
   bool operator==(const grpc_tls_credentials_options& other) const {
     return cert_request_type_ == other.cert_request_type_ &&
@@ -95,7 +101,9 @@ struct grpc_tls_credentials_options
       watch_identity_pair_ == other.watch_identity_pair_ &&
       identity_cert_name_ == other.identity_cert_name_ &&
       tls_session_key_log_file_path_ == other.tls_session_key_log_file_path_ &&
-      crl_directory_ == other.crl_directory_;
+      crl_directory_ == other.crl_directory_ &&
+      session_ticket_keys_ == other.session_ticket_keys_ &&
+      private_key_signer_ == other.private_key_signer_;
   }
 
  private:
@@ -112,6 +120,8 @@ struct grpc_tls_credentials_options
   std::string identity_cert_name_;
   std::string tls_session_key_log_file_path_;
   std::string crl_directory_;
+  grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys> session_ticket_keys_;
+  grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer_;
 };
 
 #endif  // GRPC_CORE_LIB_SECURITY_CREDENTIALS_TLS_GRPC_TLS_CREDENTIALS_OPTIONS_H
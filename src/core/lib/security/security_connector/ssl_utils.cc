@@ -29,6 +29,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
@@ -37,6 +38,7 @@
 
 #include "src/core/ext/transport/chttp2/alpn/alpn.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/host_port.h"
@@ -155,6 +157,16 @@ grpc_error_handle grpc_ssl_check_alpn(const tsi_peer* peer) {
   return absl::OkStatus();
 }
 
+void grpc_ssl_count_server_handshake(const tsi_peer* peer) {
+  GRPC_STATS_INC_TLS_SERVER_HANDSHAKES();
+  const tsi_peer_property* p =
+      tsi_peer_get_property_by_name(peer, TSI_SSL_SESSION_REUSED_PEER_PROPERTY);
+  if (p != nullptr &&
+      absl::string_view(p->value.data, p->value.length) == "true") {
+    GRPC_STATS_INC_TLS_SERVER_SESSIONS_RESUMED();
+  }
+}
+
 grpc_error_handle grpc_ssl_check_peer_name(absl::string_view peer_name,
                                            const tsi_peer* peer) {
   /* Check the peer name if specified. */
@@ -481,7 +493,8 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     grpc_ssl_client_certificate_request_type client_certificate_request,
     tsi_tls_version min_tls_version, tsi_tls_version max_tls_version,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslSessionTicketKeys* session_ticket_keys,
+    tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_server_handshaker_factory** handshaker_factory) {
   size_t num_alpn_protocols = 0;
   const char** alpn_protocol_strings =
@@ -499,6 +512,8 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
   options.max_tls_version = max_tls_version;
   options.key_logger = tls_session_key_logger;
   options.crl_directory = crl_directory;
+  options.session_ticket_keys = session_ticket_keys;
+  options.private_key_signer = private_key_signer;
   const tsi_result result =
       tsi_create_ssl_server_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -553,6 +568,38 @@ grpc_arg grpc_ssl_session_cache_create_channel_arg(
       const_cast<char*>(GRPC_SSL_SESSION_CACHE_ARG), cache, &vtable);
 }
 
+/* --- Ssl session ticket keys implementation. --- */
+
+grpc_ssl_session_ticket_keys* grpc_ssl_session_ticket_keys_create(void) {
+  return (new tsi::SslSessionTicketKeys())->c_ptr();
+}
+
+int grpc_ssl_session_ticket_keys_rotate(grpc_ssl_session_ticket_keys* keys,
+                                        const char* key, size_t key_size) {
+  GPR_ASSERT(keys != nullptr);
+  return tsi::SslSessionTicketKeys::FromC(keys)->Rotate(
+      absl::string_view(key, key_size));
+}
+
+void grpc_ssl_session_ticket_keys_release(grpc_ssl_session_ticket_keys* keys) {
+  if (keys == nullptr) return;
+  tsi::SslSessionTicketKeys::FromC(keys)->Unref();
+}
+
+/* --- TLS private key signer implementation. --- */
+
+grpc_tls_private_key_signer* grpc_tls_private_key_signer_external_create(
+    const grpc_tls_private_key_signer_external* external_signer) {
+  GPR_ASSERT(external_signer != nullptr);
+  GPR_ASSERT(external_signer->sign != nullptr);
+  return (new tsi::ExternalSslPrivateKeySigner(*external_signer))->c_ptr();
+}
+
+void grpc_tls_private_key_signer_release(grpc_tls_private_key_signer* signer) {
+  if (signer == nullptr) return;
+  tsi::SslPrivateKeySigner::FromC(signer)->Unref();
+}
+
 /* --- Default SSL root store implementation. --- */
 
 namespace grpc_core {
@@ -46,6 +46,9 @@
 /* Check ALPN information returned from SSL handshakes. */
 grpc_error_handle grpc_ssl_check_alpn(const tsi_peer* peer);
 
+/* Count a server-side SSL handshake, and whether it resumed a session. */
+void grpc_ssl_count_server_handshake(const tsi_peer* peer);
+
 /* Check peer name information returned from SSL handshakes. */
 grpc_error_handle grpc_ssl_check_peer_name(absl::string_view peer_name,
                                            const tsi_peer* peer);
@@ -93,7 +96,8 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     grpc_ssl_client_certificate_request_type client_certificate_request,
     tsi_tls_version min_tls_version, tsi_tls_version max_tls_version,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslSessionTicketKeys* session_ticket_keys,
+    tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_server_handshaker_factory** handshaker_factory);
 
 /* Free the memory occupied by key cert pairs. */
@@ -0,0 +1,99 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/handshake_thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+// Enough queued new handshakes to keep the threads busy for a few
+// milliseconds each.
+constexpr size_t kMaxQueuedHandshakesPerThread = 32;
+}  // namespace
+
+HandshakeThreadPool* HandshakeThreadPool::Get() {
+  static HandshakeThreadPool* pool = [] {
+    const size_t num_threads = std::max(1u, gpr_cpu_num_cores() / 2);
+    return new HandshakeThreadPool(
+        num_threads, num_threads * kMaxQueuedHandshakesPerThread);
+  }();
+  return pool;
+}
+
+HandshakeThreadPool::HandshakeThreadPool(size_t num_threads,
+                                         size_t max_queued_handshakes)
+    : max_queued_handshakes_(max_queued_handshakes) {
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    // Untracked, since the process-wide pool is never shut down and would
+    // otherwise hold up a fork.
+    threads_.emplace_back("grpc_handshake", &ThreadBody, this, nullptr,
+                          Thread::Options().set_tracked(false));
+    threads_.back().Start();
+  }
+}
+
+HandshakeThreadPool::~HandshakeThreadPool() {
+  {
+    MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (Thread& thread : threads_) thread.Join();
+}
+
+bool HandshakeThreadPool::Run(absl::AnyInvocable<void()> callback,
+                              bool new_handshake) {
+  MutexLock lock(&mu_);
+  if (new_handshake && callbacks_.size() >= max_queued_handshakes_) {
+    return false;
+  }
+  callbacks_.push_back(std::move(callback));
+  cv_.Signal();
+  return true;
+}
+
+void HandshakeThreadPool::ThreadBody(void* arg) {
+  HandshakeThreadPool* pool = static_cast<HandshakeThreadPool*>(arg);
+  while (true) {
+    absl::AnyInvocable<void()> callback;
+    {
+      MutexLock lock(&pool->mu_);
+      while (pool->callbacks_.empty() && !pool->shutdown_) {
+        pool->cv_.Wait(&pool->mu_);
+      }
+      // Shut down once the queue is drained.
+      if (pool->callbacks_.empty()) return;
+      callback = std::move(pool->callbacks_.front());
+      pool->callbacks_.pop_front();
+    }
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    callback();
+    callback = nullptr;
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,75 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_THREAD_POOL_H
+#define GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <deque>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_core {
+
+// A fixed number of threads that the security handshakers run their steps
+// on, so that the CPU-heavy parts of a handshake (signing, certificate
+// verification) are kept off the I/O threads that established connections
+// depend on.
+//
+// The pool admits a bounded number of queued new handshakes: past that,
+// new handshakes are rejected until the pool catches up, so that a reconnect
+// storm cannot queue up more work than the pool can get through before the
+// clients time out. The steps of handshakes already admitted are always
+// queued.
+class HandshakeThreadPool {
+ public:
+  // Returns the pool shared by all security handshakers.
+  static HandshakeThreadPool* Get();
+
+  HandshakeThreadPool(size_t num_threads, size_t max_queued_handshakes);
+  // Runs the queued callbacks, and joins the threads.
+  ~HandshakeThreadPool();
+
+  HandshakeThreadPool(const HandshakeThreadPool&) = delete;
+  HandshakeThreadPool& operator=(const HandshakeThreadPool&) = delete;
+
+  // Runs \a callback on one of the threads of the pool, with an ExecCtx.
+  // Returns false, and does not run \a callback, if it starts a new
+  // handshake and max_queued_handshakes callbacks are already queued.
+  bool Run(absl::AnyInvocable<void()> callback, bool new_handshake);
+
+ private:
+  static void ThreadBody(void* arg);
+
+  const size_t max_queued_handshakes_;
+  Mutex mu_;
+  CondVar cv_;
+  std::deque<absl::AnyInvocable<void()>> callbacks_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<Thread> threads_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_THREAD_POOL_H
@@ -41,6 +41,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -73,7 +74,16 @@ struct secure_endpoint {
                   size_t leftover_nslices)
       : wrapped_ep(transport),
         protector(protector),
-        zero_copy_protector(zero_copy_protector) {
+        zero_copy_protector(zero_copy_protector),
+        protector_is_full_duplex(
+            zero_copy_protector != nullptr
+                ? tsi_zero_copy_grpc_protector_is_full_duplex(
+                      zero_copy_protector)
+                : tsi_frame_protector_is_full_duplex(protector)),
+        release_staging_buffers_when_idle(
+            grpc_core::ChannelArgs::FromC(channel_args)
+                .GetInt(GRPC_ARG_IDLE_HIBERNATION_MS)
+                .value_or(0) > 0) {
     base.vtable = vtable;
     gpr_mu_init(&protector_mu);
     GRPC_CLOSURE_INIT(&on_read, ::on_read, this, grpc_schedule_on_exec_ctx);
@@ -122,6 +132,12 @@ struct secure_endpoint {
   grpc_endpoint* wrapped_ep;
   struct tsi_frame_protector* protector;
   struct tsi_zero_copy_grpc_protector* zero_copy_protector;
+  /* Whether reads and writes may use the protector concurrently. Otherwise
+     they serialize on protector_mu. */
+  const bool protector_is_full_duplex;
+  /* Whether the staging buffers are freed between reads and between writes,
+     rather than kept for the next one. */
+  const bool release_staging_buffers_when_idle;
   gpr_mu protector_mu;
   grpc_core::Mutex read_mu;
   grpc_core::Mutex write_mu;
@@ -190,6 +206,14 @@ static void secure_endpoint_unref(secure_endpoint* ep) {
 static void secure_endpoint_ref(secure_endpoint* ep) { gpr_ref(&ep->ref); }
 #endif
 
+static void lock_protector(secure_endpoint* ep) {
+  if (!ep->protector_is_full_duplex) gpr_mu_lock(&ep->protector_mu);
+}
+
+static void unlock_protector(secure_endpoint* ep) {
+  if (!ep->protector_is_full_duplex) gpr_mu_unlock(&ep->protector_mu);
+}
+
 static void maybe_post_reclaimer(secure_endpoint* ep) {
   if (!ep->has_posted_reclaimer) {
     SECURE_ENDPOINT_REF(ep, "benign_reclaimer");
@@ -224,6 +248,15 @@ static void maybe_post_reclaimer(secure_endpoint* ep) {
   }
 }
 
+/* Allocates a staging buffer freed by the reclaimer or while idle. */
+static void ensure_staging_buffer(secure_endpoint* ep, grpc_slice* buffer) {
+  if (ep->zero_copy_protector == nullptr && GRPC_SLICE_LENGTH(*buffer) == 0) {
+    grpc_slice_unref(*buffer);
+    *buffer = ep->memory_owner.MakeSlice(
+        grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
+  }
+}
+
 static void flush_read_staging_buffer(secure_endpoint* ep, uint8_t** cur,
                                       uint8_t** end)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(ep->read_mu) {
@@ -257,6 +290,7 @@ static void on_read(void* user_data, grpc_error_handle error) {
 
   {
     grpc_core::MutexLock l(&ep->read_mu);
+    ensure_staging_buffer(ep, &ep->read_staging_buffer);
     uint8_t* cur = GRPC_SLICE_START_PTR(ep->read_staging_buffer);
     uint8_t* end = GRPC_SLICE_END_PTR(ep->read_staging_buffer);
 
@@ -277,9 +311,11 @@ static void on_read(void* user_data, grpc_error_handle error) {
       // avoid reading of small slices from the network.
       // TODO(vigneshbabu): Set min_progress_size in the regular (non-zero-copy)
       // frame protector code path as well.
+      lock_protector(ep);
       result = tsi_zero_copy_grpc_protector_unprotect(
           ep->zero_copy_protector, &ep->source_buffer, ep->read_buffer,
           &min_progress_size);
+      unlock_protector(ep);
       min_progress_size = std::max(1, min_progress_size);
       ep->min_progress_size = result != TSI_OK ? 1 : min_progress_size;
     } else {
@@ -294,11 +330,11 @@ static void on_read(void* user_data, grpc_error_handle error) {
           size_t unprotected_buffer_size_written =
               static_cast<size_t>(end - cur);
           size_t processed_message_size = message_size;
-          gpr_mu_lock(&ep->protector_mu);
+          lock_protector(ep);
           result = tsi_frame_protector_unprotect(
               ep->protector, message_bytes, &processed_message_size, cur,
               &unprotected_buffer_size_written);
-          gpr_mu_unlock(&ep->protector_mu);
+          unlock_protector(ep);
           if (result != TSI_OK) {
             gpr_log(GPR_ERROR, "Decryption error: %s",
                     tsi_result_to_string(result));
@@ -366,6 +402,17 @@ static void endpoint_read(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     return;
   }
 
+  if (ep->release_staging_buffers_when_idle) {
+    /* The wrapped endpoint may wait a long time for the peer. */
+    grpc_slice staging;
+    {
+      grpc_core::MutexLock l(&ep->read_mu);
+      staging = ep->read_staging_buffer;
+      ep->read_staging_buffer = grpc_empty_slice();
+    }
+    grpc_slice_unref(staging);
+  }
+
   grpc_endpoint_read(ep->wrapped_ep, &ep->source_buffer, &ep->on_read, urgent,
                      /*min_progress_size=*/ep->min_progress_size);
 }
@@ -389,6 +436,7 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
 
   {
     grpc_core::MutexLock l(&ep->write_mu);
+    ensure_staging_buffer(ep, &ep->write_staging_buffer);
     uint8_t* cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
     uint8_t* end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
 
@@ -406,6 +454,7 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     if (ep->zero_copy_protector != nullptr) {
       // Use zero-copy grpc protector to protect.
       result = TSI_OK;
+      lock_protector(ep);
       // Break the input slices into chunks of size = max_frame_size and call
       // tsi_zero_copy_grpc_protector_protect on each chunk. This ensures that
       // the protector cannot create frames larger than the specified
@@ -423,6 +472,7 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
         result = tsi_zero_copy_grpc_protector_protect(
             ep->zero_copy_protector, slices, &ep->output_buffer);
       }
+      unlock_protector(ep);
       grpc_slice_buffer_reset_and_unref(&ep->protector_staging_buffer);
     } else {
       // Use frame protector to protect.
@@ -433,11 +483,11 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
         while (message_size > 0) {
           size_t protected_buffer_size_to_send = static_cast<size_t>(end - cur);
           size_t processed_message_size = message_size;
-          gpr_mu_lock(&ep->protector_mu);
+          lock_protector(ep);
           result = tsi_frame_protector_protect(ep->protector, message_bytes,
                                                &processed_message_size, cur,
                                                &protected_buffer_size_to_send);
-          gpr_mu_unlock(&ep->protector_mu);
+          unlock_protector(ep);
           if (result != TSI_OK) {
             gpr_log(GPR_ERROR, "Encryption error: %s",
                     tsi_result_to_string(result));
@@ -457,11 +507,11 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
         size_t still_pending_size;
         do {
           size_t protected_buffer_size_to_send = static_cast<size_t>(end - cur);
-          gpr_mu_lock(&ep->protector_mu);
+          lock_protector(ep);
           result = tsi_frame_protector_protect_flush(
               ep->protector, cur, &protected_buffer_size_to_send,
               &still_pending_size);
-          gpr_mu_unlock(&ep->protector_mu);
+          unlock_protector(ep);
           if (result != TSI_OK) break;
           cur += protected_buffer_size_to_send;
           if (cur == end) {
@@ -478,6 +528,10 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
         }
       }
     }
+    if (ep->release_staging_buffers_when_idle) {
+      grpc_slice_unref(ep->write_staging_buffer);
+      ep->write_staging_buffer = grpc_empty_slice();
+    }
   }
 
   if (result != TSI_OK) {
@@ -543,6 +597,12 @@ static bool endpoint_can_track_err(grpc_endpoint* secure_ep) {
   return grpc_endpoint_can_track_err(ep->wrapped_ep);
 }
 
+static void endpoint_set_channelz_socket(
+    grpc_endpoint* secure_ep, grpc_core::channelz::SocketNode* socket) {
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  grpc_endpoint_set_channelz_socket(ep->wrapped_ep, socket);
+}
+
 static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_write,
                                             endpoint_add_to_pollset,
@@ -553,7 +613,8 @@ static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_get_peer,
                                             endpoint_get_local_address,
                                             endpoint_get_fd,
-                                            endpoint_can_track_err};
+                                            endpoint_can_track_err,
+                                            endpoint_set_channelz_socket};
 
 grpc_endpoint* grpc_secure_endpoint_create(
     struct tsi_frame_protector* protector,
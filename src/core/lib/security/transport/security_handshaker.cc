@@ -45,6 +45,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -56,6 +57,7 @@
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/tcp_server.h"
 #include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/security/transport/handshake_thread_pool.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -85,6 +87,10 @@ class SecurityHandshaker : public Handshaker {
  private:
   grpc_error_handle DoHandshakerNextLocked(const unsigned char* bytes_received,
                                            size_t bytes_received_size);
+  // Like DoHandshakerNextLocked() with the bytes in handshake_buffer_, but on
+  // the handshake thread pool if it is enabled.
+  grpc_error_handle OffloadHandshakerNextLocked(size_t bytes_received_size);
+  void OnOffloadedHandshakerNext(size_t bytes_received_size);
 
   grpc_error_handle OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -132,6 +138,8 @@ class SecurityHandshaker : public Handshaker {
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
   std::string tsi_handshake_error_;
+  // Whether the handshake thread pool already admitted this handshake.
+  bool admitted_to_thread_pool_ = false;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -276,9 +284,30 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
         result));
     return;
   }
+  // Hand the protection of the connection over to the kernel if possible.
+  // Zero-copy sends are not supported on sockets protected by the kernel.
+  bool offloaded_to_kernel = false;
+  if (frame_protector_type != TSI_FRAME_PROTECTOR_NONE &&
+      IsKernelTlsEnabled() &&
+      !args_->args.GetBool(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED).value_or(false)) {
+    const int fd = grpc_endpoint_get_fd(args_->endpoint);
+    if (fd >= 0) {
+      result = tsi_handshaker_result_offload_to_kernel(handshaker_result_, fd);
+      if (result == TSI_OK) {
+        offloaded_to_kernel = true;
+      } else if (result != TSI_UNIMPLEMENTED) {
+        HandshakeFailedLocked(grpc_set_tsi_error_result(
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "Offloading the frame protection to the kernel failed"),
+            result));
+        return;
+      }
+    }
+  }
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_frame_protector* protector = nullptr;
-  switch (frame_protector_type) {
+  switch (offloaded_to_kernel ? TSI_FRAME_PROTECTOR_NONE
+                              : frame_protector_type) {
     case TSI_FRAME_PROTECTOR_ZERO_COPY:
       ABSL_FALLTHROUGH_INTENDED;
     case TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY:
@@ -336,8 +365,8 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
   tsi_handshaker_result_destroy(handshaker_result_);
   handshaker_result_ = nullptr;
   args_->args = args_->args.SetObject(auth_context_);
-  // Add channelz channel args only if frame protector is created.
-  if (has_frame_protector) {
+  // Add channelz channel args only if the connection is protected.
+  if (has_frame_protector || offloaded_to_kernel) {
     args_->args = args_->args.SetObject(
         MakeChannelzSecurityFromAuthContext(auth_context_.get()));
   }
@@ -435,6 +464,10 @@ grpc_error_handle SecurityHandshaker::OnHandshakeNextDoneLocked(
 void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
     tsi_result result, void* user_data, const unsigned char* bytes_to_send,
     size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result) {
+  // The TSI thread invoking the callback, e.g. one delivering a private key
+  // signature, may not have an ExecCtx.
+  ApplicationCallbackExecCtx callback_exec_ctx;
+  ExecCtx exec_ctx;
   RefCountedPtr<SecurityHandshaker> h(
       static_cast<SecurityHandshaker*>(user_data));
   MutexLock lock(&h->mu_);
@@ -468,6 +501,41 @@ grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
                                    hs_result);
 }
 
+grpc_error_handle SecurityHandshaker::OffloadHandshakerNextLocked(
+    size_t bytes_received_size) {
+  if (!IsHandshakeThreadPoolEnabled()) {
+    return DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+  }
+  // The caller's ref is handed over to the callback.
+  if (!HandshakeThreadPool::Get()->Run(
+          [this, bytes_received_size]() {
+            OnOffloadedHandshakerNext(bytes_received_size);
+          },
+          /*new_handshake=*/!admitted_to_thread_pool_)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Too many handshakes in progress");
+  }
+  admitted_to_thread_pool_ = true;
+  return absl::OkStatus();
+}
+
+void SecurityHandshaker::OnOffloadedHandshakerNext(
+    size_t bytes_received_size) {
+  RefCountedPtr<SecurityHandshaker> h(this);
+  MutexLock lock(&mu_);
+  if (is_shutdown_) {
+    HandshakeFailedLocked(absl::OkStatus());
+    return;
+  }
+  grpc_error_handle error =
+      DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+  if (!error.ok()) {
+    HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
 // This callback might be run inline while we are still holding on to the mutex,
 // so schedule OnHandshakeDataReceivedFromPeerFn on ExecCtx to avoid a deadlock.
 void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFnScheduler(
@@ -493,7 +561,7 @@ void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn(
   // Copy all slices received.
   size_t bytes_received_size = h->MoveReadBufferIntoHandshakeBuffer();
   // Call TSI handshaker.
-  error = h->DoHandshakerNextLocked(h->handshake_buffer_, bytes_received_size);
+  error = h->OffloadHandshakerNextLocked(bytes_received_size);
   if (!error.ok()) {
     h->HandshakeFailedLocked(error);
   } else {
@@ -565,8 +633,7 @@ void SecurityHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
   args_ = args;
   on_handshake_done_ = on_handshake_done;
   size_t bytes_received_size = MoveReadBufferIntoHandshakeBuffer();
-  grpc_error_handle error =
-      DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+  grpc_error_handle error = OffloadHandshakerNextLocked(bytes_received_size);
   if (!error.ok()) {
     HandshakeFailedLocked(error);
   } else {
@@ -0,0 +1,62 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/service_config/registered_method_path.h"
+
+#include <string.h>
+
+#include <new>
+
+#include <grpc/support/alloc.h>
+
+namespace grpc_core {
+
+Slice RegisteredMethodPath::Create(absl::string_view path) {
+  // The bytes of the path follow the refcount, in the same allocation.
+  void* p = gpr_malloc(sizeof(RegisteredMethodPath) + path.size());
+  auto* refcount = new (p) RegisteredMethodPath(path.size());
+  if (!path.empty()) memcpy(refcount->bytes(), path.data(), path.size());
+  grpc_slice slice;
+  slice.refcount = refcount;
+  slice.data.refcounted.bytes = refcount->bytes();
+  slice.data.refcounted.length = path.size();
+  return Slice(slice);
+}
+
+RegisteredMethodPath* RegisteredMethodPath::FromSlice(const grpc_slice& path) {
+  if (path.refcount == nullptr ||
+      path.refcount == grpc_slice_refcount::NoopRefcount() ||
+      path.refcount->destroyer_fn() != Destroy) {
+    return nullptr;
+  }
+  auto* refcount = static_cast<RegisteredMethodPath*>(path.refcount);
+  // A sub-slice shares the refcount, but not the path.
+  if (path.data.refcounted.bytes != refcount->bytes() ||
+      path.data.refcounted.length != refcount->length_) {
+    return nullptr;
+  }
+  return refcount;
+}
+
+void RegisteredMethodPath::Destroy(grpc_slice_refcount* refcount) {
+  auto* path = static_cast<RegisteredMethodPath*>(refcount);
+  path->~RegisteredMethodPath();
+  gpr_free(path);
+}
+
+}  // namespace grpc_core
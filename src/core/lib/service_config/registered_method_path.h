@@ -0,0 +1,65 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SERVICE_CONFIG_REGISTERED_METHOD_PATH_H
+#define GRPC_CORE_LIB_SERVICE_CONFIG_REGISTERED_METHOD_PATH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_refcount.h"
+
+namespace grpc_core {
+
+// The refcount of the path slice of a method registered with
+// grpc_channel_register_call(). All calls to the method share the slice,
+// which remembers the method config last looked up for it: the next lookup
+// in the same service config is then a load instead of a hash of the path.
+class RegisteredMethodPath final : public grpc_slice_refcount {
+ public:
+  static Slice Create(absl::string_view path);
+
+  // Returns the RegisteredMethodPath whose whole slice path is, or nullptr.
+  static RegisteredMethodPath* FromSlice(const grpc_slice& path);
+
+  // The method config last looked up for this path, encoded by the service
+  // config that looked it up, or 0.
+  std::atomic<uint64_t>* method_config_cache() { return &method_config_cache_; }
+
+ private:
+  explicit RegisteredMethodPath(size_t length)
+      : grpc_slice_refcount(Destroy), length_(length) {}
+
+  static void Destroy(grpc_slice_refcount* refcount);
+
+  uint8_t* bytes() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  const size_t length_;
+  std::atomic<uint64_t> method_config_cache_{0};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SERVICE_CONFIG_REGISTERED_METHOD_PATH_H
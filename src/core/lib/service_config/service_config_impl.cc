@@ -18,30 +18,143 @@
 
 #include "src/core/lib/service_config/service_config_impl.h"
 
-#include <string.h>
-
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <string>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/variant.h"
 
 #include <grpc/support/log.h>
 
 #include "src/core/lib/config/core_configuration.h"
-#include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/service_config/registered_method_path.h"
 #include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 namespace grpc_core {
 
+namespace {
+
+// Keeps the most recently used parse results, so that a resolver that
+// returns the same service config on each update, or channels to the same
+// target, do not parse it again.
+class ServiceConfigCache {
+ public:
+  using Result = absl::StatusOr<RefCountedPtr<ServiceConfig>>;
+
+  static ServiceConfigCache* Get() {
+    static ServiceConfigCache* cache = new ServiceConfigCache();
+    return cache;
+  }
+
+  template <typename ParseFn>
+  Result GetOrParse(const ChannelArgs& args, absl::string_view json_string,
+                    ParseFn parse) {
+    Key key{CoreConfiguration::Get().service_config_parser().generation(),
+            absl::Hash<absl::string_view>()(json_string),
+            std::string(json_string), ArgsKey(args)};
+    {
+      MutexLock lock(&mu_);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        it->second.last_used = ++uses_;
+        return it->second.result;
+      }
+    }
+    // Parse outside of the lock: if another thread got there first, its
+    // result is kept and shared.
+    Result result = parse();
+    MutexLock lock(&mu_);
+    // Entries are ordered by generation first: drop the ones parsed before
+    // the configuration was last reset.
+    while (!entries_.empty() &&
+           entries_.begin()->first.parser_generation < key.parser_generation) {
+      entries_.erase(entries_.begin());
+    }
+    if (entries_.size() >= kMaxEntries && entries_.count(key) == 0) {
+      entries_.erase(std::min_element(
+          entries_.begin(), entries_.end(),
+          [](const Entries::value_type& a, const Entries::value_type& b) {
+            return a.second.last_used < b.second.last_used;
+          }));
+    }
+    Entry& entry = entries_.emplace(std::move(key), Entry{std::move(result), 0})
+                       .first->second;
+    entry.last_used = ++uses_;
+    return entry.result;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 64;
+
+  struct Key {
+    uint64_t parser_generation;
+    size_t json_hash;
+    std::string json;
+    ChannelArgs args;
+
+    bool operator<(const Key& other) const {
+      if (parser_generation != other.parser_generation) {
+        return parser_generation < other.parser_generation;
+      }
+      if (json_hash != other.json_hash) return json_hash < other.json_hash;
+      if (json != other.json) return json < other.json;
+      return args < other.args;
+    }
+  };
+
+  struct Entry {
+    Result result;
+    uint64_t last_used;
+  };
+
+  using Entries = std::map<Key, Entry>;
+
+  // Parsers only read integer and string args, and pointer args (channelz
+  // nodes, pools, ...) are most often per channel: leave them out, so that
+  // channels share their configs.
+  static ChannelArgs ArgsKey(const ChannelArgs& args) {
+    std::vector<std::pair<std::string, ChannelArgs::Value>> entries;
+    args.ForEach([&entries](const std::string& key,
+                            const ChannelArgs::Value& value) {
+      if (absl::holds_alternative<ChannelArgs::Pointer>(value)) return;
+      entries.emplace_back(key, value);
+    });
+    return ChannelArgs::FromEntries(std::move(entries));
+  }
+
+  Mutex mu_;
+  Entries entries_ ABSL_GUARDED_BY(mu_);
+  uint64_t uses_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+constexpr size_t ServiceConfigCache::kMaxEntries;
+
+}  // namespace
+
 absl::StatusOr<RefCountedPtr<ServiceConfig>> ServiceConfigImpl::Create(
     const ChannelArgs& args, absl::string_view json_string) {
+  if (IsServiceConfigCacheEnabled()) {
+    return ServiceConfigCache::Get()->GetOrParse(
+        args, json_string, [&]() { return Parse(args, json_string); });
+  }
+  return Parse(args, json_string);
+}
+
+absl::StatusOr<RefCountedPtr<ServiceConfig>> ServiceConfigImpl::Parse(
+    const ChannelArgs& args, absl::string_view json_string) {
   auto json = Json::Parse(json_string);
   if (!json.ok()) return json.status();
   absl::Status status;
@@ -54,7 +167,9 @@ absl::StatusOr<RefCountedPtr<ServiceConfig>> ServiceConfigImpl::Create(
 ServiceConfigImpl::ServiceConfigImpl(const ChannelArgs& args,
                                      std::string json_string, Json json,
                                      absl::Status* status)
-    : json_string_(std::move(json_string)), json_(std::move(json)) {
+    : id_(NextId()),
+      json_string_(std::move(json_string)),
+      json_(std::move(json)) {
   GPR_DEBUG_ASSERT(status != nullptr);
   if (json_.type() != Json::Type::OBJECT) {
     *status = absl::InvalidArgumentError("JSON value is not an object");
@@ -77,6 +192,15 @@ ServiceConfigImpl::ServiceConfigImpl(const ChannelArgs& args,
   }
 }
 
+uint32_t ServiceConfigImpl::NextId() {
+  static std::atomic<uint32_t> next_id{1};
+  uint32_t id;
+  do {
+    id = next_id.fetch_add(1, std::memory_order_relaxed);
+  } while (id == 0);  // 0 is what a registered method path starts with.
+  return id;
+}
+
 ServiceConfigImpl::~ServiceConfigImpl() {
   for (auto& p : parsed_method_configs_map_) {
     grpc_slice_unref(p.first);
@@ -218,16 +342,53 @@ ServiceConfigImpl::GetMethodParsedConfigVector(const grpc_slice& path) const {
   if (parsed_method_configs_map_.empty()) {
     return default_method_config_vector_;
   }
+  // The path of a registered method remembers what it was last mapped to.
+  RegisteredMethodPath* registered_path = RegisteredMethodPath::FromSlice(path);
+  if (registered_path != nullptr) {
+    const uint64_t cached =
+        registered_path->method_config_cache()->load(std::memory_order_relaxed);
+    if (cached >> 32 == id_) {
+      const uint32_t encoded = static_cast<uint32_t>(cached);
+      if (encoded == 0) return nullptr;
+      return parsed_method_config_vectors_storage_[encoded - 1].get();
+    }
+  }
+  const ServiceConfigParser::ParsedConfigVector* vector =
+      LookupMethodParsedConfigVector(path);
+  if (registered_path != nullptr) {
+    uint32_t encoded = 0;
+    if (vector != nullptr) {
+      // Done once per registered method and service config.
+      auto it = std::find_if(
+          parsed_method_config_vectors_storage_.begin(),
+          parsed_method_config_vectors_storage_.end(),
+          [vector](const std::unique_ptr<
+                   ServiceConfigParser::ParsedConfigVector>& stored) {
+            return stored.get() == vector;
+          });
+      encoded = static_cast<uint32_t>(
+          it - parsed_method_config_vectors_storage_.begin() + 1);
+    }
+    registered_path->method_config_cache()->store(
+        (static_cast<uint64_t>(id_) << 32) | encoded,
+        std::memory_order_relaxed);
+  }
+  return vector;
+}
+
+const ServiceConfigParser::ParsedConfigVector*
+ServiceConfigImpl::LookupMethodParsedConfigVector(
+    const grpc_slice& path) const {
   // Try looking up the full path in the map.
   auto it = parsed_method_configs_map_.find(path);
   if (it != parsed_method_configs_map_.end()) return it->second;
   // If we didn't find a match for the path, try looking for a wildcard
   // entry (i.e., change "/service/method" to "/service/").
-  UniquePtr<char> path_str(grpc_slice_to_c_string(path));
-  char* sep = strrchr(path_str.get(), '/');
-  if (sep == nullptr) return nullptr;  // Shouldn't ever happen.
-  sep[1] = '\0';
-  grpc_slice wildcard_path = grpc_slice_from_static_string(path_str.get());
+  absl::string_view path_str = StringViewFromSlice(path);
+  size_t sep = path_str.rfind('/');
+  if (sep == absl::string_view::npos) return nullptr;  // Shouldn't ever happen.
+  grpc_slice wildcard_path =
+      grpc_slice_from_static_buffer(path_str.data(), sep + 1);
   it = parsed_method_configs_map_.find(wildcard_path);
   if (it != parsed_method_configs_map_.end()) return it->second;
   // Try default method config, if set.
@@ -20,6 +20,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <string>
@@ -69,6 +70,8 @@ namespace grpc_core {
 class ServiceConfigImpl final : public ServiceConfig {
  public:
   /// Creates a new service config from parsing \a json_string.
+  /// With the service_config_cache experiment, a recent config parsed from
+  /// the same JSON and args is returned instead.
   static absl::StatusOr<RefCountedPtr<ServiceConfig>> Create(
       const ChannelArgs& args, absl::string_view json_string);
 
@@ -94,6 +97,15 @@ class ServiceConfigImpl final : public ServiceConfig {
       const grpc_slice& path) const override;
 
  private:
+  static absl::StatusOr<RefCountedPtr<ServiceConfig>> Parse(
+      const ChannelArgs& args, absl::string_view json_string);
+
+  // Returns a new id for a service config, which is never 0.
+  static uint32_t NextId();
+
+  const ServiceConfigParser::ParsedConfigVector* LookupMethodParsedConfigVector(
+      const grpc_slice& path) const;
+
   // Helper functions for parsing the method configs.
   absl::Status ParsePerMethodParams(const ChannelArgs& args);
   absl::Status ParseJsonMethodConfig(const ChannelArgs& args, const Json& json,
@@ -103,6 +115,9 @@ class ServiceConfigImpl final : public ServiceConfig {
   // Sets *error on error.
   static absl::StatusOr<std::string> ParseJsonMethodName(const Json& json);
 
+  // Tells the method configs cached in registered method paths by this
+  // config from those cached by others.
+  const uint32_t id_;
   std::string json_string_;
   Json json_;
 
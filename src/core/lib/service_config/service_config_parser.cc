@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 
+#include <atomic>
 #include <string>
 
 #include "absl/status/status.h"
@@ -30,6 +31,13 @@
 
 namespace grpc_core {
 
+ServiceConfigParser::ServiceConfigParser(
+    ServiceConfigParserList registered_parsers)
+    : registered_parsers_(std::move(registered_parsers)) {
+  static std::atomic<uint64_t> next_generation{1};
+  generation_ = next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 ServiceConfigParser ServiceConfigParser::Builder::Build() {
   return ServiceConfigParser(std::move(registered_parsers_));
 }
@@ -20,6 +20,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <memory>
@@ -46,6 +47,9 @@ class ServiceConfigParser {
   };
 
   /// This is the base class that all service config parsers should derive from.
+  /// The parsed configs must depend only on the JSON and on the integer and
+  /// string values in the channel args: ServiceConfigImpl::Create() shares
+  /// them between channels whose args differ only in pointer values.
   class Parser {
    public:
     virtual ~Parser() = default;
@@ -90,10 +94,15 @@ class ServiceConfigParser {
   // If there is an error, return -1.
   size_t GetParserIndex(absl::string_view name) const;
 
+  // Identifies this set of parsers for the lifetime of the process: configs
+  // parsed by different sets (e.g. before and after CoreConfiguration::Reset)
+  // are never mistaken for each other.
+  uint64_t generation() const { return generation_; }
+
  private:
-  explicit ServiceConfigParser(ServiceConfigParserList registered_parsers)
-      : registered_parsers_(std::move(registered_parsers)) {}
+  explicit ServiceConfigParser(ServiceConfigParserList registered_parsers);
   ServiceConfigParserList registered_parsers_;
+  uint64_t generation_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,220 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/slab_pool.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
+
+#ifdef GPR_LINUX
+#include <sys/mman.h>
+#endif
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_slab_pool_hugepages, false,
+    "Carve the recycled storage of read slices out of 2MB slabs backed by "
+    "transparent huge pages.");
+
+namespace grpc_core {
+
+constexpr size_t SlabPool::kHeaderSize;
+constexpr int SlabPool::kNumSizeClasses;
+constexpr size_t SlabPool::kPayloadSizes[];
+
+namespace {
+
+#if defined(GPR_LINUX) && defined(MADV_HUGEPAGE)
+constexpr bool kHugepagesSupported = true;
+#else
+constexpr bool kHugepagesSupported = false;
+#endif
+
+// Free blocks of each size class kept by each thread, and by all threads
+// together. Slabs back blocks of one size class only.
+constexpr size_t kThreadCacheBytes = 256 * 1024;
+constexpr size_t kSharedBytes = 8 * 1024 * 1024;
+constexpr size_t kSlabSize = 2 * 1024 * 1024;
+
+size_t MaxBlocks(int size_class, size_t bytes) {
+  return std::max<size_t>(1, bytes / SlabPool::BlockSize(size_class));
+}
+
+// Free blocks of one size class, linked through their first bytes.
+class FreeList {
+ public:
+  size_t count() const { return count_; }
+
+  void Push(void* block) {
+    auto* node = static_cast<Node*>(block);
+    node->next = head_;
+    head_ = node;
+    ++count_;
+  }
+
+  void* Pop() {
+    Node* node = head_;
+    if (node != nullptr) {
+      head_ = node->next;
+      --count_;
+    }
+    return node;
+  }
+
+ private:
+  struct Node {
+    Node* next;
+  };
+
+  Node* head_ = nullptr;
+  size_t count_ = 0;
+};
+
+// A 2MB aligned slab backed by huge pages, or nullptr.
+char* MapHugepageSlab() {
+#if defined(GPR_LINUX) && defined(MADV_HUGEPAGE)
+  // Huge pages must be aligned: map twice the size, and unmap the ends.
+  void* p = mmap(nullptr, 2 * kSlabSize, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return nullptr;
+  const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t slab = (start + kSlabSize - 1) & ~(kSlabSize - 1);
+  if (slab > start) munmap(p, slab - start);
+  munmap(reinterpret_cast<void*>(slab + kSlabSize),
+         start + kSlabSize - slab);
+  madvise(reinterpret_cast<void*>(slab), kSlabSize, MADV_HUGEPAGE);
+  return reinterpret_cast<char*>(slab);
+#else
+  return nullptr;
+#endif
+}
+
+// The free blocks shared by all threads, and where new blocks come from.
+class SharedPool {
+ public:
+  SharedPool()
+      : hugepages_(kHugepagesSupported &&
+                   GPR_GLOBAL_CONFIG_GET(grpc_slab_pool_hugepages)) {}
+
+  void* Alloc(int size_class) {
+    {
+      MutexLock lock(&mu_);
+      void* block = lists_[size_class].Pop();
+      if (block != nullptr) return block;
+    }
+    if (hugepages_) {
+      void* block = AllocFromNewSlab(size_class);
+      if (block != nullptr) return block;
+    }
+    new_blocks_.fetch_add(1, std::memory_order_relaxed);
+    return malloc(SlabPool::BlockSize(size_class));
+  }
+
+  // Takes all the blocks of list. Without huge pages, frees those past what
+  // the shared list keeps; blocks of slabs are always kept.
+  void Release(int size_class, FreeList* list) {
+    FreeList excess;
+    {
+      MutexLock lock(&mu_);
+      const size_t max_blocks = MaxBlocks(size_class, kSharedBytes);
+      while (void* block = list->Pop()) {
+        if (hugepages_ || lists_[size_class].count() < max_blocks) {
+          lists_[size_class].Push(block);
+        } else {
+          excess.Push(block);
+        }
+      }
+    }
+    while (void* block = excess.Pop()) free(block);
+  }
+
+  uint64_t new_blocks() const {
+    return new_blocks_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void* AllocFromNewSlab(int size_class) {
+    char* slab = MapHugepageSlab();
+    if (slab == nullptr) return nullptr;
+    const size_t block_size = SlabPool::BlockSize(size_class);
+    const size_t num_blocks = kSlabSize / block_size;
+    new_blocks_.fetch_add(num_blocks, std::memory_order_relaxed);
+    MutexLock lock(&mu_);
+    for (size_t i = 1; i < num_blocks; ++i) {
+      lists_[size_class].Push(slab + i * block_size);
+    }
+    return slab;
+  }
+
+  const bool hugepages_;
+  Mutex mu_;
+  FreeList lists_[SlabPool::kNumSizeClasses] ABSL_GUARDED_BY(mu_);
+  std::atomic<uint64_t> new_blocks_{0};
+};
+
+SharedPool* Shared() {
+  static NoDestruct<SharedPool> shared;
+  return shared.get();
+}
+
+// The free blocks of one thread, handed to the shared pool when the thread
+// exits.
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    for (int i = 0; i < SlabPool::kNumSizeClasses; ++i) {
+      Shared()->Release(i, &lists_[i]);
+    }
+  }
+
+  void* Alloc(int size_class) {
+    void* block = lists_[size_class].Pop();
+    return block != nullptr ? block : Shared()->Alloc(size_class);
+  }
+
+  void Free(int size_class, void* block) {
+    FreeList& list = lists_[size_class];
+    if (list.count() >= MaxBlocks(size_class, kThreadCacheBytes)) {
+      Shared()->Release(size_class, &list);
+    }
+    list.Push(block);
+  }
+
+ private:
+  FreeList lists_[SlabPool::kNumSizeClasses];
+};
+
+thread_local ThreadCache g_thread_cache;
+
+}  // namespace
+
+void* SlabPool::Alloc(int size_class) {
+  return g_thread_cache.Alloc(size_class);
+}
+
+void SlabPool::Free(int size_class, void* block) {
+  g_thread_cache.Free(size_class, block);
+}
+
+uint64_t SlabPool::TestOnlyNewBlocks() { return Shared()->new_blocks(); }
+
+}  // namespace grpc_core
@@ -0,0 +1,77 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SLICE_SLAB_POOL_H
+#define GRPC_CORE_LIB_SLICE_SLAB_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+
+// Whether the slab pool carves its blocks out of transparent huge pages.
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_slab_pool_hugepages);
+
+namespace grpc_core {
+
+// Recycles the storage of slices of the sizes transports read in: the 8KB
+// and 64KB chunks of the tcp_read_chunks experiment, and the 8KB staging
+// buffers of secure endpoints. As a connection streams, each read otherwise
+// mallocs a block that is freed as soon as the data was parsed.
+//
+// Freed blocks go to a cache of the freeing thread, then to a list shared by
+// all threads, and only then back to malloc. MemoryAllocator accounts blocks
+// in use against their memory quota like any other slice; the bounded
+// caches of free blocks are not accounted.
+//
+// With grpc_slab_pool_hugepages set, blocks are carved out of 2MB slabs
+// backed by transparent huge pages where the platform has them, which cuts
+// TLB misses when reading at high bandwidth. Slabs are never returned to the
+// system: free blocks of one are recycled only.
+class SlabPool {
+ public:
+  // Bytes of each block before its payload, for the header of the caller.
+  static constexpr size_t kHeaderSize = 64;
+  static constexpr int kNumSizeClasses = 2;
+
+  // The size class of exactly payload_size bytes of payload, or -1.
+  static int SizeClass(size_t payload_size) {
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+      if (kPayloadSizes[i] == payload_size) return i;
+    }
+    return -1;
+  }
+  static size_t BlockSize(int size_class) {
+    return kHeaderSize + kPayloadSizes[size_class];
+  }
+
+  // A block of BlockSize(size_class) bytes, aligned like malloc.
+  static void* Alloc(int size_class);
+  // Recycles a block that Alloc(size_class) returned.
+  static void Free(int size_class, void* block);
+
+  // Blocks allocated from malloc or slabs since the process started, rather
+  // than recycled.
+  static uint64_t TestOnlyNewBlocks();
+
+ private:
+  static constexpr size_t kPayloadSizes[kNumSizeClasses] = {8 * 1024,
+                                                            64 * 1024};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SLICE_SLAB_POOL_H
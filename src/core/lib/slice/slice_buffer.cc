@@ -57,10 +57,9 @@ Slice SliceBuffer::RefSlice(size_t index) const {
 std::string SliceBuffer::JoinIntoString() const {
   std::string result;
   result.reserve(slice_buffer_.length);
-  for (size_t i = 0; i < slice_buffer_.count; i++) {
-    result.append(reinterpret_cast<const char*>(
-                      GRPC_SLICE_START_PTR(slice_buffer_.slices[i])),
-                  GRPC_SLICE_LENGTH(slice_buffer_.slices[i]));
+  for (const grpc_slice& slice : c_slices()) {
+    result.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                  GRPC_SLICE_LENGTH(slice));
   }
   return result;
 }
@@ -77,8 +76,11 @@ std::string SliceBuffer::JoinIntoString() const {
 static void GPR_ATTRIBUTE_NOINLINE do_embiggen(grpc_slice_buffer* sb,
                                                const size_t slice_count,
                                                const size_t slice_offset) {
-  if (slice_offset != 0) {
-    /* Make room by moving elements if there's still space unused */
+  if (slice_offset >= sb->count) {
+    /* Make room by moving elements if at least half of the space is unused
+     * at the front, so that a buffer used as a queue (adding at the back of
+     * a full buffer, taking from the front) moves each slice a bounded number
+     * of times rather than once per slice added */
     memmove(sb->base_slices, sb->slices, sb->count * sizeof(grpc_slice));
     sb->slices = sb->base_slices;
   } else {
@@ -21,6 +21,8 @@
 
 #include <string>
 
+#include "absl/types/span.h"
+
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
 
@@ -107,8 +109,8 @@ class SliceBuffer {
   // Return a copy of the slice buffer
   SliceBuffer Copy() const {
     SliceBuffer copy;
-    for (size_t i = 0; i < Count(); i++) {
-      copy.Append(RefSlice(i));
+    for (const grpc_slice& slice : c_slices()) {
+      copy.Append(Slice(grpc_slice_ref(slice)));
     }
     return copy;
   }
@@ -123,6 +125,13 @@ class SliceBuffer {
     return slice_buffer_.slices[index];
   }
 
+  /// Return the slices held by the SliceBuffer, front to back, for iterating
+  /// over them without indexing.  Invalidated by any change to the buffer.
+  absl::Span<const grpc_slice> c_slices() const {
+    return absl::Span<const grpc_slice>(slice_buffer_.slices,
+                                        slice_buffer_.count);
+  }
+
  private:
   /// The backing raw slice buffer.
   grpc_slice_buffer slice_buffer_;
@@ -21,6 +21,8 @@
 
 #include <atomic>
 
+#include <grpc/support/log.h>
+
 // grpc_slice_refcount : A reference count for grpc_slice.
 struct grpc_slice_refcount {
  public:
@@ -40,21 +42,69 @@ struct grpc_slice_refcount {
   explicit grpc_slice_refcount(DestroyerFn destroyer_fn)
       : destroyer_fn_(destroyer_fn) {}
 
-  void Ref() { ref_.fetch_add(1, std::memory_order_relaxed); }
+  void Ref() {
+    if (confined_) {
+      ref_.store(ref_.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+      return;
+    }
+    ref_.fetch_add(1, std::memory_order_relaxed);
+  }
   void Unref() {
+    if (confined_) {
+      UnrefConfined();
+      return;
+    }
     if (ref_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       destroyer_fn_(this);
     }
   }
 
+  // If this is the only ref, confines the refcount to the calling thread
+  // and returns true: until Share() or UnrefAndShare(), refs are counted
+  // with plain loads and stores, so every Ref() and Unref() must come from
+  // that thread, or be ordered with its own by something like a combiner.
+  bool TryConfine() {
+    if (ref_.load(std::memory_order_acquire) != 1) return false;
+    confined_ = true;
+    return true;
+  }
+  // Ends the confinement, so that the refs taken meanwhile may be passed to
+  // other threads.  To be called by the thread the refcount is confined to,
+  // before its refs escape to other threads.
+  void Share() { confined_ = false; }
+  // Drops a ref of a confined refcount, and then Share()s it if refs are
+  // left.
+  void UnrefAndShare() {
+    GPR_DEBUG_ASSERT(confined_);
+    if (!UnrefConfined()) confined_ = false;
+  }
+  bool confined() const { return confined_; }
+
   // Is this the only instance?
   // For this to be useful the caller needs to ensure that if this is the only
   // instance, no other instance could be created during this call.
   bool IsUnique() const { return ref_.load(std::memory_order_relaxed) == 1; }
 
+  // The function called when the last ref is released, which tells what
+  // kind of refcount this is.
+  DestroyerFn destroyer_fn() const { return destroyer_fn_; }
+
  private:
+  // Returns true if the last ref was dropped.
+  bool UnrefConfined() {
+    const size_t refs = ref_.load(std::memory_order_relaxed);
+    if (refs == 1) {
+      destroyer_fn_(this);
+      return true;
+    }
+    ref_.store(refs - 1, std::memory_order_relaxed);
+    return false;
+  }
+
   std::atomic<size_t> ref_{1};
   DestroyerFn destroyer_fn_ = nullptr;
+  bool confined_ = false;
 };
 
 #endif  // GRPC_CORE_LIB_SLICE_SLICE_REFCOUNT_BASE_H
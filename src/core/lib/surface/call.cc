@@ -149,12 +149,18 @@ class Call : public CppImplOf<Call, grpc_call> {
   void set_send_deadline(Timestamp send_deadline) {
     send_deadline_ = send_deadline;
   }
+  void set_deadline_propagation_margin(Duration margin) {
+    deadline_propagation_margin_ = margin;
+  }
 
  private:
   Arena* const arena_;
   std::atomic<ParentCall*> parent_call_{nullptr};
   ChildCall* child_ = nullptr;
   Timestamp send_deadline_;
+  // Taken off send_deadline_ when it is propagated to child calls, leaving
+  // this call time to answer once they are done.
+  Duration deadline_propagation_margin_;
   const bool is_client_;
   // flag indicating that cancellation is inherited
   bool cancellation_is_inherited_ = false;
@@ -398,6 +404,9 @@ class FilterStackCall final : public Call {
 
   bool call_failed_before_recv_message_ = false;
   grpc_byte_buffer** receiving_buffer_ = nullptr;
+  // Where a recv_message op with GRPC_RECV_MESSAGE_PARTIAL reports whether
+  // the rest of the message follows.
+  int* receiving_partial_ = nullptr;
   grpc_slice receiving_slice_ = grpc_empty_slice();
   grpc_closure receiving_stream_ready_;
   grpc_closure receiving_initial_metadata_ready_;
@@ -469,7 +478,9 @@ absl::Status Call::InitParent(Call* parent, uint32_t propagation_mask) {
   GPR_ASSERT(!parent->is_client_);
 
   if (propagation_mask & GRPC_PROPAGATE_DEADLINE) {
-    send_deadline_ = std::min(send_deadline_, parent->send_deadline_);
+    send_deadline_ =
+        std::min(send_deadline_, parent->send_deadline_ -
+                                     parent->deadline_propagation_margin_);
   }
   /* for now GRPC_PROPAGATE_TRACING_CONTEXT *MUST* be passed with
    * GRPC_PROPAGATE_STATS_CONTEXT */
@@ -559,6 +570,10 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
     GRPC_STATS_INC_SERVER_CALLS_CREATED();
     call->final_op_.server.cancelled = nullptr;
     call->final_op_.server.core_server = args->server;
+    if (args->server != nullptr) {
+      call->set_deadline_propagation_margin(
+          args->server->deadline_propagation_margin());
+    }
   }
 
   Call* parent = Call::FromC(args->parent);
@@ -1118,10 +1133,15 @@ void FilterStackCall::BatchControl::ProcessDataAfterMetadata() {
   FilterStackCall* call = call_;
   if (!call->receiving_slice_buffer_.has_value()) {
     *call->receiving_buffer_ = nullptr;
+    if (call->receiving_partial_ != nullptr) *call->receiving_partial_ = 0;
     call->receiving_message_ = false;
     FinishStep();
   } else {
     call->test_only_last_message_flags_ = call->receiving_stream_flags_;
+    if (call->receiving_partial_ != nullptr) {
+      *call->receiving_partial_ =
+          (call->receiving_stream_flags_ & GRPC_RECV_INTERNAL_PARTIAL) != 0;
+    }
     if ((call->receiving_stream_flags_ & GRPC_WRITE_INTERNAL_COMPRESS) &&
         (call->incoming_compression_algorithm_ != GRPC_COMPRESS_NONE)) {
       *call->receiving_buffer_ = grpc_raw_compressed_byte_buffer_create(
@@ -1404,6 +1424,10 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
                   (op->flags &
                    GRPC_INITIAL_METADATA_WAIT_FOR_READY_EXPLICITLY_SET) != 0});
         }
+        if (is_client() &&
+            (op->flags & GRPC_INITIAL_METADATA_CACHEABLE_REQUEST) != 0) {
+          send_initial_metadata_.Set(CacheableRequest(), true);
+        }
         stream_op_payload->send_initial_metadata.send_initial_metadata =
             &send_initial_metadata_;
         if (is_client()) {
@@ -1565,8 +1589,8 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         break;
       }
       case GRPC_OP_RECV_MESSAGE: {
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
+        /* Flag validation: check that only receive message flags are set */
+        if ((op->flags & ~GRPC_RECV_MESSAGE_USED_MASK) != 0) {
           error = GRPC_CALL_ERROR_INVALID_FLAGS;
           goto done_with_error;
         }
@@ -1579,7 +1603,12 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         receiving_slice_buffer_.reset();
         receiving_buffer_ = op->data.recv_message.recv_message;
         stream_op_payload->recv_message.recv_message = &receiving_slice_buffer_;
+        receiving_partial_ = nullptr;
         receiving_stream_flags_ = 0;
+        if (op->flags & GRPC_RECV_MESSAGE_PARTIAL) {
+          receiving_partial_ = op->data.recv_message.partial;
+          receiving_stream_flags_ = GRPC_RECV_INTERNAL_ACCEPT_PARTIAL;
+        }
         stream_op_payload->recv_message.flags = &receiving_stream_flags_;
         stream_op_payload->recv_message.call_failed_before_recv_message =
             &call_failed_before_recv_message_;
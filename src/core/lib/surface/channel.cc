@@ -51,6 +51,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/service_config/registered_method_path.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/channel_init.h"
@@ -343,7 +344,7 @@ grpc_call* grpc_channel_create_pollset_set_call(
 namespace grpc_core {
 
 RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg) {
-  path = Slice::FromCopiedString(method_arg);
+  path = RegisteredMethodPath::Create(method_arg);
   if (host_arg != nullptr && host_arg[0] != 0) {
     authority = Slice::FromCopiedString(host_arg);
   }
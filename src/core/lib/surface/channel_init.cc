@@ -21,6 +21,12 @@
 #include "src/core/lib/surface/channel_init.h"
 
 #include <algorithm>
+#include <map>
+#include <utility>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/experiments/experiments.h"
 
 namespace grpc_core {
 
@@ -29,6 +35,14 @@ void ChannelInit::Builder::RegisterStage(grpc_channel_stack_type type,
   slots_[type].emplace_back(std::move(stage), priority);
 }
 
+void ChannelInit::Builder::RegisterFusedFilter(
+    grpc_channel_stack_type type,
+    std::vector<const grpc_channel_filter*> filters,
+    const grpc_channel_filter* fused) {
+  GPR_ASSERT(!filters.empty());
+  fusions_[type].push_back(Fusion{std::move(filters), fused});
+}
+
 ChannelInit ChannelInit::Builder::Build() {
   ChannelInit result;
   for (int i = 0; i < GRPC_NUM_CHANNEL_STACK_TYPES; i++) {
@@ -41,14 +55,75 @@ ChannelInit ChannelInit::Builder::Build() {
     for (auto& slot : slots) {
       result_slots.emplace_back(std::move(slot.stage));
     }
+    result.fusions_[i] = std::move(fusions_[i]);
   }
   return result;
 }
 
+bool ChannelInit::StackCache::Lookup(
+    grpc_channel_stack_type type, const ChannelArgs& args,
+    std::vector<const grpc_channel_filter*>* stack) {
+  MutexLock lock(&mu_);
+  auto it = entries_.find(Key(type, args));
+  if (it == entries_.end()) return false;
+  it->second.last_used = ++uses_;
+  *stack = it->second.stack;
+  return true;
+}
+
+void ChannelInit::StackCache::Insert(
+    grpc_channel_stack_type type, const ChannelArgs& args,
+    const std::vector<const grpc_channel_filter*>& stack) {
+  MutexLock lock(&mu_);
+  Key key(type, args);
+  if (entries_.size() >= kMaxEntries && entries_.count(key) == 0) {
+    entries_.erase(std::min_element(
+        entries_.begin(), entries_.end(),
+        [](const std::map<Key, Entry>::value_type& a,
+           const std::map<Key, Entry>::value_type& b) {
+          return a.second.last_used < b.second.last_used;
+        }));
+  }
+  Entry& entry = entries_[std::move(key)];
+  entry.stack = stack;
+  entry.last_used = ++uses_;
+}
+
 bool ChannelInit::CreateStack(ChannelStackBuilder* builder) const {
+  // Without a transport, the stages have nothing but the channel args to go
+  // by, so a stack built from the same args gets the same filters: a client
+  // creating many channels needs to run them only once.
+  if (!IsChannelStackCacheEnabled() || builder->transport() != nullptr ||
+      !builder->mutable_stack()->empty()) {
+    return RunStages(builder);
+  }
+  const grpc_channel_stack_type type = builder->channel_stack_type();
+  const ChannelArgs args = builder->channel_args();
+  if (stack_cache_->Lookup(type, args, builder->mutable_stack())) return true;
+  if (!RunStages(builder)) return false;
+  // A hit only replays the filters: stages that changed the args have done
+  // more than that.
+  if (builder->channel_args() == args) {
+    stack_cache_->Insert(type, args, *builder->mutable_stack());
+  }
+  return true;
+}
+
+bool ChannelInit::RunStages(ChannelStackBuilder* builder) const {
   for (const auto& stage : slots_[builder->channel_stack_type()]) {
     if (!stage(builder)) return false;
   }
+  if (IsFusedFiltersEnabled()) {
+    auto* stack = builder->mutable_stack();
+    for (const auto& fusion : fusions_[builder->channel_stack_type()]) {
+      auto run = stack->begin();
+      while ((run = std::search(run, stack->end(), fusion.filters.begin(),
+                                fusion.filters.end())) != stack->end()) {
+        run = stack->erase(run, run + fusion.filters.size());
+        run = stack->insert(run, fusion.fused) + 1;
+      }
+    }
+  }
   return true;
 }
 
@@ -21,11 +21,21 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <functional>
+#include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 #define GRPC_CHANNEL_INIT_BUILTIN_PRIORITY 10000
@@ -43,6 +53,12 @@ class ChannelInit {
   /// finally constructed channel stack
   using Stage = std::function<bool(ChannelStackBuilder* builder)>;
 
+  /// A run of filters, and the filter that replaces it.
+  struct Fusion {
+    std::vector<const grpc_channel_filter*> filters;
+    const grpc_channel_filter* fused;
+  };
+
   class Builder {
    public:
     /// Register one stage of mutators.
@@ -55,8 +71,19 @@ class ChannelInit {
     /// different channel args. This requires setting a channel arg in case the
     /// registration function relies on some condition other than channel args
     /// to decide whether to add a filter or not.
+    /// The same goes for stacks built without a transport: with the
+    /// channel_stack_cache experiment, their filter list is computed once per
+    /// distinct set of channel args and reused.
     void RegisterStage(grpc_channel_stack_type type, int priority, Stage stage);
 
+    /// Register \a fused as doing the work of the run of adjacent \a filters
+    /// (see FusedFilter in promise_based_filter.h).
+    /// When the fused_filters experiment is enabled, stacks of type \a type
+    /// that contain the run get \a fused in its place once all stages ran.
+    void RegisterFusedFilter(grpc_channel_stack_type type,
+                             std::vector<const grpc_channel_filter*> filters,
+                             const grpc_channel_filter* fused);
+
     /// Finalize registration. No more calls to grpc_channel_init_register_stage
     /// are allowed.
     ChannelInit Build();
@@ -69,6 +96,7 @@ class ChannelInit {
       int priority;
     };
     std::vector<Slot> slots_[GRPC_NUM_CHANNEL_STACK_TYPES];
+    std::vector<Fusion> fusions_[GRPC_NUM_CHANNEL_STACK_TYPES];
   };
 
   /// Construct a channel stack of some sort: see channel_stack.h for details
@@ -76,7 +104,34 @@ class ChannelInit {
   bool CreateStack(ChannelStackBuilder* builder) const;
 
  private:
+  // The filter lists of the most recently built stacks without a transport,
+  // by stack type and channel args.
+  class StackCache {
+   public:
+    bool Lookup(grpc_channel_stack_type type, const ChannelArgs& args,
+                std::vector<const grpc_channel_filter*>* stack);
+    void Insert(grpc_channel_stack_type type, const ChannelArgs& args,
+                const std::vector<const grpc_channel_filter*>& stack);
+
+   private:
+    static constexpr size_t kMaxEntries = 64;
+
+    struct Entry {
+      std::vector<const grpc_channel_filter*> stack;
+      uint64_t last_used;
+    };
+    using Key = std::pair<grpc_channel_stack_type, ChannelArgs>;
+
+    Mutex mu_;
+    std::map<Key, Entry> entries_ ABSL_GUARDED_BY(mu_);
+    uint64_t uses_ ABSL_GUARDED_BY(mu_) = 0;
+  };
+
+  bool RunStages(ChannelStackBuilder* builder) const;
+
   std::vector<Stage> slots_[GRPC_NUM_CHANNEL_STACK_TYPES];
+  std::vector<Fusion> fusions_[GRPC_NUM_CHANNEL_STACK_TYPES];
+  std::unique_ptr<StackCache> stack_cache_ = absl::make_unique<StackCache>();
 };
 
 }  // namespace grpc_core
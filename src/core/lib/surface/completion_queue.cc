@@ -21,6 +21,12 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#ifdef GPR_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include <algorithm>
 #include <atomic>
@@ -221,7 +227,8 @@ namespace {
 
 /* Queue that holds the cq_completion_events. Internally uses
  * MultiProducerSingleConsumerQueue (a lockfree multiproducer single consumer
- * queue). It uses a queue_lock to support multiple consumers.
+ * queue). It uses a queue_lock to support multiple consumers; PopBatch()
+ * takes that lock once for a whole batch of events.
  * Only used in completion queues whose completion_type is GRPC_CQ_NEXT */
 class CqEventQueue {
  public:
@@ -236,6 +243,9 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to max completions into out and returns how many were popped.
+   * Like Pop(), may return 0 even if the queue is not empty */
+  size_t PopBatch(grpc_cq_completion** out, size_t max);
 
  private:
   /* Spinlock to serialize consumers i.e pop() operations */
@@ -360,6 +370,11 @@ struct grpc_completion_queue {
 
   grpc_closure pollset_shutdown_done;
   int num_polls;
+
+  /** How long cq_next polls without blocking; 0 never busy polls */
+  int busy_poll_us;
+  /** CPU to pin threads calling cq_next to, or -1 */
+  int busy_poll_cpu;
 };
 
 /* Forward declarations */
@@ -486,29 +501,40 @@ bool CqEventQueue::Push(grpc_cq_completion* c) {
 
 grpc_cq_completion* CqEventQueue::Pop() {
   grpc_cq_completion* c = nullptr;
+  return PopBatch(&c, 1) == 1 ? c : nullptr;
+}
+
+size_t CqEventQueue::PopBatch(grpc_cq_completion** out, size_t max) {
+  size_t n = 0;
 
   if (gpr_spinlock_trylock(&queue_lock_)) {
     bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
+    while (n < max) {
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) break;
+      out[n++] = c;
+    }
     gpr_spinlock_unlock(&queue_lock_);
   }
 
-  if (c) {
-    num_queue_items_.fetch_sub(1, std::memory_order_relaxed);
+  if (n > 0) {
+    num_queue_items_.fetch_sub(n, std::memory_order_relaxed);
   }
 
-  return c;
+  return n;
 }
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_completion_queue_functor* shutdown_callback) {
+    grpc_completion_queue_functor* shutdown_callback, int busy_poll_us,
+    int busy_poll_cpu) {
   grpc_completion_queue* cq;
 
   GRPC_API_TRACE(
       "grpc_completion_queue_create_internal(completion_type=%d, "
-      "polling_type=%d)",
-      2, (completion_type, polling_type));
+      "polling_type=%d, busy_poll_us=%d, busy_poll_cpu=%d)",
+      4, (completion_type, polling_type, busy_poll_us, busy_poll_cpu));
 
   switch (completion_type) {
     case GRPC_CQ_NEXT:
@@ -534,6 +560,8 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
 
   cq->vtable = vtable;
   cq->poller_vtable = poller_vtable;
+  cq->busy_poll_us = std::max(busy_poll_us, 0);
+  cq->busy_poll_cpu = busy_poll_cpu;
 
   /* One for destroy(), one for pollset_shutdown */
   new (&cq->owning_refs) grpc_core::RefCount(2);
@@ -938,26 +966,80 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
-  grpc_event ret;
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+namespace {
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
+// The CPU this thread was pinned to by busy_poll_pin_thread(), or -1.
+thread_local int g_busy_poll_pinned_cpu = -1;
+
+void busy_poll_pin_thread(int cpu) {
+  if (cpu < 0 || g_busy_poll_pinned_cpu == cpu) return;
+  g_busy_poll_pinned_cpu = cpu;
+#ifdef GPR_LINUX
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (err != 0) {
+    gpr_log(GPR_ERROR, "Failed to pin completion queue thread to CPU %d: %s",
+            cpu, strerror(err));
+  }
+#else
+  gpr_log(GPR_ERROR,
+          "Pinning completion queue threads to a CPU is not supported on "
+          "this platform");
+#endif
+}
+
+}  // namespace
+
+/* Maximum number of completions taken from the queue per lock acquisition */
+constexpr size_t kCqPopBatchSize = 16;
+
+/* Fills ev from a popped completion and releases the completion */
+static void cq_completion_to_event(grpc_cq_completion* c, grpc_event* ev) {
+  ev->type = GRPC_OP_COMPLETE;
+  ev->success = c->next & 1u;
+  ev->tag = c->tag;
+  c->done(c->done_arg, c);
+}
+
+/* Pops up to max_events queued completions into events without polling.
+   Returns the number of events written */
+static size_t cq_pop_events(cq_next_data* cqd, grpc_event* events,
+                            size_t max_events) {
+  grpc_cq_completion* batch[kCqPopBatchSize];
+  size_t num_events = 0;
+  while (num_events < max_events) {
+    size_t want = std::min(max_events - num_events, kCqPopBatchSize);
+    size_t popped = cqd->queue.PopBatch(batch, want);
+    for (size_t i = 0; i < popped; i++) {
+      cq_completion_to_event(batch[i], &events[num_events++]);
+    }
+    if (popped < want) break;
+  }
+  return num_events;
+}
+
+/* Shared by grpc_completion_queue_next and grpc_completion_queue_next_batch:
+   waits for at least one event and returns up to max_events of them */
+static size_t cq_next_batch(grpc_completion_queue* cq, gpr_timespec deadline,
+                            grpc_event* events, size_t max_events) {
+  size_t num_events = 0;
+  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
 
+  // Until busy_poll_deadline the pollset is polled without blocking.
+  gpr_timespec busy_poll_deadline = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  busy_poll_pin_thread(cq->busy_poll_cpu);
+  if (cq->busy_poll_us > 0) {
+    busy_poll_deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_micros(cq->busy_poll_us, GPR_TIMESPAN));
+  }
+
   grpc_core::Timestamp deadline_millis =
       grpc_core::Timestamp::FromTimespecRoundUp(deadline);
   cq_is_finished_arg is_finished_arg = {
@@ -974,26 +1056,20 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_completion_to_event(c, &events[0]);
+      num_events = 1 + cq_pop_events(cqd, events + 1, max_events - 1);
       break;
     }
 
-    grpc_cq_completion* c = cqd->queue.Pop();
+    num_events = cq_pop_events(cqd, events, max_events);
 
-    if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+    if (num_events > 0) {
       break;
     } else {
-      /* If c == NULL it means either the queue is empty OR in an transient
-         inconsistent state. If it is the latter, we shold do a 0-timeout poll
-         so that the thread comes back quickly from poll to make a second
-         attempt at popping. Not doing this can potentially deadlock this
+      /* If nothing was popped it means either the queue is empty OR in an
+         transient inconsistent state. If it is the latter, we shold do a
+         0-timeout poll so that the thread comes back quickly from poll to make
+         a second attempt at popping. Not doing this can potentially deadlock this
          thread forever (if the deadline is infinity) */
       if (cqd->queue.num_items() > 0) {
         iteration_deadline = grpc_core::Timestamp::ProcessEpoch();
@@ -1013,19 +1089,26 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
         continue;
       }
 
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_SHUTDOWN;
+      events[0].success = 0;
+      num_events = 1;
       break;
     }
 
     if (!is_finished_arg.first_loop &&
         grpc_core::Timestamp::Now() >= deadline_millis) {
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_TIMEOUT;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
 
+    if (cq->busy_poll_us > 0 &&
+        gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), busy_poll_deadline) < 0) {
+      iteration_deadline = grpc_core::Timestamp::ProcessEpoch();
+    }
+
     /* The main polling work happens in grpc_pollset_work */
     gpr_mu_lock(cq->mu);
     cq->num_polls++;
@@ -1037,11 +1120,12 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       gpr_log(GPR_ERROR, "Completion queue next failed: %s",
               grpc_error_std_string(err).c_str());
       if (err == absl::CancelledError()) {
-        ret.type = GRPC_QUEUE_SHUTDOWN;
+        events[0].type = GRPC_QUEUE_SHUTDOWN;
       } else {
-        ret.type = GRPC_QUEUE_TIMEOUT;
+        events[0].type = GRPC_QUEUE_TIMEOUT;
       }
-      ret.success = 0;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
@@ -1055,11 +1139,31 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_batch(cq, deadline, &ret, 1);
   return ret;
 }
 
@@ -1110,6 +1214,27 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                        grpc_event* events, size_t max_events,
+                                        gpr_timespec deadline, void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, "
+      "events=%p, "
+      "max_events=%" PRIuPTR
+      ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+  GPR_ASSERT(max_events > 0);
+  return cq_next_batch(cq, deadline, events, max_events);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
@@ -93,8 +93,11 @@ grpc_cq_completion_type grpc_get_cq_completion_type(grpc_completion_queue* cq);
 
 int grpc_get_cq_poll_num(grpc_completion_queue* cq);
 
+/* busy_poll_us and busy_poll_cpu are the cq_busy_poll_us and cq_busy_poll_cpu
+   attributes; pass 0 and -1 for a completion queue that does not busy poll. */
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_completion_queue_functor* shutdown_callback);
+    grpc_completion_queue_functor* shutdown_callback, int busy_poll_us,
+    int busy_poll_cpu);
 
 #endif /* GRPC_CORE_LIB_SURFACE_COMPLETION_QUEUE_H */
@@ -33,8 +33,15 @@
 static grpc_completion_queue* default_create(
     const grpc_completion_queue_factory* /*factory*/,
     const grpc_completion_queue_attributes* attr) {
+  int busy_poll_us = 0;
+  int busy_poll_cpu = -1;
+  if (attr->version >= GRPC_CQ_VERSION_MINIMUM_FOR_BUSY_POLL) {
+    busy_poll_us = attr->cq_busy_poll_us;
+    if (attr->cq_busy_poll_pin_cpu) busy_poll_cpu = attr->cq_busy_poll_cpu;
+  }
   return grpc_completion_queue_create_internal(
-      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb);
+      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb,
+      busy_poll_us, busy_poll_cpu);
 }
 
 static grpc_completion_queue_factory_vtable default_vtable = {default_create};
@@ -63,16 +70,16 @@ const grpc_completion_queue_factory* grpc_completion_queue_factory_lookup(
 grpc_completion_queue* grpc_completion_queue_create_for_next(void* reserved) {
   grpc_core::ExecCtx exec_ctx;
   GPR_ASSERT(!reserved);
-  grpc_completion_queue_attributes attr = {1, GRPC_CQ_NEXT,
-                                           GRPC_CQ_DEFAULT_POLLING, nullptr};
+  grpc_completion_queue_attributes attr = {
+      1, GRPC_CQ_NEXT, GRPC_CQ_DEFAULT_POLLING, nullptr, 0, 0, 0};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
 grpc_completion_queue* grpc_completion_queue_create_for_pluck(void* reserved) {
   grpc_core::ExecCtx exec_ctx;
   GPR_ASSERT(!reserved);
-  grpc_completion_queue_attributes attr = {1, GRPC_CQ_PLUCK,
-                                           GRPC_CQ_DEFAULT_POLLING, nullptr};
+  grpc_completion_queue_attributes attr = {
+      1, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING, nullptr, 0, 0, 0};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
@@ -81,7 +88,7 @@ grpc_completion_queue* grpc_completion_queue_create_for_callback(
   grpc_core::ExecCtx exec_ctx;
   GPR_ASSERT(!reserved);
   grpc_completion_queue_attributes attr = {
-      2, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING, shutdown_callback};
+      2, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING, shutdown_callback, 0, 0, 0};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
@@ -33,8 +33,10 @@
 #include <grpc/support/time.h>
 
 #include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/ext/filters/http/client_authority_filter.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/event_engine/default_event_engine.h"
@@ -42,6 +44,8 @@
 #include "src/core/lib/event_engine/posix_engine/timer_manager.h"
 #include "src/core/lib/experiments/config.h"
 #include "src/core/lib/gprpp/fork.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/mutex_contention_profiler.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -62,6 +66,11 @@ void grpc_resolver_dns_ares_shutdown(void);
 
 #define MAX_PLUGINS 128
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_mutex_contention_sample_period, 0,
+    "If positive, sample contention on grpc_core::Mutex from init, timing one "
+    "in every this many acquisitions that find the mutex held.");
+
 static gpr_once g_basic_init = GPR_ONCE_INIT;
 static grpc_core::Mutex* g_init_mu;
 static int g_initializations ABSL_GUARDED_BY(g_init_mu) = []() {
@@ -98,6 +107,15 @@ static bool maybe_prepend_grpc_server_authz_filter(
 }
 
 namespace grpc_core {
+namespace {
+// The authority filter is always right above the client auth filter, when
+// there is one.
+const grpc_channel_filter kClientAuthorityAndAuthFilter =
+    MakePromiseBasedFilter<FusedFilter<ClientAuthorityFilter, ClientAuthFilter>,
+                           FilterEndpoint::kClient>(
+        "authority+client-auth-filter");
+}  // namespace
+
 void RegisterSecurityFilters(CoreConfiguration::Builder* builder) {
   // Register the auth client with a priority < INT_MAX to allow the authority
   // filter -on which the auth filter depends- to be higher on the channel
@@ -114,6 +132,12 @@ void RegisterSecurityFilters(CoreConfiguration::Builder* builder) {
   // depends on to be higher on the channel stack.
   builder->channel_init()->RegisterStage(
       GRPC_SERVER_CHANNEL, INT_MAX - 2, maybe_prepend_grpc_server_authz_filter);
+  for (grpc_channel_stack_type type :
+       {GRPC_CLIENT_SUBCHANNEL, GRPC_CLIENT_DIRECT_CHANNEL}) {
+    builder->channel_init()->RegisterFusedFilter(
+        type, {&ClientAuthorityFilter::kFilter, &ClientAuthFilter::kFilter},
+        &kClientAuthorityAndAuthFilter);
+  }
 }
 }  // namespace grpc_core
 
@@ -121,6 +145,11 @@ static void do_basic_init(void) {
   grpc_core::InitInternally = grpc_init;
   grpc_core::ShutdownInternally = grpc_shutdown;
   gpr_log_verbosity_init();
+  const int32_t contention_sample_period =
+      GPR_GLOBAL_CONFIG_GET(grpc_mutex_contention_sample_period);
+  if (contention_sample_period > 0) {
+    grpc_core::MutexContentionProfiler::Start(contention_sample_period);
+  }
   g_init_mu = new grpc_core::Mutex();
   g_shutting_down_cv = new grpc_core::CondVar();
   gpr_time_init();
@@ -156,8 +185,10 @@ void grpc_shutdown_internal_locked(void)
     grpc_iomgr_shutdown_background_closure();
     grpc_timer_manager_set_threading(false);  // shutdown timer_manager thread
     grpc_resolver_dns_ares_shutdown();
-    grpc_event_engine::experimental::ResetDefaultEventEngine();
     grpc_iomgr_shutdown();
+    // Only once iomgr is down, as the executor may run closures on the
+    // default EventEngine until then.
+    grpc_event_engine::experimental::ResetDefaultEventEngine();
   }
   g_shutting_down = false;
   g_shutting_down_cv->SignalAll();
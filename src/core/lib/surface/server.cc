@@ -30,6 +30,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/types/optional.h"
@@ -50,6 +51,7 @@
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/call.h"
@@ -101,6 +103,9 @@ struct Server::RequestedCall {
   grpc_completion_queue* const cq_bound_to_call;
   grpc_call** const call;
   grpc_cq_completion completion;
+  // Set for requests allocated in the arena of the call they match, which
+  // outlives the completion.
+  bool in_call_arena = false;
   grpc_metadata_array* const initial_metadata;
   union {
     struct {
@@ -194,10 +199,23 @@ class Server::RequestMatcherInterface {
 // application to explicitly request RPCs and then matching those to incoming
 // RPCs, along with a slow path by which incoming RPCs are put on a locked
 // pending list if they aren't able to be matched to an application request.
+// Pending calls are sharded like the request queues, one shard per
+// completion queue, so that matching calls on different CQs does not
+// serialize on a server-wide lock. A call waits in the shard of the CQ it
+// arrived on; a request that finds no pending call in its own shard steals
+// from the others.
+//
+// A call must never be left pending while a request that could take it is
+// queued. MatchOrQueue() announces a call in num_pending_ before its final
+// look at the request queues, and RequestCallWithPossiblePublish() looks at
+// num_pending_ after queueing a request. With a full fence on both sides at
+// least one of them sees the other.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
   explicit RealRequestMatcher(Server* server)
-      : server_(server), requests_per_cq_(server->cqs_.size()) {}
+      : server_(server),
+        requests_per_cq_(server->cqs_.size()),
+        pending_per_cq_(server->cqs_.size()) {}
 
   ~RealRequestMatcher() override {
     for (LockedMultiProducerSingleConsumerQueue& queue : requests_per_cq_) {
@@ -206,11 +224,15 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   }
 
   void ZombifyPending() override {
-    while (!pending_.empty()) {
-      CallData* calld = pending_.front();
-      calld->SetState(CallData::CallState::ZOMBIED);
-      calld->KillZombie();
-      pending_.pop();
+    for (PendingShard& shard : pending_per_cq_) {
+      MutexLock lock(&shard.mu);
+      while (!shard.calls.empty()) {
+        CallData* calld = shard.calls.front();
+        calld->SetState(CallData::CallState::ZOMBIED);
+        calld->KillZombie();
+        shard.calls.pop();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      }
     }
   }
 
@@ -230,30 +252,60 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
 
   void RequestCallWithPossiblePublish(size_t request_queue_index,
                                       RequestedCall* call) override {
-    if (requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
-      /* this was the first queued request: we need to lock and start
-         matching calls */
-      struct PendingCall {
-        RequestedCall* rc = nullptr;
-        CallData* calld;
-      };
-      auto pop_next_pending = [this, request_queue_index] {
-        PendingCall pending_call;
-        {
-          MutexLock lock(&server_->mu_call_);
-          if (!pending_.empty()) {
-            pending_call.rc = reinterpret_cast<RequestedCall*>(
-                requests_per_cq_[request_queue_index].Pop());
-            if (pending_call.rc != nullptr) {
-              pending_call.calld = pending_.front();
-              pending_.pop();
-            }
-          }
+    if (!requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
+      // Whoever queued the first request is matching pending calls.
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_pending_.load(std::memory_order_relaxed) == 0) return;
+    // This was the first queued request: match pending calls, starting with
+    // our own shard and then stealing from the others.
+    struct PendingCall {
+      RequestedCall* rc = nullptr;
+      CallData* calld;
+      bool out_of_requests = false;
+      // Calls that waited until they ran out of time, taken off the shard
+      // without using up a request.
+      std::vector<CallData*> out_of_time;
+    };
+    auto pop_next_pending = [this, request_queue_index](PendingShard* shard) {
+      PendingCall pending_call;
+      MutexLock lock(&shard->mu);
+      while (!shard->calls.empty() && shard->calls.front()->OutOfTime()) {
+        pending_call.out_of_time.push_back(shard->calls.front());
+        shard->calls.pop();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      if (!shard->calls.empty()) {
+        pending_call.rc = reinterpret_cast<RequestedCall*>(
+            requests_per_cq_[request_queue_index].Pop());
+        if (pending_call.rc != nullptr) {
+          pending_call.calld = shard->calls.front();
+          shard->calls.pop();
+          num_pending_.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+          pending_call.out_of_requests = true;
         }
-        return pending_call;
-      };
+      }
+      return pending_call;
+    };
+    for (size_t i = 0; i < pending_per_cq_.size(); i++) {
+      PendingShard* shard =
+          &pending_per_cq_[(request_queue_index + i) % pending_per_cq_.size()];
       while (true) {
-        PendingCall next_pending = pop_next_pending();
+        PendingCall next_pending = pop_next_pending(shard);
+        for (CallData* calld : next_pending.out_of_time) {
+          if (!calld->MaybeActivate()) {
+            // Zombied Call
+            calld->KillZombie();
+          } else {
+            calld->FailOutOfTime();
+          }
+        }
+        if (next_pending.out_of_requests) {
+          // The next request queued will match whatever is still pending.
+          return;
+        }
         if (next_pending.rc == nullptr) break;
         if (!next_pending.calld->MaybeActivate()) {
           // Zombied Call
@@ -277,16 +329,20 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
         return;
       }
     }
-    // No cq to take the request found; queue it on the slow list.
-    // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
-    // an empty request queue, it will block until the call is actually
-    // added to the pending list.
+    // No cq to take the request found; queue it on the slow list of our
+    // shard. We need to ensure that all the queues are empty. We do this
+    // under the shard lock after announcing the call in num_pending_, so
+    // that a request added to an empty queue will either be seen here or
+    // will look for this call once it is on the pending list.
     RequestedCall* rc = nullptr;
     size_t cq_idx = 0;
     size_t loop_count;
     {
-      MutexLock lock(&server_->mu_call_);
+      PendingShard& shard =
+          pending_per_cq_[start_request_queue_index % pending_per_cq_.size()];
+      MutexLock lock(&shard.mu);
+      num_pending_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
       for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
         cq_idx =
             (start_request_queue_index + loop_count) % requests_per_cq_.size();
@@ -297,9 +353,10 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       }
       if (rc == nullptr) {
         calld->SetState(CallData::CallState::PENDING);
-        pending_.push(calld);
+        shard.calls.push(calld);
         return;
       }
+      num_pending_.fetch_sub(1, std::memory_order_relaxed);
     }
     calld->SetState(CallData::CallState::ACTIVATED);
     calld->Publish(cq_idx, rc);
@@ -308,9 +365,17 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   Server* server() const override { return server_; }
 
  private:
+  struct PendingShard {
+    Mutex mu;
+    std::queue<CallData*> calls ABSL_GUARDED_BY(mu);
+  };
+
   Server* const server_;
-  std::queue<CallData*> pending_;
   std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
+  std::vector<PendingShard> pending_per_cq_;
+  // Number of calls in all shards of pending_per_cq_, plus calls that are
+  // about to be added.
+  std::atomic<size_t> num_pending_{0};
 };
 
 // AllocatingRequestMatchers don't allow the application to request an RPC in
@@ -364,20 +429,24 @@ class Server::AllocatingRequestMatcherBatch
     : public AllocatingRequestMatcherBase {
  public:
   AllocatingRequestMatcherBatch(Server* server, grpc_completion_queue* cq,
-                                std::function<BatchCallAllocation()> allocator)
+                                std::function<BatchCallAllocation(grpc_call*)> allocator)
       : AllocatingRequestMatcherBase(server, cq),
         allocator_(std::move(allocator)) {}
 
   void MatchOrQueue(size_t /*start_request_queue_index*/,
                     CallData* calld) override {
     if (server()->ShutdownRefOnRequest()) {
-      BatchCallAllocation call_info = allocator_();
+      BatchCallAllocation call_info = allocator_(calld->call());
       GPR_ASSERT(server()->ValidateServerRequest(
                      cq(), static_cast<void*>(call_info.tag), nullptr,
                      nullptr) == GRPC_CALL_OK);
-      RequestedCall* rc = new RequestedCall(
-          static_cast<void*>(call_info.tag), call_info.cq, call_info.call,
-          call_info.initial_metadata, call_info.details);
+      RequestedCall* rc =
+          grpc_call_get_arena(calld->call())
+              ->New<RequestedCall>(
+                  static_cast<void*>(call_info.tag), call_info.cq,
+                  call_info.call, call_info.initial_metadata,
+                  call_info.details);
+      rc->in_call_arena = true;
       calld->SetState(CallData::CallState::ACTIVATED);
       calld->Publish(cq_idx(), rc);
     } else {
@@ -387,7 +456,7 @@ class Server::AllocatingRequestMatcherBatch
   }
 
  private:
-  std::function<BatchCallAllocation()> allocator_;
+  std::function<BatchCallAllocation(grpc_call*)> allocator_;
 };
 
 // An allocating request matcher for registered methods.
@@ -396,7 +465,7 @@ class Server::AllocatingRequestMatcherRegistered
  public:
   AllocatingRequestMatcherRegistered(
       Server* server, grpc_completion_queue* cq, RegisteredMethod* rm,
-      std::function<RegisteredCallAllocation()> allocator)
+      std::function<RegisteredCallAllocation(grpc_call*)> allocator)
       : AllocatingRequestMatcherBase(server, cq),
         registered_method_(rm),
         allocator_(std::move(allocator)) {}
@@ -404,14 +473,17 @@ class Server::AllocatingRequestMatcherRegistered
   void MatchOrQueue(size_t /*start_request_queue_index*/,
                     CallData* calld) override {
     if (server()->ShutdownRefOnRequest()) {
-      RegisteredCallAllocation call_info = allocator_();
+      RegisteredCallAllocation call_info = allocator_(calld->call());
       GPR_ASSERT(server()->ValidateServerRequest(
                      cq(), call_info.tag, call_info.optional_payload,
                      registered_method_) == GRPC_CALL_OK);
       RequestedCall* rc =
-          new RequestedCall(call_info.tag, call_info.cq, call_info.call,
-                            call_info.initial_metadata, registered_method_,
-                            call_info.deadline, call_info.optional_payload);
+          grpc_call_get_arena(calld->call())
+              ->New<RequestedCall>(call_info.tag, call_info.cq, call_info.call,
+                                   call_info.initial_metadata,
+                                   registered_method_, call_info.deadline,
+                                   call_info.optional_payload);
+      rc->in_call_arena = true;
       calld->SetState(CallData::CallState::ACTIVATED);
       calld->Publish(cq_idx(), rc);
     } else {
@@ -422,7 +494,7 @@ class Server::AllocatingRequestMatcherRegistered
 
  private:
   RegisteredMethod* const registered_method_;
-  std::function<RegisteredCallAllocation()> allocator_;
+  std::function<RegisteredCallAllocation(grpc_call*)> allocator_;
 };
 
 //
@@ -529,7 +601,18 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(
 }  // namespace
 
 Server::Server(const ChannelArgs& args)
-    : channel_args_(args), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args),
+      min_deadline_budget_(
+          std::max(args.GetDurationFromIntMillis(
+                            GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS)
+                       .value_or(Duration::Zero()),
+                   Duration::Zero())),
+      deadline_propagation_margin_(
+          std::max(args.GetDurationFromIntMillis(
+                            GRPC_ARG_SERVER_DEADLINE_PROPAGATION_MARGIN_MS)
+                       .value_or(Duration::Zero()),
+                   Duration::Zero())),
+      channelz_node_(CreateChannelzNode(args)) {}
 
 Server::~Server() {
   // Remove the cq pollsets from the config_fetcher.
@@ -631,14 +714,14 @@ bool Server::HasOpenConnections() {
 
 void Server::SetRegisteredMethodAllocator(
     grpc_completion_queue* cq, void* method_tag,
-    std::function<RegisteredCallAllocation()> allocator) {
+    std::function<RegisteredCallAllocation(grpc_call*)> allocator) {
   RegisteredMethod* rm = static_cast<RegisteredMethod*>(method_tag);
   rm->matcher = absl::make_unique<AllocatingRequestMatcherRegistered>(
       this, cq, rm, std::move(allocator));
 }
 
 void Server::SetBatchMethodAllocator(
-    grpc_completion_queue* cq, std::function<BatchCallAllocation()> allocator) {
+    grpc_completion_queue* cq, std::function<BatchCallAllocation(grpc_call*)> allocator) {
   GPR_DEBUG_ASSERT(unregistered_request_matcher_ == nullptr);
   unregistered_request_matcher_ =
       absl::make_unique<AllocatingRequestMatcherBatch>(this, cq,
@@ -689,7 +772,12 @@ Server::RegisteredMethod* Server::RegisterMethod(
 }
 
 void Server::DoneRequestEvent(void* req, grpc_cq_completion* /*c*/) {
-  delete static_cast<RequestedCall*>(req);
+  RequestedCall* rc = static_cast<RequestedCall*>(req);
+  if (rc->in_call_arena) {
+    rc->~RequestedCall();
+  } else {
+    delete rc;
+  }
 }
 
 void Server::FailCall(size_t cq_idx, RequestedCall* rc,
@@ -1208,6 +1296,19 @@ void Server::CallData::FailCallCreation() {
   }
 }
 
+bool Server::CallData::OutOfTime() const {
+  return server_->min_deadline_budget_ > Duration::Zero() &&
+         deadline_ != Timestamp::InfFuture() &&
+         deadline_ - Timestamp::Now() < server_->min_deadline_budget_;
+}
+
+void Server::CallData::FailOutOfTime() {
+  state_.store(CallState::ZOMBIED, std::memory_order_relaxed);
+  grpc_call_cancel_with_status(call_, GRPC_STATUS_DEADLINE_EXCEEDED,
+                               "Too little time left to handle call", nullptr);
+  KillZombie();
+}
+
 void Server::CallData::Start(grpc_call_element* elem) {
   grpc_op op;
   op.op = GRPC_OP_RECV_INITIAL_METADATA;
@@ -1261,6 +1362,10 @@ void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
     calld->KillZombie();
     return;
   }
+  if (calld->OutOfTime()) {
+    calld->FailOutOfTime();
+    return;
+  }
   rm->MatchOrQueue(chand->cq_idx(), calld);
 }
 
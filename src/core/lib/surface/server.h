@@ -131,6 +131,11 @@ class Server : public InternallyRefCounted<Server>,
   const ChannelArgs& channel_args() const { return channel_args_; }
   channelz::ServerNode* channelz_node() const { return channelz_node_.get(); }
 
+  // Taken off the deadlines the server's calls propagate to their children.
+  Duration deadline_propagation_margin() const {
+    return deadline_propagation_margin_;
+  }
+
   // Do not call this before Start(). Returns the pollsets. The
   // vector itself is immutable, but the pollsets inside are mutable. The
   // result is valid for the lifetime of the server.
@@ -166,12 +171,15 @@ class Server : public InternallyRefCounted<Server>,
   void RegisterCompletionQueue(grpc_completion_queue* cq);
 
   // Functions to specify that a specific registered method or the unregistered
-  // collection should use a specific allocator for request matching.
+  // collection should use a specific allocator for request matching. The
+  // allocator is passed the new call, so that it can place its state in the
+  // call's arena.
   void SetRegisteredMethodAllocator(
       grpc_completion_queue* cq, void* method_tag,
-      std::function<RegisteredCallAllocation()> allocator);
-  void SetBatchMethodAllocator(grpc_completion_queue* cq,
-                               std::function<BatchCallAllocation()> allocator);
+      std::function<RegisteredCallAllocation(grpc_call* call)> allocator);
+  void SetBatchMethodAllocator(
+      grpc_completion_queue* cq,
+      std::function<BatchCallAllocation(grpc_call* call)> allocator);
 
   RegisteredMethod* RegisterMethod(
       const char* method, const char* host,
@@ -296,6 +304,15 @@ class Server : public InternallyRefCounted<Server>,
 
     void FailCallCreation();
 
+    // Whether the call is too close to its deadline to be worth publishing.
+    bool OutOfTime() const;
+
+    // Fails a call that is OutOfTime() with DEADLINE_EXCEEDED instead of
+    // publishing it.
+    void FailOutOfTime();
+
+    grpc_call* call() const { return call_; }
+
     // Filter vtable functions.
     static grpc_error_handle InitCallElement(
         grpc_call_element* elem, const grpc_call_element_args* args);
@@ -442,6 +459,10 @@ class Server : public InternallyRefCounted<Server>,
   }
 
   ChannelArgs const channel_args_;
+  // See GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS.
+  const Duration min_deadline_budget_;
+  // See GRPC_ARG_SERVER_DEADLINE_PROPAGATION_MARGIN_MS.
+  const Duration deadline_propagation_margin_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
@@ -37,6 +37,8 @@ BdpEstimator::BdpEstimator(const char* name)
       inter_ping_delay_(Duration::Milliseconds(100)),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
+      min_rtt_(Duration::Zero()),
+      last_rtt_(Duration::Zero()),
       name_(name) {}
 
 Timestamp BdpEstimator::CompletePing() {
@@ -54,7 +56,11 @@ Timestamp BdpEstimator::CompletePing() {
             bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
-  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
+  Duration rtt = Duration::FromTimespec(dt_ts);
+  if (min_rtt_ == Duration::Zero() || rtt < min_rtt_) min_rtt_ = rtt;
+  last_rtt_ = rtt;
+  estimate_growing_ = accumulator_ > 2 * estimate_ / 3 && bw > bw_est_;
+  if (estimate_growing_) {
     estimate_ = std::max(accumulator_, estimate_ * 2);
     bw_est_ = bw;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
@@ -41,6 +41,15 @@ class BdpEstimator {
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  // The shortest round trip time of the pings so far, or zero before the
+  // first one completes.
+  Duration MinRtt() const { return min_rtt_; }
+  // The round trip time of the last ping, or zero before the first one
+  // completes.
+  Duration LastRtt() const { return last_rtt_; }
+  // Whether the last ping increased the estimate, i.e. the BDP is probably
+  // still larger than the estimate.
+  bool EstimateGrowing() const { return estimate_growing_; }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -86,6 +95,9 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  Duration min_rtt_;
+  Duration last_rtt_;
+  bool estimate_growing_ = false;
   const char* name_;
 };
 
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <vector>
 
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
@@ -34,21 +35,37 @@ void DebugStringBuilder::Add(absl::string_view key, absl::string_view value) {
   absl::StrAppend(&out_, absl::CEscape(key), ": ", absl::CEscape(value));
 }
 
+constexpr size_t UnknownMap::kInlineEntries;
+
 void UnknownMap::Append(absl::string_view key, Slice value) {
-  unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+  EmplaceBack(Slice::FromCopiedString(key), std::move(value));
+}
+
+void UnknownMap::Append(Slice key, Slice value) {
+  EmplaceBack(std::move(key), std::move(value));
 }
 
 void UnknownMap::Remove(absl::string_view key) {
-  unknown_.SetEnd(std::remove_if(unknown_.begin(), unknown_.end(),
-                                 [key](const std::pair<Slice, Slice>& p) {
-                                   return p.first.as_string_view() == key;
-                                 }));
+  auto matches = [key](const Entry& p) {
+    return p.first.as_string_view() == key;
+  };
+  if (std::none_of(begin(), end(), matches)) return;
+  // Rare enough to rebuild the map from the entries kept.
+  std::vector<Entry> kept;
+  for (size_t i = 0; i < inline_count_; i++) {
+    if (!matches(*inline_[i])) kept.push_back(std::move(*inline_[i]));
+  }
+  for (auto& p : overflow_) {
+    if (!matches(p)) kept.push_back(std::move(p));
+  }
+  Clear();
+  for (auto& p : kept) EmplaceBack(std::move(p.first), std::move(p.second));
 }
 
 absl::optional<absl::string_view> UnknownMap::GetStringValue(
     absl::string_view key, std::string* backing) const {
   absl::optional<absl::string_view> out;
-  for (const auto& p : unknown_) {
+  for (const auto& p : *this) {
     if (p.first.as_string_view() == key) {
       if (!out.has_value()) {
         out = p.second.as_string_view();
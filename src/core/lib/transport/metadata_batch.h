@@ -23,7 +23,9 @@
 
 #include <stdlib.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -40,6 +42,7 @@
 
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gprpp/chunked_vector.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/packed_table.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/arena.h"
@@ -251,6 +254,13 @@ struct GrpcTagsBinMetadata : public SimpleSliceBasedMetadata {
   static absl::string_view key() { return "grpc-tags-bin"; }
 };
 
+// grpc-compression-dictionary metadata trait: names the dictionary that the
+// zstd or lz4 compressed messages of a call were compressed with.
+struct GrpcCompressionDictionaryMetadata : public SimpleSliceBasedMetadata {
+  static constexpr bool kRepeatable = false;
+  static absl::string_view key() { return "grpc-compression-dictionary"; }
+};
+
 // :authority metadata trait.
 struct HttpAuthorityMetadata : public SimpleSliceBasedMetadata {
   static constexpr bool kRepeatable = false;
@@ -302,6 +312,18 @@ struct GrpcPreviousRpcAttemptsMetadata
   static absl::string_view key() { return "grpc-previous-rpc-attempts"; }
 };
 
+// grpc-write-weight metadata trait.
+// The weight of the call when it shares its HTTP/2 connection with other calls
+// writing data: the connection is shared between them in proportion to their
+// weights, from 1 to 256 (16 by default). Set by the client, and applies to
+// the writes of both ends of the call.
+struct GrpcWriteWeightMetadata : public SimpleIntBasedMetadata<uint32_t, 0> {
+  static constexpr bool kRepeatable = false;
+  static constexpr uint32_t kDefaultWeight = 16;
+  static constexpr uint32_t kMaxWeight = 256;
+  static absl::string_view key() { return "grpc-write-weight"; }
+};
+
 // grpc-retry-pushback-ms metadata trait.
 struct GrpcRetryPushbackMsMetadata {
   static constexpr bool kRepeatable = false;
@@ -398,6 +420,15 @@ struct WaitForReady {
   static std::string DisplayValue(ValueType x);
 };
 
+// Annotation added by client surface code to mark requests whose responses
+// may be served from a cache
+struct CacheableRequest {
+  using ValueType = bool;
+  static absl::string_view DebugKey() { return "CacheableRequest"; }
+  static constexpr bool kRepeatable = false;
+  static absl::string_view DisplayValue(bool x) { return x ? "true" : "false"; }
+};
+
 namespace metadata_detail {
 
 // Build a key/value formatted debug string.
@@ -492,6 +523,13 @@ class ParseHelper {
       : value_(std::move(value)),
         on_error_(on_error),
         transport_size_(transport_size) {}
+  // key holds the key being parsed, for NotFound to take rather than copy.
+  ParseHelper(Slice* key, Slice value, MetadataParseErrorFn on_error,
+              size_t transport_size)
+      : key_(key),
+        value_(std::move(value)),
+        on_error_(on_error),
+        transport_size_(transport_size) {}
 
   template <typename Trait>
   GPR_ATTRIBUTE_NOINLINE ParsedMetadata<Container> Found(Trait trait) {
@@ -503,6 +541,9 @@ class ParseHelper {
 
   GPR_ATTRIBUTE_NOINLINE ParsedMetadata<Container> NotFound(
       absl::string_view key) {
+    if (key_ != nullptr) {
+      return ParsedMetadata<Container>(std::move(*key_), std::move(value_));
+    }
     return ParsedMetadata<Container>(Slice::FromCopiedString(key),
                                      std::move(value_));
   }
@@ -513,11 +554,105 @@ class ParseHelper {
     return parse_memento(std::move(value_), on_error_);
   }
 
+  Slice* const key_ = nullptr;
   Slice value_;
   MetadataParseErrorFn on_error_;
   const size_t transport_size_;
 };
 
+// Maps the keys of Traits to their ParseHelper::Found method with a single
+// probe of a hash table, where NameLookup compares a key with each trait's in
+// turn: MetadataMap::Parse runs for every literal key HPACK decodes, and
+// grpc_metadata_batch has a few dozen traits.
+//
+// Trait keys are not constexpr, so the table is built on first use, by
+// searching for a hash seed that gives each key a slot of its own (a
+// perfect hash). Should there be none, lookups fall back to NameLookup.
+template <typename Container, typename... Traits>
+class KeyLookupTable {
+ public:
+  static const KeyLookupTable& Get() {
+    static const KeyLookupTable* table = new KeyLookupTable();
+    return *table;
+  }
+
+  ParsedMetadata<Container> Lookup(absl::string_view key,
+                                   ParseHelper<Container>* helper) const {
+    if (GPR_UNLIKELY(seed_ == 0 || key.empty())) {
+      return NameLookup<void, Traits...>::Lookup(key, helper);
+    }
+    const Entry& entry = slots_[Slot(key, seed_)];
+    if (entry.found != nullptr && entry.key == key) return entry.found(helper);
+    return helper->NotFound(key);
+  }
+
+ private:
+  using FoundFn = ParsedMetadata<Container> (*)(ParseHelper<Container>*);
+  struct Entry {
+    absl::string_view key;
+    FoundFn found = nullptr;
+  };
+  static constexpr int kSlotBits = 7;
+  static constexpr size_t kSlots = size_t{1} << kSlotBits;
+  static constexpr uint32_t kMaxSeedAttempts = 4096;
+
+  // Hashes the length and three characters of key (which is not empty).
+  static size_t Slot(absl::string_view key, uint32_t seed) {
+    auto byte = [key](size_t i) -> uint32_t {
+      return static_cast<uint8_t>(key[i]);
+    };
+    const uint32_t h = static_cast<uint32_t>(key.size()) ^ (byte(0) << 8) ^
+                       (byte(key.size() / 2) << 16) ^
+                       (byte(key.size() - 1) << 24);
+    return (h * seed) >> (32 - kSlotBits);
+  }
+
+  template <typename Trait>
+  static absl::enable_if_t<IsEncodableTrait<Trait>::value, void> AddTrait(
+      Entry** next) {
+    **next = Entry{Trait::key(), [](ParseHelper<Container>* helper) {
+                     return helper->Found(Trait());
+                   }};
+    ++*next;
+  }
+
+  template <typename Trait>
+  static absl::enable_if_t<!IsEncodableTrait<Trait>::value, void> AddTrait(
+      Entry**) {}
+
+  KeyLookupTable() {
+    Entry entries[sizeof...(Traits) + 1];
+    Entry* end = entries;
+    int unused[] = {0, (AddTrait<Traits>(&end), 0)...};
+    (void)unused;
+    for (uint32_t attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+      // Odd multipliers, spread over the 32 bits.
+      const uint32_t seed = 0x9e3779b1u + 2 * attempt * 0x85ebca6bu;
+      if (Fill(entries, end, seed)) {
+        seed_ = seed;
+        return;
+      }
+    }
+  }
+
+  bool Fill(const Entry* begin, const Entry* end, uint32_t seed) {
+    for (Entry& slot : slots_) slot = Entry();
+    for (const Entry* entry = begin; entry != end; ++entry) {
+      Entry& slot = slots_[Slot(entry->key, seed)];
+      if (slot.found != nullptr) {
+        // Of two traits with the same key, NameLookup finds the first.
+        if (slot.key == entry->key) continue;
+        return false;
+      }
+      slot = *entry;
+    }
+    return true;
+  }
+
+  Entry slots_[kSlots];
+  uint32_t seed_ = 0;
+};
+
 // This is an "Op" type for NameLookup.
 // Used for MetadataMap::Append, its Found/NotFound methods turn a slice into
 // a value and add it to a container.
@@ -816,7 +951,7 @@ class CopySink {
   }
 
   void Encode(const Slice& key, const Slice& value) {
-    dst_->unknown_.Append(key.as_string_view(), value.Ref());
+    dst_->unknown_.Append(key.Ref(), value.Ref());
   }
 
  private:
@@ -886,26 +1021,115 @@ class TransportSizeEncoder {
 // Handle unknown (non-trait-based) fields in the metadata map.
 class UnknownMap {
  public:
-  explicit UnknownMap(Arena* arena) : unknown_(arena) {}
+  using Entry = std::pair<Slice, Slice>;
 
-  using BackingType = ChunkedVector<std::pair<Slice, Slice>, 10>;
+  explicit UnknownMap(Arena* arena) : overflow_(arena) {}
+  UnknownMap(UnknownMap&& other) noexcept : overflow_(other.arena()) {
+    MoveFrom(&other);
+  }
+  UnknownMap& operator=(UnknownMap&& other) noexcept {
+    Clear();
+    MoveFrom(&other);
+    return *this;
+  }
+  ~UnknownMap() { ClearInline(); }
 
   void Append(absl::string_view key, Slice value);
+  // As above, for a key already in a slice.
+  void Append(Slice key, Slice value);
   void Remove(absl::string_view key);
   absl::optional<absl::string_view> GetStringValue(absl::string_view key,
                                                    std::string* backing) const;
 
-  BackingType::ConstForwardIterator begin() const { return unknown_.cbegin(); }
-  BackingType::ConstForwardIterator end() const { return unknown_.cend(); }
+  // Forward-only iterator, over the inline entries and then the overflow.
+  class ConstForwardIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Entry;
+    using pointer = const Entry*;
+    using reference = const Entry&;
+
+    const Entry& operator*() const {
+      if (n_ < map_->inline_count_) return *map_->inline_[n_];
+      return *overflow_;
+    }
+    const Entry* operator->() const { return &**this; }
+    ConstForwardIterator& operator++() {
+      if (n_ < map_->inline_count_) {
+        ++n_;
+      } else {
+        ++overflow_;
+      }
+      return *this;
+    }
+    bool operator==(const ConstForwardIterator& other) const {
+      return n_ == other.n_ && overflow_ == other.overflow_;
+    }
+    bool operator!=(const ConstForwardIterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class UnknownMap;
+    using Overflow = ChunkedVector<Entry, 10>::ConstForwardIterator;
+
+    ConstForwardIterator(const UnknownMap* map, size_t n, Overflow overflow)
+        : map_(map), n_(n), overflow_(overflow) {}
+
+    const UnknownMap* map_;
+    size_t n_;
+    Overflow overflow_;
+  };
+
+  ConstForwardIterator begin() const {
+    return ConstForwardIterator(this, 0, overflow_.cbegin());
+  }
+  ConstForwardIterator end() const {
+    return ConstForwardIterator(this, inline_count_, overflow_.cend());
+  }
 
-  bool empty() const { return unknown_.empty(); }
-  size_t size() const { return unknown_.size(); }
-  void Clear() { unknown_.Clear(); }
-  Arena* arena() const { return unknown_.arena(); }
+  bool empty() const { return inline_count_ == 0; }
+  size_t size() const {
+    if (inline_count_ < kInlineEntries) return inline_count_;
+    return inline_count_ + overflow_.size();
+  }
+  void Clear() {
+    ClearInline();
+    overflow_.Clear();
+  }
+  Arena* arena() const { return overflow_.arena(); }
 
  private:
-  // Backing store for added metadata.
-  ChunkedVector<std::pair<Slice, Slice>, 10> unknown_;
+  // Most calls carry a handful of unknown headers: those are kept in the map
+  // itself, and only the ones after them are allocated from the arena.
+  // Entries are appended to overflow_ only once the inline ones are full.
+  static constexpr size_t kInlineEntries = 4;
+
+  void EmplaceBack(Slice key, Slice value) {
+    if (inline_count_ < kInlineEntries) {
+      inline_[inline_count_++].Init(std::move(key), std::move(value));
+    } else {
+      overflow_.EmplaceBack(std::move(key), std::move(value));
+    }
+  }
+  void ClearInline() {
+    for (size_t i = 0; i < inline_count_; i++) inline_[i].Destroy();
+    inline_count_ = 0;
+  }
+  void MoveFrom(UnknownMap* other) {
+    for (size_t i = 0; i < other->inline_count_; i++) {
+      inline_[i].Init(std::move(*other->inline_[i]));
+    }
+    inline_count_ = other->inline_count_;
+    other->ClearInline();
+    overflow_ = std::move(other->overflow_);
+  }
+
+  ManualConstructor<Entry> inline_[kInlineEntries];
+  size_t inline_count_ = 0;
+  // Backing store for added metadata beyond the inline entries.
+  ChunkedVector<Entry, 10> overflow_;
 };
 
 }  // namespace metadata_detail
@@ -1191,13 +1415,30 @@ class MetadataMap {
                                        MetadataParseErrorFn on_error) {
     metadata_detail::ParseHelper<Derived> helper(value.TakeOwned(), on_error,
                                                  transport_size);
-    return metadata_detail::NameLookup<void, Traits...>::Lookup(key, &helper);
+    return metadata_detail::KeyLookupTable<Derived, Traits...>::Get().Lookup(
+        key, &helper);
+  }
+
+  // As above, for a key already in a slice: should the key be unknown, the
+  // result references that slice rather than a copy of the key.
+  static ParsedMetadata<Derived> Parse(Slice key, Slice value,
+                                       uint32_t transport_size,
+                                       MetadataParseErrorFn on_error) {
+    Slice owned_key = key.TakeOwned();
+    metadata_detail::ParseHelper<Derived> helper(&owned_key, value.TakeOwned(),
+                                                 on_error, transport_size);
+    return metadata_detail::KeyLookupTable<Derived, Traits...>::Get().Lookup(
+        owned_key.as_string_view(), &helper);
   }
 
   // Set a value from a parsed metadata object.
   void Set(const ParsedMetadata<Derived>& m) {
     m.SetOnContainer(static_cast<Derived*>(this));
   }
+  // As above, moving the value out of m rather than copying it.
+  void Set(ParsedMetadata<Derived>&& m) {
+    m.MoveToContainer(static_cast<Derived*>(this));
+  }
 
   // Append a key/value pair - takes ownership of value
   void Append(absl::string_view key, Slice value,
@@ -1291,9 +1532,11 @@ using grpc_metadata_batch_base = grpc_core::MetadataMap<
     // Non-colon prefixed headers begin here
     grpc_core::ContentTypeMetadata, grpc_core::TeMetadata,
     grpc_core::GrpcEncodingMetadata, grpc_core::GrpcInternalEncodingRequest,
-    grpc_core::GrpcAcceptEncodingMetadata, grpc_core::GrpcStatusMetadata,
+    grpc_core::GrpcAcceptEncodingMetadata,
+    grpc_core::GrpcCompressionDictionaryMetadata, grpc_core::GrpcStatusMetadata,
     grpc_core::GrpcTimeoutMetadata, grpc_core::GrpcPreviousRpcAttemptsMetadata,
-    grpc_core::GrpcRetryPushbackMsMetadata, grpc_core::UserAgentMetadata,
+    grpc_core::GrpcRetryPushbackMsMetadata,
+    grpc_core::GrpcWriteWeightMetadata, grpc_core::UserAgentMetadata,
     grpc_core::GrpcMessageMetadata, grpc_core::HostMetadata,
     grpc_core::EndpointLoadMetricsBinMetadata,
     grpc_core::GrpcServerStatsBinMetadata, grpc_core::GrpcTraceBinMetadata,
@@ -1301,7 +1544,8 @@ using grpc_metadata_batch_base = grpc_core::MetadataMap<
     grpc_core::LbCostBinMetadata, grpc_core::LbTokenMetadata,
     // Non-encodable things
     grpc_core::GrpcStreamNetworkState, grpc_core::PeerString,
-    grpc_core::GrpcStatusContext, grpc_core::WaitForReady>;
+    grpc_core::GrpcStatusContext, grpc_core::WaitForReady,
+    grpc_core::CacheableRequest>;
 
 struct grpc_metadata_batch : public grpc_metadata_batch_base {
   using grpc_metadata_batch_base::grpc_metadata_batch_base;
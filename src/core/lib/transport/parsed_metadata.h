@@ -106,6 +106,12 @@ void SetSliceValue(Slice* set, const Buffer& value) {
   *set = MementoToValue(SliceFromBuffer(value));
 }
 
+// Set a slice value in a container, taking the reference of the Buffer.
+template <Slice (*MementoToValue)(Slice)>
+void MoveSliceValue(Slice* set, const Buffer& value) {
+  *set = MementoToValue(Slice(value.slice));
+}
+
 }  // namespace metadata_detail
 
 // A parsed metadata value.
@@ -180,6 +186,12 @@ class ParsedMetadata {
   void SetOnContainer(MetadataContainer* container) const {
     vtable_->set(value_, container);
   }
+  // Move this parsed value to a container, leaving this empty: the value is
+  // handed over rather than copied (or ref'd) and then destroyed.
+  void MoveToContainer(MetadataContainer* container) {
+    vtable_->move_to(value_, container);
+    vtable_ = EmptyVTable();
+  }
 
   // Is this a binary header or not?
   bool is_binary_header() const { return vtable_->is_binary_header; }
@@ -216,6 +228,8 @@ class ParsedMetadata {
     const bool is_binary_header;
     void (*const destroy)(const Buffer& value);
     void (*const set)(const Buffer& value, MetadataContainer* container);
+    // As set, but takes ownership of value: it is not destroyed afterwards.
+    void (*const move_to)(const Buffer& value, MetadataContainer* container);
     // result is a bitwise copy of the originating ParsedMetadata.
     void (*const with_new_value)(Slice* new_value,
                                  MetadataParseErrorFn on_error,
@@ -265,6 +279,8 @@ ParsedMetadata<MetadataContainer>::EmptyVTable() {
       metadata_detail::DestroyTrivialMemento,
       // set
       [](const Buffer&, MetadataContainer*) {},
+      // move_to
+      [](const Buffer&, MetadataContainer*) {},
       // with_new_value
       [](Slice*, MetadataParseErrorFn, ParsedMetadata*) {},
       // debug_string
@@ -280,18 +296,21 @@ template <typename MetadataContainer>
 template <typename Which>
 const typename ParsedMetadata<MetadataContainer>::VTable*
 ParsedMetadata<MetadataContainer>::TrivialTraitVTable() {
+  static const auto set = [](const Buffer& value, MetadataContainer* map) {
+    map->Set(
+        Which(),
+        Which::MementoToValue(
+            metadata_detail::FieldFromTrivial<typename Which::MementoType>(
+                value)));
+  };
   static const VTable vtable = {
       absl::EndsWith(Which::key(), "-bin"),
       // destroy
       metadata_detail::DestroyTrivialMemento,
       // set
-      [](const Buffer& value, MetadataContainer* map) {
-        map->Set(
-            Which(),
-            Which::MementoToValue(
-                metadata_detail::FieldFromTrivial<typename Which::MementoType>(
-                    value)));
-      },
+      set,
+      // move_to: there is nothing to release
+      set,
       // with_new_value
       WithNewValueSetTrivial<typename Which::MementoType, Which::ParseMemento>,
       // debug_string
@@ -323,6 +342,12 @@ ParsedMetadata<MetadataContainer>::NonTrivialTraitVTable() {
         auto* p = static_cast<typename Which::MementoType*>(value.pointer);
         map->Set(Which(), Which::MementoToValue(*p));
       },
+      // move_to
+      [](const Buffer& value, MetadataContainer* map) {
+        auto* p = static_cast<typename Which::MementoType*>(value.pointer);
+        map->Set(Which(), Which::MementoToValue(std::move(*p)));
+        delete p;
+      },
       // with_new_value
       [](Slice* value, MetadataParseErrorFn on_error, ParsedMetadata* result) {
         result->value_.pointer = new typename Which::MementoType(
@@ -355,6 +380,11 @@ ParsedMetadata<MetadataContainer>::SliceTraitVTable() {
         metadata_detail::SetSliceValue<Which::MementoToValue>(
             map->GetOrCreatePointer(Which()), value);
       },
+      // move_to
+      [](const Buffer& value, MetadataContainer* map) {
+        metadata_detail::MoveSliceValue<Which::MementoToValue>(
+            map->GetOrCreatePointer(Which()), value);
+      },
       // with_new_value
       WithNewValueSetSlice<Which::ParseMemento>,
       // debug_string
@@ -379,7 +409,12 @@ ParsedMetadata<MetadataContainer>::KeyValueVTable(absl::string_view key) {
   };
   static const auto set = [](const Buffer& value, MetadataContainer* map) {
     auto* p = static_cast<KV*>(value.pointer);
-    map->unknown_.Append(p->first.as_string_view(), p->second.Ref());
+    map->unknown_.Append(p->first.Ref(), p->second.Ref());
+  };
+  static const auto move_to = [](const Buffer& value, MetadataContainer* map) {
+    auto* p = static_cast<KV*>(value.pointer);
+    map->unknown_.Append(std::move(p->first), std::move(p->second));
+    delete p;
   };
   static const auto with_new_value = [](Slice* value, MetadataParseErrorFn,
                                         ParsedMetadata* result) {
@@ -398,8 +433,8 @@ ParsedMetadata<MetadataContainer>::KeyValueVTable(absl::string_view key) {
     return static_cast<KV*>(value.pointer)->first.as_string_view();
   };
   static const VTable vtable[2] = {
-      {false, destroy, set, with_new_value, debug_string, "", key_fn},
-      {true, destroy, set, with_new_value, debug_string, "", key_fn},
+      {false, destroy, set, move_to, with_new_value, debug_string, "", key_fn},
+      {true, destroy, set, move_to, with_new_value, debug_string, "", key_fn},
   };
   return &vtable[absl::EndsWith(key, "-bin")];
 }
@@ -24,6 +24,8 @@
 
 #include <new>
 
+#include <grpc/support/time.h>
+
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor.h"
@@ -87,6 +89,11 @@ void grpc_transport_move_stats(grpc_transport_stream_stats* from,
                                grpc_transport_stream_stats* to) {
   grpc_transport_move_one_way_stats(&from->incoming, &to->incoming);
   grpc_transport_move_one_way_stats(&from->outgoing, &to->outgoing);
+  if (gpr_time_cmp(to->first_byte_written,
+                   gpr_inf_past(GPR_CLOCK_MONOTONIC)) == 0) {
+    to->first_byte_written = from->first_byte_written;
+  }
+  from->first_byte_written = gpr_inf_past(GPR_CLOCK_MONOTONIC);
 }
 
 size_t grpc_transport_stream_size(grpc_transport* transport) {
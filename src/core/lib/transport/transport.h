@@ -37,6 +37,7 @@
 #include <grpc/status.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/debug/trace.h"
@@ -79,6 +80,13 @@ struct grpc_transport_stream_op_batch_payload;
 /** Mask of all valid internal flags. */
 #define GRPC_WRITE_INTERNAL_USED_MASK \
   (GRPC_WRITE_INTERNAL_COMPRESS | GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED)
+/** Internal bit flag set in the \a flags of a recv_message op before it is
+ * started, to let the transport complete it with the part of an uncompressed
+ * message received so far. Transports that do not support it ignore it. */
+#define GRPC_RECV_INTERNAL_ACCEPT_PARTIAL (0x20000000u)
+/** Internal bit flag set by the transport in the \a flags of a recv_message op
+ * completed with part of a message, when the rest of the message follows. */
+#define GRPC_RECV_INTERNAL_PARTIAL (0x10000000u)
 
 namespace grpc_core {
 // TODO(ctiller): eliminate once MetadataHandle is constructable directly.
@@ -248,6 +256,9 @@ struct grpc_transport_one_way_stats {
 struct grpc_transport_stream_stats {
   grpc_transport_one_way_stats incoming;
   grpc_transport_one_way_stats outgoing;
+  // When the transport started writing the first bytes of the stream, or
+  // gpr_inf_past() if it did not (or does not track it).
+  gpr_timespec first_byte_written = gpr_inf_past(GPR_CLOCK_MONOTONIC);
 };
 
 void grpc_transport_move_one_way_stats(grpc_transport_one_way_stats* from,
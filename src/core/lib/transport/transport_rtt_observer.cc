@@ -0,0 +1,40 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/transport_rtt_observer.h"
+
+namespace grpc_core {
+
+void TransportRttObserver::AddWatcher(WatcherInterface* watcher) {
+  MutexLock lock(&mu_);
+  watchers_.insert(watcher);
+}
+
+void TransportRttObserver::RemoveWatcher(WatcherInterface* watcher) {
+  MutexLock lock(&mu_);
+  watchers_.erase(watcher);
+}
+
+void TransportRttObserver::OnRttSample(Duration rtt) {
+  MutexLock lock(&mu_);
+  for (WatcherInterface* watcher : watchers_) {
+    watcher->OnRttSample(rtt);
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,72 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_TRANSPORT_TRANSPORT_RTT_OBSERVER_H
+#define GRPC_CORE_LIB_TRANSPORT_TRANSPORT_RTT_OBSERVER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <set>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+#define GRPC_ARG_TRANSPORT_RTT_OBSERVER "grpc.internal.transport_rtt_observer"
+
+namespace grpc_core {
+
+// Passes the round trip times that a transport measures on its connection,
+// such as those of the chttp2 BDP pings, to the watchers registered with it.
+// A subchannel hands one to the transports it creates through channel args,
+// so that LB policies can watch the RTT of the subchannel's connections.
+class TransportRttObserver : public RefCounted<TransportRttObserver> {
+ public:
+  class WatcherInterface {
+   public:
+    virtual ~WatcherInterface() = default;
+
+    // Called from the transport with the observer's lock held, so this
+    // must be quick and must not call back into the observer.
+    virtual void OnRttSample(Duration rtt) = 0;
+  };
+
+  static absl::string_view ChannelArgName() {
+    return GRPC_ARG_TRANSPORT_RTT_OBSERVER;
+  }
+  static int ChannelArgsCompare(const TransportRttObserver* a,
+                                const TransportRttObserver* b) {
+    return QsortCompare(a, b);
+  }
+
+  void AddWatcher(WatcherInterface* watcher);
+  void RemoveWatcher(WatcherInterface* watcher);
+
+  // Called by the transport for each RTT it measures.
+  void OnRttSample(Duration rtt);
+
+ private:
+  Mutex mu_;
+  std::set<WatcherInterface*> watchers_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_TRANSPORT_TRANSPORT_RTT_OBSERVER_H
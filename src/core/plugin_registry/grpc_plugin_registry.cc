@@ -20,6 +20,7 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/ext/transport/shm/shm_handshaker.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/surface/builtins.h"
 #include "src/core/lib/transport/http_connect_handshaker.h"
@@ -33,10 +34,12 @@ extern void SecurityRegisterHandshakerFactories(
     CoreConfiguration::Builder* builder);
 extern void RegisterClientAuthorityFilter(CoreConfiguration::Builder* builder);
 extern void RegisterChannelIdleFilters(CoreConfiguration::Builder* builder);
+extern void RegisterConcurrencyLimitFilter(CoreConfiguration::Builder* builder);
 extern void RegisterDeadlineFilter(CoreConfiguration::Builder* builder);
 extern void RegisterGrpcLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterHttpFilters(CoreConfiguration::Builder* builder);
 extern void RegisterMessageSizeFilter(CoreConfiguration::Builder* builder);
+extern void RegisterResponseCacheFilter(CoreConfiguration::Builder* builder);
 extern void RegisterSecurityFilters(CoreConfiguration::Builder* builder);
 extern void RegisterServiceConfigChannelArgFilter(
     CoreConfiguration::Builder* builder);
@@ -54,6 +57,11 @@ extern void RegisterWeightedTargetLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterPickFirstLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterRoundRobinLbPolicy(CoreConfiguration::Builder* builder);
 extern void RegisterRingHashLbPolicy(CoreConfiguration::Builder* builder);
+extern void RegisterMaglevLbPolicy(CoreConfiguration::Builder* builder);
+extern void RegisterLeastRequestLbPolicy(CoreConfiguration::Builder* builder);
+extern void RegisterPeakEwmaLbPolicy(CoreConfiguration::Builder* builder);
+extern void RegisterWeightedRoundRobinLbPolicy(
+    CoreConfiguration::Builder* builder);
 extern void RegisterHttpProxyMapper(CoreConfiguration::Builder* builder);
 #ifndef GRPC_NO_RLS
 extern void RegisterRlsLbPolicy(CoreConfiguration::Builder* builder);
@@ -65,23 +73,32 @@ extern void RegisterBinderResolver(CoreConfiguration::Builder* builder);
 void BuildCoreConfiguration(CoreConfiguration::Builder* builder) {
   // The order of the handshaker registration is crucial here.
   // We want TCP connect handshaker to be registered last so that it is added to
-  // the start of the handshaker list.
+  // the start of the handshaker list. The shared-memory handshaker is added to
+  // the end of the list, and must be registered before the security
+  // handshakers so that they run over the shared-memory endpoint.
   RegisterHttpConnectHandshaker(builder);
   RegisterTCPConnectHandshaker(builder);
+  RegisterShmHandshaker(builder);
   RegisterPriorityLbPolicy(builder);
   RegisterOutlierDetectionLbPolicy(builder);
   RegisterWeightedTargetLbPolicy(builder);
   RegisterPickFirstLbPolicy(builder);
   RegisterRoundRobinLbPolicy(builder);
   RegisterRingHashLbPolicy(builder);
+  RegisterMaglevLbPolicy(builder);
+  RegisterLeastRequestLbPolicy(builder);
+  RegisterPeakEwmaLbPolicy(builder);
+  RegisterWeightedRoundRobinLbPolicy(builder);
   BuildClientChannelConfiguration(builder);
   SecurityRegisterHandshakerFactories(builder);
   RegisterClientAuthorityFilter(builder);
   RegisterChannelIdleFilters(builder);
+  RegisterConcurrencyLimitFilter(builder);
   RegisterGrpcLbPolicy(builder);
   RegisterHttpFilters(builder);
   RegisterDeadlineFilter(builder);
   RegisterMessageSizeFilter(builder);
+  RegisterResponseCacheFilter(builder);
   RegisterServiceConfigChannelArgFilter(builder);
   RegisterResourceQuota(builder);
   FaultInjectionFilterRegister(builder);
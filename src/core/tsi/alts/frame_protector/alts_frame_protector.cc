@@ -324,8 +324,14 @@ static void alts_destroy(tsi_frame_protector* self) {
   }
 }
 
+/* Seal and unseal use their own crypter, frame writer/reader and buffer.  */
+static bool alts_is_full_duplex(const tsi_frame_protector* /*self*/) {
+  return true;
+}
+
 static const tsi_frame_protector_vtable alts_frame_protector_vtable = {
-    alts_protect, alts_protect_flush, alts_unprotect, alts_destroy};
+    alts_protect, alts_protect_flush, alts_unprotect, alts_destroy,
+    alts_is_full_duplex};
 
 static grpc_status_code create_alts_crypters(const uint8_t* key,
                                              size_t key_size, bool is_client,
@@ -20,6 +20,7 @@
 
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 
+#include <algorithm>
 #include <list>
 
 #include "upb/upb.hpp"
@@ -28,6 +29,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/call.h"
@@ -38,6 +40,12 @@
 
 #define TSI_ALTS_INITIAL_BUFFER_SIZE 256
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_max_concurrent_handshakes, 40,
+    "Max number of ALTS handshakes, of each of the client and server sides, "
+    "that are in progress with the handshaker service at any time. Further "
+    "handshakes are queued.");
+
 const int kHandshakerClientOpNum = 4;
 
 struct alts_handshaker_client {
@@ -285,6 +293,7 @@ void alts_handshaker_client_handle_response(alts_handshaker_client* c,
     alts_tsi_handshaker_result_set_unused_bytes(
         result, &client->recv_bytes,
         grpc_gcp_HandshakerResp_bytes_consumed(resp));
+    alts_tsi_handshaker_save_session(handshaker, result);
   }
   grpc_status_code code = static_cast<grpc_status_code>(
       grpc_gcp_HandshakerStatus_code(resp_status));
@@ -418,7 +427,8 @@ HandshakeQueue* g_client_handshake_queue;
 HandshakeQueue* g_server_handshake_queue;
 
 void DoHandshakeQueuesInit(void) {
-  const size_t per_queue_max_outstanding_handshakes = 40;
+  const size_t per_queue_max_outstanding_handshakes = std::max(
+      1, GPR_GLOBAL_CONFIG_GET(grpc_alts_max_concurrent_handshakes));
   g_client_handshake_queue =
       new HandshakeQueue(per_queue_max_outstanding_handshakes);
   g_server_handshake_queue =
@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/alts/handshaker/alts_session_cache.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_session_cache_size, 0,
+    "Number of ALTS sessions to remember for session resumption; 0 disables "
+    "resumption. Enable it on both clients and servers.");
+
+namespace tsi {
+
+void AltsSession::DeriveSecret(absl::string_view key_data) {
+  uint8_t derived[kAltsResumptionSecretLength];
+  AltsResumptionDerive(key_data, "resumption secret", "", derived,
+                       sizeof(derived));
+  secret.assign(reinterpret_cast<char*>(derived), sizeof(derived));
+  uint8_t derived_ticket[kAltsResumptionTicketLength];
+  AltsResumptionDerive(key_data, "resumption ticket", "", derived_ticket,
+                       sizeof(derived_ticket));
+  ticket.assign(reinterpret_cast<char*>(derived_ticket),
+                sizeof(derived_ticket));
+}
+
+void AltsResumptionDerive(absl::string_view secret, absl::string_view label,
+                          absl::string_view context, uint8_t* out,
+                          size_t out_length) {
+  uint8_t block[EVP_MAX_MD_SIZE];
+  unsigned int block_length = 0;
+  std::string input;
+  for (uint8_t counter = 1; out_length > 0; ++counter) {
+    input.assign(reinterpret_cast<char*>(block), block_length);
+    input.append(label.data(), label.size());
+    input.append(context.data(), context.size());
+    input.push_back(static_cast<char>(counter));
+    GPR_ASSERT(HMAC(EVP_sha256(), secret.data(), secret.size(),
+                    reinterpret_cast<const uint8_t*>(input.data()),
+                    input.size(), block, &block_length) != nullptr);
+    const size_t n = std::min<size_t>(block_length, out_length);
+    memcpy(out, block, n);
+    out += n;
+    out_length -= n;
+  }
+}
+
+grpc_core::RefCountedPtr<AltsSessionCache> AltsSessionCache::Default() {
+  static AltsSessionCache* cache = []() -> AltsSessionCache* {
+    const int32_t capacity =
+        GPR_GLOBAL_CONFIG_GET(grpc_alts_session_cache_size);
+    if (capacity <= 0) return nullptr;
+    // Never unreffed, so that it lives as long as the process.
+    return Create(capacity).release();
+  }();
+  if (cache == nullptr) return nullptr;
+  return cache->Ref();
+}
+
+AltsSessionCache::AltsSessionCache(size_t capacity) : capacity_(capacity) {
+  GPR_ASSERT(capacity > 0);
+}
+
+std::string AltsSessionCache::ClientKey(absl::string_view target_name) {
+  return absl::StrCat("c", target_name);
+}
+
+std::string AltsSessionCache::ServerKey(absl::string_view ticket) {
+  return absl::StrCat("s", ticket);
+}
+
+size_t AltsSessionCache::Size() {
+  grpc_core::MutexLock lock(&mu_);
+  return use_order_list_.size();
+}
+
+void AltsSessionCache::Put(const std::string& key, AltsSession session) {
+  grpc_core::MutexLock lock(&mu_);
+  auto it = entry_by_key_.find(key);
+  if (it != entry_by_key_.end()) {
+    use_order_list_.erase(it->second);
+    entry_by_key_.erase(it);
+  }
+  use_order_list_.emplace_front(key, std::move(session));
+  entry_by_key_.emplace(key, use_order_list_.begin());
+  if (use_order_list_.size() > capacity_) {
+    entry_by_key_.erase(use_order_list_.back().first);
+    use_order_list_.pop_back();
+  }
+}
+
+absl::optional<AltsSession> AltsSessionCache::Take(const std::string& key) {
+  grpc_core::MutexLock lock(&mu_);
+  auto it = entry_by_key_.find(key);
+  if (it == entry_by_key_.end()) return absl::nullopt;
+  AltsSession session = std::move(it->second->second);
+  use_order_list_.erase(it->second);
+  entry_by_key_.erase(it);
+  if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), session.expiry) >= 0) {
+    return absl::nullopt;
+  }
+  return session;
+}
+
+}  // namespace tsi
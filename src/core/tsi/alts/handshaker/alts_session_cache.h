@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_TSI_ALTS_HANDSHAKER_ALTS_SESSION_CACHE_H
+#define GRPC_CORE_TSI_ALTS_HANDSHAKER_ALTS_SESSION_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+
+/// ALTS session resumption.
+///
+/// Once a handshake through the handshaker service completes, both peers
+/// derive the same resumption secret and ticket from its record protocol
+/// key, and remember the session: the client under the target name, the
+/// server under the ticket. On reconnect the client sends the ticket and a
+/// nonce in place of the first handshake frame. A server that still has
+/// the session answers with its own nonce and a MAC proving it knows the
+/// secret, and both derive the record protocol key of the new connection
+/// from the secret and the nonces without contacting the handshaker
+/// service. Otherwise the server rejects the ticket and the client falls
+/// back to a full handshake.
+///
+/// Tickets are single use: resuming a session replaces it by one derived
+/// from the new key, which keeps the expiry of the full handshake it came
+/// from, so that peers are authenticated by the handshaker service again
+/// at least once per session lifetime. Since sessions live in memory,
+/// resumption only succeeds against the server process that issued the
+/// ticket.
+
+namespace tsi {
+
+// Lengths of the fields of the resumption frames.
+constexpr size_t kAltsResumptionMagicLength = 8;
+constexpr size_t kAltsResumptionTicketLength = 32;
+constexpr size_t kAltsResumptionNonceLength = 32;
+constexpr size_t kAltsResumptionMacLength = 32;
+constexpr size_t kAltsResumptionSecretLength = 32;
+
+// The first bytes of the resumption frames. A handshake frame starts with
+// its length as a little endian 32-bit integer, which for these would be
+// far larger than any handshake frame.
+//
+// Client: hello magic, ticket, client nonce.
+constexpr absl::string_view kAltsResumptionHelloMagic("ALTSRSMH", 8);
+// Server: accept magic, server nonce, MAC.
+constexpr absl::string_view kAltsResumptionAcceptMagic("ALTSRSMA", 8);
+// Server: reject magic; the client starts a full handshake.
+constexpr absl::string_view kAltsResumptionRejectMagic("ALTSRSMR", 8);
+
+constexpr size_t kAltsResumptionHelloLength = kAltsResumptionMagicLength +
+                                              kAltsResumptionTicketLength +
+                                              kAltsResumptionNonceLength;
+constexpr size_t kAltsResumptionAcceptLength = kAltsResumptionMagicLength +
+                                               kAltsResumptionNonceLength +
+                                               kAltsResumptionMacLength;
+
+// How long a session may be resumed for after the full handshake it came
+// from.
+constexpr int64_t kAltsSessionLifetimeSeconds = 3600;
+
+/// What a peer remembers of a handshake to resume it.
+struct AltsSession {
+  std::string secret;
+  // Known to the client only; the server finds sessions by it.
+  std::string ticket;
+  std::string peer_identity;
+  // As in the handshaker result.
+  std::string rpc_versions;
+  std::string serialized_context;
+  // Peer's maximum frame size.
+  size_t max_frame_size = 0;
+  gpr_timespec expiry;
+
+  /// Sets the secret and the ticket of the session from the record protocol
+  /// \a key_data of the connection it resumes.
+  void DeriveSecret(absl::string_view key_data);
+};
+
+/// Derives \a out_length bytes from \a secret for \a label and \a context,
+/// with HMAC-SHA256 in the manner of HKDF-Expand.
+void AltsResumptionDerive(absl::string_view secret, absl::string_view label,
+                          absl::string_view context, uint8_t* out,
+                          size_t out_length);
+
+/// Cache of ALTS sessions for session resumption.
+///
+/// Older sessions are evicted using LRU policy if the capacity limit is hit.
+///
+/// This class is thread safe.
+class AltsSessionCache : public grpc_core::RefCounted<AltsSessionCache> {
+ public:
+  /// Create new LRU cache with the given capacity.
+  static grpc_core::RefCountedPtr<AltsSessionCache> Create(size_t capacity) {
+    return grpc_core::MakeRefCounted<AltsSessionCache>(capacity);
+  }
+
+  /// Returns the cache that ALTS handshakers use, sized by the
+  /// GRPC_ALTS_SESSION_CACHE_SIZE environment variable, or null if that is
+  /// 0, which disables resumption.
+  static grpc_core::RefCountedPtr<AltsSessionCache> Default();
+
+  // Use Create function instead of using this directly.
+  explicit AltsSessionCache(size_t capacity);
+
+  // Not copyable nor movable.
+  AltsSessionCache(const AltsSessionCache&) = delete;
+  AltsSessionCache& operator=(const AltsSessionCache&) = delete;
+
+  /// Returns the keys of the sessions of a client connecting to
+  /// \a target_name, and of a server that issued \a ticket. Clients and
+  /// servers in one process may share a cache.
+  static std::string ClientKey(absl::string_view target_name);
+  static std::string ServerKey(absl::string_view ticket);
+
+  /// Returns current number of sessions in the cache.
+  size_t Size();
+  /// Add \a session in the cache using \a key. This operation may discard
+  /// older sessions.
+  void Put(const std::string& key, AltsSession session);
+  /// Removes and returns the session associated with \a key, or nullopt if
+  /// there is none or it has expired.
+  absl::optional<AltsSession> Take(const std::string& key);
+
+ private:
+  using Entry = std::pair<std::string, AltsSession>;
+
+  grpc_core::Mutex mu_;
+  const size_t capacity_;
+  // Most recently used first.
+  std::list<Entry> use_order_list_ ABSL_GUARDED_BY(mu_);
+  std::map<std::string, std::list<Entry>::iterator> entry_by_key_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace tsi
+
+#endif /* GRPC_CORE_TSI_ALTS_HANDSHAKER_ALTS_SESSION_CACHE_H */
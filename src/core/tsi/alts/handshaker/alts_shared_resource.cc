@@ -20,22 +20,34 @@
 
 #include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
 
+#include <stdint.h>
+
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_handshaker_threads, 1,
+    "Number of completion queues, each with its own thread, over which "
+    "ALTS handshakes using the dedicated completion queue are spread.");
+
+// Bound on GRPC_ALTS_HANDSHAKER_THREADS.
+constexpr int kMaxHandshakerThreads = 64;
+
 static alts_shared_resource_dedicated g_alts_resource_dedicated;
 
 alts_shared_resource_dedicated* grpc_alts_get_shared_resource_dedicated(void) {
   return &g_alts_resource_dedicated;
 }
 
-static void thread_worker(void* /*arg*/) {
+static void thread_worker(void* arg) {
+  grpc_completion_queue* cq = static_cast<grpc_completion_queue*>(arg);
   while (true) {
-    grpc_event event =
-        grpc_completion_queue_next(g_alts_resource_dedicated.cq,
-                                   gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    grpc_event event = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
     GPR_ASSERT(event.type != GRPC_QUEUE_TIMEOUT);
     if (event.type == GRPC_QUEUE_SHUTDOWN) {
       break;
@@ -48,14 +60,15 @@ static void thread_worker(void* /*arg*/) {
 }
 
 void grpc_alts_shared_resource_dedicated_init() {
-  g_alts_resource_dedicated.cq = nullptr;
+  g_alts_resource_dedicated.shards = nullptr;
+  g_alts_resource_dedicated.num_shards = 0;
   gpr_mu_init(&g_alts_resource_dedicated.mu);
 }
 
 void grpc_alts_shared_resource_dedicated_start(
     const char* handshaker_service_url) {
   gpr_mu_lock(&g_alts_resource_dedicated.mu);
-  if (g_alts_resource_dedicated.cq == nullptr) {
+  if (g_alts_resource_dedicated.shards == nullptr) {
     grpc_channel_credentials* creds = grpc_insecure_credentials_create();
     // Disable retries so that we quickly get a signal when the
     // handshake server is not reachable.
@@ -65,26 +78,51 @@ void grpc_alts_shared_resource_dedicated_start(
     g_alts_resource_dedicated.channel =
         grpc_channel_create(handshaker_service_url, creds, &args);
     grpc_channel_credentials_release(creds);
-    g_alts_resource_dedicated.cq =
-        grpc_completion_queue_create_for_next(nullptr);
-    g_alts_resource_dedicated.thread =
-        grpc_core::Thread("alts_tsi_handshaker", &thread_worker, nullptr);
     g_alts_resource_dedicated.interested_parties = grpc_pollset_set_create();
-    grpc_pollset_set_add_pollset(g_alts_resource_dedicated.interested_parties,
-                                 grpc_cq_pollset(g_alts_resource_dedicated.cq));
-    g_alts_resource_dedicated.thread.Start();
+    const size_t num_shards = grpc_core::Clamp(
+        GPR_GLOBAL_CONFIG_GET(grpc_alts_handshaker_threads), 1,
+        kMaxHandshakerThreads);
+    g_alts_resource_dedicated.num_shards = num_shards;
+    g_alts_resource_dedicated.shards =
+        new alts_shared_resource_dedicated_shard[num_shards];
+    for (size_t i = 0; i < num_shards; ++i) {
+      alts_shared_resource_dedicated_shard* shard =
+          &g_alts_resource_dedicated.shards[i];
+      shard->cq = grpc_completion_queue_create_for_next(nullptr);
+      shard->thread =
+          grpc_core::Thread("alts_tsi_handshaker", &thread_worker, shard->cq);
+      grpc_pollset_set_add_pollset(g_alts_resource_dedicated.interested_parties,
+                                   grpc_cq_pollset(shard->cq));
+      shard->thread.Start();
+    }
   }
   gpr_mu_unlock(&g_alts_resource_dedicated.mu);
 }
 
+grpc_completion_queue* grpc_alts_shared_resource_dedicated_cq(
+    const void* client) {
+  GPR_ASSERT(g_alts_resource_dedicated.shards != nullptr);
+  // Skip the low bits of the address, which alignment leaves mostly zero.
+  const size_t hash = reinterpret_cast<uintptr_t>(client) / 64;
+  return g_alts_resource_dedicated
+      .shards[hash % g_alts_resource_dedicated.num_shards]
+      .cq;
+}
+
 void grpc_alts_shared_resource_dedicated_shutdown() {
-  if (g_alts_resource_dedicated.cq != nullptr) {
-    grpc_pollset_set_del_pollset(g_alts_resource_dedicated.interested_parties,
-                                 grpc_cq_pollset(g_alts_resource_dedicated.cq));
-    grpc_completion_queue_shutdown(g_alts_resource_dedicated.cq);
-    g_alts_resource_dedicated.thread.Join();
+  if (g_alts_resource_dedicated.shards != nullptr) {
+    for (size_t i = 0; i < g_alts_resource_dedicated.num_shards; ++i) {
+      alts_shared_resource_dedicated_shard* shard =
+          &g_alts_resource_dedicated.shards[i];
+      grpc_pollset_set_del_pollset(g_alts_resource_dedicated.interested_parties,
+                                   grpc_cq_pollset(shard->cq));
+      grpc_completion_queue_shutdown(shard->cq);
+      shard->thread.Join();
+      grpc_completion_queue_destroy(shard->cq);
+    }
+    delete[] g_alts_resource_dedicated.shards;
+    g_alts_resource_dedicated.shards = nullptr;
     grpc_pollset_set_destroy(g_alts_resource_dedicated.interested_parties);
-    grpc_completion_queue_destroy(g_alts_resource_dedicated.cq);
     grpc_channel_destroy(g_alts_resource_dedicated.channel);
   }
   gpr_mu_destroy(&g_alts_resource_dedicated.mu);
@@ -29,14 +29,25 @@
 #include "src/core/lib/surface/completion_queue.h"
 
 /**
- * Main struct containing ALTS shared resources used when
- * employing the dedicated completion queue and thread.
+ * A completion queue used for ALTS handshaker-service calls when
+ * employing the dedicated completion queues and threads, and the thread
+ * that polls it.
  */
-typedef struct alts_shared_resource_dedicated {
+typedef struct alts_shared_resource_dedicated_shard {
   grpc_core::Thread thread;
   grpc_completion_queue* cq;
+} alts_shared_resource_dedicated_shard;
+
+/**
+ * Main struct containing ALTS shared resources used when
+ * employing the dedicated completion queues and threads. Handshakes are
+ * spread over the shards, the number of which is set by the
+ * GRPC_ALTS_HANDSHAKER_THREADS environment variable.
+ */
+typedef struct alts_shared_resource_dedicated {
+  alts_shared_resource_dedicated_shard* shards;
+  size_t num_shards;
   grpc_pollset_set* interested_parties;
-  grpc_cq_completion storage;
   gpr_mu mu;
   grpc_channel* channel;
 } alts_shared_resource_dedicated;
@@ -62,12 +73,20 @@ void grpc_alts_shared_resource_dedicated_init();
 
 /**
  * This method populates various fields of the alts_shared_resource_dedicated
- * object shared by all TSI handshakes and start the dedicated thread.
+ * object shared by all TSI handshakes and start the dedicated threads.
  * The API will be invoked by the caller in a lazy manner. That is,
  * it will get invoked when ALTS TSI handshake occurs for the first time.
  */
 void grpc_alts_shared_resource_dedicated_start(
     const char* handshaker_service_url);
 
+/**
+ * This method returns the dedicated completion queue on which the
+ * handshaker-service calls of the given handshaker client complete. It
+ * must be invoked after grpc_alts_shared_resource_dedicated_start().
+ */
+grpc_completion_queue* grpc_alts_shared_resource_dedicated_cq(
+    const void* client);
+
 #endif /* GRPC_CORE_TSI_ALTS_HANDSHAKER_ALTS_SHARED_RESOURCE_H \
         */
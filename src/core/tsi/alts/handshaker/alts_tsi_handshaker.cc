@@ -24,8 +24,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "upb/upb.hpp"
 
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+
 #include <grpc/grpc_security.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -41,6 +50,7 @@
 #include "src/core/lib/surface/channel.h"
 #include "src/core/tsi/alts/frame_protector/alts_frame_protector.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
+#include "src/core/tsi/alts/handshaker/alts_session_cache.h"
 #include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
 #include "src/core/tsi/alts/handshaker/alts_tsi_utils.h"
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_zero_copy_grpc_protector.h"
@@ -69,6 +79,24 @@ struct alts_tsi_handshaker {
   bool shutdown = false;
   // Maximum frame size used by frame protector.
   size_t max_frame_size;
+  // Session resumption, if there is a session cache. It happens in the
+  // first calls to tsi_handshaker_next(), before a handshake through the
+  // handshaker service is started, so these fields are not shared either.
+  grpc_core::RefCountedPtr<tsi::AltsSessionCache> session_cache;
+  enum class ResumptionState {
+    kStart,
+    // Client only: waiting for the server to accept or reject the ticket.
+    kHelloSent,
+    // Resumed, or falling back to the handshaker service.
+    kDone,
+  };
+  ResumptionState resumption_state = ResumptionState::kStart;
+  // Client only: the session offered to the server, and the nonce sent.
+  absl::optional<tsi::AltsSession> resuming_session;
+  std::string client_nonce;
+  // The resumption frame received so far, and the one sent.
+  std::string resumption_received;
+  std::string resumption_sent;
 };
 
 /* Main struct for ALTS TSI handshaker result. */
@@ -260,7 +288,9 @@ static const tsi_handshaker_result_vtable result_vtable = {
     handshaker_result_create_zero_copy_grpc_protector,
     handshaker_result_create_frame_protector,
     handshaker_result_get_unused_bytes,
-    handshaker_result_destroy};
+    handshaker_result_destroy,
+    nullptr, /* handshaker_result_offload_to_kernel */
+};
 
 tsi_result alts_tsi_handshaker_result_create(grpc_gcp_HandshakerResp* resp,
                                              bool is_client,
@@ -382,6 +412,263 @@ tsi_result alts_tsi_handshaker_result_create(grpc_gcp_HandshakerResp* resp,
   return TSI_OK;
 }
 
+/* Creates the result of a resumed session, which uses key_data as its record
+ * protocol key. */
+static tsi_handshaker_result* alts_tsi_handshaker_result_create_from_session(
+    const tsi::AltsSession& session, const uint8_t* key_data, bool is_client,
+    absl::string_view unused_bytes) {
+  alts_tsi_handshaker_result* sresult =
+      grpc_core::Zalloc<alts_tsi_handshaker_result>();
+  sresult->key_data =
+      static_cast<char*>(gpr_zalloc(kAltsAes128GcmRekeyKeyLength));
+  memcpy(sresult->key_data, key_data, kAltsAes128GcmRekeyKeyLength);
+  sresult->peer_identity = gpr_strdup(session.peer_identity.c_str());
+  sresult->max_frame_size = session.max_frame_size;
+  sresult->rpc_versions = grpc_slice_from_cpp_string(session.rpc_versions);
+  sresult->serialized_context =
+      grpc_slice_from_cpp_string(session.serialized_context);
+  if (!unused_bytes.empty()) {
+    sresult->unused_bytes_size = unused_bytes.size();
+    sresult->unused_bytes =
+        static_cast<unsigned char*>(gpr_zalloc(unused_bytes.size()));
+    memcpy(sresult->unused_bytes, unused_bytes.data(), unused_bytes.size());
+  }
+  sresult->is_client = is_client;
+  sresult->base.vtable = &result_vtable;
+  return &sresult->base;
+}
+
+static std::string alts_tsi_handshaker_session_key(
+    const alts_tsi_handshaker* handshaker, absl::string_view ticket) {
+  return handshaker->is_client
+             ? tsi::AltsSessionCache::ClientKey(
+                   grpc_core::StringViewFromSlice(handshaker->target_name))
+             : tsi::AltsSessionCache::ServerKey(ticket);
+}
+
+/* Remembers session, renewing its secret from the record protocol key of the
+ * connection it was established or resumed for. */
+static void alts_tsi_handshaker_remember_session(
+    alts_tsi_handshaker* handshaker, tsi::AltsSession session,
+    absl::string_view key_data) {
+  session.DeriveSecret(key_data);
+  std::string key = alts_tsi_handshaker_session_key(handshaker, session.ticket);
+  if (!handshaker->is_client) session.ticket.clear();
+  handshaker->session_cache->Put(key, std::move(session));
+}
+
+void alts_tsi_handshaker_save_session(alts_tsi_handshaker* handshaker,
+                                      const tsi_handshaker_result* result) {
+  GPR_ASSERT(handshaker != nullptr && result != nullptr);
+  if (handshaker->session_cache == nullptr) return;
+  const alts_tsi_handshaker_result* sresult =
+      reinterpret_cast<const alts_tsi_handshaker_result*>(result);
+  tsi::AltsSession session;
+  session.peer_identity = sresult->peer_identity;
+  session.rpc_versions =
+      std::string(grpc_core::StringViewFromSlice(sresult->rpc_versions));
+  session.serialized_context =
+      std::string(grpc_core::StringViewFromSlice(sresult->serialized_context));
+  session.max_frame_size = sresult->max_frame_size;
+  session.expiry = gpr_time_add(
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_seconds(tsi::kAltsSessionLifetimeSeconds, GPR_TIMESPAN));
+  alts_tsi_handshaker_remember_session(
+      handshaker, std::move(session),
+      absl::string_view(sresult->key_data, kAltsAes128GcmRekeyKeyLength));
+}
+
+/* Derives the record protocol key of a resumed session and the MAC with which
+ * the server proves it knows the secret, from the nonces of both peers. */
+static void alts_tsi_handshaker_derive_resumed_keys(
+    const tsi::AltsSession& session, absl::string_view client_nonce,
+    absl::string_view server_nonce, uint8_t* key_data, uint8_t* mac) {
+  std::string nonces = absl::StrCat(client_nonce, server_nonce);
+  tsi::AltsResumptionDerive(session.secret, "record protocol key", nonces,
+                            key_data, kAltsAes128GcmRekeyKeyLength);
+  tsi::AltsResumptionDerive(session.secret, "server finished", nonces, mac,
+                            tsi::kAltsResumptionMacLength);
+}
+
+static std::string alts_tsi_handshaker_random_nonce() {
+  uint8_t nonce[tsi::kAltsResumptionNonceLength];
+  GPR_ASSERT(RAND_bytes(nonce, sizeof(nonce)) == 1);
+  return std::string(reinterpret_cast<char*>(nonce), sizeof(nonce));
+}
+
+/* Client side of session resumption. See alts_tsi_handshaker_maybe_resume. */
+static bool alts_tsi_handshaker_client_resume(
+    alts_tsi_handshaker* handshaker, const unsigned char** received_bytes,
+    size_t* received_bytes_size, const unsigned char** bytes_to_send,
+    size_t* bytes_to_send_size, tsi_handshaker_result** result,
+    tsi_result* status) {
+  using ResumptionState = alts_tsi_handshaker::ResumptionState;
+  if (handshaker->resumption_state == ResumptionState::kStart) {
+    handshaker->resumption_state = ResumptionState::kDone;
+    handshaker->resuming_session = handshaker->session_cache->Take(
+        alts_tsi_handshaker_session_key(handshaker, ""));
+    if (!handshaker->resuming_session.has_value()) return false;
+    handshaker->client_nonce = alts_tsi_handshaker_random_nonce();
+    handshaker->resumption_sent =
+        absl::StrCat(tsi::kAltsResumptionHelloMagic,
+                     handshaker->resuming_session->ticket,
+                     handshaker->client_nonce);
+    handshaker->resumption_state = ResumptionState::kHelloSent;
+    *bytes_to_send = reinterpret_cast<const unsigned char*>(
+        handshaker->resumption_sent.data());
+    *bytes_to_send_size = handshaker->resumption_sent.size();
+    *status = TSI_OK;
+    return true;
+  }
+  std::string& received = handshaker->resumption_received;
+  if (*received_bytes_size > 0) {
+    received.append(reinterpret_cast<const char*>(*received_bytes),
+                    *received_bytes_size);
+  }
+  if (received.size() < tsi::kAltsResumptionMagicLength) {
+    *status = TSI_INCOMPLETE_DATA;
+    return true;
+  }
+  absl::string_view magic(received.data(), tsi::kAltsResumptionMagicLength);
+  if (magic == tsi::kAltsResumptionRejectMagic) {
+    handshaker->resumption_state = ResumptionState::kDone;
+    handshaker->resuming_session.reset();
+    *received_bytes = reinterpret_cast<const unsigned char*>(received.data()) +
+                      tsi::kAltsResumptionMagicLength;
+    *received_bytes_size = received.size() - tsi::kAltsResumptionMagicLength;
+    return false;
+  }
+  if (magic != tsi::kAltsResumptionAcceptMagic) {
+    gpr_log(GPR_ERROR, "Invalid ALTS session resumption response");
+    *status = TSI_PROTOCOL_FAILURE;
+    return true;
+  }
+  if (received.size() < tsi::kAltsResumptionAcceptLength) {
+    *status = TSI_INCOMPLETE_DATA;
+    return true;
+  }
+  handshaker->resumption_state = ResumptionState::kDone;
+  absl::string_view server_nonce(
+      received.data() + tsi::kAltsResumptionMagicLength,
+      tsi::kAltsResumptionNonceLength);
+  const char* server_mac = server_nonce.data() + server_nonce.size();
+  uint8_t key_data[kAltsAes128GcmRekeyKeyLength];
+  uint8_t mac[tsi::kAltsResumptionMacLength];
+  alts_tsi_handshaker_derive_resumed_keys(*handshaker->resuming_session,
+                                          handshaker->client_nonce,
+                                          server_nonce, key_data, mac);
+  if (CRYPTO_memcmp(mac, server_mac, sizeof(mac)) != 0) {
+    gpr_log(GPR_ERROR, "ALTS session resumption failed to authenticate server");
+    *status = TSI_PROTOCOL_FAILURE;
+    return true;
+  }
+  *result = alts_tsi_handshaker_result_create_from_session(
+      *handshaker->resuming_session, key_data, /*is_client=*/true,
+      absl::string_view(received).substr(tsi::kAltsResumptionAcceptLength));
+  alts_tsi_handshaker_remember_session(
+      handshaker, std::move(*handshaker->resuming_session),
+      absl::string_view(reinterpret_cast<char*>(key_data), sizeof(key_data)));
+  handshaker->resuming_session.reset();
+  *status = TSI_OK;
+  return true;
+}
+
+/* Server side of session resumption. See alts_tsi_handshaker_maybe_resume. */
+static bool alts_tsi_handshaker_server_resume(
+    alts_tsi_handshaker* handshaker, const unsigned char** received_bytes,
+    size_t* received_bytes_size, const unsigned char** bytes_to_send,
+    size_t* bytes_to_send_size, tsi_handshaker_result** result,
+    tsi_result* status) {
+  using ResumptionState = alts_tsi_handshaker::ResumptionState;
+  std::string& received = handshaker->resumption_received;
+  if (*received_bytes_size > 0) {
+    received.append(reinterpret_cast<const char*>(*received_bytes),
+                    *received_bytes_size);
+  }
+  absl::string_view prefix = absl::string_view(received).substr(
+      0, tsi::kAltsResumptionMagicLength);
+  if (prefix != tsi::kAltsResumptionHelloMagic.substr(0, prefix.size())) {
+    // A client starting a full handshake.
+    handshaker->resumption_state = ResumptionState::kDone;
+    *received_bytes = reinterpret_cast<const unsigned char*>(received.data());
+    *received_bytes_size = received.size();
+    return false;
+  }
+  if (received.size() < tsi::kAltsResumptionHelloLength) {
+    *status = TSI_INCOMPLETE_DATA;
+    return true;
+  }
+  if (received.size() > tsi::kAltsResumptionHelloLength) {
+    // The client waits for the server's answer before sending more.
+    gpr_log(GPR_ERROR, "Unexpected bytes after ALTS session resumption hello");
+    *status = TSI_PROTOCOL_FAILURE;
+    return true;
+  }
+  handshaker->resumption_state = ResumptionState::kDone;
+  absl::string_view ticket(received.data() + tsi::kAltsResumptionMagicLength,
+                           tsi::kAltsResumptionTicketLength);
+  absl::string_view client_nonce(ticket.data() + ticket.size(),
+                                 tsi::kAltsResumptionNonceLength);
+  absl::optional<tsi::AltsSession> session = handshaker->session_cache->Take(
+      alts_tsi_handshaker_session_key(handshaker, ticket));
+  if (!session.has_value()) {
+    // Have the client start a full handshake.
+    handshaker->resumption_sent = std::string(tsi::kAltsResumptionRejectMagic);
+  } else {
+    std::string server_nonce = alts_tsi_handshaker_random_nonce();
+    uint8_t key_data[kAltsAes128GcmRekeyKeyLength];
+    uint8_t mac[tsi::kAltsResumptionMacLength];
+    alts_tsi_handshaker_derive_resumed_keys(*session, client_nonce,
+                                            server_nonce, key_data, mac);
+    handshaker->resumption_sent = absl::StrCat(
+        tsi::kAltsResumptionAcceptMagic, server_nonce,
+        absl::string_view(reinterpret_cast<char*>(mac), sizeof(mac)));
+    *result = alts_tsi_handshaker_result_create_from_session(
+        *session, key_data, /*is_client=*/false, absl::string_view());
+    alts_tsi_handshaker_remember_session(
+        handshaker, std::move(*session),
+        absl::string_view(reinterpret_cast<char*>(key_data), sizeof(key_data)));
+  }
+  *bytes_to_send = reinterpret_cast<const unsigned char*>(
+      handshaker->resumption_sent.data());
+  *bytes_to_send_size = handshaker->resumption_sent.size();
+  *status = TSI_OK;
+  return true;
+}
+
+/* Runs session resumption, synchronously, before a handshake through the
+ * handshaker service. Returns true if this handshaker_next call is done and
+ * *status is to be returned, or false to continue with the handshaker
+ * service, in which case received_bytes may have been replaced by the
+ * bytes the handshaker service is to consume. */
+static bool alts_tsi_handshaker_maybe_resume(
+    alts_tsi_handshaker* handshaker, const unsigned char** received_bytes,
+    size_t* received_bytes_size, const unsigned char** bytes_to_send,
+    size_t* bytes_to_send_size, tsi_handshaker_result** result,
+    tsi_result* status) {
+  if (handshaker->session_cache == nullptr ||
+      handshaker->resumption_state ==
+          alts_tsi_handshaker::ResumptionState::kDone) {
+    return false;
+  }
+  if (bytes_to_send == nullptr || bytes_to_send_size == nullptr ||
+      result == nullptr) {
+    // Only asynchronous results can be returned.
+    handshaker->resumption_state = alts_tsi_handshaker::ResumptionState::kDone;
+    return false;
+  }
+  *bytes_to_send = nullptr;
+  *bytes_to_send_size = 0;
+  *result = nullptr;
+  return handshaker->is_client
+             ? alts_tsi_handshaker_client_resume(
+                   handshaker, received_bytes, received_bytes_size,
+                   bytes_to_send, bytes_to_send_size, result, status)
+             : alts_tsi_handshaker_server_resume(
+                   handshaker, received_bytes, received_bytes_size,
+                   bytes_to_send, bytes_to_send_size, result, status);
+}
+
 /* gRPC provided callback used when gRPC thread model is applied. */
 static void on_handshaker_service_resp_recv(void* arg,
                                             grpc_error_handle error) {
@@ -404,12 +691,12 @@ static void on_handshaker_service_resp_recv(void* arg,
  * It serves to safely bring the control back to application. */
 static void on_handshaker_service_resp_recv_dedicated(
     void* arg, grpc_error_handle /*error*/) {
-  alts_shared_resource_dedicated* resource =
-      grpc_alts_get_shared_resource_dedicated();
+  // Handshakes complete concurrently, so each completion gets its own
+  // storage.
   grpc_cq_end_op(
-      resource->cq, arg, absl::OkStatus(),
-      [](void* /*done_arg*/, grpc_cq_completion* /*storage*/) {}, nullptr,
-      &resource->storage);
+      grpc_alts_shared_resource_dedicated_cq(arg), arg, absl::OkStatus(),
+      [](void* /*done_arg*/, grpc_cq_completion* storage) { delete storage; },
+      nullptr, new grpc_cq_completion());
 }
 
 /* Returns TSI_OK if and only if no error is encountered. */
@@ -457,8 +744,9 @@ static tsi_result alts_tsi_handshaker_continue_handshaker_next(
   }
   if (handshaker->channel == nullptr &&
       handshaker->client_vtable_for_testing == nullptr) {
-    GPR_ASSERT(grpc_cq_begin_op(grpc_alts_get_shared_resource_dedicated()->cq,
-                                handshaker->client));
+    GPR_ASSERT(grpc_cq_begin_op(
+        grpc_alts_shared_resource_dedicated_cq(handshaker->client),
+        handshaker->client));
   }
   grpc_slice slice = (received_bytes == nullptr || received_bytes_size == 0)
                          ? grpc_empty_slice()
@@ -524,8 +812,8 @@ static void alts_tsi_handshaker_create_channel(
 
 static tsi_result handshaker_next(
     tsi_handshaker* self, const unsigned char* received_bytes,
-    size_t received_bytes_size, const unsigned char** /*bytes_to_send*/,
-    size_t* /*bytes_to_send_size*/, tsi_handshaker_result** /*result*/,
+    size_t received_bytes_size, const unsigned char** bytes_to_send,
+    size_t* bytes_to_send_size, tsi_handshaker_result** result,
     tsi_handshaker_on_next_done_cb cb, void* user_data, std::string* error) {
   if (self == nullptr || cb == nullptr) {
     gpr_log(GPR_ERROR, "Invalid arguments to handshaker_next()");
@@ -542,6 +830,16 @@ static tsi_result handshaker_next(
       return TSI_HANDSHAKE_SHUTDOWN;
     }
   }
+  tsi_result resumption_status;
+  if (alts_tsi_handshaker_maybe_resume(
+          handshaker, &received_bytes, &received_bytes_size, bytes_to_send,
+          bytes_to_send_size, result, &resumption_status)) {
+    if (resumption_status != TSI_OK &&
+        resumption_status != TSI_INCOMPLETE_DATA && error != nullptr) {
+      *error = "ALTS session resumption failed";
+    }
+    return resumption_status;
+  }
   if (handshaker->channel == nullptr && !handshaker->use_dedicated_cq) {
     alts_tsi_handshaker_continue_handshaker_next_args* args =
         new alts_tsi_handshaker_continue_handshaker_next_args();
@@ -669,6 +967,7 @@ tsi_result alts_tsi_handshaker_create(
   handshaker->max_frame_size = user_specified_max_frame_size != 0
                                    ? user_specified_max_frame_size
                                    : kTsiAltsMaxFrameSize;
+  handshaker->session_cache = tsi::AltsSessionCache::Default();
   *self = &handshaker->base;
   return TSI_OK;
 }
@@ -716,5 +1015,12 @@ alts_handshaker_client* alts_tsi_handshaker_get_client_for_testing(
   return handshaker->client;
 }
 
+void alts_tsi_handshaker_set_session_cache_for_testing(
+    alts_tsi_handshaker* handshaker,
+    RefCountedPtr<tsi::AltsSessionCache> session_cache) {
+  GPR_ASSERT(handshaker != nullptr);
+  handshaker->session_cache = std::move(session_cache);
+}
+
 }  // namespace internal
 }  // namespace grpc_core
@@ -95,6 +95,17 @@ void alts_tsi_handshaker_result_set_unused_bytes(tsi_handshaker_result* result,
                                                  grpc_slice* recv_bytes,
                                                  size_t bytes_consumed);
 
+/**
+ * This method remembers the session of a handshake completed through the
+ * handshaker service, so that it can be resumed, if session resumption is
+ * enabled (see alts_session_cache.h).
+ *
+ * - handshaker: the ALTS TSI handshaker the handshake was done by.
+ * - result: the ALTS TSI handshaker result of the handshake.
+ */
+void alts_tsi_handshaker_save_session(alts_tsi_handshaker* handshaker,
+                                      const tsi_handshaker_result* result);
+
 /**
  * This method returns a boolean value indicating if an ALTS TSI handshaker
  * has been shutdown or not.
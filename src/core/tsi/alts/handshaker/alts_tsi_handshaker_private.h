@@ -21,7 +21,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
+#include "src/core/tsi/alts/handshaker/alts_session_cache.h"
 
 namespace grpc_core {
 namespace internal {
@@ -41,6 +43,10 @@ void alts_tsi_handshaker_set_client_vtable_for_testing(
 bool alts_tsi_handshaker_get_is_client_for_testing(
     alts_tsi_handshaker* handshaker);
 
+void alts_tsi_handshaker_set_session_cache_for_testing(
+    alts_tsi_handshaker* handshaker,
+    RefCountedPtr<tsi::AltsSessionCache> session_cache);
+
 void alts_handshaker_client_set_grpc_caller_for_testing(
     alts_handshaker_client* client, alts_grpc_caller caller);
 
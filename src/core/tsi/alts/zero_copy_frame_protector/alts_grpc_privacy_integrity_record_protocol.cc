@@ -20,6 +20,8 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_privacy_integrity_record_protocol.h"
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -69,6 +71,60 @@ static tsi_result alts_grpc_privacy_integrity_protect(
   return TSI_OK;
 }
 
+/* Seals all the frames in a single buffer, reading the unprotected data of
+ * each frame straight from the input slices.  */
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_data_size == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol protect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Like a sequence of protect calls, empty data is sent as one empty frame.
+   */
+  size_t data_length = unprotected_slices->length;
+  size_t num_frames = std::max<size_t>(
+      1, (data_length + max_unprotected_data_size - 1) /
+             max_unprotected_data_size);
+  size_t frame_overhead =
+      rp->header_length +
+      alts_iovec_record_protocol_get_tag_length(rp->iovec_rp);
+  grpc_slice protected_slice =
+      GRPC_SLICE_MALLOC(data_length + num_frames * frame_overhead);
+  unsigned char* protected_frame_start = GRPC_SLICE_START_PTR(protected_slice);
+  size_t slice_index = 0;
+  size_t slice_offset = 0;
+  for (size_t i = 0; i < num_frames; i++) {
+    size_t frame_data_length =
+        std::min(data_length, max_unprotected_data_size);
+    data_length -= frame_data_length;
+    size_t iovec_count =
+        alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+            rp, unprotected_slices, &slice_index, &slice_offset,
+            frame_data_length);
+    iovec_t protected_iovec = {protected_frame_start,
+                               frame_data_length + frame_overhead};
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, rp->iovec_buf, iovec_count, protected_iovec,
+            &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    protected_frame_start += protected_iovec.iov_len;
+  }
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  grpc_slice_buffer_reset_and_unref(unprotected_slices);
+  return TSI_OK;
+}
+
 static tsi_result alts_grpc_privacy_integrity_unprotect(
     alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -118,7 +174,8 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect, nullptr,
+        alts_grpc_privacy_integrity_protect_frames};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
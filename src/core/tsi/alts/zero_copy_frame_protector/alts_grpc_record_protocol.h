@@ -50,6 +50,27 @@ tsi_result alts_grpc_record_protocol_protect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
     grpc_slice_buffer* protected_slices);
 
+/**
+ * This method protects unprotected data as a sequence of frames, each carrying
+ * at most max_unprotected_data_size bytes, and appends them to
+ * protected_slices. It has the same result as calling
+ * alts_grpc_record_protocol_protect() on each max_unprotected_data_size chunk,
+ * but implementations may seal the frames into a single buffer. The input
+ * unprotected data slice buffer will be cleared, although the actual
+ * unprotected data bytes are not modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_unprotected_data_size: the maximum unprotected data size of a frame.
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success or a specific error code in
+ * case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices);
+
 /**
  * This methods performs unprotect operation on a full frame of protected data
  * and appends unprotected data to unprotected_slices. It is the caller's
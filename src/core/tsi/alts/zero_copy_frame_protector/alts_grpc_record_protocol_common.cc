@@ -57,6 +57,31 @@ void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
   }
 }
 
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t* index,
+    size_t* offset, size_t length) {
+  GPR_ASSERT(rp != nullptr && sb != nullptr && index != nullptr &&
+             offset != nullptr);
+  ensure_iovec_buf_size(rp, sb);
+  size_t count = 0;
+  while (length > 0) {
+    GPR_ASSERT(*index < sb->count);
+    size_t slice_length = GRPC_SLICE_LENGTH(sb->slices[*index]);
+    size_t iov_len = std::min(slice_length - *offset, length);
+    rp->iovec_buf[count].iov_base =
+        GRPC_SLICE_START_PTR(sb->slices[*index]) + *offset;
+    rp->iovec_buf[count].iov_len = iov_len;
+    count++;
+    length -= iov_len;
+    *offset += iov_len;
+    if (*offset == slice_length) {
+      (*index)++;
+      *offset = 0;
+    }
+  }
+  return count;
+}
+
 void alts_grpc_record_protocol_copy_slice_buffer(const grpc_slice_buffer* src,
                                                  unsigned char* dst) {
   GPR_ASSERT(src != nullptr && dst != nullptr);
@@ -134,6 +159,38 @@ tsi_result alts_grpc_record_protocol_protect(
   return self->vtable->protect(self, unprotected_slices, protected_slices);
 }
 
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_data_size == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->protect_frames != nullptr) {
+    return self->vtable->protect_frames(self, unprotected_slices,
+                                        max_unprotected_data_size,
+                                        protected_slices);
+  }
+  if (self->vtable->protect == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  grpc_slice_buffer staging_sb;
+  grpc_slice_buffer_init(&staging_sb);
+  tsi_result result = TSI_OK;
+  while (result == TSI_OK &&
+         unprotected_slices->length > max_unprotected_data_size) {
+    grpc_slice_buffer_move_first(unprotected_slices, max_unprotected_data_size,
+                                 &staging_sb);
+    result = self->vtable->protect(self, &staging_sb, protected_slices);
+  }
+  grpc_slice_buffer_destroy(&staging_sb);
+  if (result != TSI_OK) {
+    return result;
+  }
+  return self->vtable->protect(self, unprotected_slices, protected_slices);
+}
+
 tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -39,6 +39,11 @@ struct alts_grpc_record_protocol_vtable {
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
+  /* Optional: frames are protected one by one with protect when unset.  */
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_data_size,
+                               grpc_slice_buffer* protected_slices);
 };
 /* Main struct for alts_grpc_record_protocol implementation, shared by both
  * integrity-only record protocol and privacy-integrity record protocol.
@@ -63,6 +68,16 @@ struct alts_grpc_record_protocol {
 void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
     alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb);
 
+/**
+ * Converts the next length bytes of input sb, starting at byte *offset of
+ * slice *index, into iovec_t's and puts the result into rp->iovec_buf. The
+ * position is advanced past these bytes. Returns the number of iovec_t's. The
+ * caller needs to make sure sb has length bytes past the position.
+ */
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t* index,
+    size_t* offset, size_t length);
+
 /**
  * Copies bytes from slice buffer to destination buffer. Caller is responsible
  * for allocating enough memory of destination buffer. This method is used for
@@ -52,7 +52,6 @@ typedef struct alts_zero_copy_grpc_protector {
   alts_grpc_record_protocol* unrecord_protocol;
   size_t max_protected_frame_size;
   size_t max_unprotected_data_size;
-  grpc_slice_buffer unprotected_staging_sb;
   grpc_slice_buffer protected_sb;
   grpc_slice_buffer protected_staging_sb;
   uint32_t parsed_frame_size;
@@ -156,20 +155,9 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
-  /* Calls alts_grpc_record_protocol protect repeatly.  */
-  while (unprotected_slices->length > protector->max_unprotected_data_size) {
-    grpc_slice_buffer_move_first(unprotected_slices,
-                                 protector->max_unprotected_data_size,
-                                 &protector->unprotected_staging_sb);
-    tsi_result status = alts_grpc_record_protocol_protect(
-        protector->record_protocol, &protector->unprotected_staging_sb,
-        protected_slices);
-    if (status != TSI_OK) {
-      return status;
-    }
-  }
-  return alts_grpc_record_protocol_protect(
-      protector->record_protocol, unprotected_slices, protected_slices);
+  return alts_grpc_record_protocol_protect_frames(
+      protector->record_protocol, unprotected_slices,
+      protector->max_unprotected_data_size, protected_slices);
 }
 
 static tsi_result alts_zero_copy_grpc_protector_unprotect(
@@ -235,7 +223,6 @@ static void alts_zero_copy_grpc_protector_destroy(
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
   alts_grpc_record_protocol_destroy(protector->record_protocol);
   alts_grpc_record_protocol_destroy(protector->unrecord_protocol);
-  grpc_slice_buffer_destroy(&protector->unprotected_staging_sb);
   grpc_slice_buffer_destroy(&protector->protected_sb);
   grpc_slice_buffer_destroy(&protector->protected_staging_sb);
   gpr_free(protector);
@@ -250,12 +237,19 @@ static tsi_result alts_zero_copy_grpc_protector_max_frame_size(
   return TSI_OK;
 }
 
+/* Protect and unprotect use their own record protocol and slice buffers.  */
+static bool alts_zero_copy_grpc_protector_is_full_duplex(
+    const tsi_zero_copy_grpc_protector* /*self*/) {
+  return true;
+}
+
 static const tsi_zero_copy_grpc_protector_vtable
     alts_zero_copy_grpc_protector_vtable = {
         alts_zero_copy_grpc_protector_protect,
         alts_zero_copy_grpc_protector_unprotect,
         alts_zero_copy_grpc_protector_destroy,
-        alts_zero_copy_grpc_protector_max_frame_size};
+        alts_zero_copy_grpc_protector_max_frame_size,
+        alts_zero_copy_grpc_protector_is_full_duplex};
 
 tsi_result alts_zero_copy_grpc_protector_create(
     const uint8_t* key, size_t key_size, bool is_rekey, bool is_client,
@@ -297,7 +291,6 @@ tsi_result alts_zero_copy_grpc_protector_create(
               impl->record_protocol, max_protected_frame_size_to_set);
       GPR_ASSERT(impl->max_unprotected_data_size > 0);
       /* Allocates internal slice buffers.  */
-      grpc_slice_buffer_init(&impl->unprotected_staging_sb);
       grpc_slice_buffer_init(&impl->protected_sb);
       grpc_slice_buffer_init(&impl->protected_staging_sb);
       impl->parsed_frame_size = 0;
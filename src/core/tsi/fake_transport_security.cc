@@ -417,11 +417,17 @@ static void fake_protector_destroy(tsi_frame_protector* self) {
   gpr_free(self);
 }
 
+static bool fake_protector_is_full_duplex(
+    const tsi_frame_protector* /*self*/) {
+  return true;
+}
+
 static const tsi_frame_protector_vtable frame_protector_vtable = {
     fake_protector_protect,
     fake_protector_protect_flush,
     fake_protector_unprotect,
     fake_protector_destroy,
+    fake_protector_is_full_duplex,
 };
 
 /* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
@@ -512,12 +518,18 @@ static tsi_result fake_zero_copy_grpc_protector_max_frame_size(
   return TSI_OK;
 }
 
+static bool fake_zero_copy_grpc_protector_is_full_duplex(
+    const tsi_zero_copy_grpc_protector* /*self*/) {
+  return true;
+}
+
 static const tsi_zero_copy_grpc_protector_vtable
     zero_copy_grpc_protector_vtable = {
         fake_zero_copy_grpc_protector_protect,
         fake_zero_copy_grpc_protector_unprotect,
         fake_zero_copy_grpc_protector_destroy,
         fake_zero_copy_grpc_protector_max_frame_size,
+        fake_zero_copy_grpc_protector_is_full_duplex,
 };
 
 /* --- tsi_handshaker_result methods implementation. ---*/
@@ -591,6 +603,7 @@ static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     fake_handshaker_result_create_frame_protector,
     fake_handshaker_result_get_unused_bytes,
     fake_handshaker_result_destroy,
+    nullptr, /* fake_handshaker_result_offload_to_kernel */
 };
 
 static tsi_result fake_handshaker_result_create(
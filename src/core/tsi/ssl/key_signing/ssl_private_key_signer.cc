@@ -0,0 +1,54 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/key_signing/ssl_private_key_signer.h"
+
+#include <utility>
+
+#include "absl/status/status.h"
+
+namespace tsi {
+
+ExternalSslPrivateKeySigner::~ExternalSslPrivateKeySigner() {
+  if (external_signer_.destruct != nullptr) {
+    external_signer_.destruct(external_signer_.user_data);
+  }
+}
+
+void ExternalSslPrivateKeySigner::Sign(absl::string_view input,
+                                       uint16_t signature_algorithm,
+                                       OnSignDone on_done) {
+  external_signer_.sign(external_signer_.user_data, input.data(), input.size(),
+                        signature_algorithm, OnSignDoneCallback,
+                        new OnSignDone(std::move(on_done)));
+}
+
+void ExternalSslPrivateKeySigner::OnSignDoneCallback(
+    void* callback_arg, grpc_status_code status, const char* error_details,
+    const char* signature, size_t signature_size) {
+  auto* on_done = static_cast<OnSignDone*>(callback_arg);
+  if (status == GRPC_STATUS_OK) {
+    (*on_done)(std::string(signature, signature_size));
+  } else {
+    (*on_done)(absl::Status(static_cast<absl::StatusCode>(status),
+                            error_details == nullptr ? "" : error_details));
+  }
+  delete on_done;
+}
+
+}  // namespace tsi
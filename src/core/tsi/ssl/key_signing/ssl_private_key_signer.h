@@ -0,0 +1,82 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_TSI_SSL_KEY_SIGNING_SSL_PRIVATE_KEY_SIGNER_H
+#define GRPC_CORE_TSI_SSL_KEY_SIGNING_SSL_PRIVATE_KEY_SIGNER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/grpc_security.h>
+
+#include "src/core/lib/gprpp/cpp_impl_of.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+
+namespace tsi {
+
+/// Signs on behalf of a TLS server whose private key is not loaded in the
+/// process, e.g. because it is held by a hardware accelerator, an HSM or a
+/// remote key service.
+///
+/// The handshake does not wait for the signature: the handshaker goes
+/// asynchronous while the signing is in flight, and resumes from the thread
+/// that delivers the signature.
+class SslPrivateKeySigner
+    : public grpc_core::CppImplOf<SslPrivateKeySigner,
+                                  grpc_tls_private_key_signer>,
+      public grpc_core::RefCounted<SslPrivateKeySigner> {
+ public:
+  using OnSignDone = absl::AnyInvocable<void(absl::StatusOr<std::string>)>;
+
+  /// Signs \a input with the server's private key, using the TLS
+  /// SignatureScheme \a signature_algorithm (RFC 8446, section 4.2.3), and
+  /// invokes \a on_done with the signature. \a on_done may be invoked before
+  /// Sign() returns, or later from any thread. \a input is only valid until
+  /// Sign() returns.
+  virtual void Sign(absl::string_view input, uint16_t signature_algorithm,
+                    OnSignDone on_done) = 0;
+};
+
+/// A signer implemented through the C API.
+class ExternalSslPrivateKeySigner : public SslPrivateKeySigner {
+ public:
+  explicit ExternalSslPrivateKeySigner(
+      const grpc_tls_private_key_signer_external& external_signer)
+      : external_signer_(external_signer) {}
+
+  ~ExternalSslPrivateKeySigner() override;
+
+  void Sign(absl::string_view input, uint16_t signature_algorithm,
+            OnSignDone on_done) override;
+
+ private:
+  static void OnSignDoneCallback(void* callback_arg, grpc_status_code status,
+                                 const char* error_details,
+                                 const char* signature, size_t signature_size);
+
+  const grpc_tls_private_key_signer_external external_signer_;
+};
+
+}  // namespace tsi
+
+#endif  // GRPC_CORE_TSI_SSL_KEY_SIGNING_SSL_PRIVATE_KEY_SIGNER_H
@@ -0,0 +1,63 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/session_cache/ssl_session_ticket_keys.h"
+
+#include <string.h>
+
+#include <openssl/rand.h>
+
+#include <grpc/support/log.h>
+
+namespace tsi {
+
+SslSessionTicketKeys::SslSessionTicketKeys() {
+  Key key;
+  GPR_ASSERT(RAND_bytes(reinterpret_cast<uint8_t*>(&key), sizeof(key)) == 1);
+  keys_.push_front(key);
+}
+
+bool SslSessionTicketKeys::Rotate(absl::string_view key) {
+  if (key.size() != kKeySize) return false;
+  Key new_key;
+  memcpy(&new_key, key.data(), kKeySize);
+  grpc_core::MutexLock lock(&mu_);
+  keys_.push_front(new_key);
+  if (keys_.size() > kMaxKeys) keys_.pop_back();
+  return true;
+}
+
+SslSessionTicketKeys::Key SslSessionTicketKeys::EncryptionKey() {
+  grpc_core::MutexLock lock(&mu_);
+  return keys_.front();
+}
+
+bool SslSessionTicketKeys::DecryptionKey(const uint8_t* name, Key* key,
+                                         bool* renew) {
+  grpc_core::MutexLock lock(&mu_);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    if (memcmp(keys_[i].name, name, sizeof(keys_[i].name)) == 0) {
+      *key = keys_[i];
+      *renew = i != 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace tsi
@@ -0,0 +1,93 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_TICKET_KEYS_H
+#define GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_TICKET_KEYS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/grpc_security.h>
+
+#include "src/core/lib/gprpp/cpp_impl_of.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace tsi {
+
+/// The session ticket encryption keys a TLS server encrypts the session
+/// tickets it issues with, and decrypts the ones clients resume sessions
+/// with.
+///
+/// Servers sharing one instance resume each other's sessions. The keys can
+/// be rotated while they are in use: new tickets are always encrypted with
+/// the newest key, and tickets encrypted with one of the kMaxKeys - 1 keys
+/// before it are still accepted, and renewed.
+///
+/// This class is thread safe.
+class SslSessionTicketKeys
+    : public grpc_core::CppImplOf<SslSessionTicketKeys,
+                                  grpc_ssl_session_ticket_keys>,
+      public grpc_core::RefCounted<SslSessionTicketKeys> {
+ public:
+  struct Key {
+    uint8_t name[16];
+    uint8_t hmac_key[16];
+    uint8_t aes_key[16];
+  };
+
+  /// The size of a serialized key: its name, followed by its HMAC-SHA256 key
+  /// and its AES-128 key.
+  static constexpr size_t kKeySize = sizeof(Key);
+  /// The number of keys tickets are accepted from.
+  static constexpr size_t kMaxKeys = 3;
+
+  /// Creates keys holding a single random key.
+  SslSessionTicketKeys();
+
+  // Not copyable nor movable.
+  SslSessionTicketKeys(const SslSessionTicketKeys&) = delete;
+  SslSessionTicketKeys& operator=(const SslSessionTicketKeys&) = delete;
+
+  /// Makes \a key the key new tickets are encrypted with, and forgets the
+  /// oldest key if there are more than kMaxKeys. Returns false if \a key is
+  /// not kKeySize bytes.
+  bool Rotate(absl::string_view key);
+
+  /// Returns the key to encrypt a new ticket with.
+  Key EncryptionKey();
+
+  /// Looks up the key named \a name to decrypt a ticket with. Returns false
+  /// if there is no such key, and sets \a renew if the ticket should be
+  /// replaced with one encrypted with the newest key.
+  bool DecryptionKey(const uint8_t* name, Key* key, bool* renew);
+
+ private:
+  grpc_core::Mutex mu_;
+  // Newest first.
+  std::deque<Key> keys_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace tsi
+
+#endif  // GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_TICKET_KEYS_H
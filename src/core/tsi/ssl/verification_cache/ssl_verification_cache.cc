@@ -0,0 +1,105 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/verification_cache/ssl_verification_cache.h"
+
+#include <openssl/evp.h>
+
+namespace tsi {
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+namespace {
+
+// Appends the SHA-256 digest of cert to key, unless cert has expired.
+bool AppendCurrentCertDigest(X509* cert, std::string* key) {
+  if (X509_cmp_current_time(X509_get0_notAfter(cert)) <= 0) return false;
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size = 0;
+  if (X509_digest(cert, EVP_sha256(), digest, &digest_size) != 1) {
+    return false;
+  }
+  key->append(reinterpret_cast<const char*>(digest), digest_size);
+  return true;
+}
+
+}  // namespace
+#endif
+
+int SslVerificationCache::VerifyCallback(X509_STORE_CTX* ctx, void* arg) {
+  return static_cast<SslVerificationCache*>(arg)->Verify(ctx);
+}
+
+int SslVerificationCache::Verify(X509_STORE_CTX* ctx) {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+  X509* leaf = X509_STORE_CTX_get0_cert(ctx);
+  STACK_OF(X509)* chain = X509_STORE_CTX_get0_untrusted(ctx);
+  std::string key;
+  bool cacheable = leaf != nullptr && AppendCurrentCertDigest(leaf, &key);
+  for (size_t i = 0; cacheable && chain != nullptr &&
+                     i < static_cast<size_t>(sk_X509_num(chain));
+       ++i) {
+    cacheable = AppendCurrentCertDigest(sk_X509_value(chain, i), &key);
+  }
+  if (!cacheable) return X509_verify_cert(ctx);
+  if (Lookup(key)) return 1;
+  int result = X509_verify_cert(ctx);
+  if (result == 1) Insert(key);
+  return result;
+#else
+  return X509_verify_cert(ctx);
+#endif
+}
+
+size_t SslVerificationCache::Size() {
+  grpc_core::MutexLock lock(&mu_);
+  return entries_.size();
+}
+
+bool SslVerificationCache::Lookup(const std::string& key) {
+  grpc_core::MutexLock lock(&mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), it->second.expiry) >= 0) {
+    use_order_.erase(it->second.use_order_it);
+    entries_.erase(it);
+    return false;
+  }
+  use_order_.splice(use_order_.begin(), use_order_, it->second.use_order_it);
+  return true;
+}
+
+void SslVerificationCache::Insert(const std::string& key) {
+  gpr_timespec expiry =
+      gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                   gpr_time_from_seconds(kMaxAgeSeconds, GPR_TIMESPAN));
+  grpc_core::MutexLock lock(&mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second.expiry = expiry;
+    use_order_.splice(use_order_.begin(), use_order_, it->second.use_order_it);
+    return;
+  }
+  use_order_.push_front(key);
+  entries_.emplace(key, Entry{expiry, use_order_.begin()});
+  if (entries_.size() > capacity_) {
+    entries_.erase(use_order_.back());
+    use_order_.pop_back();
+  }
+}
+
+}  // namespace tsi
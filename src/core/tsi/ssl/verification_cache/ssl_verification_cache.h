@@ -0,0 +1,96 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_TSI_SSL_VERIFICATION_CACHE_SSL_VERIFICATION_CACHE_H
+#define GRPC_CORE_TSI_SSL_VERIFICATION_CACHE_SSL_VERIFICATION_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <list>
+#include <string>
+
+#include <openssl/x509.h>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace tsi {
+
+/// Remembers the peer certificate chains a handshaker factory verified
+/// recently, so that handshakes presenting one of them again skip chain
+/// building and signature checks.
+///
+/// A chain is identified by the SHA-256 digests of its certificates. The
+/// root certificates it is verified against are those of the handshaker
+/// factory, which is recreated when they change, so the cache is too.
+/// Entries are forgotten after kMaxAge, and a chain with an expired
+/// certificate is verified again (and fails).
+///
+/// Only successful verifications are remembered, and the least recently
+/// used ones are evicted beyond the capacity.
+///
+/// This class is thread safe.
+class SslVerificationCache
+    : public grpc_core::RefCounted<SslVerificationCache> {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+  static constexpr int kMaxAgeSeconds = 600;
+
+  explicit SslVerificationCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity) {}
+
+  // Not copyable nor movable.
+  SslVerificationCache(const SslVerificationCache&) = delete;
+  SslVerificationCache& operator=(const SslVerificationCache&) = delete;
+
+  /// A callback for SSL_CTX_set_cert_verify_callback(), with the cache as
+  /// \a arg.
+  static int VerifyCallback(X509_STORE_CTX* ctx, void* arg);
+
+  /// Verifies the chain of \a ctx like X509_verify_cert() does, unless it was
+  /// verified recently.
+  int Verify(X509_STORE_CTX* ctx);
+
+  /// Returns the number of chains in the cache.
+  size_t Size();
+
+ private:
+  struct Entry {
+    gpr_timespec expiry;
+    std::list<std::string>::iterator use_order_it;
+  };
+
+  // Returns whether the chain identified by key was verified recently.
+  bool Lookup(const std::string& key);
+  void Insert(const std::string& key);
+
+  const size_t capacity_;
+  grpc_core::Mutex mu_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  // The keys of the entries, most recently used first.
+  std::list<std::string> use_order_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace tsi
+
+#endif  // GRPC_CORE_TSI_SSL_VERIFICATION_CACHE_SSL_VERIFICATION_CACHE_H
@@ -18,6 +18,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/iomgr/port.h"
+
 #include "src/core/tsi/ssl_transport_security.h"
 
 #include <limits.h>
@@ -33,20 +35,36 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
 #include <string>
+#include <utility>
+
+#if defined(GRPC_LINUX_KTLS) && defined(OPENSSL_IS_BORINGSSL)
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
 
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
 
+#include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc_security.h>
 #include <grpc/support/alloc.h>
@@ -55,11 +73,18 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/slice/slice_buffer.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
+#include "src/core/tsi/ssl/key_signing/ssl_private_key_signer.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+#include "src/core/tsi/ssl/verification_cache/ssl_verification_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -98,6 +123,7 @@ struct tsi_ssl_client_handshaker_factory {
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<tsi::SslSessionLRUCache> session_cache;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  grpc_core::RefCountedPtr<tsi::SslVerificationCache> verification_cache;
 };
 
 struct tsi_ssl_server_handshaker_factory {
@@ -111,8 +137,13 @@ struct tsi_ssl_server_handshaker_factory {
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys> session_ticket_keys;
+  grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer;
+  grpc_core::RefCountedPtr<tsi::SslVerificationCache> verification_cache;
 };
 
+class SslPrivateKeyOperation;
+
 struct tsi_ssl_handshaker {
   tsi_handshaker base;
   SSL* ssl;
@@ -121,6 +152,14 @@ struct tsi_ssl_handshaker {
   unsigned char* outgoing_bytes_buffer;
   size_t outgoing_bytes_buffer_size;
   tsi_ssl_handshaker_factory* factory_ref;
+  /* The private key operation in flight, if any. */
+  SslPrivateKeyOperation* private_key_operation;
+  /* The state of the ssl_handshaker_next() call in progress, for resuming it
+     once the private key operation it waits for completes. */
+  size_t next_received_bytes_size;
+  size_t next_bytes_written;
+  tsi_handshaker_on_next_done_cb next_cb;
+  void* next_user_data;
 };
 struct tsi_ssl_handshaker_result {
   tsi_handshaker_result base;
@@ -137,10 +176,27 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+#ifdef OPENSSL_IS_BORINGSSL
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  size_t max_frame_size;
+  /* The largest plaintext sealed into a single record. */
+  size_t max_record_plaintext_size;
+  /* Holds the plaintext of a record while it is sealed. */
+  grpc_slice_buffer record_plaintext;
+  /* Where the plaintext of records spanning several slices is gathered. */
+  unsigned char* record_buffer;
+  /* The unused tail of the slice that unprotected bytes are read into. */
+  grpc_slice read_slice;
+};
+#endif /* OPENSSL_IS_BORINGSSL */
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
 static int g_ssl_ctx_ex_factory_index = -1;
+static int g_ssl_ex_handshaker_index = -1;
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -191,6 +247,9 @@ static void init_openssl(void) {
   g_ssl_ctx_ex_factory_index =
       SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
   GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+  g_ssl_ex_handshaker_index =
+      SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  GPR_ASSERT(g_ssl_ex_handshaker_index != -1);
 }
 
 /* --- Ssl utils. ---*/
@@ -832,6 +891,23 @@ static tsi_result ssl_ctx_load_verification_certs(SSL_CTX* context,
                                root_name);
 }
 
+/* Makes the SSL context skip the verification of the peer certificate chains
+   it verified recently, unless CRLs are checked: those may revoke a chain
+   while it is cached. */
+static void ssl_ctx_use_verification_cache(
+    SSL_CTX* context, const char* crl_directory,
+    grpc_core::RefCountedPtr<tsi::SslVerificationCache>* verification_cache) {
+  if (!grpc_core::IsTlsVerificationCacheEnabled()) return;
+  if (crl_directory != nullptr && strcmp(crl_directory, "") != 0) return;
+  if (*verification_cache == nullptr) {
+    *verification_cache =
+        grpc_core::MakeRefCounted<tsi::SslVerificationCache>();
+  }
+  SSL_CTX_set_cert_verify_callback(context,
+                                   tsi::SslVerificationCache::VerifyCallback,
+                                   verification_cache->get());
+}
+
 /* Populates the SSL context with a private key and a cert chain, and sets the
    cipher list and the ephemeral ECDH key. */
 static tsi_result populate_ssl_context(
@@ -1200,6 +1276,166 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+#ifdef OPENSSL_IS_BORINGSSL
+
+/* Moves the bytes that SSL wrote itself to the network BIO, e.g. in response
+   to post-handshake messages, to |protected_slices|. */
+static tsi_result ssl_zero_copy_protector_flush_network_io(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* protected_slices) {
+  size_t pending = BIO_pending(impl->network_io);
+  if (pending == 0) return TSI_OK;
+  GPR_ASSERT(pending <= INT_MAX);
+  grpc_slice slice = GRPC_SLICE_MALLOC(pending);
+  int read_from_ssl = BIO_read(impl->network_io, GRPC_SLICE_START_PTR(slice),
+                               static_cast<int>(pending));
+  if (read_from_ssl != static_cast<int>(pending)) {
+    gpr_log(GPR_ERROR,
+            "Could not read from BIO even though some data is pending");
+    grpc_slice_unref(slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, slice);
+  return TSI_OK;
+}
+
+/* Seals each record straight from the application slices into its own output
+   slice. Only the plaintext of records spanning several slices is copied. */
+static tsi_result ssl_zero_copy_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result =
+      ssl_zero_copy_protector_flush_network_io(impl, protected_slices);
+  if (result != TSI_OK) return result;
+  while (unprotected_slices->length > 0) {
+    size_t plaintext_size =
+        std::min(unprotected_slices->length, impl->max_record_plaintext_size);
+    grpc_slice_buffer_move_first(unprotected_slices, plaintext_size,
+                                 &impl->record_plaintext);
+    const uint8_t* plaintext;
+    if (impl->record_plaintext.count == 1) {
+      plaintext = GRPC_SLICE_START_PTR(impl->record_plaintext.slices[0]);
+    } else {
+      grpc_slice_buffer_copy_first_into_buffer(
+          &impl->record_plaintext, plaintext_size, impl->record_buffer);
+      plaintext = impl->record_buffer;
+    }
+    size_t prefix_size = bssl::SealRecordPrefixLen(impl->ssl, plaintext_size);
+    size_t suffix_size = bssl::SealRecordSuffixLen(impl->ssl, plaintext_size);
+    grpc_slice record =
+        GRPC_SLICE_MALLOC(prefix_size + plaintext_size + suffix_size);
+    uint8_t* out = GRPC_SLICE_START_PTR(record);
+    ERR_clear_error();
+    bool sealed = bssl::SealRecord(
+        impl->ssl, bssl::MakeSpan(out, prefix_size),
+        bssl::MakeSpan(out + prefix_size, plaintext_size),
+        bssl::MakeSpan(out + prefix_size + plaintext_size, suffix_size),
+        bssl::MakeConstSpan(plaintext, plaintext_size));
+    grpc_slice_buffer_reset_and_unref(&impl->record_plaintext);
+    if (!sealed) {
+      gpr_log(GPR_ERROR, "Sealing a record failed.");
+      log_ssl_error_stack();
+      grpc_slice_unref(record);
+      return TSI_INTERNAL_ERROR;
+    }
+    grpc_slice_buffer_add(protected_slices, record);
+  }
+  return TSI_OK;
+}
+
+/* Reads all the unprotected bytes that SSL can produce, each record into its
+   own slice. */
+static tsi_result ssl_zero_copy_protector_read(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  while (true) {
+    if (GRPC_SLICE_LENGTH(impl->read_slice) == 0) {
+      grpc_slice_unref(impl->read_slice);
+      impl->read_slice =
+          GRPC_SLICE_MALLOC(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND);
+    }
+    size_t read_size = GRPC_SLICE_LENGTH(impl->read_slice);
+    tsi_result result = do_ssl_read(
+        impl->ssl, GRPC_SLICE_START_PTR(impl->read_slice), &read_size);
+    if (result != TSI_OK || read_size == 0) return result;
+    grpc_slice_buffer_add(unprotected_slices,
+                          grpc_slice_split_head(&impl->read_slice, read_size));
+  }
+}
+
+static tsi_result ssl_zero_copy_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices, int* min_progress_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  for (size_t i = 0; i < protected_slices->count; i++) {
+    const uint8_t* protected_bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t remaining = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    while (remaining > 0) {
+      /* The network BIO may be smaller than a record: SSL drains it as it
+         reads the record in. */
+      size_t to_write =
+          std::min(remaining, BIO_ctrl_get_write_guarantee(impl->network_io));
+      if (to_write == 0) {
+        gpr_log(GPR_ERROR, "No room left in BIO for the protected frames");
+        return TSI_INTERNAL_ERROR;
+      }
+      GPR_ASSERT(to_write <= INT_MAX);
+      int written_into_ssl = BIO_write(impl->network_io, protected_bytes,
+                                       static_cast<int>(to_write));
+      if (written_into_ssl <= 0) {
+        gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+                written_into_ssl);
+        return TSI_INTERNAL_ERROR;
+      }
+      protected_bytes += written_into_ssl;
+      remaining -= static_cast<size_t>(written_into_ssl);
+      tsi_result result =
+          ssl_zero_copy_protector_read(impl, unprotected_slices);
+      if (result != TSI_OK) return result;
+    }
+  }
+  grpc_slice_buffer_reset_and_unref(protected_slices);
+  if (min_progress_size != nullptr) *min_progress_size = 1;
+  return TSI_OK;
+}
+
+static void ssl_zero_copy_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  SSL_free(impl->ssl);
+  BIO_free(impl->network_io);
+  grpc_slice_buffer_destroy(&impl->record_plaintext);
+  gpr_free(impl->record_buffer);
+  grpc_slice_unref(impl->read_slice);
+  gpr_free(impl);
+}
+
+static tsi_result ssl_zero_copy_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  *max_frame_size =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self)->max_frame_size;
+  return TSI_OK;
+}
+
+/* Not full duplex: protect and unprotect share the SSL object and its network
+   BIO. */
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_protector_protect,
+        ssl_zero_copy_protector_unprotect,
+        ssl_zero_copy_protector_destroy,
+        ssl_zero_copy_protector_max_frame_size,
+};
+
+#endif /* OPENSSL_IS_BORINGSSL */
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1337,15 +1573,69 @@ static tsi_result ssl_handshaker_result_extract_peer(
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
     const tsi_handshaker_result* /*self*/,
     tsi_frame_protector_type* frame_protector_type) {
+#ifdef OPENSSL_IS_BORINGSSL
+  *frame_protector_type = grpc_core::IsSslZeroCopyProtectorEnabled()
+                              ? TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY
+                              : TSI_FRAME_PROTECTOR_NORMAL;
+#else
   *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL;
+#endif
   return TSI_OK;
 }
 
+/* Clamps the requested max protected frame size to the supported range, and
+   returns the size to use. */
+static size_t ssl_max_output_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
+  if (max_output_protected_frame_size == nullptr) {
+    return TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  }
+  if (*max_output_protected_frame_size >
+      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  } else if (*max_output_protected_frame_size <
+             TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
+  }
+  return *max_output_protected_frame_size;
+}
+
+#ifdef OPENSSL_IS_BORINGSSL
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->max_frame_size =
+      ssl_max_output_protected_frame_size(max_output_protected_frame_size);
+  protector_impl->max_record_plaintext_size =
+      protector_impl->max_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->record_buffer = static_cast<unsigned char*>(
+      gpr_malloc(protector_impl->max_record_plaintext_size));
+  grpc_slice_buffer_init(&protector_impl->record_plaintext);
+  protector_impl->read_slice = grpc_empty_slice();
+  /* Transfer ownership of ssl and network_io to the frame protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+#endif /* OPENSSL_IS_BORINGSSL */
+
 static tsi_result ssl_handshaker_result_create_frame_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_frame_protector** protector) {
   size_t actual_max_output_protected_frame_size =
-      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+      ssl_max_output_protected_frame_size(max_output_protected_frame_size);
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(
           const_cast<tsi_handshaker_result*>(self));
@@ -1353,18 +1643,6 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
       static_cast<tsi_ssl_frame_protector*>(
           gpr_zalloc(sizeof(*protector_impl)));
 
-  if (max_output_protected_frame_size != nullptr) {
-    if (*max_output_protected_frame_size >
-        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-    } else if (*max_output_protected_frame_size <
-               TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
-    }
-    actual_max_output_protected_frame_size = *max_output_protected_frame_size;
-  }
   protector_impl->buffer_size =
       actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
@@ -1405,13 +1683,131 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   gpr_free(impl);
 }
 
+#if defined(GRPC_LINUX_KTLS) && defined(OPENSSL_IS_BORINGSSL)
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+/* Installs the keys of one direction of a TLS 1.2 AES-GCM session on |fd|. */
+template <typename CryptoInfo>
+static bool ssl_install_kernel_keys(int fd, int direction,
+                                    uint16_t cipher_type, const uint8_t* key,
+                                    const uint8_t* salt, uint64_t sequence) {
+  CryptoInfo crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  memcpy(crypto_info.key, key, sizeof(crypto_info.key));
+  memcpy(crypto_info.salt, salt, sizeof(crypto_info.salt));
+  for (size_t i = 0; i < sizeof(crypto_info.rec_seq); ++i) {
+    crypto_info.rec_seq[i] = static_cast<unsigned char>(
+        sequence >> (8 * (sizeof(crypto_info.rec_seq) - 1 - i)));
+  }
+  /* BoringSSL uses the sequence number as the explicit nonce. */
+  memcpy(crypto_info.iv, crypto_info.rec_seq, sizeof(crypto_info.iv));
+  bool ok = setsockopt(fd, SOL_TLS, direction, &crypto_info,
+                       sizeof(crypto_info)) == 0;
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return ok;
+}
+
+/* Only TLS 1.2 sessions are offloaded: the kernel cannot process the
+   post-handshake messages that TLS 1.3 peers may send. */
+static tsi_result ssl_handshaker_result_offload_to_kernel(
+    const tsi_handshaker_result* self, int fd) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  /* The records that were already received, or are still to be sent, would
+     have to be protected in user space. */
+  if (impl->ssl == nullptr || SSL_version(impl->ssl) != TLS1_2_VERSION ||
+      impl->unused_bytes_size > 0 || SSL_pending(impl->ssl) > 0 ||
+      BIO_ctrl_pending(impl->network_io) > 0) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(impl->ssl);
+  if (cipher == nullptr) return TSI_UNIMPLEMENTED;
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_size;
+  if (cipher_nid == NID_aes_128_gcm) {
+    key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+#ifdef TLS_CIPHER_AES_GCM_256
+  } else if (cipher_nid == NID_aes_256_gcm) {
+    key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+#endif
+  } else {
+    return TSI_UNIMPLEMENTED;
+  }
+  /* With an AEAD, the key block holds the client and server write keys,
+     followed by their implicit nonces. */
+  const size_t salt_size = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+  uint8_t key_block[2 * (32 + TLS_CIPHER_AES_GCM_128_SALT_SIZE)];
+  const size_t key_block_size = SSL_get_key_block_len(impl->ssl);
+  if (key_block_size != 2 * (key_size + salt_size) ||
+      key_block_size > sizeof(key_block)) {
+    return TSI_UNIMPLEMENTED;
+  }
+  if (!SSL_generate_key_block(impl->ssl, key_block, key_block_size)) {
+    return TSI_INTERNAL_ERROR;
+  }
+  const bool is_server = SSL_is_server(impl->ssl);
+  const uint8_t* client_key = key_block;
+  const uint8_t* server_key = key_block + key_size;
+  const uint8_t* client_salt = key_block + 2 * key_size;
+  const uint8_t* server_salt = client_salt + salt_size;
+  const uint8_t* read_key = is_server ? client_key : server_key;
+  const uint8_t* read_salt = is_server ? client_salt : server_salt;
+  const uint8_t* write_key = is_server ? server_key : client_key;
+  const uint8_t* write_salt = is_server ? server_salt : client_salt;
+  auto install_keys = [&](int direction, const uint8_t* key,
+                          const uint8_t* salt, uint64_t sequence) {
+#ifdef TLS_CIPHER_AES_GCM_256
+    if (cipher_nid == NID_aes_256_gcm) {
+      return ssl_install_kernel_keys<tls12_crypto_info_aes_gcm_256>(
+          fd, direction, TLS_CIPHER_AES_GCM_256, key, salt, sequence);
+    }
+#endif
+    return ssl_install_kernel_keys<tls12_crypto_info_aes_gcm_128>(
+        fd, direction, TLS_CIPHER_AES_GCM_128, key, salt, sequence);
+  };
+  tsi_result result = TSI_OK;
+  /* Until the receive keys are installed, the socket still carries the bytes
+     as they are, so the connection can be protected in user space instead. */
+  if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      !install_keys(TLS_RX, read_key, read_salt,
+                    SSL_get_read_sequence(impl->ssl))) {
+    result = TSI_UNIMPLEMENTED;
+  } else if (!install_keys(TLS_TX, write_key, write_salt,
+                           SSL_get_write_sequence(impl->ssl))) {
+    gpr_log(GPR_ERROR, "Could not install the kernel TLS transmit keys.");
+    result = TSI_INTERNAL_ERROR;
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return result;
+}
+
+#endif /* defined(GRPC_LINUX_KTLS) && defined(OPENSSL_IS_BORINGSSL) */
+
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
+#ifdef OPENSSL_IS_BORINGSSL
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
+#else
     nullptr, /* create_zero_copy_grpc_protector */
+#endif
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+#if defined(GRPC_LINUX_KTLS) && defined(OPENSSL_IS_BORINGSSL)
+    ssl_handshaker_result_offload_to_kernel,
+#else
+    nullptr, /* offload_to_kernel */
+#endif
 };
 
 static tsi_result ssl_handshaker_result_create(
@@ -1473,6 +1869,117 @@ static tsi_result ssl_handshaker_get_result(tsi_ssl_handshaker* impl) {
   return impl->result;
 }
 
+static void ssl_handshaker_resume_next(tsi_ssl_handshaker* impl);
+
+/* --- Private key operations. --- */
+
+/* A signing operation of the server handshaker factory's private key signer
+   in flight. */
+class SslPrivateKeyOperation
+    : public grpc_core::RefCounted<SslPrivateKeyOperation> {
+ public:
+  /* Invoked with the outcome of the signing, from any thread. */
+  void Done(absl::StatusOr<std::string> signature) {
+    tsi_ssl_handshaker* waiting_handshaker;
+    {
+      grpc_core::MutexLock lock(&mu_);
+      signature_ = std::move(signature);
+      waiting_handshaker = std::exchange(waiting_handshaker_, nullptr);
+    }
+    if (waiting_handshaker != nullptr) {
+      ssl_handshaker_resume_next(waiting_handshaker);
+    }
+  }
+
+  /* Returns true, and resumes handshaker once the outcome of the signing is
+     in, if the signing is still in flight. */
+  bool WaitForSignature(tsi_ssl_handshaker* handshaker) {
+    grpc_core::MutexLock lock(&mu_);
+    if (signature_.has_value()) return false;
+    waiting_handshaker_ = handshaker;
+    return true;
+  }
+
+  /* Stops resuming the handshaker, which is being destroyed. */
+  void Cancel() {
+    grpc_core::MutexLock lock(&mu_);
+    waiting_handshaker_ = nullptr;
+  }
+
+  /* Returns the outcome of the signing, if it is in. */
+  absl::optional<absl::StatusOr<std::string>> TakeSignature() {
+    grpc_core::MutexLock lock(&mu_);
+    return std::exchange(signature_, absl::nullopt);
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  absl::optional<absl::StatusOr<std::string>> signature_ ABSL_GUARDED_BY(mu_);
+  tsi_ssl_handshaker* waiting_handshaker_ ABSL_GUARDED_BY(mu_) = nullptr;
+};
+
+#ifdef OPENSSL_IS_BORINGSSL
+static ssl_private_key_result_t ssl_private_key_complete(SSL* ssl,
+                                                         uint8_t* out,
+                                                         size_t* out_len,
+                                                         size_t max_out) {
+  tsi_ssl_handshaker* impl = static_cast<tsi_ssl_handshaker*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_handshaker_index));
+  SslPrivateKeyOperation* operation = impl->private_key_operation;
+  if (operation == nullptr) return ssl_private_key_failure;
+  absl::optional<absl::StatusOr<std::string>> signature =
+      operation->TakeSignature();
+  if (!signature.has_value()) return ssl_private_key_retry;
+  impl->private_key_operation = nullptr;
+  operation->Unref();
+  if (!signature->ok()) {
+    gpr_log(GPR_ERROR, "Private key signing failed: %s",
+            signature->status().ToString().c_str());
+    return ssl_private_key_failure;
+  }
+  if ((*signature)->size() > max_out) {
+    gpr_log(GPR_ERROR, "Signature of %zu bytes exceeds the maximum of %zu.",
+            (*signature)->size(), max_out);
+    return ssl_private_key_failure;
+  }
+  memcpy(out, (*signature)->data(), (*signature)->size());
+  *out_len = (*signature)->size();
+  return ssl_private_key_success;
+}
+
+static ssl_private_key_result_t ssl_private_key_sign(
+    SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+    uint16_t signature_algorithm, const uint8_t* in, size_t in_len) {
+  tsi_ssl_handshaker* impl = static_cast<tsi_ssl_handshaker*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_handshaker_index));
+  tsi_ssl_server_handshaker_factory* factory =
+      reinterpret_cast<tsi_ssl_server_handshaker_factory*>(impl->factory_ref);
+  GPR_ASSERT(impl->private_key_operation == nullptr);
+  impl->private_key_operation = new SslPrivateKeyOperation();
+  factory->private_key_signer->Sign(
+      absl::string_view(reinterpret_cast<const char*>(in), in_len),
+      signature_algorithm,
+      [operation = impl->private_key_operation->Ref()](
+          absl::StatusOr<std::string> signature) {
+        operation->Done(std::move(signature));
+      });
+  // The signer may have already delivered the signature.
+  return ssl_private_key_complete(ssl, out, out_len, max_out);
+}
+
+static ssl_private_key_result_t ssl_private_key_decrypt(
+    SSL* /*ssl*/, uint8_t* /*out*/, size_t* /*out_len*/, size_t /*max_out*/,
+    const uint8_t* /*in*/, size_t /*in_len*/) {
+  // Only the RSA key exchange decrypts with the private key, and none of the
+  // cipher suites gRPC enables use it.
+  gpr_log(GPR_ERROR, "Private key signers do not support decryption.");
+  return ssl_private_key_failure;
+}
+
+static const SSL_PRIVATE_KEY_METHOD kSslPrivateKeyMethod = {
+    ssl_private_key_sign, ssl_private_key_decrypt, ssl_private_key_complete};
+#endif /* OPENSSL_IS_BORINGSSL */
+
 static tsi_result ssl_handshaker_do_handshake(tsi_ssl_handshaker* impl,
                                               std::string* error) {
   if (ssl_handshaker_get_result(impl) != TSI_HANDSHAKE_IN_PROGRESS) {
@@ -1495,6 +2002,15 @@ static tsi_result ssl_handshaker_do_handshake(tsi_ssl_handshaker* impl,
         return TSI_OK;
       case SSL_ERROR_WANT_WRITE:
         return TSI_DRAIN_BUFFER;
+#ifdef OPENSSL_IS_BORINGSSL
+      case SSL_ERROR_WANT_PRIVATE_KEY_OPERATION:
+        /* Unless the signature is in already, the handshake is resumed by
+           ssl_handshaker_resume_next() once it is. */
+        if (impl->private_key_operation->WaitForSignature(impl)) {
+          return TSI_ASYNC;
+        }
+        return ssl_handshaker_do_handshake(impl, error);
+#endif
       default: {
         char err_str[256];
         ERR_error_string_n(ERR_get_error(), err_str, sizeof(err_str));
@@ -1533,6 +2049,10 @@ static tsi_result ssl_handshaker_process_bytes_from_peer(
 
 static void ssl_handshaker_destroy(tsi_handshaker* self) {
   tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
+  if (impl->private_key_operation != nullptr) {
+    impl->private_key_operation->Cancel();
+    impl->private_key_operation->Unref();
+  }
   SSL_free(impl->ssl);
   BIO_free(impl->network_io);
   gpr_free(impl->outgoing_bytes_buffer);
@@ -1600,41 +2120,26 @@ static tsi_result ssl_handshaker_write_output_buffer(tsi_handshaker* self,
   return status;
 }
 
-static tsi_result ssl_handshaker_next(tsi_handshaker* self,
-                                      const unsigned char* received_bytes,
-                                      size_t received_bytes_size,
-                                      const unsigned char** bytes_to_send,
-                                      size_t* bytes_to_send_size,
-                                      tsi_handshaker_result** handshaker_result,
-                                      tsi_handshaker_on_next_done_cb /*cb*/,
-                                      void* /*user_data*/, std::string* error) {
-  /* Input sanity check.  */
-  if ((received_bytes_size > 0 && received_bytes == nullptr) ||
-      bytes_to_send == nullptr || bytes_to_send_size == nullptr ||
-      handshaker_result == nullptr) {
-    if (error != nullptr) *error = "invalid argument";
-    return TSI_INVALID_ARGUMENT;
-  }
-  /* If there are received bytes, process them first.  */
-  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
-  tsi_result status = TSI_OK;
-  size_t bytes_consumed = received_bytes_size;
-  size_t bytes_written = 0;
-  if (received_bytes_size > 0) {
-    status = ssl_handshaker_process_bytes_from_peer(impl, received_bytes,
-                                                    &bytes_consumed, error);
-    while (status == TSI_DRAIN_BUFFER) {
-      status = ssl_handshaker_write_output_buffer(self, &bytes_written, error);
-      if (status != TSI_OK) return status;
-      status = ssl_handshaker_do_handshake(impl, error);
-    }
+/* Drains the bytes to send to the peer, and creates the handshaker result
+   if the handshake is complete, for the ssl_handshaker_next() call in
+   progress. */
+static tsi_result ssl_handshaker_finish_next(
+    tsi_ssl_handshaker* impl, tsi_result status,
+    const unsigned char** bytes_to_send, size_t* bytes_to_send_size,
+    tsi_handshaker_result** handshaker_result, std::string* error) {
+  while (status == TSI_DRAIN_BUFFER) {
+    status = ssl_handshaker_write_output_buffer(
+        &impl->base, &impl->next_bytes_written, error);
+    if (status != TSI_OK) return status;
+    status = ssl_handshaker_do_handshake(impl, error);
   }
   if (status != TSI_OK) return status;
   /* Get bytes to send to the peer, if available.  */
-  status = ssl_handshaker_write_output_buffer(self, &bytes_written, error);
+  status = ssl_handshaker_write_output_buffer(
+      &impl->base, &impl->next_bytes_written, error);
   if (status != TSI_OK) return status;
   *bytes_to_send = impl->outgoing_bytes_buffer;
-  *bytes_to_send_size = bytes_written;
+  *bytes_to_send_size = impl->next_bytes_written;
   /* If handshake completes, create tsi_handshaker_result.  */
   if (ssl_handshaker_get_result(impl) == TSI_HANDSHAKE_IN_PROGRESS) {
     *handshaker_result = nullptr;
@@ -1648,7 +2153,7 @@ static tsi_result ssl_handshaker_next(tsi_handshaker* self,
     status =
         ssl_bytes_remaining(impl, &unused_bytes, &unused_bytes_size, error);
     if (status != TSI_OK) return status;
-    if (unused_bytes_size > received_bytes_size) {
+    if (unused_bytes_size > impl->next_received_bytes_size) {
       gpr_log(GPR_ERROR, "More unused bytes than received bytes.");
       gpr_free(unused_bytes);
       if (error != nullptr) *error = "More unused bytes than received bytes.";
@@ -1659,12 +2164,67 @@ static tsi_result ssl_handshaker_next(tsi_handshaker* self,
     if (status == TSI_OK) {
       /* Indicates that the handshake has completed and that a handshaker_result
        * has been created. */
-      self->handshaker_result_created = true;
+      impl->base.handshaker_result_created = true;
     }
   }
   return status;
 }
 
+/* Resumes the ssl_handshaker_next() call that went asynchronous to wait for a
+   private key operation, and reports its outcome to its callback. */
+static void ssl_handshaker_resume_next(tsi_ssl_handshaker* impl) {
+  std::string error;
+  const unsigned char* bytes_to_send = nullptr;
+  size_t bytes_to_send_size = 0;
+  tsi_handshaker_result* handshaker_result = nullptr;
+  tsi_result status = ssl_handshaker_finish_next(
+      impl, ssl_handshaker_do_handshake(impl, &error), &bytes_to_send,
+      &bytes_to_send_size, &handshaker_result, &error);
+  if (status == TSI_ASYNC) return;
+  if (status != TSI_OK) {
+    bytes_to_send_size = 0;
+    if (!error.empty()) {
+      gpr_log(GPR_ERROR, "SSL handshake failed: %s", error.c_str());
+    }
+  }
+  impl->next_cb(status, impl->next_user_data, bytes_to_send,
+                bytes_to_send_size, handshaker_result);
+}
+
+static tsi_result ssl_handshaker_next(tsi_handshaker* self,
+                                      const unsigned char* received_bytes,
+                                      size_t received_bytes_size,
+                                      const unsigned char** bytes_to_send,
+                                      size_t* bytes_to_send_size,
+                                      tsi_handshaker_result** handshaker_result,
+                                      tsi_handshaker_on_next_done_cb cb,
+                                      void* user_data, std::string* error) {
+  /* Input sanity check.  */
+  if ((received_bytes_size > 0 && received_bytes == nullptr) ||
+      bytes_to_send == nullptr || bytes_to_send_size == nullptr ||
+      handshaker_result == nullptr) {
+    if (error != nullptr) *error = "invalid argument";
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
+  impl->next_received_bytes_size = received_bytes_size;
+  impl->next_bytes_written = 0;
+  impl->next_cb = cb;
+  impl->next_user_data = user_data;
+  /* If there are received bytes, process them first.  */
+  tsi_result status = TSI_OK;
+  size_t bytes_consumed = received_bytes_size;
+  if (received_bytes_size > 0) {
+    status = ssl_handshaker_process_bytes_from_peer(impl, received_bytes,
+                                                    &bytes_consumed, error);
+  }
+  /* A private key operation makes the call asynchronous, in which case impl
+     may already be in use by ssl_handshaker_resume_next().  */
+  return ssl_handshaker_finish_next(impl, status, bytes_to_send,
+                                    bytes_to_send_size, handshaker_result,
+                                    error);
+}
+
 static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr, /* get_bytes_to_send_to_peer -- deprecated */
     nullptr, /* process_bytes_from_peer   -- deprecated */
@@ -1761,6 +2321,7 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
       static_cast<unsigned char*>(gpr_zalloc(impl->outgoing_bytes_buffer_size));
   impl->base.vtable = &handshaker_vtable;
   impl->factory_ref = tsi_ssl_handshaker_factory_ref(factory);
+  SSL_set_ex_data(ssl, g_ssl_ex_handshaker_index, impl);
   *handshaker = &impl->base;
   return TSI_OK;
 }
@@ -1819,6 +2380,7 @@ static void tsi_ssl_client_handshaker_factory_destroy(
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->session_cache.reset();
   self->key_logger.reset();
+  self->verification_cache.reset();
   gpr_free(self);
 }
 
@@ -1869,6 +2431,9 @@ static void tsi_ssl_server_handshaker_factory_destroy(
   }
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->key_logger.reset();
+  self->session_ticket_keys.reset();
+  self->private_key_signer.reset();
+  self->verification_cache.reset();
   gpr_free(self);
 }
 
@@ -1935,6 +2500,60 @@ static int ssl_server_handshaker_factory_servername_callback(SSL* ssl,
   return SSL_TLSEXT_ERR_NOACK;
 }
 
+/* Encrypts new session tickets with the newest of the factory's session ticket
+   keys, and decrypts the tickets presented by clients with the key they were
+   encrypted with. Returns 0 if that key is unknown, which makes for a full
+   handshake, and 2 if it is not the newest, which also renews the ticket. */
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static int ssl_server_handshaker_factory_ticket_key_callback(
+    SSL* ssl, unsigned char* key_name, unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx, EVP_MAC_CTX* mac_ctx, int encrypt) {
+#else
+static int ssl_server_handshaker_factory_ticket_key_callback(
+    SSL* ssl, unsigned char* key_name, unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx, int encrypt) {
+#endif
+  tsi_ssl_server_handshaker_factory* factory =
+      static_cast<tsi_ssl_server_handshaker_factory*>(SSL_CTX_get_ex_data(
+          SSL_get_SSL_CTX(ssl), g_ssl_ctx_ex_factory_index));
+  tsi::SslSessionTicketKeys::Key key;
+  bool renew = false;
+  if (encrypt) {
+    key = factory->session_ticket_keys->EncryptionKey();
+    if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_128_cbc())) != 1) {
+      return -1;
+    }
+    memcpy(key_name, key.name, sizeof(key.name));
+    if (!EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr,
+                            key.aes_key, iv)) {
+      return -1;
+    }
+  } else {
+    if (!factory->session_ticket_keys->DecryptionKey(key_name, &key, &renew)) {
+      return 0;
+    }
+    if (!EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr,
+                            key.aes_key, iv)) {
+      return -1;
+    }
+  }
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                       const_cast<char*>("SHA256"), 0),
+      OSSL_PARAM_construct_end()};
+  if (!EVP_MAC_init(mac_ctx, key.hmac_key, sizeof(key.hmac_key), params)) {
+    return -1;
+  }
+#else
+  if (!HMAC_Init_ex(hmac_ctx, key.hmac_key, sizeof(key.hmac_key),
+                    EVP_sha256(), nullptr)) {
+    return -1;
+  }
+#endif
+  return renew ? 2 : 1;
+}
+
 #if TSI_OPENSSL_ALPN_SUPPORT
 static int server_handshaker_factory_alpn_callback(
     SSL* /*ssl*/, const unsigned char** out, unsigned char* outlen,
@@ -2142,6 +2761,8 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
     SSL_CTX_set_verify(ssl_context, SSL_VERIFY_PEER, NullVerifyCallback);
   } else {
     SSL_CTX_set_verify(ssl_context, SSL_VERIFY_PEER, nullptr);
+    ssl_ctx_use_verification_cache(ssl_context, options->crl_directory,
+                                   &impl->verification_cache);
   }
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -2246,6 +2867,20 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
     impl->key_logger = options->key_logger->Ref();
   }
 
+  if (options->session_ticket_keys != nullptr) {
+    impl->session_ticket_keys = options->session_ticket_keys->Ref();
+  }
+
+  if (options->private_key_signer != nullptr) {
+#ifdef OPENSSL_IS_BORINGSSL
+    impl->private_key_signer = options->private_key_signer->Ref();
+#else
+    gpr_log(GPR_ERROR, "Private key signers are only supported by BoringSSL.");
+    tsi_ssl_handshaker_factory_unref(&impl->base);
+    return TSI_UNIMPLEMENTED;
+#endif
+  }
+
   for (i = 0; i < options->num_key_cert_pairs; i++) {
     do {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -2265,10 +2900,20 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
                                                 options->max_tls_version);
       if (result != TSI_OK) return result;
 
-      result = populate_ssl_context(impl->ssl_contexts[i],
-                                    &options->pem_key_cert_pairs[i],
+      tsi_ssl_pem_key_cert_pair key_cert_pair = options->pem_key_cert_pairs[i];
+      if (impl->private_key_signer != nullptr) {
+        // The signer signs with the private key instead.
+        key_cert_pair.private_key = nullptr;
+      }
+      result = populate_ssl_context(impl->ssl_contexts[i], &key_cert_pair,
                                     options->cipher_suites);
       if (result != TSI_OK) break;
+#ifdef OPENSSL_IS_BORINGSSL
+      if (impl->private_key_signer != nullptr) {
+        SSL_CTX_set_private_key_method(impl->ssl_contexts[i],
+                                       &kSslPrivateKeyMethod);
+      }
+#endif
 
       // TODO(elessar): Provide ability to disable session ticket keys.
 
@@ -2282,7 +2927,20 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
         break;
       }
 
-      if (options->session_ticket_key != nullptr) {
+      if (options->session_ticket_keys != nullptr) {
+        // The callback finds the keys through the factory.
+        SSL_CTX_set_ex_data(impl->ssl_contexts[i], g_ssl_ctx_ex_factory_index,
+                            impl);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(
+            impl->ssl_contexts[i],
+            ssl_server_handshaker_factory_ticket_key_callback);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(
+            impl->ssl_contexts[i],
+            ssl_server_handshaker_factory_ticket_key_callback);
+#endif
+      } else if (options->session_ticket_key != nullptr) {
         if (SSL_CTX_set_tlsext_ticket_keys(
                 impl->ssl_contexts[i],
                 const_cast<char*>(options->session_ticket_key),
@@ -2314,6 +2972,9 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
           break;
         case TSI_REQUEST_CLIENT_CERTIFICATE_AND_VERIFY:
           SSL_CTX_set_verify(impl->ssl_contexts[i], SSL_VERIFY_PEER, nullptr);
+          ssl_ctx_use_verification_cache(impl->ssl_contexts[i],
+                                         options->crl_directory,
+                                         &impl->verification_cache);
           break;
         case TSI_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_BUT_DONT_VERIFY:
           SSL_CTX_set_verify(impl->ssl_contexts[i],
@@ -2324,6 +2985,9 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
           SSL_CTX_set_verify(impl->ssl_contexts[i],
                              SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
                              nullptr);
+          ssl_ctx_use_verification_cache(impl->ssl_contexts[i],
+                                         options->crl_directory,
+                                         &impl->verification_cache);
           break;
       }
 
@@ -28,6 +28,8 @@
 #include <grpc/grpc_security_constants.h>
 
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
+#include "src/core/tsi/ssl/key_signing/ssl_private_key_signer.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_ticket_keys.h"
 #include "src/core/tsi/transport_security_interface.h"
 
 /* Value for the TSI_CERTIFICATE_TYPE_PEER_PROPERTY property for X509 certs. */
@@ -310,6 +312,16 @@ struct tsi_ssl_server_handshaker_options {
   const char* session_ticket_key;
   /* session_ticket_key_size is a size of session ticket encryption key. */
   size_t session_ticket_key_size;
+  /* session_ticket_keys are optional rotatable keys for encrypting session
+     tickets, which may be shared by several factories so that their
+     handshakers resume each other's sessions. If set, session_ticket_key is
+     ignored. */
+  tsi::SslSessionTicketKeys* session_ticket_keys;
+  /* private_key_signer is an optional signer to perform the signing
+     operations of the handshakes with, for servers whose private key is not
+     loaded in the process. If set, the private keys of pem_key_cert_pairs are
+     ignored. Only supported with BoringSSL. */
+  tsi::SslPrivateKeySigner* private_key_signer;
   /* The min and max TLS versions that will be negotiated by the handshaker. */
   tsi_tls_version min_tls_version;
   tsi_tls_version max_tls_version;
@@ -332,6 +344,8 @@ struct tsi_ssl_server_handshaker_options {
         num_alpn_protocols(0),
         session_ticket_key(nullptr),
         session_ticket_key_size(0),
+        session_ticket_keys(nullptr),
+        private_key_signer(nullptr),
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
         key_logger(nullptr),
@@ -137,6 +137,11 @@ void tsi_frame_protector_destroy(tsi_frame_protector* self) {
   self->vtable->destroy(self);
 }
 
+bool tsi_frame_protector_is_full_duplex(const tsi_frame_protector* self) {
+  if (self == nullptr || self->vtable->is_full_duplex == nullptr) return false;
+  return self->vtable->is_full_duplex(self);
+}
+
 /* --- tsi_handshaker common implementation. ---
 
    Calls specific implementation after state/input validation. */
@@ -297,6 +302,15 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
   return self->vtable->get_unused_bytes(self, bytes, bytes_size);
 }
 
+tsi_result tsi_handshaker_result_offload_to_kernel(
+    const tsi_handshaker_result* self, int fd) {
+  if (self == nullptr || self->vtable == nullptr || fd < 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->offload_to_kernel == nullptr) return TSI_UNIMPLEMENTED;
+  return self->vtable->offload_to_kernel(self, fd);
+}
+
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self) {
   if (self == nullptr) return;
   self->vtable->destroy(self);
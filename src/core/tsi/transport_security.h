@@ -30,7 +30,7 @@ extern grpc_core::TraceFlag tsi_tracing_enabled;
 
 /* Base for tsi_frame_protector implementations.
    See transport_security_interface.h for documentation.
-   All methods must be implemented. */
+   All methods must be implemented, except is_full_duplex. */
 struct tsi_frame_protector_vtable {
   tsi_result (*protect)(tsi_frame_protector* self,
                         const unsigned char* unprotected_bytes,
@@ -47,6 +47,7 @@ struct tsi_frame_protector_vtable {
                           unsigned char* unprotected_bytes,
                           size_t* unprotected_bytes_size);
   void (*destroy)(tsi_frame_protector* self);
+  bool (*is_full_duplex)(const tsi_frame_protector* self);
 };
 struct tsi_frame_protector {
   const tsi_frame_protector_vtable* vtable;
@@ -118,6 +119,9 @@ struct tsi_handshaker_result_vtable {
                                  const unsigned char** bytes,
                                  size_t* bytes_size);
   void (*destroy)(tsi_handshaker_result* self);
+  /* May be null if the implementation cannot hand the protection of the
+     connection over to the kernel. */
+  tsi_result (*offload_to_kernel)(const tsi_handshaker_result* self, int fd);
 };
 struct tsi_handshaker_result {
   const tsi_handshaker_result_vtable* vtable;
@@ -72,3 +72,9 @@ tsi_result tsi_zero_copy_grpc_protector_max_frame_size(
   if (self->vtable->max_frame_size == nullptr) return TSI_UNIMPLEMENTED;
   return self->vtable->max_frame_size(self, max_frame_size);
 }
+
+bool tsi_zero_copy_grpc_protector_is_full_duplex(
+    const tsi_zero_copy_grpc_protector* self) {
+  if (self == nullptr || self->vtable->is_full_duplex == nullptr) return false;
+  return self->vtable->is_full_duplex(self);
+}
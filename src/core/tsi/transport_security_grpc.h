@@ -63,6 +63,13 @@ void tsi_zero_copy_grpc_protector_destroy(tsi_zero_copy_grpc_protector* self);
 tsi_result tsi_zero_copy_grpc_protector_max_frame_size(
     tsi_zero_copy_grpc_protector* self, size_t* max_frame_size);
 
+/* Returns whether tsi_zero_copy_grpc_protector_protect may be called
+   concurrently with tsi_zero_copy_grpc_protector_unprotect, because the
+   protect and unprotect sides of the object share no state. Otherwise, the
+   caller needs to serialize all the calls on the object.  */
+bool tsi_zero_copy_grpc_protector_is_full_duplex(
+    const tsi_zero_copy_grpc_protector* self);
+
 /* Base for tsi_zero_copy_grpc_protector implementations.  */
 struct tsi_zero_copy_grpc_protector_vtable {
   tsi_result (*protect)(tsi_zero_copy_grpc_protector* self,
@@ -75,6 +82,7 @@ struct tsi_zero_copy_grpc_protector_vtable {
   void (*destroy)(tsi_zero_copy_grpc_protector* self);
   tsi_result (*max_frame_size)(tsi_zero_copy_grpc_protector* self,
                                size_t* max_frame_size);
+  bool (*is_full_duplex)(const tsi_zero_copy_grpc_protector* self);
 };
 struct tsi_zero_copy_grpc_protector {
   const tsi_zero_copy_grpc_protector_vtable* vtable;
@@ -217,6 +217,13 @@ tsi_result tsi_frame_protector_unprotect(
 /* Destroys the tsi_frame_protector object.  */
 void tsi_frame_protector_destroy(tsi_frame_protector* self);
 
+/* Returns whether tsi_frame_protector_protect and
+   tsi_frame_protector_protect_flush may be called concurrently with
+   tsi_frame_protector_unprotect, because the protect and unprotect sides of
+   the object share no state. Otherwise, the caller needs to serialize all the
+   calls on the object.  */
+bool tsi_frame_protector_is_full_duplex(const tsi_frame_protector* self);
+
 /* --- tsi_peer objects ---
 
    tsi_peer objects are a set of properties. The peer owns the properties.  */
@@ -279,6 +286,16 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size);
 
+/* This method hands the protection of the connection over to the kernel, by
+   installing the keys of the session on the socket |fd|. It returns
+   TSI_UNIMPLEMENTED, leaving the socket and the handshaker result untouched,
+   if neither the implementation, nor the negotiated session, nor the kernel
+   support it; the caller should then create a frame protector as usual.
+   On success, no frame protector must be created: the bytes read from and
+   written to |fd| are unprotected.  */
+tsi_result tsi_handshaker_result_offload_to_kernel(
+    const tsi_handshaker_result* self, int fd);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);
@@ -49,6 +49,11 @@
 namespace grpc {
 
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
+
+// The most spare pluckable completion queues a channel keeps: enough for as
+// many threads as usually make blocking calls on one channel at once.
+static constexpr size_t kMaxSparePluckCQs = 64;
+
 Channel::Channel(
     const std::string& host, grpc_channel* channel,
     std::vector<
@@ -70,6 +75,7 @@ Channel::~Channel() {
       CompletionQueue::ReleaseCallbackAlternativeCQ(callback_cq);
     }
   }
+  for (CompletionQueue* cq : spare_pluck_cqs_) delete cq;
 }
 
 namespace {
@@ -263,7 +269,7 @@ class ShutdownCallback : public grpc_completion_queue_functor {
       auto* shutdown_callback = new ShutdownCallback;
       callback_cq = new grpc::CompletionQueue(grpc_completion_queue_attributes{
           GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
-          shutdown_callback});
+          shutdown_callback, 0, 0, 0});
 
       // Transfer ownership of the new cq to its own shutdown callback
       shutdown_callback->TakeCQ(callback_cq);
@@ -276,4 +282,29 @@ class ShutdownCallback : public grpc_completion_queue_functor {
   return callback_cq;
 }
 
+::grpc::CompletionQueue* Channel::LendPluckCQ() {
+  {
+    grpc::internal::MutexLock l(&spare_pluck_cqs_mu_);
+    if (!spare_pluck_cqs_.empty()) {
+      CompletionQueue* cq = spare_pluck_cqs_.back();
+      spare_pluck_cqs_.pop_back();
+      return cq;
+    }
+  }
+  return new grpc::CompletionQueue(grpc_completion_queue_attributes{
+      GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING, nullptr,
+      0, 0, 0});
+}
+
+void Channel::ReturnPluckCQ(::grpc::CompletionQueue* cq) {
+  {
+    grpc::internal::MutexLock l(&spare_pluck_cqs_mu_);
+    if (spare_pluck_cqs_.size() < kMaxSparePluckCQs) {
+      spare_pluck_cqs_.push_back(cq);
+      return;
+    }
+  }
+  delete cq;
+}
+
 }  // namespace grpc
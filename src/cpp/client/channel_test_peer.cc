@@ -34,5 +34,10 @@ int ChannelTestPeer::registration_attempts() const {
       ->TestOnlyRegistrationAttempts();
 }
 
+int ChannelTestPeer::spare_pluck_cqs() const {
+  grpc::internal::MutexLock lock(&channel_->spare_pluck_cqs_mu_);
+  return static_cast<int>(channel_->spare_pluck_cqs_.size());
+}
+
 }  // namespace testing
 }  // namespace grpc
@@ -65,6 +65,7 @@ ClientContext::ClientContext()
     : initial_metadata_received_(false),
       wait_for_ready_(false),
       wait_for_ready_explicitly_set_(false),
+      cacheable_(false),
       call_(nullptr),
       call_canceled_(false),
       deadline_(gpr_inf_future(GPR_CLOCK_REALTIME)),
@@ -152,7 +153,8 @@ void ClientContext::set_compression_algorithm(
     abort();
   }
   GPR_ASSERT(algorithm_name != nullptr);
-  AddMetadata(GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY, algorithm_name);
+  AddMetadataByReference(GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY,
+                         algorithm_name);
 }
 
 void ClientContext::TryCancel() {
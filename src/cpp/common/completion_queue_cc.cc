@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -27,6 +28,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 #include <grpcpp/completion_queue.h>
+#include <grpcpp/impl/codegen/channel_interface.h>
 #include <grpcpp/impl/codegen/completion_queue_tag.h>
 #include <grpcpp/impl/grpc_library.h>
 
@@ -39,6 +41,9 @@ namespace {
 
 internal::GrpcLibraryInitializer g_gli_initializer;
 
+// Upper bound on the events CompletionQueue::NextBatch reads at once
+constexpr size_t kMaxNextBatchEvents = 64;
+
 gpr_once g_once_init_callback_alternative = GPR_ONCE_INIT;
 grpc_core::Mutex* g_callback_alternative_mu;
 
@@ -167,6 +172,29 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+size_t CompletionQueue::NextBatch(void** tags, bool* oks, size_t max) {
+  GPR_ASSERT(max > 0);
+  grpc_event events[kMaxNextBatchEvents];
+  max = std::min(max, GPR_ARRAY_SIZE(events));
+  for (;;) {
+    size_t num_events = grpc_completion_queue_next_batch(
+        cq_, events, max, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    // A timeout with an infinite deadline means the queue has been shut down.
+    if (events[0].type != GRPC_OP_COMPLETE) return 0;
+    size_t num_tags = 0;
+    for (size_t i = 0; i < num_events; i++) {
+      auto core_cq_tag =
+          static_cast<grpc::internal::CompletionQueueTag*>(events[i].tag);
+      oks[num_tags] = events[i].success != 0;
+      tags[num_tags] = core_cq_tag;
+      if (core_cq_tag->FinalizeResult(&tags[num_tags], &oks[num_tags])) {
+        num_tags++;
+      }
+    }
+    if (num_tags > 0) return num_tags;
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
@@ -208,4 +236,26 @@ void CompletionQueue::ReleaseCallbackAlternativeCQ(CompletionQueue* cq)
   g_callback_alternative_cq.Unref();
 }
 
+namespace internal {
+
+BlockingCallCQ::BlockingCallCQ(grpc::ChannelInterface* channel)
+    : channel_(channel), cq_(channel->LendPluckCQ()) {
+  if (cq_ == nullptr) {
+    channel_ = nullptr;
+    cq_ = new CompletionQueue(grpc_completion_queue_attributes{
+        GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
+        nullptr, 0, 0, 0});
+  }
+}
+
+BlockingCallCQ::~BlockingCallCQ() {
+  if (channel_ != nullptr) {
+    channel_->ReturnPluckCQ(cq_);
+  } else {
+    delete cq_;
+  }
+}
+
+}  // namespace internal
+
 }  // namespace grpc
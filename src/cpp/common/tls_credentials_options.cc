@@ -30,6 +30,41 @@
 
 namespace grpc {
 namespace experimental {
+namespace {
+
+void PrivateKeySignerSign(void* user_data, const char* input,
+                          size_t input_size, uint16_t signature_algorithm,
+                          grpc_tls_on_private_key_sign_done_cb callback,
+                          void* callback_arg) {
+  auto* signer = static_cast<std::shared_ptr<TlsPrivateKeySigner>*>(user_data);
+  (*signer)->Sign(
+      std::string(input, input_size), signature_algorithm,
+      [callback, callback_arg](const grpc::Status& status,
+                               const std::string& signature) {
+        callback(callback_arg,
+                 static_cast<grpc_status_code>(status.error_code()),
+                 status.error_message().c_str(), signature.data(),
+                 signature.size());
+      });
+}
+
+void PrivateKeySignerDestruct(void* user_data) {
+  delete static_cast<std::shared_ptr<TlsPrivateKeySigner>*>(user_data);
+}
+
+}  // namespace
+
+TlsSessionTicketKeys::TlsSessionTicketKeys()
+    : c_keys_(grpc_ssl_session_ticket_keys_create()) {}
+
+TlsSessionTicketKeys::~TlsSessionTicketKeys() {
+  grpc_ssl_session_ticket_keys_release(c_keys_);
+}
+
+bool TlsSessionTicketKeys::Rotate(const std::string& key) {
+  return grpc_ssl_session_ticket_keys_rotate(c_keys_, key.data(),
+                                             key.size()) != 0;
+}
 
 TlsCredentialsOptions::TlsCredentialsOptions() {
   c_credentials_options_ = grpc_tls_credentials_options_create();
@@ -107,5 +142,32 @@ void TlsServerCredentialsOptions::set_cert_request_type(
                                                      cert_request_type);
 }
 
+void TlsServerCredentialsOptions::set_session_ticket_keys(
+    std::shared_ptr<TlsSessionTicketKeys> session_ticket_keys) {
+  grpc_tls_credentials_options* options = c_credentials_options();
+  GPR_ASSERT(options != nullptr);
+  GPR_ASSERT(session_ticket_keys != nullptr);
+  session_ticket_keys_ = std::move(session_ticket_keys);
+  grpc_tls_credentials_options_set_session_ticket_keys(
+      options, session_ticket_keys_->c_keys());
+}
+
+void TlsServerCredentialsOptions::set_private_key_signer(
+    std::shared_ptr<TlsPrivateKeySigner> signer) {
+  grpc_tls_credentials_options* options = c_credentials_options();
+  GPR_ASSERT(options != nullptr);
+  GPR_ASSERT(signer != nullptr);
+  grpc_tls_private_key_signer_external external_signer;
+  external_signer.user_data =
+      new std::shared_ptr<TlsPrivateKeySigner>(std::move(signer));
+  external_signer.sign = PrivateKeySignerSign;
+  external_signer.destruct = PrivateKeySignerDestruct;
+  grpc_tls_private_key_signer* c_signer =
+      grpc_tls_private_key_signer_external_create(&external_signer);
+  // The options hold their own reference.
+  grpc_tls_credentials_options_set_private_key_signer(options, c_signer);
+  grpc_tls_private_key_signer_release(c_signer);
+}
+
 }  // namespace experimental
 }  // namespace grpc
@@ -21,11 +21,19 @@
 #include "src/cpp/ext/filters/census/channel_filter.h"
 
 #include "absl/status/status.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/cpp/ext/filters/census/open_census_call_tracer.h"
 
 namespace grpc {
 
 grpc_error_handle CensusChannelData::Init(grpc_channel_element* /*elem*/,
-                                          grpc_channel_element_args* /*args*/) {
+                                          grpc_channel_element_args* args) {
+  stats_sampling_period_ =
+      grpc_core::ChannelArgs::FromC(args->channel_args)
+          .GetInt(GRPC_ARG_OPENCENSUS_STATS_SAMPLING_PERIOD)
+          .value_or(1);
   return absl::OkStatus();
 }
 
@@ -32,6 +32,11 @@ class CensusChannelData : public ChannelData {
  public:
   grpc_error_handle Init(grpc_channel_element* elem,
                          grpc_channel_element_args* args) override;
+
+  int stats_sampling_period() const { return stats_sampling_period_; }
+
+ private:
+  int stats_sampling_period_ = 1;
 };
 
 }  // namespace grpc
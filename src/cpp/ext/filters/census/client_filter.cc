@@ -49,6 +49,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time_util.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_buffer.h"
@@ -71,9 +72,13 @@ constexpr uint32_t
 
 grpc_error_handle CensusClientChannelData::Init(
     grpc_channel_element* /*elem*/, grpc_channel_element_args* args) {
-  tracing_enabled_ = grpc_core::ChannelArgs::FromC(args->channel_args)
-                         .GetInt(GRPC_ARG_ENABLE_OBSERVABILITY)
-                         .value_or(true);
+  grpc_core::ChannelArgs channel_args =
+      grpc_core::ChannelArgs::FromC(args->channel_args);
+  tracing_enabled_ =
+      channel_args.GetInt(GRPC_ARG_ENABLE_OBSERVABILITY).value_or(true);
+  stats_sampling_period_ =
+      channel_args.GetInt(GRPC_ARG_OPENCENSUS_STATS_SAMPLING_PERIOD)
+          .value_or(1);
   return GRPC_ERROR_NONE;
 }
 
@@ -83,9 +88,9 @@ grpc_error_handle CensusClientChannelData::Init(
 
 grpc_error_handle CensusClientChannelData::CensusClientCallData::Init(
     grpc_call_element* elem, const grpc_call_element_args* args) {
+  auto* channeld = static_cast<CensusClientChannelData*>(elem->channel_data);
   tracer_ = args->arena->New<OpenCensusCallTracer>(
-      args, (static_cast<CensusClientChannelData*>(elem->channel_data))
-                ->tracing_enabled_);
+      args, channeld->tracing_enabled_, channeld->stats_sampling_period_);
   GPR_DEBUG_ASSERT(args->context[GRPC_CONTEXT_CALL_TRACER].value == nullptr);
   args->context[GRPC_CONTEXT_CALL_TRACER].value = tracer_;
   args->context[GRPC_CONTEXT_CALL_TRACER].destroy = [](void* tracer) {
@@ -119,7 +124,8 @@ OpenCensusCallTracer::OpenCensusCallAttemptTracer::OpenCensusCallAttemptTracer(
     : parent_(parent),
       arena_allocated_(arena_allocated),
       context_(parent_->CreateCensusContextForCallAttempt()),
-      start_time_(absl::Now()) {
+      start_time_(absl::Now()),
+      stats_sampled_(ShouldSampleRpcStats(parent_->stats_sampling_period_)) {
   if (parent_->tracing_enabled_) {
     context_.AddSpanAttribute("previous-rpc-attempts", attempt_num);
     context_.AddSpanAttribute("transparent-retry", is_transparent_retry);
@@ -183,21 +189,11 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::
   if (recv_trailing_metadata == nullptr || transport_stream_stats == nullptr) {
     return;
   }
-  uint64_t elapsed_time = 0;
-  FilterTrailingMetadata(recv_trailing_metadata, &elapsed_time);
-  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
-      context_.tags().tags();
-  tags.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
-  std::string final_status = absl::StatusCodeToString(status_code_);
-  tags.emplace_back(ClientStatusTagKey(), final_status);
-  ::opencensus::stats::Record(
-      {{RpcClientSentBytesPerRpc(),
-        static_cast<double>(transport_stream_stats->outgoing.data_bytes)},
-       {RpcClientReceivedBytesPerRpc(),
-        static_cast<double>(transport_stream_stats->incoming.data_bytes)},
-       {RpcClientServerLatency(),
-        ToDoubleMilliseconds(absl::Nanoseconds(elapsed_time))}},
-      tags);
+  // Recorded by RecordEnd(), along with the other stats of the attempt.
+  FilterTrailingMetadata(recv_trailing_metadata, &server_elapsed_time_);
+  has_transport_stats_ = true;
+  sent_bytes_ = transport_stream_stats->outgoing.data_bytes;
+  received_bytes_ = transport_stream_stats->incoming.data_bytes;
 }
 
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordCancel(
@@ -205,18 +201,76 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordCancel(
   status_code_ = absl::StatusCode::kCancelled;
 }
 
+void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordLatencyEvent(
+    LatencyEvent event, gpr_timespec time) {
+  switch (event) {
+    case LatencyEvent::kPickQueued:
+      pick_queued_time_ = grpc_core::ToAbslTime(time);
+      break;
+    case LatencyEvent::kPickComplete:
+      pick_complete_time_ = grpc_core::ToAbslTime(time);
+      break;
+    case LatencyEvent::kFirstByteWritten:
+      first_byte_written_time_ = grpc_core::ToAbslTime(time);
+      break;
+  }
+}
+
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordEnd(
     const gpr_timespec& /*latency*/) {
   double latency_ms = absl::ToDoubleMilliseconds(absl::Now() - start_time_);
-  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
+  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tag_list =
       context_.tags().tags();
-  tags.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
-  tags.emplace_back(ClientStatusTagKey(), StatusCodeToString(status_code_));
-  ::opencensus::stats::Record(
-      {{RpcClientRoundtripLatency(), latency_ms},
-       {RpcClientSentMessagesPerRpc(), sent_message_count_},
-       {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
-      tags);
+  tag_list.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
+  tag_list.emplace_back(ClientStatusTagKey(),
+                        StatusCodeToString(status_code_));
+  // Built once for all the records below.
+  const opencensus::tags::TagMap tags(std::move(tag_list));
+  // Each Record() takes a lock in the stats library: the stats of the attempt
+  // are recorded in as few as possible.
+  if (!stats_sampled_) {
+    ::opencensus::stats::Record({{RpcClientRoundtripLatency(), latency_ms}},
+                                tags);
+  } else if (has_transport_stats_) {
+    ::opencensus::stats::Record(
+        {{RpcClientRoundtripLatency(), latency_ms},
+         {RpcClientSentMessagesPerRpc(), sent_message_count_},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count_},
+         {RpcClientSentBytesPerRpc(), static_cast<double>(sent_bytes_)},
+         {RpcClientReceivedBytesPerRpc(),
+          static_cast<double>(received_bytes_)},
+         {RpcClientServerLatency(),
+          ToDoubleMilliseconds(absl::Nanoseconds(server_elapsed_time_))}},
+        tags);
+  } else {
+    ::opencensus::stats::Record(
+        {{RpcClientRoundtripLatency(), latency_ms},
+         {RpcClientSentMessagesPerRpc(), sent_message_count_},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
+        tags);
+  }
+  // Attempts that failed before their pick completed never reached a
+  // transport: only the roundtrip latency is theirs.
+  if (stats_sampled_ && pick_complete_time_ != absl::InfinitePast()) {
+    ::opencensus::stats::Record(
+        {{RpcClientPickLatency(),
+          absl::ToDoubleMilliseconds(pick_complete_time_ - start_time_)}},
+        tags);
+    if (pick_queued_time_ != absl::InfinitePast()) {
+      ::opencensus::stats::Record(
+          {{RpcClientPickQueueLatency(),
+            absl::ToDoubleMilliseconds(pick_complete_time_ -
+                                       pick_queued_time_)}},
+          tags);
+    }
+    if (first_byte_written_time_ != absl::InfinitePast()) {
+      ::opencensus::stats::Record(
+          {{RpcClientTransportLatency(),
+            absl::ToDoubleMilliseconds(first_byte_written_time_ -
+                                       pick_complete_time_)}},
+          tags);
+    }
+  }
   if (parent_->tracing_enabled_) {
     if (status_code_ != absl::StatusCode::kOk) {
       context_.Span().SetStatus(opencensus::trace::StatusCode(status_code_),
@@ -240,12 +294,14 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordEnd(
 //
 
 OpenCensusCallTracer::OpenCensusCallTracer(const grpc_call_element_args* args,
-                                           bool tracing_enabled)
+                                           bool tracing_enabled,
+                                           int stats_sampling_period)
     : call_context_(args->context),
       path_(grpc_slice_ref(args->path)),
       method_(GetMethod(path_)),
       arena_(args->arena),
-      tracing_enabled_(tracing_enabled) {}
+      tracing_enabled_(tracing_enabled),
+      stats_sampling_period_(stats_sampling_period) {}
 
 OpenCensusCallTracer::~OpenCensusCallTracer() {
   std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
@@ -51,6 +51,7 @@ class CensusClientChannelData : public ChannelData {
 
  private:
   bool tracing_enabled_ = true;
+  int stats_sampling_period_ = 1;
 };
 
 }  // namespace grpc
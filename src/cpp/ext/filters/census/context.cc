@@ -100,6 +100,16 @@ size_t ServerStatsDeserialize(const char* buf, size_t buf_size,
                                         server_elapsed_time);
 }
 
+bool ShouldSampleRpcStats(int sampling_period) {
+  if (sampling_period <= 1) return true;
+  // A counter rather than a random draw: each thread samples evenly, at the
+  // cost of an increment.
+  static thread_local int rpcs_since_sample = 0;
+  if (++rpcs_since_sample < sampling_period) return false;
+  rpcs_since_sample = 0;
+  return true;
+}
+
 uint64_t GetIncomingDataSize(const grpc_call_final_info* final_info) {
   return final_info->stats.transport_stream_stats.incoming.data_bytes;
 }
@@ -107,6 +107,10 @@ void GenerateServerContext(absl::string_view tracing, absl::string_view method,
 void GenerateClientContext(absl::string_view method, CensusContext* ctxt,
                            CensusContext* parent_ctx);
 
+// Whether to record the sampled stats of an RPC: true for one RPC in
+// sampling_period on each thread, or for all if sampling_period is at most 1.
+bool ShouldSampleRpcStats(int sampling_period);
+
 // Returns the incoming data size from the grpc call final info.
 uint64_t GetIncomingDataSize(const grpc_call_final_info* final_info);
 
@@ -60,6 +60,9 @@ void RegisterOpenCensusPlugin() {
   RpcClientRetriesPerCall();
   RpcClientTransparentRetriesPerCall();
   RpcClientRetryDelayPerCall();
+  RpcClientPickLatency();
+  RpcClientPickQueueLatency();
+  RpcClientTransportLatency();
 
   RpcServerSentBytesPerRpc();
   RpcServerReceivedBytesPerRpc();
@@ -139,6 +142,15 @@ ABSL_CONST_INIT const absl::string_view
 ABSL_CONST_INIT const absl::string_view kRpcClientRetryDelayPerCallMeasureName =
     "grpc.io/client/retry_delay_per_call";
 
+ABSL_CONST_INIT const absl::string_view kRpcClientPickLatencyMeasureName =
+    "grpc.io/client/pick_latency";
+
+ABSL_CONST_INIT const absl::string_view kRpcClientPickQueueLatencyMeasureName =
+    "grpc.io/client/pick_queue_latency";
+
+ABSL_CONST_INIT const absl::string_view kRpcClientTransportLatencyMeasureName =
+    "grpc.io/client/transport_latency";
+
 // Server
 ABSL_CONST_INIT const absl::string_view
     kRpcServerSentMessagesPerRpcMeasureName =
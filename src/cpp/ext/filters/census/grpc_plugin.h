@@ -45,6 +45,9 @@ extern const absl::string_view kRpcClientStartedRpcsMeasureName;
 extern const absl::string_view kRpcClientRetriesPerCallMeasureName;
 extern const absl::string_view kRpcClientTransparentRetriesPerCallMeasureName;
 extern const absl::string_view kRpcClientRetryDelayPerCallMeasureName;
+extern const absl::string_view kRpcClientPickLatencyMeasureName;
+extern const absl::string_view kRpcClientPickQueueLatencyMeasureName;
+extern const absl::string_view kRpcClientTransportLatencyMeasureName;
 
 extern const absl::string_view kRpcServerSentMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcServerSentBytesPerRpcMeasureName;
@@ -70,6 +73,9 @@ const ::opencensus::stats::ViewDescriptor&
 ClientTransparentRetriesPerCallCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientTransparentRetriesCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientRetryDelayPerCallCumulative();
+const ::opencensus::stats::ViewDescriptor& ClientPickLatencyCumulative();
+const ::opencensus::stats::ViewDescriptor& ClientPickQueueLatencyCumulative();
+const ::opencensus::stats::ViewDescriptor& ClientTransportLatencyCumulative();
 
 const ::opencensus::stats::ViewDescriptor& ServerSentBytesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor&
@@ -96,6 +102,9 @@ const ::opencensus::stats::ViewDescriptor&
 ClientTransparentRetriesPerCallMinute();
 const ::opencensus::stats::ViewDescriptor& ClientTransparentRetriesMinute();
 const ::opencensus::stats::ViewDescriptor& ClientRetryDelayPerCallMinute();
+const ::opencensus::stats::ViewDescriptor& ClientPickLatencyMinute();
+const ::opencensus::stats::ViewDescriptor& ClientPickQueueLatencyMinute();
+const ::opencensus::stats::ViewDescriptor& ClientTransportLatencyMinute();
 
 const ::opencensus::stats::ViewDescriptor& ServerSentMessagesPerRpcMinute();
 const ::opencensus::stats::ViewDescriptor& ServerSentBytesPerRpcMinute();
@@ -119,6 +128,9 @@ const ::opencensus::stats::ViewDescriptor&
 ClientTransparentRetriesPerCallHour();
 const ::opencensus::stats::ViewDescriptor& ClientTransparentRetriesHour();
 const ::opencensus::stats::ViewDescriptor& ClientRetryDelayPerCallHour();
+const ::opencensus::stats::ViewDescriptor& ClientPickLatencyHour();
+const ::opencensus::stats::ViewDescriptor& ClientPickQueueLatencyHour();
+const ::opencensus::stats::ViewDescriptor& ClientTransportLatencyHour();
 
 const ::opencensus::stats::ViewDescriptor& ServerSentMessagesPerRpcHour();
 const ::opencensus::stats::ViewDescriptor& ServerSentBytesPerRpcHour();
@@ -124,6 +124,34 @@ MeasureDouble RpcClientRetryDelayPerCall() {
   return measure;
 }
 
+// Client per-attempt latency breakdown measures
+MeasureDouble RpcClientPickLatency() {
+  static const auto measure = MeasureDouble::Register(
+      kRpcClientPickLatencyMeasureName,
+      "Time between the start of an attempt and the completion of its load "
+      "balancing pick",
+      kUnitMilliseconds);
+  return measure;
+}
+
+MeasureDouble RpcClientPickQueueLatency() {
+  static const auto measure = MeasureDouble::Register(
+      kRpcClientPickQueueLatencyMeasureName,
+      "Time the load balancing pick of an attempt was queued waiting for a "
+      "new picker, for attempts whose pick was queued",
+      kUnitMilliseconds);
+  return measure;
+}
+
+MeasureDouble RpcClientTransportLatency() {
+  static const auto measure = MeasureDouble::Register(
+      kRpcClientTransportLatencyMeasureName,
+      "Time between the completion of the load balancing pick of an attempt "
+      "and the transport starting to write its first bytes",
+      kUnitMilliseconds);
+  return measure;
+}
+
 // Server
 MeasureDouble RpcServerSentBytesPerRpc() {
   static const auto measure = MeasureDouble::Register(
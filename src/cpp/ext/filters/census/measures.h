@@ -36,6 +36,9 @@ namespace grpc {
 ::opencensus::stats::MeasureInt64 RpcClientRetriesPerCall();
 ::opencensus::stats::MeasureInt64 RpcClientTransparentRetriesPerCall();
 ::opencensus::stats::MeasureDouble RpcClientRetryDelayPerCall();
+::opencensus::stats::MeasureDouble RpcClientPickLatency();
+::opencensus::stats::MeasureDouble RpcClientPickQueueLatency();
+::opencensus::stats::MeasureDouble RpcClientTransportLatency();
 
 ::opencensus::stats::MeasureInt64 RpcServerSentMessagesPerRpc();
 ::opencensus::stats::MeasureDouble RpcServerSentBytesPerRpc();
@@ -55,6 +55,14 @@
 //
 #define GRPC_ARG_ENABLE_OBSERVABILITY "grpc.experimental.enable_observability"
 
+// EXPERIMENTAL. If greater than 1, the per-RPC distributions of messages,
+// bytes and latency breakdowns are only recorded for one RPC in this many on
+// each thread, to make always-on stats cheaper. The counts of started and
+// completed RPCs, retries, and the roundtrip and server latencies are
+// recorded for every RPC. Defaults to 1.
+#define GRPC_ARG_OPENCENSUS_STATS_SAMPLING_PERIOD \
+  "grpc.experimental.opencensus_stats_sampling_period"
+
 namespace grpc {
 
 class OpenCensusCallTracer : public grpc_core::CallTracer {
@@ -80,6 +88,7 @@ class OpenCensusCallTracer : public grpc_core::CallTracer {
         absl::Status status, grpc_metadata_batch* recv_trailing_metadata,
         const grpc_transport_stream_stats* transport_stream_stats) override;
     void RecordCancel(grpc_error_handle cancel_error) override;
+    void RecordLatencyEvent(LatencyEvent event, gpr_timespec time) override;
     void RecordEnd(const gpr_timespec& /*latency*/) override;
 
     CensusContext* context() { return &context_; }
@@ -94,15 +103,26 @@ class OpenCensusCallTracer : public grpc_core::CallTracer {
     CensusContext context_;
     // Start time (for measuring latency).
     absl::Time start_time_;
+    // When the events that break the latency down happened, or InfinitePast.
+    absl::Time pick_queued_time_ = absl::InfinitePast();
+    absl::Time pick_complete_time_ = absl::InfinitePast();
+    absl::Time first_byte_written_time_ = absl::InfinitePast();
     // Number of messages in this RPC.
     uint64_t recv_message_count_ = 0;
     uint64_t sent_message_count_ = 0;
     // End status code
     absl::StatusCode status_code_;
+    // Whether the sampled stats of the attempt are recorded.
+    const bool stats_sampled_;
+    // From the trailing metadata and the transport, if they were received.
+    bool has_transport_stats_ = false;
+    uint64_t sent_bytes_ = 0;
+    uint64_t received_bytes_ = 0;
+    uint64_t server_elapsed_time_ = 0;
   };
 
-  explicit OpenCensusCallTracer(const grpc_call_element_args* args,
-                                bool tracing_enabled);
+  OpenCensusCallTracer(const grpc_call_element_args* args,
+                       bool tracing_enabled, int stats_sampling_period);
   ~OpenCensusCallTracer() override;
 
   void GenerateContext();
@@ -119,6 +139,7 @@ class OpenCensusCallTracer : public grpc_core::CallTracer {
   CensusContext context_;
   grpc_core::Arena* arena_;
   bool tracing_enabled_;
+  const int stats_sampling_period_;
   grpc_core::Mutex mu_;
   // Non-transparent attempts per call
   uint64_t retries_ ABSL_GUARDED_BY(&mu_) = 0;
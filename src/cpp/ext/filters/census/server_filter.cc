@@ -161,21 +161,30 @@ grpc_error_handle CensusServerCallData::Init(
   return absl::OkStatus();
 }
 
-void CensusServerCallData::Destroy(grpc_call_element* /*elem*/,
+void CensusServerCallData::Destroy(grpc_call_element* elem,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* /*then_call_closure*/) {
   const uint64_t request_size = GetOutgoingDataSize(final_info);
   const uint64_t response_size = GetIncomingDataSize(final_info);
   double elapsed_time_ms = absl::ToDoubleMilliseconds(elapsed_time_);
   grpc_auth_context_release(auth_context_);
-  ::opencensus::stats::Record(
-      {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
-       {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
-       {RpcServerServerLatency(), elapsed_time_ms},
-       {RpcServerSentMessagesPerRpc(), sent_message_count_},
-       {RpcServerReceivedMessagesPerRpc(), recv_message_count_}},
-      {{ServerMethodTagKey(), method_},
-       {ServerStatusTagKey(), StatusCodeToString(final_info->final_status)}});
+  // The server latency also counts the completed RPCs: it is never sampled.
+  if (ShouldSampleRpcStats(static_cast<CensusChannelData*>(elem->channel_data)
+                               ->stats_sampling_period())) {
+    ::opencensus::stats::Record(
+        {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
+         {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
+         {RpcServerServerLatency(), elapsed_time_ms},
+         {RpcServerSentMessagesPerRpc(), sent_message_count_},
+         {RpcServerReceivedMessagesPerRpc(), recv_message_count_}},
+        {{ServerMethodTagKey(), method_},
+         {ServerStatusTagKey(), StatusCodeToString(final_info->final_status)}});
+  } else {
+    ::opencensus::stats::Record(
+        {{RpcServerServerLatency(), elapsed_time_ms}},
+        {{ServerMethodTagKey(), method_},
+         {ServerStatusTagKey(), StatusCodeToString(final_info->final_status)}});
+  }
   context_.EndSpan();
 }
 
@@ -220,6 +220,36 @@ const ViewDescriptor& ClientRetryDelayPerCallCumulative() {
   return descriptor;
 }
 
+const ViewDescriptor& ClientPickLatencyCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/client/pick_latency/cumulative")
+          .set_measure(kRpcClientPickLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientPickQueueLatencyCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/client/pick_queue_latency/cumulative")
+          .set_measure(kRpcClientPickQueueLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientTransportLatencyCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/client/transport_latency/cumulative")
+          .set_measure(kRpcClientTransportLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
 // server cumulative
 const ViewDescriptor& ServerSentBytesPerRpcCumulative() {
   const static ViewDescriptor descriptor =
@@ -424,6 +454,36 @@ const ViewDescriptor& ClientRetryDelayPerCallMinute() {
   return descriptor;
 }
 
+const ViewDescriptor& ClientPickLatencyMinute() {
+  const static ViewDescriptor descriptor =
+      MinuteDescriptor()
+          .set_name("grpc.io/client/pick_latency/minute")
+          .set_measure(kRpcClientPickLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientPickQueueLatencyMinute() {
+  const static ViewDescriptor descriptor =
+      MinuteDescriptor()
+          .set_name("grpc.io/client/pick_queue_latency/minute")
+          .set_measure(kRpcClientPickQueueLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientTransportLatencyMinute() {
+  const static ViewDescriptor descriptor =
+      MinuteDescriptor()
+          .set_name("grpc.io/client/transport_latency/minute")
+          .set_measure(kRpcClientTransportLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
 // server minute
 const ViewDescriptor& ServerSentBytesPerRpcMinute() {
   const static ViewDescriptor descriptor =
@@ -628,6 +688,36 @@ const ViewDescriptor& ClientRetryDelayPerCallHour() {
   return descriptor;
 }
 
+const ViewDescriptor& ClientPickLatencyHour() {
+  const static ViewDescriptor descriptor =
+      HourDescriptor()
+          .set_name("grpc.io/client/pick_latency/hour")
+          .set_measure(kRpcClientPickLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientPickQueueLatencyHour() {
+  const static ViewDescriptor descriptor =
+      HourDescriptor()
+          .set_name("grpc.io/client/pick_queue_latency/hour")
+          .set_measure(kRpcClientPickQueueLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
+const ViewDescriptor& ClientTransportLatencyHour() {
+  const static ViewDescriptor descriptor =
+      HourDescriptor()
+          .set_name("grpc.io/client/transport_latency/hour")
+          .set_measure(kRpcClientTransportLatencyMeasureName)
+          .set_aggregation(MillisDistributionAggregation())
+          .add_column(ClientMethodTagKey());
+  return descriptor;
+}
+
 // server hour
 const ViewDescriptor& ServerSentBytesPerRpcHour() {
   const static ViewDescriptor descriptor =
@@ -18,9 +18,17 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+
 #include <grpcpp/ext/admin_services.h>
 #include <grpcpp/server_builder.h>
 
+#include "src/core/lib/gprpp/mutex_contention_profiler.h"
+#include "src/core/lib/json/json.h"
+
 // TODO(lidiz) build a real registration system that can pull in services
 // automatically with minimum amount of code.
 #include "src/cpp/server/channelz/channelz_service.h"
@@ -45,4 +53,37 @@ void AddAdminServices(ServerBuilder* builder) {
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
 }
 
+namespace experimental {
+
+void SetMutexContentionSamplePeriod(uint32_t sample_period) {
+  grpc_core::MutexContentionProfiler::Start(sample_period);
+}
+
+std::string GetMutexContentionProfile(size_t max_sites) {
+  grpc_core::Json::Array sites;
+  for (const auto& site :
+       grpc_core::MutexContentionProfiler::TopSites(max_sites)) {
+    // 64-bit integers are strings, as in channelz.
+    sites.push_back(grpc_core::Json::Object{
+        {"holder", absl::StrCat(site.holder.file(), ":", site.holder.line())},
+        {"waiter", absl::StrCat(site.waiter.file(), ":", site.waiter.line())},
+        {"contentions", std::to_string(site.contentions)},
+        {"totalWaitNanos", std::to_string(site.total_wait_ns)},
+        {"maxWaitNanos", std::to_string(site.max_wait_ns)},
+    });
+  }
+  return grpc_core::Json(grpc_core::Json::Object{
+                             {"enabled",
+                              grpc_core::MutexContentionProfiler::enabled()},
+                             {"sites", std::move(sites)},
+                         })
+      .Dump();
+}
+
+void ResetMutexContentionProfile() {
+  grpc_core::MutexContentionProfiler::Reset();
+}
+
+}  // namespace experimental
+
 }  // namespace grpc
@@ -0,0 +1,175 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <stdint.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/support/callback_method_executor.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace experimental {
+
+// Only ever handed out as an opaque pointer, so its state is left to Impl.
+class CallbackMethodExecutor::MethodClass {
+ public:
+  struct Pending {
+    uint64_t seq;
+    std::function<void()> fn;
+  };
+
+  MethodClass(Impl* impl, int priority, int max_concurrency)
+      : impl(impl), priority(priority), max_concurrency(max_concurrency) {}
+
+  bool Runnable() const {
+    return !pending.empty() &&
+           (max_concurrency == 0 || running < max_concurrency);
+  }
+
+  Impl* const impl;
+  const int priority;
+  const int max_concurrency;
+  // Guarded by the mutex of impl.
+  int running = 0;
+  std::deque<Pending> pending;
+};
+
+class CallbackMethodExecutor::Impl {
+ public:
+  explicit Impl(int num_threads) {
+    GPR_ASSERT(num_threads > 0);
+    threads_.reserve(num_threads);
+    for (int i = 0; i < num_threads; i++) {
+      threads_.emplace_back(
+          "grpcpp_method_executor",
+          [](void* impl) { static_cast<Impl*>(impl)->ThreadBody(); }, this);
+      threads_.back().Start();
+    }
+  }
+
+  ~Impl() {
+    {
+      grpc_core::MutexLock lock(&mu_);
+      shutdown_ = true;
+      cv_.SignalAll();
+    }
+    for (auto& thd : threads_) thd.Join();
+  }
+
+  MethodClass* AddMethodClass(int priority, int max_concurrency) {
+    GPR_ASSERT(max_concurrency >= 0);
+    grpc_core::MutexLock lock(&mu_);
+    classes_.push_back(
+        absl::make_unique<MethodClass>(this, priority, max_concurrency));
+    return classes_.back().get();
+  }
+
+  void Run(MethodClass* method_class, std::function<void()> fn) {
+    grpc_core::MutexLock lock(&mu_);
+    method_class->pending.push_back({next_seq_++, std::move(fn)});
+    if (method_class->Runnable()) cv_.Signal();
+  }
+
+ private:
+  // The runnable class of the highest priority, ties going to the class whose
+  // oldest handler has waited longest.
+  MethodClass* PickLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    MethodClass* best = nullptr;
+    for (const auto& method_class : classes_) {
+      if (!method_class->Runnable()) continue;
+      if (best == nullptr || method_class->priority > best->priority ||
+          (method_class->priority == best->priority &&
+           method_class->pending.front().seq < best->pending.front().seq)) {
+        best = method_class.get();
+      }
+    }
+    return best;
+  }
+
+  bool AnyPendingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    for (const auto& method_class : classes_) {
+      if (!method_class->pending.empty()) return true;
+    }
+    return false;
+  }
+
+  void ThreadBody() {
+    mu_.Lock();
+    for (;;) {
+      MethodClass* method_class = PickLocked();
+      if (method_class == nullptr) {
+        // Handlers still pending, but held back by their caps, are run once
+        // the running ones finish, even after shutdown has begun.
+        if (shutdown_ && !AnyPendingLocked()) break;
+        cv_.Wait(&mu_);
+        continue;
+      }
+      std::function<void()> fn = std::move(method_class->pending.front().fn);
+      method_class->pending.pop_front();
+      method_class->running++;
+      mu_.Unlock();
+      {
+        grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+        grpc_core::ExecCtx exec_ctx;
+        fn();
+      }
+      mu_.Lock();
+      method_class->running--;
+      // The finished handler may have been what held back others of its
+      // class, and threads waiting out a shutdown must recheck.
+      if (method_class->Runnable() || shutdown_) cv_.SignalAll();
+    }
+    mu_.Unlock();
+  }
+
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  uint64_t next_seq_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<std::unique_ptr<MethodClass>> classes_ ABSL_GUARDED_BY(mu_);
+  std::vector<grpc_core::Thread> threads_;
+};
+
+CallbackMethodExecutor::CallbackMethodExecutor(int num_threads)
+    : impl_(absl::make_unique<Impl>(num_threads)) {}
+
+CallbackMethodExecutor::~CallbackMethodExecutor() = default;
+
+CallbackMethodExecutor::MethodClass* CallbackMethodExecutor::AddMethodClass(
+    int priority, int max_concurrency) {
+  return impl_->AddMethodClass(priority, max_concurrency);
+}
+
+void CallbackMethodExecutor::Run(MethodClass* method_class,
+                                 std::function<void()> fn) {
+  method_class->impl->Run(method_class, std::move(fn));
+}
+
+}  // namespace experimental
+}  // namespace grpc
@@ -22,6 +22,12 @@
 
 namespace grpc {
 
+namespace {
+// However busy the CPUs, callbacks waiting this long get a new thread: the
+// threads running may be blocked rather than busy.
+constexpr double kMaxQueueingDelayUs = 100 * 1000;
+}  // namespace
+
 DynamicThreadPool::DynamicThread::DynamicThread(DynamicThreadPool* pool)
     : pool_(pool),
       thd_(
@@ -63,8 +69,13 @@ void DynamicThreadPool::ThreadFunc() {
     // Drain callbacks before considering shutdown to ensure all work
     // gets completed.
     if (!callbacks_.empty()) {
-      auto cb = callbacks_.front();
+      auto cb = std::move(callbacks_.front().callback);
       callbacks_.pop();
+      if (!callbacks_.empty() && threads_waiting_ == 0 &&
+          ShouldAddThreadLocked(ThreadPoolController::NowMicros())) {
+        nthreads_++;
+        new DynamicThread(this);
+      }
       lock.Release();
       cb();
     } else if (shutdown_) {
@@ -101,17 +112,24 @@ DynamicThreadPool::~DynamicThreadPool() {
   ReapThreads(&dead_threads_);
 }
 
+bool DynamicThreadPool::ShouldAddThreadLocked(double now_us) {
+  return nthreads_ < reserve_threads_ ||
+         now_us - callbacks_.front().added_us >= kMaxQueueingDelayUs ||
+         !controller_.CpuSaturated(now_us);
+}
+
 void DynamicThreadPool::Add(const std::function<void()>& callback) {
   grpc_core::MutexLock lock(&mu_);
+  const double now_us = ThreadPoolController::NowMicros();
   // Add works to the callbacks list
-  callbacks_.push(callback);
+  callbacks_.push({callback, now_us});
   // Increase pool size or notify as needed
-  if (threads_waiting_ == 0) {
+  if (threads_waiting_ > 0) {
+    cv_.Signal();
+  } else if (ShouldAddThreadLocked(now_us)) {
     // Kick off a new thread
     nthreads_++;
     new DynamicThread(this);
-  } else {
-    cv_.Signal();
   }
   // Also use this chance to harvest dead threads
   if (!dead_threads_.empty()) {
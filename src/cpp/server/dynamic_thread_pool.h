@@ -26,6 +26,7 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/cpp/server/thread_pool_interface.h"
+#include "src/cpp/thread_manager/thread_pool_controller.h"
 
 namespace grpc {
 
@@ -51,13 +52,24 @@ class DynamicThreadPool final : public ThreadPoolInterface {
   grpc_core::CondVar cv_;
   grpc_core::CondVar shutdown_cv_;
   bool shutdown_;
-  std::queue<std::function<void()>> callbacks_;
+  struct Callback {
+    std::function<void()> callback;
+    // When it was added, for ThreadPoolController::NowMicros()
+    double added_us;
+  };
+  std::queue<Callback> callbacks_;
   int reserve_threads_;
   int nthreads_;
   int threads_waiting_;
   std::list<DynamicThread*> dead_threads_;
+  // Past reserve_threads_, no threads are added while the CPUs are saturated,
+  // unless callbacks have been waiting too long.
+  ThreadPoolController controller_;
 
   void ThreadFunc();
+  // Whether to add a thread for the queued callbacks, for want of an idle
+  // one.
+  bool ShouldAddThreadLocked(double now_us);
   static void ReapThreads(std::list<DynamicThread*>* tlist);
 };
 
@@ -147,15 +147,14 @@ LoadRecordValue::LoadRecordValue(std::string metric_name, uint64_t num_calls,
 void PerBalancerStore::MergeRow(const LoadRecordKey& key,
                                 const LoadRecordValue& value) {
   // During suspension, the load data received will be dropped.
-  if (!suspended_) {
-    load_record_map_[key].MergeFrom(value);
+  if (!suspended_) load_record_map_[key].MergeFrom(value);
+  // Rows are merged by the thousand on each fetch: only build their strings
+  // when they are logged.
+  if (gpr_should_log(GPR_LOG_SEVERITY_DEBUG)) {
     gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data merged (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
-  } else {
-    gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data dropped (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
+            "[PerBalancerStore %p] Load data %s (Key: %s, Value: %s).", this,
+            suspended_ ? "dropped" : "merged", key.ToString().c_str(),
+            value.ToString().c_str());
   }
   // We always keep track of num_calls_in_progress_, so that when this
   // store is resumed, we still have a correct value of
@@ -242,9 +241,8 @@ void PerHostStore::ReportStreamClosed(const std::string& lb_id) {
 
 PerBalancerStore* PerHostStore::FindPerBalancerStore(
     const std::string& lb_id) const {
-  return per_balancer_stores_.find(lb_id) != per_balancer_stores_.end()
-             ? per_balancer_stores_.find(lb_id)->second.get()
-             : nullptr;
+  auto it = per_balancer_stores_.find(lb_id);
+  return it != per_balancer_stores_.end() ? it->second.get() : nullptr;
 }
 
 const std::set<PerBalancerStore*>* PerHostStore::GetAssignedStores(
@@ -403,7 +403,8 @@ void LoadReporter::ReportStreamClosed(const std::string& hostname,
 }
 
 void LoadReporter::ProcessViewDataCallStart(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadRow>* rows) {
   auto it = view_data_map.find(kViewStartCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -412,18 +413,15 @@ void LoadReporter::ProcessViewDataCallStart(
       const std::string& client_ip_and_token = tag_values[0];
       const std::string& host = tag_values[1];
       const std::string& user_id = tag_values[2];
-      LoadRecordKey key(client_ip_and_token, user_id);
-      LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, LoadRecordKey(client_ip_and_token, user_id),
+                         LoadRecordValue(start_count));
     }
   }
 }
 
 void LoadReporter::ProcessViewDataCallEnd(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadRow>* rows) {
   uint64_t total_end_count = 0;
   uint64_t total_error_count = 0;
   auto it = view_data_map.find(kViewEndCount);
@@ -464,19 +462,17 @@ void LoadReporter::ProcessViewDataCallEnd(
         error_count = end_count;
         total_error_count += end_count;
       }
-      LoadRecordValue value = LoadRecordValue(
-          0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key),
+                         LoadRecordValue(0, ok_count, error_count, bytes_sent,
+                                         bytes_received, latency_ms));
     }
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
 }
 
 void LoadReporter::ProcessViewDataOtherCallMetrics(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadRow>* rows) {
   auto it = view_data_map.find(kViewOtherCallMetricCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -491,12 +487,10 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
           CensusViewProvider::GetRelatedViewDataRowDouble(
               view_data_map, kViewOtherCallMetricValue,
               sizeof(kViewOtherCallMetricValue) - 1, tag_values);
-      LoadRecordValue value = LoadRecordValue(
-          metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key),
+                         LoadRecordValue(metric_name,
+                                         static_cast<uint64_t>(num_calls),
+                                         total_metric_value));
     }
   }
 }
@@ -508,9 +502,15 @@ void LoadReporter::FetchAndSample() {
           this);
   CensusViewProvider::ViewDataMap view_data_map =
       census_view_provider_->FetchViewData();
-  ProcessViewDataCallStart(view_data_map);
-  ProcessViewDataCallEnd(view_data_map);
-  ProcessViewDataOtherCallMetrics(view_data_map);
+  // Parse the rows without the lock, which the report streams also take.
+  std::vector<LoadRow> rows;
+  ProcessViewDataCallStart(view_data_map, &rows);
+  ProcessViewDataCallEnd(view_data_map, &rows);
+  ProcessViewDataOtherCallMetrics(view_data_map, &rows);
+  grpc_core::MutexLock lock(&store_mu_);
+  for (const LoadRow& row : rows) {
+    load_data_store_.MergeRow(row.host, row.key, row.value);
+  }
 }
 
 }  // namespace load_reporter
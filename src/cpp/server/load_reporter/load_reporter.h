@@ -195,18 +195,31 @@ class LoadReporter {
           cpu_limit(cpu_limit) {}
   };
 
-  // Finds the view data about starting call from the view_data_map and merges
-  // the data to the load data store.
+  // A row of load data fetched from Census, to merge into the store.
+  struct LoadRow {
+    LoadRow(std::string host, LoadRecordKey key, LoadRecordValue value)
+        : host(std::move(host)), key(std::move(key)), value(std::move(value)) {}
+
+    std::string host;
+    LoadRecordKey key;
+    LoadRecordValue value;
+  };
+
+  // Finds the view data about starting call from the view_data_map and
+  // appends its rows to rows.
   void ProcessViewDataCallStart(
-      const CensusViewProvider::ViewDataMap& view_data_map);
-  // Finds the view data about ending call from the view_data_map and merges the
-  // data to the load data store.
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadRow>* rows);
+  // Finds the view data about ending call from the view_data_map and appends
+  // its rows to rows.
   void ProcessViewDataCallEnd(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadRow>* rows);
   // Finds the view data about the customized call metrics from the
-  // view_data_map and merges the data to the load data store.
+  // view_data_map and appends its rows to rows.
   void ProcessViewDataOtherCallMetrics(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadRow>* rows);
 
   bool IsRecordInWindow(const LoadBalancingFeedbackRecord& record,
                         std::chrono::system_clock::time_point now) {
@@ -224,8 +237,8 @@ class LoadReporter {
   const std::chrono::seconds feedback_sample_window_seconds_;
   grpc_core::Mutex feedback_mu_;
   std::deque<LoadBalancingFeedbackRecord> feedback_records_;
-  // TODO(juanlishen): Lock in finer grain. Locking the whole store may be
-  // too expensive.
+  // Held once per fetch to merge all the rows parsed from Census, and by the
+  // report streams.
   grpc_core::Mutex store_mu_;
   LoadDataStore load_data_store_;
   std::unique_ptr<CensusViewProvider> census_view_provider_;
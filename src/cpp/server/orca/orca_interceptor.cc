@@ -14,9 +14,18 @@
 // limitations under the License.
 //
 
+#include <grpc/support/port_platform.h>
+
 #include "src/cpp/server/orca/orca_interceptor.h"
 
+#include <stdint.h>
+
+#ifdef GPR_POSIX_TIME
+#include <time.h>
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -27,27 +36,112 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
+#include <grpc/support/cpu.h>
+#include <grpc/support/time.h>
 #include <grpcpp/ext/call_metric_recorder.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/config.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
 namespace grpc {
 namespace experimental {
 
+namespace {
+
+constexpr char kCpuTimeRequestCost[] = "grpc.cpu_time_ms";
+
+// The CPU time of the calling thread, or of the whole process, in seconds.
+// -1 where the platform cannot tell.
+double CpuSeconds(bool process) {
+#ifdef GPR_POSIX_TIME
+  struct timespec ts;
+  if (clock_gettime(process ? CLOCK_PROCESS_CPUTIME_ID
+                            : CLOCK_THREAD_CPUTIME_ID,
+                    &ts) == 0) {
+    return static_cast<double>(ts.tv_sec) + ts.tv_nsec * 1e-9;
+  }
+#else
+  (void)process;
+#endif
+  return -1;
+}
+
+// Samples the CPU utilization of the process at most once a second: calls
+// in between only load the last sample.
+class ProcessCpuSampler {
+ public:
+  // From 0 to 1, or -1 until two samples were taken.
+  double Utilization() {
+    const int64_t now_ms =
+        gpr_time_to_millis(gpr_now(GPR_CLOCK_MONOTONIC));
+    if (now_ms >= next_sample_ms_.load(std::memory_order_relaxed) &&
+        !sampling_.exchange(true, std::memory_order_acquire)) {
+      Sample(now_ms);
+      sampling_.store(false, std::memory_order_release);
+    }
+    return utilization_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr int64_t kSampleIntervalMs = 1000;
+
+  void Sample(int64_t now_ms) {
+    const double cpu_seconds = CpuSeconds(/*process=*/true);
+    if (cpu_seconds < 0) {
+      // Never known here: stop trying.
+      next_sample_ms_.store(INT64_MAX, std::memory_order_relaxed);
+      return;
+    }
+    if (last_sample_ms_ >= 0 && now_ms > last_sample_ms_) {
+      const double wall_seconds = (now_ms - last_sample_ms_) / 1000.0;
+      const double utilization = (cpu_seconds - last_cpu_seconds_) /
+                                 wall_seconds /
+                                 std::max(1u, gpr_cpu_num_cores());
+      utilization_.store(std::min(std::max(utilization, 0.0), 1.0),
+                         std::memory_order_relaxed);
+    }
+    last_sample_ms_ = now_ms;
+    last_cpu_seconds_ = cpu_seconds;
+    next_sample_ms_.store(now_ms + kSampleIntervalMs,
+                          std::memory_order_relaxed);
+  }
+
+  std::atomic<bool> sampling_{false};
+  std::atomic<int64_t> next_sample_ms_{0};
+  std::atomic<double> utilization_{-1};
+  // Only used by the thread that set sampling_.
+  int64_t last_sample_ms_ = -1;
+  double last_cpu_seconds_ = 0;
+};
+
+constexpr int64_t ProcessCpuSampler::kSampleIntervalMs;
+
+ProcessCpuSampler* GetProcessCpuSampler() {
+  static ProcessCpuSampler* sampler = new ProcessCpuSampler();
+  return sampler;
+}
+
+}  // namespace
+
 void OrcaServerInterceptor::Intercept(InterceptorBatchMethods* methods) {
   if (methods->QueryInterceptionHookPoint(
           InterceptionHookPoints::POST_RECV_INITIAL_METADATA)) {
     auto context = info_->server_context();
     context->CreateCallMetricRecorder();
+    if (record_cpu_stats_) {
+      start_thread_ = std::this_thread::get_id();
+      start_cpu_seconds_ = CpuSeconds(/*process=*/false);
+    }
   } else if (methods->QueryInterceptionHookPoint(
                  InterceptionHookPoints::PRE_SEND_STATUS)) {
     auto trailers = methods->GetSendTrailingMetadata();
     if (trailers != nullptr) {
       auto context = info_->server_context();
       auto* recorder = context->call_metric_recorder_;
+      if (record_cpu_stats_) RecordCpuStats(recorder);
       auto serialized = recorder->CreateSerializedReport();
       if (serialized.has_value() && !serialized->empty()) {
         std::string key =
@@ -60,19 +154,43 @@ void OrcaServerInterceptor::Intercept(InterceptorBatchMethods* methods) {
   methods->Proceed();
 }
 
+void OrcaServerInterceptor::RecordCpuStats(CallMetricRecorder* recorder) {
+  // Another thread's CPU time tells nothing about this RPC.
+  double cpu_time_ms = -1;
+  if (start_cpu_seconds_ >= 0 &&
+      std::this_thread::get_id() == start_thread_) {
+    cpu_time_ms = (CpuSeconds(/*process=*/false) - start_cpu_seconds_) * 1000;
+  }
+  const double utilization = GetProcessCpuSampler()->Utilization();
+  internal::MutexLock lock(&recorder->mu_);
+  grpc_core::BackendMetricData* data = recorder->backend_metric_data_;
+  // What the handler recorded takes precedence.
+  if (cpu_time_ms >= 0) {
+    data->request_cost.emplace(kCpuTimeRequestCost, cpu_time_ms);
+  }
+  if (data->cpu_utilization == -1 && utilization >= 0) {
+    data->cpu_utilization = utilization;
+  }
+}
+
 Interceptor* OrcaServerInterceptorFactory::CreateServerInterceptor(
     ServerRpcInfo* info) {
-  return new OrcaServerInterceptor(info);
+  return new OrcaServerInterceptor(info, record_cpu_stats_);
 }
 
-void OrcaServerInterceptorFactory::Register(grpc::ServerBuilder* builder) {
+void OrcaServerInterceptorFactory::Register(grpc::ServerBuilder* builder,
+                                            bool record_cpu_stats) {
   builder->internal_interceptor_creators_.push_back(
-      absl::make_unique<OrcaServerInterceptorFactory>());
+      absl::make_unique<OrcaServerInterceptorFactory>(record_cpu_stats));
 }
 
 void EnableCallMetricRecording(grpc::ServerBuilder* builder) {
   OrcaServerInterceptorFactory::Register(builder);
 }
 
+void EnableCallMetricRecordingWithCpuStats(grpc::ServerBuilder* builder) {
+  OrcaServerInterceptorFactory::Register(builder, /*record_cpu_stats=*/true);
+}
+
 }  // namespace experimental
 }  // namespace grpc
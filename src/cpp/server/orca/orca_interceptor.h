@@ -17,6 +17,8 @@
 #ifndef GRPC_INTERNAL_CPP_ORCA_ORCA_INTERCEPTOR_H
 #define GRPC_INTERNAL_CPP_ORCA_ORCA_INTERCEPTOR_H
 
+#include <thread>
+
 #include <grpcpp/support/interceptor.h>
 #include <grpcpp/support/server_interceptor.h>
 
@@ -27,20 +29,37 @@ class ServerBuilder;
 namespace experimental {
 class ServerRpcInfo;
 
+class CallMetricRecorder;
+
 class OrcaServerInterceptor : public Interceptor {
  public:
-  explicit OrcaServerInterceptor(ServerRpcInfo* info) : info_(info) {}
+  OrcaServerInterceptor(ServerRpcInfo* info, bool record_cpu_stats)
+      : info_(info), record_cpu_stats_(record_cpu_stats) {}
 
   void Intercept(InterceptorBatchMethods* methods) override;
 
  private:
+  // Records the CPU metrics that the handler did not record.
+  void RecordCpuStats(CallMetricRecorder* recorder);
+
   ServerRpcInfo* info_;
+  const bool record_cpu_stats_;
+  // The thread that received the initial metadata, and its CPU time then, in
+  // seconds, or -1.
+  std::thread::id start_thread_;
+  double start_cpu_seconds_ = -1;
 };
 
 class OrcaServerInterceptorFactory : public ServerInterceptorFactoryInterface {
  public:
-  static void Register(ServerBuilder* builder);
+  explicit OrcaServerInterceptorFactory(bool record_cpu_stats)
+      : record_cpu_stats_(record_cpu_stats) {}
+
+  static void Register(ServerBuilder* builder, bool record_cpu_stats = false);
   Interceptor* CreateServerInterceptor(ServerRpcInfo* info) override;
+
+ private:
+  const bool record_cpu_stats_;
 };
 
 }  // namespace experimental
@@ -0,0 +1,201 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/generic/proxying_generic_service.h>
+
+#include <map>
+#include <string>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/support/config.h>
+#include <grpcpp/support/string_ref.h>
+
+namespace grpc {
+
+namespace {
+
+// Metadata that the transport generates for each call, and so must not be
+// copied from one call to the other.
+bool IsForwardedMetadataKey(const grpc::string_ref& key) {
+  absl::string_view k(key.data(), key.size());
+  return !k.empty() && k[0] != ':' && !absl::StartsWith(k, "grpc-") &&
+         k != "user-agent" && k != "content-type" && k != "te";
+}
+
+std::string ToString(const grpc::string_ref& s) {
+  return std::string(s.data(), s.size());
+}
+
+// Proxies one call to the backend. The server side reads a request into
+// request_, the client side writes it and only then is the next request read;
+// responses go the other way through response_. The client call carries one
+// hold per direction so that it outlives both. Once the backend stops sending
+// responses the remaining requests are dropped, and the server call is
+// finished with the backend's status from the client call's OnDone, when no
+// write to the caller can be outstanding.
+class ProxyReactor : public ServerGenericBidiReactor {
+ public:
+  ProxyReactor(GenericStub* stub, GenericCallbackServerContext* ctx)
+      : client_(this), server_ctx_(ctx) {
+    for (const auto& md : ctx->client_metadata()) {
+      if (IsForwardedMetadataKey(md.first)) {
+        client_ctx_.AddMetadata(ToString(md.first), ToString(md.second));
+      }
+    }
+    client_ctx_.set_deadline(ctx->deadline());
+    stub->PrepareBidiStreamingCall(&client_ctx_, ctx->method(), StubOptions(),
+                                   &client_);
+    client_.AddMultipleHolds(2);
+    client_.StartCall();
+    StartRead(&request_);
+  }
+
+  // Requests, from the caller to the backend.
+  void OnReadDone(bool ok) override {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!request_hold_) return;
+      if (!ok) request_hold_ = false;
+      // Keeps the client call alive even if the responses end meanwhile.
+      client_.AddHold();
+    }
+    if (ok) {
+      client_.StartWrite(&request_);
+    } else {
+      client_.StartWritesDone();
+      client_.RemoveHold();
+    }
+    client_.RemoveHold();
+  }
+
+  // Responses, from the backend to the caller.
+  void OnSendInitialMetadataDone(bool ok) override {
+    if (ok) {
+      client_.StartRead(&response_);
+    } else {
+      client_ctx_.TryCancel();
+      EndResponses();
+    }
+  }
+  void OnWriteDone(bool ok) override {
+    if (ok) {
+      client_.StartRead(&response_);
+    } else {
+      client_ctx_.TryCancel();
+      EndResponses();
+    }
+  }
+
+  void OnCancel() override { client_ctx_.TryCancel(); }
+  void OnDone() override { delete this; }
+
+ private:
+  class Client : public ClientBidiReactor<ByteBuffer, ByteBuffer> {
+   public:
+    explicit Client(ProxyReactor* proxy) : proxy_(proxy) {}
+
+    void OnReadInitialMetadataDone(bool ok) override {
+      proxy_->OnBackendInitialMetadataDone(ok);
+    }
+    void OnReadDone(bool ok) override { proxy_->OnBackendReadDone(ok); }
+    void OnWriteDone(bool ok) override { proxy_->OnBackendWriteDone(ok); }
+    void OnDone(const grpc::Status& s) override { proxy_->OnBackendDone(s); }
+
+   private:
+    ProxyReactor* const proxy_;
+  };
+
+  void OnBackendInitialMetadataDone(bool ok) {
+    if (!ok) {
+      EndResponses();
+      return;
+    }
+    CopyMetadata(client_ctx_.GetServerInitialMetadata(),
+                 &ServerContextBase::AddInitialMetadata);
+    StartSendInitialMetadata();
+  }
+  void OnBackendReadDone(bool ok) {
+    if (ok) {
+      StartWrite(&response_);
+    } else {
+      EndResponses();
+    }
+  }
+  void OnBackendWriteDone(bool ok) {
+    if (ok) {
+      StartRead(&request_);
+      return;
+    }
+    bool release;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      release = request_hold_;
+      request_hold_ = false;
+    }
+    if (release) client_.RemoveHold();
+  }
+  void OnBackendDone(const grpc::Status& s) {
+    CopyMetadata(client_ctx_.GetServerTrailingMetadata(),
+                 &ServerContextBase::AddTrailingMetadata);
+    Finish(s);
+  }
+
+  // Releases both holds on the client call, unless the request hold is
+  // already gone.
+  void EndResponses() {
+    bool release_request_hold;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      release_request_hold = request_hold_;
+      request_hold_ = false;
+    }
+    if (release_request_hold) client_.RemoveHold();
+    client_.RemoveHold();
+  }
+
+  void CopyMetadata(
+      const std::multimap<grpc::string_ref, grpc::string_ref>& metadata,
+      void (ServerContextBase::*add)(const std::string&, const std::string&)) {
+    for (const auto& md : metadata) {
+      if (IsForwardedMetadataKey(md.first)) {
+        (server_ctx_->*add)(ToString(md.first), ToString(md.second));
+      }
+    }
+  }
+
+  Client client_;
+  GenericCallbackServerContext* const server_ctx_;
+  ClientContext client_ctx_;
+  ByteBuffer request_;
+  ByteBuffer response_;
+  grpc::internal::Mutex mu_;
+  // Whether the request direction still holds the client call.
+  bool request_hold_ ABSL_GUARDED_BY(mu_) = true;
+};
+
+}  // namespace
+
+ServerGenericBidiReactor* ProxyingGenericService::CreateReactor(
+    GenericCallbackServerContext* ctx) {
+  return new ProxyReactor(&stub_, ctx);
+}
+
+}  // namespace grpc
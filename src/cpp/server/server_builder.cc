@@ -30,6 +30,7 @@
 #include <grpc/grpc.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/workaround_list.h>
@@ -44,6 +45,7 @@
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/callback_method_executor.h>
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/config.h>
 #include <grpcpp/support/server_interceptor.h>
@@ -160,6 +162,15 @@ void ServerBuilder::experimental_type::SetAuthorizationPolicyProvider(
   builder_->authorization_provider_ = std::move(provider);
 }
 
+void ServerBuilder::experimental_type::SetCallbackMethodExecutor(
+    const std::string& method_or_service,
+    std::shared_ptr<experimental::CallbackMethodExecutor> executor,
+    int priority, int max_concurrency) {
+  GPR_ASSERT(executor != nullptr);
+  builder_->callback_method_executors_.push_back(
+      {method_or_service, std::move(executor), priority, max_concurrency});
+}
+
 ServerBuilder& ServerBuilder::SetOption(
     std::unique_ptr<ServerBuilderOption> option) {
   options_.push_back(std::move(option));
@@ -181,6 +192,9 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case PIN_CQS_TO_CPUS:
+      sync_server_settings_.pin_cqs_to_cpus = val != 0;
+      break;
   }
   return *this;
 }
@@ -334,9 +348,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
         is_hybrid_server ? GRPC_CQ_NON_POLLING : GRPC_CQ_DEFAULT_POLLING;
 
     // Create completion queues to listen to incoming rpc requests
+    const int num_cpus = static_cast<int>(gpr_cpu_num_cores());
     for (int i = 0; i < sync_server_settings_.num_cqs; i++) {
-      sync_server_cqs->emplace_back(
-          new grpc::ServerCompletionQueue(GRPC_CQ_NEXT, polling_type, nullptr));
+      sync_server_cqs->emplace_back(new grpc::ServerCompletionQueue(
+          GRPC_CQ_NEXT, polling_type, nullptr,
+          sync_server_settings_.pin_cqs_to_cpus ? i % num_cpus : -1));
     }
   }
 
@@ -407,6 +423,13 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
 
   server->RegisterContextAllocator(std::move(context_allocator_));
 
+  for (const auto& entry : callback_method_executors_) {
+    experimental::CallbackMethodExecutor::MethodClass* method_class =
+        entry.executor->AddMethodClass(entry.priority, entry.max_concurrency);
+    server->RegisterCallbackMethodExecutor(
+        entry.method_or_service, entry.executor, method_class);
+  }
+
   for (const auto& value : services_) {
     if (!server->RegisterService(value->host.get(), value->service)) {
       return nullptr;
@@ -30,6 +30,8 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
 
 #include <grpc/byte_buffer.h>
 #include <grpc/grpc.h>
@@ -60,6 +62,7 @@
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/callback_method_executor.h>
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/client_interceptor.h>
 #include <grpcpp/support/config.h>
@@ -94,6 +97,7 @@ namespace {
 // Give a useful status error message if the resource is exhausted specifically
 // because the server threadpool is full.
 const char* kServerThreadpoolExhausted = "Server Threadpool Exhausted";
+const char* kServerDeadlineTooClose = "Too little time left to handle call";
 
 // Although we might like to give a useful status error message on unimplemented
 // RPCs, it's not always possible since that also would need to be added across
@@ -417,7 +421,18 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
     request_metadata_.count = 0;
 
     global_callbacks_ = global_callbacks;
-    resources_ = resources;
+    handler_ = resources ? method_->handler()
+                         : server_->resource_exhausted_handler_.get();
+    // The call may have waited for a thread until it cannot finish in time:
+    // fail it without deserializing its request or running its handler.
+    if (resources && server_->deadline_exceeded_handler_ != nullptr &&
+        gpr_time_cmp(gpr_convert_clock_type(deadline_, GPR_CLOCK_MONOTONIC),
+                     gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                  gpr_time_from_millis(
+                                      server_->min_deadline_budget_ms_,
+                                      GPR_TIMESPAN))) < 0) {
+      handler_ = server_->deadline_exceeded_handler_.get();
+    }
 
     interceptor_methods_.SetCall(&*wrapped_call_);
     interceptor_methods_.SetReverse();
@@ -428,10 +443,8 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
 
     if (has_request_payload_) {
       // Set interception point for RECV MESSAGE
-      auto* handler = resources_ ? method_->handler()
-                                 : server_->resource_exhausted_handler_.get();
-      deserialized_request_ = handler->Deserialize(call_, request_payload_,
-                                                   &request_status_, nullptr);
+      deserialized_request_ = handler_->Deserialize(
+          call_, request_payload_, &request_status_, &handler_data_);
       if (!request_status_.ok()) {
         gpr_log(GPR_DEBUG, "Failed to deserialize message.");
       }
@@ -453,11 +466,9 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
   void ContinueRunAfterInterception() {
     ctx_->ctx.BeginCompletionOp(&*wrapped_call_, nullptr, nullptr);
     global_callbacks_->PreSynchronousRequest(&ctx_->ctx);
-    auto* handler = resources_ ? method_->handler()
-                               : server_->resource_exhausted_handler_.get();
-    handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
+    handler_->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
         &*wrapped_call_, &ctx_->ctx, deserialized_request_, request_status_,
-        nullptr, nullptr));
+        handler_data_, nullptr));
     global_callbacks_->PostSynchronousRequest(&ctx_->ctx);
 
     cq_.Shutdown();
@@ -514,8 +525,9 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
   grpc::CompletionQueue cq_;
   grpc::Status request_status_;
   std::shared_ptr<GlobalCallbacks> global_callbacks_;
-  bool resources_;
+  grpc::internal::MethodHandler* handler_;
   void* deserialized_request_ = nullptr;
+  void* handler_data_ = nullptr;
   grpc::internal::InterceptorBatchMethodsImpl interceptor_methods_;
 
   // ServerContextWrapper allows ManualConstructor while using a private
@@ -542,11 +554,15 @@ class Server::CallbackRequest final
   // For codegen services, the value of method represents the defined
   // characteristics of the method being requested. For generic services, method
   // is nullptr since these services don't have pre-defined methods.
-  CallbackRequest(Server* server, grpc::internal::RpcServiceMethod* method,
-                  grpc::CompletionQueue* cq,
-                  grpc_core::Server::RegisteredCallAllocation* data)
+  // If method_class is set, the handler is started on its executor.
+  CallbackRequest(
+      Server* server, grpc::internal::RpcServiceMethod* method,
+      grpc::experimental::CallbackMethodExecutor::MethodClass* method_class,
+      grpc::CompletionQueue* cq,
+      grpc_core::Server::RegisteredCallAllocation* data)
       : server_(server),
         method_(method),
+        method_class_(method_class),
         has_request_payload_(method->method_type() ==
                                  grpc::internal::RpcMethod::NORMAL_RPC ||
                              method->method_type() ==
@@ -567,8 +583,8 @@ class Server::CallbackRequest final
                   grpc_core::Server::BatchCallAllocation* data)
       : server_(server),
         method_(nullptr),
+        method_class_(nullptr),
         has_request_payload_(false),
-        call_details_(new grpc_call_details),
         cq_(cq),
         tag_(this),
         ctx_(server_->context_allocator() != nullptr
@@ -576,12 +592,11 @@ class Server::CallbackRequest final
                        ->NewGenericCallbackServerContext()
                  : nullptr) {
     CommonSetup(server, data);
-    grpc_call_details_init(call_details_);
-    data->details = call_details_;
+    grpc_call_details_init(&call_details_);
+    data->details = &call_details_;
   }
 
   ~CallbackRequest() override {
-    delete call_details_;
     grpc_metadata_array_destroy(&request_metadata_);
     if (has_request_payload_ && request_payload_) {
       grpc_byte_buffer_destroy(request_payload_);
@@ -634,8 +649,8 @@ class Server::CallbackRequest final
 
       if (!ok) {
         // The call has been shutdown.
-        // Delete its contents to free up the request.
-        delete req_;
+        // Destroy its contents to free up the request.
+        req_->~CallbackRequest();
         return;
       }
 
@@ -691,12 +706,20 @@ class Server::CallbackRequest final
       }
     }
     void ContinueRunAfterInterception() {
+      if (req_->method_class_ != nullptr) {
+        grpc::experimental::CallbackMethodExecutor::Run(
+            req_->method_class_, [this] { RunHandler(); });
+      } else {
+        RunHandler();
+      }
+    }
+    void RunHandler() {
       auto* handler = (req_->method_ != nullptr)
                           ? req_->method_->handler()
                           : req_->server_->generic_handler_.get();
       handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
           call_, req_->ctx_, req_->request_, req_->request_status_,
-          req_->handler_data_, [this] { delete req_; }));
+          req_->handler_data_, [this] { req_->~CallbackRequest(); }));
     }
   };
 
@@ -718,12 +741,13 @@ class Server::CallbackRequest final
 
   Server* const server_;
   grpc::internal::RpcServiceMethod* const method_;
+  grpc::experimental::CallbackMethodExecutor::MethodClass* const method_class_;
   const bool has_request_payload_;
   grpc_byte_buffer* request_payload_ = nullptr;
   void* request_ = nullptr;
   void* handler_data_ = nullptr;
   grpc::Status request_status_;
-  grpc_call_details* const call_details_ = nullptr;
+  grpc_call_details call_details_;
   grpc_call* call_;
   gpr_timespec deadline_;
   grpc_metadata_array request_metadata_;
@@ -746,13 +770,13 @@ bool Server::CallbackRequest<
     grpc::GenericCallbackServerContext>::FinalizeResult(void** /*tag*/,
                                                         bool* status) {
   if (*status) {
-    deadline_ = call_details_->deadline;
+    deadline_ = call_details_.deadline;
     // TODO(yangg) remove the copy here
-    ctx_->method_ = grpc::StringFromCopiedSlice(call_details_->method);
-    ctx_->host_ = grpc::StringFromCopiedSlice(call_details_->host);
+    ctx_->method_ = grpc::StringFromCopiedSlice(call_details_.method);
+    ctx_->host_ = grpc::StringFromCopiedSlice(call_details_.host);
   }
-  grpc_slice_unref(call_details_->method);
-  grpc_slice_unref(call_details_->host);
+  grpc_slice_unref(call_details_.method);
+  grpc_slice_unref(call_details_.host);
   return false;
 }
 
@@ -817,11 +841,12 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
 
   void AddSyncMethod(grpc::internal::RpcServiceMethod* method, void* tag) {
     grpc_core::Server::FromC(server_->server())
-        ->SetRegisteredMethodAllocator(server_cq_->cq(), tag, [this, method] {
-          grpc_core::Server::RegisteredCallAllocation result;
-          new SyncRequest(server_, method, &result);
-          return result;
-        });
+        ->SetRegisteredMethodAllocator(
+            server_cq_->cq(), tag, [this, method](grpc_call* /*call*/) {
+              grpc_core::Server::RegisteredCallAllocation result;
+              new SyncRequest(server_, method, &result);
+              return result;
+            });
     has_sync_method_ = true;
   }
 
@@ -831,11 +856,12 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
           "unknown", grpc::internal::RpcMethod::BIDI_STREAMING,
           new grpc::internal::UnknownMethodHandler(kUnknownRpcMethod));
       grpc_core::Server::FromC(server_->server())
-          ->SetBatchMethodAllocator(server_cq_->cq(), [this] {
-            grpc_core::Server::BatchCallAllocation result;
-            new SyncRequest(server_, unknown_method_.get(), &result);
-            return result;
-          });
+          ->SetBatchMethodAllocator(
+              server_cq_->cq(), [this](grpc_call* /*call*/) {
+                grpc_core::Server::BatchCallAllocation result;
+                new SyncRequest(server_, unknown_method_.get(), &result);
+                return result;
+              });
     }
   }
 
@@ -941,6 +967,10 @@ Server::Server(
         strcmp(channel_args.args[i].key, GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH)) {
       max_receive_message_size_ = channel_args.args[i].value.integer;
     }
+    if (0 == strcmp(channel_args.args[i].key,
+                    GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS)) {
+      min_deadline_budget_ms_ = channel_args.args[i].value.integer;
+    }
   }
   server_ = grpc_server_create(&channel_args, nullptr);
   grpc_server_set_config_fetcher(server_, server_config_fetcher);
@@ -1020,6 +1050,31 @@ static grpc_server_register_method_payload_handling PayloadHandlingForMethod(
   GPR_UNREACHABLE_CODE(return GRPC_SRM_PAYLOAD_NONE;);
 }
 
+void Server::RegisterCallbackMethodExecutor(
+    const std::string& method_or_service,
+    std::shared_ptr<experimental::CallbackMethodExecutor> executor,
+    experimental::CallbackMethodExecutor::MethodClass* method_class) {
+  callback_method_classes_[method_or_service] = method_class;
+  if (std::find(callback_method_executors_.begin(),
+                callback_method_executors_.end(),
+                executor) == callback_method_executors_.end()) {
+    callback_method_executors_.push_back(std::move(executor));
+  }
+}
+
+grpc::experimental::CallbackMethodExecutor::MethodClass*
+Server::CallbackMethodClass(const char* method_name) {
+  if (callback_method_classes_.empty()) return nullptr;
+  // An entry for the method itself wins over one for its service.
+  auto it = callback_method_classes_.find(method_name);
+  if (it != callback_method_classes_.end()) return it->second;
+  absl::string_view service(method_name);
+  if (!absl::ConsumePrefix(&service, "/")) return nullptr;
+  service = service.substr(0, service.find('/'));
+  it = callback_method_classes_.find(std::string(service));
+  return it != callback_method_classes_.end() ? it->second : nullptr;
+}
+
 bool Server::RegisterService(const std::string* addr, grpc::Service* service) {
   bool has_async_methods = service->has_async_methods();
   if (has_async_methods) {
@@ -1054,13 +1109,20 @@ bool Server::RegisterService(const std::string* addr, grpc::Service* service) {
     } else {
       has_callback_methods_ = true;
       grpc::internal::RpcServiceMethod* method_value = method.get();
+      grpc::experimental::CallbackMethodExecutor::MethodClass* method_class =
+          CallbackMethodClass(method->name());
       grpc::CompletionQueue* cq = CallbackCQ();
       grpc_server_register_completion_queue(server_, cq->cq(), nullptr);
       grpc_core::Server::FromC(server_)->SetRegisteredMethodAllocator(
-          cq->cq(), method_registration_tag, [this, cq, method_value] {
+          cq->cq(), method_registration_tag,
+          [this, cq, method_value, method_class](grpc_call* call) {
             grpc_core::Server::RegisteredCallAllocation result;
-            new CallbackRequest<grpc::CallbackServerContext>(this, method_value,
-                                                             cq, &result);
+            // The request is destroyed, but not freed, once the RPC is done;
+            // its memory goes away with the call's arena.
+            new (grpc_call_arena_alloc(
+                call, sizeof(CallbackRequest<grpc::CallbackServerContext>)))
+                CallbackRequest<grpc::CallbackServerContext>(
+                    this, method_value, method_class, cq, &result);
             return result;
           });
     }
@@ -1097,12 +1159,15 @@ void Server::RegisterCallbackGenericService(
   generic_handler_.reset(service->Handler());
 
   grpc::CompletionQueue* cq = CallbackCQ();
-  grpc_core::Server::FromC(server_)->SetBatchMethodAllocator(cq->cq(), [this,
-                                                                        cq] {
-    grpc_core::Server::BatchCallAllocation result;
-    new CallbackRequest<grpc::GenericCallbackServerContext>(this, cq, &result);
-    return result;
-  });
+  grpc_core::Server::FromC(server_)->SetBatchMethodAllocator(
+      cq->cq(), [this, cq](grpc_call* call) {
+        grpc_core::Server::BatchCallAllocation result;
+        new (grpc_call_arena_alloc(
+            call, sizeof(CallbackRequest<grpc::GenericCallbackServerContext>)))
+            CallbackRequest<grpc::GenericCallbackServerContext>(this, cq,
+                                                                &result);
+        return result;
+      });
 }
 
 int Server::AddListeningPort(const std::string& addr,
@@ -1209,6 +1274,11 @@ void Server::Start(grpc::ServerCompletionQueue** cqs, size_t num_cqs) {
     resource_exhausted_handler_ =
         absl::make_unique<grpc::internal::ResourceExhaustedHandler>(
             kServerThreadpoolExhausted);
+    if (min_deadline_budget_ms_ > 0) {
+      deadline_exceeded_handler_ =
+          absl::make_unique<grpc::internal::DeadlineExceededHandler>(
+              kServerDeadlineTooClose);
+    }
   }
 
   for (const auto& value : sync_req_mgrs_) {
@@ -1360,7 +1430,7 @@ grpc::CompletionQueue* Server::CallbackCQ() {
     auto* shutdown_callback = new grpc::ShutdownCallback;
     callback_cq = new grpc::CompletionQueue(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
-        shutdown_callback});
+        shutdown_callback, 0, 0, 0});
 
     // Transfer ownership of the new cq to its own shutdown callback
     shutdown_callback->TakeCQ(callback_cq);
@@ -20,10 +20,13 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <climits>
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/cpu_topology.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
@@ -44,6 +47,9 @@ ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
 }
 
 void ThreadManager::WorkerThread::Run() {
+  if (thd_mgr_->numa_node_.has_value()) {
+    grpc_core::PinCurrentThreadToNumaNode(*thd_mgr_->numa_node_);
+  }
   thd_mgr_->MainWorkLoop();
   thd_mgr_->MarkAsCompleted(this);
 }
@@ -61,8 +67,13 @@ ThreadManager::ThreadManager(const char*, grpc_resource_quota* resource_quota,
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
+      target_pollers_(min_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {}
+      max_active_threads_sofar_(0),
+      numa_node_(grpc_core::IsNumaThreadPlacementEnabled()
+                     ? absl::make_optional(
+                           grpc_core::CpuTopology::Get().NextNode())
+                     : absl::nullopt) {}
 
 ThreadManager::~ThreadManager() {
   {
@@ -124,6 +135,35 @@ void ThreadManager::CleanupCompletedThreads() {
   for (auto thd : completed_threads) delete thd;
 }
 
+void ThreadManager::PollDoneLocked(bool work_found) {
+  const double now_us = ThreadPoolController::NowMicros();
+  if (work_found && num_pollers_ == 0) {
+    no_pollers_since_us_ = now_us;
+  } else {
+    // Another poller is ready for the next item, or this one was idle.
+    controller_.RecordQueueingDelay(0);
+  }
+  switch (controller_.Decide(now_us)) {
+    case ThreadPoolController::Decision::kGrow:
+      target_pollers_ = std::min(target_pollers_ + 1, max_pollers_);
+      break;
+    case ThreadPoolController::Decision::kShrink:
+      target_pollers_ = std::max(target_pollers_ - 1, min_pollers_);
+      break;
+    case ThreadPoolController::Decision::kKeep:
+      break;
+  }
+  if (controller_.CpuSaturated(now_us)) target_pollers_ = min_pollers_;
+}
+
+void ThreadManager::StartPollingLocked() {
+  if (num_pollers_++ == 0 && no_pollers_since_us_ >= 0) {
+    controller_.RecordQueueingDelay(ThreadPoolController::NowMicros() -
+                                    no_pollers_since_us_);
+    no_pollers_since_us_ = -1;
+  }
+}
+
 void ThreadManager::Initialize() {
   if (!thread_quota_->Reserve(min_pollers_)) {
     gpr_log(GPR_ERROR,
@@ -161,7 +201,8 @@ void ThreadManager::MainWorkLoop() {
       case TIMEOUT:
         // If we timed out and we have more pollers than we need (or we are
         // shutdown), finish this thread
-        if (shutdown_ || num_pollers_ > max_pollers_) done = true;
+        PollDoneLocked(/*work_found=*/false);
+        if (shutdown_ || num_pollers_ > target_pollers_) done = true;
         break;
       case SHUTDOWN:
         // If the thread manager is shutdown, finish this thread
@@ -171,10 +212,11 @@ void ThreadManager::MainWorkLoop() {
         // If we got work and there are now insufficient pollers and there is
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
+        PollDoneLocked(/*work_found=*/true);
+        if (!shutdown_ && num_pollers_ < target_pollers_) {
           if (thread_quota_->Reserve(1)) {
             // We can allocate a new poller thread
-            num_pollers_++;
+            StartPollingLocked();
             num_threads_++;
             if (num_threads_ > max_active_threads_sofar_) {
               max_active_threads_sofar_ = num_threads_;
@@ -195,7 +237,9 @@ void ThreadManager::MainWorkLoop() {
           } else if (num_pollers_ > 0) {
             // There is still at least some thread polling, so we can go on
             // even though we are below the number of pollers that we would
-            // like to have (min_pollers_)
+            // like to have (target_pollers_). Threads are scarce: keep no
+            // more polling than needed.
+            target_pollers_ = min_pollers_;
             lock.Release();
           } else {
             // There are no pollers to spare and we couldn't allocate
@@ -249,7 +293,7 @@ void ThreadManager::MainWorkLoop() {
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
     if (num_pollers_ < max_pollers_) {
-      num_pollers_++;
+      StartPollingLocked();
     } else {
       break;
     }
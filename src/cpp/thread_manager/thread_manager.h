@@ -19,12 +19,17 @@
 #ifndef GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 #define GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 
+#include <stddef.h>
+
 #include <list>
 
+#include "absl/types/optional.h"
+
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/thread_quota.h"
+#include "src/cpp/thread_manager/thread_pool_controller.h"
 
 namespace grpc {
 
@@ -139,8 +144,14 @@ class ThreadManager {
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
-  // Protects shutdown_, num_pollers_, num_threads_ and
-  // max_active_threads_sofar_
+  // Called with mu_ held when a thread is done polling, and when one starts:
+  // they time how long work waited for a poller, and size target_pollers_
+  // from it.
+  void PollDoneLocked(bool work_found);
+  void StartPollingLocked();
+
+  // Protects shutdown_, num_pollers_, num_threads_, the poller sizing state
+  // and max_active_threads_sofar_
   grpc_core::Mutex mu_;
 
   bool shutdown_;
@@ -161,6 +172,15 @@ class ThreadManager {
   int min_pollers_;
   int max_pollers_;
 
+  // How many threads to keep polling, from min_pollers_ to max_pollers_:
+  // more while work waits for a poller, fewer when it doesn't or when the
+  // CPUs are busy anyway.
+  int target_pollers_;
+  ThreadPoolController controller_;
+  // Since when no thread polls, or -1 while some do. Work arriving in between
+  // waits, for up to the time until one polls again.
+  double no_pollers_since_us_ = -1;
+
   // The total number of threads currently active (includes threads includes the
   // threads that are currently polling i.e num_pollers_)
   int num_threads_;
@@ -170,6 +190,10 @@ class ThreadManager {
   // ever set so far
   int max_active_threads_sofar_;
 
+  // The NUMA node all threads of this ThreadManager run on, if they are
+  // pinned.
+  const absl::optional<size_t> numa_node_;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
@@ -0,0 +1,100 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/cpp/thread_manager/thread_pool_controller.h"
+
+#ifdef GPR_POSIX_TIME
+#include <time.h>
+#endif
+
+#include <algorithm>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/time.h>
+
+namespace grpc {
+
+constexpr double ThreadPoolController::kTargetQueueingDelayUs;
+constexpr double ThreadPoolController::kShrinkQueueingDelayUs;
+constexpr double ThreadPoolController::kControlIntervalUs;
+constexpr double ThreadPoolController::kCpuSaturation;
+
+namespace {
+// Weight of each new delay in the moving average.
+constexpr double kDelayWeight = 0.1;
+}  // namespace
+
+ThreadPoolController::ThreadPoolController(double (*cpu_seconds)())
+    : cpu_seconds_(cpu_seconds) {}
+
+void ThreadPoolController::RecordQueueingDelay(double delay_us) {
+  queueing_delay_us_ += kDelayWeight * (delay_us - queueing_delay_us_);
+}
+
+ThreadPoolController::Decision ThreadPoolController::Decide(double now_us) {
+  if (now_us < next_decision_us_) return Decision::kKeep;
+  next_decision_us_ = now_us + kControlIntervalUs;
+  SampleCpu(now_us);
+  if (queueing_delay_us_ > kTargetQueueingDelayUs) {
+    return cpu_utilization_ >= kCpuSaturation ? Decision::kKeep
+                                              : Decision::kGrow;
+  }
+  if (queueing_delay_us_ < kShrinkQueueingDelayUs) return Decision::kShrink;
+  return Decision::kKeep;
+}
+
+bool ThreadPoolController::CpuSaturated(double now_us) {
+  if (last_cpu_sample_us_ < 0 ||
+      now_us >= last_cpu_sample_us_ + kControlIntervalUs) {
+    SampleCpu(now_us);
+  }
+  return cpu_utilization_ >= kCpuSaturation;
+}
+
+void ThreadPoolController::SampleCpu(double now_us) {
+  const double cpu_seconds = cpu_seconds_();
+  if (cpu_seconds < 0) return;
+  if (last_cpu_sample_us_ >= 0 && now_us > last_cpu_sample_us_) {
+    const double wall_seconds = (now_us - last_cpu_sample_us_) * 1e-6;
+    cpu_utilization_ =
+        std::min(std::max((cpu_seconds - last_cpu_seconds_) / wall_seconds /
+                              std::max(1u, gpr_cpu_num_cores()),
+                          0.0),
+                 1.0);
+  }
+  last_cpu_sample_us_ = now_us;
+  last_cpu_seconds_ = cpu_seconds;
+}
+
+double ThreadPoolController::NowMicros() {
+  return gpr_timespec_to_micros(gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
+double ThreadPoolController::ProcessCpuSeconds() {
+#ifdef GPR_POSIX_TIME
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0) {
+    return static_cast<double>(ts.tv_sec) + ts.tv_nsec * 1e-9;
+  }
+#endif
+  return -1;
+}
+
+}  // namespace grpc
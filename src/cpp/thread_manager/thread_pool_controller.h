@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_THREAD_POOL_CONTROLLER_H
+#define GRPC_INTERNAL_CPP_THREAD_POOL_CONTROLLER_H
+
+namespace grpc {
+
+// Sizes a thread pool by how long its work waits for a thread: the pool
+// should grow while work waits longer than kTargetQueueingDelayUs and the
+// process has CPU to spare, and may shrink once work hardly waits at all.
+// More threads than the CPUs can run would only move the wait from the pool
+// to the scheduler.
+//
+// Not thread safe: the pool calls it with its own lock held.
+class ThreadPoolController {
+ public:
+  enum class Decision { kKeep, kGrow, kShrink };
+
+  // Work waiting longer than this, on average, calls for another thread.
+  static constexpr double kTargetQueueingDelayUs = 1000;
+  // Work waiting less than this, on average, can do with a thread less.
+  static constexpr double kShrinkQueueingDelayUs = 100;
+  // Decisions are made at most this often, so that the average reflects the
+  // last one before the next.
+  static constexpr double kControlIntervalUs = 100 * 1000;
+  // The share of all cores the process may use before it counts as
+  // saturated.
+  static constexpr double kCpuSaturation = 0.9;
+
+  // cpu_seconds returns the CPU time the process has used, or -1 where the
+  // platform cannot tell, in which case the CPU never counts as saturated.
+  explicit ThreadPoolController(double (*cpu_seconds)() = ProcessCpuSeconds);
+
+  // Records that an item of work waited delay_us for a thread.
+  void RecordQueueingDelay(double delay_us);
+
+  // What the pool should do now. kKeep between control intervals.
+  Decision Decide(double now_us);
+
+  // Whether the process used nearly all the cores over the last control
+  // interval.
+  bool CpuSaturated(double now_us);
+
+  // The moving average of the recorded delays.
+  double queueing_delay_us() const { return queueing_delay_us_; }
+
+  static double NowMicros();
+  static double ProcessCpuSeconds();
+
+ private:
+  void SampleCpu(double now_us);
+
+  double (*const cpu_seconds_)();
+  double queueing_delay_us_ = 0;
+  double next_decision_us_ = 0;
+  // CPU utilization over the last interval, from 0 to 1, or -1 if unknown.
+  double cpu_utilization_ = -1;
+  double last_cpu_sample_us_ = -1;
+  double last_cpu_seconds_ = 0;
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_THREAD_POOL_CONTROLLER_H
@@ -16,6 +16,9 @@
  *
  */
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <vector>
 
 #include <grpc/byte_buffer.h>
@@ -28,6 +31,10 @@
 #include <grpcpp/support/slice.h>
 #include <grpcpp/support/status.h>
 
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/map_file.h"
+
 namespace grpc {
 
 static internal::GrpcLibraryInitializer g_gli_initializer;
@@ -81,4 +88,38 @@ Status ByteBuffer::Dump(std::vector<Slice>* slices) const {
   return Status::OK;
 }
 
+Status ByteBuffer::Compress(grpc_compression_algorithm algorithm,
+                            ByteBuffer* compressed) const {
+  if (!buffer_) {
+    return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
+  }
+  if (buffer_->type != GRPC_BB_RAW ||
+      buffer_->data.raw.compression != GRPC_COMPRESS_NONE) {
+    return Status(StatusCode::FAILED_PRECONDITION,
+                  "Buffer is already compressed.");
+  }
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  if (grpc_msg_compress(algorithm, &buffer_->data.raw.slice_buffer, &output)) {
+    compressed->set_buffer(grpc_raw_compressed_byte_buffer_create(
+        output.slices, output.count, algorithm));
+  } else {
+    *compressed = *this;
+  }
+  grpc_slice_buffer_destroy(&output);
+  return Status::OK;
+}
+
+Status ByteBuffer::FromFileRegion(int fd, uint64_t offset, size_t length,
+                                  ByteBuffer* buffer) {
+  grpc_slice slice;
+  grpc_error_handle error = grpc_map_file_region(fd, offset, length, &slice);
+  if (!error.ok()) {
+    return Status(StatusCode::INVALID_ARGUMENT, grpc_error_std_string(error));
+  }
+  buffer->set_buffer(grpc_raw_byte_buffer_create(&slice, 1));
+  grpc_slice_unref(slice);
+  return Status::OK;
+}
+
 }  // namespace grpc
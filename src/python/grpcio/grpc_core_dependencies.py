@@ -17,6 +17,8 @@
 CORE_SOURCE_FILES = [
     'src/core/ext/filters/census/grpc_context.cc',
     'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
+    'src/core/ext/filters/channel_idle/concurrency_limit_filter.cc',
+    'src/core/ext/filters/channel_idle/concurrency_limiter.cc',
     'src/core/ext/filters/channel_idle/idle_filter_state.cc',
     'src/core/ext/filters/client_channel/backend_metric.cc',
     'src/core/ext/filters/client_channel/backup_poller.cc',
@@ -37,13 +39,18 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
     'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
     'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+    'src/core/ext/filters/client_channel/lb_policy/peak_ewma/peak_ewma.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
     'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/transport_rtt_watcher.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -58,6 +65,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper_posix.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper_windows.cc',
     'src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.cc',
+    'src/core/ext/filters/client_channel/resolver/dns/dns_result_cache.cc',
     'src/core/ext/filters/client_channel/resolver/dns/native/dns_resolver.cc',
     'src/core/ext/filters/client_channel/resolver/fake/fake_resolver.cc',
     'src/core/ext/filters/client_channel/resolver/google_c2p/google_c2p_resolver.cc',
@@ -78,12 +86,15 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/http/client/http_client_filter.cc',
     'src/core/ext/filters/http/client_authority_filter.cc',
     'src/core/ext/filters/http/http_filters_plugin.cc',
+    'src/core/ext/filters/http/message_compress/compressibility_tracker.cc',
+    'src/core/ext/filters/http/message_compress/compression_dictionary_config.cc',
     'src/core/ext/filters/http/message_compress/message_compress_filter.cc',
     'src/core/ext/filters/http/message_compress/message_decompress_filter.cc',
     'src/core/ext/filters/http/server/http_server_filter.cc',
     'src/core/ext/filters/message_size/message_size_filter.cc',
     'src/core/ext/filters/rbac/rbac_filter.cc',
     'src/core/ext/filters/rbac/rbac_service_config_parser.cc',
+    'src/core/ext/filters/response_cache/response_cache_filter.cc',
     'src/core/ext/filters/server_config_selector/server_config_selector.cc',
     'src/core/ext/filters/server_config_selector/server_config_selector_filter.cc',
     'src/core/ext/transport/chttp2/alpn/alpn.cc',
@@ -97,9 +108,11 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/flow_control.cc',
     'src/core/ext/transport/chttp2/transport/frame_data.cc',
     'src/core/ext/transport/chttp2/transport/frame_goaway.cc',
+    'src/core/ext/transport/chttp2/transport/frame_memfd_data.cc',
     'src/core/ext/transport/chttp2/transport/frame_ping.cc',
     'src/core/ext/transport/chttp2/transport/frame_rst_stream.cc',
     'src/core/ext/transport/chttp2/transport/frame_settings.cc',
+    'src/core/ext/transport/chttp2/transport/frame_size_policy.cc',
     'src/core/ext/transport/chttp2/transport/frame_window_update.cc',
     'src/core/ext/transport/chttp2/transport/hpack_encoder.cc',
     'src/core/ext/transport/chttp2/transport/hpack_encoder_table.cc',
@@ -107,13 +120,17 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/hpack_parser_table.cc',
     'src/core/ext/transport/chttp2/transport/http2_settings.cc',
     'src/core/ext/transport/chttp2/transport/huffsyms.cc',
+    'src/core/ext/transport/chttp2/transport/keepalive_schedule.cc',
     'src/core/ext/transport/chttp2/transport/parsing.cc',
+    'src/core/ext/transport/chttp2/transport/stream_delivery_queue.cc',
     'src/core/ext/transport/chttp2/transport/stream_lists.cc',
     'src/core/ext/transport/chttp2/transport/stream_map.cc',
     'src/core/ext/transport/chttp2/transport/varint.cc',
     'src/core/ext/transport/chttp2/transport/writing.cc',
     'src/core/ext/transport/inproc/inproc_plugin.cc',
     'src/core/ext/transport/inproc/inproc_transport.cc',
+    'src/core/ext/transport/shm/shm_endpoint.cc',
+    'src/core/ext/transport/shm/shm_handshaker.cc',
     'src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/config_dump.upb.c',
@@ -412,6 +429,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/xds/xds_cluster_specifier_plugin.cc',
     'src/core/ext/xds/xds_common_types.cc',
     'src/core/ext/xds/xds_endpoint.cc',
+    'src/core/ext/xds/xds_filter_chain_index.cc',
     'src/core/ext/xds/xds_http_fault_filter.cc',
     'src/core/ext/xds/xds_http_filters.cc',
     'src/core/ext/xds/xds_http_rbac_filter.cc',
@@ -441,6 +459,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/compression/message_compress.cc',
     'src/core/lib/config/core_configuration.cc',
     'src/core/lib/debug/event_log.cc',
+    'src/core/lib/debug/event_trace.cc',
     'src/core/lib/debug/stats.cc',
     'src/core/lib/debug/stats_data.cc',
     'src/core/lib/debug/trace.cc',
@@ -451,9 +470,11 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/forkable.cc',
     'src/core/lib/event_engine/memory_allocator.cc',
     'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+    'src/core/lib/event_engine/posix_engine/native_dns_lookups.cc',
     'src/core/lib/event_engine/posix_engine/timer.cc',
     'src/core/lib/event_engine/posix_engine/timer_heap.cc',
     'src/core/lib/event_engine/posix_engine/timer_manager.cc',
+    'src/core/lib/event_engine/posix_engine/timer_wheel.cc',
     'src/core/lib/event_engine/resolved_address.cc',
     'src/core/lib/event_engine/slice.cc',
     'src/core/lib/event_engine/slice_buffer.cc',
@@ -464,6 +485,8 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/windows/iocp.cc',
     'src/core/lib/event_engine/windows/win_socket.cc',
     'src/core/lib/event_engine/windows/windows_engine.cc',
+    'src/core/lib/event_engine/work_queue.cc',
+    'src/core/lib/event_engine/work_stealing_thread_pool.cc',
     'src/core/lib/experiments/config.cc',
     'src/core/lib/experiments/experiments.cc',
     'src/core/lib/gpr/alloc.cc',
@@ -494,6 +517,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gpr/tmpfile_posix.cc',
     'src/core/lib/gpr/tmpfile_windows.cc',
     'src/core/lib/gpr/wrap_memcpy.cc',
+    'src/core/lib/gprpp/cpu_topology.cc',
     'src/core/lib/gprpp/env_linux.cc',
     'src/core/lib/gprpp/env_posix.cc',
     'src/core/lib/gprpp/env_windows.cc',
@@ -502,6 +526,8 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gprpp/global_config_env.cc',
     'src/core/lib/gprpp/host_port.cc',
     'src/core/lib/gprpp/mpscq.cc',
+    'src/core/lib/gprpp/mutex_contention_profiler.cc',
+    'src/core/lib/gprpp/sharded_ref_count.cc',
     'src/core/lib/gprpp/stat_posix.cc',
     'src/core/lib/gprpp/stat_windows.cc',
     'src/core/lib/gprpp/status_helper.cc',
@@ -511,6 +537,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gprpp/time.cc',
     'src/core/lib/gprpp/time_averaged_stats.cc',
     'src/core/lib/gprpp/time_util.cc',
+    'src/core/lib/gprpp/tsc_clock.cc',
     'src/core/lib/gprpp/validation_errors.cc',
     'src/core/lib/gprpp/work_serializer.cc',
     'src/core/lib/handshaker/proxy_mapper_registry.cc',
@@ -552,6 +579,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/iomgr_windows.cc',
     'src/core/lib/iomgr/load_file.cc',
     'src/core/lib/iomgr/lockfree_event.cc',
+    'src/core/lib/iomgr/map_file.cc',
     'src/core/lib/iomgr/polling_entity.cc',
     'src/core/lib/iomgr/pollset.cc',
     'src/core/lib/iomgr/pollset_set.cc',
@@ -584,6 +612,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_generic.cc',
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
     'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -665,15 +694,18 @@ CORE_SOURCE_FILES = [
     'src/core/lib/security/security_connector/ssl_utils_config.cc',
     'src/core/lib/security/security_connector/tls/tls_security_connector.cc',
     'src/core/lib/security/transport/client_auth_filter.cc',
+    'src/core/lib/security/transport/handshake_thread_pool.cc',
     'src/core/lib/security/transport/secure_endpoint.cc',
     'src/core/lib/security/transport/security_handshaker.cc',
     'src/core/lib/security/transport/server_auth_filter.cc',
     'src/core/lib/security/transport/tsi_error.cc',
     'src/core/lib/security/util/json_util.cc',
+    'src/core/lib/service_config/registered_method_path.cc',
     'src/core/lib/service_config/service_config_impl.cc',
     'src/core/lib/service_config/service_config_parser.cc',
     'src/core/lib/slice/b64.cc',
     'src/core/lib/slice/percent_encoding.cc',
+    'src/core/lib/slice/slab_pool.cc',
     'src/core/lib/slice/slice.cc',
     'src/core/lib/slice/slice_buffer.cc',
     'src/core/lib/slice/slice_refcount.cc',
@@ -713,6 +745,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/transport/timeout_encoding.cc',
     'src/core/lib/transport/transport.cc',
     'src/core/lib/transport/transport_op_string.cc',
+    'src/core/lib/transport/transport_rtt_observer.cc',
     'src/core/lib/uri/uri_parser.cc',
     'src/core/plugin_registry/grpc_plugin_registry.cc',
     'src/core/plugin_registry/grpc_plugin_registry_extra.cc',
@@ -727,6 +760,7 @@ CORE_SOURCE_FILES = [
     'src/core/tsi/alts/frame_protector/frame_handler.cc',
     'src/core/tsi/alts/handshaker/alts_handshaker_client.cc',
     'src/core/tsi/alts/handshaker/alts_shared_resource.cc',
+    'src/core/tsi/alts/handshaker/alts_session_cache.cc',
     'src/core/tsi/alts/handshaker/alts_tsi_handshaker.cc',
     'src/core/tsi/alts/handshaker/alts_tsi_utils.cc',
     'src/core/tsi/alts/handshaker/transport_security_common_api.cc',
@@ -738,9 +772,12 @@ CORE_SOURCE_FILES = [
     'src/core/tsi/fake_transport_security.cc',
     'src/core/tsi/local_transport_security.cc',
     'src/core/tsi/ssl/key_logging/ssl_key_logging.cc',
+    'src/core/tsi/ssl/key_signing/ssl_private_key_signer.cc',
     'src/core/tsi/ssl/session_cache/ssl_session_boringssl.cc',
     'src/core/tsi/ssl/session_cache/ssl_session_cache.cc',
     'src/core/tsi/ssl/session_cache/ssl_session_openssl.cc',
+    'src/core/tsi/ssl/session_cache/ssl_session_ticket_keys.cc',
+    'src/core/tsi/ssl/verification_cache/ssl_verification_cache.cc',
     'src/core/tsi/ssl_transport_security.cc',
     'src/core/tsi/transport_security.cc',
     'src/core/tsi/transport_security_grpc.cc',
@@ -26,11 +26,15 @@ grpc_compression_algorithm_is_message_type grpc_compression_algorithm_is_message
 grpc_compression_algorithm_is_stream_type grpc_compression_algorithm_is_stream_import;
 grpc_compression_algorithm_parse_type grpc_compression_algorithm_parse_import;
 grpc_compression_algorithm_name_type grpc_compression_algorithm_name_import;
+grpc_compression_algorithm_is_supported_type grpc_compression_algorithm_is_supported_import;
 grpc_compression_algorithm_for_level_type grpc_compression_algorithm_for_level_import;
 grpc_compression_options_init_type grpc_compression_options_init_import;
 grpc_compression_options_enable_algorithm_type grpc_compression_options_enable_algorithm_import;
 grpc_compression_options_disable_algorithm_type grpc_compression_options_disable_algorithm_import;
 grpc_compression_options_is_algorithm_enabled_type grpc_compression_options_is_algorithm_enabled_import;
+grpc_compression_dictionary_create_type grpc_compression_dictionary_create_import;
+grpc_compression_dictionary_unref_type grpc_compression_dictionary_unref_import;
+grpc_compression_dictionary_arg_vtable_type grpc_compression_dictionary_arg_vtable_import;
 grpc_metadata_array_init_type grpc_metadata_array_init_import;
 grpc_metadata_array_destroy_type grpc_metadata_array_destroy_import;
 grpc_call_details_init_type grpc_call_details_init_import;
@@ -47,6 +51,7 @@ grpc_completion_queue_create_for_pluck_type grpc_completion_queue_create_for_plu
 grpc_completion_queue_create_for_callback_type grpc_completion_queue_create_for_callback_import;
 grpc_completion_queue_create_type grpc_completion_queue_create_import;
 grpc_completion_queue_next_type grpc_completion_queue_next_import;
+grpc_completion_queue_next_batch_type grpc_completion_queue_next_batch_import;
 grpc_completion_queue_pluck_type grpc_completion_queue_pluck_import;
 grpc_completion_queue_shutdown_type grpc_completion_queue_shutdown_import;
 grpc_completion_queue_destroy_type grpc_completion_queue_destroy_import;
@@ -126,6 +131,9 @@ grpc_auth_context_set_peer_identity_property_name_type grpc_auth_context_set_pee
 grpc_ssl_session_cache_create_lru_type grpc_ssl_session_cache_create_lru_import;
 grpc_ssl_session_cache_destroy_type grpc_ssl_session_cache_destroy_import;
 grpc_ssl_session_cache_create_channel_arg_type grpc_ssl_session_cache_create_channel_arg_import;
+grpc_ssl_session_ticket_keys_create_type grpc_ssl_session_ticket_keys_create_import;
+grpc_ssl_session_ticket_keys_rotate_type grpc_ssl_session_ticket_keys_rotate_import;
+grpc_ssl_session_ticket_keys_release_type grpc_ssl_session_ticket_keys_release_import;
 grpc_call_credentials_release_type grpc_call_credentials_release_import;
 grpc_google_default_credentials_create_type grpc_google_default_credentials_create_import;
 grpc_set_ssl_roots_override_callback_type grpc_set_ssl_roots_override_callback_import;
@@ -176,6 +184,10 @@ grpc_tls_credentials_options_watch_identity_key_cert_pairs_type grpc_tls_credent
 grpc_tls_credentials_options_set_identity_cert_name_type grpc_tls_credentials_options_set_identity_cert_name_import;
 grpc_tls_credentials_options_set_cert_request_type_type grpc_tls_credentials_options_set_cert_request_type_import;
 grpc_tls_credentials_options_set_crl_directory_type grpc_tls_credentials_options_set_crl_directory_import;
+grpc_tls_credentials_options_set_session_ticket_keys_type grpc_tls_credentials_options_set_session_ticket_keys_import;
+grpc_tls_private_key_signer_external_create_type grpc_tls_private_key_signer_external_create_import;
+grpc_tls_private_key_signer_release_type grpc_tls_private_key_signer_release_import;
+grpc_tls_credentials_options_set_private_key_signer_type grpc_tls_credentials_options_set_private_key_signer_import;
 grpc_tls_credentials_options_set_verify_server_cert_type grpc_tls_credentials_options_set_verify_server_cert_import;
 grpc_tls_credentials_options_set_check_call_host_type grpc_tls_credentials_options_set_check_call_host_import;
 grpc_insecure_credentials_create_type grpc_insecure_credentials_create_import;
@@ -311,11 +323,15 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_compression_algorithm_is_stream_import = (grpc_compression_algorithm_is_stream_type) GetProcAddress(library, "grpc_compression_algorithm_is_stream");
   grpc_compression_algorithm_parse_import = (grpc_compression_algorithm_parse_type) GetProcAddress(library, "grpc_compression_algorithm_parse");
   grpc_compression_algorithm_name_import = (grpc_compression_algorithm_name_type) GetProcAddress(library, "grpc_compression_algorithm_name");
+  grpc_compression_algorithm_is_supported_import = (grpc_compression_algorithm_is_supported_type) GetProcAddress(library, "grpc_compression_algorithm_is_supported");
   grpc_compression_algorithm_for_level_import = (grpc_compression_algorithm_for_level_type) GetProcAddress(library, "grpc_compression_algorithm_for_level");
   grpc_compression_options_init_import = (grpc_compression_options_init_type) GetProcAddress(library, "grpc_compression_options_init");
   grpc_compression_options_enable_algorithm_import = (grpc_compression_options_enable_algorithm_type) GetProcAddress(library, "grpc_compression_options_enable_algorithm");
   grpc_compression_options_disable_algorithm_import = (grpc_compression_options_disable_algorithm_type) GetProcAddress(library, "grpc_compression_options_disable_algorithm");
   grpc_compression_options_is_algorithm_enabled_import = (grpc_compression_options_is_algorithm_enabled_type) GetProcAddress(library, "grpc_compression_options_is_algorithm_enabled");
+  grpc_compression_dictionary_create_import = (grpc_compression_dictionary_create_type) GetProcAddress(library, "grpc_compression_dictionary_create");
+  grpc_compression_dictionary_unref_import = (grpc_compression_dictionary_unref_type) GetProcAddress(library, "grpc_compression_dictionary_unref");
+  grpc_compression_dictionary_arg_vtable_import = (grpc_compression_dictionary_arg_vtable_type) GetProcAddress(library, "grpc_compression_dictionary_arg_vtable");
   grpc_metadata_array_init_import = (grpc_metadata_array_init_type) GetProcAddress(library, "grpc_metadata_array_init");
   grpc_metadata_array_destroy_import = (grpc_metadata_array_destroy_type) GetProcAddress(library, "grpc_metadata_array_destroy");
   grpc_call_details_init_import = (grpc_call_details_init_type) GetProcAddress(library, "grpc_call_details_init");
@@ -332,6 +348,7 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_completion_queue_create_for_callback_import = (grpc_completion_queue_create_for_callback_type) GetProcAddress(library, "grpc_completion_queue_create_for_callback");
   grpc_completion_queue_create_import = (grpc_completion_queue_create_type) GetProcAddress(library, "grpc_completion_queue_create");
   grpc_completion_queue_next_import = (grpc_completion_queue_next_type) GetProcAddress(library, "grpc_completion_queue_next");
+  grpc_completion_queue_next_batch_import = (grpc_completion_queue_next_batch_type) GetProcAddress(library, "grpc_completion_queue_next_batch");
   grpc_completion_queue_pluck_import = (grpc_completion_queue_pluck_type) GetProcAddress(library, "grpc_completion_queue_pluck");
   grpc_completion_queue_shutdown_import = (grpc_completion_queue_shutdown_type) GetProcAddress(library, "grpc_completion_queue_shutdown");
   grpc_completion_queue_destroy_import = (grpc_completion_queue_destroy_type) GetProcAddress(library, "grpc_completion_queue_destroy");
@@ -411,6 +428,9 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_ssl_session_cache_create_lru_import = (grpc_ssl_session_cache_create_lru_type) GetProcAddress(library, "grpc_ssl_session_cache_create_lru");
   grpc_ssl_session_cache_destroy_import = (grpc_ssl_session_cache_destroy_type) GetProcAddress(library, "grpc_ssl_session_cache_destroy");
   grpc_ssl_session_cache_create_channel_arg_import = (grpc_ssl_session_cache_create_channel_arg_type) GetProcAddress(library, "grpc_ssl_session_cache_create_channel_arg");
+  grpc_ssl_session_ticket_keys_create_import = (grpc_ssl_session_ticket_keys_create_type) GetProcAddress(library, "grpc_ssl_session_ticket_keys_create");
+  grpc_ssl_session_ticket_keys_rotate_import = (grpc_ssl_session_ticket_keys_rotate_type) GetProcAddress(library, "grpc_ssl_session_ticket_keys_rotate");
+  grpc_ssl_session_ticket_keys_release_import = (grpc_ssl_session_ticket_keys_release_type) GetProcAddress(library, "grpc_ssl_session_ticket_keys_release");
   grpc_call_credentials_release_import = (grpc_call_credentials_release_type) GetProcAddress(library, "grpc_call_credentials_release");
   grpc_google_default_credentials_create_import = (grpc_google_default_credentials_create_type) GetProcAddress(library, "grpc_google_default_credentials_create");
   grpc_set_ssl_roots_override_callback_import = (grpc_set_ssl_roots_override_callback_type) GetProcAddress(library, "grpc_set_ssl_roots_override_callback");
@@ -461,6 +481,10 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_tls_credentials_options_set_identity_cert_name_import = (grpc_tls_credentials_options_set_identity_cert_name_type) GetProcAddress(library, "grpc_tls_credentials_options_set_identity_cert_name");
   grpc_tls_credentials_options_set_cert_request_type_import = (grpc_tls_credentials_options_set_cert_request_type_type) GetProcAddress(library, "grpc_tls_credentials_options_set_cert_request_type");
   grpc_tls_credentials_options_set_crl_directory_import = (grpc_tls_credentials_options_set_crl_directory_type) GetProcAddress(library, "grpc_tls_credentials_options_set_crl_directory");
+  grpc_tls_credentials_options_set_session_ticket_keys_import = (grpc_tls_credentials_options_set_session_ticket_keys_type) GetProcAddress(library, "grpc_tls_credentials_options_set_session_ticket_keys");
+  grpc_tls_private_key_signer_external_create_import = (grpc_tls_private_key_signer_external_create_type) GetProcAddress(library, "grpc_tls_private_key_signer_external_create");
+  grpc_tls_private_key_signer_release_import = (grpc_tls_private_key_signer_release_type) GetProcAddress(library, "grpc_tls_private_key_signer_release");
+  grpc_tls_credentials_options_set_private_key_signer_import = (grpc_tls_credentials_options_set_private_key_signer_type) GetProcAddress(library, "grpc_tls_credentials_options_set_private_key_signer");
   grpc_tls_credentials_options_set_verify_server_cert_import = (grpc_tls_credentials_options_set_verify_server_cert_type) GetProcAddress(library, "grpc_tls_credentials_options_set_verify_server_cert");
   grpc_tls_credentials_options_set_check_call_host_import = (grpc_tls_credentials_options_set_check_call_host_type) GetProcAddress(library, "grpc_tls_credentials_options_set_check_call_host");
   grpc_insecure_credentials_create_import = (grpc_insecure_credentials_create_type) GetProcAddress(library, "grpc_insecure_credentials_create");
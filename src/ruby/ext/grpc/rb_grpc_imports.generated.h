@@ -53,6 +53,9 @@ extern grpc_compression_algorithm_parse_type grpc_compression_algorithm_parse_im
 typedef int(*grpc_compression_algorithm_name_type)(grpc_compression_algorithm algorithm, const char** name);
 extern grpc_compression_algorithm_name_type grpc_compression_algorithm_name_import;
 #define grpc_compression_algorithm_name grpc_compression_algorithm_name_import
+typedef int(*grpc_compression_algorithm_is_supported_type)(grpc_compression_algorithm algorithm);
+extern grpc_compression_algorithm_is_supported_type grpc_compression_algorithm_is_supported_import;
+#define grpc_compression_algorithm_is_supported grpc_compression_algorithm_is_supported_import
 typedef grpc_compression_algorithm(*grpc_compression_algorithm_for_level_type)(grpc_compression_level level, uint32_t accepted_encodings);
 extern grpc_compression_algorithm_for_level_type grpc_compression_algorithm_for_level_import;
 #define grpc_compression_algorithm_for_level grpc_compression_algorithm_for_level_import
@@ -68,6 +71,15 @@ extern grpc_compression_options_disable_algorithm_type grpc_compression_options_
 typedef int(*grpc_compression_options_is_algorithm_enabled_type)(const grpc_compression_options* opts, grpc_compression_algorithm algorithm);
 extern grpc_compression_options_is_algorithm_enabled_type grpc_compression_options_is_algorithm_enabled_import;
 #define grpc_compression_options_is_algorithm_enabled grpc_compression_options_is_algorithm_enabled_import
+typedef grpc_compression_dictionary*(*grpc_compression_dictionary_create_type)(const char* data, size_t length);
+extern grpc_compression_dictionary_create_type grpc_compression_dictionary_create_import;
+#define grpc_compression_dictionary_create grpc_compression_dictionary_create_import
+typedef void(*grpc_compression_dictionary_unref_type)(grpc_compression_dictionary* dictionary);
+extern grpc_compression_dictionary_unref_type grpc_compression_dictionary_unref_import;
+#define grpc_compression_dictionary_unref grpc_compression_dictionary_unref_import
+typedef const grpc_arg_pointer_vtable*(*grpc_compression_dictionary_arg_vtable_type)(void);
+extern grpc_compression_dictionary_arg_vtable_type grpc_compression_dictionary_arg_vtable_import;
+#define grpc_compression_dictionary_arg_vtable grpc_compression_dictionary_arg_vtable_import
 typedef void(*grpc_metadata_array_init_type)(grpc_metadata_array* array);
 extern grpc_metadata_array_init_type grpc_metadata_array_init_import;
 #define grpc_metadata_array_init grpc_metadata_array_init_import
@@ -116,6 +128,9 @@ extern grpc_completion_queue_create_type grpc_completion_queue_create_import;
 typedef grpc_event(*grpc_completion_queue_next_type)(grpc_completion_queue* cq, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_next_type grpc_completion_queue_next_import;
 #define grpc_completion_queue_next grpc_completion_queue_next_import
+typedef size_t(*grpc_completion_queue_next_batch_type)(grpc_completion_queue* cq, grpc_event* events, size_t max_events, gpr_timespec deadline, void* reserved);
+extern grpc_completion_queue_next_batch_type grpc_completion_queue_next_batch_import;
+#define grpc_completion_queue_next_batch grpc_completion_queue_next_batch_import
 typedef grpc_event(*grpc_completion_queue_pluck_type)(grpc_completion_queue* cq, void* tag, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_pluck_type grpc_completion_queue_pluck_import;
 #define grpc_completion_queue_pluck grpc_completion_queue_pluck_import
@@ -353,6 +368,15 @@ extern grpc_ssl_session_cache_destroy_type grpc_ssl_session_cache_destroy_import
 typedef grpc_arg(*grpc_ssl_session_cache_create_channel_arg_type)(grpc_ssl_session_cache* cache);
 extern grpc_ssl_session_cache_create_channel_arg_type grpc_ssl_session_cache_create_channel_arg_import;
 #define grpc_ssl_session_cache_create_channel_arg grpc_ssl_session_cache_create_channel_arg_import
+typedef grpc_ssl_session_ticket_keys*(*grpc_ssl_session_ticket_keys_create_type)(void);
+extern grpc_ssl_session_ticket_keys_create_type grpc_ssl_session_ticket_keys_create_import;
+#define grpc_ssl_session_ticket_keys_create grpc_ssl_session_ticket_keys_create_import
+typedef int(*grpc_ssl_session_ticket_keys_rotate_type)(grpc_ssl_session_ticket_keys* keys, const char* key, size_t key_size);
+extern grpc_ssl_session_ticket_keys_rotate_type grpc_ssl_session_ticket_keys_rotate_import;
+#define grpc_ssl_session_ticket_keys_rotate grpc_ssl_session_ticket_keys_rotate_import
+typedef void(*grpc_ssl_session_ticket_keys_release_type)(grpc_ssl_session_ticket_keys* keys);
+extern grpc_ssl_session_ticket_keys_release_type grpc_ssl_session_ticket_keys_release_import;
+#define grpc_ssl_session_ticket_keys_release grpc_ssl_session_ticket_keys_release_import
 typedef void(*grpc_call_credentials_release_type)(grpc_call_credentials* creds);
 extern grpc_call_credentials_release_type grpc_call_credentials_release_import;
 #define grpc_call_credentials_release grpc_call_credentials_release_import
@@ -503,6 +527,18 @@ extern grpc_tls_credentials_options_set_cert_request_type_type grpc_tls_credenti
 typedef void(*grpc_tls_credentials_options_set_crl_directory_type)(grpc_tls_credentials_options* options, const char* crl_directory);
 extern grpc_tls_credentials_options_set_crl_directory_type grpc_tls_credentials_options_set_crl_directory_import;
 #define grpc_tls_credentials_options_set_crl_directory grpc_tls_credentials_options_set_crl_directory_import
+typedef void(*grpc_tls_credentials_options_set_session_ticket_keys_type)(grpc_tls_credentials_options* options, grpc_ssl_session_ticket_keys* keys);
+extern grpc_tls_credentials_options_set_session_ticket_keys_type grpc_tls_credentials_options_set_session_ticket_keys_import;
+#define grpc_tls_credentials_options_set_session_ticket_keys grpc_tls_credentials_options_set_session_ticket_keys_import
+typedef grpc_tls_private_key_signer*(*grpc_tls_private_key_signer_external_create_type)(const grpc_tls_private_key_signer_external* external_signer);
+extern grpc_tls_private_key_signer_external_create_type grpc_tls_private_key_signer_external_create_import;
+#define grpc_tls_private_key_signer_external_create grpc_tls_private_key_signer_external_create_import
+typedef void(*grpc_tls_private_key_signer_release_type)(grpc_tls_private_key_signer* signer);
+extern grpc_tls_private_key_signer_release_type grpc_tls_private_key_signer_release_import;
+#define grpc_tls_private_key_signer_release grpc_tls_private_key_signer_release_import
+typedef void(*grpc_tls_credentials_options_set_private_key_signer_type)(grpc_tls_credentials_options* options, grpc_tls_private_key_signer* signer);
+extern grpc_tls_credentials_options_set_private_key_signer_type grpc_tls_credentials_options_set_private_key_signer_import;
+#define grpc_tls_credentials_options_set_private_key_signer grpc_tls_credentials_options_set_private_key_signer_import
 typedef void(*grpc_tls_credentials_options_set_verify_server_cert_type)(grpc_tls_credentials_options* options, int verify_server_cert);
 extern grpc_tls_credentials_options_set_verify_server_cert_type grpc_tls_credentials_options_set_verify_server_cert_import;
 #define grpc_tls_credentials_options_set_verify_server_cert grpc_tls_credentials_options_set_verify_server_cert_import
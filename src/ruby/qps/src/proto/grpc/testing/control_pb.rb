@@ -11,6 +11,7 @@ Google::Protobuf::DescriptorPool.generated_pool.build do
   add_file("src/proto/grpc/testing/control.proto", :syntax => :proto3) do
     add_message "grpc.testing.PoissonParams" do
       optional :offered_load, :double, 1
+      optional :measure_from_intended_start, :bool, 2
     end
     add_message "grpc.testing.ClosedLoopParams" do
     end
@@ -131,6 +132,8 @@ Google::Protobuf::DescriptorPool.generated_pool.build do
       optional :client_queries_per_cpu_sec, :double, 18
       optional :start_time, :message, 19, "google.protobuf.Timestamp"
       optional :end_time, :message, 20, "google.protobuf.Timestamp"
+      optional :client_syscalls_per_request, :double, 21
+      optional :server_syscalls_per_request, :double, 22
     end
     add_message "grpc.testing.ScenarioResult" do
       optional :scenario, :message, 1, "grpc.testing.Scenario"
@@ -14,6 +14,9 @@
 
 #include "src/core/lib/avl/avl.h"
 
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace grpc_core {
@@ -36,6 +39,23 @@ TEST(AvlTest, Lookup) {
   EXPECT_EQ(nullptr, avl.Lookup(5));
 }
 
+TEST(AvlTest, FromSortedUnique) {
+  std::vector<std::pair<int, int>> entries;
+  AVL<int, int> added;
+  for (int i = 0; i < 100; i++) {
+    entries.emplace_back(i, i * 2);
+    added = added.Add(i, i * 2);
+  }
+  auto avl = AVL<int, int>::FromSortedUnique(entries.begin(), entries.end());
+  EXPECT_EQ(avl, added);
+  for (int i = 0; i < 100; i++) EXPECT_EQ(i * 2, *avl.Lookup(i));
+  EXPECT_EQ(nullptr, avl.Lookup(100));
+  // The result is a valid tree to keep adding to and removing from.
+  avl = avl.Add(100, 200).Remove(50);
+  EXPECT_EQ(200, *avl.Lookup(100));
+  EXPECT_EQ(nullptr, avl.Lookup(50));
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -124,6 +124,32 @@ TEST(ChannelArgsTest, ToAndFromC) {
   gpr_free(ptr);
 }
 
+TEST(ChannelArgsTest, FromCLastValueWins) {
+  grpc_arg args[] = {
+      grpc_channel_arg_integer_create(const_cast<char*>("b"), 1),
+      grpc_channel_arg_string_create(const_cast<char*>("a"),
+                                     const_cast<char*>("x")),
+      grpc_channel_arg_integer_create(const_cast<char*>("b"), 2),
+      grpc_channel_arg_integer_create(const_cast<char*>("c"), 3),
+  };
+  grpc_channel_args c_args = {GPR_ARRAY_SIZE(args), args};
+  EXPECT_EQ(ChannelArgs::FromC(&c_args),
+            ChannelArgs().Set("b", 1).Set("a", "x").Set("b", 2).Set("c", 3));
+}
+
+TEST(ChannelArgsTest, PreconditionFirstValueWins) {
+  grpc_arg args[] = {
+      grpc_channel_arg_integer_create(const_cast<char*>("b"), 1),
+      grpc_channel_arg_integer_create(const_cast<char*>("grpc.internal.x"),
+                                      1),
+      grpc_channel_arg_integer_create(const_cast<char*>("b"), 2),
+      grpc_channel_arg_integer_create(const_cast<char*>("a"), 3),
+  };
+  grpc_channel_args c_args = {GPR_ARRAY_SIZE(args), args};
+  EXPECT_EQ(ChannelArgsBuiltinPrecondition(&c_args),
+            ChannelArgs().Set("a", 3).Set("b", 1));
+}
+
 // shared_ptrs in ChannelArgs must support enable_shared_from_this
 class ShareableObject : public std::enable_shared_from_this<ShareableObject> {
  public:
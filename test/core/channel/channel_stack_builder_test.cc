@@ -21,6 +21,7 @@
 #include <limits.h>
 #include <string.h>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <grpc/grpc_security.h>
@@ -31,6 +32,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder_impl.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/experiments/config.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel_init.h"
 #include "test/core/util/test_config.h"
@@ -115,6 +117,62 @@ bool AddOriginalFilter(ChannelStackBuilder* builder) {
   return true;
 }
 
+const grpc_channel_filter fused_filter = {
+    grpc_call_next_op,    nullptr,
+    grpc_channel_next_op, 0,
+    CallInitFunc,         grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    CallDestroyFunc,      0,
+    ChannelInitFunc,      grpc_channel_stack_no_post_init,
+    ChannelDestroyFunc,   grpc_channel_next_get_info,
+    "fused_filter"};
+
+TEST(ChannelStackBuilder, FusesRegisteredRuns) {
+  ChannelInit::Builder init_builder;
+  init_builder.RegisterStage(
+      GRPC_CLIENT_DIRECT_CHANNEL, 0, [](ChannelStackBuilder* builder) {
+        builder->AppendFilter(&original_filter);
+        builder->AppendFilter(&replacement_filter);
+        builder->AppendFilter(&original_filter);
+        builder->AppendFilter(&original_filter);
+        builder->AppendFilter(&replacement_filter);
+        return true;
+      });
+  init_builder.RegisterFusedFilter(GRPC_CLIENT_DIRECT_CHANNEL,
+                                   {&original_filter, &replacement_filter},
+                                   &fused_filter);
+  ChannelInit init = init_builder.Build();
+  ChannelStackBuilderImpl builder("test", GRPC_CLIENT_DIRECT_CHANNEL);
+  ASSERT_TRUE(init.CreateStack(&builder));
+  EXPECT_THAT(*builder.mutable_stack(),
+              ::testing::ElementsAre(&fused_filter, &original_filter,
+                                     &fused_filter));
+}
+
+TEST(ChannelStackBuilder, ReusesFilterListForSameArgs) {
+  int stage_runs = 0;
+  ChannelInit::Builder init_builder;
+  init_builder.RegisterStage(GRPC_CLIENT_CHANNEL, 0,
+                             [&stage_runs](ChannelStackBuilder* builder) {
+                               ++stage_runs;
+                               builder->AppendFilter(&original_filter);
+                               return true;
+                             });
+  ChannelInit init = init_builder.Build();
+  auto create_stack = [&init](const ChannelArgs& args) {
+    ChannelStackBuilderImpl builder("test", GRPC_CLIENT_CHANNEL);
+    builder.SetChannelArgs(args);
+    EXPECT_TRUE(init.CreateStack(&builder));
+    return *builder.mutable_stack();
+  };
+  const ChannelArgs args = ChannelArgs().Set("test.arg", 1);
+  EXPECT_THAT(create_stack(args), ::testing::ElementsAre(&original_filter));
+  EXPECT_THAT(create_stack(args), ::testing::ElementsAre(&original_filter));
+  EXPECT_EQ(stage_runs, 1);
+  EXPECT_THAT(create_stack(args.Set("test.arg", 2)),
+              ::testing::ElementsAre(&original_filter));
+  EXPECT_EQ(stage_runs, 2);
+}
+
 TEST(ChannelStackBuilder, UnknownTarget) {
   ChannelStackBuilderImpl builder("alpha-beta-gamma", GRPC_CLIENT_CHANNEL);
   EXPECT_EQ(builder.target(), "unknown");
@@ -127,6 +185,8 @@ TEST(ChannelStackBuilder, UnknownTarget) {
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::ForceEnableExperiment("fused_filters", true);
+  grpc_core::ForceEnableExperiment("channel_stack_cache", true);
   grpc_core::CoreConfiguration::RegisterBuilder(
       [](grpc_core::CoreConfiguration::Builder* builder) {
         builder->channel_init()->RegisterStage(
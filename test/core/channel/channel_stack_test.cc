@@ -27,6 +27,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
 
@@ -134,6 +135,11 @@ TEST(ChannelStackTest, CreateChannelStack) {
   EXPECT_EQ(call_elem->filter, channel_elem->filter);
   EXPECT_EQ(call_elem->channel_data, channel_elem->channel_data);
   call_data = static_cast<int*>(call_elem->call_data);
+  // The call data of the last filter ends the call stack.
+  EXPECT_EQ(reinterpret_cast<char*>(call_data) +
+                GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(int)),
+            reinterpret_cast<char*>(call_stack) +
+                channel_stack->call_stack_size);
   EXPECT_EQ(*call_data, 0);
   EXPECT_EQ(*channel_data, 1);
 
@@ -21,6 +21,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -137,6 +141,49 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ConcurrentRegistration) {
+  const int kThreads = 8;
+  const int kNodesPerThread = 100;
+  std::vector<std::vector<RefCountedPtr<BaseNode>>> nodes(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&nodes, i] {
+      for (int j = 0; j < kNodesPerThread; j++) {
+        nodes[i].push_back(CreateTestNode());
+        // Churn: half of the nodes go away right after being created.
+        if (j % 2 == 1) nodes[i].pop_back();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::set<intptr_t> uuids;
+  for (const auto& thread_nodes : nodes) {
+    for (const auto& node : thread_nodes) {
+      EXPECT_TRUE(uuids.insert(node->uuid()).second);
+      EXPECT_EQ(ChannelzRegistry::Get(node->uuid()), node);
+    }
+  }
+  EXPECT_EQ(uuids.size(), kThreads * kNodesPerThread / 2);
+}
+
+TEST_F(ChannelzRegistryTest, ServerPagesSkipOtherNodes) {
+  std::vector<RefCountedPtr<BaseNode>> sockets;
+  for (int i = 0; i < 200; i++) sockets.push_back(CreateTestNode());
+  RefCountedPtr<BaseNode> server = MakeRefCounted<ServerNode>(0);
+  for (int i = 0; i < 200; i++) sockets.push_back(CreateTestNode());
+  auto json = Json::Parse(ChannelzRegistry::GetServers(0));
+  ASSERT_TRUE(json.ok()) << json.status();
+  const Json::Object& object = json->object_value();
+  ASSERT_EQ(object.count("server"), 1);
+  EXPECT_EQ(object.at("server").array_value().size(), 1);
+  EXPECT_EQ(object.count("end"), 1);
+  // Paging past the server finds nothing.
+  json = Json::Parse(ChannelzRegistry::GetServers(server->uuid() + 1));
+  ASSERT_TRUE(json.ok()) << json.status();
+  EXPECT_EQ(json->object_value().count("server"), 0);
+  EXPECT_EQ(json->object_value().count("end"), 1);
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
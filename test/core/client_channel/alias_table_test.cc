@@ -0,0 +1,117 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr uint64_t k2To32 = uint64_t(1) << 32;
+
+// The random number picking column \a column, with \a low as its low bits.
+uint64_t RandomFor(const AliasTable& table, size_t column, uint32_t low) {
+  const uint64_t high = (column * k2To32 + table.size() - 1) / table.size();
+  return (high << 32) | low;
+}
+
+// How likely \a table is to pick each index, worked out from where in each
+// column its picks switch from one index to the other.
+std::vector<double> PickProbabilities(const AliasTable& table) {
+  std::vector<double> probabilities(table.size());
+  for (size_t column = 0; column < table.size(); ++column) {
+    const size_t first = table.Pick(RandomFor(table, column, 0));
+    const size_t last = table.Pick(RandomFor(table, column, UINT32_MAX));
+    // Find the lowest low bits picking the last index.
+    uint64_t lo = 0;
+    uint64_t hi = UINT32_MAX;
+    while (lo < hi) {
+      const uint64_t mid = (lo + hi) / 2;
+      if (table.Pick(RandomFor(table, column, mid)) == last) {
+        hi = mid;
+      } else {
+        EXPECT_EQ(table.Pick(RandomFor(table, column, mid)), first);
+        lo = mid + 1;
+      }
+    }
+    const double share = static_cast<double>(lo) / k2To32;
+    probabilities[first] += share / table.size();
+    probabilities[last] += (1 - share) / table.size();
+  }
+  return probabilities;
+}
+
+void CheckProbabilities(const std::vector<uint32_t>& weights) {
+  AliasTable table(weights);
+  ASSERT_EQ(table.size(), weights.size());
+  double total = 0;
+  for (uint32_t weight : weights) total += weight;
+  const std::vector<double> probabilities = PickProbabilities(table);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(probabilities[i], weights[i] / total, 1e-6)
+        << "index " << i << " of " << weights.size();
+  }
+}
+
+TEST(AliasTableTest, SingleWeight) {
+  AliasTable table({7});
+  ASSERT_EQ(table.size(), 1);
+  for (uint64_t random : {uint64_t(0), uint64_t(12345), UINT64_MAX}) {
+    EXPECT_EQ(table.Pick(random), 0);
+  }
+}
+
+TEST(AliasTableTest, EqualWeights) { CheckProbabilities({3, 3, 3, 3, 3}); }
+
+TEST(AliasTableTest, UnequalWeights) {
+  CheckProbabilities({1, 2, 5});
+  CheckProbabilities({1, 1000000, 1});
+  CheckProbabilities({UINT32_MAX, 1, UINT32_MAX / 2});
+}
+
+TEST(AliasTableTest, ZeroWeights) {
+  AliasTable table({0, 4, 0});
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(table.Pick(rng()), 1);
+}
+
+TEST(AliasTableTest, RandomWeights) {
+  std::mt19937_64 rng(42);
+  for (size_t size : {2, 3, 10, 100, 1000}) {
+    std::vector<uint32_t> weights(size);
+    for (uint32_t& weight : weights) weight = 1 + rng() % 1000;
+    CheckProbabilities(weights);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_result_cache.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/status/status.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Records the lookups started through the cache, and lets the test
+// complete them.
+class FakeLookups {
+ public:
+  DnsResultCache::StartLookupFunc start_lookup() {
+    return [this](grpc_pollset_set* /*interested_parties*/,
+                  DnsResultCache::OnDone on_done) {
+      lookups_.push_back({std::move(on_done), false});
+      return OrphanablePtr<Orphanable>(
+          MakeOrphanable<Lookup>(&lookups_.back().cancelled));
+    };
+  }
+
+  size_t num_started() const { return lookups_.size(); }
+  bool cancelled(size_t index) const { return lookups_[index].cancelled; }
+
+  void Complete(size_t index, DnsResultCache::LookupResult result) {
+    lookups_[index].on_done(std::move(result));
+  }
+
+ private:
+  class Lookup : public Orphanable {
+   public:
+    explicit Lookup(bool* cancelled) : cancelled_(cancelled) {}
+    ~Lookup() override = default;
+
+    void Orphan() override {
+      *cancelled_ = true;
+      delete this;
+    }
+
+   private:
+    bool* cancelled_;
+  };
+
+  struct StartedLookup {
+    DnsResultCache::OnDone on_done;
+    bool cancelled;
+  };
+
+  // A deque, so that the lookups can point into it.
+  std::deque<StartedLookup> lookups_;
+};
+
+DnsResultCache::LookupResult MakeResult(absl::string_view address) {
+  DnsResultCache::LookupResult result;
+  result.addresses.emplace();
+  result.addresses->emplace_back(*StringToSockaddr(address), ChannelArgs());
+  return result;
+}
+
+class DnsResultCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { DnsResultCache::Get()->ResetForTesting(); }
+
+  // Looks up key, and returns where the result will be delivered.
+  OrphanablePtr<Orphanable> Lookup(
+      const std::string& key, Duration max_age,
+      std::vector<DnsResultCache::LookupResult>* results) {
+    return DnsResultCache::Get()->Lookup(
+        key, max_age, /*interested_parties=*/nullptr,
+        lookups_.start_lookup(),
+        [results](DnsResultCache::LookupResult result) {
+          results->push_back(std::move(result));
+        });
+  }
+
+  ExecCtx exec_ctx_;
+  FakeLookups lookups_;
+};
+
+TEST_F(DnsResultCacheTest, CoalescesConcurrentLookups) {
+  std::vector<DnsResultCache::LookupResult> results1;
+  std::vector<DnsResultCache::LookupResult> results2;
+  auto lookup1 = Lookup("coalesce", Duration::Seconds(30), &results1);
+  auto lookup2 = Lookup("coalesce", Duration::Seconds(30), &results2);
+  ASSERT_EQ(lookups_.num_started(), 1);
+  EXPECT_TRUE(results1.empty());
+  lookups_.Complete(0, MakeResult("10.0.0.1:443"));
+  ASSERT_EQ(results1.size(), 1);
+  ASSERT_EQ(results2.size(), 1);
+  EXPECT_EQ(*results1[0].addresses, *results2[0].addresses);
+  EXPECT_FALSE(lookups_.cancelled(0));
+}
+
+TEST_F(DnsResultCacheTest, ReusesRecentResults) {
+  std::vector<DnsResultCache::LookupResult> results;
+  auto lookup = Lookup("reuse", Duration::Seconds(30), &results);
+  lookups_.Complete(0, MakeResult("10.0.0.1:443"));
+  // Delivered synchronously from the cache.
+  auto cached_lookup = Lookup("reuse", Duration::Seconds(30), &results);
+  EXPECT_EQ(lookups_.num_started(), 1);
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(*results[0].addresses, *results[1].addresses);
+  // A lookup that accepts no cached result starts a new one.
+  auto fresh_lookup = Lookup("reuse", Duration::Zero(), &results);
+  EXPECT_EQ(lookups_.num_started(), 2);
+  EXPECT_EQ(results.size(), 2);
+  // Other keys are looked up separately.
+  auto other_lookup = Lookup("reuse2", Duration::Seconds(30), &results);
+  EXPECT_EQ(lookups_.num_started(), 3);
+}
+
+TEST_F(DnsResultCacheTest, DoesNotCacheFailures) {
+  std::vector<DnsResultCache::LookupResult> results;
+  auto lookup = Lookup("failure", Duration::Seconds(30), &results);
+  DnsResultCache::LookupResult failure;
+  failure.status = absl::UnavailableError("no such name");
+  lookups_.Complete(0, std::move(failure));
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_FALSE(results[0].ok());
+  EXPECT_EQ(results[0].status, absl::UnavailableError("no such name"));
+  auto retry = Lookup("failure", Duration::Seconds(30), &results);
+  EXPECT_EQ(lookups_.num_started(), 2);
+}
+
+TEST_F(DnsResultCacheTest, CancelsLookupOnceNoOneWaits) {
+  std::vector<DnsResultCache::LookupResult> results1;
+  std::vector<DnsResultCache::LookupResult> results2;
+  auto lookup1 = Lookup("cancel", Duration::Seconds(30), &results1);
+  auto lookup2 = Lookup("cancel", Duration::Seconds(30), &results2);
+  lookup1.reset();
+  EXPECT_FALSE(lookups_.cancelled(0));
+  lookup2.reset();
+  EXPECT_TRUE(lookups_.cancelled(0));
+  // The cancelled lookup still completes, with no one to deliver to.
+  lookups_.Complete(0, MakeResult("10.0.0.1:443"));
+  EXPECT_TRUE(results1.empty());
+  EXPECT_TRUE(results2.empty());
+  // And its result was not cached.
+  auto lookup3 = Lookup("cancel", Duration::Seconds(30), &results1);
+  EXPECT_EQ(lookups_.num_started(), 2);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,178 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// The first hash at or after \a hash, wrapping around.
+size_t ExpectedIndex(const std::vector<uint64_t>& hashes, uint64_t hash) {
+  auto it = std::lower_bound(hashes.begin(), hashes.end(), hash);
+  return it == hashes.end() ? 0 : it - hashes.begin();
+}
+
+void CheckLookups(std::vector<uint64_t> hashes, std::mt19937_64* rng) {
+  std::sort(hashes.begin(), hashes.end());
+  RingHashLookupTable table(hashes);
+  ASSERT_EQ(table.size(), hashes.size());
+  std::vector<uint64_t> probes = {0, 1, std::numeric_limits<uint64_t>::max()};
+  for (uint64_t hash : hashes) {
+    probes.push_back(hash);
+    probes.push_back(hash - 1);
+    probes.push_back(hash + 1);
+  }
+  for (int i = 0; i < 1000; ++i) probes.push_back((*rng)());
+  for (uint64_t probe : probes) {
+    EXPECT_EQ(table.Find(probe), ExpectedIndex(hashes, probe))
+        << "probe " << probe << " in a ring of " << hashes.size();
+  }
+}
+
+TEST(RingHashLookupTableTest, RandomRings) {
+  std::mt19937_64 rng(42);
+  for (size_t size : {1, 2, 3, 7, 64, 1000, 65537}) {
+    std::vector<uint64_t> hashes(size);
+    for (uint64_t& hash : hashes) hash = rng();
+    CheckLookups(std::move(hashes), &rng);
+  }
+}
+
+TEST(RingHashLookupTableTest, CrowdedBuckets) {
+  std::mt19937_64 rng(42);
+  // All in one bucket.
+  std::vector<uint64_t> hashes(1000);
+  for (uint64_t& hash : hashes) hash = rng() % 1000;
+  CheckLookups(hashes, &rng);
+  // Duplicates, and the smallest and largest hashes.
+  hashes = {0, 0, 5, 5, 5, std::numeric_limits<uint64_t>::max(),
+            std::numeric_limits<uint64_t>::max()};
+  CheckLookups(hashes, &rng);
+}
+
+std::vector<size_t> SlotCounts(const std::vector<uint32_t>& table,
+                               size_t num_backends) {
+  std::vector<size_t> counts(num_backends);
+  for (uint32_t index : table) {
+    EXPECT_LT(index, num_backends);
+    if (index < num_backends) ++counts[index];
+  }
+  return counts;
+}
+
+std::vector<MaglevBackend> MakeBackends(const std::vector<std::string>& keys) {
+  std::vector<MaglevBackend> backends;
+  for (const std::string& key : keys) backends.push_back({key, 1});
+  return backends;
+}
+
+std::vector<std::string> Addresses(size_t n) {
+  std::vector<std::string> addresses;
+  for (size_t i = 0; i < n; ++i) {
+    addresses.push_back(absl::StrCat("10.0.0.", i, ":443"));
+  }
+  return addresses;
+}
+
+TEST(MaglevTableTest, Empty) {
+  EXPECT_TRUE(BuildMaglevTable({}, 65537).empty());
+}
+
+TEST(MaglevTableTest, EvenShares) {
+  const std::vector<std::string> addresses = Addresses(10);
+  const std::vector<uint32_t> table =
+      BuildMaglevTable(MakeBackends(addresses), 65537);
+  ASSERT_EQ(table.size(), 65537);
+  for (size_t count : SlotCounts(table, addresses.size())) {
+    EXPECT_GE(count, 6553);
+    EXPECT_LE(count, 6554);
+  }
+}
+
+TEST(MaglevTableTest, WeightedShares) {
+  const std::vector<std::string> addresses = Addresses(3);
+  std::vector<MaglevBackend> backends = MakeBackends(addresses);
+  backends[0].weight = 1;
+  backends[1].weight = 2;
+  backends[2].weight = 5;
+  const std::vector<size_t> counts =
+      SlotCounts(BuildMaglevTable(backends, 65537), backends.size());
+  EXPECT_NEAR(counts[0], 65537 / 8.0, 2);
+  EXPECT_NEAR(counts[1], 65537 * 2 / 8.0, 2);
+  EXPECT_NEAR(counts[2], 65537 * 5 / 8.0, 2);
+}
+
+TEST(MaglevTableTest, MinimalDisruption) {
+  std::vector<std::string> addresses = Addresses(10);
+  const std::vector<uint32_t> before =
+      BuildMaglevTable(MakeBackends(addresses), 65537);
+  // Remove the backend at index 3; those after it move down by one.
+  addresses.erase(addresses.begin() + 3);
+  const std::vector<uint32_t> after =
+      BuildMaglevTable(MakeBackends(addresses), 65537);
+  size_t moved = 0;
+  for (size_t i = 0; i < before.size(); ++i) {
+    if (before[i] == 3) continue;
+    const uint32_t expected = before[i] > 3 ? before[i] - 1 : before[i];
+    if (after[i] != expected) ++moved;
+  }
+  // Only the slots of the removed backend need to move, but Maglev
+  // trades a few more for its even balance.
+  EXPECT_LT(moved, before.size() / 50);
+}
+
+TEST(MaglevConfigTest, TableSize) {
+  auto parse = [](absl::string_view json_string) {
+    return LoadFromJson<MaglevConfig>(*Json::Parse(json_string));
+  };
+  auto config = parse("{}");
+  ASSERT_TRUE(config.ok()) << config.status();
+  EXPECT_EQ(config->table_size, 65537);
+  config = parse("{\"table_size\": 251}");
+  ASSERT_TRUE(config.ok()) << config.status();
+  EXPECT_EQ(config->table_size, 251);
+  for (absl::string_view json_string :
+       {"{\"table_size\": 0}", "{\"table_size\": 1}",
+        "{\"table_size\": 65536}", "{\"table_size\": 5000101}"}) {
+    EXPECT_FALSE(parse(json_string).ok()) << json_string;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -27,10 +27,13 @@
 
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
 #include "src/core/ext/filters/client_channel/retry_service_config.h"
+#include "src/core/ext/filters/http/message_compress/compression_dictionary_config.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/experiments/config.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/service_config/registered_method_path.h"
 #include "src/core/lib/service_config/service_config_impl.h"
 #include "src/core/lib/service_config/service_config_parser.h"
 #include "test/core/util/port.h"
@@ -405,6 +408,78 @@ TEST_F(ServiceConfigTest, Parser2ErrorInvalidValue) {
                          TestParser2::InvalidValueErrorMessage(), "]]]"));
 }
 
+TEST_F(ServiceConfigTest, CacheSharesConfigsParsedFromTheSameJsonAndArgs) {
+  const char* test_json = "{\"global_param\":5}";
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  auto same = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  ASSERT_TRUE(same.ok()) << same.status();
+  EXPECT_EQ(same->get(), service_config->get());
+  // Parsers may read integer and string args: they are part of the key.
+  auto disabled = ServiceConfigImpl::Create(
+      ChannelArgs().Set(GRPC_ARG_DISABLE_PARSING, 1), test_json);
+  ASSERT_TRUE(disabled.ok()) << disabled.status();
+  EXPECT_NE(disabled->get(), service_config->get());
+  EXPECT_EQ((*disabled)->GetGlobalParsedConfig(0), nullptr);
+  // Pointer args are not.
+  auto with_pointer = ServiceConfigImpl::Create(
+      ChannelArgs().SetObject(*service_config), test_json);
+  ASSERT_TRUE(with_pointer.ok()) << with_pointer.status();
+  EXPECT_EQ(with_pointer->get(), service_config->get());
+  // Nor is a config shared with another set of parsers.
+  CoreConfiguration::WithSubstituteBuilder builder(
+      [](CoreConfiguration::Builder* builder) {
+        builder->service_config_parser()->RegisterParser(
+            absl::make_unique<TestParser1>());
+      });
+  auto other_parsers = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  ASSERT_TRUE(other_parsers.ok()) << other_parsers.status();
+  EXPECT_NE(other_parsers->get(), service_config->get());
+}
+
+TEST_F(ServiceConfigTest, CacheKeepsErrors) {
+  const char* test_json = "{\"global_param\":\"5\"}";
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  auto again = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  EXPECT_EQ(service_config.status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(again.status(), service_config.status());
+}
+
+TEST_F(ServiceConfigTest, RegisteredMethodPathRemembersItsMethodConfig) {
+  auto service_config = ServiceConfigImpl::Create(
+      ChannelArgs(),
+      "{\"methodConfig\": ["
+      "{\"name\":[{\"service\":\"TestServ\",\"method\":\"A\"}], "
+      "\"method_param\":1},"
+      "{\"name\":[{\"service\":\"TestServ\"}], \"method_param\":2}]}");
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  auto other = ServiceConfigImpl::Create(
+      ChannelArgs(),
+      "{\"methodConfig\": [{\"name\":[{\"service\":\"OtherServ\"}], "
+      "\"method_param\":3}]}");
+  ASSERT_TRUE(other.ok()) << other.status();
+  auto method_param = [](const ServiceConfig& config, const Slice& path) {
+    const auto* vector = config.GetMethodParsedConfigVector(path.c_slice());
+    if (vector == nullptr) return -1;
+    return static_cast<TestParsedConfig1*>((*vector)[1].get())->value();
+  };
+  Slice a = RegisteredMethodPath::Create("/TestServ/A");
+  Slice b = RegisteredMethodPath::Create("/TestServ/B");
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(method_param(**service_config, a), 1);
+    EXPECT_EQ(method_param(**service_config, b), 2);
+    // What the paths remember for one config does not leak into another.
+    EXPECT_EQ(method_param(**other, a), -1);
+    EXPECT_EQ(method_param(**other, b), -1);
+  }
+  // Sub-slices share the refcount of the path, but are looked up as is.
+  EXPECT_EQ(method_param(**service_config, a.RefSubSlice(0, 10)), 2);
+  EXPECT_EQ(
+      method_param(**service_config, Slice::FromCopiedString("/TestServ/A")),
+      1);
+}
+
 TEST(ServiceConfigParserTest, DoubleRegistration) {
   CoreConfiguration::Reset();
   ASSERT_DEATH_IF_SUPPORTED(
@@ -1439,6 +1514,150 @@ TEST_F(RetryParserTest, InvalidRetryPolicyPerAttemptRecvTimeoutBadValue) {
                   "field:perAttemptRecvTimeout error:must be greater than 0"));
 }
 
+TEST_F(RetryParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [\"UNAVAILABLE\"]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  const ChannelArgs args =
+      ChannelArgs().Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, 1);
+  auto service_config = ServiceConfigImpl::Create(args, test_json);
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* vector_ptr =
+      (*service_config)
+          ->GetMethodParsedConfigVector(
+              grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<internal::RetryMethodConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->max_attempts(), 3);
+  EXPECT_EQ(parsed_config->hedging_delay(), Duration::Milliseconds(500));
+  EXPECT_TRUE(parsed_config->retryable_status_codes().Contains(
+      GRPC_STATUS_UNAVAILABLE));
+  EXPECT_FALSE(
+      parsed_config->retryable_status_codes().Contains(GRPC_STATUS_ABORTED));
+}
+
+TEST_F(RetryParserTest, ValidHedgingPolicyDefaults) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 10\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  const ChannelArgs args =
+      ChannelArgs().Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, 1);
+  auto service_config = ServiceConfigImpl::Create(args, test_json);
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* vector_ptr =
+      (*service_config)
+          ->GetMethodParsedConfigVector(
+              grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<internal::RetryMethodConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  // Clamped to 5.
+  EXPECT_EQ(parsed_config->max_attempts(), 5);
+  EXPECT_EQ(parsed_config->hedging_delay(), Duration::Zero());
+  EXPECT_TRUE(parsed_config->retryable_status_codes().Empty());
+}
+
+TEST_F(RetryParserTest, HedgingPolicyIgnoredWhenHedgingDisabled) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* vector_ptr =
+      (*service_config)
+          ->GetMethodParsedConfigVector(
+              grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  EXPECT_EQ(((*vector_ptr)[0]).get(), nullptr);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyWithRetryPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 2,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [\"ABORTED\"]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  const ChannelArgs args =
+      ChannelArgs().Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, 1);
+  auto service_config = ServiceConfigImpl::Create(args, test_json);
+  EXPECT_EQ(service_config.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(std::string(service_config.status().message()),
+              ::testing::ContainsRegex(
+                  "error parsing retry method parameters: "
+                  "retryPolicy and hedgingPolicy cannot both be set"));
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyFields) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 1,\n"
+      "      \"hedgingDelay\": \"1sec\",\n"
+      "      \"nonFatalStatusCodes\": [\"FOO\"]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  const ChannelArgs args =
+      ChannelArgs().Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, 1);
+  auto service_config = ServiceConfigImpl::Create(args, test_json);
+  EXPECT_EQ(service_config.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(std::string(service_config.status().message()),
+              ::testing::ContainsRegex(
+                  "error parsing retry method parameters:.*"
+                  "hedgingPolicy" CHILD_ERROR_TAG
+                  "field:maxAttempts error:should be at least 2.*"
+                  "field:hedgingDelay.*"
+                  "field:nonFatalStatusCodes error:failed to parse status "
+                  "code"));
+}
+
 //
 // message_size parser tests
 //
@@ -1530,12 +1749,103 @@ TEST_F(MessageSizeParserTest, InvalidMaxResponseMessageBytes) {
                   "number"));
 }
 
+class CompressionDictionaryParserTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    builder_ = std::make_unique<CoreConfiguration::WithSubstituteBuilder>(
+        [](CoreConfiguration::Builder* builder) {
+          builder->service_config_parser()->RegisterParser(
+              absl::make_unique<CompressionDictionaryParser>());
+        });
+    EXPECT_EQ(CoreConfiguration::Get().service_config_parser().GetParserIndex(
+                  "compression_dictionary"),
+              0);
+  }
+
+ private:
+  std::unique_ptr<CoreConfiguration::WithSubstituteBuilder> builder_;
+};
+
+TEST_F(CompressionDictionaryParserTest, Valid) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"compressionDictionary\": {\n"
+      "      \"name\": \"users-v1\",\n"
+      "      \"data\": \"dXNlcl9pZA==\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* vector_ptr =
+      (*service_config)
+          ->GetMethodParsedConfigVector(
+              grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  auto parsed_config = static_cast<CompressionDictionaryParsedConfig*>(
+      ((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->name().as_string_view(), "users-v1");
+  ASSERT_NE(parsed_config->dictionary(), nullptr);
+  EXPECT_EQ(parsed_config->dictionary()->data(), "user_id");
+}
+
+TEST_F(CompressionDictionaryParserTest, InvalidData) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"compressionDictionary\": {\n"
+      "      \"name\": \"users-v1\",\n"
+      "      \"data\": \"not base64!\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), test_json);
+  EXPECT_EQ(service_config.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(std::string(service_config.status().message()),
+              ::testing::ContainsRegex(
+                  "Service config parsing errors: \\["
+                  "errors parsing methodConfig: \\["
+                  "index 0: \\[.*"
+                  "field:compressionDictionary error:field:data error:should "
+                  "be a non-empty base64 string"));
+}
+
+TEST(CompressionDictionaryRegistryTest, LooksUpByName) {
+  auto registry = CompressionDictionaryRegistry::FromJsonString(
+      "[{\"name\": \"a\", \"data\": \"YWFh\"},"
+      " {\"name\": \"b\", \"data\": \"YmJi\"}]");
+  ASSERT_TRUE(registry.ok()) << registry.status();
+  ASSERT_NE((*registry)->Lookup("a"), nullptr);
+  EXPECT_EQ((*registry)->Lookup("a")->data(), "aaa");
+  ASSERT_NE((*registry)->Lookup("b"), nullptr);
+  EXPECT_EQ((*registry)->Lookup("b")->data(), "bbb");
+  EXPECT_EQ((*registry)->Lookup("c"), nullptr);
+}
+
+TEST(CompressionDictionaryRegistryTest, RejectsDuplicateNames) {
+  auto registry = CompressionDictionaryRegistry::FromJsonString(
+      "[{\"name\": \"a\", \"data\": \"YWFh\"},"
+      " {\"name\": \"a\", \"data\": \"YmJi\"}]");
+  EXPECT_EQ(registry.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(std::string(registry.status().message()),
+              ::testing::HasSubstr("index 1: duplicate name"));
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::ForceEnableExperiment("service_config_cache", true);
   grpc_init();
   int ret = RUN_ALL_TESTS();
   grpc_shutdown();
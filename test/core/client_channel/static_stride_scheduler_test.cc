@@ -0,0 +1,118 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+std::vector<size_t> PickCounts(const StaticStrideScheduler& scheduler,
+                               size_t num_backends, size_t num_picks) {
+  std::vector<size_t> counts(num_backends);
+  for (size_t i = 0; i < num_picks; ++i) {
+    const size_t index = scheduler.Pick();
+    EXPECT_LT(index, num_backends);
+    if (index < num_backends) ++counts[index];
+  }
+  return counts;
+}
+
+TEST(StaticStrideSchedulerTest, NeedsTwoPositiveWeights) {
+  uint32_t sequence = 0;
+  auto next_sequence = [&]() { return sequence++; };
+  EXPECT_FALSE(StaticStrideScheduler::Make({}, next_sequence).has_value());
+  EXPECT_FALSE(StaticStrideScheduler::Make({1}, next_sequence).has_value());
+  EXPECT_FALSE(
+      StaticStrideScheduler::Make({0, 5, 0}, next_sequence).has_value());
+  EXPECT_TRUE(StaticStrideScheduler::Make({0, 5, 1}, next_sequence).has_value());
+}
+
+TEST(StaticStrideSchedulerTest, PicksInProportionToWeights) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {1, 2, 3, 4};
+  auto scheduler =
+      StaticStrideScheduler::Make(weights, [&]() { return sequence++; });
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts =
+      PickCounts(*scheduler, weights.size(), 100000);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(counts[i], 100000 * weights[i] / 10, 100) << "backend " << i;
+  }
+}
+
+TEST(StaticStrideSchedulerTest, EqualWeightsAreRoundRobin) {
+  uint32_t sequence = 0;
+  auto scheduler =
+      StaticStrideScheduler::Make({7, 7, 7}, [&]() { return sequence++; });
+  ASSERT_TRUE(scheduler.has_value());
+  for (size_t i = 0; i < 30; ++i) EXPECT_EQ(scheduler->Pick(), i % 3);
+}
+
+TEST(StaticStrideSchedulerTest, MissingWeightsGetTheMean) {
+  uint32_t sequence = 0;
+  auto scheduler =
+      StaticStrideScheduler::Make({1, 0, 3}, [&]() { return sequence++; });
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts = PickCounts(*scheduler, 3, 60000);
+  EXPECT_NEAR(counts[0], 10000, 100);
+  EXPECT_NEAR(counts[1], 20000, 100);
+  EXPECT_NEAR(counts[2], 30000, 100);
+}
+
+TEST(StaticStrideSchedulerTest, TinyWeightsAreRaised) {
+  uint32_t sequence = 0;
+  auto scheduler =
+      StaticStrideScheduler::Make({1e-6f, 1}, [&]() { return sequence++; });
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts = PickCounts(*scheduler, 2, 101000);
+  EXPECT_NEAR(counts[0], 1000, 50);
+}
+
+TEST(StaticStrideSchedulerTest, SpreadsPicksOverTime) {
+  uint32_t sequence = 0;
+  auto scheduler =
+      StaticStrideScheduler::Make({1, 1, 2}, [&]() { return sequence++; });
+  ASSERT_TRUE(scheduler.has_value());
+  // Any window of 8 picks gives the heavy backend about half of them.
+  std::vector<size_t> picks;
+  for (size_t i = 0; i < 1000; ++i) picks.push_back(scheduler->Pick());
+  for (size_t start = 0; start + 8 <= picks.size(); ++start) {
+    size_t heavy = 0;
+    for (size_t i = start; i < start + 8; ++i) heavy += picks[i] == 2;
+    EXPECT_GE(heavy, 3) << "window starting at " << start;
+    EXPECT_LE(heavy, 5) << "window starting at " << start;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
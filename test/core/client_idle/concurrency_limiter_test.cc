@@ -0,0 +1,85 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/channel_idle/concurrency_limiter.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc_core {
+namespace testing {
+
+constexpr int kMaxLimit = 200;
+
+// Fills the limiter up to its limit.
+void FillUp(ConcurrencyLimiter* limiter) {
+  while (limiter->TryAcquire()) {
+  }
+}
+
+// Runs calls that each take latency_us, keeping the limiter full.
+void RunCalls(ConcurrencyLimiter* limiter, int calls, double latency_us) {
+  for (int i = 0; i < calls; i++) {
+    FillUp(limiter);
+    limiter->Release(latency_us);
+  }
+  FillUp(limiter);
+}
+
+TEST(ConcurrencyLimiterTest, AdmitsUpToTheLimit) {
+  ConcurrencyLimiter limiter(kMaxLimit);
+  for (int i = 0; i < ConcurrencyLimiter::kMinLimit; i++) {
+    EXPECT_TRUE(limiter.TryAcquire());
+  }
+  EXPECT_FALSE(limiter.TryAcquire());
+  EXPECT_EQ(limiter.in_flight(), ConcurrencyLimiter::kMinLimit);
+  limiter.Drop();
+  EXPECT_EQ(limiter.limit(), ConcurrencyLimiter::kMinLimit);
+  EXPECT_TRUE(limiter.TryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, GrowsWhileLatencyHolds) {
+  ConcurrencyLimiter limiter(kMaxLimit);
+  RunCalls(&limiter, 1000, 1000);
+  EXPECT_EQ(limiter.limit(), kMaxLimit);
+  EXPECT_EQ(limiter.in_flight(), kMaxLimit);
+}
+
+TEST(ConcurrencyLimiterTest, ShrinksWhenLatencyRises) {
+  ConcurrencyLimiter limiter(kMaxLimit);
+  RunCalls(&limiter, 1000, 1000);
+  const int limit = limiter.limit();
+  RunCalls(&limiter, 100, 10 * 1000);
+  EXPECT_LT(limiter.limit(), limit / 2);
+  // Calls over the new limit are turned away until enough finish.
+  EXPECT_GT(limiter.in_flight(), limiter.limit());
+  EXPECT_FALSE(limiter.TryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, DoesNotGrowWhenUnderused) {
+  ConcurrencyLimiter limiter(kMaxLimit);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.Release(1000);
+  }
+  EXPECT_EQ(limiter.limit(), ConcurrencyLimiter::kMinLimit);
+  EXPECT_EQ(limiter.in_flight(), 0);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
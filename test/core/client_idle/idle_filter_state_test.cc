@@ -52,6 +52,23 @@ TEST(IdleFilterStateTest, TimerKeepsGoingWithActivity) {
   EXPECT_FALSE(s.CheckTimer());
 }
 
+TEST(IdleFilterStateTest, CallsFinishOnOtherThreads) {
+  IdleFilterState s(false);
+  std::thread([&s] {
+    s.IncreaseCallCount();
+    s.IncreaseCallCount();
+  }).join();
+  EXPECT_FALSE(s.DecreaseCallCount());
+  // Idleness is noticed however the calls were spread over threads.
+  EXPECT_TRUE(s.DecreaseCallCount());
+  std::thread([&s] { s.IncreaseCallCount(); }).join();
+  EXPECT_TRUE(s.CheckTimer());
+  EXPECT_FALSE(s.DecreaseCallCount());
+  // The call was in progress at the last check.
+  EXPECT_TRUE(s.CheckTimer());
+  EXPECT_FALSE(s.CheckTimer());
+}
+
 TEST(IdleFilterStateTest, StressTest) {
   IdleFilterState s(false);
   std::atomic<bool> done{false};
@@ -0,0 +1,115 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "src/core/ext/filters/http/message_compress/compressibility_tracker.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using MethodStats = CompressibilityTracker::MethodStats;
+
+// Returns how many of the next \a messages of \a stats would be compressed.
+int CountCompressed(MethodStats* stats, int messages) {
+  int compressed = 0;
+  for (int i = 0; i < messages; ++i) {
+    if (stats->ShouldCompress()) ++compressed;
+  }
+  return compressed;
+}
+
+TEST(CompressibilityTrackerTest, CompressesUntilSampled) {
+  CompressibilityTracker tracker(10);
+  MethodStats* stats = tracker.GetMethodStats("/svc/method");
+  ASSERT_NE(stats, nullptr);
+  for (uint32_t i = 0; i + 1 < CompressibilityTracker::kMinSamples; ++i) {
+    EXPECT_TRUE(stats->ShouldCompress());
+    stats->RecordCompression(1000, 1000);
+  }
+  EXPECT_TRUE(stats->ShouldCompress());
+}
+
+TEST(CompressibilityTrackerTest, KeepsCompressingCompressibleMethods) {
+  CompressibilityTracker tracker(10);
+  MethodStats* stats = tracker.GetMethodStats("/svc/method");
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(stats->ShouldCompress());
+    stats->RecordCompression(1000, 500);
+  }
+}
+
+TEST(CompressibilityTrackerTest, ProbesIncompressibleMethods) {
+  CompressibilityTracker tracker(10);
+  MethodStats* stats = tracker.GetMethodStats("/svc/method");
+  for (uint32_t i = 0; i < CompressibilityTracker::kMinSamples; ++i) {
+    stats->RecordCompression(1000, 950);
+  }
+  EXPECT_EQ(CountCompressed(stats, 10 * CompressibilityTracker::kProbeInterval),
+            10);
+}
+
+TEST(CompressibilityTrackerTest, ResumesWhenMessagesShrinkAgain) {
+  CompressibilityTracker tracker(10);
+  MethodStats* stats = tracker.GetMethodStats("/svc/method");
+  for (uint32_t i = 0; i < CompressibilityTracker::kMinSamples; ++i) {
+    stats->RecordCompression(1000, 1000);
+  }
+  EXPECT_FALSE(stats->ShouldCompress());
+  // Probes that compress well bring the average back down.
+  for (int i = 0; i < 20; ++i) stats->RecordCompression(1000, 100);
+  EXPECT_TRUE(stats->ShouldCompress());
+}
+
+TEST(CompressibilityTrackerTest, TracksMethodsSeparately) {
+  CompressibilityTracker tracker(10);
+  MethodStats* incompressible = tracker.GetMethodStats("/svc/images");
+  MethodStats* compressible = tracker.GetMethodStats("/svc/text");
+  EXPECT_NE(incompressible, compressible);
+  EXPECT_EQ(tracker.GetMethodStats("/svc/images"), incompressible);
+  for (uint32_t i = 0; i < CompressibilityTracker::kMinSamples; ++i) {
+    incompressible->RecordCompression(1000, 1000);
+    compressible->RecordCompression(1000, 300);
+  }
+  EXPECT_FALSE(incompressible->ShouldCompress());
+  EXPECT_TRUE(compressible->ShouldCompress());
+}
+
+TEST(CompressibilityTrackerTest, LimitsTrackedMethods) {
+  CompressibilityTracker tracker(10);
+  for (size_t i = 0; i < CompressibilityTracker::kMaxMethods; ++i) {
+    EXPECT_NE(tracker.GetMethodStats(absl::StrCat("/svc/m", i)), nullptr);
+  }
+  EXPECT_EQ(tracker.GetMethodStats("/svc/one_too_many"), nullptr);
+  EXPECT_NE(tracker.GetMethodStats("/svc/m0"), nullptr);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -34,11 +34,13 @@
 
 TEST(CompressionTest, CompressionAlgorithmParse) {
   size_t i;
-  const char* valid_names[] = {"identity", "gzip", "deflate"};
+  const char* valid_names[] = {"identity", "gzip", "deflate", "zstd", "lz4"};
   const grpc_compression_algorithm valid_algorithms[] = {
       GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_DEFLATE,
+      GRPC_COMPRESS_ZSTD,
+      GRPC_COMPRESS_LZ4,
   };
   const char* invalid_names[] = {"gzip2", "foo", "", "2gzip"};
 
@@ -68,11 +70,13 @@ TEST(CompressionTest, CompressionAlgorithmName) {
   int success;
   const char* name;
   size_t i;
-  const char* valid_names[] = {"identity", "gzip", "deflate"};
+  const char* valid_names[] = {"identity", "gzip", "deflate", "zstd", "lz4"};
   const grpc_compression_algorithm valid_algorithms[] = {
       GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_DEFLATE,
+      GRPC_COMPRESS_ZSTD,
+      GRPC_COMPRESS_LZ4,
   };
 
   gpr_log(GPR_DEBUG, "test_compression_algorithm_name");
@@ -264,11 +268,13 @@ TEST(CompressionTest, ChannelArgsCompressionAlgorithmStates) {
 
   const grpc_channel_args* ch_args =
       grpc_channel_args_copy_and_add(nullptr, nullptr, 0);
-  /* by default, all enabled */
+  /* by default, all the supported ones are enabled */
   states = grpc_core::CompressionAlgorithmSet::FromChannelArgs(ch_args);
 
   for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
-    ASSERT_TRUE(states.IsSet(static_cast<grpc_compression_algorithm>(i)));
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
+    ASSERT_EQ(states.IsSet(algorithm),
+              grpc_compression_algorithm_is_supported(algorithm) != 0);
   }
 
   /* disable gzip and deflate and stream/gzip */
@@ -284,10 +290,12 @@ TEST(CompressionTest, ChannelArgsCompressionAlgorithmStates) {
   states = grpc_core::CompressionAlgorithmSet::FromChannelArgs(
       ch_args_wo_gzip_deflate);
   for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
     if (i == GRPC_COMPRESS_GZIP || i == GRPC_COMPRESS_DEFLATE) {
-      ASSERT_FALSE(states.IsSet(static_cast<grpc_compression_algorithm>(i)));
+      ASSERT_FALSE(states.IsSet(algorithm));
     } else {
-      ASSERT_TRUE(states.IsSet(static_cast<grpc_compression_algorithm>(i)));
+      ASSERT_EQ(states.IsSet(algorithm),
+                grpc_compression_algorithm_is_supported(algorithm) != 0);
     }
   }
 
@@ -298,16 +306,35 @@ TEST(CompressionTest, ChannelArgsCompressionAlgorithmStates) {
 
   states = grpc_core::CompressionAlgorithmSet::FromChannelArgs(ch_args_wo_gzip);
   for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
     if (i == GRPC_COMPRESS_DEFLATE) {
-      ASSERT_FALSE(states.IsSet(static_cast<grpc_compression_algorithm>(i)));
+      ASSERT_FALSE(states.IsSet(algorithm));
     } else {
-      ASSERT_TRUE(states.IsSet(static_cast<grpc_compression_algorithm>(i)));
+      ASSERT_EQ(states.IsSet(algorithm),
+                grpc_compression_algorithm_is_supported(algorithm) != 0);
     }
   }
 
   grpc_channel_args_destroy(ch_args);
 }
 
+TEST(CompressionTest, CompressionAlgorithmForLevelSkipsUnsupported) {
+  uint32_t accepted_encodings = 0;
+  for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    grpc_core::SetBit(&accepted_encodings, i);
+  }
+  const bool lz4 = grpc_compression_algorithm_is_supported(GRPC_COMPRESS_LZ4);
+  const bool zstd =
+      grpc_compression_algorithm_is_supported(GRPC_COMPRESS_ZSTD);
+  /* lz4 is the fastest and zstd the densest, when the build has them */
+  ASSERT_EQ(lz4 ? GRPC_COMPRESS_LZ4 : GRPC_COMPRESS_GZIP,
+            grpc_compression_algorithm_for_level(GRPC_COMPRESS_LEVEL_LOW,
+                                                 accepted_encodings));
+  ASSERT_EQ(zstd ? GRPC_COMPRESS_ZSTD : GRPC_COMPRESS_DEFLATE,
+            grpc_compression_algorithm_for_level(GRPC_COMPRESS_LEVEL_HIGH,
+                                                 accepted_encodings));
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
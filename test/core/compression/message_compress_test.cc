@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <grpc/compression.h>
@@ -29,7 +31,10 @@
 
 #include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
@@ -117,6 +122,9 @@ static grpc_slice repeated(char c, size_t length) {
 static compressability get_compressability(
     test_value id, grpc_compression_algorithm algorithm) {
   if (algorithm == GRPC_COMPRESS_NONE) return SHOULD_NOT_COMPRESS;
+  if (!grpc_compression_algorithm_is_supported(algorithm)) {
+    return SHOULD_NOT_COMPRESS;
+  }
   switch (id) {
     case ONE_A:
       return SHOULD_NOT_COMPRESS;
@@ -304,6 +312,131 @@ TEST(MessageCompressTest, BadDecompressionAlgorithm) {
   grpc_slice_buffer_destroy(&output);
 }
 
+// A message made of words that are all in the dictionary, too short and too
+// varied to compress on its own.
+static const char kDictionary[] =
+    "{\"user_id\": , \"display_name\": \"\", \"email_address\": \"\", "
+    "\"created_at\": \"2022-\", \"last_login_at\": \"2022-\", "
+    "\"preferred_language\": \"en-US\", \"time_zone\": \"America/\"}";
+static const char kDictionaryMessage[] =
+    "{\"user_id\": 42, \"display_name\": \"Ada\", \"email_address\": "
+    "\"ada@example.com\", \"created_at\": \"2022-01-05\", "
+    "\"last_login_at\": \"2022-06-30\", \"preferred_language\": \"en-US\", "
+    "\"time_zone\": \"America/Chicago\"}";
+
+TEST(MessageCompressTest, DictionaryRoundTrip) {
+  grpc_core::MessageCompressionOptions options;
+  options.dictionary =
+      grpc_core::MakeRefCounted<grpc_core::CompressionDictionary>(kDictionary);
+  for (grpc_compression_algorithm algorithm :
+       {GRPC_COMPRESS_ZSTD, GRPC_COMPRESS_LZ4}) {
+    if (!grpc_compression_algorithm_is_supported(algorithm)) continue;
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::SliceBuffer input;
+    grpc_core::SliceBuffer compressed;
+    grpc_core::SliceBuffer output;
+    grpc_core::SliceBuffer output_without_dictionary;
+    input.Append(grpc_core::Slice::FromCopiedString(kDictionaryMessage));
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, options, input.c_slice_buffer(),
+                                   compressed.c_slice_buffer()));
+    ASSERT_LT(compressed.Length(), input.Length() / 2);
+    ASSERT_EQ(1, grpc_msg_decompress(algorithm, options,
+                                     compressed.c_slice_buffer(),
+                                     output.c_slice_buffer()));
+    EXPECT_EQ(output.JoinIntoString(), kDictionaryMessage);
+    // Without the dictionary the frame can't be decoded.
+    EXPECT_EQ(0, grpc_msg_decompress(
+                     algorithm, compressed.c_slice_buffer(),
+                     output_without_dictionary.c_slice_buffer()));
+  }
+}
+
+TEST(MessageCompressTest, BadDecompressionDataFrame) {
+  for (grpc_compression_algorithm algorithm :
+       {GRPC_COMPRESS_ZSTD, GRPC_COMPRESS_LZ4}) {
+    if (!grpc_compression_algorithm_is_supported(algorithm)) continue;
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer input;
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer corrupted;
+    grpc_slice_buffer garbage;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&corrupted);
+    grpc_slice_buffer_init(&garbage);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, create_test_value(ONE_MB_A));
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, &input, &compressed));
+    /* a truncated frame is rejected */
+    grpc_slice_buffer_trim_end(&compressed, 1, &garbage);
+    ASSERT_EQ(0, grpc_msg_decompress(algorithm, &compressed, &output));
+    /* and so is one that does not start with a frame header */
+    grpc_slice_buffer_add(&corrupted,
+                          grpc_slice_from_copied_string("not a frame header"));
+    ASSERT_EQ(0, grpc_msg_decompress(algorithm, &corrupted, &output));
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&corrupted);
+    grpc_slice_buffer_destroy(&garbage);
+    grpc_slice_buffer_destroy(&output);
+  }
+}
+
+// Each thread reuses its codec contexts, so a message must not see what the
+// previous one left behind: a half decoded frame, or a dictionary.
+TEST(MessageCompressTest, ReusedContextsStartFresh) {
+  grpc_core::MessageCompressionOptions with_dictionary;
+  with_dictionary.dictionary =
+      grpc_core::MakeRefCounted<grpc_core::CompressionDictionary>(kDictionary);
+  for (int i = 1; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
+    if (!grpc_compression_algorithm_is_supported(algorithm)) continue;
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::SliceBuffer input;
+    grpc_core::SliceBuffer compressed;
+    grpc_core::SliceBuffer truncated;
+    grpc_core::SliceBuffer output;
+    input.Append(grpc_core::Slice(create_test_value(ONE_MB_A)));
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, with_dictionary,
+                                   input.c_slice_buffer(),
+                                   truncated.c_slice_buffer()));
+    truncated.RemoveLastNBytes(truncated.Length() / 2);
+    EXPECT_EQ(0, grpc_msg_decompress(algorithm, with_dictionary,
+                                     truncated.c_slice_buffer(),
+                                     output.c_slice_buffer()));
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, input.c_slice_buffer(),
+                                   compressed.c_slice_buffer()));
+    ASSERT_EQ(1, grpc_msg_decompress(algorithm, compressed.c_slice_buffer(),
+                                     output.c_slice_buffer()));
+    EXPECT_EQ(output.JoinIntoString(), input.JoinIntoString());
+  }
+}
+
+// Large messages may be compressed in parallel chunks, each a frame.
+TEST(MessageCompressTest, ConcatenatedFrames) {
+  for (grpc_compression_algorithm algorithm :
+       {GRPC_COMPRESS_ZSTD, GRPC_COMPRESS_LZ4}) {
+    if (!grpc_compression_algorithm_is_supported(algorithm)) continue;
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::SliceBuffer first;
+    grpc_core::SliceBuffer second;
+    grpc_core::SliceBuffer compressed;
+    grpc_core::SliceBuffer output;
+    first.Append(grpc_core::Slice(create_test_value(ONE_MB_A)));
+    second.Append(grpc_core::Slice(create_test_value(ONE_KB_A)));
+    const std::string expected =
+        first.JoinIntoString() + second.JoinIntoString();
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, first.c_slice_buffer(),
+                                   compressed.c_slice_buffer()));
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, second.c_slice_buffer(),
+                                   compressed.c_slice_buffer()));
+    ASSERT_EQ(1, grpc_msg_decompress(algorithm, compressed.c_slice_buffer(),
+                                     output.c_slice_buffer()));
+    EXPECT_EQ(output.JoinIntoString(), expected);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
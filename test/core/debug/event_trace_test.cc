@@ -0,0 +1,130 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/debug/event_trace.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// The traceEvents of the dump, which must be valid JSON.
+Json::Array DumpedEvents() {
+  auto json = Json::Parse(EventTrace::DumpJson());
+  EXPECT_TRUE(json.ok()) << json.status();
+  if (!json.ok()) return {};
+  return json->object_value().at("traceEvents").array_value();
+}
+
+TEST(EventTraceTest, RecordsNothingWhenStopped) {
+  EventTrace::Start();
+  EventTrace::Stop();
+  EXPECT_FALSE(EventTrace::enabled());
+  EventTrace::Instant(EventTrace::Event::kTimerFire, 1);
+  { EventTrace::Scope scope(EventTrace::Event::kTcpRead); }
+  EXPECT_TRUE(DumpedEvents().empty());
+}
+
+TEST(EventTraceTest, RecordsScopesAndInstants) {
+  EventTrace::Start();
+  {
+    EventTrace::Scope scope(EventTrace::Event::kTcpRead);
+    scope.set_arg(42);
+  }
+  EventTrace::Instant(EventTrace::Event::kTimerFire, 3);
+  EventTrace::Stop();
+  Json::Array events = DumpedEvents();
+  ASSERT_EQ(events.size(), 2);
+  const Json::Object& read = events[0].object_value();
+  EXPECT_EQ(read.at("name").string_value(), "tcp_read");
+  EXPECT_EQ(read.at("ph").string_value(), "X");
+  EXPECT_EQ(read.at("args").object_value().at("bytes").string_value(), "42");
+  EXPECT_EQ(read.count("dur"), 1);
+  const Json::Object& fire = events[1].object_value();
+  EXPECT_EQ(fire.at("name").string_value(), "timer_fire");
+  EXPECT_EQ(fire.at("ph").string_value(), "i");
+  EXPECT_EQ(fire.at("args").object_value().at("late_ms").string_value(), "3");
+  EXPECT_EQ(read.at("tid").string_value(), fire.at("tid").string_value());
+}
+
+TEST(EventTraceTest, StartDropsEarlierEvents) {
+  EventTrace::Start();
+  EventTrace::Instant(EventTrace::Event::kCombinerOffload);
+  EventTrace::Start();
+  EventTrace::Instant(EventTrace::Event::kTimerFire);
+  EventTrace::Stop();
+  Json::Array events = DumpedEvents();
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].object_value().at("name").string_value(), "timer_fire");
+}
+
+TEST(EventTraceTest, KeepsTheLastEventsOfEachThread) {
+  EventTrace::Start();
+  const int kEvents = EventTrace::kRingSize + 10;
+  for (int i = 0; i < kEvents; i++) {
+    EventTrace::Instant(EventTrace::Event::kTimerFire, i);
+  }
+  EventTrace::Stop();
+  Json::Array events = DumpedEvents();
+  ASSERT_EQ(events.size(), EventTrace::kRingSize);
+  auto late_ms = [](const Json& event) {
+    return event.object_value()
+        .at("args")
+        .object_value()
+        .at("late_ms")
+        .string_value();
+  };
+  EXPECT_EQ(late_ms(events.front()), "10");
+  EXPECT_EQ(late_ms(events.back()), std::to_string(kEvents - 1));
+}
+
+TEST(EventTraceTest, DumpsWhileThreadsRecord) {
+  EventTrace::Start();
+  const int kThreads = 4;
+  const int kEventsPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([] {
+      for (int j = 0; j < kEventsPerThread; j++) {
+        EventTrace::Scope scope(EventTrace::Event::kExecCtxFlush);
+        scope.set_arg(j);
+      }
+    });
+  }
+  // Copies that race with a writer are dropped, but what is dumped parses.
+  for (int i = 0; i < 10; i++) DumpedEvents();
+  for (auto& thread : threads) thread.join();
+  EventTrace::Stop();
+  Json::Array events = DumpedEvents();
+  EXPECT_EQ(events.size(), kThreads * kEventsPerThread);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  gpr_time_init();
+  return RUN_ALL_TESTS();
+}
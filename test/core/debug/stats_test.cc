@@ -18,11 +18,15 @@
 
 #include "src/core/lib/debug/stats.h"
 
+#include <string.h>
+
 #include <mutex>
 #include <queue>
 #include <random>
+#include <string>
 #include <thread>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -71,6 +75,36 @@ TEST(StatsTest, IncSpecificCounter) {
             1);
 }
 
+TEST(StatsTest, PrometheusText) {
+  grpc_stats_data data;
+  memset(&data, 0, sizeof(data));
+  data.counters[GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED] = 3;
+  // Bucket boundaries are 0, 1, 2, 4, 7, 11, 17, 26, 38, 56 (and 80).
+  gpr_atm* queue_length =
+      data.histograms + GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH_FIRST_SLOT;
+  queue_length[0] = 1;
+  queue_length[3] = 2;
+  queue_length[GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_LENGTH_BUCKETS - 1] = 1;
+  std::string text = grpc_stats_data_as_prometheus(&data);
+  EXPECT_THAT(text, ::testing::HasSubstr(
+                        "# TYPE grpc_client_calls_created counter\n"
+                        "grpc_client_calls_created 3\n"));
+  EXPECT_THAT(text,
+              ::testing::HasSubstr(
+                  "# TYPE grpc_combiner_queue_length histogram\n"
+                  "grpc_combiner_queue_length_bucket{le=\"0\"} 1\n"
+                  "grpc_combiner_queue_length_bucket{le=\"1\"} 1\n"
+                  "grpc_combiner_queue_length_bucket{le=\"3\"} 1\n"
+                  "grpc_combiner_queue_length_bucket{le=\"6\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"10\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"16\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"25\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"37\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"55\"} 3\n"
+                  "grpc_combiner_queue_length_bucket{le=\"+Inf\"} 4\n"
+                  "grpc_combiner_queue_length_count 4\n"));
+}
+
 static int FindExpectedBucket(int i, int j) {
   if (j < 0) {
     return 0;
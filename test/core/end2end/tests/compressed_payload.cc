@@ -281,7 +281,8 @@ static void request_with_payload_template_inner(
     grpc_compression_algorithm expected_algorithm_from_server,
     grpc_metadata* client_init_metadata, bool set_server_level,
     grpc_compression_level server_compression_level,
-    bool send_message_before_initial_metadata, bool decompress_in_core) {
+    bool send_message_before_initial_metadata, bool decompress_in_core,
+    int offload_threshold) {
   grpc_call* c;
   grpc_call* s;
   grpc_slice request_payload_slice;
@@ -332,6 +333,19 @@ static void request_with_payload_template_inner(
     grpc_channel_args_destroy(old_client_args);
     grpc_channel_args_destroy(old_server_args);
   }
+  if (offload_threshold > 0) {
+    grpc_arg offload_threshold_arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_COMPRESSION_CHANNEL_OFFLOAD_THRESHOLD),
+        offload_threshold);
+    const grpc_channel_args* old_client_args = client_args;
+    const grpc_channel_args* old_server_args = server_args;
+    client_args =
+        grpc_channel_args_copy_and_add(client_args, &offload_threshold_arg, 1);
+    server_args =
+        grpc_channel_args_copy_and_add(server_args, &offload_threshold_arg, 1);
+    grpc_channel_args_destroy(old_client_args);
+    grpc_channel_args_destroy(old_server_args);
+  }
   f = begin_test(config, test_name, client_args, server_args,
                  decompress_in_core);
   grpc_core::CqVerifier cqv(f.cq);
@@ -396,9 +410,15 @@ static void request_with_payload_template_inner(
   cqv.Expect(tag(100), true);
   cqv.Verify();
 
-  GPR_ASSERT(grpc_core::BitCount(
-                 grpc_call_test_only_get_encodings_accepted_by_peer(s)) ==
-             GRPC_COMPRESS_ALGORITHMS_COUNT);
+  uint32_t supported_encodings = 0;
+  for (int i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if (grpc_compression_algorithm_is_supported(
+            static_cast<grpc_compression_algorithm>(i))) {
+      grpc_core::SetBit(&supported_encodings, i);
+    }
+  }
+  GPR_ASSERT(grpc_call_test_only_get_encodings_accepted_by_peer(s) ==
+             supported_encodings);
   GPR_ASSERT(
       grpc_core::GetBit(grpc_call_test_only_get_encodings_accepted_by_peer(s),
                         GRPC_COMPRESS_NONE) != 0);
@@ -580,14 +600,22 @@ static void request_with_payload_template(
       default_server_channel_compression_algorithm,
       expected_algorithm_from_client, expected_algorithm_from_server,
       client_init_metadata, set_server_level, server_compression_level,
-      send_message_before_initial_metadata, false);
+      send_message_before_initial_metadata, false, 0);
+  request_with_payload_template_inner(
+      config, test_name, client_send_flags_bitmask,
+      default_client_channel_compression_algorithm,
+      default_server_channel_compression_algorithm,
+      expected_algorithm_from_client, expected_algorithm_from_server,
+      client_init_metadata, set_server_level, server_compression_level,
+      send_message_before_initial_metadata, true, 0);
+  /* Every message compressed and decompressed on the EventEngine */
   request_with_payload_template_inner(
       config, test_name, client_send_flags_bitmask,
       default_client_channel_compression_algorithm,
       default_server_channel_compression_algorithm,
       expected_algorithm_from_client, expected_algorithm_from_server,
       client_init_metadata, set_server_level, server_compression_level,
-      send_message_before_initial_metadata, true);
+      send_message_before_initial_metadata, true, 1);
 }
 
 static void test_invoke_request_with_exceptionally_uncompressed_payload(
@@ -0,0 +1,151 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/event_engine/posix_engine/native_dns_lookups.h"
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+
+using Addresses = absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>;
+
+class NativeDNSLookupsTest : public ::testing::Test {
+ protected:
+  // Looks \a name up, waiting for the result.
+  Addresses Lookup(absl::string_view name, absl::string_view default_port,
+                   EventEngine::Duration timeout = std::chrono::seconds(30)) {
+    absl::Notification done;
+    Addresses result;
+    lookups_.LookupHostname(
+        [&](Addresses addresses) {
+          result = std::move(addresses);
+          done.Notify();
+        },
+        name, default_port, timeout);
+    EXPECT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(60)));
+    return result;
+  }
+
+  PosixEventEngine engine_;
+  NativeDNSLookups lookups_{&engine_};
+};
+
+TEST_F(NativeDNSLookupsTest, ResolvesLiterals) {
+  auto v4 = Lookup("127.0.0.1:443", "");
+  ASSERT_TRUE(v4.ok()) << v4.status();
+  ASSERT_EQ(v4->size(), 1);
+  auto v6 = Lookup("[::1]", "80");
+  ASSERT_TRUE(v6.ok()) << v6.status();
+  ASSERT_EQ(v6->size(), 1);
+}
+
+TEST_F(NativeDNSLookupsTest, ResolvesLocalhost) {
+  auto addresses = Lookup("localhost", "443");
+  ASSERT_TRUE(addresses.ok()) << addresses.status();
+  EXPECT_FALSE(addresses->empty());
+}
+
+TEST_F(NativeDNSLookupsTest, RejectsMissingPort) {
+  auto addresses = Lookup("localhost", "");
+  EXPECT_EQ(addresses.status().code(), absl::StatusCode::kInvalidArgument);
+}
+
+TEST_F(NativeDNSLookupsTest, CoalescesConcurrentLookups) {
+  constexpr int kLookups = 3 * NativeDNSLookups::kMaxConcurrentLookups;
+  std::vector<Addresses> results(kLookups);
+  std::vector<absl::Notification> done(kLookups);
+  for (int i = 0; i < kLookups; i++) {
+    lookups_.LookupHostname(
+        [&results, &done, i](Addresses addresses) {
+          results[i] = std::move(addresses);
+          done[i].Notify();
+        },
+        "localhost", "443", std::chrono::seconds(30));
+  }
+  for (int i = 0; i < kLookups; i++) {
+    ASSERT_TRUE(done[i].WaitForNotificationWithTimeout(absl::Seconds(60)));
+    ASSERT_TRUE(results[i].ok()) << results[i].status();
+    EXPECT_EQ(results[i]->size(), results[0]->size());
+  }
+}
+
+TEST_F(NativeDNSLookupsTest, CancelledLookupsDoNotCallBack) {
+  constexpr int kLookups = 3 * NativeDNSLookups::kMaxConcurrentLookups;
+  grpc_core::Mutex mu;
+  grpc_core::CondVar cv;
+  std::vector<bool> called(kLookups, false);
+  std::vector<NativeDNSLookups::LookupTaskHandle> handles;
+  for (int i = 0; i < kLookups; i++) {
+    handles.push_back(lookups_.LookupHostname(
+        [&, i](Addresses) {
+          grpc_core::MutexLock lock(&mu);
+          called[i] = true;
+          cv.SignalAll();
+        },
+        "localhost", "443", std::chrono::seconds(30)));
+  }
+  // Lookups may complete before they are cancelled, in which case
+  // cancelling them fails.
+  std::vector<bool> cancelled(kLookups);
+  for (int i = kLookups - 1; i >= 0; i--) {
+    cancelled[i] = lookups_.CancelLookup(handles[i]);
+    // A lookup cannot be cancelled twice.
+    EXPECT_FALSE(lookups_.CancelLookup(handles[i]));
+  }
+  {
+    grpc_core::MutexLock lock(&mu);
+    for (int i = 0; i < kLookups; i++) {
+      if (cancelled[i]) continue;
+      while (!called[i]) cv.Wait(&mu);
+    }
+  }
+  // Lookups started after that still complete.
+  auto addresses = Lookup("localhost", "443");
+  EXPECT_TRUE(addresses.ok()) << addresses.status();
+  grpc_core::MutexLock lock(&mu);
+  for (int i = 0; i < kLookups; i++) {
+    EXPECT_NE(called[i], cancelled[i]) << i;
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,295 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/slice.h>
+#include <grpc/event_engine/slice_buffer.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller_posix_default.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/event_engine/posix_engine/tcp_socket_utils.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+
+// This test won't work except with posix sockets enabled
+#ifdef GRPC_POSIX_SOCKET_TCP
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_poll_strategy);
+
+namespace grpc_event_engine {
+namespace posix_engine {
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+using ::grpc_event_engine::experimental::Slice;
+using ::grpc_event_engine::experimental::SliceBuffer;
+using namespace std::chrono_literals;
+
+class TestScheduler : public Scheduler {
+ public:
+  explicit TestScheduler(EventEngine* engine) : engine_(engine) {}
+  void Run(EventEngine::Closure* closure) override { engine_->Run(closure); }
+  void Run(absl::AnyInvocable<void()> cb) override {
+    engine_->Run(std::move(cb));
+  }
+
+ private:
+  EventEngine* engine_;
+};
+
+// Connects two non-blocking sockets over loopback TCP.
+void CreateConnectedSockets(int* client_fd, int* server_fd) {
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(listen_fd, 0);
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  ASSERT_EQ(bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+            0);
+  ASSERT_EQ(listen(listen_fd, 1), 0);
+  socklen_t len = sizeof(addr);
+  ASSERT_EQ(getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len),
+            0);
+  *client_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(*client_fd, 0);
+  ASSERT_EQ(connect(*client_fd, reinterpret_cast<sockaddr*>(&addr), len), 0);
+  *server_fd = accept(listen_fd, nullptr, nullptr);
+  ASSERT_GE(*server_fd, 0);
+  close(listen_fd);
+  for (int fd : {*client_fd, *server_fd}) {
+    ASSERT_EQ(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK), 0);
+  }
+}
+
+std::string MakeData(size_t length) {
+  std::string data(length, '\0');
+  for (size_t i = 0; i < length; i++) data[i] = static_cast<char>(i * 7 + 3);
+  return data;
+}
+
+// Writes data on one endpoint and reads it from the other, expecting it to
+// arrive intact.
+void ExchangeData(PosixEndpoint* writer, PosixEndpoint* reader,
+                  size_t length) {
+  const std::string data = MakeData(length);
+  SliceBuffer write_buffer;
+  write_buffer.Append(Slice::FromCopiedString(data));
+  grpc_core::Notification write_done;
+  writer->Write(
+      [&write_done](absl::Status status) {
+        EXPECT_TRUE(status.ok()) << status;
+        write_done.Notify();
+      },
+      &write_buffer, nullptr);
+  std::string received;
+  SliceBuffer read_buffer;
+  while (received.size() < length) {
+    grpc_core::Notification read_done;
+    bool read_ok = false;
+    reader->Read(
+        [&read_done, &read_ok](absl::Status status) {
+          EXPECT_TRUE(status.ok()) << status;
+          read_ok = status.ok();
+          read_done.Notify();
+        },
+        &read_buffer, nullptr);
+    read_done.WaitForNotification();
+    if (!read_ok) break;
+    grpc_slice_buffer* slices = read_buffer.c_slice_buffer();
+    for (size_t i = 0; i < slices->count; i++) {
+      const grpc_slice& slice = slices->slices[i];
+      received.append(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+          GRPC_SLICE_LENGTH(slice));
+    }
+  }
+  write_done.WaitForNotification();
+  EXPECT_EQ(received.size(), data.size());
+  EXPECT_TRUE(received == data);
+}
+
+class PosixEndpointTest : public ::testing::TestWithParam<std::string> {
+ protected:
+  void SetUp() override {
+    engine_ = std::make_shared<PosixEventEngine>();
+    scheduler_ = std::make_unique<TestScheduler>(engine_.get());
+    GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, GetParam().c_str());
+    poller_ = GetDefaultPoller(scheduler_.get());
+    if (poller_ == nullptr) return;
+    poll_thread_ = std::thread([this]() {
+      while (!shutdown_.load(std::memory_order_acquire)) {
+        poller_->Work(24h, []() {});
+      }
+    });
+  }
+
+  void TearDown() override {
+    if (poller_ == nullptr) return;
+    shutdown_.store(true, std::memory_order_release);
+    poller_->Kick();
+    poll_thread_.join();
+    poller_->Shutdown();
+  }
+
+  std::unique_ptr<PosixEndpoint> CreateEndpoint(int fd,
+                                                PosixTcpOptions options) {
+    options.resource_quota = grpc_core::ResourceQuota::Default();
+    EventHandle* handle =
+        poller_->CreateHandle(fd, "posix_endpoint_test",
+                              poller_->CanTrackErrors());
+    return CreatePosixEndpoint(handle, nullptr, engine_, options);
+  }
+
+  PosixEventPoller* poller() { return poller_; }
+
+ private:
+  std::shared_ptr<PosixEventEngine> engine_;
+  std::unique_ptr<TestScheduler> scheduler_;
+  PosixEventPoller* poller_ = nullptr;
+  std::atomic<bool> shutdown_{false};
+  std::thread poll_thread_;
+};
+
+TEST_P(PosixEndpointTest, WritesArriveIntact) {
+  if (poller() == nullptr) return;
+  int client_fd, server_fd;
+  CreateConnectedSockets(&client_fd, &server_fd);
+  auto client = CreateEndpoint(client_fd, PosixTcpOptions());
+  auto server = CreateEndpoint(server_fd, PosixTcpOptions());
+  for (size_t length : {1, 1000, 64 * 1024, 4 * 1024 * 1024}) {
+    ExchangeData(client.get(), server.get(), length);
+    ExchangeData(server.get(), client.get(), length);
+  }
+}
+
+TEST_P(PosixEndpointTest, ZerocopyWritesArriveIntact) {
+  if (poller() == nullptr) return;
+  int client_fd, server_fd;
+  CreateConnectedSockets(&client_fd, &server_fd);
+  PosixTcpOptions options;
+  options.tcp_tx_zero_copy_enabled = true;
+  options.tcp_tx_zerocopy_send_bytes_threshold = 4096;
+  auto client = CreateEndpoint(client_fd, options);
+  auto server = CreateEndpoint(server_fd, PosixTcpOptions());
+  // More writes than there are zerocopy send records, so that records have to
+  // be recycled.
+  for (int i = 0; i < 3 * PosixTcpOptions::kDefaultMaxSends; i++) {
+    ExchangeData(client.get(), server.get(), 1024 * 1024);
+  }
+}
+
+TEST_P(PosixEndpointTest, AddressesMatchPeer) {
+  if (poller() == nullptr) return;
+  int client_fd, server_fd;
+  CreateConnectedSockets(&client_fd, &server_fd);
+  auto client = CreateEndpoint(client_fd, PosixTcpOptions());
+  auto server = CreateEndpoint(server_fd, PosixTcpOptions());
+  auto client_peer = SockaddrToString(&client->GetPeerAddress(), true);
+  auto server_local = SockaddrToString(&server->GetLocalAddress(), true);
+  ASSERT_TRUE(client_peer.ok());
+  ASSERT_TRUE(server_local.ok());
+  EXPECT_EQ(*client_peer, *server_local);
+  auto client_local = SockaddrToString(&client->GetLocalAddress(), true);
+  auto server_peer = SockaddrToString(&server->GetPeerAddress(), true);
+  ASSERT_TRUE(client_local.ok());
+  ASSERT_TRUE(server_peer.ok());
+  EXPECT_EQ(*client_local, *server_peer);
+}
+
+TEST_P(PosixEndpointTest, DestroyingEndpointFailsPendingRead) {
+  if (poller() == nullptr) return;
+  int client_fd, server_fd;
+  CreateConnectedSockets(&client_fd, &server_fd);
+  auto client = CreateEndpoint(client_fd, PosixTcpOptions());
+  auto server = CreateEndpoint(server_fd, PosixTcpOptions());
+  grpc_core::Notification read_done;
+  SliceBuffer read_buffer;
+  server->Read(
+      [&read_done](absl::Status status) {
+        EXPECT_FALSE(status.ok());
+        read_done.Notify();
+      },
+      &read_buffer, nullptr);
+  server.reset();
+  read_done.WaitForNotification();
+}
+
+TEST_P(PosixEndpointTest, ReadFailsOnceThePeerIsGone) {
+  if (poller() == nullptr) return;
+  int client_fd, server_fd;
+  CreateConnectedSockets(&client_fd, &server_fd);
+  auto client = CreateEndpoint(client_fd, PosixTcpOptions());
+  auto server = CreateEndpoint(server_fd, PosixTcpOptions());
+  client.reset();
+  grpc_core::Notification read_done;
+  SliceBuffer read_buffer;
+  server->Read(
+      [&read_done](absl::Status status) {
+        EXPECT_FALSE(status.ok());
+        read_done.Notify();
+      },
+      &read_buffer, nullptr);
+  read_done.WaitForNotification();
+}
+
+INSTANTIATE_TEST_SUITE_P(PosixEndpoint, PosixEndpointTest,
+                         ::testing::ValuesIn({std::string("epoll1"),
+                                              std::string("poll")}),
+                         [](const ::testing::TestParamInfo<std::string>& info) {
+                           return info.param;
+                         });
+
+}  // namespace
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
+
+#else  // GRPC_POSIX_SOCKET_TCP
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif  // GRPC_POSIX_SOCKET_TCP
@@ -27,6 +27,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
 #include "src/core/lib/gprpp/time.h"
 
 using testing::Mock;
@@ -66,7 +67,13 @@ CheckResult FinishCheck(
 
 }  // namespace
 
-TEST(TimerListTest, Add) {
+template <typename T>
+class TimerListTest : public testing::Test {};
+
+using TimerListTypes = testing::Types<TimerList, TimerWheel>;
+TYPED_TEST_SUITE(TimerListTest, TimerListTypes);
+
+TYPED_TEST(TimerListTest, Add) {
   Timer timers[20];
   StrictMock<MockClosure> closures[20];
 
@@ -75,7 +82,7 @@ TEST(TimerListTest, Add) {
 
   StrictMock<MockHost> host;
   EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
-  TimerList timer_list(&host);
+  TypeParam timer_list(&host);
 
   /* 10 ms timers.  will expire in the current epoch */
   for (int i = 0; i < 10; i++) {
@@ -129,7 +136,7 @@ TEST(TimerListTest, Add) {
 }
 
 /* Cleaning up a list with pending timers. */
-TEST(TimerListTest, Destruction) {
+TYPED_TEST(TimerListTest, Destruction) {
   Timer timers[5];
   StrictMock<MockClosure> closures[5];
 
@@ -137,7 +144,7 @@ TEST(TimerListTest, Destruction) {
   EXPECT_CALL(host, Now())
       .WillOnce(
           Return(grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(0)));
-  TimerList timer_list(&host);
+  TypeParam timer_list(&host);
 
   EXPECT_CALL(host, Now())
       .WillOnce(
@@ -195,7 +202,7 @@ TEST(TimerListTest, Destruction) {
         step 1) to `now+4`
     4) Shuts down the timer list
    https://github.com/grpc/grpc/issues/15904 */
-TEST(TimerListTest, LongRunningServiceCleanup) {
+TYPED_TEST(TimerListTest, LongRunningServiceCleanup) {
   Timer timers[4];
   StrictMock<MockClosure> closures[4];
 
@@ -204,7 +211,7 @@ TEST(TimerListTest, LongRunningServiceCleanup) {
 
   StrictMock<MockHost> host;
   EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
-  TimerList timer_list(&host);
+  TypeParam timer_list(&host);
 
   EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
   timer_list.TimerInit(&timers[0], kStart + k25Days, &closures[0]);
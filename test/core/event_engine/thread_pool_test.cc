@@ -25,20 +25,28 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/event_engine/work_stealing_thread_pool.h"
 #include "src/core/lib/gprpp/notification.h"
 
 namespace grpc_event_engine {
 namespace experimental {
 
-TEST(ThreadPoolTest, CanRunClosure) {
-  ThreadPool p(1);
+template <typename T>
+class ThreadPoolTest : public testing::Test {};
+
+using ThreadPoolTypes =
+    ::testing::Types<OriginalThreadPool, WorkStealingThreadPool>;
+TYPED_TEST_SUITE(ThreadPoolTest, ThreadPoolTypes);
+
+TYPED_TEST(ThreadPoolTest, CanRunClosure) {
+  TypeParam p(1);
   grpc_core::Notification n;
   p.Add([&n] { n.Notify(); });
   n.WaitForNotification();
 }
 
-TEST(ThreadPoolTest, CanDestroyInsideClosure) {
-  auto p = std::make_shared<ThreadPool>(1);
+TYPED_TEST(ThreadPoolTest, CanDestroyInsideClosure) {
+  auto p = std::make_shared<TypeParam>(1);
   grpc_core::Notification n;
   p->Add([p, &n]() mutable {
     std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -51,8 +59,8 @@ TEST(ThreadPoolTest, CanDestroyInsideClosure) {
   n.WaitForNotification();
 }
 
-TEST(ThreadPoolTest, CanSurviveFork) {
-  ThreadPool p(1);
+TYPED_TEST(ThreadPoolTest, CanSurviveFork) {
+  TypeParam p(1);
   grpc_core::Notification n;
   gpr_log(GPR_INFO, "add callback 1");
   p.Add([&n, &p] {
@@ -84,11 +92,16 @@ void ScheduleSelf(ThreadPool* p) {
   p->Add([p] { ScheduleSelf(p); });
 }
 
-TEST(ThreadPoolDeathTest, CanDetectStucknessAtFork) {
+template <typename T>
+class ThreadPoolDeathTest : public testing::Test {};
+
+TYPED_TEST_SUITE(ThreadPoolDeathTest, ThreadPoolTypes);
+
+TYPED_TEST(ThreadPoolDeathTest, CanDetectStucknessAtFork) {
   ASSERT_DEATH_IF_SUPPORTED(
       [] {
         gpr_set_log_verbosity(GPR_LOG_SEVERITY_ERROR);
-        ThreadPool p(1);
+        TypeParam p(1);
         ScheduleSelf(&p);
         std::thread terminator([] {
           std::this_thread::sleep_for(std::chrono::seconds(10));
@@ -107,8 +120,8 @@ void ScheduleTwiceUntilZero(ThreadPool* p, int n) {
   });
 }
 
-TEST(ThreadPoolTest, CanStartLotsOfClosures) {
-  ThreadPool p(1);
+TYPED_TEST(ThreadPoolTest, CanStartLotsOfClosures) {
+  TypeParam p(1);
   // Our first thread pool implementation tried to create ~1M threads for this
   // test.
   ScheduleTwiceUntilZero(&p, 20);
@@ -118,12 +118,13 @@ TEST_F(IOCPTest, ClientReceivesNotificationOfServerSend) {
                                [&cb_invoked]() { cb_invoked = true; });
   ASSERT_TRUE(work_result == Poller::WorkResult::kOk);
   ASSERT_TRUE(cb_invoked);
-  // Doing work for WSARecv
+  // Doing work for WSARecv, unless it was dequeued along with the WSASend
   cb_invoked = false;
-  work_result = iocp.Work(std::chrono::seconds(10),
+  work_result = iocp.Work(std::chrono::seconds(1),
                           [&cb_invoked]() { cb_invoked = true; });
-  ASSERT_TRUE(work_result == Poller::WorkResult::kOk);
-  ASSERT_TRUE(cb_invoked);
+  ASSERT_TRUE(work_result == Poller::WorkResult::kOk ||
+              work_result == Poller::WorkResult::kDeadlineExceeded);
+  ASSERT_EQ(cb_invoked, work_result == Poller::WorkResult::kOk);
   // wait for the callbacks to run
   read_called.WaitForNotification();
   write_called.WaitForNotification();
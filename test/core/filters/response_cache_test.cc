@@ -0,0 +1,138 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/response_cache/response_cache_filter.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+const Timestamp kNow = Timestamp::FromMillisecondsAfterProcessEpoch(1000000);
+
+std::shared_ptr<const CachedResponse> MakeResponse(absl::string_view message) {
+  auto response = std::make_shared<CachedResponse>();
+  response->initial_metadata.emplace_back(
+      Slice::FromCopiedString("cache-control"),
+      Slice::FromCopiedString("max-age=60"));
+  response->message.Append(Slice::FromCopiedString(message));
+  response->trailing_metadata.emplace_back(
+      Slice::FromCopiedString("grpc-status"), Slice::FromCopiedString("0"));
+  return response;
+}
+
+class ResponseCacheTest : public ::testing::Test {
+ protected:
+  RefCountedPtr<ResponseCache> MakeCache(size_t max_size) {
+    return MakeRefCounted<ResponseCache>(
+        max_size, quota_->memory_quota()->CreateMemoryOwner("test"));
+  }
+
+  ExecCtx exec_ctx_;
+  ResourceQuotaRefPtr quota_ = MakeResourceQuota("response_cache_test");
+};
+
+TEST_F(ResponseCacheTest, ReturnsWhatWasInserted) {
+  auto cache = MakeCache(1 << 20);
+  EXPECT_EQ(cache->Lookup("a", kNow), nullptr);
+  auto response = MakeResponse("hello");
+  cache->Insert("a", response, kNow + Duration::Seconds(60));
+  EXPECT_EQ(cache->Lookup("a", kNow), response);
+  EXPECT_EQ(cache->Lookup("b", kNow), nullptr);
+  EXPECT_GT(cache->size(), response->Size());
+}
+
+TEST_F(ResponseCacheTest, ExpiresEntries) {
+  auto cache = MakeCache(1 << 20);
+  cache->Insert("a", MakeResponse("hello"), kNow + Duration::Seconds(60));
+  EXPECT_NE(cache->Lookup("a", kNow + Duration::Seconds(59)), nullptr);
+  EXPECT_EQ(cache->Lookup("a", kNow + Duration::Seconds(60)), nullptr);
+  EXPECT_EQ(cache->size(), 0);
+}
+
+TEST_F(ResponseCacheTest, ReplacesEntries) {
+  auto cache = MakeCache(1 << 20);
+  cache->Insert("a", MakeResponse("old"), kNow + Duration::Seconds(60));
+  const size_t size = cache->size();
+  auto response = MakeResponse("new");
+  cache->Insert("a", response, kNow + Duration::Seconds(60));
+  EXPECT_EQ(cache->Lookup("a", kNow), response);
+  EXPECT_EQ(cache->size(), size);
+}
+
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+  const std::string message(1000, 'x');
+  const Timestamp expiry = kNow + Duration::Seconds(60);
+  auto probe = MakeCache(1 << 20);
+  probe->Insert("a", MakeResponse(message), expiry);
+  // Room for three entries, not four.
+  const size_t max_size = probe->size() * 7 / 2;
+  auto cache = MakeCache(max_size);
+  cache->Insert("a", MakeResponse(message), expiry);
+  cache->Insert("b", MakeResponse(message), expiry);
+  cache->Insert("c", MakeResponse(message), expiry);
+  // Makes "a" more recently used than "b".
+  EXPECT_NE(cache->Lookup("a", kNow), nullptr);
+  cache->Insert("d", MakeResponse(message), expiry);
+  EXPECT_NE(cache->Lookup("a", kNow), nullptr);
+  EXPECT_EQ(cache->Lookup("b", kNow), nullptr);
+  EXPECT_NE(cache->Lookup("c", kNow), nullptr);
+  EXPECT_NE(cache->Lookup("d", kNow), nullptr);
+  EXPECT_LE(cache->size(), max_size);
+}
+
+TEST_F(ResponseCacheTest, SkipsResponsesLargerThanTheCache) {
+  auto cache = MakeCache(1000);
+  cache->Insert("a", MakeResponse(std::string(1000, 'x')),
+                kNow + Duration::Seconds(60));
+  EXPECT_EQ(cache->Lookup("a", kNow), nullptr);
+  EXPECT_EQ(cache->size(), 0);
+}
+
+TEST(ResponseCacheParseMaxAgeTest, ParsesMaxAge) {
+  EXPECT_EQ(ResponseCache::ParseMaxAge("max-age=30"), Duration::Seconds(30));
+  EXPECT_EQ(ResponseCache::ParseMaxAge("public, max-age=5"),
+            Duration::Seconds(5));
+  EXPECT_EQ(ResponseCache::ParseMaxAge(" private ,max-age=0 "),
+            Duration::Zero());
+  EXPECT_EQ(ResponseCache::ParseMaxAge("public"), absl::nullopt);
+}
+
+TEST(ResponseCacheParseMaxAgeTest, RejectsUncacheable) {
+  EXPECT_EQ(ResponseCache::ParseMaxAge("no-store"), absl::nullopt);
+  EXPECT_EQ(ResponseCache::ParseMaxAge("max-age=30, No-Cache"), absl::nullopt);
+  EXPECT_EQ(ResponseCache::ParseMaxAge("max-age=-1"), absl::nullopt);
+  EXPECT_EQ(ResponseCache::ParseMaxAge("max-age=soon"), absl::nullopt);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
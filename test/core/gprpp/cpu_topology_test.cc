@@ -0,0 +1,84 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/cpu_topology.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(ParseCpuListTest, ParsesRangesAndSingleCpus) {
+  EXPECT_THAT(ParseCpuList("0-3,8,10-11").value(),
+              ElementsAre(0, 1, 2, 3, 8, 10, 11));
+  EXPECT_THAT(ParseCpuList("5").value(), ElementsAre(5));
+  EXPECT_THAT(ParseCpuList("").value(), ElementsAre());
+}
+
+TEST(ParseCpuListTest, SortsAndDeduplicates) {
+  EXPECT_THAT(ParseCpuList("4-5,0,5,1-2").value(), ElementsAre(0, 1, 2, 4, 5));
+}
+
+TEST(ParseCpuListTest, RejectsMalformedLists) {
+  EXPECT_FALSE(ParseCpuList("a").has_value());
+  EXPECT_FALSE(ParseCpuList("3-1").has_value());
+  EXPECT_FALSE(ParseCpuList("1-").has_value());
+  EXPECT_FALSE(ParseCpuList("-1").has_value());
+  EXPECT_FALSE(ParseCpuList("1,,2").has_value());
+}
+
+TEST(CpuTopologyTest, MapsCpusToNodes) {
+  CpuTopology topology({{0, 1, 2, 3}, {}, {4, 5, 6, 7}});
+  ASSERT_EQ(topology.num_nodes(), 2);
+  EXPECT_THAT(topology.CpusOfNode(1), ElementsAre(4, 5, 6, 7));
+  EXPECT_EQ(topology.NodeOfCpu(2), 0);
+  EXPECT_EQ(topology.NodeOfCpu(7), 1);
+  EXPECT_FALSE(topology.NodeOfCpu(8).has_value());
+}
+
+TEST(CpuTopologyTest, FallsBackToASingleNode) {
+  CpuTopology topology({});
+  ASSERT_EQ(topology.num_nodes(), 1);
+  EXPECT_THAT(topology.CpusOfNode(0), ElementsAre(0));
+}
+
+TEST(CpuTopologyTest, NextNodeIsRoundRobin) {
+  CpuTopology topology({{0}, {1}, {2}});
+  EXPECT_EQ(topology.NextNode(), 0);
+  EXPECT_EQ(topology.NextNode(), 1);
+  EXPECT_EQ(topology.NextNode(), 2);
+  EXPECT_EQ(topology.NextNode(), 0);
+}
+
+TEST(CpuTopologyTest, DiscoversThisMachine) {
+  const CpuTopology& topology = CpuTopology::Get();
+  ASSERT_GE(topology.num_nodes(), 1);
+  for (size_t i = 0; i < topology.num_nodes(); i++) {
+    ASSERT_FALSE(topology.CpusOfNode(i).empty());
+    EXPECT_EQ(topology.NodeOfCpu(topology.CpusOfNode(i).front()), i);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
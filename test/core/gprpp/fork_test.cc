@@ -20,6 +20,9 @@
 
 #include <gtest/gtest.h>
 
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
 #include "src/core/lib/gprpp/thd.h"
 #include "test/core/util/test_config.h"
 
@@ -84,6 +87,41 @@ TEST(ForkTest, ThdCount) {
   ASSERT_TRUE(gpr_time_similar(end_time, est_end_time, tolerance));
 }
 
+struct HeldExecCtx {
+  gpr_event created;
+  gpr_event release;
+};
+
+static void held_exec_ctx_thread(void* arg) {
+  HeldExecCtx* held = static_cast<HeldExecCtx*>(arg);
+  grpc_core::Fork::IncExecCtxCount();
+  gpr_event_set(&held->created, reinterpret_cast<void*>(1));
+  gpr_event_wait(&held->release, gpr_inf_future(GPR_CLOCK_REALTIME));
+  grpc_core::Fork::DecExecCtxCount();
+}
+
+// ExecCtx counts are kept per thread: check that blocking still sees the
+// ExecCtxs of other threads.
+TEST(ForkTest, ExecCountAcrossThreads) {
+  grpc_core::Fork::Enable(true);
+  grpc_core::Fork::GlobalInit();
+
+  HeldExecCtx held;
+  gpr_event_init(&held.created);
+  gpr_event_init(&held.release);
+  grpc_core::Thread thd =
+      grpc_core::Thread("grpc_fork_test", held_exec_ctx_thread, &held);
+  thd.Start();
+  gpr_event_wait(&held.created, gpr_inf_future(GPR_CLOCK_REALTIME));
+  grpc_core::Fork::IncExecCtxCount();
+  ASSERT_FALSE(grpc_core::Fork::BlockExecCtx());
+  gpr_event_set(&held.release, reinterpret_cast<void*>(1));
+  thd.Join();
+  ASSERT_TRUE(grpc_core::Fork::BlockExecCtx());
+  grpc_core::Fork::DecExecCtxCount();
+  grpc_core::Fork::AllowExecCtx();
+}
+
 static void exec_ctx_thread(void* arg) {
   bool* exec_ctx_created = static_cast<bool*>(arg);
   grpc_core::Fork::IncExecCtxCount();
@@ -0,0 +1,107 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/mutex_contention_profiler.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class MutexContentionProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { MutexContentionProfiler::Reset(); }
+  void TearDown() override {
+    MutexContentionProfiler::Stop();
+    MutexContentionProfiler::Reset();
+  }
+
+  // Holds mu on another thread until the returned thread is joined, while
+  // this thread waits for it from the line after the call.
+  static std::thread HoldFor(Mutex* mu, absl::Duration duration,
+                             int* holder_line) {
+    std::atomic<bool> held{false};
+    std::thread holder([mu, duration, holder_line, &held] {
+      *holder_line = __LINE__ + 1;
+      MutexLock lock(mu);
+      held.store(true);
+      absl::SleepFor(duration);
+    });
+    while (!held.load()) absl::SleepFor(absl::Milliseconds(1));
+    return holder;
+  }
+};
+
+TEST_F(MutexContentionProfilerTest, RecordsHolderAndWaiter) {
+  MutexContentionProfiler::Start(1);
+  Mutex mu;
+  int holder_line = 0;
+  std::thread holder = HoldFor(&mu, absl::Milliseconds(100), &holder_line);
+  const int waiter_line = __LINE__ + 1;
+  { MutexLock lock(&mu); }
+  holder.join();
+  auto sites = MutexContentionProfiler::TopSites(10);
+  ASSERT_EQ(sites.size(), 1u);
+  EXPECT_NE(strstr(sites[0].holder.file(), "mutex_contention_profiler_test"),
+            nullptr);
+  EXPECT_EQ(sites[0].holder.line(), holder_line);
+  EXPECT_EQ(sites[0].waiter.line(), waiter_line);
+  EXPECT_EQ(sites[0].contentions, 1u);
+  EXPECT_GE(sites[0].total_wait_ns, 50 * 1000 * 1000);
+  EXPECT_EQ(sites[0].max_wait_ns, sites[0].total_wait_ns);
+}
+
+TEST_F(MutexContentionProfilerTest, SamplesOneInPeriod) {
+  MutexContentionProfiler::Start(2);
+  Mutex mu;
+  int holder_line = 0;
+  for (int i = 0; i < 4; i++) {
+    std::thread holder = HoldFor(&mu, absl::Milliseconds(10), &holder_line);
+    { ReleasableMutexLock lock(&mu); }
+    holder.join();
+  }
+  auto sites = MutexContentionProfiler::TopSites(10);
+  ASSERT_EQ(sites.size(), 1u);
+  EXPECT_EQ(sites[0].contentions, 2u);
+}
+
+TEST_F(MutexContentionProfilerTest, NothingRecordedWhenStopped) {
+  Mutex mu;
+  int holder_line = 0;
+  std::thread holder = HoldFor(&mu, absl::Milliseconds(10), &holder_line);
+  { MutexLock lock(&mu); }
+  holder.join();
+  EXPECT_TRUE(MutexContentionProfiler::TopSites(10).empty());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/gprpp/sharded_ref_count.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+TEST(ShardedRefCount, ReleaseInitialRefAlone) {
+  ShardedRefCount refs;
+  EXPECT_TRUE(refs.ReleaseInitialRef());
+}
+
+TEST(ShardedRefCount, RefsBeforeRelease) {
+  ShardedRefCount refs;
+  refs.Ref();
+  refs.Ref();
+  EXPECT_FALSE(refs.Unref());
+  EXPECT_FALSE(refs.ReleaseInitialRef());
+  EXPECT_TRUE(refs.Unref());
+}
+
+TEST(ShardedRefCount, RefsAfterRelease) {
+  ShardedRefCount refs;
+  refs.Ref();
+  EXPECT_FALSE(refs.ReleaseInitialRef());
+  refs.Ref();
+  EXPECT_FALSE(refs.Unref());
+  EXPECT_TRUE(refs.Unref());
+}
+
+TEST(ShardedRefCount, RefsFromManyThreads) {
+  ShardedRefCount refs;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 32; ++i) {
+    // Each thread takes a ref for the others to drop.
+    refs.Ref();
+    threads.emplace_back([&refs, i]() {
+      for (int j = 0; j < 1000; ++j) {
+        refs.Ref();
+        EXPECT_FALSE(refs.Unref());
+      }
+      if (i % 2 == 0) EXPECT_FALSE(refs.Unref());
+    });
+  }
+  EXPECT_FALSE(refs.ReleaseInitialRef());
+  for (auto& thread : threads) thread.join();
+  for (int i = 1; i < 31; i += 2) EXPECT_FALSE(refs.Unref());
+  EXPECT_TRUE(refs.Unref());
+}
+
+class Foo : public ShardedInternallyRefCounted<Foo> {
+ public:
+  explicit Foo(bool* destroyed) : destroyed_(destroyed) {}
+  ~Foo() override { *destroyed_ = true; }
+
+  void Orphan() override { ReleaseInitialRef(); }
+
+  using ShardedInternallyRefCounted::Ref;
+
+ private:
+  bool* destroyed_;
+};
+
+TEST(ShardedInternallyRefCounted, DestroyedWhenOrphanedWithoutRefs) {
+  bool destroyed = false;
+  auto foo = MakeOrphanable<Foo>(&destroyed);
+  foo.reset();
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(ShardedInternallyRefCounted, RefOutlivesOwner) {
+  bool destroyed = false;
+  auto foo = MakeOrphanable<Foo>(&destroyed);
+  RefCountedPtr<Foo> ref = foo->Ref();
+  foo.reset();
+  EXPECT_FALSE(destroyed);
+  RefCountedPtr<Foo> ref2 = ref->Ref(DEBUG_LOCATION, "ref2");
+  ref.reset();
+  EXPECT_FALSE(destroyed);
+  ref2.reset();
+  EXPECT_TRUE(destroyed);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
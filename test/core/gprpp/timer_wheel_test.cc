@@ -0,0 +1,186 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/timer_wheel.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace grpc_core {
+namespace testing {
+
+struct TestTimer {
+  int64_t deadline;
+  uint32_t heap_index;
+  TestTimer* next;
+  TestTimer* prev;
+  bool pending = false;
+};
+
+using Wheel = HierarchicalTimerWheel<TestTimer>;
+
+std::vector<TestTimer*> AdvanceAndCollect(Wheel* wheel, int64_t now) {
+  std::vector<TestTimer*> out;
+  wheel->Advance(now, [&out](TestTimer* t) { out.push_back(t); });
+  return out;
+}
+
+TEST(TimerWheelTest, StartsEmpty) {
+  Wheel wheel(0);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.NextDeadline(), std::numeric_limits<int64_t>::max());
+  EXPECT_TRUE(AdvanceAndCollect(&wheel, 1000000).empty());
+}
+
+TEST(TimerWheelTest, FiresAtDeadline) {
+  Wheel wheel(100);
+  TestTimer t;
+  t.deadline = 110;
+  wheel.Add(&t);
+  EXPECT_EQ(wheel.NextDeadline(), 110);
+  EXPECT_TRUE(AdvanceAndCollect(&wheel, 109).empty());
+  EXPECT_EQ(AdvanceAndCollect(&wheel, 110), std::vector<TestTimer*>{&t});
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastDeadlineFiresOnNextAdvance) {
+  Wheel wheel(100);
+  AdvanceAndCollect(&wheel, 200);
+  TestTimer t;
+  t.deadline = 50;
+  wheel.Add(&t);
+  EXPECT_EQ(wheel.NextDeadline(), 201);
+  EXPECT_EQ(AdvanceAndCollect(&wheel, 200), std::vector<TestTimer*>{&t});
+}
+
+TEST(TimerWheelTest, CancelIsConstantTimeAndExact) {
+  Wheel wheel(0);
+  TestTimer a, b, c;
+  a.deadline = 10;
+  b.deadline = 10;
+  c.deadline = 10;
+  wheel.Add(&a);
+  wheel.Add(&b);
+  wheel.Add(&c);
+  wheel.Remove(&b);
+  EXPECT_EQ(wheel.size(), 2);
+  auto fired = AdvanceAndCollect(&wheel, 10);
+  EXPECT_EQ(std::set<TestTimer*>(fired.begin(), fired.end()),
+            (std::set<TestTimer*>{&a, &c}));
+}
+
+TEST(TimerWheelTest, NextDeadlineIsALowerBound) {
+  Wheel wheel(0);
+  TestTimer t;
+  t.deadline = 100000;
+  wheel.Add(&t);
+  int64_t now = 0;
+  // Repeatedly sleeping until the reported deadline must converge on the
+  // actual deadline without overshooting it.
+  while (!wheel.empty()) {
+    int64_t next = wheel.NextDeadline();
+    ASSERT_LE(next, t.deadline);
+    ASSERT_GT(next, now);
+    now = next;
+    AdvanceAndCollect(&wheel, now);
+  }
+  EXPECT_EQ(now, t.deadline);
+}
+
+TEST(TimerWheelTest, FarFutureTimersAreDrained) {
+  Wheel wheel(0);
+  TestTimer near, far, inf;
+  near.deadline = 3;
+  far.deadline = int64_t{1} << 40;
+  inf.deadline = std::numeric_limits<int64_t>::max() - 1;
+  wheel.Add(&near);
+  wheel.Add(&far);
+  wheel.Add(&inf);
+  EXPECT_EQ(AdvanceAndCollect(&wheel, 4), std::vector<TestTimer*>{&near});
+  std::vector<TestTimer*> rest;
+  wheel.PopAll([&rest](TestTimer* t) { rest.push_back(t); });
+  EXPECT_EQ(std::set<TestTimer*>(rest.begin(), rest.end()),
+            (std::set<TestTimer*>{&far, &inf}));
+  EXPECT_TRUE(wheel.empty());
+}
+
+// Compares the wheel against a brute force model with random deadlines spread
+// over every level, random cancellations and random advance steps.
+TEST(TimerWheelTest, MatchesModel) {
+  std::mt19937_64 rng(42);
+  const int64_t kStart = (int64_t{1} << 32) - 5000;
+  Wheel wheel(kStart);
+  std::vector<std::unique_ptr<TestTimer>> timers;
+  int64_t now = kStart;
+  for (int round = 0; round < 20000; round++) {
+    switch (rng() % 4) {
+      case 0:
+      case 1: {
+        timers.push_back(std::make_unique<TestTimer>());
+        TestTimer* t = timers.back().get();
+        // Spread deadlines from the recent past to beyond level 3.
+        const int shift = rng() % 36;
+        const uint64_t range = (uint64_t{1} << shift) + 1;
+        t->deadline = now - 10 + static_cast<int64_t>(rng() % range);
+        t->pending = true;
+        wheel.Add(t);
+        break;
+      }
+      case 2: {
+        if (timers.empty()) break;
+        TestTimer* t = timers[rng() % timers.size()].get();
+        if (t->pending) {
+          t->pending = false;
+          wheel.Remove(t);
+        }
+        break;
+      }
+      case 3: {
+        const int64_t step = static_cast<int64_t>(rng() % 3000);
+        now += step;
+        for (TestTimer* t : AdvanceAndCollect(&wheel, now)) {
+          ASSERT_TRUE(t->pending);
+          ASSERT_LE(t->deadline, now);
+          t->pending = false;
+        }
+        size_t pending = 0;
+        int64_t min_deadline = std::numeric_limits<int64_t>::max();
+        for (const auto& t : timers) {
+          if (!t->pending) continue;
+          ASSERT_GT(t->deadline, now);
+          ++pending;
+          min_deadline = std::min(min_deadline, t->deadline);
+        }
+        ASSERT_EQ(pending, wheel.size());
+        ASSERT_LE(wheel.NextDeadline(), min_deadline);
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/tsc_clock.h"
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+int64_t MonotonicNanos() {
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+TEST(TscClockTest, TracksMonotonicClock) {
+  if (!TscClock::Supported()) GTEST_SKIP() << "no invariant TSC";
+  TscClock clock(10 * GPR_NS_PER_MS);
+  for (int i = 0; i < 20; i++) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(5));
+    const int64_t before = MonotonicNanos();
+    const int64_t now = clock.Now();
+    const int64_t after = MonotonicNanos();
+    // Well within the millisecond resolution of Timestamp.
+    EXPECT_GT(now, before - 200 * GPR_NS_PER_US);
+    EXPECT_LT(now, after + 200 * GPR_NS_PER_US);
+  }
+}
+
+TEST(TscClockTest, NeverGoesBackOnOneThread) {
+  if (!TscClock::Supported()) GTEST_SKIP() << "no invariant TSC";
+  // Resync often, as many threads read the clock.
+  TscClock clock(100 * GPR_NS_PER_US);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&clock]() {
+      int64_t last = clock.Now();
+      for (int j = 0; j < 200000; j++) {
+        const int64_t now = clock.Now();
+        // Resyncs adjust the rate from their own base, which may leave the
+        // clock a little behind what another calibration gave.
+        EXPECT_GE(now, last - GPR_NS_PER_US);
+        last = now;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
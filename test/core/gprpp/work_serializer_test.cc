@@ -18,6 +18,7 @@
 
 #include "src/core/lib/gprpp/work_serializer.h"
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -30,6 +31,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/experiments/config.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/notification.h"
 #include "src/core/lib/gprpp/thd.h"
@@ -235,11 +237,56 @@ TEST(WorkSerializerTest, WorkSerializerDestructionRaceMultipleThreads) {
   }
 }
 
+TEST(WorkSerializerTest, StatsCountCallbacks) {
+  grpc_core::WorkSerializer lock;
+  for (int i = 0; i < 10; ++i) lock.Schedule([]() {}, DEBUG_LOCATION);
+  lock.DrainQueue();
+  lock.Run([]() {}, DEBUG_LOCATION);
+  grpc_core::WorkSerializer::Stats stats = lock.stats();
+  EXPECT_EQ(stats.callbacks, 11u);
+  EXPECT_EQ(stats.drains, 2u);
+  EXPECT_EQ(stats.max_queue_depth, 10u);
+}
+
+// Tests that a long drain is handed to the EventEngine, still in order.
+TEST(WorkSerializerTest, LongDrainsAreOffloaded) {
+  std::atomic<uint64_t> observed_offloads{0};
+  grpc_core::WorkSerializer lock(
+      [&observed_offloads](const grpc_core::WorkSerializer::Stats& stats) {
+        observed_offloads.store(stats.offloads);
+      });
+  constexpr size_t kCallbacks = 1000;
+  size_t counter = 0;
+  std::thread::id last_thread;
+  grpc_core::Notification done;
+  for (size_t i = 0; i < kCallbacks; ++i) {
+    lock.Schedule(
+        [&, i]() {
+          EXPECT_EQ(counter, i);
+          ++counter;
+          if (counter == kCallbacks) {
+            last_thread = std::this_thread::get_id();
+            done.Notify();
+          }
+        },
+        DEBUG_LOCATION);
+  }
+  lock.DrainQueue();
+  done.WaitForNotification();
+  EXPECT_NE(last_thread, std::this_thread::get_id());
+  grpc_core::WorkSerializer::Stats stats = lock.stats();
+  EXPECT_EQ(stats.callbacks, kCallbacks);
+  EXPECT_GT(stats.offloads, 0u);
+  EXPECT_EQ(stats.drains, stats.offloads + 1);
+  EXPECT_EQ(observed_offloads.load(), stats.offloads);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::ForceEnableExperiment("work_serializer_offload", true);
   grpc_init();
   int retval = RUN_ALL_TESTS();
   grpc_shutdown();
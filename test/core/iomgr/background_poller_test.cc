@@ -0,0 +1,127 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Fds polled by a thread of the epoll1 engine's own (the
+// epoll1_background_poller experiment).
+
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "test/core/util/test_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_poll_strategy);
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class BackgroundPollerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    grpc_init();
+    skip_ = strcmp(grpc_get_poll_strategy_name(), "epoll1") != 0;
+  }
+
+  void TearDown() override { grpc_shutdown(); }
+
+  // Waits, without polling, for done to be set.
+  static bool WaitFor(const std::atomic<bool>& done) {
+    const Timestamp give_up = Timestamp::Now() + Duration::Seconds(10);
+    while (!done.load(std::memory_order_acquire) &&
+           Timestamp::Now() < give_up) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+      ExecCtx::Get()->InvalidateNow();
+    }
+    return done.load(std::memory_order_acquire);
+  }
+
+  bool skip_ = false;
+};
+
+TEST_F(BackgroundPollerTest, RunsInBackground) {
+  if (skip_) return;
+  // So that client channels and TCP writes start no backup poller.
+  EXPECT_TRUE(grpc_iomgr_run_in_background());
+  EXPECT_FALSE(grpc_iomgr_is_any_background_poller_thread());
+}
+
+TEST_F(BackgroundPollerTest, FdBecomesReadableWithoutPolling) {
+  if (skip_) return;
+  ExecCtx exec_ctx;
+  int sv[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+  grpc_fd* fd = grpc_fd_create(sv[0], "background_poller_test", false);
+  struct State {
+    std::atomic<bool> readable{false};
+    std::atomic<bool> on_background_poller{false};
+    std::atomic<bool> orphaned{false};
+  } state;
+  grpc_closure on_readable;
+  GRPC_CLOSURE_INIT(
+      &on_readable,
+      [](void* arg, grpc_error_handle error) {
+        auto* state = static_cast<State*>(arg);
+        EXPECT_TRUE(error.ok());
+        state->on_background_poller.store(
+            grpc_iomgr_is_any_background_poller_thread(),
+            std::memory_order_relaxed);
+        state->readable.store(true, std::memory_order_release);
+      },
+      &state, grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_readable);
+  ExecCtx::Get()->Flush();
+  ASSERT_EQ(write(sv[1], "x", 1), 1);
+  // Nobody but the background poller polls.
+  ASSERT_TRUE(WaitFor(state.readable));
+  EXPECT_TRUE(state.on_background_poller.load(std::memory_order_relaxed));
+  grpc_closure on_orphaned;
+  GRPC_CLOSURE_INIT(
+      &on_orphaned,
+      [](void* arg, grpc_error_handle) {
+        static_cast<State*>(arg)->orphaned.store(true,
+                                                 std::memory_order_release);
+      },
+      &state, grpc_schedule_on_exec_ctx);
+  grpc_fd_orphan(fd, &on_orphaned, nullptr, "test done");
+  ExecCtx::Get()->Flush();
+  EXPECT_TRUE(WaitFor(state.orphaned));
+  close(sv[1]);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "epoll1");
+  grpc_core::ForceEnableExperiment("epoll1_background_poller", true);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
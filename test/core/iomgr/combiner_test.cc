@@ -18,12 +18,15 @@
 
 #include "src/core/lib/iomgr/combiner.h"
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "test/core/util/test_config.h"
@@ -139,9 +142,60 @@ TEST(CombinerTest, TestExecuteFinally) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+typedef struct {
+  grpc_core::Combiner* lock;
+  grpc_closure second;
+  std::thread::id second_thread;
+  gpr_event done;
+} budget_args;
+
+static void record_thread(void* a, grpc_error_handle /*error*/) {
+  budget_args* args = static_cast<budget_args*>(a);
+  args->second_thread = std::this_thread::get_id();
+  gpr_event_set(&args->done, reinterpret_cast<void*>(1));
+}
+
+static void run_past_budget(void* a, grpc_error_handle /*error*/) {
+  budget_args* args = static_cast<budget_args*>(a);
+  args->lock->Run(
+      GRPC_CLOSURE_INIT(&args->second, record_thread, args, nullptr),
+      absl::OkStatus());
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+}
+
+TEST(CombinerTest, TestTimeBudgetOffloads) {
+  gpr_log(GPR_DEBUG, "test_time_budget_offloads");
+
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+  budget_args args;
+  args.lock = grpc_combiner_create();
+  gpr_event_init(&args.done);
+  grpc_core::ExecCtx exec_ctx;
+  args.lock->Run(GRPC_CLOSURE_CREATE(run_past_budget, &args, nullptr),
+                 absl::OkStatus());
+  grpc_core::ExecCtx::Get()->Flush();
+  ASSERT_NE(gpr_event_wait(&args.done, grpc_timeout_seconds_to_deadline(5)),
+            nullptr);
+  // The closure queued behind the one that ran past the budget was picked up
+  // by the executor.
+  EXPECT_NE(args.second_thread, std::this_thread::get_id());
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  EXPECT_GT(after.counters[GRPC_STATS_COUNTER_COMBINER_BUDGET_OFFLOADS],
+            before.counters[GRPC_STATS_COUNTER_COMBINER_BUDGET_OFFLOADS]);
+  EXPECT_GT(grpc_stats_histo_count(&after,
+                                   GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US),
+            grpc_stats_histo_count(&before,
+                                   GRPC_STATS_HISTOGRAM_COMBINER_HOLD_TIME_US));
+  GRPC_COMBINER_UNREF(args.lock, "test_time_budget_offloads");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_time_budget_us, 1000);
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_collect_stats, true);
   grpc::testing::TestGrpcScope grpc_scope;
   return RUN_ALL_TESTS();
 }
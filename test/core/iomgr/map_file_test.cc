@@ -0,0 +1,115 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/iomgr/map_file.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/slice.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/gpr/tmpfile.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+// A temporary file holding more than a page of distinct bytes, so that
+// regions start at offsets the mapping has to round down.
+class MapFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (size_t i = 0; i < 3 * 4096 + 100; ++i) {
+      contents_.push_back(static_cast<char>('a' + i % 26));
+    }
+    char* name;
+    FILE* file = gpr_tmpfile("map_file_test", &name);
+    ASSERT_NE(file, nullptr);
+    name_ = name;
+    gpr_free(name);
+    ASSERT_EQ(fwrite(contents_.data(), 1, contents_.size(), file),
+              contents_.size());
+    fclose(file);
+    fd_ = open(name_.c_str(), O_RDONLY);
+    ASSERT_GE(fd_, 0);
+  }
+
+  void TearDown() override {
+    if (fd_ >= 0) close(fd_);
+    remove(name_.c_str());
+  }
+
+  std::string contents_;
+  std::string name_;
+  int fd_ = -1;
+};
+
+TEST_F(MapFileTest, MapsRegions) {
+  for (uint64_t offset : {0, 1, 4095, 4096, 5000}) {
+    grpc_slice slice;
+    ASSERT_TRUE(grpc_map_file_region(fd_, offset, 6000, &slice).ok());
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(
+                              GRPC_SLICE_START_PTR(slice)),
+                          GRPC_SLICE_LENGTH(slice)),
+              contents_.substr(offset, 6000));
+    grpc_slice_unref(slice);
+  }
+}
+
+TEST_F(MapFileTest, OutlivesDescriptor) {
+  grpc_slice slice;
+  ASSERT_TRUE(grpc_map_file_region(fd_, 0, contents_.size(), &slice).ok());
+  close(fd_);
+  fd_ = -1;
+  grpc_slice copy = grpc_slice_ref(slice);
+  grpc_slice_unref(slice);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(
+                            GRPC_SLICE_START_PTR(copy)),
+                        GRPC_SLICE_LENGTH(copy)),
+            contents_);
+  grpc_slice_unref(copy);
+}
+
+TEST_F(MapFileTest, EmptyRegion) {
+  grpc_slice slice;
+  ASSERT_TRUE(grpc_map_file_region(fd_, contents_.size(), 0, &slice).ok());
+  EXPECT_EQ(GRPC_SLICE_LENGTH(slice), 0);
+  grpc_slice_unref(slice);
+}
+
+TEST_F(MapFileTest, RejectsRegionsPastTheEnd) {
+  grpc_slice slice;
+  EXPECT_FALSE(
+      grpc_map_file_region(fd_, 0, contents_.size() + 1, &slice).ok());
+  EXPECT_FALSE(
+      grpc_map_file_region(fd_, contents_.size() + 1, 0, &slice).ok());
+  EXPECT_FALSE(grpc_map_file_region(-1, 0, 1, &slice).ok());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  return RUN_ALL_TESTS();
+}
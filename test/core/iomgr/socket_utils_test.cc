@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
+#include <netinet/tcp.h>
 #include <string.h>
 
 #include <gtest/gtest.h>
@@ -163,6 +164,36 @@ TEST(SocketUtilsTest, MainTest) {
   close(sock);
 }
 
+#ifdef GPR_LINUX
+TEST(SocketUtilsTest, FastOpen) {
+  int sock = socket(PF_INET, SOCK_STREAM, 0);
+  ASSERT_GT(sock, 0);
+  ASSERT_TRUE(GRPC_LOG_IF_ERROR("set_socket_fastopen_connect",
+                                grpc_set_socket_fastopen_connect(sock)));
+  ASSERT_TRUE(GRPC_LOG_IF_ERROR("set_socket_fastopen",
+                                grpc_set_socket_fastopen(sock, 16)));
+  int queue_length = 0;
+  socklen_t intlen = sizeof(queue_length);
+  ASSERT_EQ(0, getsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN, &queue_length,
+                          &intlen));
+  EXPECT_EQ(16, queue_length);
+  close(sock);
+}
+
+TEST(SocketUtilsTest, NotsentLowat) {
+  int sock = socket(PF_INET, SOCK_STREAM, 0);
+  ASSERT_GT(sock, 0);
+  ASSERT_TRUE(GRPC_LOG_IF_ERROR("set_socket_notsent_lowat",
+                                grpc_set_socket_notsent_lowat(sock, 16384)));
+  int lowat = 0;
+  socklen_t intlen = sizeof(lowat);
+  ASSERT_EQ(0,
+            getsockopt(sock, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &lowat, &intlen));
+  EXPECT_EQ(16384, lowat);
+  close(sock);
+}
+#endif
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -171,6 +202,23 @@ int main(int argc, char** argv) {
 
 #else /* GRPC_POSIX_SOCKET_UTILS_COMMON */
 
+#ifdef GPR_LINUX
+TEST(SocketUtilsTest, FastOpen) {
+  int sock = socket(PF_INET, SOCK_STREAM, 0);
+  ASSERT_GT(sock, 0);
+  ASSERT_TRUE(GRPC_LOG_IF_ERROR("set_socket_fastopen_connect",
+                                grpc_set_socket_fastopen_connect(sock)));
+  ASSERT_TRUE(GRPC_LOG_IF_ERROR("set_socket_fastopen",
+                                grpc_set_socket_fastopen(sock, 16)));
+  int queue_length = 0;
+  socklen_t intlen = sizeof(queue_length);
+  ASSERT_EQ(0, getsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN, &queue_length,
+                          &intlen));
+  EXPECT_EQ(16, queue_length);
+  close(sock);
+}
+#endif
+
 int main(int argc, char** argv) { return 1; }
 
 #endif /* GRPC_POSIX_SOCKET_UTILS_COMMON */
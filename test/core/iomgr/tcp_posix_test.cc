@@ -44,6 +44,7 @@
 #include "src/core/lib/iomgr/sockaddr_posix.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/iomgr/endpoint_tests.h"
 #include "test/core/util/test_config.h"
@@ -277,7 +278,8 @@ static void read_test(size_t num_bytes, size_t slice_size,
 
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
    API. */
-static void large_read_test(size_t slice_size, int min_progress_size) {
+static void large_read_test(size_t slice_size, int min_progress_size,
+                            bool rx_zerocopy = false) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -286,11 +288,13 @@ static void large_read_test(size_t slice_size, int min_progress_size) {
       grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR, slice_size);
+  gpr_log(GPR_INFO,
+          "Start large read test, slice size %" PRIuPTR ", rx zerocopy %d",
+          slice_size, rx_zerocopy);
 
   create_sockets(sv);
 
-  grpc_arg a[2];
+  grpc_arg a[4];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER;
   a[0].value.integer = static_cast<int>(slice_size);
@@ -298,6 +302,13 @@ static void large_read_test(size_t slice_size, int min_progress_size) {
   a[1].type = GRPC_ARG_POINTER;
   a[1].value.pointer.p = grpc_resource_quota_create("test");
   a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  // Sockets that cannot map their receive queue must fall back to copying.
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = rx_zerocopy;
+  a[3].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_READ_BYTES_THRESHOLD);
+  a[3].type = GRPC_ARG_INTEGER;
+  a[3].value.integer = 0;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
   ep = grpc_tcp_create(
       grpc_fd_create(sv[1], "large_read_test", false),
@@ -620,6 +631,92 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
       static_cast<grpc_resource_quota*>(a[1].value.pointer.p));
 }
 
+static void pass_fds_read_cb(void* user_data, grpc_error_handle error) {
+  GPR_ASSERT(error.ok());
+  gpr_mu_lock(g_mu);
+  *static_cast<int*>(user_data) = 1;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Pass the write end of a pipe along with a write over a unix socket, and
+   check that the reader receives a working descriptor for it. */
+static void pass_fds_test(void) {
+  int sv[2];
+  int pipe_fds[2];
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "Start pass fds test");
+
+  create_sockets(sv);
+  GPR_ASSERT(pipe(pipe_fds) == 0);
+  auto options = TcpOptionsFromEndpointConfig(
+      grpc_event_engine::experimental::ChannelArgsEndpointConfig(
+          grpc_core::ChannelArgs()
+              .Set(GRPC_ARG_UDS_MEMFD_DATA_ENABLED, true)
+              .SetObject(grpc_core::ResourceQuota::Default())));
+  grpc_endpoint* writer = grpc_tcp_create(
+      grpc_fd_create(sv[0], "pass_fds:writer", false), options, "test");
+  grpc_endpoint* reader = grpc_tcp_create(
+      grpc_fd_create(sv[1], "pass_fds:reader", false), options, "test");
+  grpc_endpoint_add_to_pollset(writer, g_pollset);
+  grpc_endpoint_add_to_pollset(reader, g_pollset);
+  GPR_ASSERT(grpc_tcp_can_pass_fds(writer));
+  GPR_ASSERT(grpc_tcp_can_pass_fds(reader));
+  GPR_ASSERT(grpc_tcp_take_received_fd(reader) < 0);
+
+  grpc_tcp_queue_fd_for_write(writer, pipe_fds[1]);
+  grpc_slice_buffer outgoing;
+  grpc_slice_buffer_init(&outgoing);
+  grpc_slice_buffer_add(&outgoing, grpc_slice_from_static_string("x"));
+  int write_done = 0;
+  int read_done = 0;
+  grpc_closure write_closure;
+  grpc_closure read_closure;
+  GRPC_CLOSURE_INIT(&write_closure, pass_fds_read_cb, &write_done,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&read_closure, pass_fds_read_cb, &read_done,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(writer, &outgoing, &write_closure, nullptr,
+                      /*max_frame_size=*/INT_MAX);
+  grpc_slice_buffer incoming;
+  grpc_slice_buffer_init(&incoming);
+  grpc_endpoint_read(reader, &incoming, &read_closure, /*urgent=*/false,
+                     /*min_progress_size=*/1);
+  exec_ctx.Flush();
+  gpr_mu_lock(g_mu);
+  while (!write_done || !read_done) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    exec_ctx.Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(incoming.length == 1);
+
+  /* The writer closed its copy once sent, so the pipe only stays open through
+     the one received. */
+  int fd = grpc_tcp_take_received_fd(reader);
+  GPR_ASSERT(fd >= 0);
+  GPR_ASSERT(grpc_tcp_take_received_fd(reader) < 0);
+  GPR_ASSERT(write(fd, "y", 1) == 1);
+  close(fd);
+  char c;
+  GPR_ASSERT(read(pipe_fds[0], &c, 1) == 1 && c == 'y');
+  GPR_ASSERT(read(pipe_fds[0], &c, 1) == 0);
+  close(pipe_fds[0]);
+
+  grpc_slice_buffer_destroy(&outgoing);
+  grpc_slice_buffer_destroy(&incoming);
+  grpc_endpoint_destroy(writer);
+  grpc_endpoint_destroy(reader);
+}
+
 void run_tests(void) {
   size_t i = 0;
   for (int i = 1; i <= 8192; i = i * 2) {
@@ -630,6 +727,8 @@ void run_tests(void) {
     large_read_test(8192, i);
     large_read_test(1, i);
   }
+  large_read_test(8192, 1, /*rx_zerocopy=*/true);
+  large_read_test(8192, 8192, /*rx_zerocopy=*/true);
   write_test(100, 8192, false);
   write_test(100, 1, false);
   write_test(100000, 8192, false);
@@ -648,6 +747,7 @@ void run_tests(void) {
   }
 
   release_fd_test(100, 8192);
+  pass_fds_test();
 }
 
 static void clean_up(void) {}
@@ -0,0 +1,132 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/iomgr/tcp_zerocopy_threshold.h"
+
+#include "gtest/gtest.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Controller = TcpZerocopyThresholdController;
+
+// Feeds the controller one decision interval worth of sends and completions
+// at the given costs per byte.
+bool RunInterval(Controller* controller, int64_t copy_ns_per_byte,
+                 int64_t zerocopy_ns_per_byte, bool copied = false) {
+  const size_t bytes = controller->threshold();
+  bool changed = false;
+  for (uint32_t i = 0; i < Controller::kMinCopyProbesPerDecision; i++) {
+    controller->RecordCopySend(bytes, bytes * copy_ns_per_byte);
+  }
+  for (uint32_t i = 0; i < Controller::kCompletionsPerDecision; i++) {
+    controller->RecordZerocopySend(bytes, bytes * zerocopy_ns_per_byte);
+    changed |= controller->RecordCompletion(1000, copied);
+  }
+  return changed;
+}
+
+TEST(TcpZerocopyThresholdTest, InitialThresholdIsClamped) {
+  EXPECT_EQ(Controller(1).threshold(), size_t{Controller::kMinThreshold});
+  EXPECT_EQ(Controller(64 * 1024).threshold(), 64 * 1024);
+  EXPECT_EQ(Controller(1024 * 1024 * 1024).threshold(),
+            size_t{Controller::kMaxThreshold});
+}
+
+TEST(TcpZerocopyThresholdTest, ProbesBothSidesOfTheThreshold) {
+  Controller controller(64 * 1024);
+  int zerocopy_above = 0;
+  int zerocopy_below = 0;
+  const int kSends = 16 * Controller::kProbeInterval;
+  for (int i = 0; i < kSends; i++) {
+    zerocopy_above += controller.ShouldZerocopy(64 * 1024);
+  }
+  for (int i = 0; i < kSends; i++) {
+    zerocopy_below += controller.ShouldZerocopy(48 * 1024);
+  }
+  EXPECT_EQ(zerocopy_above, kSends - kSends / Controller::kProbeInterval);
+  EXPECT_EQ(zerocopy_below, kSends / Controller::kProbeInterval);
+  for (int i = 0; i < kSends; i++) {
+    EXPECT_FALSE(controller.ShouldZerocopy(16 * 1024));
+  }
+}
+
+TEST(TcpZerocopyThresholdTest, WaitsForEnoughSamples) {
+  Controller controller(64 * 1024);
+  for (uint32_t i = 0; i < 4 * Controller::kCompletionsPerDecision; i++) {
+    controller.RecordZerocopySend(64 * 1024, 1);
+    EXPECT_FALSE(controller.RecordCompletion(1000, false));
+  }
+  EXPECT_EQ(controller.threshold(), 64 * 1024);
+  EXPECT_TRUE(controller.LastDecision().empty());
+}
+
+TEST(TcpZerocopyThresholdTest, LowersThresholdWhenZerocopyIsCheaper) {
+  Controller controller(64 * 1024);
+  EXPECT_TRUE(RunInterval(&controller, 4, 1));
+  EXPECT_EQ(controller.threshold(), 32 * 1024);
+  EXPECT_FALSE(controller.LastDecision().empty());
+  while (RunInterval(&controller, 4, 1)) {
+  }
+  EXPECT_EQ(controller.threshold(), size_t{Controller::kMinThreshold});
+}
+
+TEST(TcpZerocopyThresholdTest, RaisesThresholdWhenZerocopyIsNotCheaper) {
+  Controller controller(64 * 1024);
+  EXPECT_TRUE(RunInterval(&controller, 1, 1));
+  EXPECT_EQ(controller.threshold(), 128 * 1024);
+  while (RunInterval(&controller, 1, 2)) {
+  }
+  EXPECT_EQ(controller.threshold(), size_t{Controller::kMaxThreshold});
+}
+
+TEST(TcpZerocopyThresholdTest, HoldsThresholdWhenCostsAreClose) {
+  Controller controller(64 * 1024);
+  EXPECT_FALSE(RunInterval(&controller, 3, 2));
+  EXPECT_EQ(controller.threshold(), 64 * 1024);
+}
+
+TEST(TcpZerocopyThresholdTest, RaisesThresholdWhenKernelCopies) {
+  Controller controller(64 * 1024);
+  EXPECT_TRUE(RunInterval(&controller, 4, 1, /*copied=*/true));
+  EXPECT_EQ(controller.threshold(), 128 * 1024);
+}
+
+TEST(TcpZerocopyThresholdTest, RaisesThresholdWhenSendRecordsRunOut) {
+  Controller controller(64 * 1024);
+  controller.RecordSendRecordsExhausted();
+  EXPECT_TRUE(RunInterval(&controller, 4, 1));
+  EXPECT_EQ(controller.threshold(), 128 * 1024);
+  // The next interval starts from scratch.
+  EXPECT_TRUE(RunInterval(&controller, 4, 1));
+  EXPECT_EQ(controller.threshold(), 64 * 1024);
+}
+
+TEST(TcpZerocopyThresholdTest, ErrqueueTimeCountsAgainstZerocopy) {
+  Controller controller(64 * 1024);
+  controller.RecordErrqueueTime(
+      int64_t{4} * 64 * 1024 * Controller::kCompletionsPerDecision);
+  EXPECT_TRUE(RunInterval(&controller, 4, 1));
+  EXPECT_EQ(controller.threshold(), 128 * 1024);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Timers run by the epoll1 poller itself (the timerfd_timers experiment).
+
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "test/core/util/test_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_poll_strategy);
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class TimerfdTimersTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    grpc_init();
+    skip_ = strcmp(grpc_get_poll_strategy_name(), "epoll1") != 0;
+  }
+
+  void TearDown() override { grpc_shutdown(); }
+
+  // Arms a timer that records the thread it runs on.
+  void StartTimer(Duration timeout) {
+    GRPC_CLOSURE_INIT(
+        &on_timer_,
+        [](void* arg, grpc_error_handle error) {
+          auto* self = static_cast<TimerfdTimersTest*>(arg);
+          EXPECT_TRUE(error.ok());
+          self->timer_thread_ = std::this_thread::get_id();
+          self->fired_.store(true, std::memory_order_release);
+        },
+        this, grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&timer_, Timestamp::Now() + timeout, &on_timer_);
+  }
+
+  bool skip_ = false;
+  grpc_timer timer_;
+  grpc_closure on_timer_;
+  std::thread::id timer_thread_;
+  std::atomic<bool> fired_{false};
+};
+
+TEST_F(TimerfdTimersTest, PollerRunsTimers) {
+  if (skip_) return;
+  ExecCtx exec_ctx;
+  grpc_pollset* pollset =
+      static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  gpr_mu* mu;
+  grpc_pollset_init(pollset, &mu);
+  // Starts the timer once this thread is the designated poller, so that the
+  // timer threads leave it to the poller.
+  std::thread starter([this]() {
+    ExecCtx exec_ctx;
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(200));
+    StartTimer(Duration::Milliseconds(100));
+  });
+  const Timestamp give_up = Timestamp::Now() + Duration::Seconds(10);
+  while (!fired_.load(std::memory_order_acquire) &&
+         Timestamp::Now() < give_up) {
+    gpr_mu_lock(mu);
+    // Polls for longer than the timer takes, so the timer threads would be
+    // the ones running it unless the poller does.
+    GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(pollset, nullptr,
+                          Timestamp::Now() + Duration::Seconds(1)));
+    gpr_mu_unlock(mu);
+    ExecCtx::Get()->Flush();
+  }
+  starter.join();
+  ASSERT_TRUE(fired_.load(std::memory_order_acquire));
+  EXPECT_EQ(timer_thread_, std::this_thread::get_id());
+  grpc_closure destroyed;
+  GRPC_CLOSURE_INIT(
+      &destroyed,
+      [](void* arg, grpc_error_handle) {
+        grpc_pollset_destroy(static_cast<grpc_pollset*>(arg));
+        gpr_free(arg);
+      },
+      pollset, grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(mu);
+  grpc_pollset_shutdown(pollset, &destroyed);
+  gpr_mu_unlock(mu);
+}
+
+TEST_F(TimerfdTimersTest, TimerThreadsRunTimersWithoutPollers) {
+  if (skip_) return;
+  ExecCtx exec_ctx;
+  StartTimer(Duration::Milliseconds(100));
+  const Timestamp give_up = Timestamp::Now() + Duration::Seconds(10);
+  while (!fired_.load(std::memory_order_acquire) &&
+         Timestamp::Now() < give_up) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+    ExecCtx::Get()->InvalidateNow();
+  }
+  ASSERT_TRUE(fired_.load(std::memory_order_acquire));
+  EXPECT_NE(timer_thread_, std::this_thread::get_id());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "epoll1");
+  grpc_core::ForceEnableExperiment("timerfd_timers", true);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
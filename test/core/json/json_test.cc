@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -240,6 +241,28 @@ TEST(Json, EmbeddedInvalidWhitechars) {
   RunParseFailureTest("\"\t\"");
 }
 
+TEST(Json, CharactersThatEndPlainRunsInLongStrings) {
+  // Plain characters in strings are read many at a time: put the ones that
+  // need more care at each offset of the first few words.
+  for (size_t length = 0; length < 20; ++length) {
+    const std::string plain(length, 'x');
+    const std::string escaped_quote =
+        absl::StrCat("\"", plain, "\\\"", plain, "\"");
+    RunSuccessTest(escaped_quote.c_str(), absl::StrCat(plain, "\"", plain),
+                   escaped_quote.c_str());
+    const std::string utf8_key =
+        absl::StrCat("{\"", plain, "\xc3\xa9", plain, "\":0}");
+    const std::string utf8_key_output =
+        absl::StrCat("{\"", plain, "\\u00e9", plain, "\":0}");
+    RunSuccessTest(utf8_key.c_str(),
+                   Json::Object{{absl::StrCat(plain, "\xc3\xa9", plain), 0}},
+                   utf8_key_output.c_str());
+    RunParseFailureTest(absl::StrCat("\"", plain, "\n", plain, "\"").c_str());
+    RunParseFailureTest(absl::StrCat("\"", plain, "\xc3", plain, "\"").c_str());
+    RunParseFailureTest(absl::StrCat("\"", plain).c_str());
+  }
+}
+
 TEST(Json, EmptyString) { RunParseFailureTest(""); }
 
 TEST(Json, ExtraCharsAtEndOfParsing) {
@@ -30,6 +30,7 @@
 #include "absl/strings/string_view.h"
 
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/support/channel_arguments.h>
@@ -45,6 +46,10 @@ ABSL_FLAG(std::string, target, "", "Target host:port");
 ABSL_FLAG(bool, secure, false, "Use SSL Credentials");
 ABSL_FLAG(int, server_pid, 99999, "Server's pid");
 ABSL_FLAG(int, size, 50, "Number of channels");
+ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, idle_hibernation_ms, 0,
+          "Hibernate connections idle for this long, and measure memory once "
+          "they have, 0 for never");
 
 std::shared_ptr<grpc::Channel> CreateChannelForTest(int index) {
   // Set the authentication mechanism.
@@ -62,6 +67,13 @@ std::shared_ptr<grpc::Channel> CreateChannelForTest(int index) {
   // Arg to bypass mechanism that combines channels on the serverside if they
   // have the same channel args. Allows for one channel per connection
   channel_args.SetInt("grpc.memory_usage_counter", index);
+  if (absl::GetFlag(FLAGS_minstack)) {
+    channel_args.SetInt(GRPC_ARG_MINIMAL_STACK, 1);
+  }
+  if (absl::GetFlag(FLAGS_idle_hibernation_ms) > 0) {
+    channel_args.SetInt(GRPC_ARG_IDLE_HIBERNATION_MS,
+                        absl::GetFlag(FLAGS_idle_hibernation_ms));
+  }
 
   // Create a channel to the server and a stub
   std::shared_ptr<grpc::Channel> channel =
@@ -148,6 +160,14 @@ int main(int argc, char** argv) {
     UnaryCall(channel)->done.WaitForNotification();
   }
 
+  // Give the connections, now idle, time to hibernate
+  if (absl::GetFlag(FLAGS_idle_hibernation_ms) > 0) {
+    gpr_sleep_until(gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_millis(2 * absl::GetFlag(FLAGS_idle_hibernation_ms),
+                             GPR_TIMESPAN)));
+  }
+
   // Getting peak memory usage
   long peak_server_memory = GetMemUsage(absl::GetFlag(FLAGS_server_pid));
   long peak_client_memory = GetMemUsage();
@@ -28,6 +28,7 @@
 
 #include <grpc/support/log.h>
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/resource_quota.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/support/server_callback.h>
 #include <grpcpp/support/status.h>
@@ -72,6 +73,11 @@ static void sigint_handler(int /*x*/) { _exit(0); }
 
 ABSL_FLAG(std::string, bind, "", "Bind host:port");
 ABSL_FLAG(bool, secure, false, "Use SSL Credentials");
+ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, resource_quota_size, 0,
+          "Size of the server's resource quota in bytes, 0 for unlimited");
+ABSL_FLAG(int, idle_hibernation_ms, 0,
+          "Hibernate connections idle for this long, 0 for never");
 
 int main(int argc, char** argv) {
   absl::ParseCommandLine(argc, argv);
@@ -102,6 +108,20 @@ int main(int argc, char** argv) {
   }
   builder.AddListeningPort(server_address, creds);
   builder.RegisterService(&callback_server);
+  if (absl::GetFlag(FLAGS_minstack)) {
+    builder.AddChannelArgument(GRPC_ARG_MINIMAL_STACK, 1);
+  }
+  // Under a small quota, the server's connections are shrunk by the
+  // reclamation passes, and the memory per channel measured is what is left.
+  if (absl::GetFlag(FLAGS_resource_quota_size) > 0) {
+    grpc::ResourceQuota resource_quota("memory_usage_callback_server");
+    resource_quota.Resize(absl::GetFlag(FLAGS_resource_quota_size));
+    builder.SetResourceQuota(resource_quota);
+  }
+  if (absl::GetFlag(FLAGS_idle_hibernation_ms) > 0) {
+    builder.AddChannelArgument(GRPC_ARG_IDLE_HIBERNATION_MS,
+                               absl::GetFlag(FLAGS_idle_hibernation_ms));
+  }
 
   // Set up the server to start accepting requests.
   std::shared_ptr<grpc::Server> server(builder.BuildAndStart());
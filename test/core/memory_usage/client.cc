@@ -223,6 +223,8 @@ ABSL_FLAG(std::string, target, "localhost:443", "Target host:port");
 ABSL_FLAG(int, warmup, 100, "Warmup iterations");
 ABSL_FLAG(int, benchmark, 1000, "Benchmark iterations");
 ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, idle_hibernation_ms, 0,
+          "Hibernate connections idle for this long, 0 for never");
 
 int main(int argc, char** argv) {
   absl::ParseCommandLine(argc, argv);
@@ -247,6 +249,11 @@ int main(int argc, char** argv) {
     args_vec.push_back(grpc_channel_arg_integer_create(
         const_cast<char*>(GRPC_ARG_MINIMAL_STACK), 1));
   }
+  if (absl::GetFlag(FLAGS_idle_hibernation_ms) > 0) {
+    args_vec.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_IDLE_HIBERNATION_MS),
+        absl::GetFlag(FLAGS_idle_hibernation_ms)));
+  }
   grpc_channel_args args = {args_vec.size(), args_vec.data()};
 
   channel = grpc_channel_create(absl::GetFlag(FLAGS_target).c_str(),
@@ -47,7 +47,7 @@ ABSL_FLAG(std::string, benchmark_names, "call,channel",
 ABSL_FLAG(int, size, 1000, "Number of channels/calls");
 ABSL_FLAG(std::string, scenario_config, "insecure",
           "Possible Values: minstack (Use minimal stack), resource_quota, "
-          "secure (Use SSL credentials on server)");
+          "idle_hibernation, secure (Use SSL credentials on server)");
 ABSL_FLAG(bool, memory_profiling, false,
           "Run memory profiling");  // TODO (chennancy) Connect this flag
 
@@ -108,8 +108,9 @@ int RunCallBenchmark(char* root, std::vector<std::string> server_scenario_flags,
 }
 
 /* Per-channel benchmark*/
-int RunChannelBenchmark(char* root) {
-  // TODO(chennancy) Add the scenario specific flags
+int RunChannelBenchmark(char* root,
+                        std::vector<std::string> server_scenario_flags,
+                        std::vector<std::string> client_scenario_flags) {
   int status;
   int port = grpc_pick_unused_port_or_die();
 
@@ -118,6 +119,8 @@ int RunChannelBenchmark(char* root) {
       absl::StrCat(root, "/memory_usage_callback_server",
                    gpr_subprocess_binary_extension()),
       "--bind", grpc_core::JoinHostPort("::", port)};
+  // Add scenario-specific server flags to the end of the server_flags
+  absl::c_move(server_scenario_flags, std::back_inserter(server_flags));
   Subprocess svr(server_flags);
 
   // Wait one second before starting client to avoid possible race condition
@@ -133,6 +136,8 @@ int RunChannelBenchmark(char* root) {
       "--nosecure",
       absl::StrCat("--server_pid=", svr.GetPID()),
       absl::StrCat("--size=", absl::GetFlag(FLAGS_size))};
+  // Add scenario-specific client flags to the end of the client_flags
+  absl::c_move(client_scenario_flags, std::back_inserter(client_flags));
   Subprocess cli(client_flags);
   /* wait for completion */
   if ((status = cli.Join()) != 0) {
@@ -149,7 +154,8 @@ int RunBenchmark(char* root, absl::string_view benchmark,
   if (benchmark == "call") {
     return RunCallBenchmark(root, server_scenario_flags, client_scenario_flags);
   } else if (benchmark == "channel") {
-    return RunChannelBenchmark(root);
+    return RunChannelBenchmark(root, server_scenario_flags,
+                               client_scenario_flags);
   } else {
     gpr_log(GPR_INFO, "Not a valid benchmark name");
     return 4;
@@ -177,11 +183,17 @@ int main(int argc, char** argv) {
     std::vector<std::string> client;
     std::vector<std::string> server;
   };
-  // TODO(chennancy): add in resource quota parameter setting later
+  // The resource_quota scenario puts the server under memory pressure
+  // (1000 connections get 32KB each), so that its reclaimers run.
   const std::map<std::string /*scenario*/, ScenarioArgs> scenarios = {
       {"secure", {/*client=*/{}, /*server=*/{"--secure"}}},
-      {"resource_quota", {/*client=*/{}, /*server=*/{"--secure"}}},
+      {"resource_quota",
+       {/*client=*/{},
+        /*server=*/{"--secure", "--resource_quota_size=33554432"}}},
       {"minstack", {/*client=*/{"--minstack"}, /*server=*/{"--minstack"}}},
+      {"idle_hibernation",
+       {/*client=*/{"--idle_hibernation_ms=1000"},
+        /*server=*/{"--idle_hibernation_ms=1000"}}},
       {"insecure", {{}, {}}},
   };
   auto it_scenario = scenarios.find(absl::GetFlag(FLAGS_scenario_config));
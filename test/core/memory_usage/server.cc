@@ -161,6 +161,10 @@ static void sigint_handler(int /*x*/) { _exit(0); }
 ABSL_FLAG(std::string, bind, "", "Bind host:port");
 ABSL_FLAG(bool, secure, false, "Use security");
 ABSL_FLAG(bool, minstack, false, "Use minimal stack");
+ABSL_FLAG(int, idle_hibernation_ms, 0,
+          "Hibernate connections idle for this long, 0 for never");
+ABSL_FLAG(int, resource_quota_size, 0,
+          "Size of the server's resource quota in bytes, 0 for unlimited");
 
 int main(int argc, char** argv) {
   absl::ParseCommandLine(argc, argv);
@@ -192,6 +196,20 @@ int main(int argc, char** argv) {
     args_vec.push_back(grpc_channel_arg_integer_create(
         const_cast<char*>(GRPC_ARG_MINIMAL_STACK), 1));
   }
+  if (absl::GetFlag(FLAGS_idle_hibernation_ms) > 0) {
+    args_vec.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_IDLE_HIBERNATION_MS),
+        absl::GetFlag(FLAGS_idle_hibernation_ms)));
+  }
+  grpc_resource_quota* resource_quota = nullptr;
+  if (absl::GetFlag(FLAGS_resource_quota_size) > 0) {
+    resource_quota = grpc_resource_quota_create("memory_usage_server");
+    grpc_resource_quota_resize(resource_quota,
+                               absl::GetFlag(FLAGS_resource_quota_size));
+    args_vec.push_back(grpc_channel_arg_pointer_create(
+        const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), resource_quota,
+        grpc_resource_quota_arg_vtable()));
+  }
   grpc_channel_args args = {args_vec.size(), args_vec.data()};
 
   MemStats before_server_create = MemStats::Snapshot();
@@ -208,6 +226,7 @@ int main(int argc, char** argv) {
     GPR_ASSERT(grpc_server_add_http2_port(
         server, addr.c_str(), grpc_insecure_server_credentials_create()));
   }
+  if (resource_quota != nullptr) grpc_resource_quota_unref(resource_quota);
 
   grpc_server_register_completion_queue(server, cq, nullptr);
   grpc_server_start(server);
@@ -34,6 +34,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -100,6 +101,35 @@ INSTANTIATE_TEST_SUITE_P(
                       AllocShape{1, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}},
                       AllocShape{6, {1, 2, 3}}));
 
+TEST(ArenaTest, RecycledArenasAreUsable) {
+  ExecCtx exec_ctx;
+  std::vector<Arena*> arenas;
+  for (size_t initial_size : {1, 1000, 4096, 10000, 100000}) {
+    for (int i = 0; i < 3; i++) {
+      auto arena_and_alloc = Arena::CreateWithAlloc(
+          std::max<size_t>(initial_size, 32), 32, g_memory_allocator);
+      memset(arena_and_alloc.second, 1, 32);
+      memset(arena_and_alloc.first->Alloc(initial_size), 2, initial_size);
+      arena_and_alloc.first->Destroy();
+    }
+    arenas.push_back(Arena::Create(initial_size, g_memory_allocator));
+    memset(arenas.back()->Alloc(initial_size), 3, initial_size);
+  }
+  for (Arena* arena : arenas) arena->Destroy();
+}
+
+TEST(ArenaTest, SteadyStateReusesArenaBlock) {
+  if (!grpc_core::IsArenaBlockCacheEnabled()) {
+    GTEST_SKIP() << "arena_block_cache experiment is disabled";
+  }
+  ExecCtx exec_ctx;
+  Arena* first = Arena::Create(2000, g_memory_allocator);
+  first->Destroy();
+  Arena* second = Arena::Create(2000, g_memory_allocator);
+  EXPECT_EQ(first, second);
+  second->Destroy();
+}
+
 #define CONCURRENT_TEST_THREADS 10
 
 size_t concurrent_test_iterations() {
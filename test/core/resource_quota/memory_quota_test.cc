@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <random>
 #include <thread>
 #include <vector>
@@ -169,6 +170,31 @@ TEST(MemoryQuotaTest, NoBunchingIfIdle) {
   EXPECT_GE(count_reclaimers_called.load(std::memory_order_relaxed), 8000);
 }
 
+TEST(MemoryQuotaTest, TakeAndReturnAreFullyAccounted) {
+  ExecCtx exec_ctx;
+  constexpr size_t kQuotaSize = 64 * 1024 * 1024;
+  constexpr size_t kTakes = 1000;
+  auto memory_quota = std::make_shared<BasicMemoryQuota>("foo");
+  memory_quota->SetSize(kQuotaSize);
+  for (size_t i = 0; i < kTakes; i++) memory_quota->Take(4096);
+  // Bytes cached per CPU may only make pressure appear higher.
+  EXPECT_GE(memory_quota->GetPressureInfo().instantaneous_pressure,
+            static_cast<double>(kTakes * 4096) / kQuotaSize);
+  for (size_t i = 0; i < kTakes; i++) memory_quota->Return(4096);
+  // Resizing reconciles any cached bytes with the quota.
+  memory_quota->SetSize(kQuotaSize);
+  EXPECT_EQ(memory_quota->GetPressureInfo().instantaneous_pressure, 0.0);
+}
+
+TEST(MemoryQuotaTest, SmallTakesStillReachOvercommit) {
+  ExecCtx exec_ctx;
+  constexpr size_t kQuotaSize = 1024 * 1024;
+  auto memory_quota = std::make_shared<BasicMemoryQuota>("foo");
+  memory_quota->SetSize(kQuotaSize);
+  for (size_t i = 0; i <= kQuotaSize / 4096; i++) memory_quota->Take(4096);
+  EXPECT_EQ(memory_quota->GetPressureInfo().instantaneous_pressure, 1.0);
+}
+
 }  // namespace testing
 
 namespace memory_quota_detail {
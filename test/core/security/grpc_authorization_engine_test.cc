@@ -19,8 +19,25 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
+namespace {
+
+std::unique_ptr<Rbac::Permission> MakePathPermission(absl::string_view path) {
+  return absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kExact, path).value()));
+}
+
+Rbac::Principal MakeAuthenticatedPrincipal(absl::string_view name) {
+  return Rbac::Principal::MakeAuthenticatedPrincipal(
+      StringMatcher::Create(StringMatcher::Type::kExact, name).value());
+}
+
+}  // namespace
+
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
   Rbac::Policy policy1(
       Rbac::Permission::MakeNotPermission(
@@ -103,9 +120,102 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+TEST(GrpcAuthorizationEngineTest, PathIndexedPoliciesKeepPolicyOrder) {
+  std::map<std::string, Rbac::Policy> policies;
+  std::vector<std::unique_ptr<Rbac::Permission>> paths;
+  paths.push_back(MakePathPermission("/pkg.Service/Foo"));
+  paths.push_back(MakePathPermission("/pkg.Service/Bar"));
+  policies["policy1"] =
+      Rbac::Policy(Rbac::Permission::MakeOrPermission(std::move(paths)),
+                   Rbac::Principal::MakeAnyPrincipal());
+  policies["policy2"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeNotPrincipal(Rbac::Principal::MakeAnyPrincipal()));
+  policies["policy3"] = Rbac::Policy(std::move(*MakePathPermission("/baz")),
+                                     Rbac::Principal::MakeAnyPrincipal());
+  policies["policy4"] = Rbac::Policy(
+      Rbac::Permission::MakeNotPermission(
+          std::move(*MakePathPermission("/pkg.Service/Foo"))),
+      Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  struct {
+    const char* path;
+    const char* matching_policy_name;
+  } cases[] = {
+      {"/pkg.Service/Foo", "policy1"},
+      {"/pkg.Service/Bar", "policy1"},
+      {"/baz", "policy3"},
+      {"/other", "policy4"},
+  };
+  for (const auto& c : cases) {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", c.path);
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.matching_policy_name, c.matching_policy_name)
+        << c.path;
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, PerChannelPrincipalsCachedPerEngine) {
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_SSL_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME, "spiffe://foo");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  std::map<std::string, Rbac::Policy> foo_policies;
+  foo_policies["foo"] =
+      Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                   MakeAuthenticatedPrincipal("spiffe://foo"));
+  GrpcAuthorizationEngine foo_engine(
+      Rbac(Rbac::Action::kAllow, std::move(foo_policies)));
+  std::map<std::string, Rbac::Policy> bar_policies;
+  bar_policies["bar"] =
+      Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                   MakeAuthenticatedPrincipal("spiffe://bar"));
+  GrpcAuthorizationEngine bar_engine(
+      Rbac(Rbac::Action::kAllow, std::move(bar_policies)));
+  // Both engines share the connection's cache, and each keeps getting its
+  // own results from it.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(foo_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(bar_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kDeny);
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, DecisionsDependOnlyOnPath) {
+  EXPECT_TRUE(
+      GrpcAuthorizationEngine(Rbac::Action::kAllow).DecisionsDependOnlyOnPath());
+  std::map<std::string, Rbac::Policy> policies;
+  policies["path"] = Rbac::Policy(std::move(*MakePathPermission("/foo")),
+                                  MakeAuthenticatedPrincipal("spiffe://foo"));
+  GrpcAuthorizationEngine path_engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EXPECT_TRUE(path_engine.DecisionsDependOnlyOnPath());
+  policies.clear();
+  std::vector<std::unique_ptr<Rbac::Principal>> principals;
+  principals.push_back(absl::make_unique<Rbac::Principal>(
+      Rbac::Principal::MakeHeaderPrincipal(
+          HeaderMatcher::Create("key", HeaderMatcher::Type::kExact, "value")
+              .value())));
+  policies["header"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeNotPrincipal(
+          Rbac::Principal::MakeOrPrincipal(std::move(principals))));
+  GrpcAuthorizationEngine header_engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EXPECT_FALSE(header_engine.DecisionsDependOnlyOnPath());
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
 }
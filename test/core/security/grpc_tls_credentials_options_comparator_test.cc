@@ -161,6 +161,26 @@ TEST(TlsCredentialsOptionsComparatorTest, DifferentCrlDirectory) {
   delete options_1;
   delete options_2;
 }
+TEST(TlsCredentialsOptionsComparatorTest, DifferentSessionTicketKeys) {
+  auto* options_1 = grpc_tls_credentials_options_create();
+  auto* options_2 = grpc_tls_credentials_options_create();
+  options_1->set_session_ticket_keys(MakeRefCounted<tsi::SslSessionTicketKeys>());
+  options_2->set_session_ticket_keys(MakeRefCounted<tsi::SslSessionTicketKeys>());
+  EXPECT_FALSE(*options_1 == *options_2);
+  EXPECT_FALSE(*options_2 == *options_1);
+  delete options_1;
+  delete options_2;
+}
+TEST(TlsCredentialsOptionsComparatorTest, DifferentPrivateKeySigner) {
+  auto* options_1 = grpc_tls_credentials_options_create();
+  auto* options_2 = grpc_tls_credentials_options_create();
+  options_1->set_private_key_signer(MakeRefCounted<tsi::ExternalSslPrivateKeySigner>(grpc_tls_private_key_signer_external{}));
+  options_2->set_private_key_signer(MakeRefCounted<tsi::ExternalSslPrivateKeySigner>(grpc_tls_private_key_signer_external{}));
+  EXPECT_FALSE(*options_1 == *options_2);
+  EXPECT_FALSE(*options_2 == *options_1);
+  delete options_1;
+  delete options_2;
+}
 
 } // namespace
 } // namespace grpc_core
@@ -0,0 +1,94 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/security/transport/handshake_thread_pool.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(HandshakeThreadPoolTest, RunsCallbacksWithExecCtx) {
+  HandshakeThreadPool pool(2, 10);
+  std::atomic<int> runs{0};
+  Notification done;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(pool.Run(
+        [&runs, &done]() {
+          EXPECT_NE(ExecCtx::Get(), nullptr);
+          if (runs.fetch_add(1) == 9) done.Notify();
+        },
+        /*new_handshake=*/true));
+  }
+  done.WaitForNotification();
+  EXPECT_EQ(runs.load(), 10);
+}
+
+TEST(HandshakeThreadPoolTest, RejectsNewHandshakesWhenBackedUp) {
+  HandshakeThreadPool pool(1, 2);
+  // Keeps the only thread busy, so that the next callbacks stay queued.
+  Notification started;
+  Notification release;
+  ASSERT_TRUE(pool.Run(
+      [&started, &release]() {
+        started.Notify();
+        release.WaitForNotification();
+      },
+      /*new_handshake=*/true));
+  started.WaitForNotification();
+  std::atomic<int> runs{0};
+  auto callback = [&runs]() { runs.fetch_add(1); };
+  EXPECT_TRUE(pool.Run(callback, /*new_handshake=*/true));
+  EXPECT_TRUE(pool.Run(callback, /*new_handshake=*/true));
+  EXPECT_FALSE(pool.Run(callback, /*new_handshake=*/true));
+  // Handshakes already admitted are still queued.
+  EXPECT_TRUE(pool.Run(callback, /*new_handshake=*/false));
+  release.Notify();
+}
+
+TEST(HandshakeThreadPoolTest, RunsQueuedCallbacksBeforeShuttingDown) {
+  std::atomic<int> runs{0};
+  {
+    HandshakeThreadPool pool(1, 100);
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_TRUE(
+          pool.Run([&runs]() { runs.fetch_add(1); }, /*new_handshake=*/true));
+    }
+  }
+  EXPECT_EQ(runs.load(), 100);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -128,6 +128,44 @@ TEST(StringMatcherTest, ContainsMatchCaseInSensitive) {
   EXPECT_FALSE(string_matcher->Match("Test-Containz"));
 }
 
+TEST(StringMatcherSetTest, MatchesSameAsEachMatcher) {
+  std::vector<StringMatcher> matchers;
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kSafeRegex, "/pkg\\..*")
+          .value());
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kPrefix, "/pkg.").value());
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kSafeRegex, ".*/Method")
+          .value());
+  matchers.push_back(StringMatcher::Create(StringMatcher::Type::kContains,
+                                           "service", false)
+                         .value());
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kSafeRegex, "Method").value());
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kSafeRegex, "/pkg.*").value());
+  std::vector<const StringMatcher*> matcher_ptrs;
+  for (const StringMatcher& matcher : matchers) {
+    matcher_ptrs.push_back(&matcher);
+  }
+  StringMatcherSet matcher_set(matcher_ptrs);
+  for (absl::string_view value :
+       {"/pkg.Service/Method", "/pkgXService/Method", "/other/Method",
+        "Method", "/pkg", ""}) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < matchers.size(); ++i) {
+      if (matchers[i].Match(value)) expected.push_back(i);
+    }
+    EXPECT_EQ(matcher_set.Match(value), expected) << value;
+  }
+}
+
+TEST(StringMatcherSetTest, Empty) {
+  StringMatcherSet matcher_set;
+  EXPECT_TRUE(matcher_set.Match("value").empty());
+}
+
 TEST(HeaderMatcherTest, StringMatcher) {
   auto header_matcher =
       HeaderMatcher::Create(/*name=*/"key", HeaderMatcher::Type::kExact,
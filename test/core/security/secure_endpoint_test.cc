@@ -114,7 +114,8 @@ static const grpc_endpoint_vtable vtable = {me_read,
                                             me_get_peer,
                                             me_get_local_address,
                                             me_get_fd,
-                                            me_can_track_err};
+                                            me_can_track_err,
+                                            nullptr};
 
 grpc_endpoint* wrap_with_intercept_endpoint(grpc_endpoint* wrapped_ep) {
   intercept_endpoint* m =
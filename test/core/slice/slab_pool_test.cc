@@ -0,0 +1,90 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/slice/slab_pool.h"
+
+#include <string.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(SlabPoolTest, SizeClasses) {
+  EXPECT_EQ(SlabPool::SizeClass(8 * 1024), 0);
+  EXPECT_EQ(SlabPool::SizeClass(64 * 1024), 1);
+  EXPECT_EQ(SlabPool::SizeClass(8 * 1024 + 1), -1);
+  EXPECT_EQ(SlabPool::SizeClass(4096), -1);
+  EXPECT_EQ(SlabPool::BlockSize(0), SlabPool::kHeaderSize + 8 * 1024);
+}
+
+TEST(SlabPoolTest, RecyclesFreedBlocks) {
+  void* block = SlabPool::Alloc(1);
+  memset(block, 0xab, SlabPool::BlockSize(1));
+  SlabPool::Free(1, block);
+  const uint64_t new_blocks = SlabPool::TestOnlyNewBlocks();
+  for (int i = 0; i < 100; ++i) {
+    void* recycled = SlabPool::Alloc(1);
+    EXPECT_EQ(recycled, block);
+    SlabPool::Free(1, recycled);
+  }
+  EXPECT_EQ(SlabPool::TestOnlyNewBlocks(), new_blocks);
+}
+
+TEST(SlabPoolTest, KeepsSizeClassesApart) {
+  void* small = SlabPool::Alloc(0);
+  void* big = SlabPool::Alloc(1);
+  SlabPool::Free(0, small);
+  SlabPool::Free(1, big);
+  EXPECT_EQ(SlabPool::Alloc(1), big);
+  EXPECT_EQ(SlabPool::Alloc(0), small);
+  SlabPool::Free(0, small);
+  SlabPool::Free(1, big);
+}
+
+TEST(SlabPoolTest, NeverHandsOutABlockTwice) {
+  std::vector<void*> blocks;
+  for (int i = 0; i < 1000; ++i) blocks.push_back(SlabPool::Alloc(0));
+  EXPECT_EQ(std::set<void*>(blocks.begin(), blocks.end()).size(),
+            blocks.size());
+  for (void* block : blocks) SlabPool::Free(0, block);
+}
+
+TEST(SlabPoolTest, RecyclesBlocksOfExitedThreads) {
+  void* block = nullptr;
+  std::thread([&block] { block = SlabPool::Alloc(1); }).join();
+  // Freed here, cached by this thread.
+  SlabPool::Free(1, block);
+  std::thread([] {
+    // Cached by this thread, then shared when it exits.
+    void* other = SlabPool::Alloc(1);
+    SlabPool::Free(1, other);
+    SlabPool::Free(1, SlabPool::Alloc(1));
+  }).join();
+  const uint64_t new_blocks = SlabPool::TestOnlyNewBlocks();
+  std::thread([] { SlabPool::Free(1, SlabPool::Alloc(1)); }).join();
+  EXPECT_EQ(SlabPool::TestOnlyNewBlocks(), new_blocks);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
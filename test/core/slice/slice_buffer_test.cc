@@ -75,6 +75,39 @@ TEST(SliceBufferTest, SliceRefTest) {
   sb.Clear();
 }
 
+TEST(SliceBufferTest, SlicesSpanTest) {
+  SliceBuffer sb;
+  EXPECT_TRUE(sb.c_slices().empty());
+  for (size_t i = 1; i <= 3; i++) sb.AppendIndexed(MakeSlice(i));
+  Slice first = sb.TakeFirst();
+  size_t expected_length = 2;
+  for (const grpc_slice& slice : sb.c_slices()) {
+    EXPECT_EQ(GRPC_SLICE_LENGTH(slice), expected_length++);
+  }
+  EXPECT_EQ(sb.c_slices().size(), 2);
+  sb.Prepend(std::move(first));
+  EXPECT_EQ(GRPC_SLICE_LENGTH(sb.c_slices().front()), 1);
+  EXPECT_EQ(sb.Copy().JoinIntoString(), "aaaaaa");
+}
+
+TEST(SliceBufferTest, QueueTest) {
+  // Taking from the front of a full buffer and adding to its back, over and
+  // over, keeps the slices in order.
+  SliceBuffer sb;
+  size_t next_added = 0;
+  size_t next_taken = 0;
+  for (int round = 0; round < 100; round++) {
+    while (sb.Count() < 20) sb.AppendIndexed(MakeSlice(++next_added));
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(sb.TakeFirst().size(), ++next_taken);
+    }
+  }
+  EXPECT_EQ(sb.Count(), 17);
+  for (const grpc_slice& slice : sb.c_slices()) {
+    EXPECT_EQ(GRPC_SLICE_LENGTH(slice), ++next_taken);
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
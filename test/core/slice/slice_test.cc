@@ -96,6 +96,39 @@ TEST(GrpcSliceTest, SliceNewWithUserData) {
   EXPECT_EQ(marker, 1);
 }
 
+TEST(GrpcSliceTest, ConfinedRefcount) {
+  int marker = 0;
+  uint8_t buf[2] = {0, 1};
+  grpc_slice slice = grpc_slice_new_with_user_data(buf, 2, set_mark, &marker);
+  grpc_slice ref = grpc_slice_ref(slice);
+  // Only the holder of the only ref may confine the refcount.
+  EXPECT_FALSE(slice.refcount->TryConfine());
+  grpc_slice_unref(ref);
+  ASSERT_TRUE(slice.refcount->TryConfine());
+  EXPECT_TRUE(slice.refcount->confined());
+  ref = grpc_slice_ref(slice);
+  grpc_slice_unref(grpc_slice_ref(slice));
+  EXPECT_FALSE(slice.refcount->IsUnique());
+  // The ref left once the confining ref is dropped is shared.
+  slice.refcount->UnrefAndShare();
+  EXPECT_FALSE(ref.refcount->confined());
+  EXPECT_TRUE(ref.refcount->IsUnique());
+  EXPECT_EQ(marker, 0);
+  grpc_slice_unref(ref);
+  EXPECT_EQ(marker, 1);
+}
+
+TEST(GrpcSliceTest, ConfinedRefcountDestroyedByUnrefAndShare) {
+  int marker = 0;
+  uint8_t buf[2] = {0, 1};
+  grpc_slice slice = grpc_slice_new_with_user_data(buf, 2, set_mark, &marker);
+  ASSERT_TRUE(slice.refcount->TryConfine());
+  grpc_slice_unref(grpc_slice_ref(slice));
+  EXPECT_EQ(marker, 0);
+  slice.refcount->UnrefAndShare();
+  EXPECT_EQ(marker, 1);
+}
+
 static int do_nothing_with_len_1_calls = 0;
 
 static void do_nothing_with_len_1(void* /*ignored*/, size_t len) {
@@ -170,6 +170,111 @@ TEST(GrpcCompletionQueueTest, TestCqEndOp) {
   }
 }
 
+TEST(GrpcCompletionQueueTest, TestBusyPollNext) {
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  grpc_cq_completion completion;
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  void* tag = create_test_tag();
+
+  LOG_TEST("test_busy_poll_next");
+
+  attr.version = GRPC_CQ_VERSION_MINIMUM_FOR_BUSY_POLL;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  attr.cq_shutdown_cb = nullptr;
+  attr.cq_busy_poll_us = 20000;
+  attr.cq_busy_poll_pin_cpu = 1;
+  attr.cq_busy_poll_cpu = 0;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    // Busy polling polls many times before the deadline passes.
+    ev = grpc_completion_queue_next(
+        cc, grpc_timeout_milliseconds_to_deadline(5), nullptr);
+    ASSERT_EQ(ev.type, GRPC_QUEUE_TIMEOUT);
+    ASSERT_GT(grpc_get_cq_poll_num(cc), 1);
+
+    {
+      grpc_core::ExecCtx exec_ctx;
+      ASSERT_TRUE(grpc_cq_begin_op(cc, tag));
+      grpc_cq_end_op(cc, tag, absl::OkStatus(), do_nothing_end_completion,
+                     nullptr, &completion);
+    }
+    ev = grpc_completion_queue_next(cc, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr);
+    ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+    ASSERT_EQ(ev.tag, tag);
+    ASSERT_TRUE(ev.success);
+
+    shutdown_and_destroy(cc);
+  }
+}
+
+TEST(GrpcCompletionQueueTest, TestNextBatch) {
+  grpc_event events[32];
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[40];
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+
+  LOG_TEST("test_next_batch");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+  }
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    {
+      grpc_core::ExecCtx exec_ctx;
+      for (size_t j = 0; j < GPR_ARRAY_SIZE(completions); j++) {
+        ASSERT_TRUE(grpc_cq_begin_op(cc, tags[j]));
+        grpc_cq_end_op(cc, tags[j], absl::OkStatus(),
+                       do_nothing_end_completion, nullptr, &completions[j]);
+      }
+    }
+
+    // The first batch is full, the second one holds what is left, in order.
+    size_t next_tag = 0;
+    for (size_t expected : {size_t{32}, size_t{8}}) {
+      size_t n = grpc_completion_queue_next_batch(
+          cc, events, GPR_ARRAY_SIZE(events),
+          gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      ASSERT_EQ(n, expected);
+      for (size_t j = 0; j < n; j++) {
+        ASSERT_EQ(events[j].type, GRPC_OP_COMPLETE);
+        ASSERT_EQ(events[j].tag, tags[next_tag++]);
+        ASSERT_TRUE(events[j].success);
+      }
+    }
+
+    ASSERT_EQ(grpc_completion_queue_next_batch(
+                  cc, events, GPR_ARRAY_SIZE(events),
+                  grpc_timeout_milliseconds_to_deadline(1), nullptr),
+              size_t{1});
+    ASSERT_EQ(events[0].type, GRPC_QUEUE_TIMEOUT);
+
+    grpc_completion_queue_shutdown(cc);
+    ASSERT_EQ(grpc_completion_queue_next_batch(
+                  cc, events, GPR_ARRAY_SIZE(events),
+                  gpr_inf_future(GPR_CLOCK_REALTIME), nullptr),
+              size_t{1});
+    ASSERT_EQ(events[0].type, GRPC_QUEUE_SHUTDOWN);
+    grpc_completion_queue_destroy(cc);
+  }
+}
+
 TEST(GrpcCompletionQueueTest, TestCqTlsCacheFull) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -72,11 +72,15 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_compression_algorithm_is_stream);
   printf("%lx", (unsigned long) grpc_compression_algorithm_parse);
   printf("%lx", (unsigned long) grpc_compression_algorithm_name);
+  printf("%lx", (unsigned long) grpc_compression_algorithm_is_supported);
   printf("%lx", (unsigned long) grpc_compression_algorithm_for_level);
   printf("%lx", (unsigned long) grpc_compression_options_init);
   printf("%lx", (unsigned long) grpc_compression_options_enable_algorithm);
   printf("%lx", (unsigned long) grpc_compression_options_disable_algorithm);
   printf("%lx", (unsigned long) grpc_compression_options_is_algorithm_enabled);
+  printf("%lx", (unsigned long) grpc_compression_dictionary_create);
+  printf("%lx", (unsigned long) grpc_compression_dictionary_unref);
+  printf("%lx", (unsigned long) grpc_compression_dictionary_arg_vtable);
   printf("%lx", (unsigned long) grpc_metadata_array_init);
   printf("%lx", (unsigned long) grpc_metadata_array_destroy);
   printf("%lx", (unsigned long) grpc_call_details_init);
@@ -93,6 +97,7 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_completion_queue_create_for_callback);
   printf("%lx", (unsigned long) grpc_completion_queue_create);
   printf("%lx", (unsigned long) grpc_completion_queue_next);
+  printf("%lx", (unsigned long) grpc_completion_queue_next_batch);
   printf("%lx", (unsigned long) grpc_completion_queue_pluck);
   printf("%lx", (unsigned long) grpc_completion_queue_shutdown);
   printf("%lx", (unsigned long) grpc_completion_queue_destroy);
@@ -170,6 +175,9 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_ssl_session_cache_create_lru);
   printf("%lx", (unsigned long) grpc_ssl_session_cache_destroy);
   printf("%lx", (unsigned long) grpc_ssl_session_cache_create_channel_arg);
+  printf("%lx", (unsigned long) grpc_ssl_session_ticket_keys_create);
+  printf("%lx", (unsigned long) grpc_ssl_session_ticket_keys_rotate);
+  printf("%lx", (unsigned long) grpc_ssl_session_ticket_keys_release);
   printf("%lx", (unsigned long) grpc_call_credentials_release);
   printf("%lx", (unsigned long) grpc_google_default_credentials_create);
   printf("%lx", (unsigned long) grpc_set_ssl_roots_override_callback);
@@ -220,6 +228,10 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_identity_cert_name);
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_cert_request_type);
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_crl_directory);
+  printf("%lx", (unsigned long) grpc_tls_credentials_options_set_session_ticket_keys);
+  printf("%lx", (unsigned long) grpc_tls_private_key_signer_external_create);
+  printf("%lx", (unsigned long) grpc_tls_private_key_signer_release);
+  printf("%lx", (unsigned long) grpc_tls_credentials_options_set_private_key_signer);
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_verify_server_cert);
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_check_call_host);
   printf("%lx", (unsigned long) grpc_insecure_credentials_create);
@@ -260,6 +260,37 @@ TEST(WireWriterTest, RpcCall) {
   init_lib.shutdown();
 }
 
+TEST(WireWriterTest, SmallMessagesFillTheFlowControlWindow) {
+  grpc::internal::GrpcLibrary init_lib;
+  init_lib.init();
+  // Required because wire writer uses combiner internally.
+  grpc_core::ExecCtx exec_ctx;
+  auto mock_binder = absl::make_unique<MockBinder>();
+  MockBinder& mock_binder_ref = *mock_binder;
+  ::testing::NiceMock<MockWritableParcel> mock_writable_parcel;
+  ON_CALL(mock_binder_ref, GetWritableParcel)
+      .WillByDefault(Return(&mock_writable_parcel));
+  // Flags, sequence number and data length take 12 bytes.
+  const std::string kData(988, 'a');
+  constexpr int kParcelSize = 1000;
+  ON_CALL(mock_writable_parcel, GetDataSize).WillByDefault(Return(kParcelSize));
+  WireWriterImpl wire_writer(std::move(mock_binder));
+
+  // No acks arrive, so only as many messages as fit in the window are sent,
+  // rather than as many as would if each was taken for a whole `kBlockSize`.
+  const int kNumMessages =
+      (WireWriterImpl::kFlowControlWindowSize - 1) / kParcelSize;
+  EXPECT_CALL(mock_binder_ref, Transact(BinderTransportTxCode(kFirstCallId)))
+      .Times(kNumMessages);
+  for (int i = 0; i < kNumMessages + 1; i++) {
+    auto tx = std::make_unique<Transaction>(kFirstCallId, /*is_client=*/true);
+    tx->SetData(kData);
+    EXPECT_TRUE(wire_writer.RpcCall(std::move(tx)).ok());
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+  init_lib.shutdown();
+}
+
 }  // namespace grpc_binder
 
 int main(int argc, char** argv) {
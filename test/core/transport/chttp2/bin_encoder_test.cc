@@ -20,6 +20,9 @@
 
 #include <string.h>
 
+#include <random>
+#include <vector>
+
 /* This is here for grpc_is_binary_header
  * TODO(murgatroid99): Remove this
  */
@@ -29,6 +32,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "test/core/util/test_config.h"
@@ -174,6 +178,52 @@ TEST(BinEncoderTest, MainTest) {
   expect_binary_header("-bin", 0);
 }
 
+// Encodes one bit at a time straight from the hpack table.
+static std::vector<uint8_t> reference_huffman_compress(
+    const std::vector<uint8_t>& input) {
+  std::vector<uint8_t> out;
+  size_t nbits = 0;
+  auto push_bit = [&out, &nbits](bool bit) {
+    if (nbits % 8 == 0) out.push_back(0);
+    if (bit) out.back() |= static_cast<uint8_t>(0x80 >> (nbits % 8));
+    ++nbits;
+  };
+  for (uint8_t c : input) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[c];
+    for (unsigned i = sym.length; i > 0; i--) {
+      push_bit((sym.bits >> (i - 1)) & 1);
+    }
+  }
+  while (nbits % 8 != 0) push_bit(true);
+  return out;
+}
+
+TEST(BinEncoderTest, MatchesReferenceOnRandomInput) {
+  std::mt19937 rng(0);
+  for (size_t len = 0; len < 300; len++) {
+    std::vector<uint8_t> input(len);
+    for (auto& c : input) c = static_cast<uint8_t>(rng());
+    grpc_slice slice = grpc_slice_from_copied_buffer(
+        reinterpret_cast<const char*>(input.data()), input.size());
+    std::vector<uint8_t> want = reference_huffman_compress(input);
+    grpc_slice got = grpc_chttp2_huffman_compress(slice);
+    EXPECT_EQ(want, std::vector<uint8_t>(GRPC_SLICE_START_PTR(got),
+                                         GRPC_SLICE_END_PTR(got)))
+        << "len=" << len;
+    grpc_slice_unref(got);
+    grpc_slice base64 = grpc_chttp2_base64_encode(slice);
+    want = reference_huffman_compress(std::vector<uint8_t>(
+        GRPC_SLICE_START_PTR(base64), GRPC_SLICE_END_PTR(base64)));
+    got = grpc_chttp2_base64_encode_and_huffman_compress(slice);
+    EXPECT_EQ(want, std::vector<uint8_t>(GRPC_SLICE_START_PTR(got),
+                                         GRPC_SLICE_END_PTR(got)))
+        << "len=" << len;
+    grpc_slice_unref(got);
+    grpc_slice_unref(base64);
+    grpc_slice_unref(slice);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
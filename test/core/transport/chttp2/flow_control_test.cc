@@ -14,21 +14,55 @@
 
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "gtest/gtest.h"
 
+#include <grpc/support/time.h>
+
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
 namespace grpc_core {
 namespace chttp2 {
 
 namespace {
 auto* g_memory_owner = new MemoryOwner(
     ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("test"));
-}
+
+// Makes gpr_now() return simulated time while in scope.
+class SimulatedClock {
+ public:
+  SimulatedClock() : saved_now_impl_(gpr_now_impl) {
+    now_ = gpr_time_0(GPR_CLOCK_MONOTONIC);
+    gpr_now_impl = Now;
+  }
+  ~SimulatedClock() { gpr_now_impl = saved_now_impl_; }
+
+  void Advance(Duration duration) {
+    now_ = gpr_time_add(now_, duration.as_timespec());
+  }
+
+ private:
+  static gpr_timespec Now(gpr_clock_type clock_type) {
+    gpr_timespec now = now_;
+    now.clock_type = clock_type;
+    return now;
+  }
+
+  static gpr_timespec now_;
+  gpr_timespec (*const saved_now_impl_)(gpr_clock_type);
+};
+
+gpr_timespec SimulatedClock::now_;
+}  // namespace
 
 TEST(FlowControl, NoOp) {
   ExecCtx exec_ctx;
@@ -165,6 +199,51 @@ TEST(FlowControl, GradualReadsUpdate) {
   EXPECT_EQ(immediate_updates + queued_updates, 65535);
 }
 
+// Simulates a bulk transfer over a 10Gbps path with an 80ms round trip time,
+// where the peer keeps as many bytes in flight as the window allows, and
+// checks how fast the window grows to the BDP of the path and that it then
+// stays put.
+TEST(FlowControl, ModelBasedWindowConvergesOnLongFatPath) {
+  if (!IsModelBasedFlowControlEnabled()) {
+    GTEST_SKIP() << "model_based_flow_control experiment is disabled";
+  }
+  ExecCtx exec_ctx;
+  SimulatedClock clock;
+  TransportFlowControl tfc("test", true, g_memory_owner);
+  BdpEstimator* bdp_estimator = tfc.bdp_estimator();
+  const Duration kRtt = Duration::Milliseconds(80);
+  const int64_t kPathBdp = static_cast<int64_t>(10e9 / 8 * kRtt.seconds());
+  int64_t window = kDefaultWindow;
+  Duration elapsed = Duration::Zero();
+  absl::optional<Duration> converged_after;
+  int updates_after_convergence = 0;
+  for (int i = 0; i < 100; i++) {
+    bdp_estimator->SchedulePing();
+    bdp_estimator->StartPing();
+    bdp_estimator->AddIncomingBytes(std::min(window, kPathBdp));
+    clock.Advance(kRtt);
+    const Duration ping_delay =
+        bdp_estimator->CompletePing() - Timestamp::Now();
+    clock.Advance(ping_delay);
+    elapsed += kRtt + ping_delay;
+    FlowControlAction action = tfc.PeriodicUpdate();
+    if (action.send_initial_window_update() !=
+        FlowControlAction::Urgency::NO_ACTION_NEEDED) {
+      window = action.initial_window_size();
+      if (converged_after.has_value()) updates_after_convergence++;
+    }
+    if (!converged_after.has_value() && window >= kPathBdp) {
+      converged_after = elapsed;
+    }
+  }
+  ASSERT_TRUE(converged_after.has_value());
+  EXPECT_LT(*converged_after, Duration::Seconds(1));
+  // The window settles once the estimate stops growing.
+  EXPECT_LE(updates_after_convergence, 2);
+  EXPECT_GE(window, kPathBdp);
+  EXPECT_LE(window, 4 * kPathBdp);
+}
+
 }  // namespace chttp2
 }  // namespace grpc_core
 
@@ -0,0 +1,98 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/frame_size_policy.h"
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+namespace {
+constexpr uint32_t kPeerMaxFrameSize = 4 * 1024 * 1024;
+
+// Has the peer of policy drain bytes_per_ms for duration, in window updates
+// every millisecond.
+Timestamp Drain(FrameSizePolicy* policy, Timestamp now, uint32_t bytes_per_ms,
+                Duration duration) {
+  for (Timestamp end = now + duration; now < end;
+       now = now + Duration::Milliseconds(1)) {
+    policy->PeerDrained(bytes_per_ms, now);
+  }
+  return now;
+}
+}  // namespace
+
+TEST(FrameSizePolicyTest, UncontendedStreamsUsePeerMaxFrameSize) {
+  FrameSizePolicy policy;
+  Drain(&policy, Timestamp::FromMillisecondsAfterProcessEpoch(1000), 1024,
+        Duration::Seconds(1));
+  EXPECT_EQ(policy.FrameSize(kPeerMaxFrameSize, 64 * 1024 * 1024, false),
+            kPeerMaxFrameSize);
+}
+
+TEST(FrameSizePolicyTest, SmallMessagesAreNotSplit) {
+  FrameSizePolicy policy;
+  EXPECT_EQ(policy.FrameSize(kPeerMaxFrameSize, 1024, true),
+            kPeerMaxFrameSize);
+}
+
+TEST(FrameSizePolicyTest, ContendedBulkStreamsStartWithMinFrameSize) {
+  FrameSizePolicy policy;
+  EXPECT_FALSE(policy.drain_bytes_per_second().has_value());
+  EXPECT_EQ(policy.FrameSize(kPeerMaxFrameSize, 1024 * 1024, true),
+            FrameSizePolicy::kMinFrameSize);
+}
+
+TEST(FrameSizePolicyTest, FrameSizeFollowsDrainRate) {
+  FrameSizePolicy policy;
+  Timestamp now = Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+  // 100 MB/s: 100KB per frame budget of a millisecond.
+  now = Drain(&policy, now, 100 * 1000, Duration::Seconds(1));
+  ASSERT_TRUE(policy.drain_bytes_per_second().has_value());
+  EXPECT_NEAR(*policy.drain_bytes_per_second(), 100e6, 1e6);
+  EXPECT_NEAR(policy.FrameSize(kPeerMaxFrameSize, 64 * 1024 * 1024, true),
+              100 * 1000, 1000);
+  // A slow peer gets minimum sized frames.
+  now = Drain(&policy, now, 1000, Duration::Seconds(1));
+  EXPECT_EQ(policy.FrameSize(kPeerMaxFrameSize, 64 * 1024 * 1024, true),
+            FrameSizePolicy::kMinFrameSize);
+  // And a very fast one the maximum frame size it advertised.
+  Drain(&policy, now, 10 * 1000 * 1000, Duration::Seconds(1));
+  EXPECT_EQ(policy.FrameSize(kPeerMaxFrameSize, 64 * 1024 * 1024, true),
+            kPeerMaxFrameSize);
+}
+
+TEST(FrameSizePolicyTest, IdleTimeIsNotTakenForASlowPeer) {
+  FrameSizePolicy policy;
+  Timestamp now = Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+  now = Drain(&policy, now, 100 * 1000, Duration::Seconds(1));
+  const double rate = *policy.drain_bytes_per_second();
+  // Nothing to send for a minute, then the peer drains at the same rate.
+  now = now + Duration::Minutes(1);
+  Drain(&policy, now, 100 * 1000, Duration::Milliseconds(100));
+  EXPECT_NEAR(*policy.drain_bytes_per_second(), rate, rate / 100);
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -155,9 +155,11 @@ static void CrashOnAppendError(absl::string_view, const grpc_core::Slice&) {
 
 grpc_slice EncodeHeaderIntoBytes(
     bool is_eof,
-    const std::vector<std::pair<std::string, std::string>>& header_fields) {
+    const std::vector<std::pair<std::string, std::string>>& header_fields,
+    bool use_literal_cache = false) {
   std::unique_ptr<grpc_core::HPackCompressor> compressor =
       std::make_unique<grpc_core::HPackCompressor>();
+  compressor->SetUseLiteralCache(use_literal_cache);
 
   auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
   grpc_metadata_batch b(arena.get());
@@ -302,6 +304,111 @@ TEST(HpackEncoderTest, UserAgentMetadataNoIndexing) {
   grpc_slice_unref(encoded_header);
 }
 
+TEST(HpackEncoderTest, LiteralCacheSharesEncodingAcrossConnections) {
+  grpc_core::ExecCtx exec_ctx;
+
+  // Every connection emits the same huffman compressed literal.
+  for (int i = 0; i < 2; i++) {
+    const grpc_core::Slice encoded_header(EncodeHeaderIntoBytes(
+        false, {{grpc_core::UserAgentMetadata::key().data(), "value"}},
+        true));
+    EXPECT_EQ(encoded_header,
+              grpc_core::Slice(parse_hexstring(
+                  "00000e 0104 deadbeef 40 87 b505b161cc5a9384 84 ee3a2d2f")));
+  }
+}
+
+TEST(HpackEncoderTest, AuthorizationIndexing) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::HPackCompressor compressor;
+  compressor.SetIndexAuthorization(true);
+  const grpc_core::Slice token =
+      grpc_core::Slice::FromStaticString("Bearer token");
+
+  auto encode = [&compressor](const grpc_core::Slice& value) {
+    auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+    grpc_metadata_batch b(arena.get());
+    b.Append("authorization", value.Ref(), CrashOnAppendError);
+    grpc_transport_one_way_stats stats = {};
+    grpc_core::HPackCompressor::EncodeHeaderOptions hopt{
+        0xdeadbeef, /* stream_id */
+        false,      /* is_eof */
+        false,      /* use_true_binary_metadata */
+        16384,      /* max_frame_size */
+        &stats      /* stats */
+    };
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&output);
+    compressor.EncodeHeaders(hopt, b, &output);
+    grpc_core::Slice ret(grpc_slice_merge(output.slices, output.count));
+    grpc_slice_buffer_destroy(&output);
+    return ret;
+  };
+
+  // The first call adds the header to the table, the next ones refer to it,
+  // whether or not they share the slice.
+  EXPECT_EQ(encode(token),
+            grpc_core::Slice(parse_hexstring(
+                "00001c 0104 deadbeef 40 0d 617574686f72697a6174696f6e"
+                "0c 42656172657220746f6b656e")));
+  EXPECT_EQ(encode(token),
+            grpc_core::Slice(parse_hexstring("000001 0104 deadbeef be")));
+  EXPECT_EQ(encode(grpc_core::Slice::FromCopiedString("Bearer token")),
+            grpc_core::Slice(parse_hexstring("000001 0104 deadbeef be")));
+  // A new token is added to the table again.
+  const grpc_core::Slice encoded_header =
+      encode(grpc_core::Slice::FromStaticString("Bearer other"));
+  EXPECT_THAT(encoded_header.c_slice(),
+              HasLiteralHeaderFieldNewNameFlagIncrementalIndexing());
+}
+
+TEST(HpackEncoderTest, MemoryPressureLimitShrinksTable) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::HPackCompressor compressor;
+  compressor.SetIndexAuthorization(true);
+  const grpc_core::Slice token =
+      grpc_core::Slice::FromStaticString("Bearer token");
+
+  auto encode = [&compressor, &token]() {
+    auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+    grpc_metadata_batch b(arena.get());
+    b.Append("authorization", token.Ref(), CrashOnAppendError);
+    grpc_transport_one_way_stats stats = {};
+    grpc_core::HPackCompressor::EncodeHeaderOptions hopt{
+        0xdeadbeef, /* stream_id */
+        false,      /* is_eof */
+        false,      /* use_true_binary_metadata */
+        16384,      /* max_frame_size */
+        &stats      /* stats */
+    };
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&output);
+    compressor.EncodeHeaders(hopt, b, &output);
+    grpc_core::Slice ret(grpc_slice_merge(output.slices, output.count));
+    grpc_slice_buffer_destroy(&output);
+    return ret;
+  };
+
+  encode();
+  EXPECT_EQ(compressor.test_only_table_size(), 57u);
+  // The table empties, and the decoder is told.
+  compressor.SetMemoryPressureLimit(0);
+  EXPECT_EQ(compressor.test_only_table_size(), 0u);
+  EXPECT_EQ(encode(), grpc_core::Slice(parse_hexstring(
+                          "00001d 0104 deadbeef 20 40 0d "
+                          "617574686f72697a6174696f6e"
+                          "0c 42656172657220746f6b656e")));
+  EXPECT_EQ(compressor.test_only_table_size(), 0u);
+  // The peer's size is used again once the limit is lifted.
+  compressor.SetMemoryPressureLimit(
+      grpc_core::HPackCompressor::kMaxTableSize);
+  compressor.SetMaxTableSize(4096);
+  encode();
+  EXPECT_EQ(compressor.test_only_table_size(), 57u);
+  EXPECT_EQ(encode(),
+            grpc_core::Slice(parse_hexstring("000001 0104 deadbeef be")));
+}
+
 static void verify_continuation_headers(const char* key, const char* value,
                                         bool is_eof) {
   auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
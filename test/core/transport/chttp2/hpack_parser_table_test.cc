@@ -134,6 +134,70 @@ TEST(HpackParserTableTest, ManyAdditions) {
   }
 }
 
+TEST(HpackParserTableTest, ArenaCopies) {
+  ExecCtx exec_ctx;
+  HPackTable tbl;
+  const std::string value_a(64, 'a');
+  const std::string value_b(64, 'b');
+  Slice a = tbl.CopyToArena(value_a);
+  Slice b = tbl.CopyToArena(value_b);
+  EXPECT_EQ(a.as_string_view(), value_a);
+  EXPECT_EQ(b.as_string_view(), value_b);
+  // Copies share a block.
+  EXPECT_EQ(a.c_slice().refcount, b.c_slice().refcount);
+  EXPECT_EQ(a.data() + a.size(), b.data());
+  // Short strings are inlined, long ones get their own allocation.
+  EXPECT_EQ(tbl.CopyToArena("short").c_slice().refcount, nullptr);
+  const std::string long_value(4096, 'c');
+  Slice c = tbl.CopyToArena(long_value);
+  EXPECT_EQ(c.as_string_view(), long_value);
+  EXPECT_NE(c.c_slice().refcount, a.c_slice().refcount);
+}
+
+TEST(HpackParserTableTest, ManyArenaAdditions) {
+  HPackTable tbl;
+  ExecCtx exec_ctx;
+  for (int i = 0; i < 100000; i++) {
+    std::string key = absl::StrCat("a-longer-key-for-the-arena.", i);
+    std::string value = absl::StrCat("a-longer-value-for-the-arena.", i);
+    auto memento = HPackTable::Memento(tbl.CopyToArena(key),
+                                       tbl.CopyToArena(value));
+    ASSERT_EQ(tbl.Add(std::move(memento)), absl::OkStatus());
+    AssertIndex(&tbl, 1 + hpack_constants::kLastStaticEntry, key.c_str(),
+                value.c_str());
+    if (i > 0) {
+      std::string key = absl::StrCat("a-longer-key-for-the-arena.", i - 1);
+      std::string value = absl::StrCat("a-longer-value-for-the-arena.", i - 1);
+      AssertIndex(&tbl, 2 + hpack_constants::kLastStaticEntry, key.c_str(),
+                  value.c_str());
+    }
+  }
+}
+
+TEST(HpackParserTableTest, EmptiedTableStartsAgain) {
+  ExecCtx exec_ctx;
+  HPackTable tbl;
+  const std::string key(64, 'k');
+  const std::string value(64, 'v');
+  Slice before = tbl.CopyToArena(key);
+  ASSERT_EQ(tbl.Add(HPackTable::Memento(before.Ref(), tbl.CopyToArena(value))),
+            absl::OkStatus());
+  tbl.SetMaxBytes(0);
+  EXPECT_EQ(tbl.num_entries(), 0);
+  EXPECT_EQ(tbl.Lookup(1 + hpack_constants::kLastStaticEntry), nullptr);
+  // The block copies went to is let go: later copies go to a new one.
+  Slice after = tbl.CopyToArena(key);
+  EXPECT_NE(after.c_slice().refcount, before.c_slice().refcount);
+  tbl.SetMaxBytes(hpack_constants::kInitialTableSize);
+  ASSERT_EQ(tbl.SetCurrentTableSize(hpack_constants::kInitialTableSize),
+            absl::OkStatus());
+  ASSERT_EQ(tbl.Add(HPackTable::Memento(std::move(after),
+                                        tbl.CopyToArena(value))),
+            absl::OkStatus());
+  AssertIndex(&tbl, 1 + hpack_constants::kLastStaticEntry, key.c_str(),
+              value.c_str());
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
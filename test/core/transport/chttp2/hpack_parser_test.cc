@@ -302,6 +302,31 @@ INSTANTIATE_TEST_SUITE_P(
                  {"40 09 61 2e 62 2e 63 2d 62 69 6e 0c 62 32 31 6e 4d 6a 41 79 "
                   "4d 51 3d 3d",
                   "a.b.c-bin: omg2021\n"},
+             }},
+        Test{{},
+             {
+                 // Literal keys of metadata traits
+                 {"00 0b 67 72 70 63 2d 73 74 61 74 75 73 01 30",
+                  "grpc-status: 0\n"},
+                 {"00 0c 63 6f 6e 74 65 6e 74 2d 74 79 70 65 10 61 70 70 6c "
+                  "69 63 61 74 69 6f 6e 2f 67 72 70 63",
+                  "content-type: application/grpc\n"},
+                 // A multi-byte varint string length
+                 {"00 01 61 7f 49 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 "
+                  "62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62 62",
+                  "a: bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"
+                  "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"
+                  "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"
+                  "bbbbbbbbbbbbbbbbbbbbbbbbbbbb\n"},
              }}));
 
 int main(int argc, char** argv) {
@@ -0,0 +1,70 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/keepalive_schedule.h"
+
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+TEST(KeepaliveScheduleTest, SlackIsATenthOfKeepaliveTimeUpToASecond) {
+  EXPECT_EQ(KeepaliveSlack(Duration::Milliseconds(500)),
+            Duration::Milliseconds(50));
+  EXPECT_EQ(KeepaliveSlack(Duration::Seconds(10)), Duration::Seconds(1));
+  EXPECT_EQ(KeepaliveSlack(Duration::Hours(2)), Duration::Seconds(1));
+  EXPECT_EQ(KeepaliveSlack(Duration::Milliseconds(5)),
+            Duration::Milliseconds(1));
+}
+
+TEST(KeepaliveScheduleTest, DeadlineIsKeepaliveTimeAfterLastReadWithinSlack) {
+  const Duration keepalive_time = Duration::Seconds(20);
+  for (int64_t ms = 1000; ms < 5000; ms += 37) {
+    const Timestamp last_read =
+        Timestamp::FromMillisecondsAfterProcessEpoch(ms);
+    const Timestamp deadline = KeepaliveDeadline(last_read, keepalive_time);
+    EXPECT_GE(deadline, last_read + keepalive_time);
+    EXPECT_LT(deadline,
+              last_read + keepalive_time + KeepaliveSlack(keepalive_time));
+  }
+}
+
+TEST(KeepaliveScheduleTest, TransportsIdleSinceAboutTheSameTimeWakeTogether) {
+  const Duration keepalive_time = Duration::Minutes(1);
+  std::set<Timestamp> deadlines;
+  // A thousand transports, that last read in the same second.
+  for (int64_t ms = 10000; ms < 11000; ms++) {
+    deadlines.insert(KeepaliveDeadline(
+        Timestamp::FromMillisecondsAfterProcessEpoch(ms), keepalive_time));
+  }
+  EXPECT_LE(deadlines.size(), 2u);
+}
+
+TEST(KeepaliveScheduleTest, InfiniteKeepaliveTime) {
+  EXPECT_EQ(KeepaliveDeadline(Timestamp::FromMillisecondsAfterProcessEpoch(1),
+                              Duration::Infinity()),
+            Timestamp::InfFuture());
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
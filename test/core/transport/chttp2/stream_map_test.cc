@@ -26,6 +26,15 @@
 
 #define LOG_TEST(x) gpr_log(GPR_INFO, "%s", x)
 
+static void init_map(grpc_chttp2_stream_map* map, size_t initial_capacity,
+                     bool open_addressing) {
+  if (open_addressing) {
+    grpc_chttp2_stream_map_init_open_addressing(map, initial_capacity);
+  } else {
+    grpc_chttp2_stream_map_init(map, initial_capacity);
+  }
+}
+
 /* test creation & destruction */
 static void test_no_op(void) {
   grpc_chttp2_stream_map map;
@@ -48,7 +57,7 @@ static void test_empty_find(void) {
 }
 
 /* test add & lookup */
-static void test_basic_add_find(uint32_t n) {
+static void test_basic_add_find(uint32_t n, bool open_addressing = false) {
   grpc_chttp2_stream_map map;
   uint32_t i;
   size_t got;
@@ -56,7 +65,7 @@ static void test_basic_add_find(uint32_t n) {
   LOG_TEST("test_basic_add_find");
   gpr_log(GPR_INFO, "n = %d", n);
 
-  grpc_chttp2_stream_map_init(&map, 8);
+  init_map(&map, 8, open_addressing);
   ASSERT_EQ(0, grpc_chttp2_stream_map_size(&map));
   for (i = 1; i <= n; i++) {
     grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
@@ -71,6 +80,15 @@ static void test_basic_add_find(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* open addressing maps do not iterate in key order: count the odd keys seen */
+static void verify_for_each_unordered(void* user_data, uint32_t stream_id,
+                                      void* ptr) {
+  uint32_t* seen = static_cast<uint32_t*>(user_data);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr), stream_id);
+  ASSERT_EQ(stream_id & 1, 1);
+  ++*seen;
+}
+
 /* verify that for_each gets the right values during test_delete_evens_XXX */
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
   uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
@@ -79,7 +97,8 @@ static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
   *for_each_check += 2;
 }
 
-static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
+static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n,
+                               bool open_addressing) {
   uint32_t for_each_check = 1;
   uint32_t i;
   size_t got;
@@ -95,6 +114,12 @@ static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
     }
   }
 
+  if (open_addressing) {
+    uint32_t seen = 0;
+    grpc_chttp2_stream_map_for_each(map, verify_for_each_unordered, &seen);
+    ASSERT_EQ(seen, (n + 1) / 2);
+    return;
+  }
   grpc_chttp2_stream_map_for_each(map, verify_for_each, &for_each_check);
   if (n & 1) {
     ASSERT_EQ(for_each_check, n + 2);
@@ -105,14 +130,14 @@ static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
 
 /* add a bunch of keys, delete the even ones, and make sure the map is
    consistent */
-static void test_delete_evens_sweep(uint32_t n) {
+static void test_delete_evens_sweep(uint32_t n, bool open_addressing = false) {
   grpc_chttp2_stream_map map;
   uint32_t i;
 
   LOG_TEST("test_delete_evens_sweep");
   gpr_log(GPR_INFO, "n = %d", n);
 
-  grpc_chttp2_stream_map_init(&map, 8);
+  init_map(&map, 8, open_addressing);
   for (i = 1; i <= n; i++) {
     grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
   }
@@ -121,27 +146,28 @@ static void test_delete_evens_sweep(uint32_t n) {
       ASSERT_EQ((void*)(uintptr_t)i, grpc_chttp2_stream_map_delete(&map, i));
     }
   }
-  check_delete_evens(&map, n);
+  check_delete_evens(&map, n, open_addressing);
   grpc_chttp2_stream_map_destroy(&map);
 }
 
 /* add a bunch of keys, delete the even ones immediately, and make sure the map
    is consistent */
-static void test_delete_evens_incremental(uint32_t n) {
+static void test_delete_evens_incremental(uint32_t n,
+                                          bool open_addressing = false) {
   grpc_chttp2_stream_map map;
   uint32_t i;
 
   LOG_TEST("test_delete_evens_incremental");
   gpr_log(GPR_INFO, "n = %d", n);
 
-  grpc_chttp2_stream_map_init(&map, 8);
+  init_map(&map, 8, open_addressing);
   for (i = 1; i <= n; i++) {
     grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
     if ((i & 1) == 0) {
       grpc_chttp2_stream_map_delete(&map, i);
     }
   }
-  check_delete_evens(&map, n);
+  check_delete_evens(&map, n, open_addressing);
   grpc_chttp2_stream_map_destroy(&map);
 }
 
@@ -169,6 +195,70 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* with a steady number of live streams, an open addressing map must not grow
+   past twice the live count rounded up to a power of two */
+static void test_open_addressing_steady_state(uint32_t n) {
+  grpc_chttp2_stream_map map;
+
+  LOG_TEST("test_open_addressing_steady_state");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init_open_addressing(&map, 16);
+  for (uint32_t i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i - 1, reinterpret_cast<void*>(i));
+    if (i > 8) {
+      uint32_t del = i - 8;
+      ASSERT_EQ((void*)(uintptr_t)del,
+                grpc_chttp2_stream_map_delete(&map, 2 * del - 1));
+    }
+    ASSERT_NE(nullptr, grpc_chttp2_stream_map_rand(&map));
+  }
+  ASSERT_LE(map.capacity, 32);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+static void delete_in_for_each(void* user_data, uint32_t stream_id,
+                               void* /* ptr */) {
+  grpc_chttp2_stream_map* map = static_cast<grpc_chttp2_stream_map*>(user_data);
+  ASSERT_NE(nullptr, grpc_chttp2_stream_map_delete(map, stream_id));
+}
+
+/* for_each must visit every entry exactly once even when the callback deletes
+   entries, as the transport does when cancelling all streams */
+static void test_open_addressing_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+
+  LOG_TEST("test_open_addressing_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init_open_addressing(&map, 8);
+  for (uint32_t i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+  }
+  grpc_chttp2_stream_map_for_each(&map, delete_in_for_each, &map);
+  ASSERT_EQ(0, grpc_chttp2_stream_map_size(&map));
+  ASSERT_EQ(nullptr, grpc_chttp2_stream_map_rand(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+TEST(StreamMapTest, OpenAddressing) {
+  uint32_t n = 1;
+  uint32_t prev = 1;
+  uint32_t tmp;
+
+  while (n < 100000) {
+    test_basic_add_find(n, true);
+    test_delete_evens_sweep(n, true);
+    test_delete_evens_incremental(n, true);
+    test_open_addressing_steady_state(n);
+    test_open_addressing_delete_during_for_each(n);
+
+    tmp = n;
+    n += prev;
+    prev = tmp;
+  }
+}
+
 TEST(StreamMapTest, MainTest) {
   uint32_t n = 1;
   uint32_t prev = 1;
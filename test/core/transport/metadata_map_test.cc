@@ -138,6 +138,68 @@ TEST(MetadataMapTest, NonEncodableTrait) {
   EXPECT_EQ(map.DebugString(), "GrpcStreamNetworkState: not sent on wire");
 }
 
+TEST(MetadataMapTest, WriteWeightIsParsedFromCallMetadata) {
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch map(arena.get());
+  map.Append("grpc-write-weight", Slice::FromStaticString("64"),
+             [](absl::string_view, const Slice&) { abort(); });
+  EXPECT_EQ(map.get(GrpcWriteWeightMetadata()), 64u);
+  EXPECT_EQ(map.DebugString(), "grpc-write-weight: 64");
+  grpc_metadata_batch invalid(arena.get());
+  bool parse_failed = false;
+  invalid.Append("grpc-write-weight", Slice::FromStaticString("heavy"),
+                 [&parse_failed](absl::string_view, const Slice&) {
+                   parse_failed = true;
+                 });
+  EXPECT_TRUE(parse_failed);
+  EXPECT_EQ(invalid.get(GrpcWriteWeightMetadata()), 0u);
+}
+
+TEST(MetadataMapTest, ManyUnknownHeaders) {
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch map(arena.get());
+  std::string expected;
+  // More than are kept inline, and than fit in an arena chunk.
+  for (int i = 0; i < 24; i++) {
+    const std::string key = absl::StrCat("x-custom-header-", i);
+    map.Append(key, Slice::FromCopiedString(absl::StrCat(i)),
+               [](absl::string_view, const Slice&) { abort(); });
+    if (i != 5 && i != 15) {
+      absl::StrAppend(&expected, expected.empty() ? "" : ", ", key, ": ", i);
+    }
+  }
+  EXPECT_EQ(map.count(), 24u);
+  map.Remove("x-custom-header-5");
+  map.Remove("x-custom-header-15");
+  EXPECT_EQ(map.count(), 22u);
+  EXPECT_EQ(map.DebugString(), expected);
+  grpc_metadata_batch copy = map.Copy();
+  EXPECT_EQ(copy.DebugString(), expected);
+  grpc_metadata_batch moved(std::move(map));
+  EXPECT_EQ(moved.DebugString(), expected);
+  std::string backing;
+  EXPECT_EQ(moved.GetStringValue("x-custom-header-23", &backing), "23");
+  map = std::move(moved);
+  EXPECT_EQ(map.DebugString(), expected);
+}
+
+TEST(MetadataMapTest, SetMovesParsedMetadata) {
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch map(arena.get());
+  auto on_error = [](absl::string_view, const Slice&) { abort(); };
+  auto unknown = grpc_metadata_batch::Parse(
+      "x-custom-header", Slice::FromCopiedString("a value"), 0, on_error);
+  auto path = grpc_metadata_batch::Parse(
+      ":path", Slice::FromCopiedString("/foo/bar"), 0, on_error);
+  map.Set(unknown);
+  EXPECT_EQ(unknown.DebugString(), "x-custom-header: a value");
+  map.Set(std::move(unknown));
+  map.Set(std::move(path));
+  EXPECT_EQ(map.DebugString(),
+            ":path: /foo/bar, x-custom-header: a value, "
+            "x-custom-header: a value");
+}
+
 TEST(DebugStringBuilderTest, AddOne) {
   metadata_detail::DebugStringBuilder b;
   b.Add("a", "b");
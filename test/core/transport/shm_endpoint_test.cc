@@ -0,0 +1,160 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "test/core/iomgr/endpoint_tests.h"
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+namespace grpc_core {
+namespace {
+
+gpr_mu* g_mu;
+grpc_pollset* g_pollset;
+
+// The smallest ring there is, so that the larger writes of the endpoint tests
+// wrap around it and run out of space to lend out.
+constexpr size_t kRingSize = 64 * 1024;
+
+grpc_endpoint_pair CreateShmEndpointPair() {
+  grpc_endpoint_pair control =
+      grpc_iomgr_create_endpoint_pair("shm_control", nullptr);
+  auto fds = ShmCreateConnectionFds(kRingSize);
+  GPR_ASSERT(fds.ok());
+  ShmConnectionFds server_fds;
+  server_fds.memfd = dup(fds->memfd);
+  server_fds.client_wakeup_fd = dup(fds->client_wakeup_fd);
+  server_fds.server_wakeup_fd = dup(fds->server_wakeup_fd);
+  auto client = ShmEndpointCreate(*fds, /*is_client=*/true, control.client);
+  GPR_ASSERT(client.ok());
+  auto server = ShmEndpointCreate(server_fds, /*is_client=*/false,
+                                  control.server);
+  GPR_ASSERT(server.ok());
+  return {*client, *server};
+}
+
+void CleanUp() {}
+
+grpc_endpoint_test_fixture CreateFixture(size_t /*slice_size*/) {
+  ExecCtx exec_ctx;
+  grpc_endpoint_pair p = CreateShmEndpointPair();
+  grpc_endpoint_add_to_pollset(p.client, g_pollset);
+  grpc_endpoint_add_to_pollset(p.server, g_pollset);
+  return {p.client, p.server};
+}
+
+grpc_endpoint_test_config configs[] = {
+    {"shm/shm_socketpair", CreateFixture, CleanUp},
+};
+
+void DestroyPollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+struct ReadState {
+  grpc_slice_buffer incoming;
+  grpc_closure on_read;
+  bool done = false;
+  grpc_error_handle error;
+};
+
+void OnRead(void* arg, grpc_error_handle error) {
+  auto* state = static_cast<ReadState*>(arg);
+  gpr_mu_lock(g_mu);
+  state->done = true;
+  state->error = error;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+class ShmEndpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    grpc_init();
+    ExecCtx exec_ctx;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+  }
+
+  void TearDown() override {
+    {
+      ExecCtx exec_ctx;
+      grpc_closure destroyed;
+      GRPC_CLOSURE_INIT(&destroyed, DestroyPollset, g_pollset,
+                        grpc_schedule_on_exec_ctx);
+      grpc_pollset_shutdown(g_pollset, &destroyed);
+    }
+    grpc_shutdown();
+    gpr_free(g_pollset);
+  }
+};
+
+TEST_F(ShmEndpointTest, EndpointTests) {
+  ExecCtx exec_ctx;
+  grpc_endpoint_tests(configs[0], g_pollset, g_mu);
+}
+
+TEST_F(ShmEndpointTest, ReadFailsOnceThePeerIsDestroyed) {
+  ExecCtx exec_ctx;
+  grpc_endpoint_test_fixture f = CreateFixture(0);
+  ReadState state;
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.on_read, OnRead, &state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_read(f.server_ep, &state.incoming, &state.on_read,
+                     /*urgent=*/false, /*min_progress_size=*/1);
+  grpc_endpoint_destroy(f.client_ep);
+  ExecCtx::Get()->Flush();
+  const Timestamp deadline = Timestamp::Now() + Duration::Seconds(10);
+  gpr_mu_lock(g_mu);
+  while (!state.done) {
+    ASSERT_LT(Timestamp::Now(), deadline);
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  EXPECT_FALSE(state.error.ok());
+  EXPECT_EQ(state.incoming.length, 0u);
+  grpc_slice_buffer_destroy(&state.incoming);
+  grpc_endpoint_destroy(f.server_ep);
+  ExecCtx::Get()->Flush();
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 
+#include "absl/strings/string_view.h"
 #include "upb/upb.hpp"
 
 #include <grpc/grpc.h>
@@ -30,7 +31,9 @@
 
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
+#include "src/core/tsi/alts/handshaker/alts_session_cache.h"
 #include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
 #include "src/core/tsi/alts/handshaker/alts_tsi_handshaker_private.h"
 #include "src/core/tsi/transport_security_grpc.h"
@@ -73,6 +76,7 @@ using grpc_core::internal::alts_handshaker_client_set_recv_bytes_for_testing;
 using grpc_core::internal::alts_tsi_handshaker_get_client_for_testing;
 using grpc_core::internal::alts_tsi_handshaker_get_is_client_for_testing;
 using grpc_core::internal::alts_tsi_handshaker_set_client_vtable_for_testing;
+using grpc_core::internal::alts_tsi_handshaker_set_session_cache_for_testing;
 static bool should_handshaker_client_api_succeed = true;
 
 /* ALTS mock notification. */
@@ -1099,6 +1103,213 @@ TEST(AltsTsiHandshakerTest, CheckHandshakerSuccess) {
   notification_destroy(&tsi_to_caller_notification);
 }
 
+static tsi::AltsSession create_test_session() {
+  tsi::AltsSession session;
+  session.peer_identity = ALTS_TSI_HANDSHAKER_TEST_PEER_IDENTITY;
+  session.rpc_versions = "test rpc versions";
+  session.serialized_context = "test serialized context";
+  session.max_frame_size = ALTS_TSI_HANDSHAKER_TEST_MAX_FRAME_SIZE;
+  session.expiry = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  session.DeriveSecret(ALTS_TSI_HANDSHAKER_TEST_KEY_DATA);
+  return session;
+}
+
+static tsi_handshaker* create_resuming_handshaker(
+    bool is_client,
+    grpc_core::RefCountedPtr<tsi::AltsSessionCache> session_cache) {
+  tsi_handshaker* handshaker = create_test_handshaker(is_client);
+  alts_tsi_handshaker_set_session_cache_for_testing(
+      reinterpret_cast<alts_tsi_handshaker*>(handshaker),
+      std::move(session_cache));
+  return handshaker;
+}
+
+/* Sends the client's resumption hello to the server, and returns the
+ * server's answer. */
+static tsi_result run_resumption_hello(tsi_handshaker* client,
+                                       tsi_handshaker* server,
+                                       const unsigned char** server_bytes,
+                                       size_t* server_bytes_size,
+                                       tsi_handshaker_result** server_result) {
+  const unsigned char* client_bytes = nullptr;
+  size_t client_bytes_size = 0;
+  tsi_handshaker_result* client_result = nullptr;
+  EXPECT_EQ(tsi_handshaker_next(client, nullptr, 0, &client_bytes,
+                                &client_bytes_size, &client_result,
+                                check_must_not_be_called, nullptr),
+            TSI_OK);
+  EXPECT_EQ(client_bytes_size, tsi::kAltsResumptionHelloLength);
+  EXPECT_EQ(client_result, nullptr);
+  return tsi_handshaker_next(server, client_bytes, client_bytes_size,
+                             server_bytes, server_bytes_size, server_result,
+                             check_must_not_be_called, nullptr);
+}
+
+TEST(AltsTsiHandshakerTest, CheckSessionResumption) {
+  /* Initialization. */
+  grpc_core::RefCountedPtr<tsi::AltsSessionCache> session_cache =
+      tsi::AltsSessionCache::Create(10);
+  tsi::AltsSession session = create_test_session();
+  session_cache->Put(tsi::AltsSessionCache::ClientKey("target_name"), session);
+  session_cache->Put(tsi::AltsSessionCache::ServerKey(session.ticket),
+                     session);
+  tsi_handshaker* client = create_resuming_handshaker(true, session_cache);
+  tsi_handshaker* server = create_resuming_handshaker(false, session_cache);
+  /* Resume, without the handshaker service. */
+  const unsigned char* server_bytes = nullptr;
+  size_t server_bytes_size = 0;
+  tsi_handshaker_result* server_result = nullptr;
+  ASSERT_EQ(run_resumption_hello(client, server, &server_bytes,
+                                 &server_bytes_size, &server_result),
+            TSI_OK);
+  ASSERT_EQ(server_bytes_size, tsi::kAltsResumptionAcceptLength);
+  ASSERT_NE(server_result, nullptr);
+  const unsigned char* client_bytes = nullptr;
+  size_t client_bytes_size = 0;
+  tsi_handshaker_result* client_result = nullptr;
+  ASSERT_EQ(tsi_handshaker_next(client, server_bytes, server_bytes_size,
+                                &client_bytes, &client_bytes_size,
+                                &client_result, check_must_not_be_called,
+                                nullptr),
+            TSI_OK);
+  EXPECT_EQ(client_bytes_size, 0u);
+  ASSERT_NE(client_result, nullptr);
+  /* Check the peer. */
+  tsi_peer peer;
+  ASSERT_EQ(tsi_handshaker_result_extract_peer(client_result, &peer), TSI_OK);
+  const tsi_peer_property* property = tsi_peer_get_property_by_name(
+      &peer, TSI_ALTS_SERVICE_ACCOUNT_PEER_PROPERTY);
+  ASSERT_NE(property, nullptr);
+  EXPECT_EQ(absl::string_view(property->value.data, property->value.length),
+            ALTS_TSI_HANDSHAKER_TEST_PEER_IDENTITY);
+  tsi_peer_destruct(&peer);
+  /* Check that both derived the same record protocol key. */
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  ASSERT_EQ(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                client_result, nullptr, &client_protector),
+            TSI_OK);
+  ASSERT_EQ(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                server_result, nullptr, &server_protector),
+            TSI_OK);
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_add(
+      &unprotected,
+      grpc_slice_from_static_string(ALTS_TSI_HANDSHAKER_TEST_OUT_FRAME));
+  ASSERT_EQ(tsi_zero_copy_grpc_protector_protect(client_protector, &unprotected,
+                                                 &protected_slices),
+            TSI_OK);
+  ASSERT_EQ(tsi_zero_copy_grpc_protector_unprotect(
+                server_protector, &protected_slices, &unprotected, nullptr),
+            TSI_OK);
+  ASSERT_EQ(unprotected.count, 1u);
+  EXPECT_EQ(grpc_core::StringViewFromSlice(unprotected.slices[0]),
+            ALTS_TSI_HANDSHAKER_TEST_OUT_FRAME);
+  /* Both sessions were renewed for the next connection. */
+  EXPECT_EQ(session_cache->Size(), 2u);
+  /* Cleanup. */
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_slices);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+  tsi_handshaker_result_destroy(client_result);
+  tsi_handshaker_result_destroy(server_result);
+  run_tsi_handshaker_destroy_with_exec_ctx(client);
+  run_tsi_handshaker_destroy_with_exec_ctx(server);
+}
+
+TEST(AltsTsiHandshakerTest, CheckSessionResumptionRejectsUnknownTicket) {
+  /* Initialization. */
+  grpc_core::RefCountedPtr<tsi::AltsSessionCache> client_cache =
+      tsi::AltsSessionCache::Create(10);
+  client_cache->Put(tsi::AltsSessionCache::ClientKey("target_name"),
+                    create_test_session());
+  tsi_handshaker* client = create_resuming_handshaker(true, client_cache);
+  tsi_handshaker* server =
+      create_resuming_handshaker(false, tsi::AltsSessionCache::Create(10));
+  /* The server does not know the ticket. */
+  const unsigned char* server_bytes = nullptr;
+  size_t server_bytes_size = 0;
+  tsi_handshaker_result* server_result = nullptr;
+  ASSERT_EQ(run_resumption_hello(client, server, &server_bytes,
+                                 &server_bytes_size, &server_result),
+            TSI_OK);
+  EXPECT_EQ(absl::string_view(reinterpret_cast<const char*>(server_bytes),
+                              server_bytes_size),
+            tsi::kAltsResumptionRejectMagic);
+  EXPECT_EQ(server_result, nullptr);
+  /* Tickets are single use. */
+  EXPECT_EQ(client_cache->Size(), 0u);
+  /* Cleanup. */
+  run_tsi_handshaker_destroy_with_exec_ctx(client);
+  run_tsi_handshaker_destroy_with_exec_ctx(server);
+}
+
+TEST(AltsTsiHandshakerTest, CheckSessionResumptionAuthenticatesServer) {
+  /* Initialization. */
+  grpc_core::RefCountedPtr<tsi::AltsSessionCache> session_cache =
+      tsi::AltsSessionCache::Create(10);
+  tsi::AltsSession session = create_test_session();
+  session_cache->Put(tsi::AltsSessionCache::ClientKey("target_name"), session);
+  session_cache->Put(tsi::AltsSessionCache::ServerKey(session.ticket),
+                     session);
+  tsi_handshaker* client = create_resuming_handshaker(true, session_cache);
+  tsi_handshaker* server = create_resuming_handshaker(false, session_cache);
+  const unsigned char* server_bytes = nullptr;
+  size_t server_bytes_size = 0;
+  tsi_handshaker_result* server_result = nullptr;
+  ASSERT_EQ(run_resumption_hello(client, server, &server_bytes,
+                                 &server_bytes_size, &server_result),
+            TSI_OK);
+  ASSERT_EQ(server_bytes_size, tsi::kAltsResumptionAcceptLength);
+  /* Tamper with the server's MAC, and deliver the answer in two reads. */
+  std::string accept(reinterpret_cast<const char*>(server_bytes),
+                     server_bytes_size);
+  accept.back() ^= 1;
+  const unsigned char* client_bytes = nullptr;
+  size_t client_bytes_size = 0;
+  tsi_handshaker_result* client_result = nullptr;
+  EXPECT_EQ(tsi_handshaker_next(
+                client, reinterpret_cast<const unsigned char*>(accept.data()),
+                tsi::kAltsResumptionMagicLength, &client_bytes,
+                &client_bytes_size, &client_result, check_must_not_be_called,
+                nullptr),
+            TSI_INCOMPLETE_DATA);
+  EXPECT_EQ(tsi_handshaker_next(
+                client,
+                reinterpret_cast<const unsigned char*>(accept.data()) +
+                    tsi::kAltsResumptionMagicLength,
+                accept.size() - tsi::kAltsResumptionMagicLength, &client_bytes,
+                &client_bytes_size, &client_result, check_must_not_be_called,
+                nullptr),
+            TSI_PROTOCOL_FAILURE);
+  EXPECT_EQ(client_result, nullptr);
+  /* Cleanup. */
+  tsi_handshaker_result_destroy(server_result);
+  run_tsi_handshaker_destroy_with_exec_ctx(client);
+  run_tsi_handshaker_destroy_with_exec_ctx(server);
+}
+
+TEST(AltsTsiHandshakerTest, CheckSessionCacheEvictsAndExpires) {
+  grpc_core::RefCountedPtr<tsi::AltsSessionCache> session_cache =
+      tsi::AltsSessionCache::Create(2);
+  session_cache->Put("a", create_test_session());
+  session_cache->Put("b", create_test_session());
+  session_cache->Put("c", create_test_session());
+  EXPECT_EQ(session_cache->Size(), 2u);
+  EXPECT_FALSE(session_cache->Take("a").has_value());
+  EXPECT_TRUE(session_cache->Take("b").has_value());
+  EXPECT_FALSE(session_cache->Take("b").has_value());
+  tsi::AltsSession expired = create_test_session();
+  expired.expiry = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  session_cache->Put("d", expired);
+  EXPECT_FALSE(session_cache->Take("d").has_value());
+  EXPECT_EQ(session_cache->Size(), 1u);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
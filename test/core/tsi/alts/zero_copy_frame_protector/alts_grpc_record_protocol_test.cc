@@ -18,6 +18,8 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_record_protocol.h"
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <grpc/support/alloc.h>
@@ -35,6 +37,7 @@ constexpr size_t kMaxSliceLength = 256;
 constexpr size_t kMaxSlices = 10;
 constexpr size_t kSealRepeatTimes = 5;
 constexpr size_t kTagLength = 16;
+constexpr size_t kMaxFrameDataLength = 100;
 
 /* Test fixtures for each test cases.  */
 struct alts_grpc_record_protocol_test_fixture {
@@ -333,6 +336,45 @@ static void empty_seal_unseal(alts_grpc_record_protocol* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void frames_seal_unseal(alts_grpc_record_protocol* sender,
+                               alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_grpc_record_protocol_test_var* var =
+        alts_grpc_record_protocol_test_var_create();
+    /* Seals as several frames, and then unseals them one by one.  */
+    size_t data_length = var->original_sb.length;
+    size_t num_frames =
+        (data_length + kMaxFrameDataLength - 1) / kMaxFrameDataLength;
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        sender, &var->original_sb, kMaxFrameDataLength, &var->protected_sb);
+    ASSERT_EQ(status, TSI_OK);
+    ASSERT_EQ(var->original_sb.length, 0);
+    ASSERT_EQ(var->protected_sb.length,
+              data_length +
+                  num_frames * (var->header_length + var->tag_length));
+    grpc_slice_buffer frame_sb;
+    grpc_slice_buffer_init(&frame_sb);
+    while (data_length > 0) {
+      size_t frame_data_length = std::min(data_length, kMaxFrameDataLength);
+      data_length -= frame_data_length;
+      grpc_slice_buffer_move_first(
+          &var->protected_sb,
+          frame_data_length + var->header_length + var->tag_length,
+          &frame_sb);
+      status = alts_grpc_record_protocol_unprotect(receiver, &frame_sb,
+                                                   &var->unprotected_sb);
+      ASSERT_EQ(status, TSI_OK);
+    }
+    grpc_slice_buffer_destroy(&frame_sb);
+    ASSERT_EQ(var->protected_sb.length, 0);
+    ASSERT_TRUE(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    alts_grpc_record_protocol_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 static void unsync_seal_unseal(alts_grpc_record_protocol* sender,
                                alts_grpc_record_protocol* receiver) {
   grpc_core::ExecCtx exec_ctx;
@@ -422,6 +464,12 @@ static void alts_grpc_record_protocol_empty_seal_unseal_tests(
   empty_seal_unseal(fixture->server_protect, fixture->client_unprotect);
 }
 
+static void alts_grpc_record_protocol_frames_seal_unseal_tests(
+    alts_grpc_record_protocol_test_fixture* fixture) {
+  frames_seal_unseal(fixture->client_protect, fixture->server_unprotect);
+  frames_seal_unseal(fixture->server_protect, fixture->client_unprotect);
+}
+
 static void alts_grpc_record_protocol_unsync_seal_unseal_tests(
     alts_grpc_record_protocol_test_fixture* fixture) {
   unsync_seal_unseal(fixture->client_protect, fixture->server_unprotect);
@@ -460,6 +508,10 @@ static void alts_grpc_record_protocol_tests(
   auto* fixture_5 = fixture_create();
   alts_grpc_record_protocol_input_check_tests(fixture_5);
   alts_grpc_record_protocol_test_fixture_destroy(fixture_5);
+
+  auto* fixture_6 = fixture_create();
+  alts_grpc_record_protocol_frames_seal_unseal_tests(fixture_6);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_6);
 }
 
 TEST(AltsGrpcRecordProtocolTest, MainTest) {
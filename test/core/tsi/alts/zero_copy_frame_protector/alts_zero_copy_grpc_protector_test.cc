@@ -132,6 +132,8 @@ alts_zero_copy_grpc_protector_test_fixture_create(bool rekey,
                 fixture->server, &actual_max_protected_frame_size),
             TSI_OK);
   EXPECT_EQ(actual_max_protected_frame_size, max_protected_frame_size);
+  EXPECT_TRUE(tsi_zero_copy_grpc_protector_is_full_duplex(fixture->client));
+  EXPECT_TRUE(tsi_zero_copy_grpc_protector_is_full_duplex(fixture->server));
   gpr_free(key);
   grpc_core::ExecCtx::Get()->Flush();
   return fixture;
@@ -22,10 +22,22 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef GPR_LINUX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #include <gtest/gtest.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/pem.h>
+#include <openssl/rsa.h>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -35,7 +47,11 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_ticket_keys.h"
+#include "src/core/tsi/ssl/verification_cache/ssl_verification_cache.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
 #include "test/core/util/build.h"
@@ -101,6 +117,8 @@ typedef struct ssl_tsi_test_fixture {
   bool session_reused;
   const char* session_ticket_key;
   size_t session_ticket_key_size;
+  tsi::SslSessionTicketKeys* session_ticket_keys;
+  tsi::SslPrivateKeySigner* private_key_signer;
   size_t network_bio_buf_size;
   size_t ssl_bio_buf_size;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
@@ -169,6 +187,8 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   }
   server_options.session_ticket_key = ssl_fixture->session_ticket_key;
   server_options.session_ticket_key_size = ssl_fixture->session_ticket_key_size;
+  server_options.session_ticket_keys = ssl_fixture->session_ticket_keys;
+  server_options.private_key_signer = ssl_fixture->private_key_signer;
   server_options.min_tls_version = test_tls_version;
   server_options.max_tls_version = test_tls_version;
   ASSERT_EQ(tsi_create_ssl_server_handshaker_factory_with_options(
@@ -326,6 +346,21 @@ static void check_client_peer(ssl_tsi_test_fixture* ssl_fixture,
   tsi_peer_destruct(peer);
 }
 
+// Offloading the protection to the kernel needs a TCP socket, and leaves the
+// handshaker result usable when it is not possible.
+static void check_offload_to_kernel(tsi_handshaker_result* result) {
+  ASSERT_EQ(tsi_handshaker_result_offload_to_kernel(result, -1),
+            TSI_INVALID_ARGUMENT);
+#ifdef GPR_LINUX
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  ASSERT_EQ(tsi_handshaker_result_offload_to_kernel(result, fds[0]),
+            TSI_UNIMPLEMENTED);
+  close(fds[0]);
+  close(fds[1]);
+#endif
+}
+
 static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
   ssl_tsi_test_fixture* ssl_fixture =
       reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
@@ -359,6 +394,7 @@ static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
     check_session_reusage(ssl_fixture, &peer);
     check_alpn(ssl_fixture, &peer);
     check_security_level(&peer);
+    check_offload_to_kernel(ssl_fixture->base.client_result);
     if (ssl_fixture->server_name_indication == nullptr ||
         strcmp(ssl_fixture->server_name_indication, SSL_TSI_TEST_WRONG_SNI) ==
             0) {
@@ -378,6 +414,7 @@ static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
     check_session_reusage(ssl_fixture, &peer);
     check_alpn(ssl_fixture, &peer);
     check_security_level(&peer);
+    check_offload_to_kernel(ssl_fixture->base.server_result);
     check_client_peer(ssl_fixture, &peer);
   } else {
     ASSERT_EQ(ssl_fixture->base.server_result, nullptr);
@@ -518,6 +555,8 @@ static tsi_test_fixture* ssl_tsi_test_fixture_create() {
   ssl_fixture->session_reused = false;
   ssl_fixture->session_ticket_key = nullptr;
   ssl_fixture->session_ticket_key_size = 0;
+  ssl_fixture->session_ticket_keys = nullptr;
+  ssl_fixture->private_key_signer = nullptr;
   ssl_fixture->force_client_auth = false;
   ssl_fixture->network_bio_buf_size = 0;
   ssl_fixture->ssl_bio_buf_size = 0;
@@ -759,6 +798,78 @@ void ssl_tsi_test_do_round_trip_odd_buffer_size() {
   }
 }
 
+#ifdef OPENSSL_IS_BORINGSSL
+// Sends a message spread over slices of many sizes from |sender| to
+// |receiver|, delivering the protected frames in pieces that split records.
+static void ssl_tsi_test_zero_copy_send(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver) {
+  std::string message;
+  for (size_t i = 0; i < 100000; i++) {
+    message.push_back(static_cast<char>('a' + i % 26));
+  }
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_frames;
+  grpc_slice_buffer piece;
+  grpc_slice_buffer received;
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_frames);
+  grpc_slice_buffer_init(&piece);
+  grpc_slice_buffer_init(&received);
+  size_t slice_size = 1;
+  for (size_t offset = 0; offset < message.size();) {
+    size_t size = std::min(slice_size, message.size() - offset);
+    grpc_slice_buffer_add(&unprotected, grpc_slice_from_copied_buffer(
+                                            message.data() + offset, size));
+    offset += size;
+    slice_size = slice_size * 7 % 20000 + 1;
+  }
+  ASSERT_EQ(tsi_zero_copy_grpc_protector_protect(sender, &unprotected,
+                                                 &protected_frames),
+            TSI_OK);
+  EXPECT_EQ(unprotected.length, 0);
+  while (protected_frames.length > 0) {
+    grpc_slice_buffer_move_first(
+        &protected_frames,
+        std::min(protected_frames.length, static_cast<size_t>(1000)), &piece);
+    ASSERT_EQ(tsi_zero_copy_grpc_protector_unprotect(receiver, &piece,
+                                                     &received, nullptr),
+              TSI_OK);
+    grpc_slice_buffer_reset_and_unref(&piece);
+  }
+  ASSERT_EQ(received.length, message.size());
+  std::string received_message(received.length, '\0');
+  grpc_slice_buffer_copy_first_into_buffer(&received, received.length,
+                                           &received_message[0]);
+  EXPECT_EQ(received_message, message);
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_frames);
+  grpc_slice_buffer_destroy(&piece);
+  grpc_slice_buffer_destroy(&received);
+}
+
+void ssl_tsi_test_do_zero_copy_round_trip() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_zero_copy_round_trip");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  tsi_test_do_handshake(fixture);
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  ASSERT_EQ(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                fixture->client_result, nullptr, &client_protector),
+            TSI_OK);
+  ASSERT_EQ(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                fixture->server_result, nullptr, &server_protector),
+            TSI_OK);
+  // Both directions use the same SSL object.
+  EXPECT_FALSE(tsi_zero_copy_grpc_protector_is_full_duplex(client_protector));
+  ssl_tsi_test_zero_copy_send(client_protector, server_protector);
+  ssl_tsi_test_zero_copy_send(server_protector, client_protector);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+#endif
+
 void ssl_tsi_test_do_handshake_session_cache() {
   gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_session_cache");
   tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
@@ -792,6 +903,179 @@ void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache_unref(session_cache);
 }
 
+void ssl_tsi_test_do_handshake_session_ticket_keys() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_session_ticket_keys");
+  tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
+  auto session_ticket_keys =
+      grpc_core::MakeRefCounted<tsi::SslSessionTicketKeys>();
+  // Each handshake is with a new server handshaker factory, so the session
+  // is resumed only if the factories share their keys.
+  auto do_handshake = [&session_ticket_keys,
+                       &session_cache](bool session_reused) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_fixture->server_name_indication =
+        const_cast<char*>("waterzooi.test.google.be");
+    ssl_fixture->session_ticket_keys = session_ticket_keys.get();
+    tsi_ssl_session_cache_ref(session_cache);
+    ssl_fixture->session_cache = session_cache;
+    ssl_fixture->session_reused = session_reused;
+    tsi_test_do_round_trip(&ssl_fixture->base);
+    tsi_test_fixture_destroy(fixture);
+  };
+  auto rotate = [&session_ticket_keys](char c) {
+    std::string key(tsi::SslSessionTicketKeys::kKeySize, c);
+    ASSERT_TRUE(session_ticket_keys->Rotate(key));
+  };
+  do_handshake(false);
+  do_handshake(true);
+  // Tickets encrypted with the previous keys are still accepted, and renewed.
+  rotate('a');
+  do_handshake(true);
+  rotate('b');
+  rotate('c');
+  do_handshake(true);
+  // But not those encrypted with a key that was rotated out.
+  rotate('d');
+  rotate('e');
+  rotate('f');
+  do_handshake(false);
+  do_handshake(true);
+  ASSERT_FALSE(session_ticket_keys->Rotate("too short"));
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
+#ifdef OPENSSL_IS_BORINGSSL
+// Signs with the server's private key, either before Sign() returns or from
+// another thread.
+class TestPrivateKeySigner : public tsi::SslPrivateKeySigner {
+ public:
+  TestPrivateKeySigner(const char* pem_private_key, bool async)
+      : async_(async) {
+    BIO* bio = BIO_new_mem_buf(pem_private_key, strlen(pem_private_key));
+    private_key_ = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+    BIO_free(bio);
+    GPR_ASSERT(private_key_ != nullptr);
+  }
+
+  ~TestPrivateKeySigner() override {
+    for (std::thread& thread : threads_) thread.join();
+    EVP_PKEY_free(private_key_);
+  }
+
+  void Sign(absl::string_view input, uint16_t signature_algorithm,
+            OnSignDone on_done) override {
+    ++num_signatures_;
+    if (!async_) {
+      on_done(SignNow(input, signature_algorithm));
+      return;
+    }
+    threads_.emplace_back([this, input = std::string(input),
+                           signature_algorithm,
+                           on_done = std::move(on_done)]() mutable {
+      on_done(SignNow(input, signature_algorithm));
+    });
+  }
+
+  int num_signatures() const { return num_signatures_; }
+
+ private:
+  absl::StatusOr<std::string> SignNow(absl::string_view input,
+                                      uint16_t signature_algorithm) {
+    std::string signature(EVP_PKEY_size(private_key_), '\0');
+    size_t signature_size = signature.size();
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    EVP_PKEY_CTX* pkey_ctx = nullptr;
+    bool ok =
+        EVP_DigestSignInit(ctx, &pkey_ctx,
+                           SSL_get_signature_algorithm_digest(
+                               signature_algorithm),
+                           nullptr, private_key_) == 1 &&
+        (!SSL_is_signature_algorithm_rsa_pss(signature_algorithm) ||
+         (EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ==
+              1 &&
+          EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1) == 1)) &&
+        EVP_DigestSign(ctx, reinterpret_cast<uint8_t*>(&signature[0]),
+                       &signature_size,
+                       reinterpret_cast<const uint8_t*>(input.data()),
+                       input.size()) == 1;
+    EVP_MD_CTX_free(ctx);
+    if (!ok) return absl::InternalError("Signing failed.");
+    signature.resize(signature_size);
+    return signature;
+  }
+
+  const bool async_;
+  EVP_PKEY* private_key_;
+  int num_signatures_ = 0;
+  std::vector<std::thread> threads_;
+};
+
+void ssl_tsi_test_do_handshake_with_private_key_signer(bool async) {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_with_private_key_signer");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  ssl_tsi_test_fixture* ssl_fixture =
+      reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+  auto signer = grpc_core::MakeRefCounted<TestPrivateKeySigner>(
+      ssl_fixture->key_cert_lib->server_pem_key_cert_pairs[0].private_key,
+      async);
+  ssl_fixture->private_key_signer = signer.get();
+  tsi_test_do_round_trip(&ssl_fixture->base);
+  tsi_test_fixture_destroy(fixture);
+  EXPECT_EQ(signer->num_signatures(), 1);
+}
+#endif
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+static X509* ssl_tsi_test_load_x509(const char* file_name) {
+  char* pem = load_file(SSL_TSI_TEST_CREDENTIALS_DIR, file_name);
+  BIO* bio = BIO_new_mem_buf(pem, strlen(pem));
+  X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+  BIO_free(bio);
+  gpr_free(pem);
+  GPR_ASSERT(cert != nullptr);
+  return cert;
+}
+
+// Verifies cert against store through cache.
+static int ssl_tsi_test_verify_with_cache(tsi::SslVerificationCache* cache,
+                                          X509_STORE* store, X509* cert) {
+  X509_STORE_CTX* ctx = X509_STORE_CTX_new();
+  GPR_ASSERT(X509_STORE_CTX_init(ctx, store, cert, nullptr) == 1);
+  int result = cache->Verify(ctx);
+  X509_STORE_CTX_free(ctx);
+  return result;
+}
+
+void ssl_tsi_test_verification_cache() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_verification_cache");
+  X509* root = ssl_tsi_test_load_x509("ca.pem");
+  X509* cert = ssl_tsi_test_load_x509("server1.pem");
+  X509* bad_cert = ssl_tsi_test_load_x509("badserver.pem");
+  X509_STORE* store = X509_STORE_new();
+  X509_STORE_add_cert(store, root);
+  X509_STORE* empty_store = X509_STORE_new();
+  auto cache = grpc_core::MakeRefCounted<tsi::SslVerificationCache>(
+      /*capacity=*/1);
+  // Failed verifications are not remembered.
+  EXPECT_EQ(ssl_tsi_test_verify_with_cache(cache.get(), empty_store, cert), 0);
+  EXPECT_EQ(cache->Size(), 0);
+  EXPECT_EQ(ssl_tsi_test_verify_with_cache(cache.get(), store, cert), 1);
+  EXPECT_EQ(cache->Size(), 1);
+  // The chain is not verified again: the roots are those the cache was
+  // populated with.
+  EXPECT_EQ(ssl_tsi_test_verify_with_cache(cache.get(), empty_store, cert), 1);
+  EXPECT_EQ(ssl_tsi_test_verify_with_cache(cache.get(), store, bad_cert), 0);
+  EXPECT_EQ(cache->Size(), 1);
+  X509_STORE_free(empty_store);
+  X509_STORE_free(store);
+  X509_free(bad_cert);
+  X509_free(cert);
+  X509_free(root);
+}
+#endif
+
 static const tsi_ssl_handshaker_factory_vtable* original_vtable;
 static bool handshaker_factory_destructor_called;
 
@@ -1116,9 +1400,18 @@ TEST(SslTransportSecurityTest, MainTest) {
     ssl_tsi_test_do_handshake_alpn_server_no_client();
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
     ssl_tsi_test_do_handshake_session_cache();
+    ssl_tsi_test_do_handshake_session_ticket_keys();
     ssl_tsi_test_do_round_trip_for_all_configs();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
+#ifdef OPENSSL_IS_BORINGSSL
+    ssl_tsi_test_do_zero_copy_round_trip();
+    ssl_tsi_test_do_handshake_with_private_key_signer(/*async=*/false);
+    ssl_tsi_test_do_handshake_with_private_key_signer(/*async=*/true);
+#endif
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+    ssl_tsi_test_verification_cache();
+#endif
     ssl_tsi_test_handshaker_factory_internals();
     ssl_tsi_test_duplicate_root_certificates();
     ssl_tsi_test_extract_x509_subject_names();
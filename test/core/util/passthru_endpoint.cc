@@ -402,6 +402,7 @@ static const grpc_endpoint_vtable vtable = {
     me_get_local_address,
     me_get_fd,
     me_can_track_err,
+    nullptr,
 };
 
 static void half_init(half* m, passthru_endpoint* parent,
@@ -212,6 +212,36 @@ TEST(XdsBootstrapTest, InsecureCreds) {
   EXPECT_EQ(bootstrap->node(), nullptr);
 }
 
+TEST(XdsBootstrapTest, XdsDeltaServerFeature) {
+  const char* json_str =
+      "{"
+      "  \"xds_servers\": ["
+      "    {"
+      "      \"server_uri\": \"fake:///lb\","
+      "      \"channel_creds\": [{\"type\": \"insecure\"}],"
+      "      \"server_features\": [\"xds_v3\", \"xds_delta\"]"
+      "    }"
+      "  ]"
+      "}";
+  auto bootstrap_or = GrpcXdsBootstrap::Create(json_str);
+  ASSERT_TRUE(bootstrap_or.ok()) << bootstrap_or.status();
+  EXPECT_TRUE((*bootstrap_or)->server().ShouldUseDelta());
+  // Delta is not used without xds_v3.
+  json_str =
+      "{"
+      "  \"xds_servers\": ["
+      "    {"
+      "      \"server_uri\": \"fake:///lb\","
+      "      \"channel_creds\": [{\"type\": \"insecure\"}],"
+      "      \"server_features\": [\"xds_delta\"]"
+      "    }"
+      "  ]"
+      "}";
+  bootstrap_or = GrpcXdsBootstrap::Create(json_str);
+  ASSERT_TRUE(bootstrap_or.ok()) << bootstrap_or.status();
+  EXPECT_FALSE((*bootstrap_or)->server().ShouldUseDelta());
+}
+
 TEST(XdsBootstrapTest, GoogleDefaultCreds) {
   // Generate call creds file needed by GoogleDefaultCreds.
   const char token_str[] =
@@ -20,6 +20,7 @@
 
 #include "src/core/ext/xds/xds_client.h"
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <memory>
@@ -38,6 +39,8 @@
 #include "test/core/util/test_config.h"
 #include "test/core/xds/xds_transport_fake.h"
 
+using envoy::service::discovery::v3::DeltaDiscoveryRequest;
+using envoy::service::discovery::v3::DeltaDiscoveryResponse;
 using envoy::service::discovery::v3::DiscoveryRequest;
 using envoy::service::discovery::v3::DiscoveryResponse;
 
@@ -97,10 +100,12 @@ class XdsClientTest : public ::testing::Test {
       bool IgnoreResourceDeletion() const override {
         return ignore_resource_deletion_;
       }
+      bool ShouldUseDelta() const override { return use_delta_; }
       bool Equals(const XdsServer& other) const override {
         const auto& o = static_cast<const FakeXdsServer&>(other);
         return server_uri_ == o.server_uri_ && use_v3_ == o.use_v3_ &&
-               ignore_resource_deletion_ == o.ignore_resource_deletion_;
+               ignore_resource_deletion_ == o.ignore_resource_deletion_ &&
+               use_delta_ == o.use_delta_;
       }
 
       void set_server_uri(std::string server_uri) {
@@ -110,11 +115,13 @@ class XdsClientTest : public ::testing::Test {
       void set_ignore_resource_deletion(bool ignore_resource_deletion) {
         ignore_resource_deletion_ = ignore_resource_deletion;
       }
+      void set_use_delta(bool use_delta) { use_delta_ = use_delta; }
 
      private:
       std::string server_uri_ = "default_xds_server";
       bool use_v3_ = true;
       bool ignore_resource_deletion_ = false;
+      bool use_delta_ = false;
     };
 
     class FakeAuthority : public Authority {
@@ -139,6 +146,10 @@ class XdsClientTest : public ::testing::Test {
         server_.set_use_v3(false);
         return *this;
       }
+      Builder& set_use_delta() {
+        server_.set_use_delta(true);
+        return *this;
+      }
       Builder& set_node_id(std::string id) {
         if (!node_.has_value()) node_.emplace();
         node_->set_id(std::move(id));
@@ -222,21 +233,31 @@ class XdsClientTest : public ::testing::Test {
       absl::optional<ResourceStruct> WaitForNextResource(
           absl::Duration timeout = absl::Seconds(1),
           SourceLocation location = SourceLocation()) {
+        auto foo = WaitForNextResourceSnapshot(timeout, location);
+        if (foo == nullptr) return absl::nullopt;
+        return *foo;
+      }
+
+      // Returns the resource exactly as delivered by the XdsClient, so that
+      // tests can check which watchers share the same object.
+      std::shared_ptr<const ResourceStruct> WaitForNextResourceSnapshot(
+          absl::Duration timeout = absl::Seconds(1),
+          SourceLocation location = SourceLocation()) {
         MutexLock lock(&mu_);
-        if (!WaitForEventLocked(timeout)) return absl::nullopt;
+        if (!WaitForEventLocked(timeout)) return nullptr;
         Event& event = queue_.front();
-        if (!absl::holds_alternative<ResourceStruct>(event)) {
+        if (!absl::holds_alternative<ResourcePtr>(event)) {
           EXPECT_TRUE(false)
               << "got unexpected event "
               << (absl::holds_alternative<absl::Status>(event)
                       ? "error"
                       : "does-not-exist")
               << " at " << location.file() << ":" << location.line();
-          return absl::nullopt;
+          return nullptr;
         }
-        ResourceStruct foo = std::move(absl::get<ResourceStruct>(event));
+        ResourcePtr foo = std::move(absl::get<ResourcePtr>(event));
         queue_.pop_front();
-        return std::move(foo);
+        return foo;
       }
 
       absl::optional<absl::Status> WaitForNextError(
@@ -248,7 +269,7 @@ class XdsClientTest : public ::testing::Test {
         if (!absl::holds_alternative<absl::Status>(event)) {
           EXPECT_TRUE(false)
               << "got unexpected event "
-              << (absl::holds_alternative<ResourceStruct>(event)
+              << (absl::holds_alternative<ResourcePtr>(event)
                       ? "resource"
                       : "does-not-exist")
               << " at " << location.file() << ":" << location.line();
@@ -267,7 +288,7 @@ class XdsClientTest : public ::testing::Test {
         if (!absl::holds_alternative<DoesNotExist>(event)) {
           EXPECT_TRUE(false)
               << "got unexpected event "
-              << (absl::holds_alternative<ResourceStruct>(event) ? "resource"
+              << (absl::holds_alternative<ResourcePtr>(event) ? "resource"
                                                                  : "error")
               << " at " << location.file() << ":" << location.line();
           return false;
@@ -278,9 +299,10 @@ class XdsClientTest : public ::testing::Test {
 
      private:
       struct DoesNotExist {};
-      using Event = absl::variant<ResourceStruct, absl::Status, DoesNotExist>;
+      using ResourcePtr = std::shared_ptr<const ResourceStruct>;
+      using Event = absl::variant<ResourcePtr, absl::Status, DoesNotExist>;
 
-      void OnResourceChanged(ResourceStruct foo) override {
+      void OnResourceChanged(ResourcePtr foo) override {
         MutexLock lock(&mu_);
         queue_.push_back(std::move(foo));
         cv_.Signal();
@@ -321,6 +343,7 @@ class XdsClientTest : public ::testing::Test {
     XdsResourceType::DecodeResult Decode(
         const XdsResourceType::DecodeContext& /*context*/,
         absl::string_view serialized_resource, bool /*is_v2*/) const override {
+      ++num_decodes_;
       auto json = Json::Parse(serialized_resource);
       XdsResourceType::DecodeResult result;
       if (!json.ok()) {
@@ -354,6 +377,11 @@ class XdsClientTest : public ::testing::Test {
       any.set_value(resource.AsJsonString());
       return any;
     }
+
+    int num_decodes() const { return num_decodes_.load(); }
+
+   private:
+    mutable std::atomic<int> num_decodes_{0};
   };
 
   // A fake "Foo" xDS resource type.
@@ -475,6 +503,42 @@ class XdsClientTest : public ::testing::Test {
     DiscoveryResponse response_;
   };
 
+  // A helper class to build and serialize a DeltaDiscoveryResponse.
+  class DeltaResponseBuilder {
+   public:
+    explicit DeltaResponseBuilder(absl::string_view type_url) {
+      response_.set_type_url(absl::StrCat("type.googleapis.com/", type_url));
+    }
+
+    DeltaResponseBuilder& set_nonce(absl::string_view nonce) {
+      response_.set_nonce(std::string(nonce));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddFooResource(const XdsFooResource& resource,
+                                         absl::string_view version) {
+      auto* res = response_.add_resources();
+      res->set_name(resource.name);
+      res->set_version(std::string(version));
+      *res->mutable_resource() = XdsFooResourceType::EncodeAsAny(resource);
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddRemovedResource(absl::string_view name) {
+      response_.add_removed_resources(std::string(name));
+      return *this;
+    }
+
+    std::string Serialize() {
+      std::string serialized_response;
+      EXPECT_TRUE(response_.SerializeToString(&serialized_response));
+      return serialized_response;
+    }
+
+   private:
+    DeltaDiscoveryResponse response_;
+  };
+
   class ScopedExperimentalEnvVar {
    public:
     explicit ScopedExperimentalEnvVar(const char* env_var) : env_var_(env_var) {
@@ -566,6 +630,22 @@ class XdsClientTest : public ::testing::Test {
     return std::move(request);
   }
 
+  // Gets the latest delta request sent to the fake xDS server.
+  absl::optional<DeltaDiscoveryRequest> WaitForDeltaRequest(
+      FakeXdsTransportFactory::FakeStreamingCall* stream,
+      absl::Duration timeout = absl::Seconds(1),
+      SourceLocation location = SourceLocation()) {
+    auto message =
+        stream->WaitForMessageFromClient(timeout * grpc_test_slowdown_factor());
+    if (!message.has_value()) return absl::nullopt;
+    DeltaDiscoveryRequest request;
+    bool success = request.ParseFromString(*message);
+    EXPECT_TRUE(success) << "Failed to deserialize DeltaDiscoveryRequest at "
+                         << location.file() << ":" << location.line();
+    if (!success) return absl::nullopt;
+    return std::move(request);
+  }
+
   // Helper function to check the fields of a DiscoveryRequest.
   void CheckRequest(const DiscoveryRequest& request, absl::string_view type_url,
                     absl::string_view version_info,
@@ -836,15 +916,13 @@ TEST_F(XdsClientTest, MultipleWatchersForSameResource) {
           .set_nonce("B")
           .AddFooResource(XdsFooResource{"foo1", 9})
           .Serialize());
-  // XdsClient should deliver the response to both watchers.
-  resource = watcher->WaitForNextResource();
-  ASSERT_TRUE(resource.has_value());
-  EXPECT_EQ(resource->name, "foo1");
-  EXPECT_EQ(resource->value, 9);
-  resource = watcher2->WaitForNextResource();
-  ASSERT_TRUE(resource.has_value());
-  EXPECT_EQ(resource->name, "foo1");
-  EXPECT_EQ(resource->value, 9);
+  // XdsClient should deliver the response to both watchers, which share
+  // the same copy of the resource.
+  auto snapshot = watcher->WaitForNextResourceSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->name, "foo1");
+  EXPECT_EQ(snapshot->value, 9);
+  EXPECT_EQ(watcher2->WaitForNextResourceSnapshot(), snapshot);
   // XdsClient should have sent an ACK message to the xDS server.
   request = WaitForRequest(stream.get());
   ASSERT_TRUE(request.has_value());
@@ -1055,6 +1133,131 @@ TEST_F(XdsClientTest, UpdateContainsOnlyChangedResource) {
   }
 }
 
+TEST_F(XdsClientTest, UnchangedResourceNotDecodedAgain) {
+  InitXdsClient();
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server sends foo1.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource{"foo1", 6})
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  const int num_decodes = XdsFooResourceType::Get()->num_decodes();
+  // Server sends the same bytes again, first bare and then in a Resource
+  // wrapper.  Neither is decoded, but both are ACKed.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource{"foo1", 6})
+          .Serialize());
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"2", /*response_nonce=*/"B",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("3")
+          .set_nonce("C")
+          .AddFooResource(XdsFooResource{"foo1", 6},
+                          /*in_resource_wrapper=*/true)
+          .Serialize());
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"3", /*response_nonce=*/"C",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  EXPECT_EQ(XdsFooResourceType::Get()->num_decodes(), num_decodes);
+  EXPECT_FALSE(watcher->HasEvent());
+  // A changed resource is decoded and delivered.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("4")
+          .set_nonce("D")
+          .AddFooResource(XdsFooResource{"foo1", 7})
+          .Serialize());
+  resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 7);
+  EXPECT_EQ(XdsFooResourceType::Get()->num_decodes(), num_decodes + 1);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+// A response large enough to be decoded on several threads is still
+// applied, and its errors reported, in order.
+TEST_F(XdsClientTest, LargeResponse) {
+  constexpr int kNumResources = 200;
+  InitXdsClient();
+  std::vector<std::string> names;
+  std::vector<RefCountedPtr<XdsFooResourceType::Watcher>> watchers;
+  for (int i = 0; i < kNumResources; ++i) {
+    names.push_back(absl::StrCat("foo", i));
+    watchers.push_back(StartFooWatch(names.back()));
+  }
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // Wait for the client to subscribe to all of the resources.
+  absl::optional<DiscoveryRequest> request;
+  do {
+    request = WaitForRequest(stream.get());
+    ASSERT_TRUE(request.has_value());
+  } while (request->resource_names_size() < kNumResources);
+  // Server sends all of them, with an invalid resource at each end.
+  ResponseBuilder response(XdsFooResourceType::Get()->type_url());
+  response.set_version_info("1").set_nonce("A");
+  response.AddInvalidResource(XdsFooResourceType::Get()->type_url(),
+                              "{\"name\":\"bar\",\"value\":[]}");
+  for (int i = 0; i < kNumResources; ++i) {
+    response.AddFooResource(
+        XdsFooResource{names[i], static_cast<uint32_t>(i)});
+  }
+  response.AddInvalidResource(XdsFooResourceType::Get()->type_url(),
+                              "{\"name\":\"baz\",\"value\":[]}");
+  stream->SendMessageToClient(response.Serialize());
+  for (int i = 0; i < kNumResources; ++i) {
+    auto resource = watchers[i]->WaitForNextResource();
+    ASSERT_TRUE(resource.has_value()) << i;
+    EXPECT_EQ(resource->name, names[i]);
+    EXPECT_EQ(resource->value, static_cast<uint32_t>(i));
+  }
+  // XdsClient should NACK the update, listing the errors in order.
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(
+      *request, XdsFooResourceType::Get()->type_url(),
+      /*version_info=*/"", /*response_nonce=*/"A",
+      /*error_detail=*/
+      absl::InvalidArgumentError(absl::StrCat(
+          "xDS response validation errors: ["
+          "resource index 0: bar: INVALID_ARGUMENT: errors validating JSON: "
+          "[field:value error:is not a number]; "
+          "resource index ",
+          kNumResources + 1,
+          ": baz: INVALID_ARGUMENT: errors validating JSON: "
+          "[field:value error:is not a number]]")),
+      /*resource_names=*/{names.begin(), names.end()});
+  for (int i = 0; i < kNumResources; ++i) {
+    CancelFooWatch(watchers[i].get(), names[i]);
+  }
+}
+
 TEST_F(XdsClientTest, ResourceValidationFailure) {
   InitXdsClient();
   // Start a watch for "foo1".
@@ -1894,6 +2097,141 @@ TEST_F(XdsClientTest, BasicWatchV2) {
   }
 }
 
+TEST_F(XdsClientTest, BasicWatchDelta) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta());
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  // XdsClient should have created a delta ADS stream.
+  auto stream = transport_factory_->WaitForStream(
+      xds_client_->bootstrap().server(),
+      FakeXdsTransportFactory::kDeltaAdsMethod,
+      absl::Seconds(5) * grpc_test_slowdown_factor());
+  ASSERT_TRUE(stream != nullptr);
+  // XdsClient should have subscribed to foo1.
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->type_url(),
+            absl::StrCat("type.googleapis.com/",
+                         XdsFooResourceType::Get()->type_url()));
+  EXPECT_THAT(request->resource_names_subscribe(),
+              ::testing::ElementsAre("foo1"));
+  EXPECT_THAT(request->resource_names_unsubscribe(), ::testing::IsEmpty());
+  EXPECT_TRUE(request->initial_resource_versions().empty());
+  EXPECT_EQ(request->response_nonce(), "");
+  EXPECT_EQ(request->node().id(), xds_client_->bootstrap().node()->id());
+  // Server sends foo1 with its own version.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource{"foo1", 6}, "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  // XdsClient should ACK without resending the subscription.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->response_nonce(), "A");
+  EXPECT_FALSE(request->has_error_detail());
+  EXPECT_THAT(request->resource_names_subscribe(), ::testing::IsEmpty());
+  EXPECT_FALSE(request->has_node());
+  // Start a watch for "foo2".  Only the new name is sent.
+  auto watcher2 = StartFooWatch("foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_THAT(request->resource_names_subscribe(),
+              ::testing::ElementsAre("foo2"));
+  // Server sends only foo2; foo1 must not be treated as deleted.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource{"foo2", 7}, "v1")
+          .Serialize());
+  resource = watcher2->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo2");
+  EXPECT_EQ(resource->value, 7);
+  EXPECT_FALSE(watcher->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->response_nonce(), "B");
+  // Server removes foo2.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("C")
+          .AddRemovedResource("foo2")
+          .Serialize());
+  EXPECT_TRUE(watcher2->WaitForDoesNotExist(absl::Seconds(1)));
+  EXPECT_FALSE(watcher->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->response_nonce(), "C");
+  // Cancelling the watch for foo2 unsubscribes only foo2.
+  CancelFooWatch(watcher2.get(), "foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_THAT(request->resource_names_subscribe(), ::testing::IsEmpty());
+  EXPECT_THAT(request->resource_names_unsubscribe(),
+              ::testing::ElementsAre("foo2"));
+  // Server closes the stream.  The new stream re-subscribes to foo1 and
+  // tells the server which version of it we already have.
+  stream->MaybeSendStatusToClient(absl::OkStatus());
+  EXPECT_TRUE(watcher->WaitForNextError().has_value());
+  stream = transport_factory_->WaitForStream(
+      xds_client_->bootstrap().server(),
+      FakeXdsTransportFactory::kDeltaAdsMethod,
+      absl::Seconds(5) * grpc_test_slowdown_factor());
+  ASSERT_TRUE(stream != nullptr);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_THAT(request->resource_names_subscribe(),
+              ::testing::ElementsAre("foo1"));
+  EXPECT_THAT(request->initial_resource_versions(),
+              ::testing::ElementsAre(::testing::Pair("foo1", "v1")));
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaFallsBackToSotwWhenUnimplemented) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta());
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  // XdsClient should have created a delta ADS stream.
+  auto stream = transport_factory_->WaitForStream(
+      xds_client_->bootstrap().server(),
+      FakeXdsTransportFactory::kDeltaAdsMethod,
+      absl::Seconds(5) * grpc_test_slowdown_factor());
+  ASSERT_TRUE(stream != nullptr);
+  ASSERT_TRUE(WaitForDeltaRequest(stream.get()).has_value());
+  // Server doesn't implement delta ADS.
+  stream->MaybeSendStatusToClient(
+      absl::UnimplementedError("DeltaAggregatedResources"));
+  EXPECT_TRUE(watcher->WaitForNextError().has_value());
+  // XdsClient should retry with a SotW stream.
+  stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"", /*response_nonce=*/"",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  CheckRequestNode(*request);  // Should be present on the first request.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource{"foo1", 6})
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
 TEST_F(XdsClientTest, Federation) {
   ScopedExperimentalEnvVar env_var("GRPC_EXPERIMENTAL_XDS_FEDERATION");
   constexpr char kAuthority[] = "xds.example.com";
@@ -0,0 +1,189 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_filter_chain_index.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using FilterChainMap = XdsListenerResource::FilterChainMap;
+using ConnectionSourceType = FilterChainMap::ConnectionSourceType;
+
+grpc_resolved_address Address(absl::string_view ip) {
+  return *StringToSockaddr(ip, 0);
+}
+
+absl::optional<FilterChainMap::CidrRange> Range(absl::string_view ip,
+                                                uint32_t prefix_len) {
+  FilterChainMap::CidrRange range;
+  range.address = Address(ip);
+  range.prefix_len = prefix_len;
+  grpc_sockaddr_mask_bits(&range.address, prefix_len);
+  return range;
+}
+
+// Builds filter chain maps, keeping the filter chain of each entry so
+// that the tests can tell which entry matched.
+class FilterChainMapBuilder {
+ public:
+  // Adds a destination entry and returns its index.
+  size_t AddDestination(absl::optional<FilterChainMap::CidrRange> range) {
+    map_.destination_ip_vector.emplace_back();
+    map_.destination_ip_vector.back().prefix_range = std::move(range);
+    return map_.destination_ip_vector.size() - 1;
+  }
+
+  // Adds a source entry with one port to a destination entry, returning
+  // the filter chain it maps to.
+  const XdsListenerResource::FilterChainData* AddSource(
+      size_t destination, ConnectionSourceType type,
+      absl::optional<FilterChainMap::CidrRange> range, uint16_t port = 0) {
+    auto& source_ips = map_.destination_ip_vector[destination]
+                           .source_types_array[static_cast<int>(type)];
+    source_ips.emplace_back();
+    source_ips.back().prefix_range = std::move(range);
+    auto data = std::make_shared<XdsListenerResource::FilterChainData>();
+    source_ips.back().ports_map[port].data = data;
+    return data.get();
+  }
+
+  const FilterChainMap& map() const { return map_; }
+
+ private:
+  FilterChainMap map_;
+};
+
+TEST(XdsFilterChainIndexTest, PicksLongestDestinationPrefix) {
+  FilterChainMapBuilder builder;
+  const auto* any = builder.AddSource(builder.AddDestination(absl::nullopt),
+                                      ConnectionSourceType::kAny,
+                                      absl::nullopt);
+  const auto* wide =
+      builder.AddSource(builder.AddDestination(Range("10.0.0.0", 8)),
+                        ConnectionSourceType::kAny, absl::nullopt);
+  const auto* narrow =
+      builder.AddSource(builder.AddDestination(Range("10.1.0.0", 16)),
+                        ConnectionSourceType::kAny, absl::nullopt);
+  XdsFilterChainIndex index(builder.map());
+  const grpc_resolved_address source = Address("192.168.0.1");
+  EXPECT_EQ(index.Find(Address("10.1.2.3"), source, 1234), narrow);
+  EXPECT_EQ(index.Find(Address("10.2.2.3"), source, 1234), wide);
+  EXPECT_EQ(index.Find(Address("11.0.0.1"), source, 1234), any);
+  EXPECT_EQ(index.Find(Address("::1"), source, 1234), any);
+}
+
+TEST(XdsFilterChainIndexTest, NoMatchWithoutCatchAll) {
+  FilterChainMapBuilder builder;
+  builder.AddSource(builder.AddDestination(Range("10.0.0.0", 8)),
+                    ConnectionSourceType::kAny, Range("192.168.0.0", 16));
+  XdsFilterChainIndex index(builder.map());
+  EXPECT_EQ(index.Find(Address("11.0.0.1"), Address("192.168.0.1"), 1234),
+            nullptr);
+  EXPECT_EQ(index.Find(Address("10.0.0.1"), Address("192.169.0.1"), 1234),
+            nullptr);
+  EXPECT_NE(index.Find(Address("10.0.0.1"), Address("192.168.0.1"), 1234),
+            nullptr);
+}
+
+TEST(XdsFilterChainIndexTest, PicksLongestSourcePrefix) {
+  FilterChainMapBuilder builder;
+  const size_t destination = builder.AddDestination(absl::nullopt);
+  const auto* any = builder.AddSource(destination, ConnectionSourceType::kAny,
+                                      absl::nullopt);
+  const auto* wide = builder.AddSource(
+      destination, ConnectionSourceType::kAny, Range("2001:db8::", 32));
+  const auto* narrow = builder.AddSource(
+      destination, ConnectionSourceType::kAny, Range("2001:db8:1::", 48));
+  const auto* host = builder.AddSource(
+      destination, ConnectionSourceType::kAny, Range("2001:db8:1::7", 128));
+  XdsFilterChainIndex index(builder.map());
+  const grpc_resolved_address dest = Address("2001:db8::1");
+  EXPECT_EQ(index.Find(dest, Address("2001:db8:1::7"), 1), host);
+  EXPECT_EQ(index.Find(dest, Address("2001:db8:1::8"), 1), narrow);
+  EXPECT_EQ(index.Find(dest, Address("2001:db8:2::8"), 1), wide);
+  EXPECT_EQ(index.Find(dest, Address("2001:db9::8"), 1), any);
+  EXPECT_EQ(index.Find(dest, Address("10.0.0.1"), 1), any);
+}
+
+TEST(XdsFilterChainIndexTest, KeepsFirstOfDuplicateRanges) {
+  FilterChainMapBuilder builder;
+  const size_t destination = builder.AddDestination(absl::nullopt);
+  const auto* first = builder.AddSource(
+      destination, ConnectionSourceType::kAny, Range("10.0.0.0", 8));
+  builder.AddSource(destination, ConnectionSourceType::kAny,
+                    Range("10.0.0.0", 8));
+  XdsFilterChainIndex index(builder.map());
+  EXPECT_EQ(index.Find(Address("1.2.3.4"), Address("10.0.0.1"), 1), first);
+}
+
+TEST(XdsFilterChainIndexTest, SelectsSourceType) {
+  FilterChainMapBuilder builder;
+  const size_t destination = builder.AddDestination(absl::nullopt);
+  const auto* local = builder.AddSource(
+      destination, ConnectionSourceType::kSameIpOrLoopback, absl::nullopt);
+  const auto* external = builder.AddSource(
+      destination, ConnectionSourceType::kExternal, absl::nullopt);
+  builder.AddSource(destination, ConnectionSourceType::kAny, absl::nullopt);
+  XdsFilterChainIndex index(builder.map());
+  const grpc_resolved_address dest = Address("10.0.0.1");
+  EXPECT_EQ(index.Find(dest, Address("127.0.0.1"), 1), local);
+  EXPECT_EQ(index.Find(dest, Address("::1"), 1), local);
+  EXPECT_EQ(index.Find(dest, Address("10.0.0.1"), 1), local);
+  EXPECT_EQ(index.Find(dest, Address("10.0.0.2"), 1), external);
+}
+
+TEST(XdsFilterChainIndexTest, UsesAnySourceTypeOnlyWhenAlone) {
+  FilterChainMapBuilder builder;
+  const size_t destination = builder.AddDestination(absl::nullopt);
+  const auto* any = builder.AddSource(destination, ConnectionSourceType::kAny,
+                                      absl::nullopt);
+  XdsFilterChainIndex index(builder.map());
+  EXPECT_EQ(index.Find(Address("10.0.0.1"), Address("127.0.0.1"), 1), any);
+  EXPECT_EQ(index.Find(Address("10.0.0.1"), Address("10.0.0.2"), 1), any);
+}
+
+TEST(XdsFilterChainIndexTest, MatchesSourcePort) {
+  FilterChainMapBuilder builder;
+  const size_t destination = builder.AddDestination(absl::nullopt);
+  const auto* port_443 = builder.AddSource(
+      destination, ConnectionSourceType::kAny, Range("10.0.0.0", 8), 443);
+  XdsFilterChainIndex index(builder.map());
+  const grpc_resolved_address dest = Address("1.2.3.4");
+  const grpc_resolved_address source = Address("10.0.0.1");
+  EXPECT_EQ(index.Find(dest, source, 443), port_443);
+  EXPECT_EQ(index.Find(dest, source, 444), nullptr);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/matchers/matchers.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class VirtualHostList : public XdsRouting::VirtualHostListIterator {
+ public:
+  explicit VirtualHostList(std::vector<std::vector<std::string>> domains)
+      : domains_(std::move(domains)) {}
+
+  size_t Size() const override { return domains_.size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return domains_[index];
+  }
+
+ private:
+  std::vector<std::vector<std::string>> domains_;
+};
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  void Add(StringMatcher::Type type, absl::string_view path,
+           bool case_sensitive = true) {
+    XdsRouteConfigResource::Route::Matchers matchers;
+    matchers.path_matcher =
+        StringMatcher::Create(type, path, case_sensitive).value();
+    matchers_.push_back(std::move(matchers));
+  }
+
+  size_t Size() const override { return matchers_.size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return matchers_[index];
+  }
+
+ private:
+  std::vector<XdsRouteConfigResource::Route::Matchers> matchers_;
+};
+
+TEST(VirtualHostIndexTest, MatchesLinearSearch) {
+  VirtualHostList vhosts({
+      {"*"},
+      {"foo.*", "*.example.com"},
+      {"*.com"},
+      {"Foo.Example.Com", "bar.example.com"},
+      {"foo.example.*"},
+      {"foo.example.com"},
+      {"*.EXAMPLE.com"},
+  });
+  XdsRouting::VirtualHostIndex index(vhosts);
+  for (absl::string_view domain :
+       {"foo.example.com", "FOO.EXAMPLE.COM", "bar.example.com",
+        "baz.example.com", "foo.example.org", "foo.bar", "x.com", "other",
+        ".com", "example.com"}) {
+    EXPECT_EQ(index.Find(domain),
+              XdsRouting::FindVirtualHostForDomain(vhosts, domain))
+        << domain;
+  }
+}
+
+TEST(VirtualHostIndexTest, NoMatch) {
+  VirtualHostList vhosts({{"foo.example.com"}, {"*.example.org"}});
+  XdsRouting::VirtualHostIndex index(vhosts);
+  EXPECT_EQ(index.Find("foo.example.org"), 1);
+  EXPECT_FALSE(index.Find("bar.example.com").has_value());
+}
+
+TEST(RouteIndexTest, FirstMatchingRouteWins) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kExact, "/pkg.Service/Exact");
+  routes.Add(StringMatcher::Type::kPrefix, "/pkg.Service/");
+  routes.Add(StringMatcher::Type::kSafeRegex, "/pkg\\.Other/.*");
+  routes.Add(StringMatcher::Type::kExact, "/pkg.Other/Exact");
+  routes.Add(StringMatcher::Type::kPrefix, "/pkg.other/", false);
+  routes.Add(StringMatcher::Type::kExact, "/pkg.Service/Method");
+  routes.Add(StringMatcher::Type::kPrefix, "/pkg.");
+  routes.Add(StringMatcher::Type::kPrefix, "");
+  XdsRouting::RouteIndex index(routes);
+  for (absl::string_view path :
+       {"/pkg.Service/Exact", "/pkg.Service/Method", "/pkg.Other/Exact",
+        "/PKG.OTHER/Method", "/pkg.Third/Method", "/other/Method", "",
+        "/pkg"}) {
+    EXPECT_EQ(index.GetRouteForRequest(routes, path, nullptr),
+              XdsRouting::GetRouteForRequest(routes, path, nullptr))
+        << path;
+  }
+  EXPECT_EQ(index.GetRouteForRequest(routes, "/pkg.Service/Method", nullptr),
+            1);
+  EXPECT_EQ(index.GetRouteForRequest(routes, "/PKG.OTHER/Method", nullptr), 4);
+  EXPECT_EQ(index.GetRouteForRequest(routes, "/other/Method", nullptr), 7);
+}
+
+TEST(RouteIndexTest, ManyRoutes) {
+  RouteList routes;
+  for (int i = 0; i < 1000; ++i) {
+    routes.Add(StringMatcher::Type::kExact,
+               absl::StrCat("/pkg.Service", i, "/Method"));
+    routes.Add(StringMatcher::Type::kPrefix,
+               absl::StrCat("/pkg.Service", i, "/"));
+  }
+  XdsRouting::RouteIndex index(routes);
+  EXPECT_EQ(index.GetRouteForRequest(routes, "/pkg.Service123/Method", nullptr),
+            246);
+  EXPECT_EQ(index.GetRouteForRequest(routes, "/pkg.Service123/Other", nullptr),
+            247);
+  EXPECT_FALSE(index.GetRouteForRequest(routes, "/pkg.Other/Method", nullptr)
+                   .has_value());
+}
+
+TEST(RouteIndexTest, NoRoutes) {
+  RouteList routes;
+  XdsRouting::RouteIndex index(routes);
+  EXPECT_FALSE(index.GetRouteForRequest(routes, "/pkg.Service/Method", nullptr)
+                   .has_value());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
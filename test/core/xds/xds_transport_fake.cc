@@ -190,6 +190,7 @@ FakeXdsTransportFactory::FakeXdsTransport::CreateStreamingCall(
 
 constexpr char FakeXdsTransportFactory::kAdsMethod[];
 constexpr char FakeXdsTransportFactory::kAdsV2Method[];
+constexpr char FakeXdsTransportFactory::kDeltaAdsMethod[];
 
 OrphanablePtr<XdsTransportFactory::XdsTransport>
 FakeXdsTransportFactory::Create(
@@ -46,6 +46,9 @@ class FakeXdsTransportFactory : public XdsTransportFactory {
   static constexpr char kAdsV2Method[] =
       "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
       "StreamAggregatedResources";
+  static constexpr char kDeltaAdsMethod[] =
+      "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+      "DeltaAggregatedResources";
 
   class FakeStreamingCall : public XdsTransport::StreamingCall {
    public:
@@ -16,6 +16,10 @@
  *
  */
 
+#include <string>
+#include <vector>
+
+#include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
 #include <grpc/impl/codegen/byte_buffer.h>
@@ -89,6 +93,38 @@ TEST_F(ProtoUtilsTest, TinyBackupThenNext) {
   EXPECT_EQ(block_size, size);
 }
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+// A cord field spanning slices refers to them, and what follows it is read
+// from where it ends.
+TEST_F(ProtoUtilsTest, ReadCordAcrossSlices) {
+  const std::string first(4096, 'a');
+  const std::string second(8192, 'b');
+  Slice slices[] = {Slice(first), Slice(second)};
+  ByteBuffer bb(slices, 2);
+  ProtoBufferReader reader(&bb);
+
+  const void* data;
+  int size;
+  ASSERT_TRUE(reader.Next(&data, &size));
+  ASSERT_EQ(size, 4096);
+  reader.BackUp(1000);
+  absl::Cord cord;
+  ASSERT_TRUE(reader.ReadCord(&cord, 3000));
+  EXPECT_EQ(cord, first.substr(3096) + second.substr(0, 2000));
+  EXPECT_EQ(reader.ByteCount(), 6096);
+  auto chunk = cord.chunk_begin();
+  EXPECT_EQ(chunk->data(),
+            reinterpret_cast<const char*>(slices[0].begin()) + 3096);
+  ++chunk;
+  EXPECT_EQ(chunk->data(), reinterpret_cast<const char*>(slices[1].begin()));
+
+  ASSERT_TRUE(reader.Next(&data, &size));
+  EXPECT_EQ(data, slices[1].begin() + 2000);
+  EXPECT_EQ(size, 6192);
+  EXPECT_FALSE(reader.ReadCord(&cord, 1));
+}
+#endif
+
 namespace {
 
 // Set backup_size to 0 to indicate no backup is needed.
@@ -185,6 +221,82 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+TEST_F(WriterTest, AliasedWriteIsNotCopied) {
+  const std::string aliased(4096, 'a');
+  ByteBuffer bb;
+  ProtoBufferWriter writer(&bb, 1024, 8 + aliased.size() + 8);
+  void* data;
+  int size;
+  ASSERT_TRUE(writer.Next(&data, &size));
+  memset(data, 'x', 8);
+  writer.BackUp(size - 8);
+  ASSERT_TRUE(writer.WriteAliasedRaw(aliased.data(), aliased.size()));
+  ASSERT_TRUE(writer.Next(&data, &size));
+  ASSERT_GE(size, 8);
+  memset(data, 'y', 8);
+  writer.BackUp(size - 8);
+  EXPECT_EQ(writer.ByteCount(), 8 + aliased.size() + 8);
+
+  std::vector<Slice> slices;
+  ASSERT_TRUE(bb.Dump(&slices).ok());
+  ASSERT_EQ(slices.size(), size_t{3});
+  EXPECT_EQ(slices[0].size(), size_t{8});
+  EXPECT_EQ(slices[1].begin(),
+            reinterpret_cast<const uint8_t*>(aliased.data()));
+  EXPECT_EQ(slices[1].size(), aliased.size());
+  EXPECT_EQ(slices[2].size(), size_t{8});
+}
+
+std::string Flatten(ByteBuffer* bb) {
+  std::vector<Slice> slices;
+  EXPECT_TRUE(bb->Dump(&slices).ok());
+  std::string out;
+  for (const Slice& slice : slices) {
+    out.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+  }
+  return out;
+}
+
+class SerializeTest : public WriterTest {
+ protected:
+  SerializeTest() { msg_.set_value(std::string(2 * 1024 * 1024, 'v')); }
+
+  ::google::protobuf::BytesValue msg_;
+};
+
+TEST_F(SerializeTest, Exact) {
+  ByteBuffer bb;
+  bool own_buffer;
+  ASSERT_TRUE(GenericSerializeExact(msg_, &bb, &own_buffer).ok());
+  std::vector<Slice> slices;
+  ASSERT_TRUE(bb.Dump(&slices).ok());
+  ASSERT_EQ(slices.size(), size_t{1});
+  EXPECT_EQ(slices[0].size(), msg_.ByteSizeLong());
+  EXPECT_EQ(Flatten(&bb), msg_.SerializeAsString());
+}
+
+TEST_F(SerializeTest, Aliased) {
+  ByteBuffer bb;
+  bool own_buffer;
+  ASSERT_TRUE(
+      GenericSerializeAliased<ProtoBufferWriter>(msg_, &bb, &own_buffer).ok());
+  EXPECT_EQ(Flatten(&bb), msg_.SerializeAsString());
+  std::vector<Slice> slices;
+  ASSERT_TRUE(bb.Dump(&slices).ok());
+  bool found_alias = false;
+  for (const Slice& slice : slices) {
+    found_alias |= slice.begin() ==
+                   reinterpret_cast<const uint8_t*>(msg_.value().data());
+  }
+  EXPECT_TRUE(found_alias);
+
+  ::google::protobuf::BytesValue parsed;
+  ASSERT_TRUE(SerializationTraits<::google::protobuf::BytesValue>::Deserialize(
+                  &bb, &parsed)
+                  .ok());
+  EXPECT_EQ(parsed.value(), msg_.value());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -283,6 +284,33 @@ TEST(AlarmTest, Cancellation) {
   EXPECT_EQ(junk, output_tag);
 }
 
+TEST(AlarmTest, NextBatch) {
+  constexpr size_t kNumAlarms = 8;
+  constexpr size_t kBatchSize = 3;
+  CompletionQueue cq;
+  Alarm alarms[kNumAlarms];
+  for (size_t i = 0; i < kNumAlarms; i++) {
+    alarms[i].Set(&cq, grpc_timeout_seconds_to_deadline(0),
+                  reinterpret_cast<void*>(i + 1));
+  }
+
+  std::set<void*> seen;
+  void* tags[kBatchSize];
+  bool oks[kBatchSize];
+  while (seen.size() < kNumAlarms) {
+    size_t n = cq.NextBatch(tags, oks, kBatchSize);
+    ASSERT_GT(n, 0);
+    ASSERT_LE(n, kBatchSize);
+    for (size_t i = 0; i < n; i++) {
+      EXPECT_TRUE(oks[i]);
+      EXPECT_TRUE(seen.insert(tags[i]).second);
+    }
+  }
+
+  cq.Shutdown();
+  EXPECT_EQ(cq.NextBatch(tags, oks, kBatchSize), 0);
+}
+
 TEST(AlarmTest, CallbackCancellation) {
   Alarm alarm;
 
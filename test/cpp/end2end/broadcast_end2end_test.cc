@@ -0,0 +1,231 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/server_callback.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr int kNumWrites = 3;
+constexpr int kNumSubscribers = 10;
+
+ByteBuffer Serialize(const EchoResponse& response) {
+  ByteBuffer buffer;
+  bool own_buffer;
+  EXPECT_TRUE(SerializationTraits<EchoResponse>::Serialize(response, &buffer,
+                                                           &own_buffer)
+                  .ok());
+  return buffer;
+}
+
+// Writes the same serialized responses to every stream: synchronously to
+// server streams, and to the bidi streams subscribed with a first request.
+class BroadcastServiceImpl
+    : public EchoTestService::WithCallbackMethod_BidiStream<
+          EchoTestService::Service> {
+ public:
+  explicit BroadcastServiceImpl(const EchoResponse& response)
+      : serialized_(Serialize(response)) {
+    EXPECT_TRUE(serialized_.Compress(GRPC_COMPRESS_GZIP, &compressed_).ok());
+    EXPECT_LT(compressed_.Length(), serialized_.Length());
+  }
+
+  Status ResponseStream(ServerContext* context, const EchoRequest* request,
+                        ServerWriter<EchoResponse>* writer) override {
+    const ByteBuffer* message = &serialized_;
+    if (request->message() == "compressed") {
+      context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+      message = &compressed_;
+    }
+    for (int i = 0; i < kNumWrites; ++i) {
+      if (!writer->WriteSerialized(*message)) break;
+    }
+    return Status::OK;
+  }
+
+  ServerBidiReactor<EchoRequest, EchoResponse>* BidiStream(
+      CallbackServerContext* /*context*/) override {
+    return new Subscriber(this);
+  }
+
+  void WaitForSubscribers(size_t count) {
+    internal::MutexLock lock(&mu_);
+    while (subscribers_.size() < count) cv_.Wait(&mu_);
+  }
+
+  // Writes the one serialized response to every subscriber.
+  void Broadcast() {
+    internal::MutexLock lock(&mu_);
+    for (Subscriber* subscriber : subscribers_) {
+      subscriber->StartWriteSerialized(serialized_);
+    }
+  }
+
+ private:
+  class Subscriber : public ServerBidiReactor<EchoRequest, EchoResponse> {
+   public:
+    explicit Subscriber(BroadcastServiceImpl* service) : service_(service) {
+      StartRead(&request_);
+    }
+
+    void OnReadDone(bool ok) override {
+      if (!ok) {
+        Finish(Status::OK);
+        return;
+      }
+      service_->Subscribe(this);
+      StartRead(&request_);
+    }
+
+    void OnDone() override {
+      service_->Unsubscribe(this);
+      delete this;
+    }
+
+   private:
+    BroadcastServiceImpl* const service_;
+    EchoRequest request_;
+  };
+
+  void Subscribe(Subscriber* subscriber) {
+    internal::MutexLock lock(&mu_);
+    subscribers_.insert(subscriber);
+    cv_.SignalAll();
+  }
+
+  void Unsubscribe(Subscriber* subscriber) {
+    internal::MutexLock lock(&mu_);
+    subscribers_.erase(subscriber);
+  }
+
+  const ByteBuffer serialized_;
+  ByteBuffer compressed_;
+  internal::Mutex mu_;
+  internal::CondVar cv_;
+  std::set<Subscriber*> subscribers_ ABSL_GUARDED_BY(mu_);
+};
+
+class BroadcastEnd2endTest : public ::testing::Test {
+ protected:
+  BroadcastEnd2endTest() : service_(MakeResponse()) {}
+
+  static EchoResponse MakeResponse() {
+    EchoResponse response;
+    response.set_message(std::string(64 * 1024, 'a'));
+    return response;
+  }
+
+  void SetUp() override {
+    int port = grpc_pick_unused_port_or_die();
+    server_address_ << "localhost:" << port;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    stub_ = EchoTestService::NewStub(grpc::CreateChannel(
+        server_address_.str(), InsecureChannelCredentials()));
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  void CheckResponseStream(const std::string& message) {
+    ClientContext context;
+    EchoRequest request;
+    request.set_message(message);
+    auto stream = stub_->ResponseStream(&context, request);
+    EchoResponse response;
+    int reads = 0;
+    while (stream->Read(&response)) {
+      EXPECT_EQ(response.message(), MakeResponse().message());
+      ++reads;
+    }
+    EXPECT_EQ(reads, kNumWrites);
+    EXPECT_TRUE(stream->Finish().ok());
+  }
+
+  std::ostringstream server_address_;
+  BroadcastServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(BroadcastEnd2endTest, WritesSerializedMessages) {
+  CheckResponseStream("");
+}
+
+TEST_F(BroadcastEnd2endTest, WritesCompressedMessages) {
+  CheckResponseStream("compressed");
+}
+
+TEST_F(BroadcastEnd2endTest, BroadcastsToSubscribers) {
+  std::vector<std::unique_ptr<ClientContext>> contexts;
+  std::vector<std::unique_ptr<ClientReaderWriter<EchoRequest, EchoResponse>>>
+      streams;
+  for (int i = 0; i < kNumSubscribers; ++i) {
+    contexts.push_back(absl::make_unique<ClientContext>());
+    streams.push_back(stub_->BidiStream(contexts.back().get()));
+    ASSERT_TRUE(streams.back()->Write(EchoRequest()));
+  }
+  service_.WaitForSubscribers(kNumSubscribers);
+  service_.Broadcast();
+  for (auto& stream : streams) {
+    EchoResponse response;
+    ASSERT_TRUE(stream->Read(&response));
+    EXPECT_EQ(response.message(), MakeResponse().message());
+    stream->WritesDone();
+    EXPECT_FALSE(stream->Read(&response));
+    EXPECT_TRUE(stream->Finish().ok());
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
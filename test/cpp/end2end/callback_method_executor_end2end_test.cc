@@ -0,0 +1,240 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/callback_method_executor.h>
+#include <grpcpp/support/client_callback.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Records the order in which handlers start and how many run at once. A
+// handler whose message is "block" does not return until Unblock().
+class RecordingService : public EchoTestService::CallbackService {
+ public:
+  ServerUnaryReactor* Echo(CallbackServerContext* context,
+                           const EchoRequest* request,
+                           EchoResponse* response) override {
+    return Handle(context, request, response);
+  }
+
+  ServerUnaryReactor* Echo1(CallbackServerContext* context,
+                            const EchoRequest* request,
+                            EchoResponse* response) override {
+    return Handle(context, request, response);
+  }
+
+  void WaitForBlocked() {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [this] { return blocked_; });
+  }
+
+  void Unblock() {
+    std::lock_guard<std::mutex> lock(mu_);
+    unblocked_ = true;
+    cv_.notify_all();
+  }
+
+  std::vector<std::string> started() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return started_;
+  }
+
+  int max_running() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return max_running_;
+  }
+
+ private:
+  ServerUnaryReactor* Handle(CallbackServerContext* context,
+                             const EchoRequest* request,
+                             EchoResponse* response) {
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      started_.push_back(request->message());
+      max_running_ = std::max(max_running_, ++running_);
+      if (request->message() == "block") {
+        blocked_ = true;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return unblocked_; });
+      }
+    }
+    if (request->param().server_sleep_us() > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(request->param().server_sleep_us()));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      --running_;
+    }
+    response->set_message(request->message());
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(Status::OK);
+    return reactor;
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool blocked_ = false;
+  bool unblocked_ = false;
+  std::vector<std::string> started_;
+  int running_ = 0;
+  int max_running_ = 0;
+};
+
+class CallbackMethodExecutorEnd2endTest : public ::testing::Test {
+ protected:
+  void StartServer() {
+    server_ = builder_.BuildAndStart();
+    ASSERT_NE(server_, nullptr);
+    stub_ = EchoTestService::NewStub(
+        server_->InProcessChannel(ChannelArguments()));
+  }
+
+  void TearDown() override {
+    if (server_ != nullptr) server_->Shutdown();
+  }
+
+  // Counts down as the RPCs started by StartEcho complete.
+  class Calls {
+   public:
+    void Started() {
+      std::lock_guard<std::mutex> lock(mu_);
+      ++outstanding_;
+    }
+
+    void Done(const Status& status) {
+      EXPECT_TRUE(status.ok()) << status.error_message();
+      std::lock_guard<std::mutex> lock(mu_);
+      --outstanding_;
+      cv_.notify_all();
+    }
+
+    void Wait() {
+      std::unique_lock<std::mutex> lock(mu_);
+      cv_.wait(lock, [this] { return outstanding_ == 0; });
+    }
+
+   private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    int outstanding_ = 0;
+  };
+
+  struct Call {
+    ClientContext context;
+    EchoRequest request;
+    EchoResponse response;
+  };
+
+  void StartEcho(bool echo1, const std::string& message, int server_sleep_us) {
+    calls_.push_back(absl::make_unique<Call>());
+    Call* call = calls_.back().get();
+    call->request.set_message(message);
+    call->request.mutable_param()->set_server_sleep_us(server_sleep_us);
+    pending_.Started();
+    auto on_done = [this](Status status) { pending_.Done(status); };
+    if (echo1) {
+      stub_->async()->Echo1(&call->context, &call->request, &call->response,
+                            on_done);
+    } else {
+      stub_->async()->Echo(&call->context, &call->request, &call->response,
+                           on_done);
+    }
+  }
+
+  ServerBuilder builder_;
+  RecordingService service_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+  std::vector<std::unique_ptr<Call>> calls_;
+  Calls pending_;
+};
+
+TEST_F(CallbackMethodExecutorEnd2endTest, ConcurrencyIsCapped) {
+  const int kRpcCount = 8;
+  builder_.RegisterService(&service_);
+  builder_.experimental().SetCallbackMethodExecutor(
+      "grpc.testing.EchoTestService",
+      std::make_shared<experimental::CallbackMethodExecutor>(4),
+      /*priority=*/0, /*max_concurrency=*/2);
+  StartServer();
+  for (int i = 0; i < kRpcCount; i++) {
+    StartEcho(/*echo1=*/false, std::to_string(i), 20 * 1000);
+  }
+  pending_.Wait();
+  EXPECT_EQ(service_.started().size(), static_cast<size_t>(kRpcCount));
+  EXPECT_LE(service_.max_running(), 2);
+}
+
+TEST_F(CallbackMethodExecutorEnd2endTest, HigherPriorityStartsFirst) {
+  auto executor = std::make_shared<experimental::CallbackMethodExecutor>(1);
+  builder_.RegisterService(&service_);
+  builder_.experimental().SetCallbackMethodExecutor(
+      "grpc.testing.EchoTestService", executor, /*priority=*/0);
+  // The method entry takes precedence over the service entry.
+  builder_.experimental().SetCallbackMethodExecutor(
+      "/grpc.testing.EchoTestService/Echo1", executor, /*priority=*/1);
+  StartServer();
+  // Occupy the only thread, then queue low priority work behind it.
+  StartEcho(/*echo1=*/false, "block", 0);
+  service_.WaitForBlocked();
+  for (int i = 0; i < 3; i++) {
+    StartEcho(/*echo1=*/false, "batch", 0);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  StartEcho(/*echo1=*/true, "critical", 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  service_.Unblock();
+  pending_.Wait();
+  std::vector<std::string> started = service_.started();
+  ASSERT_EQ(started.size(), 5u);
+  EXPECT_EQ(started[0], "block");
+  EXPECT_EQ(started[1], "critical");
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
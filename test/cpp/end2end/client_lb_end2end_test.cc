@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstdlib>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,8 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 
 #include <grpc/event_engine/endpoint_config.h>
 #include <grpc/grpc.h>
@@ -91,17 +94,25 @@ class MyTestServiceImpl : public TestServiceImpl {
  public:
   Status Echo(ServerContext* context, const EchoRequest* request,
               EchoResponse* response) override {
+    int sleep_ms;
     {
       grpc_core::MutexLock lock(&mu_);
       ++request_count_;
+      sleep_ms = sleep_ms_;
     }
     AddClient(context->peer());
+    if (sleep_ms > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(sleep_ms));
+    }
     if (request->has_param() && request->param().has_backend_metrics()) {
       load_report_ = request->param().backend_metrics();
       auto* recorder = context->ExperimentalGetCallMetricRecorder();
       EXPECT_NE(recorder, nullptr);
       recorder->RecordCpuUtilizationMetric(load_report_.cpu_utilization())
           .RecordMemoryUtilizationMetric(load_report_.mem_utilization());
+      if (load_report_.rps() != 0) {
+        recorder->RecordQpsMetric(load_report_.rps());
+      }
       for (const auto& p : load_report_.request_cost()) {
         recorder->RecordRequestCostMetric(p.first, p.second);
       }
@@ -122,6 +133,12 @@ class MyTestServiceImpl : public TestServiceImpl {
     request_count_ = 0;
   }
 
+  // Delays every Echo RPC by sleep_ms.
+  void set_sleep_ms(int sleep_ms) {
+    grpc_core::MutexLock lock(&mu_);
+    sleep_ms_ = sleep_ms;
+  }
+
   std::set<std::string> clients() {
     grpc_core::MutexLock lock(&clients_mu_);
     return clients_;
@@ -135,6 +152,7 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   grpc_core::Mutex mu_;
   int request_count_ = 0;
+  int sleep_ms_ = 0;
   grpc_core::Mutex clients_mu_;
   std::set<std::string> clients_;
   // For strings storage.
@@ -402,6 +420,8 @@ class ClientLbEnd2endTest : public ::testing::Test {
     grpc_core::CondVar cond_;
     bool server_ready_ ABSL_GUARDED_BY(mu_) = false;
     bool started_ ABSL_GUARDED_BY(mu_) = false;
+    // Set before Start() to have the server measure CPU metrics.
+    bool record_cpu_stats_ = false;
 
     explicit ServerData(int port = 0)
         : port_(port > 0 ? port : grpc_pick_unused_port_or_die()),
@@ -424,7 +444,11 @@ class ClientLbEnd2endTest : public ::testing::Test {
       std::ostringstream server_address;
       server_address << server_host << ":" << port_;
       ServerBuilder builder;
-      experimental::EnableCallMetricRecording(&builder);
+      if (record_cpu_stats_) {
+        experimental::EnableCallMetricRecordingWithCpuStats(&builder);
+      } else {
+        experimental::EnableCallMetricRecording(&builder);
+      }
       std::shared_ptr<ServerCredentials> creds(new SecureServerCredentials(
           grpc_fake_transport_security_server_credentials_create()));
       builder.AddListeningPort(server_address.str(), std::move(creds));
@@ -1155,6 +1179,35 @@ TEST_F(PickFirstTest, LocalSubchannelPool) {
   EXPECT_EQ(2UL, servers_[0]->service_.clients().size());
 }
 
+TEST_F(PickFirstTest, PooledConnections) {
+  StartServers(1);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, 2);
+  args.SetInt(GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION, 1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  WaitForServer(DEBUG_LOCATION, stub, 0);
+  EXPECT_EQ(1UL, servers_[0]->service_.clients().size());
+  // Keep a call open on the first connection, which fills it.
+  std::thread long_call([&]() {
+    EchoRequest request;
+    request.mutable_param()->set_server_sleep_us(3 * 1000 * 1000);
+    EXPECT_TRUE(SendRpc(stub, nullptr, 10000, false, &request).ok());
+  });
+  // Calls sent meanwhile make the subchannel open a second connection,
+  // and then go to it.
+  const absl::Time deadline =
+      absl::Now() + absl::Seconds(2 * grpc_test_slowdown_factor());
+  while (servers_[0]->service_.clients().size() < 2 &&
+         absl::Now() < deadline) {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  }
+  EXPECT_EQ(2UL, servers_[0]->service_.clients().size());
+  long_call.join();
+}
+
 TEST_F(PickFirstTest, ManyUpdates) {
   const int kNumUpdates = 1000;
   const int kNumServers = 3;
@@ -1259,6 +1312,55 @@ TEST_F(PickFirstTest, ReconnectWithoutNewResolverResultStartsFromTopOfList) {
   WaitForServer(DEBUG_LOCATION, stub, 0);
 }
 
+TEST_F(PickFirstTest, PreconnectReconnectsWithoutCalls) {
+  std::vector<int> ports = {grpc_pick_unused_port_or_die()};
+  StartServers(1, ports);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_EXPERIMENTAL_PICK_FIRST_PRECONNECT_PERCENT, 100);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(ports);
+  gpr_log(GPR_INFO, "****** INITIAL CONNECTION *******");
+  WaitForServer(DEBUG_LOCATION, stub, 0);
+  gpr_log(GPR_INFO, "****** STOPPING SERVER ******");
+  servers_[0]->Shutdown();
+  EXPECT_TRUE(WaitForChannelNotReady(channel.get()));
+  gpr_log(GPR_INFO, "****** RESTARTING SERVER ******");
+  StartServers(1, ports);
+  // The channel should reconnect on its own instead of staying IDLE until
+  // the next call.
+  auto predicate = [](grpc_connectivity_state state) {
+    return state == GRPC_CHANNEL_READY;
+  };
+  EXPECT_TRUE(
+      WaitForChannelState(channel.get(), predicate, /*try_to_connect=*/false));
+}
+
+TEST_F(PickFirstTest, ConnectionAttemptDelayStartsNextAttempt) {
+  // Start connection injector.
+  ConnectionAttemptInjector injector;
+  StartServers(2);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_EXPERIMENTAL_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS,
+              100);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Hang the connection attempt to the first server.
+  auto hold = injector.AddHold(servers_[0]->port_);
+  gpr_log(GPR_INFO, "=== TRIGGERING INITIAL CONNECTION ATTEMPT");
+  EXPECT_EQ(GRPC_CHANNEL_IDLE, channel->GetState(/*try_to_connect=*/true));
+  hold->Wait();
+  // Once the delay has elapsed, the channel should connect to the second
+  // server without waiting for the first attempt to fail.
+  gpr_log(GPR_INFO, "=== WAITING FOR SECOND SERVER");
+  WaitForServer(DEBUG_LOCATION, stub, 1);
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+  hold->Resume();
+}
+
 TEST_F(PickFirstTest, FailsEmptyResolverUpdate) {
   auto response_generator = BuildResolverResponseGenerator();
   auto channel = BuildChannel("pick_first", response_generator);
@@ -2163,6 +2265,45 @@ TEST_F(RoundRobinTest, HealthCheckingServiceNamePerChannel) {
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(RoundRobinTest, HealthCheckingSharedAcrossChannels) {
+  EnableDefaultHealthCheckService(true);
+  // Start server.
+  const int kNumServers = 1;
+  StartServers(kNumServers);
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  // Create two channels sharing health checks, with args that differ so
+  // that they do not share a subchannel.
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\"healthCheckConfig\": "
+      "{\"serviceName\": \"health_check_service_name\"}}");
+  args.SetInt(GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS, 1);
+  std::vector<int> ports = GetServersPorts();
+  auto response_generator1 = BuildResolverResponseGenerator();
+  auto channel1 = BuildChannel("round_robin", response_generator1, args);
+  auto stub1 = BuildStub(channel1);
+  response_generator1.SetNextResolution(ports);
+  args.SetInt("grpc.testing.distinct_subchannel", 1);
+  auto response_generator2 = BuildResolverResponseGenerator();
+  auto channel2 = BuildChannel("round_robin", response_generator2, args);
+  auto stub2 = BuildStub(channel2);
+  response_generator2.SetNextResolution(ports);
+  CheckRpcSendOk(DEBUG_LOCATION, stub1, true /* wait_for_ready */);
+  CheckRpcSendOk(DEBUG_LOCATION, stub2, true /* wait_for_ready */);
+  EXPECT_EQ(2UL, servers_[0]->service_.clients().size());
+  // Both channels see the backend become unhealthy.
+  servers_[0]->SetServingStatus("health_check_service_name", false);
+  EXPECT_TRUE(WaitForChannelNotReady(channel1.get()));
+  EXPECT_TRUE(WaitForChannelNotReady(channel2.get()));
+  // Destroying either channel leaves the other one health checking.
+  stub1.reset();
+  channel1.reset();
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(DEBUG_LOCATION, stub2, true /* wait_for_ready */);
+  // Clean up.
+  EnableDefaultHealthCheckService(false);
+}
+
 TEST_F(RoundRobinTest,
        HealthCheckingServiceNameChangesAfterSubchannelsCreated) {
   EnableDefaultHealthCheckService(true);
@@ -2191,6 +2332,183 @@ TEST_F(RoundRobinTest,
   EnableDefaultHealthCheckService(false);
 }
 
+//
+// least_request tests
+//
+
+using LeastRequestTest = ClientLbEnd2endTest;
+
+TEST_F(LeastRequestTest, Basic) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("least_request_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // With one RPC at a time, all backends are equally loaded, so each of them
+  // sees RPCs.
+  do {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  } while (!SeenAllServers());
+  EXPECT_EQ("least_request_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(LeastRequestTest, AvoidsBusyBackend) {
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // With 10 choices, a pick misses the idle backend once in 1024 picks.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\": "
+      "{\"choiceCount\": 10}}]}");
+  WaitForServers(DEBUG_LOCATION, stub);
+  // Keep an RPC in flight on one of the backends.
+  std::thread slow_rpc([&]() {
+    EchoRequest request;
+    request.mutable_param()->set_server_sleep_us(5 * 1000 * 1000);
+    EXPECT_TRUE(SendRpc(stub, nullptr, /*timeout_ms=*/10000,
+                        /*wait_for_ready=*/false, &request)
+                    .ok());
+  });
+  size_t busy_server;
+  while (true) {
+    if (servers_[0]->service_.request_count() > 0) {
+      busy_server = 0;
+      break;
+    }
+    if (servers_[1]->service_.request_count() > 0) {
+      busy_server = 1;
+      break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  const int kNumRpcs = 100;
+  for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+  // The slow RPC, and at most a few misses.
+  EXPECT_LE(servers_[busy_server]->service_.request_count(), 4);
+  EXPECT_GE(servers_[1 - busy_server]->service_.request_count(), kNumRpcs - 3);
+  slow_rpc.join();
+}
+
+//
+// peak_ewma tests
+//
+
+using PeakEwmaTest = ClientLbEnd2endTest;
+
+TEST_F(PeakEwmaTest, Basic) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("peak_ewma_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Before any backend is seen to be slower than the others, picks fall back
+  // to the calls in flight, so each backend sees RPCs.
+  do {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  } while (!SeenAllServers());
+  EXPECT_EQ("peak_ewma_experimental", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(PeakEwmaTest, AvoidsSlowBackend) {
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // With 10 choices, a pick misses the fast backend once in 1024 picks.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"peak_ewma_experimental\": "
+      "{\"choiceCount\": 10, \"decayTime\": \"100s\"}}]}");
+  WaitForServers(DEBUG_LOCATION, stub);
+  // Make one of the backends slow, and send RPCs until both have served
+  // one, so that each has a latency sample.
+  servers_[0]->service_.set_sleep_ms(200);
+  ResetCounters();
+  while (servers_[0]->service_.request_count() == 0 ||
+         servers_[1]->service_.request_count() == 0) {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  }
+  ResetCounters();
+  const int kNumRpcs = 100;
+  for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+  EXPECT_LE(servers_[0]->service_.request_count(), 3);
+  EXPECT_GE(servers_[1]->service_.request_count(), kNumRpcs - 3);
+}
+
+//
+// weighted_round_robin tests
+//
+
+using WeightedRoundRobinTest = ClientLbEnd2endTest;
+
+TEST_F(WeightedRoundRobinTest, PerCallLoadReports) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("weighted_round_robin_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // All the backends report the same load, so they all keep seeing RPCs.
+  xds::data::orca::v3::OrcaLoadReport load_report;
+  load_report.set_rps(100);
+  load_report.set_cpu_utilization(0.5);
+  for (int i = 0; i < 3; ++i) {
+    do {
+      CheckRpcSendOk(DEBUG_LOCATION, stub, /*wait_for_ready=*/false,
+                     &load_report);
+    } while (!SeenAllServers());
+    ResetCounters();
+  }
+  EXPECT_EQ("weighted_round_robin_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(WeightedRoundRobinTest, OobLoadReports) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  // Weights of 4:2:1.
+  const double kCpuUtilizations[kNumServers] = {0.2, 0.4, 0.8};
+  for (size_t i = 0; i < kNumServers; ++i) {
+    servers_[i]->orca_service_.SetQps(100);
+    servers_[i]->orca_service_.SetCpuUtilization(kCpuUtilizations[i]);
+  }
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": {"
+      "\"enableOobLoadReport\": true, \"blackoutPeriod\": \"0s\", "
+      "\"weightUpdatePeriod\": \"0.1s\"}}]}");
+  WaitForServers(DEBUG_LOCATION, stub);
+  // Wait for the weights to be used.
+  const int kNumRpcs = 700;
+  const int kExpectedCounts[kNumServers] = {400, 200, 100};
+  auto deadline = absl::Now() + absl::Seconds(10) * grpc_test_slowdown_factor();
+  while (true) {
+    for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+    bool weighted = true;
+    for (size_t i = 0; i < kNumServers; ++i) {
+      const int count = servers_[i]->service_.request_count();
+      if (std::abs(count - kExpectedCounts[i]) > kExpectedCounts[i] / 10) {
+        weighted = false;
+      }
+    }
+    ResetCounters();
+    if (weighted) break;
+    ASSERT_LT(absl::Now(), deadline) << "picks not weighted by load reports";
+  }
+}
+
 //
 // LB policy pick args
 //
@@ -2557,6 +2875,43 @@ TEST_F(ClientLbInterceptTrailingMetadataTest, BackendMetricData) {
   EXPECT_EQ(kNumRpcs, num_trailers_intercepted());
 }
 
+TEST_F(ClientLbInterceptTrailingMetadataTest, BackendMetricDataCpuStats) {
+  CreateServers(1);
+  servers_[0]->record_cpu_stats_ = true;
+  StartServer(0);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("intercept_trailing_metadata_lb", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // The handler records nothing: the server reports the CPU time of each
+  // RPC, and the CPU utilization once it has sampled it twice.
+  bool saw_utilization = false;
+  absl::Time deadline = absl::Now() + absl::Seconds(10);
+  while (!saw_utilization && absl::Now() < deadline) {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+    auto actual = backend_load_report();
+    ASSERT_TRUE(actual.has_value());
+    auto it = actual->request_cost().find("grpc.cpu_time_ms");
+    ASSERT_NE(it, actual->request_cost().end());
+    EXPECT_GE(it->second, 0);
+    EXPECT_GE(actual->cpu_utilization(), 0);
+    EXPECT_LE(actual->cpu_utilization(), 1);
+    saw_utilization = actual->cpu_utilization() > 0;
+    if (!saw_utilization) absl::SleepFor(absl::Milliseconds(100));
+  }
+  EXPECT_TRUE(saw_utilization);
+  // What the handler records takes precedence.
+  xds::data::orca::v3::OrcaLoadReport load_report;
+  load_report.set_cpu_utilization(0.5);
+  (*load_report.mutable_request_cost())["grpc.cpu_time_ms"] = 123;
+  CheckRpcSendOk(DEBUG_LOCATION, stub, false, &load_report);
+  auto actual = backend_load_report();
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ(actual->cpu_utilization(), 0.5);
+  EXPECT_EQ(actual->request_cost().at("grpc.cpu_time_ms"), 123);
+}
+
 //
 // tests that address attributes from the resolver are visible to the LB policy
 //
@@ -871,6 +871,40 @@ TEST_P(End2endTest, ManyStubs) {
   EXPECT_GT(peer.registration_attempts(), registration_attempts_pre);
 }
 
+TEST_P(End2endTest, BlockingCallsReuseCompletionQueues) {
+  ResetStub();
+  ChannelTestPeer peer(channel_.get());
+  SendRpc(stub_.get(), 1, false);
+  const int spare_pluck_cqs = peer.spare_pluck_cqs();
+  EXPECT_GE(spare_pluck_cqs, 1);
+  SendRpc(stub_.get(), 100, false);
+  EXPECT_EQ(peer.spare_pluck_cqs(), spare_pluck_cqs);
+}
+
+TEST_P(End2endTest, MetadataAddedByReference) {
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello hello hello hello");
+  request.mutable_param()->set_echo_metadata(true);
+  ClientContext context;
+  context.AddMetadataByReference("custom-referenced", "referenced value");
+  context.AddMetadata("custom-copied", "copied value");
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(response.message(), request.message());
+  EXPECT_TRUE(s.ok());
+  grpc::MetadataView trailing_metadata =
+      context.GetServerTrailingMetadataView();
+  EXPECT_EQ(trailing_metadata.size(),
+            context.GetServerTrailingMetadata().size());
+  grpc::string_ref value;
+  ASSERT_TRUE(trailing_metadata.Find("custom-referenced", &value));
+  EXPECT_EQ(value, "referenced value");
+  ASSERT_TRUE(trailing_metadata.Find("custom-copied", &value));
+  EXPECT_EQ(value, "copied value");
+  EXPECT_FALSE(trailing_metadata.Find("custom-missing", &value));
+}
+
 TEST_P(End2endTest, EmptyBinaryMetadata) {
   ResetStub();
   EchoRequest request;
@@ -2239,6 +2273,42 @@ TEST_P(ResourceQuotaEnd2endTest, SimpleRequest) {
   EXPECT_TRUE(s.ok());
 }
 
+class DeadlineBudgetEnd2endTest : public End2endTest {
+ public:
+  void ConfigureServerBuilder(ServerBuilder* builder) override {
+    builder->AddChannelArgument(GRPC_ARG_SERVER_MIN_DEADLINE_BUDGET_MS,
+                                30 * 1000);
+  }
+};
+
+TEST_P(DeadlineBudgetEnd2endTest, CallWithoutDeadlineIsHandled) {
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello");
+
+  ClientContext context;
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(response.message(), request.message());
+  EXPECT_TRUE(s.ok());
+}
+
+// A call with less time left than the server asks for fails straight away,
+// long before its deadline comes.
+TEST_P(DeadlineBudgetEnd2endTest, CallOutOfTimeIsFailedEarly) {
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello");
+
+  ClientContext context;
+  auto start = std::chrono::system_clock::now();
+  context.set_deadline(start + std::chrono::seconds(20));
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(StatusCode::DEADLINE_EXCEEDED, s.error_code());
+  EXPECT_LT(std::chrono::system_clock::now() - start, std::chrono::seconds(10));
+}
+
 // TODO(vjpai): refactor arguments into a struct if it makes sense
 std::vector<TestScenario> CreateTestScenarios(bool use_proxy,
                                               bool test_insecure,
@@ -2322,6 +2392,11 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::ValuesIn(CreateTestScenarios(false, true, true, true, true)),
     &TestScenario::Name);
 
+INSTANTIATE_TEST_SUITE_P(
+    DeadlineBudgetEnd2end, DeadlineBudgetEnd2endTest,
+    ::testing::ValuesIn(CreateTestScenarios(false, true, false, true, true)),
+    &TestScenario::Name);
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -30,6 +30,7 @@
 #include <grpcpp/create_channel.h>
 #include <grpcpp/generic/async_generic_service.h>
 #include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/generic/proxying_generic_service.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
@@ -40,6 +41,7 @@
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/util/byte_buffer_proto_helper.h"
+#include "test/cpp/util/string_ref_helper.h"
 
 using grpc::testing::EchoRequest;
 using grpc::testing::EchoResponse;
@@ -420,6 +422,109 @@ TEST_F(GenericEnd2endTest, ShortDeadline) {
   driver.join();
 }
 
+// A backend that echoes messages and metadata, for the proxy tests.
+class ProxiedEchoService : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    auto it = context->client_metadata().find("echo-metadata");
+    if (it != context->client_metadata().end()) {
+      std::string value(it->second.data(), it->second.size());
+      context->AddInitialMetadata("echo-initial", value);
+      context->AddTrailingMetadata("echo-trailing", value);
+    }
+    if (request->message() == "fail") {
+      return Status(StatusCode::FAILED_PRECONDITION, "failed");
+    }
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  Status BidiStream(
+      ServerContext* /*context*/,
+      ServerReaderWriter<EchoResponse, EchoRequest>* stream) override {
+    EchoRequest request;
+    while (stream->Read(&request)) {
+      EchoResponse response;
+      response.set_message(request.message());
+      stream->Write(response);
+    }
+    return Status::OK;
+  }
+};
+
+class ProxyingGenericServiceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ServerBuilder backend_builder;
+    backend_builder.RegisterService(&backend_service_);
+    backend_ = backend_builder.BuildAndStart();
+    proxy_service_ = absl::make_unique<ProxyingGenericService>(
+        backend_->InProcessChannel(ChannelArguments()));
+    ServerBuilder proxy_builder;
+    proxy_builder.RegisterCallbackGenericService(proxy_service_.get());
+    proxy_ = proxy_builder.BuildAndStart();
+    stub_ = EchoTestService::NewStub(
+        proxy_->InProcessChannel(ChannelArguments()));
+  }
+
+  void TearDown() override {
+    proxy_->Shutdown();
+    backend_->Shutdown();
+  }
+
+  ProxiedEchoService backend_service_;
+  std::unique_ptr<Server> backend_;
+  std::unique_ptr<ProxyingGenericService> proxy_service_;
+  std::unique_ptr<Server> proxy_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(ProxyingGenericServiceTest, UnaryRpc) {
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext context;
+  request.set_message(std::string(100000, 'a'));
+  context.AddMetadata("echo-metadata", "value");
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_TRUE(s.ok()) << s.error_message();
+  EXPECT_EQ(response.message(), request.message());
+  auto initial = context.GetServerInitialMetadata().find("echo-initial");
+  ASSERT_NE(initial, context.GetServerInitialMetadata().end());
+  EXPECT_EQ(ToString(initial->second), "value");
+  auto trailing = context.GetServerTrailingMetadata().find("echo-trailing");
+  ASSERT_NE(trailing, context.GetServerTrailingMetadata().end());
+  EXPECT_EQ(ToString(trailing->second), "value");
+}
+
+TEST_F(ProxyingGenericServiceTest, BackendStatusIsForwarded) {
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext context;
+  request.set_message("fail");
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(s.error_code(), StatusCode::FAILED_PRECONDITION);
+  EXPECT_EQ(s.error_message(), "failed");
+}
+
+TEST_F(ProxyingGenericServiceTest, BidiStreaming) {
+  ClientContext context;
+  auto stream = stub_->BidiStream(&context);
+  for (int i = 0; i < 10; i++) {
+    EchoRequest request;
+    EchoResponse response;
+    request.set_message(std::string(i * 1000, 'a' + i));
+    EXPECT_TRUE(stream->Write(request));
+    EXPECT_TRUE(stream->Read(&response));
+    EXPECT_EQ(response.message(), request.message());
+  }
+  EXPECT_TRUE(stream->WritesDone());
+  EchoResponse response;
+  EXPECT_FALSE(stream->Read(&response));
+  Status s = stream->Finish();
+  EXPECT_TRUE(s.ok()) << s.error_message();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -0,0 +1,142 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Many connections to one server, used from many threads at once, with the
+// epoll1 engine spreading them over epoll sets (epoll_sharded_sets).
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/end2end/test_service_impl.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_poll_strategy);
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr int kNumChannels = 256;
+constexpr int kNumThreads = 8;
+constexpr int kCallsPerChannel = 4;
+
+class ManyConnectionsEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    server_address_ =
+        absl::StrCat("localhost:", grpc_pick_unused_port_or_die());
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_, InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  // A channel with a connection of its own.
+  std::unique_ptr<EchoTestService::Stub> NewStub() {
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    return EchoTestService::NewStub(grpc::CreateCustomChannel(
+        server_address_, InsecureChannelCredentials(), args));
+  }
+
+  std::string server_address_;
+  TestServiceImpl service_;
+  std::unique_ptr<Server> server_;
+};
+
+TEST_F(ManyConnectionsEnd2endTest, UnaryCallsFromManyThreads) {
+  std::vector<std::unique_ptr<EchoTestService::Stub>> stubs;
+  for (int i = 0; i < kNumChannels; i++) stubs.push_back(NewStub());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&stubs, t]() {
+      for (int round = 0; round < kCallsPerChannel; round++) {
+        for (size_t i = t; i < stubs.size(); i += kNumThreads) {
+          EchoRequest request;
+          EchoResponse response;
+          request.set_message(absl::StrCat("hello ", i));
+          ClientContext context;
+          Status status = stubs[i]->Echo(&context, request, &response);
+          ASSERT_TRUE(status.ok()) << status.error_message();
+          EXPECT_EQ(response.message(), request.message());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST_F(ManyConnectionsEnd2endTest, StreamsFromManyThreads) {
+  std::vector<std::unique_ptr<EchoTestService::Stub>> stubs;
+  for (int i = 0; i < kNumChannels; i++) stubs.push_back(NewStub());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&stubs, t]() {
+      for (size_t i = t; i < stubs.size(); i += kNumThreads) {
+        ClientContext context;
+        auto stream = stubs[i]->BidiStream(&context);
+        EchoRequest request;
+        EchoResponse response;
+        for (int j = 0; j < kCallsPerChannel; j++) {
+          request.set_message(absl::StrCat("hello ", i, " ", j));
+          ASSERT_TRUE(stream->Write(request));
+          ASSERT_TRUE(stream->Read(&response));
+          EXPECT_EQ(response.message(), request.message());
+        }
+        stream->WritesDone();
+        EXPECT_FALSE(stream->Read(&response));
+        Status status = stream->Finish();
+        EXPECT_TRUE(status.ok()) << status.error_message();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+#ifdef GRPC_LINUX_EPOLL
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "epoll1");
+#endif
+  grpc_core::ForceEnableExperiment("epoll_sharded_sets", true);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
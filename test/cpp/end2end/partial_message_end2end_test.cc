@@ -0,0 +1,178 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Large enough to span many HTTP/2 flow control windows.
+constexpr size_t kMessageSize = 2 * 1024 * 1024;
+
+// Reads the parts of the next message of stream into *msg, and returns how
+// many parts it came in, or 0 at the end of the stream.
+template <class Stream, class T>
+int ReadInParts(Stream* stream, T* msg) {
+  std::vector<Slice> slices;
+  int parts = 0;
+  bool partial = true;
+  while (partial) {
+    ByteBuffer part;
+    if (!stream->ReadPartial(&part, &partial)) return 0;
+    ++parts;
+    std::vector<Slice> part_slices;
+    EXPECT_TRUE(part.Dump(&part_slices).ok());
+    slices.insert(slices.end(), part_slices.begin(), part_slices.end());
+  }
+  ByteBuffer whole(slices.data(), slices.size());
+  EXPECT_TRUE(SerializationTraits<T>::Deserialize(&whole, msg).ok());
+  return parts;
+}
+
+// Echoes requests, reading each in parts.
+class PartialEchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status BidiStream(
+      ServerContext* /*context*/,
+      ServerReaderWriter<EchoResponse, EchoRequest>* stream) override {
+    EchoRequest request;
+    while (int parts = ReadInParts(stream, &request)) {
+      request_parts_ = parts;
+      EchoResponse response;
+      response.set_message(request.message());
+      stream->Write(response);
+    }
+    return Status::OK;
+  }
+
+  int request_parts() const { return request_parts_; }
+
+ private:
+  std::atomic<int> request_parts_{0};
+};
+
+class PartialMessageEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int port = grpc_pick_unused_port_or_die();
+    server_address_ << "localhost:" << port;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    // Keep the flow control windows small, so that big messages arrive over
+    // several reads.
+    builder.AddChannelArgument(GRPC_ARG_HTTP2_BDP_PROBE, 0);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 0);
+    stub_ = EchoTestService::NewStub(grpc::CreateCustomChannel(
+        server_address_.str(), InsecureChannelCredentials(), args));
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  std::ostringstream server_address_;
+  PartialEchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(PartialMessageEnd2endTest, ServerReadsInParts) {
+  ClientContext context;
+  auto stream = stub_->BidiStream(&context);
+  EchoRequest request;
+  request.set_message(std::string(kMessageSize, 'a'));
+  ASSERT_TRUE(stream->Write(request));
+  EchoResponse response;
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.message(), request.message());
+  EXPECT_GT(service_.request_parts(), 1);
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
+TEST_F(PartialMessageEnd2endTest, ClientReadsInParts) {
+  ClientContext context;
+  auto stream = stub_->BidiStream(&context);
+  for (int i = 0; i < 3; ++i) {
+    EchoRequest request;
+    request.set_message(std::string(kMessageSize, 'a' + i));
+    ASSERT_TRUE(stream->Write(request));
+    EchoResponse response;
+    EXPECT_GT(ReadInParts(stream.get(), &response), 1);
+    EXPECT_EQ(response.message(), request.message());
+  }
+  // Small messages are read whole.
+  EchoRequest request;
+  request.set_message("hello");
+  ASSERT_TRUE(stream->Write(request));
+  EchoResponse response;
+  EXPECT_EQ(ReadInParts(stream.get(), &response), 1);
+  EXPECT_EQ(response.message(), request.message());
+  stream->WritesDone();
+  EXPECT_EQ(ReadInParts(stream.get(), &response), 0);
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
+TEST_F(PartialMessageEnd2endTest, CompressedMessagesAreReadWhole) {
+  ClientContext context;
+  context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  auto stream = stub_->BidiStream(&context);
+  EchoRequest request;
+  request.set_message(std::string(kMessageSize, 'a'));
+  ASSERT_TRUE(stream->Write(request));
+  EchoResponse response;
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.message(), request.message());
+  EXPECT_EQ(service_.request_parts(), 1);
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -124,10 +124,10 @@ TEST_P(CdsTest, AcceptsEdsConfigSourceOfTypeAds) {
 }
 
 // Tests that CDS client should send a NACK if the lb_policy in CDS response
-// is other than ROUND_ROBIN.
+// is not supported.
 TEST_P(CdsTest, WrongLbPolicy) {
   auto cluster = default_cluster_;
-  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.set_lb_policy(Cluster::RANDOM);
   balancer_->ads_service()->SetCdsResource(cluster);
   const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
   ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
@@ -135,6 +135,37 @@ TEST_P(CdsTest, WrongLbPolicy) {
               ::testing::HasSubstr("LB policy is not supported."));
 }
 
+// Tests that CDS client accepts the LEAST_REQUEST lb_policy, and that it
+// sends RPCs to all of the backends.
+TEST_P(CdsTest, LeastRequestLbPolicy) {
+  CreateAndStartBackends(2);
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      3);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION);
+  auto response_state = balancer_->ads_service()->cds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that CDS client should send a NACK if the choice_count of the
+// LEAST_REQUEST lb_policy is less than 2.
+TEST_P(CdsTest, LeastRequestLbPolicyInvalidChoiceCount) {
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      1);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  EXPECT_THAT(response_state->error_message,
+              ::testing::HasSubstr("choice_count must be at least 2."));
+}
+
 // Tests that CDS client should send a NACK if the lrs_server in CDS response
 // is other than SELF.
 TEST_P(CdsTest, WrongLrsServer) {
@@ -697,6 +728,58 @@ TEST_P(EdsTest, WeightedRoundRobin) {
               ::testing::DoubleNear(kLocalityWeightRate1, kErrorTolerance));
 }
 
+// With zone-aware routing, a locality in the client's own zone with enough
+// capacity gets all the traffic, and the others get it once it is down.
+TEST_P(EdsTest, ZoneAwareRoutingPrefersLocalZone) {
+  ScopedExperimentalEnvVar env_var("GRPC_EXPERIMENTAL_XDS_ZONE_AWARE_ROUTING");
+  CreateAndStartBackends(2);
+  const size_t kNumRpcs = 100;
+  EdsResourceArgs::Locality local("locality0",
+                                  CreateEndpointsForBackends(0, 1));
+  // The zone of the bootstrap's node.
+  local.region = "corp";
+  local.zone = "svl";
+  EdsResourceArgs args(
+      {local, {"locality1", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForBackend(DEBUG_LOCATION, 0);
+  CheckRpcSendOk(DEBUG_LOCATION, kNumRpcs);
+  EXPECT_EQ(kNumRpcs, backends_[0]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[1]->backend_service()->request_count());
+  // Spill over to the other zone once ours is down.
+  ShutdownBackend(0);
+  WaitForBackend(DEBUG_LOCATION, 1);
+}
+
+// With zone-aware routing, traffic spills over from the client's zone when
+// its capacity is less than its share of the clients.
+TEST_P(EdsTest, ZoneAwareRoutingSpillsOver) {
+  ScopedExperimentalEnvVar env_var("GRPC_EXPERIMENTAL_XDS_ZONE_AWARE_ROUTING");
+  CreateAndStartBackends(2);
+  // Taking clients to be spread evenly over the two zones, the local zone
+  // can serve half of its clients' traffic, and the other zone the rest.
+  const double kExpectedLocalRate = 0.5;
+  const double kErrorTolerance = 0.05;
+  const size_t kNumRpcs =
+      ComputeIdealNumRpcs(kExpectedLocalRate, kErrorTolerance);
+  EdsResourceArgs::Locality local("locality0", CreateEndpointsForBackends(0, 1),
+                                  /*lb_weight=*/1);
+  local.region = "corp";
+  local.zone = "svl";
+  EdsResourceArgs args({
+      local,
+      {"locality1", CreateEndpointsForBackends(1, 2), /*lb_weight=*/3},
+  });
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 2);
+  CheckRpcSendOk(DEBUG_LOCATION, kNumRpcs);
+  const double local_rate =
+      static_cast<double>(backends_[0]->backend_service()->request_count()) /
+      kNumRpcs;
+  EXPECT_THAT(local_rate,
+              ::testing::DoubleNear(kExpectedLocalRate, kErrorTolerance));
+}
+
 // Tests that we correctly handle a locality containing no endpoints.
 TEST_P(EdsTest, LocalityContainingNoEndpoints) {
   CreateAndStartBackends(2);
@@ -1154,6 +1237,34 @@ TEST_P(FailoverTest, ReportsConnectingDuringFailover) {
                            << " message=" << status.error_message();
 }
 
+// With a warm standby, the next priority gets connected while the higher
+// one is in use, so failing over to it does not need a new connection.
+TEST_P(FailoverTest, WarmStandbyConnectsNextPriority) {
+  ChannelArguments channel_args;
+  channel_args.SetInt(GRPC_ARG_EXPERIMENTAL_PRIORITY_WARM_STANDBY_SUBCHANNELS,
+                      1);
+  ResetStub(/*failover_timeout_ms=*/500, &channel_args);
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({
+      {"locality0", CreateEndpointsForBackends(0, 1), kDefaultLocalityWeight,
+       0},
+      {"locality1", CreateEndpointsForBackends(1, 2), kDefaultLocalityWeight,
+       1},
+  });
+  ConnectionAttemptInjector injector;
+  auto hold = injector.AddHold(backends_[1]->port(),
+                               /*intercept_completion=*/true);
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForBackend(DEBUG_LOCATION, 0);
+  // Priority 1 connects while priority 0 is in use.
+  hold->Wait();
+  hold->Resume();
+  hold->WaitForCompletion();
+  // Fail over once priority 1 is connected.
+  backends_[0]->StopListeningAndSendGoaways();
+  WaitForBackend(DEBUG_LOCATION, 1);
+}
+
 // If a locality with higher priority than the current one becomes ready,
 // switch to it.
 TEST_P(FailoverTest, SwitchBackToHigherPriority) {
@@ -636,8 +636,8 @@ ClusterLoadAssignment XdsEnd2endTest::BuildEdsResource(
     auto* endpoints = assignment.add_endpoints();
     endpoints->mutable_load_balancing_weight()->set_value(locality.lb_weight);
     endpoints->set_priority(locality.priority);
-    endpoints->mutable_locality()->set_region(kDefaultLocalityRegion);
-    endpoints->mutable_locality()->set_zone(kDefaultLocalityZone);
+    endpoints->mutable_locality()->set_region(locality.region);
+    endpoints->mutable_locality()->set_zone(locality.zone);
     endpoints->mutable_locality()->set_sub_zone(locality.sub_zone);
     for (size_t i = 0; i < locality.endpoints.size(); ++i) {
       const int& port = locality.endpoints[i].port;
@@ -593,6 +593,8 @@ class XdsEnd2endTest : public ::testing::TestWithParam<XdsTestType> {
       std::vector<Endpoint> endpoints;
       int lb_weight;
       int priority;
+      std::string region = kDefaultLocalityRegion;
+      std::string zone = kDefaultLocalityZone;
     };
 
     EdsResourceArgs() = default;
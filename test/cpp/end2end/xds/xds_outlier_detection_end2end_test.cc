@@ -542,6 +542,59 @@ TEST_P(OutlierDetectionTest, FailurePercentageEjectionAndUnejection) {
   EXPECT_EQ(100, backends_[1]->backend_service()->request_count());
 }
 
+// Consecutive failures eject a backend right away, not at the next interval.
+TEST_P(OutlierDetectionTest, ConsecutiveFailureEjection) {
+  ScopedExperimentalEnvVar env_var(
+      "GRPC_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION");
+  CreateAndStartBackends(2);
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::RING_HASH);
+  // The interval is far longer than the test, so only consecutive failure
+  // ejection can eject anything.
+  auto* outlier_detection = cluster.mutable_outlier_detection();
+  SetProtoDuration(grpc_core::Duration::Seconds(100),
+                   outlier_detection->mutable_interval());
+  outlier_detection->mutable_consecutive_5xx()->set_value(2);
+  outlier_detection->mutable_enforcing_consecutive_5xx()->set_value(100);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  auto new_route_config = default_route_config_;
+  auto* route = new_route_config.mutable_virtual_hosts(0)->mutable_routes(0);
+  auto* hash_policy = route->mutable_route()->add_hash_policy();
+  hash_policy->mutable_header()->set_header_name("address_hash");
+  SetListenerAndRouteConfiguration(balancer_.get(), default_listener_,
+                                   new_route_config);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  std::vector<std::pair<std::string, std::string>> metadata = {
+      {"address_hash", CreateMetadataValueThatHashesToBackend(0)}};
+  const auto rpc_options = RpcOptions().set_metadata(metadata);
+  const auto failing_rpc_options =
+      RpcOptions().set_metadata(metadata).set_server_expected_error(
+          StatusCode::CANCELLED);
+  WaitForBackend(DEBUG_LOCATION, 0, /*check_status=*/nullptr,
+                 WaitForBackendOptions(), rpc_options);
+  // A success in between resets the count.
+  CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::CANCELLED, "",
+                      failing_rpc_options);
+  CheckRpcSendOk(DEBUG_LOCATION, 1, rpc_options);
+  CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::CANCELLED, "",
+                      failing_rpc_options);
+  ResetBackendCounters();
+  CheckRpcSendOk(DEBUG_LOCATION, 1, rpc_options);
+  EXPECT_EQ(1, backends_[0]->backend_service()->request_count());
+  // The second failure in a row ejects backend 0.
+  CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::CANCELLED, "",
+                      failing_rpc_options);
+  CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::CANCELLED, "",
+                      failing_rpc_options);
+  WaitForBackend(DEBUG_LOCATION, 1, /*check_status=*/nullptr,
+                 WaitForBackendOptions().set_timeout_ms(
+                     3000 * grpc_test_slowdown_factor()),
+                 rpc_options);
+  CheckRpcSendOk(DEBUG_LOCATION, 100, rpc_options);
+  EXPECT_EQ(100, backends_[1]->backend_service()->request_count());
+}
+
 // We don't eject more than max_ejection_percent (default 10%) of the backends
 // beyond the first one.
 TEST_P(OutlierDetectionTest, FailurePercentageMaxPercentage) {
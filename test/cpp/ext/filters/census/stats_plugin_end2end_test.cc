@@ -422,6 +422,48 @@ TEST_F(StatsPluginEnd2EndTest, Latency) {
                                   ::testing::DoubleEq(client_elapsed_time))))));
 }
 
+TEST_F(StatsPluginEnd2EndTest, LatencyBreakdown) {
+  View client_latency_view(ClientRoundtripLatencyCumulative());
+  View client_pick_latency_view(ClientPickLatencyCumulative());
+  View client_transport_latency_view(ClientTransportLatencyCumulative());
+
+  {
+    EchoRequest request;
+    request.set_message("foo");
+    EchoResponse response;
+    grpc::ClientContext context;
+    grpc::Status status = stub_->Echo(&context, request, &response);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ("foo", response.message());
+  }
+  absl::SleepFor(absl::Milliseconds(500 * grpc_test_slowdown_factor()));
+  TestUtils::Flush();
+
+  // Both parts of the breakdown are subintervals of the roundtrip latency.
+  const auto client_latency = client_latency_view.GetData()
+                                  .distribution_data()
+                                  .find({client_method_name_})
+                                  ->second.mean();
+  EXPECT_THAT(
+      client_pick_latency_view.GetData().distribution_data(),
+      ::testing::UnorderedElementsAre(::testing::Pair(
+          ::testing::ElementsAre(client_method_name_),
+          ::testing::AllOf(
+              ::testing::Property(&Distribution::count, 1),
+              ::testing::Property(&Distribution::mean, ::testing::Ge(0.0)),
+              ::testing::Property(&Distribution::mean,
+                                  ::testing::Lt(client_latency))))));
+  EXPECT_THAT(
+      client_transport_latency_view.GetData().distribution_data(),
+      ::testing::UnorderedElementsAre(::testing::Pair(
+          ::testing::ElementsAre(client_method_name_),
+          ::testing::AllOf(
+              ::testing::Property(&Distribution::count, 1),
+              ::testing::Property(&Distribution::mean, ::testing::Ge(0.0)),
+              ::testing::Property(&Distribution::mean,
+                                  ::testing::Lt(client_latency))))));
+}
+
 TEST_F(StatsPluginEnd2EndTest, StartedRpcs) {
   View client_started_rpcs_view(ClientStartedRpcsCumulative());
   View server_started_rpcs_view(ServerStartedRpcsCumulative());
@@ -0,0 +1,214 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the throughput of concurrent ALTS handshakes driven through the
+ * dedicated completion queue threads, against a fake handshaker service.
+ * Run with GRPC_ALTS_HANDSHAKER_THREADS=<n> to spread them over n threads. */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+#include <grpcpp/impl/service_type.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/security/credentials/alts/grpc_alts_credentials_options.h"
+#include "src/core/lib/security/security_connector/alts/alts_security_connector.h"
+#include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
+#include "src/core/tsi/alts/handshaker/alts_tsi_handshaker.h"
+#include "src/core/tsi/transport_security_interface.h"
+#include "test/core/tsi/alts/fake_handshaker/fake_handshaker_server.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Runs the fake handshaker service on a local port for the whole run.
+class FakeHandshakerServer {
+ public:
+  FakeHandshakerServer()
+      : address_(absl::StrCat("localhost:", grpc_pick_unused_port_or_die())),
+        service_(grpc::gcp::CreateFakeHandshakerService(0)) {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(address_, grpc::InsecureServerCredentials());
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    GPR_ASSERT(server_ != nullptr);
+  }
+
+  ~FakeHandshakerServer() { server_->Shutdown(); }
+
+  const std::string& address() const { return address_; }
+
+ private:
+  std::string address_;
+  std::unique_ptr<grpc::Service> service_;
+  std::unique_ptr<grpc::Server> server_;
+};
+
+FakeHandshakerServer* g_handshaker_server;
+
+// A client and a server handshaker exchanging the frames each hands back
+// from tsi_handshaker_next(), until both have their results.
+class HandshakePair {
+ public:
+  HandshakePair(std::atomic<int>* remaining, Notification* done)
+      : remaining_(remaining), done_(done) {
+    grpc_alts_credentials_options* client_options =
+        grpc_alts_credentials_client_options_create();
+    grpc_alts_credentials_options* server_options =
+        grpc_alts_credentials_server_options_create();
+    grpc_alts_set_rpc_protocol_versions(&client_options->rpc_versions);
+    grpc_alts_set_rpc_protocol_versions(&server_options->rpc_versions);
+    const char* handshaker_service_url =
+        g_handshaker_server->address().c_str();
+    GPR_ASSERT(alts_tsi_handshaker_create(
+                   client_options, "target_name", handshaker_service_url,
+                   /*is_client=*/true, /*interested_parties=*/nullptr,
+                   &client_, 0) == TSI_OK);
+    GPR_ASSERT(alts_tsi_handshaker_create(
+                   server_options, "target_name", handshaker_service_url,
+                   /*is_client=*/false, /*interested_parties=*/nullptr,
+                   &server_, 0) == TSI_OK);
+    grpc_alts_credentials_options_destroy(client_options);
+    grpc_alts_credentials_options_destroy(server_options);
+  }
+
+  ~HandshakePair() {
+    tsi_handshaker_result_destroy(client_result_);
+    tsi_handshaker_result_destroy(server_result_);
+    tsi_handshaker_destroy(client_);
+    tsi_handshaker_destroy(server_);
+  }
+
+  void Start() { Next(client_, nullptr, 0); }
+
+ private:
+  void Next(tsi_handshaker* handshaker, const unsigned char* received_bytes,
+            size_t received_bytes_size) {
+    const unsigned char* bytes_to_send = nullptr;
+    size_t bytes_to_send_size = 0;
+    tsi_handshaker_result* result = nullptr;
+    GPR_ASSERT(tsi_handshaker_next(
+                   handshaker, received_bytes, received_bytes_size,
+                   &bytes_to_send, &bytes_to_send_size, &result,
+                   handshaker == client_ ? OnClientNextDone : OnServerNextDone,
+                   this) == TSI_ASYNC);
+  }
+
+  static void OnClientNextDone(tsi_result status, void* user_data,
+                               const unsigned char* bytes_to_send,
+                               size_t bytes_to_send_size,
+                               tsi_handshaker_result* result) {
+    auto* self = static_cast<HandshakePair*>(user_data);
+    self->OnNextDone(status, &self->client_result_, self->server_,
+                     bytes_to_send, bytes_to_send_size, result);
+  }
+
+  static void OnServerNextDone(tsi_result status, void* user_data,
+                               const unsigned char* bytes_to_send,
+                               size_t bytes_to_send_size,
+                               tsi_handshaker_result* result) {
+    auto* self = static_cast<HandshakePair*>(user_data);
+    self->OnNextDone(status, &self->server_result_, self->client_,
+                     bytes_to_send, bytes_to_send_size, result);
+  }
+
+  // The bytes to send stay valid until the handshaker that produced them
+  // is next called, which is only once the peer answers them.
+  void OnNextDone(tsi_result status, tsi_handshaker_result** result_slot,
+                  tsi_handshaker* peer, const unsigned char* bytes_to_send,
+                  size_t bytes_to_send_size, tsi_handshaker_result* result) {
+    GPR_ASSERT(status == TSI_OK);
+    if (result != nullptr) {
+      *result_slot = result;
+      if (remaining_->fetch_sub(1) == 1) done_->Notify();
+    }
+    if (bytes_to_send_size > 0) Next(peer, bytes_to_send, bytes_to_send_size);
+  }
+
+  std::atomic<int>* remaining_;
+  Notification* done_;
+  tsi_handshaker* client_ = nullptr;
+  tsi_handshaker* server_ = nullptr;
+  tsi_handshaker_result* client_result_ = nullptr;
+  tsi_handshaker_result* server_result_ = nullptr;
+};
+
+// Each iteration completes range(0) handshakes at once.
+void BM_AltsConcurrentHandshakes(benchmark::State& state) {
+  const int concurrent_handshakes = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::atomic<int> remaining(2 * concurrent_handshakes);
+    Notification done;
+    std::vector<std::unique_ptr<HandshakePair>> pairs;
+    for (int i = 0; i < concurrent_handshakes; ++i) {
+      pairs.push_back(absl::make_unique<HandshakePair>(&remaining, &done));
+    }
+    state.ResumeTiming();
+    for (auto& pair : pairs) pair->Start();
+    done.WaitForNotification();
+    state.PauseTiming();
+    pairs.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * concurrent_handshakes);
+}
+BENCHMARK(BM_AltsConcurrentHandshakes)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(40)
+    ->Arg(100)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc_alts_shared_resource_dedicated_init();
+  grpc_core::g_handshaker_server = new grpc_core::FakeHandshakerServer();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc_core::g_handshaker_server;
+  grpc_alts_shared_resource_dedicated_shutdown();
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark GrpcAuthorizationEngine::Evaluate over policies of many rules,
+ * each allowing a few methods of one service to one workload identity */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc_security_constants.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/rbac_policy.h"
+#include "test/core/util/evaluate_args_test_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int kMethodsPerRule = 4;
+
+std::string MethodPath(int rule, int method) {
+  return absl::StrCat("/pkg.Service", rule, "/Method", method);
+}
+
+std::string Identity(int rule) {
+  return absl::StrCat("spiffe://cluster.local/ns/default/sa/client", rule);
+}
+
+// A policy like those the rbac translator produces: one rule per service,
+// each matching its methods and one authenticated principal.
+Rbac MakePolicy(int num_rules) {
+  std::map<std::string, Rbac::Policy> policies;
+  for (int rule = 0; rule < num_rules; ++rule) {
+    std::vector<std::unique_ptr<Rbac::Permission>> paths;
+    for (int method = 0; method < kMethodsPerRule; ++method) {
+      paths.push_back(absl::make_unique<Rbac::Permission>(
+          Rbac::Permission::MakePathPermission(
+              StringMatcher::Create(StringMatcher::Type::kExact,
+                                    MethodPath(rule, method))
+                  .value())));
+    }
+    std::vector<std::unique_ptr<Rbac::Permission>> permissions;
+    permissions.push_back(absl::make_unique<Rbac::Permission>(
+        Rbac::Permission::MakeOrPermission(std::move(paths))));
+    std::vector<std::unique_ptr<Rbac::Principal>> principals;
+    principals.push_back(absl::make_unique<Rbac::Principal>(
+        Rbac::Principal::MakeAuthenticatedPrincipal(
+            StringMatcher::Create(StringMatcher::Type::kExact, Identity(rule))
+                .value())));
+    policies[absl::StrCat("rule", rule)] = Rbac::Policy(
+        Rbac::Permission::MakeAndPermission(std::move(permissions)),
+        Rbac::Principal::MakeOrPrincipal(std::move(principals)));
+  }
+  return Rbac(Rbac::Action::kAllow, std::move(policies));
+}
+
+// Each iteration authorizes a call to the last rule's service from its
+// identity, on a connection that has already made calls.
+void BM_EvaluateAllow(benchmark::State& state) {
+  const int num_rules = state.range(0);
+  GrpcAuthorizationEngine engine(MakePolicy(num_rules));
+  const int rule = num_rules - 1;
+  const std::string path = MethodPath(rule, kMethodsPerRule - 1);
+  const std::string identity = Identity(rule);
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata(":path", path.c_str());
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_SSL_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME, identity.c_str());
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    auto decision = engine.Evaluate(args);
+    GPR_ASSERT(decision.type == AuthorizationEngine::Decision::Type::kAllow);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EvaluateAllow)->Arg(10)->Arg(100)->Arg(500);
+
+// Each iteration denies a call to a method that no rule allows.
+void BM_EvaluateDeny(benchmark::State& state) {
+  const int num_rules = state.range(0);
+  GrpcAuthorizationEngine engine(MakePolicy(num_rules));
+  const std::string identity = Identity(0);
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata(":path", "/pkg.Unknown/Method");
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_SSL_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME, identity.c_str());
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    auto decision = engine.Evaluate(args);
+    GPR_ASSERT(decision.type == AuthorizationEngine::Decision::Type::kDeny);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EvaluateDeny)->Arg(10)->Arg(100)->Arg(500);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the base64 coding used for -bin metadata when the peer does not
+// support true binary metadata.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
+#include "src/core/lib/slice/slice.h"
+#include "test/core/util/test_config.h"
+
+// Trace contexts and auth blobs range from tens of bytes to a few KB.
+static void BinaryMetadataSizes(benchmark::internal::Benchmark* b) {
+  for (int64_t size : {16, 128, 1024, 8192}) {
+    b->Arg(size);
+  }
+}
+
+static grpc_core::Slice RandomBytes(size_t length) {
+  std::mt19937 rd(0);
+  std::vector<uint8_t> v(length);
+  for (auto& c : v) c = static_cast<uint8_t>(rd());
+  return grpc_core::Slice::FromCopiedBuffer(v);
+}
+
+static void BM_Base64Encode(benchmark::State& state) {
+  grpc_core::Slice input = RandomBytes(state.range(0));
+  for (auto _ : state) {
+    grpc_core::Slice output(grpc_chttp2_base64_encode(input.c_slice()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64Encode)->Apply(BinaryMetadataSizes);
+
+static void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  grpc_core::Slice input = RandomBytes(state.range(0));
+  for (auto _ : state) {
+    grpc_core::Slice output(
+        grpc_chttp2_base64_encode_and_huffman_compress(input.c_slice()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress)->Apply(BinaryMetadataSizes);
+
+// Used by transports that receive unpadded base64 metadata and know the
+// decoded length up front. The HPACK parser's own decoder is covered by the
+// NonIndexedBinaryElem cases in bm_chttp2_hpack.
+static void BM_Base64DecodeWithLength(benchmark::State& state) {
+  grpc_core::Slice input = RandomBytes(state.range(0));
+  grpc_core::Slice encoded(grpc_chttp2_base64_encode(input.c_slice()));
+  for (auto _ : state) {
+    grpc_core::Slice output(
+        grpc_chttp2_base64_decode_with_length(encoded.c_slice(), input.size()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64DecodeWithLength)->Apply(BinaryMetadataSizes);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
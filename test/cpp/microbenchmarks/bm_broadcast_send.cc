@@ -0,0 +1,129 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Benchmark of writing one message to many streams: serializing it for each
+// stream, as Write does, against serializing it once and sending the buffer,
+// as WriteSerialized does.
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/impl/codegen/call_op_set.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include "src/proto/grpc/testing/echo_messages.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// The send message op of one stream, taken through the steps a CallOpSet
+// takes it through for each write, short of handing it to core.
+class StreamSendOp : public internal::CallOpSendMessage {
+ public:
+  void Write() {
+    grpc_op op;
+    size_t nops = 0;
+    AddOp(&op, &nops);
+    bool ok = true;
+    FinishOp(&ok);
+  }
+};
+
+static EchoResponse MakeEvent(size_t size) {
+  EchoResponse event;
+  event.set_message(std::string(size, 'a'));
+  return event;
+}
+
+// Args: message size, number of streams.
+static void BM_BroadcastSerializePerStream(benchmark::State& state) {
+  const EchoResponse event = MakeEvent(state.range(0));
+  std::vector<StreamSendOp> streams(state.range(1));
+  for (auto _ : state) {
+    for (StreamSendOp& stream : streams) {
+      GPR_ASSERT(stream.SendMessagePtr(&event, WriteOptions()).ok());
+      stream.Write();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * streams.size());
+}
+BENCHMARK(BM_BroadcastSerializePerStream)
+    ->Ranges({{64, 64 * 1024}, {1, 10000}});
+
+static void BM_BroadcastSerializeOnce(benchmark::State& state) {
+  const EchoResponse event = MakeEvent(state.range(0));
+  std::vector<StreamSendOp> streams(state.range(1));
+  for (auto _ : state) {
+    ByteBuffer serialized;
+    bool own_buffer;
+    GPR_ASSERT(SerializationTraits<EchoResponse>::Serialize(event, &serialized,
+                                                            &own_buffer)
+                   .ok());
+    for (StreamSendOp& stream : streams) {
+      stream.SendSerializedMessage(serialized, WriteOptions());
+      stream.Write();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * streams.size());
+}
+BENCHMARK(BM_BroadcastSerializeOnce)->Ranges({{64, 64 * 1024}, {1, 10000}});
+
+static void BM_BroadcastCompressOnce(benchmark::State& state) {
+  const EchoResponse event = MakeEvent(state.range(0));
+  std::vector<StreamSendOp> streams(state.range(1));
+  for (auto _ : state) {
+    ByteBuffer serialized;
+    bool own_buffer;
+    GPR_ASSERT(SerializationTraits<EchoResponse>::Serialize(event, &serialized,
+                                                            &own_buffer)
+                   .ok());
+    ByteBuffer compressed;
+    GPR_ASSERT(serialized.Compress(GRPC_COMPRESS_GZIP, &compressed).ok());
+    for (StreamSendOp& stream : streams) {
+      stream.SendSerializedMessage(compressed, WriteOptions());
+      stream.Write();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * streams.size());
+}
+BENCHMARK(BM_BroadcastCompressOnce)->Ranges({{64, 64 * 1024}, {1, 10000}});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -22,9 +22,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/byte_buffer.h>
 
+#include "src/proto/grpc/testing/echo_messages.pb.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -115,6 +117,28 @@ static void BM_ByteBufferReader_Peek(benchmark::State& state) {
 }
 BENCHMARK(BM_ByteBufferReader_Peek)->Ranges({{64 * 1024, 1024 * 1024}});
 
+// Serializes an EchoRequest whose message field holds state.range(0) bytes.
+template <Status (*Serialize)(const grpc::protobuf::MessageLite&, ByteBuffer*,
+                              bool*)>
+static void BM_SerializeProto(benchmark::State& state) {
+  EchoRequest request;
+  request.set_message(std::string(state.range(0), 'a'));
+  for (auto _ : state) {
+    ByteBuffer bb;
+    bool own_buffer;
+    GPR_ASSERT(Serialize(request, &bb, &own_buffer).ok());
+  }
+  state.SetBytesProcessed(state.iterations() * request.ByteSizeLong());
+}
+BENCHMARK_TEMPLATE(BM_SerializeProto,
+                   GenericSerialize<ProtoBufferWriter, EchoRequest>)
+    ->Range(1024, 16 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_SerializeProto, GenericSerializeExact)
+    ->Range(1024, 16 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_SerializeProto,
+                   GenericSerializeAliased<ProtoBufferWriter>)
+    ->Range(1024, 16 * 1024 * 1024);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,132 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the call combiner: closures started on a free combiner, either
+ * scheduled on the ExecCtx (Start) or run right away (StartInline, and Start
+ * with the call_combiner_inline_start experiment) */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// A closure that yields the call combiner it ran in, and then starts the
+// next of remaining steps: like the callbacks of successive batches.
+struct Chain {
+  grpc_core::CallCombiner call_combiner;
+  grpc_closure closure;
+  bool inline_start;
+  int remaining = 0;
+
+  void Start() {
+    if (inline_start) {
+      GRPC_CALL_COMBINER_START_INLINE(&call_combiner, &closure,
+                                      absl::OkStatus(), "chain");
+    } else {
+      GRPC_CALL_COMBINER_START(&call_combiner, &closure, absl::OkStatus(),
+                               "chain");
+    }
+  }
+
+  static void Step(void* arg, grpc_error_handle /*error*/) {
+    Chain* chain = static_cast<Chain*>(arg);
+    GRPC_CALL_COMBINER_STOP(&chain->call_combiner, "chain");
+    if (--chain->remaining > 0) chain->Start();
+  }
+};
+
+// state.range(0) selects StartInline, state.range(1) is the length of the
+// chain started in each iteration.
+void BM_CallCombinerChain(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Chain chain;
+  chain.inline_start = state.range(0) != 0;
+  GRPC_CLOSURE_INIT(&chain.closure, Chain::Step, &chain,
+                    grpc_schedule_on_exec_ctx);
+  for (auto _ : state) {
+    chain.remaining = state.range(1);
+    chain.Start();
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  state.counters["closures_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(1)),
+      benchmark::Counter::kIsRate);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallCombinerChain)
+    ->ArgNames({"inline", "length"})
+    ->ArgsProduct({{0, 1}, {1, 4, 64}});
+
+// Two closures started at once: the second always waits for the first to
+// yield the combiner.
+void BM_CallCombinerContended(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  const bool inline_start = state.range(0) != 0;
+  grpc_core::CallCombiner call_combiner;
+  grpc_closure closures[2];
+  for (grpc_closure& closure : closures) {
+    GRPC_CLOSURE_INIT(
+        &closure,
+        [](void* arg, grpc_error_handle /*error*/) {
+          GRPC_CALL_COMBINER_STOP(static_cast<grpc_core::CallCombiner*>(arg),
+                                  "contended");
+        },
+        &call_combiner, grpc_schedule_on_exec_ctx);
+  }
+  for (auto _ : state) {
+    for (grpc_closure& closure : closures) {
+      if (inline_start) {
+        GRPC_CALL_COMBINER_START_INLINE(&call_combiner, &closure,
+                                        absl::OkStatus(), "contended");
+      } else {
+        GRPC_CALL_COMBINER_START(&call_combiner, &closure, absl::OkStatus(),
+                                 "contended");
+      }
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallCombinerContended)->ArgName("inline")->Arg(0)->Arg(1);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -34,6 +34,7 @@
 
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/ext/filters/http/client_authority_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
@@ -42,6 +43,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder_impl.h"
 #include "src/core/lib/channel/connected_channel.h"
+#include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
@@ -344,9 +346,11 @@ enum FixtureFlags : uint32_t {
   REQUIRES_TRANSPORT = 2,
 };
 
-template <const grpc_channel_filter* kFilter, uint32_t kFlags>
+template <const grpc_channel_filter* kFilter, uint32_t kFlags,
+          const grpc_channel_filter* kSecondFilter = nullptr>
 struct Fixture {
   const grpc_channel_filter* filter = kFilter;
+  const grpc_channel_filter* second_filter = kSecondFilter;
   const uint32_t flags = kFlags;
 };
 
@@ -516,7 +520,8 @@ static void BM_IsolatedFilter(benchmark::State& state) {
   grpc_core::ChannelArgs channel_args =
       grpc_core::ChannelArgs()
           .SetObject(&fake_client_channel_factory)
-          .Set(GRPC_ARG_SERVER_URI, "localhost");
+          .Set(GRPC_ARG_SERVER_URI, "localhost")
+          .Set(GRPC_ARG_DEFAULT_AUTHORITY, "localhost");
   if (fixture.flags & REQUIRES_TRANSPORT) {
     channel_args = channel_args.Set(phony_transport::Arg());
   }
@@ -525,6 +530,9 @@ static void BM_IsolatedFilter(benchmark::State& state) {
   if (fixture.filter != nullptr) {
     filters.push_back(fixture.filter);
   }
+  if (fixture.second_filter != nullptr) {
+    filters.push_back(fixture.second_filter);
+  }
   if (fixture.flags & CHECKS_NOT_LAST) {
     filters.push_back(&phony_filter::phony_filter);
     label << " #has_phony_filter";
@@ -544,6 +552,7 @@ static void BM_IsolatedFilter(benchmark::State& state) {
   grpc_core::ExecCtx::Get()->Flush();
   grpc_call_stack* call_stack =
       static_cast<grpc_call_stack*>(gpr_zalloc(channel_stack->call_stack_size));
+  state.counters["call_stack_bytes"] = channel_stack->call_stack_size;
   grpc_core::Timestamp deadline = grpc_core::Timestamp::InfFuture();
   gpr_cycle_counter start_time = gpr_get_cycle_counter();
   grpc_slice method = grpc_slice_from_static_string("/foo/bar");
@@ -609,6 +618,23 @@ typedef Fixture<&grpc_core::HttpClientFilter::kFilter,
     HttpClientFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpClientFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpClientFilter, SendEmptyMetadata);
+typedef Fixture<&grpc_core::ClientAuthorityFilter::kFilter,
+                CHECKS_NOT_LAST | REQUIRES_TRANSPORT,
+                &grpc_core::HttpClientFilter::kFilter>
+    AuthorityAndHttpClientFilters;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, AuthorityAndHttpClientFilters, NoOp);
+// The same pair, statically composed into one filter.
+const grpc_channel_filter kFusedAuthorityHttpClientFilter =
+    grpc_core::MakePromiseBasedFilter<
+        grpc_core::FusedFilter<grpc_core::ClientAuthorityFilter,
+                               grpc_core::HttpClientFilter>,
+        grpc_core::FilterEndpoint::kClient,
+        grpc_core::kFilterExaminesServerInitialMetadata>(
+        "authority+http-client");
+typedef Fixture<&kFusedAuthorityHttpClientFilter,
+                CHECKS_NOT_LAST | REQUIRES_TRANSPORT>
+    FusedAuthorityHttpClientFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, FusedAuthorityHttpClientFilter, NoOp);
 typedef Fixture<&grpc_core::HttpServerFilter::kFilter, CHECKS_NOT_LAST>
     HttpServerFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpServerFilter, NoOp);
@@ -0,0 +1,112 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark unary RPCs forwarded by a ProxyingGenericService */
+
+#include <condition_variable>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/generic/proxying_generic_service.h>
+#include <grpcpp/server_builder.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_unary_ping_pong.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// A proxy server in front of a backend served by Fixture. The proxy and its
+// clients talk over an in-process channel, so the proxy's own forwarding cost
+// is what is added to the direct case.
+template <class Fixture>
+class Proxied {
+ public:
+  explicit Proxied(Service* service)
+      : backend_(service), proxy_service_(backend_.channel()) {
+    ServerBuilder builder;
+    builder.RegisterCallbackGenericService(&proxy_service_);
+    proxy_ = builder.BuildAndStart();
+    channel_ = proxy_->InProcessChannel(ChannelArguments());
+  }
+
+  ~Proxied() { proxy_->Shutdown(gpr_inf_past(GPR_CLOCK_MONOTONIC)); }
+
+  std::shared_ptr<Channel> channel() { return channel_; }
+
+  void Finish(benchmark::State& state) { backend_.Finish(state); }
+
+ private:
+  Fixture backend_;
+  ProxyingGenericService proxy_service_;
+  std::unique_ptr<Server> proxy_;
+  std::shared_ptr<Channel> channel_;
+};
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+// Replace "benchmark::internal::Benchmark" with "::testing::Benchmark" to use
+// internal microbenchmarking tooling
+static void SweepSizesArgs(benchmark::internal::Benchmark* b) {
+  b->Args({0, 0});
+  for (int i = 1; i <= 16 * 1024 * 1024; i *= 8) {
+    // First argument is the message size of request
+    // Second argument is the message size of response
+    b->Args({i, 0});
+    b->Args({0, i});
+    b->Args({i, i});
+  }
+}
+
+// The backend alone, for comparison
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcessCHTTP2, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(SweepSizesArgs);
+
+// The same backends behind a proxy
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, Proxied<InProcess>, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, Proxied<InProcessCHTTP2>,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(SweepSizesArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -16,13 +16,45 @@
  *
  */
 
+#include <stdlib.h>
+
+#include <atomic>
+
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/callback_unary_ping_pong.h"
 #include "test/cpp/util/test_config.h"
 
+// Count the global C++ allocations made by the process, so that the per-RPC
+// allocations of the callback API can be tracked.
+static std::atomic<int64_t> g_cxx_allocs{0};
+
+void* operator new(size_t size) {
+  g_cxx_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  GPR_ASSERT(p != nullptr);
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+void operator delete(void* p, size_t /*size*/) noexcept { free(p); }
+
 namespace grpc {
 namespace testing {
 
+// Reports the C++ heap allocations per unary RPC, averaged over the run
+// (fixture setup included). Client and transport allocations are counted too;
+// the server side call state lives in the call arena.
+template <class Fixture>
+static void BM_CallbackUnaryPingPongAllocs(benchmark::State& state) {
+  int64_t start = g_cxx_allocs.load(std::memory_order_relaxed);
+  BM_CallbackUnaryPingPong<Fixture, NoOpMutator, NoOpMutator>(state);
+  state.counters["CxxAllocsPerRpc"] = benchmark::Counter(
+      static_cast<double>(g_cxx_allocs.load(std::memory_order_relaxed) -
+                          start),
+      benchmark::Counter::kAvgIterations);
+}
+
 /*******************************************************************************
  * CONFIGURATIONS
  */
@@ -101,6 +133,11 @@ BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess, NoOpMutator,
 BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
+
+// Heap allocations per RPC
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPongAllocs, InProcess)->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPongAllocs, MinInProcess)
+    ->Args({0, 0});
 }  // namespace testing
 }  // namespace grpc
 
@@ -16,10 +16,13 @@
  * grpc_core::ChannelArgs */
 
 #include <random>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include "absl/container/btree_map.h"
+#include "absl/strings/str_cat.h"
 
 #include <grpcpp/support/channel_arguments.h>
 
@@ -82,6 +85,49 @@ void BM_ChannelArgsAsKeyIntoBTree(benchmark::State& state) {
 }
 BENCHMARK(BM_ChannelArgsAsKeyIntoBTree);
 
+// state.range(0) integer args with keys like the ones channels are created
+// with.
+class ManyArgs {
+ public:
+  explicit ManyArgs(int n) {
+    for (int i = 0; i < n; i++) {
+      keys_.push_back(absl::StrCat("grpc.some_channel_arg_", i));
+    }
+    for (int i = 0; i < n; i++) {
+      c_args_.push_back(grpc_channel_arg_integer_create(
+          const_cast<char*>(keys_[i].c_str()), i));
+    }
+  }
+
+  const std::vector<std::string>& keys() const { return keys_; }
+  grpc_channel_args c_args() { return {c_args_.size(), c_args_.data()}; }
+
+ private:
+  std::vector<std::string> keys_;
+  std::vector<grpc_arg> c_args_;
+};
+
+void BM_ChannelArgsFromC(benchmark::State& state) {
+  ManyArgs args(state.range(0));
+  grpc_channel_args c_args = args.c_args();
+  for (auto s : state) {
+    benchmark::DoNotOptimize(grpc_core::ChannelArgs::FromC(&c_args));
+  }
+}
+BENCHMARK(BM_ChannelArgsFromC)->Arg(4)->Arg(16)->Arg(64);
+
+void BM_ChannelArgsGetInt(benchmark::State& state) {
+  ManyArgs args(state.range(0));
+  grpc_channel_args c_args = args.c_args();
+  auto channel_args = grpc_core::ChannelArgs::FromC(&c_args);
+  size_t n = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        channel_args.GetInt(args.keys()[n++ % args.keys().size()]));
+  }
+}
+BENCHMARK(BM_ChannelArgsGetInt)->Arg(4)->Arg(16)->Arg(64);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
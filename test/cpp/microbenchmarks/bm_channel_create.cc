@@ -0,0 +1,105 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark the cost of creating and destroying channels, as clients that fan
+// out to many backends do.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// Creates and destroys channels to state.range(0) distinct targets in turn.
+// No call is made, so the channels never connect.
+void BM_ChannelCreateDestroy(benchmark::State& state) {
+  std::vector<std::string> targets;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    targets.push_back(absl::StrCat("dns:///backend-", i, ".example.com:443"));
+  }
+  auto creds = grpc::InsecureChannelCredentials();
+  grpc::ChannelArguments args;
+  size_t next = 0;
+  for (auto _ : state) {
+    std::shared_ptr<grpc::Channel> channel =
+        grpc::CreateCustomChannel(targets[next], creds, args);
+    benchmark::DoNotOptimize(channel.get());
+    next = (next + 1) % targets.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ChannelCreateDestroy)->Arg(1)->Arg(64)->Arg(1024);
+
+// As above, but with channelz turned off, to tell its share of the cost.
+void BM_ChannelCreateDestroyWithoutChannelz(benchmark::State& state) {
+  auto creds = grpc::InsecureChannelCredentials();
+  grpc::ChannelArguments args;
+  args.SetInt(GRPC_ARG_ENABLE_CHANNELZ, 0);
+  for (auto _ : state) {
+    std::shared_ptr<grpc::Channel> channel =
+        grpc::CreateCustomChannel("dns:///backend.example.com:443", creds,
+                                  args);
+    benchmark::DoNotOptimize(channel.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ChannelCreateDestroyWithoutChannelz);
+
+// Keeps state.range(0) channels alive, as a fanout client does, replacing the
+// oldest with a new one.
+void BM_ChannelChurn(benchmark::State& state) {
+  auto creds = grpc::InsecureChannelCredentials();
+  grpc::ChannelArguments args;
+  std::vector<std::shared_ptr<grpc::Channel>> channels(state.range(0));
+  size_t next = 0;
+  for (auto _ : state) {
+    channels[next] = grpc::CreateCustomChannel(
+        absl::StrCat("dns:///backend-", next, ".example.com:443"), creds,
+        args);
+    next = (next + 1) % channels.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ChannelChurn)->Arg(64)->Arg(1024);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
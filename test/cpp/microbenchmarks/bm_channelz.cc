@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the call counting of channelz from many threads at once, against
+ * the same calls on a channel with channelz disabled, and the cost of
+ * summing the counts when channelz is queried */
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Shared by the channels of all the benchmark threads, like the helper of a
+// channel that many threads start calls on.
+channelz::CallCountingHelper* SharedHelper() {
+  static auto* helper = new channelz::CallCountingHelper();
+  return helper;
+}
+
+// state.range(0) enables channelz: when disabled, the channel has no helper
+// and each call only checks for one, as in surface/call.cc.
+void BM_CallCounting(benchmark::State& state) {
+  channelz::CallCountingHelper* helper =
+      state.range(0) != 0 ? SharedHelper() : nullptr;
+  ExecCtx exec_ctx;
+  for (auto _ : state) {
+    channelz::CallCountingHelper* call_helper = helper;
+    benchmark::DoNotOptimize(call_helper);
+    if (call_helper != nullptr) call_helper->RecordCallStarted();
+    if (call_helper != nullptr) call_helper->RecordCallSucceeded();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallCounting)
+    ->ArgName("channelz")
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+void BM_PopulateCallCounts(benchmark::State& state) {
+  channelz::CallCountingHelper* helper = SharedHelper();
+  {
+    ExecCtx exec_ctx;
+    helper->RecordCallStarted();
+  }
+  for (auto _ : state) {
+    Json::Object json;
+    helper->PopulateCallCounts(&json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+BENCHMARK(BM_PopulateCallCounts);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -22,9 +22,12 @@
 
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/strings/string_view.h"
+
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -162,6 +165,47 @@ static void BM_HpackEncoderEncodeHeader(benchmark::State& state) {
   track_counters.Finish(state);
 }
 
+// Encodes the first request on a fresh connection: nothing is in the dynamic
+// table yet, so every cacheable header is emitted as a literal.
+template <class Fixture, bool kUseLiteralCache>
+static void BM_HpackEncoderEncodeHeaderColdConnection(
+    benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+
+  auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch b(arena.get());
+  Fixture::Prepare(&b);
+
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  for (auto _ : state) {
+    grpc_core::HPackCompressor c;
+    c.SetUseLiteralCache(kUseLiteralCache);
+    c.EncodeHeaders(
+        grpc_core::HPackCompressor::EncodeHeaderOptions{
+            1,
+            false,
+            Fixture::kEnableTrueBinary,
+            16384,
+            &stats,
+        },
+        b, &outbuf);
+    grpc_slice_buffer_reset_and_unref(&outbuf);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_slice_buffer_destroy(&outbuf);
+
+  std::ostringstream label;
+  label << "header_bytes/iter:"
+        << (static_cast<double>(stats.header_bytes) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+
 namespace hpack_encoder_fixtures {
 
 class EmptyBatch {
@@ -322,6 +366,8 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<31, false>)
     ->Args({0, 16384});
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<100, false>)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<1000, false>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonBinaryElem)
     ->Args({0, 1});
@@ -339,6 +385,15 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    RepresentativeServerTrailingMetadata)
     ->Args({1, 16384});
 
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeaderColdConnection,
+                   RepresentativeClientInitialMetadata, false);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeaderColdConnection,
+                   RepresentativeClientInitialMetadata, true);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeaderColdConnection,
+                   RepresentativeServerInitialMetadata, false);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeaderColdConnection,
+                   RepresentativeServerInitialMetadata, true);
+
 }  // namespace hpack_encoder_fixtures
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -380,9 +435,11 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
     }
   };
   parse_vec(init_slices);
+  int64_t headers = 0;
   while (state.KeepRunning()) {
     b->Clear();
     parse_vec(benchmark_slices);
+    headers += b->count();
     grpc_core::ExecCtx::Get()->Flush();
     // Recreate arena every 4k iterations to avoid oom
     if (0 == (state.iterations() & 0xfff)) {
@@ -403,6 +460,8 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
   for (auto slice : benchmark_slices) grpc_slice_unref(slice);
   arena->Destroy();
 
+  state.counters["headers_per_second"] =
+      benchmark::Counter(headers, benchmark::Counter::kIsRate);
   track_counters.Finish(state);
 }
 
@@ -534,6 +593,32 @@ class NonIndexedElem {
   }
 };
 
+// Headers with literal keys, not added to the table: several of known
+// metadata traits, and a couple of custom ones.
+class NonIndexedKnownKeys {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    std::vector<uint8_t> bytes;
+    auto add = [&bytes](absl::string_view key, absl::string_view value) {
+      bytes.push_back(0x00);
+      bytes.push_back(static_cast<uint8_t>(key.size()));
+      bytes.insert(bytes.end(), key.begin(), key.end());
+      bytes.push_back(static_cast<uint8_t>(value.size()));
+      bytes.insert(bytes.end(), value.begin(), value.end());
+    };
+    add(":path", "/foo/bar");
+    add("content-type", "application/grpc");
+    add("te", "trailers");
+    add("grpc-accept-encoding", "identity,deflate,gzip");
+    add("user-agent", "grpc-c/1.0.0 (linux)");
+    add("grpc-timeout", "100m");
+    add("x-request-id", "00000000-0000-0000-0000-000000000000");
+    add("x-client-name", "benchmark");
+    return {MakeSlice(bytes)};
+  }
+};
+
 template <int kLength, bool kTrueBinary>
 class NonIndexedBinaryElem;
 
@@ -647,6 +732,7 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, IndexedSingleInternedElem);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, AddIndexedSingleInternedElem);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, KeyIndexedSingleInternedElem);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedElem);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedKnownKeys);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<1, false>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<3, false>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<10, false>);
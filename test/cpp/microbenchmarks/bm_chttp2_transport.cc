@@ -23,6 +23,7 @@
 #include <memory>
 #include <queue>
 #include <sstream>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -61,7 +62,8 @@ class PhonyEndpoint : public grpc_endpoint {
                                                    get_peer,
                                                    get_local_address,
                                                    get_fd,
-                                                   can_track_err};
+                                                   can_track_err,
+                                                   nullptr};
     grpc_endpoint::vtable = &my_vtable;
   }
 
@@ -367,6 +369,58 @@ static void BM_StreamCreateSendInitialMetadataDestroy(benchmark::State& state) {
 BENCHMARK_TEMPLATE(BM_StreamCreateSendInitialMetadataDestroy,
                    RepresentativeClientInitialMetadata);
 
+// Many open streams on one transport all cancelled at once, as when a peer
+// goes away or a deadline fires for a whole batch of calls.
+static void BM_StreamCancelStorm(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Fixture f(grpc::ChannelArguments(), true);
+  const int num_streams = state.range(0);
+  std::vector<std::unique_ptr<Stream>> streams;
+  std::vector<std::unique_ptr<grpc_transport_stream_op_batch_payload>> payloads;
+  for (int i = 0; i < num_streams; i++) {
+    streams.emplace_back(new Stream(&f));
+    payloads.emplace_back(new grpc_transport_stream_op_batch_payload(nullptr));
+  }
+  std::vector<grpc_transport_stream_op_batch> ops(num_streams);
+  auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch b(arena.get());
+  RepresentativeClientInitialMetadata::Prepare(&b);
+  std::unique_ptr<TestClosure> sent =
+      MakeTestClosure([](grpc_error_handle /*error*/) {});
+  const grpc_error_handle cancel_error = absl::CancelledError();
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int i = 0; i < num_streams; i++) {
+      streams[i]->Init(state);
+      ops[i] = {};
+      ops[i].payload = payloads[i].get();
+      ops[i].on_complete = sent.get();
+      ops[i].send_initial_metadata = true;
+      payloads[i]->send_initial_metadata.send_initial_metadata = &b;
+      streams[i]->Op(&ops[i]);
+    }
+    f.FlushExecCtx();
+    state.ResumeTiming();
+    for (int i = 0; i < num_streams; i++) {
+      ops[i] = {};
+      ops[i].payload = payloads[i].get();
+      ops[i].cancel_stream = true;
+      payloads[i]->cancel_stream.cancel_error = cancel_error;
+      streams[i]->Op(&ops[i]);
+    }
+    f.FlushExecCtx();
+    state.PauseTiming();
+    for (auto& s : streams) s->DestroyThen(nullptr);
+    f.FlushExecCtx();
+    state.ResumeTiming();
+  }
+  streams.clear();
+  f.FlushExecCtx();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamCancelStorm)->Range(1, 1024);
+
 static void BM_TransportEmptyOp(benchmark::State& state) {
   TrackCounters track_counters;
   grpc_core::ExecCtx exec_ctx;
@@ -410,6 +464,75 @@ static void BM_TransportEmptyOp(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportEmptyOp);
 
+static void InitStreamMap(grpc_chttp2_stream_map* map, bool open_addressing) {
+  // Same initial capacity as the transport.
+  if (open_addressing) {
+    grpc_chttp2_stream_map_init_open_addressing(map, 8);
+  } else {
+    grpc_chttp2_stream_map_init(map, 8);
+  }
+}
+
+// Looks up one of state.range(0) live streams, as done for every incoming
+// frame.
+template <bool kOpenAddressing>
+static void BM_StreamMapFind(benchmark::State& state) {
+  const uint32_t n = state.range(0);
+  grpc_chttp2_stream_map map;
+  InitStreamMap(&map, kOpenAddressing);
+  // Client initiated stream ids are odd.
+  for (uint32_t i = 0; i < n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i + 1, &map);
+  }
+  uint32_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, 2 * (i % n) + 1));
+    i += 7919;
+  }
+  for (uint32_t j = 0; j < n; j++) {
+    grpc_chttp2_stream_map_delete(&map, 2 * j + 1);
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+BENCHMARK_TEMPLATE(BM_StreamMapFind, false)
+    ->RangeMultiplier(8)
+    ->Range(1, 32768);
+BENCHMARK_TEMPLATE(BM_StreamMapFind, true)
+    ->RangeMultiplier(8)
+    ->Range(1, 32768);
+
+// Opens a new stream and closes the oldest one while state.range(0) streams
+// stay live, exercising growth and compaction (or probe sequence repair).
+template <bool kOpenAddressing>
+static void BM_StreamMapChurn(benchmark::State& state) {
+  const uint32_t n = state.range(0);
+  grpc_chttp2_stream_map map;
+  InitStreamMap(&map, kOpenAddressing);
+  uint32_t next_id = 1;
+  for (uint32_t i = 0; i < n; i++) {
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+    next_id += 2;
+  }
+  uint32_t oldest_id = 1;
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+    next_id += 2;
+    grpc_chttp2_stream_map_delete(&map, oldest_id);
+    oldest_id += 2;
+  }
+  for (; oldest_id < next_id; oldest_id += 2) {
+    grpc_chttp2_stream_map_delete(&map, oldest_id);
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+BENCHMARK_TEMPLATE(BM_StreamMapChurn, false)
+    ->RangeMultiplier(8)
+    ->Range(1, 32768);
+BENCHMARK_TEMPLATE(BM_StreamMapChurn, true)
+    ->RangeMultiplier(8)
+    ->Range(1, 32768);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
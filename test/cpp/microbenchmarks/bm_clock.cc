@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark reading the clocks behind Timestamp::Now(). Run with
+ * GRPC_TSC_CLOCK=1 to have BM_TimestampNow read the TSC clock. */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/tsc_clock.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+void BM_GprNowMonotonic(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gpr_now(GPR_CLOCK_MONOTONIC));
+  }
+}
+BENCHMARK(BM_GprNowMonotonic)->ThreadRange(1, 16);
+
+void BM_TscClockNow(benchmark::State& state) {
+  if (!TscClock::Supported()) {
+    state.SkipWithError("no invariant TSC");
+    return;
+  }
+  static TscClock* clock = new TscClock();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(clock->Now());
+  }
+}
+BENCHMARK(BM_TscClockNow)->ThreadRange(1, 16);
+
+void BM_TimestampNow(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Timestamp::Now());
+  }
+}
+BENCHMARK(BM_TimestampNow)->ThreadRange(1, 16);
+
+// Reads through the time cache of an ExecCtx, invalidating it as often as
+// the argument says, as exec_ctx flushes do.
+void BM_ExecCtxNow(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  const int64_t invalidate_every = state.range(0);
+  int64_t reads = 0;
+  for (auto _ : state) {
+    if (++reads == invalidate_every) {
+      reads = 0;
+      exec_ctx.InvalidateNow();
+    }
+    benchmark::DoNotOptimize(exec_ctx.Now());
+  }
+}
+BENCHMARK(BM_ExecCtxNow)->Arg(1)->Arg(8)->Arg(64);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
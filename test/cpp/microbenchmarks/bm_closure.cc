@@ -136,6 +136,55 @@ static void BM_ClosureSchedOnExecCtx(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureSchedOnExecCtx);
 
+static void BM_ClosureCreateAndSchedOnExecCtx(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION,
+        GRPC_CLOSURE_CREATE(DoNothing, nullptr, grpc_schedule_on_exec_ctx),
+        absl::OkStatus());
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ClosureCreateAndSchedOnExecCtx);
+
+// The same one-shot work as above, without the allocation.
+static void BM_CallbackSchedOnExecCtx(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  int runs = 0;
+  for (auto _ : state) {
+    grpc_core::ExecCtx::RunCallback(DEBUG_LOCATION, [&runs]() { ++runs; });
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  benchmark::DoNotOptimize(runs);
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallbackSchedOnExecCtx);
+
+// Schedules state.range(0) callbacks before each flush: past the number the
+// ExecCtx holds inline, the rest allocate.
+static void BM_CallbacksSchedOnExecCtx(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  int runs = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); i++) {
+      grpc_core::ExecCtx::RunCallback(DEBUG_LOCATION, [&runs]() { ++runs; });
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  benchmark::DoNotOptimize(runs);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallbacksSchedOnExecCtx)->Arg(4)->Arg(8)->Arg(16);
+
 static void BM_ClosureSched2OnExecCtx(benchmark::State& state) {
   TrackCounters track_counters;
   grpc_closure c1;
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include <atomic>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -42,6 +43,8 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+/* Number of completions queued by each pollset_work() call */
+static int g_completions_per_work = 1;
 
 namespace grpc {
 namespace testing {
@@ -68,7 +71,7 @@ static void cq_done_cb(void* /*done_arg*/, grpc_cq_completion* cq_completion) {
   gpr_free(cq_completion);
 }
 
-/* Queues a completion tag if deadline is > 0.
+/* Queues g_completions_per_work completion tags if deadline is > 0.
  * Does nothing if deadline is 0 (i.e gpr_time_0(GPR_CLOCK_MONOTONIC)) */
 static grpc_error_handle pollset_work(grpc_pollset* ps,
                                       grpc_pollset_worker** /*worker*/,
@@ -81,10 +84,12 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
   gpr_mu_unlock(&ps->mu);
 
   void* tag = reinterpret_cast<void*>(10);  // Some random number
-  GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
-  grpc_cq_end_op(
-      g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
-      static_cast<grpc_cq_completion*>(gpr_malloc(sizeof(grpc_cq_completion))));
+  for (int i = 0; i < g_completions_per_work; i++) {
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
   grpc_core::ExecCtx::Get()->Flush();
   gpr_mu_lock(&ps->mu);
   return absl::OkStatus();
@@ -114,12 +119,13 @@ static grpc_event_engine_vtable make_engine_vtable(const char* name) {
   return vtable;
 }
 
-static void setup() {
+static void setup(int completions_per_work) {
   grpc_init();
   GPR_ASSERT(strcmp(grpc_get_poll_strategy_name(), "none") == 0 ||
              strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") ==
                  0);
 
+  g_completions_per_work = completions_per_work;
   g_cq = grpc_completion_queue_create_for_next(nullptr);
 }
 
@@ -157,14 +163,12 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+static void start_benchmark_thread(int thd_idx, int completions_per_work) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  auto thd_idx = state.thread_index();
-
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
-    setup();
+    setup(completions_per_work);
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -173,19 +177,10 @@ static void BM_Cq_Throughput(benchmark::State& state) {
     }
   }
   gpr_mu_unlock(&g_mu);
+}
 
-  // Use a TrackCounters object to monitor the gRPC performance statistics
-  // (optionally including low-level counters) before and after the test
-  TrackCounters track_counters;
-
-  for (auto _ : state) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
-  }
-
-  state.SetItemsProcessed(state.iterations());
-  track_counters.Finish(state);
-
+static void finish_benchmark_thread(int thd_idx) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   gpr_mu_lock(&g_mu);
   g_threads_active--;
   if (g_threads_active == 0) {
@@ -203,8 +198,62 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index();
+
+  start_benchmark_thread(thd_idx, 1);
+
+  // Use a TrackCounters object to monitor the gRPC performance statistics
+  // (optionally including low-level counters) before and after the test
+  TrackCounters track_counters;
+
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+
+  finish_benchmark_thread(thd_idx);
+}
+
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
 
+/* Like BM_Cq_Throughput, but each poll queues state.range(0) completions and
+   every thread takes them out with grpc_completion_queue_next_batch */
+static void BM_Cq_BatchThroughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index();
+  const int batch_size = state.range(0);
+  std::vector<grpc_event> events(batch_size);
+
+  start_benchmark_thread(thd_idx, batch_size);
+
+  TrackCounters track_counters;
+
+  int64_t items = 0;
+  for (auto _ : state) {
+    size_t n = grpc_completion_queue_next_batch(g_cq, events.data(),
+                                                events.size(), deadline,
+                                                nullptr);
+    GPR_ASSERT(events[0].type == GRPC_OP_COMPLETE);
+    items += n;
+  }
+
+  state.SetItemsProcessed(items);
+  track_counters.Finish(state);
+
+  finish_benchmark_thread(thd_idx);
+}
+
+BENCHMARK(BM_Cq_BatchThroughput)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
 namespace {
 const grpc_event_engine_vtable g_none_vtable =
     grpc::testing::make_engine_vtable("none");
@@ -0,0 +1,268 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares moving bytes through the event engine's posix endpoint with moving
+// them through the iomgr tcp endpoint, over the same kind of socket pair.
+
+#include <limits.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/slice.h>
+#include <grpc/event_engine/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpcpp/impl/grpc_library.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller_posix_default.h"
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/event_engine/posix_engine/tcp_socket_utils.h"
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+
+#include <sys/socket.h>
+
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+using ::grpc_event_engine::experimental::Slice;
+using ::grpc_event_engine::experimental::SliceBuffer;
+using ::grpc_event_engine::posix_engine::CreatePosixEndpoint;
+using ::grpc_event_engine::posix_engine::PosixEndpoint;
+using ::grpc_event_engine::posix_engine::PosixEventPoller;
+using ::grpc_event_engine::posix_engine::PosixTcpOptions;
+using ::grpc_event_engine::posix_engine::Scheduler;
+
+grpc_slice MakePayload(size_t length) {
+  grpc_slice slice = grpc_slice_malloc(length);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', length);
+  return slice;
+}
+
+// iomgr
+
+struct IomgrTransfer {
+  gpr_mu* mu;
+  grpc_pollset* pollset;
+  grpc_endpoint* reader;
+  grpc_slice_buffer incoming;
+  grpc_closure on_read;
+  grpc_closure on_write;
+  size_t want;
+  size_t received;
+  bool write_done;
+};
+
+void IomgrOnRead(void* arg, grpc_error_handle error) {
+  auto* t = static_cast<IomgrTransfer*>(arg);
+  GPR_ASSERT(error.ok());
+  t->received += t->incoming.length;
+  grpc_slice_buffer_reset_and_unref(&t->incoming);
+  if (t->received < t->want) {
+    grpc_endpoint_read(t->reader, &t->incoming, &t->on_read, false, 1);
+    return;
+  }
+  gpr_mu_lock(t->mu);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("kick", grpc_pollset_kick(t->pollset, nullptr)));
+  gpr_mu_unlock(t->mu);
+}
+
+void IomgrOnWrite(void* arg, grpc_error_handle error) {
+  auto* t = static_cast<IomgrTransfer*>(arg);
+  GPR_ASSERT(error.ok());
+  gpr_mu_lock(t->mu);
+  t->write_done = true;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("kick", grpc_pollset_kick(t->pollset, nullptr)));
+  gpr_mu_unlock(t->mu);
+}
+
+void DestroyPollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+void BM_IomgrEndpoint_Transfer(benchmark::State& state) {
+  const size_t length = state.range(0);
+  grpc_core::ExecCtx exec_ctx;
+  IomgrTransfer t;
+  t.pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(t.pollset, &t.mu);
+  grpc_endpoint_pair p = grpc_iomgr_create_endpoint_pair("bm", nullptr);
+  grpc_endpoint_add_to_pollset(p.client, t.pollset);
+  grpc_endpoint_add_to_pollset(p.server, t.pollset);
+  t.reader = p.server;
+  grpc_slice_buffer_init(&t.incoming);
+  GRPC_CLOSURE_INIT(&t.on_read, IomgrOnRead, &t, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&t.on_write, IomgrOnWrite, &t, grpc_schedule_on_exec_ctx);
+  grpc_slice payload = MakePayload(length);
+  grpc_slice_buffer outgoing;
+  grpc_slice_buffer_init(&outgoing);
+  for (auto _ : state) {
+    t.want = length;
+    t.received = 0;
+    t.write_done = false;
+    grpc_slice_buffer_add(&outgoing, grpc_slice_ref(payload));
+    grpc_endpoint_read(p.server, &t.incoming, &t.on_read, false, 1);
+    grpc_endpoint_write(p.client, &outgoing, &t.on_write, nullptr,
+                        /*max_frame_size=*/INT_MAX);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(t.mu);
+    while (t.received < t.want || !t.write_done) {
+      grpc_pollset_worker* worker = nullptr;
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(t.pollset, &worker,
+                            grpc_core::Timestamp::InfFuture())));
+      gpr_mu_unlock(t.mu);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(t.mu);
+    }
+    gpr_mu_unlock(t.mu);
+    grpc_slice_buffer_reset_and_unref(&outgoing);
+  }
+  state.SetBytesProcessed(length * state.iterations());
+  grpc_slice_unref(payload);
+  grpc_slice_buffer_destroy(&outgoing);
+  grpc_slice_buffer_destroy(&t.incoming);
+  grpc_endpoint_destroy(p.client);
+  grpc_endpoint_destroy(p.server);
+  grpc_closure destroyed;
+  GRPC_CLOSURE_INIT(&destroyed, DestroyPollset, t.pollset,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(t.pollset, &destroyed);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(t.pollset);
+}
+BENCHMARK(BM_IomgrEndpoint_Transfer)->Range(1, 4 * 1024 * 1024);
+
+// Event engine
+
+class EngineScheduler : public Scheduler {
+ public:
+  explicit EngineScheduler(EventEngine* engine) : engine_(engine) {}
+  void Run(EventEngine::Closure* closure) override { engine_->Run(closure); }
+  void Run(absl::AnyInvocable<void()> cb) override {
+    engine_->Run(std::move(cb));
+  }
+
+ private:
+  EventEngine* engine_;
+};
+
+void BM_EventEngineEndpoint_Transfer(benchmark::State& state) {
+  const size_t length = state.range(0);
+  auto engine = std::make_shared<PosixEventEngine>();
+  EngineScheduler scheduler(engine.get());
+  PosixEventPoller* poller =
+      grpc_event_engine::posix_engine::GetDefaultPoller(&scheduler);
+  if (poller == nullptr) {
+    state.SkipWithError("no event engine poller available");
+    return;
+  }
+  std::atomic<bool> shutdown{false};
+  std::thread poll_thread([poller, &shutdown]() {
+    while (!shutdown.load(std::memory_order_acquire)) {
+      poller->Work(std::chrono::hours(24), []() {});
+    }
+  });
+  int fds[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  PosixTcpOptions options;
+  options.resource_quota = grpc_core::ResourceQuota::Default();
+  auto create = [&](int fd) {
+    GPR_ASSERT(grpc_event_engine::posix_engine::PosixSocketWrapper(fd)
+                   .SetSocketNonBlocking(1)
+                   .ok());
+    return CreatePosixEndpoint(
+        poller->CreateHandle(fd, "bm", poller->CanTrackErrors()), nullptr,
+        engine, options);
+  };
+  std::unique_ptr<PosixEndpoint> client = create(fds[0]);
+  std::unique_ptr<PosixEndpoint> server = create(fds[1]);
+  grpc_slice payload = MakePayload(length);
+  SliceBuffer outgoing;
+  SliceBuffer incoming;
+  for (auto _ : state) {
+    grpc_core::Notification write_done;
+    outgoing.Append(Slice(grpc_slice_ref(payload)));
+    client->Write(
+        [&write_done](absl::Status status) {
+          GPR_ASSERT(status.ok());
+          write_done.Notify();
+        },
+        &outgoing, nullptr);
+    size_t received = 0;
+    while (received < length) {
+      grpc_core::Notification read_done;
+      server->Read(
+          [&read_done](absl::Status status) {
+            GPR_ASSERT(status.ok());
+            read_done.Notify();
+          },
+          &incoming, nullptr);
+      read_done.WaitForNotification();
+      received += incoming.Length();
+      incoming.Clear();
+    }
+    write_done.WaitForNotification();
+    outgoing.Clear();
+  }
+  state.SetBytesProcessed(length * state.iterations());
+  grpc_slice_unref(payload);
+  client.reset();
+  server.reset();
+  shutdown.store(true, std::memory_order_release);
+  poller->Kick();
+  poll_thread.join();
+  poller->Shutdown();
+}
+BENCHMARK(BM_EventEngineEndpoint_Transfer)->Range(1, 4 * 1024 * 1024);
+
+}  // namespace
+
+#endif  // GRPC_POSIX_SOCKET_TCP
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
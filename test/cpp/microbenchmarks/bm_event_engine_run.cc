@@ -124,6 +124,34 @@ BENCHMARK(BM_EventEngine_RunClosure)
     ->MeasureProcessCPUTime()
     ->UseRealTime();
 
+// Every benchmark thread is an independent producer scheduling callbacks onto
+// the shared default engine, which exercises contention on the executor's
+// queues.
+void BM_EventEngine_RunFromManyProducers(benchmark::State& state) {
+  auto engine = GetDefaultEventEngine();
+  const int cb_count = state.range(0);
+  std::atomic_int count{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    grpc_core::Notification signal;
+    auto cb = [&signal, &count, cb_count]() {
+      if (++count == cb_count) signal.Notify();
+    };
+    state.ResumeTiming();
+    for (int i = 0; i < cb_count; i++) {
+      engine->Run(cb);
+    }
+    signal.WaitForNotification();
+    count.store(0);
+  }
+  state.SetItemsProcessed(cb_count * state.iterations());
+}
+BENCHMARK(BM_EventEngine_RunFromManyProducers)
+    ->Range(100, 4096)
+    ->ThreadRange(1, 16)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
 void FanoutTestArguments(benchmark::internal::Benchmark* b) {
   // TODO(hork): enable when the engines are fast enough to run these:
   // ->Args({10000, 1})  // chain of callbacks scheduling callbacks
@@ -45,6 +45,24 @@ BENCHMARK(BM_ExecCtx_Run)
     ->MeasureProcessCPUTime()
     ->UseRealTime();
 
+void BM_ExecCtx_RunCallback(benchmark::State& state) {
+  int cb_count = state.range(0);
+  int runs = 0;
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    for (int i = 0; i < cb_count; i++) {
+      grpc_core::ExecCtx::RunCallback(DEBUG_LOCATION, [&runs]() { ++runs; });
+      exec_ctx.Flush();
+    }
+  }
+  benchmark::DoNotOptimize(runs);
+  state.SetItemsProcessed(cb_count * state.iterations());
+}
+BENCHMARK(BM_ExecCtx_RunCallback)
+    ->Range(100, 10000)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
 struct CountingCbData {
   std::atomic_int cnt{0};
   grpc_core::Notification* signal;
@@ -0,0 +1,162 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the rate of unary calls a single connection sustains with many
+ * calls in flight, e.g. to compare with and without the
+ * chttp2_parallel_stream_delivery experiment (GRPC_EXPERIMENTS), or how the
+ * inproc transport scales with its calls */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
+
+// Keeps state.range(0) unary calls in flight on the channel of the fixture,
+// with messages of state.range(1) bytes both ways. An iteration is a call.
+template <class Fixture>
+static void BM_ConcurrentUnary(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  const size_t concurrency = state.range(0);
+  EchoRequest send_request;
+  EchoResponse send_response;
+  if (state.range(1) > 0) {
+    send_request.set_message(std::string(state.range(1), 'a'));
+    send_response.set_message(std::string(state.range(1), 'a'));
+  }
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+
+  // Client calls use the even tags, server calls the odd ones.
+  struct ClientCall {
+    std::unique_ptr<ClientContext> ctx;
+    EchoResponse recv_response;
+    Status recv_status;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader;
+  };
+  struct ServerCall {
+    std::unique_ptr<ServerContext> ctx;
+    EchoRequest recv_request;
+    std::unique_ptr<ServerAsyncResponseWriter<EchoResponse>> response_writer;
+    bool replied = false;
+  };
+  std::vector<ClientCall> client_calls(concurrency);
+  std::vector<ServerCall> server_calls(concurrency);
+  auto start_client_call = [&](size_t i) {
+    ClientCall& call = client_calls[i];
+    call.ctx = std::make_unique<ClientContext>();
+    call.response_reader =
+        stub->AsyncEcho(call.ctx.get(), send_request, fixture->cq());
+    call.response_reader->Finish(&call.recv_response, &call.recv_status,
+                                 tag(2 * i));
+  };
+  auto request_server_call = [&](size_t i) {
+    ServerCall& call = server_calls[i];
+    call.ctx = std::make_unique<ServerContext>();
+    call.response_writer =
+        std::make_unique<ServerAsyncResponseWriter<EchoResponse>>(
+            call.ctx.get());
+    call.replied = false;
+    service.RequestEcho(call.ctx.get(), &call.recv_request,
+                        call.response_writer.get(), fixture->cq(),
+                        fixture->cq(), tag(2 * i + 1));
+  };
+  for (size_t i = 0; i < concurrency; ++i) {
+    request_server_call(i);
+    start_client_call(i);
+  }
+
+  for (auto _ : state) {
+    // Serve calls until one completes on the client, and replace it.
+    while (true) {
+      void* t;
+      bool ok;
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      intptr_t tagnum = reinterpret_cast<intptr_t>(t);
+      size_t i = tagnum / 2;
+      if (tagnum % 2 == 1) {
+        ServerCall& call = server_calls[i];
+        if (call.replied) {
+          request_server_call(i);
+        } else {
+          call.replied = true;
+          call.response_writer->Finish(send_response, Status::OK, t);
+        }
+        continue;
+      }
+      GPR_ASSERT(client_calls[i].recv_status.ok());
+      start_client_call(i);
+      break;
+    }
+  }
+  fixture->Finish(state);
+  // Cancels the calls still in flight, and drains their completions.
+  fixture.reset();
+  state.SetBytesProcessed(2 * state.range(1) * state.iterations());
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+static void ConcurrencyArgs(benchmark::internal::Benchmark* b) {
+  for (int concurrency : {1, 64, 1024}) {
+    for (int message_size : {0, 1024, 64 * 1024}) {
+      b->Args({concurrency, message_size});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, TCP)->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, InProcess)->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, InProcessCHTTP2)
+    ->Apply(ConcurrencyArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -86,6 +86,12 @@ BENCHMARK_TEMPLATE(BM_StreamingPingPongMsgs, MinInProcess, NoOpMutator,
                    NoOpMutator)
     ->Range(0, kMaxMessageSize);
 
+BENCHMARK_TEMPLATE(BM_StreamingPingPong, RetryTCP, NoOpMutator, NoOpMutator)
+    ->Apply(StreamingPingPongArgs);
+BENCHMARK_TEMPLATE(BM_StreamingPingPongMsgs, RetryTCP, NoOpMutator,
+                   NoOpMutator)
+    ->Range(0, kMaxMessageSize);
+
 // Generate Args for StreamingPingPongWithCoalescingApi benchmarks. Currently
 // generates args for only "small streams" (i.e streams with 0, 1 or 2 messages)
 static void StreamingPingPongWithCoalescingApiArgs(
@@ -45,6 +45,21 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcess)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcessCHTTP2)
     ->Range(0, 128 * 1024 * 1024);
+
+static void FairnessArgs(benchmark::internal::Benchmark* b) {
+  for (int bulk_message_size : {64 * 1024, 1024 * 1024, 16 * 1024 * 1024}) {
+    for (int small_message_size : {0, 1024}) {
+      for (int small_weight : {16, 256}) {
+        b->Args({bulk_message_size, small_message_size, small_weight});
+      }
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_PumpStreamsFairness, TCP)->Apply(FairnessArgs);
+BENCHMARK_TEMPLATE(BM_PumpStreamsFairness, InProcessCHTTP2)
+    ->Apply(FairnessArgs);
+
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinInProcess)->Arg(0);
@@ -16,7 +16,9 @@
  *
  */
 
-/* Benchmark gRPC end2end in various configurations */
+/* Benchmark gRPC end2end in various configurations.
+   GRPC_EXPERIMENTS=connected_channel_inline_callbacks compares the cost of the
+   call combiner hops of the batch based call path */
 
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/fullstack_unary_ping_pong.h"
@@ -61,6 +63,20 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2, NoOpMutator, NoOpMutator)
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinInProcessCHTTP2, NoOpMutator,
                    NoOpMutator)
     ->Apply(SweepSizesArgs);
+// A unary ping-pong never has frames from another stream to coalesce with, so
+// these show the latency cost of holding small writes back for the window,
+// and that writes above the byte limit are not held back.
+typedef WriteCoalesce<TCP, 16 * 1024, 1000> WriteCoalescingTCP;
+typedef WriteCoalesce<InProcessCHTTP2, 16 * 1024, 1000>
+    WriteCoalescingInProcessCHTTP2;
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, WriteCoalescingTCP, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0})
+    ->Args({64 * 1024, 64 * 1024});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, WriteCoalescingInProcessCHTTP2,
+                   NoOpMutator, NoOpMutator)
+    ->Args({0, 0})
+    ->Args({64 * 1024, 64 * 1024});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2,
                    Client_AddMetadata<RandomBinaryMetadata<10>, 1>, NoOpMutator)
     ->Args({0, 0});
@@ -0,0 +1,104 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark the startup cost of short-lived processes: bringing the library up
+// and down, building the core configuration, and making the first call.
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+class EchoServiceImpl : public grpc::testing::EchoTestService::Service {
+ public:
+  grpc::Status Echo(grpc::ServerContext* /*context*/,
+                    const grpc::testing::EchoRequest* request,
+                    grpc::testing::EchoResponse* response) override {
+    response->set_message(request->message());
+    return grpc::Status::OK;
+  }
+};
+
+void BM_GrpcInitShutdown(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_GrpcInitShutdown)->UseRealTime();
+
+void BM_BuildCoreConfiguration(benchmark::State& state) {
+  grpc_init();
+  for (auto _ : state) {
+    grpc_core::CoreConfiguration::Reset();
+    benchmark::DoNotOptimize(&grpc_core::CoreConfiguration::Get());
+  }
+  grpc_shutdown_blocking();
+}
+BENCHMARK(BM_BuildCoreConfiguration);
+
+// The whole life of a process that makes a single call: from grpc_init,
+// through a server and an in-process channel to it, to grpc_shutdown.
+void BM_FirstUnaryCall(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_core::CoreConfiguration::Reset();
+    {
+      EchoServiceImpl service;
+      grpc::ServerBuilder builder;
+      builder.RegisterService(&service);
+      std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+      auto stub = grpc::testing::EchoTestService::NewStub(
+          server->InProcessChannel(grpc::ChannelArguments()));
+      grpc::ClientContext context;
+      grpc::testing::EchoRequest request;
+      grpc::testing::EchoResponse response;
+      request.set_message("hello");
+      grpc::Status status = stub->Echo(&context, request, &response);
+      GPR_ASSERT(status.ok());
+      server->Shutdown();
+    }
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_FirstUnaryCall)->UseRealTime();
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -22,24 +22,51 @@
 #include "src/core/lib/slice/slice.h"
 #include "test/core/util/test_config.h"
 
-static const std::vector<uint8_t>* kInput = [] {
-  std::vector<uint8_t> v;
+static const std::vector<uint8_t>* kPlainInput = [] {
+  auto* v = new std::vector<uint8_t>();
   std::mt19937 rd(0);
   std::uniform_int_distribution<> dist_ty(0, 100);
   std::uniform_int_distribution<> dist_byte(0, 255);
   std::uniform_int_distribution<> dist_normal(32, 126);
   for (int i = 0; i < 1024 * 1024; i++) {
     if (dist_ty(rd) == 1) {
-      v.push_back(dist_byte(rd));
+      v->push_back(dist_byte(rd));
     } else {
-      v.push_back(dist_normal(rd));
+      v->push_back(dist_normal(rd));
     }
   }
-  grpc_core::Slice s = grpc_core::Slice::FromCopiedBuffer(v);
+  return v;
+}();
+
+static const std::vector<uint8_t>* kInput = [] {
+  grpc_core::Slice s = grpc_core::Slice::FromCopiedBuffer(*kPlainInput);
   grpc_core::Slice c(grpc_chttp2_huffman_compress(s.c_slice()));
   return new std::vector<uint8_t>(c.begin(), c.end());
 }();
 
+static void BM_Encode(benchmark::State& state) {
+  grpc_core::Slice input = grpc_core::Slice::FromCopiedBuffer(*kPlainInput);
+  for (auto _ : state) {
+    grpc_core::Slice output(grpc_chttp2_huffman_compress(input.c_slice()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Encode);
+
+// The path taken for -bin metadata when the peer does not support true
+// binary metadata.
+static void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  grpc_core::Slice input = grpc_core::Slice::FromCopiedBuffer(*kPlainInput);
+  for (auto _ : state) {
+    grpc_core::Slice output(
+        grpc_chttp2_base64_encode_and_huffman_compress(input.c_slice()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress);
+
 static void BM_Decode(benchmark::State& state) {
   std::vector<uint8_t> output;
   auto add = [&output](uint8_t c) { output.push_back(c); };
@@ -49,6 +76,7 @@ static void BM_Decode(benchmark::State& state) {
                                           kInput->data() + kInput->size())
         .Run();
   }
+  state.SetBytesProcessed(state.iterations() * kInput->size());
 }
 BENCHMARK(BM_Decode);
 
@@ -451,6 +479,7 @@ static void BM_LegacyDecode(benchmark::State& state) {
       nibble(c & 0xf);
     }
   }
+  state.SetBytesProcessed(state.iterations() * kInput->size());
 }
 BENCHMARK(BM_LegacyDecode);
 
@@ -0,0 +1,126 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing JSON documents shaped like service configs, and dumping
+ * them back */
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// A service config with num_methods method configs, each with a name, a
+// timeout and a retry policy.
+std::string ServiceConfigJson(int num_methods) {
+  std::vector<std::string> method_configs;
+  for (int i = 0; i < num_methods; i++) {
+    method_configs.push_back(absl::StrCat(
+        "{\n"
+        "  \"name\": [\n"
+        "    {\"service\": \"grpc.testing.SomeService\", \"method\": \"Method",
+        i,
+        "\"}\n"
+        "  ],\n"
+        "  \"waitForReady\": true,\n"
+        "  \"timeout\": \"1.5s\",\n"
+        "  \"maxRequestMessageBytes\": 4194304,\n"
+        "  \"retryPolicy\": {\n"
+        "    \"maxAttempts\": 3,\n"
+        "    \"initialBackoff\": \"0.1s\",\n"
+        "    \"maxBackoff\": \"10s\",\n"
+        "    \"backoffMultiplier\": 1.6,\n"
+        "    \"retryableStatusCodes\": [\"UNAVAILABLE\", \"ABORTED\"]\n"
+        "  }\n"
+        "}"));
+  }
+  return absl::StrCat(
+      "{\n"
+      "\"loadBalancingConfig\": [{\"round_robin\": {}}],\n"
+      "\"methodConfig\": [\n",
+      absl::StrJoin(method_configs, ",\n"), "\n]\n}");
+}
+
+void BM_JsonParse(benchmark::State& state) {
+  const std::string json = ServiceConfigJson(state.range(0));
+  for (auto _ : state) {
+    auto parsed = Json::Parse(json);
+    if (!parsed.ok()) abort();
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JsonParse)->Arg(1)->Arg(100)->Arg(10000);
+
+// Long string values, like certificates and policies embedded in configs.
+void BM_JsonParseLongStrings(benchmark::State& state) {
+  std::vector<std::string> values;
+  for (int i = 0; i < 16; i++) {
+    values.push_back(
+        absl::StrCat("\"", std::string(state.range(0), 'a' + i), "\""));
+  }
+  const std::string json = absl::StrCat("[", absl::StrJoin(values, ","), "]");
+  for (auto _ : state) {
+    auto parsed = Json::Parse(json);
+    if (!parsed.ok()) abort();
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JsonParseLongStrings)->Arg(64)->Arg(4096);
+
+void BM_JsonDump(benchmark::State& state) {
+  auto parsed = Json::Parse(ServiceConfigJson(state.range(0)));
+  GPR_ASSERT(parsed.ok());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parsed->Dump());
+  }
+}
+BENCHMARK(BM_JsonDump)->Arg(1)->Arg(100)->Arg(10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
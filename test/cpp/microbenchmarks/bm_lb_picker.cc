@@ -0,0 +1,500 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the pickers of LB policies, and the updates that rebuild them,
+ * with fake subchannels that are READY as soon as they are watched. The rls
+ * policy looks its keys up in a fake RLS server. */
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/env.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/security/credentials/credentials.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/test_lb_policies.h"
+#include "test/cpp/end2end/rls_server.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr char kPath[] = "/bm.Service/Pick";
+constexpr char kRlsKeyHeader[] = "rls-key";
+// The RLS server knows this many keys, each routed to its own endpoint.
+constexpr int kMaxRlsKeys = 1000;
+// The number of children weighted_target spreads the endpoints over.
+constexpr int kWeightedTargetChildren = 4;
+// How many different requests each thread cycles through.
+constexpr size_t kRequests = 4096;
+
+enum class Policy {
+  kRoundRobin,
+  kRingHash,
+  kWeightedTarget,
+  kOutlierDetection,
+  kRls,
+};
+
+std::string EndpointAddress(size_t i, int port) {
+  return absl::StrCat("10.", i / 65536, ".", i / 256 % 256, ".", i % 256, ":",
+                      port);
+}
+
+std::string RlsKey(size_t i) { return absl::StrCat("key", i); }
+
+// Runs the fake RLS server for the whole run.
+class FakeRlsServer {
+ public:
+  FakeRlsServer() : port_(grpc_pick_unused_port_or_die()) {
+    for (int i = 0; i < kMaxRlsKeys; ++i) {
+      service_.SetResponse(
+          grpc::testing::BuildRlsRequest({{"k", RlsKey(i)}}),
+          grpc::testing::BuildRlsResponse(
+              {absl::StrCat("ipv4:", EndpointAddress(i, 443))}));
+    }
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("localhost:", port_),
+                             grpc::InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    GPR_ASSERT(server_ != nullptr);
+  }
+
+  ~FakeRlsServer() { server_->Shutdown(); }
+
+  int port() const { return port_; }
+
+ private:
+  const int port_;
+  grpc::testing::RlsServiceImpl service_;
+  std::unique_ptr<grpc::Server> server_;
+};
+
+FakeRlsServer* g_rls_server;
+
+std::string PolicyConfig(Policy policy) {
+  switch (policy) {
+    case Policy::kRoundRobin:
+      return "[{\"round_robin\":{}}]";
+    case Policy::kRingHash:
+      return "[{\"ring_hash_experimental\":{}}]";
+    case Policy::kWeightedTarget: {
+      std::vector<std::string> targets;
+      for (int i = 0; i < kWeightedTargetChildren; ++i) {
+        targets.push_back(absl::StrCat(
+            "\"target", i, "\":{\"weight\":", i + 1,
+            ",\"childPolicy\":[{\"round_robin\":{}}]}"));
+      }
+      return absl::StrCat(
+          "[{\"weighted_target_experimental\":{\"targets\":{",
+          absl::StrJoin(targets, ","), "}}}]");
+    }
+    case Policy::kOutlierDetection:
+      return "[{\"outlier_detection_experimental\":{"
+             "\"successRateEjection\":{},"
+             "\"childPolicy\":[{\"round_robin\":{}}]}}]";
+    case Policy::kRls:
+      return absl::StrCat(
+          "[{\"rls_experimental\":{"
+          "\"routeLookupConfig\":{"
+          "\"lookupService\":\"localhost:",
+          g_rls_server->port(),
+          "\",\"cacheSizeBytes\":10485760,"
+          "\"grpcKeybuilders\":[{"
+          "\"names\":[{\"service\":\"bm.Service\"}],"
+          "\"headers\":[{\"key\":\"k\",\"names\":[\"",
+          kRlsKeyHeader,
+          "\"]}]}]},"
+          "\"childPolicy\":[{\"fixed_address_lb\":{}}],"
+          "\"childPolicyConfigTargetFieldName\":\"address\"}}]");
+  }
+  GPR_UNREACHABLE_CODE(return "");
+}
+
+const char* PolicyName(Policy policy) {
+  switch (policy) {
+    case Policy::kRoundRobin:
+      return "round_robin";
+    case Policy::kRingHash:
+      return "ring_hash_experimental";
+    case Policy::kWeightedTarget:
+      return "weighted_target_experimental";
+    case Policy::kOutlierDetection:
+      return "outlier_detection_experimental";
+    case Policy::kRls:
+      return "rls_experimental";
+  }
+  GPR_UNREACHABLE_CODE(return "");
+}
+
+// What the pickers may read of a call: the request hash that ring_hash
+// picks by, and the header that rls builds its key from.
+class FakeCall : public ClientChannel::LoadBalancedCall::LbCallState,
+                 public LoadBalancingPolicy::MetadataInterface {
+ public:
+  FakeCall(std::string request_hash, std::string rls_key)
+      : LbCallState(nullptr),
+        request_hash_(std::move(request_hash)),
+        rls_key_(std::move(rls_key)) {}
+
+  LoadBalancingPolicy::PickArgs args() {
+    LoadBalancingPolicy::PickArgs pick_args;
+    pick_args.path = kPath;
+    pick_args.initial_metadata = this;
+    pick_args.call_state = this;
+    return pick_args;
+  }
+
+  // LbCallState
+  void* Alloc(size_t size) override {
+    allocations_.emplace_back(new char[size]);
+    return allocations_.back().get();
+  }
+  absl::string_view GetCallAttribute(UniqueTypeName /*type*/) override {
+    return request_hash_;
+  }
+
+  // MetadataInterface
+  void Add(absl::string_view /*key*/, absl::string_view /*value*/) override {}
+  std::vector<std::pair<std::string, std::string>> TestOnlyCopyToVector()
+      override {
+    return {{kRlsKeyHeader, rls_key_}};
+  }
+  absl::optional<absl::string_view> Lookup(
+      absl::string_view key, std::string* /*buffer*/) const override {
+    if (key != kRlsKeyHeader) return absl::nullopt;
+    return rls_key_;
+  }
+
+ private:
+  const std::string request_hash_;
+  const std::string rls_key_;
+  std::vector<std::unique_ptr<char[]>> allocations_;
+};
+
+// Calls with random request hashes, and whose rls keys go through the first
+// \a num_keys keys starting at \a first_key.
+std::vector<std::unique_ptr<FakeCall>> MakeCalls(size_t num_keys,
+                                                 size_t first_key) {
+  std::mt19937_64 rng(first_key);
+  std::vector<std::unique_ptr<FakeCall>> calls;
+  for (size_t i = 0; i < kRequests; ++i) {
+    calls.push_back(absl::make_unique<FakeCall>(
+        absl::StrCat(rng()), RlsKey((first_key + i) % num_keys)));
+  }
+  return calls;
+}
+
+// Runs an LB policy over fake subchannels, and keeps the last picker it
+// reported.
+class PickerFixture {
+ public:
+  PickerFixture(Policy policy, size_t num_endpoints)
+      : policy_kind_(policy),
+        num_endpoints_(num_endpoints),
+        work_serializer_(std::make_shared<WorkSerializer>()),
+        channel_args_(
+            ChannelArgs()
+                .Set(GRPC_ARG_SERVER_URI, "dns:///server.example.com")
+                .SetObject(RefCountedPtr<grpc_channel_credentials>(
+                    grpc_insecure_credentials_create()))) {
+    LoadBalancingPolicy::Args args;
+    args.work_serializer = work_serializer_;
+    args.channel_control_helper = absl::make_unique<Helper>(this);
+    args.args = channel_args_;
+    policy_ =
+        CoreConfiguration::Get().lb_policy_registry().CreateLoadBalancingPolicy(
+            PolicyName(policy), std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            *Json::Parse(PolicyConfig(policy)));
+    GPR_ASSERT(config.ok());
+    config_ = std::move(*config);
+    Update();
+    if (policy == Policy::kRls) FillRlsCache();
+  }
+
+  ~PickerFixture() {
+    work_serializer_->Run([this]() { policy_.reset(); }, DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+  }
+
+  // Sends the policy its endpoints again, with the address of the first one
+  // changed, as a re-resolution that replaced an endpoint would.
+  void Update() {
+    LoadBalancingPolicy::UpdateArgs update;
+    update.config = config_;
+    update.args = channel_args_;
+    update.addresses.emplace();
+    // rls gets its endpoints from the RLS server instead.
+    if (policy_kind_ != Policy::kRls) {
+      for (size_t i = 0; i < num_endpoints_; ++i) {
+        auto address = StringToSockaddr(
+            EndpointAddress(i, i == 0 ? 443 + generation_ % 2 : 443));
+        GPR_ASSERT(address.ok());
+        std::map<const char*,
+                 std::unique_ptr<ServerAddress::AttributeInterface>>
+            attributes;
+        if (policy_kind_ == Policy::kWeightedTarget) {
+          attributes[kHierarchicalPathAttributeKey] =
+              MakeHierarchicalPathAttribute(
+                  {absl::StrCat("target", i % kWeightedTargetChildren)});
+        }
+        update.addresses->emplace_back(*address, ChannelArgs(),
+                                       std::move(attributes));
+      }
+    }
+    ++generation_;
+    work_serializer_->Run(
+        [this, &update]() {
+          GPR_ASSERT(policy_->UpdateLocked(std::move(update)).ok());
+        },
+        DEBUG_LOCATION);
+    work_serializer_->DrainQueue();
+  }
+
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker() {
+    MutexLock lock(&mu_);
+    return picker_;
+  }
+
+ private:
+  // Picks every key until rls has looked them all up and its children for
+  // them are READY.
+  void FillRlsCache() {
+    std::vector<std::unique_ptr<FakeCall>> calls =
+        MakeCalls(num_endpoints_, 0);
+    calls.resize(num_endpoints_);
+    while (true) {
+      auto current_picker = picker();
+      size_t complete = 0;
+      if (current_picker != nullptr) {
+        for (auto& call : calls) {
+          auto result = current_picker->Pick(call->args());
+          if (absl::holds_alternative<
+                  LoadBalancingPolicy::PickResult::Complete>(result.result)) {
+            ++complete;
+          }
+        }
+      }
+      ExecCtx::Get()->Flush();
+      if (complete == calls.size()) return;
+      absl::SleepFor(absl::Milliseconds(1));
+    }
+  }
+
+  class FakeSubchannel : public SubchannelInterface {
+   public:
+    explicit FakeSubchannel(PickerFixture* fixture) : fixture_(fixture) {}
+
+    void WatchConnectivityState(
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+      watcher_ = std::move(watcher);
+      ConnectivityStateWatcherInterface* watcher_ptr = watcher_.get();
+      fixture_->work_serializer_->Schedule(
+          [watcher_ptr]() {
+            watcher_ptr->OnConnectivityStateChange(GRPC_CHANNEL_READY,
+                                                   absl::OkStatus());
+          },
+          DEBUG_LOCATION);
+    }
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override {
+      if (watcher_.get() == watcher) watcher_.reset();
+    }
+
+    void RequestConnection() override {}
+    void ResetBackoff() override {}
+    void AddDataWatcher(
+        std::unique_ptr<DataWatcherInterface> /*watcher*/) override {}
+    ChannelArgs channel_args() override { return ChannelArgs(); }
+
+   private:
+    PickerFixture* fixture_;
+    std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+  };
+
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(PickerFixture* fixture) : fixture_(fixture) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress /*address*/, const ChannelArgs& /*args*/) override {
+      return MakeRefCounted<FakeSubchannel>(fixture_);
+    }
+
+    void UpdateState(
+        grpc_connectivity_state /*state*/, const absl::Status& /*status*/,
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker)
+        override {
+      // rls reports its pickers from the threads its RLS calls complete on.
+      MutexLock lock(&fixture_->mu_);
+      fixture_->picker_ = std::move(picker);
+    }
+
+    void RequestReresolution() override {}
+    absl::string_view GetAuthority() override { return "server.example.com"; }
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    PickerFixture* fixture_;
+  };
+
+  const Policy policy_kind_;
+  const size_t num_endpoints_;
+  std::shared_ptr<WorkSerializer> work_serializer_;
+  const ChannelArgs channel_args_;
+  RefCountedPtr<LoadBalancingPolicy::Config> config_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  size_t generation_ = 0;
+  Mutex mu_;
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
+      ABSL_GUARDED_BY(mu_);
+};
+
+PickerFixture* g_fixture;
+
+// Each thread picks from the same picker of a policy over range(0)
+// endpoints; for rls, range(0) is the number of keys it has cached.
+void BM_Pick(benchmark::State& state, Policy policy) {
+  ExecCtx exec_ctx;
+  if (state.thread_index() == 0) {
+    g_fixture = new PickerFixture(policy, state.range(0));
+  }
+  std::vector<std::unique_ptr<FakeCall>> calls =
+      MakeCalls(state.range(0), state.thread_index() * 97);
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker;
+  size_t i = 0;
+  for (auto _ : state) {
+    // g_fixture is only set once all the threads have started.
+    if (GPR_UNLIKELY(picker == nullptr)) picker = g_fixture->picker();
+    auto result = picker->Pick(calls[i++ % calls.size()]->args());
+    if (!absl::holds_alternative<LoadBalancingPolicy::PickResult::Complete>(
+            result.result)) {
+      state.SkipWithError("pick not complete");
+      break;
+    }
+  }
+  picker.reset();
+  if (state.thread_index() == 0) {
+    delete g_fixture;
+    g_fixture = nullptr;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+void EndpointCounts(benchmark::internal::Benchmark* b) {
+  b->Arg(10)->Arg(1000)->Arg(100000);
+}
+
+void PickArgs(benchmark::internal::Benchmark* b) {
+  EndpointCounts(b);
+  b->ThreadRange(1, 8)->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(BM_Pick, round_robin, Policy::kRoundRobin)->Apply(PickArgs);
+BENCHMARK_CAPTURE(BM_Pick, ring_hash, Policy::kRingHash)->Apply(PickArgs);
+BENCHMARK_CAPTURE(BM_Pick, weighted_target, Policy::kWeightedTarget)
+    ->Apply(PickArgs);
+BENCHMARK_CAPTURE(BM_Pick, outlier_detection, Policy::kOutlierDetection)
+    ->Apply(PickArgs);
+BENCHMARK_CAPTURE(BM_Pick, rls, Policy::kRls)
+    ->Arg(10)
+    ->Arg(kMaxRlsKeys)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Each iteration re-resolves range(0) endpoints with one of them replaced,
+// and waits for the picker to be rebuilt.
+void BM_Update(benchmark::State& state, Policy policy) {
+  ExecCtx exec_ctx;
+  PickerFixture fixture(policy, state.range(0));
+  for (auto _ : state) {
+    fixture.Update();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_Update, round_robin, Policy::kRoundRobin)
+    ->Apply(EndpointCounts);
+BENCHMARK_CAPTURE(BM_Update, ring_hash, Policy::kRingHash)
+    ->Apply(EndpointCounts);
+BENCHMARK_CAPTURE(BM_Update, weighted_target, Policy::kWeightedTarget)
+    ->Apply(EndpointCounts);
+BENCHMARK_CAPTURE(BM_Update, outlier_detection, Policy::kOutlierDetection)
+    ->Apply(EndpointCounts);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::SetEnv("GRPC_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION", "true");
+  grpc_core::CoreConfiguration::RegisterBuilder(
+      grpc_core::RegisterFixedAddressLoadBalancingPolicy);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc_core::g_rls_server = new grpc_core::FakeRlsServer();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc_core::g_rls_server;
+  return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark LB policies while all their subchannels disconnect and reconnect
+ * at once, as after a network blip, and while a single subchannel of a large
+ * list flaps */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Runs an LB policy over fake subchannels whose connectivity state changes
+// are delivered through the policy's WorkSerializer, like the client channel
+// does.
+class LbPolicyFixture {
+ public:
+  LbPolicyFixture(absl::string_view policy_name, size_t num_subchannels)
+      : work_serializer_(std::make_shared<WorkSerializer>()) {
+    LoadBalancingPolicy::Args args;
+    args.work_serializer = work_serializer_;
+    args.channel_control_helper = absl::make_unique<Helper>(this);
+    policy_ =
+        CoreConfiguration::Get().lb_policy_registry().CreateLoadBalancingPolicy(
+            policy_name, std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            *Json::Parse(absl::StrCat("[{\"", policy_name, "\":{}}]")));
+    GPR_ASSERT(config.ok());
+    LoadBalancingPolicy::UpdateArgs update;
+    update.config = std::move(*config);
+    update.addresses.emplace();
+    for (size_t i = 0; i < num_subchannels; ++i) {
+      auto address = StringToSockaddr(
+          absl::StrCat("10.0.", i / 256, ".", i % 256, ":443"));
+      GPR_ASSERT(address.ok());
+      update.addresses->emplace_back(*address, ChannelArgs());
+    }
+    work_serializer_->Run(
+        [this, &update]() {
+          GPR_ASSERT(policy_->UpdateLocked(std::move(update)).ok());
+        },
+        DEBUG_LOCATION);
+    SetAllStates(GRPC_CHANNEL_READY);
+  }
+
+  ~LbPolicyFixture() {
+    work_serializer_->Run([this]() { policy_.reset(); }, DEBUG_LOCATION);
+  }
+
+  // Changes the state of every subchannel, delivering all the
+  // notifications in one burst.
+  void SetAllStates(grpc_connectivity_state state) {
+    const absl::Status status =
+        state == GRPC_CHANNEL_TRANSIENT_FAILURE
+            ? absl::UnavailableError("connection refused")
+            : absl::OkStatus();
+    for (FakeSubchannel* subchannel : subchannels_) {
+      subchannel->SetState(state, status);
+    }
+    work_serializer_->DrainQueue();
+  }
+
+  // Changes the state of the subchannel at \a index.
+  void SetState(size_t index, grpc_connectivity_state state) {
+    subchannels_[index]->SetState(
+        state, state == GRPC_CHANNEL_TRANSIENT_FAILURE
+                   ? absl::UnavailableError("connection refused")
+                   : absl::OkStatus());
+    work_serializer_->DrainQueue();
+  }
+
+  size_t num_pickers() const { return num_pickers_; }
+
+ private:
+  class FakeSubchannel : public SubchannelInterface {
+   public:
+    explicit FakeSubchannel(LbPolicyFixture* fixture) : fixture_(fixture) {}
+
+    void WatchConnectivityState(
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+      watcher_ = std::move(watcher);
+      SetState(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+    }
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override {
+      if (watcher_.get() == watcher) watcher_.reset();
+    }
+
+    void RequestConnection() override {}
+    void ResetBackoff() override {}
+    void AddDataWatcher(
+        std::unique_ptr<DataWatcherInterface> /*watcher*/) override {}
+    ChannelArgs channel_args() override { return ChannelArgs(); }
+
+    void SetState(grpc_connectivity_state state, absl::Status status) {
+      ConnectivityStateWatcherInterface* watcher = watcher_.get();
+      if (watcher == nullptr) return;
+      fixture_->work_serializer_->Schedule(
+          [watcher, state, status]() {
+            watcher->OnConnectivityStateChange(state, status);
+          },
+          DEBUG_LOCATION);
+    }
+
+   private:
+    LbPolicyFixture* fixture_;
+    std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+  };
+
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(LbPolicyFixture* fixture) : fixture_(fixture) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress /*address*/, const ChannelArgs& /*args*/) override {
+      auto subchannel = MakeRefCounted<FakeSubchannel>(fixture_);
+      fixture_->subchannels_.push_back(subchannel.get());
+      return subchannel;
+    }
+
+    void UpdateState(
+        grpc_connectivity_state /*state*/, const absl::Status& /*status*/,
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> /*picker*/)
+        override {
+      ++fixture_->num_pickers_;
+    }
+
+    void RequestReresolution() override {}
+    absl::string_view GetAuthority() override { return "server.example.com"; }
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    LbPolicyFixture* fixture_;
+  };
+
+  std::shared_ptr<WorkSerializer> work_serializer_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  // Not owned; the policy holds the refs.
+  std::vector<FakeSubchannel*> subchannels_;
+  size_t num_pickers_ = 0;
+};
+
+// Each iteration takes all range(0) subchannels to TRANSIENT_FAILURE and
+// back to READY.
+void BM_MassReconnect(benchmark::State& state, const char* policy_name) {
+  ExecCtx exec_ctx;
+  LbPolicyFixture fixture(policy_name, state.range(0));
+  const size_t initial_pickers = fixture.num_pickers();
+  for (auto _ : state) {
+    fixture.SetAllStates(GRPC_CHANNEL_TRANSIENT_FAILURE);
+    fixture.SetAllStates(GRPC_CHANNEL_READY);
+  }
+  state.counters["pickers_per_reconnect"] =
+      benchmark::Counter(fixture.num_pickers() - initial_pickers,
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK_CAPTURE(BM_MassReconnect, round_robin, "round_robin")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000);
+BENCHMARK_CAPTURE(BM_MassReconnect, ring_hash, "ring_hash_experimental")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000);
+
+// Each iteration takes one of range(0) subchannels to TRANSIENT_FAILURE and
+// back to READY, which produces two pickers.
+void BM_SingleFlip(benchmark::State& state, const char* policy_name) {
+  ExecCtx exec_ctx;
+  LbPolicyFixture fixture(policy_name, state.range(0));
+  size_t index = 0;
+  for (auto _ : state) {
+    fixture.SetState(index, GRPC_CHANNEL_TRANSIENT_FAILURE);
+    fixture.SetState(index, GRPC_CHANNEL_READY);
+    index = (index + 1) % state.range(0);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK_CAPTURE(BM_SingleFlip, round_robin, "round_robin")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the ingestion of the rows fetched from Census into the load data
+ * store, across many hosts (tenants) each reporting to one balancer */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/cpp/server/load_reporter/load_data_store.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace load_reporter {
+namespace {
+
+// state.range(0) is the number of hosts, state.range(1) the number of
+// clients of each host: each iteration merges one fetch, with one call start
+// and one call end row per client.
+void BM_LoadDataStoreMergeRows(benchmark::State& state) {
+  const int num_hosts = state.range(0);
+  const int clients_per_host = state.range(1);
+  LoadDataStore store;
+  std::vector<std::string> hosts;
+  std::vector<LoadRecordKey> keys;
+  for (int i = 0; i < num_hosts; ++i) {
+    hosts.push_back("host" + std::to_string(i));
+    const std::string lb_id = "lbid" + std::to_string(1000 + i);
+    store.ReportStreamCreated(hosts.back(), lb_id, "load_key");
+    for (int j = 0; j < clients_per_host; ++j) {
+      keys.emplace_back(lb_id, "lb_tag", "user" + std::to_string(j),
+                        "0a000001");
+    }
+  }
+  const LoadRecordValue start(1);
+  const LoadRecordValue end(0, 1, 0, 100, 200, 3);
+  for (auto _ : state) {
+    for (size_t k = 0; k < keys.size(); ++k) {
+      const std::string& host = hosts[k / clients_per_host];
+      store.MergeRow(host, keys[k], start);
+      store.MergeRow(host, keys[k], end);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size() * 2);
+}
+BENCHMARK(BM_LoadDataStoreMergeRows)
+    ->Args({1, 1000})
+    ->Args({100, 10})
+    ->Args({1000, 10});
+
+}  // namespace
+}  // namespace load_reporter
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
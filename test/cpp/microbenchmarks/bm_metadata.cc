@@ -0,0 +1,193 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of metadata batches with unknown (custom) headers:
+ * appending, looking up, encoding and copying them */
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/slice.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+auto* g_memory_allocator = new MemoryAllocator(
+    ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+
+// Keys and values of state.range(0) custom headers, like the ones services
+// add to their calls.
+struct CustomHeaders {
+  explicit CustomHeaders(int n) {
+    for (int i = 0; i < n; i++) {
+      keys.push_back(absl::StrCat("x-service-custom-header-", i));
+      values.push_back(absl::StrCat("a-value-of-custom-header-", i));
+    }
+  }
+
+  void AppendTo(grpc_metadata_batch* batch) const {
+    for (size_t i = 0; i < keys.size(); i++) {
+      batch->Append(keys[i], Slice::FromCopiedString(values[i]),
+                    [](absl::string_view, const Slice&) { abort(); });
+    }
+  }
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+};
+
+// Counts what an encoder is handed, so that the loop is not optimized away.
+class CountingEncoder {
+ public:
+  void Encode(const Slice& key, const Slice& value) {
+    bytes_ += key.size() + value.size();
+  }
+  template <typename Which, typename Value>
+  void Encode(Which, const Value&) {
+    ++bytes_;
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+void CustomHeaderArgs(benchmark::internal::Benchmark* b) {
+  for (int n : {1, 4, 10, 20}) b->Arg(n);
+}
+
+// Batches that spill out of their inline storage allocate from their arena,
+// which only frees memory when destroyed: each iteration gets its own, like
+// each call does.
+void BM_MetadataAppend(benchmark::State& state) {
+  CustomHeaders headers(state.range(0));
+  for (auto _ : state) {
+    auto arena = MakeScopedArena(4096, g_memory_allocator);
+    grpc_metadata_batch batch(arena.get());
+    headers.AppendTo(&batch);
+    benchmark::DoNotOptimize(batch.count());
+  }
+  state.counters["headers_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(0)),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MetadataAppend)->Apply(CustomHeaderArgs);
+
+void BM_MetadataLookup(benchmark::State& state) {
+  CustomHeaders headers(state.range(0));
+  auto arena = MakeScopedArena(4096, g_memory_allocator);
+  grpc_metadata_batch batch(arena.get());
+  headers.AppendTo(&batch);
+  // The last header: the whole batch is searched.
+  const std::string& key = headers.keys.back();
+  std::string backing;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch.GetStringValue(key, &backing));
+  }
+}
+BENCHMARK(BM_MetadataLookup)->Apply(CustomHeaderArgs);
+
+void BM_MetadataEncode(benchmark::State& state) {
+  CustomHeaders headers(state.range(0));
+  auto arena = MakeScopedArena(4096, g_memory_allocator);
+  grpc_metadata_batch batch(arena.get());
+  headers.AppendTo(&batch);
+  for (auto _ : state) {
+    CountingEncoder encoder;
+    batch.Encode(&encoder);
+    benchmark::DoNotOptimize(encoder.bytes());
+  }
+}
+BENCHMARK(BM_MetadataEncode)->Apply(CustomHeaderArgs);
+
+void BM_MetadataHpackEncode(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  CustomHeaders headers(state.range(0));
+  auto arena = MakeScopedArena(4096, g_memory_allocator);
+  grpc_metadata_batch batch(arena.get());
+  headers.AppendTo(&batch);
+  HPackCompressor compressor;
+  grpc_transport_one_way_stats stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  uint32_t stream_id = 1;
+  for (auto _ : state) {
+    compressor.EncodeHeaders(
+        HPackCompressor::EncodeHeaderOptions{stream_id, false, false, 16384,
+                                            &stats},
+        batch, &outbuf);
+    stream_id += 2;
+    grpc_slice_buffer_reset_and_unref(&outbuf);
+    ExecCtx::Get()->Flush();
+  }
+  grpc_slice_buffer_destroy(&outbuf);
+}
+BENCHMARK(BM_MetadataHpackEncode)->Apply(CustomHeaderArgs);
+
+void BM_MetadataCopy(benchmark::State& state) {
+  CustomHeaders headers(state.range(0));
+  auto arena = MakeScopedArena(4096, g_memory_allocator);
+  grpc_metadata_batch batch(arena.get());
+  headers.AppendTo(&batch);
+  for (auto _ : state) {
+    // What batch.Copy() does, but into the arena of the iteration.
+    auto copy_arena = MakeScopedArena(4096, g_memory_allocator);
+    grpc_metadata_batch copy(copy_arena.get());
+    metadata_detail::CopySink<grpc_metadata_batch> sink(&copy);
+    batch.ForEach(&sink);
+    benchmark::DoNotOptimize(copy.count());
+  }
+}
+BENCHMARK(BM_MetadataCopy)->Apply(CustomHeaderArgs);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
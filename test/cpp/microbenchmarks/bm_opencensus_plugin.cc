@@ -31,6 +31,7 @@
 
 #include "src/core/lib/config/core_configuration.h"
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
+#include "src/cpp/ext/filters/census/open_census_call_tracer.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
@@ -57,8 +58,10 @@ class EchoServer final : public grpc::testing::EchoTestService::Service {
 // shuts down the server and thread when it goes out of scope.
 class EchoServerThread final {
  public:
-  EchoServerThread() {
+  explicit EchoServerThread(int stats_sampling_period = 1) {
     grpc::ServerBuilder builder;
+    builder.AddChannelArgument(GRPC_ARG_OPENCENSUS_STATS_SAMPLING_PERIOD,
+                               stats_sampling_period);
     int port;
     builder.AddListeningPort("[::]:0", grpc::InsecureServerCredentials(),
                              &port);
@@ -104,6 +107,7 @@ static void BM_E2eLatencyCensusDisabled(benchmark::State& state) {
 }
 BENCHMARK(BM_E2eLatencyCensusDisabled);
 
+// state.range(0) is the stats sampling period of the client and the server.
 static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
   grpc_core::CoreConfiguration::Reset();
   // Now start the test by registering the plugin (once in the execution)
@@ -113,10 +117,12 @@ static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
   grpc::RegisterOpenCensusViewsForExport();
 
   grpc::testing::TestGrpcScope grpc_scope;
-  EchoServerThread server;
+  EchoServerThread server(state.range(0));
+  grpc::ChannelArguments args;
+  args.SetInt(GRPC_ARG_OPENCENSUS_STATS_SAMPLING_PERIOD, state.range(0));
   std::unique_ptr<grpc::testing::EchoTestService::Stub> stub =
-      grpc::testing::EchoTestService::NewStub(grpc::CreateChannel(
-          server.address(), grpc::InsecureChannelCredentials()));
+      grpc::testing::EchoTestService::NewStub(grpc::CreateCustomChannel(
+          server.address(), grpc::InsecureChannelCredentials(), args));
 
   grpc::testing::EchoResponse response;
   for (auto _ : state) {
@@ -125,7 +131,7 @@ static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
     grpc::Status status = stub->Echo(&context, request, &response);
   }
 }
-BENCHMARK(BM_E2eLatencyCensusEnabled);
+BENCHMARK(BM_E2eLatencyCensusEnabled)->Arg(1)->Arg(100);
 
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
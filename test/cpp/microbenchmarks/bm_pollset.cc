@@ -20,6 +20,10 @@
 
 #include <string.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
@@ -255,6 +259,135 @@ static void BM_SingleThreadPollOneFd(benchmark::State& state) {
 }
 BENCHMARK(BM_SingleThreadPollOneFd);
 
+// state.range(0) fds become readable together, like the connections of a busy
+// server: an iteration polls until each has been read once. Compare with and
+// without the epoll_batched_events experiment (GRPC_EXPERIMENTS).
+static void BM_SingleThreadPollManyFds(benchmark::State& state) {
+  TrackCounters track_counters;
+  const int num_fds = state.range(0);
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_wakeup_fd> wakeup_fds(num_fds);
+  std::vector<grpc_fd*> fds(num_fds);
+  std::vector<std::unique_ptr<TestClosure>> closures(num_fds);
+  int pending = 0;
+  bool done = false;
+  for (int i = 0; i < num_fds; i++) {
+    GRPC_ERROR_UNREF(grpc_wakeup_fd_init(&wakeup_fds[i]));
+    fds[i] = grpc_fd_create(wakeup_fds[i].read_fd, "wakeup_read", false);
+    grpc_pollset_add_fd(ps, fds[i]);
+    closures[i].reset(MakeTestClosure([&, i]() {
+      // Orphaning the fds runs the closures they still hold.
+      if (done) return;
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_consume_wakeup(&wakeup_fds[i]));
+      grpc_fd_notify_on_read(fds[i], closures[i].get());
+      --pending;
+    }));
+    grpc_fd_notify_on_read(fds[i], closures[i].get());
+  }
+  gpr_mu_lock(mu);
+  for (auto _ : state) {
+    for (int i = 0; i < num_fds; i++) {
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_wakeup(&wakeup_fds[i]));
+    }
+    pending = num_fds;
+    while (pending > 0) {
+      GRPC_ERROR_UNREF(
+          grpc_pollset_work(ps, nullptr, grpc_core::Timestamp::InfFuture()));
+    }
+  }
+  done = true;
+  for (int i = 0; i < num_fds; i++) {
+    grpc_fd_orphan(fds[i], nullptr, nullptr, "done");
+    wakeup_fds[i].read_fd = 0;
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (int i = 0; i < num_fds; i++) grpc_wakeup_fd_destroy(&wakeup_fds[i]);
+  gpr_free(ps);
+  state.counters["reads_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * num_fds),
+      benchmark::Counter::kIsRate);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SingleThreadPollManyFds)->Arg(1)->Arg(16)->Arg(100)->Arg(1000);
+
+// Each of the threads polls a pollset of its own, with state.range(0) fds
+// that become readable together: an iteration polls until each of them has
+// been read once, by whichever thread. Compare with and without the
+// epoll_sharded_sets experiment (GRPC_EXPERIMENTS), which lets several threads
+// sit in epoll_wait at once.
+static void BM_MultiThreadPollManyFds(benchmark::State& state) {
+  const int num_fds = state.range(0);
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_wakeup_fd> wakeup_fds(num_fds);
+  std::vector<grpc_fd*> fds(num_fds);
+  std::vector<std::unique_ptr<TestClosure>> closures(num_fds);
+  // Closures run on whichever thread polls their fd.
+  std::atomic<int> pending{0};
+  std::atomic<bool> done{false};
+  for (int i = 0; i < num_fds; i++) {
+    GRPC_ERROR_UNREF(grpc_wakeup_fd_init(&wakeup_fds[i]));
+    fds[i] = grpc_fd_create(wakeup_fds[i].read_fd, "wakeup_read", false);
+    grpc_pollset_add_fd(ps, fds[i]);
+    closures[i].reset(MakeTestClosure([&, i]() {
+      if (done) return;
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_consume_wakeup(&wakeup_fds[i]));
+      grpc_fd_notify_on_read(fds[i], closures[i].get());
+      if (pending.fetch_sub(1) == 1) {
+        // Closures run without any pollset lock held.
+        gpr_mu_lock(mu);
+        GRPC_ERROR_UNREF(grpc_pollset_kick(ps, nullptr));
+        gpr_mu_unlock(mu);
+      }
+    }));
+    grpc_fd_notify_on_read(fds[i], closures[i].get());
+  }
+  gpr_mu_lock(mu);
+  for (auto _ : state) {
+    pending = num_fds;
+    for (int i = 0; i < num_fds; i++) {
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_wakeup(&wakeup_fds[i]));
+    }
+    while (pending > 0) {
+      GRPC_ERROR_UNREF(
+          grpc_pollset_work(ps, nullptr, grpc_core::Timestamp::InfFuture()));
+    }
+  }
+  done = true;
+  for (int i = 0; i < num_fds; i++) {
+    grpc_fd_orphan(fds[i], nullptr, nullptr, "done");
+    wakeup_fds[i].read_fd = 0;
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (int i = 0; i < num_fds; i++) grpc_wakeup_fd_destroy(&wakeup_fds[i]);
+  gpr_free(ps);
+  state.counters["reads_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * num_fds),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MultiThreadPollManyFds)
+    ->Arg(100)
+    ->Arg(1000)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,284 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark how long the priority policy takes to fail over to its next
+ * priority when every endpoint of the priority in use fails, with and
+ * without a warm standby, over fake subchannels whose connections take a
+ * fixed time to establish */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// How long a fake connection takes to establish.  Connections requested
+// together are established in parallel.
+constexpr absl::Duration kHandshakeTime = absl::Milliseconds(1);
+// The port of the endpoints of priority 0; those of priority 1 use the
+// next one.
+constexpr int kPort = 443;
+
+// Runs the priority policy over two priorities with round_robin leaves,
+// whose subchannels connect only when the fixture completes handshakes.
+class PriorityFixture {
+ public:
+  PriorityFixture(int endpoints_per_priority, int warm_standby_subchannels)
+      : work_serializer_(std::make_shared<WorkSerializer>()) {
+    LoadBalancingPolicy::Args args;
+    args.work_serializer = work_serializer_;
+    args.channel_control_helper = absl::make_unique<Helper>(this);
+    args.args = ChannelArgs().Set(
+        GRPC_ARG_EXPERIMENTAL_PRIORITY_WARM_STANDBY_SUBCHANNELS,
+        warm_standby_subchannels);
+    policy_ =
+        CoreConfiguration::Get().lb_policy_registry().CreateLoadBalancingPolicy(
+            "priority_experimental", std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            *Json::Parse("[{\"priority_experimental\":{\"children\":{"
+                         "\"child0\":{\"config\":[{\"round_robin\":{}}]},"
+                         "\"child1\":{\"config\":[{\"round_robin\":{}}]}},"
+                         "\"priorities\":[\"child0\",\"child1\"]}}]"));
+    GPR_ASSERT(config.ok());
+    LoadBalancingPolicy::UpdateArgs update;
+    update.config = std::move(*config);
+    update.addresses.emplace();
+    for (int priority = 0; priority < 2; ++priority) {
+      for (int i = 0; i < endpoints_per_priority; ++i) {
+        auto address = StringToSockaddr(absl::StrCat(
+            "10.0.", i / 256, ".", i % 256, ":", kPort + priority));
+        GPR_ASSERT(address.ok());
+        std::map<const char*,
+                 std::unique_ptr<ServerAddress::AttributeInterface>>
+            attributes;
+        attributes[kHierarchicalPathAttributeKey] =
+            MakeHierarchicalPathAttribute({absl::StrCat("child", priority)});
+        update.addresses->emplace_back(*address, ChannelArgs(),
+                                       std::move(attributes));
+      }
+    }
+    work_serializer_->Run(
+        [this, &update]() {
+          GPR_ASSERT(policy_->UpdateLocked(std::move(update)).ok());
+        },
+        DEBUG_LOCATION);
+    work_serializer_->DrainQueue();
+    // Also connect the warm standby, if any.
+    while (state_ != GRPC_CHANNEL_READY || !connecting_.empty()) {
+      CompleteHandshakes();
+    }
+  }
+
+  ~PriorityFixture() {
+    work_serializer_->Run([this]() { policy_.reset(); }, DEBUG_LOCATION);
+  }
+
+  // Completes the connections pending until the policy reports READY, and
+  // returns how many rounds of handshakes that took.
+  int WaitForReady() {
+    int rounds = 0;
+    while (state_ != GRPC_CHANNEL_READY) {
+      CompleteHandshakes();
+      ++rounds;
+    }
+    return rounds;
+  }
+
+  // Fails the connections to every endpoint of the highest priority.
+  void FailHighestPriority() {
+    for (FakeSubchannel* subchannel : subchannels_) {
+      if (subchannel->priority() == 0) {
+        subchannel->SetState(GRPC_CHANNEL_TRANSIENT_FAILURE,
+                             absl::UnavailableError("connection refused"));
+      }
+    }
+    work_serializer_->DrainQueue();
+  }
+
+ private:
+  // Establishes all the connections that are pending.
+  void CompleteHandshakes() {
+    GPR_ASSERT(!connecting_.empty());
+    absl::SleepFor(kHandshakeTime);
+    std::vector<FakeSubchannel*> connecting = std::move(connecting_);
+    connecting_.clear();
+    for (FakeSubchannel* subchannel : connecting) {
+      subchannel->SetState(GRPC_CHANNEL_READY, absl::OkStatus());
+    }
+    work_serializer_->DrainQueue();
+  }
+
+  class FakeSubchannel : public SubchannelInterface {
+   public:
+    FakeSubchannel(PriorityFixture* fixture, int priority)
+        : fixture_(fixture), priority_(priority) {}
+
+    int priority() const { return priority_; }
+
+    void WatchConnectivityState(
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+      watcher_ = std::move(watcher);
+      SetState(GRPC_CHANNEL_IDLE, absl::OkStatus());
+    }
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override {
+      if (watcher_.get() == watcher) watcher_.reset();
+    }
+
+    void RequestConnection() override {
+      if (state_ != GRPC_CHANNEL_IDLE) return;
+      fixture_->connecting_.push_back(this);
+      SetState(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+    }
+
+    void ResetBackoff() override {}
+    void AddDataWatcher(
+        std::unique_ptr<DataWatcherInterface> /*watcher*/) override {}
+    ChannelArgs channel_args() override { return ChannelArgs(); }
+
+    void SetState(grpc_connectivity_state state, absl::Status status) {
+      state_ = state;
+      ConnectivityStateWatcherInterface* watcher = watcher_.get();
+      if (watcher == nullptr) return;
+      fixture_->work_serializer_->Schedule(
+          [watcher, state, status]() {
+            watcher->OnConnectivityStateChange(state, status);
+          },
+          DEBUG_LOCATION);
+    }
+
+   private:
+    PriorityFixture* fixture_;
+    const int priority_;
+    grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
+    std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+  };
+
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(PriorityFixture* fixture) : fixture_(fixture) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress address, const ChannelArgs& /*args*/) override {
+      const int priority = grpc_sockaddr_get_port(&address.address()) - kPort;
+      auto subchannel = MakeRefCounted<FakeSubchannel>(fixture_, priority);
+      fixture_->subchannels_.push_back(subchannel.get());
+      return subchannel;
+    }
+
+    void UpdateState(
+        grpc_connectivity_state state, const absl::Status& /*status*/,
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> /*picker*/)
+        override {
+      fixture_->state_ = state;
+    }
+
+    void RequestReresolution() override {}
+    absl::string_view GetAuthority() override { return "server.example.com"; }
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    PriorityFixture* fixture_;
+  };
+
+  std::shared_ptr<WorkSerializer> work_serializer_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  // Not owned; the policy holds the refs.
+  std::vector<FakeSubchannel*> subchannels_;
+  std::vector<FakeSubchannel*> connecting_;
+  grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
+};
+
+// Each iteration fails every one of the range(0) endpoints of the highest
+// priority of a newly connected policy, and waits for the policy to be
+// READY again, with a warm standby budget of range(1) subchannels.
+void BM_PriorityFailover(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  int64_t rounds = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    {
+      PriorityFixture fixture(state.range(0), state.range(1));
+      state.ResumeTiming();
+      fixture.FailHighestPriority();
+      rounds += fixture.WaitForReady();
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  state.counters["handshakes_per_failover"] =
+      benchmark::Counter(rounds, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PriorityFailover)
+    ->ArgNames({"endpoints", "warm_standby_subchannels"})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({100, 0})
+    ->Args({100, 100})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
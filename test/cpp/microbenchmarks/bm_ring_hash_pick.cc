@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the ring lookup of ring_hash picks */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+using grpc_core::RingHashLookupTable;
+
+static std::vector<uint64_t> SortedHashes(size_t size) {
+  std::mt19937_64 rng(size);
+  std::vector<uint64_t> hashes(size);
+  for (uint64_t& hash : hashes) hash = rng();
+  std::sort(hashes.begin(), hashes.end());
+  return hashes;
+}
+
+// Random request hashes, so that picks land all over the ring.
+static std::vector<uint64_t> RequestHashes() {
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> hashes(4096);
+  for (uint64_t& hash : hashes) hash = rng();
+  return hashes;
+}
+
+// The layout the ring used to have: a binary search over (hash, subchannel)
+// entries.
+static void BM_RingHashPick_BinarySearch(benchmark::State& state) {
+  struct RingEntry {
+    uint64_t hash;
+    void* subchannel;
+  };
+  std::vector<RingEntry> ring;
+  for (uint64_t hash : SortedHashes(state.range(0))) {
+    ring.push_back({hash, nullptr});
+  }
+  const std::vector<uint64_t> requests = RequestHashes();
+  size_t i = 0;
+  for (auto _ : state) {
+    const uint64_t h = requests[i++ % requests.size()];
+    auto it = std::lower_bound(
+        ring.begin(), ring.end(), h,
+        [](const RingEntry& entry, uint64_t h) { return entry.hash < h; });
+    benchmark::DoNotOptimize(it == ring.end() ? ring.begin() : it);
+  }
+}
+BENCHMARK(BM_RingHashPick_BinarySearch)->Range(1024, 8 * 1024 * 1024);
+
+static void BM_RingHashPick_LookupTable(benchmark::State& state) {
+  RingHashLookupTable table(SortedHashes(state.range(0)));
+  const std::vector<uint64_t> requests = RequestHashes();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.Find(requests[i++ % requests.size()]));
+  }
+}
+BENCHMARK(BM_RingHashPick_LookupTable)->Range(1024, 8 * 1024 * 1024);
+
+static void BM_RingHashLookupTableBuild(benchmark::State& state) {
+  const std::vector<uint64_t> hashes = SortedHashes(state.range(0));
+  for (auto _ : state) {
+    RingHashLookupTable table(hashes);
+    benchmark::DoNotOptimize(table.size());
+  }
+  state.SetItemsProcessed(state.iterations() * hashes.size());
+}
+BENCHMARK(BM_RingHashLookupTableBuild)->Range(1024, 8 * 1024 * 1024);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark unary calls from many threads through one RLS channel whose
+ * keys are all in the RLS cache */
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/test_lb_policies.h"
+#include "test/cpp/end2end/rls_server.h"
+#include "test/cpp/end2end/test_service_impl.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kMaxKeys = 1000;
+constexpr char kKeyHeader[] = "rls-key";
+
+static std::string KeyValue(int i) { return absl::StrCat("key", i); }
+
+// An RLS server and a backend, and a channel that routes all the keys to the
+// backend through RLS.
+class RlsFixture {
+ public:
+  RlsFixture() {
+    const int rls_port = grpc_pick_unused_port_or_die();
+    const int backend_port = grpc_pick_unused_port_or_die();
+    rls_server_ = StartServer(rls_port, &rls_service_);
+    backend_server_ = StartServer(backend_port, &backend_service_);
+    const std::string backend = absl::StrCat("ipv4:127.0.0.1:", backend_port);
+    for (int i = 0; i < kMaxKeys; ++i) {
+      rls_service_.SetResponse(BuildRlsRequest({{"k", KeyValue(i)}}),
+                               BuildRlsResponse({backend}));
+    }
+    ChannelArguments args;
+    args.SetServiceConfigJSON(absl::StrCat(
+        "{\"loadBalancingConfig\":[{\"rls_experimental\":{"
+        "  \"routeLookupConfig\":{"
+        "    \"lookupService\":\"localhost:",
+        rls_port,
+        "\","
+        "    \"cacheSizeBytes\":10485760,"
+        "    \"grpcKeybuilders\":[{"
+        "      \"names\":[{\"service\":\"grpc.testing.EchoTestService\"}],"
+        "      \"headers\":[{\"key\":\"k\",\"names\":[\"",
+        kKeyHeader,
+        "\"]}]"
+        "    }]"
+        "  },"
+        "  \"childPolicy\":[{\"fixed_address_lb\":{}}],"
+        "  \"childPolicyConfigTargetFieldName\":\"address\""
+        "}}]}"));
+    channel_ = CreateCustomChannel(backend, InsecureChannelCredentials(), args);
+    stub_ = EchoTestService::NewStub(channel_);
+    // Fill the cache.
+    for (int i = 0; i < kMaxKeys; ++i) {
+      ClientContext context;
+      context.AddMetadata(kKeyHeader, KeyValue(i));
+      context.set_wait_for_ready(true);
+      EchoRequest request;
+      EchoResponse response;
+      GPR_ASSERT(stub_->Echo(&context, request, &response).ok());
+    }
+  }
+
+  ~RlsFixture() {
+    backend_server_->Shutdown();
+    rls_server_->Shutdown();
+  }
+
+  EchoTestService::Stub* stub() const { return stub_.get(); }
+
+ private:
+  static std::unique_ptr<Server> StartServer(int port, Service* service) {
+    ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("localhost:", port),
+                             InsecureServerCredentials());
+    builder.RegisterService(service);
+    return builder.BuildAndStart();
+  }
+
+  RlsServiceImpl rls_service_;
+  TestServiceImpl backend_service_;
+  std::unique_ptr<Server> rls_server_;
+  std::unique_ptr<Server> backend_server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+static RlsFixture* g_fixture;
+
+// Each thread spreads its calls over range(0) keys.
+static void BM_RlsPick(benchmark::State& state) {
+  const int num_keys = state.range(0);
+  EchoTestService::Stub* stub = g_fixture->stub();
+  EchoRequest request;
+  request.set_message("hello");
+  int i = state.thread_index();
+  for (auto _ : state) {
+    ClientContext context;
+    context.AddMetadata(kKeyHeader, KeyValue(i++ % num_keys));
+    EchoResponse response;
+    Status status = stub->Echo(&context, request, &response);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RlsPick)
+    ->Arg(1)
+    ->Arg(kMaxKeys)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::CoreConfiguration::RegisterBuilder(
+      grpc_core::RegisterFixedAddressLoadBalancingPolicy);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::RlsFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark unary calls from many threads sharing one channel, so that all
+ * their LB picks go through the same client channel */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/end2end/test_service_impl.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kNumBackends = 4;
+
+// Backends, and one round_robin channel to all of them.
+class SharedChannelFixture {
+ public:
+  SharedChannelFixture() {
+    std::vector<std::string> addresses;
+    for (int i = 0; i < kNumBackends; ++i) {
+      const int port = grpc_pick_unused_port_or_die();
+      ServerBuilder builder;
+      builder.AddListeningPort(absl::StrCat("localhost:", port),
+                               InsecureServerCredentials());
+      builder.RegisterService(&service_);
+      servers_.push_back(builder.BuildAndStart());
+      addresses.push_back(absl::StrCat("127.0.0.1:", port));
+    }
+    ChannelArguments args;
+    args.SetLoadBalancingPolicyName("round_robin");
+    channel_ = CreateCustomChannel(
+        absl::StrCat("ipv4:", absl::StrJoin(addresses, ",")),
+        InsecureChannelCredentials(), args);
+    GPR_ASSERT(channel_->WaitForConnected(
+        grpc_timeout_seconds_to_deadline(10)));
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  ~SharedChannelFixture() {
+    for (auto& server : servers_) server->Shutdown();
+  }
+
+  EchoTestService::Stub* stub() const { return stub_.get(); }
+
+ private:
+  TestServiceImpl service_;
+  std::vector<std::unique_ptr<Server>> servers_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+static SharedChannelFixture* g_fixture;
+
+static void BM_SharedChannelUnary(benchmark::State& state) {
+  EchoTestService::Stub* stub = g_fixture->stub();
+  EchoRequest request;
+  request.set_message("hello");
+  for (auto _ : state) {
+    ClientContext context;
+    EchoResponse response;
+    Status status = stub->Echo(&context, request, &response);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedChannelUnary)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::SharedChannelFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark slice buffers holding as many slices as a message read in
+ * chunks does */
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+std::vector<Slice> MakeSlices(size_t count) {
+  std::vector<Slice> slices;
+  for (size_t i = 0; i < count; i++) {
+    slices.emplace_back(grpc_slice_malloc(64));
+  }
+  return slices;
+}
+
+// Args: number of slices.
+void BM_SliceBufferAppendAndTakeAll(benchmark::State& state) {
+  const std::vector<Slice> slices = MakeSlices(state.range(0));
+  for (auto _ : state) {
+    SliceBuffer buffer;
+    for (const Slice& slice : slices) buffer.AppendIndexed(slice.Ref());
+    while (buffer.Count() > 0) benchmark::DoNotOptimize(buffer.TakeFirst());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SliceBufferAppendAndTakeAll)->Range(1, 1024);
+
+// A buffer used as a queue: one slice is taken from the front for each one
+// added at the back of the full buffer.  Args: number of slices queued.
+void BM_SliceBufferQueue(benchmark::State& state) {
+  const std::vector<Slice> slices = MakeSlices(state.range(0));
+  SliceBuffer buffer;
+  for (const Slice& slice : slices) buffer.AppendIndexed(slice.Ref());
+  for (auto _ : state) {
+    buffer.AppendIndexed(buffer.TakeFirst());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SliceBufferQueue)->Range(8, 1024);
+
+// Takes the first slice and puts it back, as the parsers peeking at the
+// front of a buffer do.  Args: number of slices.
+void BM_SliceBufferTakeFirstAndPrepend(benchmark::State& state) {
+  const std::vector<Slice> slices = MakeSlices(state.range(0));
+  SliceBuffer buffer;
+  for (const Slice& slice : slices) buffer.AppendIndexed(slice.Ref());
+  for (auto _ : state) {
+    buffer.Prepend(buffer.TakeFirst());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SliceBufferTakeFirstAndPrepend)->Range(1, 1024);
+
+// Args: number of slices.
+void BM_SliceBufferIterate(benchmark::State& state) {
+  const std::vector<Slice> slices = MakeSlices(state.range(0));
+  SliceBuffer buffer;
+  for (const Slice& slice : slices) buffer.AppendIndexed(slice.Ref());
+  for (auto _ : state) {
+    size_t length = 0;
+    for (const grpc_slice& slice : buffer.c_slices()) {
+      length += GRPC_SLICE_LENGTH(slice);
+    }
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SliceBufferIterate)->Range(1, 1024);
+
+// Args: number of slices.
+void BM_SliceBufferCopy(benchmark::State& state) {
+  const std::vector<Slice> slices = MakeSlices(state.range(0));
+  SliceBuffer buffer;
+  for (const Slice& slice : slices) buffer.AppendIndexed(slice.Ref());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.Copy());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SliceBufferCopy)->Range(1, 1024);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
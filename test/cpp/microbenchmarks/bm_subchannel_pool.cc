@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many threads creating the subchannels for their channels through
+ * the global subchannel pool at once, as at the startup of a service that
+ * opens many channels to the same backends */
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int kNumAddresses = 1000;
+
+// Never connects; the subchannels are only created and destroyed.
+class NoopConnector : public SubchannelConnector {
+ public:
+  void Connect(const Args& /*args*/, Result* /*result*/,
+               grpc_closure* /*notify*/) override {}
+  void Shutdown(grpc_error_handle /*error*/) override {}
+};
+
+// Each iteration is one channel getting the subchannels for range(0) of the
+// backends, starting at a different backend on each thread, and then
+// releasing them.
+void BM_GlobalSubchannelPoolStartup(benchmark::State& state) {
+  static std::vector<grpc_resolved_address>* addresses = [] {
+    auto* addresses = new std::vector<grpc_resolved_address>();
+    for (int i = 0; i < kNumAddresses; ++i) {
+      auto address = StringToSockaddr(
+          absl::StrCat("10.0.", i / 256, ".", i % 256, ":443"));
+      GPR_ASSERT(address.ok());
+      addresses->push_back(*address);
+    }
+    return addresses;
+  }();
+  const ChannelArgs args =
+      ChannelArgs().SetObject(GlobalSubchannelPool::instance());
+  const int num_subchannels = state.range(0);
+  std::vector<RefCountedPtr<Subchannel>> subchannels;
+  subchannels.reserve(num_subchannels);
+  int next = state.thread_index() * 97;
+  for (auto _ : state) {
+    ExecCtx exec_ctx;
+    for (int i = 0; i < num_subchannels; ++i) {
+      subchannels.push_back(
+          Subchannel::Create(MakeOrphanable<NoopConnector>(),
+                             (*addresses)[next++ % kNumAddresses], args));
+    }
+    subchannels.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * num_subchannels);
+}
+BENCHMARK(BM_GlobalSubchannelPoolStartup)
+    ->Arg(10)
+    ->Arg(100)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
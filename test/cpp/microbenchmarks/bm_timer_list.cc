@@ -0,0 +1,191 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the arm/cancel throughput of the EventEngine timer containers.
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::posix_engine::Timer;
+using ::grpc_event_engine::posix_engine::TimerList;
+using ::grpc_event_engine::posix_engine::TimerListHost;
+using ::grpc_event_engine::posix_engine::TimerListInterface;
+using ::grpc_event_engine::posix_engine::TimerWheel;
+
+// Time only advances when a benchmark says so, so no timer ever fires.
+class FakeHost final : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+        now_.load(std::memory_order_relaxed));
+  }
+  void Kick() override {}
+
+  void Advance(int64_t millis) {
+    now_.fetch_add(millis, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<int64_t> now_{1000};
+};
+
+class NoopClosure final : public EventEngine::Closure {
+ public:
+  void Run() override {}
+};
+
+// Spreads deadlines between 1ms and max_millis.
+grpc_core::Duration DeadlineOffset(size_t i, int64_t max_millis = 1 << 20) {
+  return grpc_core::Duration::Milliseconds(1 + ((i * 7919) % max_millis));
+}
+
+// Short deadlines end up in TimerList's heaps, long ones (~17 minutes) mostly
+// in its unsorted lists and in the upper levels of the timer wheel.
+void ArmCancelArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t max_millis : {100, 1 << 20}) {
+    for (int64_t pending : {1, 100, 10000, 100000}) {
+      b->Args({pending, max_millis});
+    }
+  }
+}
+
+// Arms and immediately cancels one timer while state.range(0) other timers
+// are pending, which is what per-call deadlines look like on a busy server.
+template <typename TimerListType>
+void BM_TimerArmCancel(benchmark::State& state) {
+  FakeHost host;
+  TimerListType timer_list(&host);
+  NoopClosure closure;
+  const int64_t max_millis = state.range(1);
+  std::vector<Timer> background(state.range(0));
+  for (size_t i = 0; i < background.size(); i++) {
+    timer_list.TimerInit(&background[i],
+                         host.Now() + DeadlineOffset(i, max_millis), &closure);
+  }
+  Timer timer;
+  size_t i = 0;
+  for (auto _ : state) {
+    timer_list.TimerInit(&timer, host.Now() + DeadlineOffset(i++, max_millis),
+                         &closure);
+    GPR_ASSERT(timer_list.TimerCancel(&timer));
+  }
+  for (auto& t : background) {
+    GPR_ASSERT(timer_list.TimerCancel(&t));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_TimerArmCancel, TimerList)->Apply(ArmCancelArguments);
+BENCHMARK_TEMPLATE(BM_TimerArmCancel, TimerWheel)->Apply(ArmCancelArguments);
+
+// Arms state.range(0) timers, lets time pass without any of them expiring,
+// then cancels them all. Includes the cost of TimerCheck moving far timers
+// closer to their deadline.
+template <typename TimerListType>
+void BM_TimerArmCheckCancelBatch(benchmark::State& state) {
+  FakeHost host;
+  TimerListType timer_list(&host);
+  NoopClosure closure;
+  std::vector<Timer> timers(state.range(0));
+  for (auto _ : state) {
+    for (size_t i = 0; i < timers.size(); i++) {
+      timer_list.TimerInit(&timers[i],
+                           host.Now() + grpc_core::Duration::Seconds(30) +
+                               DeadlineOffset(i),
+                           &closure);
+    }
+    host.Advance(1000);
+    grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+    auto expired = timer_list.TimerCheck(&next);
+    GPR_ASSERT(expired.has_value() && expired->empty());
+    for (auto& t : timers) {
+      GPR_ASSERT(timer_list.TimerCancel(&t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_TimerArmCheckCancelBatch, TimerList)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+BENCHMARK_TEMPLATE(BM_TimerArmCheckCancelBatch, TimerWheel)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+// Arms and cancels timers from many threads sharing one container.
+FakeHost* g_host;
+TimerListInterface* g_timer_list;
+
+template <typename TimerListType>
+void SharedSetup(const benchmark::State& /* state */) {
+  g_host = new FakeHost();
+  g_timer_list = new TimerListType(g_host);
+}
+
+void SharedTeardown(const benchmark::State& /* state */) {
+  delete g_timer_list;
+  delete g_host;
+}
+
+void BM_TimerArmCancelContended(benchmark::State& state) {
+  NoopClosure closure;
+  Timer timer;
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    g_timer_list->TimerInit(&timer, g_host->Now() + DeadlineOffset(i++),
+                            &closure);
+    GPR_ASSERT(g_timer_list->TimerCancel(&timer));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerArmCancelContended)
+    ->Name("BM_TimerArmCancelContended<TimerList>")
+    ->Setup(SharedSetup<TimerList>)
+    ->Teardown(SharedTeardown)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK(BM_TimerArmCancelContended)
+    ->Name("BM_TimerArmCancelContended<TimerWheel>")
+    ->Setup(SharedSetup<TimerWheel>)
+    ->Teardown(SharedTeardown)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
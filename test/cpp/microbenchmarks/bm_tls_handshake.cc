@@ -0,0 +1,169 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the throughput of TLS handshakes between in-memory TSI
+ * handshakers, run inline or on the handshake thread pool */
+
+#include <atomic>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/security/transport/handshake_thread_pool.h"
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security_interface.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/tls_utils.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr char kCaCertPath[] = "src/core/tsi/test_creds/ca.pem";
+constexpr char kServerCertPath[] = "src/core/tsi/test_creds/server1.pem";
+constexpr char kServerKeyPath[] = "src/core/tsi/test_creds/server1.key";
+constexpr char kServerName[] = "foo.test.google.fr";
+
+class HandshakerFactories {
+ public:
+  HandshakerFactories()
+      : root_cert_(testing::GetFileContents(kCaCertPath)),
+        server_cert_(testing::GetFileContents(kServerCertPath)),
+        server_key_(testing::GetFileContents(kServerKeyPath)) {
+    tsi_ssl_pem_key_cert_pair key_cert_pair = {server_key_.c_str(),
+                                               server_cert_.c_str()};
+    tsi_ssl_server_handshaker_options server_options;
+    server_options.pem_key_cert_pairs = &key_cert_pair;
+    server_options.num_key_cert_pairs = 1;
+    GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
+                   &server_options, &server_factory_) == TSI_OK);
+    tsi_ssl_client_handshaker_options client_options;
+    client_options.pem_root_certs = root_cert_.c_str();
+    GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
+                   &client_options, &client_factory_) == TSI_OK);
+  }
+
+  ~HandshakerFactories() {
+    tsi_ssl_server_handshaker_factory_unref(server_factory_);
+    tsi_ssl_client_handshaker_factory_unref(client_factory_);
+  }
+
+  // Runs a full handshake between a new client and a new server.
+  void DoHandshake() {
+    tsi_handshaker* client = nullptr;
+    tsi_handshaker* server = nullptr;
+    GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                   client_factory_, kServerName, 0, 0, &client) == TSI_OK);
+    GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                   server_factory_, 0, 0, &server) == TSI_OK);
+    std::string to_client;
+    std::string to_server;
+    tsi_handshaker_result* client_result = nullptr;
+    tsi_handshaker_result* server_result = nullptr;
+    // The client speaks first.
+    while (client_result == nullptr || server_result == nullptr) {
+      if (client_result == nullptr) {
+        Step(client, &to_client, &to_server, &client_result);
+      }
+      if (server_result == nullptr) {
+        Step(server, &to_server, &to_client, &server_result);
+      }
+    }
+    tsi_handshaker_result_destroy(client_result);
+    tsi_handshaker_result_destroy(server_result);
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+  }
+
+ private:
+  static void Step(tsi_handshaker* handshaker, std::string* received,
+                   std::string* to_send, tsi_handshaker_result** result) {
+    const unsigned char* bytes_to_send = nullptr;
+    size_t bytes_to_send_size = 0;
+    GPR_ASSERT(tsi_handshaker_next(
+                   handshaker,
+                   reinterpret_cast<const unsigned char*>(received->data()),
+                   received->size(), &bytes_to_send, &bytes_to_send_size,
+                   result, nullptr, nullptr) == TSI_OK);
+    received->clear();
+    to_send->append(reinterpret_cast<const char*>(bytes_to_send),
+                    bytes_to_send_size);
+  }
+
+  const std::string root_cert_;
+  const std::string server_cert_;
+  const std::string server_key_;
+  tsi_ssl_server_handshaker_factory* server_factory_ = nullptr;
+  tsi_ssl_client_handshaker_factory* client_factory_ = nullptr;
+};
+
+// Each iteration runs one handshake on the benchmark thread, the way the
+// security handshaker does on the I/O thread by default.
+void BM_TlsHandshakeInline(benchmark::State& state) {
+  HandshakerFactories factories;
+  for (auto _ : state) {
+    factories.DoHandshake();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TlsHandshakeInline);
+
+// Each iteration runs a batch of concurrent handshakes on a handshake thread
+// pool with the given number of threads.
+void BM_TlsHandshakeThreadPool(benchmark::State& state) {
+  constexpr int kHandshakesPerIteration = 64;
+  HandshakerFactories factories;
+  HandshakeThreadPool pool(state.range(0), kHandshakesPerIteration);
+  for (auto _ : state) {
+    std::atomic<int> pending{kHandshakesPerIteration};
+    Notification done;
+    for (int i = 0; i < kHandshakesPerIteration; ++i) {
+      GPR_ASSERT(pool.Run(
+          [&factories, &pending, &done]() {
+            factories.DoHandshake();
+            if (pending.fetch_sub(1) == 1) done.Notify();
+          },
+          /*new_handshake=*/true));
+    }
+    done.WaitForNotification();
+  }
+  state.SetItemsProcessed(state.iterations() * kHandshakesPerIteration);
+}
+BENCHMARK(BM_TlsHandshakeThreadPool)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark how weighted_target picks which child to delegate a pick to */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+using grpc_core::AliasTable;
+
+static std::vector<uint32_t> Weights(size_t size) {
+  std::mt19937 rng(size);
+  std::vector<uint32_t> weights(size);
+  for (uint32_t& weight : weights) weight = 1 + rng() % 100;
+  return weights;
+}
+
+static std::vector<uint64_t> RandomNumbers() {
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> numbers(4096);
+  for (uint64_t& number : numbers) number = rng();
+  return numbers;
+}
+
+// What the picker used to do: a binary search over the children's cumulative
+// weights.
+static void BM_WeightedTargetPick_BinarySearch(benchmark::State& state) {
+  std::vector<uint32_t> ends;
+  uint32_t end = 0;
+  for (uint32_t weight : Weights(state.range(0))) {
+    end += weight;
+    ends.push_back(end);
+  }
+  const std::vector<uint64_t> numbers = RandomNumbers();
+  size_t i = 0;
+  for (auto _ : state) {
+    const uint32_t key = numbers[i++ % numbers.size()] % end;
+    benchmark::DoNotOptimize(
+        std::upper_bound(ends.begin(), ends.end(), key) - ends.begin());
+  }
+}
+BENCHMARK(BM_WeightedTargetPick_BinarySearch)->Range(2, 1024);
+
+static void BM_WeightedTargetPick_AliasTable(benchmark::State& state) {
+  AliasTable table(Weights(state.range(0)));
+  const std::vector<uint64_t> numbers = RandomNumbers();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.Pick(numbers[i++ % numbers.size()]));
+  }
+}
+BENCHMARK(BM_WeightedTargetPick_AliasTable)->Range(2, 1024);
+
+static void BM_AliasTableBuild(benchmark::State& state) {
+  const std::vector<uint32_t> weights = Weights(state.range(0));
+  for (auto _ : state) {
+    AliasTable table(weights);
+    benchmark::DoNotOptimize(table.size());
+  }
+  state.SetItemsProcessed(state.iterations() * weights.size());
+}
+BENCHMARK(BM_AliasTableBuild)->Range(2, 1024);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -116,6 +116,46 @@ BENCHMARK(BM_MultithreadedWorkQueuePopBack)
     ->Threads(4)
     ->ThreadPerCpu();
 
+WorkQueue* g_shared_queue;
+
+void SharedQueueSetup(const benchmark::State& /* state */) {
+  g_shared_queue = new WorkQueue();
+}
+
+void SharedQueueTeardown(const benchmark::State& /* state */) {
+  delete g_shared_queue;
+}
+
+// Thread 0 owns the queue, adding and popping from the back, while every other
+// thread concurrently steals from the front.
+void BM_WorkQueueOwnerWithThieves(benchmark::State& state) {
+  AnyInvocableClosure closure([] {});
+  int element_count = state.range(0);
+  int64_t popped = 0;
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      for (int i = 0; i < element_count; i++) g_shared_queue->Add(&closure);
+      while (g_shared_queue->PopBack() != nullptr) ++popped;
+    } else {
+      for (int i = 0; i < element_count; i++) {
+        if (g_shared_queue->PopFront() != nullptr) ++popped;
+      }
+    }
+  }
+  state.counters["Popped"] = popped;
+  state.counters["Pop Rate"] =
+      benchmark::Counter(popped, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_WorkQueueOwnerWithThieves)
+    ->Setup(SharedQueueSetup)
+    ->Teardown(SharedQueueTeardown)
+    ->Range(8, 1024)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime()
+    ->Threads(1)
+    ->Threads(4)
+    ->ThreadPerCpu();
+
 void BM_WorkQueueClosureExecution(benchmark::State& state) {
   WorkQueue queue;
   int element_count = state.range(0);
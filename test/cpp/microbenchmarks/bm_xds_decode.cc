@@ -0,0 +1,251 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark XdsClient handling of xDS responses carrying many resources:
+ * decoding them, both one resource at a time and through the XdsClient, as
+ * when a control plane pushes a large EDS update, and looking up the cached
+ * state of watched resources that did not change */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "upb/def.hpp"
+#include "upb/upb.hpp"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_bootstrap_grpc.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/core/xds/xds_transport_fake.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using ::envoy::config::endpoint::v3::ClusterLoadAssignment;
+using ::envoy::service::discovery::v3::DiscoveryRequest;
+using ::envoy::service::discovery::v3::DiscoveryResponse;
+
+TraceFlag bm_xds_decode_trace(false, "bm_xds_decode");
+
+RefCountedPtr<XdsClient> MakeXdsClient(
+    OrphanablePtr<XdsTransportFactory> transport_factory) {
+  auto bootstrap = GrpcXdsBootstrap::Create(
+      "{\n"
+      "  \"xds_servers\": [\n"
+      "    {\n"
+      "      \"server_uri\": \"xds.example.com\",\n"
+      "      \"channel_creds\": [{\"type\": \"insecure\"}],\n"
+      "      \"server_features\": [\"xds_v3\"]\n"
+      "    }\n"
+      "  ]\n"
+      "}");
+  GPR_ASSERT(bootstrap.ok());
+  return MakeRefCounted<XdsClient>(std::move(*bootstrap),
+                                   std::move(transport_factory));
+}
+
+// A ClusterLoadAssignment with one locality of a few endpoints.
+ClusterLoadAssignment MakeClusterLoadAssignment(int index) {
+  ClusterLoadAssignment cla;
+  cla.set_cluster_name(absl::StrCat("cluster", index));
+  auto* locality = cla.add_endpoints();
+  locality->mutable_load_balancing_weight()->set_value(1);
+  locality->mutable_locality()->set_region("region");
+  locality->mutable_locality()->set_zone("zone");
+  for (int i = 0; i < 4; ++i) {
+    auto* socket_address = locality->add_lb_endpoints()
+                               ->mutable_endpoint()
+                               ->mutable_address()
+                               ->mutable_socket_address();
+    socket_address->set_address(
+        absl::StrCat("10.", index / 256 % 256, ".", index % 256, ".", i));
+    socket_address->set_port_value(443);
+  }
+  return cla;
+}
+
+DiscoveryResponse MakeResponse(int num_resources) {
+  DiscoveryResponse response;
+  response.set_type_url(absl::StrCat(
+      "type.googleapis.com/", XdsEndpointResourceType::Get()->type_url()));
+  for (int i = 0; i < num_resources; ++i) {
+    response.add_resources()->PackFrom(MakeClusterLoadAssignment(i));
+  }
+  return response;
+}
+
+// Each iteration decodes range(0) resources, one after the other, as the
+// XdsClient used to do under its lock.
+void BM_DecodeSerially(benchmark::State& state) {
+  const int num_resources = state.range(0);
+  auto xds_client = MakeXdsClient(/*transport_factory=*/nullptr);
+  upb::DefPool def_pool;
+  XdsEndpointResourceType::Get()->InitUpbSymtab(def_pool.ptr());
+  std::vector<std::string> serialized_resources;
+  for (int i = 0; i < num_resources; ++i) {
+    serialized_resources.push_back(
+        MakeClusterLoadAssignment(i).SerializeAsString());
+  }
+  for (auto _ : state) {
+    for (const std::string& serialized_resource : serialized_resources) {
+      upb::Arena arena;
+      XdsResourceType::DecodeContext context = {
+          xds_client.get(), xds_client->bootstrap().server(),
+          &bm_xds_decode_trace, def_pool.ptr(), arena.ptr()};
+      auto result = XdsEndpointResourceType::Get()->Decode(
+          context, serialized_resource, /*is_v2=*/false);
+      GPR_ASSERT(result.resource.ok());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_resources);
+}
+BENCHMARK(BM_DecodeSerially)->Arg(1000)->Arg(10000)->UseRealTime();
+
+class NoopWatcher : public XdsEndpointResourceType::WatcherInterface {
+ public:
+  void OnResourceChanged(
+      std::shared_ptr<const XdsEndpointResource> /*resource*/) override {}
+  void OnError(absl::Status /*status*/) override {}
+  void OnResourceDoesNotExist() override {}
+};
+
+// Each iteration delivers an EDS response of range(0) resources to an
+// XdsClient watching one of them, and waits for the ACK.  Every resource
+// is decoded, whether watched or not.
+void BM_XdsClientResponse(benchmark::State& state) {
+  const int num_resources = state.range(0);
+  ExecCtx exec_ctx;
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto transport_factory_ref = transport_factory->Ref();
+  auto xds_client = MakeXdsClient(std::move(transport_factory));
+  auto watcher = MakeRefCounted<NoopWatcher>();
+  XdsEndpointResourceType::StartWatch(xds_client.get(), "cluster0", watcher);
+  auto stream = transport_factory_ref->WaitForStream(
+      xds_client->bootstrap().server(), FakeXdsTransportFactory::kAdsMethod,
+      absl::Seconds(5));
+  GPR_ASSERT(stream != nullptr);
+  GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(5)).has_value());
+  DiscoveryResponse response = MakeResponse(num_resources);
+  int version = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ++version;
+    response.set_version_info(absl::StrCat(version));
+    response.set_nonce(absl::StrCat(version));
+    const std::string serialized_response = response.SerializeAsString();
+    state.ResumeTiming();
+    stream->SendMessageToClient(serialized_response);
+    GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(5)).has_value());
+  }
+  state.SetItemsProcessed(state.iterations() * num_resources);
+  XdsEndpointResourceType::CancelWatch(xds_client.get(), "cluster0",
+                                       watcher.get());
+  stream.reset();
+  xds_client.reset();
+}
+BENCHMARK(BM_XdsClientResponse)->Arg(1000)->Arg(10000)->UseRealTime();
+
+// Each iteration delivers an EDS response of range(0) unchanged resources
+// to an XdsClient watching all of them, and waits for the ACK.  The
+// resources are not decoded again, so this measures the lookups of the
+// cached resource state.
+void BM_XdsClientUnchangedUpdate(benchmark::State& state) {
+  const int num_resources = state.range(0);
+  ExecCtx exec_ctx;
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto transport_factory_ref = transport_factory->Ref();
+  auto xds_client = MakeXdsClient(std::move(transport_factory));
+  auto watcher = MakeRefCounted<NoopWatcher>();
+  for (int i = 0; i < num_resources; ++i) {
+    XdsEndpointResourceType::StartWatch(
+        xds_client.get(), absl::StrCat("cluster", i), watcher);
+  }
+  auto stream = transport_factory_ref->WaitForStream(
+      xds_client->bootstrap().server(), FakeXdsTransportFactory::kAdsMethod,
+      absl::Seconds(5));
+  GPR_ASSERT(stream != nullptr);
+  // Wait for the client to subscribe to all of the resources.
+  DiscoveryRequest request;
+  do {
+    auto message = stream->WaitForMessageFromClient(absl::Seconds(30));
+    GPR_ASSERT(message.has_value());
+    GPR_ASSERT(request.ParseFromString(*message));
+  } while (request.resource_names_size() < num_resources);
+  // Populate the cache.
+  DiscoveryResponse response = MakeResponse(num_resources);
+  response.set_version_info("0");
+  response.set_nonce("0");
+  stream->SendMessageToClient(response.SerializeAsString());
+  GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(30)).has_value());
+  int version = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ++version;
+    response.set_version_info(absl::StrCat(version));
+    response.set_nonce(absl::StrCat(version));
+    const std::string serialized_response = response.SerializeAsString();
+    state.ResumeTiming();
+    stream->SendMessageToClient(serialized_response);
+    GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(5)).has_value());
+  }
+  state.SetItemsProcessed(state.iterations() * num_resources);
+  for (int i = 0; i < num_resources; ++i) {
+    XdsEndpointResourceType::CancelWatch(
+        xds_client.get(), absl::StrCat("cluster", i), watcher.get());
+  }
+  stream.reset();
+  xds_client.reset();
+}
+BENCHMARK(BM_XdsClientUnchangedUpdate)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark matching new connections against the filter chains of an xDS
+ * Listener, with many destination and source CIDR ranges: scanning the
+ * ranges, as the server config fetcher used to, against looking them up in
+ * XdsFilterChainIndex */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_filter_chain_index.h"
+#include "src/core/ext/xds/xds_listener.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using FilterChainMap = XdsListenerResource::FilterChainMap;
+
+FilterChainMap::CidrRange MakeRange(const std::string& ip,
+                                    uint32_t prefix_len) {
+  FilterChainMap::CidrRange range;
+  range.address = *StringToSockaddr(ip, 0);
+  range.prefix_len = prefix_len;
+  return range;
+}
+
+// One /24 destination range per destination, each with one /28 source
+// range per source, and catch-alls for both.
+FilterChainMap MakeFilterChainMap(int destinations, int sources) {
+  FilterChainMap map;
+  for (int i = 0; i <= destinations; ++i) {
+    map.destination_ip_vector.emplace_back();
+    auto& destination = map.destination_ip_vector.back();
+    if (i < destinations) {
+      destination.prefix_range =
+          MakeRange(absl::StrCat("10.", i / 256, ".", i % 256, ".0"), 24);
+    }
+    auto& source_ips = destination.source_types_array[0];
+    for (int j = 0; j <= sources; ++j) {
+      source_ips.emplace_back();
+      if (j < sources) {
+        source_ips.back().prefix_range = MakeRange(
+            absl::StrCat("192.168.", j / 16, ".", j % 16 * 16), 28);
+      }
+      source_ips.back().ports_map[0].data =
+          std::make_shared<XdsListenerResource::FilterChainData>();
+    }
+  }
+  return map;
+}
+
+// The longest prefix match by scanning, as the matching code did before
+// XdsFilterChainIndex.
+template <typename Entry>
+const Entry* ScanForLongestMatch(const std::vector<Entry>& entries,
+                                 const grpc_resolved_address& address) {
+  const Entry* best_match = nullptr;
+  for (const auto& entry : entries) {
+    if (!entry.prefix_range.has_value()) {
+      if (best_match == nullptr) best_match = &entry;
+      continue;
+    }
+    if (best_match != nullptr && best_match->prefix_range.has_value() &&
+        best_match->prefix_range->prefix_len >=
+            entry.prefix_range->prefix_len) {
+      continue;
+    }
+    if (grpc_sockaddr_match_subnet(&address, &entry.prefix_range->address,
+                                   entry.prefix_range->prefix_len)) {
+      best_match = &entry;
+    }
+  }
+  return best_match;
+}
+
+std::vector<grpc_resolved_address> MakeAddresses(const std::string& prefix,
+                                                 int count) {
+  std::vector<grpc_resolved_address> addresses;
+  for (int i = 0; i < count; ++i) {
+    addresses.push_back(*StringToSockaddr(
+        absl::StrCat(prefix, i % 64, ".", i * 7 % 256), 0));
+  }
+  return addresses;
+}
+
+// Args: number of destination ranges, number of source ranges.
+void BM_FilterChainMatchScan(benchmark::State& state) {
+  const FilterChainMap map =
+      MakeFilterChainMap(state.range(0), state.range(1));
+  const auto destinations = MakeAddresses("10.0.", 1024);
+  const auto sources = MakeAddresses("192.168.", 1024);
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto* destination =
+        ScanForLongestMatch(map.destination_ip_vector, destinations[i % 1024]);
+    const auto* source = ScanForLongestMatch(
+        destination->source_types_array[0], sources[i % 1024]);
+    benchmark::DoNotOptimize(source->ports_map.find(0));
+    ++i;
+  }
+}
+BENCHMARK(BM_FilterChainMatchScan)->RangePair(1, 4096, 1, 256);
+
+void BM_FilterChainMatchIndex(benchmark::State& state) {
+  const FilterChainMap map =
+      MakeFilterChainMap(state.range(0), state.range(1));
+  const XdsFilterChainIndex index(map);
+  const auto destinations = MakeAddresses("10.0.", 1024);
+  const auto sources = MakeAddresses("192.168.", 1024);
+  size_t i = 0;
+  for (auto _ : state) {
+    GPR_ASSERT(index.Find(destinations[i % 1024], sources[i % 1024], 443) !=
+               nullptr);
+    ++i;
+  }
+}
+BENCHMARK(BM_FilterChainMatchIndex)->RangePair(1, 4096, 1, 256);
+
+void BM_FilterChainIndexBuild(benchmark::State& state) {
+  const FilterChainMap map =
+      MakeFilterChainMap(state.range(0), state.range(1));
+  for (auto _ : state) {
+    XdsFilterChainIndex index(map);
+    benchmark::DoNotOptimize(&index);
+  }
+}
+BENCHMARK(BM_FilterChainIndexBuild)->RangePair(1, 4096, 1, 256);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,638 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the xDS client side at control plane scale: an XdsClient
+ * watching many listeners, routes, clusters or endpoints while synthetic ADS
+ * responses change a fraction of them, and the priority policy that
+ * xds_cluster_resolver feeds from EDS rebuilding its picker as endpoints
+ * churn and flap */
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "upb/def.hpp"
+#include "upb/upb.hpp"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
+#include "src/core/ext/xds/xds_bootstrap_grpc.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_cluster.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/ext/xds/xds_listener.h"
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/proto/grpc/testing/xds/v3/cluster.pb.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "src/proto/grpc/testing/xds/v3/http_connection_manager.pb.h"
+#include "src/proto/grpc/testing/xds/v3/listener.pb.h"
+#include "src/proto/grpc/testing/xds/v3/route.pb.h"
+#include "src/proto/grpc/testing/xds/v3/router.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/core/xds/xds_transport_fake.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using ::envoy::config::cluster::v3::Cluster;
+using ::envoy::config::endpoint::v3::ClusterLoadAssignment;
+using ::envoy::config::listener::v3::Listener;
+using ::envoy::config::route::v3::RouteConfiguration;
+using ::envoy::extensions::filters::http::router::v3::Router;
+using ::envoy::extensions::filters::network::http_connection_manager::v3::
+    HttpConnectionManager;
+using ::envoy::service::discovery::v3::DiscoveryRequest;
+using ::envoy::service::discovery::v3::DiscoveryResponse;
+
+TraceFlag bm_xds_scale_trace(false, "bm_xds_scale");
+
+// Bytes in use on the heap, or 0 where malloc cannot tell.
+double HeapBytes() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return static_cast<double>(mallinfo2().uordblks);
+#else
+  return 0;
+#endif
+}
+
+RefCountedPtr<XdsClient> MakeXdsClient(
+    OrphanablePtr<XdsTransportFactory> transport_factory) {
+  auto bootstrap = GrpcXdsBootstrap::Create(
+      "{\n"
+      "  \"xds_servers\": [\n"
+      "    {\n"
+      "      \"server_uri\": \"xds.example.com\",\n"
+      "      \"channel_creds\": [{\"type\": \"insecure\"}],\n"
+      "      \"server_features\": [\"xds_v3\"]\n"
+      "    }\n"
+      "  ]\n"
+      "}");
+  GPR_ASSERT(bootstrap.ok());
+  return MakeRefCounted<XdsClient>(std::move(*bootstrap),
+                                   std::move(transport_factory));
+}
+
+//
+// Synthetic resources.  Resource i of a generation only differs from the
+// same resource of another generation by the name it points to, or for
+// endpoints by their port, as when a control plane shifts traffic.
+//
+
+struct ListenerTraits {
+  using ResourceType = XdsListenerResourceType;
+  using Resource = XdsListenerResource;
+
+  static std::string Name(int i) { return absl::StrCat("listener", i); }
+
+  static void Pack(int i, int generation, google::protobuf::Any* any) {
+    HttpConnectionManager hcm;
+    auto* rds = hcm.mutable_rds();
+    rds->mutable_config_source()->mutable_ads();
+    rds->set_route_config_name(absl::StrCat("route", i, "_", generation));
+    auto* filter = hcm.add_http_filters();
+    filter->set_name("router");
+    filter->mutable_typed_config()->PackFrom(Router());
+    Listener listener;
+    listener.set_name(Name(i));
+    listener.mutable_api_listener()->mutable_api_listener()->PackFrom(hcm);
+    any->PackFrom(listener);
+  }
+};
+
+struct RouteConfigTraits {
+  using ResourceType = XdsRouteConfigResourceType;
+  using Resource = XdsRouteConfigResource;
+
+  static std::string Name(int i) { return absl::StrCat("route", i); }
+
+  static void Pack(int i, int generation, google::protobuf::Any* any) {
+    RouteConfiguration route_config;
+    route_config.set_name(Name(i));
+    auto* virtual_host = route_config.add_virtual_hosts();
+    virtual_host->add_domains("*");
+    auto* route = virtual_host->add_routes();
+    route->mutable_match()->set_prefix("");
+    route->mutable_route()->set_cluster(
+        absl::StrCat("cluster", i, "_", generation));
+    any->PackFrom(route_config);
+  }
+};
+
+struct ClusterTraits {
+  using ResourceType = XdsClusterResourceType;
+  using Resource = XdsClusterResource;
+
+  static std::string Name(int i) { return absl::StrCat("cluster", i); }
+
+  static void Pack(int i, int generation, google::protobuf::Any* any) {
+    Cluster cluster;
+    cluster.set_name(Name(i));
+    cluster.set_type(Cluster::EDS);
+    auto* eds_config = cluster.mutable_eds_cluster_config();
+    eds_config->mutable_eds_config()->mutable_ads();
+    eds_config->set_service_name(absl::StrCat("eds", i, "_", generation));
+    any->PackFrom(cluster);
+  }
+};
+
+struct EndpointTraits {
+  using ResourceType = XdsEndpointResourceType;
+  using Resource = XdsEndpointResource;
+
+  static std::string Name(int i) { return absl::StrCat("eds", i); }
+
+  // One locality of a few endpoints.
+  static void Pack(int i, int generation, google::protobuf::Any* any) {
+    ClusterLoadAssignment cla;
+    cla.set_cluster_name(Name(i));
+    auto* locality = cla.add_endpoints();
+    locality->mutable_load_balancing_weight()->set_value(1);
+    locality->mutable_locality()->set_region("region");
+    locality->mutable_locality()->set_zone("zone");
+    for (int j = 0; j < 4; ++j) {
+      auto* socket_address = locality->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(
+          absl::StrCat("10.", i / 256 % 256, ".", i % 256, ".", j));
+      socket_address->set_port_value(1000 + generation % 60000);
+    }
+    any->PackFrom(cla);
+  }
+};
+
+// Generations of each of num_resources resources, of which every update
+// bumps the next churn_percent percent, round robin.
+class ChurningResources {
+ public:
+  ChurningResources(int num_resources, int churn_percent)
+      : generations_(num_resources, 0),
+        per_update_(std::max(1, num_resources * churn_percent / 100)) {}
+
+  const std::vector<int>& generations() const { return generations_; }
+  int per_update() const { return per_update_; }
+
+  void Churn() {
+    for (int k = 0; k < per_update_; ++k) {
+      ++generations_[next_];
+      next_ = (next_ + 1) % generations_.size();
+    }
+  }
+
+ private:
+  std::vector<int> generations_;
+  const int per_update_;
+  size_t next_ = 0;
+};
+
+template <typename Traits>
+DiscoveryResponse MakeResponse(const std::vector<int>& generations,
+                               int version) {
+  DiscoveryResponse response;
+  response.set_type_url(absl::StrCat(
+      "type.googleapis.com/", Traits::ResourceType::Get()->type_url()));
+  response.set_version_info(absl::StrCat(version));
+  response.set_nonce(absl::StrCat(version));
+  for (size_t i = 0; i < generations.size(); ++i) {
+    Traits::Pack(i, generations[i], response.add_resources());
+  }
+  return response;
+}
+
+// Each iteration decodes range(0) resources of the type, one after the
+// other.
+template <typename Traits>
+void BM_XdsScaleDecode(benchmark::State& state) {
+  const int num_resources = state.range(0);
+  auto xds_client = MakeXdsClient(/*transport_factory=*/nullptr);
+  upb::DefPool def_pool;
+  Traits::ResourceType::Get()->InitUpbSymtab(def_pool.ptr());
+  std::vector<std::string> serialized_resources;
+  for (int i = 0; i < num_resources; ++i) {
+    google::protobuf::Any any;
+    Traits::Pack(i, 0, &any);
+    serialized_resources.push_back(any.value());
+  }
+  for (auto _ : state) {
+    for (const std::string& serialized_resource : serialized_resources) {
+      upb::Arena arena;
+      XdsResourceType::DecodeContext context = {
+          xds_client.get(), xds_client->bootstrap().server(),
+          &bm_xds_scale_trace, def_pool.ptr(), arena.ptr()};
+      auto result = Traits::ResourceType::Get()->Decode(
+          context, serialized_resource, /*is_v2=*/false);
+      GPR_ASSERT(result.resource.ok());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_resources);
+}
+BENCHMARK_TEMPLATE(BM_XdsScaleDecode, ListenerTraits)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_XdsScaleDecode, RouteConfigTraits)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_XdsScaleDecode, ClusterTraits)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_XdsScaleDecode, EndpointTraits)->Arg(1000);
+
+// Counts the changes it is notified of, and remembers when the last one
+// that was expected came.
+template <typename Traits>
+class CountingWatcher : public Traits::ResourceType::WatcherInterface {
+ public:
+  void OnResourceChanged(
+      std::shared_ptr<const typename Traits::Resource> /*resource*/)
+      override {
+    MutexLock lock(&mu_);
+    if (++notified_ == expected_) {
+      last_notification_ = absl::Now();
+      cv_.Signal();
+    }
+  }
+  void OnError(absl::Status status) override {
+    gpr_log(GPR_ERROR, "xDS error: %s", status.ToString().c_str());
+  }
+  void OnResourceDoesNotExist() override {}
+
+  // Expects that many changes from now on.
+  void Expect(int expected) {
+    MutexLock lock(&mu_);
+    notified_ = 0;
+    expected_ = expected;
+  }
+
+  // Waits for the expected changes, and returns when the last came.
+  absl::Time Wait() {
+    MutexLock lock(&mu_);
+    const absl::Time deadline = absl::Now() + absl::Seconds(60);
+    while (notified_ < expected_) {
+      GPR_ASSERT(!cv_.WaitWithDeadline(&mu_, deadline));
+    }
+    return last_notification_;
+  }
+
+ private:
+  Mutex mu_;
+  CondVar cv_;
+  int notified_ ABSL_GUARDED_BY(mu_) = 0;
+  int expected_ ABSL_GUARDED_BY(mu_) = 0;
+  absl::Time last_notification_ ABSL_GUARDED_BY(mu_);
+};
+
+// An XdsClient watching range(0) resources of the type. Each iteration
+// delivers a response with all of them, range(1) percent of which changed,
+// and waits until the watchers were notified and the response was ACKed.
+// Reports how long the last watcher notification took after the response
+// was sent, and the heap used by the XdsClient once it cached the
+// resources.
+template <typename Traits>
+void BM_XdsScaleUpdate(benchmark::State& state) {
+  const int num_resources = state.range(0);
+  ChurningResources resources(num_resources, state.range(1));
+  ExecCtx exec_ctx;
+  const double heap_bytes_before = HeapBytes();
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto transport_factory_ref = transport_factory->Ref();
+  auto xds_client = MakeXdsClient(std::move(transport_factory));
+  auto watcher = MakeRefCounted<CountingWatcher<Traits>>();
+  for (int i = 0; i < num_resources; ++i) {
+    Traits::ResourceType::StartWatch(xds_client.get(), Traits::Name(i),
+                                     watcher);
+  }
+  auto stream = transport_factory_ref->WaitForStream(
+      xds_client->bootstrap().server(), FakeXdsTransportFactory::kAdsMethod,
+      absl::Seconds(5));
+  GPR_ASSERT(stream != nullptr);
+  // Wait for the client to subscribe to all of the resources.
+  DiscoveryRequest request;
+  do {
+    auto message = stream->WaitForMessageFromClient(absl::Seconds(30));
+    GPR_ASSERT(message.has_value());
+    GPR_ASSERT(request.ParseFromString(*message));
+  } while (request.resource_names_size() < num_resources);
+  // Populate the cache.
+  int version = 0;
+  watcher->Expect(num_resources);
+  stream->SendMessageToClient(
+      MakeResponse<Traits>(resources.generations(), version)
+          .SerializeAsString());
+  watcher->Wait();
+  GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(30)).has_value());
+  const double heap_bytes = HeapBytes() - heap_bytes_before;
+  double notification_us = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    resources.Churn();
+    ++version;
+    const std::string serialized_response =
+        MakeResponse<Traits>(resources.generations(), version)
+            .SerializeAsString();
+    watcher->Expect(resources.per_update());
+    state.ResumeTiming();
+    const absl::Time sent = absl::Now();
+    stream->SendMessageToClient(serialized_response);
+    notification_us += absl::ToDoubleMicroseconds(watcher->Wait() - sent);
+    GPR_ASSERT(stream->WaitForMessageFromClient(absl::Seconds(30)).has_value());
+  }
+  state.counters["notification_us"] =
+      benchmark::Counter(notification_us, benchmark::Counter::kAvgIterations);
+  state.counters["heap_bytes_per_resource"] = heap_bytes / num_resources;
+  state.SetItemsProcessed(state.iterations() * resources.per_update());
+  for (int i = 0; i < num_resources; ++i) {
+    Traits::ResourceType::CancelWatch(xds_client.get(), Traits::Name(i),
+                                      watcher.get());
+  }
+  stream.reset();
+  xds_client.reset();
+}
+
+void XdsScaleUpdateArgs(benchmark::internal::Benchmark* b) {
+  for (int num_resources : {1000, 10000}) {
+    for (int churn_percent : {1, 10, 100}) {
+      b->Args({num_resources, churn_percent});
+    }
+  }
+  b->ArgNames({"resources", "churn_percent"})->UseRealTime();
+}
+BENCHMARK_TEMPLATE(BM_XdsScaleUpdate, ListenerTraits)
+    ->Apply(XdsScaleUpdateArgs);
+BENCHMARK_TEMPLATE(BM_XdsScaleUpdate, RouteConfigTraits)
+    ->Apply(XdsScaleUpdateArgs);
+BENCHMARK_TEMPLATE(BM_XdsScaleUpdate, ClusterTraits)
+    ->Apply(XdsScaleUpdateArgs);
+BENCHMARK_TEMPLATE(BM_XdsScaleUpdate, EndpointTraits)
+    ->Apply(XdsScaleUpdateArgs);
+
+//
+// The priority policy, fed the way xds_cluster_resolver feeds it: one child
+// per EDS priority, with round_robin leaves, over fake subchannels.
+//
+
+class PriorityFixture {
+ public:
+  PriorityFixture(int num_priorities, int endpoints_per_priority)
+      : work_serializer_(std::make_shared<WorkSerializer>()),
+        endpoints_per_priority_(endpoints_per_priority) {
+    LoadBalancingPolicy::Args args;
+    args.work_serializer = work_serializer_;
+    args.channel_control_helper = absl::make_unique<Helper>(this);
+    policy_ =
+        CoreConfiguration::Get().lb_policy_registry().CreateLoadBalancingPolicy(
+            "priority_experimental", std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+    std::vector<std::string> children;
+    std::vector<std::string> priorities;
+    for (int p = 0; p < num_priorities; ++p) {
+      children.push_back(absl::StrCat(
+          "\"child", p, "\":{\"config\":[{\"round_robin\":{}}]}"));
+      priorities.push_back(absl::StrCat("\"child", p, "\""));
+    }
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            *Json::Parse(absl::StrCat(
+                "[{\"priority_experimental\":{\"children\":{",
+                absl::StrJoin(children, ","), "},\"priorities\":[",
+                absl::StrJoin(priorities, ","), "]}}]")));
+    GPR_ASSERT(config.ok());
+    config_ = std::move(*config);
+    generations_.assign(num_priorities * endpoints_per_priority, 0);
+    Update();
+  }
+
+  ~PriorityFixture() {
+    work_serializer_->Run([this]() { policy_.reset(); }, DEBUG_LOCATION);
+  }
+
+  // Delivers the addresses of the current generations, as for an EDS
+  // update, and brings the subchannels it creates to READY.
+  void Update() {
+    LoadBalancingPolicy::UpdateArgs update;
+    update.config = config_;
+    update.addresses.emplace();
+    for (size_t i = 0; i < generations_.size(); ++i) {
+      const int priority = i / endpoints_per_priority_;
+      auto address = StringToSockaddr(absl::StrCat(
+          "10.", priority, ".", i % endpoints_per_priority_ / 256, ".",
+          i % 256, ":", 1000 + generations_[i] % 60000));
+      GPR_ASSERT(address.ok());
+      std::map<const char*, std::unique_ptr<ServerAddress::AttributeInterface>>
+          attributes;
+      attributes[kHierarchicalPathAttributeKey] =
+          MakeHierarchicalPathAttribute({absl::StrCat("child", priority)});
+      update.addresses->emplace_back(*address, ChannelArgs(),
+                                     std::move(attributes));
+    }
+    work_serializer_->Run(
+        [this, &update]() {
+          GPR_ASSERT(policy_->UpdateLocked(std::move(update)).ok());
+        },
+        DEBUG_LOCATION);
+    work_serializer_->DrainQueue();
+    std::vector<FakeSubchannel*> created = std::move(created_);
+    created_.clear();
+    for (FakeSubchannel* subchannel : created) {
+      subchannel->SetState(GRPC_CHANNEL_READY, absl::OkStatus());
+    }
+    if (flapping_ == nullptr && !created.empty()) flapping_ = created.front();
+    work_serializer_->DrainQueue();
+  }
+
+  // Changes the port of the next churn_percent percent of the endpoints, of
+  // every priority.
+  void Churn(int churn_percent) {
+    const int changed =
+        std::max<size_t>(1, generations_.size() * churn_percent / 100);
+    for (int k = 0; k < changed; ++k) {
+      ++generations_[next_];
+      next_ = (next_ + 1) % generations_.size();
+    }
+  }
+
+  // Takes one READY subchannel of the highest priority to
+  // TRANSIENT_FAILURE and back.
+  void Flap() {
+    GPR_ASSERT(flapping_ != nullptr);
+    flapping_->SetState(GRPC_CHANNEL_TRANSIENT_FAILURE,
+                              absl::UnavailableError("connection refused"));
+    work_serializer_->DrainQueue();
+    flapping_->SetState(GRPC_CHANNEL_READY, absl::OkStatus());
+    work_serializer_->DrainQueue();
+  }
+
+  size_t num_pickers() const { return num_pickers_; }
+  size_t num_endpoints() const { return generations_.size(); }
+
+ private:
+  class FakeSubchannel : public SubchannelInterface {
+   public:
+    explicit FakeSubchannel(PriorityFixture* fixture) : fixture_(fixture) {}
+
+    void WatchConnectivityState(
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+      watcher_ = std::move(watcher);
+      SetState(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+    }
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override {
+      if (watcher_.get() == watcher) watcher_.reset();
+    }
+
+    void RequestConnection() override {}
+    void ResetBackoff() override {}
+    void AddDataWatcher(
+        std::unique_ptr<DataWatcherInterface> /*watcher*/) override {}
+    ChannelArgs channel_args() override { return ChannelArgs(); }
+
+    void SetState(grpc_connectivity_state state, absl::Status status) {
+      ConnectivityStateWatcherInterface* watcher = watcher_.get();
+      if (watcher == nullptr) return;
+      fixture_->work_serializer_->Schedule(
+          [watcher, state, status]() {
+            watcher->OnConnectivityStateChange(state, status);
+          },
+          DEBUG_LOCATION);
+    }
+
+   private:
+    PriorityFixture* fixture_;
+    std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+  };
+
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(PriorityFixture* fixture) : fixture_(fixture) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress /*address*/, const ChannelArgs& /*args*/) override {
+      auto subchannel = MakeRefCounted<FakeSubchannel>(fixture_);
+      fixture_->created_.push_back(subchannel.get());
+      return subchannel;
+    }
+
+    void UpdateState(
+        grpc_connectivity_state /*state*/, const absl::Status& /*status*/,
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> /*picker*/)
+        override {
+      ++fixture_->num_pickers_;
+    }
+
+    void RequestReresolution() override {}
+    absl::string_view GetAuthority() override { return "server.example.com"; }
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    PriorityFixture* fixture_;
+  };
+
+  std::shared_ptr<WorkSerializer> work_serializer_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  RefCountedPtr<LoadBalancingPolicy::Config> config_;
+  const int endpoints_per_priority_;
+  std::vector<int> generations_;
+  size_t next_ = 0;
+  // Created by the last update; not owned, the policy holds the refs.
+  std::vector<FakeSubchannel*> created_;
+  // The first subchannel created, which is of the highest priority as long
+  // as its endpoint does not churn.
+  FakeSubchannel* flapping_ = nullptr;
+  size_t num_pickers_ = 0;
+};
+
+// Each iteration delivers an EDS-like update of range(0) priorities of
+// range(1) endpoints each, range(2) percent of which changed address.
+void BM_PriorityEndpointChurn(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  PriorityFixture fixture(state.range(0), state.range(1));
+  const size_t initial_pickers = fixture.num_pickers();
+  for (auto _ : state) {
+    fixture.Churn(state.range(2));
+    fixture.Update();
+  }
+  state.counters["pickers_per_update"] =
+      benchmark::Counter(fixture.num_pickers() - initial_pickers,
+                         benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PriorityEndpointChurn)
+    ->ArgNames({"priorities", "endpoints", "churn_percent"})
+    ->Args({1, 100, 10})
+    ->Args({1, 1000, 1})
+    ->Args({1, 1000, 10})
+    ->Args({3, 1000, 10});
+
+// Each iteration flaps one endpoint of the highest of range(0) priorities
+// of range(1) endpoints each: two picker rebuilds through priority.
+void BM_PriorityPickerRebuild(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  PriorityFixture fixture(state.range(0), state.range(1));
+  for (auto _ : state) {
+    fixture.Flap();
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_PriorityPickerRebuild)
+    ->ArgNames({"priorities", "endpoints"})
+    ->Args({1, 100})
+    ->Args({1, 1000})
+    ->Args({3, 1000});
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
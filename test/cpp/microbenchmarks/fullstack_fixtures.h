@@ -331,6 +331,59 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+////////////////////////////////////////////////////////////////////////////////
+// Write coalescing fixtures
+
+template <int kBytes, int kWindowUs>
+class WriteCoalescingConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES, kBytes);
+    a->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, kWindowUs);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES, kBytes);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, kWindowUs);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base, int kBytes, int kWindowUs>
+class WriteCoalesce : public Base {
+ public:
+  explicit WriteCoalesce(Service* service)
+      : Base(service, WriteCoalescingConfiguration<kBytes, kWindowUs>()) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Retry fixtures
+
+class RetryConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetServiceConfigJSON(
+        "{\"methodConfig\":[{"
+        "  \"name\":[{}],"
+        "  \"retryPolicy\":{"
+        "    \"maxAttempts\":2,"
+        "    \"initialBackoff\":\"1s\","
+        "    \"maxBackoff\":\"1s\","
+        "    \"backoffMultiplier\":1.6,"
+        "    \"retryableStatusCodes\":[\"UNAVAILABLE\"]"
+        "  }"
+        "}]}");
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+template <class Base>
+class Retryize : public Base {
+ public:
+  explicit Retryize(Service* service) : Base(service, RetryConfiguration()) {}
+};
+
+typedef Retryize<TCP> RetryTCP;
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -21,10 +21,15 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
+#include "src/core/lib/slice/slab_pool.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
 #include "test/cpp/microbenchmarks/fullstack_fixtures.h"
@@ -38,6 +43,15 @@ namespace testing {
 
 static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
 
+// Reports how many blocks of read slices the slab pool had to allocate rather
+// than recycle, per iteration since slab_new_blocks was sampled.
+static void ReportSlabNewBlocks(benchmark::State& state,
+                                uint64_t slab_new_blocks) {
+  state.counters["slab_new_blocks_per_iter"] = benchmark::Counter(
+      grpc_core::SlabPool::TestOnlyNewBlocks() - slab_new_blocks,
+      benchmark::Counter::kAvgIterations);
+}
+
 template <class Fixture>
 static void BM_PumpStreamClientToServer(benchmark::State& state) {
   EchoTestService::AsyncService service;
@@ -68,6 +82,7 @@ static void BM_PumpStreamClientToServer(benchmark::State& state) {
       need_tags &= ~(1 << i);
     }
     response_rw.Read(&recv_request, tag(0));
+    const uint64_t slab_new_blocks = grpc_core::SlabPool::TestOnlyNewBlocks();
     for (auto _ : state) {
       request_rw->Write(send_request, tag(1));
       while (true) {
@@ -81,6 +96,7 @@ static void BM_PumpStreamClientToServer(benchmark::State& state) {
         }
       }
     }
+    ReportSlabNewBlocks(state, slab_new_blocks);
     request_rw->WritesDone(tag(1));
     need_tags = (1 << 0) | (1 << 1);
     while (need_tags) {
@@ -136,6 +152,7 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
       need_tags &= ~(1 << i);
     }
     request_rw->Read(&recv_response, tag(0));
+    const uint64_t slab_new_blocks = grpc_core::SlabPool::TestOnlyNewBlocks();
     for (auto _ : state) {
       response_rw.Write(send_response, tag(1));
       while (true) {
@@ -149,6 +166,7 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
         }
       }
     }
+    ReportSlabNewBlocks(state, slab_new_blocks);
     response_rw.Finish(Status::OK, tag(1));
     need_tags = (1 << 0) | (1 << 1);
     while (need_tags) {
@@ -162,6 +180,125 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
   fixture.reset();
   state.SetBytesProcessed(state.range(0) * state.iterations());
 }
+
+// Pumps messages of state.range(0) bytes from client to server on one
+// stream, while another stream of the same channel plays ping pong with
+// messages of state.range(1) bytes, at the grpc-write-weight state.range(2).
+// An iteration is a ping pong, and the counters report how long the small
+// stream waits behind the bulk one (e.g. to compare with and without the
+// adaptive_frame_size and chttp2_weighted_fair_writes experiments).
+template <class Fixture>
+static void BM_PumpStreamsFairness(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  // Tags of the bulk stream: server read 0, client write 1; of the small
+  // stream: server read 2, client write 3, server write 4, client read 5.
+  std::vector<double> latencies_us;
+  int64_t bulk_bytes = 0;
+  {
+    EchoRequest bulk_request;
+    EchoRequest small_request;
+    EchoRequest recv_request;
+    EchoResponse small_response;
+    EchoResponse recv_response;
+    bulk_request.set_message(std::string(state.range(0), 'a'));
+    if (state.range(1) > 0) {
+      small_request.set_message(std::string(state.range(1), 'a'));
+      small_response.set_message(std::string(state.range(1), 'a'));
+    }
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    void* t;
+    bool ok;
+    auto start_stream = [&](ServerContext* svr_ctx,
+                            ServerAsyncReaderWriter<EchoResponse, EchoRequest>*
+                                response_rw,
+                            ClientContext* cli_ctx) {
+      service.RequestBidiStream(svr_ctx, response_rw, fixture->cq(),
+                                fixture->cq(), tag(0));
+      auto request_rw = stub->AsyncBidiStream(cli_ctx, fixture->cq(), tag(1));
+      int need_tags = (1 << 0) | (1 << 1);
+      while (need_tags) {
+        GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+        GPR_ASSERT(ok);
+        int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+        GPR_ASSERT(need_tags & (1 << i));
+        need_tags &= ~(1 << i);
+      }
+      return request_rw;
+    };
+    ServerContext bulk_svr_ctx;
+    ServerAsyncReaderWriter<EchoResponse, EchoRequest> bulk_response_rw(
+        &bulk_svr_ctx);
+    ClientContext bulk_cli_ctx;
+    auto bulk_request_rw =
+        start_stream(&bulk_svr_ctx, &bulk_response_rw, &bulk_cli_ctx);
+    ServerContext small_svr_ctx;
+    ServerAsyncReaderWriter<EchoResponse, EchoRequest> small_response_rw(
+        &small_svr_ctx);
+    ClientContext small_cli_ctx;
+    small_cli_ctx.AddMetadata("grpc-write-weight",
+                              std::to_string(state.range(2)));
+    auto small_request_rw =
+        start_stream(&small_svr_ctx, &small_response_rw, &small_cli_ctx);
+
+    bulk_response_rw.Read(&recv_request, tag(0));
+    bulk_request_rw->Write(bulk_request, tag(1));
+    small_response_rw.Read(&recv_request, tag(2));
+    for (auto _ : state) {
+      auto start = std::chrono::steady_clock::now();
+      small_request_rw->Write(small_request, tag(3));
+      small_request_rw->Read(&recv_response, tag(5));
+      int need_tags = (1 << 3) | (1 << 4) | (1 << 5);
+      while (need_tags) {
+        GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+        GPR_ASSERT(ok);
+        int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+        switch (i) {
+          case 0:
+            bulk_bytes += state.range(0);
+            bulk_response_rw.Read(&recv_request, tag(0));
+            break;
+          case 1:
+            bulk_request_rw->Write(bulk_request, tag(1));
+            break;
+          case 2:
+            small_response_rw.Write(small_response, tag(4));
+            break;
+          case 5:
+            latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+            need_tags &= ~(1 << i);
+            break;
+          default:
+            GPR_ASSERT(need_tags & (1 << i));
+            need_tags &= ~(1 << i);
+            if (i == 4) small_response_rw.Read(&recv_request, tag(2));
+        }
+      }
+    }
+    // Cancel both streams, and drain the reads and write still pending.
+    bulk_cli_ctx.TryCancel();
+    small_cli_ctx.TryCancel();
+    for (int pending = 3; pending > 0; --pending) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+    }
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [&latencies_us](double p) {
+    if (latencies_us.empty()) return 0.0;
+    return latencies_us[static_cast<size_t>(p * (latencies_us.size() - 1))];
+  };
+  state.counters["small_p50_us"] = percentile(0.5);
+  state.counters["small_p99_us"] = percentile(0.99);
+  state.counters["bulk_bytes_per_second"] =
+      benchmark::Counter(bulk_bytes, benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(bulk_bytes);
+}
 }  // namespace testing
 }  // namespace grpc
 
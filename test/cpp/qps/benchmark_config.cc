@@ -32,6 +32,10 @@ ABSL_FLAG(bool, enable_log_reporter, true,
 ABSL_FLAG(std::string, scenario_result_file, "",
           "Write JSON benchmark report to the file specified.");
 
+ABSL_FLAG(std::string, hdr_histogram_file, "",
+          "Write the latency distribution, in microseconds, to the file "
+          "specified in the percentile distribution format of HdrHistogram.");
+
 ABSL_FLAG(std::string, hashed_id, "", "Hash of the user id");
 
 ABSL_FLAG(std::string, test_name, "", "Name of the test being executed");
@@ -66,6 +70,10 @@ static std::shared_ptr<Reporter> InitBenchmarkReporters() {
     composite_reporter->add(std::unique_ptr<Reporter>(new JsonReporter(
         "JsonReporter", absl::GetFlag(FLAGS_scenario_result_file))));
   }
+  if (!absl::GetFlag(FLAGS_hdr_histogram_file).empty()) {
+    composite_reporter->add(std::unique_ptr<Reporter>(new HdrHistogramReporter(
+        "HdrHistogramReporter", absl::GetFlag(FLAGS_hdr_histogram_file))));
+  }
   if (absl::GetFlag(FLAGS_enable_rpc_reporter)) {
     ChannelArguments channel_args;
     std::shared_ptr<ChannelCredentials> channel_creds =
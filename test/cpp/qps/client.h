@@ -140,6 +140,20 @@ class HistogramEntry final {
   int status_;
 };
 
+// The start of the latency of a request that the load meant to issue at
+// issue_time, from NextIssueTime(), in UsageTimer::Now() units: if the
+// client is issuing it late, the time it fell behind counts. Measuring from
+// when a request was actually issued omits that wait exactly when the client
+// cannot keep up with the offered load, and under-reports latencies.
+inline double IntendedStartTime(gpr_timespec issue_time) {
+  const double now = UsageTimer::Now();
+  const double behind_seconds =
+      gpr_timespec_to_micros(
+          gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), issue_time)) /
+      1e6;
+  return behind_seconds > 0 ? now - behind_seconds : now;
+}
+
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
 inline void MergeStatusHistogram(const StatusHistogram& from,
@@ -170,6 +184,11 @@ class Client {
 
     int cur_poll_count = GetPollCount();
     int poll_count = cur_poll_count - last_reset_poll_count_;
+    // Like polls, core stats are counted since the last reset.
+    grpc_stats_data cur_core_stats;
+    grpc_stats_collect(&cur_core_stats);
+    grpc_stats_data core_stats;
+    grpc_stats_diff(&cur_core_stats, &last_reset_core_stats_, &core_stats);
     if (reset) {
       std::vector<Histogram> to_merge(threads_.size());
       std::vector<StatusHistogram> to_merge_status(threads_.size());
@@ -185,6 +204,7 @@ class Client {
       }
       timer_result = timer->Mark();
       last_reset_poll_count_ = cur_poll_count;
+      last_reset_core_stats_ = cur_core_stats;
     } else {
       // merge snapshots of each thread histogram
       for (size_t i = 0; i < threads_.size(); i++) {
@@ -206,9 +226,6 @@ class Client {
       }
     }
 
-    grpc_stats_data core_stats;
-    grpc_stats_collect(&core_stats);
-
     ClientStats stats;
     latencies.FillProto(stats.mutable_latencies());
     for (StatusHistogram::const_iterator it = statuses.begin();
@@ -249,6 +266,14 @@ class Client {
 
   bool IsClosedLoop() { return closed_loop_; }
 
+  // The start of the latency of a request issued now, which the load meant to
+  // issue at issue_time: see IntendedStartTime(). Unless the scenario asks
+  // for latencies from the intended start, that is now.
+  double RequestStartTime(gpr_timespec issue_time) const {
+    return measure_from_intended_start_ ? IntendedStartTime(issue_time)
+                                        : UsageTimer::Now();
+  }
+
   gpr_timespec NextIssueTime(int thread_idx) {
     const gpr_timespec result = next_time_[thread_idx];
     next_time_[thread_idx] =
@@ -342,6 +367,9 @@ class Client {
 
  protected:
   bool closed_loop_;
+  // Whether open-loop latencies are measured from when the load meant to
+  // issue each request.
+  bool measure_from_intended_start_ = false;
   gpr_atm thread_pool_done_;
   double median_latency_collection_interval_seconds_;  // In seconds
 
@@ -372,6 +400,8 @@ class Client {
       case LoadParams::kPoisson:
         random_dist = absl::make_unique<ExpDist>(load.poisson().offered_load() /
                                                  num_threads);
+        measure_from_intended_start_ =
+            load.poisson().measure_from_intended_start();
         break;
       default:
         GPR_ASSERT(false);
@@ -414,6 +444,7 @@ class Client {
   bool started_requests_;
 
   int last_reset_poll_count_;
+  grpc_stats_data last_reset_core_stats_ = {};
 
   void MaybeStartRequests() {
     if (!started_requests_) {
@@ -86,12 +86,15 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   ~ClientRpcContextUnaryImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
     GPR_ASSERT(!config.use_coalesce_api());  // not supported.
+    measure_from_intended_start_ =
+        config.load_params().poisson().measure_from_intended_start();
     StartInternal(cq);
   }
   bool RunNextState(bool /*ok*/, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        start_ = measure_from_intended_start_ ? IntendedStartTime(issue_time_)
+                                              : UsageTimer::Now();
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -113,6 +116,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   void StartNewClone(CompletionQueue* cq) override {
     auto* clone = new ClientRpcContextUnaryImpl(stub_, req_, next_issue_,
                                                 prepare_req_, callback_);
+    clone->measure_from_intended_start_ = measure_from_intended_start_;
     clone->StartInternal(cq);
   }
   void TryCancel() override { context_.TryCancel(); }
@@ -134,6 +138,9 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  // When the load meant to issue the call, in open loop.
+  gpr_timespec issue_time_;
+  bool measure_from_intended_start_ = false;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
@@ -142,8 +149,9 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
     if (!next_issue_) {  // ready to issue
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
+      issue_time_ = next_issue_();
       alarm_ = absl::make_unique<Alarm>();
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
     }
   }
 };
@@ -357,6 +365,8 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         coalesce_(false) {}
   ~ClientRpcContextStreamingPingPongImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
+    measure_from_intended_start_ =
+        config.load_params().poisson().measure_from_intended_start();
     StartInternal(cq, config.messages_per_stream(), config.use_coalesce_api());
   }
   bool RunNextState(bool ok, HistogramEntry* entry) override {
@@ -371,14 +381,17 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
+          issue_time_ = next_issue_();
           alarm_ = absl::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          start_ = measure_from_intended_start_
+                       ? IntendedStartTime(issue_time_)
+                       : UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -428,6 +441,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
   void StartNewClone(CompletionQueue* cq) override {
     auto* clone = new ClientRpcContextStreamingPingPongImpl(
         stub_, req_, next_issue_, prepare_req_, callback_);
+    clone->measure_from_intended_start_ = measure_from_intended_start_;
     clone->StartInternal(cq, messages_per_stream_, coalesce_);
   }
   void TryCancel() override { context_.TryCancel(); }
@@ -458,6 +472,9 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  // When the load meant to issue the message, in open loop.
+  gpr_timespec issue_time_;
+  bool measure_from_intended_start_ = false;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
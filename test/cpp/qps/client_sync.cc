@@ -79,10 +79,12 @@ class SynchronousClient
   }
 
  protected:
-  // WaitToIssue returns false if we realize that we need to break out
-  bool WaitToIssue(int thread_idx) {
+  // WaitToIssue returns false if we realize that we need to break out.
+  // Otherwise *issue_time is when the load meant to issue the request.
+  bool WaitToIssue(int thread_idx, gpr_timespec* issue_time) {
     if (!closed_loop_) {
       const gpr_timespec next_issue_time = NextIssueTime(thread_idx);
+      *issue_time = next_issue_time;
       // Avoid sleeping for too long continuously because we might
       // need to terminate before then. This is an issue since
       // exponential distribution can occasionally produce bad outliers
@@ -101,6 +103,7 @@ class SynchronousClient
         }
       }
     }
+    *issue_time = gpr_now(GPR_CLOCK_MONOTONIC);
     return true;
   }
 
@@ -119,11 +122,12 @@ class SynchronousUnaryClient final : public SynchronousClient {
   bool InitThreadFuncImpl(size_t /*thread_idx*/) override { return true; }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    gpr_timespec issue_time;
+    if (!WaitToIssue(thread_idx, &issue_time)) {
       return true;
     }
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
-    double start = UsageTimer::Now();
+    double start = RequestStartTime(issue_time);
     grpc::ClientContext context;
     grpc::Status s =
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
@@ -238,10 +242,11 @@ class SynchronousStreamingPingPongClient final
   }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    gpr_timespec issue_time;
+    if (!WaitToIssue(thread_idx, &issue_time)) {
       return true;
     }
-    double start = UsageTimer::Now();
+    double start = RequestStartTime(issue_time);
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
@@ -298,7 +303,8 @@ class SynchronousStreamingFromClientClient final
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
     // Figure out how to make histogram sensible if this is rate-paced
-    if (!WaitToIssue(thread_idx)) {
+    gpr_timespec issue_time;
+    if (!WaitToIssue(thread_idx, &issue_time)) {
       return true;
     }
     if (stream_[thread_idx]->Write(request_)) {
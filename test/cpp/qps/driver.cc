@@ -36,6 +36,7 @@
 
 #include "src/core/lib/gprpp/env.h"
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/cpp/util/core_stats.h"
 #include "src/proto/grpc/testing/worker_service.grpc.pb.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -113,6 +114,18 @@ static double ServerTotalCpuTime(const ServerStats& s) {
 static double ServerIdleCpuTime(const ServerStats& s) {
   return s.idle_cpu_time();
 }
+static double CoreStatsSyscalls(const grpc::core::Stats& stats) {
+  grpc_stats_data data;
+  ProtoToCoreStats(stats, &data);
+  return data.counters[GRPC_STATS_COUNTER_SYSCALL_READ] +
+         data.counters[GRPC_STATS_COUNTER_SYSCALL_WRITE];
+}
+static double CliSyscalls(const ClientStats& s) {
+  return CoreStatsSyscalls(s.core_stats());
+}
+static double SvrSyscalls(const ServerStats& s) {
+  return CoreStatsSyscalls(s.core_stats());
+}
 static int Cores(int n) { return n; }
 
 static bool IsSuccess(const Status& s) {
@@ -210,6 +223,10 @@ static void postprocess_scenario_result(ScenarioResult* result) {
       sum(result->client_stats(), CliPollCount) / histogram.Count());
   result->mutable_summary()->set_server_polls_per_request(
       sum(result->server_stats(), SvrPollCount) / histogram.Count());
+  result->mutable_summary()->set_client_syscalls_per_request(
+      sum(result->client_stats(), CliSyscalls) / histogram.Count());
+  result->mutable_summary()->set_server_syscalls_per_request(
+      sum(result->server_stats(), SvrSyscalls) / histogram.Count());
 
   auto server_queries_per_cpu_sec =
       histogram.Count() / (sum(result->server_stats(), ServerSystemTime) +
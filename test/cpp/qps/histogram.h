@@ -49,6 +49,9 @@ class Histogram {
     return grpc_histogram_percentile(impl_, pctile);
   }
   double Count() const { return grpc_histogram_count(impl_); }
+  double Mean() const { return grpc_histogram_mean(impl_); }
+  double StdDev() const { return grpc_histogram_stddev(impl_); }
+  double Max() const { return grpc_histogram_maximum(impl_); }
   void Swap(Histogram* other) { std::swap(impl_, other->impl_); }
   void FillProto(HistogramData* p) {
     size_t n;
@@ -58,6 +58,30 @@ static void RunQPS() {
   GetReporter()->ReportLatency(*result);
 }
 
+static void RunQPSFromIntendedStart() {
+  gpr_log(GPR_INFO, "Running QPS test, open-loop from intended start");
+
+  ClientConfig client_config;
+  client_config.set_client_type(SYNC_CLIENT);
+  client_config.set_outstanding_rpcs_per_channel(1);
+  client_config.set_client_channels(8);
+  client_config.set_rpc_type(UNARY);
+  auto* poisson = client_config.mutable_load_params()->mutable_poisson();
+  poisson->set_offered_load(1000.0 / grpc_test_slowdown_factor());
+  poisson->set_measure_from_intended_start(true);
+
+  ServerConfig server_config;
+  server_config.set_server_type(SYNC_SERVER);
+
+  const auto result =
+      RunScenario(client_config, 1, server_config, 1, WARMUP, BENCHMARK, -2, "",
+                  kInsecureCredentialsType, {}, false, 0);
+
+  GPR_ASSERT(result->latencies().count() > 0);
+  GetReporter()->ReportLatency(*result);
+  GetReporter()->ReportPollCount(*result);
+}
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -66,6 +90,7 @@ int main(int argc, char** argv) {
   grpc::testing::InitTest(&argc, &argv, true);
 
   grpc::testing::RunQPS();
+  grpc::testing::RunQPSFromIntendedStart();
 
   return 0;
 }
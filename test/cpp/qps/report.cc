@@ -18,14 +18,19 @@
 
 #include "test/cpp/qps/report.h"
 
+#include <math.h>
+
 #include <fstream>
 
+#include "absl/strings/str_format.h"
+
 #include <grpc/support/log.h>
 #include <grpcpp/client_context.h>
 
 #include "src/cpp/util/core_stats.h"
 #include "src/proto/grpc/testing/report_qps_scenario_service.grpc.pb.h"
 #include "test/cpp/qps/driver.h"
+#include "test/cpp/qps/histogram.h"
 #include "test/cpp/qps/parse_json.h"
 #include "test/cpp/qps/stats.h"
 
@@ -154,6 +159,10 @@ void GprLogReporter::ReportPollCount(const ScenarioResult& result) {
           result.summary().client_polls_per_request());
   gpr_log(GPR_INFO, "Server Polls per Request: %.2f",
           result.summary().server_polls_per_request());
+  gpr_log(GPR_INFO, "Client Syscalls per Request: %.2f",
+          result.summary().client_syscalls_per_request());
+  gpr_log(GPR_INFO, "Server Syscalls per Request: %.2f",
+          result.summary().server_syscalls_per_request());
 }
 
 void GprLogReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
@@ -195,6 +204,61 @@ void JsonReporter::ReportQueriesPerCpuSec(const ScenarioResult& /*result*/) {
   // NOP - all reporting is handled by ReportQPS.
 }
 
+void HdrHistogramReporter::ReportQPS(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
+void HdrHistogramReporter::ReportQPSPerCore(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
+void HdrHistogramReporter::ReportLatency(const ScenarioResult& result) {
+  Histogram histogram;
+  histogram.MergeProto(result.latencies());
+  const double count = histogram.Count();
+  std::ofstream output_file(report_file_);
+  output_file << absl::StrFormat("%12s %14s %10s %14s\n\n", "Value",
+                                 "Percentile", "TotalCount",
+                                 "1/(1-Percentile)");
+  // As HdrHistogram does: 5 lines for each halving of the distance to the
+  // 100th percentile, until less than one request is left beyond.
+  double percentile = 0;
+  while ((100 - percentile) / 100 * count >= 1) {
+    output_file << absl::StrFormat(
+        "%12.3f %2.12f %10.0f %14.2f\n", histogram.Percentile(percentile) / 1e3,
+        percentile / 100, floor(percentile / 100 * count + 0.5),
+        100 / (100 - percentile));
+    const double ticks = 10 * exp2(floor(log2(100 / (100 - percentile))));
+    percentile += 100 / ticks;
+  }
+  output_file << absl::StrFormat("%12.3f %2.12f %10.0f\n",
+                                 histogram.Max() / 1e3, 1.0, count);
+  output_file << absl::StrFormat(
+      "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", histogram.Mean() / 1e3,
+      histogram.StdDev() / 1e3);
+  output_file << absl::StrFormat(
+      "#[Max     = %12.3f, Total count    = %12.0f]\n", histogram.Max() / 1e3,
+      count);
+  output_file.close();
+}
+
+void HdrHistogramReporter::ReportTimes(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
+void HdrHistogramReporter::ReportCpuUsage(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
+void HdrHistogramReporter::ReportPollCount(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
+void HdrHistogramReporter::ReportQueriesPerCpuSec(
+    const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportLatency.
+}
+
 void RpcReporter::ReportQPS(const ScenarioResult& result) {
   grpc::ClientContext context;
   grpc::Status status;
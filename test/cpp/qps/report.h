@@ -60,7 +60,8 @@ class Reporter {
   /** Reports server cpu usage. */
   virtual void ReportCpuUsage(const ScenarioResult& result) = 0;
 
-  /** Reports client and server poll usage inside completion queue. */
+  /** Reports client and server poll usage inside completion queue, and
+   * syscalls per request. */
   virtual void ReportPollCount(const ScenarioResult& result) = 0;
 
   /** Reports queries per cpu-sec. */
@@ -126,6 +127,26 @@ class JsonReporter : public Reporter {
   const string report_file_;
 };
 
+/** Writes the latency distribution, in microseconds, to a file in the
+ * percentile distribution format of HdrHistogram, which its plotting tools
+ * read. */
+class HdrHistogramReporter : public Reporter {
+ public:
+  HdrHistogramReporter(const string& name, const string& report_file)
+      : Reporter(name), report_file_(report_file) {}
+
+ private:
+  void ReportQPS(const ScenarioResult& result) override;
+  void ReportQPSPerCore(const ScenarioResult& result) override;
+  void ReportLatency(const ScenarioResult& result) override;
+  void ReportTimes(const ScenarioResult& result) override;
+  void ReportCpuUsage(const ScenarioResult& result) override;
+  void ReportPollCount(const ScenarioResult& result) override;
+  void ReportQueriesPerCpuSec(const ScenarioResult& result) override;
+
+  const string report_file_;
+};
+
 class RpcReporter : public Reporter {
  public:
   RpcReporter(const string& name, const std::shared_ptr<grpc::Channel>& channel)
@@ -56,18 +56,21 @@ class Server {
     UsageTimer::Result timer_result;
     int cur_poll_count = GetPollCount();
     int poll_count = cur_poll_count - last_reset_poll_count_;
+    // Like polls, core stats are counted since the last reset.
+    grpc_stats_data cur_core_stats;
+    grpc_stats_collect(&cur_core_stats);
+    grpc_stats_data core_stats;
+    grpc_stats_diff(&cur_core_stats, &last_reset_core_stats_, &core_stats);
     if (reset) {
       std::unique_ptr<UsageTimer> timer(new UsageTimer);
       timer.swap(timer_);
       timer_result = timer->Mark();
       last_reset_poll_count_ = cur_poll_count;
+      last_reset_core_stats_ = cur_core_stats;
     } else {
       timer_result = timer_->Mark();
     }
 
-    grpc_stats_data core_stats;
-    grpc_stats_collect(&core_stats);
-
     ServerStats stats;
     stats.set_time_elapsed(timer_result.wall);
     stats.set_time_system(timer_result.system);
@@ -149,6 +152,7 @@ class Server {
   int cores_;
   std::unique_ptr<UsageTimer> timer_;
   int last_reset_poll_count_;
+  grpc_stats_data last_reset_core_stats_ = {};
 };
 
 std::unique_ptr<Server> CreateSynchronousServer(const ServerConfig& config);
@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -106,6 +107,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     for (int i = 0; i < num_threads; i++) {
       cq_.emplace_back(i % srv_cqs_.size());
     }
+    next_batch_ = std::max(1, config.async_server_next_batch());
 
     ApplyConfigToBuilder(config, builder.get());
 
@@ -163,7 +165,11 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
 
     for (int i = 0; i < num_threads; i++) {
       shutdown_state_.emplace_back(new PerThreadShutdownState());
-      threads_.emplace_back(&AsyncQpsServerTest::ThreadFunc, this, i);
+      if (next_batch_ > 1) {
+        threads_.emplace_back(&AsyncQpsServerTest::BatchThreadFunc, this, i);
+      } else {
+        threads_.emplace_back(&AsyncQpsServerTest::ThreadFunc, this, i);
+      }
     }
   }
   ~AsyncQpsServerTest() override {
@@ -234,6 +240,31 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
         &got_tag, &ok, gpr_inf_future(GPR_CLOCK_REALTIME)));
   }
 
+  // Like ThreadFunc, but takes up to next_batch_ events per wakeup.
+  void BatchThreadFunc(int thread_idx) {
+    std::vector<void*> tags(next_batch_);
+    std::unique_ptr<bool[]> oks(new bool[next_batch_]);
+    std::mutex* mu_ptr = &shutdown_state_[thread_idx]->mutex;
+    size_t n;
+    while ((n = srv_cqs_[cq_[thread_idx]]->NextBatch(tags.data(), oks.get(),
+                                                     tags.size())) > 0) {
+      for (size_t i = 0; i < n; i++) {
+        ServerRpcContext* ctx = detag(tags[i]);
+        // Proceed while holding a lock to make sure that
+        // this thread isn't supposed to shut down
+        std::lock_guard<std::mutex> lock(*mu_ptr);
+        if (shutdown_state_[thread_idx]->shutdown) {
+          return;
+        }
+        ctx->lock();
+        if (!ctx->RunNextState(oks[i])) {
+          ctx->Reset();
+        }
+        ctx->unlock();
+      }
+    }
+  }
+
   class ServerRpcContext {
    public:
     ServerRpcContext() {}
@@ -524,6 +555,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
   std::unique_ptr<grpc::Server> server_;
   std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> srv_cqs_;
   std::vector<int> cq_;
+  int next_batch_;
   ServiceType async_service_;
   std::vector<std::unique_ptr<ServerRpcContext>> contexts_;
 
@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/thread_manager/thread_pool_controller.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/support/cpu.h>
+
+namespace grpc {
+namespace {
+
+using Decision = ThreadPoolController::Decision;
+
+constexpr double kInterval = ThreadPoolController::kControlIntervalUs;
+
+// The CPU time reported to the controllers under test.
+double g_cpu_seconds = 0;
+double FakeCpuSeconds() { return g_cpu_seconds; }
+double UnknownCpuSeconds() { return -1; }
+
+// Uses the CPUs for the given share of an interval.
+void UseCpu(double share) {
+  g_cpu_seconds += share * gpr_cpu_num_cores() * kInterval * 1e-6;
+}
+
+TEST(ThreadPoolControllerTest, GrowsWhileWorkWaits) {
+  ThreadPoolController controller(FakeCpuSeconds);
+  double now = 0;
+  for (int i = 0; i < 100; i++) controller.RecordQueueingDelay(10 * 1000);
+  EXPECT_GT(controller.queueing_delay_us(),
+            ThreadPoolController::kTargetQueueingDelayUs);
+  EXPECT_EQ(controller.Decide(now), Decision::kGrow);
+  // Not again before the next interval.
+  EXPECT_EQ(controller.Decide(now + kInterval / 2), Decision::kKeep);
+  now += kInterval;
+  UseCpu(0.5);
+  EXPECT_EQ(controller.Decide(now), Decision::kGrow);
+}
+
+TEST(ThreadPoolControllerTest, ShrinksWhenWorkDoesNotWait) {
+  ThreadPoolController controller(FakeCpuSeconds);
+  for (int i = 0; i < 100; i++) controller.RecordQueueingDelay(0);
+  EXPECT_EQ(controller.Decide(0), Decision::kShrink);
+  // In between, keeps the size.
+  for (int i = 0; i < 100; i++) controller.RecordQueueingDelay(500);
+  EXPECT_EQ(controller.Decide(kInterval), Decision::kKeep);
+}
+
+TEST(ThreadPoolControllerTest, StopsGrowingWhenCpuIsSaturated) {
+  ThreadPoolController controller(FakeCpuSeconds);
+  for (int i = 0; i < 100; i++) controller.RecordQueueingDelay(10 * 1000);
+  double now = 0;
+  EXPECT_FALSE(controller.CpuSaturated(now));
+  now += kInterval;
+  UseCpu(1);
+  EXPECT_TRUE(controller.CpuSaturated(now));
+  EXPECT_EQ(controller.Decide(now), Decision::kKeep);
+  now += kInterval;
+  UseCpu(0.2);
+  EXPECT_FALSE(controller.CpuSaturated(now));
+  EXPECT_EQ(controller.Decide(now), Decision::kGrow);
+}
+
+TEST(ThreadPoolControllerTest, UnknownCpuIsNeverSaturated) {
+  ThreadPoolController controller(UnknownCpuSeconds);
+  EXPECT_FALSE(controller.CpuSaturated(0));
+  EXPECT_FALSE(controller.CpuSaturated(kInterval));
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
  */
 
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -152,6 +153,35 @@ TEST_F(ByteBufferTest, DumpToSingleSlice) {
   EXPECT_EQ(strlen(kContent1) + strlen(kContent2), slice.size());
 }
 
+TEST_F(ByteBufferTest, Compress) {
+  const std::string content(1024, 'x');
+  Slice slice(content);
+  ByteBuffer buffer(&slice, 1);
+  ByteBuffer compressed;
+  EXPECT_TRUE(buffer.Compress(GRPC_COMPRESS_GZIP, &compressed).ok());
+  EXPECT_LT(compressed.Length(), buffer.Length());
+  // Reading decompresses.
+  Slice decompressed;
+  EXPECT_TRUE(compressed.DumpToSingleSlice(&decompressed).ok());
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(decompressed.begin()),
+                        decompressed.size()),
+            content);
+  ByteBuffer twice;
+  EXPECT_FALSE(compressed.Compress(GRPC_COMPRESS_GZIP, &twice).ok());
+}
+
+TEST_F(ByteBufferTest, CompressLeavesIncompressibleContents) {
+  // Too short for gzip's header and trailer to pay off.
+  const char* content = "hello";
+  Slice slice(content);
+  ByteBuffer buffer(&slice, 1);
+  ByteBuffer compressed;
+  EXPECT_TRUE(buffer.Compress(GRPC_COMPRESS_GZIP, &compressed).ok());
+  Slice single;
+  EXPECT_TRUE(compressed.TrySingleSlice(&single).ok());
+  EXPECT_EQ(single.size(), strlen(content));
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -160,7 +160,29 @@ _DATA_MEMBERS = [
         setter_move_semantics=True,
         test_name="DifferentCrlDirectory",
         test_value_1="\"crl_directory_1\"",
-        test_value_2="\"crl_directory_2\"")
+        test_value_2="\"crl_directory_2\""),
+    DataMember(
+        name='session_ticket_keys',
+        type='grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys>',
+        special_getter_return_type=
+        'const grpc_core::RefCountedPtr<tsi::SslSessionTicketKeys>&',
+        setter_comment=
+        'Sets the keys the server encrypts session tickets with. Servers sharing the same keys resume each other\'s sessions. If not set, each server uses its own random key.',
+        setter_move_semantics=True,
+        test_name="DifferentSessionTicketKeys",
+        test_value_1="MakeRefCounted<tsi::SslSessionTicketKeys>()",
+        test_value_2="MakeRefCounted<tsi::SslSessionTicketKeys>()"),
+    DataMember(
+        name='private_key_signer',
+        type='grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner>',
+        special_getter_return_type=
+        'const grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner>&',
+        setter_comment=
+        'Sets the signer that performs the signing operations of the server\'s handshakes, for servers whose private key is not loaded in the process. If set, the private keys of the identity key-cert pairs are ignored.',
+        setter_move_semantics=True,
+        test_name="DifferentPrivateKeySigner",
+        test_value_1="MakeRefCounted<tsi::ExternalSslPrivateKeySigner>(grpc_tls_private_key_signer_external{})",
+        test_value_2="MakeRefCounted<tsi::ExternalSslPrivateKeySigner>(grpc_tls_private_key_signer_external{})")
 ]
 
 
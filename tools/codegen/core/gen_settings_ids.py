@@ -50,6 +50,8 @@ _SETTINGS = {
                 clamp_invalid_value),
     'GRPC_ALLOW_TRUE_BINARY_METADATA':
         Setting(0xfe03, 0, 0, 1, clamp_invalid_value),
+    'GRPC_ALLOW_MEMFD_DATA':
+        Setting(0xfe04, 0, 0, 1, clamp_invalid_value),
 }
 
 H = open('src/core/ext/transport/chttp2/transport/http2_settings.h', 'w')
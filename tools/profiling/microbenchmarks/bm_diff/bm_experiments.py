@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+""" Runs microbenchmarks and C++ qps scenarios with each experiment on and off,
+and reports the differences as json """
+
+import argparse
+import collections
+import json
+import multiprocessing
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+
+import tabulate
+import yaml
+
+sys.path.append(os.path.join(os.path.dirname(sys.argv[0]), '..'))
+sys.path.append(
+    os.path.join(os.path.dirname(sys.argv[0]), '..', '..', '..', 'run_tests'))
+sys.path.append(
+    os.path.join(os.path.dirname(sys.argv[0]), '..', '..', '..', 'run_tests',
+                 'python_utils'))
+
+import bm_build
+import bm_constants
+import bm_diff
+import bm_json
+import bm_speedup
+import jobset
+import performance.scenario_config as scenario_config
+
+_EXPERIMENTS_YAML = 'src/core/lib/experiments/experiments.yaml'
+# Handle of the build, as passed to bm_build.py.
+_BUILD_NAME = 'experiments'
+_QPS_DRIVER = 'qps_json_driver'
+# Fields of the summary of a scenario result to compare.
+_SCENARIO_INTERESTING = ('qps', 'qpsPerServerCore', 'latency50', 'latency99',
+                         'serverCpuUsage', 'clientPollsPerRequest',
+                         'serverPollsPerRequest')
+# The states of an experiment, and what GRPC_EXPERIMENTS is set to for them.
+_STATES = {
+    'on': '%s',
+    'off': '-%s',
+}
+
+
+def _experiments():
+    with open(_EXPERIMENTS_YAML) as f:
+        attrs = yaml.load(f.read(), Loader=yaml.FullLoader)
+    return collections.OrderedDict(
+        (attr['name'], attr['default']) for attr in attrs)
+
+
+def _args(experiments):
+    argp = argparse.ArgumentParser(
+        description=
+        'Compare microbenchmarks and qps scenarios with experiments on and off')
+    argp.add_argument('-e',
+                      '--experiments',
+                      nargs='+',
+                      choices=list(experiments.keys()),
+                      default=list(experiments.keys()),
+                      help='Experiments to compare')
+    argp.add_argument('-t',
+                      '--track',
+                      choices=sorted(bm_constants._INTERESTING),
+                      nargs='+',
+                      default=sorted(bm_constants._INTERESTING),
+                      help='Which microbenchmark metrics to track')
+    argp.add_argument('-b',
+                      '--benchmarks',
+                      nargs='*',
+                      choices=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+                      default=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+                      help='Microbenchmarks to run')
+    argp.add_argument('-r',
+                      '--regex',
+                      type=str,
+                      default="",
+                      help='Regex to filter microbenchmarks run')
+    argp.add_argument('-c',
+                      '--category',
+                      choices=['smoketest', 'scalable', 'sweep', 'all', 'none'],
+                      default='smoketest',
+                      help='Category of C++ qps scenarios to run')
+    argp.add_argument('-s',
+                      '--scenario_regex',
+                      type=str,
+                      default='.*',
+                      help='Regex to filter qps scenarios run')
+    argp.add_argument(
+        '-l',
+        '--loops',
+        type=int,
+        default=5,
+        help=
+        'Number of times to run everything in each state of each experiment. More loops cuts down on noise'
+    )
+    argp.add_argument('-j',
+                      '--jobs',
+                      type=int,
+                      default=multiprocessing.cpu_count(),
+                      help='Number of CPUs to use for microbenchmarks')
+    argp.add_argument('--skip_build',
+                      default=False,
+                      action='store_const',
+                      const=True,
+                      help='Reuse the binaries of a previous run')
+    argp.add_argument('-d',
+                      '--out_dir',
+                      type=str,
+                      default='bm_experiments',
+                      help='Directory for the results of the runs')
+    argp.add_argument('-o',
+                      '--output',
+                      type=str,
+                      default='experiments.json',
+                      help='File to write the comparison to')
+    args = argp.parse_args()
+    if args.loops < 3:
+        print("WARNING: This run will likely be noisy. Increase loops to at "
+              "least 3.")
+    return args
+
+
+def _binary(name):
+    return 'bm_diff_%s/opt/%s' % (_BUILD_NAME, name)
+
+
+def _build_qps_driver():
+    """Adds the qps driver to the binaries bm_build.py built."""
+    subprocess.check_call([
+        'tools/bazel', 'build', '--config=opt', '--dynamic_mode=off',
+        '//test/cpp/qps:%s' % _QPS_DRIVER
+    ])
+    subprocess.check_call(
+        ['cp', 'bazel-bin/test/cpp/qps/%s' % _QPS_DRIVER,
+         _binary(_QPS_DRIVER)])
+
+
+def _scenarios(category, regex):
+    """C++ scenarios, with their workers spawned in the driver process, so
+    that GRPC_EXPERIMENTS applies to the clients and the servers."""
+    if category == 'none':
+        return []
+    scenarios = []
+    for scenario_json in scenario_config.LANGUAGES['c++'].scenarios():
+        categories = scenario_json.get('CATEGORIES', ['scalable', 'smoketest'])
+        if category != 'all' and category not in categories:
+            continue
+        if not re.search(regex, scenario_json['name']):
+            continue
+        # Scenarios with workers in another language can't run here.
+        if ('SERVER_LANGUAGE' in scenario_json or
+                'CLIENT_LANGUAGE' in scenario_json):
+            continue
+        scenario_json = scenario_config.remove_nonproto_fields(scenario_json)
+        scenario_json['spawn_local_worker_count'] = (
+            scenario_json['num_servers'] +
+            max(scenario_json.get('num_clients', 0), 1))
+        scenarios.append(scenario_json)
+    return scenarios
+
+
+def _stripped(line):
+    return line.strip().replace("/", "_").replace("<", "_").replace(
+        ">", "_").replace(", ", "_")
+
+
+def _run_name(experiment, state):
+    return '%s.%s' % (experiment, state)
+
+
+def _environ(experiment, state):
+    return {'GRPC_EXPERIMENTS': _STATES[state] % experiment}
+
+
+def _bm_tests(bm, regex):
+    return [
+        line.decode('UTF-8') for line in subprocess.check_output([
+            _binary(bm), '--benchmark_list_tests',
+            '--benchmark_filter=%s' % regex
+        ]).splitlines()
+    ]
+
+
+def _bm_result_file(out_dir, bm, line, run, idx):
+    return os.path.join(out_dir,
+                        '%s.%s.%s.%d.json' % (bm, _stripped(line), run, idx))
+
+
+def _scenario_result_file(out_dir, scenario, run, idx):
+    return os.path.join(out_dir, '%s.%s.%d.json' % (scenario, run, idx))
+
+
+def create_bm_jobs(experiments, benchmarks, loops, regex, out_dir):
+    jobs_list = []
+    for bm in benchmarks:
+        lines = _bm_tests(bm, regex)
+        for experiment in experiments:
+            for state in _STATES:
+                run = _run_name(experiment, state)
+                for idx in range(0, loops):
+                    for line in lines:
+                        cmd = [
+                            _binary(bm),
+                            '--benchmark_filter=^%s$' % line,
+                            '--benchmark_out=%s' %
+                            _bm_result_file(out_dir, bm, line, run, idx),
+                            '--benchmark_out_format=json',
+                        ]
+                        jobs_list.append(
+                            jobset.JobSpec(
+                                cmd,
+                                shortname='%s %s %s %d/%d' %
+                                (bm, line, run, idx + 1, loops),
+                                environ=_environ(experiment, state),
+                                verbose_success=True,
+                                cpu_cost=2,
+                                timeout_seconds=60 * 60))  # one hour
+    # shuffle all jobs to eliminate noise from GCE CPU drift
+    random.shuffle(jobs_list, random.SystemRandom().random)
+    return jobs_list
+
+
+def create_scenario_jobs(experiments, scenarios, loops, out_dir):
+    jobs_list = []
+    for scenario_json in scenarios:
+        for experiment in experiments:
+            for state in _STATES:
+                run = _run_name(experiment, state)
+                for idx in range(0, loops):
+                    cmd = [
+                        _binary(_QPS_DRIVER),
+                        '--scenarios_json=%s' %
+                        json.dumps({'scenarios': [scenario_json]}),
+                        '--scenario_result_file=%s' % _scenario_result_file(
+                            out_dir, scenario_json['name'], run, idx),
+                    ]
+                    environ = _environ(experiment, state)
+                    # Use the local workers only.
+                    environ['QPS_WORKERS'] = ''
+                    jobs_list.append(
+                        jobset.JobSpec(cmd,
+                                       shortname='%s %s %d/%d' %
+                                       (scenario_json['name'], run, idx + 1,
+                                        loops),
+                                       environ=environ,
+                                       verbose_success=True,
+                                       timeout_seconds=30 * 60))
+    random.shuffle(jobs_list, random.SystemRandom().random)
+    return jobs_list
+
+
+def _read_json(filename, missing_files):
+    try:
+        with open(filename) as f:
+            return json.loads(f.read())
+    except (IOError, ValueError):
+        missing_files.append(filename)
+        return None
+
+
+def _compare(samples):
+    """Turns {metric: {state: [values]}} into medians and the change, in
+    percent, of each metric with the experiment on. Changes that are not
+    statistically significant are 0."""
+    result = {}
+    for metric, by_state in sorted(samples.items()):
+        on = by_state['on']
+        off = by_state['off']
+        if not on or not off:
+            continue
+        result[metric] = {
+            'on': bm_diff._median(on),
+            'off': bm_diff._median(off),
+            'change_pct': bm_speedup.speedup(on, off, 1e-5),
+        }
+    return result
+
+
+def collect_bms(experiment, benchmarks, loops, regex, track, out_dir,
+                missing_files):
+    samples = collections.defaultdict(lambda: collections.defaultdict(
+        lambda: collections.defaultdict(list)))
+    for bm in benchmarks:
+        for line in _bm_tests(bm, regex):
+            for state in _STATES:
+                run = _run_name(experiment, state)
+                for idx in range(0, loops):
+                    js = _read_json(
+                        _bm_result_file(out_dir, bm, line, run, idx),
+                        missing_files)
+                    if not js:
+                        continue
+                    for row in bm_json.expand_json(js):
+                        for metric in track:
+                            if metric in row:
+                                samples[row['cpp_name']][metric][state].append(
+                                    float(row[metric]))
+    return {name: _compare(s) for name, s in sorted(samples.items())}
+
+
+def collect_scenarios(experiment, scenarios, loops, out_dir, missing_files):
+    samples = collections.defaultdict(lambda: collections.defaultdict(
+        lambda: collections.defaultdict(list)))
+    for scenario_json in scenarios:
+        name = scenario_json['name']
+        for state in _STATES:
+            run = _run_name(experiment, state)
+            for idx in range(0, loops):
+                js = _read_json(
+                    _scenario_result_file(out_dir, name, run, idx),
+                    missing_files)
+                if not js:
+                    continue
+                summary = js.get('summary', {})
+                for metric in _SCENARIO_INTERESTING:
+                    if metric in summary:
+                        samples[name][metric][state].append(
+                            float(summary[metric]))
+    return {name: _compare(s) for name, s in sorted(samples.items())}
+
+
+def _significant_rows(experiment, kind, comparisons):
+    rows = []
+    for name, metrics in sorted(comparisons.items()):
+        for metric, comparison in sorted(metrics.items()):
+            if abs(comparison['change_pct']) > 3:
+                rows.append([
+                    experiment, kind, name, metric,
+                    '%+d%%' % comparison['change_pct']
+                ])
+    return rows
+
+
+def main(args, experiments):
+    scenarios = _scenarios(args.category, args.scenario_regex)
+    if not args.skip_build:
+        bm_build.build(_BUILD_NAME, args.benchmarks, args.jobs)
+        if scenarios:
+            _build_qps_driver()
+    shutil.rmtree(args.out_dir, ignore_errors=True)
+    os.makedirs(args.out_dir)
+
+    jobset.run(create_bm_jobs(args.experiments, args.benchmarks, args.loops,
+                              args.regex, args.out_dir),
+               maxjobs=args.jobs)
+    # Each scenario keeps several cores busy: run them one at a time.
+    jobset.run(create_scenario_jobs(args.experiments, scenarios, args.loops,
+                                    args.out_dir),
+               maxjobs=1)
+
+    missing_files = []
+    report = collections.OrderedDict()
+    rows = []
+    for experiment in args.experiments:
+        microbenchmarks = collect_bms(experiment, args.benchmarks, args.loops,
+                                      args.regex, args.track, args.out_dir,
+                                      missing_files)
+        scenario_results = collect_scenarios(experiment, scenarios, args.loops,
+                                             args.out_dir, missing_files)
+        report[experiment] = {
+            'default': experiments[experiment],
+            'microbenchmarks': microbenchmarks,
+            'scenarios': scenario_results,
+        }
+        rows += _significant_rows(experiment, 'microbenchmark',
+                                  microbenchmarks)
+        rows += _significant_rows(experiment, 'scenario', scenario_results)
+    with open(args.output, 'w') as f:
+        json.dump({'loops': args.loops, 'experiments': report}, f, indent=2)
+
+    if missing_files:
+        print('Missing or corrupt results (indicates timeout or crash):\n%s' %
+              '\n'.join('    ' + f for f in missing_files))
+    if rows:
+        print('Changes with the experiment on:\n%s' % tabulate.tabulate(
+            rows, headers=['Experiment', 'Kind', 'Name', 'Metric', 'Change']))
+    else:
+        print('No significant differences')
+    print('Comparison written to %s' % args.output)
+
+
+if __name__ == '__main__':
+    experiments = _experiments()
+    args = _args(experiments)
+    main(args, experiments)
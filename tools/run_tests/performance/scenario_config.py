@@ -127,6 +127,7 @@ def _ping_pong_scenario(name,
                         server_processes=0,
                         server_threads_per_cq=0,
                         client_threads_per_cq=0,
+                        server_next_batch=None,
                         warmup_seconds=WARMUP_SECONDS,
                         categories=None,
                         channels=None,
@@ -169,6 +170,8 @@ def _ping_pong_scenario(name,
     }
     if resource_quota_size:
         scenario['server_config']['resource_quota_size'] = resource_quota_size
+    if server_next_batch:
+        scenario['server_config']['async_server_next_batch'] = server_next_batch
     if use_generic_payload:
         if server_type != 'ASYNC_GENERIC_SERVER':
             raise Exception('Use ASYNC_GENERIC_SERVER for generic payload.')
@@ -438,6 +441,19 @@ class CXXLanguage(Language):
                 server_threads_per_cq=1000000,
                 categories=inproc_categories + [SCALABLE])
 
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_qps_unconstrained_1cq_next_batch_%s' %
+                secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async-limited',
+                secure=secure,
+                client_threads_per_cq=1000000,
+                server_threads_per_cq=1000000,
+                server_next_batch=32,
+                categories=inproc_categories + [SCALABLE])
+
             yield _ping_pong_scenario(
                 'cpp_generic_async_streaming_qps_one_server_core_%s' % secstr,
                 rpc_type='STREAMING',
@@ -487,6 +503,20 @@ class CXXLanguage(Language):
                 minimal_stack=not secure,
                 categories=[SWEEP])
 
+            # Many client threads making blocking calls on one channel, so
+            # that the calls share the pluckable completion queues it keeps.
+            yield _ping_pong_scenario(
+                'cpp_protobuf_sync_unary_qps_unconstrained_1channel_%s' %
+                secstr,
+                rpc_type='UNARY',
+                client_type='SYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='sync',
+                channels=1,
+                secure=secure,
+                minimal_stack=not secure,
+                categories=[SWEEP])
+
             yield _ping_pong_scenario(
                 'cpp_protobuf_async_unary_ping_pong_%s_1MB' % secstr,
                 rpc_type='UNARY',